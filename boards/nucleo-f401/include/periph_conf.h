@@ -115,6 +115,22 @@ static const uart_conf_t uart_config[] = {
 #define UART_1_ISR          (isr_usart6)
 #define UART_1_DMA_ISR      (isr_dma1_stream6)
 
+/* UART RX DMA configuration, see uart_init_block() */
+#define UART_0_DMA_RX_STREAM    5           /* DMA1 stream 5 */
+#define UART_0_DMA_RX_CHAN      4
+#define UART_0_DMA_RX_ISR       isr_dma1_stream5
+#define UART_1_DMA_RX_STREAM    9           /* DMA2 stream 1 */
+#define UART_1_DMA_RX_CHAN      5
+#define UART_1_DMA_RX_ISR       isr_dma2_stream1
+
+/* UART TX DMA configuration, used by the periph_uart_nonblocking module */
+#define UART_0_DMA_TX_STREAM    6           /* DMA1 stream 6 */
+#define UART_0_DMA_TX_CHAN      4
+#define UART_0_DMA_TX_ISR       isr_dma1_stream6
+#define UART_1_DMA_TX_STREAM    14          /* DMA2 stream 6 */
+#define UART_1_DMA_TX_CHAN      5
+#define UART_1_DMA_TX_ISR       isr_dma2_stream6
+
 #define UART_NUMOF          (sizeof(uart_config) / sizeof(uart_config[0]))
 /** @} */
 
@@ -146,6 +162,11 @@ static const uart_conf_t uart_config[] = {
 #define SPI_0_MOSI_PIN          7
 #define SPI_0_MOSI_AF           5
 #define SPI_0_MOSI_PORT_CLKEN() (periph_clk_en(AHB1, RCC_AHB1ENR_GPIOAEN))
+/* SPI 0 DMA configuration */
+#define SPI_0_DMA_RX_STREAM     8           /* DMA2 stream 0 */
+#define SPI_0_DMA_TX_STREAM     11          /* DMA2 stream 3 */
+#define SPI_0_DMA_CHAN          3
+#define SPI_0_DMA_RX_ISR        isr_dma2_stream0
 /** @} */
 
 
@@ -185,6 +185,9 @@ static const pwm_conf_t pwm_config[] = {
 #define SPI_0_MOSI          GPIO_PIN(PB, 30)
 #define SPI_0_MOSI_MUX      GPIO_MUX_F
 #define SPI_0_MOSI_PAD      SPI_PAD_MOSI_2_SCK_3
+/* SPI 0 DMA configuration */
+#define SPI_0_DMA_RX_TRIG   SERCOM4_DMAC_ID_RX
+#define SPI_0_DMA_TX_TRIG   SERCOM4_DMAC_ID_TX
 
 /*      SPI1             */
 #define SPI_1_DEV           SERCOM5->SPI
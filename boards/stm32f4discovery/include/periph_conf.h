@@ -134,6 +134,17 @@ static const uart_conf_t uart_config[] = {
 }
 
 #define ADC_NUMOF           (4)
+
+/* continuous sampling on ADC1, triggered by TRGO of TIM8, moved by DMA2
+ * stream 4 */
+#define ADC_CONT_DEV        (0)
+#define ADC_CONT_TIM        (TIM8)
+#define ADC_CONT_TIM_RCC    (RCC_APB2ENR_TIM8EN)
+#define ADC_CONT_TIM_BUS    (APB2)
+#define ADC_CONT_TIM_EXTSEL (14)
+#define ADC_CONT_DMA_STREAM (12)
+#define ADC_CONT_DMA_CHAN   (0)
+#define ADC_CONT_DMA_ISR    (isr_dma2_stream4)
 /** @} */
 
 /**
@@ -44,3 +44,51 @@ int atomic_cas(atomic_int_t *var, int old, int now)
 }
 
 #endif
+
+/* Set ARCH_HAS_ATOMIC_FETCH_ADD within cpu.h to override this function */
+#if (ARCH_HAS_ATOMIC_FETCH_ADD == 0)
+
+int atomic_fetch_add(atomic_int_t *var, int val)
+{
+    int old;
+
+#if ARCH_HAS_ATOMIC_COMPARE_AND_SWAP
+    do {
+        old = ATOMIC_VALUE(*var);
+    } while (!atomic_cas(var, old, (int)((unsigned)old + (unsigned)val)));
+#else
+    unsigned int mask = irq_disable();
+
+    old = ATOMIC_VALUE(*var);
+    ATOMIC_VALUE(*var) = (int)((unsigned)old + (unsigned)val);
+    irq_restore(mask);
+#endif
+
+    return old;
+}
+
+#endif
+
+/* Set ARCH_HAS_ATOMIC_SWAP within cpu.h to override this function */
+#if (ARCH_HAS_ATOMIC_SWAP == 0)
+
+int atomic_swap(atomic_int_t *var, int now)
+{
+    int old;
+
+#if ARCH_HAS_ATOMIC_COMPARE_AND_SWAP
+    do {
+        old = ATOMIC_VALUE(*var);
+    } while (!atomic_cas(var, old, now));
+#else
+    unsigned int mask = irq_disable();
+
+    old = ATOMIC_VALUE(*var);
+    ATOMIC_VALUE(*var) = now;
+    irq_restore(mask);
+#endif
+
+    return old;
+}
+
+#endif
@@ -21,6 +21,8 @@
 
 #include <stdio.h>
 
+#include "bitarithm.h"
+
 unsigned bitarithm_msb(unsigned v)
 {
     register unsigned r; // result of log2(v) will go here
@@ -44,6 +46,7 @@ unsigned bitarithm_msb(unsigned v)
     return r;
 }
 /*---------------------------------------------------------------------------*/
+#if !BITARITHM_LSB_BUILTIN
 unsigned bitarithm_lsb(register unsigned v)
 {
     register unsigned r = 0;
@@ -55,6 +58,7 @@ unsigned bitarithm_lsb(register unsigned v)
 
     return r;
 }
+#endif
 /*---------------------------------------------------------------------------*/
 unsigned bitarithm_bits_set(unsigned v)
 {
@@ -56,6 +56,33 @@ typedef struct {
  */
 int atomic_cas(atomic_int_t *var, int old, int now);
 
+/**
+ * @brief Add to a variable atomically and return the old value
+ *
+ * Set ARCH_HAS_ATOMIC_FETCH_ADD within cpu.h to provide an architecture
+ * specific implementation. The generic one is a loop over atomic_cas() if
+ * the architecture implements that, and disables interrupts otherwise.
+ *
+ * @param[inout] var  Atomic variable to update
+ * @param[in]    val  The value to add, the sum wraps around
+ *
+ * @return The value of *var* before the addition
+ */
+int atomic_fetch_add(atomic_int_t *var, int val);
+
+/**
+ * @brief Write a variable atomically and return the old value
+ *
+ * Set ARCH_HAS_ATOMIC_SWAP within cpu.h to provide an architecture specific
+ * implementation.
+ *
+ * @param[inout] var  Atomic variable to update
+ * @param[in]    now  The new value to write to var
+ *
+ * @return The value of *var* before the write
+ */
+int atomic_swap(atomic_int_t *var, int now);
+
 /**
  * @brief Increment a counter variable by one atomically and return the old value.
  *
@@ -65,13 +92,7 @@ int atomic_cas(atomic_int_t *var, int old, int now);
  */
 static inline int atomic_inc(atomic_int_t *var)
 {
-    int old;
-
-    do {
-        old = var->value;
-    } while (!atomic_cas(var, old, old + 1));
-
-    return old;
+    return atomic_fetch_add(var, 1);
 }
 
 /**
@@ -83,13 +104,7 @@ static inline int atomic_inc(atomic_int_t *var)
  */
 static inline int atomic_dec(atomic_int_t *var)
 {
-    int old;
-
-    do {
-        old = var->value;
-    } while (!atomic_cas(var, old, old - 1));
-
-    return old;
+    return atomic_fetch_add(var, -1);
 }
 
 /**
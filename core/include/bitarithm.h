@@ -99,15 +99,35 @@
  */
 unsigned bitarithm_msb(unsigned v);
 
+/**
+ * @brief   Set to 1 if bitarithm_lsb() maps to a single count-trailing-zeros
+ *          (or bit-reverse + count-leading-zeros) instruction sequence
+ *
+ * This is the case on ARMv7-M and later (Cortex-M3 and up) and on x86.
+ */
+#if defined(__ARM_FEATURE_CLZ) || defined(__i386__) || defined(__x86_64__)
+#define BITARITHM_LSB_BUILTIN   (1)
+#else
+#define BITARITHM_LSB_BUILTIN   (0)
+#endif
+
 /**
  * @brief   Returns the number of the lowest '1' bit in a value
  * @param[in]   v   Input value - must be unequal to '0', otherwise the
- *                  function will produce an infinite loop
+ *                  function will produce an infinite loop (or an undefined
+ *                  result if @ref BITARITHM_LSB_BUILTIN is set)
  * @return          Bit Number
  *
  * Source: http://graphics.stanford.edu/~seander/bithacks.html#IntegerLogObvious
  */
+#if BITARITHM_LSB_BUILTIN
+static inline unsigned bitarithm_lsb(unsigned v)
+{
+    return __builtin_ctz(v);
+}
+#else
 unsigned bitarithm_lsb(register unsigned v);
+#endif
 
 /**
  * @brief   Returns the number of bits set in a value
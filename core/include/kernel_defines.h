@@ -106,6 +106,20 @@
 #define UNREACHABLE() do { /* nothing */ } while (1)
 #endif
 
+/**
+ * @def RAMFUNC
+ * @brief Execute the function from RAM when the `ramfunc` module is used.
+ *        The Cortex-M linker scripts place the `.ramfunc` section next to
+ *        `.data`, which is copied to RAM at startup. Use it for hot paths that
+ *        would otherwise stall on flash wait states. Without the module or on
+ *        other platforms it has no effect.
+ */
+#if defined(MODULE_RAMFUNC) && defined(MODULE_CORTEXM_COMMON)
+#define RAMFUNC __attribute__((section(".ramfunc")))
+#else
+#define RAMFUNC
+#endif
+
 /**
  * @def         ALIGN_OF(T)
  * @brief       Calculate the minimal alignment for type T.
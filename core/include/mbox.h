@@ -25,6 +25,7 @@
 #include "list.h"
 #include "cib.h"
 #include "msg.h"
+#include "sched.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -95,6 +96,55 @@ int _mbox_put(mbox_t *mbox, msg_t *msg, int blocking);
  */
 int _mbox_get(mbox_t *mbox, msg_t *msg, int blocking);
 
+/**
+ * @brief Get message from mailbox, blocking until a message arrives or the
+ *        wait is canceled
+ *
+ * @internal
+ *
+ * This is the building block for waiting on a mailbox with a timeout, see
+ * @ref xtimer_mbox_get_timeout().
+ *
+ * @param[in] mbox      ptr to mailbox to operate on
+ * @param[in] msg       ptr to storage for retrieved message
+ * @param[in] canceled  ptr to a flag, initially 0, that is set by
+ *                      @ref _mbox_cancel_get()
+ *
+ * @return  1   if msg could be retrieved
+ * @return  0   if the wait was canceled
+ */
+int _mbox_get_cancelable(mbox_t *mbox, msg_t *msg, volatile unsigned *canceled);
+
+/**
+ * @brief Cancel a wait in @ref _mbox_get_cancelable()
+ *
+ * @internal
+ *
+ * May be called from interrupt context. If @p thread is not (yet) waiting,
+ * its next call to @ref _mbox_get_cancelable() with @p canceled returns
+ * right away, unless a message is queued.
+ *
+ * @param[in] mbox      ptr to mailbox @p thread waits on
+ * @param[in] thread    the waiting thread
+ * @param[in] canceled  flag given to @ref _mbox_get_cancelable()
+ */
+void _mbox_cancel_get(mbox_t *mbox, thread_t *thread, volatile unsigned *canceled);
+
+/**
+ * @brief Get up to @p n messages from mailbox
+ *
+ * @internal
+ *
+ * @param[in] mbox      ptr to mailbox to operate on
+ * @param[out] msgs     array of at least @p n messages
+ * @param[in] n         maximum number of messages to retrieve
+ * @param[in] blocking  block until at least one message is available if 1,
+ *                      don't block if 0
+ *
+ * @return  number of messages retrieved
+ */
+unsigned _mbox_get_many(mbox_t *mbox, msg_t *msgs, unsigned n, int blocking);
+
 /**
  * @brief Add message to mailbox
  *
@@ -155,6 +205,40 @@ static inline int mbox_try_get(mbox_t *mbox, msg_t *msg)
     return _mbox_get(mbox, msg, NON_BLOCKING);
 }
 
+/**
+ * @brief Get up to @p n messages from mailbox
+ *
+ * If the mailbox is empty, this function will block until a message becomes
+ * available. Otherwise all queued messages up to @p n are retrieved at once,
+ * waking blocked writers with a single context switch.
+ *
+ * @param[in] mbox  ptr to mailbox to operate on
+ * @param[out] msgs array of at least @p n messages
+ * @param[in] n     maximum number of messages to retrieve
+ *
+ * @return  number of messages retrieved, at least 1 if @p n > 0
+ */
+static inline unsigned mbox_get_many(mbox_t *mbox, msg_t *msgs, unsigned n)
+{
+    return _mbox_get_many(mbox, msgs, n, BLOCKING);
+}
+
+/**
+ * @brief Get up to @p n messages from mailbox
+ *
+ * If the mailbox is empty, this fuction will return right away.
+ *
+ * @param[in] mbox  ptr to mailbox to operate on
+ * @param[out] msgs array of at least @p n messages
+ * @param[in] n     maximum number of messages to retrieve
+ *
+ * @return  number of messages retrieved
+ */
+static inline unsigned mbox_try_get_many(mbox_t *mbox, msg_t *msgs, unsigned n)
+{
+    return _mbox_get_many(mbox, msgs, n, NON_BLOCKING);
+}
+
 #ifdef __cplusplus
 }
 #endif
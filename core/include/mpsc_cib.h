@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  core_util
+ * @{
+ *
+ * @file
+ * @brief       Multi-producer/single-consumer circular integer buffer
+ * @details     Like @ref cib_t, this hands out indices into an array managed
+ *              by the caller, but any number of threads and ISRs may put
+ *              into it concurrently without disabling interrupts. Only one
+ *              thread may take out.
+ *
+ *              A producer reserves a slot with mpsc_cib_put(), writes its
+ *              element to it and publishes it with mpsc_cib_commit(). The
+ *              consumer gets the oldest element with mpsc_cib_peek() and
+ *              frees its slot with mpsc_cib_release() after reading it.
+ *
+ *              Every slot carries a sequence number telling whether it is
+ *              free or holds a committed element, so the producers only
+ *              race for the write counter, using atomic_cas(). Elements
+ *              are taken out in the order of reservation: an element
+ *              becomes visible once all elements reserved before it are
+ *              committed.
+ *
+ * @note        Only a compiler barrier is used between element and sequence
+ *              accesses, which is sufficient on single-core MCUs.
+ */
+
+#ifndef MPSC_CIB_H
+#define MPSC_CIB_H
+
+#include "assert.h"
+#include "atomic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Multi-producer/single-consumer circular integer buffer structure
+ */
+typedef struct {
+    atomic_int_t write_count;   /**< number of reserved slots */
+    unsigned int read_count;    /**< number of released slots */
+    unsigned int mask;          /**< size of buffer -1 */
+    atomic_int_t *seq;          /**< sequence number of each slot */
+} mpsc_cib_t;
+
+/**
+ * @brief   Initialize @p cib
+ *
+ * @param[out] cib      buffer to initialize
+ * @param[in]  seq      sequence numbers, one per slot
+ * @param[in]  size     number of slots, must be a power of 2
+ */
+static inline void mpsc_cib_init(mpsc_cib_t *cib, atomic_int_t *seq,
+                                 unsigned int size)
+{
+    assert(size && !(size & (size - 1)));
+
+    ATOMIC_VALUE(cib->write_count) = 0;
+    cib->read_count = 0;
+    cib->mask = size - 1;
+    cib->seq = seq;
+    for (unsigned int i = 0; i < size; i++) {
+        ATOMIC_VALUE(seq[i]) = i;
+    }
+}
+
+/**
+ * @brief   Reserve a slot to put to
+ *
+ * May be called by any thread or ISR.
+ *
+ * @param[in,out] cib   buffer to put to
+ *
+ * @return  index of the slot, to be passed to mpsc_cib_commit()
+ * @return  -1 if the buffer is full
+ */
+static inline int mpsc_cib_put(mpsc_cib_t *cib)
+{
+    unsigned int pos = ATOMIC_VALUE(cib->write_count);
+
+    while (1) {
+        unsigned int idx = pos & cib->mask;
+        int diff = (int)((unsigned int)ATOMIC_VALUE(cib->seq[idx]) - pos);
+
+        if (diff < 0) {
+            /* the slot still holds the element of the last round */
+            return -1;
+        }
+        if ((diff == 0) &&
+            atomic_cas(&cib->write_count, (int)pos, (int)(pos + 1))) {
+            return (int)idx;
+        }
+        /* another producer was faster */
+        pos = ATOMIC_VALUE(cib->write_count);
+    }
+}
+
+/**
+ * @brief   Publish the element written to a reserved slot
+ *
+ * @param[in,out] cib   buffer put to
+ * @param[in]     idx   index returned by mpsc_cib_put()
+ */
+static inline void mpsc_cib_commit(mpsc_cib_t *cib, int idx)
+{
+    __asm__ volatile ("" : : : "memory");
+    /* no one else touches a reserved slot */
+    ATOMIC_VALUE(cib->seq[idx]) = ATOMIC_VALUE(cib->seq[idx]) + 1;
+}
+
+/**
+ * @brief   Get the index of the oldest element without removing it
+ *
+ * Must only be called by the consumer.
+ *
+ * @param[in] cib   buffer to get from
+ *
+ * @return  index of the element
+ * @return  -1 if there is no committed element
+ */
+static inline int mpsc_cib_peek(const mpsc_cib_t *cib)
+{
+    unsigned int idx = cib->read_count & cib->mask;
+
+    if ((unsigned int)ATOMIC_VALUE(cib->seq[idx]) != (cib->read_count + 1)) {
+        return -1;
+    }
+    __asm__ volatile ("" : : : "memory");
+    return (int)idx;
+}
+
+/**
+ * @brief   Free the slot of the element returned by mpsc_cib_peek()
+ *
+ * Must only be called by the consumer, after reading the element.
+ *
+ * @param[in,out] cib   buffer to get from
+ */
+static inline void mpsc_cib_release(mpsc_cib_t *cib)
+{
+    unsigned int idx = cib->read_count & cib->mask;
+
+    __asm__ volatile ("" : : : "memory");
+    /* the slot is free for the next round */
+    ATOMIC_VALUE(cib->seq[idx]) = cib->read_count + cib->mask + 1;
+    cib->read_count++;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPSC_CIB_H */
+/** @} */
@@ -309,6 +309,46 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Send multiple messages to one thread at once.
+ *
+ * All messages in @p m are handed to @p target_pid within one single
+ * interrupt-disabled section and with at most one context switch afterwards.
+ * If the target is waiting for a message, the first message is delivered
+ * directly, the remaining ones are put into the target's message queue.
+ *
+ * This function never blocks. Messages that do not fit into the target's
+ * queue are not delivered, the caller can use the return value to retry
+ * sending the remainder. The function can be called from an ISR, in which case
+ * ``sender_pid`` of all messages is set to @ref KERNEL_PID_ISR.
+ *
+ * @param[in] m             Array of @p n preallocated ``msg_t`` structures,
+ *                          must not be NULL.
+ * @param[in] n             Number of messages in @p m, must be > 0.
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return  Number of messages that were delivered (may be 0 if the receiver
+ *          was not waiting and its queue is full or missing)
+ * @return  -1, on error (invalid PID)
+ */
+int msg_send_bulk(msg_t *m, unsigned n, kernel_pid_t target_pid);
+
+/**
+ * @brief Receive multiple messages at once.
+ *
+ * Blocks until at least one message was received. If there are more messages
+ * in the calling thread's message queue, up to @p n of them are fetched
+ * within the same interrupt-disabled section. Senders blocked on the full
+ * queue are released with at most one context switch.
+ *
+ * @param[out] m    Array of @p n preallocated ``msg_t`` structures, must not
+ *                  be NULL.
+ * @param[in] n     Maximum number of messages to receive, must be > 0.
+ *
+ * @return  Number of messages received (at least 1).
+ */
+int msg_receive_bulk(msg_t *m, unsigned n);
+
 /**
  * @brief Send a message, block until reply received.
  *
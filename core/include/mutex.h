@@ -11,6 +11,20 @@
  * @defgroup    core_sync Synchronization
  * @brief       Mutex for thread synchronization
  * @ingroup     core
+ *
+ * Priority inheritance
+ * ====================
+ *
+ * If the (pseudo) module `core_mutex_pi` is used, a mutex remembers its owner.
+ * When a thread with a higher priority blocks on a locked mutex, the owner is
+ * temporarily raised to the waiter's priority until it unlocks the mutex. This
+ * prevents medium priority threads from delaying a high priority thread that
+ * waits for a mutex held by a low priority thread (priority inversion).
+ *
+ * Inheritance is not transitive: if the owner itself is blocked on another
+ * mutex, the owner of that mutex is not boosted. Nested mutexes must be
+ * unlocked in reverse locking order to restore the correct priorities.
+ *
  * @{
  *
  * @file
@@ -26,6 +40,7 @@
 
 #include "list.h"
 #include "atomic.h"
+#include "kernel_types.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -41,18 +56,42 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
+    /**
+     * @brief   PID of the thread currently holding the mutex, or
+     *          @ref KERNEL_PID_UNDEF if unknown. **Must never be changed by
+     *          the user.**
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Priority the owner had when it locked the mutex, restored on
+     *          unlock. **Must never be changed by the user.**
+     * @internal
+     */
+    uint8_t owner_prio;
+#endif
 } mutex_t;
 
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
-#define MUTEX_INIT { { NULL } }
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, 0 }
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
+ *
+ * @note    With `core_mutex_pi` the owner of a mutex initialized this way is
+ *          unknown until it is unlocked and locked again, so no priority
+ *          inheritance takes place for the initial lock.
  */
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF, 0 }
+#else
+#define MUTEX_INIT { { NULL } }
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @internal
@@ -70,6 +109,9 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PI
+    mutex->owner = KERNEL_PID_UNDEF;
+#endif
 }
 
 /**
@@ -99,11 +99,19 @@ typedef struct _thread thread_t;
 /**
  * @def SCHED_PRIO_LEVELS
  * @brief The number of thread priority levels
+ *
+ * Up to the machine word size (32 on 32-bit platforms) the runqueues are
+ * tracked in a single bitmap word. Larger values, up to 256, switch to a
+ * two-level bitmap, so selecting the next thread stays O(1).
  */
 #ifndef SCHED_PRIO_LEVELS
 #define SCHED_PRIO_LEVELS 16
 #endif
 
+#if SCHED_PRIO_LEVELS > 256
+#error "SCHED_PRIO_LEVELS must not exceed 256, thread priorities are uint8_t"
+#endif
+
 /**
  * @brief   Triggers the scheduler to schedule the next thread
  * @returns 1 if sched_active_thread/sched_active_pid was changed, 0 otherwise.
@@ -133,6 +141,21 @@ void sched_set_status(thread_t *process, unsigned int status);
  */
 void sched_switch(uint16_t other_prio);
 
+/**
+ * @brief   Change the priority of a thread
+ *
+ * If the thread is on a run queue, it is moved to the run queue matching
+ * @p priority. The currently active thread is put at the head of its new run
+ * queue, all other threads at the tail. This function does not yield, call
+ * @ref sched_switch() afterwards if needed.
+ *
+ * @pre     Interrupts are disabled.
+ *
+ * @param[in]   thread      The thread to change the priority of
+ * @param[in]   priority    The new priority
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief   Call context switching at thread exit
  */
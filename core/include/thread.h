@@ -192,6 +192,10 @@ struct _thread {
 #if defined(DEVELHELP) || defined(SCHED_TEST_STACK) || defined(MODULE_MPU_STACK_GUARD)
     char *stack_start;              /**< thread's stack start address   */
 #endif
+#ifdef MODULE_SCHED_EDF
+    struct sched_edf *edf;          /**< deadline state, NULL for
+                                         best-effort threads            */
+#endif
 #ifdef DEVELHELP
     const char *name;               /**< thread's name                  */
     int stack_size;                 /**< thread's stack size            */
@@ -329,7 +333,7 @@ struct _thread {
 */
 kernel_pid_t thread_create(char *stack,
                   int stacksize,
-                  char priority,
+                  uint8_t priority,
                   int flags,
                   thread_task_func_t task_func,
                   void *arg,
@@ -64,6 +64,7 @@
 #define THREAD_FLAG_MSG_WAITING      (0x1<<15)
 #define THREAD_FLAG_MUTEX_UNLOCKED   (0x1<<14)
 #define THREAD_FLAG_TIMEOUT          (0x1<<13)
+#define THREAD_FLAG_COND_SIGNALED    (0x1<<12)
 /** @} */
 
 /**
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  core_thread
+ * @{
+ *
+ * @file
+ * @brief       Statically declared threads
+ *
+ * A module can declare its thread, stack and message queue at compile time
+ * instead of creating them from an init function:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * static void *_worker(void *arg);
+ *
+ * THREAD_STATIC_MSG(worker, THREAD_STACKSIZE_DEFAULT, THREAD_PRIORITY_MAIN - 1,
+ *                   0, _worker, NULL, 8);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The descriptors are collected by the linker in the section
+ * `riot_thread_static`, which kernel_init() walks right after creating the
+ * idle and main threads. So the threads exist before main() and auto_init()
+ * run, without a call from any init function, and a thread of higher
+ * priority than main starts running before auto_init(). The message queue is
+ * set up before the thread runs, so it need not call msg_init_queue().
+ *
+ * The PID is available as `<name>_pid` once the kernel started.
+ *
+ * Modules and applications are linked from archives, and the linker only
+ * takes an object file out of an archive if one of its symbols is
+ * referenced. An object file that only declares a static thread is thus
+ * dropped and the thread is silently never created. Either reference
+ * `<name>_pid` from code that is linked anyway, or list the thread in the
+ * `THREAD_STATIC` make variable, which makes the linker pull it in:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * THREAD_STATIC += worker
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The descriptors are walked as an array, so each is declared with an
+ * explicit alignment, which keeps the compiler from padding them.
+ *
+ * @note    The section needs the `__start_` and `__stop_` symbols GNU ld
+ *          provides for sections without a linker script entry, as on
+ *          native. Ports with a linker script that places all input sections
+ *          define them there (see cortexm_base.ld). thread_static_init()
+ *          asserts that both symbols are there if one is. tests/thread_static
+ *          checks that the threads are created.
+ */
+
+#ifndef THREAD_STATIC_H
+#define THREAD_STATIC_H
+
+#include "kernel_types.h"
+#include "msg.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Descriptor of a statically declared thread
+ */
+typedef struct {
+    char *stack;                    /**< stack memory */
+    int stacksize;                  /**< size of stack */
+    uint8_t priority;               /**< priority of the thread */
+    int flags;                      /**< flags passed to thread_create() */
+    thread_task_func_t task_func;   /**< function the thread runs */
+    void *arg;                      /**< argument of task_func */
+    const char *name;               /**< name of the thread */
+    msg_t *msg_array;               /**< message queue or NULL */
+    unsigned msg_num;               /**< size of msg_array, a power of 2 */
+    kernel_pid_t *pid;              /**< PID of the created thread */
+} thread_static_t;
+
+/**
+ * @brief   Declare a thread, created at boot
+ *
+ * @param[in] name      name of the thread, also prefix of the variables
+ *                      declared (`<name>_pid` is global)
+ * @param[in] stacksize size of the thread's stack in bytes
+ * @param[in] priority  priority of the thread
+ * @param[in] flags     flags for thread_create(),
+ *                      THREAD_CREATE_WOUT_YIELD is implied
+ * @param[in] task_func function the thread runs
+ * @param[in] arg       argument of @p task_func
+ */
+#define THREAD_STATIC(name, stacksize, priority, flags, task_func, arg) \
+    _THREAD_STATIC(name, stacksize, priority, flags, task_func, arg, NULL, 0)
+
+/**
+ * @brief   Declare a thread with a message queue, created at boot
+ *
+ * @param[in] name      see @ref THREAD_STATIC
+ * @param[in] stacksize see @ref THREAD_STATIC
+ * @param[in] priority  see @ref THREAD_STATIC
+ * @param[in] flags     see @ref THREAD_STATIC
+ * @param[in] task_func see @ref THREAD_STATIC
+ * @param[in] arg       see @ref THREAD_STATIC
+ * @param[in] msg_num   size of the message queue, a power of 2
+ */
+#define THREAD_STATIC_MSG(name, stacksize, priority, flags, task_func, arg, \
+                          msg_num) \
+    static msg_t name ## _msg_array[msg_num]; \
+    _THREAD_STATIC(name, stacksize, priority, flags, task_func, arg, \
+                   name ## _msg_array, msg_num)
+
+/**
+ * @internal
+ * @brief   Declare stack, PID and descriptor of a static thread
+ */
+#define _THREAD_STATIC(name, stacksize, priority, flags, task_func, arg, \
+                       msgs, msg_num) \
+    static char name ## _stack[stacksize]; \
+    kernel_pid_t name ## _pid = KERNEL_PID_UNDEF; \
+    static const thread_static_t name ## _thread_static \
+    __attribute__((used, aligned(sizeof(void *)), \
+                   section("riot_thread_static"))) = { \
+        name ## _stack, sizeof(name ## _stack), (priority), (flags), \
+        (task_func), (arg), #name, (msgs), (msg_num), &name ## _pid \
+    }
+
+/**
+ * @brief   Create all statically declared threads
+ *
+ * @internal    called by kernel_init()
+ */
+void thread_static_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THREAD_STATIC_H */
+/** @} */
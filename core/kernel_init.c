@@ -25,6 +25,7 @@
 #include "kernel_init.h"
 #include "sched.h"
 #include "thread.h"
+#include "thread_static.h"
 #include "irq.h"
 #include "log.h"
 
@@ -41,13 +42,28 @@
 #include <auto_init.h>
 #endif
 
+#ifdef MODULE_BOOTPROF
+#include "bootprof.h"
+#endif
+
+#ifdef MODULE_THREADPROF
+#include "threadprof.h"
+#endif
+
 extern int main(void);
 static void *main_trampoline(void *arg)
 {
     (void) arg;
 
+#ifdef MODULE_BOOTPROF
+    bootprof_mark("kernel_init");
+#endif
+
 #ifdef MODULE_AUTO_INIT
     auto_init();
+#ifdef MODULE_BOOTPROF
+    bootprof_mark("auto_init");
+#endif
 #endif
 
 #ifdef MODULE_SCHEDSTATISTICS
@@ -66,6 +82,9 @@ static void *idle_thread(void *arg)
     (void) arg;
 
     while (1) {
+#ifdef MODULE_THREADPROF
+        threadprof_stack_sample();
+#endif
         pm_set_lowest();
     }
 
@@ -92,5 +111,7 @@ void kernel_init(void)
             THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
             main_trampoline, NULL, main_name);
 
+    thread_static_init();
+
     cpu_switch_context_exit();
 }
@@ -57,6 +57,22 @@ static void _wait(list_node_t *wait_list, unsigned irqstate)
             sched_active_pid);
 }
 
+static void _get_queued(mbox_t *mbox, msg_t *msg, unsigned irqstate)
+{
+    DEBUG("mbox: Thread %"PRIkernel_pid" mbox 0x%08x: _tryget(): "
+            "got queued message.\n", sched_active_pid, (unsigned)mbox);
+    /* copy msg from queue */
+    *msg = mbox->msg_array[cib_get_unsafe(&mbox->cib)];
+    list_node_t *next = (list_node_t*) list_remove_head(&mbox->writers);
+    if (next) {
+        thread_t *thread = container_of((clist_node_t*)next, thread_t, rq_entry);
+        _wake_waiter(thread, irqstate);
+    }
+    else {
+        irq_restore(irqstate);
+    }
+}
+
 int _mbox_put(mbox_t *mbox, msg_t *msg, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -67,6 +83,9 @@ int _mbox_put(mbox_t *mbox, msg_t *msg, int blocking)
                 "there's a waiter.\n", sched_active_pid, (unsigned)mbox);
         thread_t *thread = container_of((clist_node_t*)next, thread_t, rq_entry);
         *(msg_t *)thread->wait_data = *msg;
+        /* tell the reader the message was delivered, see
+         * _mbox_get_cancelable() */
+        thread->wait_data = NULL;
         _wake_waiter(thread, irqstate);
         return 1;
     }
@@ -97,18 +116,7 @@ int _mbox_get(mbox_t *mbox, msg_t *msg, int blocking)
     unsigned irqstate = irq_disable();
 
     if (cib_avail(&mbox->cib)) {
-        DEBUG("mbox: Thread %"PRIkernel_pid" mbox 0x%08x: _tryget(): "
-                "got queued message.\n", sched_active_pid, (unsigned)mbox);
-        /* copy msg from queue */
-        *msg = mbox->msg_array[cib_get_unsafe(&mbox->cib)];
-        list_node_t *next = (list_node_t*) list_remove_head(&mbox->writers);
-        if (next) {
-            thread_t *thread = container_of((clist_node_t*)next, thread_t, rq_entry);
-            _wake_waiter(thread, irqstate);
-        }
-        else {
-            irq_restore(irqstate);
-        }
+        _get_queued(mbox, msg, irqstate);
         return 1;
     }
     else if (blocking) {
@@ -123,4 +131,84 @@ int _mbox_get(mbox_t *mbox, msg_t *msg, int blocking)
     }
 }
 
+int _mbox_get_cancelable(mbox_t *mbox, msg_t *msg, volatile unsigned *canceled)
+{
+    unsigned irqstate = irq_disable();
+
+    if (cib_avail(&mbox->cib)) {
+        _get_queued(mbox, msg, irqstate);
+        return 1;
+    }
+    else if (*canceled) {
+        irq_restore(irqstate);
+        return 0;
+    }
+
+    sched_active_thread->wait_data = (void*)msg;
+    _wait(&mbox->readers, irqstate);
+    /* wait_data was cleared if a sender copied a message, it is left
+     * untouched if we were woken up by _mbox_cancel_get() */
+    return (sched_active_thread->wait_data == NULL);
+}
+
+void _mbox_cancel_get(mbox_t *mbox, thread_t *thread, volatile unsigned *canceled)
+{
+    unsigned irqstate = irq_disable();
+
+    *canceled = 1;
+    if (list_remove(&mbox->readers, (list_node_t *)&thread->rq_entry)) {
+        DEBUG("mbox: mbox 0x%08x: _mbox_cancel_get(): waking up "
+                "%"PRIkernel_pid".\n", (unsigned)mbox, thread->pid);
+        _wake_waiter(thread, irqstate);
+    }
+    else {
+        irq_restore(irqstate);
+    }
+}
+
+unsigned _mbox_get_many(mbox_t *mbox, msg_t *msgs, unsigned n, int blocking)
+{
+    unsigned irqstate = irq_disable();
+    unsigned count = 0;
+
+    while ((count < n) && cib_avail(&mbox->cib)) {
+        msgs[count++] = mbox->msg_array[cib_get_unsafe(&mbox->cib)];
+    }
+
+    if (count) {
+        DEBUG("mbox: Thread %"PRIkernel_pid" mbox 0x%08x: _mbox_get_many(): "
+                "got %u queued messages.\n", sched_active_pid, (unsigned)mbox,
+                count);
+        /* every freed slot lets one blocked writer proceed, but only switch
+         * context once */
+        uint16_t switch_prio = THREAD_PRIORITY_MIN + 1;
+        for (unsigned i = 0; i < count; i++) {
+            list_node_t *next = list_remove_head(&mbox->writers);
+            if (!next) {
+                break;
+            }
+            thread_t *thread = container_of((clist_node_t*)next, thread_t, rq_entry);
+            sched_set_status(thread, STATUS_PENDING);
+            if (thread->priority < switch_prio) {
+                switch_prio = thread->priority;
+            }
+        }
+        irq_restore(irqstate);
+        if (switch_prio <= THREAD_PRIORITY_MIN) {
+            sched_switch(switch_prio);
+        }
+        return count;
+    }
+    else if (blocking && n) {
+        sched_active_thread->wait_data = (void*)msgs;
+        _wait(&mbox->readers, irqstate);
+        /* sender has copied message */
+        return 1;
+    }
+    else {
+        irq_restore(irqstate);
+        return 0;
+    }
+}
+
 #endif /* MODULE_CORE_MBOX */
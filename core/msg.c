@@ -29,6 +29,13 @@
 #include "thread.h"
 #include "irq.h"
 #include "cib.h"
+#ifdef MODULE_NATIVE_TRACE
+#include "native_trace.h"
+#define TRACE(ev, pid, peer, m) \
+    native_trace_msg(NATIVE_TRACE_MSG_ ## ev, pid, peer, (m)->type)
+#else
+#define TRACE(ev, pid, peer, m)
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -39,7 +46,7 @@
 static int _msg_receive(msg_t *m, int block);
 static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state);
 
-static int queue_msg(thread_t *target, const msg_t *m)
+static int RAMFUNC queue_msg(thread_t *target, const msg_t *m)
 {
     int n = cib_put(&(target->msg_queue));
     if (n < 0) {
@@ -75,8 +82,11 @@ int msg_try_send(msg_t *m, kernel_pid_t target_pid)
     return _msg_send(m, target_pid, false, irq_disable());
 }
 
-static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned state)
+static int RAMFUNC _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
+                             unsigned state)
 {
+    TRACE(SEND, sched_active_pid, target_pid, m);
+
 #ifdef DEVELHELP
     if (!pid_is_valid(target_pid)) {
         DEBUG("msg_send(): target_pid is invalid, continuing anyways\n");
@@ -155,8 +165,12 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block, unsigned sta
         *target_message = *m;
         sched_set_status(target, STATUS_PENDING);
 
+        /* switches straight to the receiver if we are waiting for its reply
+         * (not on the runqueue anymore) or it has a higher priority, and
+         * spares the scheduler pass otherwise */
+        uint16_t target_prio = target->priority;
         irq_restore(state);
-        thread_yield_higher();
+        sched_switch(target_prio);
     }
 
     return 1;
@@ -166,6 +180,7 @@ int msg_send_to_self(msg_t *m)
 {
     unsigned state = irq_disable();
 
+    TRACE(SEND, sched_active_pid, sched_active_pid, m);
     m->sender_pid = sched_active_pid;
     int res = queue_msg((thread_t *) sched_active_thread, m);
 
@@ -173,8 +188,10 @@ int msg_send_to_self(msg_t *m)
     return res;
 }
 
-int msg_send_int(msg_t *m, kernel_pid_t target_pid)
+int RAMFUNC msg_send_int(msg_t *m, kernel_pid_t target_pid)
 {
+    TRACE(SEND, KERNEL_PID_ISR, target_pid, m);
+
 #ifdef DEVELHELP
     if (!pid_is_valid(target_pid)) {
         DEBUG("msg_send(): target_pid is invalid, continuing anyways\n");
@@ -239,6 +256,7 @@ int msg_reply(msg_t *m, msg_t *reply)
 
     DEBUG("msg_reply(): %" PRIkernel_pid ": Direct msg copy.\n",
           sched_active_thread->pid);
+    TRACE(SEND, sched_active_pid, target->pid, reply);
     /* copy msg to target */
     msg_t *target_message = (msg_t*) target->wait_data;
     *target_message = *reply;
@@ -260,6 +278,7 @@ int msg_reply_int(msg_t *m, msg_t *reply)
         return -1;
     }
 
+    TRACE(SEND, KERNEL_PID_ISR, target->pid, reply);
     msg_t *target_message = (msg_t*) target->wait_data;
     *target_message = *reply;
     sched_set_status(target, STATUS_PENDING);
@@ -267,17 +286,88 @@ int msg_reply_int(msg_t *m, msg_t *reply)
     return 1;
 }
 
+int msg_send_bulk(msg_t *m, unsigned n, kernel_pid_t target_pid)
+{
+    assert(n > 0);
+
+    if (!irq_is_in() && (sched_active_pid == target_pid)) {
+        unsigned state = irq_disable();
+        thread_t *me = (thread_t *) sched_active_thread;
+        unsigned i;
+        for (i = 0; i < n; i++) {
+            m[i].sender_pid = sched_active_pid;
+            if (!queue_msg(me, &m[i])) {
+                break;
+            }
+        }
+        irq_restore(state);
+        return i;
+    }
+
+#ifdef DEVELHELP
+    if (!pid_is_valid(target_pid)) {
+        DEBUG("msg_send_bulk(): target_pid is invalid, continuing anyways\n");
+    }
+#endif /* DEVELHELP */
+
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t *) sched_threads[target_pid];
+
+    if (target == NULL) {
+        DEBUG("msg_send_bulk(): target thread does not exist\n");
+        irq_restore(state);
+        return -1;
+    }
+
+    kernel_pid_t sender_pid = irq_is_in() ? KERNEL_PID_ISR : sched_active_pid;
+    unsigned i = 0;
+
+    if (target->status == STATUS_RECEIVE_BLOCKED) {
+        DEBUG("msg_send_bulk(): Direct msg copy to %" PRIkernel_pid ".\n",
+              target_pid);
+        m[0].sender_pid = sender_pid;
+        *((msg_t *) target->wait_data) = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        i++;
+    }
+
+    for (; i < n; i++) {
+        m[i].sender_pid = sender_pid;
+        if (!queue_msg(target, &m[i])) {
+            DEBUG("msg_send_bulk(): queue of %" PRIkernel_pid " full after "
+                  "%u messages\n", target_pid, i);
+            break;
+        }
+    }
+
+    uint16_t target_prio = target->priority;
+    irq_restore(state);
+    if (i > 0) {
+        sched_switch(target_prio);
+    }
+
+    return i;
+}
+
 int msg_try_receive(msg_t *m)
 {
-    return _msg_receive(m, 0);
+    int res = _msg_receive(m, 0);
+
+    if (res == 1) {
+        TRACE(RECV, sched_active_pid, m->sender_pid, m);
+    }
+    return res;
 }
 
 int msg_receive(msg_t *m)
 {
-    return _msg_receive(m, 1);
+    int res = _msg_receive(m, 1);
+
+    TRACE(RECV, sched_active_pid, m->sender_pid, m);
+    return res;
 }
 
-static int _msg_receive(msg_t *m, int block)
+static int RAMFUNC _msg_receive(msg_t *m, int block)
 {
     unsigned state = irq_disable();
     DEBUG("_msg_receive: %" PRIkernel_pid ": _msg_receive.\n",
@@ -363,6 +453,60 @@ static int _msg_receive(msg_t *m, int block)
     DEBUG("This should have never been reached!\n");
 }
 
+int msg_receive_bulk(msg_t *m, unsigned n)
+{
+    assert(n > 0);
+
+    unsigned state = irq_disable();
+    thread_t *me = (thread_t *) sched_active_thread;
+    unsigned count = 0;
+
+    if (!me->msg_array || !cib_avail(&(me->msg_queue))) {
+        irq_restore(state);
+        /* nothing queued: take the regular (possibly blocking) path */
+        _msg_receive(m, 1);
+        if ((n == 1) || !me->msg_array) {
+            return 1;
+        }
+        /* a bulk sender might have queued more messages while we were
+         * blocked */
+        state = irq_disable();
+        count = 1;
+    }
+
+    int queue_index;
+    while ((count < n) && ((queue_index = cib_get(&(me->msg_queue))) >= 0)) {
+        m[count++] = me->msg_array[queue_index];
+    }
+
+    /* refill the just freed queue space from blocked senders, so they can
+     * be released with one single context switch */
+    uint16_t max_prio = THREAD_PRIORITY_IDLE;
+    list_node_t *next;
+    while (!cib_full(&(me->msg_queue)) &&
+           ((next = list_remove_head(&me->msg_waiters)) != NULL)) {
+        thread_t *sender = container_of((clist_node_t *)next, thread_t,
+                                        rq_entry);
+        msg_t *sender_msg = (msg_t *) sender->wait_data;
+        me->msg_array[cib_put(&(me->msg_queue))] = *sender_msg;
+
+        if (sender->status != STATUS_REPLY_BLOCKED) {
+            sender->wait_data = NULL;
+            sched_set_status(sender, STATUS_PENDING);
+            if (sender->priority < max_prio) {
+                max_prio = sender->priority;
+            }
+        }
+    }
+
+    irq_restore(state);
+    if (max_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(max_prio);
+    }
+
+    return count;
+}
+
 int msg_avail(void)
 {
     DEBUG("msg_available: %" PRIkernel_pid ": msg_available.\n",
@@ -35,6 +35,46 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_CORE_MUTEX_PI
+static inline void _set_owner(mutex_t *mutex, thread_t *thread)
+{
+    mutex->owner = thread->pid;
+    mutex->owner_prio = thread->priority;
+}
+
+static inline void _inherit_priority(mutex_t *mutex, thread_t *waiter)
+{
+    if (mutex->owner == KERNEL_PID_UNDEF) {
+        return;
+    }
+    thread_t *owner = (thread_t *)sched_threads[mutex->owner];
+    if (owner && (owner->priority > waiter->priority)) {
+        DEBUG("PID[%" PRIkernel_pid "]: boosting owner %" PRIkernel_pid
+              " to prio %" PRIu32 "\n", waiter->pid, owner->pid,
+              (uint32_t)waiter->priority);
+        sched_change_priority(owner, waiter->priority);
+    }
+}
+
+/* returns 1 if the priority of the current thread was lowered */
+static inline int _disinherit_priority(mutex_t *mutex)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+    int res = 0;
+    if ((mutex->owner == sched_active_pid) &&
+        (me->priority != mutex->owner_prio)) {
+        sched_change_priority(me, mutex->owner_prio);
+        res = 1;
+    }
+    mutex->owner = KERNEL_PID_UNDEF;
+    return res;
+}
+#else
+#define _set_owner(mutex, thread)           (void)(mutex)
+#define _inherit_priority(mutex, waiter)    (void)(mutex)
+#define _disinherit_priority(mutex)         (0)
+#endif
+
 int _mutex_lock(mutex_t *mutex, int blocking)
 {
     unsigned irqstate = irq_disable();
@@ -44,6 +84,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        _set_owner(mutex, (thread_t *)sched_active_thread);
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -61,6 +102,7 @@ int _mutex_lock(mutex_t *mutex, int blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+        _inherit_priority(mutex, me);
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
@@ -86,10 +128,16 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+    int lowered = _disinherit_priority(mutex);
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
         irq_restore(irqstate);
+        if (lowered) {
+            /* a thread we were shadowing while boosted might be runnable */
+            sched_switch(0);
+        }
         return;
     }
 
@@ -100,6 +148,7 @@ void mutex_unlock(mutex_t *mutex)
     DEBUG("mutex_unlock: waking up waiting thread %" PRIkernel_pid "\n",
           process->pid);
     sched_set_status(process, STATUS_PENDING);
+    _set_owner(mutex, process);
 
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
@@ -117,6 +166,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+        (void)_disinherit_priority(mutex);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -126,6 +176,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
                                              rq_entry);
             DEBUG("PID[%" PRIkernel_pid "]: waking up waiter.\n", process->pid);
             sched_set_status(process, STATUS_PENDING);
+            _set_owner(mutex, process);
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
@@ -37,6 +37,18 @@
 #include "xtimer.h"
 #endif
 
+#ifdef MODULE_SCHED_ROUND_ROBIN
+#include "sched_round_robin.h"
+#endif
+
+#ifdef MODULE_SCHED_EDF
+#include "sched_edf.h"
+#endif
+
+#ifdef MODULE_THREADPROF
+#include "threadprof.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -55,14 +67,80 @@ volatile thread_t *sched_active_thread;
 volatile kernel_pid_t sched_active_pid = KERNEL_PID_UNDEF;
 
 clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
-static uint32_t runqueue_bitcache = 0;
+
+/* bitarithm_lsb() operates on `unsigned`, so that is the word size of the
+ * runqueue bitmap */
+#if ARCH_32_BIT
+#define RUNQUEUE_WORD_SHIFT (5)
+#else
+#define RUNQUEUE_WORD_SHIFT (4)
+#endif
+#define RUNQUEUE_WORD_BITS  (1 << RUNQUEUE_WORD_SHIFT)
+#define RUNQUEUE_WORD_MASK  (RUNQUEUE_WORD_BITS - 1)
+
+#if SCHED_PRIO_LEVELS <= RUNQUEUE_WORD_BITS
+static unsigned runqueue_bitcache = 0;
+
+static inline void _runqueue_set(uint8_t prio)
+{
+    runqueue_bitcache |= 1U << prio;
+}
+
+static inline void _runqueue_clear(uint8_t prio)
+{
+    runqueue_bitcache &= ~(1U << prio);
+}
+
+static inline int _runqueue_first(void)
+{
+    return bitarithm_lsb(runqueue_bitcache);
+}
+#else
+/* Two-level bitmap: bit n of runqueue_groupcache is set iff
+ * runqueue_bitcache[n] is non-zero, so finding the highest priority
+ * runnable level takes two LSB lookups regardless of SCHED_PRIO_LEVELS. */
+#define RUNQUEUE_GROUPS     ((SCHED_PRIO_LEVELS + RUNQUEUE_WORD_MASK) >> RUNQUEUE_WORD_SHIFT)
+
+#if RUNQUEUE_GROUPS > RUNQUEUE_WORD_BITS
+#error "SCHED_PRIO_LEVELS too large for a two-level runqueue bitmap"
+#endif
+
+static unsigned runqueue_bitcache[RUNQUEUE_GROUPS];
+static unsigned runqueue_groupcache = 0;
+
+static inline void _runqueue_set(uint8_t prio)
+{
+    unsigned group = prio >> RUNQUEUE_WORD_SHIFT;
+
+    runqueue_bitcache[group] |= 1U << (prio & RUNQUEUE_WORD_MASK);
+    runqueue_groupcache |= 1U << group;
+}
+
+static inline void _runqueue_clear(uint8_t prio)
+{
+    unsigned group = prio >> RUNQUEUE_WORD_SHIFT;
+
+    runqueue_bitcache[group] &= ~(1U << (prio & RUNQUEUE_WORD_MASK));
+    if (!runqueue_bitcache[group]) {
+        runqueue_groupcache &= ~(1U << group);
+    }
+}
+
+static inline int _runqueue_first(void)
+{
+    unsigned group = bitarithm_lsb(runqueue_groupcache);
+
+    return (group << RUNQUEUE_WORD_SHIFT) |
+           bitarithm_lsb(runqueue_bitcache[group]);
+}
+#endif
 
 #ifdef MODULE_SCHEDSTATISTICS
 static void (*sched_cb) (uint32_t timestamp, uint32_t value) = NULL;
 schedstat sched_pidlist[KERNEL_PID_LAST + 1];
 #endif
 
-int __attribute__((used)) sched_run(void)
+int __attribute__((used)) RAMFUNC sched_run(void)
 {
     sched_context_switch_request = 0;
 
@@ -71,13 +149,22 @@ int __attribute__((used)) sched_run(void)
     /* The bitmask in runqueue_bitcache is never empty,
      * since the threading should not be started before at least the idle thread was started.
      */
-    int nextrq = bitarithm_lsb(runqueue_bitcache);
+    int nextrq = _runqueue_first();
+#ifdef MODULE_SCHED_EDF
+    if (nextrq == SCHED_EDF_PRIO) {
+        sched_edf_update(&sched_runqueues[nextrq]);
+    }
+#endif
     thread_t *next_thread = container_of(sched_runqueues[nextrq].next->next, thread_t, rq_entry);
 
     DEBUG("sched_run: active thread: %" PRIkernel_pid ", next thread: %" PRIkernel_pid "\n",
           (active_thread == NULL) ? KERNEL_PID_UNDEF : active_thread->pid,
           next_thread->pid);
 
+#ifdef MODULE_SCHED_ROUND_ROBIN
+    sched_round_robin_update(next_thread);
+#endif
+
     if (active_thread == next_thread) {
         DEBUG("sched_run: done, sched_active_thread was not changed.\n");
         return 0;
@@ -120,13 +207,7 @@ int __attribute__((used)) sched_run(void)
     sched_active_thread = (volatile thread_t *) next_thread;
 
 #ifdef MODULE_MPU_STACK_GUARD
-    mpu_configure(
-        1,                                                /* MPU region 1 */
-        (uintptr_t)sched_active_thread->stack_start + 31, /* Base Address (rounded up) */
-        MPU_ATTR(1, AP_RO_RO, 0, 1, 0, 1, MPU_SIZE_32B)   /* Attributes and Size */
-    );
-
-    mpu_enable();
+    mpu_stack_guard((uintptr_t)next_thread->stack_start);
 #endif
 
     DEBUG("sched_run: done, changed sched_active_thread.\n");
@@ -141,14 +222,14 @@ void sched_register_cb(void (*callback)(uint32_t, uint32_t))
 }
 #endif
 
-void sched_set_status(thread_t *process, unsigned int status)
+void RAMFUNC sched_set_status(thread_t *process, unsigned int status)
 {
     if (status >= STATUS_ON_RUNQUEUE) {
         if (!(process->status >= STATUS_ON_RUNQUEUE)) {
             DEBUG("sched_set_status: adding thread %" PRIkernel_pid " to runqueue %" PRIu16 ".\n",
                   process->pid, process->priority);
             clist_rpush(&sched_runqueues[process->priority], &(process->rq_entry));
-            runqueue_bitcache |= 1 << process->priority;
+            _runqueue_set(process->priority);
         }
     }
     else {
@@ -158,7 +239,7 @@ void sched_set_status(thread_t *process, unsigned int status)
             clist_lpop(&sched_runqueues[process->priority]);
 
             if (!sched_runqueues[process->priority].next) {
-                runqueue_bitcache &= ~(1 << process->priority);
+                _runqueue_clear(process->priority);
             }
         }
     }
@@ -166,7 +247,34 @@ void sched_set_status(thread_t *process, unsigned int status)
     process->status = status;
 }
 
-void sched_switch(uint16_t other_prio)
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    if (thread->priority == priority) {
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid ": %" PRIu16
+          " -> %" PRIu16 "\n", thread->pid, thread->priority, priority);
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        clist_remove(&sched_runqueues[thread->priority], &(thread->rq_entry));
+        if (!sched_runqueues[thread->priority].next) {
+            _runqueue_clear(thread->priority);
+        }
+
+        if (thread == sched_active_thread) {
+            clist_lpush(&sched_runqueues[priority], &(thread->rq_entry));
+        }
+        else {
+            clist_rpush(&sched_runqueues[priority], &(thread->rq_entry));
+        }
+        _runqueue_set(priority);
+    }
+
+    thread->priority = priority;
+}
+
+void RAMFUNC sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *) sched_active_thread;
     uint16_t current_prio = active_thread->priority;
@@ -176,7 +284,13 @@ void sched_switch(uint16_t other_prio)
           ", other_prio=%" PRIu16 "\n",
           active_thread->pid, current_prio, on_runqueue, other_prio);
 
-    if (!on_runqueue || (current_prio > other_prio)) {
+    if (!on_runqueue || (current_prio > other_prio)
+#ifdef MODULE_SCHED_EDF
+        /* equal priorities only preempt among deadline threads */
+        || ((current_prio == other_prio) && (other_prio == SCHED_EDF_PRIO) &&
+            sched_edf_preempt())
+#endif
+        ) {
         if (irq_is_in()) {
             DEBUG("sched_switch: setting sched_context_switch_request.\n");
             sched_context_switch_request = 1;
@@ -196,6 +310,9 @@ NORETURN void sched_task_exit(void)
     DEBUG("sched_task_exit: ending thread %" PRIkernel_pid "...\n", sched_active_thread->pid);
 
     (void) irq_disable();
+#ifdef MODULE_THREADPROF
+    threadprof_thread_exit();
+#endif
     sched_threads[sched_active_pid] = NULL;
     sched_num_threads--;
 
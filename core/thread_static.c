@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_thread
+ * @{
+ *
+ * @file
+ * @brief       Creation of statically declared threads
+ *
+ * @}
+ */
+
+#include "assert.h"
+#include "cib.h"
+#include "thread_static.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* provided by the linker, undefined if no thread is declared */
+extern const thread_static_t __start_riot_thread_static[] __attribute__((weak));
+extern const thread_static_t __stop_riot_thread_static[] __attribute__((weak));
+
+void thread_static_init(void)
+{
+    /* both or none must be provided, and without padding in between */
+    assert((__start_riot_thread_static == NULL) ==
+           (__stop_riot_thread_static == NULL));
+    assert(((uintptr_t)__stop_riot_thread_static -
+            (uintptr_t)__start_riot_thread_static) %
+           sizeof(thread_static_t) == 0);
+
+    for (const thread_static_t *t = __start_riot_thread_static;
+         t < __stop_riot_thread_static; t++) {
+        kernel_pid_t pid = thread_create(t->stack, t->stacksize, t->priority,
+                                         t->flags | THREAD_CREATE_WOUT_YIELD,
+                                         t->task_func, t->arg, t->name);
+
+        assert(pid > KERNEL_PID_UNDEF);
+        *t->pid = pid;
+#ifdef MODULE_CORE_MSG
+        if (t->msg_array) {
+            thread_t *thread = (thread_t *)sched_threads[pid];
+
+            thread->msg_array = t->msg_array;
+            cib_init(&thread->msg_queue, t->msg_num);
+        }
+#endif
+        DEBUG("thread_static_init: created %s, pid %" PRIkernel_pid "\n",
+              t->name, pid);
+    }
+}
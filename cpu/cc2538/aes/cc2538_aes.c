@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_cc2538
+ * @{
+ *
+ * @file
+ * @brief       AES-128 backend for the crypto ciphers API
+ *
+ * The engine reads the key from its key store, which is only reloaded if a
+ * different key than the last one is used. Data is moved by the engine's own
+ * DMA, so any number of blocks is handled by a single operation.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "cpu.h"
+#include "mutex.h"
+#include "cc2538_aes.h"
+#include "crypto/aes.h"
+#include "crypto/ciphers.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define KEY_AREA        (0U)
+#define ERRORS          (AES_CTRL_INT_KEY_ST_WR_ERR | \
+                         AES_CTRL_INT_KEY_ST_RD_ERR | \
+                         AES_CTRL_INT_DMA_BUS_ERR)
+
+static mutex_t _lock = MUTEX_INIT;
+static uint8_t _key[AES_KEY_SIZE];
+static int _key_loaded;
+
+/* waits for the current operation, returns 0 on success */
+static int _finish(void)
+{
+    uint32_t stat;
+
+    while (!((stat = AES_CTRL_INT_STAT) & AES_CTRL_INT_RESULT_AV)) {
+        if (stat & ERRORS) {
+            break;
+        }
+    }
+    AES_CTRL_INT_CLR = AES_CTRL_INT_RESULT_AV | AES_CTRL_INT_DMA_IN_DONE |
+                       (stat & ERRORS);
+    AES_CTRL_ALG_SEL = 0;
+    return (stat & ERRORS) ? -1 : 0;
+}
+
+static int _load_key(const uint8_t *key)
+{
+    if (_key_loaded && (memcmp(_key, key, AES_KEY_SIZE) == 0)) {
+        return 0;
+    }
+    _key_loaded = 0;
+    AES_CTRL_ALG_SEL = AES_CTRL_ALG_SEL_KEYSTORE;
+    AES_CTRL_INT_CLR = AES_CTRL_INT_RESULT_AV | AES_CTRL_INT_DMA_IN_DONE;
+    AES_KEY_STORE_SIZE = AES_KEY_STORE_SIZE_128;
+    AES_KEY_STORE_WRITTEN_AREA = (1 << KEY_AREA);
+    AES_KEY_STORE_WRITE_AREA = (1 << KEY_AREA);
+    AES_DMAC_CH0_CTRL = AES_DMAC_CH_CTRL_EN;
+    AES_DMAC_CH0_EXTADDR = (uint32_t)key;
+    AES_DMAC_CH0_DMALENGTH = AES_KEY_SIZE;
+    if ((_finish() < 0) || !(AES_KEY_STORE_WRITTEN_AREA & (1 << KEY_AREA))) {
+        DEBUG("cc2538_aes: loading the key failed\n");
+        return -1;
+    }
+    memcpy(_key, key, AES_KEY_SIZE);
+    _key_loaded = 1;
+    return 0;
+}
+
+static int _crypt(const cipher_context_t *ctx, const uint8_t *input,
+                  uint8_t *output, size_t length, int encrypt)
+{
+    int res = -1;
+
+    if ((length == 0) || (length % AES_BLOCK_SIZE)) {
+        return (length == 0) ? 0 : CIPHER_ERR_INVALID_LENGTH;
+    }
+
+    mutex_lock(&_lock);
+    if (_load_key(ctx->context) == 0) {
+        AES_CTRL_ALG_SEL = AES_CTRL_ALG_SEL_AES;
+        AES_CTRL_INT_CLR = AES_CTRL_INT_RESULT_AV | AES_CTRL_INT_DMA_IN_DONE;
+        AES_KEY_STORE_READ_AREA = KEY_AREA;
+        while (AES_KEY_STORE_READ_AREA & AES_KEY_STORE_READ_AREA_BUSY) {}
+        /* ECB, so all blocks are processed independently */
+        AES_AES_CTRL = encrypt ? AES_AES_CTRL_DIRECTION_ENCRYPT : 0;
+        AES_AES_C_LENGTH_0 = length;
+        AES_AES_C_LENGTH_1 = 0;
+        AES_DMAC_CH0_CTRL = AES_DMAC_CH_CTRL_EN;
+        AES_DMAC_CH0_EXTADDR = (uint32_t)input;
+        AES_DMAC_CH0_DMALENGTH = length;
+        AES_DMAC_CH1_CTRL = AES_DMAC_CH_CTRL_EN;
+        AES_DMAC_CH1_EXTADDR = (uint32_t)output;
+        AES_DMAC_CH1_DMALENGTH = length;
+        res = _finish();
+    }
+    mutex_unlock(&_lock);
+
+    if (res < 0) {
+        return encrypt ? CIPHER_ERR_ENC_FAILED : CIPHER_ERR_DEC_FAILED;
+    }
+    return length;
+}
+
+static int _init(cipher_context_t *ctx, const uint8_t *key, uint8_t key_size)
+{
+    /* the engine is limited to the key sizes of the software implementation
+     * here, which the context has room for */
+    if (key_size != AES_KEY_SIZE) {
+        return CIPHER_ERR_INVALID_KEY_SIZE;
+    }
+    memcpy(ctx->context, key, AES_KEY_SIZE);
+    return CIPHER_INIT_SUCCESS;
+}
+
+static int _encrypt(const cipher_context_t *ctx, const uint8_t *plain,
+                    uint8_t *cipher)
+{
+    return (_crypt(ctx, plain, cipher, AES_BLOCK_SIZE, 1) < 0) ? -1 : 1;
+}
+
+static int _decrypt(const cipher_context_t *ctx, const uint8_t *cipher,
+                    uint8_t *plain)
+{
+    return (_crypt(ctx, cipher, plain, AES_BLOCK_SIZE, 0) < 0) ? -1 : 1;
+}
+
+static int _encrypt_blocks(const cipher_context_t *ctx, const uint8_t *input,
+                           uint8_t *output, size_t length)
+{
+    return _crypt(ctx, input, output, length, 1);
+}
+
+static int _decrypt_blocks(const cipher_context_t *ctx, const uint8_t *input,
+                           uint8_t *output, size_t length)
+{
+    return _crypt(ctx, input, output, length, 0);
+}
+
+static const cipher_interface_t _interface = {
+    AES_BLOCK_SIZE,
+    AES_KEY_SIZE,
+    _init,
+    _encrypt,
+    _decrypt,
+    _encrypt_blocks,
+    _decrypt_blocks
+};
+
+static cipher_backend_t _backend;
+
+void cc2538_aes_init(void)
+{
+    SYS_CTRL_RCGCSEC |= SYS_CTRL_SEC_AES;
+    SYS_CTRL_SCGCSEC |= SYS_CTRL_SEC_AES;
+    AES_CTRL_INT_CFG = AES_CTRL_INT_CFG_LEVEL;
+    AES_CTRL_INT_EN = AES_CTRL_INT_RESULT_AV | AES_CTRL_INT_DMA_IN_DONE;
+
+    _backend.cipher = CIPHER_AES_128;
+    _backend.interface = &_interface;
+    cipher_register_backend(&_backend);
+}
@@ -20,6 +20,9 @@
 #include <assert.h>
 
 #include "cpu.h"
+#ifdef MODULE_CC2538_AES
+#include "cc2538_aes.h"
+#endif
 
 #define BIT(n)          ( 1UL << (n) )
 
@@ -47,6 +50,10 @@ void cpu_init(void)
     SYS_CTRL->I_MAP = 1;
     /* initialize the clock system */
     cpu_clock_init();
+#ifdef MODULE_CC2538_AES
+    /* make the AES engine available to the crypto ciphers API */
+    cc2538_aes_init();
+#endif
 }
 
 /**
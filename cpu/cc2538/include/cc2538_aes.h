@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_cc2538
+ * @{
+ *
+ * @file
+ * @brief       AES-128 backend for the crypto ciphers API using the CC2538's
+ *              AES engine
+ */
+
+#ifndef CC2538_AES_H
+#define CC2538_AES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    AES engine register bits
+ * @{
+ */
+#define AES_CTRL_ALG_SEL_KEYSTORE       (0x00000001)
+#define AES_CTRL_ALG_SEL_AES            (0x00000002)
+#define AES_CTRL_INT_RESULT_AV          (0x00000001)
+#define AES_CTRL_INT_DMA_IN_DONE        (0x00000002)
+#define AES_CTRL_INT_KEY_ST_WR_ERR      (0x20000000)
+#define AES_CTRL_INT_KEY_ST_RD_ERR      (0x40000000)
+#define AES_CTRL_INT_DMA_BUS_ERR        (0x80000000)
+#define AES_CTRL_INT_CFG_LEVEL          (0x00000001)
+#define AES_KEY_STORE_SIZE_128          (0x00000001)
+#define AES_KEY_STORE_READ_AREA_BUSY    (0x80000000)
+#define AES_AES_CTRL_DIRECTION_ENCRYPT  (0x00000004)
+#define AES_DMAC_CH_CTRL_EN             (0x00000001)
+#define SYS_CTRL_SEC_AES                (0x00000002)
+/** @} */
+
+/**
+ * @brief   Registers the AES engine as backend for CIPHER_AES_128
+ *
+ * Called by cpu_init() if the cc2538_aes module is used.
+ */
+void cc2538_aes_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC2538_AES_H */
+/** @} */
@@ -46,3 +46,32 @@ int atomic_cas(atomic_int_t *var, int old, int now)
     return (status == 0);
 }
 #endif
+
+#if ARCH_HAS_ATOMIC_FETCH_ADD
+int atomic_fetch_add(atomic_int_t *var, int val)
+{
+    volatile uint32_t *ptr = (volatile uint32_t *)(&ATOMIC_VALUE(*var));
+    uint32_t old;
+
+    /* retry if the exclusive access was lost to an interrupt in between */
+    do {
+        old = __LDREXW(ptr);
+    } while (__STREXW(old + (uint32_t)val, ptr) != 0);
+
+    return (int)old;
+}
+#endif
+
+#if ARCH_HAS_ATOMIC_SWAP
+int atomic_swap(atomic_int_t *var, int now)
+{
+    volatile uint32_t *ptr = (volatile uint32_t *)(&ATOMIC_VALUE(*var));
+    uint32_t old;
+
+    do {
+        old = __LDREXW(ptr);
+    } while (__STREXW((uint32_t)now, ptr) != 0);
+
+    return (int)old;
+}
+#endif
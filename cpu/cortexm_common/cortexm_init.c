@@ -19,6 +19,9 @@
  */
 
 #include "cpu.h"
+#ifdef MODULE_MPU_STACK_GUARD
+#include "mpu.h"
+#endif
 
 /**
  * @name   Pattern to write into the co-processor Access Control Register to
@@ -32,6 +35,11 @@ void cortexm_init(void)
 #ifdef CPU_ARCH_CORTEX_M4F
     /* give full access to the FPU */
     SCB->CPACR |= (uint32_t)FULL_FPU_ACCESS;
+#ifdef __ARM_FP
+    /* make sure automatic and lazy FPU state preservation are enabled (the
+     * reset default), the context switch relies on it */
+    FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk;
+#endif
 #endif
 
     /* configure the vector table location to internal flash */
@@ -60,4 +68,9 @@ void cortexm_init(void)
 #ifdef SCB_CCR_STKALIGN_Msk
     SCB->CCR |= SCB_CCR_STKALIGN_Msk;
 #endif
+
+#ifdef MODULE_MPU_STACK_GUARD
+    /* the scheduler only moves the thread stack guard region */
+    mpu_enable();
+#endif
 }
@@ -48,6 +48,8 @@ extern "C" {
 #if defined(CPU_ARCH_CORTEX_M3) || defined(CPU_ARCH_CORTEX_M4) || \
     defined(CPU_ARCH_CORTEX_M4F)
 #define ARCH_HAS_ATOMIC_COMPARE_AND_SWAP 1
+#define ARCH_HAS_ATOMIC_FETCH_ADD 1
+#define ARCH_HAS_ATOMIC_SWAP 1
 #endif
 
 /**
@@ -156,6 +156,34 @@ bool mpu_enabled(void);
  */
 int mpu_configure(uint_fast8_t region, uintptr_t base, uint_fast32_t attr);
 
+/**
+ * @brief MPU region guarding the stack of the running thread
+ */
+#define MPU_STACK_GUARD_REGION  (1U)
+
+/**
+ * @brief move the stack guard region to the stack of the next thread
+ *
+ * Called by the scheduler on every context switch. Setting the VALID bit of
+ * RBAR selects the region, so instead of the read-modify-write sequence of
+ * mpu_configure() and mpu_enable() this is two consecutive stores. The MPU
+ * is enabled once by cortexm_init().
+ *
+ * @param[in]   stack_start lowest address of the stack, the guard covers the
+ *                          first 32 byte aligned block
+ */
+static inline void mpu_stack_guard(uintptr_t stack_start)
+{
+#if __MPU_PRESENT
+    MPU->RBAR = ((stack_start + 31) & MPU_RBAR_ADDR_Msk) |
+                MPU_RBAR_VALID_Msk | MPU_STACK_GUARD_REGION;
+    MPU->RASR = MPU_ATTR(1, AP_RO_RO, 0, 1, 0, 1, MPU_SIZE_32B) |
+                MPU_RASR_ENABLE_Msk;
+#else
+    (void)stack_start;
+#endif
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -82,7 +82,19 @@
  * | RET  | <- exception return code
  * -------- lowest address (top of stack)
  *
- * TODO: Implement handling of FPU registers for Cortex-M4 CPUs
+ * On CPUs with FPU, when compiled with FPU support (`__ARM_FP`, see
+ * `CFLAGS_FPU`), the FPU context is handled lazily: the hardware marks in
+ * bit 4 of the exception return code whether the interrupted thread has used
+ * the FPU, and only reserves room for S0-S15 and FPSCR in that case (lazy
+ * stacking, see FPCCR). The context switch then additionally saves S16-S31
+ * between the hardware-stacked frame and R11-R4. The exception return code
+ * kept on each thread's stack therefore acts as a per-thread "uses FPU" flag,
+ * and threads that never touch the FPU do not need any extra stack space for
+ * it.
+ *
+ * Exceptions always execute on the main stack (MSP), threads on the process
+ * stack (PSP). So only the first, hardware-stacked exception frame lands on a
+ * thread's stack, nested interrupts never do.
  *
  *
  * @author      Stefan Pfeiffer <stefan.pfeiffer@fu-berlin.de>
@@ -149,21 +161,8 @@ char *thread_arch_stack_init(thread_task_func_t task_func,
         *stk = ~((uint32_t)STACK_MARKER);
     }
 
-#ifdef CPU_ARCH_CORTEX_M4F
-    /* TODO: fix FPU handling for Cortex-M4f */
-    /*
-    stk--;
-    *stk = (unsigned int) 0;
-    */
-
-    /* S0 - S15 */
-    /*
-    for (int i = 15; i >= 0; i--) {
-        stk--;
-        *stk = i;
-    }
-    */
-#endif
+    /* no FPU context is stacked for a new thread, as its initial exception
+     * return code marks it as not using the FPU (yet) */
 
     /* ****************************** */
     /* Automatically popped registers */
@@ -289,14 +288,14 @@ __attribute__((naked)) void NORETURN thread_arch_start_threading(void)
     :::);
 }
 
-void thread_arch_yield(void)
+void RAMFUNC thread_arch_yield(void)
 {
     /* trigger the PENDSV interrupt to run scheduler and schedule new thread if
      * applicable */
     SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
 }
 
-void __attribute__((naked)) __attribute__((used)) isr_pendsv(void) {
+void __attribute__((naked)) __attribute__((used)) RAMFUNC isr_pendsv(void) {
     __asm__ volatile (
     /* PendSV handler entry point */
     /* save context by pushing unsaved registers to the stack */
@@ -318,11 +317,13 @@ void __attribute__((naked)) __attribute__((used)) isr_pendsv(void) {
     "mov    r0, sp                    \n" /* switch back to the exception SP */
     "mov    sp, r12                   \n"
 #else
+#ifdef __ARM_FP
+    "tst    lr, #0x10                 \n" /* did the thread use the FPU? */
+    "it     eq                        \n"
+    "vstmdbeq r0!, {s16-s31}          \n" /* then save remaining FPU regs */
+#endif
     "stmdb  r0!,{r4-r11}              \n" /* save regs */
     "stmdb  r0!,{lr}                  \n" /* exception return value */
-#ifdef CPU_ARCH_CORTEX_M4F
-/*  "vstmdb sp!, {s16-s31}            \n" */ /* TODO save FPU registers */
-#endif
 #endif
     "ldr    r1, =sched_active_thread  \n" /* load address of current tcb */
     "ldr    r1, [r1]                  \n" /* dereference pdc */
@@ -331,7 +332,7 @@ void __attribute__((naked)) __attribute__((used)) isr_pendsv(void) {
     );
 }
 
-void __attribute__((naked)) __attribute__((used)) isr_svc(void) {
+void __attribute__((naked)) __attribute__((used)) RAMFUNC isr_svc(void) {
     __asm__ volatile (
     /* SVC handler entry point */
     /* PendSV will continue here as well (via jump) */
@@ -365,10 +366,12 @@ void __attribute__((naked)) __attribute__((used)) isr_svc(void) {
     "ldr    r0, [r0]                  \n" /* dereference TCB */
     "ldr    r1, [r0]                  \n" /* load tcb->sp to register 1 */
     "ldmia  r1!, {r0}                 \n" /* restore exception return value */
-#ifdef CPU_ARCH_CORTEX_M4F
-/*  "pop    {s16-s31}                 \n" */ /* TODO load FPU registers */
-#endif
     "ldmia  r1!, {r4-r11}             \n" /* restore other registers */
+#ifdef __ARM_FP
+    "tst    r0, #0x10                 \n" /* did the thread use the FPU? */
+    "it     eq                        \n"
+    "vldmiaeq r1!, {s16-s31}          \n" /* then restore remaining FPU regs */
+#endif
     "msr    psp, r1                   \n" /* restore user mode SP to PSP reg */
     "bx     r0                        \n" /* load exception return value to PC,
                                            * causes end of exception*/
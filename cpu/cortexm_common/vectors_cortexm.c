@@ -32,6 +32,10 @@
 #include "panic.h"
 #include "vectors_cortexm.h"
 
+#ifdef MODULE_BOOTPROF
+#include "bootprof.h"
+#endif
+
 #ifndef SRAM_BASE
 #define SRAM_BASE 0
 #endif
@@ -77,6 +81,10 @@ void reset_handler_default(void)
     uint32_t *dst;
     uint32_t *src = &_etext;
 
+#ifdef MODULE_BOOTPROF
+    bootprof_start();
+#endif
+
     pre_startup();
 
 #ifdef DEVELHELP
@@ -98,6 +106,9 @@ void reset_handler_default(void)
     for (dst = &_szero; dst < &_ezero; ) {
         *(dst++) = 0;
     }
+#ifdef MODULE_BOOTPROF
+    bootprof_mark("ram_init");
+#endif
 
 #ifdef MODULE_MPU_STACK_GUARD
     if (((uintptr_t)&_sstack) != SRAM_BASE) {
@@ -115,6 +126,9 @@ void reset_handler_default(void)
 
     /* initialize the board (which also initiates CPU initialization) */
     board_init();
+#ifdef MODULE_BOOTPROF
+    bootprof_mark("board_init");
+#endif
 
 #if MODULE_NEWLIB
     /* initialize std-c library (this must be done after board_init) */
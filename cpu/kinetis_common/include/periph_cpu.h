@@ -45,6 +45,11 @@ typedef uint16_t gpio_t;
  */
 #define GPIO_PIN(x, y)      (((x + 1) << 12) | (x << 6) | y)
 
+/**
+ * @brief   Several pins of a port can be accessed at once, see gpio_port_read()
+ */
+#define PERIPH_GPIO_HAS_PORT
+
 /**
  * @brief   Length of the CPU_ID in octets
  */
@@ -283,6 +283,32 @@ void gpio_write(gpio_t pin, int value)
     }
 }
 
+uint32_t gpio_port_read(gpio_t port)
+{
+    return gpio(port)->PDIR;
+}
+
+void gpio_port_set(gpio_t port, uint32_t mask)
+{
+    gpio(port)->PSOR = mask;
+}
+
+void gpio_port_clear(gpio_t port, uint32_t mask)
+{
+    gpio(port)->PCOR = mask;
+}
+
+void gpio_port_toggle(gpio_t port, uint32_t mask)
+{
+    gpio(port)->PTOR = mask;
+}
+
+void gpio_port_write(gpio_t port, uint32_t mask, uint32_t value)
+{
+    gpio(port)->PCOR = (mask & ~value);
+    gpio(port)->PSOR = (mask & value);
+}
+
 static inline void irq_handler(PORT_Type *port, int port_num)
 {
     /* take interrupt flags only from pins which interrupt is enabled */
@@ -715,42 +715,42 @@ void timer_stop(tim_t dev)
 /* ****** ISR instances ****** */
 
 #ifdef PIT_ISR_0
-void PIT_ISR_0(void)
+void RAMFUNC PIT_ISR_0(void)
 {
     pit_irq_handler(_pit_tim_t(0));
 }
 #endif
 
 #ifdef PIT_ISR_1
-void PIT_ISR_1(void)
+void RAMFUNC PIT_ISR_1(void)
 {
     pit_irq_handler(_pit_tim_t(1));
 }
 #endif
 
 #ifdef PIT_ISR_2
-void PIT_ISR_2(void)
+void RAMFUNC PIT_ISR_2(void)
 {
     pit_irq_handler(_pit_tim_t(2));
 }
 #endif
 
 #ifdef PIT_ISR_3
-void PIT_ISR_3(void)
+void RAMFUNC PIT_ISR_3(void)
 {
     pit_irq_handler(_pit_tim_t(3));
 }
 #endif
 
 #ifdef LPTMR_ISR_0
-void LPTMR_ISR_0(void)
+void RAMFUNC LPTMR_ISR_0(void)
 {
     lptmr_irq_handler(_lptmr_tim_t(0));
 }
 #endif
 
 #ifdef LPTMR_ISR_1
-void LPTMR_ISR_1(void)
+void RAMFUNC LPTMR_ISR_1(void)
 {
     lptmr_irq_handler(_lptmr_tim_t(1));
 }
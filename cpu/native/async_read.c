@@ -22,6 +22,9 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 #include "async_read.h"
 #include "native_internal.h"
@@ -31,11 +34,29 @@ static int _fds[ASYNC_READ_NUMOF];
 static void *_args[ASYNC_READ_NUMOF];
 static native_async_read_callback_t _native_async_read_callbacks[ASYNC_READ_NUMOF];
 
+#ifdef __linux__
+/* the registered fds are kept in an epoll set, so the SIGIO handler does
+ * not need to rebuild a fd_set for every signal */
+static int _epoll_fd = -1;
+#endif
+
 #ifdef __MACH__
 static pid_t _sigio_child_pids[ASYNC_READ_NUMOF];
 static void _sigio_child(int fd);
 #endif
 
+#ifdef __linux__
+static void _async_io_isr(void) {
+    struct epoll_event events[ASYNC_READ_NUMOF];
+    int n = epoll_wait(_epoll_fd, events, ASYNC_READ_NUMOF, 0);
+
+    for (int i = 0; i < n; i++) {
+        int index = events[i].data.u32;
+
+        _native_async_read_callbacks[index](_fds[index], _args[index]);
+    }
+}
+#else
 static void _async_io_isr(void) {
     fd_set rfds;
 
@@ -61,14 +82,29 @@ static void _async_io_isr(void) {
         }
     }
 }
+#endif
 
 void native_async_read_setup(void) {
+#ifdef __linux__
+    /* called by every user of this module, the set is shared */
+    if ((_epoll_fd == -1) &&
+        ((_epoll_fd = epoll_create1(EPOLL_CLOEXEC)) == -1)) {
+        err(EXIT_FAILURE, "native_async_read_setup(): epoll_create1");
+    }
+#endif
     register_interrupt(SIGIO, _async_io_isr);
 }
 
 void native_async_read_cleanup(void) {
     unregister_interrupt(SIGIO);
 
+#ifdef __linux__
+    if (_epoll_fd != -1) {
+        real_close(_epoll_fd);
+        _epoll_fd = -1;
+    }
+#endif
+
 #ifdef __MACH__
     for (int i = 0; i < _next_index; i++) {
         kill(_sigio_child_pids[i], SIGKILL);
@@ -102,14 +138,23 @@ void native_async_read_add_handler(int fd, void *arg, native_async_read_callback
     _sigio_child(_next_index);
 #else
     /* configure fds to send signals on io */
-    if (fcntl(fd, F_SETOWN, _native_pid) == -1) {
+    if (real_fcntl(fd, F_SETOWN, _native_pid) == -1) {
         err(EXIT_FAILURE, "native_async_read_add_handler(): fcntl(F_SETOWN)");
     }
     /* set file access mode to non-blocking */
-    if (fcntl(fd, F_SETFL, O_NONBLOCK | O_ASYNC) == -1) {
+    if (real_fcntl(fd, F_SETFL, O_NONBLOCK | O_ASYNC) == -1) {
         err(EXIT_FAILURE, "native_async_read_add_handler(): fcntl(F_SETFL)");
     }
 #endif /* not OSX */
+#ifdef __linux__
+    struct epoll_event event = {
+        .events = EPOLLIN,
+        .data.u32 = _next_index,
+    };
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        err(EXIT_FAILURE, "native_async_read_add_handler(): epoll_ctl");
+    }
+#endif
 
     _next_index++;
 }
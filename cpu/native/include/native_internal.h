@@ -99,6 +99,7 @@ extern int (*real_close)(int);
 extern int (*real_creat)(const char *path, ...);
 extern int (*real_dup2)(int, int);
 extern int (*real_execve)(const char *, char *const[], char *const[]);
+extern int (*real_fcntl)(int fildes, int cmd, ...);
 extern int (*real_feof)(FILE *stream);
 extern int (*real_ferror)(FILE *stream);
 extern int (*real_fork)(void);
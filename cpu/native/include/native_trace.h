@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @brief       Event trace of a native instance
+ * @{
+ *
+ * With module `native_trace`, starting a native instance with `-t <file>`
+ * records context switches, emulated interrupts and messages with host
+ * timestamps into @p file. The file is mapped into memory, so recording an
+ * event costs no system call. It holds a ring of the last
+ * @ref NATIVE_TRACE_SLOTS events.
+ *
+ * `dist/tools/native_trace/native_trace.py` converts the file to the Chrome
+ * trace event format, which is shown by chrome://tracing and Perfetto.
+ *
+ * @file
+ * @brief       Interface definition of the native event trace
+ */
+#ifndef NATIVE_TRACE_H
+#define NATIVE_TRACE_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Magic number at the start of a trace file ("RTRC")
+ */
+#define NATIVE_TRACE_MAGIC  (0x52545243)
+
+/**
+ * @brief   Number of events the trace file holds, must be a power of two
+ */
+#ifndef NATIVE_TRACE_SLOTS
+#define NATIVE_TRACE_SLOTS  (65536U)
+#endif
+
+/**
+ * @brief   Event types
+ */
+enum {
+    NATIVE_TRACE_SWITCH = 1,    /**< thread native_trace_event_t::pid was
+                                     scheduled, arg is the previous thread */
+    NATIVE_TRACE_ISR_ENTER,     /**< interrupt entered, arg is the signal */
+    NATIVE_TRACE_ISR_EXIT,      /**< interrupt left, arg is the signal */
+    NATIVE_TRACE_MSG_SEND,      /**< message sent, arg is the target in the
+                                     upper and the type in the lower 16 bit */
+    NATIVE_TRACE_MSG_RECV,      /**< message received, arg is the sender in
+                                     the upper and the type in the lower 16
+                                     bit */
+};
+
+/**
+ * @brief   Header of a trace file
+ *
+ * Followed by @ref NATIVE_TRACE_SLOTS events.
+ */
+typedef struct {
+    uint32_t magic;         /**< @ref NATIVE_TRACE_MAGIC */
+    uint32_t slots;         /**< number of event slots */
+    uint64_t hz;            /**< timestamp ticks per second */
+    uint32_t count;         /**< number of events written, the event n is
+                                 in slot n % slots */
+    uint32_t isr_pid;       /**< sender pid of messages sent from
+                                 interrupts */
+} native_trace_hdr_t;
+
+/**
+ * @brief   Recorded event
+ */
+typedef struct {
+    uint64_t time;          /**< host timestamp */
+    uint16_t type;          /**< event type */
+    int16_t pid;            /**< thread running (or scheduled) */
+    uint32_t arg;           /**< argument, depending on the type */
+} native_trace_event_t;
+
+/**
+ * @brief   Open (and truncate) the trace file and start recording
+ *
+ * @param[in] file  path of the trace file
+ *
+ * @return  0 on success
+ * @return  -ENOENT, if @p file can not be created or mapped
+ */
+int native_trace_open(const char *file);
+
+/**
+ * @brief   Record an event, does nothing if no trace file is open
+ *
+ * May be called from thread and interrupt context.
+ *
+ * @param[in] type  event type
+ * @param[in] pid   thread the event belongs to
+ * @param[in] arg   argument of the event
+ */
+void native_trace(unsigned type, kernel_pid_t pid, uint32_t arg);
+
+/**
+ * @brief   Record a message event
+ *
+ * @param[in] type  @ref NATIVE_TRACE_MSG_SEND or @ref NATIVE_TRACE_MSG_RECV
+ * @param[in] pid   thread sending or receiving
+ * @param[in] peer  target or sender of the message
+ * @param[in] msg   type of the message
+ */
+static inline void native_trace_msg(unsigned type, kernel_pid_t pid,
+                                    kernel_pid_t peer, uint16_t msg)
+{
+    native_trace(type, pid, ((uint32_t)(uint16_t)peer << 16) | msg);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NATIVE_TRACE_H */
+/** @} */
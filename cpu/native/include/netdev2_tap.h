@@ -35,6 +35,8 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+#include "net/ethernet.h"
+
 /**
  * @brief tap interface state
  */
@@ -44,6 +46,10 @@ typedef struct netdev2_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+    int rx_len;                         /**< length of the frame in rx_buf,
+                                             0 if none */
+    uint8_t rx_buf[ETHERNET_FRAME_LEN]; /**< frame read from the TAP that
+                                             is handed out with recv() */
 } netdev2_tap_t;
 
 /**
@@ -32,6 +32,12 @@ extern "C" {
 #define CPUID_LEN           (4U)
 #endif
 
+/**
+ * @brief   uart_init_block() hands out everything that could be read from the
+ *          device at once
+ */
+#define PERIPH_UART_HAS_RX_BLOCK
+
 #ifdef __cplusplus
 }
 #endif
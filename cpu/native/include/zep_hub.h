@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @brief       Shared memory medium for ZEP frames between native instances
+ * @{
+ *
+ * All native instances of a simulation map the same file. It holds a loss
+ * matrix between the nodes and one receive ring per node. Sending a frame
+ * copies it directly into the rings of all nodes that have a link to the
+ * sender, so delivering a frame costs no system call, no matter how many
+ * nodes are simulated.
+ *
+ * The file is created with `dist/tools/zep_hub/zep_hub.py`, which also sets
+ * up the topology.
+ *
+ * @file
+ * @brief       Interface definition of the ZEP hub
+ */
+#ifndef ZEP_HUB_H
+#define ZEP_HUB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Magic number at the start of a hub file ("ZEPH")
+ */
+#define ZEP_HUB_MAGIC       (0x5a455048)
+
+/**
+ * @brief   Number of frames a node's receive ring holds
+ */
+#define ZEP_HUB_SLOTS       (16U)
+
+/**
+ * @brief   Maximum length of a frame including its ZEP header
+ */
+#define ZEP_HUB_FRAME_LEN   (168U)
+
+/**
+ * @brief   Entry of the loss matrix for nodes without a link
+ */
+#define ZEP_HUB_NO_LINK     (0xff)
+
+/**
+ * @brief   Header of a hub file
+ *
+ * Followed by the loss matrix of `nodes * nodes` bytes, padded to a multiple
+ * of 8 bytes, and `nodes` rings of type @ref zep_hub_ring_t.
+ */
+typedef struct {
+    uint32_t magic;         /**< @ref ZEP_HUB_MAGIC */
+    uint32_t nodes;         /**< number of nodes */
+} zep_hub_hdr_t;
+
+/**
+ * @brief   Frame slot of a receive ring
+ */
+typedef struct {
+    uint16_t len;                       /**< length of zep_hub_slot_t::frame */
+    uint8_t frame[ZEP_HUB_FRAME_LEN];   /**< the frame */
+} zep_hub_slot_t;
+
+/**
+ * @brief   Receive ring of a node
+ *
+ * Any node writes to it holding zep_hub_ring_t::lock, only the owner reads.
+ */
+typedef struct {
+    uint32_t lock;          /**< spin lock of the writers */
+    uint32_t head;          /**< number of frames written */
+    uint32_t tail;          /**< number of frames read */
+    uint32_t dropped;       /**< frames dropped because the ring was full */
+    zep_hub_slot_t slots[ZEP_HUB_SLOTS];    /**< the frames */
+} zep_hub_ring_t;
+
+/**
+ * @brief   Attach to a hub file
+ *
+ * @param[in] file  path of the hub file
+ * @param[in] node  number of this node in the hub, starting at 0
+ *
+ * @return  0 on success
+ * @return  -ENOENT, if @p file can not be opened or mapped
+ * @return  -EINVAL, if @p file is no hub file
+ * @return  -ERANGE, if @p node is not in the hub
+ */
+int zep_hub_attach(const char *file, unsigned node);
+
+/**
+ * @brief   Check if this instance is attached to a hub
+ *
+ * @return  1 if attached, 0 otherwise
+ */
+int zep_hub_attached(void);
+
+/**
+ * @brief   Send a frame to all nodes linked to this one
+ *
+ * Each copy is lost with the probability of the link in the loss matrix.
+ *
+ * @param[in] data  the frame
+ * @param[in] len   length of @p data, at most @ref ZEP_HUB_FRAME_LEN
+ *
+ * @return  number of nodes the frame was delivered to
+ * @return  -ENOTCONN, if not attached to a hub
+ * @return  -EMSGSIZE, if @p len is too long
+ */
+int zep_hub_send(const void *data, size_t len);
+
+/**
+ * @brief   Take the next frame from the receive ring of this node
+ *
+ * @param[out] buf      buffer for the frame
+ * @param[in] max_len   size of @p buf
+ *
+ * @return  length of the frame
+ * @return  0, if there is no frame
+ * @return  -ENOTCONN, if not attached to a hub
+ * @return  -ENOBUFS, if @p buf is too small, the frame is dropped
+ */
+int zep_hub_recv(void *buf, size_t max_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEP_HUB_H */
+/** @} */
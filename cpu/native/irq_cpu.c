@@ -40,6 +40,9 @@
 #include "periph/pm.h"
 
 #include "native_internal.h"
+#ifdef MODULE_NATIVE_TRACE
+#include "native_trace.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -158,6 +161,9 @@ unsigned irq_disable(void)
         DEBUG("irq_disable + _native_in_isr\n");
     }
 
+    /* the context switches and _native_syscall_leave() set
+     * native_interrupts_enabled without touching the signal mask, so the
+     * flag cannot be used to skip this */
     if (sigprocmask(SIG_SETMASK, &_native_sig_set_dint, NULL) == -1) {
         err(EXIT_FAILURE, "irq_disable: sigprocmask");
     }
@@ -261,7 +267,13 @@ void native_irq_handler(void)
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
+#ifdef MODULE_NATIVE_TRACE
+            native_trace(NATIVE_TRACE_ISR_ENTER, sched_active_pid, sig);
+#endif
             native_irq_handlers[sig]();
+#ifdef MODULE_NATIVE_TRACE
+            native_trace(NATIVE_TRACE_ISR_EXIT, sched_active_pid, sig);
+#endif
         }
         else if (sig == SIGUSR1) {
             warnx("native_irq_handler: ignoring SIGUSR1");
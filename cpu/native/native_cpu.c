@@ -58,6 +58,13 @@ extern netdev2_tap_t netdev2_tap;
 #endif
 
 #include "native_internal.h"
+#ifdef MODULE_NATIVE_TRACE
+#include "native_trace.h"
+#endif
+
+#ifdef MODULE_THREADPROF
+#include "threadprof.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -140,11 +147,19 @@ char *thread_stack_init(thread_task_func_t task_func, void *arg, void *stack_sta
 void isr_cpu_switch_context_exit(void)
 {
     ucontext_t *ctx;
+#ifdef MODULE_NATIVE_TRACE
+    kernel_pid_t prev = sched_active_pid;
+#endif
 
     DEBUG("isr_cpu_switch_context_exit\n");
     if ((sched_context_switch_request == 1) || (sched_active_thread == NULL)) {
         sched_run();
     }
+#ifdef MODULE_NATIVE_TRACE
+    if (sched_active_pid != prev) {
+        native_trace(NATIVE_TRACE_SWITCH, sched_active_pid, (uint16_t)prev);
+    }
+#endif
 
     DEBUG("isr_cpu_switch_context_exit: calling setcontext(%" PRIkernel_pid ")\n\n", sched_active_pid);
     ctx = (ucontext_t *)(sched_active_thread->sp);
@@ -163,6 +178,9 @@ void cpu_switch_context_exit(void)
 #ifdef NATIVE_AUTO_EXIT
     if (sched_num_threads <= 1) {
         DEBUG("cpu_switch_context_exit: last task has ended. exiting.\n");
+#ifdef MODULE_THREADPROF
+        threadprof_print_stacks();
+#endif
         real_exit(EXIT_SUCCESS);
     }
 #endif
@@ -194,7 +212,15 @@ void isr_thread_yield(void)
         native_irq_handler();
     }
 
+#ifdef MODULE_NATIVE_TRACE
+    kernel_pid_t prev = sched_active_pid;
+#endif
     sched_run();
+#ifdef MODULE_NATIVE_TRACE
+    if (sched_active_pid != prev) {
+        native_trace(NATIVE_TRACE_SWITCH, sched_active_pid, (uint16_t)prev);
+    }
+#endif
     ucontext_t *ctx = (ucontext_t *)(sched_active_thread->sp);
     DEBUG("isr_thread_yield: switching to(%" PRIkernel_pid ")\n\n", sched_active_pid);
 
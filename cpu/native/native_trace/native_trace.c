@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @{
+ *
+ * @file
+ * @brief       Event trace of a native instance
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __MACH__
+#include <mach/mach_time.h>
+#endif
+
+#include "msg.h"
+#include "native_internal.h"
+#include "native_trace.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if (NATIVE_TRACE_SLOTS & (NATIVE_TRACE_SLOTS - 1)) != 0
+#error "NATIVE_TRACE_SLOTS must be a power of two"
+#endif
+
+/* time the TSC is measured against the monotonic clock of the host */
+#define CALIBRATION_NS      (20U * 1000U * 1000U)
+
+static native_trace_hdr_t *_hdr;
+static native_trace_event_t *_events;
+
+#ifdef __MACH__
+static inline uint64_t _now(void)
+{
+    return mach_absolute_time();
+}
+
+static uint64_t _hz(void)
+{
+    mach_timebase_info_data_t info;
+
+    mach_timebase_info(&info);
+    return (1000000000ULL * info.denom) / info.numer;
+}
+#else
+static uint64_t _ns(void)
+{
+    struct timespec t;
+
+    real_clock_gettime(CLOCK_MONOTONIC, &t);
+    return ((uint64_t)t.tv_sec * 1000000000ULL) + t.tv_nsec;
+}
+
+#if defined(__i386__) || defined(__x86_64__)
+static inline uint64_t _now(void)
+{
+    return __builtin_ia32_rdtsc();
+}
+
+static uint64_t _hz(void)
+{
+    uint64_t start = _ns(), tsc = _now(), ns;
+
+    while ((ns = _ns() - start) < CALIBRATION_NS) {}
+    return ((_now() - tsc) * 1000000000ULL) / ns;
+}
+#else
+static inline uint64_t _now(void)
+{
+    return _ns();
+}
+
+static uint64_t _hz(void)
+{
+    return 1000000000ULL;
+}
+#endif
+#endif
+
+int native_trace_open(const char *file)
+{
+    size_t size = sizeof(native_trace_hdr_t) +
+                  (NATIVE_TRACE_SLOTS * sizeof(native_trace_event_t));
+    void *map;
+    int fd;
+
+    _native_syscall_enter();
+    fd = real_open(file, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        _native_syscall_leave();
+        return -ENOENT;
+    }
+    if (ftruncate(fd, size) < 0) {
+        real_close(fd);
+        _native_syscall_leave();
+        return -ENOENT;
+    }
+    map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    /* the mapping stays valid after closing the file */
+    real_close(fd);
+    if (map == MAP_FAILED) {
+        _native_syscall_leave();
+        return -ENOENT;
+    }
+
+    native_trace_hdr_t *hdr = map;
+    hdr->magic = NATIVE_TRACE_MAGIC;
+    hdr->slots = NATIVE_TRACE_SLOTS;
+    hdr->hz = _hz();
+    hdr->count = 0;
+    hdr->isr_pid = KERNEL_PID_ISR;
+    _events = (native_trace_event_t *)(hdr + 1);
+    _hdr = hdr;
+    _native_syscall_leave();
+
+    DEBUG("native_trace: recording to %s, %u ticks/s\n", file,
+          (unsigned)hdr->hz);
+    return 0;
+}
+
+void native_trace(unsigned type, kernel_pid_t pid, uint32_t arg)
+{
+    if (_hdr == NULL) {
+        return;
+    }
+
+    /* a signal may interrupt a thread recording an event, the slot is
+     * reserved with a single atomic instruction */
+    uint32_t n = __atomic_fetch_add(&_hdr->count, 1, __ATOMIC_RELAXED);
+    native_trace_event_t *event = &_events[n & (NATIVE_TRACE_SLOTS - 1)];
+
+    event->time = _now();
+    event->type = type;
+    event->pid = pid;
+    event->arg = arg;
+}
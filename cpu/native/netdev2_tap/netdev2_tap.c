@@ -1,3 +1,71 @@
+/* reads the next frame for this device into dev->rx_buf, returns its length
+ * or 0 if there is none */
+static int _read_frame(netdev2_tap_t *dev)
+{
+    while (1) {
+        int nread = real_read(dev->tap_fd, dev->rx_buf, sizeof(dev->rx_buf));
+        DEBUG("netdev2_tap: read %d bytes\n", nread);
+
+        if (nread > 0) {
+            ethernet_hdr_t *hdr = (ethernet_hdr_t *)dev->rx_buf;
+            if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
+                !_is_addr_broadcast(hdr->dst) &&
+                (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+                DEBUG("netdev2_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
+                      "That's not me => Dropped\n",
+                      hdr->dst[0], hdr->dst[1], hdr->dst[2],
+                      hdr->dst[3], hdr->dst[4], hdr->dst[5]);
+                continue;
+            }
+            return nread;
+        }
+        else if (nread == -1) {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+                err(EXIT_FAILURE, "netdev2_tap: read");
+            }
+        }
+        else if (nread == 0) {
+            DEBUG("_native_handle_tap_input: ignoring null-event\n");
+        }
+        else {
+            errx(EXIT_FAILURE, "internal error _rx_event");
+        }
+        return 0;
+    }
+}
+
+static int _recv(netdev2_t *netdev2, void *buf, size_t len, void *info)
+{
+    netdev2_tap_t *dev = (netdev2_tap_t*)netdev2;
+    int nread = dev->rx_len;
+    (void)info;
+
+    if (!buf) {
+        if (len > 0) {
+            /* no memory available in pktbuf, discarding the frame */
+            DEBUG("netdev2_tap: discarding the frame\n");
+            dev->rx_len = 0;
+        }
+        return nread;
+    }
+
+    dev->rx_len = 0;
+    if (nread == 0) {
+        return -1;
+    }
+    if ((size_t)nread > len) {
+        DEBUG("netdev2_tap: receive buffer too small\n");
+        return -ENOBUFS;
+    }
+    memcpy(buf, dev->rx_buf, nread);
+
+#ifdef MODULE_NETSTATS_L2
+    netdev2->stats.rx_count++;
+    netdev2->stats.rx_bytes += nread;
+#endif
+    return nread;
+}
+
 /*
  * Copyright (C) 2015 Ludwig Knüpfer <ludwig.knuepfer@fu-berlin.de>,
  *                    Martine Lenders <mlenders@inf.fu-berlin.de>
@@ -93,16 +161,30 @@ static inline int _set_promiscous(netdev2_t *netdev, int value)
     return value;
 }
 
+static int _read_frame(netdev2_tap_t *dev);
+static void _continue_reading(netdev2_tap_t *dev);
+
+/* Hands out frames until the TAP is drained or NETDEV2_RX_BUDGET frames were
+ * handled, so a burst of frames costs one signal instead of one each. */
 static inline void _isr(netdev2_t *netdev)
 {
+    netdev2_tap_t *dev = (netdev2_tap_t*)netdev;
+
     if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV2_EVENT_RX_COMPLETE);
+        for (unsigned i = 0; i < NETDEV2_RX_BUDGET; i++) {
+            dev->rx_len = _read_frame(dev);
+            if (dev->rx_len == 0) {
+                break;
+            }
+            netdev->event_callback(netdev, NETDEV2_EVENT_RX_COMPLETE);
+        }
     }
 #if DEVELHELP
     else {
         puts("netdev2_tap: _isr(): no event_callback set.");
     }
 #endif
+    _continue_reading(dev);
 }
 
 static int _get(netdev2_t *dev, netopt_t opt, void *value, size_t max_len)
@@ -343,6 +425,7 @@ static int _init(netdev2_t *netdev)
 #endif
     /* initialize device descriptor */
     dev->promiscous = 0;
+    dev->rx_len = 0;
     /* implicitly create the tap interface */
     if ((dev->tap_fd = real_open(clonedev, O_RDWR | O_NONBLOCK)) == -1) {
         err(EXIT_FAILURE, "open(%s)", clonedev);
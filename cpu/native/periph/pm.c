@@ -25,6 +25,10 @@
 #include "netdev2_tap.h"
 #include "tty_uart.h"
 
+#ifdef MODULE_THREADPROF
+#include "threadprof.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -43,6 +47,9 @@ void pm_set_lowest(void)
 void pm_off(void)
 {
     puts("\nnative: exiting");
+#ifdef MODULE_THREADPROF
+    threadprof_print_stacks();
+#endif
     real_exit(EXIT_SUCCESS);
 }
 
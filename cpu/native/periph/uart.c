@@ -46,6 +46,11 @@ static char *tty_device_filenames[UART_NUMOF];
  */
 static int tty_fds[UART_NUMOF];
 
+/**
+ * @brief block callbacks of devices initialized with uart_init_block()
+ */
+static uart_rx_block_cb_t block_cb[UART_NUMOF];
+
 void tty_uart_setup(uart_t uart, const char *filename)
 {
     tty_device_filenames[uart] = strndup(filename, PATH_MAX - 1);
@@ -62,6 +67,22 @@ static void io_signal_handler(int fd, void *arg)
         }
     }
 
+    if (block_cb[uart] != NULL) {
+        uint8_t buf[UART_RX_BLOCK_BUFSIZE];
+        int status;
+
+        while ((status = real_read(fd, buf, sizeof(buf))) > 0) {
+            block_cb[uart](uart_config[uart].arg, buf, status);
+        }
+        if (status == -1 && errno != EAGAIN) {
+            DEBUG("error: cannot read from serial port\n");
+
+            block_cb[uart] = NULL;
+        }
+        native_async_read_continue(fd);
+        return;
+    }
+
     int is_first = 1;
 
     while (1) {
@@ -150,6 +171,7 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
 
     uart_config[uart].rx_cb = rx_cb;
     uart_config[uart].arg = arg;
+    block_cb[uart] = NULL;
 
     native_async_read_setup();
     native_async_read_add_handler(tty_fds[uart], NULL, io_signal_handler);
@@ -157,6 +179,17 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
     return UART_OK;
 }
 
+int uart_init_block(uart_t uart, uint32_t baudrate, uart_rx_block_cb_t rx_cb,
+                    void *arg)
+{
+    int res = uart_init(uart, baudrate, NULL, arg);
+
+    if (res == UART_OK) {
+        block_cb[uart] = rx_cb;
+    }
+    return res;
+}
+
 void uart_write(uart_t uart, const uint8_t *data, size_t len)
 {
     DEBUG("writing to serial port ");
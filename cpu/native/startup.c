@@ -53,6 +53,14 @@ const char *_native_unix_socket_path = NULL;
 extern netdev2_tap_t netdev2_tap;
 #endif
 
+#ifdef MODULE_NATIVE_TRACE
+#include "native_trace.h"
+#endif
+
+#ifdef MODULE_BOOTPROF
+#include "bootprof.h"
+#endif
+
 /**
  * initialize _native_null_in_pipe to allow for reading from stdin
  * @param stdiotype: "stdio" (only initialize pipe) or any string
@@ -220,6 +228,10 @@ void usage_exit(void)
 -o          redirect stdout to file (/tmp/riot.stdout.PID) when not attached\n\
             to socket\n\
 -c          specify TTY device for UART\n");
+#ifdef MODULE_NATIVE_TRACE
+    real_printf("\
+-t <file>   record context switches, interrupts and messages to file\n");
+#endif
 
     real_printf("\n\
 The order of command line arguments matters.\n");
@@ -311,6 +323,19 @@ __attribute__((constructor)) static void startup(int argc, char **argv)
 
             tty_uart_setup(uart++, argv[argp]);
         }
+#ifdef MODULE_NATIVE_TRACE
+        else if (strcmp("-t", arg) == 0) {
+            if (argp + 1 < argc) {
+                argp++;
+            }
+            else {
+                usage_exit();
+            }
+            if (native_trace_open(argv[argp]) < 0) {
+                err(EXIT_FAILURE, "native_trace_open(%s)", argv[argp]);
+            }
+        }
+#endif
         else {
             usage_exit();
         }
@@ -324,6 +349,9 @@ __attribute__((constructor)) static void startup(int argc, char **argv)
     _native_log_stdout(stdouttype);
     _native_null_in(stdiotype);
 
+#ifdef MODULE_BOOTPROF
+    bootprof_start();
+#endif
     native_cpu_init();
     native_interrupt_init();
 #ifdef MODULE_NETDEV2_TAP
@@ -333,6 +361,9 @@ __attribute__((constructor)) static void startup(int argc, char **argv)
 #endif
 
     board_init();
+#ifdef MODULE_BOOTPROF
+    bootprof_mark("board_init");
+#endif
 
     puts("RIOT native hardware initialization complete.\n");
     irq_enable();
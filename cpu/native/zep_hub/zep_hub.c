@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @{
+ *
+ * @file
+ * @brief       Shared memory medium for ZEP frames between native instances
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "irq.h"
+#include "random.h"
+#include "native_internal.h"
+#include "zep_hub.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static zep_hub_hdr_t *_hub;
+static const uint8_t *_loss;
+static zep_hub_ring_t *_rings;
+static unsigned _node;
+
+static inline size_t _matrix_size(unsigned nodes)
+{
+    return ((nodes * nodes) + 7) & ~7U;
+}
+
+int zep_hub_attach(const char *file, unsigned node)
+{
+    zep_hub_hdr_t hdr;
+    struct stat st;
+    void *map;
+    int fd;
+
+    _native_syscall_enter();
+    fd = real_open(file, O_RDWR);
+    if (fd < 0) {
+        _native_syscall_leave();
+        return -ENOENT;
+    }
+    if ((fstat(fd, &st) < 0) || ((size_t)st.st_size < sizeof(hdr)) ||
+        (real_read(fd, &hdr, sizeof(hdr)) != sizeof(hdr))) {
+        real_close(fd);
+        _native_syscall_leave();
+        return -EINVAL;
+    }
+    if ((hdr.magic != ZEP_HUB_MAGIC) ||
+        ((size_t)st.st_size < (sizeof(hdr) + _matrix_size(hdr.nodes) +
+                               (hdr.nodes * sizeof(zep_hub_ring_t))))) {
+        real_close(fd);
+        _native_syscall_leave();
+        return -EINVAL;
+    }
+    if (node >= hdr.nodes) {
+        real_close(fd);
+        _native_syscall_leave();
+        return -ERANGE;
+    }
+    map = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    /* the mapping stays valid after closing the file */
+    real_close(fd);
+    _native_syscall_leave();
+    if (map == MAP_FAILED) {
+        return -ENOENT;
+    }
+
+    _hub = map;
+    _loss = (const uint8_t *)(_hub + 1);
+    _rings = (zep_hub_ring_t *)(_loss + _matrix_size(hdr.nodes));
+    _node = node;
+    DEBUG("zep_hub: attached to %s as node %u of %u\n", file, node,
+          (unsigned)hdr.nodes);
+    return 0;
+}
+
+int zep_hub_attached(void)
+{
+    return (_hub != NULL);
+}
+
+static void _ring_put(zep_hub_ring_t *ring, const void *data, size_t len)
+{
+    while (__atomic_test_and_set(&ring->lock, __ATOMIC_ACQUIRE)) {}
+    uint32_t head = ring->head;
+
+    if ((head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE)) >= ZEP_HUB_SLOTS) {
+        ring->dropped++;
+    }
+    else {
+        zep_hub_slot_t *slot = &ring->slots[head % ZEP_HUB_SLOTS];
+
+        slot->len = len;
+        memcpy(slot->frame, data, len);
+        __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    }
+    __atomic_clear(&ring->lock, __ATOMIC_RELEASE);
+}
+
+int zep_hub_send(const void *data, size_t len)
+{
+    const uint8_t *loss;
+    unsigned state;
+    int delivered = 0;
+
+    if (_hub == NULL) {
+        return -ENOTCONN;
+    }
+    if (len > ZEP_HUB_FRAME_LEN) {
+        return -EMSGSIZE;
+    }
+    loss = &_loss[_node * _hub->nodes];
+    /* a signal must not switch to a thread that sends too while this node
+     * holds the lock of a ring */
+    state = irq_disable();
+    for (unsigned i = 0; i < _hub->nodes; i++) {
+        if ((i == _node) || (loss[i] == ZEP_HUB_NO_LINK)) {
+            continue;
+        }
+        if ((loss[i] > 0) && ((random_uint32() % 100) < loss[i])) {
+            continue;
+        }
+        _ring_put(&_rings[i], data, len);
+        delivered++;
+    }
+    irq_restore(state);
+    return delivered;
+}
+
+int zep_hub_recv(void *buf, size_t max_len)
+{
+    zep_hub_ring_t *ring;
+    zep_hub_slot_t *slot;
+    uint32_t tail;
+    int len;
+
+    if (_hub == NULL) {
+        return -ENOTCONN;
+    }
+    ring = &_rings[_node];
+    tail = ring->tail;
+    if (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == tail) {
+        return 0;
+    }
+    slot = &ring->slots[tail % ZEP_HUB_SLOTS];
+    len = slot->len;
+    if ((size_t)len > max_len) {
+        len = -ENOBUFS;
+    }
+    else {
+        memcpy(buf, slot->frame, len);
+    }
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return len;
+}
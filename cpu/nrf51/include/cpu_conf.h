@@ -41,6 +41,8 @@ extern "C" {
  * @{
  */
 #define FLASHPAGE_SIZE          (1024U)
+#define FLASHPAGE_RAW_BLOCKSIZE (4U)
+#define FLASHPAGE_RAW_ALIGNMENT (4U)
 
 #if defined(CPU_MODEL_NRF51X22XXAA)
 #define FLASHPAGE_NUMOF         (256U)
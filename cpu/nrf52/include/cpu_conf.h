@@ -42,6 +42,8 @@ extern "C" {
  * @{
  */
 #define FLASHPAGE_SIZE                  (4096U)
+#define FLASHPAGE_RAW_BLOCKSIZE         (4U)
+#define FLASHPAGE_RAW_ALIGNMENT         (4U)
 
 #if defined(CPU_MODEL_NRF52XXAA)
 #define FLASHPAGE_NUMOF                 (128U)
@@ -30,6 +30,12 @@ extern "C" {
  */
 #define CPUID_LEN           (8U)
 
+/**
+ * @brief   The UART can send from a buffer in the background, see the
+ *          `periph_uart_nonblocking` module
+ */
+#define PERIPH_UART_HAS_NONBLOCKING
+
 /**
  * @brief   Override macro for defining GPIO pins
  *
@@ -22,26 +22,42 @@
 #include "assert.h"
 #include "periph/flashpage.h"
 
+void flashpage_write_raw(void *target_addr, const void *data, size_t len)
+{
+    /* only whole, aligned words can be written */
+    assert(!(len % FLASHPAGE_RAW_BLOCKSIZE));
+    assert(!((unsigned)target_addr % FLASHPAGE_RAW_ALIGNMENT));
+    assert(!((unsigned)data % FLASHPAGE_RAW_ALIGNMENT));
+    assert(((unsigned)target_addr + len) <=
+           (CPU_FLASH_BASE + (FLASHPAGE_SIZE * FLASHPAGE_NUMOF)));
+
+    uint32_t *page_addr = (uint32_t *)target_addr;
+    const uint32_t *data_addr = (const uint32_t *)data;
+
+    NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Wen;
+    for (unsigned i = 0; i < (len / FLASHPAGE_RAW_BLOCKSIZE); i++) {
+        *page_addr++ = data_addr[i];
+        while (NRF_NVMC->READY == 0) {}
+    }
+
+    /* finish up */
+    NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Ren;
+}
+
 void flashpage_write(int page, void *data)
 {
     assert(page < FLASHPAGE_NUMOF);
 
     uint32_t *page_addr = (uint32_t *)flashpage_addr(page);
-    uint32_t *data_addr = (uint32_t *)data;
 
     /* erase given page */
     NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Een;
     NRF_NVMC->ERASEPAGE = (uint32_t)page_addr;
     while (NRF_NVMC->READY == 0) {}
+    NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Ren;
 
     /* write data to page */
     if (data != NULL) {
-        NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Wen;
-        for (unsigned i = 0; i < (FLASHPAGE_SIZE / 4); i++) {
-            *page_addr++ = data_addr[i];
-        }
+        flashpage_write_raw(page_addr, data, FLASHPAGE_SIZE);
     }
-
-    /* finish up */
-    NRF_NVMC->CONFIG = NVMC_CONFIG_WEN_Ren;
 }
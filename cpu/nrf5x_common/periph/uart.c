@@ -26,6 +26,8 @@
 #include <stdint.h>
 
 #include "cpu.h"
+#include "irq.h"
+#include "ringbuffer.h"
 #include "periph/uart.h"
 #include "periph_cpu.h"
 #include "periph_conf.h"
@@ -36,6 +38,53 @@
  */
 static uart_isr_ctx_t uart_config;
 
+#ifdef MODULE_PERIPH_UART_NONBLOCKING
+/**
+ * @brief   Transmit buffer
+ */
+static char tx_mem[UART_TXBUF_SIZE];
+static ringbuffer_t tx_buf;
+
+/**
+ * @brief   Set while a byte is being sent
+ */
+static volatile uint8_t tx_busy;
+
+/* send the next buffered byte, called with interrupts disabled */
+static void tx_next(void)
+{
+    int c = ringbuffer_get_one(&tx_buf);
+
+    if (c < 0) {
+        tx_busy = 0;
+        NRF_UART0->INTENCLR = UART_INTENCLR_TXDRDY_Msk;
+        return;
+    }
+    NRF_UART0->EVENTS_TXDRDY = 0;
+    NRF_UART0->TXD = (uint8_t)c;
+    if (!tx_busy) {
+        tx_busy = 1;
+        NRF_UART0->INTENSET = UART_INTENSET_TXDRDY_Msk;
+    }
+}
+
+/* wait for the byte being sent and send the next one without the
+ * interrupt, called with interrupts disabled */
+static void tx_poll(void)
+{
+    if (tx_busy) {
+        while (NRF_UART0->EVENTS_TXDRDY == 0) {}
+        tx_next();
+    }
+}
+
+/* true when the interrupts sending the buffer can not come */
+static inline int tx_must_poll(void)
+{
+    return irq_is_in() || __get_PRIMASK();
+}
+#endif /* MODULE_PERIPH_UART_NONBLOCKING */
+
 int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
 {
     if (uart != 0) {
@@ -45,6 +94,10 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
     /* remember callback addresses and argument */
     uart_config.rx_cb = rx_cb;
     uart_config.arg = arg;
+#ifdef MODULE_PERIPH_UART_NONBLOCKING
+    ringbuffer_init(&tx_buf, tx_mem, UART_TXBUF_SIZE);
+    tx_busy = 0;
+#endif
 
 #ifdef CPU_FAM_NRF51
    /* power on the UART device */
@@ -134,6 +187,54 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
     return UART_OK;
 }
 
+#ifdef MODULE_PERIPH_UART_NONBLOCKING
+void uart_write(uart_t uart, const uint8_t *data, size_t len)
+{
+    int poll = tx_must_poll();
+
+    if (uart != 0) {
+        return;
+    }
+
+    while (len) {
+        unsigned state = irq_disable();
+        unsigned n = ringbuffer_add(&tx_buf, (const char *)data, len);
+
+        if (n == 0 && poll) {
+            tx_poll();
+        }
+        else if (!tx_busy) {
+            tx_next();
+        }
+        irq_restore(state);
+        data += n;
+        len -= n;
+    }
+    if (poll) {
+        /* nothing else sends the buffer */
+        uart_flush(uart);
+    }
+}
+
+void uart_flush(uart_t uart)
+{
+    int poll = tx_must_poll();
+
+    if (uart != 0) {
+        return;
+    }
+
+    /* the busy flag is cleared after the last byte was sent */
+    while (tx_busy) {
+        if (poll) {
+            unsigned state = irq_disable();
+
+            tx_poll();
+            irq_restore(state);
+        }
+    }
+}
+#else
 void uart_write(uart_t uart, const uint8_t *data, size_t len)
 {
     if (uart == 0) {
@@ -157,6 +258,7 @@ void uart_write(uart_t uart, const uint8_t *data, size_t len)
         }
     }
 }
+#endif /* MODULE_PERIPH_UART_NONBLOCKING */
 
 void uart_poweron(uart_t uart)
 {
@@ -178,5 +280,10 @@ void isr_uart0(void)
         uint8_t byte = (uint8_t)(NRF_UART0->RXD & 0xff);
         uart_config.rx_cb(uart_config.arg, byte);
     }
+#ifdef MODULE_PERIPH_UART_NONBLOCKING
+    if (tx_busy && NRF_UART0->EVENTS_TXDRDY == 1) {
+        tx_next();
+    }
+#endif
     cortexm_isr_end();
 }
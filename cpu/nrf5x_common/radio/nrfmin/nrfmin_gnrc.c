@@ -35,7 +35,7 @@
 #endif
 
 #ifndef NRFMIN_GNRC_STACKSIZE
-#define NRFMIN_GNRC_STACKSIZE       THREAD_STACKSIZE_DEFAULT
+#define NRFMIN_GNRC_STACKSIZE       GNRC_NETDEV2_STACKSIZE(THREAD_STACKSIZE_DEFAULT)
 #endif
 /** @} */
 
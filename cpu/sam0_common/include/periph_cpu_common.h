@@ -72,6 +72,16 @@ typedef enum {
 /** @} */
 #endif /* ndef DOXYGEN */
 
+/**
+ * @brief   Several pins of a port can be accessed at once, see gpio_port_read()
+ */
+#define PERIPH_GPIO_HAS_PORT
+
+/**
+ * @brief   Single pins can be accessed inline, see gpio_fast_set()
+ */
+#define PERIPH_GPIO_HAS_FAST
+
 /**
  * @brief   Available MUX values for configuring a pin's alternate function
  */
@@ -145,6 +155,46 @@ typedef enum
  */
 void gpio_init_mux(gpio_t pin, gpio_mux_t mux);
 
+/**
+ * @brief   Set the given pin to HIGH with a single write to OUTSET
+ */
+static inline void gpio_fast_set(gpio_t pin)
+{
+    ((PortGroup *)(pin & ~(0x1f)))->OUTSET.reg = (1UL << (pin & 0x1f));
+}
+
+/**
+ * @brief   Set the given pin to LOW with a single write to OUTCLR
+ */
+static inline void gpio_fast_clear(gpio_t pin)
+{
+    ((PortGroup *)(pin & ~(0x1f)))->OUTCLR.reg = (1UL << (pin & 0x1f));
+}
+
+/**
+ * @brief   Toggle the given pin with a single write to OUTTGL
+ */
+static inline void gpio_fast_toggle(gpio_t pin)
+{
+    ((PortGroup *)(pin & ~(0x1f)))->OUTTGL.reg = (1UL << (pin & 0x1f));
+}
+
+/**
+ * @brief   Read the given pin, from OUT for outputs and from IN for inputs
+ *
+ * @return  0 for LOW, != 0 for HIGH
+ */
+static inline int gpio_fast_read(gpio_t pin)
+{
+    PortGroup *port = (PortGroup *)(pin & ~(0x1f));
+    uint32_t mask = (1UL << (pin & 0x1f));
+
+    if (port->DIR.reg & mask) {
+        return (port->OUT.reg & mask) ? 1 : 0;
+    }
+    return (port->IN.reg & mask) ? 1 : 0;
+}
+
 #ifdef __cplusplus
 }
 #endif
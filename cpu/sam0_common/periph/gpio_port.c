@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_sam0_common
+ * @{
+ *
+ * @file
+ * @brief       Port-wide GPIO access
+ *
+ * @}
+ */
+
+#include "cpu.h"
+#include "periph/gpio.h"
+
+static inline PortGroup *_port(gpio_t pin)
+{
+    return (PortGroup *)(pin & ~(0x1f));
+}
+
+uint32_t gpio_port_read(gpio_t port)
+{
+    return _port(port)->IN.reg;
+}
+
+void gpio_port_set(gpio_t port, uint32_t mask)
+{
+    _port(port)->OUTSET.reg = mask;
+}
+
+void gpio_port_clear(gpio_t port, uint32_t mask)
+{
+    _port(port)->OUTCLR.reg = mask;
+}
+
+void gpio_port_toggle(gpio_t port, uint32_t mask)
+{
+    _port(port)->OUTTGL.reg = mask;
+}
+
+void gpio_port_write(gpio_t port, uint32_t mask, uint32_t value)
+{
+    _port(port)->OUTCLR.reg = (mask & ~value);
+    _port(port)->OUTSET.reg = (mask & value);
+}
@@ -25,6 +25,21 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   SPI transfers can use DMA, see spi_transfer_bytes_dma()
+ *
+ * The board enables DMA for a SPI device by defining SPI_x_DMA_RX_TRIG and
+ * SPI_x_DMA_TX_TRIG to the SERCOM's DMA trigger IDs. SPI device x uses the
+ * DMA channels 2x (RX) and 2x + 1 (TX).
+ */
+#define PERIPH_SPI_HAS_DMA
+
+/**
+ * @brief   UART devices can send from a buffer in the background, see the
+ *          `periph_uart_nonblocking` module
+ */
+#define PERIPH_UART_HAS_NONBLOCKING
+
 /**
  * @brief   Available ports on the SAMD21
  */
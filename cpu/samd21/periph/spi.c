@@ -22,6 +22,7 @@
  */
 
 #include "cpu.h"
+#include "irq.h"
 #include "mutex.h"
 #include "periph/gpio.h"
 #include "periph/spi.h"
@@ -57,6 +58,111 @@ static mutex_t locks[] =  {
 #endif
 };
 
+/**
+ * @brief Master configuration last applied to each device, 0 if unknown
+ *
+ * Drivers sharing a bus with the same mode and speed then do not reset and
+ * reprogram the device again.
+ */
+static uint8_t conf_cache[SPI_NUMOF];
+
+#define CONF_CACHE_KEY(conf, speed)     (0x80 | ((conf) << 4) | (speed))
+
+#if defined(SPI_0_DMA_RX_TRIG) || defined(SPI_1_DMA_RX_TRIG)
+#define SPI_USE_DMA
+
+/**
+ * @brief DMA trigger IDs used by each SPI device, 0 if the device has none
+ */
+typedef struct {
+    uint8_t rx_trig;
+    uint8_t tx_trig;
+} spi_dma_t;
+
+static const spi_dma_t spi_dma[] = {
+#if SPI_0_EN
+#ifdef SPI_0_DMA_RX_TRIG
+    [SPI_0] = { SPI_0_DMA_RX_TRIG, SPI_0_DMA_TX_TRIG },
+#else
+    [SPI_0] = { 0, 0 },
+#endif
+#endif
+#if SPI_1_EN
+#ifdef SPI_1_DMA_RX_TRIG
+    [SPI_1] = { SPI_1_DMA_RX_TRIG, SPI_1_DMA_TX_TRIG },
+#else
+    [SPI_1] = { 0, 0 },
+#endif
+#endif
+};
+
+/**
+ * @brief Unlocked by the DMA interrupt when a transfer is complete
+ */
+static mutex_t dma_done[] = {
+#if SPI_0_EN
+    [SPI_0] = MUTEX_INIT_LOCKED,
+#endif
+#if SPI_1_EN
+    [SPI_1] = MUTEX_INIT_LOCKED,
+#endif
+};
+
+/**
+ * @brief Transfer and write-back descriptors of the used DMA channels
+ */
+static DmacDescriptor dma_desc[2 * SPI_NUMOF] __attribute__((aligned(16)));
+static DmacDescriptor dma_wb[2 * SPI_NUMOF] __attribute__((aligned(16)));
+
+/**
+ * @brief Source and sink for transfers that only send or only receive
+ */
+static uint8_t dma_dummy_out = 0;
+static uint8_t dma_dummy_in;
+
+static void _dma_chan_init(uint8_t chan, uint8_t trig, bool irq)
+{
+    /* the channel registers are selected via CHID, keep that atomic */
+    unsigned state = irq_disable();
+
+    DMAC->CHID.reg = DMAC_CHID_ID(chan);
+    DMAC->CHCTRLA.reg = 0;
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+    while (DMAC->CHCTRLA.reg & DMAC_CHCTRLA_SWRST) {}
+    DMAC->CHCTRLB.reg = (DMAC_CHCTRLB_TRIGSRC(trig) | DMAC_CHCTRLB_TRIGACT_BEAT);
+    if (irq) {
+        DMAC->CHINTENSET.reg = DMAC_CHINTENSET_TCMPL;
+    }
+    irq_restore(state);
+}
+
+static void _dma_chan_enable(uint8_t chan)
+{
+    unsigned state = irq_disable();
+
+    DMAC->CHID.reg = DMAC_CHID_ID(chan);
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_ENABLE;
+    irq_restore(state);
+}
+
+static void _dma_init(spi_t dev)
+{
+    if (spi_dma[dev].rx_trig == 0) {
+        return;
+    }
+    if (!(DMAC->CTRL.reg & DMAC_CTRL_DMAENABLE)) {
+        PM->AHBMASK.reg |= PM_AHBMASK_DMAC;
+        PM->APBBMASK.reg |= PM_APBBMASK_DMAC;
+        DMAC->BASEADDR.reg = (uint32_t)dma_desc;
+        DMAC->WRBADDR.reg = (uint32_t)dma_wb;
+        DMAC->CTRL.reg = (DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN(0xf));
+        NVIC_EnableIRQ(DMAC_IRQn);
+    }
+    _dma_chan_init(2 * dev, spi_dma[dev].rx_trig, true);
+    _dma_chan_init((2 * dev) + 1, spi_dma[dev].tx_trig, false);
+}
+#endif /* SPI_0_DMA_RX_TRIG || SPI_1_DMA_RX_TRIG */
+
 int spi_init_master(spi_t dev, spi_conf_t conf, spi_speed_t speed)
 {
     SercomSpi* spi_dev = 0;
@@ -72,6 +178,11 @@ int spi_init_master(spi_t dev, spi_conf_t conf, spi_speed_t speed)
     uint32_t   cpha = 0;
     uint32_t   cpol = 0;
     uint32_t   f_baud = 0;
+
+    if ((dev < SPI_NUMOF) && (conf_cache[dev] == CONF_CACHE_KEY(conf, speed))) {
+        /* already configured like this, e.g., by another driver on the bus */
+        return 0;
+    }
     switch (speed)
     {
     case SPI_SPEED_100KHZ:
@@ -203,6 +314,10 @@ int spi_init_master(spi_t dev, spi_conf_t conf, spi_speed_t speed)
 
     /* enable */
     _spi_poweron(spi_dev);
+#ifdef SPI_USE_DMA
+    _dma_init(dev);
+#endif
+    conf_cache[dev] = CONF_CACHE_KEY(conf, speed);
     return 0;
 }
 
@@ -267,6 +382,60 @@ int spi_transfer_byte(spi_t dev, char out, char *in)
     return 1;
 }
 
+int spi_transfer_bytes_dma(spi_t dev, char *out, char *in, unsigned int length)
+{
+#ifdef SPI_USE_DMA
+    SercomSpi* spi_dev = 0;
+    DmacDescriptor *rx, *tx;
+
+    switch(dev)
+    {
+#if SPI_0_EN
+    case SPI_0:
+        spi_dev = &(SPI_0_DEV);
+        break;
+#endif
+#if SPI_1_EN
+    case SPI_1:
+        spi_dev = &(SPI_1_DEV);
+        break;
+#endif
+    default:
+        return -1;
+    }
+
+    if ((length < SPI_DMA_MIN_LEN) || (spi_dma[dev].rx_trig == 0)) {
+        return spi_transfer_bytes(dev, out, in, length);
+    }
+
+    /* incrementing addresses point to the end of the block */
+    rx = &dma_desc[2 * dev];
+    rx->BTCTRL.reg = (DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE |
+                      ((in != NULL) ? DMAC_BTCTRL_DSTINC : 0));
+    rx->BTCNT.reg = length;
+    rx->SRCADDR.reg = (uint32_t)&(spi_dev->DATA.reg);
+    rx->DSTADDR.reg = (in != NULL) ? (uint32_t)(in + length) : (uint32_t)&dma_dummy_in;
+    rx->DESCADDR.reg = 0;
+    tx = &dma_desc[(2 * dev) + 1];
+    tx->BTCTRL.reg = (DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE |
+                      ((out != NULL) ? DMAC_BTCTRL_SRCINC : 0));
+    tx->BTCNT.reg = length;
+    tx->SRCADDR.reg = (out != NULL) ? (uint32_t)(out + length) : (uint32_t)&dma_dummy_out;
+    tx->DSTADDR.reg = (uint32_t)&(spi_dev->DATA.reg);
+    tx->DESCADDR.reg = 0;
+
+    /* every byte sent clocks in one byte, so the end of the RX channel marks
+     * the end of the transfer */
+    _dma_chan_enable(2 * dev);
+    _dma_chan_enable((2 * dev) + 1);
+    mutex_lock(&dma_done[dev]);
+
+    return length;
+#else
+    return spi_transfer_bytes(dev, out, in, length);
+#endif
+}
+
 static void _spi_poweron(SercomSpi* spi_dev)
 {
     if (spi_dev == NULL) {
@@ -303,6 +472,9 @@ static void _spi_poweroff(SercomSpi* spi_dev)
 
 void spi_poweroff(spi_t dev)
 {
+    if (dev < SPI_NUMOF) {
+        conf_cache[dev] = 0;
+    }
     switch(dev) {
 #if SPI_0_EN
     case SPI_0:
@@ -317,4 +489,17 @@ void spi_poweroff(spi_t dev)
     }
 }
 
+#ifdef SPI_USE_DMA
+void isr_dmac(void)
+{
+    while (DMAC->INTSTATUS.reg) {
+        uint8_t chan = DMAC->INTPEND.bit.ID;
+
+        DMAC->INTPEND.reg = (DMAC_INTPEND_ID(chan) | DMAC_INTPEND_TCMPL);
+        mutex_unlock(&dma_done[chan / 2]);
+    }
+    cortexm_isr_end();
+}
+#endif
+
 #endif /* SPI_0_EN || SPI_1_EN */
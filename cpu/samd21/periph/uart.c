@@ -21,6 +21,8 @@
  */
 
 #include "cpu.h"
+#include "irq.h"
+#include "ringbuffer.h"
 
 #include "periph/uart.h"
 #include "periph/gpio.h"
@@ -44,6 +46,40 @@ static inline SercomUsart *_uart(uart_t dev)
 
 static int init_base(uart_t uart, uint32_t baudrate);
 
+#ifdef MODULE_PERIPH_UART_NONBLOCKING
+/**
+ * @brief   Transmit buffers
+ */
+static char tx_mem[UART_NUMOF][UART_TXBUF_SIZE];
+static ringbuffer_t tx_buf[UART_NUMOF];
+
+/**
+ * @brief   Set once a byte was written, TXC is not set before
+ */
+static uint8_t tx_sent[UART_NUMOF];
+
+/* true when the interrupts sending the buffer can not come */
+static inline int tx_must_poll(void)
+{
+    return irq_is_in() || __get_PRIMASK();
+}
+
+/* send the next byte without the interrupt, called with interrupts
+ * disabled */
+static void tx_poll(uart_t uart)
+{
+    int c = ringbuffer_get_one(&tx_buf[uart]);
+
+    if (c >= 0) {
+        while (!(_uart(uart)->INTFLAG.reg & SERCOM_USART_INTFLAG_DRE)) {}
+        _uart(uart)->DATA.reg = (uint8_t)c;
+    }
+    if (ringbuffer_empty(&tx_buf[uart])) {
+        _uart(uart)->INTENCLR.reg = SERCOM_USART_INTENCLR_DRE;
+    }
+}
+#endif /* MODULE_PERIPH_UART_NONBLOCKING */
+
 int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
 {
     /* initialize basic functionality */
@@ -55,6 +91,10 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
     /* register callbacks */
     uart_ctx[uart].rx_cb = rx_cb;
     uart_ctx[uart].arg = arg;
+#ifdef MODULE_PERIPH_UART_NONBLOCKING
+    ringbuffer_init(&tx_buf[uart], tx_mem[uart], UART_TXBUF_SIZE);
+    tx_sent[uart] = 0;
+#endif
     /* configure interrupts and enable RX interrupt */
     _uart(uart)->INTENSET.reg = SERCOM_USART_INTENSET_RXC;
     NVIC_EnableIRQ(SERCOM0_IRQn + _sercom_id(_uart(uart)));
@@ -102,6 +142,53 @@ static int init_base(uart_t uart, uint32_t baudrate)
     return UART_OK;
 }
 
+#ifdef MODULE_PERIPH_UART_NONBLOCKING
+void uart_write(uart_t uart, const uint8_t *data, size_t len)
+{
+    int poll = tx_must_poll();
+
+    tx_sent[uart] = 1;
+    while (len) {
+        unsigned state = irq_disable();
+        unsigned n = ringbuffer_add(&tx_buf[uart], (const char *)data, len);
+
+        if (n == 0 && poll) {
+            tx_poll(uart);
+        }
+        else {
+            /* the DRE interrupt fires as long as DATA can take a byte */
+            _uart(uart)->INTENSET.reg = SERCOM_USART_INTENSET_DRE;
+        }
+        irq_restore(state);
+        data += n;
+        len -= n;
+    }
+    if (poll) {
+        /* nothing else sends the buffer */
+        uart_flush(uart);
+    }
+}
+
+void uart_flush(uart_t uart)
+{
+    int poll = tx_must_poll();
+    int empty;
+
+    do {
+        unsigned state = irq_disable();
+
+        empty = ringbuffer_empty(&tx_buf[uart]);
+        if (!empty && poll) {
+            tx_poll(uart);
+        }
+        irq_restore(state);
+    } while (!empty);
+
+    if (tx_sent[uart]) {
+        while (!(_uart(uart)->INTFLAG.reg & SERCOM_USART_INTFLAG_TXC)) {}
+    }
+}
+#else
 void uart_write(uart_t uart, const uint8_t *data, size_t len)
 {
     for (size_t i = 0; i < len; i++) {
@@ -109,6 +196,7 @@ void uart_write(uart_t uart, const uint8_t *data, size_t len)
         _uart(uart)->DATA.reg = data[i];
     }
 }
+#endif /* MODULE_PERIPH_UART_NONBLOCKING */
 
 void uart_poweron(uart_t uart)
 {
@@ -132,6 +220,20 @@ static inline void irq_handler(int dev)
 {
     SercomUsart *uart = _uart(dev);
 
+#ifdef MODULE_PERIPH_UART_NONBLOCKING
+    if ((uart->INTENSET.reg & SERCOM_USART_INTENSET_DRE) &&
+        (uart->INTFLAG.reg & SERCOM_USART_INTFLAG_DRE)) {
+        int c = ringbuffer_get_one(&tx_buf[dev]);
+
+        if (c >= 0) {
+            uart->DATA.reg = (uint8_t)c;
+        }
+        if (ringbuffer_empty(&tx_buf[dev])) {
+            uart->INTENCLR.reg = SERCOM_USART_INTENCLR_DRE;
+        }
+    }
+#endif
+
     if (uart->INTFLAG.reg & SERCOM_USART_INTFLAG_RXC) {
         /* interrupt flag is cleared by reading the data register */
         uart_ctx[dev].rx_cb(uart_ctx[dev].arg, (uint8_t)(uart->DATA.reg));
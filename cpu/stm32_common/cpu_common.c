@@ -24,6 +24,16 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#ifndef CLOCK_FLASH_PREFETCH
+#define CLOCK_FLASH_PREFETCH    (1)
+#endif
+#ifndef CLOCK_FLASH_ICACHE
+#define CLOCK_FLASH_ICACHE      (1)
+#endif
+#ifndef CLOCK_FLASH_DCACHE
+#define CLOCK_FLASH_DCACHE      (1)
+#endif
+
 uint32_t periph_apb_clk(uint8_t bus)
 {
     if (bus == APB1) {
@@ -97,3 +107,38 @@ void periph_clk_dis(bus_t bus, uint32_t mask)
             break;
     }
 }
+
+void stm32_flash_init(uint32_t latency)
+{
+#if defined(CPU_FAM_STM32F2) || defined(CPU_FAM_STM32F4)
+    uint32_t acr = latency;
+
+    /* the caches can only be reset while they are disabled */
+    FLASH->ACR = 0;
+    FLASH->ACR = (FLASH_ACR_ICRST | FLASH_ACR_DCRST);
+    FLASH->ACR = 0;
+#if CLOCK_FLASH_PREFETCH
+    acr |= FLASH_ACR_PRFTEN;
+#endif
+#if CLOCK_FLASH_ICACHE
+    acr |= FLASH_ACR_ICEN;
+#endif
+#if CLOCK_FLASH_DCACHE
+    acr |= FLASH_ACR_DCEN;
+#endif
+    FLASH->ACR = acr;
+#elif defined(CPU_FAM_STM32L1)
+    /* 64-bit access must be set before prefetch and wait states */
+    FLASH->ACR |= FLASH_ACR_ACC64;
+#if CLOCK_FLASH_PREFETCH
+    FLASH->ACR |= FLASH_ACR_PRFTEN;
+#endif
+    FLASH->ACR |= latency;
+#else
+#if CLOCK_FLASH_PREFETCH
+    FLASH->ACR = (FLASH_ACR_PRFTBE | latency);
+#else
+    FLASH->ACR = latency;
+#endif
+#endif
+}
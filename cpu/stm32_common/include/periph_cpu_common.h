@@ -89,6 +89,16 @@ typedef uint32_t gpio_t;
  */
 #define GPIO_PIN(x, y)      ((GPIOA_BASE + (x << 10)) | y)
 
+/**
+ * @brief   Several pins of a port can be accessed at once, see gpio_port_read()
+ */
+#define PERIPH_GPIO_HAS_PORT
+
+/**
+ * @brief   Single pins can be accessed inline, see gpio_fast_set()
+ */
+#define PERIPH_GPIO_HAS_FAST
+
 /**
  * @brief   Available MUX values for configuring a pin's alternate function
  */
@@ -141,6 +151,12 @@ typedef struct {
     uint8_t bus;            /**< APB bus */
 } pwm_conf_t;
 
+/**
+ * @brief   UART devices can send from a buffer in the background, see the
+ *          `periph_uart_nonblocking` module
+ */
+#define PERIPH_UART_HAS_NONBLOCKING
+
 /**
  * @brief   Structure for UART configuration data
  */
@@ -186,6 +202,19 @@ void periph_clk_en(bus_t bus, uint32_t mask);
  */
 void periph_clk_dis(bus_t bus, uint32_t mask);
 
+/**
+ * @brief   Configure the flash wait states and access acceleration
+ *
+ * The board can select the acceleration in its periph_conf.h by setting
+ * `CLOCK_FLASH_PREFETCH`, `CLOCK_FLASH_ICACHE` and `CLOCK_FLASH_DCACHE` to 0
+ * or 1, all default to 1. The instruction and data caches (the ART
+ * accelerator) only exist on the STM32F2 and F4. The caches are flushed
+ * before they are enabled.
+ *
+ * @param[in] latency   value of the LATENCY field of FLASH->ACR
+ */
+void stm32_flash_init(uint32_t latency);
+
 /**
  * @brief   Configure the alternate function for the given pin
  *
@@ -201,6 +230,61 @@ void gpio_init_af(gpio_t pin, gpio_af_t af);
  */
 void gpio_init_analog(gpio_t pin);
 
+/**
+ * @brief   BSRR of the port of the given pin
+ *
+ * Some vendor headers split BSRR into two half-word registers.
+ */
+static inline volatile uint32_t *gpio_fast_bsrr(gpio_t pin)
+{
+    GPIO_TypeDef *port = (GPIO_TypeDef *)(pin & ~(0x0f));
+#if defined(CPU_FAM_STM32F3) || defined(CPU_FAM_STM32F4) || \
+    defined(CPU_FAM_STM32L1)
+    return (volatile uint32_t *)&port->BSRRL;
+#else
+    return &port->BSRR;
+#endif
+}
+
+/**
+ * @brief   Set the given pin to HIGH with a single write to BSRR
+ */
+static inline void gpio_fast_set(gpio_t pin)
+{
+    *gpio_fast_bsrr(pin) = (1 << (pin & 0x0f));
+}
+
+/**
+ * @brief   Set the given pin to LOW with a single write to BSRR
+ */
+static inline void gpio_fast_clear(gpio_t pin)
+{
+    *gpio_fast_bsrr(pin) = (1UL << ((pin & 0x0f) + 16));
+}
+
+/**
+ * @brief   Toggle the given pin
+ */
+static inline void gpio_fast_toggle(gpio_t pin)
+{
+    if (((GPIO_TypeDef *)(pin & ~(0x0f)))->ODR & (1 << (pin & 0x0f))) {
+        gpio_fast_clear(pin);
+    }
+    else {
+        gpio_fast_set(pin);
+    }
+}
+
+/**
+ * @brief   Read the level at the given pin from IDR
+ *
+ * @return  0 for LOW, != 0 for HIGH
+ */
+static inline int gpio_fast_read(gpio_t pin)
+{
+    return ((GPIO_TypeDef *)(pin & ~(0x0f)))->IDR & (1 << (pin & 0x0f));
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_stm32_common
+ * @{
+ *
+ * @file
+ * @brief       Low-level CRC driver implementation
+ *
+ * The unit is set up for the reflected CRC32 with its default polynomial.
+ * The input is bit reversed per byte and the output as a whole, so the data
+ * register holds the state of the reflected software algorithm.
+ *
+ * @}
+ */
+
+#include "cpu.h"
+#include "mutex.h"
+#include "periph/crc.h"
+
+/* only compile this, if the CRC unit has a configurable start value and
+ * input and output reversal (F0, F3) */
+#ifdef CRC_CR_REV_IN
+
+static mutex_t _lock = MUTEX_INIT;
+
+static uint32_t _reverse(uint32_t v)
+{
+    uint32_t r = 0;
+
+    for (unsigned i = 0; i < 32; i++) {
+        r = (r << 1) | (v & 1);
+        v >>= 1;
+    }
+    return r;
+}
+
+uint32_t crc_crc32_update(uint32_t crc, const uint8_t *buf, size_t len)
+{
+    mutex_lock(&_lock);
+    periph_clk_en(AHB, RCC_AHBENR_CRCEN);
+
+    /* the start value is loaded into the shift register unreversed */
+    CRC->INIT = _reverse(~crc);
+    CRC->CR = CRC_CR_REV_IN_0 | CRC_CR_REV_OUT | CRC_CR_RESET;
+    while (len--) {
+        *((__IO uint8_t *)&CRC->DR) = *buf++;
+    }
+    crc = ~CRC->DR;
+
+    periph_clk_dis(AHB, RCC_AHBENR_CRCEN);
+    mutex_unlock(&_lock);
+    return crc;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* CRC_CR_REV_IN */
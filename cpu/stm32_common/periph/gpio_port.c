@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_stm32_common
+ * @{
+ *
+ * @file
+ * @brief       Port-wide GPIO access
+ *
+ * All pins of a port are set and cleared by a single write to BSRR.
+ *
+ * @}
+ */
+
+#include "cpu.h"
+#include "periph/gpio.h"
+
+static inline GPIO_TypeDef *_port(gpio_t pin)
+{
+    return (GPIO_TypeDef *)(pin & ~(0x0f));
+}
+
+/* some vendor headers split BSRR into two half-word registers */
+static inline volatile uint32_t *_bsrr(gpio_t pin)
+{
+#if defined(CPU_FAM_STM32F3) || defined(CPU_FAM_STM32F4) || \
+    defined(CPU_FAM_STM32L1)
+    return (volatile uint32_t *)&_port(pin)->BSRRL;
+#else
+    return &_port(pin)->BSRR;
+#endif
+}
+
+uint32_t gpio_port_read(gpio_t port)
+{
+    return _port(port)->IDR & 0xffff;
+}
+
+void gpio_port_set(gpio_t port, uint32_t mask)
+{
+    *_bsrr(port) = (mask & 0xffff);
+}
+
+void gpio_port_clear(gpio_t port, uint32_t mask)
+{
+    *_bsrr(port) = (mask << 16);
+}
+
+void gpio_port_toggle(gpio_t port, uint32_t mask)
+{
+    uint32_t odr = _port(port)->ODR;
+
+    mask &= 0xffff;
+    *_bsrr(port) = ((~odr & mask) | ((odr & mask) << 16));
+}
+
+void gpio_port_write(gpio_t port, uint32_t mask, uint32_t value)
+{
+    mask &= 0xffff;
+    *_bsrr(port) = ((value & mask) | ((~value & mask) << 16));
+}
@@ -141,35 +141,35 @@ static inline void irq_handler(tim_t tim)
 }
 
 #ifdef TIMER_0_ISR
-void TIMER_0_ISR(void)
+void RAMFUNC TIMER_0_ISR(void)
 {
     irq_handler(0);
 }
 #endif
 
 #ifdef TIMER_1_ISR
-void TIMER_1_ISR(void)
+void RAMFUNC TIMER_1_ISR(void)
 {
     irq_handler(1);
 }
 #endif
 
 #ifdef TIMER_2_ISR
-void TIMER_2_ISR(void)
+void RAMFUNC TIMER_2_ISR(void)
 {
     irq_handler(2);
 }
 #endif
 
 #ifdef TIMER_3_ISR
-void TIMER_3_ISR(void)
+void RAMFUNC TIMER_3_ISR(void)
 {
     irq_handler(3);
 }
 #endif
 
 #ifdef TIMER_4_ISR
-void TIMER_4_ISR(void)
+void RAMFUNC TIMER_4_ISR(void)
 {
     irq_handler(4);
 }
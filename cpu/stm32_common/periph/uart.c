@@ -24,9 +24,11 @@
  */
 
 #include "cpu.h"
+#include "irq.h"
 #include "sched.h"
 #include "thread.h"
 #include "assert.h"
+#include "ringbuffer.h"
 #include "periph/uart.h"
 #include "periph/gpio.h"
 
@@ -34,6 +36,23 @@
 
 #define RXENABLE            (USART_CR1_RE | USART_CR1_RXNEIE)
 
+/**
+ * @brief   Status and transmit data register names differ between families
+ * @{
+ */
+#if defined(CPU_FAM_STM32F0) || defined(CPU_FAM_STM32F3)
+#define STATUS              ISR
+#define STATUS_TXE          USART_ISR_TXE
+#define STATUS_TC           USART_ISR_TC
+#define TXDATA              TDR
+#else
+#define STATUS              SR
+#define STATUS_TXE          USART_SR_TXE
+#define STATUS_TC           USART_SR_TC
+#define TXDATA              DR
+#endif
+/** @} */
+
 /**
  * @brief   Allocate memory to store the callback functions
  */
@@ -44,6 +63,191 @@ static inline USART_TypeDef *dev(uart_t uart)
     return uart_config[uart].dev;
 }
 
+#ifdef PERIPH_UART_HAS_RX_BLOCK
+/**
+ * @brief   DMA stream used for block reception by each UART device
+ */
+typedef struct {
+    int8_t stream;          /**< logical DMA stream, -1 if the device has none */
+    uint8_t chan;           /**< DMA channel of the stream */
+    uint8_t *buf;           /**< receive buffer */
+} uart_dma_t;
+
+#define UART_DMA_NONE       { -1, 0, NULL }
+
+#ifdef UART_0_DMA_RX_STREAM
+static uint8_t dma_buf0[UART_RX_BLOCK_BUFSIZE];
+#endif
+#ifdef UART_1_DMA_RX_STREAM
+static uint8_t dma_buf1[UART_RX_BLOCK_BUFSIZE];
+#endif
+#ifdef UART_2_DMA_RX_STREAM
+static uint8_t dma_buf2[UART_RX_BLOCK_BUFSIZE];
+#endif
+#ifdef UART_3_DMA_RX_STREAM
+static uint8_t dma_buf3[UART_RX_BLOCK_BUFSIZE];
+#endif
+
+static const uart_dma_t uart_dma[] = {
+#ifdef UART_0_DMA_RX_STREAM
+    { UART_0_DMA_RX_STREAM, UART_0_DMA_RX_CHAN, dma_buf0 },
+#else
+    UART_DMA_NONE,
+#endif
+#ifdef UART_1_DMA_RX_STREAM
+    { UART_1_DMA_RX_STREAM, UART_1_DMA_RX_CHAN, dma_buf1 },
+#else
+    UART_DMA_NONE,
+#endif
+#ifdef UART_2_DMA_RX_STREAM
+    { UART_2_DMA_RX_STREAM, UART_2_DMA_RX_CHAN, dma_buf2 },
+#else
+    UART_DMA_NONE,
+#endif
+#ifdef UART_3_DMA_RX_STREAM
+    { UART_3_DMA_RX_STREAM, UART_3_DMA_RX_CHAN, dma_buf3 },
+#else
+    UART_DMA_NONE,
+#endif
+};
+
+/**
+ * @brief   Block callbacks of devices initialized with uart_init_block()
+ */
+static uart_rx_block_cb_t block_cb[UART_NUMOF];
+
+/**
+ * @brief   Position in the DMA buffer up to which data was handed out
+ */
+static uint16_t dma_pos[UART_NUMOF];
+
+static inline int has_dma(uart_t uart)
+{
+    return (uart < (sizeof(uart_dma) / sizeof(uart_dma[0]))) &&
+           (uart_dma[uart].stream >= 0);
+}
+#endif /* PERIPH_UART_HAS_RX_BLOCK */
+
+#ifdef MODULE_PERIPH_UART_NONBLOCKING
+/**
+ * @brief   Transmit buffers
+ */
+static char tx_mem[UART_NUMOF][UART_TXBUF_SIZE];
+static ringbuffer_t tx_buf[UART_NUMOF];
+
+#ifdef PERIPH_UART_HAS_TX_DMA
+/**
+ * @brief   DMA stream used for sending by each UART device
+ */
+typedef struct {
+    int8_t stream;          /**< logical DMA stream, -1 if the device has none */
+    uint8_t chan;           /**< DMA channel of the stream */
+} uart_tx_dma_t;
+
+static const uart_tx_dma_t uart_tx_dma[] = {
+#ifdef UART_0_DMA_TX_STREAM
+    { UART_0_DMA_TX_STREAM, UART_0_DMA_TX_CHAN },
+#else
+    { -1, 0 },
+#endif
+#ifdef UART_1_DMA_TX_STREAM
+    { UART_1_DMA_TX_STREAM, UART_1_DMA_TX_CHAN },
+#else
+    { -1, 0 },
+#endif
+#ifdef UART_2_DMA_TX_STREAM
+    { UART_2_DMA_TX_STREAM, UART_2_DMA_TX_CHAN },
+#else
+    { -1, 0 },
+#endif
+#ifdef UART_3_DMA_TX_STREAM
+    { UART_3_DMA_TX_STREAM, UART_3_DMA_TX_CHAN },
+#else
+    { -1, 0 },
+#endif
+};
+
+/**
+ * @brief   Number of bytes of the transmit buffer the DMA is sending
+ */
+static uint16_t tx_dma_len[UART_NUMOF];
+
+static inline int has_tx_dma(uart_t uart)
+{
+    return (uart < (sizeof(uart_tx_dma) / sizeof(uart_tx_dma[0]))) &&
+           (uart_tx_dma[uart].stream >= 0);
+}
+#endif /* PERIPH_UART_HAS_TX_DMA */
+
+/* true when the interrupts sending the buffer can not come */
+static inline int tx_must_poll(void)
+{
+    return irq_is_in() || __get_PRIMASK();
+}
+
+/* hand the buffered data to the hardware, called with interrupts disabled */
+static void tx_start(uart_t uart)
+{
+    ringbuffer_t *rb = &tx_buf[uart];
+
+#ifdef PERIPH_UART_HAS_TX_DMA
+    if (has_tx_dma(uart)) {
+        DMA_Stream_TypeDef *stream = dma_stream(uart_tx_dma[uart].stream);
+        unsigned len;
+
+        if (tx_dma_len[uart]) {
+            if (stream->CR & DMA_SxCR_EN) {
+                return;
+            }
+            ringbuffer_remove(rb, tx_dma_len[uart]);
+            tx_dma_len[uart] = 0;
+        }
+        if (ringbuffer_empty(rb)) {
+            return;
+        }
+        /* the DMA sends the buffer up to its end or the last byte */
+        len = rb->size - rb->start;
+        if (len > rb->avail) {
+            len = rb->avail;
+        }
+        dma_isr_clear(uart_tx_dma[uart].stream);
+        dev(uart)->SR &= ~(USART_SR_TC);
+        stream->M0AR = (uint32_t)&rb->buf[rb->start];
+        stream->NDTR = len;
+        tx_dma_len[uart] = len;
+        stream->CR |= DMA_SxCR_EN;
+        return;
+    }
+#endif
+    if (!ringbuffer_empty(rb)) {
+        dev(uart)->CR1 |= USART_CR1_TXEIE;
+    }
+}
+
+/* send the next byte without the interrupt, called with interrupts
+ * disabled */
+static void tx_poll(uart_t uart)
+{
+    int c;
+
+#ifdef PERIPH_UART_HAS_TX_DMA
+    if (has_tx_dma(uart)) {
+        while (dma_stream(uart_tx_dma[uart].stream)->CR & DMA_SxCR_EN) {}
+        tx_start(uart);
+        return;
+    }
+#endif
+    c = ringbuffer_get_one(&tx_buf[uart]);
+    if (c >= 0) {
+        while (!(dev(uart)->STATUS & STATUS_TXE)) {}
+        dev(uart)->TXDATA = (uint8_t)c;
+    }
+    if (ringbuffer_empty(&tx_buf[uart])) {
+        dev(uart)->CR1 &= ~(USART_CR1_TXEIE);
+    }
+}
+#endif /* MODULE_PERIPH_UART_NONBLOCKING */
+
 int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
 {
     uint16_t mantissa;
@@ -55,6 +259,9 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
     /* save ISR context */
     isr_ctx[uart].rx_cb = rx_cb;
     isr_ctx[uart].arg   = arg;
+#ifdef PERIPH_UART_HAS_RX_BLOCK
+    block_cb[uart] = NULL;
+#endif
 
     /* configure RX and TX pin */
     gpio_init(uart_config[uart].rx_pin, GPIO_IN);
@@ -82,6 +289,27 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
     fraction = (uint8_t)(clk - (mantissa * 16));
     dev(uart)->BRR = ((mantissa & 0x0fff) << 4) | (fraction & 0x0f);
 
+#ifdef MODULE_PERIPH_UART_NONBLOCKING
+    /* the interrupt or the DMA sends the transmit buffer */
+    ringbuffer_init(&tx_buf[uart], tx_mem[uart], UART_TXBUF_SIZE);
+    NVIC_EnableIRQ(uart_config[uart].irqn);
+#ifdef PERIPH_UART_HAS_TX_DMA
+    if (has_tx_dma(uart)) {
+        DMA_Stream_TypeDef *stream = dma_stream(uart_tx_dma[uart].stream);
+
+        dma_poweron(uart_tx_dma[uart].stream);
+        stream->CR = 0;
+        dma_isr_clear(uart_tx_dma[uart].stream);
+        tx_dma_len[uart] = 0;
+        stream->PAR = (uint32_t)&(dev(uart)->DR);
+        stream->CR = ((uint32_t)uart_tx_dma[uart].chan << 25) |
+                     DMA_SxCR_MINC | DMA_SxCR_DIR_0 | DMA_SxCR_TCIE;
+        dma_isr_enable(uart_tx_dma[uart].stream);
+        dev(uart)->CR3 = USART_CR3_DMAT;
+    }
+#endif
+#endif
+
     /* enable RX interrupt if applicable */
     if (rx_cb) {
         NVIC_EnableIRQ(uart_config[uart].irqn);
@@ -94,28 +322,132 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg)
     return UART_OK;
 }
 
+#ifdef PERIPH_UART_HAS_RX_BLOCK
+int uart_init_block(uart_t uart, uint32_t baudrate, uart_rx_block_cb_t rx_cb,
+                    void *arg)
+{
+    int res;
+
+    assert(rx_cb);
+
+    res = uart_init(uart, baudrate, NULL, arg);
+    if (res != UART_OK) {
+        return res;
+    }
+    block_cb[uart] = rx_cb;
+    NVIC_EnableIRQ(uart_config[uart].irqn);
+
+    if (!has_dma(uart)) {
+        /* hand out every byte on its own */
+        dev(uart)->CR1 |= RXENABLE;
+        return UART_OK;
+    }
+
+    /* let the DMA fill the buffer circularly and interrupt when half of it
+     * is filled, the UART interrupts when the line goes idle */
+    DMA_Stream_TypeDef *stream = dma_stream(uart_dma[uart].stream);
+
+    dma_poweron(uart_dma[uart].stream);
+    stream->CR = 0;
+    dma_isr_clear(uart_dma[uart].stream);
+    dma_pos[uart] = 0;
+    stream->PAR = (uint32_t)&(dev(uart)->DR);
+    stream->M0AR = (uint32_t)uart_dma[uart].buf;
+    stream->NDTR = UART_RX_BLOCK_BUFSIZE;
+    stream->CR = ((uint32_t)uart_dma[uart].chan << 25) | DMA_SxCR_MINC |
+                 DMA_SxCR_CIRC | DMA_SxCR_HTIE | DMA_SxCR_TCIE;
+    stream->CR |= DMA_SxCR_EN;
+    dma_isr_enable(uart_dma[uart].stream);
+
+    dev(uart)->CR3 |= USART_CR3_DMAR;
+    dev(uart)->CR1 |= (USART_CR1_RE | USART_CR1_IDLEIE);
+
+    return UART_OK;
+}
+
+/* hand out everything the DMA wrote since the last call */
+static void dma_deliver(uart_t uart)
+{
+    const uart_dma_t *dma = &uart_dma[uart];
+    unsigned pos = UART_RX_BLOCK_BUFSIZE - dma_stream(dma->stream)->NDTR;
+    unsigned last = dma_pos[uart];
+
+    if (pos >= UART_RX_BLOCK_BUFSIZE) {
+        pos = 0;
+    }
+    if (pos < last) {
+        block_cb[uart](isr_ctx[uart].arg, &dma->buf[last],
+                       UART_RX_BLOCK_BUFSIZE - last);
+        last = 0;
+    }
+    if (pos > last) {
+        block_cb[uart](isr_ctx[uart].arg, &dma->buf[last], pos - last);
+    }
+    dma_pos[uart] = pos;
+}
+#endif /* PERIPH_UART_HAS_RX_BLOCK */
+
+#ifdef MODULE_PERIPH_UART_NONBLOCKING
 void uart_write(uart_t uart, const uint8_t *data, size_t len)
 {
+    int poll = tx_must_poll();
+
     assert(uart < UART_NUMOF);
 
-    for (size_t i = 0; i < len; i++) {
-#if defined(CPU_FAM_STM32F0) || defined(CPU_FAM_STM32F3)
-        while (!(dev(uart)->ISR & USART_ISR_TXE)) {}
-        dev(uart)->TDR = data[i];
+    while (len) {
+        unsigned state = irq_disable();
+        unsigned n = ringbuffer_add(&tx_buf[uart], (const char *)data, len);
+
+        if (n == 0 && poll) {
+            tx_poll(uart);
+        }
+        else {
+            tx_start(uart);
+        }
+        irq_restore(state);
+        data += n;
+        len -= n;
+    }
+    if (poll) {
+        /* nothing else sends the buffer */
+        uart_flush(uart);
+    }
+}
+
+void uart_flush(uart_t uart)
+{
+    int poll = tx_must_poll();
+    int empty;
+
+    assert(uart < UART_NUMOF);
+
+    do {
+        unsigned state = irq_disable();
+
+        empty = ringbuffer_empty(&tx_buf[uart]);
+        if (!empty && poll) {
+            tx_poll(uart);
+        }
+        irq_restore(state);
+    } while (!empty);
+
+    while (!(dev(uart)->STATUS & STATUS_TC)) {}
+}
 #else
-        while (!(dev(uart)->SR & USART_SR_TXE)) {}
-        dev(uart)->DR = data[i];
-#endif
+void uart_write(uart_t uart, const uint8_t *data, size_t len)
+{
+    assert(uart < UART_NUMOF);
+
+    for (size_t i = 0; i < len; i++) {
+        while (!(dev(uart)->STATUS & STATUS_TXE)) {}
+        dev(uart)->TXDATA = data[i];
     }
 
     /* make sure the function is synchronous by waiting for the transfer to
      * finish */
-#if defined(CPU_FAM_STM32F0) || defined(CPU_FAM_STM32F3)
-    while (!(dev(uart)->ISR & USART_ISR_TC)) {}
-#else
-    while (!(dev(uart)->SR & USART_SR_TC)) {}
-#endif
+    while (!(dev(uart)->STATUS & STATUS_TC)) {}
 }
+#endif /* MODULE_PERIPH_UART_NONBLOCKING */
 
 void uart_poweron(uart_t uart)
 {
@@ -131,6 +463,20 @@ void uart_poweroff(uart_t uart)
 
 static inline void irq_handler(uart_t uart)
 {
+#ifdef MODULE_PERIPH_UART_NONBLOCKING
+    if ((dev(uart)->CR1 & USART_CR1_TXEIE) &&
+        (dev(uart)->STATUS & STATUS_TXE)) {
+        int c = ringbuffer_get_one(&tx_buf[uart]);
+
+        if (c >= 0) {
+            dev(uart)->TXDATA = (uint8_t)c;
+        }
+        if (ringbuffer_empty(&tx_buf[uart])) {
+            dev(uart)->CR1 &= ~(USART_CR1_TXEIE);
+        }
+    }
+#endif
+
 #if defined(CPU_FAM_STM32F0) || defined(CPU_FAM_STM32F3)
 
     uint32_t status = dev(uart)->ISR;
@@ -146,6 +492,23 @@ static inline void irq_handler(uart_t uart)
 
     uint32_t status = dev(uart)->SR;
 
+#ifdef PERIPH_UART_HAS_RX_BLOCK
+    if (block_cb[uart] && has_dma(uart)) {
+        if (status & (USART_SR_IDLE | USART_SR_ORE)) {
+            /* IDLE and ORE are cleared by reading SR and DR sequentially */
+            dev(uart)->DR;
+            dma_deliver(uart);
+        }
+        cortexm_isr_end();
+        return;
+    }
+    if (block_cb[uart] && (status & USART_SR_RXNE)) {
+        uint8_t data = (uint8_t)dev(uart)->DR;
+
+        block_cb[uart](isr_ctx[uart].arg, &data, 1);
+    }
+    else
+#endif
     if (status & USART_SR_RXNE) {
         isr_ctx[uart].rx_cb(isr_ctx[uart].arg, (uint8_t)dev(uart)->DR);
     }
@@ -201,4 +564,80 @@ void UART_5_ISR(void)
 }
 #endif
 
+#ifdef PERIPH_UART_HAS_RX_BLOCK
+static inline void irq_handler_dma(uart_t uart)
+{
+    dma_isr_clear(uart_dma[uart].stream);
+    if (block_cb[uart]) {
+        dma_deliver(uart);
+    }
+    cortexm_isr_end();
+}
+
+#ifdef UART_0_DMA_RX_ISR
+void UART_0_DMA_RX_ISR(void)
+{
+    irq_handler_dma(UART_DEV(0));
+}
+#endif
+
+#ifdef UART_1_DMA_RX_ISR
+void UART_1_DMA_RX_ISR(void)
+{
+    irq_handler_dma(UART_DEV(1));
+}
+#endif
+
+#ifdef UART_2_DMA_RX_ISR
+void UART_2_DMA_RX_ISR(void)
+{
+    irq_handler_dma(UART_DEV(2));
+}
+#endif
+
+#ifdef UART_3_DMA_RX_ISR
+void UART_3_DMA_RX_ISR(void)
+{
+    irq_handler_dma(UART_DEV(3));
+}
+#endif
+#endif /* PERIPH_UART_HAS_RX_BLOCK */
+
+#if defined(MODULE_PERIPH_UART_NONBLOCKING) && defined(PERIPH_UART_HAS_TX_DMA)
+static inline void irq_handler_dma_tx(uart_t uart)
+{
+    dma_isr_clear(uart_tx_dma[uart].stream);
+    tx_start(uart);
+    cortexm_isr_end();
+}
+
+#ifdef UART_0_DMA_TX_ISR
+void UART_0_DMA_TX_ISR(void)
+{
+    irq_handler_dma_tx(UART_DEV(0));
+}
+#endif
+
+#ifdef UART_1_DMA_TX_ISR
+void UART_1_DMA_TX_ISR(void)
+{
+    irq_handler_dma_tx(UART_DEV(1));
+}
+#endif
+
+#ifdef UART_2_DMA_TX_ISR
+void UART_2_DMA_TX_ISR(void)
+{
+    irq_handler_dma_tx(UART_DEV(2));
+}
+#endif
+
+#ifdef UART_3_DMA_TX_ISR
+void UART_3_DMA_TX_ISR(void)
+{
+    irq_handler_dma_tx(UART_DEV(3));
+}
+#endif
+#endif /* MODULE_PERIPH_UART_NONBLOCKING && PERIPH_UART_HAS_TX_DMA */
+
 #endif /* UART_NUMOF */
@@ -113,7 +113,7 @@ static void clock_init(void)
     /* configure flash latency */
 
     /* enable pre-fetch buffer and set flash latency to 1 cycle*/
-    FLASH->ACR = FLASH_ACR_PRFTBE | FLASH_ACR_LATENCY;
+    stm32_flash_init(FLASH_ACR_LATENCY);
 
     /* configure the sysclock and the peripheral clocks */
 
@@ -131,7 +131,7 @@ static void clk_init(void)
      * NOTE: the MCU will stay here forever if you use an external clock source and it's not connected */
     while ((RCC->CR & CLOCK_CR_SOURCE_RDY) == 0) {}
     /* Enable prefetch buffer and set flash wait state */
-    FLASH->ACR = (uint32_t)(FLASH_ACR_PRFTBE | FLASH_LATENCY);
+    stm32_flash_init(FLASH_LATENCY);
     /* HCLK = SYSCLK */
     RCC->CFGR |= (uint32_t)CLOCK_AHB_DIV;
     /* PCLK2 = HCLK */
@@ -49,6 +49,8 @@ extern "C" {
  * @{
  */
 #define FLASHPAGE_SIZE      (2048U)
+#define FLASHPAGE_RAW_BLOCKSIZE (2U)
+#define FLASHPAGE_RAW_ALIGNMENT (2U)
 
 #if defined(CPU_MODEL_STM32F103C8)
 #define FLASHPAGE_NUMOF     (32U)
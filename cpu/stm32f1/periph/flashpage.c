@@ -25,12 +25,8 @@
 #define ENABLE_DEBUG        (0)
 #include "debug.h"
 
-void flashpage_write(int page, void *data)
+static uint32_t _unlock(void)
 {
-    assert(page < FLASHPAGE_NUMOF);
-
-    uint16_t *page_addr = flashpage_addr(page);
-    uint16_t *data_addr = (uint16_t *)data;
     uint32_t hsi_state = (RCC->CR & RCC_CR_HSION);
 
     /* the internal RC oscillator (HSI) must be enabled */
@@ -43,6 +39,60 @@ void flashpage_write(int page, void *data)
         FLASH->KEYR = FLASH_KEY1;
         FLASH->KEYR = FLASH_KEY2;
     }
+    return hsi_state;
+}
+
+static void _lock(uint32_t hsi_state)
+{
+    /* finally, lock the flash module again */
+    DEBUG("flashpage] now locking the flash module again\n");
+    FLASH->CR |= FLASH_CR_LOCK;
+
+    /* restore the HSI state */
+    if (!hsi_state) {
+        RCC->CR &= ~(RCC_CR_HSION);
+        while (RCC->CR & RCC_CR_HSIRDY) {}
+    }
+}
+
+static void _write_raw(uint16_t *target_addr, const uint16_t *data,
+                       size_t len)
+{
+    DEBUG("[flashpage] write: now writing the data\n");
+    /* set PG bit and program page to flash */
+    FLASH->CR |= FLASH_CR_PG;
+    for (unsigned i = 0; i < (len / FLASHPAGE_RAW_BLOCKSIZE); i++) {
+        *target_addr++ = data[i];
+        while (FLASH->SR & FLASH_SR_BSY) {}
+    }
+    /* clear program bit again */
+    FLASH->CR &= ~(FLASH_CR_PG);
+    DEBUG("[flashpage] write: done writing data\n");
+}
+
+void flashpage_write_raw(void *target_addr, const void *data, size_t len)
+{
+    /* only whole, aligned half-words can be written */
+    assert(!(len % FLASHPAGE_RAW_BLOCKSIZE));
+    assert(!((unsigned)target_addr % FLASHPAGE_RAW_ALIGNMENT));
+    assert(!((unsigned)data % FLASHPAGE_RAW_ALIGNMENT));
+    assert(((unsigned)target_addr + len) <=
+           (CPU_FLASH_BASE + (FLASHPAGE_SIZE * FLASHPAGE_NUMOF)));
+
+    uint32_t hsi_state = _unlock();
+
+    /* make sure no flash operation is ongoing */
+    while (FLASH->SR & FLASH_SR_BSY) {}
+    _write_raw(target_addr, data, len);
+
+    _lock(hsi_state);
+}
+
+void flashpage_write(int page, void *data)
+{
+    assert(page < FLASHPAGE_NUMOF);
+
+    uint32_t hsi_state = _unlock();
 
     /* ERASE sequence */
     /* make sure no flash operation is ongoing */
@@ -64,25 +114,8 @@ void flashpage_write(int page, void *data)
 
     /* WRITE sequence */
     if (data != NULL) {
-        DEBUG("[flashpage] write: now writing the data\n");
-        /* set PG bit and program page to flash */
-        FLASH->CR |= FLASH_CR_PG;
-        for (unsigned i = 0; i < (FLASHPAGE_SIZE / 2); i++) {
-            *page_addr++ = data_addr[i];
-            while (FLASH->SR & FLASH_SR_BSY) {}
-        }
-        /* clear program bit again */
-        FLASH->CR &= ~(FLASH_CR_PG);
-        DEBUG("[flashpage] write: done writing data\n");
+        _write_raw(flashpage_addr(page), data, FLASHPAGE_SIZE);
     }
 
-    /* finally, lock the flash module again */
-    DEBUG("flashpage] now locking the flash module again\n");
-    FLASH->CR |= FLASH_CR_LOCK;
-
-    /* restore the HSI state */
-    if (hsi_state) {
-        RCC->CR &= ~(RCC_CR_HSION);
-        while (RCC->CR & RCC_CR_HSIRDY) {}
-    }
+    _lock(hsi_state);
 }
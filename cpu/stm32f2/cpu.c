@@ -67,10 +67,7 @@ static void clk_init(void)
      * NOTE: the MCU will stay here forever if no HSE clock is connected */
     while ((RCC->CR & RCC_CR_SOURCE_RDY) == 0);
     /* Configure Flash prefetch, Instruction cache, Data cache and wait state */
-    FLASH->ACR = FLASH_ACR_PRFTEN | FLASH_ACR_ICEN | FLASH_ACR_DCEN;
-    /* Flash 2 wait state */
-    FLASH->ACR &= ~((uint32_t)FLASH_ACR_LATENCY);
-    FLASH->ACR |= (uint32_t)CLOCK_FLASH_LATENCY;
+    stm32_flash_init(CLOCK_FLASH_LATENCY);
     /* HCLK = SYSCLK */
     RCC->CFGR |= (uint32_t)CLOCK_AHB_DIV;
     /* PCLK2 = HCLK */
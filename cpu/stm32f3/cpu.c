@@ -116,13 +116,8 @@ static void cpu_clock_init(void)
 
     /* configure flash latency */
 
-    /* reset flash access control register */
-    FLASH->ACR = 0;
-    /* enable pre-fetch buffer */
-    FLASH->ACR |= FLASH_ACR_PRFTBE;
-    /* set flash latency */
-    FLASH->ACR &= ~FLASH_ACR_LATENCY;
-    FLASH->ACR |= CLOCK_FLASH_LATENCY;
+    /* set flash latency and enable the pre-fetch buffer */
+    stm32_flash_init(CLOCK_FLASH_LATENCY);
 
     /* configure the sysclock and the peripheral clocks */
 
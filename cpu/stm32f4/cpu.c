@@ -127,17 +127,8 @@ static void cpu_clock_init(void)
 
     /* configure flash latency */
 
-    /* reset flash access control register */
-    FLASH->ACR = 0;
-    /* enable instruction cache */
-    FLASH->ACR |= FLASH_ACR_ICEN;
-    /* enable data cache */
-    FLASH->ACR |= FLASH_ACR_DCEN;
-    /* enable pre-fetch buffer */
-    // FLASH->ACR |= FLASH_ACR_PRFTEN;
-    /* set flash latency */
-    FLASH->ACR &= ~FLASH_ACR_LATENCY;
-    FLASH->ACR |= CLOCK_FLASH_LATENCY;
+    /* set flash latency, enable the caches and the pre-fetch buffer */
+    stm32_flash_init(CLOCK_FLASH_LATENCY);
 
     /* configure the sysclock and the peripheral clocks */
 
@@ -43,6 +43,31 @@ extern "C" {
 #define PERIPH_SPI_NEEDS_TRANSFER_REGS
 /** @} */
 
+/**
+ * @brief   SPI transfers can use DMA, see spi_transfer_bytes_dma()
+ *
+ * The board enables DMA for a SPI device by defining SPI_x_DMA_RX_STREAM,
+ * SPI_x_DMA_TX_STREAM, SPI_x_DMA_CHAN and SPI_x_DMA_RX_ISR.
+ */
+#define PERIPH_SPI_HAS_DMA
+
+/**
+ * @brief   UART devices can receive in blocks using DMA, see uart_init_block()
+ *
+ * The board enables DMA for a UART device by defining UART_x_DMA_RX_STREAM,
+ * UART_x_DMA_RX_CHAN and UART_x_DMA_RX_ISR.
+ */
+#define PERIPH_UART_HAS_RX_BLOCK
+
+/**
+ * @brief   UART devices can send their transmit buffer using DMA
+ *
+ * Used with the `periph_uart_nonblocking` module, the board enables it for a
+ * UART device by defining UART_x_DMA_TX_STREAM, UART_x_DMA_TX_CHAN and
+ * UART_x_DMA_TX_ISR.
+ */
+#define PERIPH_UART_HAS_TX_DMA
+
 #ifndef DOXYGEN
 /**
  * @brief   Override the ADC resolution configuration
@@ -195,6 +220,19 @@ static inline uint32_t dma_ifc(int stream)
     }
 }
 
+/**
+ * @brief   Clear all interrupt flags of the given DMA stream
+ *
+ * @param[in] stream    logical DMA stream
+ */
+static inline void dma_isr_clear(int stream)
+{
+    /* the flags of the 4 streams of each register are at bit 0, 6, 16, 22 */
+    uint32_t shift = ((stream & 0x3) * 6) + ((stream & 0x2) ? 4 : 0);
+
+    dma_base(stream)->IFCR[dma_hl(stream)] = (0x3d << shift);
+}
+
 static inline void dma_isr_enable(int stream)
 {
     if (stream < 7) {
@@ -122,6 +122,123 @@ int adc_sample(adc_t line, adc_res_t res)
     return sample;
 }
 
+#ifdef ADC_CONT_DMA_STREAM
+/**
+ * @brief   State of the continuous sampling, there is only one timer and DMA
+ *          stream for it
+ */
+static struct {
+    adc_cont_cb_t cb;
+    void *arg;
+    uint16_t *buf;
+    size_t len;
+} cont;
+
+int adc_continuous_start(adc_t line, adc_res_t res, uint32_t freq,
+                         uint16_t *buf, size_t len, adc_cont_cb_t cb,
+                         void *arg)
+{
+    DMA_Stream_TypeDef *stream = dma_stream(ADC_CONT_DMA_STREAM);
+    uint32_t clk = periph_apb_clk(ADC_CONT_TIM_BUS);
+    uint32_t ticks, psc;
+
+    /* the DMA counts at most 0xffff transfers */
+    if ((res < 0xff) || (line >= ADC_NUMOF) || (freq == 0) ||
+        (adc_config[line].dev != ADC_CONT_DEV) || (len < 2) || (len & 1) ||
+        (len > 0xffff) || (cb == NULL)) {
+        return -1;
+    }
+    if (cont.cb) {
+        return -2;
+    }
+    /* timers run at twice the APB clock if the APB prescaler is not 1 */
+    if (clk < CLOCK_CORECLOCK) {
+        clk *= 2;
+    }
+    ticks = clk / freq;
+    psc = ticks >> 16;
+    if ((ticks == 0) || (psc > 0xffff)) {
+        return -1;
+    }
+
+    /* lock and power on the ADC device until sampling is stopped */
+    prep(line);
+    cont.cb = cb;
+    cont.arg = arg;
+    cont.buf = buf;
+    cont.len = len;
+
+    /* move each conversion result into buf, wrapping around at its end */
+    dma_poweron(ADC_CONT_DMA_STREAM);
+    stream->CR = 0;
+    while (stream->CR & DMA_SxCR_EN) {}
+    dma_isr_clear(ADC_CONT_DMA_STREAM);
+    stream->PAR = (uint32_t)&dev(line)->DR;
+    stream->M0AR = (uint32_t)buf;
+    stream->NDTR = (uint16_t)len;
+    stream->CR = ((uint32_t)ADC_CONT_DMA_CHAN << 25) |
+                 DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 | DMA_SxCR_MINC |
+                 DMA_SxCR_CIRC | DMA_SxCR_HTIE | DMA_SxCR_TCIE;
+    dma_isr_enable(ADC_CONT_DMA_STREAM);
+    stream->CR |= DMA_SxCR_EN;
+
+    /* convert on each rising edge of the timer's trigger output */
+    dev(line)->CR1 = res;
+    dev(line)->SQR3 = adc_config[line].chan;
+    dev(line)->CR2 = ADC_CR2_ADON | ADC_CR2_DMA | ADC_CR2_DDS |
+                     ((uint32_t)ADC_CONT_TIM_EXTSEL << 24) | ADC_CR2_EXTEN_0;
+
+    /* emit the trigger output on each update event */
+    periph_clk_en(ADC_CONT_TIM_BUS, ADC_CONT_TIM_RCC);
+    ADC_CONT_TIM->CR1 = 0;
+    ADC_CONT_TIM->PSC = psc;
+    ADC_CONT_TIM->ARR = (ticks / (psc + 1)) - 1;
+    ADC_CONT_TIM->CR2 = TIM_CR2_MMS_1;
+    ADC_CONT_TIM->EGR = TIM_EGR_UG;
+    ADC_CONT_TIM->CR1 = TIM_CR1_CEN;
+
+    return 0;
+}
+
+void adc_continuous_stop(adc_t line)
+{
+    DMA_Stream_TypeDef *stream = dma_stream(ADC_CONT_DMA_STREAM);
+
+    if (!cont.cb) {
+        return;
+    }
+    ADC_CONT_TIM->CR1 = 0;
+    periph_clk_dis(ADC_CONT_TIM_BUS, ADC_CONT_TIM_RCC);
+    dev(line)->CR2 = ADC_CR2_ADON;
+    stream->CR &= ~(DMA_SxCR_EN);
+    while (stream->CR & DMA_SxCR_EN) {}
+    dma_isr_clear(ADC_CONT_DMA_STREAM);
+    cont.cb = NULL;
+    done(line);
+}
+
+void ADC_CONT_DMA_ISR(void)
+{
+    /* the flags of the 4 streams of each register are at bit 0, 6, 16, 22 */
+    uint32_t shift = ((ADC_CONT_DMA_STREAM & 0x3) * 6) +
+                     ((ADC_CONT_DMA_STREAM & 0x2) ? 4 : 0);
+    uint32_t flags = dma_base(ADC_CONT_DMA_STREAM)->ISR[dma_hl(ADC_CONT_DMA_STREAM)];
+    size_t half = cont.len / 2;
+
+    dma_isr_clear(ADC_CONT_DMA_STREAM);
+    if (cont.cb) {
+        /* HTIF is bit 4 and TCIF is bit 5 of a stream's flags */
+        if (flags & (DMA_LISR_HTIF0 << shift)) {
+            cont.cb(cont.arg, cont.buf, half);
+        }
+        if (flags & (DMA_LISR_TCIF0 << shift)) {
+            cont.cb(cont.arg, cont.buf + half, half);
+        }
+    }
+    cortexm_isr_end();
+}
+#endif /* ADC_CONT_DMA_STREAM */
+
 #else
 typedef int dont_be_pedantic;
 #endif /* ADC_CONFIG */
@@ -75,11 +75,90 @@ static mutex_t locks[] =  {
 #endif
 };
 
+/**
+ * @brief Master configuration last applied to each device, 0 if unknown
+ *
+ * Drivers sharing a bus with the same mode and speed then do not reset and
+ * reprogram the device again.
+ */
+static uint8_t conf_cache[SPI_NUMOF];
+
+#define CONF_CACHE_KEY(conf, speed)     (0x80 | ((conf) << 4) | (speed))
+
+/**
+ * @brief DMA streams used by each SPI device, -1 if the device has none
+ */
+typedef struct {
+    int8_t rx_stream;
+    int8_t tx_stream;
+    uint8_t chan;
+} spi_dma_t;
+
+static const spi_dma_t spi_dma[] = {
+#if SPI_0_EN
+#ifdef SPI_0_DMA_RX_STREAM
+    [SPI_0] = { SPI_0_DMA_RX_STREAM, SPI_0_DMA_TX_STREAM, SPI_0_DMA_CHAN },
+#else
+    [SPI_0] = { -1, -1, 0 },
+#endif
+#endif
+#if SPI_1_EN
+#ifdef SPI_1_DMA_RX_STREAM
+    [SPI_1] = { SPI_1_DMA_RX_STREAM, SPI_1_DMA_TX_STREAM, SPI_1_DMA_CHAN },
+#else
+    [SPI_1] = { -1, -1, 0 },
+#endif
+#endif
+#if SPI_2_EN
+#ifdef SPI_2_DMA_RX_STREAM
+    [SPI_2] = { SPI_2_DMA_RX_STREAM, SPI_2_DMA_TX_STREAM, SPI_2_DMA_CHAN },
+#else
+    [SPI_2] = { -1, -1, 0 },
+#endif
+#endif
+};
+
+/**
+ * @brief Unlocked by the DMA interrupt when a transfer is complete
+ */
+static mutex_t dma_done[] = {
+#if SPI_0_EN
+    [SPI_0] = MUTEX_INIT_LOCKED,
+#endif
+#if SPI_1_EN
+    [SPI_1] = MUTEX_INIT_LOCKED,
+#endif
+#if SPI_2_EN
+    [SPI_2] = MUTEX_INIT_LOCKED
+#endif
+};
+
+/**
+ * @brief Source and sink for transfers that only send or only receive
+ */
+static uint8_t dma_dummy_out = 0;
+static uint8_t dma_dummy_in;
+
+static void dma_init(spi_t dev)
+{
+    if (spi_dma[dev].rx_stream < 0) {
+        return;
+    }
+    dma_poweron(spi_dma[dev].rx_stream);
+    dma_poweron(spi_dma[dev].tx_stream);
+    dma_isr_enable(spi_dma[dev].rx_stream);
+}
+
 int spi_init_master(spi_t dev, spi_conf_t conf, spi_speed_t speed)
 {
     uint8_t speed_devider;
     SPI_TypeDef *spi_port;
 
+    if ((dev < SPI_NUMOF) && (conf_cache[dev] == CONF_CACHE_KEY(conf, speed))) {
+        /* already configured like this, e.g., by another driver on the bus */
+        return 0;
+    }
+
     switch (speed) {
         case SPI_SPEED_100KHZ:
             return -2;          /* not possible for stm32f4, APB2 minimum is 328 kHz */
@@ -149,6 +228,8 @@ int spi_init_master(spi_t dev, spi_conf_t conf, spi_speed_t speed)
     spi_port->CR1 |= (conf);
     /* enable SPI */
     spi_port->CR1 |= (SPI_CR1_SPE);
+    dma_init(dev);
+    conf_cache[dev] = CONF_CACHE_KEY(conf, speed);
     return 0;
 }
 
@@ -156,6 +237,10 @@ int spi_init_slave(spi_t dev, spi_conf_t conf, char(*cb)(char data))
 {
     SPI_TypeDef *spi_port;
 
+    if (dev < SPI_NUMOF) {
+        conf_cache[dev] = 0;
+    }
+
     switch (dev) {
 #if SPI_0_EN
         case SPI_0:
@@ -347,6 +432,67 @@ int spi_transfer_byte(spi_t dev, char out, char *in)
     return 1;
 }
 
+int spi_transfer_bytes_dma(spi_t dev, char *out, char *in, unsigned int length)
+{
+    SPI_TypeDef *spi_port;
+    DMA_Stream_TypeDef *rx, *tx;
+    uint32_t chsel;
+
+    switch (dev) {
+#if SPI_0_EN
+        case SPI_0:
+            spi_port = SPI_0_DEV;
+            break;
+#endif
+#if SPI_1_EN
+        case SPI_1:
+            spi_port = SPI_1_DEV;
+            break;
+#endif
+#if SPI_2_EN
+        case SPI_2:
+            spi_port = SPI_2_DEV;
+            break;
+#endif
+        default:
+            return -1;
+    }
+
+    if ((length < SPI_DMA_MIN_LEN) || (spi_dma[dev].rx_stream < 0)) {
+        return spi_transfer_bytes(dev, out, in, length);
+    }
+
+    rx = dma_stream(spi_dma[dev].rx_stream);
+    tx = dma_stream(spi_dma[dev].tx_stream);
+    chsel = ((uint32_t)spi_dma[dev].chan << 25);
+    dma_isr_clear(spi_dma[dev].rx_stream);
+    dma_isr_clear(spi_dma[dev].tx_stream);
+
+    /* every byte sent clocks in one byte, so the end of the RX stream marks
+     * the end of the transfer */
+    rx->PAR = (uint32_t)&(spi_port->DR);
+    rx->M0AR = (in != NULL) ? (uint32_t)in : (uint32_t)&dma_dummy_in;
+    rx->NDTR = length;
+    rx->CR = chsel | ((in != NULL) ? DMA_SxCR_MINC : 0) | DMA_SxCR_TCIE;
+    tx->PAR = (uint32_t)&(spi_port->DR);
+    tx->M0AR = (out != NULL) ? (uint32_t)out : (uint32_t)&dma_dummy_out;
+    tx->NDTR = length;
+    tx->CR = chsel | ((out != NULL) ? DMA_SxCR_MINC : 0) | DMA_SxCR_DIR_0;
+
+    spi_port->CR2 |= SPI_CR2_RXDMAEN;
+    rx->CR |= DMA_SxCR_EN;
+    tx->CR |= DMA_SxCR_EN;
+    spi_port->CR2 |= SPI_CR2_TXDMAEN;
+
+    mutex_lock(&dma_done[dev]);
+
+    spi_port->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+    tx->CR = 0;
+    rx->CR = 0;
+
+    return length;
+}
+
 void spi_transmission_begin(spi_t dev, char reset_val)
 {
 
@@ -392,6 +538,9 @@ void spi_poweron(spi_t dev)
 
 void spi_poweroff(spi_t dev)
 {
+    if (dev < SPI_NUMOF) {
+        conf_cache[dev] = 0;
+    }
     switch (dev) {
 #if SPI_0_EN
         case SPI_0:
@@ -448,4 +597,32 @@ void SPI_2_IRQ_HANDLER(void)
 }
 #endif
 
+static inline void irq_handler_dma(spi_t dev)
+{
+    dma_isr_clear(spi_dma[dev].rx_stream);
+    mutex_unlock(&dma_done[dev]);
+    cortexm_isr_end();
+}
+
+#if SPI_0_EN && defined(SPI_0_DMA_RX_ISR)
+void SPI_0_DMA_RX_ISR(void)
+{
+    irq_handler_dma(SPI_0);
+}
+#endif
+
+#if SPI_1_EN && defined(SPI_1_DMA_RX_ISR)
+void SPI_1_DMA_RX_ISR(void)
+{
+    irq_handler_dma(SPI_1);
+}
+#endif
+
+#if SPI_2_EN && defined(SPI_2_DMA_RX_ISR)
+void SPI_2_DMA_RX_ISR(void)
+{
+    irq_handler_dma(SPI_2);
+}
+#endif
+
 #endif /* SPI_NUMOF */
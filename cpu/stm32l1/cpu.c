@@ -69,11 +69,8 @@ static void clk_init(void)
     /* Wait till the high speed clock source is ready
      * NOTE: the MCU will stay here forever if you use an external clock source and it's not connected */
     while (!(RCC->CR & CLOCK_CR_SOURCE_RDY)) {}
-    FLASH->ACR |= FLASH_ACR_ACC64;
-    /* Enable Prefetch Buffer */
-    FLASH->ACR |= FLASH_ACR_PRFTEN;
-    /* Flash 1 wait state */
-    FLASH->ACR |= CLOCK_FLASH_LATENCY;
+    /* 64-bit access, prefetch buffer and flash wait states */
+    stm32_flash_init(CLOCK_FLASH_LATENCY);
     /* Power enable */
     periph_clk_en(APB1, RCC_APB1ENR_PWREN);
     /* Select the Voltage Range 1 (1.8 V) */
@@ -274,7 +274,7 @@ static bool add_pages_to_pool(uint64_t start, uint64_t end)
 
     if (start < end) {
         cr3_write((uint32_t) &pdpt | PT_CR3_BITS); /* flush tlb */
-        tlsf_add_pool((void *) init_free_pages_heap_position, end - start);
+        tlsf_malloc_add_pool((void *) init_free_pages_heap_position, end - start);
         init_free_pages_heap_position += end - start;
     }
 
@@ -0,0 +1,152 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+'''
+Converts the trace file of a native instance started with `-t <file>` (see
+cpu/native/include/native_trace.h) to the Chrome trace event format, which
+is shown by chrome://tracing and https://ui.perfetto.dev.
+'''
+
+from __future__ import print_function
+import argparse
+import collections
+import json
+import signal
+import struct
+import sys
+
+NATIVE_TRACE_MAGIC = 0x52545243
+
+SWITCH = 1
+ISR_ENTER = 2
+ISR_EXIT = 3
+MSG_SEND = 4
+MSG_RECV = 5
+
+# magic, slots, hz, count, isr_pid
+HDR = struct.Struct("<IIQII")
+# time, type, pid, arg
+EVENT = struct.Struct("<QHhI")
+
+# thread id of the interrupt track
+ISR_TID = -1
+
+
+def read_events(data):
+    magic, slots, hz, count, isr_pid = HDR.unpack_from(data)
+    if magic != NATIVE_TRACE_MAGIC:
+        sys.exit("error: no native trace file")
+    if len(data) < HDR.size + (slots * EVENT.size):
+        sys.exit("error: trace file is truncated")
+
+    # the oldest events were overwritten if the ring wrapped around
+    first = max(0, count - slots)
+    events = []
+    for n in range(first, count):
+        events.append(EVENT.unpack_from(data, HDR.size +
+                                        ((n % slots) * EVENT.size)))
+    return hz, isr_pid, count - first, first, events
+
+
+def signal_name(sig):
+    try:
+        return signal.Signals(sig).name
+    except (AttributeError, ValueError):
+        return "signal %d" % sig
+
+
+def convert(hz, isr_pid, events):
+    out = []
+    threads = set()
+    # messages in flight per (sender, target, type), to draw arrows
+    flows = collections.defaultdict(collections.deque)
+    flow_id = 0
+    running = None
+    t0 = events[0][0] if events else 0
+
+    def us(t):
+        return ((t - t0) * 1e6) / hz
+
+    def name(pid):
+        return "ISR" if pid == isr_pid else pid
+
+    for time, type, pid, arg in events:
+        ts = us(time)
+        if type == SWITCH:
+            if running is not None:
+                out.append({"ph": "E", "pid": 0, "tid": running[0],
+                            "ts": ts})
+            threads.add(pid)
+            out.append({"ph": "B", "pid": 0, "tid": pid, "ts": ts,
+                        "name": "running"})
+            running = (pid, ts)
+        elif type in (ISR_ENTER, ISR_EXIT):
+            out.append({"ph": "B" if type == ISR_ENTER else "E", "pid": 0,
+                        "tid": ISR_TID, "ts": ts,
+                        "name": signal_name(arg)})
+        elif type == MSG_SEND:
+            target, msg_type = arg >> 16, arg & 0xffff
+            tid = ISR_TID if pid == isr_pid else pid
+            threads.add(tid)
+            out.append({"ph": "i", "s": "t", "pid": 0, "tid": tid,
+                        "ts": ts, "name": "send 0x%04x" % msg_type,
+                        "args": {"to": name(target)}})
+            flow_id += 1
+            flows[(pid, target, msg_type)].append(flow_id)
+            out.append({"ph": "s", "pid": 0, "tid": tid, "ts": ts,
+                        "id": flow_id, "name": "msg", "cat": "msg"})
+        elif type == MSG_RECV:
+            sender, msg_type = arg >> 16, arg & 0xffff
+            threads.add(pid)
+            out.append({"ph": "i", "s": "t", "pid": 0, "tid": pid,
+                        "ts": ts, "name": "recv 0x%04x" % msg_type,
+                        "args": {"from": name(sender)}})
+            pending = flows.get((sender, pid, msg_type))
+            if pending:
+                out.append({"ph": "f", "bp": "e", "pid": 0, "tid": pid,
+                            "ts": ts, "id": pending.popleft(),
+                            "name": "msg", "cat": "msg"})
+
+    if running is not None:
+        out.append({"ph": "E", "pid": 0, "tid": running[0],
+                    "ts": us(events[-1][0])})
+
+    out.append({"ph": "M", "pid": 0, "name": "process_name",
+                "args": {"name": "RIOT native"}})
+    out.append({"ph": "M", "pid": 0, "tid": ISR_TID, "name": "thread_name",
+                "args": {"name": "ISR"}})
+    for tid in sorted(threads - {ISR_TID}):
+        out.append({"ph": "M", "pid": 0, "tid": tid, "name": "thread_name",
+                    "args": {"name": "pid %d" % tid}})
+    return out
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__)
+    p.add_argument("trace", help="trace file written by the native instance")
+    p.add_argument("output", nargs="?", default="-",
+                   help="JSON output file (default: stdout)")
+    args = p.parse_args()
+
+    with open(args.trace, "rb") as f:
+        data = f.read()
+    hz, isr_pid, num, lost, events = read_events(data)
+    print("%d events, %d overwritten, %d ticks/s" % (num, lost, hz),
+          file=sys.stderr)
+
+    trace = {"traceEvents": convert(hz, isr_pid, events), "displayTimeUnit": "ns"}
+    if args.output == "-":
+        json.dump(trace, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+
+
+if __name__ == "__main__":
+    main()
@@ -11,6 +11,7 @@
 #include <string.h>
 #include <unistd.h>
 #include <stdio.h>
+#include <time.h>
 #include <netdb.h>
 #include <net/if.h>
 #include <arpa/inet.h>
@@ -19,6 +20,8 @@
 
 char _prefix[16];
 unsigned _prefix_len;
+/* changes with every start, so clients reconfigure a changed prefix */
+uint32_t _lease;
 
 static const char *BIND_OPTION = "--bind-to-device";
 static void bind_to_device(int sock, const char *interface);
@@ -62,6 +65,8 @@ int main(int argc, char *argv[])
         exit(1);
     }
 
+    _lease = (uint32_t)time(NULL);
+
     if (argc == 4) {
         if (strcmp(BIND_OPTION, argv[3])) {
             fprintf(stderr, "error: unkwown option\n");
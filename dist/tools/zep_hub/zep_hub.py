@@ -0,0 +1,97 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+'''
+Creates the shared memory file of a ZEP hub (see cpu/native/include/zep_hub.h)
+for a simulation of native instances using `zep_init hub <file> <node>`.
+'''
+
+from __future__ import print_function
+import argparse
+import struct
+import sys
+
+ZEP_HUB_MAGIC = 0x5a455048
+ZEP_HUB_SLOTS = 16
+ZEP_HUB_FRAME_LEN = 168
+ZEP_HUB_NO_LINK = 0xff
+
+# lock, head, tail, dropped and the slots of uint16_t len + frame
+RING_SIZE = (4 * 4) + (ZEP_HUB_SLOTS * (2 + ZEP_HUB_FRAME_LEN))
+
+
+def matrix_size(nodes):
+    return ((nodes * nodes) + 7) & ~7
+
+
+def link(matrix, nodes, a, b, loss):
+    if a >= nodes or b >= nodes:
+        sys.exit("error: link %d - %d: node out of range" % (a, b))
+    matrix[(a * nodes) + b] = loss
+    matrix[(b * nodes) + a] = loss
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("file", help="hub file to create")
+    parser.add_argument("nodes", type=int, help="number of nodes")
+    topo = parser.add_mutually_exclusive_group(required=True)
+    topo.add_argument("--full", action="store_true",
+                      help="all nodes are linked to each other")
+    topo.add_argument("--line", action="store_true",
+                      help="node n is linked to n - 1 and n + 1")
+    topo.add_argument("--grid", type=int, metavar="WIDTH",
+                      help="nodes form a grid of WIDTH columns")
+    topo.add_argument("--edges", metavar="FILE",
+                      help="links from lines of \"<a> <b> [<loss>]\"")
+    parser.add_argument("--loss", type=int, default=0,
+                        help="loss of each link in percent (default: 0)")
+    args = parser.parse_args()
+
+    if args.nodes < 1:
+        sys.exit("error: need at least one node")
+    if not 0 <= args.loss <= 100:
+        sys.exit("error: loss must be between 0 and 100")
+
+    nodes = args.nodes
+    matrix = bytearray([ZEP_HUB_NO_LINK] * matrix_size(nodes))
+
+    if args.full:
+        for a in range(nodes):
+            for b in range(a + 1, nodes):
+                link(matrix, nodes, a, b, args.loss)
+    elif args.line:
+        for a in range(nodes - 1):
+            link(matrix, nodes, a, a + 1, args.loss)
+    elif args.grid:
+        for a in range(nodes):
+            if ((a + 1) % args.grid) and (a + 1 < nodes):
+                link(matrix, nodes, a, a + 1, args.loss)
+            if a + args.grid < nodes:
+                link(matrix, nodes, a, a + args.grid, args.loss)
+    else:
+        with open(args.edges) as edges:
+            for line in edges:
+                fields = line.split("#")[0].split()
+                if not fields:
+                    continue
+                loss = int(fields[2]) if len(fields) > 2 else args.loss
+                link(matrix, nodes, int(fields[0]), int(fields[1]), loss)
+
+    with open(args.file, "wb") as hub:
+        hub.write(struct.pack("=II", ZEP_HUB_MAGIC, nodes))
+        hub.write(matrix)
+        hub.write(bytearray(RING_SIZE * nodes))
+
+    print("%s: %d nodes, %d bytes" % (args.file, nodes,
+          8 + len(matrix) + (RING_SIZE * nodes)))
+
+
+if __name__ == "__main__":
+    main()
@@ -146,6 +146,23 @@ void at86rf2xx_set_chan(at86rf2xx_t *dev, uint8_t channel)
 
     dev->netdev.chan = channel;
 
+#ifndef MODULE_AT86RF212B
+    /* The PLL of the 2.4 GHz transceivers follows a new channel in any
+     * non-busy awake state, so only a sleeping or busy device takes the
+     * detour over TRX_OFF */
+    uint8_t state = at86rf2xx_get_status(dev);
+
+    if ((state == AT86RF2XX_STATE_TRX_OFF) || (state == AT86RF2XX_STATE_PLL_ON) ||
+        (state == AT86RF2XX_STATE_RX_AACK_ON) || (state == AT86RF2XX_STATE_TX_ARET_ON)) {
+        uint8_t phy_cc_cca = at86rf2xx_reg_read(dev, AT86RF2XX_REG__PHY_CC_CCA);
+
+        phy_cc_cca &= ~(AT86RF2XX_PHY_CC_CCA_MASK__CHANNEL);
+        phy_cc_cca |= (channel & AT86RF2XX_PHY_CC_CCA_MASK__CHANNEL);
+        at86rf2xx_reg_write(dev, AT86RF2XX_REG__PHY_CC_CCA, phy_cc_cca);
+        return;
+    }
+#endif
+
     at86rf2xx_configure_phy(dev);
 }
 
@@ -66,7 +66,7 @@ void at86rf2xx_sram_read(const at86rf2xx_t *dev,
     spi_transfer_reg(dev->params.spi,
                      AT86RF2XX_ACCESS_SRAM | AT86RF2XX_ACCESS_READ,
                      (char)offset, NULL);
-    spi_transfer_bytes(dev->params.spi, NULL, (char *)data, len);
+    spi_transfer_bytes_dma(dev->params.spi, NULL, (char *)data, len);
     gpio_set(dev->params.cs_pin);
     spi_release(dev->params.spi);
 }
@@ -81,7 +81,7 @@ void at86rf2xx_sram_write(const at86rf2xx_t *dev,
     spi_transfer_reg(dev->params.spi,
                      AT86RF2XX_ACCESS_SRAM | AT86RF2XX_ACCESS_WRITE,
                      (char)offset, NULL);
-    spi_transfer_bytes(dev->params.spi, (char *)data, NULL, len);
+    spi_transfer_bytes_dma(dev->params.spi, (char *)data, NULL, len);
     gpio_set(dev->params.cs_pin);
     spi_release(dev->params.spi);
 }
@@ -99,7 +99,7 @@ void at86rf2xx_fb_read(const at86rf2xx_t *dev,
                        uint8_t *data,
                        const size_t len)
 {
-    spi_transfer_bytes(dev->params.spi, NULL, (char *)data, len);
+    spi_transfer_bytes_dma(dev->params.spi, NULL, (char *)data, len);
 }
 
 void at86rf2xx_fb_stop(const at86rf2xx_t *dev)
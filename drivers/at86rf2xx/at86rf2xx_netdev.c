@@ -113,11 +113,11 @@ static int _send(netdev2_t *netdev, const struct iovec *vector, unsigned count)
                   (unsigned)len + 2);
             return -EOVERFLOW;
         }
-#ifdef MODULE_NETSTATS_L2
-        netdev->stats.tx_bytes += len;
-#endif
         len = at86rf2xx_tx_load(dev, ptr->iov_base, ptr->iov_len, len);
     }
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.tx_bytes += len;
+#endif
 
     /* send data out directly if pre-loading id disabled */
     if (!(dev->netdev.flags & AT86RF2XX_OPT_PRELOADING)) {
@@ -298,6 +298,28 @@ static int _get(netdev2_t *netdev, netopt_t opt, void *val, size_t max_len)
                 !!(dev->netdev.flags & AT86RF2XX_OPT_CSMA);
             return sizeof(netopt_enable_t);
 
+        case NETOPT_AUTOACK:
+            *((netopt_enable_t *)val) =
+                !!(dev->netdev.flags & AT86RF2XX_OPT_AUTOACK);
+            return sizeof(netopt_enable_t);
+
+        case NETOPT_OFFLOADS:
+            if (max_len < sizeof(uint16_t)) {
+                return -EOVERFLOW;
+            }
+            /* the transceiver always sends in extended operating mode */
+            *((uint16_t *)val) = NETOPT_OFFLOAD_RETRANS;
+            if (!(dev->netdev.flags & AT86RF2XX_OPT_PROMISCUOUS)) {
+                *((uint16_t *)val) |= NETOPT_OFFLOAD_ADDR_FILTER;
+                if (dev->netdev.flags & AT86RF2XX_OPT_AUTOACK) {
+                    *((uint16_t *)val) |= NETOPT_OFFLOAD_AUTOACK;
+                }
+            }
+            if (dev->netdev.flags & AT86RF2XX_OPT_CSMA) {
+                *((uint16_t *)val) |= NETOPT_OFFLOAD_CSMA;
+            }
+            return sizeof(uint16_t);
+
         default:
             /* Can still be handled in second switch */
             break;
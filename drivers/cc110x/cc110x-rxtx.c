@@ -81,43 +81,79 @@ static void _rx_read_data(cc110x_t *dev, void(*callback)(void*), void*arg)
     }
 
     cc110x_pkt_buf_t *pkt_buf = &dev->pkt_buf;
+    char *pkt = (char *)&pkt_buf->packet;
+    int pkt_len, to_read;
+
     if (!pkt_buf->pos) {
-        pkt_buf->pos = 1;
-        pkt_buf->packet.length = cc110x_read_reg(dev, CC110X_RXFIFO);
+        /* the length byte comes with the first burst. As the length is not
+         * known yet, leave at least one byte as per spec sheet. */
+        to_read = fifo - 1;
+        if (to_read > (int)sizeof(cc110x_pkt_t)) {
+            to_read = sizeof(cc110x_pkt_t);
+        }
+        if (!to_read) {
+            gpio_irq_enable(dev->params.gdo2);
+            return;
+        }
+        cc110x_readburst_reg(dev, CC110X_RXFIFO, pkt, to_read);
+        pkt_buf->pos = to_read;
 
         /* Possible packet received, RX -> IDLE (0.1 us) */
         dev->cc110x_statistic.packets_in++;
+
+        pkt_len = pkt_buf->packet.length + 1;
+        if ((pkt_buf->packet.length < CC110X_HEADER_LENGTH) ||
+            (pkt_len > (int)sizeof(cc110x_pkt_t)) ||
+            (to_read > pkt_len + (int)sizeof(pkt_buf->status))) {
+            DEBUG("%s:%s:%u invalid length\n", RIOT_FILE_RELATIVE, __func__,
+                  __LINE__);
+            _rx_abort(dev);
+            return;
+        }
+        if (to_read > pkt_len) {
+            /* a short packet: status bytes came along, too */
+            memcpy(pkt_buf->status, &pkt[pkt_len], to_read - pkt_len);
+        }
     }
+    else {
+        pkt_len = pkt_buf->packet.length + 1;
 
-    int left = pkt_buf->packet.length+1 - pkt_buf->pos;
+        int left = pkt_len + (int)sizeof(pkt_buf->status) - pkt_buf->pos;
 
-    /* if the fifo doesn't contain the rest of the packet,
-     * leav at least one byte as per spec sheet. */
-    int to_read = (fifo < left) ? (fifo-1) : fifo;
-    if (to_read > left) {
-        to_read = left;
-    }
+        /* if the fifo doesn't contain the rest of the packet,
+         * leav at least one byte as per spec sheet. */
+        to_read = (fifo < left) ? (fifo-1) : left;
+
+        if (to_read) {
+            /* the rest of the packet and the status bytes in one burst */
+            int data_len = pkt_len - pkt_buf->pos;
+            char *status = NULL;
 
-    if (to_read) {
-        cc110x_readburst_reg(dev, CC110X_RXFIFO,
-                ((char *)&pkt_buf->packet)+pkt_buf->pos, to_read);
-        pkt_buf->pos += to_read;
+            if (data_len < 0) {
+                data_len = 0;
+            }
+            else if (data_len > to_read) {
+                data_len = to_read;
+            }
+            if (to_read > data_len) {
+                status = (char *)&pkt_buf->status[pkt_buf->pos + data_len - pkt_len];
+            }
+            cc110x_read_rxfifo(dev, data_len ? &pkt[pkt_buf->pos] : NULL,
+                    data_len, status, to_read - data_len);
+            pkt_buf->pos += to_read;
+        }
     }
 
-    if (to_read == left) {
-        uint8_t status[2];
+    if (pkt_buf->pos == pkt_len + (int)sizeof(pkt_buf->status)) {
         /* full packet received. */
-        /* Read the 2 appended status bytes (status[0] = RSSI, status[1] = LQI) */
-        cc110x_readburst_reg(dev, CC110X_RXFIFO, (char *)status, 2);
-
         /* Store RSSI value of packet */
-        pkt_buf->rssi = status[I_RSSI];
+        pkt_buf->rssi = pkt_buf->status[I_RSSI];
 
         /* Bit 0-6 of LQI indicates the link quality (LQI) */
-        pkt_buf->lqi = status[I_LQI] & LQI_EST;
+        pkt_buf->lqi = pkt_buf->status[I_LQI] & LQI_EST;
 
         /* MSB of LQI is the CRC_OK bit */
-        int crc_ok = (status[I_LQI] & CRC_OK) >> 7;
+        int crc_ok = (pkt_buf->status[I_LQI] & CRC_OK) >> 7;
 
         if (crc_ok) {
                     LOG_DEBUG("cc110x: received packet from=%u to=%u payload "
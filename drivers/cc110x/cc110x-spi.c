@@ -86,15 +86,29 @@ void cc110x_writeburst_reg(cc110x_t *dev, uint8_t addr, const char *src, uint8_t
 
 void cc110x_readburst_reg(cc110x_t *dev, uint8_t addr, char *buffer, uint8_t count)
 {
-    int i = 0;
     unsigned int cpsr;
     spi_acquire(dev->params.spi);
     cpsr = irq_disable();
     cc110x_cs(dev);
-    spi_transfer_byte(dev->params.spi, addr | CC110X_READ_BURST, 0);
-    while (i < count) {
-        spi_transfer_byte(dev->params.spi, CC110X_NOBYTE, &buffer[i]);
-        i++;
+    spi_transfer_regs(dev->params.spi, addr | CC110X_READ_BURST, NULL, buffer, count);
+    gpio_set(dev->params.cs);
+    irq_restore(cpsr);
+    spi_release(dev->params.spi);
+}
+
+void cc110x_read_rxfifo(cc110x_t *dev, char *data, uint8_t data_count,
+                        char *status, uint8_t status_count)
+{
+    unsigned int cpsr;
+    spi_acquire(dev->params.spi);
+    cpsr = irq_disable();
+    cc110x_cs(dev);
+    spi_transfer_byte(dev->params.spi, CC110X_RXFIFO | CC110X_READ_BURST, 0);
+    if (data_count) {
+        spi_transfer_bytes(dev->params.spi, NULL, data, data_count);
+    }
+    if (status_count) {
+        spi_transfer_bytes(dev->params.spi, NULL, status, status_count);
     }
     gpio_set(dev->params.cs);
     irq_restore(cpsr);
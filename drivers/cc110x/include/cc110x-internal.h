@@ -119,8 +119,11 @@ typedef struct __attribute__((packed))
 typedef struct {
     uint8_t rssi;                           /**< RSSI value */
     uint8_t lqi;                            /**< link quality indicator */
-    uint8_t pos;                            /**< I have no clue. */
+    uint8_t pos;                            /**< bytes of the frame read or
+                                                 written so far */
     cc110x_pkt_t packet;                    /**< whole packet */
+    uint8_t status[2];                      /**< status bytes appended to a
+                                                 received packet */
 } cc110x_pkt_buf_t;
 
 /**
@@ -49,6 +49,20 @@ void cc110x_writeburst_reg(cc110x_t *dev, uint8_t addr, const char *buffer, uint
  */
 void cc110x_readburst_reg(cc110x_t *dev, uint8_t addr, char *buffer, uint8_t count);
 
+/**
+ * @brief Read the RX FIFO in one burst, split into two buffers
+ *
+ * Used to read the end of a packet and the appended status bytes at once.
+ *
+ * @param dev       Device to work on
+ * @param data      Buffer for the first @p data_count bytes
+ * @param data_count Number of bytes to read into @p data
+ * @param status    Buffer for the following @p status_count bytes
+ * @param status_count Number of bytes to read into @p status
+ */
+void cc110x_read_rxfifo(cc110x_t *dev, char *data, uint8_t data_count,
+                        char *status, uint8_t status_count);
+
 /**
  * @brief Write one byte to a register
  *
@@ -220,6 +220,22 @@ static int _get(netdev2_t *netdev, netopt_t opt, void *val, size_t max_len)
         case NETOPT_PROMISCUOUSMODE:
             return opt_state(val, (dev->options & CC2420_OPT_PROMISCUOUS));
 
+        case NETOPT_OFFLOADS: {
+            uint16_t offloads = 0;
+
+            assert(max_len >= sizeof(uint16_t));
+            if (!(dev->options & CC2420_OPT_PROMISCUOUS)) {
+                offloads |= NETOPT_OFFLOAD_ADDR_FILTER;
+                if (dev->options & CC2420_OPT_AUTOACK) {
+                    offloads |= NETOPT_OFFLOAD_AUTOACK;
+                }
+            }
+            if (dev->options & CC2420_OPT_CSMA) {
+                offloads |= NETOPT_OFFLOAD_CSMA;
+            }
+            return w_u16(val, offloads);
+        }
+
         case NETOPT_RX_START_IRQ:
             return opt_state(val, (dev->options & CC2420_OPT_TELL_RX_START));
 
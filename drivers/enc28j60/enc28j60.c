@@ -213,6 +213,44 @@ static void mac_set(enc28j60_t *dev, uint8_t *mac)
     cmd_wcr(dev, REG_B3_MAADR1, 3, mac[5]);
 }
 
+/* bit of the hash filter an address maps to: bits 28:23 of the Ethernet CRC
+ * over the address, see data sheet section 8.2.2 */
+static unsigned hash_bit(const uint8_t *addr)
+{
+    uint32_t crc = 0xffffffff;
+
+    for (unsigned i = 0; i < ETHERNET_ADDR_LEN; i++) {
+        uint8_t byte = addr[i];
+        for (unsigned j = 0; j < 8; j++) {
+            crc = (crc >> 1) ^ (((crc ^ byte) & 1) ? 0xedb88320 : 0);
+            byte >>= 1;
+        }
+    }
+    return (crc >> 23) & (ENC28J60_HASH_BITS - 1);
+}
+
+static int group_set(enc28j60_t *dev, const uint8_t *addr, bool join)
+{
+    unsigned bit = hash_bit(addr);
+    uint8_t reg = REG_B1_EHT0 + (bit >> 3);
+
+    mutex_lock(&dev->devlock);
+    if (join) {
+        if (dev->hash_refs[bit]++ == 0) {
+            cmd_bfs(dev, reg, 1, (1 << (bit & 0x7)));
+        }
+        /* from the first join on, only pass multicast frames that hit the
+         * hash filter instead of all frames */
+        cmd_wcr(dev, REG_B1_ERXFCON, 1, (ERXFCON_UCEN | ERXFCON_CRCEN |
+                                         ERXFCON_HTEN | ERXFCON_BCEN));
+    }
+    else if ((dev->hash_refs[bit] > 0) && (--dev->hash_refs[bit] == 0)) {
+        cmd_bfc(dev, reg, 1, (1 << (bit & 0x7)));
+    }
+    mutex_unlock(&dev->devlock);
+    return ETHERNET_ADDR_LEN;
+}
+
 static void on_int(void *arg)
 {
     netdev2_t *netdev = (netdev2_t *)arg;
@@ -227,10 +265,6 @@ static int nd_send(netdev2_t *netdev, const struct iovec *data, unsigned count)
 
     mutex_lock(&dev->devlock);
 
-#ifdef MODULE_NETSTATS_L2
-    netdev->stats.tx_bytes += count;
-#endif
-
     /* set write pointer */
     cmd_w_addr(dev, ADDR_WRITE_PTR, BUF_TX_START);
     /* write control byte and the actual data into the buffer */
@@ -239,6 +273,9 @@ static int nd_send(netdev2_t *netdev, const struct iovec *data, unsigned count)
         c += data[i].iov_len;
         cmd_wbm(dev, (uint8_t *)data[i].iov_base, data[i].iov_len);
     }
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.tx_bytes += c;
+#endif
     /* set TX end pointer */
     cmd_w_addr(dev, ADDR_TX_END, cmd_r_addr(dev, ADDR_WRITE_PTR) - 1);
     /* trigger the send process */
@@ -269,7 +306,7 @@ static int nd_recv(netdev2_t *netdev, void *buf, size_t max_len, void *info)
     if (buf != NULL) {
 #ifdef MODULE_NETSTATS_L2
         netdev->stats.rx_count++;
-        netdev2->stats.rx_bytes += size;
+        netdev->stats.rx_bytes += size;
 #endif
         /* read packet content into the supplied buffer */
         if (size <= max_len) {
@@ -335,8 +372,13 @@ static int nd_init(netdev2_t *netdev)
     cmd_w_addr(dev, ADDR_TX_END, BUF_TX_END);
 
     /* FILTER configuration */
-    /* setup receive filters - we accept everything per default */
+    /* setup receive filters - we accept everything per default, until a
+     * multicast group is joined */
     cmd_wcr(dev, REG_B1_ERXFCON, 1, 0);
+    for (unsigned i = 0; i < (ENC28J60_HASH_BITS / 8); i++) {
+        cmd_wcr(dev, REG_B1_EHT0 + i, 1, 0);
+    }
+    memset(dev->hash_refs, 0, sizeof(dev->hash_refs));
 
     /* MAC configuration */
     /* enable RX through filter and enable sending of RX and TX pause frames */
@@ -392,6 +434,7 @@ static void nd_isr(netdev2_t *netdev)
 {
     enc28j60_t *dev = (enc28j60_t *)netdev;
     uint8_t eir = cmd_rcr(dev, REG_EIR, -1);
+    unsigned budget = NETDEV2_RX_BUDGET;
 
     while (eir != 0) {
         if (eir & EIR_LINKIF) {
@@ -409,6 +452,13 @@ static void nd_isr(netdev2_t *netdev)
         }
         if (eir & EIR_PKTIF) {
             do {
+                if (budget == 0) {
+                    /* leave the rest for the next round. The interrupt line
+                     * stays asserted, so there is no new edge to wait for */
+                    netdev->event_callback(netdev, NETDEV2_EVENT_ISR);
+                    return;
+                }
+                budget--;
                 DEBUG("[enc28j60] isr: packet received\n");
                 netdev->event_callback(netdev, NETDEV2_EVENT_RX_COMPLETE);
             } while (cmd_rcr(dev, REG_B1_EPKTCNT, 1) > 0);
@@ -439,6 +489,10 @@ static int nd_get(netdev2_t *netdev, netopt_t opt, void *value, size_t max_len)
             assert(max_len >= ETHERNET_ADDR_LEN);
             mac_get(dev, (uint8_t *)value);
             return ETHERNET_ADDR_LEN;
+        case NETOPT_OFFLOADS:
+            assert(max_len >= sizeof(uint16_t));
+            *((uint16_t *)value) = NETOPT_OFFLOAD_MCAST_FILTER;
+            return sizeof(uint16_t);
         default:
             return netdev2_eth_get(netdev, opt, value, max_len);
     }
@@ -453,6 +507,12 @@ static int nd_set(netdev2_t *netdev, netopt_t opt, void *value, size_t value_len
             assert(value_len == ETHERNET_ADDR_LEN);
             mac_set(dev, (uint8_t *)value);
             return ETHERNET_ADDR_LEN;
+        case NETOPT_L2_GROUP:
+        case NETOPT_L2_GROUP_LEAVE:
+            if (value_len != ETHERNET_ADDR_LEN) {
+                return -EINVAL;
+            }
+            return group_set(dev, (uint8_t *)value, (opt == NETOPT_L2_GROUP));
         default:
             return netdev2_eth_set(netdev, opt, value, value_len);
     }
@@ -21,6 +21,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <string.h>
 
 #include "mutex.h"
 #include "encx24j600.h"
@@ -32,7 +33,10 @@
 #include "net/netdev2/eth.h"
 #include "net/eui64.h"
 #include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/ipv6/hdr.h"
 #include "net/netstats.h"
+#include "net/protnum.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -50,6 +54,9 @@
 #define TX_BUFFER_END   (RX_BUFFER_START)
 #define TX_BUFFER_START (TX_BUFFER_END - TX_BUFFER_LEN)
 
+/* CRC and padding to the next even address between two received frames */
+#define RX_FRAME_GAP_MAX (5U)
+
 static void cmd(encx24j600_t *dev, char cmd);
 static void reg_set(encx24j600_t *dev, uint8_t reg, uint16_t value);
 static uint16_t reg_get(encx24j600_t *dev, uint8_t reg);
@@ -89,6 +96,8 @@ void encx24j600_setup(encx24j600_t *dev, const encx24j600_params_t *params)
     dev->cs = params->cs_pin;
     dev->int_pin = params->int_pin;
     dev->rx_next_ptr = RX_BUFFER_START;
+    dev->rx_pending = 0;
+    dev->rx_hdr_len = 0;
 
     mutex_init(&dev->mutex);
 }
@@ -109,6 +118,7 @@ static void _isr(netdev2_t *netdev)
     encx24j600_t *dev = (encx24j600_t *) netdev;
 
     uint16_t eir;
+    unsigned budget = NETDEV2_RX_BUDGET;
 
     lock(dev);
     cmd(dev, ENC_CLREIE);
@@ -129,6 +139,11 @@ static void _isr(netdev2_t *netdev)
     /* check & handle available packets */
     if (eir & ENC_PKTIF) {
         while (_packets_available(dev)) {
+            if (budget-- == 0) {
+                /* leave the rest for the next round */
+                netdev->event_callback(netdev, NETDEV2_EVENT_ISR);
+                break;
+            }
             unlock(dev);
             netdev->event_callback(netdev, NETDEV2_EVENT_RX_COMPLETE);
             lock(dev);
@@ -284,6 +299,8 @@ static int _init(netdev2_t *encdev)
     reg_set(dev, ENC_ERXST, RX_BUFFER_START);
     reg_set(dev, ENC_ERXTAIL, RX_BUFFER_END);
     dev->rx_next_ptr = RX_BUFFER_START;
+    dev->rx_pending = 0;
+    dev->rx_hdr_len = 0;
 
     /* configure receive filter to receive multicast frames */
     reg_set_bits(dev, ENC_ERXFCON, ENC_MCEN);
@@ -303,6 +320,121 @@ static int _init(netdev2_t *encdev)
     return 0;
 }
 
+/* copy len bytes at offset of the frame given by vector to dst */
+static size_t _iov_read(const struct iovec *vector, unsigned count,
+                        size_t offset, void *dst, size_t len)
+{
+    uint8_t *out = dst;
+    size_t done = 0;
+
+    for (unsigned i = 0; (i < count) && (done < len); i++) {
+        size_t n = vector[i].iov_len;
+
+        if (offset >= n) {
+            offset -= n;
+            continue;
+        }
+        n -= offset;
+        if (n > (len - done)) {
+            n = len - done;
+        }
+        memcpy(&out[done], (uint8_t *)vector[i].iov_base + offset, n);
+        done += n;
+        offset = 0;
+    }
+
+    return done;
+}
+
+/* offset of the checksum field within the header of upper layer protocol nh */
+static int _csum_field(uint8_t nh)
+{
+    switch (nh) {
+        case PROTNUM_ICMPV6:
+            return 2;
+        case PROTNUM_UDP:
+            return 6;
+        case PROTNUM_TCP:
+            return 16;
+        default:
+            return -1;
+    }
+}
+
+/*
+ * @brief Fill in the upper layer checksum of an IPv6 frame in the TX buffer
+ *
+ * The pseudo header sum is written to the checksum field, then the DMA engine
+ * sums up the upper layer segment in SRAM. Only empty checksum fields are
+ * filled in, so forwarded packets are left alone.
+ */
+static void _tx_csum(encx24j600_t *dev, const struct iovec *vector,
+                     unsigned count, size_t len)
+{
+    ethernet_hdr_t eth;
+    ipv6_hdr_t ipv6;
+    size_t offset = sizeof(eth) + sizeof(ipv6);
+    size_t ul_len;
+    uint8_t field[2];
+    uint16_t csum;
+    int csum_field;
+    uint8_t nh;
+
+    if ((_iov_read(vector, count, 0, &eth, sizeof(eth)) < sizeof(eth)) ||
+        (byteorder_ntohs(eth.type) != ETHERTYPE_IPV6) ||
+        (_iov_read(vector, count, sizeof(eth), &ipv6,
+                   sizeof(ipv6)) < sizeof(ipv6))) {
+        return;
+    }
+
+    /* skip extension headers up to the upper layer header */
+    nh = ipv6.nh;
+    while ((nh == PROTNUM_IPV6_EXT_HOPOPT) || (nh == PROTNUM_IPV6_EXT_RH) ||
+           (nh == PROTNUM_IPV6_EXT_DST)) {
+        uint8_t ext[2];
+
+        if (_iov_read(vector, count, offset, ext, sizeof(ext)) < sizeof(ext)) {
+            return;
+        }
+        nh = ext[0];
+        offset += (ext[1] + 1) * 8;
+    }
+
+    ul_len = sizeof(eth) + sizeof(ipv6) + byteorder_ntohs(ipv6.len);
+    csum_field = _csum_field(nh);
+    if ((csum_field < 0) || (ul_len > len) ||
+        ((offset + csum_field + sizeof(field)) > ul_len) ||
+        (_iov_read(vector, count, offset + csum_field, field,
+                   sizeof(field)) < sizeof(field)) ||
+        (field[0] != 0) || (field[1] != 0)) {
+        return;
+    }
+    ul_len -= offset;
+
+    csum = ipv6_hdr_inet_csum(0, &ipv6, nh, ul_len);
+    field[0] = csum >> 8;
+    field[1] = csum & 0xff;
+    sram_op(dev, ENC_WGPDATA, TX_BUFFER_START + offset + csum_field,
+            (char *)field, sizeof(field));
+
+    reg_set(dev, ENC_EDMAST, TX_BUFFER_START + offset);
+    reg_set(dev, ENC_EDMALEN, ul_len);
+    reg_clear_bits(dev, ENC_ECON1, ENC_DMACPY | ENC_DMANOCS | ENC_DMACSSD);
+    reg_set_bits(dev, ENC_ECON1, ENC_DMAST);
+    while (reg_get(dev, ENC_ECON1) & ENC_DMAST);
+
+    /* EDMACS holds the checksum in SRAM byte order */
+    csum = reg_get(dev, ENC_EDMACS);
+    if ((csum == 0) && (nh == PROTNUM_UDP)) {
+        /* 0 means no checksum for UDP */
+        csum = 0xffff;
+    }
+    field[0] = csum & 0xff;
+    field[1] = csum >> 8;
+    sram_op(dev, ENC_WGPDATA, TX_BUFFER_START + offset + csum_field,
+            (char *)field, sizeof(field));
+}
+
 static int _send(netdev2_t *netdev, const struct iovec *vector, unsigned count) {
     encx24j600_t * dev = (encx24j600_t *) netdev;
     lock(dev);
@@ -318,6 +450,9 @@ static int _send(netdev2_t *netdev, const struct iovec *vector, unsigned count)
         len += vector[i].iov_len;
     }
 
+    /* let the DMA engine calculate the checksum GNRC left out */
+    _tx_csum(dev, vector, count, len);
+
     /* set start of TX packet and length */
     reg_set(dev, ENC_ETXST, TX_BUFFER_START);
     reg_set(dev, ENC_ETXLEN, len);
@@ -340,8 +475,12 @@ static int _send(netdev2_t *netdev, const struct iovec *vector, unsigned count)
 
 static inline int _packets_available(encx24j600_t *dev)
 {
-    /* return ENC_PKTCNT (low byte of ENC_ESTAT) */
-    return reg_get(dev, ENC_ESTAT) & ~0xFF00;
+    /* only ask the device again when all packets counted before were read */
+    if (dev->rx_pending == 0) {
+        /* ENC_PKTCNT is the low byte of ENC_ESTAT */
+        dev->rx_pending = reg_get(dev, ENC_ESTAT) & ~0xFF00;
+    }
+    return dev->rx_pending;
 }
 
 static void _get_mac_addr(netdev2_t *encdev, uint8_t* buf)
@@ -358,34 +497,94 @@ static void _get_mac_addr(netdev2_t *encdev, uint8_t* buf)
     unlock(dev);
 }
 
+/* distance from SRAM address from to to within the RX buffer */
+static uint16_t _rx_dist(uint16_t from, uint16_t to)
+{
+    if (to < from) {
+        to += (RX_BUFFER_END + 1) - RX_BUFFER_START;
+    }
+    return to - from;
+}
+
+/*
+ * @brief Read the payload of the current frame and the header of the next one
+ *
+ * Frames lie back to back in the RX buffer, so the header of the next frame
+ * is read in the same SPI transaction, skipping the CRC and padding.
+ */
+static void _read_prefetch(encx24j600_t *dev, char *buf, size_t len,
+                           unsigned gap)
+{
+    char tmp[RX_FRAME_GAP_MAX + sizeof(encx24j600_frame_hdr_t)];
+    encx24j600_frame_hdr_t hdr;
+
+    spi_acquire(dev->spi);
+    gpio_clear(dev->cs);
+    spi_transfer_byte(dev->spi, ENC_RRXDATA, NULL);
+    spi_transfer_bytes(dev->spi, NULL, buf, len);
+    spi_transfer_bytes(dev->spi, NULL, tmp, gap + sizeof(hdr));
+    gpio_set(dev->cs);
+    spi_release(dev->spi);
+
+    memcpy(&hdr, &tmp[gap], sizeof(hdr));
+    dev->rx_hdr_next = hdr.rx_next_ptr;
+    dev->rx_hdr_len = hdr.frame_len;
+}
+
 static int _recv(netdev2_t *netdev, void *buf, size_t len, void *info)
 {
     encx24j600_t * dev = (encx24j600_t *) netdev;
-    encx24j600_frame_hdr_t hdr;
 
     (void)info;
     lock(dev);
 
-    /* read frame header */
-    sram_op(dev, ENC_RRXDATA, dev->rx_next_ptr, (char*)&hdr, sizeof(hdr));
+    /* read frame header, unless it came along with the previous frame */
+    if (dev->rx_hdr_len == 0) {
+        encx24j600_frame_hdr_t hdr;
+
+        sram_op(dev, ENC_RRXDATA, dev->rx_next_ptr, (char*)&hdr, sizeof(hdr));
+        dev->rx_hdr_next = hdr.rx_next_ptr;
+        dev->rx_hdr_len = hdr.frame_len;
+    }
+
+    /* frame length given by device contains 4 bytes checksum */
+    size_t payload_len = dev->rx_hdr_len - 4;
 
-    /* hdr.frame_len given by device contains 4 bytes checksum */
-    size_t payload_len = hdr.frame_len - 4;
+    if (buf || len) {
+        uint16_t next_ptr = dev->rx_hdr_next;
 
-    if (buf) {
+        dev->rx_hdr_len = 0;
+        if (buf) {
+            uint16_t end = dev->rx_next_ptr + sizeof(encx24j600_frame_hdr_t) +
+                           payload_len;
+            unsigned gap = _rx_dist(end > RX_BUFFER_END ?
+                                    end - ((RX_BUFFER_END + 1) - RX_BUFFER_START) :
+                                    end, next_ptr);
 #ifdef MODULE_NETSTATS_L2
-        netdev->stats.rx_count++;
-        netdev2->stats.rx_bytes += len;
+            netdev->stats.rx_count++;
+            netdev->stats.rx_bytes += payload_len;
 #endif
-        /* read packet (without 4 bytes checksum) */
-        sram_op(dev, ENC_RRXDATA, 0xFFFF, buf, payload_len);
+            /* read packet (without 4 bytes checksum), together with the
+             * header of the next one if that is complete already */
+            if ((dev->rx_pending > 1) && (gap <= RX_FRAME_GAP_MAX)) {
+                _read_prefetch(dev, buf, payload_len, gap);
+            }
+            else {
+                sram_op(dev, ENC_RRXDATA, 0xFFFF, buf, payload_len);
+            }
+        }
 
         /* decrement available packet count */
         cmd(dev, ENC_SETPKTDEC);
+        if (dev->rx_pending) {
+            dev->rx_pending--;
+        }
 
-        dev->rx_next_ptr = hdr.rx_next_ptr;
+        dev->rx_next_ptr = next_ptr;
 
-        reg_set(dev, ENC_ERXTAIL, dev->rx_next_ptr - 2);
+        /* free the buffer up to two bytes before the next packet */
+        reg_set(dev, ENC_ERXTAIL, (next_ptr == RX_BUFFER_START) ?
+                RX_BUFFER_END - 1 : next_ptr - 2);
     }
 
     unlock(dev);
@@ -407,6 +606,12 @@ static int _get(netdev2_t *dev, netopt_t opt, void *value, size_t max_len)
                 res = ETHERNET_ADDR_LEN;
             }
             break;
+        case NETOPT_OFFLOADS:
+            assert(max_len >= sizeof(uint16_t));
+            /* upper layer checksums are calculated by the DMA engine */
+            *((uint16_t *)value) = NETOPT_OFFLOAD_CSUM_TX;
+            res = sizeof(uint16_t);
+            break;
         default:
             res = netdev2_eth_get(dev, opt, value, max_len);
             break;
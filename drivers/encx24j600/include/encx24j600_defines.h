@@ -74,6 +74,10 @@ extern "C" {
 #define ENC_ERXST       0x04
 #define ENC_ERXTAIL     0x06
 #define ENC_ERXHEAD     0x08
+#define ENC_EDMAST      0x0a    /* DMA start address */
+#define ENC_EDMALEN     0x0c    /* DMA length */
+#define ENC_EDMADST     0x0e    /* DMA destination address */
+#define ENC_EDMACS      0x10    /* DMA checksum */
 #define ENC_ETXSTAT     0x12
 #define ENC_ETXWIRE     0x14
 #define ENC_EUDAST      0x16
@@ -43,7 +43,7 @@ extern isrpipe_t uart_stdio_isrpipe;
 #include "debug.h"
 
 static void _get_mac_addr(netdev2_t *dev, uint8_t* buf);
-static void ethos_isr(void *arg, uint8_t c);
+static void ethos_isr(void *arg, const uint8_t *data, size_t len);
 static const netdev2_driver_t netdev2_driver_ethos;
 
 static const uint8_t _esc_esc[] = {ETHOS_ESC_CHAR, (ETHOS_ESC_CHAR ^ 0x20)};
@@ -60,6 +60,7 @@ void ethos_setup(ethos_t *dev, const ethos_params_t *params)
     dev->last_framesize = 0;
 
     tsrb_init(&dev->inbuf, (char*)params->buf, params->bufsize);
+    tsrb_init(&dev->rawbuf, dev->rawmem, sizeof(dev->rawmem));
     mutex_init(&dev->out_mutex);
 
     uint32_t a = random_uint32();
@@ -70,7 +71,7 @@ void ethos_setup(ethos_t *dev, const ethos_params_t *params)
     dev->mac_addr[0] &= (0x2);      /* unset globally unique bit */
     dev->mac_addr[0] &= ~(0x1);     /* set unicast bit*/
 
-    uart_init(params->uart, params->baudrate, ethos_isr, (void*)dev);
+    uart_init_block(params->uart, params->baudrate, ethos_isr, (void*)dev);
 
     uint8_t frame_delim = ETHOS_FRAME_DELIMITER;
     uart_write(dev->uart, &frame_delim, 1);
@@ -84,14 +85,14 @@ static void _reset_state(ethos_t *dev)
     dev->framesize = 0;
 }
 
-static void _handle_char(ethos_t *dev, char c)
+static void _handle_data(ethos_t *dev, const char *data, size_t len)
 {
     switch (dev->frametype) {
         case ETHOS_FRAME_TYPE_DATA:
         case ETHOS_FRAME_TYPE_HELLO:
         case ETHOS_FRAME_TYPE_HELLO_REPLY:
-             if (tsrb_add_one(&dev->inbuf, c) == 0) {
-                dev->framesize++;
+            if (tsrb_add(&dev->inbuf, data, len) == (int)len) {
+                dev->framesize += len;
             } else {
                 //puts("lost frame");
                 dev->inbuf.reads = 0;
@@ -101,8 +102,8 @@ static void _handle_char(ethos_t *dev, char c)
             break;
 #ifdef USE_ETHOS_FOR_STDIO
         case ETHOS_FRAME_TYPE_TEXT:
-            dev->framesize++;
-            isrpipe_write_one(&uart_stdio_isrpipe, c);
+            dev->framesize += len;
+            isrpipe_write(&uart_stdio_isrpipe, data, len);
 #endif
     }
 }
@@ -113,7 +114,7 @@ static void _end_of_frame(ethos_t *dev)
         case ETHOS_FRAME_TYPE_DATA:
             if (dev->framesize) {
                 dev->last_framesize = dev->framesize;
-                dev->netdev.event_callback((netdev2_t*) dev, NETDEV2_EVENT_ISR);
+                dev->netdev.event_callback((netdev2_t*) dev, NETDEV2_EVENT_RX_COMPLETE);
             }
             break;
         case ETHOS_FRAME_TYPE_HELLO:
@@ -129,57 +130,90 @@ static void _end_of_frame(ethos_t *dev)
     _reset_state(dev);
 }
 
-static void ethos_isr(void *arg, uint8_t c)
+/* UART callback, only queues the data for the thread of the device */
+static void ethos_isr(void *arg, const uint8_t *data, size_t len)
 {
     ethos_t *dev = (ethos_t *) arg;
 
-    switch (dev->state) {
-        case WAIT_FRAMESTART:
-            if (c == ETHOS_FRAME_DELIMITER) {
-                _reset_state(dev);
-                dev->state = IN_FRAME;
-            }
-            break;
-        case IN_FRAME:
-            if (c == ETHOS_ESC_CHAR) {
-                dev->state = IN_ESCAPE;
-            }
-            else if (c == ETHOS_FRAME_DELIMITER) {
-                if (dev->framesize) {
-                    _end_of_frame(dev);
-                }
-            }
-            else {
-                _handle_char(dev, c);
-            }
-            break;
-        case IN_ESCAPE:
-            switch (c) {
-                case (ETHOS_FRAME_DELIMITER ^ 0x20):
-                    _handle_char(dev, ETHOS_FRAME_DELIMITER);
-                    break;
-                case (ETHOS_ESC_CHAR ^ 0x20):
-                    _handle_char(dev, ETHOS_ESC_CHAR);
-                    break;
-                case (ETHOS_FRAME_TYPE_TEXT ^ 0x20):
-                    dev->frametype = ETHOS_FRAME_TYPE_TEXT;
-                    break;
-                case (ETHOS_FRAME_TYPE_HELLO ^ 0x20):
-                    dev->frametype = ETHOS_FRAME_TYPE_HELLO;
-                    break;
-                case (ETHOS_FRAME_TYPE_HELLO_REPLY ^ 0x20):
-                    dev->frametype = ETHOS_FRAME_TYPE_HELLO_REPLY;
-                    break;
-            }
-            dev->state = IN_FRAME;
-            break;
+    if (tsrb_add(&dev->rawbuf, (const char *)data, len) != (int)len) {
+        DEBUG("ethos: raw buffer full, dropping data\n");
+    }
+    if ((memchr(data, ETHOS_FRAME_DELIMITER, len) != NULL) &&
+        (dev->netdev.event_callback != NULL)) {
+        dev->netdev.event_callback((netdev2_t*) dev, NETDEV2_EVENT_ISR);
     }
 }
 
+/* Decode the received data in thread context. Runs of bytes needing no
+ * unescaping are handled in one go. */
 static void _isr(netdev2_t *netdev)
 {
     ethos_t *dev = (ethos_t *) netdev;
-    dev->netdev.event_callback((netdev2_t*) dev, NETDEV2_EVENT_RX_COMPLETE);
+    char chunk[32];
+    int n;
+
+    while ((n = tsrb_get(&dev->rawbuf, chunk, sizeof(chunk))) > 0) {
+        int i = 0;
+
+        while (i < n) {
+            char c = chunk[i];
+
+            switch (dev->state) {
+                case WAIT_FRAMESTART:
+                    if (c == ETHOS_FRAME_DELIMITER) {
+                        _reset_state(dev);
+                        dev->state = IN_FRAME;
+                    }
+                    i++;
+                    break;
+                case IN_FRAME:
+                    if (c == ETHOS_ESC_CHAR) {
+                        dev->state = IN_ESCAPE;
+                        i++;
+                    }
+                    else if (c == ETHOS_FRAME_DELIMITER) {
+                        if (dev->framesize) {
+                            _end_of_frame(dev);
+                        }
+                        i++;
+                    }
+                    else {
+                        int run = i;
+
+                        while ((run < n) && (chunk[run] != ETHOS_ESC_CHAR) &&
+                               (chunk[run] != ETHOS_FRAME_DELIMITER)) {
+                            run++;
+                        }
+                        _handle_data(dev, &chunk[i], run - i);
+                        i = run;
+                    }
+                    break;
+                case IN_ESCAPE:
+                    switch ((uint8_t)c) {
+                        case (ETHOS_FRAME_DELIMITER ^ 0x20):
+                            c = ETHOS_FRAME_DELIMITER;
+                            _handle_data(dev, &c, 1);
+                            break;
+                        case (ETHOS_ESC_CHAR ^ 0x20):
+                            c = ETHOS_ESC_CHAR;
+                            _handle_data(dev, &c, 1);
+                            break;
+                        case (ETHOS_FRAME_TYPE_TEXT ^ 0x20):
+                            dev->frametype = ETHOS_FRAME_TYPE_TEXT;
+                            break;
+                        case (ETHOS_FRAME_TYPE_HELLO ^ 0x20):
+                            dev->frametype = ETHOS_FRAME_TYPE_HELLO;
+                            break;
+                        case (ETHOS_FRAME_TYPE_HELLO_REPLY ^ 0x20):
+                            dev->frametype = ETHOS_FRAME_TYPE_HELLO_REPLY;
+                            break;
+                    }
+                    dev->state = IN_FRAME;
+                    i++;
+                    break;
+            }
+        }
+    }
 }
 
 static int _init(netdev2_t *encdev)
@@ -178,6 +178,37 @@ int hdc1000_read(hdc1000_t *dev, uint16_t *rawtemp, uint16_t *rawhum)
     return 0;
 }
 
+#ifdef MODULE_I2C_ASYNC
+int hdc1000_read_async(hdc1000_t *dev, i2c_async_cb_t cb)
+{
+    if (dev->initialized == false) {
+        return -1;
+    }
+
+    dev->req.dev = dev->i2c;
+    dev->req.addr = dev->addr;
+    dev->req.flags = I2C_ASYNC_READ;
+    dev->req.data = dev->buf;
+    dev->req.len = sizeof(dev->buf);
+    dev->req.cb = cb;
+    dev->req.arg = dev;
+    i2c_async_submit(&dev->req);
+    return 0;
+}
+
+int hdc1000_read_async_result(hdc1000_t *dev, uint16_t *rawtemp,
+                              uint16_t *rawhum)
+{
+    if (dev->req.res != sizeof(dev->buf)) {
+        return -1;
+    }
+    /* Register bytes are sent MSB first. */
+    *rawtemp = ((uint16_t)dev->buf[0] << 8) | dev->buf[1];
+    *rawhum = ((uint16_t)dev->buf[2] << 8) | dev->buf[3];
+    return 0;
+}
+#endif
+
 void hdc1000_convert(uint16_t rawtemp, uint16_t rawhum,  int *temp, int *hum)
 {
     /* calculate temperature*100 [°C] */
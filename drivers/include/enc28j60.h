@@ -41,6 +41,11 @@ extern "C" {
  */
 #define ENC28J60_FALLBACK_MAC       {0x02, 0x22, 0x33, 0x44, 0x55, 0x66}
 
+/**
+ * @brief   Number of bits in the multicast hash filter of the device
+ */
+#define ENC28J60_HASH_BITS          (64U)
+
 /**
  * @brief   Struct containing the needed peripheral configuration
  */
@@ -62,6 +67,11 @@ typedef struct {
     gpio_t reset_pin;       /**< pin connected to the RESET line */
     mutex_t devlock;        /**< lock the device on access */
     int8_t bank;            /**< remember the active register bank */
+    /**
+     * @brief   Number of joined multicast addresses per bit of the hash
+     *          filter, a bit is cleared once no address maps to it anymore
+     */
+    uint8_t hash_refs[ENC28J60_HASH_BITS];
 } enc28j60_t;
 
 /**
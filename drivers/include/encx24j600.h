@@ -41,6 +41,10 @@ typedef struct {
     gpio_t cs;              /**< SPI chip select pin */
     gpio_t int_pin;         /**< SPI interrupt pin */
     uint16_t rx_next_ptr;   /**< ptr to next packet whithin devices memory */
+    uint16_t rx_pending;    /**< packets in the RX buffer not read yet */
+    uint16_t rx_hdr_next;   /**< next packet ptr of the prefetched header */
+    uint16_t rx_hdr_len;    /**< frame length of the prefetched header,
+                                 0 if none was prefetched */
     mutex_t mutex;          /**< mutex used to lock device access */
 } encx24j600_t;
 
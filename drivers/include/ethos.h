@@ -54,6 +54,16 @@ extern "C" {
 #define ETHOS_FRAME_TYPE_HELLO_REPLY    (0x3)
 /** @} */
 
+/**
+ * @brief   Size of the buffer for undecoded data from the UART
+ *
+ * The UART interrupt only copies received data into this buffer, it is
+ * decoded in the thread of the device. Must be a power of two.
+ */
+#ifndef ETHOS_RAW_BUFSIZE
+#define ETHOS_RAW_BUFSIZE               (256U)
+#endif
+
 /**
  * @brief   enum describing line state
  */
@@ -73,6 +83,8 @@ typedef struct {
     uint8_t mac_addr[6];    /**< this device's MAC address */
     uint8_t remote_mac_addr[6]; /**< this device's MAC address */
     tsrb_t inbuf;           /**< ringbuffer for incoming data */
+    tsrb_t rawbuf;          /**< ringbuffer for undecoded incoming data */
+    char rawmem[ETHOS_RAW_BUFSIZE]; /**< memory used by ethos_t::rawbuf */
     line_state_t state;     /**< Line status variable */
     size_t framesize;       /**< size of currently incoming frame */
     unsigned frametype;     /**< type of currently incoming frame */
@@ -37,6 +37,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "periph/i2c.h"
+#ifdef MODULE_I2C_ASYNC
+#include "i2c_async.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
@@ -58,6 +61,10 @@ typedef struct {
     i2c_t i2c;              /**< I2C device the sensor is connected to */
     uint8_t addr;           /**< the sensor's slave address on the I2C bus */
     bool initialized;       /**< sensor status, true if sensor is initialized */
+#if defined(MODULE_I2C_ASYNC) || defined(DOXYGEN)
+    i2c_async_req_t req;    /**< request of hdc1000_read_async() */
+    uint8_t buf[4];         /**< raw data read by hdc1000_read_async() */
+#endif
 } hdc1000_t;
 
 /**
@@ -120,6 +127,36 @@ int hdc1000_startmeasure(hdc1000_t *dev);
  */
 int hdc1000_read(hdc1000_t *dev, uint16_t *rawtemp, uint16_t *rawhum);
 
+#if defined(MODULE_I2C_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief Read sensor's data without blocking
+ *
+ * Queues the read with @ref sys_i2c_async. Once @p cb is called, with
+ * @p dev as the request's i2c_async_req_t::arg, the values can be fetched with
+ * hdc1000_read_async_result().
+ *
+ * @param[in]  dev          device descriptor of sensor
+ * @param[in]  cb           callback executed when the read finished
+ *
+ * @return                  0 on success
+ * @return                  -1 on error
+ */
+int hdc1000_read_async(hdc1000_t *dev, i2c_async_cb_t cb);
+
+/**
+ * @brief Get the sensor's data read by hdc1000_read_async()
+ *
+ * @param[in]  dev          device descriptor of sensor
+ * @param[out] rawtemp      raw temperature value
+ * @param[out] rawhum       raw humidity value
+ *
+ * @return                  0 on success
+ * @return                  -1 if the read failed
+ */
+int hdc1000_read_async_result(hdc1000_t *dev, uint16_t *rawtemp,
+                              uint16_t *rawhum);
+#endif
+
 /**
  * @brief Convert raw sensor values to temperature and humidity.
  *
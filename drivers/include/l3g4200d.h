@@ -75,6 +75,11 @@ typedef enum {
     L3G4200D_MODE_800_110 = 0xf         /**< data rate: 800Hz, cut-off: 110Hz */
 } l3g4200d_mode_t;
 
+/**
+ * @brief Number of samples the FIFO holds
+ */
+#define L3G4200D_FIFO_SIZE      (32U)
+
 /**
  * @brief Device descriptor for L3G4200D sensors
  */
@@ -127,6 +132,36 @@ int l3g4200d_init(l3g4200d_t *dev, i2c_t i2c, uint8_t address,
  */
 int l3g4200d_read(l3g4200d_t *dev, l3g4200d_data_t *acc_data);
 
+/**
+ * @brief Enable or disable the FIFO of the gyro
+ *
+ * With the FIFO enabled, the gyro keeps the last @ref L3G4200D_FIFO_SIZE
+ * samples and raises the INT2 (DRDY) pin when it holds more than
+ * @p watermark samples. Use l3g4200d_read_fifo() to get them.
+ *
+ * @param[in]  dev          device descriptor of gyro
+ * @param[in]  watermark    FIFO level to signal on INT2, 1 to 31, 0 disables
+ *                          the FIFO
+ *
+ * @return                  0 on success
+ * @return                  -1 on error
+ */
+int l3g4200d_set_fifo(l3g4200d_t *dev, uint8_t watermark);
+
+/**
+ * @brief Read up to @p num samples from the FIFO of the gyro
+ *
+ * All samples are read in a single I2C transfer.
+ *
+ * @param[in]  dev          device descriptor of gyro
+ * @param[out] data         buffer for @p num result vectors in dps per axis
+ * @param[in]  num          maximum number of samples to read
+ *
+ * @return                  number of samples read on success
+ * @return                  -1 on error
+ */
+int l3g4200d_read_fifo(l3g4200d_t *dev, l3g4200d_data_t *data, unsigned num);
+
 /**
  * @brief Power-up the given device
  *
@@ -674,6 +674,8 @@ typedef enum {
 #define LIS3DH_FIFO_MODE_STREAM (0x02 << LIS3DH_FIFO_CTRL_REG_FM_SHIFT)
 /** FIFO mode: Stream to FIFO */
 #define LIS3DH_FIFO_MODE_STREAM_TO_FIFO (0x03 << LIS3DH_FIFO_CTRL_REG_FM_SHIFT)
+/** Number of samples the FIFO holds */
+#define LIS3DH_FIFO_SIZE (32U)
 /** @} */
 
 /**
@@ -729,6 +731,23 @@ int lis3dh_init(lis3dh_t *dev, spi_t spi, gpio_t cs_pin, uint8_t scale);
  */
 int lis3dh_read_xyz(const lis3dh_t *dev, lis3dh_data_t *acc_data);
 
+/**
+ * @brief Read up to @p num samples from the FIFO of the accelerometer
+ *
+ * All samples are read in a single burst. The FIFO must have been enabled
+ * with lis3dh_set_fifo(), a watermark interrupt set with lis3dh_set_int1()
+ * tells when there is data to read.
+ *
+ * @param[in]  dev          Device descriptor of sensor
+ * @param[out] acc_data     Buffer for @p num samples
+ * @param[in]  num          Maximum number of samples to read
+ *
+ * @return                  number of samples read on success
+ * @return                  -1 on error
+ */
+int lis3dh_read_fifo(const lis3dh_t *dev, lis3dh_data_t *acc_data,
+                     unsigned num);
+
 /**
  * @brief Read auxiliary ADC channel 1 data from the accelerometer
  *
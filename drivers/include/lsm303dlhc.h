@@ -35,6 +35,11 @@ extern "C" {
 #define LSM303DLHC_ACC_DEFAULT_ADDRESS        (0x19)
 #define LSM303DLHC_MAG_DEFAULT_ADDRESS        (0x1e)
 
+/**
+ * @brief Number of samples the accelerometer FIFO holds
+ */
+#define LSM303DLHC_ACC_FIFO_SIZE              (32U)
+
 /**
  * @brief Possible accelerometer sample rates
  */
@@ -171,6 +176,39 @@ int lsm303dlhc_init(lsm303dlhc_t *dev, i2c_t i2c, gpio_t acc_pin, gpio_t mag_pin
  */
 int lsm303dlhc_read_acc(lsm303dlhc_t *dev, lsm303dlhc_3d_data_t *data);
 
+/**
+ * @brief Enable or disable the FIFO of the accelerometer
+ *
+ * With the FIFO enabled, the accelerometer keeps the last
+ * @ref LSM303DLHC_ACC_FIFO_SIZE samples and raises its INT1 pin (acc_pin)
+ * when it holds more than @p watermark samples, instead of on every new
+ * sample. Use lsm303dlhc_read_acc_fifo() to get them.
+ *
+ * @param[in] dev           device descriptor of an LSM303DLHC device
+ * @param[in] watermark     FIFO level to signal on INT1, 1 to 31, 0 disables
+ *                          the FIFO
+ *
+ * @return              0 on success
+ * @return              -1 on error
+ */
+int lsm303dlhc_set_acc_fifo(lsm303dlhc_t *dev, uint8_t watermark);
+
+/**
+ * @brief Read up to @p num accelerometer values from the FIFO
+ *
+ * All values are read in a single I2C transfer and are scaled like the ones
+ * of lsm303dlhc_read_acc().
+ *
+ * @param[in]  dev      device descriptor of an LSM303DLHC device
+ * @param[out] data     buffer for @p num accelerometer values
+ * @param[in]  num      maximum number of values to read
+ *
+ * @return              number of values read on success
+ * @return              -1 on error
+ */
+int lsm303dlhc_read_acc_fifo(lsm303dlhc_t *dev, lsm303dlhc_3d_data_t *data,
+                             unsigned num);
+
 /**
  * @brief Read a magnetometer value from the sensor.
  *
@@ -143,6 +143,19 @@ typedef struct {
     int16_t z_axis;             /**< Z-Axis measurement result */
 } mpu9150_results_t;
 
+/**
+ * @brief MPU-9150 FIFO sample, as stored by the sensor
+ */
+typedef struct {
+    mpu9150_results_t accel;    /**< Accelerometer values in mG */
+    mpu9150_results_t gyro;     /**< Gyroscope values in dps */
+} mpu9150_fifo_sample_t;
+
+/**
+ * @brief Size of the MPU-9150 FIFO in bytes
+ */
+#define MPU9150_FIFO_SIZE           (1024U)
+
 /**
  * @brief Configuration struct for the MPU-9150 sensor
  */
@@ -275,6 +288,41 @@ int mpu9150_read_compass(mpu9150_t *dev, mpu9150_results_t *output);
  */
 int mpu9150_read_temperature(mpu9150_t *dev, int32_t *output);
 
+/**
+ * @brief Enable or disable storing accelerometer and gyroscope values in
+ *        the FIFO
+ *
+ * With the FIFO enabled, the MPU-9150 stores a sample at the configured
+ * sample rate, up to MPU9150_FIFO_SIZE / sizeof(mpu9150_fifo_sample_t)
+ * samples. The MPU-9150 has no FIFO level interrupt, so the FIFO is to be
+ * read before it overflows, e.g. every 50 samples from a timer.
+ *
+ * @param[in]  dev          Device descriptor of MPU9150 device
+ * @param[in]  enable       0 disables the FIFO, any other value resets and
+ *                          enables it
+ *
+ * @return                  0 on success
+ * @return                  -1 if device's I2C is not enabled in board config
+ */
+int mpu9150_set_fifo(mpu9150_t *dev, uint8_t enable);
+
+/**
+ * @brief Read up to @p num samples from the FIFO
+ *
+ * All samples are read in a single I2C transfer.
+ *
+ * @param[in]  dev          Device descriptor of MPU9150 device
+ * @param[out] output       Buffer for @p num samples
+ * @param[in]  num          Maximum number of samples to read
+ *
+ * @return                  number of samples read on success
+ * @return                  -1 if device's I2C is not enabled in board config
+ * @return                  -2 if the full-scale range is not valid
+ * @return                  -3 if the FIFO overflowed, it is reset
+ */
+int mpu9150_read_fifo(mpu9150_t *dev, mpu9150_fifo_sample_t *output,
+                      unsigned num);
+
 /**
  * @brief Set the full-scale range for raw gyroscope data
  *
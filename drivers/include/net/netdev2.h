@@ -56,6 +56,18 @@ extern "C" {
 #include "net/netstats.h"
 #include "net/netopt.h"
 
+/**
+ * @brief   Maximum number of frames a driver passes up in one
+ *          @ref netdev2_driver_t::isr "netdev2->driver->isr()" call
+ *
+ * With more frames pending, the driver returns and signals
+ * @ref NETDEV2_EVENT_ISR again, so the network stack can serve other
+ * requests to the device in between.
+ */
+#ifndef NETDEV2_RX_BUDGET
+#define NETDEV2_RX_BUDGET   (8U)
+#endif
+
 enum {
     NETDEV2_TYPE_UNKNOWN,
     NETDEV2_TYPE_RAW,
@@ -186,6 +198,8 @@ typedef struct netdev2_driver {
      * by netdev2_isr.
      *
      * It is supposed to call @ref netdev2_t::event_callback() for each occuring event.
+     * A driver should handle everything that is pending on the device, but
+     * report at most @ref NETDEV2_RX_BUDGET received frames per call.
      *
      * See receive packet flow description for details.
      *
@@ -224,6 +238,44 @@ typedef struct netdev2_driver {
      */
     int (*set)(netdev2_t *dev, netopt_t opt,
                void *value, size_t value_len);
+
+    /**
+     * @brief   Lend a received frame in the driver's own memory
+     *
+     * Optional, may be NULL. Drivers that receive into memory of their own,
+     * e.g. a DMA receive ring, can implement this to hand out the frame
+     * without copying it. The frame stays owned by the caller until it is
+     * handed back with netdev2_driver_t::recv_return().
+     *
+     * @pre `(dev != NULL) && (buf != NULL)`
+     *
+     * Supposed to be called from @ref netdev2_t::event_callback() instead of
+     * netdev2_driver_t::recv().
+     *
+     * @param[in]   dev     network device descriptor
+     * @param[out]  buf     start of the received frame
+     * @param[out]  info    status information for the received packet, see
+     *                      netdev2_driver_t::recv()
+     *
+     * @return  length of the frame in @p buf
+     * @return  `<= 0` if no frame is available or on error
+     */
+    int (*recv_loan)(netdev2_t *dev, void **buf, void *info);
+
+    /**
+     * @brief   Hand a frame lent with netdev2_driver_t::recv_loan() back
+     *
+     * Mandatory if netdev2_driver_t::recv_loan is implemented. May be called
+     * from any thread, so implementations must only mark the memory as free
+     * again and not block.
+     *
+     * @pre `(dev != NULL)`
+     *
+     * @param[in] dev       network device descriptor
+     * @param[in] buf       pointer into the lent frame, not necessarily its
+     *                      start
+     */
+    void (*recv_return)(netdev2_t *dev, void *buf);
 } netdev2_driver_t;
 
 #ifdef __cplusplus
@@ -42,6 +42,27 @@ typedef struct nvram_spi_params {
     gpio_t cs;
     /** @brief Number of address bytes following each read/write command. */
     uint8_t address_count;
+    /**
+     * @brief Write page size of EEPROMs, 0 for memories without pages (FRAM)
+     *
+     * Writes are split at page boundaries and wait for the write cycle of
+     * each page to finish.
+     */
+    uint16_t page_size;
+    /**
+     * @brief Write-back cache for small writes, or NULL
+     *
+     * Consecutive writes that fit into the cache are collected and written
+     * in one access when a write goes elsewhere, a read overlaps them, or
+     * nvram_spi_flush() is called.
+     */
+    uint8_t *cache;
+    /** @brief Size of @p cache */
+    uint16_t cache_size;
+    /** @brief Number of bytes in @p cache, managed by the driver */
+    uint16_t cache_len;
+    /** @brief Address of the data in @p cache, managed by the driver */
+    uint32_t cache_addr;
 } nvram_spi_params_t;
 
 /**
@@ -58,6 +79,16 @@ typedef struct nvram_spi_params {
  */
 int nvram_spi_init(nvram_t *dev, nvram_spi_params_t *spi_params, size_t size);
 
+/**
+ * @brief Write the data held in the write-back cache to the device
+ *
+ * @param[in]  dev          Pointer to NVRAM device descriptor
+ *
+ * @return                  0 on success
+ * @return                  <0 on errors
+ */
+int nvram_spi_flush(nvram_t *dev);
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <sys/uio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -77,8 +78,106 @@ typedef struct nvram {
 
     /** @brief Device-specific parameters, if any. */
     void *extra;
+
+    /**
+     * @brief Pointer to device-specific vectored read function, may be NULL
+     *
+     * Reads the consecutive NVRAM range starting at @p src into the buffers
+     * of @p vec in a single access.
+     *
+     * @param[in]  dev   Pointer to NVRAM device descriptor
+     * @param[in]  vec   Buffers to read to
+     * @param[in]  count Number of buffers in @p vec
+     * @param[in]  src   Starting address in the NVRAM device address space
+     *
+     * @return           Number of bytes read on success
+     * @return           <0 on errors
+     */
+    int (*readv)(struct nvram *dev, const struct iovec *vec, unsigned count,
+                 uint32_t src);
+
+    /**
+     * @brief Pointer to device-specific vectored write function, may be NULL
+     *
+     * Writes the buffers of @p vec to the consecutive NVRAM range starting at
+     * @p dst in a single access.
+     *
+     * @param[in]  dev   Pointer to NVRAM device descriptor
+     * @param[in]  vec   Buffers to write
+     * @param[in]  count Number of buffers in @p vec
+     * @param[in]  dst   Starting address in the NVRAM device address space
+     *
+     * @return           Number of bytes written on success
+     * @return           <0 on errors
+     */
+    int (*writev)(struct nvram *dev, const struct iovec *vec, unsigned count,
+                  uint32_t dst);
 } nvram_t;
 
+/**
+ * @brief Read a consecutive NVRAM range into several buffers
+ *
+ * Uses the device's vectored read if it has one, else reads buffer by buffer.
+ *
+ * @param[in]  dev   Pointer to NVRAM device descriptor
+ * @param[in]  vec   Buffers to read to
+ * @param[in]  count Number of buffers in @p vec
+ * @param[in]  src   Starting address in the NVRAM device address space
+ *
+ * @return           Number of bytes read on success
+ * @return           <0 on errors
+ */
+static inline int nvram_readv(nvram_t *dev, const struct iovec *vec,
+                              unsigned count, uint32_t src)
+{
+    int total = 0;
+
+    if (dev->readv) {
+        return dev->readv(dev, vec, count, src);
+    }
+    for (unsigned i = 0; i < count; i++) {
+        int res = dev->read(dev, vec[i].iov_base, src + total, vec[i].iov_len);
+        if (res < 0) {
+            return res;
+        }
+        total += res;
+    }
+    return total;
+}
+
+/**
+ * @brief Write several buffers to a consecutive NVRAM range
+ *
+ * Uses the device's vectored write if it has one, else writes buffer by
+ * buffer.
+ *
+ * @param[in]  dev   Pointer to NVRAM device descriptor
+ * @param[in]  vec   Buffers to write
+ * @param[in]  count Number of buffers in @p vec
+ * @param[in]  dst   Starting address in the NVRAM device address space
+ *
+ * @return           Number of bytes written on success
+ * @return           <0 on errors
+ */
+static inline int nvram_writev(nvram_t *dev, const struct iovec *vec,
+                               unsigned count, uint32_t dst)
+{
+    int total = 0;
+
+    if (dev->writev) {
+        return dev->writev(dev, vec, count, dst);
+    }
+    for (unsigned i = 0; i < count; i++) {
+        int res = dev->write(dev, vec[i].iov_base, dst + total,
+                             vec[i].iov_len);
+        if (res < 0) {
+            return res;
+        }
+        total += res;
+    }
+    return total;
+}
+
 #ifdef __cplusplus
 }
 #endif
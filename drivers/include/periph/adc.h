@@ -30,7 +30,11 @@
  * waiting for the result of a conversion (e.g. through putting the calling
  * thread to sleep while waiting for the conversion results).
  *
- * @todo        Extend interface for continuous mode?
+ * Platforms providing the `periph_adc_continuous` feature can also sample a
+ * line continuously at a fixed rate, see adc_continuous_start(). The
+ * conversions are then triggered by a hardware timer and moved into a buffer
+ * by DMA, so sampling does not depend on the CPU keeping up with every
+ * single conversion.
  *
  * @{
  *
@@ -44,6 +48,8 @@
 #define PERIPH_ADC_H
 
 #include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #include "periph_cpu.h"
 #include "periph_conf.h"
@@ -132,6 +138,55 @@ int adc_init(adc_t line);
  */
 int adc_sample(adc_t line, adc_res_t res);
 
+/**
+ * @brief   Callback for a block of samples taken continuously
+ *
+ * Executed in interrupt context.
+ *
+ * @param[in] arg           argument given to adc_continuous_start()
+ * @param[in] samples       the block of samples
+ * @param[in] len           number of samples in @p samples
+ */
+typedef void (*adc_cont_cb_t)(void *arg, const uint16_t *samples, size_t len);
+
+/**
+ * @brief   Start sampling a line continuously
+ *
+ * The line is sampled @p freq times per second into @p buf, which is used as
+ * a double buffer: @p cb is called with the first half of @p buf once it is
+ * filled and with the second half once that one is filled, while sampling
+ * continues into the other half. The callback must thus be done with a half
+ * within the time it takes to fill the other one.
+ *
+ * The ADC device of @p line is blocked for adc_sample() until
+ * adc_continuous_stop() is called.
+ *
+ * @note    Only available on platforms providing the `periph_adc_continuous`
+ *          feature
+ *
+ * @param[in] line          line to sample, must be initialized
+ * @param[in] res           resolution to use for conversion
+ * @param[in] freq          sampling rate in Hz
+ * @param[out] buf          double buffer to sample into
+ * @param[in] len           number of samples fitting into @p buf, must be even
+ * @param[in] cb            callback for each filled half of @p buf
+ * @param[in] arg           argument for @p cb
+ *
+ * @return                  0 on success
+ * @return                  -1 if a parameter is not applicable
+ * @return                  -2 if continuous sampling is in use already
+ */
+int adc_continuous_start(adc_t line, adc_res_t res, uint32_t freq,
+                         uint16_t *buf, size_t len, adc_cont_cb_t cb,
+                         void *arg);
+
+/**
+ * @brief   Stop continuous sampling
+ *
+ * @param[in] line          line passed to adc_continuous_start()
+ */
+void adc_continuous_stop(adc_t line);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_periph_crc CRC
+ * @ingroup     drivers_periph
+ * @brief       Low-level CRC calculation unit peripheral driver
+ *
+ * Some MCUs calculate CRCs in hardware. Use this interface through
+ * @ref sys_checksum_crc32 with the `crc32_periph` module rather than
+ * directly.
+ *
+ * The unit is shared, calls are serialized by the driver, so it must not be
+ * used from interrupt context.
+ *
+ * @{
+ * @file
+ * @brief       Low-level CRC peripheral driver interface definitions
+ */
+
+#ifndef PERIPH_CRC_H
+#define PERIPH_CRC_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Update a CRC32 (IEEE 802.3) with the CRC unit
+ *
+ * @param[in] crc       checksum of the data so far, 0 to start a new one
+ * @param[in] buf       data to add to the checksum
+ * @param[in] len       number of bytes in @p buf
+ *
+ * @return  checksum of the data given so far, same as crc32_update()
+ */
+uint32_t crc_crc32_update(uint32_t crc, const uint8_t *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIPH_CRC_H */
+/** @} */
@@ -23,6 +23,11 @@
  * A module for more fine-grained access of memory locations can easily be
  * programmed on top of this interface.
  *
+ * Most MCUs can program their flash in blocks much smaller than a page. Where
+ * the CPU defines @ref FLASHPAGE_RAW_BLOCKSIZE, flashpage_write_raw() writes
+ * such blocks to already erased flash without a page sized buffer in RAM,
+ * e.g. for streaming a firmware image to flash.
+ *
  * @note        Flash memory has only a limited amount of erase cycles (mostly
  *              around 10K times), so using this interface in some kind of loops
  *              can damage you MCU!
@@ -33,6 +38,7 @@
 #ifndef FLASHPAGE_H
 #define FLASHPAGE_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "periph_cpu.h"
@@ -58,6 +64,21 @@ extern "C" {
 #error "periph/flashpage: FLASHPAGE_NUMOF not defined"
 #endif
 
+#ifdef DOXYGEN
+/**
+ * @brief   Size of the blocks flashpage_write_raw() writes, the length of a
+ *          raw write must be a multiple of it
+ *
+ * Only defined by CPUs supporting raw writes.
+ */
+#define FLASHPAGE_RAW_BLOCKSIZE
+
+/**
+ * @brief   Required alignment of the target address and data of a raw write
+ */
+#define FLASHPAGE_RAW_ALIGNMENT
+#endif
+
 /**
  * @brief   Return values used in this interface
  */
@@ -90,6 +111,23 @@ static inline void *flashpage_addr(int page)
  */
 void flashpage_write(int page, void *data);
 
+#if defined(FLASHPAGE_RAW_BLOCKSIZE) || defined(DOXYGEN)
+/**
+ * @brief   Write data to erased flash
+ *
+ * Programming can only clear bits, so the target should be erased, e.g. with
+ * flashpage_write(page, NULL). A write may span several pages.
+ *
+ * @param[in] target_addr   address in flash to write to, MUST be aligned to
+ *                          @ref FLASHPAGE_RAW_ALIGNMENT
+ * @param[in] data          data to write, MUST be aligned to
+ *                          @ref FLASHPAGE_RAW_ALIGNMENT
+ * @param[in] len           length of @p data, MUST be a multiple of
+ *                          @ref FLASHPAGE_RAW_BLOCKSIZE
+ */
+void flashpage_write_raw(void *target_addr, const void *data, size_t len);
+#endif
+
 /**
  * @brief   Read the given page into the given memory location
  *
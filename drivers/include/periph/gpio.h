@@ -43,6 +43,17 @@
  * definitions in `RIOT/boards/ * /include/periph_conf.h` will define the selected
  * GPIO pin.
  *
+ * On CPUs defining PERIPH_GPIO_HAS_PORT, the gpio_port_x() functions read or
+ * change several pins of one port with a single register access, e.g. for
+ * bit-banging parallel buses. The port is given by any of its pins, e.g.
+ * @p GPIO_PIN(1, 0), and the pins by a mask in which bit n is pin n of the
+ * port. The pins must have been initialized with gpio_init() before.
+ *
+ * CPUs defining PERIPH_GPIO_HAS_FAST provide gpio_fast_set(),
+ * gpio_fast_clear(), gpio_fast_toggle() and gpio_fast_read() as static inline
+ * functions in their periph_cpu.h. For a pin known at compile time, these
+ * compile down to one or two register accesses without a function call.
+ *
  * @{
  * @file
  * @brief       Low-level GPIO peripheral driver interface definitions
@@ -54,6 +65,7 @@
 #define GPIO_H
 
 #include <limits.h>
+#include <stdint.h>
 
 #include "periph_cpu.h"
 #include "periph_conf.h"
@@ -221,6 +233,95 @@ void gpio_toggle(gpio_t pin);
  */
 void gpio_write(gpio_t pin, int value);
 
+#if defined(PERIPH_GPIO_HAS_PORT) || defined(DOXYGEN)
+/**
+ * @brief   Get the current value of all pins of the given port
+ *
+ * @param[in] port      any pin of the port to read
+ *
+ * @return              pin values, bit n is set when pin n is HIGH
+ */
+uint32_t gpio_port_read(gpio_t port);
+
+/**
+ * @brief   Set the pins given by @p mask of the given port to HIGH
+ *
+ * @param[in] port      any pin of the port
+ * @param[in] mask      pins to set
+ */
+void gpio_port_set(gpio_t port, uint32_t mask);
+
+/**
+ * @brief   Set the pins given by @p mask of the given port to LOW
+ *
+ * @param[in] port      any pin of the port
+ * @param[in] mask      pins to clear
+ */
+void gpio_port_clear(gpio_t port, uint32_t mask);
+
+/**
+ * @brief   Toggle the pins given by @p mask of the given port
+ *
+ * @param[in] port      any pin of the port
+ * @param[in] mask      pins to toggle
+ */
+void gpio_port_toggle(gpio_t port, uint32_t mask);
+
+/**
+ * @brief   Set the pins given by @p mask of the given port to the
+ *          corresponding bits of @p value
+ *
+ * Pins not in @p mask keep their value. Depending on the CPU, the pins set
+ * to HIGH and to LOW change in one or in two register accesses.
+ *
+ * @param[in] port      any pin of the port
+ * @param[in] mask      pins to write
+ * @param[in] value     new pin values, bit n for pin n
+ */
+void gpio_port_write(gpio_t port, uint32_t mask, uint32_t value);
+#endif /* PERIPH_GPIO_HAS_PORT */
+
+#if defined(DOXYGEN)
+/**
+ * @brief   Set the given pin to HIGH, inline
+ *
+ * Only available on CPUs defining PERIPH_GPIO_HAS_FAST.
+ *
+ * @param[in] pin       the pin to set, initialized as output
+ */
+static inline void gpio_fast_set(gpio_t pin);
+
+/**
+ * @brief   Set the given pin to LOW, inline
+ *
+ * Only available on CPUs defining PERIPH_GPIO_HAS_FAST.
+ *
+ * @param[in] pin       the pin to clear, initialized as output
+ */
+static inline void gpio_fast_clear(gpio_t pin);
+
+/**
+ * @brief   Toggle the given pin, inline
+ *
+ * Only available on CPUs defining PERIPH_GPIO_HAS_FAST.
+ *
+ * @param[in] pin       the pin to toggle, initialized as output
+ */
+static inline void gpio_fast_toggle(gpio_t pin);
+
+/**
+ * @brief   Read the given pin, inline
+ *
+ * Only available on CPUs defining PERIPH_GPIO_HAS_FAST.
+ *
+ * @param[in] pin       the pin to read
+ *
+ * @return  0 for LOW
+ * @return  != 0 for HIGH
+ */
+static inline int gpio_fast_read(gpio_t pin);
+#endif /* DOXYGEN */
+
 #ifdef __cplusplus
 }
 #endif
@@ -90,6 +90,13 @@ typedef enum {
 #endif
 /** @} */
 
+/**
+ * @brief Minimum length of a transfer to be worth setting up the DMA
+ */
+#ifndef SPI_DMA_MIN_LEN
+#define SPI_DMA_MIN_LEN     (16U)
+#endif
+
 /**
  * @brief Define a set of pre-defined SPI clock speeds.
  *
@@ -201,6 +208,27 @@ int spi_transfer_byte(spi_t dev, char out, char *in);
  */
 int spi_transfer_bytes(spi_t dev, char *out, char *in, unsigned int length);
 
+/**
+ * @brief Transfer a number bytes on the given SPI bus using DMA
+ *
+ * Same as spi_transfer_bytes(), but the calling thread sleeps while the DMA
+ * controller moves the data, so the CPU is free for other threads during a
+ * longer transfer. Transfers shorter than @ref SPI_DMA_MIN_LEN, or on devices
+ * the board did not assign DMA channels to, fall back to
+ * spi_transfer_bytes().
+ *
+ * @note    Must not be called from interrupt context
+ *
+ * @param[in] dev       SPI device to use
+ * @param[in] out       Array of bytes to send, set NULL if only receiving
+ * @param[out] in       Buffer to receive bytes to, set NULL if only sending
+ * @param[in] length    Number of bytes to transfer
+ *
+ * @return              Number of bytes that were transfered
+ * @return              -1 on error
+ */
+int spi_transfer_bytes_dma(spi_t dev, char *out, char *in, unsigned int length);
+
 /**
  * @brief Transfer one byte to/from a given register address
  *
@@ -236,6 +264,34 @@ int spi_transfer_reg(spi_t dev, uint8_t reg, char out, char *in);
  */
 int spi_transfer_regs(spi_t dev, uint8_t reg, char *out, char *in, unsigned int length);
 
+/**
+ * @brief Register transfer queued for spi_transfer_reg_batch()
+ */
+typedef struct {
+    uint8_t reg;                /**< register address (command byte) */
+    char *out;                  /**< bytes to send, NULL if only receiving */
+    char *in;                   /**< buffer to read into, NULL if only sending */
+    unsigned int length;        /**< number of bytes after the address */
+} spi_reg_op_t;
+
+/**
+ * @brief Transfer a batch of register operations back to back
+ *
+ * Runs spi_transfer_regs() for each entry of @p ops. The caller acquires the
+ * bus and asserts chip select once around the whole batch, so this is meant
+ * for devices that accept several commands within one chip select frame,
+ * e.g., to configure a number of registers in a row.
+ *
+ * @param[in] dev       SPI device to use
+ * @param[in] ops       register operations to run in order
+ * @param[in] num       number of entries in @p ops
+ *
+ * @return              Number of bytes that were transfered, including the
+ *                      register addresses
+ * @return              -1 on error
+ */
+int spi_transfer_reg_batch(spi_t dev, const spi_reg_op_t *ops, unsigned int num);
+
 /**
  * @brief Tell the SPI driver that a new transaction was started. Call only when SPI in slave mode!
  *
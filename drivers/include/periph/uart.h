@@ -101,6 +101,33 @@ typedef unsigned int uart_t;
  */
 typedef void(*uart_rx_cb_t)(void *arg, uint8_t data);
 
+/**
+ * @brief   Signature for receive interrupt callback handing out blocks
+ *
+ * @param[in] arg           context to the callback (optional)
+ * @param[in] data          the bytes that were received
+ * @param[in] len           number of bytes in @p data
+ */
+typedef void(*uart_rx_block_cb_t)(void *arg, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Size of the DMA receive buffer of devices initialized with
+ *          uart_init_block()
+ *
+ * The callback is called at the latest when half of it is filled.
+ */
+#ifndef UART_RX_BLOCK_BUFSIZE
+#define UART_RX_BLOCK_BUFSIZE   (128U)
+#endif
+
+/**
+ * @brief   Size of the transmit buffer of each UART device when the
+ *          `periph_uart_nonblocking` module is used
+ */
+#ifndef UART_TXBUF_SIZE
+#define UART_TXBUF_SIZE         (64U)
+#endif
+
 /**
  * @brief   Interrupt context for a UART device
  * @{
@@ -146,6 +173,30 @@ enum {
  */
 int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg);
 
+/**
+ * @brief   Initialize a given UART device to receive data in blocks
+ *
+ * Same as uart_init(), but @p rx_cb is called in interrupt context with all
+ * bytes received since its previous call. CPUs defining
+ * PERIPH_UART_HAS_RX_BLOCK let the DMA fill a buffer of
+ * @ref UART_RX_BLOCK_BUFSIZE bytes and call @p rx_cb when the line goes idle
+ * or half of the buffer is filled, so the CPU is interrupted once per block
+ * instead of once per byte. Everywhere else, and on devices the board did not
+ * assign a DMA stream to, @p rx_cb is called once for every byte.
+ *
+ * @param[in] uart          UART device to initialize
+ * @param[in] baudrate      desired baudrate in baud/s
+ * @param[in] rx_cb         receive callback, must not be NULL
+ * @param[in] arg           optional context passed to the callback functions
+ *
+ * @return                  UART_OK on success
+ * @return                  UART_NODEV on invalid UART device
+ * @return                  UART_NOBAUD on inapplicable baudrate
+ * @return                  UART_INTERR on other errors
+ */
+int uart_init_block(uart_t uart, uint32_t baudrate, uart_rx_block_cb_t rx_cb,
+                    void *arg);
+
 /**
  * @brief   Write data from the given buffer to the specified UART device
  *
@@ -153,6 +204,13 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg);
  * given buffer have been send. The way this data is send is up to the
  * implementation: active waiting, interrupt driven, DMA, etc.
  *
+ * With the `periph_uart_nonblocking` module on CPUs defining
+ * PERIPH_UART_HAS_NONBLOCKING, the data is copied to a transmit buffer of
+ * @ref UART_TXBUF_SIZE bytes instead, which is sent by the interrupt or the
+ * DMA, and the function only waits while the buffer is full. Called from
+ * interrupt context or with interrupts disabled, it sends the buffer itself
+ * and returns when it is empty, so output of e.g. core_panic() is not lost.
+ *
  * @param[in] uart          UART device to use for transmission
  * @param[in] data          data buffer to send
  * @param[in] len           number of bytes to send
@@ -160,6 +218,15 @@ int uart_init(uart_t uart, uint32_t baudrate, uart_rx_cb_t rx_cb, void *arg);
  */
 void uart_write(uart_t uart, const uint8_t *data, size_t len);
 
+/**
+ * @brief   Wait until all data written to the given UART device was sent
+ *
+ * Returns right away when uart_write() is blocking.
+ *
+ * @param[in] uart          UART device to flush
+ */
+void uart_flush(uart_t uart);
+
 /**
  * @brief   Power on the given UART device
  *
@@ -18,6 +18,11 @@
  * stack provided by RIOT (e.g. GNRC). This enables W5100 devices to communicate
  * via IPv6, enables unlimited connections, and more...
  *
+ * Nodes that only need a few IPv4 UDP connections can instead offload the
+ * whole stack to the device: with the `w5100_sock_udp` module the device is
+ * handed to w5100_sock_init() instead of a network stack, and @ref net_sock_udp
+ * maps each sock onto one of the four hardware sockets.
+ *
  * @note        This driver expects to be triggered by the external interrupt
  *              line of the W5100 device. On some Arduino shields this is not
  *              enabled by default, you have to close the corresponding solder
@@ -77,6 +82,33 @@ typedef struct {
  */
 void w5100_setup(w5100_t *dev, const w5100_params_t *params);
 
+#if defined(MODULE_W5100_SOCK_UDP) || defined(DOXYGEN)
+/**
+ * @brief   Number of hardware sockets
+ */
+#define W5100_SOCK_NUMOF    (4U)
+
+/**
+ * @brief   Initialize the device for the hardware TCP/IP stack
+ *
+ * Resets the device, sets its IPv4 configuration and makes @p dev the device
+ * of the @ref net_sock_udp implementation. The device can not be used as a
+ * netdev2 device anymore afterwards.
+ *
+ * @pre w5100_setup() was called on @p dev
+ *
+ * @param[in] dev       device descriptor
+ * @param[in] addr      IPv4 address of the device in network byte order
+ * @param[in] netmask   subnet mask in network byte order
+ * @param[in] gw        default gateway in network byte order
+ *
+ * @return  0 on success
+ * @return  W5100_ERR_BUS if the device does not respond
+ */
+int w5100_sock_init(w5100_t *dev, const uint8_t *addr,
+                    const uint8_t *netmask, const uint8_t *gw);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -56,6 +56,22 @@ extern "C" {
  */
 #define XBEE_MAX_RESP_LENGTH        (16U)
 
+/**
+ * @brief   Maximum length of an AT command frame, sized for KY with a 128-bit
+ *          key
+ */
+#define XBEE_MAX_CMD_LENGTH         (24U)
+
+/**
+ * @brief   Maximum number of AT commands sent in one round trip
+ *
+ * Each command in flight takes a response buffer of
+ * @ref XBEE_MAX_RESP_LENGTH bytes. Must not be greater than 8.
+ */
+#ifndef XBEE_AT_PIPELINE_LEN
+#define XBEE_AT_PIPELINE_LEN        (4U)
+#endif
+
 /**
  * @brief   Maximal possible size of a TX header
  */
@@ -111,6 +127,7 @@ typedef enum {
                              *   responses */
     XBEE_INT_STATE_RX,      /**< handling incoming data when receiving radio
                              *   packets */
+    XBEE_INT_STATE_SKIP,    /**< skipping the rest of an unused frame */
 } xbee_rx_state_t;
 
 /**
@@ -149,12 +166,19 @@ typedef struct {
     /* values for the UART TX state machine */
     mutex_t tx_lock;                    /**< mutex to allow only one
                                          *   transmission at a time */
-    uint8_t cmd_buf[XBEE_MAX_RESP_LENGTH];/**< command data buffer */
+    uint8_t cmd_buf[XBEE_MAX_CMD_LENGTH];/**< command data buffer */
     uint8_t tx_fid;                     /**< TX frame ID */
     /* buffer and synchronization for command responses */
     mutex_t resp_lock;                  /**< mutex for waiting for AT command
                                          *   response frames */
-    uint8_t resp_buf[XBEE_MAX_RESP_LENGTH]; /**< AT response data buffer */
+    uint8_t resp_buf[XBEE_AT_PIPELINE_LEN][XBEE_MAX_RESP_LENGTH]; /**< AT
+                                         *   response data buffers, one per
+                                         *   command in flight */
+    uint8_t resp_len[XBEE_AT_PIPELINE_LEN]; /**< size of each response */
+    volatile uint8_t resp_pending;      /**< bitmap of outstanding responses */
+    uint8_t resp_fid;                   /**< frame ID of the first command in
+                                         *   flight */
+    uint8_t resp_slot;                  /**< response buffer in use */
     uint16_t resp_count;                /**< counter for ongoing transmission */
     uint16_t resp_limit;                /**< size RESP frame in transferred */
     /* buffer and synchronization for incoming network packets */
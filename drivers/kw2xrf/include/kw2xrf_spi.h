@@ -47,6 +47,15 @@ int kw2xrf_spi_init(spi_t spi, spi_speed_t spi_speed,
  */
 void kw2xrf_write_dreg(uint8_t addr, uint8_t value);
 
+/**
+ * @brief Writes consecutive kw2xrf registers in one burst.
+ *
+ * @param[in] addr Address of the first register to write.
+ * @param[in] buf Values to write.
+ * @param[in] length Number of registers to write.
+ */
+void kw2xrf_write_dregs(uint8_t addr, uint8_t *buf, uint8_t length);
+
 /**
  * @brief Reads a byte from the kw2xrf register.
  *
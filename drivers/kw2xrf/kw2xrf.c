@@ -102,16 +102,11 @@ int kw2xrf_get_channel(kw2xrf_t *dev, uint8_t *val, size_t max)
         return -EOVERFLOW;
     }
 
-    uint8_t pll_int = kw2xrf_read_dreg(MKW2XDM_PLL_INT0);
-    uint16_t pll_frac = kw2xrf_read_dreg(MKW2XDM_PLL_FRAC0_LSB);
-    pll_frac |= ((uint16_t)kw2xrf_read_dreg(MKW2XDM_PLL_FRAC0_MSB) << 8);
-
-    for (int i = 0; i < 16; i++) {
-        if ((pll_frac_lt[i] == pll_frac) && (pll_int_lt[i] == pll_int)) {
-            val[0] = i + 11;
-            val[1] = 0;
-            return 2;
-        }
+    /* kept up to date by kw2xrf_set_channel(), no need to ask the PLL */
+    if (dev->radio_channel != 0) {
+        val[0] = dev->radio_channel;
+        val[1] = 0;
+        return 2;
     }
 
     return -EINVAL;
@@ -231,12 +226,7 @@ void kw2xrf_set_sequence(kw2xrf_t *dev, kw2xrf_physeq_t seq)
 
 int kw2xrf_set_channel(kw2xrf_t *dev, uint8_t *val, size_t len)
 {
-    /* Save old sequence to restore this state later */
-    uint8_t old_seq = kw2xrf_get_sequence();
-
-    if (old_seq) {
-        kw2xrf_set_sequence(dev, XCVSEQ_IDLE);
-    }
+    uint8_t old_seq;
 
     if ((val[0] < 11) || (val[0] > 26)) {
         DEBUG("kw2xrf: Invalid channel %i set. Valid channels are 11 through 26\n", val[0]);
@@ -248,6 +238,17 @@ int kw2xrf_set_channel(kw2xrf_t *dev, uint8_t *val, size_t len)
         return -EINVAL;
     }
 
+    if (val[0] == dev->radio_channel) {
+        return 2;
+    }
+
+    /* Save old sequence to restore this state later */
+    old_seq = kw2xrf_get_sequence();
+
+    if (old_seq) {
+        kw2xrf_set_sequence(dev, XCVSEQ_IDLE);
+    }
+
     /*
      * Fc = 2405 + 5(k - 11) , k = 11,12,...,26
      *
@@ -256,9 +257,14 @@ int kw2xrf_set_channel(kw2xrf_t *dev, uint8_t *val, size_t len)
      *
      */
     uint8_t tmp = val[0] - 11;
-    kw2xrf_write_dreg(MKW2XDM_PLL_INT0, MKW2XDM_PLL_INT0_VAL(pll_int_lt[tmp]));
-    kw2xrf_write_dreg(MKW2XDM_PLL_FRAC0_LSB, (uint8_t)pll_frac_lt[tmp]);
-    kw2xrf_write_dreg(MKW2XDM_PLL_FRAC0_MSB, (uint8_t)(pll_frac_lt[tmp] >> 8));
+    uint8_t pll[3] = {
+        MKW2XDM_PLL_INT0_VAL(pll_int_lt[tmp]),
+        (uint8_t)pll_frac_lt[tmp],
+        (uint8_t)(pll_frac_lt[tmp] >> 8)
+    };
+    /* PLL_INT0, PLL_FRAC0_LSB and PLL_FRAC0_MSB in one burst */
+    kw2xrf_write_dregs(MKW2XDM_PLL_INT0, pll, sizeof(pll));
+    dev->radio_channel = val[0];
 
     DEBUG("kw2xrf: set channel to %u\n", val[0]);
 
@@ -456,8 +462,8 @@ int kw2xrf_init(kw2xrf_t *dev, spi_t spi, spi_speed_t spi_speed,
     kw2xrf_set_tx_power(dev, &(dev->tx_power), sizeof(dev->tx_power));
 
     /* set default channel */
-    dev->radio_channel = KW2XRF_DEFAULT_CHANNEL;
-    tmp[0] = dev->radio_channel;
+    dev->radio_channel = 0;
+    tmp[0] = KW2XRF_DEFAULT_CHANNEL;
     tmp[1] = 0;
     kw2xrf_set_channel(dev, tmp, 2);
     /* set default PAN ID */
@@ -666,6 +672,26 @@ int kw2xrf_get(gnrc_netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
             *((netopt_enable_t *)value) = !!(dev->option & KW2XRF_OPT_RAWDUMP);
             return sizeof(netopt_enable_t);
 
+        case NETOPT_AUTOCCA:
+            *((netopt_enable_t *)value) = !!(dev->option & KW2XRF_OPT_CSMA);
+            return sizeof(netopt_enable_t);
+
+        case NETOPT_OFFLOADS:
+            if (max_len < sizeof(uint16_t)) {
+                return -EOVERFLOW;
+            }
+            *((uint16_t *)value) = 0;
+            if (!(dev->option & KW2XRF_OPT_PROMISCUOUS)) {
+                *((uint16_t *)value) |= NETOPT_OFFLOAD_ADDR_FILTER;
+                if (dev->option & KW2XRF_OPT_AUTOACK) {
+                    *((uint16_t *)value) |= NETOPT_OFFLOAD_AUTOACK;
+                }
+            }
+            if (dev->option & KW2XRF_OPT_CSMA) {
+                *((uint16_t *)value) |= NETOPT_OFFLOAD_CSMA;
+            }
+            return sizeof(uint16_t);
+
         default:
             return -ENOTSUP;
     }
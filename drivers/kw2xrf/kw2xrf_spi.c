@@ -85,6 +85,13 @@ void kw2xrf_write_dreg(uint8_t addr, uint8_t value)
     return;
 }
 
+void kw2xrf_write_dregs(uint8_t addr, uint8_t *buf, uint8_t length)
+{
+    kw2xrf_spi_transfer_head();
+    spi_transfer_regs(kw2xrf_spi, addr, (char *)buf, NULL, length);
+    kw2xrf_spi_transfer_tail();
+}
+
 uint8_t kw2xrf_read_dreg(uint8_t addr)
 {
     uint8_t value;
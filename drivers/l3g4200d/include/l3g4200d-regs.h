@@ -73,6 +73,16 @@
 #define L3G4200D_CTRL1_MODE_POS         (4)
 /** @} */
 
+/**
+ * @name CTRL3 bitfields
+ * @{
+ */
+#define L3G4200D_CTRL3_I2_DRDY          0x08
+#define L3G4200D_CTRL3_I2_WTM           0x04
+#define L3G4200D_CTRL3_I2_ORUN          0x02
+#define L3G4200D_CTRL3_I2_EMPTY         0x01
+/** @} */
+
 /**
  * @name CTRL4 bitfields
  */
@@ -86,6 +96,24 @@
 #define L3G4200D_CTRL4_FS_POS           (4)
 /** @} */
 
+/**
+ * @name CTRL5 bitfields
+ * @{
+ */
+#define L3G4200D_CTRL5_FIFO_EN          0x40
+/** @} */
+
+/**
+ * @name FIFO_CTRL and FIFO_SRC bitfields
+ * @{
+ */
+#define L3G4200D_FIFO_MODE_BYPASS       0x00
+#define L3G4200D_FIFO_MODE_STREAM       0x40
+#define L3G4200D_FIFO_WTM_MASK          0x1f
+#define L3G4200D_FIFO_SRC_OVRN          0x40
+#define L3G4200D_FIFO_SRC_FSS_MASK      0x1f
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
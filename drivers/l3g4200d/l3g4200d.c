@@ -84,24 +84,85 @@ int l3g4200d_init(l3g4200d_t *dev, i2c_t i2c, uint8_t address,
     return 0;
 }
 
+/* read num samples in one transfer, the bus must be acquired */
+static int _read_samples(l3g4200d_t *dev, l3g4200d_data_t *data, unsigned num)
+{
+    int len = num * sizeof(l3g4200d_data_t);
+    uint8_t *raw = (uint8_t *)data;
+    int16_t *res = (int16_t *)data;
+
+    /* with the FIFO enabled, the address wraps from OUT_Z_H to OUT_X_L */
+    if (i2c_read_regs(dev->i2c, dev->addr, L3G4200D_REG_OUT_X_L | L3G4200D_AUTOINC,
+                      raw, len) != len) {
+        return -1;
+    }
+
+    /* parse and normalize data into result vectors, in place */
+    for (unsigned i = 0; i < num * 3; i++) {
+        int16_t tmp = (raw[2 * i + 1] << 8) | raw[2 * i];
+        res[i] = (int16_t)((dev->scale * tmp) / MAX_VAL);
+    }
+    return 0;
+}
+
 int l3g4200d_read(l3g4200d_t *dev, l3g4200d_data_t *data)
 {
-    uint8_t tmp[6];
-    int16_t res;
+    int res;
 
     i2c_acquire(dev->i2c);
-    /* get acceleration in x direction */
-    i2c_read_regs(dev->i2c, dev->addr, L3G4200D_REG_OUT_X_L | L3G4200D_AUTOINC, tmp, 6);
+    res = _read_samples(dev, data, 1);
     i2c_release(dev->i2c);
+    return res;
+}
 
-    /* parse and normalize data into result vector */
-    res = (tmp[1] << 8) | tmp[0];
-    data->acc_x = (int16_t)((dev->scale * res) / MAX_VAL);
-    res = (tmp[3] << 8) | tmp[2];
-    data->acc_y = (int16_t)((dev->scale * res) / MAX_VAL);
-    res = (tmp[5] << 8) | tmp[4];
-    data->acc_z = (int16_t)((dev->scale * res) / MAX_VAL);
-    return 0;
+int l3g4200d_set_fifo(l3g4200d_t *dev, uint8_t watermark)
+{
+    uint8_t mode = L3G4200D_FIFO_MODE_BYPASS;
+    uint8_t ctrl5 = 0;
+    uint8_t ctrl3 = 0;
+    int res = 0;
+
+    if (watermark > 0) {
+        mode = L3G4200D_FIFO_MODE_STREAM | (watermark & L3G4200D_FIFO_WTM_MASK);
+        ctrl5 = L3G4200D_CTRL5_FIFO_EN;
+        ctrl3 = L3G4200D_CTRL3_I2_WTM;
+    }
+
+    i2c_acquire(dev->i2c);
+    res += i2c_write_reg(dev->i2c, dev->addr, L3G4200D_REG_FIFO_CTRL, mode);
+    res += i2c_write_reg(dev->i2c, dev->addr, L3G4200D_REG_CTRL5, ctrl5);
+    res += i2c_write_reg(dev->i2c, dev->addr, L3G4200D_REG_CTRL3, ctrl3);
+    i2c_release(dev->i2c);
+
+    return (res < 3) ? -1 : 0;
+}
+
+int l3g4200d_read_fifo(l3g4200d_t *dev, l3g4200d_data_t *data, unsigned num)
+{
+    uint8_t src;
+    unsigned level;
+
+    i2c_acquire(dev->i2c);
+    if (i2c_read_reg(dev->i2c, dev->addr, L3G4200D_REG_FIFO_SRC, &src) != 1) {
+        i2c_release(dev->i2c);
+        return -1;
+    }
+    if (src & L3G4200D_FIFO_SRC_OVRN) {
+        level = L3G4200D_FIFO_SIZE;
+    }
+    else {
+        level = src & L3G4200D_FIFO_SRC_FSS_MASK;
+    }
+    if (level > num) {
+        level = num;
+    }
+    if ((level > 0) && (_read_samples(dev, data, level) < 0)) {
+        i2c_release(dev->i2c);
+        return -1;
+    }
+    i2c_release(dev->i2c);
+
+    return level;
 }
 
 int l3g4200d_enable(l3g4200d_t *dev)
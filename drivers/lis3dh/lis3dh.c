@@ -28,6 +28,8 @@ static inline int lis3dh_write_bits(const lis3dh_t *dev, const lis3dh_reg_t reg,
 static int lis3dh_write_reg(const lis3dh_t *dev, const lis3dh_reg_t reg, const uint8_t value);
 static int lis3dh_read_regs(const lis3dh_t *dev, const lis3dh_reg_t reg, const uint8_t len,
                             uint8_t *buf);
+static int lis3dh_read_samples(const lis3dh_t *dev, lis3dh_data_t *acc_data,
+                               unsigned num);
 
 
 int lis3dh_init(lis3dh_t *dev, spi_t spi, gpio_t cs_pin, uint8_t scale)
@@ -76,37 +78,36 @@ int lis3dh_init(lis3dh_t *dev, spi_t spi, gpio_t cs_pin, uint8_t scale)
 
 int lis3dh_read_xyz(const lis3dh_t *dev, lis3dh_data_t *acc_data)
 {
-    uint8_t i;
-    /* Set READ MULTIPLE mode */
-    static const uint8_t addr = (LIS3DH_REG_OUT_X_L | LIS3DH_SPI_READ_MASK | LIS3DH_SPI_MULTI_MASK);
+    return lis3dh_read_samples(dev, acc_data, 1);
+}
 
-    /* Acquire exclusive access to the bus. */
-    spi_acquire(dev->spi);
-    /* Perform the transaction */
-    gpio_clear(dev->cs);
+int lis3dh_read_fifo(const lis3dh_t *dev, lis3dh_data_t *acc_data,
+                     unsigned num)
+{
+    uint8_t reg;
+    unsigned level;
 
-    if (spi_transfer_regs(dev->spi, addr, NULL, (char *)acc_data,
-                          sizeof(lis3dh_data_t)) != sizeof(lis3dh_data_t)) {
-        /* Transfer error */
-        gpio_set(dev->cs);
-        /* Release the bus for other threads. */
-        spi_release(dev->spi);
+    if (lis3dh_read_regs(dev, LIS3DH_REG_FIFO_SRC_REG, 1, &reg) != 0) {
         return -1;
     }
-
-    gpio_set(dev->cs);
-    /* Release the bus for other threads. */
-    spi_release(dev->spi);
-
-    /* Scale to milli-G */
-    for (i = 0; i < 3; ++i) {
-        int32_t tmp = (int32_t)(((int16_t *)acc_data)[i]);
-        tmp *= dev->scale;
-        tmp /= 32768;
-        (((int16_t *)acc_data)[i]) = (int16_t)tmp;
+    if (reg & LIS3DH_FIFO_SRC_REG_OVRN_FIFO_MASK) {
+        level = LIS3DH_FIFO_SIZE;
     }
-
-    return 0;
+    else {
+        level = (reg & LIS3DH_FIFO_SRC_REG_FSS_MASK) >> LIS3DH_FIFO_SRC_REG_FSS_SHIFT;
+    }
+    if (level > num) {
+        level = num;
+    }
+    if (level == 0) {
+        return 0;
+    }
+    /* with the FIFO enabled, the address wraps from OUT_Z_H to OUT_X_L, so
+     * all samples are read in one go */
+    if (lis3dh_read_samples(dev, acc_data, level) < 0) {
+        return -1;
+    }
+    return level;
 }
 
 int lis3dh_read_aux_adc1(const lis3dh_t *dev, int16_t *out)
@@ -249,6 +250,51 @@ static int lis3dh_read_regs(const lis3dh_t *dev, const lis3dh_reg_t reg, const u
     return 0;
 }
 
+/**
+ * @brief Read samples from the output registers and scale them to milli-G.
+ *
+ * @param[in]  dev          Device descriptor
+ * @param[out] acc_data     The samples will be written here
+ * @param[in]  num          Number of samples to read
+ *
+ * @return                  0 on success
+ * @return                  -1 on error
+ */
+static int lis3dh_read_samples(const lis3dh_t *dev, lis3dh_data_t *acc_data,
+                               unsigned num)
+{
+    /* Set READ MULTIPLE mode */
+    static const uint8_t addr = (LIS3DH_REG_OUT_X_L | LIS3DH_SPI_READ_MASK | LIS3DH_SPI_MULTI_MASK);
+    unsigned len = num * sizeof(lis3dh_data_t);
+
+    /* Acquire exclusive access to the bus. */
+    spi_acquire(dev->spi);
+    /* Perform the transaction */
+    gpio_clear(dev->cs);
+
+    if (spi_transfer_regs(dev->spi, addr, NULL, (char *)acc_data, len) != (int)len) {
+        /* Transfer error */
+        gpio_set(dev->cs);
+        /* Release the bus for other threads. */
+        spi_release(dev->spi);
+        return -1;
+    }
+
+    gpio_set(dev->cs);
+    /* Release the bus for other threads. */
+    spi_release(dev->spi);
+
+    /* Scale to milli-G */
+    for (unsigned i = 0; i < num * 3; ++i) {
+        int32_t tmp = (int32_t)(((int16_t *)acc_data)[i]);
+        tmp *= dev->scale;
+        tmp /= 32768;
+        (((int16_t *)acc_data)[i]) = (int16_t)tmp;
+    }
+
+    return 0;
+}
+
 /**
  * @brief Write a value to an 8 bit register in the LIS3DH.
  *
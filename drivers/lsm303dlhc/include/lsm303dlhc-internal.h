@@ -42,8 +42,16 @@ extern "C" {
 #define LSM303DLHC_REG_OUT_Y_H_A            (0x2b)
 #define LSM303DLHC_REG_OUT_Z_L_A            (0x2c)
 #define LSM303DLHC_REG_OUT_Z_H_A            (0x2d)
+#define LSM303DLHC_REG_FIFO_CTRL_A          (0x2e)
+#define LSM303DLHC_REG_FIFO_SRC_A           (0x2f)
 /** @} */
 
+/**
+ * @brief Flag for auto-incrementing the register address on multi-byte
+ *        accelerometer reads
+ */
+#define LSM303DLHC_AUTOINC_A                (0x80)
+
 /**
  * @name Masks for the LSM303DLHC CTRL1_A register
  * @{
@@ -72,9 +80,9 @@ extern "C" {
 #define LSM303DLHC_CTRL3_A_I1_AOI1          (0x40)
 #define LSM303DLHC_CTRL3_A_I1_AOI2          (0x20)
 #define LSM303DLHC_CTRL3_A_I1_DRDY1         (0x10)
-#define LSM303DLHC_CTRL3_A_I1_DRDY2         (0x80)
-#define LSM303DLHC_CTRL3_A_I1_WTM           (0x40)
-#define LSM303DLHC_CTRL3_A_I1_OVERRUN       (0x20)
+#define LSM303DLHC_CTRL3_A_I1_DRDY2         (0x08)
+#define LSM303DLHC_CTRL3_A_I1_WTM           (0x04)
+#define LSM303DLHC_CTRL3_A_I1_OVERRUN       (0x02)
 #define LSM303DLHC_CTRL3_A_I1_NONE          (0x00)
 /** @} */
 
@@ -113,6 +121,17 @@ extern "C" {
 #define LSM303DLHC_REG_CTRL5_A_FIFO_EN  (0x40)
 /** @} */
 
+/**
+ * @name Masks for the LSM303DLHC FIFO_CTRL_REG_A and FIFO_SRC_REG_A registers
+ * @{
+ */
+#define LSM303DLHC_FIFO_A_MODE_BYPASS   (0x00)
+#define LSM303DLHC_FIFO_A_MODE_STREAM   (0x80)
+#define LSM303DLHC_FIFO_A_FTH_MASK      (0x1f)
+#define LSM303DLHC_FIFO_A_SRC_OVRN      (0x40)
+#define LSM303DLHC_FIFO_A_SRC_FSS_MASK  (0x1f)
+/** @} */
+
 /**
  * @name LSM303DLHC magnetometer registers
  * @{
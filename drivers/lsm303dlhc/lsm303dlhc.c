@@ -92,42 +92,39 @@ int lsm303dlhc_init(lsm303dlhc_t *dev, i2c_t i2c, gpio_t acc_pin, gpio_t mag_pin
     return (res < 7) ? -1 : 0;
 }
 
+/* read num accelerometer values in one transfer, the bus must be acquired */
+static int read_acc_values(lsm303dlhc_t *dev, lsm303dlhc_3d_data_t *data,
+                           unsigned num)
+{
+    int len = num * sizeof(lsm303dlhc_3d_data_t);
+    uint8_t *raw = (uint8_t *)data;
+    int16_t *val = (int16_t *)data;
+
+    /* with the FIFO enabled, the address wraps from OUT_Z_H to OUT_X_L */
+    if (i2c_read_regs(dev->i2c, dev->acc_address,
+                      LSM303DLHC_REG_OUT_X_L_A | LSM303DLHC_AUTOINC_A,
+                      raw, len) < len) {
+        return -1;
+    }
+
+    /* the values are little endian and left aligned, convert in place */
+    for (unsigned i = 0; i < num * 3; i++) {
+        int16_t tmp = (raw[2 * i + 1] << 8) | raw[2 * i];
+        val[i] = tmp >> 4;
+    }
+    return 0;
+}
+
 int lsm303dlhc_read_acc(lsm303dlhc_t *dev, lsm303dlhc_3d_data_t *data)
 {
     int res;
-    uint8_t tmp;
 
+    DEBUG("lsm303dlhc: read acc values ... ");
     i2c_acquire(dev->i2c);
-    i2c_read_reg(dev->i2c, dev->acc_address, LSM303DLHC_REG_STATUS_A, &tmp);
-    DEBUG("lsm303dlhc status: %x\n", tmp);
-    DEBUG("lsm303dlhc: wait for acc values ... ");
-
-    res = i2c_read_reg(dev->i2c, dev->acc_address,
-                       LSM303DLHC_REG_OUT_X_L_A, &tmp);
-    data->x_axis = tmp;
-    res += i2c_read_reg(dev->i2c, dev->acc_address,
-                        LSM303DLHC_REG_OUT_X_H_A, &tmp);
-    data->x_axis |= tmp<<8;
-    res += i2c_read_reg(dev->i2c, dev->acc_address,
-                       LSM303DLHC_REG_OUT_Y_L_A, &tmp);
-    data->y_axis = tmp;
-    res += i2c_read_reg(dev->i2c, dev->acc_address,
-                        LSM303DLHC_REG_OUT_Y_H_A, &tmp);
-    data->y_axis |= tmp<<8;
-    res += i2c_read_reg(dev->i2c, dev->acc_address,
-                       LSM303DLHC_REG_OUT_Z_L_A, &tmp);
-    data->z_axis = tmp;
-    res += i2c_read_reg(dev->i2c, dev->acc_address,
-                        LSM303DLHC_REG_OUT_Z_H_A, &tmp);
-    data->z_axis |= tmp<<8;
+    res = read_acc_values(dev, data, 1);
     i2c_release(dev->i2c);
-    DEBUG("read ... ");
 
-    data->x_axis = data->x_axis>>4;
-    data->y_axis = data->y_axis>>4;
-    data->z_axis = data->z_axis>>4;
-
-    if (res < 6) {
+    if (res < 0) {
         DEBUG("[!!failed!!]\n");
         return -1;
     }
@@ -136,6 +133,62 @@ int lsm303dlhc_read_acc(lsm303dlhc_t *dev, lsm303dlhc_3d_data_t *data)
     return 0;
 }
 
+int lsm303dlhc_set_acc_fifo(lsm303dlhc_t *dev, uint8_t watermark)
+{
+    uint8_t mode = LSM303DLHC_FIFO_A_MODE_BYPASS;
+    uint8_t ctrl5 = 0;
+    uint8_t ctrl3 = LSM303DLHC_CTRL3_A_I1_NONE;
+    int res;
+
+    if (watermark > 0) {
+        mode = LSM303DLHC_FIFO_A_MODE_STREAM |
+               (watermark & LSM303DLHC_FIFO_A_FTH_MASK);
+        ctrl5 = LSM303DLHC_REG_CTRL5_A_FIFO_EN;
+        ctrl3 = LSM303DLHC_CTRL3_A_I1_WTM;
+    }
+
+    i2c_acquire(dev->i2c);
+    res = i2c_write_reg(dev->i2c, dev->acc_address,
+                        LSM303DLHC_REG_FIFO_CTRL_A, mode);
+    res += i2c_write_reg(dev->i2c, dev->acc_address,
+                         LSM303DLHC_REG_CTRL5_A, ctrl5);
+    res += i2c_write_reg(dev->i2c, dev->acc_address,
+                         LSM303DLHC_REG_CTRL3_A, ctrl3);
+    i2c_release(dev->i2c);
+
+    return (res < 3) ? -1 : 0;
+}
+
+int lsm303dlhc_read_acc_fifo(lsm303dlhc_t *dev, lsm303dlhc_3d_data_t *data,
+                             unsigned num)
+{
+    uint8_t src;
+    unsigned level;
+
+    i2c_acquire(dev->i2c);
+    if (i2c_read_reg(dev->i2c, dev->acc_address,
+                     LSM303DLHC_REG_FIFO_SRC_A, &src) < 1) {
+        i2c_release(dev->i2c);
+        return -1;
+    }
+    if (src & LSM303DLHC_FIFO_A_SRC_OVRN) {
+        level = LSM303DLHC_ACC_FIFO_SIZE;
+    }
+    else {
+        level = src & LSM303DLHC_FIFO_A_SRC_FSS_MASK;
+    }
+    if (level > num) {
+        level = num;
+    }
+    if ((level > 0) && (read_acc_values(dev, data, level) < 0)) {
+        i2c_release(dev->i2c);
+        return -1;
+    }
+    i2c_release(dev->i2c);
+
+    return level;
+}
+
 int lsm303dlhc_read_mag(lsm303dlhc_t *dev, lsm303dlhc_3d_data_t *data)
 {
     int res;
@@ -93,6 +93,12 @@
 #define BIT_SLAVE_RW                    (0x80)
 #define BIT_SLAVE_EN                    (0x80)
 #define BIT_DMP_EN                      (0x80)
+#define BIT_FIFO_EN                     (0x40)
+#define BIT_FIFO_RESET                  (0x04)
+#define BIT_FIFO_XG                     (0x40)
+#define BIT_FIFO_YG                     (0x20)
+#define BIT_FIFO_ZG                     (0x10)
+#define BIT_FIFO_ACCEL                  (0x08)
 /** @} */
 
 #ifdef __cplusplus
@@ -47,6 +47,8 @@ static const mpu9150_status_t DEFAULT_STATUS = {
 static int compass_init(mpu9150_t *dev);
 static void conf_bypass(mpu9150_t *dev, uint8_t bypass_enable);
 static void conf_lpf(mpu9150_t *dev, uint16_t rate);
+static int32_t gyro_fsr(const mpu9150_t *dev);
+static int32_t accel_fsr(const mpu9150_t *dev);
 
 /*---------------------------------------------------------------------------*
  *                          MPU9150 Core API                                 *
@@ -246,23 +248,10 @@ int mpu9150_read_gyro(mpu9150_t *dev, mpu9150_results_t *output)
 {
     uint8_t data[6];
     int16_t temp;
-    float fsr;
+    float fsr = gyro_fsr(dev);
 
-    switch (dev->conf.gyro_fsr) {
-        case MPU9150_GYRO_FSR_250DPS:
-            fsr = 250.0;
-            break;
-        case MPU9150_GYRO_FSR_500DPS:
-            fsr = 500.0;
-            break;
-        case MPU9150_GYRO_FSR_1000DPS:
-            fsr = 1000.0;
-            break;
-        case MPU9150_GYRO_FSR_2000DPS:
-            fsr = 2000.0;
-            break;
-        default:
-            return -2;
+    if (fsr == 0) {
+        return -2;
     }
 
     /* Acquire exclusive access */
@@ -289,23 +278,10 @@ int mpu9150_read_accel(mpu9150_t *dev, mpu9150_results_t *output)
 {
     uint8_t data[6];
     int16_t temp;
-    float fsr;
+    float fsr = accel_fsr(dev);
 
-    switch (dev->conf.accel_fsr) {
-        case MPU9150_ACCEL_FSR_2G:
-            fsr = 2000.0;
-            break;
-        case MPU9150_ACCEL_FSR_4G:
-            fsr = 4000.0;
-            break;
-        case MPU9150_ACCEL_FSR_8G:
-            fsr = 8000.0;
-            break;
-        case MPU9150_ACCEL_FSR_16G:
-            fsr = 16000.0;
-            break;
-        default:
-            return -2;
+    if (fsr == 0) {
+        return -2;
     }
 
     /* Acquire exclusive access */
@@ -381,6 +357,83 @@ int mpu9150_read_temperature(mpu9150_t *dev, int32_t *output)
     return 0;
 }
 
+int mpu9150_set_fifo(mpu9150_t *dev, uint8_t enable)
+{
+    uint8_t data;
+
+    /* Acquire exclusive access */
+    if (i2c_acquire(dev->i2c_dev)) {
+        return -1;
+    }
+    /* Keep the I2C master settings for the compass */
+    i2c_read_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG, &data);
+    data &= ~(BIT_FIFO_EN);
+    i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG, data);
+    if (enable) {
+        i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG,
+                      data | BIT_FIFO_RESET);
+        i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_FIFO_EN_REG,
+                      BIT_FIFO_ACCEL | BIT_FIFO_XG | BIT_FIFO_YG | BIT_FIFO_ZG);
+        i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG,
+                      data | BIT_FIFO_EN);
+    }
+    else {
+        i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_FIFO_EN_REG, REG_RESET);
+    }
+    /* Release the bus */
+    i2c_release(dev->i2c_dev);
+
+    return 0;
+}
+
+int mpu9150_read_fifo(mpu9150_t *dev, mpu9150_fifo_sample_t *output,
+                      unsigned num)
+{
+    uint8_t data[2];
+    unsigned count;
+    int32_t fsr[2] = { accel_fsr(dev), gyro_fsr(dev) };
+    int16_t *values = (int16_t *)output;
+    uint8_t *raw = (uint8_t *)output;
+
+    if (fsr[0] == 0 || fsr[1] == 0) {
+        return -2;
+    }
+
+    /* Acquire exclusive access */
+    if (i2c_acquire(dev->i2c_dev)) {
+        return -1;
+    }
+    i2c_read_regs(dev->i2c_dev, dev->hw_addr, MPU9150_FIFO_COUNT_START_REG, data, 2);
+    count = (data[0] << 8) | data[1];
+    if (count >= MPU9150_FIFO_SIZE) {
+        /* Samples were overwritten, so the FIFO is no longer aligned */
+        i2c_read_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG, data);
+        i2c_write_reg(dev->i2c_dev, dev->hw_addr, MPU9150_USER_CTRL_REG,
+                      data[0] | BIT_FIFO_RESET);
+        i2c_release(dev->i2c_dev);
+        return -3;
+    }
+    count /= sizeof(mpu9150_fifo_sample_t);
+    if (count > num) {
+        count = num;
+    }
+    /* Burst reads of the FIFO register return consecutive FIFO bytes */
+    if (count > 0) {
+        i2c_read_regs(dev->i2c_dev, dev->hw_addr, MPU9150_FIFO_RW_REG, raw,
+                      count * sizeof(mpu9150_fifo_sample_t));
+    }
+    /* Release the bus */
+    i2c_release(dev->i2c_dev);
+
+    /* Normalize data in place, accel and gyro alternate every 3 values */
+    for (unsigned i = 0; i < count * 6; i++) {
+        int16_t temp = (raw[2 * i] << 8) | raw[2 * i + 1];
+        values[i] = (temp * fsr[(i / 3) & 1]) / MAX_VALUE;
+    }
+
+    return count;
+}
+
 int mpu9150_set_gyro_fsr(mpu9150_t *dev, mpu9150_gyro_ranges_t fsr)
 {
     if (dev->conf.gyro_fsr == fsr) {
@@ -586,6 +639,44 @@ static void conf_bypass(mpu9150_t *dev, uint8_t bypass_enable)
    }
 }
 
+/**
+ * Get the configured gyro full-scale range in dps, 0 if invalid
+ */
+static int32_t gyro_fsr(const mpu9150_t *dev)
+{
+    switch (dev->conf.gyro_fsr) {
+        case MPU9150_GYRO_FSR_250DPS:
+            return 250;
+        case MPU9150_GYRO_FSR_500DPS:
+            return 500;
+        case MPU9150_GYRO_FSR_1000DPS:
+            return 1000;
+        case MPU9150_GYRO_FSR_2000DPS:
+            return 2000;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Get the configured accel full-scale range in mG, 0 if invalid
+ */
+static int32_t accel_fsr(const mpu9150_t *dev)
+{
+    switch (dev->conf.accel_fsr) {
+        case MPU9150_ACCEL_FSR_2G:
+            return 2000;
+        case MPU9150_ACCEL_FSR_4G:
+            return 4000;
+        case MPU9150_ACCEL_FSR_8G:
+            return 8000;
+        case MPU9150_ACCEL_FSR_16G:
+            return 16000;
+        default:
+            return 0;
+    }
+}
+
 /**
  * Configure low pass filter
  * Caution: This internal function does not acquire exclusive access to the I2C bus.
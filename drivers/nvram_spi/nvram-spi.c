@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 #include "nvram.h"
 #include "nvram-spi.h"
 #include "byteorder.h"
@@ -34,85 +35,35 @@ typedef enum {
     NVRAM_SPI_CMD_WRITE = 0x02,
     /** READ command byte, 0b0000 0011 */
     NVRAM_SPI_CMD_READ = 0x03,
+    /** RDSR command byte, 0b0000 0101 */
+    NVRAM_SPI_CMD_RDSR = 0x05,
     /** WREN command byte, 0b0000 0110 */
     NVRAM_SPI_CMD_WREN = 0x06,
 } nvram_spi_commands_t;
 
+/** @brief Write-in-progress bit of the status register */
+#define NVRAM_SPI_STATUS_WIP    (0x01)
+
 /** @brief Delay to wait between toggling CS pin, on most chips this can probably be
  * removed. */
 #define NVRAM_SPI_CS_TOGGLE_TICKS xtimer_ticks_from_usec(1)
 
-/**
- * @brief Copy data from system memory to NVRAM.
- *
- * @param[in]  dev   Pointer to NVRAM device descriptor
- * @param[in]  src   Pointer to the first byte in the system memory address space
- * @param[in]  dst   Starting address in the NVRAM device address space
- * @param[in]  len   Number of bytes to copy
- *
- * @return           Number of bytes written on success
- * @return           <0 on errors
- */
 static int nvram_spi_write(nvram_t *dev, const uint8_t *src, uint32_t dst, size_t len);
-
-/**
- * @brief Copy data from NVRAM to system memory.
- *
- * @param[in]  dev   Pointer to NVRAM device descriptor
- * @param[out] dst   Pointer to the first byte in the system memory address space
- * @param[in]  src   Starting address in the NVRAM device address space
- * @param[in]  len   Number of bytes to copy
- *
- * @return           Number of bytes read on success
- * @return           <0 on errors
- */
 static int nvram_spi_read(nvram_t *dev, uint8_t *dst, uint32_t src, size_t len);
-
-/**
- * @brief Copy data from system memory to NVRAM.
- *
- * This is a special form of the WRITE command used by some Ramtron/Cypress
- * 4Kbit FRAM devices which puts the 9th address bit inside the command byte to
- * be able to use one byte for addressing instead of two.
- *
- * @param[in]  dev   Pointer to NVRAM device descriptor
- * @param[in]  src   Pointer to the first byte in the system memory address space
- * @param[in]  dst   Starting address in the NVRAM device address space
- * @param[in]  len   Number of bytes to copy
- *
- * @return           Number of bytes written on success
- * @return           <0 on errors
- */
-static int nvram_spi_write_9bit_addr(nvram_t *dev, const uint8_t *src, uint32_t dst, size_t len);
-
-/**
- * @brief Copy data from NVRAM to system memory.
- *
- * This is a special form of the READ command used by some Ramtron/Cypress 4Kbit
- * FRAM devices which puts the 9th address bit inside the command byte to be
- * able to use one byte for addressing instead of two.
- *
- * @param[in]  dev   Pointer to NVRAM device descriptor
- * @param[out] dst   Pointer to the first byte in the system memory address space
- * @param[in]  src   Starting address in the NVRAM device address space
- * @param[in]  len   Number of bytes to copy
- *
- * @return           Number of bytes read on success
- * @return           <0 on errors
- */
-static int nvram_spi_read_9bit_addr(nvram_t *dev, uint8_t *dst, uint32_t src, size_t len);
+static int nvram_spi_writev(nvram_t *dev, const struct iovec *vec,
+                            unsigned count, uint32_t dst);
+static int nvram_spi_readv(nvram_t *dev, const struct iovec *vec,
+                           unsigned count, uint32_t src);
 
 int nvram_spi_init(nvram_t *dev, nvram_spi_params_t *spi_params, size_t size)
 {
     dev->size = size;
-    if (size > 0x100 && spi_params->address_count == 1) {
-        dev->write = nvram_spi_write_9bit_addr;
-        dev->read = nvram_spi_read_9bit_addr;
-    } else {
-        dev->write = nvram_spi_write;
-        dev->read = nvram_spi_read;
-    }
+    dev->write = nvram_spi_write;
+    dev->read = nvram_spi_read;
+    dev->writev = nvram_spi_writev;
+    dev->readv = nvram_spi_readv;
     dev->extra = spi_params;
+    spi_params->cache_len = 0;
 
     gpio_init(spi_params->cs, GPIO_OUT);
     gpio_set(spi_params->cs);
@@ -120,166 +71,235 @@ int nvram_spi_init(nvram_t *dev, nvram_spi_params_t *spi_params, size_t size)
     return 0;
 }
 
-static int nvram_spi_write(nvram_t *dev, const uint8_t *src, uint32_t dst, size_t len)
+static size_t _iov_len(const struct iovec *vec, unsigned count)
+{
+    size_t len = 0;
+
+    for (unsigned i = 0; i < count; i++) {
+        len += vec[i].iov_len;
+    }
+    return len;
+}
+
+/**
+ * @brief Assert CS and send a command with its address
+ */
+static int _cmd(nvram_spi_params_t *spi_dev, uint8_t cmd, uint32_t addr)
 {
-    nvram_spi_params_t *spi_dev = (nvram_spi_params_t *) dev->extra;
-    int status;
     union {
         uint32_t u32;
         char c[4];
-    } addr;
-    /* Address is expected by the device as big-endian, i.e. network byte order,
-     * we utilize the network byte order macros here. */
-    addr.u32 = HTONL(dst);
-    /* Acquire exclusive bus access */
-    spi_acquire(spi_dev->spi);
-    /* Assert CS */
-    gpio_clear(spi_dev->cs);
-    /* Enable writes */
-    status = spi_transfer_byte(spi_dev->spi, NVRAM_SPI_CMD_WREN, NULL);
-    if (status < 0)
-    {
-        return status;
-    }
-    /* Release CS */
-    gpio_set(spi_dev->cs);
-    xtimer_spin(NVRAM_SPI_CS_TOGGLE_TICKS);
-    /* Re-assert CS */
+    } buf;
+
     gpio_clear(spi_dev->cs);
-    /* Write command and address */
-    status = spi_transfer_regs(spi_dev->spi, NVRAM_SPI_CMD_WRITE,
-                      &addr.c[sizeof(addr.c) - spi_dev->address_count], NULL,
-                      spi_dev->address_count);
-    if (status < 0)
-    {
-        return status;
+    if (spi_dev->address_count == 1) {
+        /* The upper address bit is mixed into the command byte on certain
+         * 4 Kbit devices, probably just to save a byte in the SPI transfer
+         * protocol. */
+        if (addr > 0xff) {
+            cmd |= 0x08;
+        }
+        return spi_transfer_reg(spi_dev->spi, cmd, (char)(addr & 0xff), NULL);
     }
-    /* Keep holding CS and write data */
-    status = spi_transfer_bytes(spi_dev->spi, (char *)src, NULL, len);
-    if (status < 0)
-    {
-        return status;
+    /* Address is expected by the device as big-endian, i.e. network byte
+     * order, we utilize the network byte order macros here. */
+    buf.u32 = HTONL(addr);
+    return spi_transfer_regs(spi_dev->spi, cmd,
+                             &buf.c[sizeof(buf.c) - spi_dev->address_count],
+                             NULL, spi_dev->address_count);
+}
+
+/**
+ * @brief Wait for the write cycle of an EEPROM to finish
+ */
+static int _wait_ready(nvram_spi_params_t *spi_dev)
+{
+    char status;
+    int res;
+
+    do {
+        gpio_clear(spi_dev->cs);
+        res = spi_transfer_reg(spi_dev->spi, NVRAM_SPI_CMD_RDSR, 0, &status);
+        gpio_set(spi_dev->cs);
+    } while ((res >= 0) && (status & NVRAM_SPI_STATUS_WIP));
+    return res;
+}
+
+/**
+ * @brief Write the buffers of vec to the device, one access per page
+ */
+static int _writev(nvram_spi_params_t *spi_dev, const struct iovec *vec,
+                   unsigned count, uint32_t dst)
+{
+    size_t total = _iov_len(vec, count);
+    size_t done = 0, off = 0;
+    unsigned i = 0;
+    int status = 0;
+
+    /* Acquire exclusive bus access */
+    spi_acquire(spi_dev->spi);
+    while (done < total) {
+        size_t chunk = total - done;
+        uint32_t addr = dst + done;
+
+        if (spi_dev->page_size) {
+            size_t page_left = spi_dev->page_size - (addr % spi_dev->page_size);
+            chunk = (chunk < page_left) ? chunk : page_left;
+        }
+
+        /* Enable writes */
+        gpio_clear(spi_dev->cs);
+        status = spi_transfer_byte(spi_dev->spi, NVRAM_SPI_CMD_WREN, NULL);
+        gpio_set(spi_dev->cs);
+        if (status < 0) {
+            break;
+        }
+        xtimer_spin(NVRAM_SPI_CS_TOGGLE_TICKS);
+        /* Write command and address */
+        status = _cmd(spi_dev, NVRAM_SPI_CMD_WRITE, addr);
+        /* Keep holding CS and stream the data of this page */
+        for (size_t left = chunk; (status >= 0) && left; ) {
+            size_t n;
+
+            while (off == vec[i].iov_len) {
+                i++;
+                off = 0;
+            }
+            n = vec[i].iov_len - off;
+            n = (n < left) ? n : left;
+            status = spi_transfer_bytes(spi_dev->spi,
+                                        (char *)vec[i].iov_base + off, NULL, n);
+            off += n;
+            left -= n;
+        }
+        /* Release CS, this starts the write cycle of EEPROMs */
+        gpio_set(spi_dev->cs);
+        if ((status >= 0) && spi_dev->page_size) {
+            status = _wait_ready(spi_dev);
+        }
+        if (status < 0) {
+            break;
+        }
+        done += chunk;
     }
-    /* Release CS */
-    gpio_set(spi_dev->cs);
     /* Release exclusive bus access */
     spi_release(spi_dev->spi);
-    return status;
+    return (status < 0) ? status : (int)total;
 }
 
-static int nvram_spi_read(nvram_t *dev, uint8_t *dst, uint32_t src, size_t len)
+/**
+ * @brief Read the device into the buffers of vec in a single access
+ */
+static int _readv(nvram_spi_params_t *spi_dev, const struct iovec *vec,
+                  unsigned count, uint32_t src)
 {
-    nvram_spi_params_t *spi_dev = (nvram_spi_params_t *) dev->extra;
     int status;
-    union {
-        uint32_t u32;
-        char c[4];
-    } addr;
-    /* Address is expected by the device as big-endian, i.e. network byte order,
-     * we utilize the network byte order macros here. */
-    addr.u32 = HTONL(src);
+
     /* Acquire exclusive bus access */
     spi_acquire(spi_dev->spi);
-    /* Assert CS */
-    gpio_clear(spi_dev->cs);
     /* Write command and address */
-    status = spi_transfer_regs(spi_dev->spi, NVRAM_SPI_CMD_READ,
-                               &addr.c[sizeof(addr.c) - spi_dev->address_count],
-                               NULL, spi_dev->address_count);
-    if (status < 0)
-    {
-        return status;
-    }
-    /* Keep holding CS and read data */
-    status = spi_transfer_bytes(spi_dev->spi, NULL, (char *)dst, len);
-    if (status < 0)
-    {
-        return status;
+    status = _cmd(spi_dev, NVRAM_SPI_CMD_READ, src);
+    /* Keep holding CS and read data, the address auto-increments across
+     * pages */
+    for (unsigned i = 0; (status >= 0) && (i < count); i++) {
+        if (vec[i].iov_len) {
+            status = spi_transfer_bytes(spi_dev->spi, NULL, vec[i].iov_base,
+                                        vec[i].iov_len);
+        }
     }
     /* Release CS */
     gpio_set(spi_dev->cs);
     /* Release exclusive bus access */
     spi_release(spi_dev->spi);
-    /* status contains the number of bytes actually read from the SPI bus. */
-    return status;
+    return (status < 0) ? status : (int)_iov_len(vec, count);
 }
 
-
-static int nvram_spi_write_9bit_addr(nvram_t *dev, const uint8_t *src, uint32_t dst, size_t len)
+int nvram_spi_flush(nvram_t *dev)
 {
     nvram_spi_params_t *spi_dev = (nvram_spi_params_t *) dev->extra;
+    struct iovec vec = {
+        .iov_base = spi_dev->cache,
+        .iov_len = spi_dev->cache_len,
+    };
     int status;
-    uint8_t cmd;
-    uint8_t addr;
-    cmd = NVRAM_SPI_CMD_WRITE;
-    /* The upper address bit is mixed into the command byte on certain devices,
-     * probably just to save a byte in the SPI transfer protocol. */
-    if (dst > 0xff) {
-        cmd |= 0x08;
-    }
-    /* LSB of address */
-    addr = (dst & 0xff);
-    spi_acquire(spi_dev->spi);
-    gpio_clear(spi_dev->cs);
-    /* Enable writes */
-    status = spi_transfer_byte(spi_dev->spi, NVRAM_SPI_CMD_WREN, NULL);
-    if (status < 0)
-    {
-        return status;
-    }
-    gpio_set(spi_dev->cs);
-    xtimer_spin(NVRAM_SPI_CS_TOGGLE_TICKS);
-    gpio_clear(spi_dev->cs);
-    /* Write command and address */
-    status = spi_transfer_reg(spi_dev->spi, cmd, addr, NULL);
-    if (status < 0)
-    {
-        return status;
+
+    if (spi_dev->cache_len == 0) {
+        return 0;
     }
-    /* Keep holding CS and write data */
-    status = spi_transfer_bytes(spi_dev->spi, (char *)src, NULL, len);
-    if (status < 0)
-    {
+    status = _writev(spi_dev, &vec, 1, spi_dev->cache_addr);
+    if (status < 0) {
         return status;
     }
-    gpio_set(spi_dev->cs);
-    spi_release(spi_dev->spi);
-    /* status contains the number of bytes actually written to the SPI bus. */
-    return status;
+    spi_dev->cache_len = 0;
+    return 0;
 }
 
-static int nvram_spi_read_9bit_addr(nvram_t *dev, uint8_t *dst, uint32_t src, size_t len)
+static int nvram_spi_writev(nvram_t *dev, const struct iovec *vec,
+                            unsigned count, uint32_t dst)
 {
     nvram_spi_params_t *spi_dev = (nvram_spi_params_t *) dev->extra;
+    size_t len = _iov_len(vec, count);
     int status;
-    uint8_t cmd;
-    uint8_t addr;
-    cmd = NVRAM_SPI_CMD_READ;
-    /* The upper address bit is mixed into the command byte on certain devices,
-     * probably just to save a byte in the SPI transfer protocol. */
-    if (src > 0xff) {
-        cmd |= 0x08;
+
+    if (spi_dev->cache && (len <= spi_dev->cache_size)) {
+        uint32_t end = spi_dev->cache_addr + spi_dev->cache_len;
+
+        /* start over unless the write extends or overwrites the data in the
+         * cache */
+        if ((spi_dev->cache_len == 0) || (dst < spi_dev->cache_addr) ||
+            (dst > end) ||
+            (dst + len > spi_dev->cache_addr + spi_dev->cache_size)) {
+            if ((status = nvram_spi_flush(dev)) < 0) {
+                return status;
+            }
+            spi_dev->cache_addr = dst;
+        }
+        uint8_t *pos = spi_dev->cache + (dst - spi_dev->cache_addr);
+        for (unsigned i = 0; i < count; i++) {
+            memcpy(pos, vec[i].iov_base, vec[i].iov_len);
+            pos += vec[i].iov_len;
+        }
+        if (pos - spi_dev->cache > spi_dev->cache_len) {
+            spi_dev->cache_len = pos - spi_dev->cache;
+        }
+        return len;
     }
-    /* LSB of address */
-    addr = (src & 0xff);
-    spi_acquire(spi_dev->spi);
-    gpio_clear(spi_dev->cs);
-    /* Write command and address */
-    status = spi_transfer_reg(spi_dev->spi, (char)cmd, addr, NULL);
-    if (status < 0)
-    {
+
+    /* the cached data is older than this write */
+    if ((status = nvram_spi_flush(dev)) < 0) {
         return status;
     }
-    /* Keep holding CS and read data */
-    status = spi_transfer_bytes(spi_dev->spi, NULL, (char *)dst, len);
-    if (status < 0)
-    {
-        return status;
+    return _writev(spi_dev, vec, count, dst);
+}
+
+static int nvram_spi_readv(nvram_t *dev, const struct iovec *vec,
+                           unsigned count, uint32_t src)
+{
+    nvram_spi_params_t *spi_dev = (nvram_spi_params_t *) dev->extra;
+    size_t len = _iov_len(vec, count);
+    int status;
+
+    if (spi_dev->cache_len && (src < spi_dev->cache_addr + spi_dev->cache_len) &&
+        (src + len > spi_dev->cache_addr)) {
+        if ((status = nvram_spi_flush(dev)) < 0) {
+            return status;
+        }
     }
-    gpio_set(spi_dev->cs);
-    spi_release(spi_dev->spi);
-    /* status contains the number of bytes actually read from the SPI bus. */
-    return status;
+    return _readv(spi_dev, vec, count, src);
+}
+
+static int nvram_spi_write(nvram_t *dev, const uint8_t *src, uint32_t dst, size_t len)
+{
+    struct iovec vec = { .iov_base = (void *)src, .iov_len = len };
+
+    return nvram_spi_writev(dev, &vec, 1, dst);
+}
+
+static int nvram_spi_read(nvram_t *dev, uint8_t *dst, uint32_t src, size_t len)
+{
+    struct iovec vec = { .iov_base = dst, .iov_len = len };
+
+    return nvram_spi_readv(dev, &vec, 1, src);
 }
 
 /** @} */
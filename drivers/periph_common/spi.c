@@ -52,6 +52,13 @@ int spi_transfer_bytes(spi_t dev, char *out, char *in, unsigned int length)
 }
 #endif
 
+#ifndef PERIPH_SPI_HAS_DMA
+int spi_transfer_bytes_dma(spi_t dev, char *out, char *in, unsigned int length)
+{
+    return spi_transfer_bytes(dev, out, in, length);
+}
+#endif
+
 #ifdef PERIPH_SPI_NEEDS_TRANSFER_BYTE
 int spi_transfer_byte(spi_t dev, char out, char *in)
 {
@@ -95,4 +102,20 @@ int spi_transfer_regs(spi_t dev, uint8_t reg, char *out, char *in, unsigned int
 }
 #endif
 
+int spi_transfer_reg_batch(spi_t dev, const spi_reg_op_t *ops, unsigned int num)
+{
+    int trans_bytes = 0;
+
+    for (unsigned int i = 0; i < num; i++) {
+        int trans_ret = spi_transfer_regs(dev, ops[i].reg, ops[i].out,
+                                          ops[i].in, ops[i].length);
+        if (trans_ret < 0) {
+            return -1;
+        }
+        trans_bytes += trans_ret + 1;
+    }
+
+    return trans_bytes;
+}
+
 #endif /* SPI_NUMOF */
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup drivers
+ * @{
+ *
+ * @file
+ * @brief       common UART function fallback implementations
+ *
+ * @}
+ */
+
+#include "board.h"
+#include "cpu.h"
+#include "periph/uart.h"
+#include "periph_cpu.h"
+
+#if defined(UART_NUMOF) && !defined(PERIPH_UART_HAS_RX_BLOCK)
+
+typedef struct {
+    uart_rx_block_cb_t rx_cb;
+    void *arg;
+} uart_block_ctx_t;
+
+static uart_block_ctx_t block_ctx[UART_NUMOF];
+
+static void _rx_byte(void *arg, uint8_t data)
+{
+    uart_block_ctx_t *ctx = arg;
+
+    ctx->rx_cb(ctx->arg, &data, 1);
+}
+
+int uart_init_block(uart_t uart, uint32_t baudrate, uart_rx_block_cb_t rx_cb,
+                    void *arg)
+{
+    if (uart >= UART_NUMOF) {
+        return UART_NODEV;
+    }
+    block_ctx[uart].rx_cb = rx_cb;
+    block_ctx[uart].arg = arg;
+    return uart_init(uart, baudrate, _rx_byte, &block_ctx[uart]);
+}
+
+#endif
+
+#if defined(UART_NUMOF) && \
+    (!defined(MODULE_PERIPH_UART_NONBLOCKING) || \
+     !defined(PERIPH_UART_HAS_NONBLOCKING))
+void uart_flush(uart_t uart)
+{
+    /* uart_write() returns when the data was sent */
+    (void)uart;
+}
+#endif
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_w5100
+ * @{
+ *
+ * @file
+ * @brief       Register access shared by the W5100 netdev2 driver and the
+ *              sock backend
+ */
+
+#ifndef W5100_INTERNAL_H
+#define W5100_INTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "w5100.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Read a single register
+ */
+uint8_t w5100_rreg(w5100_t *dev, uint16_t reg);
+
+/**
+ * @brief   Read a 16-bit value from two registers
+ */
+uint16_t w5100_raddr(w5100_t *dev, uint16_t addr_high, uint16_t addr_low);
+
+/**
+ * @brief   Read @p len bytes starting at @p addr
+ */
+void w5100_rchunk(w5100_t *dev, uint16_t addr, uint8_t *data, size_t len);
+
+/**
+ * @brief   Write a single register
+ */
+void w5100_wreg(w5100_t *dev, uint16_t reg, uint8_t data);
+
+/**
+ * @brief   Write a 16-bit value to two registers
+ */
+void w5100_waddr(w5100_t *dev,
+                 uint16_t addr_high, uint16_t addr_low, uint16_t val);
+
+/**
+ * @brief   Write @p len bytes starting at @p addr
+ */
+void w5100_wchunk(w5100_t *dev, uint16_t addr, uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* W5100_INTERNAL_H */
+/** @} */
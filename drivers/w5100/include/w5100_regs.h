@@ -75,12 +75,16 @@ extern "C" {
 /**
  * @brief   Socket 0 registers
  *
- * As we are using the device in MACRAW mode, we only need socket 0.
+ * The netdev2 driver uses socket 0 in MACRAW mode, the sock backend all
+ * sockets. The registers of socket n are at an offset of
+ * @ref SOCK_REG_OFFSET(n).
  */
 #define S0_MR               (0x0400)    /**< mode */
 #define S0_CR               (0x0401)    /**< control */
 #define S0_IR               (0x0402)    /**< interrupt flags */
 #define S0_SR               (0x0403)    /**< state */
+#define S0_PORT0            (0x0404)    /**< source port 0 */
+#define S0_PORT1            (0x0405)    /**< source port 1 */
 #define S0_DHAR0            (0x0406)    /**< destination hardware address 0 */
 #define S0_DHAR1            (0x0407)    /**< destination hardware address 1 */
 #define S0_DHAR2            (0x0408)    /**< destination hardware address 2 */
@@ -108,6 +112,8 @@ extern "C" {
 #define S0_RX_RSR1          (0x0427)    /**< RX receive size 1 */
 #define S0_RX_RD0           (0x0428)    /**< RX read pointer 0 */
 #define S0_RX_RD1           (0x0429)    /**< RX read pointer 1 */
+
+#define SOCK_REG_OFFSET(n)  ((n) << 8)  /**< offset of socket n registers */
 /** @} */
 
 /**
@@ -117,6 +123,8 @@ extern "C" {
 
 #define RMSR_8KB_TO_S0      (0x03)      /**< receive memory size: 8kib */
 #define TMSR_8KB_TO_S0      (0x03)      /**< transmit memory size: 8kib */
+#define RMSR_2KB_EACH       (0x55)      /**< receive memory size: 2kib each */
+#define TMSR_2KB_EACH       (0x55)      /**< transmit memory size: 2kib each */
 
 #define IMR_S0_INT          (0x01)      /**< global socket 0 interrupt mask */
 
@@ -125,11 +133,16 @@ extern "C" {
 
 #define CR_OPEN             (0x01)      /**< socket command: open */
 #define CR_CLOSE            (0x10)      /**< socket command: close */
+#define CR_SEND             (0x20)      /**< socket command: send */
 #define CR_SEND_MAC         (0x21)      /**< socket command: send raw */
 #define CR_RECV             (0x40)      /**< socket command: receive new data */
 
 #define IR_SEND_OK          (0x10)      /**< socket interrupt: send ok */
+#define IR_TIMEOUT          (0x08)      /**< socket interrupt: ARP timed out */
 #define IR_RECV             (0x04)      /**< socket interrupt: data received */
+
+#define SR_CLOSED           (0x00)      /**< socket state: closed */
+#define SR_UDP              (0x22)      /**< socket state: UDP mode */
 /** @} */
 
 #ifdef __cplusplus
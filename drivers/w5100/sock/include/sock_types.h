@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_w5100_sock  W5100 implementation of the sock API
+ * @ingroup     drivers_w5100
+ * @brief       Provides @ref net_sock_udp by the hardware TCP/IP stack of
+ *              @ref drivers_w5100 devices
+ *
+ * Each sock occupies one of the @ref W5100_SOCK_NUMOF hardware sockets from
+ * sock_udp_create() to sock_udp_close(). Sending with a `NULL` sock needs a
+ * free hardware socket for the duration of the call. Only IPv4 is
+ * supported.
+ *
+ * Received datagrams stay in the memory of the device until they are read,
+ * so sock_udp_recv_buf() is not supported.
+ *
+ * @{
+ *
+ * @file
+ * @brief   W5100-specific types
+ */
+#ifndef SOCK_TYPES_H_
+#define SOCK_TYPES_H_
+
+#include <stdint.h>
+
+#include "mutex.h"
+#include "net/sock/udp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   UDP sock type
+ * @internal
+ */
+struct sock_udp {
+    sock_udp_ep_t local;                /**< local end-point */
+    sock_udp_ep_t remote;               /**< remote end-point */
+    uint16_t flags;                     /**< option flags */
+    uint8_t num;                        /**< hardware socket */
+    mutex_t irq;                        /**< unlocked on device interrupts */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SOCK_TYPES_H_ */
+/** @} */
@@ -0,0 +1,478 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_w5100_sock
+ * @{
+ *
+ * @file
+ * @brief       W5100 implementation of @ref net_sock_udp
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "random.h"
+#include "xtimer.h"
+#include "net/af.h"
+#include "net/sock/udp.h"
+
+#include "w5100.h"
+#include "w5100_regs.h"
+#include "w5100_internal.h"
+
+#define ENABLE_DEBUG        (0)
+#include "debug.h"
+
+#define SOCK_MEMSIZE        (0x0800)
+#define SOCK_MASK           (SOCK_MEMSIZE - 1)
+#define SOCK_TX_BASE(n)     (0x4000 + ((n) * SOCK_MEMSIZE))
+#define SOCK_RX_BASE(n)     (0x6000 + ((n) * SOCK_MEMSIZE))
+#define SREG(n, reg)        ((reg) + SOCK_REG_OFFSET(n))
+
+/* start of the IANA dynamic port range */
+#define SOCK_PORT_MIN       (49152U)
+
+/* the device puts the peer address, port and length before each datagram */
+#define UDP_INFO_LEN        (8U)
+
+static w5100_t *_dev = NULL;
+static mutex_t _lock = MUTEX_INIT;
+static sock_udp_t *_socks[W5100_SOCK_NUMOF];
+
+static void _event_cb(netdev2_t *netdev, netdev2_event_t event)
+{
+    (void)netdev;
+    (void)event;
+
+    /* we can't ask the device from the ISR which socket caused the interrupt,
+     * so all socks check their hardware socket themselves */
+    for (unsigned i = 0; i < W5100_SOCK_NUMOF; i++) {
+        if (_socks[i] != NULL) {
+            mutex_unlock(&_socks[i]->irq);
+        }
+    }
+}
+
+static void _cmd(uint8_t num, uint8_t cmd)
+{
+    w5100_wreg(_dev, SREG(num, S0_CR), cmd);
+    /* the device clears the command register once it took the command */
+    while (w5100_rreg(_dev, SREG(num, S0_CR))) {}
+}
+
+static void _irq_enable(uint8_t num, bool enable)
+{
+    uint8_t imr = w5100_rreg(_dev, REG_IMR);
+
+    if (enable) {
+        imr |= (IMR_S0_INT << num);
+    }
+    else {
+        imr &= ~(IMR_S0_INT << num);
+    }
+    w5100_wreg(_dev, REG_IMR, imr);
+}
+
+static bool _port_used(uint16_t port)
+{
+    for (unsigned i = 0; i < W5100_SOCK_NUMOF; i++) {
+        if ((_socks[i] != NULL) && (_socks[i]->local.port == port)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint16_t _dyn_port(void)
+{
+    uint16_t port;
+
+    do {
+        port = SOCK_PORT_MIN +
+               (random_uint32() % ((UINT16_MAX + 1) - SOCK_PORT_MIN));
+    } while (_port_used(port));
+    return port;
+}
+
+static int _open(uint8_t num, uint16_t port)
+{
+    w5100_wreg(_dev, SREG(num, S0_MR), MR_UDP);
+    w5100_waddr(_dev, SREG(num, S0_PORT0), SREG(num, S0_PORT1), port);
+    _cmd(num, CR_OPEN);
+    return (w5100_rreg(_dev, SREG(num, S0_SR)) == SR_UDP) ? 0 : -ENOMEM;
+}
+
+static void _close(uint8_t num)
+{
+    _cmd(num, CR_CLOSE);
+    w5100_wreg(_dev, SREG(num, S0_IR), 0xff);
+}
+
+static void _rx_read(uint8_t num, uint16_t ptr, uint8_t *data, size_t len)
+{
+    /* the RX memory of each socket is a ring buffer */
+    for (size_t i = 0; i < len; i++) {
+        data[i] = w5100_rreg(_dev, SOCK_RX_BASE(num) + ((ptr++) & SOCK_MASK));
+    }
+}
+
+/* reads the next datagram of sock, -EAGAIN if there is none */
+static ssize_t _read(sock_udp_t *sock, uint8_t *data, size_t max_len,
+                     sock_udp_ep_t *remote)
+{
+    uint8_t num = sock->num;
+    uint8_t info[UDP_INFO_LEN];
+    uint16_t rd, port, len;
+    ssize_t res;
+
+    /* clear the flag before looking for data, so the interrupt of a datagram
+     * arriving meanwhile is not lost */
+    w5100_wreg(_dev, SREG(num, S0_IR), IR_RECV);
+    if (w5100_raddr(_dev, SREG(num, S0_RX_RSR0), SREG(num, S0_RX_RSR1)) == 0) {
+        return -EAGAIN;
+    }
+
+    rd = w5100_raddr(_dev, SREG(num, S0_RX_RD0), SREG(num, S0_RX_RD1));
+    _rx_read(num, rd, info, sizeof(info));
+    port = (info[4] << 8) | info[5];
+    len = (info[6] << 8) | info[7];
+    DEBUG("w5100_sock: got %u byte on socket %u\n", (unsigned)len,
+          (unsigned)num);
+
+    if ((sock->remote.family != AF_UNSPEC) &&
+        ((memcmp(info, sock->remote.addr.ipv4, sizeof(sock->remote.addr.ipv4)) != 0) ||
+         (port != sock->remote.port))) {
+        res = -EPROTO;
+    }
+    else if (len > max_len) {
+        res = -ENOBUFS;
+    }
+    else {
+        _rx_read(num, rd + sizeof(info), data, len);
+        if (remote != NULL) {
+            remote->family = AF_INET;
+            memcpy(remote->addr.ipv4, info, sizeof(remote->addr.ipv4));
+            remote->netif = SOCK_ADDR_ANY_NETIF;
+            remote->port = port;
+        }
+        res = len;
+    }
+
+    /* remove the datagram from the RX memory */
+    w5100_waddr(_dev, SREG(num, S0_RX_RD0), SREG(num, S0_RX_RD1),
+                rd + sizeof(info) + len);
+    _cmd(num, CR_RECV);
+    return res;
+}
+
+static ssize_t _write(uint8_t num, const uint8_t *data, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    uint16_t wr;
+    uint8_t ir;
+
+    /* every send waits for the previous datagram to leave, so all of the TX
+     * memory is free */
+    if (len > SOCK_MEMSIZE) {
+        return -ENOMEM;
+    }
+
+    w5100_wchunk(_dev, SREG(num, S0_DIPR0), (uint8_t *)remote->addr.ipv4,
+                 sizeof(remote->addr.ipv4));
+    w5100_waddr(_dev, SREG(num, S0_DPORT0), SREG(num, S0_DPORT1),
+                remote->port);
+
+    wr = w5100_raddr(_dev, SREG(num, S0_TX_WR0), SREG(num, S0_TX_WR1));
+    for (size_t i = 0; i < len; i++) {
+        w5100_wreg(_dev, SOCK_TX_BASE(num) + ((wr + i) & SOCK_MASK), data[i]);
+    }
+    w5100_waddr(_dev, SREG(num, S0_TX_WR0), SREG(num, S0_TX_WR1), wr + len);
+
+    _cmd(num, CR_SEND);
+    while (!((ir = w5100_rreg(_dev, SREG(num, S0_IR))) & (IR_SEND_OK | IR_TIMEOUT))) {}
+    w5100_wreg(_dev, SREG(num, S0_IR), IR_SEND_OK | IR_TIMEOUT);
+
+    /* a timeout means ARP could not resolve the next hop */
+    return (ir & IR_SEND_OK) ? (ssize_t)len : -EHOSTUNREACH;
+}
+
+int w5100_sock_init(w5100_t *dev, const uint8_t *addr,
+                    const uint8_t *netmask, const uint8_t *gw)
+{
+    /* reset the device and set the MAC address like for netdev2 */
+    int res = dev->nd.driver->init(&dev->nd);
+
+    if (res < 0) {
+        return res;
+    }
+
+    mutex_lock(&_lock);
+    _dev = dev;
+
+    /* replace the MACRAW socket by four sockets with 2kib memory each */
+    _close(0);
+    w5100_wreg(dev, REG_IMR, 0);
+    w5100_wreg(dev, REG_RMSR, RMSR_2KB_EACH);
+    w5100_wreg(dev, REG_TMSR, TMSR_2KB_EACH);
+
+    w5100_wchunk(dev, REG_SIPR0, (uint8_t *)addr, 4);
+    w5100_wchunk(dev, REG_SUB0, (uint8_t *)netmask, 4);
+    w5100_wchunk(dev, REG_GAR0, (uint8_t *)gw, 4);
+
+    dev->nd.event_callback = _event_cb;
+    mutex_unlock(&_lock);
+
+    return 0;
+}
+
+int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
+                    const sock_udp_ep_t *remote, uint16_t flags)
+{
+    int res = -ENOMEM;
+
+    assert(sock != NULL);
+    assert((local == NULL) || (local->port != 0));
+    assert((remote == NULL) || (remote->port != 0));
+    if ((local != NULL) && (remote != NULL) &&
+        (local->netif != SOCK_ADDR_ANY_NETIF) &&
+        (remote->netif != SOCK_ADDR_ANY_NETIF) &&
+        (local->netif != remote->netif)) {
+        return -EINVAL;
+    }
+    if (((local != NULL) && (local->family != AF_INET)) ||
+        ((remote != NULL) && (remote->family != AF_INET))) {
+        return -EAFNOSUPPORT;
+    }
+    if ((remote != NULL) && (remote->addr.ipv4_u32 == 0)) {
+        return -EINVAL;
+    }
+
+    memset(sock, 0, sizeof(sock_udp_t));
+    if (local != NULL) {
+        memcpy(&sock->local, local, sizeof(sock_udp_ep_t));
+    }
+    else {
+        sock->local.family = AF_INET;
+    }
+    if (remote != NULL) {
+        memcpy(&sock->remote, remote, sizeof(sock_udp_ep_t));
+    }
+    sock->flags = flags;
+    /* locked until the next interrupt */
+    mutex_init(&sock->irq);
+    mutex_lock(&sock->irq);
+
+    if (_dev == NULL) {
+        return -ENOMEM;
+    }
+    mutex_lock(&_lock);
+    if ((local != NULL) && !(flags & SOCK_FLAGS_REUSE_EP) &&
+        _port_used(local->port)) {
+        res = -EADDRINUSE;
+    }
+    else {
+        for (uint8_t num = 0; num < W5100_SOCK_NUMOF; num++) {
+            if (_socks[num] == NULL) {
+                uint16_t port = (local != NULL) ? local->port : _dyn_port();
+
+                if ((res = _open(num, port)) == 0) {
+                    sock->num = num;
+                    sock->local.port = port;
+                    _socks[num] = sock;
+                }
+                break;
+            }
+        }
+    }
+    mutex_unlock(&_lock);
+    return res;
+}
+
+void sock_udp_close(sock_udp_t *sock)
+{
+    assert(sock != NULL);
+    mutex_lock(&_lock);
+    if (_socks[sock->num] == sock) {
+        _close(sock->num);
+        _socks[sock->num] = NULL;
+    }
+    mutex_unlock(&_lock);
+}
+
+int sock_udp_get_local(sock_udp_t *sock, sock_udp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+    if (sock->local.family == AF_UNSPEC) {
+        return -EADDRNOTAVAIL;
+    }
+    memcpy(ep, &sock->local, sizeof(sock_udp_ep_t));
+    return 0;
+}
+
+int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+    if (sock->remote.family == AF_UNSPEC) {
+        return -ENOTCONN;
+    }
+    memcpy(ep, &sock->remote, sizeof(sock_udp_ep_t));
+    return 0;
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    uint32_t start = xtimer_now_usec();
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    mutex_lock(&_lock);
+    while (((res = _read(sock, data, max_len, remote)) == -EAGAIN) &&
+           (timeout != 0)) {
+        bool timed_out = false;
+
+        _irq_enable(sock->num, true);
+        mutex_unlock(&_lock);
+        if (timeout == SOCK_NO_TIMEOUT) {
+            mutex_lock(&sock->irq);
+        }
+        else {
+            uint32_t passed = xtimer_now_usec() - start;
+
+            timed_out = (passed >= timeout) ||
+                        (xtimer_mutex_lock_timeout(&sock->irq,
+                                                   timeout - passed) < 0);
+        }
+        mutex_lock(&_lock);
+        _irq_enable(sock->num, false);
+        if (timed_out) {
+            res = -ETIMEDOUT;
+            break;
+        }
+    }
+    mutex_unlock(&_lock);
+    return res;
+}
+
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    (void)timeout;
+    (void)remote;
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    /* datagrams can only be copied out of the device memory */
+    *data = NULL;
+    if (*buf_ctx != NULL) {
+        *buf_ctx = NULL;
+        return 0;
+    }
+    return -ENOMEM;
+}
+
+ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    sock_udp_t tmp;
+    ssize_t res;
+
+    assert((sock != NULL) || (remote != NULL));
+    assert((len == 0) || (data != NULL));
+    if (remote == NULL) {
+        if (sock->remote.family == AF_UNSPEC) {
+            return -ENOTCONN;
+        }
+        remote = &sock->remote;
+    }
+    else if ((remote->family != AF_INET) && (remote->family != AF_UNSPEC)) {
+        return -EAFNOSUPPORT;
+    }
+    if ((remote->port == 0) || (remote->addr.ipv4_u32 == 0)) {
+        return -EINVAL;
+    }
+    if ((sock != NULL) && (sock->local.netif != SOCK_ADDR_ANY_NETIF) &&
+        (remote->netif != SOCK_ADDR_ANY_NETIF) &&
+        (sock->local.netif != remote->netif)) {
+        return -EINVAL;
+    }
+    if (sock == NULL) {
+        /* borrow a hardware socket with a dynamic port */
+        if ((res = sock_udp_create(&tmp, NULL, NULL, 0)) < 0) {
+            return res;
+        }
+        sock = &tmp;
+    }
+
+    mutex_lock(&_lock);
+    res = _write(sock->num, data, len, remote);
+    mutex_unlock(&_lock);
+
+    if (sock == &tmp) {
+        sock_udp_close(&tmp);
+    }
+    return res;
+}
+
+ssize_t sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                            unsigned count, uint32_t timeout)
+{
+    unsigned i = 0;
+
+    assert((sock != NULL) && (msgs != NULL) && (count > 0));
+    while (i < count) {
+        sock_udp_msg_t *msg = &msgs[i];
+        /* only wait for the first message */
+        ssize_t res = sock_udp_recv(sock, msg->data, msg->len,
+                                    (i == 0) ? timeout : 0, msg->remote);
+
+        if (res == -EPROTO) {
+            /* message was from another remote and is dropped */
+            if (i == 0) {
+                return res;
+            }
+            continue;
+        }
+        if (res < 0) {
+            return (i == 0) ? res : (ssize_t)i;
+        }
+        msg->recv_len = res;
+        i++;
+    }
+    return i;
+}
+
+ssize_t sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                            unsigned count)
+{
+    sock_udp_t tmp;
+    ssize_t res = 0;
+    unsigned i;
+
+    assert((msgs != NULL) || (count == 0));
+    if ((sock == NULL) && (count > 0)) {
+        /* send all messages from the same dynamic port */
+        if ((res = sock_udp_create(&tmp, NULL, NULL, 0)) < 0) {
+            return res;
+        }
+        sock = &tmp;
+    }
+    for (i = 0; i < count; i++) {
+        res = sock_udp_send(sock, msgs[i].data, msgs[i].len, msgs[i].remote);
+        if (res < 0) {
+            break;
+        }
+    }
+    if (sock == &tmp) {
+        sock_udp_close(&tmp);
+    }
+    return ((i == 0) && (res < 0)) ? res : (ssize_t)i;
+}
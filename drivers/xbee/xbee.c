@@ -90,6 +90,14 @@ typedef struct {
     uint8_t data_len;       /**< number ob bytes written to @p data */
 } resp_t;
 
+/**
+ * @brief   AT command to send in API frame mode
+ */
+typedef struct {
+    const uint8_t *cmd;     /**< AT command name and parameter */
+    uint8_t size;           /**< length of @p cmd */
+} cmd_t;
+
 
 /*
  * Driver's internal utility functions
@@ -121,25 +129,40 @@ static void isr_resp_timeout(void *arg)
     mutex_unlock(&(dev->resp_lock));
 }
 
-static void _api_at_cmd(xbee_t *dev, uint8_t *cmd, uint8_t size, resp_t *resp)
+static void _api_at_cmds(xbee_t *dev, const cmd_t *cmds, unsigned numof,
+                         resp_t *resps)
 {
-    DEBUG("[xbee] AT_CMD: %s\n", cmd);
+    assert(numof <= XBEE_AT_PIPELINE_LEN);
 
     /* acquire TX lock */
     mutex_lock(&(dev->tx_lock));
-    /* construct API frame */
-    dev->cmd_buf[0] = API_START_DELIMITER;
-    dev->cmd_buf[1] = (size + 2) >> 8;
-    dev->cmd_buf[2] = (size + 2) & 0xff;
-    dev->cmd_buf[3] = API_ID_AT;
-    dev->cmd_buf[4] = 1;             /* use fixed frame id */
-    memcpy(dev->cmd_buf + 5, cmd, size);
-    dev->cmd_buf[size + 5] = _cksum(3, dev->cmd_buf, size + 5);
-
-    /* reset the response data counter */
-    dev->resp_count = 0;
-    /* start send data */
-    uart_write(dev->p.uart, dev->cmd_buf, size + 6);
+
+    /* use fresh frame IDs, so late responses to a timed out command are not
+     * taken for responses to this one */
+    dev->resp_fid += XBEE_AT_PIPELINE_LEN;
+    if ((dev->resp_fid == 0) ||
+        (dev->resp_fid > (256 - XBEE_AT_PIPELINE_LEN))) {
+        dev->resp_fid = 1;
+    }
+    dev->resp_pending = (uint8_t)((1 << numof) - 1);
+
+    /* send all commands back to back, the device answers them in order */
+    for (unsigned i = 0; i < numof; i++) {
+        uint8_t size = cmds[i].size;
+
+        DEBUG("[xbee] AT_CMD: %c%c\n", cmds[i].cmd[0], cmds[i].cmd[1]);
+        assert((size + 6U) <= XBEE_MAX_CMD_LENGTH);
+
+        /* construct API frame */
+        dev->cmd_buf[0] = API_START_DELIMITER;
+        dev->cmd_buf[1] = (size + 2) >> 8;
+        dev->cmd_buf[2] = (size + 2) & 0xff;
+        dev->cmd_buf[3] = API_ID_AT;
+        dev->cmd_buf[4] = dev->resp_fid + i;
+        memcpy(dev->cmd_buf + 5, cmds[i].cmd, size);
+        dev->cmd_buf[size + 5] = _cksum(3, dev->cmd_buf, size + 5);
+        uart_write(dev->p.uart, dev->cmd_buf, size + 6);
+    }
 
     xtimer_ticks64_t sent_time = xtimer_now64();
 
@@ -147,11 +170,12 @@ static void _api_at_cmd(xbee_t *dev, uint8_t *cmd, uint8_t size, resp_t *resp)
 
     resp_timer.callback = isr_resp_timeout;
     resp_timer.arg = dev;
+    resp_timer.target = resp_timer.long_target = 0;
 
     xtimer_set(&resp_timer, RESP_TIMEOUT_USEC);
 
     /* wait for results */
-    while ((dev->resp_limit != dev->resp_count) &&
+    while ((dev->resp_pending != 0) &&
            (xtimer_less(
                 xtimer_diff32_64(xtimer_now64(), sent_time),
                 xtimer_ticks_from_usec(RESP_TIMEOUT_USEC)))) {
@@ -160,23 +184,40 @@ static void _api_at_cmd(xbee_t *dev, uint8_t *cmd, uint8_t size, resp_t *resp)
 
     xtimer_remove(&resp_timer);
 
-    if (dev->resp_limit != dev->resp_count) {
-        DEBUG("[xbee] api_at_cmd: response timeout\n");
-        resp->status = 255;
-        mutex_unlock(&(dev->tx_lock));
+    uint8_t missing = dev->resp_pending;
+    dev->resp_pending = 0;
 
-        return;
-    }
+    /* populate response data structures, the checksums are verified here
+     * instead of in the UART interrupt */
+    for (unsigned i = 0; i < numof; i++) {
+        uint8_t *buf = dev->resp_buf[i];
 
-    /* populate response data structure */
-    resp->status = dev->resp_buf[3];
-    resp->data_len = dev->resp_limit - 5;
-    if (resp->data_len > 0) {
-        memcpy(resp->data, &(dev->resp_buf[4]), resp->data_len);
+        if (missing & (1 << i)) {
+            DEBUG("[xbee] api_at_cmd: response timeout\n");
+            resps[i].status = 255;
+            continue;
+        }
+        if (_cksum(0, buf, dev->resp_len[i]) != API_ID_AT_RESP) {
+            DEBUG("[xbee] api_at_cmd: invalid response checksum\n");
+            resps[i].status = 255;
+            continue;
+        }
+        resps[i].status = buf[3];
+        resps[i].data_len = dev->resp_len[i] - 5;
+        if (resps[i].data_len > 0) {
+            memcpy(resps[i].data, &buf[4], resps[i].data_len);
+        }
     }
     mutex_unlock(&(dev->tx_lock));
 }
 
+static void _api_at_cmd(xbee_t *dev, uint8_t *cmd, uint8_t size, resp_t *resp)
+{
+    cmd_t c = { cmd, size };
+
+    _api_at_cmds(dev, &c, 1, resp);
+}
+
 /*
  * Interrupt callbacks
  */
@@ -200,29 +241,54 @@ static void _rx_cb(void *arg, uint8_t c)
             dev->int_state = XBEE_INT_STATE_TYPE;
             break;
         case XBEE_INT_STATE_TYPE:
-            if (c == API_ID_RX_SHORT_ADDR || c == API_ID_RX_LONG_ADDR) {
-                /* in case old data was not processed, ignore incoming data */
-                if (dev->rx_count != 0) {
-                    dev->int_state = XBEE_INT_STATE_IDLE;
-                    return;
-                }
+            if ((c == API_ID_RX_SHORT_ADDR || c == API_ID_RX_LONG_ADDR) &&
+                (dev->rx_count == 0) &&
+                (dev->int_size < XBEE_MAX_PKT_LENGTH)) {
                 dev->rx_limit = dev->int_size + 1;
                 dev->rx_buf[dev->rx_count++] = c;
                 dev->int_state = XBEE_INT_STATE_RX;
             }
-            else if (c == API_ID_AT_RESP) {
+            else if ((c == API_ID_AT_RESP) && (dev->int_size >= 5) &&
+                     (dev->int_size <= XBEE_MAX_RESP_LENGTH)) {
+                dev->resp_count = 0;
                 dev->resp_limit = dev->int_size;
                 dev->int_state = XBEE_INT_STATE_RESP;
             }
+            else if (dev->int_size > 0) {
+                /* in case old data was not processed, or the frame is of no
+                 * interest, skip it by its length: without escaping, the start
+                 * delimiter may also appear inside a frame */
+                dev->int_state = XBEE_INT_STATE_SKIP;
+            }
             else {
                 dev->int_state = XBEE_INT_STATE_IDLE;
             }
             break;
         case XBEE_INT_STATE_RESP:
-            dev->resp_buf[dev->resp_count++] = c;
+            if (dev->resp_count == 0) {
+                /* the frame ID selects the buffer of the pipelined command */
+                dev->resp_slot = (uint8_t)(c - dev->resp_fid);
+                if ((dev->resp_slot >= XBEE_AT_PIPELINE_LEN) ||
+                    !(dev->resp_pending & (1 << dev->resp_slot))) {
+                    dev->int_size = dev->resp_limit - 1;
+                    dev->int_state = XBEE_INT_STATE_SKIP;
+                    break;
+                }
+            }
+            dev->resp_buf[dev->resp_slot][dev->resp_count++] = c;
             if (dev->resp_count == dev->resp_limit) {
-                /* here we ignore the checksum to prevent deadlocks */
-                mutex_unlock(&(dev->resp_lock));
+                dev->resp_len[dev->resp_slot] = dev->resp_limit;
+                dev->resp_pending &= ~(1 << dev->resp_slot);
+                /* the checksum is verified by the waiting thread */
+                if (dev->resp_pending == 0) {
+                    mutex_unlock(&(dev->resp_lock));
+                }
+                dev->int_state = XBEE_INT_STATE_IDLE;
+            }
+            break;
+        case XBEE_INT_STATE_SKIP:
+            /* the remaining frame data plus the checksum */
+            if (--dev->int_size == 0) {
                 dev->int_state = XBEE_INT_STATE_IDLE;
             }
             break;
@@ -247,28 +313,20 @@ static void _rx_cb(void *arg, uint8_t c)
  */
 static int _get_addr_long(xbee_t *dev, uint8_t *val, size_t len)
 {
-    uint8_t cmd[2];
-    resp_t resp;
-
     if (len < IEEE802154_LONG_ADDRESS_LEN) {
         return -EOVERFLOW;
     }
 
-    /* read 4 high byte - AT command: SH*/
-    cmd[0] = 'S';
-    cmd[1] = 'H';
-    _api_at_cmd(dev, cmd, 2, &resp);
-    if (resp.status == 0) {
-        memcpy(val, resp.data, 4);
-    }
-    else {
-        return -ECANCELED;
-    }
-    /* read next 4 byte - AT command: SL */
-    cmd[1] = 'L';
-    _api_at_cmd(dev, cmd, 2, &resp);
-    if (resp.status == 0) {
-        memcpy(val + 4, resp.data, 4);
+    /* read the 4 high and the 4 low byte in one go - AT commands: SH, SL */
+    const uint8_t sh[] = { 'S', 'H' };
+    const uint8_t sl[] = { 'S', 'L' };
+    const cmd_t cmds[] = { { sh, 2 }, { sl, 2 } };
+    resp_t resps[2];
+
+    _api_at_cmds(dev, cmds, 2, resps);
+    if (resps[0].status == 0 && resps[1].status == 0) {
+        memcpy(val, resps[0].data, 4);
+        memcpy(val + 4, resps[1].data, 4);
         return IEEE802154_LONG_ADDRESS_LEN;
     }
     return -ECANCELED;
@@ -568,7 +626,6 @@ int xbee_parse_hdr(xbee_t *dev, const uint8_t *xhdr, xbee_l2hdr_t *l2hdr)
 
 int xbee_init(netdev2_t *dev)
 {
-    uint8_t tmp[2];
     xbee_t *xbee = (xbee_t *)dev;
 
     /* set default options */
@@ -577,7 +634,8 @@ int xbee_init(netdev2_t *dev)
     /* initialize buffers and locks*/
     mutex_init(&(xbee->tx_lock));
     mutex_init(&(xbee->resp_lock));
-    xbee->resp_limit = 1;    /* needs to be greater then 0 initially */
+    xbee->resp_pending = 0;
+    xbee->resp_fid = 0;
     xbee->rx_count = 0;
     /* initialize UART and GPIO pins */
     if (uart_init(xbee->p.uart, xbee->p.br, _rx_cb, xbee) != UART_OK) {
@@ -603,29 +661,36 @@ int xbee_init(netdev2_t *dev)
     /* exit command mode */
     _at_cmd(xbee, "ATCN\r");
 
-    /* load long address (we can not set it, its read only for Xbee devices) */
-    if (_get_addr_long(xbee, xbee->addr_long.uint8, IEEE802154_LONG_ADDRESS_LEN) < 0) {
+    /* load long address (we can not set it, its read only for Xbee devices),
+     * and set the default channel and PAN ID in one round trip */
+    const uint8_t sh[] = { 'S', 'H' };
+    const uint8_t sl[] = { 'S', 'L' };
+    const uint8_t ch[] = { 'C', 'H', XBEE_DEFAULT_CHANNEL };
+    const uint8_t id[] = { 'I', 'D', (uint8_t)(XBEE_DEFAULT_PANID >> 8),
+                           (uint8_t)(XBEE_DEFAULT_PANID & 0xff) };
+    const cmd_t cmds[] = { { sh, sizeof(sh) }, { sl, sizeof(sl) },
+                           { ch, sizeof(ch) }, { id, sizeof(id) } };
+    resp_t resps[4];
+
+    _api_at_cmds(xbee, cmds, 4, resps);
+    if (resps[0].status != 0 || resps[1].status != 0) {
         DEBUG("[xbee] init: error getting address\n");
         return -EIO;
     }
-    if (_set_addr(xbee, &((xbee->addr_long).uint8[6]), IEEE802154_SHORT_ADDRESS_LEN) < 0) {
-        DEBUG("[xbee] init: error setting short address\n");
-        return -EIO;
-    }
-    /* set default channel */
-    tmp[1] = 0;
-    tmp[0] = XBEE_DEFAULT_CHANNEL;
-    if (_set_channel(xbee, tmp, 2) < 0) {
+    memcpy(xbee->addr_long.uint8, resps[0].data, 4);
+    memcpy(xbee->addr_long.uint8 + 4, resps[1].data, 4);
+    if (resps[2].status != 0) {
         DEBUG("[xbee] init: error setting channel\n");
         return -EIO;
     }
-    /* set default PAN ID */
-    tmp[1] = (uint8_t)(XBEE_DEFAULT_PANID >> 8);
-    tmp[0] = (uint8_t)(XBEE_DEFAULT_PANID & 0xff);
-    if (_set_panid(xbee, tmp, 2) < 0) {
+    if (resps[3].status != 0) {
         DEBUG("[xbee] init: error setting PAN ID\n");
         return -EIO;
     }
+    if (_set_addr(xbee, &((xbee->addr_long).uint8[6]), IEEE802154_SHORT_ADDRESS_LEN) < 0) {
+        DEBUG("[xbee] init: error setting short address\n");
+        return -EIO;
+    }
 
     DEBUG("[xbee] init: Initialization successful\n");
     return 0;
@@ -66,7 +66,25 @@
 #define CLIENT_PORT  DEFAULT_PORT + 1
 #define MAX_TIMES_TRY_TO_SEND 10
 
-static dtls_context_t *dtls_context = NULL;
+/*
+ * Established sessions are kept per server, so sending to it again uses
+ * the negotiated keys instead of doing a full handshake. TinyDTLS has no
+ * session resumption, so this only skips the handshake while the server
+ * keeps the session as well.
+ */
+#ifndef DTLS_CLIENT_SESSIONS
+#define DTLS_CLIENT_SESSIONS (2)
+#endif
+
+typedef struct {
+    dtls_context_t *ctx;    /* NULL for a free entry */
+    session_t dst;
+    uint32_t last_used;
+    char addr_str[IPV6_ADDR_MAX_STR_LEN];
+} client_session_t;
+
+static client_session_t sessions[DTLS_CLIENT_SESSIONS];
+static uint32_t session_uses;
 static char *client_payload;
 static size_t buflen = 0;
 
@@ -349,8 +367,9 @@ static int send_to_peer(struct dtls_context_t *ctx,
  *  This is a custom function for preparing the SIGNAL events and
  *  create a new DTLS context.
  */
-static void init_dtls(session_t *dst, char *addr_str)
+static dtls_context_t *init_dtls(session_t *dst, char *addr_str)
 {
+    dtls_context_t *ctx;
 
     static dtls_handler_t cb = {
         .write = send_to_peer,
@@ -386,22 +405,68 @@ static void init_dtls(session_t *dst, char *addr_str)
 
     if (ipv6_addr_from_str(&dst->addr, addr_str) == NULL) {
         puts("ERROR: init_dtls was unable to load the IPv6 addresses!\n");
-        dtls_context = NULL;
-        return;
+        return NULL;
     }
 
-    ipv6_addr_t addr_dbg;
-    ipv6_addr_from_str(&addr_dbg, addr_str);
-
     /*akin to syslog: EMERG, ALERT, CRITC, NOTICE, INFO, DEBUG */
     dtls_set_log_level(DTLS_LOG_NOTICE);
 
-    dtls_context = dtls_new_context(addr_str);
-    if (dtls_context) {
-        dtls_set_handler(dtls_context, &cb);
+    ctx = dtls_new_context(addr_str);
+    if (ctx) {
+        dtls_set_handler(ctx, &cb);
     }
 
-    return;
+    return ctx;
+}
+
+static void drop_session(client_session_t *entry)
+{
+    dtls_free_context(entry->ctx);
+    entry->ctx = NULL;
+}
+
+/**
+ * @brief Returns the cached session with a server, or a new one in place of
+ * a free or the least recently used entry.
+ */
+static client_session_t *get_session(char *addr_str)
+{
+    client_session_t *entry = NULL;
+    ipv6_addr_t addr;
+
+    if (ipv6_addr_from_str(&addr, addr_str) == NULL) {
+        puts("ERROR: unable to parse the IPv6 address!");
+        return NULL;
+    }
+
+    for (unsigned i = 0; i < DTLS_CLIENT_SESSIONS; i++) {
+        if (sessions[i].ctx && ipv6_addr_equal(&sessions[i].dst.addr, &addr)) {
+            sessions[i].last_used = ++session_uses;
+            return &sessions[i];
+        }
+    }
+
+    for (unsigned i = 0; i < DTLS_CLIENT_SESSIONS; i++) {
+        if (!sessions[i].ctx) {
+            entry = &sessions[i];
+            break;
+        }
+        if (!entry || (sessions[i].last_used < entry->last_used)) {
+            entry = &sessions[i];
+        }
+    }
+    if (entry->ctx) {
+        DEBUG("DBG-Client: dropping the session with %s\n", entry->addr_str);
+        drop_session(entry);
+    }
+
+    /* the context refers to the address as its app data */
+    strncpy(entry->addr_str, addr_str, sizeof(entry->addr_str) - 1);
+    entry->addr_str[sizeof(entry->addr_str) - 1] = '\0';
+    entry->ctx = init_dtls(&entry->dst, entry->addr_str);
+    entry->last_used = ++session_uses;
+
+    return entry->ctx ? entry : NULL;
 }
 
 /**
@@ -411,13 +476,13 @@ static void init_dtls(session_t *dst, char *addr_str)
 static void client_send(char *addr_str, char *data, unsigned int delay)
 {
     static int8_t iWatch;
-    static session_t dst;
-    static int connected = 0;
+    client_session_t *session;
+    dtls_peer_t *peer;
+    int connected = 0;
     msg_t msg;
 
    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(CLIENT_PORT,
                                                            sched_active_pid);
-    dtls_init();
 
     if (gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry)) {
         puts("Unable to register ports");
@@ -427,16 +492,24 @@ static void client_send(char *addr_str, char *data, unsigned int delay)
 
     if (strlen(data) > DTLS_MAX_BUF) {
         puts("Data too long ");
+        gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &entry);
         return;
     }
 
-    init_dtls(&dst, addr_str);
-    if (!dtls_context) {
+    session = get_session(addr_str);
+    if (!session) {
         dtls_emerg("cannot create context\n");
         puts("Client unable to load context!");
+        gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &entry);
         return;
     }
 
+    peer = dtls_get_peer(session->ctx, &session->dst);
+    if (peer && (peer->state == DTLS_STATE_CONNECTED)) {
+        puts("Client reuses the established session");
+        connected = 1;
+    }
+
     /* client_payload is global due to the SIGNAL function send_to_peer  */
     client_payload = data;
     buflen =  strlen(client_payload);
@@ -449,7 +522,7 @@ static void client_send(char *addr_str, char *data, unsigned int delay)
      * sequence number of the first DTLS Hello message will be greater than
      * zero).
      */
-    //connected = dtls_connect(dtls_context, &dst) >= 0;
+    //connected = dtls_connect(session->ctx, &session->dst) >= 0;
 
     /*
      * Until all the data is not sent we remains trying to connect to the
@@ -463,7 +536,7 @@ static void client_send(char *addr_str, char *data, unsigned int delay)
          * commented..
          */
         if (!connected) {
-            connected = dtls_connect(dtls_context, &dst);
+            connected = dtls_connect(session->ctx, &session->dst);
         }
         else if (connected < 0) {
             puts("Client DTLS was unable to establish a channel!\n");
@@ -471,7 +544,7 @@ static void client_send(char *addr_str, char *data, unsigned int delay)
         }
         else {
             /*TODO: must happens always or only when connected?*/
-            try_send(dtls_context, &dst);
+            try_send(session->ctx, &session->dst);
         }
 
         /*
@@ -485,18 +558,19 @@ static void client_send(char *addr_str, char *data, unsigned int delay)
         xtimer_usleep(delay);
 
         if (msg_try_receive(&msg) == 1) {
-            dtls_handle_read(dtls_context, (gnrc_pktsnip_t *)(msg.content.ptr));
+            dtls_handle_read(session->ctx, (gnrc_pktsnip_t *)(msg.content.ptr));
         }
 
         iWatch--;
     } /*END while*/
 
-    dtls_free_context(dtls_context);
+    /* a failed session starts from scratch next time */
+    if (buflen > 0) {
+        drop_session(session);
+    }
     /* unregister our UDP listener on this thread */
     gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &entry);
-    connected = 0; /*Probably this should be removed or global */
 
-    /* Permanent or not permanent? */
     DEBUG("DTLS-Client: DTLS session finished\n");
 }
 
@@ -400,9 +400,6 @@ static void start_server(void)
         return;
     }
 
-    /*TESTING tinydtls*/
-    dtls_init();
-
     /* The server is initialized  */
     server.target.pid = thread_create(_server_stack, sizeof(_server_stack),
                                THREAD_PRIORITY_MAIN - 1,
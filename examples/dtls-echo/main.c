@@ -25,6 +25,10 @@
 #include "shell.h"
 #include "msg.h"
 
+/* TinyDTLS */
+#include "tinydtls.h"
+#include "dtls.h"
+
 
 
 /*TinyDTLS WARNING check*/
@@ -55,6 +59,10 @@ int main(void)
     msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
     puts("RIOT (Tiny)DTLS testing implementation");
 
+    /* the client keeps its sessions between commands, so the pools of
+     * TinyDTLS are initialized only once for client and server */
+    dtls_init();
+
     /* start shell */
     puts("All up, running the shell now");
     char line_buf[SHELL_DEFAULT_BUFSIZE];
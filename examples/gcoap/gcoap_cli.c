@@ -26,11 +26,18 @@
 #include "od.h"
 #include "fmt.h"
 
+/* Number of lines of the /cli/log resource */
+#define LOG_LINES       (32U)
+/* Length of a line, "entry NN\n" */
+#define LOG_LINE_LEN    (9U)
+
 static void _resp_handler(unsigned req_state, coap_pkt_t* pdu);
+static ssize_t _log_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len);
 static ssize_t _stats_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len);
 
 /* CoAP resources */
 static const coap_resource_t _resources[] = {
+    { "/cli/log", COAP_GET, _log_handler },
     { "/cli/stats", COAP_GET, _stats_handler },
 };
 static gcoap_listener_t _listener = {
@@ -38,6 +45,11 @@ static gcoap_listener_t _listener = {
     sizeof(_resources) / sizeof(_resources[0]),
     NULL
 };
+/* /cli/stats notifies its observers at most once per second */
+static gcoap_observable_t _stats_observable = {
+    .resource     = &_resources[1],
+    .min_interval = 1000000U,
+};
 
 /* Counts requests sent by CLI. */
 static uint16_t req_count = 0;
@@ -80,6 +92,43 @@ static void _resp_handler(unsigned req_state, coap_pkt_t* pdu)
     }
 }
 
+/*
+ * Block reader for /cli/log. Generates the slice of the log on demand, the
+ * log itself does not exist in memory.
+ */
+static ssize_t _log_reader(void *arg, size_t offset, uint8_t *buf, size_t len)
+{
+    static const char prefix[] = "entry ";
+    size_t pos;
+    (void)arg;
+
+    for (pos = 0; (pos < len) && (offset < LOG_LINES * LOG_LINE_LEN); pos++) {
+        unsigned line = offset / LOG_LINE_LEN;
+        unsigned col  = offset++ % LOG_LINE_LEN;
+
+        if (col < sizeof(prefix) - 1) {
+            buf[pos] = prefix[col];
+        }
+        else if (col == LOG_LINE_LEN - 1) {
+            buf[pos] = '\n';
+        }
+        else {
+            buf[pos] = '0' + ((col == sizeof(prefix) - 1) ? line / 10 : line % 10);
+        }
+    }
+    return pos;
+}
+
+/*
+ * Server callback for /cli/log. The log is longer than a PDU, so it is
+ * returned block-wise.
+ */
+static ssize_t _log_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len)
+{
+    return gcoap_block2_respond(pdu, buf, len, COAP_FORMAT_TEXT, _log_reader,
+                                NULL);
+}
+
 /*
  * Server callback for /cli/stats. Returns the count of packets sent by the
  * CLI.
@@ -114,6 +163,7 @@ static size_t _send(uint8_t *buf, size_t len, char *addr_str, char *port_str)
     bytes_sent = gcoap_req_send(buf, len, &addr, port, _resp_handler);
     if (bytes_sent > 0) {
         req_count++;
+        gcoap_obs_notify(&_stats_observable);
     }
     return bytes_sent;
 }
@@ -178,4 +228,5 @@ int gcoap_cli_cmd(int argc, char **argv)
 void gcoap_cli_init(void)
 {
     gcoap_register_listener(&_listener);
+    gcoap_register_observable(&_stats_observable);
 }
@@ -43,16 +43,53 @@ extern "C" {
 /**
  * @name Dynamic memory allocation used in CCN-Lite
  *
+ * CCN-Lite allocates every prefix, packet, content store and PIT entry
+ * separately. To keep this from fragmenting the heap, requests of up to
+ * 128 byte are served from fixed-block pools, one per power of two from 16 to
+ * 128 byte. Only larger requests and requests for an exhausted pool go to the
+ * heap.
+ *
+ * @{
+ */
+#define ccnl_malloc(s)                  ccnl_pool_malloc(s)
+#define ccnl_calloc(n,s)                ccnl_pool_calloc(n,s)
+#define ccnl_realloc(p,s)               ccnl_pool_realloc(p,s)
+#define ccnl_free(p)                    ccnl_pool_free(p)
+/**
+ * @}
+ */
+
+/**
+ * @name Number of blocks in the memory pools, 0 to disable a pool
+ *
  * @{
  */
-#define ccnl_malloc(s)                  malloc(s)
-#define ccnl_calloc(n,s)                calloc(n,s)
-#define ccnl_realloc(p,s)               realloc(p,s)
-#define ccnl_free(p)                    free(p)
+#ifndef CCNL_POOL_NUMOF_16
+#define CCNL_POOL_NUMOF_16      (24U)   /**< blocks of 16 byte */
+#endif
+#ifndef CCNL_POOL_NUMOF_32
+#define CCNL_POOL_NUMOF_32      (16U)   /**< blocks of 32 byte */
+#endif
+#ifndef CCNL_POOL_NUMOF_64
+#define CCNL_POOL_NUMOF_64      (12U)   /**< blocks of 64 byte */
+#endif
+#ifndef CCNL_POOL_NUMOF_128
+#define CCNL_POOL_NUMOF_128     (8U)    /**< blocks of 128 byte */
+#endif
 /**
  * @}
  */
 
+/**
+ * @brief Memory pool statistics
+ */
+typedef struct {
+    uint32_t pool_allocs;   /**< allocations served from a pool */
+    uint32_t heap_allocs;   /**< allocations served from the heap */
+    uint16_t used;          /**< pool blocks currently in use */
+    uint16_t max_used;      /**< maximum of pool blocks in use */
+} ccnl_pool_stats_t;
+
 /**
  * Closing an interface or socket from CCN-Lite
  */
@@ -276,6 +313,52 @@ void ccnl_set_local_producer(ccnl_producer_func func);
  */
 void ccnl_set_cache_strategy_remove(ccnl_cache_strategy_func func);
 
+/**
+ * @brief Allocates memory for CCN-Lite
+ *
+ * @param[in] size  number of bytes
+ *
+ * @return  pointer to the memory
+ * @return  NULL, if no memory is left
+ */
+void *ccnl_pool_malloc(size_t size);
+
+/**
+ * @brief Allocates zeroed memory for CCN-Lite
+ *
+ * @param[in] numof number of elements
+ * @param[in] size  size of an element
+ *
+ * @return  pointer to the memory
+ * @return  NULL, if no memory is left
+ */
+void *ccnl_pool_calloc(size_t numof, size_t size);
+
+/**
+ * @brief Resizes memory allocated by ccnl_pool_malloc()
+ *
+ * @param[in] ptr   the memory, may be NULL
+ * @param[in] size  new number of bytes
+ *
+ * @return  pointer to the memory
+ * @return  NULL, if no memory is left; @p ptr is left untouched then
+ */
+void *ccnl_pool_realloc(void *ptr, size_t size);
+
+/**
+ * @brief Frees memory allocated by ccnl_pool_malloc()
+ *
+ * @param[in] ptr   the memory, may be NULL
+ */
+void ccnl_pool_free(void *ptr);
+
+/**
+ * @brief Get the memory pool statistics
+ *
+ * @return  the statistics since start-up
+ */
+const ccnl_pool_stats_t *ccnl_pool_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_ccnlite
+ * @{
+ *
+ * @file
+ * @brief       Fixed-block memory pools for CCN-Lite's allocations
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "irq.h"
+#include "ccn-lite-riot.h"
+
+#define POOL_NUMOF          (4U)
+#define POOL_MIN_SIZE       (16U)
+#define POOL_SIZE(i)        (POOL_MIN_SIZE << (i))
+
+#define POOL_MEM_SIZE       ((CCNL_POOL_NUMOF_16 * 16U) + \
+                             (CCNL_POOL_NUMOF_32 * 32U) + \
+                             (CCNL_POOL_NUMOF_64 * 64U) + \
+                             (CCNL_POOL_NUMOF_128 * 128U))
+
+typedef struct block {
+    struct block *next;
+} block_t;
+
+static const uint16_t _numof[POOL_NUMOF] = {
+    CCNL_POOL_NUMOF_16, CCNL_POOL_NUMOF_32, CCNL_POOL_NUMOF_64,
+    CCNL_POOL_NUMOF_128
+};
+
+/* all pools in one buffer, ordered by block size, so every block is aligned
+ * to its size up to 8 byte */
+static uint64_t _mem[(POOL_MEM_SIZE / sizeof(uint64_t)) + 1];
+static block_t *_free[POOL_NUMOF];
+static uint8_t _initialized;
+static ccnl_pool_stats_t _stats;
+
+static void _init(void)
+{
+    uint8_t *pos = (uint8_t *)_mem;
+
+    for (unsigned i = 0; i < POOL_NUMOF; i++) {
+        for (unsigned j = 0; j < _numof[i]; j++) {
+            block_t *block = (block_t *)pos;
+
+            block->next = _free[i];
+            _free[i] = block;
+            pos += POOL_SIZE(i);
+        }
+    }
+    _initialized = 1;
+}
+
+/* pool of a block, or -1 if ptr does not point into the pools */
+static int _pool_of(const void *ptr)
+{
+    const uint8_t *pos = (const uint8_t *)_mem;
+
+    if ((const uint8_t *)ptr < pos) {
+        return -1;
+    }
+    for (unsigned i = 0; i < POOL_NUMOF; i++) {
+        pos += _numof[i] * POOL_SIZE(i);
+        if ((const uint8_t *)ptr < pos) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void *_pool_alloc(size_t size)
+{
+    block_t *block = NULL;
+    unsigned i = 0;
+
+    while ((i < POOL_NUMOF) && (size > POOL_SIZE(i))) {
+        i++;
+    }
+    if (i < POOL_NUMOF) {
+        unsigned state = irq_disable();
+
+        if (!_initialized) {
+            _init();
+        }
+        block = _free[i];
+        if (block != NULL) {
+            _free[i] = block->next;
+            _stats.pool_allocs++;
+            if (++_stats.used > _stats.max_used) {
+                _stats.max_used = _stats.used;
+            }
+        }
+        irq_restore(state);
+    }
+    return block;
+}
+
+void *ccnl_pool_malloc(size_t size)
+{
+    void *ptr = _pool_alloc(size);
+
+    if (ptr == NULL) {
+        ptr = malloc(size);
+        _stats.heap_allocs++;
+    }
+    return ptr;
+}
+
+void *ccnl_pool_calloc(size_t numof, size_t size)
+{
+    void *ptr;
+
+    if ((size != 0) && (numof > (SIZE_MAX / size))) {
+        return NULL;
+    }
+    ptr = ccnl_pool_malloc(numof * size);
+    if (ptr != NULL) {
+        memset(ptr, 0, numof * size);
+    }
+    return ptr;
+}
+
+void *ccnl_pool_realloc(void *ptr, size_t size)
+{
+    int pool;
+    void *res;
+
+    if (ptr == NULL) {
+        return ccnl_pool_malloc(size);
+    }
+    pool = _pool_of(ptr);
+    if (pool < 0) {
+        _stats.heap_allocs++;
+        return realloc(ptr, size);
+    }
+    if (size <= POOL_SIZE(pool)) {
+        return ptr;
+    }
+    res = ccnl_pool_malloc(size);
+    if (res != NULL) {
+        memcpy(res, ptr, POOL_SIZE(pool));
+        ccnl_pool_free(ptr);
+    }
+    return res;
+}
+
+void ccnl_pool_free(void *ptr)
+{
+    int pool = _pool_of(ptr);
+
+    if (pool < 0) {
+        free(ptr);
+    }
+    else {
+        block_t *block = ptr;
+        unsigned state = irq_disable();
+
+        block->next = _free[pool];
+        _free[pool] = block;
+        _stats.used--;
+        irq_restore(state);
+    }
+}
+
+const ccnl_pool_stats_t *ccnl_pool_stats(void)
+{
+    return &_stats;
+}
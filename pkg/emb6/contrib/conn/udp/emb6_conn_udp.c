@@ -17,6 +17,7 @@
 #include <errno.h>
 #include <stdbool.h>
 
+#include "emb6/wakeup.h"
 #include "evproc.h"
 #include "msg.h"
 #include "mutex.h"
@@ -194,6 +195,7 @@ int conn_udp_sendto(const void *data, size_t len, const void *src, size_t src_le
         mutex_unlock(&send_cmd.mutex);
         return -EIO;
     }
+    emb6_wakeup();
     /* block thread until data was send */
     mutex_lock(&send_cmd.mutex);
     udp_socket_close(&send_cmd.sock);
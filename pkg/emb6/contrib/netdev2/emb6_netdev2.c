@@ -20,6 +20,9 @@
 #include "msg.h"
 #include "net/netdev2.h"
 
+#include "emb6/netdev2.h"
+#include "emb6/wakeup.h"
+
 #include "evproc.h"
 #include "emb6.h"
 #include "linkaddr.h"
@@ -34,6 +37,7 @@ static netdev2_t *_dev = NULL;
 static s_nsLowMac_t *_lowmac = NULL;
 static int8_t _rssi_base_value = -100;
 static uint8_t _last_rssi;
+static volatile uint8_t _isr_pending = 0;
 
 static int8_t _netdev2_init(s_ns_t *p_ns);
 static int8_t _netdev2_send(const void *pr_payload, uint8_t c_len);
@@ -83,10 +87,13 @@ static void _get_recv_pkt(void)
 static void _event_cb(netdev2_t *dev, netdev2_event_t event)
 {
     if (event == NETDEV2_EVENT_ISR) {
-        /* EVENT_TYPE_PCK_LL is supposed to be used by drivers, so use it
-         * (though NETDEV2_EVENT_ISR technically doesn't only signify
-         * incoming packets) */
-        evproc_putEvent(E_EVPROC_HEAD, EVENT_TYPE_PCK_LL, NULL);
+        /* the event is put into emb6's queue by the emb6 thread, and the
+         * driver's ISR handler handles everything that is pending by then,
+         * so interrupts signaled in the meantime need no extra wakeup */
+        if (!_isr_pending) {
+            _isr_pending = 1;
+            emb6_wakeup();
+        }
     }
     else {
         switch (event) {
@@ -108,6 +115,17 @@ static void _emb6_netdev2_callback(c_event_t c_event, p_data_t p_data)
     }
 }
 
+void emb6_netdev2_poll(void)
+{
+    if (_isr_pending) {
+        _isr_pending = 0;
+        /* EVENT_TYPE_PCK_LL is supposed to be used by drivers, so use it
+         * (though NETDEV2_EVENT_ISR technically doesn't only signify
+         * incoming packets) */
+        evproc_putEvent(E_EVPROC_HEAD, EVENT_TYPE_PCK_LL, NULL);
+    }
+}
+
 int emb6_netdev2_setup(netdev2_t *dev)
 {
     if (_dev == NULL) {
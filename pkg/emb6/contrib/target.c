@@ -22,10 +22,16 @@
 #include "periph/hwrng.h"
 #include "xtimer.h"
 
+#include "emb6/wakeup.h"
+#ifdef MODULE_EMB6_NETDEV2
+#include "emb6/netdev2.h"
+#endif
+#include "etimer.h"
 #include "target.h"
 #include "bsp.h"
 
 static mutex_t critical_mutex = MUTEX_INIT;
+static mutex_t wakeup_mutex = MUTEX_INIT_LOCKED;
 
 void hal_enterCritical(void)
 {
@@ -96,9 +102,32 @@ uint8_t hal_extIntInit(en_targetExtInt_t e_extInt, pfn_intCallb_t pfn_intCallbac
     return 0;
 }
 
+void emb6_wakeup(void)
+{
+    mutex_unlock(&wakeup_mutex);
+}
+
 void hal_delay_us(uint32_t i_delay)
 {
-    xtimer_usleep(i_delay);
+    /* emb6 only delays between two runs of its event loop, so instead of
+     * polling every i_delay sleep until the next etimer is due or until there
+     * is an event to handle */
+    clock_time_t next = etimer_next_expiration_time();
+
+    (void)i_delay;
+    if (next != 0) {
+        int32_t timeout = (int32_t)(next - hal_getTick());
+
+        if (timeout > 0) {
+            xtimer_mutex_lock_timeout(&wakeup_mutex, (uint64_t)timeout);
+        }
+    }
+    else {
+        mutex_lock(&wakeup_mutex);
+    }
+#ifdef MODULE_EMB6_NETDEV2
+    emb6_netdev2_poll();
+#endif
 }
 
 uint8_t hal_gpioPinInit(uint8_t c_pin, uint8_t c_dir, uint8_t c_initState)
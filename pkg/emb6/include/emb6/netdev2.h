@@ -48,6 +48,15 @@ extern const s_nsIf_t emb6_netdev2_driver;
  */
 int emb6_netdev2_setup(netdev2_t *dev);
 
+/**
+ * @brief   Hands a pending interrupt of the network device to emb6
+ *
+ * Called by the emb6 thread whenever it wakes up. Several interrupts
+ * signaled in the meantime are handled by one call of the device's ISR
+ * handler.
+ */
+void emb6_netdev2_poll(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup pkgemb6_wakeup     Event-driven emb6 main loop
+ * @ingroup pkg_emb6
+ * @brief   Lets the emb6 thread sleep until there is work for it
+ *
+ * emb6_process() runs emb6's event loop and delays between two runs with
+ * hal_delay_us(). On RIOT, that delay does not poll: the emb6 thread sleeps
+ * until the next emb6 timer is due or until it is woken up by
+ * emb6_wakeup(), e.g. because the network device signaled an interrupt or
+ * another thread put an event into emb6's event queue. The delay given to
+ * emb6_process() is ignored.
+ * @{
+ *
+ * @file
+ * @brief
+ */
+#ifndef EMB6_WAKEUP_H_
+#define EMB6_WAKEUP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Wakes up the emb6 thread
+ *
+ * Must be called after putting an event into emb6's event queue from outside
+ * the emb6 thread. May be called from interrupt context.
+ */
+void emb6_wakeup(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EMB6_WAKEUP_H_ */
+/** @} */
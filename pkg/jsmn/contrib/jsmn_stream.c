@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_jsmn_stream
+ * @{
+ *
+ * @file
+ * @brief       Streaming JSON tokenizer implementation
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "jsmn_stream.h"
+
+enum {
+    STATE_VALUE,            /* expecting a value */
+    STATE_VALUE_OR_END,     /* expecting a value or ']' */
+    STATE_KEY,              /* expecting a key */
+    STATE_KEY_OR_END,       /* expecting a key or '}' */
+    STATE_COLON,            /* expecting ':' */
+    STATE_NEXT,             /* expecting ',' or the end of the container */
+    STATE_STRING,           /* inside a string */
+    STATE_PRIMITIVE,        /* inside a primitive */
+    STATE_DONE,             /* top-level value complete */
+    STATE_ERROR,            /* an error occurred */
+};
+
+#define FLAG_ESCAPE         (0x01)  /* previous character was a backslash */
+#define FLAG_KEY            (0x02)  /* the string is a key */
+
+static int _is_space(char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+}
+
+static int _add_char(jsmn_stream_t *s, char c)
+{
+    if (s->value_len >= JSMN_STREAM_VALUE_LEN) {
+        return JSMN_ERROR_NOMEM;
+    }
+    s->value[s->value_len++] = c;
+    return 0;
+}
+
+static int _add_component(jsmn_stream_t *s, const char *comp, size_t len)
+{
+    if ((s->path_len + 1 + len) >= JSMN_STREAM_PATH_LEN) {
+        return JSMN_ERROR_NOMEM;
+    }
+    s->path[s->path_len++] = '/';
+    memcpy(&s->path[s->path_len], comp, len);
+    s->path_len += len;
+    s->path[s->path_len] = '\0';
+    return 0;
+}
+
+static void _emit(jsmn_stream_t *s, jsmntype_t type)
+{
+    s->value[s->value_len] = '\0';
+    s->cb(s, type, s->path, s->value, s->value_len, s->arg);
+}
+
+/* a value is complete: continue in the enclosing container */
+static void _value_end(jsmn_stream_t *s)
+{
+    if (s->depth == 0) {
+        s->state = STATE_DONE;
+        s->path_len = 0;
+    }
+    else {
+        if (s->stack[s->depth - 1].type == JSMN_ARRAY) {
+            s->stack[s->depth - 1].index++;
+        }
+        s->path_len = s->stack[s->depth - 1].base;
+        s->state = STATE_NEXT;
+    }
+    s->path[s->path_len] = '\0';
+}
+
+static int _value_start(jsmn_stream_t *s, char c)
+{
+    if ((s->depth > 0) && (s->stack[s->depth - 1].type == JSMN_ARRAY)) {
+        char idx[6];
+        int len = snprintf(idx, sizeof(idx), "%u",
+                           (unsigned)s->stack[s->depth - 1].index);
+
+        if (_add_component(s, idx, len) < 0) {
+            return JSMN_ERROR_NOMEM;
+        }
+    }
+    switch (c) {
+        case '{':
+        case '[':
+            if (s->depth >= JSMN_STREAM_DEPTH) {
+                return JSMN_ERROR_NOMEM;
+            }
+            s->stack[s->depth].type = (c == '{') ? JSMN_OBJECT : JSMN_ARRAY;
+            s->stack[s->depth].base = s->path_len;
+            s->stack[s->depth].index = 0;
+            s->cb(s, s->stack[s->depth].type, s->path, NULL, 0, s->arg);
+            s->depth++;
+            s->state = (c == '{') ? STATE_KEY_OR_END : STATE_VALUE_OR_END;
+            return 0;
+        case '"':
+            s->value_len = 0;
+            s->flags = 0;
+            s->state = STATE_STRING;
+            return 0;
+        case '-':
+        case 't':
+        case 'f':
+        case 'n':
+            break;
+        default:
+            if ((c < '0') || (c > '9')) {
+                return JSMN_ERROR_INVAL;
+            }
+            break;
+    }
+    s->value_len = 0;
+    s->state = STATE_PRIMITIVE;
+    return _add_char(s, c);
+}
+
+static int _container_end(jsmn_stream_t *s, char c)
+{
+    uint8_t type = (c == '}') ? JSMN_OBJECT : JSMN_ARRAY;
+
+    if ((s->depth == 0) || (s->stack[s->depth - 1].type != type)) {
+        return JSMN_ERROR_INVAL;
+    }
+    s->depth--;
+    _value_end(s);
+    return 0;
+}
+
+static int _key_start(jsmn_stream_t *s, char c)
+{
+    if (c != '"') {
+        return JSMN_ERROR_INVAL;
+    }
+    s->value_len = 0;
+    s->flags = FLAG_KEY;
+    s->state = STATE_STRING;
+    return 0;
+}
+
+static int _string(jsmn_stream_t *s, char c)
+{
+    if (s->flags & FLAG_ESCAPE) {
+        s->flags &= ~FLAG_ESCAPE;
+    }
+    else if (c == '\\') {
+        s->flags |= FLAG_ESCAPE;
+    }
+    else if (c == '"') {
+        if (s->flags & FLAG_KEY) {
+            s->state = STATE_COLON;
+            return _add_component(s, s->value, s->value_len);
+        }
+        _emit(s, JSMN_STRING);
+        _value_end(s);
+        return 0;
+    }
+    return _add_char(s, c);
+}
+
+static int _step(jsmn_stream_t *s, char c)
+{
+    switch (s->state) {
+        case STATE_STRING:
+            return _string(s, c);
+        case STATE_PRIMITIVE:
+            if (!_is_space(c) && (c != ',') && (c != ']') && (c != '}')) {
+                return _add_char(s, c);
+            }
+            _emit(s, JSMN_PRIMITIVE);
+            _value_end(s);
+            /* the character ends the primitive and belongs to what follows */
+            return _step(s, c);
+        default:
+            break;
+    }
+    if (_is_space(c)) {
+        return 0;
+    }
+    switch (s->state) {
+        case STATE_VALUE_OR_END:
+            if (c == ']') {
+                return _container_end(s, c);
+            }
+            return _value_start(s, c);
+        case STATE_VALUE:
+            return _value_start(s, c);
+        case STATE_KEY_OR_END:
+            if (c == '}') {
+                return _container_end(s, c);
+            }
+            return _key_start(s, c);
+        case STATE_KEY:
+            return _key_start(s, c);
+        case STATE_COLON:
+            if (c != ':') {
+                return JSMN_ERROR_INVAL;
+            }
+            s->state = STATE_VALUE;
+            return 0;
+        case STATE_NEXT:
+            if (c == ',') {
+                s->state = (s->stack[s->depth - 1].type == JSMN_OBJECT) ?
+                           STATE_KEY : STATE_VALUE;
+                return 0;
+            }
+            if ((c == '}') || (c == ']')) {
+                return _container_end(s, c);
+            }
+            return JSMN_ERROR_INVAL;
+        default:
+            /* STATE_DONE: nothing may follow the top-level value */
+            return JSMN_ERROR_INVAL;
+    }
+}
+
+void jsmn_stream_init(jsmn_stream_t *stream, jsmn_stream_cb_t cb, void *arg)
+{
+    memset(stream, 0, sizeof(*stream));
+    stream->cb = cb;
+    stream->arg = arg;
+    stream->state = STATE_VALUE;
+}
+
+int jsmn_stream_feed(jsmn_stream_t *stream, const char *buf, size_t len)
+{
+    if (stream->state == STATE_ERROR) {
+        return JSMN_ERROR_INVAL;
+    }
+    for (size_t i = 0; i < len; i++) {
+        int res = _step(stream, buf[i]);
+
+        if (res < 0) {
+            stream->state = STATE_ERROR;
+            return res;
+        }
+    }
+    return 0;
+}
+
+int jsmn_stream_finish(jsmn_stream_t *stream)
+{
+    if ((stream->state == STATE_PRIMITIVE) && (stream->depth == 0)) {
+        _emit(stream, JSMN_PRIMITIVE);
+        _value_end(stream);
+    }
+    if (stream->state == STATE_ERROR) {
+        return JSMN_ERROR_INVAL;
+    }
+    return (stream->state == STATE_DONE) ? 0 : JSMN_ERROR_PART;
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    pkg_jsmn_stream Streaming JSON tokenizer
+ * @ingroup     pkg
+ * @brief       Tokenizes JSON documents chunk by chunk with bounded RAM
+ *
+ * jsmn needs the whole document in memory and a token array sized for it.
+ * This tokenizer takes the document in arbitrary chunks, e.g. as they arrive
+ * from a socket or as CoAP blocks, and calls a callback for every value,
+ * together with the path of the value in the document:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * {"server": {"host": "fd00::1", "ports": [5683, 5684]}}
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * yields the object "" and "/server", the string "fd00::1" at
+ * "/server/host", the array "/server/ports" and the primitives 5683 and 5684
+ * at "/server/ports/0" and "/server/ports/1". Keys are put into the path as
+ * they appear in the document, without unescaping.
+ *
+ * Values are passed with the surrounding quotes removed and escapes left in
+ * place, as jsmn does. The RAM needed is fixed by
+ * @ref JSMN_STREAM_DEPTH, @ref JSMN_STREAM_PATH_LEN and
+ * @ref JSMN_STREAM_VALUE_LEN, independent of the size of the document.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * USEMODULE += jsmn_stream
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Streaming JSON tokenizer interface
+ */
+
+#ifndef JSMN_STREAM_H
+#define JSMN_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jsmn.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum nesting depth of objects and arrays
+ */
+#ifndef JSMN_STREAM_DEPTH
+#define JSMN_STREAM_DEPTH       (8U)
+#endif
+
+/**
+ * @brief   Maximum length of the path of a value, including the terminating
+ *          zero byte
+ */
+#ifndef JSMN_STREAM_PATH_LEN
+#define JSMN_STREAM_PATH_LEN    (64U)
+#endif
+
+/**
+ * @brief   Maximum length of a key, string or primitive
+ */
+#ifndef JSMN_STREAM_VALUE_LEN
+#define JSMN_STREAM_VALUE_LEN   (32U)
+#endif
+
+/**
+ * @brief   Forward declaration of the tokenizer state
+ */
+typedef struct jsmn_stream jsmn_stream_t;
+
+/**
+ * @brief   Callback for every value of the document
+ *
+ * @param[in] stream    the tokenizer
+ * @param[in] type      type of the value
+ * @param[in] path      zero-terminated path of the value, "" for the top-level
+ *                      value
+ * @param[in] value     zero-terminated string or primitive, NULL for objects
+ *                      and arrays, which are reported at their start
+ * @param[in] len       length of @p value
+ * @param[in] arg       the argument given to jsmn_stream_init()
+ */
+typedef void (*jsmn_stream_cb_t)(jsmn_stream_t *stream, jsmntype_t type,
+                                 const char *path, const char *value,
+                                 size_t len, void *arg);
+
+/**
+ * @brief   Tokenizer state
+ */
+struct jsmn_stream {
+    jsmn_stream_cb_t cb;                /**< callback for values */
+    void *arg;                          /**< argument of the callback */
+    uint8_t state;                      /**< state of the tokenizer */
+    uint8_t flags;                      /**< flags of the current string */
+    uint8_t depth;                      /**< nesting depth */
+    uint16_t path_len;                  /**< length of the current path */
+    uint16_t value_len;                 /**< length of the current value */
+    struct {
+        uint8_t type;                   /**< JSMN_OBJECT or JSMN_ARRAY */
+        uint16_t base;                  /**< length of its path */
+        uint16_t index;                 /**< index of the current element */
+    } stack[JSMN_STREAM_DEPTH];         /**< enclosing objects and arrays */
+    char path[JSMN_STREAM_PATH_LEN];    /**< path of the current value */
+    char value[JSMN_STREAM_VALUE_LEN + 1]; /**< the current value */
+};
+
+/**
+ * @brief   Initializes a tokenizer for a new document
+ *
+ * @param[out] stream   the tokenizer
+ * @param[in] cb        callback for the values of the document
+ * @param[in] arg       argument passed to @p cb
+ */
+void jsmn_stream_init(jsmn_stream_t *stream, jsmn_stream_cb_t cb, void *arg);
+
+/**
+ * @brief   Tokenizes the next chunk of the document
+ *
+ * The chunk can be released once the function returned.
+ *
+ * @param[in,out] stream    the tokenizer
+ * @param[in] buf           the chunk
+ * @param[in] len           length of @p buf
+ *
+ * @return  0 on success
+ * @return  JSMN_ERROR_INVAL if the document is not valid JSON
+ * @return  JSMN_ERROR_NOMEM if the document is nested too deep, or a path or
+ *          value is too long
+ */
+int jsmn_stream_feed(jsmn_stream_t *stream, const char *buf, size_t len);
+
+/**
+ * @brief   Ends the document
+ *
+ * Reports a top-level primitive, which has no end marker.
+ *
+ * @param[in,out] stream    the tokenizer
+ *
+ * @return  0 if the document was complete
+ * @return  JSMN_ERROR_PART if the document ended early
+ * @return  JSMN_ERROR_INVAL if an error occurred before
+ */
+int jsmn_stream_finish(jsmn_stream_t *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JSMN_STREAM_H */
+/** @} */
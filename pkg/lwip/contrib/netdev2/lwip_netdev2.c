@@ -49,7 +49,6 @@
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _stack[LWIP_NETDEV2_STACKSIZE];
 static msg_t _queue[LWIP_NETDEV2_QUEUE_LEN];
-static char _tmp_buf[LWIP_NETDEV2_BUFLEN];
 
 #ifdef MODULE_NETDEV2_ETH
 static err_t _eth_link_output(struct netif *netif, struct pbuf *p);
@@ -213,16 +212,25 @@ static err_t _ieee802154_link_output(struct netif *netif, struct pbuf *p)
 
 static struct pbuf *_get_recv_pkt(netdev2_t *dev)
 {
-    int len = dev->driver->recv(dev, _tmp_buf, sizeof(_tmp_buf), NULL);
+    int len = dev->driver->recv(dev, NULL, 0, NULL);
+    struct pbuf *p;
 
+    if (len <= 0) {
+        return NULL;
+    }
     assert(((unsigned)len) <= UINT16_MAX);
-    struct pbuf *p = pbuf_alloc(PBUF_RAW, (u16_t)len, PBUF_POOL);
-
+    /* a single pbuf, so the driver copies the frame right into it */
+    p = pbuf_alloc(PBUF_RAW, (u16_t)len, PBUF_RAM);
     if (p == NULL) {
         DEBUG("lwip_netdev2: can not allocate in pbuf\n");
+        /* drop the frame */
+        dev->driver->recv(dev, NULL, len, NULL);
+        return NULL;
+    }
+    if (dev->driver->recv(dev, p->payload, len, NULL) != len) {
+        pbuf_free(p);
         return NULL;
     }
-    pbuf_take(p, _tmp_buf, len);
     return p;
 }
 
@@ -235,7 +243,8 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event)
         msg.type = LWIP_NETDEV2_MSG_TYPE_EVENT;
         msg.content.ptr = dev;
 
-        if (msg_send(&msg, _pid) <= 0) {
+        /* don't block, the driver may signal from within the thread itself */
+        if (msg_try_send(&msg, _pid) <= 0) {
             DEBUG("lwip_netdev2: possibly lost interrupt.\n");
         }
     }
@@ -250,6 +259,7 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event)
                 }
                 if (netif->input(p, netif) != ERR_OK) {
                     DEBUG("lwip_netdev2: error inputing packet\n");
+                    pbuf_free(p);
                     return;
                 }
             }
@@ -23,13 +23,16 @@
 #include "lwip/opt.h"
 #include "lwip/sys.h"
 
+#include "irq.h"
 #include "msg.h"
-#include "sema.h"
 #include "thread.h"
+#include "thread_flags.h"
 #include "xtimer.h"
 
 #define _MSG_SUCCESS    (0x5cac)
-#define _MSG_TIMEOUT    (0x5cad)
+
+/* a post is a condition signal to the waiter it removed from the queue */
+#define _SEM_FLAG       (THREAD_FLAG_COND_SIGNALED)
 
 void sys_init(void)
 {
@@ -59,40 +62,94 @@ void sys_mutex_free(sys_mutex_t *mutex)
 
 err_t sys_sem_new(sys_sem_t *sem, u8_t count)
 {
-    if (sema_create((sema_t *)sem, (unsigned int)count) < 0) {
-        return ERR_VAL;
-    }
+    sem->value = count;
+    priority_queue_init(&sem->queue);
     return ERR_OK;
 }
 
 void sys_sem_free(sys_sem_t *sem)
 {
-    sema_destroy((sema_t *)sem);
+    (void)sem;
 }
 
 void sys_sem_signal(sys_sem_t *sem)
 {
+    priority_queue_node_t *head;
+    int prio = -1;
+
     LWIP_ASSERT("invalid semaphor", sys_sem_valid(sem));
-    sema_post((sema_t *)sem);
+    unsigned state = irq_disable();
+    sem->value++;
+    head = priority_queue_remove_head(&sem->queue);
+    if (head != NULL) {
+        thread_t *thread = (thread_t *)sched_threads[head->data];
+
+        thread->flags |= _SEM_FLAG;
+        if (thread_flags_wake(thread)) {
+            prio = thread->priority;
+        }
+    }
+    irq_restore(state);
+    if (prio >= 0) {
+        sched_switch(prio);
+    }
 }
 
+/*
+ * Unlike sema_wait_timed(), waiting on thread flags neither takes nor
+ * discards messages sent to the waiting thread. A woken waiter retries, as
+ * another thread may have taken the value in the meantime.
+ */
 u32_t sys_arch_sem_wait(sys_sem_t *sem, u32_t count)
 {
+    thread_t *me = (thread_t *)sched_active_thread;
+    xtimer_t timer = { .target = 0, .long_target = 0 };
+    priority_queue_node_t n;
+    uint64_t start = 0;
+    u32_t res = 0;
+
     LWIP_ASSERT("invalid semaphor", sys_sem_valid(sem));
+    thread_flags_clear(_SEM_FLAG | THREAD_FLAG_TIMEOUT);
     if (count != 0) {
-        uint64_t stop, start;
         start = xtimer_now_usec64();
-        int res = sema_wait_timed((sema_t *)sem, count * MS_IN_USEC);
-        stop = xtimer_now_usec64() - start;
-        if (res == -ETIMEDOUT) {
-            return SYS_ARCH_TIMEOUT;
+        xtimer_set_timeout_flag64(&timer, (uint64_t)count * MS_IN_USEC, me);
+    }
+    while (1) {
+        unsigned state = irq_disable();
+
+        if (sem->value > 0) {
+            sem->value--;
+            irq_restore(state);
+            break;
+        }
+        n.priority = me->priority;
+        n.data = me->pid;
+        n.next = NULL;
+        priority_queue_add(&sem->queue, &n);
+        irq_restore(state);
+
+        if (thread_flags_wait_any(_SEM_FLAG | THREAD_FLAG_TIMEOUT) & _SEM_FLAG) {
+            continue;
         }
-        return (u32_t)(stop / MS_IN_USEC);
+        state = irq_disable();
+        if (me->flags & _SEM_FLAG) {
+            /* posted right after the timeout, the node is already removed */
+            me->flags &= ~_SEM_FLAG;
+            irq_restore(state);
+            continue;
+        }
+        priority_queue_remove(&sem->queue, &n);
+        irq_restore(state);
+        res = SYS_ARCH_TIMEOUT;
+        break;
     }
-    else {
-        sema_wait_timed((sema_t *)sem, 0);
-        return 0;
+    if (count != 0) {
+        xtimer_remove(&timer);
+        if (res != SYS_ARCH_TIMEOUT) {
+            res = (u32_t)((xtimer_now_usec64() - start) / MS_IN_USEC);
+        }
     }
+    return res;
 }
 
 err_t sys_mbox_new(sys_mbox_t *mbox, int size)
@@ -128,37 +185,24 @@ err_t sys_mbox_trypost(sys_mbox_t *mbox, void *msg)
     }
 }
 
-static void _mbox_timeout(void *arg)
-{
-    msg_t m = { .type = _MSG_TIMEOUT };
-    mbox_put(arg, &m);
-}
-
 u32_t sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout)
 {
     msg_t m;
-    xtimer_t timer = { .callback = _mbox_timeout, .arg = &mbox->mbox };
-    uint64_t start, stop;
+    uint64_t start = xtimer_now_usec64();
 
-    start = xtimer_now_usec64();
     if (timeout > 0) {
-        uint64_t u_timeout = (timeout * MS_IN_USEC);
-        _xtimer_set64(&timer, (uint32_t)u_timeout, (uint32_t)(u_timeout >> 32));
+        /* the wait is canceled, so a full mbox does not block the timer */
+        if (xtimer_mbox_get_timeout(&mbox->mbox, &m,
+                                    timeout * MS_IN_USEC) < 0) {
+            return SYS_ARCH_TIMEOUT;
+        }
     }
-    mbox_get(&mbox->mbox, &m);
-    stop = xtimer_now_usec64();
-    xtimer_remove(&timer);  /* in case timer did not time out */
-    switch (m.type) {
-        case _MSG_SUCCESS:
-            *msg = m.content.ptr;
-            return (u32_t)((stop - start) / MS_IN_USEC);
-        case _MSG_TIMEOUT:
-            break;
-        default:    /* should not happen */
-            LWIP_ASSERT("invalid message received", false);
-            break;
+    else {
+        mbox_get(&mbox->mbox, &m);
     }
-    return SYS_ARCH_TIMEOUT;
+    LWIP_ASSERT("invalid message received", (m.type == _MSG_SUCCESS));
+    *msg = m.content.ptr;
+    return (u32_t)((xtimer_now_usec64() - start) / MS_IN_USEC);
 }
 
 u32_t sys_arch_mbox_tryfetch(sys_mbox_t *mbox, void **msg)
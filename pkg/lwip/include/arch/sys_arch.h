@@ -27,8 +27,8 @@
 #include "kernel_types.h"
 #include "mbox.h"
 #include "mutex.h"
+#include "priority_queue.h"
 #include "random.h"
-#include "sema.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,8 +43,15 @@ typedef struct {
     msg_t msgs[SYS_MBOX_SIZE];
 } sys_mbox_t;
 
+/**
+ * @brief   Semaphore, waiters block on thread flags instead of messages
+ */
+typedef struct {
+    volatile unsigned value;    /**< value of the semaphore */
+    priority_queue_t queue;     /**< threads waiting for the semaphore */
+} sys_sem_t;
+
 typedef mutex_t sys_mutex_t;
-typedef sema_t sys_sem_t;
 typedef kernel_pid_t sys_thread_t;
 
 static inline bool sys_mutex_valid(sys_mutex_t *mutex)
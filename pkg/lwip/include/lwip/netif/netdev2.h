@@ -31,14 +31,6 @@
 extern "C" {
 #endif
 
-/**
- * @brief   Length of the temporary copying buffer for receival.
- * @note    It should be as long as the maximum packet length of all the netdev you use.
- */
-#ifndef LWIP_NETDEV2_BUFLEN
-#define LWIP_NETDEV2_BUFLEN     (ETHERNET_MAX_LEN)
-#endif
-
 /**
  * @brief   Initializes the netdev2 adapter.
  *
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_micro-ecc_pinned
+ * @{
+ *
+ * @file
+ * @brief       ECDSA verification with a pinned key
+ *
+ * The comb method splits a scalar k of 4 * d bits into 4 teeth of d bits,
+ * k = k0 + 2^d k1 + 2^2d k2 + 2^3d k3. With the table of all sums of
+ * P, 2^d P, 2^2d P and 2^3d P, k * P takes d doublings and at most d
+ * additions. The doublings are shared between u1 * G and u2 * Q.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "uecc_pinned.h"
+
+#define W           (UECC_PINNED_MAX_WORDS)
+#define TEETH       (4U)
+
+/**
+ * @brief   Point in Jacobian coordinates, (x / z^2, y / z^3), z = 0 is the
+ *          point at infinity
+ */
+typedef struct {
+    uECC_word_t x[W];
+    uECC_word_t y[W];
+    uECC_word_t z[W];
+} _jpoint_t;
+
+static void _dbl(_jpoint_t *p, uECC_Curve curve)
+{
+    const uECC_word_t *mod = uECC_curve_p(curve);
+    wordcount_t nw = uECC_curve_num_words(curve);
+    uECC_word_t delta[W], gamma[W], beta[W], alpha[W], t[W];
+
+    if (uECC_vli_isZero(p->z, nw)) {
+        return;
+    }
+    if (uECC_vli_isZero(p->y, nw)) {
+        uECC_vli_clear(p->z, nw);
+        return;
+    }
+    /* dbl-2001-b, for a = -3 */
+    uECC_vli_modSquare_fast(delta, p->z, curve);
+    uECC_vli_modSquare_fast(gamma, p->y, curve);
+    uECC_vli_modMult_fast(beta, p->x, gamma, curve);
+    /* alpha = 3 * (x - delta) * (x + delta) */
+    uECC_vli_modSub(t, p->x, delta, mod, nw);
+    uECC_vli_modAdd(alpha, p->x, delta, mod, nw);
+    uECC_vli_modMult_fast(alpha, alpha, t, curve);
+    uECC_vli_modAdd(t, alpha, alpha, mod, nw);
+    uECC_vli_modAdd(alpha, alpha, t, mod, nw);
+    /* z3 = (y + z)^2 - gamma - delta */
+    uECC_vli_modAdd(t, p->y, p->z, mod, nw);
+    uECC_vli_modSquare_fast(t, t, curve);
+    uECC_vli_modSub(t, t, gamma, mod, nw);
+    uECC_vli_modSub(p->z, t, delta, mod, nw);
+    /* x3 = alpha^2 - 8 * beta */
+    uECC_vli_modAdd(beta, beta, beta, mod, nw);
+    uECC_vli_modAdd(beta, beta, beta, mod, nw);
+    uECC_vli_modAdd(t, beta, beta, mod, nw);
+    uECC_vli_modSquare_fast(p->x, alpha, curve);
+    uECC_vli_modSub(p->x, p->x, t, mod, nw);
+    /* y3 = alpha * (4 * beta - x3) - 8 * gamma^2 */
+    uECC_vli_modSub(t, beta, p->x, mod, nw);
+    uECC_vli_modMult_fast(t, alpha, t, curve);
+    uECC_vli_modSquare_fast(gamma, gamma, curve);
+    uECC_vli_modAdd(gamma, gamma, gamma, mod, nw);
+    uECC_vli_modAdd(gamma, gamma, gamma, mod, nw);
+    uECC_vli_modAdd(gamma, gamma, gamma, mod, nw);
+    uECC_vli_modSub(p->y, t, gamma, mod, nw);
+}
+
+/* adds the affine point a, given as x followed by y */
+static void _add(_jpoint_t *p, const uECC_word_t *a, uECC_Curve curve)
+{
+    const uECC_word_t *mod = uECC_curve_p(curve);
+    wordcount_t nw = uECC_curve_num_words(curve);
+    uECC_word_t h[W], r[W], hh[W], hhh[W], v[W], t[W];
+
+    if (uECC_vli_isZero(p->z, nw)) {
+        uECC_vli_set(p->x, a, nw);
+        uECC_vli_set(p->y, a + nw, nw);
+        uECC_vli_clear(p->z, nw);
+        p->z[0] = 1;
+        return;
+    }
+    /* madd-2004-hmv */
+    uECC_vli_modSquare_fast(t, p->z, curve);
+    uECC_vli_modMult_fast(h, a, t, curve);
+    uECC_vli_modSub(h, h, p->x, mod, nw);
+    uECC_vli_modMult_fast(t, t, p->z, curve);
+    uECC_vli_modMult_fast(r, a + nw, t, curve);
+    uECC_vli_modSub(r, r, p->y, mod, nw);
+    if (uECC_vli_isZero(h, nw)) {
+        if (uECC_vli_isZero(r, nw)) {
+            _dbl(p, curve);
+        }
+        else {
+            uECC_vli_clear(p->z, nw);
+        }
+        return;
+    }
+    uECC_vli_modSquare_fast(hh, h, curve);
+    uECC_vli_modMult_fast(hhh, hh, h, curve);
+    uECC_vli_modMult_fast(v, p->x, hh, curve);
+    uECC_vli_modMult_fast(p->z, p->z, h, curve);
+    /* x3 = r^2 - h^3 - 2 * v */
+    uECC_vli_modSquare_fast(t, r, curve);
+    uECC_vli_modSub(t, t, hhh, mod, nw);
+    uECC_vli_modSub(t, t, v, mod, nw);
+    uECC_vli_modSub(p->x, t, v, mod, nw);
+    /* y3 = r * (v - x3) - y * h^3 */
+    uECC_vli_modSub(v, v, p->x, mod, nw);
+    uECC_vli_modMult_fast(v, r, v, curve);
+    uECC_vli_modMult_fast(t, p->y, hhh, curve);
+    uECC_vli_modSub(p->y, v, t, mod, nw);
+}
+
+static void _to_affine(const _jpoint_t *p, uECC_word_t *a, uECC_Curve curve)
+{
+    wordcount_t nw = uECC_curve_num_words(curve);
+    uECC_word_t zinv[W], t[W];
+
+    uECC_vli_modInv(zinv, p->z, uECC_curve_p(curve), nw);
+    uECC_vli_modSquare_fast(t, zinv, curve);
+    uECC_vli_modMult_fast(a, p->x, t, curve);
+    uECC_vli_modMult_fast(t, t, zinv, curve);
+    uECC_vli_modMult_fast(a + nw, p->y, t, curve);
+}
+
+static unsigned _cols(uECC_Curve curve)
+{
+    return (uECC_curve_num_n_bits(curve) + TEETH - 1) / TEETH;
+}
+
+/* comb[j - 1] = sum of 2^(t * d) * point for all bits t set in j */
+static void _comb_init(uECC_word_t comb[][2 * W], const uECC_word_t *point,
+                       uECC_Curve curve)
+{
+    wordcount_t nw = uECC_curve_num_words(curve);
+    unsigned cols = _cols(curve);
+
+    uECC_vli_set(comb[0], point, 2 * nw);
+    for (unsigned t = 1; t < TEETH; t++) {
+        uECC_word_t *prev = comb[(1 << (t - 1)) - 1];
+        uECC_word_t *tooth = comb[(1 << t) - 1];
+        _jpoint_t p;
+
+        memset(&p, 0, sizeof(p));
+        _add(&p, prev, curve);
+        for (unsigned i = 0; i < cols; i++) {
+            _dbl(&p, curve);
+        }
+        _to_affine(&p, tooth, curve);
+        for (unsigned j = 1; j < (1U << t); j++) {
+            memset(&p, 0, sizeof(p));
+            _add(&p, comb[j - 1], curve);
+            _add(&p, tooth, curve);
+            _to_affine(&p, comb[(1 << t) + j - 1], curve);
+        }
+    }
+}
+
+static unsigned _comb_index(const uECC_word_t *k, unsigned col,
+                            unsigned cols, unsigned bits)
+{
+    unsigned idx = 0;
+
+    for (unsigned t = 0; t < TEETH; t++) {
+        unsigned bit = col + t * cols;
+
+        if ((bit < bits) && uECC_vli_testBit(k, bit)) {
+            idx |= 1 << t;
+        }
+    }
+    return idx;
+}
+
+int uecc_pinned_init(uecc_pinned_t *key, const uint8_t *public_key,
+                     uECC_Curve curve)
+{
+    wordcount_t nw = uECC_curve_num_words(curve);
+    uECC_word_t q[2 * W];
+
+#if uECC_SUPPORTS_secp256k1
+    /* the doubling assumes a = -3 */
+    if (curve == uECC_secp256k1()) {
+        return -ENOTSUP;
+    }
+#endif
+    /* secp160r1 has an order one bit longer than its field */
+    if ((uECC_curve_num_n_words(curve) != uECC_curve_num_words(curve)) ||
+        (uECC_curve_num_n_bits(curve) % 8)) {
+        return -ENOTSUP;
+    }
+    if (!uECC_valid_public_key(public_key, curve)) {
+        return -EINVAL;
+    }
+    uECC_vli_bytesToNative(q, public_key, uECC_curve_num_bytes(curve));
+    uECC_vli_bytesToNative(q + nw, public_key + uECC_curve_num_bytes(curve),
+                           uECC_curve_num_bytes(curve));
+    key->curve = curve;
+    _comb_init(key->comb[0], uECC_curve_G(curve), curve);
+    _comb_init(key->comb[1], q, curve);
+    return 0;
+}
+
+int uecc_pinned_verify(const uecc_pinned_t *key, const uint8_t *hash,
+                       unsigned hash_size, const uint8_t *signature)
+{
+    uECC_Curve curve = key->curve;
+    const uECC_word_t *n = uECC_curve_n(curve);
+    wordcount_t nw = uECC_curve_num_words(curve);
+    unsigned bytes = uECC_curve_num_n_bytes(curve);
+    unsigned bits = uECC_curve_num_n_bits(curve);
+    unsigned cols = _cols(curve);
+    uECC_word_t r[W], s[W], e[W], w[W], u1[W], u2[W], x[2 * W];
+    _jpoint_t p;
+
+    uECC_vli_bytesToNative(r, signature, bytes);
+    uECC_vli_bytesToNative(s, signature + bytes, bytes);
+    if (uECC_vli_isZero(r, nw) || uECC_vli_isZero(s, nw) ||
+        (uECC_vli_cmp(n, r, nw) != 1) || (uECC_vli_cmp(n, s, nw) != 1)) {
+        return 0;
+    }
+    /* the leftmost bits of the hash, as the order has whole bytes */
+    uECC_vli_clear(e, nw);
+    uECC_vli_bytesToNative(e, hash, (hash_size < bytes) ? hash_size : bytes);
+    if (uECC_vli_cmp(n, e, nw) != 1) {
+        uECC_vli_sub(e, e, n, nw);
+    }
+
+    /* u1 = e / s, u2 = r / s */
+    uECC_vli_modInv(w, s, n, nw);
+    uECC_vli_modMult(u1, e, w, n, nw);
+    uECC_vli_modMult(u2, r, w, n, nw);
+
+    memset(&p, 0, sizeof(p));
+    for (unsigned col = cols; col-- > 0;) {
+        unsigned idx;
+
+        _dbl(&p, curve);
+        idx = _comb_index(u1, col, cols, bits);
+        if (idx != 0) {
+            _add(&p, key->comb[0][idx - 1], curve);
+        }
+        idx = _comb_index(u2, col, cols, bits);
+        if (idx != 0) {
+            _add(&p, key->comb[1][idx - 1], curve);
+        }
+    }
+    if (uECC_vli_isZero(p.z, nw)) {
+        return 0;
+    }
+    _to_affine(&p, x, curve);
+    /* x mod n, the field is less than twice the order */
+    if (uECC_vli_cmp(n, x, nw) != 1) {
+        uECC_vli_sub(x, x, n, nw);
+    }
+    return uECC_vli_cmp(x, r, nw) == 0;
+}
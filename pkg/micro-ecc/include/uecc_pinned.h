@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    pkg_micro-ecc_pinned ECDSA verification with a pinned key
+ * @ingroup     pkg
+ * @brief       Fast ECDSA verification with precomputed tables of a fixed
+ *              public key
+ *
+ * uECC_verify() computes u1 * G + u2 * Q from scratch for every signature,
+ * with one point doubling per bit of the curve order. Devices that verify
+ * many signatures of the same signer, like OTA manifests or the DTLS
+ * handshakes with a single server, can instead pin the signer's key: the
+ * module precomputes a comb table of G and of the key Q once, so a
+ * verification needs only a quarter of the doublings.
+ *
+ * The tables take `2 * 15 * 64` bytes for secp256r1. Supported are the
+ * curves with a = -3 whose order has as many words as their field, i.e.
+ * secp192r1, secp224r1 and secp256r1.
+ *
+ * Verification only uses public data and needs no random numbers.
+ *
+ * @{
+ *
+ * @file
+ * @brief       ECDSA verification with a pinned key
+ */
+
+#ifndef UECC_PINNED_H
+#define UECC_PINNED_H
+
+#include <stdint.h>
+
+#include "uECC.h"
+#include "uECC_vli.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of words of the largest supported curve
+ */
+#define UECC_PINNED_MAX_WORDS   (32 / uECC_WORD_SIZE)
+
+/**
+ * @brief   Number of points of a comb table, all sums of the 4 teeth
+ */
+#define UECC_PINNED_COMB_SIZE   (15U)
+
+/**
+ * @brief   A pinned public key
+ */
+typedef struct {
+    uECC_Curve curve;       /**< the curve of the key */
+    /**
+     * @brief   Comb tables of the generator and the key, affine x and y
+     */
+    uECC_word_t comb[2][UECC_PINNED_COMB_SIZE][2 * UECC_PINNED_MAX_WORDS];
+} uecc_pinned_t;
+
+/**
+ * @brief   Pins a public key
+ *
+ * Validates the key and precomputes its tables, which takes about as long
+ * as one uECC_verify().
+ *
+ * @param[out] key          the pinned key
+ * @param[in] public_key    the public key in the format of micro-ecc
+ * @param[in] curve         the curve of the key
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the key is not a valid point of the curve
+ * @return  -ENOTSUP if the curve is not supported
+ */
+int uecc_pinned_init(uecc_pinned_t *key, const uint8_t *public_key,
+                     uECC_Curve curve);
+
+/**
+ * @brief   Verifies an ECDSA signature with a pinned key
+ *
+ * Drop-in for uECC_verify() with the key pinned.
+ *
+ * @param[in] key           the pinned key
+ * @param[in] hash          the message hash
+ * @param[in] hash_size     size of @p hash in bytes
+ * @param[in] signature     the signature in the format of micro-ecc
+ *
+ * @return  1 if the signature is valid
+ * @return  0 otherwise
+ */
+int uecc_pinned_verify(const uecc_pinned_t *key, const uint8_t *hash,
+                       unsigned hash_size, const uint8_t *signature);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UECC_PINNED_H */
+/** @} */
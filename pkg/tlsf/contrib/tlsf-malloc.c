@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     pkg_tlsf_malloc
+ * @{
+ *
+ * @file
+ * @brief       TLSF-based malloc implementation
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "tlsf-malloc.h"
+
+static mutex_t _lock = MUTEX_INIT;
+static tlsf_malloc_stats_t _stats;
+
+/* must be called with _lock held */
+static void _account(void *ptr, size_t bytes)
+{
+    if (ptr) {
+        _stats.used += tlsf_block_size(ptr);
+        _stats.blocks++;
+        if (_stats.used > _stats.max_used) {
+            _stats.max_used = _stats.used;
+        }
+    }
+    else {
+        _stats.failed++;
+        /* the free bytes would have sufficed if they were not scattered */
+        if ((_stats.pool_size - _stats.used) >= bytes) {
+            _stats.fragmented++;
+        }
+    }
+}
+
+/* must be called with _lock held */
+static void _unaccount(void *ptr)
+{
+    _stats.used -= tlsf_block_size(ptr);
+    _stats.blocks--;
+}
+
+void tlsf_malloc_init(void *mem, size_t bytes)
+{
+    mutex_lock(&_lock);
+    tlsf_create_with_pool(mem, bytes);
+    memset(&_stats, 0, sizeof(_stats));
+    _stats.pool_size = bytes;
+    mutex_unlock(&_lock);
+}
+
+int tlsf_malloc_add_pool(void *mem, size_t bytes)
+{
+    int res = -1;
+
+    mutex_lock(&_lock);
+    if (tlsf_add_pool(mem, bytes)) {
+        _stats.pool_size += bytes;
+        res = 0;
+    }
+    mutex_unlock(&_lock);
+    return res;
+}
+
+void tlsf_malloc_get_stats(tlsf_malloc_stats_t *stats)
+{
+    mutex_lock(&_lock);
+    *stats = _stats;
+    mutex_unlock(&_lock);
+}
+
+void heap_stats(void)
+{
+    tlsf_malloc_stats_t stats;
+
+    tlsf_malloc_get_stats(&stats);
+    printf("heap: %u bytes, used: %u, peak: %u, blocks: %u\n",
+           (unsigned)stats.pool_size, (unsigned)stats.used,
+           (unsigned)stats.max_used, stats.blocks);
+    printf("failed allocations: %lu (%lu due to fragmentation)\n",
+           (unsigned long)stats.failed, (unsigned long)stats.fragmented);
+}
+
+void *TLSF_MALLOC_NAME(malloc)(size_t bytes)
+{
+    mutex_lock(&_lock);
+    void *result = tlsf_malloc(bytes);
+    _account(result, bytes);
+    mutex_unlock(&_lock);
+    return result;
+}
+
+void *TLSF_MALLOC_NAME(calloc)(size_t count, size_t bytes)
+{
+    if (bytes && (count > (SIZE_MAX / bytes))) {
+        return NULL;
+    }
+
+    void *result = TLSF_MALLOC_NAME(malloc)(count * bytes);
+
+    if (result) {
+        memset(result, 0, count * bytes);
+    }
+    return result;
+}
+
+void *TLSF_MALLOC_NAME(memalign)(size_t align, size_t bytes)
+{
+    mutex_lock(&_lock);
+    void *result = tlsf_memalign(align, bytes);
+    _account(result, bytes);
+    mutex_unlock(&_lock);
+    return result;
+}
+
+void *TLSF_MALLOC_NAME(realloc)(void *ptr, size_t size)
+{
+    mutex_lock(&_lock);
+    size_t old = ptr ? tlsf_block_size(ptr) : 0;
+    void *result = tlsf_realloc(ptr, size);
+
+    if (result || !size) {
+        /* the old block was released or resized */
+        _stats.used -= old;
+        _stats.blocks -= (ptr != NULL);
+    }
+    if (size) {
+        _account(result, size);
+    }
+    mutex_unlock(&_lock);
+    return result;
+}
+
+void TLSF_MALLOC_NAME(free)(void *ptr)
+{
+    if (ptr) {
+        mutex_lock(&_lock);
+        _unaccount(ptr);
+        tlsf_free(ptr);
+        mutex_unlock(&_lock);
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    pkg_tlsf_malloc TLSF-based malloc
+ * @ingroup     pkg
+ * @brief       malloc(), free() and friends on top of the TLSF allocator
+ *
+ * Replaces the C library's allocator with TLSF, which allocates and releases
+ * blocks in constant time and keeps fragmentation low, so it is suited for
+ * long running nodes with libraries that allocate and free memory
+ * frequently.
+ *
+ * The heap has to be set up with @ref tlsf_malloc_init() before the first
+ * allocation, more memory can be added with @ref tlsf_malloc_add_pool().
+ * All functions are serialized by a mutex, so they may be called from any
+ * thread, but not from interrupt context.
+ *
+ * The shell command `heap` prints the statistics of the heap.
+ *
+ * @{
+ *
+ * @file
+ * @brief       TLSF-based malloc interface
+ */
+
+#ifndef TLSF_MALLOC_H
+#define TLSF_MALLOC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tlsf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef TLSF_MALLOC_PREFIX
+/**
+ * @brief   Prefix of the allocation functions, empty to replace the C
+ *          library's ones
+ */
+#define TLSF_MALLOC_PREFIX
+#endif
+
+/**
+ * @cond INTERNAL
+ */
+#define __TLSF_MALLOC_NAME(A, B) A ## B
+#define _TLSF_MALLOC_NAME(A, B) __TLSF_MALLOC_NAME(A, B)
+/** @endcond */
+
+/**
+ * @brief   Name of the allocation function @p NAME with TLSF_MALLOC_PREFIX
+ */
+#define TLSF_MALLOC_NAME(NAME) _TLSF_MALLOC_NAME(TLSF_MALLOC_PREFIX, NAME)
+
+/**
+ * @brief   Heap statistics
+ */
+typedef struct {
+    size_t pool_size;           /**< bytes given to the heap */
+    size_t used;                /**< bytes in allocated blocks */
+    size_t max_used;            /**< peak of tlsf_malloc_stats_t::used */
+    unsigned blocks;            /**< number of allocated blocks */
+    uint32_t failed;            /**< failed allocations */
+    uint32_t fragmented;        /**< failed allocations the heap had enough
+                                 *   free bytes for in total */
+} tlsf_malloc_stats_t;
+
+/**
+ * @brief   Set up the heap
+ *
+ * @param[in] mem       memory to manage, 4 byte aligned
+ * @param[in] bytes     size of @p mem, including the allocator's
+ *                      management structures
+ */
+void tlsf_malloc_init(void *mem, size_t bytes);
+
+/**
+ * @brief   Add memory to the heap
+ *
+ * @param[in] mem       memory to add, 4 byte aligned
+ * @param[in] bytes     size of @p mem
+ *
+ * @return  0 on success
+ * @return  -1 if @p mem is too small or too large
+ */
+int tlsf_malloc_add_pool(void *mem, size_t bytes);
+
+/**
+ * @brief   Get a snapshot of the heap statistics
+ *
+ * @param[out] stats    the statistics
+ */
+void tlsf_malloc_get_stats(tlsf_malloc_stats_t *stats);
+
+/**
+ * @name    Allocation functions
+ * @{
+ */
+void *TLSF_MALLOC_NAME(malloc)(size_t bytes);
+void *TLSF_MALLOC_NAME(calloc)(size_t count, size_t bytes);
+void *TLSF_MALLOC_NAME(memalign)(size_t align, size_t bytes);
+void *TLSF_MALLOC_NAME(realloc)(void *ptr, size_t size);
+void TLSF_MALLOC_NAME(free)(void *ptr);
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TLSF_MALLOC_H */
+/** @} */
@@ -18,6 +18,9 @@
  * @}
  */
 
+#include <stdint.h>
+
+#include "assert.h"
 #include "analog_util.h"
 
 /* keep a max value to ADC resolution mapping for quick access in the ROM */
@@ -39,3 +42,69 @@ float adc_util_mapf(int sample, adc_res_t res, float min, float max)
 {
     return ((((max - min) * sample) / val_max[res]) + min);
 }
+
+static uint32_t _isqrt(uint32_t val)
+{
+    uint32_t res = 0;
+    uint32_t bit = (uint32_t)1 << 30;
+
+    while (bit > val) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (val >= res + bit) {
+            val -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+void adc_util_block_stats(const uint16_t *samples, size_t len,
+                          adc_util_stats_t *stats)
+{
+    uint64_t sum = 0;
+    uint64_t sum_sq = 0;
+
+    assert(len > 0);
+    stats->min = UINT16_MAX;
+    stats->max = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint16_t sample = samples[i];
+
+        if (sample < stats->min) {
+            stats->min = sample;
+        }
+        if (sample > stats->max) {
+            stats->max = sample;
+        }
+        sum += sample;
+        sum_sq += (uint32_t)sample * sample;
+    }
+    stats->mean = (uint16_t)(sum / len);
+    /* variance = E[x^2] - E[x]^2, which is below 2^32 for 16 bit samples */
+    stats->rms = (uint16_t)_isqrt((uint32_t)((sum_sq / len) -
+                                             ((sum * sum) / ((uint64_t)len * len))));
+}
+
+size_t adc_util_block_decimate(const uint16_t *in, size_t len,
+                               unsigned factor, uint16_t *out)
+{
+    size_t num;
+
+    assert(factor > 0);
+    num = len / factor;
+    for (size_t i = 0; i < num; i++) {
+        uint32_t sum = 0;
+
+        for (unsigned j = 0; j < factor; j++) {
+            sum += in[(i * factor) + j];
+        }
+        out[i] = (uint16_t)(sum / factor);
+    }
+    return num;
+}
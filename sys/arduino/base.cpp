@@ -39,21 +39,6 @@ void pinMode(int pin, int mode)
     gpio_init(arduino_pinmap[pin], m);
 }
 
-void digitalWrite(int pin, int state)
-{
-    gpio_write(arduino_pinmap[pin], state);
-}
-
-int digitalRead(int pin)
-{
-    if (gpio_read(arduino_pinmap[pin])) {
-        return HIGH;
-    }
-    else {
-        return LOW;
-    }
-}
-
 void delay(int msec)
 {
     xtimer_usleep(1000 * msec);
@@ -61,19 +61,46 @@ void pinMode(int pin, int mode);
 /**
  * @brief   Set the value for the given pin
  *
+ * If @p pin is a constant, the pin is looked up at compile time, and on CPUs
+ * defining PERIPH_GPIO_HAS_FAST the call compiles down to a register write.
+ *
  * @param[in] pin       pin to set
  * @param[in] state     HIGH or LOW
  */
-void digitalWrite(int pin, int state);
+inline void digitalWrite(int pin, int state)
+{
+#ifdef PERIPH_GPIO_HAS_FAST
+    if (__builtin_constant_p(pin)) {
+        if (state) {
+            gpio_fast_set(arduino_pinmap[pin]);
+        }
+        else {
+            gpio_fast_clear(arduino_pinmap[pin]);
+        }
+        return;
+    }
+#endif
+    gpio_write(arduino_pinmap[pin], state);
+}
 
 /**
  * @brief   Read the current state of the given pin
  *
+ * Like digitalWrite(), a constant @p pin is read inline.
+ *
  * @param[in] pin       pin to read
  *
  * @return  state of the given pin, HIGH or LOW
  */
-int digitalRead(int pin);
+inline int digitalRead(int pin)
+{
+#ifdef PERIPH_GPIO_HAS_FAST
+    if (__builtin_constant_p(pin)) {
+        return gpio_fast_read(arduino_pinmap[pin]) ? HIGH : LOW;
+    }
+#endif
+    return gpio_read(arduino_pinmap[pin]) ? HIGH : LOW;
+}
 
 /**
  * @brief   Sleep for a given amount of time [milliseconds]
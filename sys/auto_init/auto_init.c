@@ -15,6 +15,7 @@
  * @author  Hauke Petersen <hauke.petersen@fu-berlin.de>
  * @}
  */
+#include <inttypes.h>
 #include <stdint.h>
 #include <stdio.h>
 
@@ -72,6 +73,10 @@
 #include "net/gnrc/pktdump.h"
 #endif
 
+#ifdef MODULE_GNRC_TCP
+#include "net/gnrc/tcp.h"
+#endif
+
 #ifdef MODULE_GNRC_UDP
 #include "net/gnrc/udp.h"
 #endif
@@ -84,7 +89,7 @@
 #include "net/fib.h"
 #endif
 
-#ifdef MODULE_TINYMT32
+#if defined(MODULE_TINYMT32) || defined(MODULE_RANDOM_SEED_HWRNG)
 #include "random.h"
 #endif
 
@@ -92,18 +97,225 @@
 #include "net/gnrc/coap.h"
 #endif
 
+#ifdef MODULE_THREADPROF
+#include "threadprof.h"
+#endif
+
+#ifdef MODULE_EVENT_THREAD
+#include "event.h"
+#endif
+
+#ifdef MODULE_LOG_DEFERRED
+#include "log.h"
+#endif
+
+#ifdef MODULE_PM_LAYERED_RESIDENCY
+#include "pm_layered.h"
+#endif
+
+#ifdef MODULE_I2C_ASYNC
+#include "i2c_async.h"
+#endif
+
+#ifdef MODULE_SAUL_CACHE
+#include "saul_cache.h"
+#endif
+
+#ifdef MODULE_BOOTPROF
+#include "bootprof.h"
+#endif
+
+#ifdef MODULE_AUTO_INIT_PARALLEL
+#include "mutex.h"
+#include "thread.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#if defined(MODULE_AUTO_INIT_PARALLEL) && defined(DEVELHELP) && \
+    defined(MODULE_XTIMER)
+#define AUTO_INIT_PROFILE
+#endif
+
+/**
+ * @brief   A single initialization step
+ */
+typedef struct {
+    const char *name;       /**< name shown in the boot time breakdown */
+    void (*init)(void);     /**< function doing the initialization */
+} auto_init_step_t;
+
+#ifdef MODULE_AUTO_INIT_SAUL
+extern void auto_init_gpio(void);
+extern void auto_init_adc(void);
+extern void auto_init_lsm303dlhc(void);
+extern void auto_init_lps331ap(void);
+extern void auto_init_isl29020(void);
+extern void auto_init_l3g4200d(void);
+extern void auto_init_lis3dh(void);
+extern void auto_init_mma8652(void);
+extern void auto_init_si70xx(void);
+extern void auto_init_bmp180(void);
+
+/**
+ * @brief   SAUL drivers, terminated by an empty entry
+ */
+static const auto_init_step_t _saul_steps[] = {
+#ifdef MODULE_SAUL_GPIO
+    { "saul_gpio", auto_init_gpio },
+#endif
+#ifdef MODULE_SAUL_ADC
+    { "saul_adc", auto_init_adc },
+#endif
+#ifdef MODULE_LSM303DLHC
+    { "lsm303dlhc", auto_init_lsm303dlhc },
+#endif
+#ifdef MODULE_LPS331AP
+    { "lps331ap", auto_init_lps331ap },
+#endif
+#ifdef MODULE_ISL29020
+    { "isl29020", auto_init_isl29020 },
+#endif
+#ifdef MODULE_L3G4200D
+    { "l3g4200d", auto_init_l3g4200d },
+#endif
+#ifdef MODULE_LIS3DH
+    { "lis3dh", auto_init_lis3dh },
+#endif
+#ifdef MODULE_MMA8652
+    { "mma8652", auto_init_mma8652 },
+#endif
+#ifdef MODULE_SI70XX
+    { "si70xx", auto_init_si70xx },
+#endif
+#ifdef MODULE_BMP180
+    { "bmp180", auto_init_bmp180 },
+#endif
+    { NULL, NULL }
+};
+
+#define SAUL_STEPS_NUMOF    (sizeof(_saul_steps) / sizeof(_saul_steps[0]) - 1)
+#endif /* MODULE_AUTO_INIT_SAUL */
+
+#if defined(AUTO_INIT_PROFILE) || defined(MODULE_BOOTPROF)
+/**
+ * @brief   Phases of auto_init() run by the calling thread
+ */
+enum {
+    AUTO_INIT_PHASE_CORE,           /**< system modules up to the worker */
+    AUTO_INIT_PHASE_NETWORK,        /**< network stack and interfaces */
+    AUTO_INIT_PHASE_SAUL,           /**< SAUL drivers, or waiting for them */
+    AUTO_INIT_PHASE_REST,           /**< anything depending on the above */
+    AUTO_INIT_PHASE_NUMOF
+};
+
+static const char *_phase_names[] = { "core", "network", "saul", "rest" };
+
+#define AUTO_INIT_MARK(phase)       _mark(phase)
+#else
+#define AUTO_INIT_MARK(phase)
+#endif
+
+#ifdef AUTO_INIT_PROFILE
+static uint32_t _phase_time[AUTO_INIT_PHASE_NUMOF];
+static uint32_t _last;
+#ifdef MODULE_AUTO_INIT_SAUL
+static uint32_t _saul_time[SAUL_STEPS_NUMOF];
+#endif
+#endif
+
+#if defined(AUTO_INIT_PROFILE) || defined(MODULE_BOOTPROF)
+static void _mark(unsigned phase)
+{
+#ifdef AUTO_INIT_PROFILE
+    uint32_t now = xtimer_now_usec();
+
+    _phase_time[phase] += now - _last;
+    _last = now;
+#endif
+#ifdef MODULE_BOOTPROF
+    bootprof_mark(_phase_names[phase]);
+#endif
+}
+#endif
+
+#ifdef AUTO_INIT_PROFILE
+
+static void _print_profile(void)
+{
+    uint32_t total = 0;
+
+    puts("auto_init boot time breakdown [us]:");
+    for (unsigned i = 0; i < AUTO_INIT_PHASE_NUMOF; i++) {
+        printf("  %-14s %8" PRIu32 "\n", _phase_names[i], _phase_time[i]);
+        total += _phase_time[i];
+    }
+#ifdef MODULE_AUTO_INIT_SAUL
+    for (unsigned i = 0; i < SAUL_STEPS_NUMOF; i++) {
+        printf("  saul/%-9s %8" PRIu32 "\n", _saul_steps[i].name, _saul_time[i]);
+    }
+#endif
+    printf("  %-14s %8" PRIu32 "\n", "total", total);
+}
+#endif /* AUTO_INIT_PROFILE */
+
+#ifdef MODULE_AUTO_INIT_SAUL
+static void _run_steps(const auto_init_step_t *steps, uint32_t *times)
+{
+    (void)times;
+
+    for (unsigned i = 0; steps[i].init; i++) {
+#ifdef AUTO_INIT_PROFILE
+        uint32_t start = xtimer_now_usec();
+#endif
+        DEBUG("Auto init %s.\n", steps[i].name);
+        steps[i].init();
+#ifdef AUTO_INIT_PROFILE
+        times[i] = xtimer_now_usec() - start;
+#endif
+#ifdef MODULE_BOOTPROF
+        bootprof_mark(steps[i].name);
+#endif
+    }
+}
+#endif
+
+#if defined(MODULE_AUTO_INIT_SAUL) && defined(MODULE_AUTO_INIT_PARALLEL)
+static char _saul_stack[AUTO_INIT_PARALLEL_STACKSIZE];
+static mutex_t _saul_done = MUTEX_INIT_LOCKED;
+
+static void *_saul_thread(void *arg)
+{
+    (void)arg;
+#ifdef AUTO_INIT_PROFILE
+    _run_steps(_saul_steps, _saul_time);
+#else
+    _run_steps(_saul_steps, NULL);
+#endif
+    mutex_unlock(&_saul_done);
+    return NULL;
+}
+#endif
+
 void auto_init(void)
 {
-#ifdef MODULE_TINYMT32
+#if defined(MODULE_RANDOM_SEED_HWRNG)
+    random_seed_hwrng();
+#elif defined(MODULE_TINYMT32)
     random_init(0);
 #endif
 #ifdef MODULE_XTIMER
     DEBUG("Auto init xtimer module.\n");
     xtimer_init();
 #endif
+#ifdef AUTO_INIT_PROFILE
+    _last = xtimer_now_usec();
+#endif
+#ifdef MODULE_PM_LAYERED_RESIDENCY
+    DEBUG("Auto init pm_layered residency accounting.\n");
+    pm_residency_init();
+#endif
 #ifdef MODULE_RTC
     DEBUG("Auto init rtc module.\n");
     rtc_init();
@@ -132,6 +344,30 @@ void auto_init(void)
     extern void profiling_init(void);
     profiling_init();
 #endif
+#ifdef MODULE_THREADPROF
+    DEBUG("Auto init threadprof module.\n");
+    threadprof_init();
+#endif
+#ifdef MODULE_EVENT_THREAD
+    DEBUG("Auto init event_thread module.\n");
+    event_thread_init();
+#endif
+#ifdef MODULE_LOG_DEFERRED
+    DEBUG("Auto init log_deferred module.\n");
+    log_deferred_init();
+#endif
+#ifdef MODULE_I2C_ASYNC
+    DEBUG("Auto init i2c_async module.\n");
+    i2c_async_init();
+#endif
+    AUTO_INIT_MARK(AUTO_INIT_PHASE_CORE);
+#if defined(MODULE_AUTO_INIT_SAUL) && defined(MODULE_AUTO_INIT_PARALLEL)
+    /* the sensors only need xtimer and the peripherals, so bring them up
+     * while the network stack is set up */
+    DEBUG("auto_init SAUL in parallel\n");
+    thread_create(_saul_stack, sizeof(_saul_stack), AUTO_INIT_PARALLEL_PRIO,
+                  THREAD_CREATE_STACKTEST, _saul_thread, NULL, "auto_init");
+#endif
 #ifdef MODULE_GNRC_PKTBUF
     DEBUG("Auto init gnrc_pktbuf module\n");
     gnrc_pktbuf_init();
@@ -148,6 +384,10 @@ void auto_init(void)
     DEBUG("Auto init gnrc_ipv6 module.\n");
     gnrc_ipv6_init();
 #endif
+#ifdef MODULE_GNRC_TCP
+    DEBUG("Auto init TCP module.\n");
+    gnrc_tcp_init();
+#endif
 #ifdef MODULE_GNRC_UDP
     DEBUG("Auto init UDP module.\n");
     gnrc_udp_init();
@@ -250,52 +490,22 @@ void auto_init(void)
     auto_init_gnrc_uhcpc();
 #endif
 
-/* initialize sensors and actuators */
-#ifdef MODULE_AUTO_INIT_SAUL
+    AUTO_INIT_MARK(AUTO_INIT_PHASE_NETWORK);
+#if defined(MODULE_AUTO_INIT_SAUL) && defined(MODULE_AUTO_INIT_PARALLEL)
+    /* wait for the sensors, the SAUL cache and main() expect them */
+    mutex_lock(&_saul_done);
+    AUTO_INIT_MARK(AUTO_INIT_PHASE_SAUL);
+#elif defined(MODULE_AUTO_INIT_SAUL)
+    /* initialize sensors and actuators */
     DEBUG("auto_init SAUL\n");
-
-#ifdef MODULE_SAUL_GPIO
-    extern void auto_init_gpio(void);
-    auto_init_gpio();
-#endif
-#ifdef MODULE_SAUL_ADC
-    extern void auto_init_adc(void);
-    auto_init_adc();
-#endif
-#ifdef MODULE_LSM303DLHC
-    extern void auto_init_lsm303dlhc(void);
-    auto_init_lsm303dlhc();
-#endif
-#ifdef MODULE_LPS331AP
-    extern void auto_init_lps331ap(void);
-    auto_init_lps331ap();
-#endif
-#ifdef MODULE_ISL29020
-    extern void auto_init_isl29020(void);
-    auto_init_isl29020();
-#endif
-#ifdef MODULE_L3G4200D
-    extern void auto_init_l3g4200d(void);
-    auto_init_l3g4200d();
-#endif
-#ifdef MODULE_LIS3DH
-    extern void auto_init_lis3dh(void);
-    auto_init_lis3dh();
-#endif
-#ifdef MODULE_MMA8652
-    extern void auto_init_mma8652(void);
-    auto_init_mma8652();
-#endif
-#ifdef MODULE_SI70XX
-    extern void auto_init_si70xx(void);
-    auto_init_si70xx();
-#endif
-#ifdef MODULE_BMP180
-    extern void auto_init_bmp180(void);
-    auto_init_bmp180();
+    _run_steps(_saul_steps, NULL);
+    AUTO_INIT_MARK(AUTO_INIT_PHASE_SAUL);
 #endif
 
-#endif /* MODULE_AUTO_INIT_SAUL */
+#ifdef MODULE_SAUL_CACHE
+    DEBUG("Auto init SAUL cache\n");
+    saul_cache_init();
+#endif
 
 #ifdef MODULE_AUTO_INIT_GNRC_RPL
 
@@ -305,4 +515,9 @@ void auto_init(void)
 #endif
 
 #endif /* MODULE_AUTO_INIT_GNRC_RPL */
+
+#ifdef AUTO_INIT_PROFILE
+    AUTO_INIT_MARK(AUTO_INIT_PHASE_REST);
+    _print_profile();
+#endif
 }
@@ -23,6 +23,9 @@
 #include "net/gnrc/netdev2.h"
 #include "net/gnrc/netdev2/ieee802154.h"
 #include "net/gnrc.h"
+#ifdef MODULE_GNRC_LWMAC
+#include "net/gnrc/lwmac/lwmac.h"
+#endif
 
 #include "at86rf2xx.h"
 #include "at86rf2xx_params.h"
@@ -34,7 +37,11 @@
  * @brief   Define stack parameters for the MAC layer thread
  * @{
  */
+#ifdef MODULE_GNRC_LWMAC
 #define AT86RF2XX_MAC_STACKSIZE     (THREAD_STACKSIZE_DEFAULT)
+#else
+#define AT86RF2XX_MAC_STACKSIZE     GNRC_NETDEV2_STACKSIZE(THREAD_STACKSIZE_DEFAULT)
+#endif
 #ifndef AT86RF2XX_MAC_PRIO
 #define AT86RF2XX_MAC_PRIO          (GNRC_NETDEV2_MAC_PRIO)
 #endif
@@ -60,11 +67,19 @@ void auto_init_at86rf2xx(void)
             DEBUG("Error initializing AT86RF2xx radio device!\n");
         }
         else {
+#ifdef MODULE_GNRC_LWMAC
+            gnrc_lwmac_init(_at86rf2xx_stacks[i],
+                            AT86RF2XX_MAC_STACKSIZE,
+                            AT86RF2XX_MAC_PRIO,
+                            "at86rf2xx-lwmac",
+                            &gnrc_adpt[i]);
+#else
             gnrc_netdev2_init(_at86rf2xx_stacks[i],
                               AT86RF2XX_MAC_STACKSIZE,
                               AT86RF2XX_MAC_PRIO,
                               "at86rf2xx",
                               &gnrc_adpt[i]);
+#endif
         }
     }
 }
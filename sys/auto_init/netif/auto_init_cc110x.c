@@ -34,7 +34,7 @@
  * @brief   Define stack parameters for the MAC layer thread
  * @{
  */
-#define CC110X_MAC_STACKSIZE     (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
+#define CC110X_MAC_STACKSIZE     GNRC_NETDEV2_STACKSIZE(THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
 #ifndef CC110X_MAC_PRIO
 #define CC110X_MAC_PRIO          (GNRC_NETDEV2_MAC_PRIO)
 #endif
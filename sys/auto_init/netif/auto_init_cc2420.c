@@ -36,7 +36,7 @@
  * @brief   MAC layer stack parameters
  * @{
  */
-#define CC2420_MAC_STACKSIZE           (THREAD_STACKSIZE_MAIN)
+#define CC2420_MAC_STACKSIZE           GNRC_NETDEV2_STACKSIZE(THREAD_STACKSIZE_MAIN)
 #ifndef CC2420_MAC_PRIO
 #define CC2420_MAC_PRIO                (GNRC_NETDEV2_MAC_PRIO)
 #endif
@@ -31,7 +31,7 @@
  * @brief   Define stack parameters for the MAC layer thread
  * @{
  */
-#define CC2538_MAC_STACKSIZE       (THREAD_STACKSIZE_DEFAULT)
+#define CC2538_MAC_STACKSIZE       GNRC_NETDEV2_STACKSIZE(THREAD_STACKSIZE_DEFAULT)
 #ifndef CC2538_MAC_PRIO
 #define CC2538_MAC_PRIO            (GNRC_NETDEV2_MAC_PRIO)
 #endif
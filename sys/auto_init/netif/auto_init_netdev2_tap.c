@@ -32,7 +32,7 @@ extern netdev2_tap_t netdev2_tap;
  * @brief   Define stack parameters for the MAC layer thread
  * @{
  */
-#define TAP_MAC_STACKSIZE           (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
+#define TAP_MAC_STACKSIZE           GNRC_NETDEV2_STACKSIZE(THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
 #ifndef TAP_MAC_PRIO
 #define TAP_MAC_PRIO                (GNRC_NETDEV2_MAC_PRIO)
 #endif
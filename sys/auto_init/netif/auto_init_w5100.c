@@ -31,7 +31,7 @@
  * @brief   Define stack parameters for the MAC layer thread
  * @{
  */
-#define MAC_STACKSIZE   (THREAD_STACKSIZE_DEFAULT)
+#define MAC_STACKSIZE   GNRC_NETDEV2_STACKSIZE(THREAD_STACKSIZE_DEFAULT)
 #define MAC_PRIO        (THREAD_PRIORITY_MAIN - 4)
 /*** @} */
 
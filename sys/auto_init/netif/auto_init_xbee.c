@@ -36,7 +36,7 @@
 /**
  * @brief   Define stack parameters for the MAC layer thread
  */
-#define XBEE_MAC_STACKSIZE           (THREAD_STACKSIZE_DEFAULT)
+#define XBEE_MAC_STACKSIZE           GNRC_NETDEV2_STACKSIZE(THREAD_STACKSIZE_DEFAULT)
 #ifndef XBEE_MAC_PRIO
 #define XBEE_MAC_PRIO                (GNRC_NETDEV2_MAC_PRIO)
 #endif
@@ -13,156 +13,223 @@
  * @file
  * @brief   Functions to encode and decode base64
  *
+ * Both directions work on groups of 3 bytes / 4 characters held in one 32 bit
+ * word. Bytes or characters of an incomplete group are kept in a
+ * base64_ctx_t until the next call.
+ *
  * @author  Martin Landsmann <Martin.Landsmann@HAW-Hamburg.de>
  * @}
  *
  */
 
+#include <stdint.h>
+
 #include "base64.h"
 
-#define BASE64_CAPITAL_UPPER_BOUND     (25)     /**< base64 'Z'           */
-#define BASE64_SMALL_UPPER_BOUND       (51)     /**< base64 'z'           */
-#define BASE64_NUMBER_UPPER_BOUND      (61)     /**< base64 '9'           */
-#define BASE64_PLUS                    (62)     /**< base64 '+'           */
-#define BASE64_SLASH                   (63)     /**< base64 '/'           */
 #define BASE64_EQUALS                  (0xFE)   /**< no base64 symbol '=' */
 #define BASE64_NOT_DEFINED             (0xFF)   /**< no base64 symbol     */
 
+/* flags any value that is not a 6 bit code */
+#define NOT_A_CODE                     (~0x3FU)
+
+static const char _symbols[65] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+#define NA  BASE64_NOT_DEFINED
+#define EQ  BASE64_EQUALS
+/* base64 code of the ascii symbols '+' to 'z' */
+static const uint8_t _codes['z' - '+' + 1] = {
+    62, NA, NA, NA, 63, 52, 53, 54, 55, 56,
+    57, 58, 59, 60, 61, NA, NA, NA, EQ, NA,
+    NA, NA,  0,  1,  2,  3,  4,  5,  6,  7,
+     8,  9, 10, 11, 12, 13, 14, 15, 16, 17,
+    18, 19, 20, 21, 22, 23, 24, 25, NA, NA,
+    NA, NA, NA, NA, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41,
+    42, 43, 44, 45, 46, 47, 48, 49, 50, 51,
+};
+#undef NA
+#undef EQ
+
 /*
- * returns the corresponding ascii symbol value for the given base64 code
+ *  returns the corresponding base64 code for the given ascii symbol
  */
-static char getsymbol(unsigned char code)
+static inline unsigned getcode(unsigned char symbol)
 {
-    if (code == BASE64_SLASH) {
-        return '/';
-    }
+    /* symbols below '+' wrap around to large indices */
+    unsigned idx = (unsigned)symbol - '+';
 
-    if (code == BASE64_PLUS) {
-        return '+';
-    }
+    return (idx < sizeof(_codes)) ? _codes[idx] : BASE64_NOT_DEFINED;
+}
 
-    if (code <= BASE64_CAPITAL_UPPER_BOUND) {
-        return (code + 'A');
-    }
+static inline unsigned char *encode_group(unsigned char *out, uint32_t group)
+{
+    out[0] = _symbols[(group >> 18) & 0x3F];
+    out[1] = _symbols[(group >> 12) & 0x3F];
+    out[2] = _symbols[(group >> 6) & 0x3F];
+    out[3] = _symbols[group & 0x3F];
+    return out + 4;
+}
 
-    if (code <= BASE64_SMALL_UPPER_BOUND) {
-        return (code + ('z' - BASE64_SMALL_UPPER_BOUND));
-    }
+static inline unsigned char *decode_group(unsigned char *out, uint32_t group)
+{
+    out[0] = (unsigned char)(group >> 16);
+    out[1] = (unsigned char)(group >> 8);
+    out[2] = (unsigned char)group;
+    return out + 3;
+}
 
-    if (code <= BASE64_NUMBER_UPPER_BOUND) {
-        return (code + ('9' - BASE64_NUMBER_UPPER_BOUND));
+size_t base64_encode_update(base64_ctx_t *ctx, const unsigned char *data_in,
+                            size_t data_in_size, unsigned char *base64_out)
+{
+    unsigned char *pos = base64_out;
+    uint32_t acc = ctx->acc;
+    unsigned len = ctx->len;
+
+    /* complete the group started by the previous call */
+    if (len) {
+        for (; (len < 3) && data_in_size; len++, data_in_size--) {
+            acc = (acc << 8) | *data_in++;
+        }
+        if (len == 3) {
+            pos = encode_group(pos, acc);
+            acc = 0;
+            len = 0;
+        }
+    }
+    for (; data_in_size >= 3; data_in_size -= 3, data_in += 3) {
+        pos = encode_group(pos, ((uint32_t)data_in[0] << 16) |
+                                ((uint32_t)data_in[1] << 8) | data_in[2]);
+    }
+    for (; data_in_size; len++, data_in_size--) {
+        acc = (acc << 8) | *data_in++;
     }
 
-    return (char)BASE64_NOT_DEFINED;
+    ctx->acc = acc;
+    ctx->len = len;
+    return pos - base64_out;
 }
 
-int base64_encode(unsigned char *data_in, size_t data_in_size, \
-                  unsigned char *base64_out, size_t *base64_out_size)
+size_t base64_encode_finish(base64_ctx_t *ctx, unsigned char *base64_out)
 {
-    size_t required_size = 4 * ((data_in_size + 2) / 3);
-
-    if (data_in == NULL) {
-        return BASE64_ERROR_DATA_IN;
-    }
-
-    if (data_in_size < 1) {
-        return BASE64_ERROR_DATA_IN_SIZE;
-    }
+    unsigned len = ctx->len;
 
-    if (*base64_out_size < required_size) {
-        *base64_out_size = required_size;
-        return BASE64_ERROR_BUFFER_OUT_SIZE;
+    if (len == 0) {
+        return 0;
     }
-
-    if (base64_out == NULL) {
-        return BASE64_ERROR_BUFFER_OUT;
+    /* align the missing bytes as zeros and replace their symbols by '=' */
+    encode_group(base64_out, ctx->acc << (8 * (3 - len)));
+    for (unsigned i = len + 1; i < 4; i++) {
+        base64_out[i] = '=';
     }
 
-    int iterate_base64_buffer = 0;
-    unsigned char nNum = 0;
-    int nLst = 0;
-    int njump = 0;
-
-    for (int i = 0; i < (int)(data_in_size); ++i) {
-        unsigned char tmpval;
-        njump++;
-        tmpval = *(data_in + i);
+    base64_ctx_init(ctx);
+    return 4;
+}
 
-        nNum = (tmpval >> (2 * njump));
+size_t base64_decode_update(base64_ctx_t *ctx, const unsigned char *base64_in,
+                            size_t base64_in_size, unsigned char *data_out)
+{
+    unsigned char *pos = data_out;
+    uint32_t acc = ctx->acc;
+    unsigned len = ctx->len;
+
+    while (base64_in_size) {
+        unsigned code;
+
+        if ((len == 0) && (base64_in_size >= 4)) {
+            unsigned a = getcode(base64_in[0]);
+            unsigned b = getcode(base64_in[1]);
+            unsigned c = getcode(base64_in[2]);
+            unsigned d = getcode(base64_in[3]);
+
+            /* a whole group of valid symbols, no padding or whitespace */
+            if (((a | b | c | d) & NOT_A_CODE) == 0) {
+                pos = decode_group(pos, (a << 18) | (b << 12) | (c << 6) | d);
+                base64_in += 4;
+                base64_in_size -= 4;
+                continue;
+            }
+        }
 
-        if (njump == 4) {
-            nNum = nLst << (8 - 2 * njump);
-            njump = 0;
-            nLst = 0;
-            --i;
+        code = getcode(*base64_in++);
+        base64_in_size--;
+        if (code & NOT_A_CODE) {
+            /* padding and symbols that are no base64 are ignored */
+            continue;
         }
-        else {
-            nNum += nLst << (8 - 2 * njump);
-            nLst =  tmpval & ((1 << njump * 2) - 1);
+        acc = (acc << 6) | code;
+        if (++len == 4) {
+            pos = decode_group(pos, acc);
+            acc = 0;
+            len = 0;
         }
-
-        base64_out[iterate_base64_buffer++] = getsymbol(nNum);
     }
 
-    /* The last character is not finished yet */
-    njump++;
+    ctx->acc = acc;
+    ctx->len = len;
+    return pos - data_out;
+}
 
-    nNum = nLst << (8 - 2 * njump);
-    base64_out[iterate_base64_buffer++] = getsymbol(nNum);
+size_t base64_decode_finish(base64_ctx_t *ctx, unsigned char *data_out)
+{
+    size_t res = 0;
 
-    /* if required we append '=' for the required dividability */
-    while (iterate_base64_buffer % 4) {
-        base64_out[iterate_base64_buffer++] = '=';
+    /* 2 symbols carry 1 byte, 3 symbols 2 bytes, a single one nothing */
+    if (ctx->len == 2) {
+        data_out[0] = (unsigned char)(ctx->acc >> 4);
+        res = 1;
+    }
+    else if (ctx->len == 3) {
+        data_out[0] = (unsigned char)(ctx->acc >> 10);
+        data_out[1] = (unsigned char)(ctx->acc >> 2);
+        res = 2;
     }
 
-    *base64_out_size = iterate_base64_buffer;
-
-    return BASE64_SUCCESS;
+    base64_ctx_init(ctx);
+    return res;
 }
 
-/*
- *  returns the corresponding base64 code for the given ascii symbol
- */
-static int getcode(char symbol)
+int base64_encode(unsigned char *data_in, size_t data_in_size, \
+                  unsigned char *base64_out, size_t *base64_out_size)
 {
-    if (symbol == '/') {
-        return BASE64_SLASH;
-    }
+    size_t required_size = BASE64_ENCODED_LEN(data_in_size);
+    base64_ctx_t ctx = BASE64_CTX_INIT;
+    size_t len;
 
-    if (symbol == '+') {
-        return BASE64_PLUS;
+    if (data_in == NULL) {
+        return BASE64_ERROR_DATA_IN;
     }
 
-    if (symbol == '=') {
-        /* indicates a padded base64 end */
-        return BASE64_EQUALS;
+    if (data_in_size < 1) {
+        return BASE64_ERROR_DATA_IN_SIZE;
     }
 
-    if (symbol < '0') {
-        /* indicates that the given symbol is not base64 and should be ignored */
-        return BASE64_NOT_DEFINED;
+    if (*base64_out_size < required_size) {
+        *base64_out_size = required_size;
+        return BASE64_ERROR_BUFFER_OUT_SIZE;
     }
 
-    if (symbol <= '9' && symbol >= '0') {
-        return (symbol + (BASE64_NUMBER_UPPER_BOUND - '9'));
+    if (base64_out == NULL) {
+        return BASE64_ERROR_BUFFER_OUT;
     }
 
-    if (symbol <= 'Z' && symbol >= 'A') {
-        return (symbol - 'A');
-    }
+    len = base64_encode_update(&ctx, data_in, data_in_size, base64_out);
+    len += base64_encode_finish(&ctx, base64_out + len);
 
-    if (symbol <= 'z' && symbol >= 'a') {
-        return (symbol + (BASE64_SMALL_UPPER_BOUND - 'z'));
-    }
+    *base64_out_size = len;
 
-    /* indicates that the given symbol is not base64 and should be ignored */
-    return BASE64_NOT_DEFINED;
+    return BASE64_SUCCESS;
 }
 
 int base64_decode(unsigned char *base64_in, size_t base64_in_size, \
                   unsigned char *data_out, size_t *data_out_size)
 {
-    size_t required_size = ((base64_in_size / 4) * 3);
+    /* a trailing incomplete group of n > 1 symbols carries n - 1 bytes */
+    size_t rest = base64_in_size % 4;
+    size_t required_size = ((base64_in_size / 4) * 3) + (rest ? rest - 1 : 0);
+    base64_ctx_t ctx = BASE64_CTX_INIT;
+    size_t len;
 
     if (base64_in == NULL) {
         return BASE64_ERROR_DATA_IN;
@@ -181,34 +248,9 @@ int base64_decode(unsigned char *base64_in, size_t base64_in_size, \
         return BASE64_ERROR_BUFFER_OUT;
     }
 
-    int iterate_data_buffer = 0;
-    unsigned char nNum = 0;
-    int nLst = getcode(base64_in[0]) << 2;
-    int code = 0;
-
-    int mask = 2;
-
-    for (int i = 1; i < (int)(base64_in_size); i++) {
-        code = getcode(base64_in[i]);
-
-        if (code == BASE64_NOT_DEFINED || code == BASE64_EQUALS) {
-            continue;
-        }
-
-        int nm = (0xFF << (2 * mask));
-
-        nNum = nLst + ((code & (0xFF & nm)) >> (2 * mask));
-        nLst = (code & (0xFF & ~nm)) << (8 - (2 * mask));
-
-        (mask != 3) ? data_out[iterate_data_buffer++] = nNum : nNum;
-        (mask == 0) ? mask = 3 : mask--;
-    }
-
-    if (code == BASE64_EQUALS) {
-        /* add the last character to the data_out buffer */
-        data_out[iterate_data_buffer] = nNum;
-    }
+    len = base64_decode_update(&ctx, base64_in, base64_in_size, data_out);
+    len += base64_decode_finish(&ctx, data_out + len);
 
-    *data_out_size = iterate_data_buffer;
+    *data_out_size = len;
     return BASE64_SUCCESS;
 }
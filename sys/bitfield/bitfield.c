@@ -19,28 +19,137 @@
  */
 
 #include <stdint.h>
+#include <string.h>
+
+#include "bitarithm.h"
 #include "bitfield.h"
 #include "irq.h"
 
-int bf_get_unset(uint8_t field[], int size)
+#define WORD_BYTES  (sizeof(unsigned))
+
+/* loads up to WORD_BYTES bytes, the first byte into the lowest bits */
+static inline unsigned _load(const uint8_t field[], size_t n)
 {
-    int result = -1;
-    int nbytes = (size + 7) / 8;
-    int i = 0;
+    unsigned w = 0;
 
-    unsigned state = irq_disable();
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (n == WORD_BYTES) {
+        memcpy(&w, field, WORD_BYTES);
+        return w;
+    }
+#endif
+    for (size_t i = 0; i < n; i++) {
+        w |= (unsigned)field[i] << (8 * i);
+    }
+    return w;
+}
+
+/* bits of the bitfield are XORed with flip before searching for a 1 */
+static int _find_next(const uint8_t field[], size_t size, size_t start,
+                      unsigned flip)
+{
+    size_t nbytes = (size + 7) / 8;
+    size_t byte = start / 8;
+    unsigned mask = ~0u << (start % 8);
+
+    if (start >= size) {
+        return -1;
+    }
+    while (byte < nbytes) {
+        size_t n = nbytes - byte;
+
+        if (n > WORD_BYTES) {
+            n = WORD_BYTES;
+        }
+        else if (n < WORD_BYTES) {
+            mask &= (1u << (8 * n)) - 1;
+        }
+        unsigned w = (_load(&field[byte], n) ^ flip) & mask;
+        if (w != 0) {
+            size_t idx = (byte * 8) + bitarithm_lsb(w);
+
+            return (idx < size) ? (int)idx : -1;
+        }
+        byte += n;
+        mask = ~0u;
+    }
+    return -1;
+}
+
+int bf_find_next_set(const uint8_t field[], size_t size, size_t start)
+{
+    return _find_next(field, size, start, 0);
+}
+
+int bf_find_next_unset(const uint8_t field[], size_t size, size_t start)
+{
+    return _find_next(field, size, start, ~0u);
+}
+
+static void _range(uint8_t field[], size_t start, size_t len, uint8_t val)
+{
+    size_t end = start + len;
+
+    /* leading bits up to the next byte boundary */
+    for (; (start < end) && (start % 8); start++) {
+        field[start / 8] = (field[start / 8] & ~(1u << (start % 8))) |
+                           (val & (1u << (start % 8)));
+    }
+    if (start < end) {
+        size_t bytes = (end - start) / 8;
 
-    /* skip full bytes */
-    for (int j = 0; (j < nbytes) && (field[j] == 255); j++) {
-        i += 8;
+        memset(&field[start / 8], val, bytes);
+        start += bytes * 8;
+    }
+    /* trailing bits */
+    for (; start < end; start++) {
+        field[start / 8] = (field[start / 8] & ~(1u << (start % 8))) |
+                           (val & (1u << (start % 8)));
     }
+}
+
+void bf_set_range(uint8_t field[], size_t start, size_t len)
+{
+    _range(field, start, len, 0xff);
+}
+
+void bf_unset_range(uint8_t field[], size_t start, size_t len)
+{
+    _range(field, start, len, 0);
+}
+
+unsigned bf_popcnt(const uint8_t field[], size_t size)
+{
+    unsigned count = 0;
+    size_t full = size / 8;
 
-    for (; i < size; i++) {
-        if (!bf_isset(field, i)) {
-            bf_set(field, i);
-            result = i;
-            break;
+    for (size_t byte = 0; byte < full; byte += WORD_BYTES) {
+        size_t n = full - byte;
+
+        if (n > WORD_BYTES) {
+            n = WORD_BYTES;
         }
+        count += bitarithm_bits_set(_load(&field[byte], n));
+    }
+    if (size % 8) {
+        count += bitarithm_bits_set(field[full] & ((1u << (size % 8)) - 1));
+    }
+    return count;
+}
+
+int bf_get_unset(uint8_t field[], int size)
+{
+    int result = -1;
+
+    if (size <= 0) {
+        return -1;
+    }
+
+    unsigned state = irq_disable();
+
+    result = bf_find_first_unset(field, size);
+    if (result >= 0) {
+        bf_set(field, result);
     }
 
     irq_restore(state);
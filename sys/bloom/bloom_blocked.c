@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @file
+ * @brief   Blocked Bloom filter
+ */
+
+#include <string.h>
+
+#include "bloom.h"
+#include "bitfield.h"
+
+/* the block is picked by the upper bits of h1 by multiply and shift, the
+ * bits within the block by its lower bits, so the two are independent */
+static uint8_t *_block(const bloom_blocked_t *bloom, uint32_t h1)
+{
+    return bloom->a +
+           ((((uint64_t)h1 * bloom->blocks) >> 32) * BLOOM_BLOCK_SIZE);
+}
+
+void bloom_blocked_init(bloom_blocked_t *bloom, uint8_t *blocks,
+                        size_t blocks_numof, unsigned k)
+{
+    bloom->a = blocks;
+    bloom->blocks = blocks_numof;
+    bloom->k = k;
+    memset(blocks, 0, blocks_numof * BLOOM_BLOCK_SIZE);
+}
+
+void bloom_blocked_add(bloom_blocked_t *bloom, const uint8_t *buf, size_t len)
+{
+    uint64_t hash = bloom_hash64(buf, len);
+    uint32_t h1 = (uint32_t)hash;
+    uint32_t h2 = (uint32_t)(hash >> 32) | 1;
+    uint8_t *block = _block(bloom, h1);
+
+    for (unsigned i = 0; i < bloom->k; i++) {
+        bf_set(block, (h1 + i * h2) % BLOOM_BLOCK_BITS);
+    }
+}
+
+bool bloom_blocked_check(const bloom_blocked_t *bloom, const uint8_t *buf,
+                         size_t len)
+{
+    uint64_t hash = bloom_hash64(buf, len);
+    uint32_t h1 = (uint32_t)hash;
+    uint32_t h2 = (uint32_t)(hash >> 32) | 1;
+    uint8_t *block = _block(bloom, h1);
+
+    for (unsigned i = 0; i < bloom->k; i++) {
+        if (!bf_isset(block, (h1 + i * h2) % BLOOM_BLOCK_BITS)) {
+            return false;
+        }
+    }
+    return true;
+}
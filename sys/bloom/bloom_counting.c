@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @file
+ * @brief   Counting Bloom filter with 4 bit counters
+ */
+
+#include <string.h>
+
+#include "bloom.h"
+
+#define COUNTER_MAX     (0xf)
+
+static unsigned _get(const bloom_counting_t *bloom, size_t idx)
+{
+    return (bloom->counters[idx / 2] >> (4 * (idx % 2))) & COUNTER_MAX;
+}
+
+static void _set(bloom_counting_t *bloom, size_t idx, unsigned val)
+{
+    uint8_t *c = &bloom->counters[idx / 2];
+    unsigned shift = 4 * (idx % 2);
+
+    *c = (*c & ~(COUNTER_MAX << shift)) | (val << shift);
+}
+
+static inline size_t _idx(const bloom_counting_t *bloom, uint64_t hash,
+                          unsigned i)
+{
+    uint32_t h1 = (uint32_t)hash;
+    uint32_t h2 = (uint32_t)(hash >> 32) | 1;
+
+    return (uint32_t)(h1 + i * h2) % bloom->m;
+}
+
+void bloom_counting_init(bloom_counting_t *bloom, uint8_t *counters, size_t m,
+                         unsigned k)
+{
+    bloom->counters = counters;
+    bloom->m = m;
+    bloom->k = k;
+    memset(counters, 0, BLOOM_COUNTING_SIZE(m));
+}
+
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf,
+                        size_t len)
+{
+    uint64_t hash = bloom_hash64(buf, len);
+
+    for (unsigned i = 0; i < bloom->k; i++) {
+        size_t idx = _idx(bloom, hash, i);
+        unsigned val = _get(bloom, idx);
+
+        if (val < COUNTER_MAX) {
+            _set(bloom, idx, val + 1);
+        }
+    }
+}
+
+void bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf,
+                           size_t len)
+{
+    uint64_t hash = bloom_hash64(buf, len);
+
+    for (unsigned i = 0; i < bloom->k; i++) {
+        size_t idx = _idx(bloom, hash, i);
+        unsigned val = _get(bloom, idx);
+
+        /* a saturated counter may stand for more keys than it counts */
+        if ((val > 0) && (val < COUNTER_MAX)) {
+            _set(bloom, idx, val - 1);
+        }
+    }
+}
+
+bool bloom_counting_check(const bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len)
+{
+    uint64_t hash = bloom_hash64(buf, len);
+
+    for (unsigned i = 0; i < bloom->k; i++) {
+        if (!_get(bloom, _idx(bloom, hash, i))) {
+            return false;
+        }
+    }
+    return true;
+}
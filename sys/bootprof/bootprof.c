@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_bootprof
+ * @{
+ *
+ * @file
+ * @brief       Boot profiling implementation
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "bootprof.h"
+#include "cpu.h"
+#include "irq.h"
+
+static bootprof_entry_t _table[BOOTPROF_NUMOF];
+static unsigned _numof;
+
+#if defined(CPU_NATIVE)
+#if !defined(__i386__) && !defined(__x86_64__)
+#error "bootprof: no cycle counter on this host"
+#endif
+
+static uint64_t _tsc_start;
+
+void bootprof_start(void)
+{
+    /* the TSC cannot be reset, time stamps are relative to this */
+    _tsc_start = __builtin_ia32_rdtsc();
+}
+
+uint32_t bootprof_cycles(void)
+{
+    return (uint32_t)(__builtin_ia32_rdtsc() - _tsc_start);
+}
+
+#elif defined(DWT_CTRL_CYCCNTENA_Msk)
+void bootprof_start(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t bootprof_cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+#else
+#error "bootprof: no cycle counter on this CPU"
+#endif
+
+void bootprof_mark(const char *name)
+{
+    uint32_t cycles = bootprof_cycles();
+    unsigned state = irq_disable();
+
+    if (_numof < BOOTPROF_NUMOF) {
+        _table[_numof].name = name;
+        _table[_numof].cycles = cycles;
+        _numof++;
+    }
+    irq_restore(state);
+}
+
+const bootprof_entry_t *bootprof_get(unsigned *numof)
+{
+    *numof = _numof;
+    return _table;
+}
+
+void bootprof_print(void)
+{
+    uint32_t last = 0;
+
+    printf("%-16s %10s %10s\n", "phase", "cycles", "delta");
+    for (unsigned i = 0; i < _numof; i++) {
+        printf("%-16s %10" PRIu32 " %10" PRIu32 "\n", _table[i].name,
+               _table[i].cycles, _table[i].cycles - last);
+        last = _table[i].cycles;
+    }
+#ifdef CLOCK_CORECLOCK
+    printf("core clock: %" PRIu32 " Hz\n", (uint32_t)CLOCK_CORECLOCK);
+#endif
+}
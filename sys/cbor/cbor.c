@@ -17,6 +17,7 @@
 
 #include "byteorder.h"
 
+#include <errno.h>
 #include <inttypes.h>
 #include <math.h>
 #include <stdint.h>
@@ -585,6 +586,20 @@ size_t cbor_serialize_byte_stringl(cbor_stream_t *stream, const char *val, size_
     return encode_bytes(CBOR_BYTES, stream, val, length);
 }
 
+unsigned char *cbor_reserve_byte_string(cbor_stream_t *stream, size_t length)
+{
+    size_t length_field_size = uint_bytes_follow(uint_additional_info(length)) + 1;
+    CBOR_ENSURE_SIZE(stream, length_field_size + length);
+
+    if (!encode_int(CBOR_BYTES, stream, (uint64_t) length)) {
+        return NULL;
+    }
+
+    unsigned char *res = &stream->data[stream->pos];
+    stream->pos += length;
+    return res;
+}
+
 size_t cbor_deserialize_unicode_string(const cbor_stream_t *stream, size_t offset, char *val,
                                        size_t length)
 {
@@ -786,6 +801,170 @@ bool cbor_at_end(const cbor_stream_t *s, size_t offset)
     return s ? offset >= s->pos - 1 : true;
 }
 
+void cbor_reader_init(cbor_reader_t *reader, const uint8_t *buf, size_t len)
+{
+    reader->pos = buf;
+    reader->end = buf + len;
+}
+
+int cbor_reader_next(cbor_reader_t *reader, cbor_item_t *item)
+{
+    const uint8_t *pos = reader->pos;
+
+    if (pos >= reader->end) {
+        return -ENOENT;
+    }
+
+    item->type = *pos >> 5;
+    item->info = *pos & CBOR_INFO_MASK;
+    item->value = item->info;
+    item->data = NULL;
+    pos++;
+
+    if (item->info >= CBOR_UINT8_FOLLOWS && item->info <= CBOR_UINT64_FOLLOWS) {
+        unsigned bytes_follow = uint_bytes_follow(item->info);
+
+        if ((size_t)(reader->end - pos) < bytes_follow) {
+            return -EBADMSG;
+        }
+        item->value = 0;
+        while (bytes_follow--) {
+            item->value = (item->value << 8) | *pos++;
+        }
+    }
+    else if (item->info == CBOR_ITEM_INDEFINITE) {
+        /* integers and tags have no indefinite length form */
+        if (item->type <= CBOR_ITEM_NEGINT || item->type == CBOR_ITEM_TAG) {
+            return -EBADMSG;
+        }
+        item->value = 0;
+    }
+    else if (item->info > CBOR_UINT64_FOLLOWS) {
+        return -EBADMSG;
+    }
+
+    if ((item->type == CBOR_ITEM_BYTES || item->type == CBOR_ITEM_TEXT) &&
+        (item->info != CBOR_ITEM_INDEFINITE)) {
+        if (item->value > (uint64_t)(reader->end - pos)) {
+            return -EBADMSG;
+        }
+        item->data = pos;
+        pos += item->value;
+    }
+
+    reader->pos = pos;
+    return 0;
+}
+
+static int _reader_skip(cbor_reader_t *reader, const cbor_item_t *item,
+                        unsigned depth)
+{
+    cbor_item_t child;
+    uint64_t count;
+
+    switch (item->type) {
+        case CBOR_ITEM_ARRAY:
+            count = item->value;
+            break;
+        case CBOR_ITEM_MAP:
+            if (item->value > (UINT64_MAX / 2)) {
+                return -EBADMSG;
+            }
+            count = item->value * 2;
+            break;
+        case CBOR_ITEM_TAG:
+            count = 1;
+            break;
+        case CBOR_ITEM_BYTES:
+        case CBOR_ITEM_TEXT:
+            if (item->info == CBOR_ITEM_INDEFINITE) {
+                break;
+            }
+            return 0;
+        default:
+            return 0;
+    }
+
+    if (depth >= CBOR_READER_MAX_DEPTH) {
+        return -EBADMSG;
+    }
+
+    if (item->info == CBOR_ITEM_INDEFINITE) {
+        while (1) {
+            if ((cbor_reader_next(reader, &child) < 0)) {
+                return -EBADMSG;
+            }
+            if (cbor_item_is_break(&child)) {
+                return 0;
+            }
+            if (_reader_skip(reader, &child, depth + 1) < 0) {
+                return -EBADMSG;
+            }
+        }
+    }
+
+    while (count--) {
+        if ((cbor_reader_next(reader, &child) < 0) ||
+            cbor_item_is_break(&child) ||
+            (_reader_skip(reader, &child, depth + 1) < 0)) {
+            return -EBADMSG;
+        }
+    }
+    return 0;
+}
+
+int cbor_reader_skip(cbor_reader_t *reader, const cbor_item_t *item)
+{
+    return _reader_skip(reader, item, 0);
+}
+
+int cbor_item_get_int64(const cbor_item_t *item, int64_t *val)
+{
+    if ((item->type != CBOR_ITEM_UINT && item->type != CBOR_ITEM_NEGINT) ||
+        (item->value > INT64_MAX)) {
+        return -EINVAL;
+    }
+
+    *val = (item->type == CBOR_ITEM_UINT) ? (int64_t)item->value
+                                          : -1 - (int64_t)item->value;
+    return 0;
+}
+
+#ifndef CBOR_NO_FLOAT
+int cbor_item_get_double(const cbor_item_t *item, double *val)
+{
+    if (item->type != CBOR_ITEM_SIMPLE) {
+        return -EINVAL;
+    }
+
+    switch (item->info) {
+        case CBOR_UINT16_FOLLOWS: {
+            unsigned char half[2] = { item->value >> 8, item->value };
+            *val = decode_float_half(half);
+            return 0;
+        }
+        case CBOR_UINT32_FOLLOWS: {
+            union {
+                float f;
+                uint32_t i;
+            } u = { .i = (uint32_t)item->value };
+            *val = u.f;
+            return 0;
+        }
+        case CBOR_UINT64_FOLLOWS: {
+            union {
+                double d;
+                uint64_t i;
+            } u = { .i = item->value };
+            *val = u.d;
+            return 0;
+        }
+        default:
+            return -EINVAL;
+    }
+}
+#endif /* CBOR_NO_FLOAT */
+
 #ifndef CBOR_NO_PRINT
 /* BEGIN: Printers */
 void cbor_stream_print(const cbor_stream_t *stream)
@@ -23,6 +23,22 @@
 
 #include "checksum/crc16_ccitt.h"
 
+#ifdef MODULE_CRC16_CCITT_NIBBLE
+static const uint16_t _crc16_lookuptable[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef
+};
+
+uint16_t crc16_ccitt_update(uint16_t crc, const unsigned char *buf, size_t len)
+{
+    while (len--) {
+        crc = ((crc << 4) ^ _crc16_lookuptable[(crc >> 12) ^ (*buf >> 4)]);
+        crc = ((crc << 4) ^ _crc16_lookuptable[(crc >> 12) ^ ((*buf++) & 0x0F)]);
+    }
+
+    return crc;
+}
+#else
 static const uint16_t _crc16_lookuptable[256] = {
     0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
     0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
@@ -66,6 +82,7 @@ uint16_t crc16_ccitt_update(uint16_t crc, const unsigned char *buf, size_t len)
 
     return crc;
 }
+#endif
 
 uint16_t crc16_ccitt_calc(const unsigned char *buf, size_t len)
 {
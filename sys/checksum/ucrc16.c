@@ -22,11 +22,29 @@
 #define UINT16_BIT_SIZE             (16U)
 #define LEFTMOST_BIT_SET(value)     ((value) & 0x8000U)
 #define RIGHTMOST_BIT_SET(value)    ((value) & 0x0001U)
+/* below this length building the nibble table costs more than it saves */
+#define NIBBLE_TABLE_MIN            (8U)
 
 uint16_t ucrc16_calc_be(const uint8_t *buf, size_t len, uint16_t poly,
                         uint16_t seed)
 {
     assert(buf != NULL);
+    if (len >= NIBBLE_TABLE_MIN) {
+        uint16_t table[16];
+
+        for (unsigned n = 0; n < 16; n++) {
+            uint32_t tmp = n << (UINT16_BIT_SIZE - 4);
+            for (unsigned i = 0; i < 4; i++) {
+                tmp = LEFTMOST_BIT_SET(tmp) ? ((tmp << 1) ^ poly) : (tmp << 1);
+            }
+            table[n] = tmp & UINT16_MAX;
+        }
+        for (unsigned c = 0; c < len; c++, buf++) {
+            seed = (seed << 4) ^ table[(seed >> 12) ^ (*buf >> 4)];
+            seed = (seed << 4) ^ table[(seed >> 12) ^ (*buf & 0xf)];
+        }
+        return seed;
+    }
     for (unsigned c = 0; c < len; c++, buf++) {
         uint32_t tmp = seed ^ (*buf << (UINT16_BIT_SIZE - UINT8_BIT_SIZE));
         for (unsigned i = 0; i < UINT8_BIT_SIZE; i++) {
@@ -41,6 +59,23 @@ uint16_t ucrc16_calc_le(const uint8_t *buf, size_t len, uint16_t poly,
                         uint16_t seed)
 {
     assert(buf != NULL);
+    if (len >= NIBBLE_TABLE_MIN) {
+        uint16_t table[16];
+
+        for (unsigned n = 0; n < 16; n++) {
+            uint16_t tmp = n;
+            for (unsigned i = 0; i < 4; i++) {
+                tmp = RIGHTMOST_BIT_SET(tmp) ? ((tmp >> 1) ^ poly) : (tmp >> 1);
+            }
+            table[n] = tmp;
+        }
+        for (unsigned c = 0; c < len; c++, buf++) {
+            seed ^= (*buf);
+            seed = (seed >> 4) ^ table[seed & 0xf];
+            seed = (seed >> 4) ^ table[seed & 0xf];
+        }
+        return seed;
+    }
     for (unsigned c = 0; c < len; c++, buf++) {
         seed ^= (*buf);
         for (unsigned i = 0; i < UINT8_BIT_SIZE; i++) {
@@ -24,6 +24,7 @@
 #include "irq.h"
 #include "sched.h"
 #include "thread.h"
+#include "thread_flags.h"
 #include "timex.h"
 #include "xtimer.h"
 #include "priority_queue.h"
@@ -36,17 +37,29 @@ namespace riot {
 
 condition_variable::~condition_variable() { m_queue.first = NULL; }
 
+namespace {
+
+// sets the flag on the thread of a removed queue node, returns the priority
+// if that woke up the thread
+int signal(priority_queue_node_t* head) {
+  thread_t* other_thread = (thread_t*)sched_threads[head->data];
+  if (other_thread) {
+    other_thread->flags |= THREAD_FLAG_COND_SIGNALED;
+    if (thread_flags_wake(other_thread)) {
+      return other_thread->priority;
+    }
+  }
+  return -1;
+}
+
+} // namespace
+
 void condition_variable::notify_one() noexcept {
   unsigned old_state = irq_disable();
   priority_queue_node_t* head = priority_queue_remove_head(&m_queue);
   int other_prio = -1;
   if (head != NULL) {
-    thread_t* other_thread = (thread_t*)sched_threads[head->data];
-    if (other_thread) {
-      other_prio = other_thread->priority;
-      sched_set_status(other_thread, STATUS_PENDING);
-    }
-    head->data = -1u;
+    other_prio = signal(head);
   }
   irq_restore(old_state);
   if (other_prio >= 0) {
@@ -62,14 +75,12 @@ void condition_variable::notify_all() noexcept {
     if (head == NULL) {
       break;
     }
-    thread_t* other_thread = (thread_t*)sched_threads[head->data];
-    if (other_thread) {
+    int prio = signal(head);
+    if (prio >= 0) {
       auto max_prio
         = [](int a, int b) { return (a < 0) ? b : ((a < b) ? a : b); };
-      other_prio = max_prio(other_prio, other_thread->priority);
-      sched_set_status(other_thread, STATUS_PENDING);
+      other_prio = max_prio(other_prio, prio);
     }
-    head->data = -1u;
   }
   irq_restore(old_state);
   if (other_prio >= 0) {
@@ -77,40 +88,62 @@ void condition_variable::notify_all() noexcept {
   }
 }
 
-void condition_variable::wait(unique_lock<mutex>& lock) noexcept {
+cv_status condition_variable::wait_timer(unique_lock<mutex>& lock,
+                                         xtimer_t* timer,
+                                         uint64_t usec) noexcept {
+  thread_t* me = (thread_t*)sched_active_thread;
   priority_queue_node_t n;
-  n.priority = sched_active_thread->priority;
-  n.data = sched_active_pid;
+  n.priority = me->priority;
+  n.data = me->pid;
   n.next = NULL;
+  // left over from an earlier wait that ended by timeout
+  thread_flags_clear(THREAD_FLAG_COND_SIGNALED | THREAD_FLAG_TIMEOUT);
   // the signaling thread may not hold the mutex, the queue is not thread safe
   unsigned old_state = irq_disable();
   priority_queue_add(&m_queue, &n);
   irq_restore(old_state);
-  mutex_unlock_and_sleep(lock.mutex()->native_handle());
-  if (n.data != -1u) {
-    // on signaling n.data is set to -1u
-    // if it isn't set, then the wakeup is either spurious or a timer wakeup
+  if (timer) {
+    xtimer_set_timeout_flag64(timer, usec, me);
+  }
+  // the flag stays set if the signal comes before this thread blocks
+  mutex_unlock(lock.mutex()->native_handle());
+  thread_flags_t flags
+    = thread_flags_wait_any(THREAD_FLAG_COND_SIGNALED | THREAD_FLAG_TIMEOUT);
+  if (timer) {
+    xtimer_remove(timer);
+  }
+  cv_status res = cv_status::no_timeout;
+  if (!(flags & THREAD_FLAG_COND_SIGNALED)) {
     old_state = irq_disable();
-    priority_queue_remove(&m_queue, &n);
+    if (me->flags & THREAD_FLAG_COND_SIGNALED) {
+      // signaled right after the timeout, don't swallow the signal
+      me->flags &= ~THREAD_FLAG_COND_SIGNALED;
+    }
+    else {
+      priority_queue_remove(&m_queue, &n);
+      res = cv_status::timeout;
+    }
     irq_restore(old_state);
   }
   mutex_lock(lock.mutex()->native_handle());
+  return res;
+}
+
+void condition_variable::wait(unique_lock<mutex>& lock) noexcept {
+  wait_timer(lock, NULL, 0);
 }
 
 cv_status condition_variable::wait_until(unique_lock<mutex>& lock,
                                          const time_point& timeout_time) {
+  timex_t now;
+  xtimer_now_timex(&now);
+  if (timex_cmp(timeout_time.native_handle(), now) <= 0) {
+    return cv_status::timeout;
+  }
+  auto diff = timex_sub(timeout_time.native_handle(), now);
   xtimer_t timer;
-  // todo: use function to wait for absolute timepoint once available
-  timex_t before;
-  xtimer_now_timex(&before);
-  auto diff = timex_sub(timeout_time.native_handle(), before);
-  xtimer_set_wakeup(&timer, timex_uint64(diff), sched_active_pid);
-  wait(lock);
-  timex_t after;
-  xtimer_now_timex(&after);
-  xtimer_remove(&timer);
-  auto cmp = timex_cmp(after, timeout_time.native_handle());
-  return cmp < 1 ? cv_status::no_timeout : cv_status::timeout;
+  timer.target = timer.long_target = 0;
+  return wait_timer(lock, &timer, timex_uint64(diff));
 }
 
 } // namespace riot
@@ -79,6 +79,9 @@ class condition_variable {
   condition_variable(const condition_variable&);
   condition_variable& operator=(const condition_variable&);
 
+  cv_status wait_timer(unique_lock<mutex>& lock, xtimer_t* timer,
+                       uint64_t usec) noexcept;
+
   priority_queue_t m_queue;
 };
 
@@ -110,20 +113,14 @@ cv_status condition_variable::wait_for(unique_lock<mutex>& lock,
   if (timeout_duration <= timeout_duration.zero()) {
     return cv_status::timeout;
   }
-  timex_t timeout, before, after;
+  timex_t timeout;
   auto s = duration_cast<seconds>(timeout_duration);
   timeout.seconds = s.count();
   timeout.microseconds
     = (duration_cast<microseconds>(timeout_duration - s)).count();
-  xtimer_now_timex(&before);
   xtimer_t timer;
-  xtimer_set_wakeup(&timer, timex_uint64(timeout), sched_active_pid);
-  wait(lock);
-  xtimer_now_timex(&after);
-  xtimer_remove(&timer);
-  auto passed = timex_sub(after, before);
-  auto cmp = timex_cmp(passed, timeout);
-  return cmp < 1 ? cv_status::no_timeout : cv_status::timeout;
+  timer.target = timer.long_target = 0;
+  return wait_timer(lock, &timer, timex_uint64(timeout));
 }
 
 template <class Rep, class Period, class Predicate>
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   C++ allocator that takes its memory from a memarray pool
+ * @see     <a href="http://en.cppreference.com/w/cpp/concept/Allocator">
+ *            Allocator concept
+ *          </a>
+ *
+ * A pool hands out single elements only, so this suits node based
+ * containers like std::list, std::map or std::set, which allocate one node
+ * per element. The pool's elements must be large enough for a node:
+ *
+ * @code{.cpp}
+ * static uint8_t nodes[16][48];
+ * static memarray_t pool = MEMARRAY_INIT(nodes, 0);
+ *
+ * std::map<int, int, std::less<int>,
+ *          riot::memarray_allocator<std::pair<const int, int>>>
+ *   map{riot::memarray_allocator<std::pair<const int, int>>(pool)};
+ * @endcode
+ *
+ * For contiguous storage use riot::static_vector instead.
+ *
+ * @}
+ */
+
+#ifndef RIOT_MEMARRAY_ALLOCATOR_HPP
+#define RIOT_MEMARRAY_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+#include "memarray.h"
+
+namespace riot {
+
+/**
+ * @brief Allocator for single objects backed by a memarray_t
+ *
+ * Allocating fails with std::bad_alloc if the pool is exhausted, if more
+ * than one object is requested at once or if an object does not fit into
+ * an element of the pool.
+ */
+template <class T>
+class memarray_allocator {
+ public:
+  using value_type = T;
+
+  inline explicit memarray_allocator(memarray_t& pool) noexcept
+      : m_pool{&pool} {}
+  template <class U>
+  inline memarray_allocator(const memarray_allocator<U>& other) noexcept
+      : m_pool{other.pool()} {}
+
+  inline T* allocate(std::size_t n) {
+    void* ptr = nullptr;
+    if ((n == 1) && (sizeof(T) <= m_pool->size)) {
+      ptr = memarray_alloc(m_pool);
+    }
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(ptr);
+  }
+
+  inline void deallocate(T* ptr, std::size_t) noexcept {
+    memarray_free(m_pool, ptr);
+  }
+
+  inline memarray_t* pool() const noexcept { return m_pool; }
+
+ private:
+  memarray_t* m_pool;
+};
+
+template <class T, class U>
+inline bool operator==(const memarray_allocator<T>& lhs,
+                       const memarray_allocator<U>& rhs) noexcept {
+  return lhs.pool() == rhs.pool();
+}
+
+template <class T, class U>
+inline bool operator!=(const memarray_allocator<T>& lhs,
+                       const memarray_allocator<U>& rhs) noexcept {
+  return !(lhs == rhs);
+}
+
+} // namespace riot
+
+#endif // RIOT_MEMARRAY_ALLOCATOR_HPP
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Containers with a capacity fixed at compile time
+ *
+ * The elements are stored inside the container object, so these never
+ * allocate and can be placed in static memory or on the stack.
+ *
+ * @}
+ */
+
+#ifndef RIOT_STATIC_VECTOR_HPP
+#define RIOT_STATIC_VECTOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace riot {
+
+namespace detail {
+
+/**
+ * @brief Uninitialized storage for N objects of type T
+ */
+template <class T, std::size_t N>
+class static_storage {
+ public:
+  inline T* ptr(std::size_t i) noexcept {
+    return reinterpret_cast<T*>(&m_data[i]);
+  }
+  inline const T* ptr(std::size_t i) const noexcept {
+    return reinterpret_cast<const T*>(&m_data[i]);
+  }
+
+ private:
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type m_data[N];
+};
+
+} // namespace detail
+
+/**
+ * @brief Vector with a capacity of N elements
+ * @see   <a href="http://en.cppreference.com/w/cpp/container/vector">
+ *          std::vector
+ *        </a>
+ *
+ * Adding an element to a full vector throws std::length_error.
+ */
+template <class T, std::size_t N>
+class static_vector {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  inline static_vector() noexcept : m_size{0} {}
+  inline static_vector(const static_vector& other) : m_size{0} {
+    for (const auto& val : other) {
+      push_back(val);
+    }
+  }
+  inline static_vector& operator=(const static_vector& other) {
+    if (this != &other) {
+      clear();
+      for (const auto& val : other) {
+        push_back(val);
+      }
+    }
+    return *this;
+  }
+  inline ~static_vector() { clear(); }
+
+  inline iterator begin() noexcept { return m_storage.ptr(0); }
+  inline const_iterator begin() const noexcept { return m_storage.ptr(0); }
+  inline iterator end() noexcept { return m_storage.ptr(m_size); }
+  inline const_iterator end() const noexcept { return m_storage.ptr(m_size); }
+
+  inline size_type size() const noexcept { return m_size; }
+  inline constexpr size_type capacity() const noexcept { return N; }
+  inline bool empty() const noexcept { return m_size == 0; }
+  inline bool full() const noexcept { return m_size == N; }
+
+  inline reference operator[](size_type i) noexcept {
+    return *m_storage.ptr(i);
+  }
+  inline const_reference operator[](size_type i) const noexcept {
+    return *m_storage.ptr(i);
+  }
+  inline reference at(size_type i) {
+    if (i >= m_size) {
+      throw std::out_of_range("static_vector::at");
+    }
+    return *m_storage.ptr(i);
+  }
+  inline const_reference at(size_type i) const {
+    if (i >= m_size) {
+      throw std::out_of_range("static_vector::at");
+    }
+    return *m_storage.ptr(i);
+  }
+  inline reference front() noexcept { return *m_storage.ptr(0); }
+  inline reference back() noexcept { return *m_storage.ptr(m_size - 1); }
+  inline T* data() noexcept { return m_storage.ptr(0); }
+
+  template <class... Args>
+  inline reference emplace_back(Args&&... args) {
+    if (full()) {
+      throw std::length_error("static_vector is full");
+    }
+    T* ptr = new (m_storage.ptr(m_size)) T(std::forward<Args>(args)...);
+    ++m_size;
+    return *ptr;
+  }
+  inline void push_back(const T& val) { emplace_back(val); }
+  inline void push_back(T&& val) { emplace_back(std::move(val)); }
+
+  inline void pop_back() noexcept { m_storage.ptr(--m_size)->~T(); }
+  inline void clear() noexcept {
+    while (m_size) {
+      pop_back();
+    }
+  }
+
+ private:
+  detail::static_storage<T, N> m_storage;
+  size_type m_size;
+};
+
+/**
+ * @brief FIFO ring of up to N elements
+ * @see   <a href="http://en.cppreference.com/w/cpp/container/queue">
+ *          std::queue
+ *        </a>
+ *
+ * Adding an element to a full ring throws std::length_error.
+ */
+template <class T, std::size_t N>
+class static_ring {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = const T&;
+
+  inline static_ring() noexcept : m_head{0}, m_size{0} {}
+  inline ~static_ring() { clear(); }
+
+  inline size_type size() const noexcept { return m_size; }
+  inline constexpr size_type capacity() const noexcept { return N; }
+  inline bool empty() const noexcept { return m_size == 0; }
+  inline bool full() const noexcept { return m_size == N; }
+
+  /**
+   * @brief Returns the i-th element, counted from the oldest one
+   */
+  inline reference operator[](size_type i) noexcept {
+    return *m_storage.ptr(index(i));
+  }
+  inline const_reference operator[](size_type i) const noexcept {
+    return *m_storage.ptr(index(i));
+  }
+  inline reference front() noexcept { return *m_storage.ptr(m_head); }
+  inline reference back() noexcept {
+    return *m_storage.ptr(index(m_size - 1));
+  }
+
+  template <class... Args>
+  inline reference emplace_back(Args&&... args) {
+    if (full()) {
+      throw std::length_error("static_ring is full");
+    }
+    T* ptr = new (m_storage.ptr(index(m_size))) T(std::forward<Args>(args)...);
+    ++m_size;
+    return *ptr;
+  }
+  inline void push_back(const T& val) { emplace_back(val); }
+  inline void push_back(T&& val) { emplace_back(std::move(val)); }
+
+  inline void pop_front() noexcept {
+    m_storage.ptr(m_head)->~T();
+    m_head = (m_head + 1 == N) ? 0 : m_head + 1;
+    --m_size;
+  }
+  inline void clear() noexcept {
+    while (m_size) {
+      pop_front();
+    }
+  }
+
+ private:
+  static_ring(const static_ring&);
+  static_ring& operator=(const static_ring&);
+
+  inline size_type index(size_type i) const noexcept {
+    i += m_head;
+    return (i >= N) ? i - N : i;
+  }
+
+  detail::static_storage<T, N> m_storage;
+  size_type m_head;
+  size_type m_size;
+};
+
+} // namespace riot
+
+#endif // RIOT_STATIC_VECTOR_HPP
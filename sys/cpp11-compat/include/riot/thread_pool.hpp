@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup cpp11-compat
+ * @{
+ *
+ * @file
+ * @brief   Fixed set of worker threads processing a bounded work queue
+ *
+ * The workers and their stacks are created once with the pool, submitting a
+ * task only passes a pointer through a core mbox. Tasks are owned by the
+ * submitter and must stay alive until they are done, so dispatching never
+ * allocates:
+ *
+ * @code{.cpp}
+ * static riot::thread_pool<2> pool;    // in a function, see below
+ *
+ * auto task = riot::make_pool_task([] { return 6 * 7; });
+ * pool.submit(task);
+ * int res = task.get();
+ * @endcode
+ *
+ * All workers take tasks from the same queue, so an idle worker always gets
+ * the next task. RIOT schedules one thread at a time (native included),
+ * which leaves nothing to gain from per-worker queues and work stealing.
+ *
+ * @}
+ */
+
+#ifndef RIOT_THREAD_POOL_HPP
+#define RIOT_THREAD_POOL_HPP
+
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "mbox.h"
+#include "thread.h"
+
+#include "riot/mutex.hpp"
+#include "riot/condition_variable.hpp"
+
+namespace riot {
+
+/**
+ * @brief Type erased part of a task, what the workers operate on
+ */
+class pool_task_base {
+ public:
+  inline pool_task_base(void (*run)(pool_task_base*)) noexcept
+      : m_run{run}, m_done{false} {}
+  /**
+   * @brief Tasks can be moved until they are submitted
+   */
+  inline pool_task_base(pool_task_base&& other) noexcept
+      : m_run{other.m_run}, m_done{other.m_done} {}
+
+  /**
+   * @brief Blocks until the task was run
+   */
+  inline void wait() {
+    unique_lock<mutex> lk(m_mtx);
+    m_cv.wait(lk, [this] { return m_done; });
+  }
+
+  /**
+   * @brief Returns true if the task was run
+   */
+  inline bool ready() {
+    lock_guard<mutex> lk(m_mtx);
+    return m_done;
+  }
+
+  /**
+   * @brief Runs the task and wakes the threads waiting for it
+   */
+  inline void run() {
+    m_run(this);
+    lock_guard<mutex> lk(m_mtx);
+    m_done = true;
+    m_cv.notify_all();
+  }
+
+ protected:
+  std::exception_ptr m_exception;
+
+ private:
+  pool_task_base(const pool_task_base&);
+  pool_task_base& operator=(const pool_task_base&);
+
+  void (*m_run)(pool_task_base*);
+  mutex m_mtx;
+  condition_variable m_cv;
+  bool m_done;
+};
+
+namespace detail {
+
+template <class R>
+struct pool_task_result {
+  template <class F>
+  inline void set(F& f) { m_value = f(); }
+  inline R get() { return std::move(m_value); }
+  R m_value;
+};
+
+template <>
+struct pool_task_result<void> {
+  template <class F>
+  inline void set(F& f) { f(); }
+  inline void get() {}
+};
+
+} // namespace detail
+
+/**
+ * @brief A callable and storage for its result, like std::packaged_task
+ *
+ * Non-void results must be default constructible.
+ */
+template <class F>
+class pool_task : public pool_task_base {
+ public:
+  using result_type = typename std::result_of<F()>::type;
+
+  inline explicit pool_task(F f) : pool_task_base{&pool_task::call},
+                                   m_func(std::move(f)) {}
+  inline pool_task(pool_task&& other)
+      : pool_task_base{std::move(other)}, m_func(std::move(other.m_func)) {}
+
+  /**
+   * @brief Waits for the task and returns its result or rethrows the
+   *        exception it exited with
+   */
+  inline result_type get() {
+    wait();
+    if (m_exception) {
+      std::rethrow_exception(m_exception);
+    }
+    return m_result.get();
+  }
+
+ private:
+  static void call(pool_task_base* base) {
+    auto self = static_cast<pool_task*>(base);
+    try {
+      self->m_result.set(self->m_func);
+    }
+    catch (...) {
+      self->m_exception = std::current_exception();
+    }
+  }
+
+  F m_func;
+  detail::pool_task_result<result_type> m_result;
+};
+
+/**
+ * @brief Creates a pool_task from a callable
+ */
+template <class F>
+inline pool_task<typename std::decay<F>::type> make_pool_task(F&& f) {
+  return pool_task<typename std::decay<F>::type>(std::forward<F>(f));
+}
+
+/**
+ * @brief Pool of @p Workers threads sharing a queue of @p QueueSize tasks
+ *
+ * @tparam Workers    number of worker threads
+ * @tparam QueueSize  number of queued tasks, must be a power of two
+ * @tparam StackSize  stack size of each worker
+ *
+ * The pool creates its workers when constructed, so it must be constructed
+ * by a thread, not as a global object. The destructor waits for the queued
+ * tasks and stops the workers. It must
+ * run in a thread with a lower priority than the workers, so they have
+ * exited before their stacks go away.
+ */
+template <std::size_t Workers, std::size_t QueueSize = 8,
+          std::size_t StackSize = THREAD_STACKSIZE_MAIN>
+class thread_pool {
+  static_assert(Workers > 0, "a pool needs workers");
+  static_assert((QueueSize & (QueueSize - 1)) == 0,
+                "QueueSize must be a power of two");
+
+ public:
+  explicit thread_pool(uint8_t prio = THREAD_PRIORITY_MAIN - 1)
+      : m_running{0} {
+    mbox_init(&m_mbox, m_queue, QueueSize);
+    for (std::size_t i = 0; i < Workers; ++i) {
+      kernel_pid_t pid = thread_create(m_stacks[i], StackSize, prio,
+                                       THREAD_CREATE_WOUT_YIELD |
+                                       THREAD_CREATE_STACKTEST,
+                                       &thread_pool::worker, this,
+                                       "riot_cpp_pool");
+      if (pid < 0) {
+        stop();
+        throw std::system_error(
+          std::make_error_code(std::errc::resource_unavailable_try_again),
+          "Failed to create worker.");
+      }
+      ++m_running;
+    }
+  }
+
+  ~thread_pool() { stop(); }
+
+  /**
+   * @brief Queues a task, blocks while the queue is full
+   */
+  inline void submit(pool_task_base& task) {
+    msg_t msg;
+    msg.content.ptr = &task;
+    mbox_put(&m_mbox, &msg);
+  }
+
+  /**
+   * @brief Queues a task if the queue is not full
+   * @return true if the task was queued
+   */
+  inline bool try_submit(pool_task_base& task) {
+    msg_t msg;
+    msg.content.ptr = &task;
+    return mbox_try_put(&m_mbox, &msg) != 0;
+  }
+
+  /**
+   * @brief Returns the number of workers
+   */
+  inline constexpr std::size_t size() const noexcept { return Workers; }
+
+ private:
+  thread_pool(const thread_pool&);
+  thread_pool& operator=(const thread_pool&);
+
+  static void* worker(void* arg) {
+    auto self = static_cast<thread_pool*>(arg);
+    msg_t msg;
+    while (true) {
+      mbox_get(&self->m_mbox, &msg);
+      if (msg.content.ptr == nullptr) {
+        break;
+      }
+      static_cast<pool_task_base*>(msg.content.ptr)->run();
+    }
+    lock_guard<mutex> lk(self->m_mtx);
+    --self->m_running;
+    self->m_cv.notify_all();
+    return nullptr;
+  }
+
+  void stop() {
+    unique_lock<mutex> lk(m_mtx);
+    msg_t msg;
+    msg.content.ptr = nullptr;
+    for (std::size_t i = 0; i < m_running; ++i) {
+      mbox_put(&m_mbox, &msg);
+    }
+    m_cv.wait(lk, [this] { return m_running == 0; });
+  }
+
+  mbox_t m_mbox;
+  msg_t m_queue[QueueSize];
+  mutex m_mtx;
+  condition_variable m_cv;
+  std::size_t m_running;
+  char m_stacks[Workers][StackSize];
+};
+
+} // namespace riot
+
+#endif // RIOT_THREAD_POOL_HPP
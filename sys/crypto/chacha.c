@@ -39,34 +39,53 @@
 
 #include <string.h>
 
-static void _r(uint32_t *d, uint32_t *a, const uint32_t *b, unsigned c)
-{
-    *a += *b;
-    uint32_t tmp = *a ^ *d;
-    *d = (tmp << c) | (tmp >> (32 - c));
-}
+#define ROTL32(x, n)    (((x) << (n)) | ((x) >> (32 - (n))))
 
+#define QUARTERROUND(a, b, c, d) \
+    a += b; d ^= a; d = ROTL32(d, 16); \
+    c += d; b ^= c; b = ROTL32(b, 12); \
+    a += b; d ^= a; d = ROTL32(d,  8); \
+    c += d; b ^= c; b = ROTL32(b,  7)
+
+/* the state is kept in locals and the quarter-rounds are unrolled, so the
+ * compiler can keep the whole state in registers on e.g. Cortex-M */
 static void _doubleround(void *output_, const uint32_t input[16], uint8_t rounds)
 {
     uint32_t *output = (uint32_t *) output_;
-    memcpy(output, input, 64);
-
-    rounds *= 4;
-    for (unsigned i = 0; i < rounds; ++i) {
-        uint32_t *a = &output[((i + ((i & 4) ? 0 : 0)) & 3) + (4 * 0)];
-        uint32_t *b = &output[((i + ((i & 4) ? 1 : 0)) & 3) + (4 * 1)];
-        uint32_t *c = &output[((i + ((i & 4) ? 2 : 0)) & 3) + (4 * 2)];
-        uint32_t *d = &output[((i + ((i & 4) ? 3 : 0)) & 3) + (4 * 3)];
-
-        _r(d, a, b, 16);
-        _r(b, c, d, 12);
-        _r(d, a, b,  8);
-        _r(b, c, d,  7);
+    uint32_t x0 = input[0], x1 = input[1], x2 = input[2], x3 = input[3];
+    uint32_t x4 = input[4], x5 = input[5], x6 = input[6], x7 = input[7];
+    uint32_t x8 = input[8], x9 = input[9], x10 = input[10], x11 = input[11];
+    uint32_t x12 = input[12], x13 = input[13], x14 = input[14], x15 = input[15];
+
+    for (unsigned i = 0; i < rounds; i += 2) {
+        /* column round */
+        QUARTERROUND(x0, x4,  x8, x12);
+        QUARTERROUND(x1, x5,  x9, x13);
+        QUARTERROUND(x2, x6, x10, x14);
+        QUARTERROUND(x3, x7, x11, x15);
+        /* diagonal round */
+        QUARTERROUND(x0, x5, x10, x15);
+        QUARTERROUND(x1, x6, x11, x12);
+        QUARTERROUND(x2, x7,  x8, x13);
+        QUARTERROUND(x3, x4,  x9, x14);
     }
 
-    for (unsigned i = 0; i < 16; ++i) {
-        output[i] += input[i];
-    }
+    output[0] = x0 + input[0];
+    output[1] = x1 + input[1];
+    output[2] = x2 + input[2];
+    output[3] = x3 + input[3];
+    output[4] = x4 + input[4];
+    output[5] = x5 + input[5];
+    output[6] = x6 + input[6];
+    output[7] = x7 + input[7];
+    output[8] = x8 + input[8];
+    output[9] = x9 + input[9];
+    output[10] = x10 + input[10];
+    output[11] = x11 + input[11];
+    output[12] = x12 + input[12];
+    output[13] = x13 + input[13];
+    output[14] = x14 + input[14];
+    output[15] = x15 + input[15];
 }
 
 int chacha_init(chacha_ctx *ctx,
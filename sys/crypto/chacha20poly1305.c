@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       ChaCha20-Poly1305 authenticated encryption (RFC 8439)
+ *
+ * Encryption and authentication are done in a single pass over the data,
+ * one key stream block at a time.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "crypto/chacha.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/helper.h"
+#include "crypto/poly1305.h"
+
+#define BLOCK_SIZE      (64U)
+/* the 32 bit block counter starts at 1, block 0 is the Poly1305 key */
+#define MAX_INPUT_LEN   ((((uint64_t)1 << 32) - 1) * BLOCK_SIZE)
+
+static const uint8_t _zero[POLY1305_BLOCK_SIZE];
+
+/* the RFC 8439 layout: 32 bit block counter, followed by a 96 bit nonce */
+static void _init(chacha_ctx *chacha, poly1305_ctx_t *poly,
+                  const uint8_t *key, const uint8_t *nonce)
+{
+    uint32_t block[BLOCK_SIZE / sizeof(uint32_t)];
+
+    chacha_init(chacha, 20, key, CHACHA20POLY1305_KEY_SIZE, _zero);
+    chacha->state[12] = 0;
+    memcpy(&chacha->state[13], nonce, CHACHA20POLY1305_NONCE_SIZE);
+
+    chacha_keystream_bytes(chacha, block);
+    poly1305_init(poly, (uint8_t *)block);
+    memset(block, 0, sizeof(block));
+}
+
+static void _pad16(poly1305_ctx_t *poly, size_t len)
+{
+    if (len % POLY1305_BLOCK_SIZE) {
+        poly1305_update(poly, _zero,
+                        POLY1305_BLOCK_SIZE - (len % POLY1305_BLOCK_SIZE));
+    }
+}
+
+/* XORs the key stream onto input, the cipher text is fed to Poly1305 */
+static void _crypt(chacha_ctx *chacha, poly1305_ctx_t *poly,
+                   const uint8_t *input, size_t len, uint8_t *output,
+                   int encrypt)
+{
+    uint32_t block[BLOCK_SIZE / sizeof(uint32_t)];
+
+    while (len) {
+        size_t n = (len < BLOCK_SIZE) ? len : BLOCK_SIZE;
+        const uint8_t *stream = (const uint8_t *)block;
+
+        chacha_keystream_bytes(chacha, block);
+        if (!encrypt) {
+            poly1305_update(poly, input, n);
+        }
+        for (size_t i = 0; i < n; i++) {
+            output[i] = input[i] ^ stream[i];
+        }
+        if (encrypt) {
+            poly1305_update(poly, output, n);
+        }
+        input += n;
+        output += n;
+        len -= n;
+    }
+    memset(block, 0, sizeof(block));
+}
+
+static void _finish(poly1305_ctx_t *poly, size_t aad_len, size_t len,
+                    uint8_t *mac)
+{
+    uint8_t lengths[16];
+    uint64_t l[2] = { aad_len, len };
+
+    for (unsigned i = 0; i < sizeof(lengths); i++) {
+        lengths[i] = (uint8_t)(l[i / 8] >> (8 * (i % 8)));
+    }
+    _pad16(poly, len);
+    poly1305_update(poly, lengths, sizeof(lengths));
+    poly1305_finish(poly, mac);
+}
+
+int chacha20poly1305_encrypt(const uint8_t *key, const uint8_t *nonce,
+                             const uint8_t *aad, size_t aad_len,
+                             const uint8_t *input, size_t input_len,
+                             uint8_t *output)
+{
+    chacha_ctx chacha;
+    poly1305_ctx_t poly;
+
+    if ((uint64_t)input_len > MAX_INPUT_LEN) {
+        return CHACHA20POLY1305_ERR_INVALID_LENGTH;
+    }
+
+    _init(&chacha, &poly, key, nonce);
+    poly1305_update(&poly, aad, aad_len);
+    _pad16(&poly, aad_len);
+    _crypt(&chacha, &poly, input, input_len, output, 1);
+    _finish(&poly, aad_len, input_len, output + input_len);
+    memset(&chacha, 0, sizeof(chacha));
+
+    return input_len + CHACHA20POLY1305_TAG_SIZE;
+}
+
+int chacha20poly1305_decrypt(const uint8_t *key, const uint8_t *nonce,
+                             const uint8_t *aad, size_t aad_len,
+                             const uint8_t *input, size_t input_len,
+                             uint8_t *output)
+{
+    chacha_ctx chacha;
+    poly1305_ctx_t poly;
+    uint8_t mac[CHACHA20POLY1305_TAG_SIZE];
+    size_t len;
+
+    if (input_len < CHACHA20POLY1305_TAG_SIZE) {
+        return CHACHA20POLY1305_ERR_INVALID_LENGTH;
+    }
+    len = input_len - CHACHA20POLY1305_TAG_SIZE;
+
+    _init(&chacha, &poly, key, nonce);
+    poly1305_update(&poly, aad, aad_len);
+    _pad16(&poly, aad_len);
+    _crypt(&chacha, &poly, input, len, output, 0);
+    _finish(&poly, aad_len, len, mac);
+    memset(&chacha, 0, sizeof(chacha));
+
+    if (!crypto_equals(mac, (uint8_t *)input + len, sizeof(mac))) {
+        memset(output, 0, len);
+        return CHACHA20POLY1305_ERR_INVALID_TAG;
+    }
+    return len;
+}
@@ -18,6 +18,14 @@
 #include <stdio.h>
 #include "crypto/ciphers.h"
 
+static cipher_backend_t *_backends;
+
+void cipher_register_backend(cipher_backend_t *backend)
+{
+    backend->next = _backends;
+    _backends = backend;
+}
+
 
 int cipher_init(cipher_t* cipher, cipher_id_t cipher_id, const uint8_t* key,
                 uint8_t key_size)
@@ -26,6 +34,16 @@ int cipher_init(cipher_t* cipher, cipher_id_t cipher_id, const uint8_t* key,
         return CIPHER_ERR_INVALID_KEY_SIZE;
     }
 
+    for (cipher_backend_t *backend = _backends; backend; backend = backend->next) {
+        if ((backend->cipher == cipher_id) &&
+            (key_size <= backend->interface->max_key_size) &&
+            (backend->interface->init(&cipher->context, key,
+                                      key_size) == CIPHER_INIT_SUCCESS)) {
+            cipher->interface = backend->interface;
+            return CIPHER_INIT_SUCCESS;
+        }
+    }
+
     cipher->interface = cipher_id;
     return cipher->interface->init(&cipher->context, key, key_size);
 
@@ -44,6 +62,48 @@ int cipher_decrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output
 }
 
 
+static int _crypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                         uint8_t* output, size_t length, int encrypt)
+{
+    uint8_t block_size = cipher->interface->block_size;
+    int (*crypt_blocks)(const cipher_context_t*, const uint8_t*, uint8_t*,
+                        size_t);
+    int (*crypt)(const cipher_context_t*, const uint8_t*, uint8_t*);
+
+    if (length % block_size != 0) {
+        return CIPHER_ERR_INVALID_LENGTH;
+    }
+
+    crypt_blocks = encrypt ? cipher->interface->encrypt_blocks :
+                             cipher->interface->decrypt_blocks;
+    if (crypt_blocks) {
+        return crypt_blocks(&cipher->context, input, output, length);
+    }
+
+    crypt = encrypt ? cipher->interface->encrypt : cipher->interface->decrypt;
+    for (size_t offset = 0; offset < length; offset += block_size) {
+        if (crypt(&cipher->context, input + offset, output + offset) != 1) {
+            return encrypt ? CIPHER_ERR_ENC_FAILED : CIPHER_ERR_DEC_FAILED;
+        }
+    }
+    return length;
+}
+
+
+int cipher_encrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t length)
+{
+    return _crypt_blocks(cipher, input, output, length, 1);
+}
+
+
+int cipher_decrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t length)
+{
+    return _crypt_blocks(cipher, input, output, length, 0);
+}
+
+
 int cipher_get_block_size(const cipher_t* cipher)
 {
     return cipher->interface->block_size;
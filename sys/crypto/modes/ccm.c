@@ -37,7 +37,8 @@ static inline int min(int a, int b)
 int ccm_compute_cbc_mac(cipher_t* cipher, uint8_t iv[16],
                         uint8_t* input, size_t length, uint8_t* mac)
 {
-    uint8_t offset, block_size, mac_enc[16] = {0};
+    size_t offset;
+    uint8_t block_size, mac_enc[16] = {0};
 
     block_size = cipher_get_block_size(cipher);
     memmove(mac, iv, 16);
@@ -129,16 +130,70 @@ int ccm_compute_adata_mac(cipher_t* cipher, uint8_t* auth_data,
 }
 
 
-int cipher_encrypt_ccm(cipher_t* cipher, uint8_t* auth_data, uint32_t auth_data_len,
-                       uint8_t mac_length, uint8_t length_encoding,
-                       uint8_t* nonce, size_t nonce_len,
-                       uint8_t* input, size_t input_len,
-                       uint8_t* output)
+/**
+ * @brief   Number of key stream blocks generated at once
+ */
+#ifndef CCM_STREAM_BLOCKS
+#define CCM_STREAM_BLOCKS   (4U)
+#endif
+
+/*
+ * Computes the CBC-MAC over the plaintext and en- or decrypts it in counter
+ * mode in a single pass. The key stream is generated a few blocks at a time
+ * with one cipher call, the first time starting with the block for counter
+ * 0, which is returned in @p s0 to encrypt the MAC with.
+ */
+static int _ccm_crypt(cipher_t* cipher, uint8_t counter[16], uint8_t ctr_len,
+                      const uint8_t* input, size_t length, uint8_t* output,
+                      uint8_t mac[16], uint8_t s0[16], int encrypt)
+{
+    uint8_t stream[CCM_STREAM_BLOCKS * 16], block_size;
+    size_t offset = 0, skip;
+
+    block_size = cipher_get_block_size(cipher);
+    skip = block_size;
+    do {
+        size_t chunk = min(length - offset, sizeof(stream) - skip);
+        size_t blocks = (skip + chunk + block_size - 1) / block_size;
+
+        for (size_t i = 0; i < blocks; ++i) {
+            memcpy(&stream[i * block_size], counter, block_size);
+            crypto_block_inc_ctr(counter, ctr_len);
+        }
+        if (cipher_encrypt_blocks(cipher, stream, stream,
+                                  blocks * block_size) < 0) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
+        if (skip) {
+            memcpy(s0, stream, block_size);
+        }
+
+        for (size_t i = 0; i < chunk; i += block_size) {
+            const uint8_t *key = &stream[skip + i];
+            uint8_t block_size_input = min(block_size, chunk - i);
+
+            for (uint8_t j = 0; j < block_size_input; ++j) {
+                uint8_t in = input[offset + i + j];
+                uint8_t plain = encrypt ? in : in ^ key[j];
+
+                output[offset + i + j] = in ^ key[j];
+                mac[j] ^= plain;
+            }
+            if (cipher_encrypt(cipher, mac, mac) != 1) {
+                return CIPHER_ERR_ENC_FAILED;
+            }
+        }
+        offset += chunk;
+        skip = 0;
+    } while (offset < length);
+
+    return offset;
+}
+
+static int _ccm_check(uint8_t mac_length, uint8_t length_encoding,
+                      size_t input_len, uint32_t auth_data_len)
 {
-    int len = -1;
     uint32_t length_max;
-    uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
-                                stream_block[16] = {0}, zero_block[16] = {0}, block_size;
 
     if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
         return CCM_ERR_INVALID_MAC_LENGTH;
@@ -149,35 +204,58 @@ int cipher_encrypt_ccm(cipher_t* cipher, uint8_t* auth_data, uint32_t auth_data_
             input_len - auth_data_len > length_max) {
         return CCM_ERR_INVALID_LENGTH_ENCODING;
     }
+    return 0;
+}
 
+/* computes the MAC IV including the associated data and sets the counter
+ * to counter 0 */
+static int _ccm_start(cipher_t* cipher, uint8_t* auth_data,
+                      uint32_t auth_data_len, uint8_t mac_length,
+                      uint8_t length_encoding, uint8_t* nonce,
+                      size_t nonce_len, size_t plain_len, uint8_t mac[16],
+                      uint8_t counter[16])
+{
     /* Create B0, encrypt it (X1) and use it as mac_iv */
-    block_size = cipher_get_block_size(cipher);
     if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, input_len, mac_iv) < 0) {
+                          nonce, nonce_len, plain_len, mac) < 0) {
         return CCM_ERR_INVALID_DATA_LENGTH;
     }
 
-    /* MAC calulation (T) with additional data and plaintext */
-    ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
-    len = ccm_compute_cbc_mac(cipher, mac_iv, input, input_len, mac);
+    /* MAC calulation (T) with additional data */
+    ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac);
+
+    memset(counter, 0, 16);
+    counter[0] = length_encoding - 1;
+    memcpy(&counter[1], nonce, min(nonce_len, (size_t) 15 - length_encoding));
+    return 0;
+}
+
+
+int cipher_encrypt_ccm(cipher_t* cipher, uint8_t* auth_data, uint32_t auth_data_len,
+                       uint8_t mac_length, uint8_t length_encoding,
+                       uint8_t* nonce, size_t nonce_len,
+                       uint8_t* input, size_t input_len,
+                       uint8_t* output)
+{
+    int len;
+    uint8_t nonce_counter[16], mac[16], stream_block[16];
+
+    len = _ccm_check(mac_length, length_encoding, input_len, auth_data_len);
     if (len < 0) {
         return len;
     }
 
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    memcpy(&nonce_counter[1], nonce,
-           min(nonce_len, (size_t) 15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size,
-                             zero_block, block_size, stream_block);
+    len = _ccm_start(cipher, auth_data, auth_data_len, mac_length,
+                     length_encoding, nonce, nonce_len, input_len, mac,
+                     nonce_counter);
     if (len < 0) {
         return len;
     }
 
-    /* Encrypt message in counter mode  */
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             input_len, output);
+    /* MAC over the plaintext and counter mode encryption in one go */
+    len = _ccm_crypt(cipher, nonce_counter,
+                     cipher_get_block_size(cipher) - nonce_len, input,
+                     input_len, output, mac, stream_block, 1);
     if (len < 0) {
         return len;
     }
@@ -196,50 +274,30 @@ int cipher_decrypt_ccm(cipher_t* cipher, uint8_t* auth_data,
                        uint8_t length_encoding, uint8_t* nonce, size_t nonce_len,
                        uint8_t* input, size_t input_len, uint8_t* plain)
 {
-    int len = -1;
-    uint32_t length_max;
-    uint8_t nonce_counter[16] = {0}, mac_iv[16] = {0}, mac[16] = {0},
-                                mac_recv[16] = {0}, stream_block[16] = {0}, zero_block[16] = {0},
-                                        plain_len, block_size;
+    int len;
+    size_t plain_len;
+    uint8_t nonce_counter[16], mac[16], mac_recv[16], stream_block[16];
 
-    if (mac_length % 2 != 0  || mac_length < 4 || mac_length > 16) {
-        return CCM_ERR_INVALID_MAC_LENGTH;
-    }
-
-    length_max = 2 << (8 * length_encoding);
-    if (length_encoding < 2 || length_encoding > 8 ||
-            input_len - auth_data_len > length_max) {
-        return CCM_ERR_INVALID_LENGTH_ENCODING;
-    }
-
-    /* Compute first stream block */
-    nonce_counter[0] = length_encoding - 1;
-    block_size = cipher_get_block_size(cipher);
-    memcpy(&nonce_counter[1], nonce, min(nonce_len, (size_t) 15 - length_encoding));
-    len = cipher_encrypt_ctr(cipher, nonce_counter, block_size, zero_block,
-                             block_size, stream_block);
+    len = _ccm_check(mac_length, length_encoding, input_len, auth_data_len);
     if (len < 0) {
         return len;
     }
+    if (input_len < mac_length) {
+        return CCM_ERR_INVALID_DATA_LENGTH;
+    }
 
-    /* Decrypt message in counter mode */
     plain_len = input_len - mac_length;
-    crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
-    len = cipher_encrypt_ctr(cipher, nonce_counter, nonce_len, input,
-                             plain_len, plain);
+    len = _ccm_start(cipher, auth_data, auth_data_len, mac_length,
+                     length_encoding, nonce, nonce_len, plain_len, mac,
+                     nonce_counter);
     if (len < 0) {
         return len;
     }
 
-    /* Create B0, encrypt it (X1) and use it as mac_iv */
-    if (ccm_create_mac_iv(cipher, auth_data_len, mac_length, length_encoding,
-                          nonce, nonce_len, plain_len, mac_iv) < 0) {
-        return CCM_ERR_INVALID_DATA_LENGTH;
-    }
-
-    /* MAC calulation (T) with additional data and plaintext */
-    ccm_compute_adata_mac(cipher, auth_data, auth_data_len, mac_iv);
-    len = ccm_compute_cbc_mac(cipher, mac_iv, plain, plain_len, mac);
+    /* counter mode decryption and MAC over the plaintext in one go */
+    len = _ccm_crypt(cipher, nonce_counter,
+                     cipher_get_block_size(cipher) - nonce_len, input,
+                     plain_len, plain, mac, stream_block, 0);
     if (len < 0) {
         return len;
     }
@@ -18,9 +18,52 @@
 * @}
 */
 
+#include <string.h>
+
 #include "crypto/helper.h"
 #include "crypto/modes/ctr.h"
 
+/**
+ * @brief   Number of key stream blocks generated at once if the cipher
+ *          implementation can encrypt multiple blocks in one go
+ */
+#ifndef CTR_STREAM_BLOCKS
+#define CTR_STREAM_BLOCKS   (4U)
+#endif
+
+static int _encrypt_ctr_multi(cipher_t* cipher, uint8_t nonce_counter[16],
+                              uint8_t nonce_len, uint8_t* input,
+                              size_t length, uint8_t* output)
+{
+    size_t offset = 0;
+    uint8_t stream[CTR_STREAM_BLOCKS * 16], block_size;
+
+    block_size = cipher_get_block_size(cipher);
+    do {
+        size_t chunk = length - offset;
+        size_t blocks;
+
+        if (chunk > (CTR_STREAM_BLOCKS * block_size)) {
+            chunk = CTR_STREAM_BLOCKS * block_size;
+        }
+        blocks = (chunk + block_size - 1) / block_size;
+        for (size_t i = 0; i < blocks; ++i) {
+            memcpy(&stream[i * block_size], nonce_counter, block_size);
+            crypto_block_inc_ctr(nonce_counter, block_size - nonce_len);
+        }
+        if (cipher_encrypt_blocks(cipher, stream, stream,
+                                  blocks * block_size) < 0) {
+            return CIPHER_ERR_ENC_FAILED;
+        }
+        for (size_t i = 0; i < chunk; ++i) {
+            output[offset + i] = stream[i] ^ input[offset + i];
+        }
+        offset += chunk;
+    } while (offset < length);
+
+    return offset;
+}
+
 int cipher_encrypt_ctr(cipher_t* cipher, uint8_t nonce_counter[16],
                        uint8_t nonce_len, uint8_t* input, size_t length,
                        uint8_t* output)
@@ -28,6 +71,11 @@ int cipher_encrypt_ctr(cipher_t* cipher, uint8_t nonce_counter[16],
     size_t offset = 0;
     uint8_t stream_block[16] = {0}, block_size;
 
+    if (cipher->interface->encrypt_blocks) {
+        return _encrypt_ctr_multi(cipher, nonce_counter, nonce_len, input,
+                                  length, output);
+    }
+
     block_size = cipher_get_block_size(cipher);
     do {
         uint8_t block_size_input;
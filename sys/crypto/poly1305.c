@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Poly1305 with 32 bit limbs, after Andrew Moon's poly1305-donna
+ *
+ * The accumulator is kept in five 26 bit limbs, so all products fit into
+ * 64 bit without carries in between. Runs in constant time.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "crypto/poly1305.h"
+
+static inline uint32_t _load32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void _store32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/* hibit is 1 << 24 for full blocks, 0 for the padded final one */
+static void _blocks(poly1305_ctx_t *ctx, const uint8_t *m, size_t len,
+                    uint32_t hibit)
+{
+    const uint32_t r0 = ctx->r[0], r1 = ctx->r[1], r2 = ctx->r[2];
+    const uint32_t r3 = ctx->r[3], r4 = ctx->r[4];
+    const uint32_t s1 = r1 * 5, s2 = r2 * 5, s3 = r3 * 5, s4 = r4 * 5;
+    uint32_t h0 = ctx->h[0], h1 = ctx->h[1], h2 = ctx->h[2];
+    uint32_t h3 = ctx->h[3], h4 = ctx->h[4];
+
+    while (len >= POLY1305_BLOCK_SIZE) {
+        uint64_t d0, d1, d2, d3, d4;
+        uint32_t c;
+
+        /* h += m */
+        h0 += (_load32(m + 0)) & 0x3ffffff;
+        h1 += (_load32(m + 3) >> 2) & 0x3ffffff;
+        h2 += (_load32(m + 6) >> 4) & 0x3ffffff;
+        h3 += (_load32(m + 9) >> 6) & 0x3ffffff;
+        h4 += (_load32(m + 12) >> 8) | hibit;
+
+        /* h *= r, the 2^130 overflow wraps around times 5 */
+        d0 = ((uint64_t)h0 * r0) + ((uint64_t)h1 * s4) + ((uint64_t)h2 * s3) +
+             ((uint64_t)h3 * s2) + ((uint64_t)h4 * s1);
+        d1 = ((uint64_t)h0 * r1) + ((uint64_t)h1 * r0) + ((uint64_t)h2 * s4) +
+             ((uint64_t)h3 * s3) + ((uint64_t)h4 * s2);
+        d2 = ((uint64_t)h0 * r2) + ((uint64_t)h1 * r1) + ((uint64_t)h2 * r0) +
+             ((uint64_t)h3 * s4) + ((uint64_t)h4 * s3);
+        d3 = ((uint64_t)h0 * r3) + ((uint64_t)h1 * r2) + ((uint64_t)h2 * r1) +
+             ((uint64_t)h3 * r0) + ((uint64_t)h4 * s4);
+        d4 = ((uint64_t)h0 * r4) + ((uint64_t)h1 * r3) + ((uint64_t)h2 * r2) +
+             ((uint64_t)h3 * r1) + ((uint64_t)h4 * r0);
+
+        /* partial reduction mod 2^130 - 5 */
+        c = (uint32_t)(d0 >> 26); h0 = (uint32_t)d0 & 0x3ffffff;
+        d1 += c; c = (uint32_t)(d1 >> 26); h1 = (uint32_t)d1 & 0x3ffffff;
+        d2 += c; c = (uint32_t)(d2 >> 26); h2 = (uint32_t)d2 & 0x3ffffff;
+        d3 += c; c = (uint32_t)(d3 >> 26); h3 = (uint32_t)d3 & 0x3ffffff;
+        d4 += c; c = (uint32_t)(d4 >> 26); h4 = (uint32_t)d4 & 0x3ffffff;
+        h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+        h1 += c;
+
+        m += POLY1305_BLOCK_SIZE;
+        len -= POLY1305_BLOCK_SIZE;
+    }
+
+    ctx->h[0] = h0;
+    ctx->h[1] = h1;
+    ctx->h[2] = h2;
+    ctx->h[3] = h3;
+    ctx->h[4] = h4;
+}
+
+void poly1305_init(poly1305_ctx_t *ctx, const uint8_t *key)
+{
+    /* r &= 0xffffffc0ffffffc0ffffffc0fffffff */
+    ctx->r[0] = (_load32(key + 0)) & 0x3ffffff;
+    ctx->r[1] = (_load32(key + 3) >> 2) & 0x3ffff03;
+    ctx->r[2] = (_load32(key + 6) >> 4) & 0x3ffc0ff;
+    ctx->r[3] = (_load32(key + 9) >> 6) & 0x3f03fff;
+    ctx->r[4] = (_load32(key + 12) >> 8) & 0x00fffff;
+
+    memset(ctx->h, 0, sizeof(ctx->h));
+
+    for (unsigned i = 0; i < 4; i++) {
+        ctx->pad[i] = _load32(key + 16 + (4 * i));
+    }
+    ctx->left = 0;
+}
+
+void poly1305_update(poly1305_ctx_t *ctx, const uint8_t *data, size_t len)
+{
+    if (ctx->left) {
+        size_t want = POLY1305_BLOCK_SIZE - ctx->left;
+
+        if (want > len) {
+            want = len;
+        }
+        memcpy(ctx->buf + ctx->left, data, want);
+        ctx->left += want;
+        data += want;
+        len -= want;
+        if (ctx->left < POLY1305_BLOCK_SIZE) {
+            return;
+        }
+        _blocks(ctx, ctx->buf, POLY1305_BLOCK_SIZE, 1UL << 24);
+        ctx->left = 0;
+    }
+
+    if (len >= POLY1305_BLOCK_SIZE) {
+        size_t full = len & ~(size_t)(POLY1305_BLOCK_SIZE - 1);
+
+        _blocks(ctx, data, full, 1UL << 24);
+        data += full;
+        len -= full;
+    }
+
+    if (len) {
+        memcpy(ctx->buf, data, len);
+        ctx->left = len;
+    }
+}
+
+void poly1305_finish(poly1305_ctx_t *ctx, uint8_t *mac)
+{
+    uint32_t h0, h1, h2, h3, h4, c;
+    uint32_t g0, g1, g2, g3, g4, mask;
+    uint64_t f;
+
+    /* the last partial block is terminated by a 1 byte instead of bit 128 */
+    if (ctx->left) {
+        ctx->buf[ctx->left] = 1;
+        memset(ctx->buf + ctx->left + 1, 0,
+               POLY1305_BLOCK_SIZE - ctx->left - 1);
+        _blocks(ctx, ctx->buf, POLY1305_BLOCK_SIZE, 0);
+    }
+
+    /* fully carry h */
+    h0 = ctx->h[0]; h1 = ctx->h[1]; h2 = ctx->h[2];
+    h3 = ctx->h[3]; h4 = ctx->h[4];
+    c = h1 >> 26; h1 &= 0x3ffffff;
+    h2 += c; c = h2 >> 26; h2 &= 0x3ffffff;
+    h3 += c; c = h3 >> 26; h3 &= 0x3ffffff;
+    h4 += c; c = h4 >> 26; h4 &= 0x3ffffff;
+    h0 += c * 5; c = h0 >> 26; h0 &= 0x3ffffff;
+    h1 += c;
+
+    /* g = h + -p, select g if h >= p without branching */
+    g0 = h0 + 5; c = g0 >> 26; g0 &= 0x3ffffff;
+    g1 = h1 + c; c = g1 >> 26; g1 &= 0x3ffffff;
+    g2 = h2 + c; c = g2 >> 26; g2 &= 0x3ffffff;
+    g3 = h3 + c; c = g3 >> 26; g3 &= 0x3ffffff;
+    g4 = h4 + c - (1UL << 26);
+
+    mask = (g4 >> 31) - 1;
+    g0 &= mask; g1 &= mask; g2 &= mask; g3 &= mask; g4 &= mask;
+    mask = ~mask;
+    h0 = (h0 & mask) | g0;
+    h1 = (h1 & mask) | g1;
+    h2 = (h2 & mask) | g2;
+    h3 = (h3 & mask) | g3;
+    h4 = (h4 & mask) | g4;
+
+    /* h = h % 2^128 */
+    h0 = (h0) | (h1 << 26);
+    h1 = (h1 >> 6) | (h2 << 20);
+    h2 = (h2 >> 12) | (h3 << 14);
+    h3 = (h3 >> 18) | (h4 << 8);
+
+    /* mac = (h + pad) % 2^128 */
+    f = (uint64_t)h0 + ctx->pad[0];
+    _store32(mac + 0, (uint32_t)f);
+    f = (uint64_t)h1 + ctx->pad[1] + (f >> 32);
+    _store32(mac + 4, (uint32_t)f);
+    f = (uint64_t)h2 + ctx->pad[2] + (f >> 32);
+    _store32(mac + 8, (uint32_t)f);
+    f = (uint64_t)h3 + ctx->pad[3] + (f >> 32);
+    _store32(mac + 12, (uint32_t)f);
+
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void poly1305_auth(uint8_t *mac, const uint8_t *data, size_t len,
+                   const uint8_t *key)
+{
+    poly1305_ctx_t ctx;
+
+    poly1305_init(&ctx, key);
+    poly1305_update(&ctx, data, len);
+    poly1305_finish(&ctx, mac);
+}
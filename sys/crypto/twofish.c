@@ -42,7 +42,9 @@ static const cipher_interface_t twofish_interface = {
     TWOFISH_KEY_SIZE,
     twofish_init,
     twofish_encrypt,
-    twofish_decrypt
+    twofish_decrypt,
+    NULL,
+    NULL
 };
 const cipher_id_t CIPHER_TWOFISH = &twofish_interface;
 
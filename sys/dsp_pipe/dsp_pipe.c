@@ -0,0 +1,329 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_dsp_pipe
+ * @{
+ *
+ * @file
+ * @brief       DSP pipeline implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "assert.h"
+#include "bitarithm.h"
+#include "dsp_pipe.h"
+
+#ifdef MODULE_BOOTPROF
+#include "bootprof.h"
+#endif
+
+#ifndef DSP_PIPE_CMSIS
+#include <math.h>
+
+/* sin(2 * pi * i / DSP_PIPE_FFT_MAXLEN) for the first quarter period */
+static int16_t _sin[(DSP_PIPE_FFT_MAXLEN / 4) + 1];
+
+static inline int16_t _sat(int64_t acc)
+{
+    if (acc > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (acc < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)acc;
+}
+#endif
+
+static void _stage_init(dsp_pipe_stage_t *stage, dsp_pipe_process_t process,
+                        const char *name)
+{
+    memset(stage, 0, sizeof(*stage));
+    stage->process = process;
+    stage->name = name;
+}
+
+static size_t _fir(dsp_pipe_stage_t *stage, int16_t *buf, size_t len)
+{
+    dsp_pipe_fir_t *fir = (dsp_pipe_fir_t *)stage;
+
+    assert(len <= fir->block_len);
+#ifdef DSP_PIPE_CMSIS
+    /* copies each input sample into the state before it writes the output
+     * sample at the same index, so it works in place */
+    arm_fir_q15(&fir->inst, buf, buf, len);
+#else
+    int16_t *state = fir->state;
+
+    memcpy(&state[fir->taps - 1], buf, len * sizeof(int16_t));
+    for (size_t i = 0; i < len; i++) {
+        int64_t acc = 0;
+
+        for (unsigned k = 0; k < fir->taps; k++) {
+            acc += (int32_t)state[i + k] * fir->coeffs[k];
+        }
+        buf[i] = _sat(acc >> 15);
+    }
+    memmove(state, &state[len], (fir->taps - 1) * sizeof(int16_t));
+#endif
+    return len;
+}
+
+int dsp_pipe_fir_init(dsp_pipe_fir_t *fir, const int16_t *coeffs,
+                      uint16_t taps, int16_t *state, uint16_t block_len)
+{
+    /* the CMSIS-DSP kernel processes the taps in pairs */
+    if ((taps < 4) || (taps & 1)) {
+        return -EINVAL;
+    }
+    _stage_init(&fir->stage, _fir, "fir");
+    fir->coeffs = coeffs;
+    fir->state = state;
+    fir->taps = taps;
+    fir->block_len = block_len;
+#ifdef DSP_PIPE_CMSIS
+    arm_fir_init_q15(&fir->inst, taps, (q15_t *)coeffs, state, block_len);
+#else
+    memset(state, 0, (taps + block_len - 1) * sizeof(int16_t));
+#endif
+    return 0;
+}
+
+static size_t _iir(dsp_pipe_stage_t *stage, int16_t *buf, size_t len)
+{
+    dsp_pipe_iir_t *iir = (dsp_pipe_iir_t *)stage;
+
+#ifdef DSP_PIPE_CMSIS
+    arm_biquad_cascade_df1_q15(&iir->inst, buf, buf, len);
+#else
+    for (unsigned b = 0; b < iir->biquads; b++) {
+        const int16_t *c = &iir->coeffs[6 * b];
+        int16_t *s = &iir->state[4 * b];
+
+        for (size_t i = 0; i < len; i++) {
+            int64_t acc = (int32_t)c[0] * buf[i] + (int32_t)c[2] * s[0] +
+                          (int32_t)c[3] * s[1] + (int32_t)c[4] * s[2] +
+                          (int32_t)c[5] * s[3];
+            int16_t out = _sat(acc >> (15 - iir->post_shift));
+
+            s[1] = s[0];
+            s[0] = buf[i];
+            s[3] = s[2];
+            s[2] = out;
+            buf[i] = out;
+        }
+    }
+#endif
+    return len;
+}
+
+int dsp_pipe_iir_init(dsp_pipe_iir_t *iir, const int16_t *coeffs,
+                      uint8_t biquads, int16_t *state, int8_t post_shift)
+{
+    if ((post_shift < 0) || (post_shift > 15)) {
+        return -EINVAL;
+    }
+    _stage_init(&iir->stage, _iir, "iir");
+    iir->coeffs = coeffs;
+    iir->state = state;
+    iir->biquads = biquads;
+    iir->post_shift = post_shift;
+#ifdef DSP_PIPE_CMSIS
+    arm_biquad_cascade_df1_init_q15(&iir->inst, biquads, (q15_t *)coeffs,
+                                    state, post_shift);
+#else
+    memset(state, 0, 4 * biquads * sizeof(int16_t));
+#endif
+    return 0;
+}
+
+#ifndef DSP_PIPE_CMSIS
+/* twiddle factor exp(-2 * pi * i * j / DSP_PIPE_FFT_MAXLEN), j < MAXLEN / 2 */
+static void _twiddle(unsigned j, int16_t *re, int16_t *im)
+{
+    const unsigned quarter = DSP_PIPE_FFT_MAXLEN / 4;
+
+    if (j <= quarter) {
+        *re = _sin[quarter - j];
+        *im = -_sin[j];
+    }
+    else {
+        *re = -_sin[j - quarter];
+        *im = -_sin[(2 * quarter) - j];
+    }
+}
+
+static uint16_t _isqrt(uint32_t x)
+{
+    uint32_t res = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (res > INT16_MAX) ? INT16_MAX : res;
+}
+
+/* radix-2 decimation in time on interleaved complex samples, every stage
+ * halves the values, so the result is the DFT scaled by 1 / len */
+static void _cfft(int16_t *work, unsigned len)
+{
+    unsigned bits = bitarithm_msb(len);
+
+    for (unsigned i = 0; i < len; i++) {
+        unsigned j = 0;
+
+        for (unsigned b = 0; b < bits; b++) {
+            j |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        if (j > i) {
+            int16_t re = work[2 * i], im = work[2 * i + 1];
+
+            work[2 * i] = work[2 * j];
+            work[2 * i + 1] = work[2 * j + 1];
+            work[2 * j] = re;
+            work[2 * j + 1] = im;
+        }
+    }
+    for (unsigned span = 1; span < len; span <<= 1) {
+        unsigned step = DSP_PIPE_FFT_MAXLEN / (2 * span);
+
+        for (unsigned k = 0; k < span; k++) {
+            int16_t wr, wi;
+
+            _twiddle(k * step, &wr, &wi);
+            for (unsigned i = k; i < len; i += 2 * span) {
+                int16_t *a = &work[2 * i];
+                int16_t *b = &work[2 * (i + span)];
+                int32_t tr = ((int32_t)b[0] * wr - (int32_t)b[1] * wi) >> 15;
+                int32_t ti = ((int32_t)b[0] * wi + (int32_t)b[1] * wr) >> 15;
+
+                b[0] = (a[0] - tr) >> 1;
+                b[1] = (a[1] - ti) >> 1;
+                a[0] = (a[0] + tr) >> 1;
+                a[1] = (a[1] + ti) >> 1;
+            }
+        }
+    }
+}
+#endif
+
+static size_t _fft(dsp_pipe_stage_t *stage, int16_t *buf, size_t len)
+{
+    dsp_pipe_fft_t *fft = (dsp_pipe_fft_t *)stage;
+
+    assert(len == fft->len);
+#ifdef DSP_PIPE_CMSIS
+    /* the transform scales by 2 / len and the magnitude by 1 / 2 */
+    arm_rfft_q15(&fft->inst, buf, fft->work);
+    arm_cmplx_mag_q15(fft->work, buf, len / 2);
+#else
+    for (size_t i = 0; i < len; i++) {
+        fft->work[2 * i] = buf[i];
+        fft->work[2 * i + 1] = 0;
+    }
+    _cfft(fft->work, len);
+    for (size_t i = 0; i < len / 2; i++) {
+        int32_t re = fft->work[2 * i], im = fft->work[2 * i + 1];
+
+        buf[i] = _isqrt((uint32_t)(re * re) + (uint32_t)(im * im));
+    }
+#endif
+    return len / 2;
+}
+
+int dsp_pipe_fft_init(dsp_pipe_fft_t *fft, int16_t *work, uint16_t len)
+{
+    if ((len < 32) || (len > DSP_PIPE_FFT_MAXLEN) || (len & (len - 1))) {
+        return -EINVAL;
+    }
+    _stage_init(&fft->stage, _fft, "fft");
+    fft->work = work;
+    fft->len = len;
+#ifdef DSP_PIPE_CMSIS
+    arm_rfft_init_q15(&fft->inst, len, 0, 1);
+#else
+    if (_sin[DSP_PIPE_FFT_MAXLEN / 4] == 0) {
+        for (unsigned i = 0; i <= DSP_PIPE_FFT_MAXLEN / 4; i++) {
+            float x = sinf((2 * (float)M_PI * i) / DSP_PIPE_FFT_MAXLEN);
+
+            _sin[i] = (int16_t)(x * INT16_MAX + 0.5f);
+        }
+    }
+#endif
+    return 0;
+}
+
+void dsp_pipe_append(dsp_pipe_stage_t **head, dsp_pipe_stage_t *stage)
+{
+    while (*head != NULL) {
+        head = &(*head)->next;
+    }
+    stage->next = NULL;
+    *head = stage;
+}
+
+size_t dsp_pipe_process(dsp_pipe_stage_t *head, int16_t *buf, size_t len)
+{
+    for (dsp_pipe_stage_t *stage = head; stage != NULL; stage = stage->next) {
+#ifdef MODULE_BOOTPROF
+        uint32_t start = bootprof_cycles();
+
+        len = stage->process(stage, buf, len);
+        stage->cycles += bootprof_cycles() - start;
+        stage->blocks++;
+#else
+        len = stage->process(stage, buf, len);
+#endif
+    }
+    return len;
+}
+
+void dsp_pipe_from_adc(const uint16_t *samples, int16_t *out, size_t len,
+                       unsigned bits)
+{
+    assert((bits > 0) && (bits <= 16));
+    for (size_t i = 0; i < len; i++) {
+        out[i] = (int16_t)(((int32_t)samples[i] << (16 - bits)) - 0x8000);
+    }
+}
+
+void dsp_pipe_print(const dsp_pipe_stage_t *head)
+{
+#ifdef MODULE_BOOTPROF
+    printf("%-8s %8s %12s\n", "stage", "blocks", "cycles/block");
+    for (const dsp_pipe_stage_t *stage = head; stage != NULL;
+         stage = stage->next) {
+        printf("%-8s %8" PRIu32 " %12" PRIu32 "\n", stage->name,
+               stage->blocks,
+               (stage->blocks != 0) ? (stage->cycles / stage->blocks) : 0);
+    }
+#else
+    for (const dsp_pipe_stage_t *stage = head; stage != NULL;
+         stage = stage->next) {
+        puts(stage->name);
+    }
+#endif
+}
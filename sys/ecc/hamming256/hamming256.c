@@ -39,6 +39,7 @@
  *----------------------------------------------------------------------------*/
 
 #include <stdint.h>
+#include <string.h>
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -58,6 +59,22 @@ static uint8_t count_bits_in_code256(uint8_t *code)
     return bitarithm_bits_set(code[0]) +  bitarithm_bits_set(code[1]) +  bitarithm_bits_set(code[2]);
 }
 
+/**
+ *  @brief Parity of a byte, looked up nibble-wise in the constant 0x6996.
+ */
+static inline uint8_t parity8(uint8_t byte)
+{
+    return (0x6996 >> ((byte ^ (byte >> 4)) & 0x0f)) & 1;
+}
+
+/**
+ *  @brief Spreads the bits of a nibble to the even bits of a byte.
+ */
+static const uint8_t spread4[16] = {
+    0x00, 0x01, 0x04, 0x05, 0x10, 0x11, 0x14, 0x15,
+    0x40, 0x41, 0x44, 0x45, 0x50, 0x51, 0x54, 0x55
+};
+
 /**
  *  @brief Calculates the 22-bit hamming code for a 256-bytes block of data.
  *  @param data  Data buffer to calculate code for.
@@ -67,76 +84,82 @@ static uint8_t count_bits_in_code256(uint8_t *code)
  */
 static void compute256(const uint8_t *data, uint8_t *code, uint8_t padding)
 {
-    uint32_t i;
-    uint8_t columnSum = 0;
-    uint8_t evenLineCode = 0;
+    uint32_t len = 256 - padding;
+    uint32_t words = len / sizeof(uint32_t);
+    uint32_t sum = 0;
+    uint8_t lanes[sizeof(uint32_t)];
+    uint8_t columnSum;
+    uint8_t evenLineCode;
     uint8_t oddLineCode = 0;
-    uint8_t evenColumnCode = 0;
-    uint8_t oddColumnCode = 0;
+    uint8_t evenColumnCode;
+    uint8_t oddColumnCode;
 
     /*
-     * Xor all bytes together to get the column sum;
-     * At the same time, calculate the even and odd line codes
+     * A byte with odd parity toggles the line parities Px' of all bits set in
+     * its index and Px of all bits cleared (see the table below). Bits 7..2
+     * of the index are the index of the 32-bit word holding the byte, and
+     * the parity of a word is the parity of its bytes together, so the word
+     * index goes into oddLineCode if the word has odd parity. Bits 1..0 are
+     * the position of the byte in the word: they follow from the XOR of all
+     * words, which is also the column sum.
+     *
+     * bits (dec)  7   6   5   4   3   2   1   0
+     *      (bin) 111 110 101 100 011 010 001 000
+     *
+     * groups P4' ooooooooooooooo eeeeeeeeeeeeeee P4
+     *        P2' ooooooo eeeeeee ooooooo eeeeeee P2
+     *        P1' ooo eee ooo eee ooo eee ooo eee P1
+     *
+     * evenLineCode bits: P128  P64  P32  P16  P8  P4  P2  P1
+     * oddLineCode  bits: P128' P64' P32' P16' P8' P4' P2' P1'
      */
-    for (i = 0; i < 256; i++) {
-        /* Allow non-multiples of 256 to be calculated by padding the data with zeroes */
-        uint8_t current = 0;
-        if (i < ((uint16_t)(256 - padding))) {
-            current = data[i];
+    for (uint32_t i = 0; i < words; i++) {
+        uint32_t word;
+        memcpy(&word, &data[i * sizeof(uint32_t)], sizeof(word));
+        sum ^= word;
+        word ^= word >> 16;
+        word ^= word >> 8;
+        if (parity8(word)) {
+            oddLineCode ^= (i << 2);
         }
+    }
 
-        columnSum ^= current;
-
-        /*
-         * If the xor sum of the byte is 0, then this byte has no incidence on
-         * the computed code; so check if the sum is 1.
-         */
-        if ((bitarithm_bits_set(current) & 1) == 1) {
-            /*
-             * Parity groups are formed by forcing a particular index bit to 0
-             * (even) or 1 (odd).
-             * Example on one byte:
-             *
-             * bits (dec)  7   6   5   4   3   2   1   0
-             *      (bin) 111 110 101 100 011 010 001 000
-             *                            '---'---'---'----------.
-             *                                                   |
-             * groups P4' ooooooooooooooo eeeeeeeeeeeeeee P4     |
-             *        P2' ooooooo eeeeeee ooooooo eeeeeee P2     |
-             *        P1' ooo eee ooo eee ooo eee ooo eee P1     |
-             *                                                   |
-             * We can see that:                                  |
-             *  - P4  -> bit 2 of index is 0 --------------------'
-             *  - P4' -> bit 2 of index is 1.
-             *  - P2  -> bit 1 of index if 0.
-             *  - etc...
-             * We deduce that a bit position has an impact on all even Px if
-             * the log2(x)nth bit of its index is 0
-             *     ex: log2(4) = 2, bit2 of the index must be 0 (-> 0 1 2 3)
-             * and on all odd Px' if the log2(x)nth bit of its index is 1
-             *     ex: log2(2) = 1, bit1 of the index must be 1 (-> 0 1 4 5)
-             *
-             * As such, we calculate all the possible Px and Px' values at the
-             * same time in two variables, evenLineCode and oddLineCode, such as
-             *     evenLineCode bits: P128  P64  P32  P16  P8  P4  P2  P1
-             *     oddLineCode  bits: P128' P64' P32' P16' P8' P4' P2' P1'
-             */
-            evenLineCode ^= (255 - i);
-            oddLineCode ^= i;
+    /* The bytes of a last partial word, padded with zeroes */
+    if (len % sizeof(uint32_t)) {
+        uint32_t i = words * sizeof(uint32_t);
+        uint8_t last = 0;
+        for (; i < len; i++) {
+            lanes[i % sizeof(uint32_t)] = data[i];
+            last ^= data[i];
+        }
+        for (i = len % sizeof(uint32_t); i < sizeof(uint32_t); i++) {
+            lanes[i] = 0;
+        }
+        if (parity8(last)) {
+            oddLineCode ^= (words << 2);
         }
+        uint32_t word;
+        memcpy(&word, lanes, sizeof(word));
+        sum ^= word;
     }
 
+    /* Bytes in memory order, independent of the endianness */
+    memcpy(lanes, &sum, sizeof(lanes));
+    columnSum = lanes[0] ^ lanes[1] ^ lanes[2] ^ lanes[3];
+    oddLineCode |= parity8(lanes[1] ^ lanes[3]);
+    oddLineCode |= parity8(lanes[2] ^ lanes[3]) << 1;
+
     /*
-     * At this point, we have the line parities, and the column sum. First, We
-     * must caculate the parity group values on the column sum.
+     * The number of bytes with odd parity is odd exactly if the column sum has
+     * odd parity. Each of them toggles Px or Px' of every bit, so
+     * evenLineCode is oddLineCode, inverted in that case. The same holds for
+     * the parity groups of the bits of the column sum.
      */
-    for (i = 0; i < 8; i++) {
-        if (columnSum & 1) {
-            evenColumnCode ^= (7 - i);
-            oddColumnCode ^= i;
-        }
-        columnSum >>= 1;
-    }
+    evenLineCode = oddLineCode ^ (parity8(columnSum) ? 0xff : 0);
+    oddColumnCode = parity8(columnSum & 0xaa) |
+                    (parity8(columnSum & 0xcc) << 1) |
+                    (parity8(columnSum & 0xf0) << 2);
+    evenColumnCode = oddColumnCode ^ (parity8(columnSum) ? 0x07 : 0);
 
     /*
      * Now, we must interleave the parity values, to obtain the following layout:
@@ -145,53 +168,13 @@ static void compute256(const uint8_t *data, uint8_t *code, uint8_t padding)
      * Code[2] = Column
      * Line = Px' Px P(x-1)- P(x-1) ...
      * Column = P4' P4 P2' P2 P1' P1 PadBit PadBit
+     *
+     * The codes are inverted for linux compatibility.
      */
-    code[0] = 0;
-    code[1] = 0;
-    code[2] = 0;
-
-    for (i = 0; i < 4; i++) {
-        code[0] <<= 2;
-        code[1] <<= 2;
-        code[2] <<= 2;
-
-        /* Line 1 */
-        if ((oddLineCode & 0x80) != 0) {
-            code[0] |= 2;
-        }
-
-        if ((evenLineCode & 0x80) != 0) {
-            code[0] |= 1;
-        }
-
-        /* Line 2 */
-        if ((oddLineCode & 0x08) != 0) {
-            code[1] |= 2;
-        }
-
-        if ((evenLineCode & 0x08) != 0) {
-            code[1] |= 1;
-        }
-
-        /* Column */
-        if ((oddColumnCode & 0x04) != 0) {
-            code[2] |= 2;
-        }
-
-        if ((evenColumnCode & 0x04) != 0) {
-            code[2] |= 1;
-        }
-
-        oddLineCode <<= 1;
-        evenLineCode <<= 1;
-        oddColumnCode <<= 1;
-        evenColumnCode <<= 1;
-    }
-
-    /* Invert codes (linux compatibility) */
-    code[0] = (~(uint32_t)code[0]);
-    code[1] = (~(uint32_t)code[1]);
-    code[2] = (~(uint32_t)code[2]);
+    code[0] = ~((spread4[oddLineCode >> 4] << 1) | spread4[evenLineCode >> 4]);
+    code[1] = ~((spread4[oddLineCode & 0x0f] << 1) |
+                spread4[evenLineCode & 0x0f]);
+    code[2] = ~(((spread4[oddColumnCode] << 1) | spread4[evenColumnCode]) << 2);
 
     DEBUG("Computed code = %02X %02X %02X\n\r",
           code[0], code[1], code[2]);
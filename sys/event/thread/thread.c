@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @{
+ *
+ * @file
+ * @brief       Shared event thread
+ *
+ * @}
+ */
+
+#include "event.h"
+#include "thread.h"
+
+/**
+ * @brief   Stack size of the shared event thread
+ */
+#ifndef EVENT_THREAD_STACKSIZE
+#define EVENT_THREAD_STACKSIZE  (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the shared event thread
+ */
+#ifndef EVENT_THREAD_PRIO
+#define EVENT_THREAD_PRIO       (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+event_queue_t event_queue_shared;
+
+static char _stack[EVENT_THREAD_STACKSIZE];
+
+static void *_event_thread(void *arg)
+{
+    (void)arg;
+    event_loop(&event_queue_shared);
+    return NULL;
+}
+
+void event_thread_init(void)
+{
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack), EVENT_THREAD_PRIO,
+                                     THREAD_CREATE_WOUT_YIELD |
+                                     THREAD_CREATE_STACKTEST,
+                                     _event_thread, NULL, "event");
+    /* the queue must be usable before the thread ran for the first time */
+    event_queue_shared.waiter = (thread_t *)sched_threads[pid];
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_flash_digest
+ * @{
+ *
+ * @file
+ * @brief       Flash digest implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+
+#include "flash_digest.h"
+#ifdef FLASHPAGE_SIZE
+#include "periph/flashpage.h"
+#endif
+
+void flash_digest_mem(const digest_algo_t *algo, const void *addr,
+                      size_t len, void *digest)
+{
+    digest_ctx_t ctx;
+
+    algo->init(&ctx);
+    algo->update(&ctx, addr, len);
+    algo->final(&ctx, digest);
+}
+
+#ifdef FLASHPAGE_SIZE
+int flash_digest_pages(const digest_algo_t *algo, int page, size_t len,
+                       void *digest)
+{
+    if ((page < 0) || (page >= (int)FLASHPAGE_NUMOF) ||
+        (len > ((size_t)(FLASHPAGE_NUMOF - page) * FLASHPAGE_SIZE))) {
+        return -EINVAL;
+    }
+    flash_digest_mem(algo, flashpage_addr(page), len, digest);
+    return 0;
+}
+#endif
+
+static int _read(const digest_algo_t *algo, flash_digest_read_t read,
+                 void *arg, uint32_t addr, size_t len, uint8_t *buf,
+                 size_t buf_len, void *digest)
+{
+    digest_ctx_t ctx;
+
+    algo->init(&ctx);
+    while (len > 0) {
+        size_t n = (len < buf_len) ? len : buf_len;
+        int res = read(arg, buf, addr, n);
+
+        if (res < 0) {
+            return res;
+        }
+        algo->update(&ctx, buf, n);
+        addr += n;
+        len -= n;
+    }
+    algo->final(&ctx, digest);
+    return 0;
+}
+
+int flash_digest_read(const digest_algo_t *algo, flash_digest_read_t read,
+                      void *arg, uint32_t addr, size_t len, uint8_t *buf,
+                      size_t buf_len, void *digest)
+{
+    if (buf == NULL) {
+        uint8_t chunk[FLASH_DIGEST_CHUNK];
+
+        return _read(algo, read, arg, addr, len, chunk, sizeof(chunk), digest);
+    }
+    return _read(algo, read, arg, addr, len, buf, buf_len, digest);
+}
+
+static int _nvram_read(void *arg, uint8_t *dst, uint32_t addr, size_t len)
+{
+    nvram_t *dev = arg;
+
+    return dev->read(dev, dst, addr, len);
+}
+
+int flash_digest_nvram(const digest_algo_t *algo, nvram_t *dev, uint32_t addr,
+                       size_t len, uint8_t *buf, size_t buf_len, void *digest)
+{
+    if ((addr > dev->size) || (len > (dev->size - addr))) {
+        return -EINVAL;
+    }
+    return flash_digest_read(algo, _nvram_read, dev, addr, len, buf, buf_len,
+                             digest);
+}
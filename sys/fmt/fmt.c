@@ -183,14 +183,17 @@ size_t fmt_u16_dec(char *out, uint16_t val)
 
 size_t fmt_s32_dec(char *out, int32_t val)
 {
-    int negative = (val < 0);
+    unsigned negative = (val < 0);
+    uint32_t absolute = (uint32_t)val;
+
     if (negative) {
         if (out) {
             *out++ = '-';
         }
-        val *= -1;
+        /* negate as unsigned, so INT32_MIN does not overflow */
+        absolute = -absolute;
     }
-    return fmt_u32_dec(out, val) + negative;
+    return fmt_u32_dec(out, absolute) + negative;
 }
 
 size_t fmt_s16_dec(char *out, int16_t val)
@@ -200,47 +203,98 @@ size_t fmt_s16_dec(char *out, int16_t val)
 
 size_t fmt_s16_dfp(char *out, int16_t val, unsigned fp_digits)
 {
-    int16_t absolute, divider;
-    size_t pos = 0;
-    size_t div_len, len;
-    unsigned e;
-    char tmp[4];
-
     if (fp_digits > 4) {
         return 0;
     }
-    if (fp_digits == 0) {
-        return fmt_s16_dec(out, val);
+    return fmt_s32_dfp(out, val, fp_digits);
+}
+
+/* writes the fraction with leading zeros to fill up digits characters */
+static size_t _fmt_fraction(char *out, uint32_t fraction, unsigned digits)
+{
+    if (out) {
+        size_t len = fmt_u32_dec(NULL, fraction);
+
+        memset(out, '0', digits - len);
+        fmt_u32_dec(&out[digits - len], fraction);
     }
-    if (val < 0) {
+    return digits;
+}
+
+size_t fmt_s32_dfp(char *out, int32_t val, int fp_digits)
+{
+    uint32_t absolute, e;
+    size_t pos;
+
+    if (fp_digits > 9) {
+        /* 10^10 does not fit into 32 bit */
+        return 0;
+    }
+    if (fp_digits <= 0) {
+        size_t zeros = (val != 0) ? (size_t)-fp_digits : 0;
+
+        pos = fmt_s32_dec(out, val);
         if (out) {
-            out[pos++] = '-';
+            memset(&out[pos], '0', zeros);
         }
-        val *= -1;
+        return pos + zeros;
     }
 
+    pos = (val < 0);
+    absolute = (pos) ? -(uint32_t)val : (uint32_t)val;
+    if (out && pos) {
+        out[0] = '-';
+    }
     e = pwr(10, fp_digits);
-    absolute = (val / (int)e);
-    divider = val - (absolute * e);
+    pos += fmt_u32_dec((out) ? &out[pos] : NULL, absolute / e);
+    if (out) {
+        out[pos] = '.';
+    }
+    pos++;
+    return pos + _fmt_fraction((out) ? &out[pos] : NULL, absolute % e,
+                               fp_digits);
+}
 
-    pos += fmt_s16_dec(&out[pos], absolute);
+size_t fmt_float(char *out, float f, unsigned precision)
+{
+    uint32_t integer, fraction, e;
+    size_t pos;
 
-    if (!out) {
-        return pos + 1 + fp_digits;     /* abs len + decimal point + divider */
+    if (f != f) {
+        return fmt_str(out, "nan");
+    }
+    if (precision > 7) {
+        precision = 7;
+    }
+    pos = (f < 0);
+    if (pos) {
+        f = -f;
+        if (out) {
+            out[0] = '-';
+        }
+    }
+    if (f > 4294967295.0f) {
+        return pos + fmt_str((out) ? &out[pos] : NULL, "inf");
     }
 
-    out[pos++] = '.';
-    len = pos + fp_digits;
-    div_len = fmt_s16_dec(tmp, divider);
+    /* the fraction is rounded as an integer, which may carry over */
+    e = pwr(10, precision);
+    integer = (uint32_t)f;
+    fraction = (uint32_t)(((f - integer) * e) + 0.5f);
+    if (fraction >= e) {
+        integer++;
+        fraction -= e;
+    }
 
-    while (pos < (len - div_len)) {
-        out[pos++] = '0';
+    pos += fmt_u32_dec((out) ? &out[pos] : NULL, integer);
+    if (precision == 0) {
+        return pos;
     }
-    for (size_t i = 0; i < div_len; i++) {
-        out[pos++] = tmp[i];
+    if (out) {
+        out[pos] = '.';
     }
-
-    return pos;
+    pos++;
+    return pos + _fmt_fraction((out) ? &out[pos] : NULL, fraction, precision);
 }
 
 uint32_t scn_u32_dec(const char *str, size_t n)
@@ -290,6 +344,28 @@ void print_s32_dec(int32_t val)
     print(buf, len);
 }
 
+void print_s32_dfp(int32_t val, int fp_digits)
+{
+    char buf[FMT_S32_DFP_MAXLEN];
+
+    if (fp_digits < 0) {
+        /* the zeros are printed without a buffer */
+        print_s32_dec(val);
+        for (int i = fp_digits; val && (i < 0); i++) {
+            print("0", 1);
+        }
+        return;
+    }
+    print(buf, fmt_s32_dfp(buf, val, fp_digits));
+}
+
+void print_float(float f, unsigned precision)
+{
+    char buf[FMT_FLOAT_MAXLEN];
+
+    print(buf, fmt_float(buf, f, precision));
+}
+
 void print_u32_hex(uint32_t val)
 {
     char buf[8];
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_hashes
+ * @{
+ *
+ * @file
+ * @brief       Common interface to the message digests in sys/hashes
+ *
+ * @}
+ */
+
+#include "hashes/digest.h"
+
+static void _md5_init(digest_ctx_t *ctx)
+{
+    md5_init(&ctx->md5);
+}
+
+static void _md5_update(digest_ctx_t *ctx, const void *data, size_t len)
+{
+    md5_update(&ctx->md5, data, len);
+}
+
+static void _md5_final(digest_ctx_t *ctx, void *digest)
+{
+    md5_final(&ctx->md5, digest);
+}
+
+const digest_algo_t digest_md5 = {
+    MD5_DIGEST_LENGTH, _md5_init, _md5_update, _md5_final
+};
+
+static void _sha1_init(digest_ctx_t *ctx)
+{
+    sha1_init(&ctx->sha1);
+}
+
+static void _sha1_update(digest_ctx_t *ctx, const void *data, size_t len)
+{
+    sha1_update(&ctx->sha1, data, len);
+}
+
+static void _sha1_final(digest_ctx_t *ctx, void *digest)
+{
+    sha1_final(&ctx->sha1, digest);
+}
+
+const digest_algo_t digest_sha1 = {
+    SHA1_DIGEST_LENGTH, _sha1_init, _sha1_update, _sha1_final
+};
+
+static void _sha256_init(digest_ctx_t *ctx)
+{
+    sha256_init(&ctx->sha256);
+}
+
+static void _sha256_update(digest_ctx_t *ctx, const void *data, size_t len)
+{
+    sha256_update(&ctx->sha256, data, len);
+}
+
+static void _sha256_final(digest_ctx_t *ctx, void *digest)
+{
+    sha256_final(&ctx->sha256, digest);
+}
+
+const digest_algo_t digest_sha256 = {
+    SHA256_DIGEST_LENGTH, _sha256_init, _sha256_update, _sha256_final
+};
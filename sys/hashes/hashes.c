@@ -109,3 +109,27 @@ uint32_t one_at_a_time_hash(const uint8_t *buf, size_t len)
     hash += hash << 15;
     return hash;
 }
+
+uint32_t fnv1a_32_hash(const uint8_t *buf, size_t len)
+{
+    uint32_t hash = 0x811c9dc5;
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= buf[i];
+        hash *= 0x01000193;
+    }
+
+    return hash;
+}
+
+uint64_t fnv1a_64_hash(const uint8_t *buf, size_t len)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= buf[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
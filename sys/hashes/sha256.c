@@ -276,8 +276,8 @@ void *sha256(const void *data, size_t len, void *digest)
     return digest;
 }
 
-const void *hmac_sha256(const void *key, size_t key_length,
-                        const void *data, size_t len, void *digest)
+void hmac_sha256_key_init(hmac_sha256_key_t *hkey, const void *key,
+                          size_t key_length)
 {
     unsigned char k[SHA256_INTERNAL_BLOCK_SIZE];
 
@@ -303,36 +303,124 @@ const void *hmac_sha256(const void *key, size_t key_length,
         i_key_pad[i] = 0x36 ^ k[i];
     }
 
-    /*
-     * Create the inner hash
-     * tmp = hash(i_key_pad CONCAT message)
-     */
-    sha256_context_t c;
+    /* the pads fill exactly one block, so the states can be kept */
+    sha256_init(&hkey->inner);
+    sha256_update(&hkey->inner, i_key_pad, SHA256_INTERNAL_BLOCK_SIZE);
+    sha256_init(&hkey->outer);
+    sha256_update(&hkey->outer, o_key_pad, SHA256_INTERNAL_BLOCK_SIZE);
+}
+
+void hmac_sha256_init(hmac_sha256_context_t *ctx,
+                      const hmac_sha256_key_t *hkey)
+{
+    ctx->ctx = hkey->inner;
+    ctx->key = hkey;
+}
+
+void hmac_sha256_update(hmac_sha256_context_t *ctx, const void *data,
+                        size_t len)
+{
+    sha256_update(&ctx->ctx, data, len);
+}
+
+void hmac_sha256_final(hmac_sha256_context_t *ctx, void *digest)
+{
     unsigned char tmp[SHA256_DIGEST_LENGTH];
 
-    sha256_init(&c);
-    sha256_update(&c, i_key_pad, SHA256_INTERNAL_BLOCK_SIZE);
-    sha256_update(&c, data, len);
-    sha256_final(&c, tmp);
+    /* tmp = hash(i_key_pad CONCAT message) */
+    sha256_final(&ctx->ctx, tmp);
 
+    /* result = hash(o_key_pad CONCAT tmp) */
+    ctx->ctx = ctx->key->outer;
+    sha256_update(&ctx->ctx, tmp, SHA256_DIGEST_LENGTH);
+    sha256_final(&ctx->ctx, digest);
+    ctx->key = NULL;
+}
+
+const void *hmac_sha256(const void *key, size_t key_length,
+                        const void *data, size_t len, void *digest)
+{
     static unsigned char m[SHA256_DIGEST_LENGTH];
+    hmac_sha256_key_t hkey;
+    hmac_sha256_context_t c;
 
     if (digest == NULL) {
         digest = m;
     }
 
-    /*
-     * Create the outer hash
-     * result = hash(o_key_pad CONCAT tmp)
-     */
-    sha256_init(&c);
-    sha256_update(&c, o_key_pad, SHA256_INTERNAL_BLOCK_SIZE);
-    sha256_update(&c, tmp, SHA256_DIGEST_LENGTH);
-    sha256_final(&c, digest);
+    hmac_sha256_key_init(&hkey, key, key_length);
+    hmac_sha256_init(&c, &hkey);
+    hmac_sha256_update(&c, data, len);
+    hmac_sha256_final(&c, digest);
 
     return digest;
 }
 
+void hkdf_sha256_extract(const void *salt, size_t salt_len,
+                         const void *ikm, size_t ikm_len, void *prk)
+{
+    /* no salt means a string of zeros as long as the hash */
+    static const unsigned char zeros[SHA256_DIGEST_LENGTH];
+
+    if (salt == NULL) {
+        salt = zeros;
+        salt_len = sizeof(zeros);
+    }
+    hmac_sha256(salt, salt_len, ikm, ikm_len, prk);
+}
+
+int hkdf_sha256_expand(const void *prk, size_t prk_len,
+                       const void *info, size_t info_len,
+                       void *okm, size_t okm_len)
+{
+    hmac_sha256_key_t hkey;
+    hmac_sha256_context_t c;
+    unsigned char t[SHA256_DIGEST_LENGTH];
+    unsigned char *out = okm;
+    uint8_t counter = 1;
+
+    if (okm_len > (255 * SHA256_DIGEST_LENGTH)) {
+        return -1;
+    }
+
+    /* the key is the same for all blocks T(1) ... T(N) */
+    hmac_sha256_key_init(&hkey, prk, prk_len);
+    while (okm_len > 0) {
+        size_t n = (okm_len < SHA256_DIGEST_LENGTH) ? okm_len :
+                   SHA256_DIGEST_LENGTH;
+
+        /* T(i) = HMAC(PRK, T(i - 1) | info | i) */
+        hmac_sha256_init(&c, &hkey);
+        if (counter > 1) {
+            hmac_sha256_update(&c, t, SHA256_DIGEST_LENGTH);
+        }
+        hmac_sha256_update(&c, info, info_len);
+        hmac_sha256_update(&c, &counter, 1);
+        hmac_sha256_final(&c, t);
+
+        memcpy(out, t, n);
+        out += n;
+        okm_len -= n;
+        counter++;
+    }
+    memset(t, 0, sizeof(t));
+    return 0;
+}
+
+int hkdf_sha256(const void *salt, size_t salt_len,
+                const void *ikm, size_t ikm_len,
+                const void *info, size_t info_len,
+                void *okm, size_t okm_len)
+{
+    unsigned char prk[SHA256_DIGEST_LENGTH];
+    int res;
+
+    hkdf_sha256_extract(salt, salt_len, ikm, ikm_len, prk);
+    res = hkdf_sha256_expand(prk, sizeof(prk), info, info_len, okm, okm_len);
+    memset(prk, 0, sizeof(prk));
+    return res;
+}
+
 /**
  * @brief helper to compute sha256 inplace for the given buffer
  *
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_hashes_siphash
+ * @{
+ *
+ * @file
+ * @brief       SipHash-2-4 implementation
+ *
+ * @}
+ */
+
+#include "hashes/siphash.h"
+
+#define ROTL64(x, b)    (((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIPROUND(v0, v1, v2, v3) \
+    v0 += v1; v1 = ROTL64(v1, 13); v1 ^= v0; v0 = ROTL64(v0, 32); \
+    v2 += v3; v3 = ROTL64(v3, 16); v3 ^= v2; \
+    v0 += v3; v3 = ROTL64(v3, 21); v3 ^= v0; \
+    v2 += v1; v1 = ROTL64(v1, 17); v1 ^= v2; v2 = ROTL64(v2, 32)
+
+/* byte wise, so neither alignment nor endianness matter */
+static inline uint64_t _load64(const uint8_t *p, size_t len)
+{
+    uint64_t res = 0;
+
+    while (len--) {
+        res |= (uint64_t)p[len] << (8 * len);
+    }
+    return res;
+}
+
+uint64_t siphash24(const uint8_t *key, const uint8_t *buf, size_t len)
+{
+    uint64_t k0 = _load64(key, 8);
+    uint64_t k1 = _load64(key + 8, 8);
+    uint64_t v0 = k0 ^ 0x736f6d6570736575ULL;
+    uint64_t v1 = k1 ^ 0x646f72616e646f6dULL;
+    uint64_t v2 = k0 ^ 0x6c7967656e657261ULL;
+    uint64_t v3 = k1 ^ 0x7465646279746573ULL;
+    uint64_t m;
+    size_t left = len;
+
+    for (; left >= 8; left -= 8, buf += 8) {
+        m = _load64(buf, 8);
+        v3 ^= m;
+        SIPROUND(v0, v1, v2, v3);
+        SIPROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    /* the last block carries the length in its top byte */
+    m = _load64(buf, left) | ((uint64_t)len << 56);
+    v3 ^= m;
+    SIPROUND(v0, v1, v2, v3);
+    SIPROUND(v0, v1, v2, v3);
+    v0 ^= m;
+
+    v2 ^= 0xff;
+    SIPROUND(v0, v1, v2, v3);
+    SIPROUND(v0, v1, v2, v3);
+    SIPROUND(v0, v1, v2, v3);
+    SIPROUND(v0, v1, v2, v3);
+
+    return v0 ^ v1 ^ v2 ^ v3;
+}
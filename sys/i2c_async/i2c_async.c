@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_i2c_async
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous I2C transfers
+ *
+ * @}
+ */
+
+#include "i2c_async.h"
+#include "thread.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static event_queue_t _queue;
+static char _stack[I2C_ASYNC_STACKSIZE];
+
+static int _transfer(i2c_async_req_t *req)
+{
+    switch (req->flags & (I2C_ASYNC_READ | I2C_ASYNC_REG)) {
+        case I2C_ASYNC_WRITE:
+            return i2c_write_bytes(req->dev, req->addr, req->data, req->len);
+        case I2C_ASYNC_READ:
+            return i2c_read_bytes(req->dev, req->addr, req->data, req->len);
+        case I2C_ASYNC_WRITE | I2C_ASYNC_REG:
+            return i2c_write_regs(req->dev, req->addr, req->reg, req->data,
+                                  req->len);
+        default:
+            return i2c_read_regs(req->dev, req->addr, req->reg, req->data,
+                                 req->len);
+    }
+}
+
+static void _handler(event_t *event)
+{
+    i2c_async_req_t *req = container_of(event, i2c_async_req_t, event);
+
+    i2c_acquire(req->dev);
+    req->res = _transfer(req);
+    i2c_release(req->dev);
+    DEBUG("i2c_async: 0x%02x done: %d\n", req->addr, req->res);
+    if (req->cb) {
+        req->cb(req);
+    }
+}
+
+static void *_thread(void *arg)
+{
+    (void)arg;
+    event_loop(&_queue);
+    return NULL;
+}
+
+void i2c_async_init(void)
+{
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack), I2C_ASYNC_PRIO,
+                                     THREAD_CREATE_WOUT_YIELD |
+                                     THREAD_CREATE_STACKTEST,
+                                     _thread, NULL, "i2c_async");
+    /* the queue must be usable before the thread ran for the first time */
+    _queue.waiter = (thread_t *)sched_threads[pid];
+}
+
+void i2c_async_submit(i2c_async_req_t *req)
+{
+    req->event.handler = _handler;
+    event_post(&_queue, &req->event);
+}
+
+void i2c_async_cancel(i2c_async_req_t *req)
+{
+    event_cancel(&_queue, &req->event);
+}
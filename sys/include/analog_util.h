@@ -86,6 +86,47 @@ uint16_t dac_util_map(int value, int min, int max);
  */
 uint16_t dac_util_mapf(float value, float min, float max);
 
+/**
+ * @brief   Statistics of a block of ADC samples
+ */
+typedef struct {
+    uint16_t min;           /**< smallest sample */
+    uint16_t max;           /**< largest sample */
+    uint16_t mean;          /**< mean of the samples, i.e., their DC part */
+    uint16_t rms;           /**< root mean square of the samples' deviation
+                             *   from the mean, i.e., of their AC part */
+} adc_util_stats_t;
+
+/**
+ * @brief   Compute the statistics of a block of samples
+ *
+ * Meant for the blocks delivered by adc_continuous_start(), e.g., to track
+ * the amplitude of a vibration.
+ *
+ * @param[in] samples       block of samples
+ * @param[in] len           number of samples in @p samples, must not be 0
+ * @param[out] stats        statistics of the block
+ */
+void adc_util_block_stats(const uint16_t *samples, size_t len,
+                          adc_util_stats_t *stats);
+
+/**
+ * @brief   Reduce the sampling rate of a block of samples
+ *
+ * Each output sample is the mean of @p factor input samples, which also
+ * filters frequencies the lower sampling rate cannot represent. @p in and
+ * @p out may be the same buffer.
+ *
+ * @param[in] in            block of samples
+ * @param[in] len           number of samples in @p in
+ * @param[in] factor        number of input samples per output sample
+ * @param[out] out          buffer for len / factor output samples
+ *
+ * @return                  number of samples written to @p out
+ */
+size_t adc_util_block_decimate(const uint16_t *in, size_t len,
+                               unsigned factor, uint16_t *out);
+
 #ifdef __cplusplus
 }
 #endif
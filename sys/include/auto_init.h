@@ -24,6 +24,15 @@
  *              initialized only once, so do not call a module's init function
  *              when using auto_init unless you know what you're doing.
  *
+ *              With the `auto_init_parallel` module, the SAUL drivers are
+ *              initialized in a worker thread while the calling thread sets
+ *              up the network stack, so their power-up delays overlap. Both
+ *              only depend on xtimer and the peripherals being initialized,
+ *              modules depending on them (SAUL cache, RPL) still run after
+ *              both are done. Network devices are always brought up in their
+ *              own threads. With DEVELHELP and xtimer, a breakdown of the
+ *              boot time is printed at the end of auto_init().
+ *
  * @{
  *
  * @file
@@ -40,6 +49,23 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Stack size of the worker thread used by `auto_init_parallel`
+ */
+#ifndef AUTO_INIT_PARALLEL_STACKSIZE
+#define AUTO_INIT_PARALLEL_STACKSIZE    (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the worker thread used by `auto_init_parallel`
+ *
+ * The worker runs before the calling thread until it blocks on a power-up
+ * delay.
+ */
+#ifndef AUTO_INIT_PARALLEL_PRIO
+#define AUTO_INIT_PARALLEL_PRIO         (THREAD_PRIORITY_MAIN - 1)
+#endif
+
 /**
  * @brief Initializes all high level modules that do not require parameters for
  *        initialization or uses default values.
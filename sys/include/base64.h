@@ -11,6 +11,17 @@
  * @defgroup    sys_base64 base64 encoder decoder
  * @ingroup     sys
  * @brief       base64 encoder and decoder
+ *
+ * base64_encode() and base64_decode() convert a whole buffer at once.
+ * Large payloads can be converted in chunks of any size with the
+ * base64_*_update() and base64_*_finish() functions, which keep an
+ * incomplete group of bytes or characters in a @ref base64_ctx_t between
+ * calls, so only a buffer for the current chunk is needed.
+ *
+ * Decoding can be done in place, i.e. the output may start at the same
+ * address as the input, as 4 characters are always read before the 3 bytes
+ * they carry are written.
+ *
  * @{
  *
  * @brief       encoding and decoding functions for base64
@@ -21,6 +32,7 @@
 #define BASE64_ENCODER_DECODER_H_
 
 #include <stddef.h> /* for size_t */
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -32,6 +44,41 @@ extern "C" {
 #define BASE64_ERROR_DATA_IN          (-3) /**< error value for invalid input buffer           */
 #define BASE64_ERROR_DATA_IN_SIZE     (-4) /**< error value for invalid input buffer size      */
 
+/**
+ * @brief   Number of characters needed to encode @p len bytes, including
+ *          padding
+ */
+#define BASE64_ENCODED_LEN(len)       (4 * (((len) + 2) / 3))
+
+/**
+ * @brief   Maximum number of bytes decoded from @p len characters
+ */
+#define BASE64_DECODED_MAXLEN(len)    (3 * (((len) + 3) / 4))
+
+/**
+ * @brief   State of a chunked conversion
+ */
+typedef struct {
+    uint32_t acc;   /**< bytes or 6 bit codes of the incomplete group */
+    uint8_t len;    /**< number of bytes or codes in base64_ctx_t::acc */
+} base64_ctx_t;
+
+/**
+ * @brief   Static initializer for @ref base64_ctx_t
+ */
+#define BASE64_CTX_INIT               { 0, 0 }
+
+/**
+ * @brief   Initialize the state of a chunked conversion
+ *
+ * @param[out] ctx      state to initialize
+ */
+static inline void base64_ctx_init(base64_ctx_t *ctx)
+{
+    ctx->acc = 0;
+    ctx->len = 0;
+}
+
 /**
  * @brief           Encodes a given datum to base64 and save the result to the given destination.
  * @param[in]       data_in           pointer to the datum to encode
@@ -74,6 +121,62 @@ int base64_encode(unsigned char *data_in, size_t data_in_size, \
 int base64_decode(unsigned char *base64_in, size_t base64_in_size, \
                   unsigned char *data_out, size_t *data_out_size);
 
+/**
+ * @brief   Encode a chunk of data
+ *
+ * Up to 2 bytes that do not fill a group of 3 are kept in @p ctx and encoded
+ * with the next chunk or by base64_encode_finish().
+ *
+ * @param[in,out] ctx           state of the conversion
+ * @param[in] data_in           chunk to encode
+ * @param[in] data_in_size      size of @p data_in
+ * @param[out] base64_out       output, at least
+ *                              BASE64_ENCODED_LEN(@p data_in_size) bytes
+ *
+ * @return  number of characters written to @p base64_out
+ */
+size_t base64_encode_update(base64_ctx_t *ctx, const unsigned char *data_in,
+                            size_t data_in_size, unsigned char *base64_out);
+
+/**
+ * @brief   Encode the remaining bytes and add the padding
+ *
+ * @param[in,out] ctx           state of the conversion, initialized again
+ * @param[out] base64_out       output, at least 4 bytes
+ *
+ * @return  number of characters written to @p base64_out (0 or 4)
+ */
+size_t base64_encode_finish(base64_ctx_t *ctx, unsigned char *base64_out);
+
+/**
+ * @brief   Decode a chunk of base64 characters
+ *
+ * Padding and characters that are not base64 (e.g. line breaks) are
+ * ignored. Up to 3 characters that do not fill a group of 4 are kept in
+ * @p ctx and decoded with the next chunk or by base64_decode_finish().
+ *
+ * @param[in,out] ctx           state of the conversion
+ * @param[in] base64_in         chunk to decode
+ * @param[in] base64_in_size    size of @p base64_in
+ * @param[out] data_out         output, at least
+ *                              BASE64_DECODED_MAXLEN(@p base64_in_size)
+ *                              bytes, may be @p base64_in
+ *
+ * @return  number of bytes written to @p data_out
+ */
+size_t base64_decode_update(base64_ctx_t *ctx, const unsigned char *base64_in,
+                            size_t base64_in_size, unsigned char *data_out);
+
+/**
+ * @brief   Decode the remaining characters of unpadded input
+ *
+ * @param[in,out] ctx           state of the conversion, initialized again
+ * @param[out] data_out         output, at least 2 bytes
+ *
+ * @return  number of bytes written to @p data_out (0 to 2)
+ */
+size_t base64_decode_finish(base64_ctx_t *ctx, unsigned char *data_out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -85,6 +85,96 @@ static inline bool bf_isset(uint8_t field[], size_t idx)
     return (field[idx / 8] & (1u << (idx % 8)));
 }
 
+/**
+ * @brief   Set a range of bits to 1
+ *
+ * @param[in,out] field The bitfield
+ * @param[in]     start The number of the first bit to set
+ * @param[in]     len   The number of bits to set
+ */
+void bf_set_range(uint8_t field[], size_t start, size_t len);
+
+/**
+ * @brief   Clear a range of bits
+ *
+ * @param[in,out] field The bitfield
+ * @param[in]     start The number of the first bit to clear
+ * @param[in]     len   The number of bits to clear
+ */
+void bf_unset_range(uint8_t field[], size_t start, size_t len);
+
+/**
+ * @brief   Get the number of the first set bit at or after a given bit
+ *
+ * The bitfield is scanned a machine word at a time. This allows iterating
+ * over all set bits:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * for (int i = bf_find_first_set(field, size); i >= 0;
+ *      i = bf_find_next_set(field, size, i + 1)) {
+ *     ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @param[in]     field The bitfield
+ * @param[in]     size  The size of the bitfield
+ * @param[in]     start The number of the bit to start at
+ *
+ * @return      number of the first set bit >= @p start
+ * @return      -1 if no such bit is set
+ */
+int bf_find_next_set(const uint8_t field[], size_t size, size_t start);
+
+/**
+ * @brief   Get the number of the first unset bit at or after a given bit
+ *
+ * @param[in]     field The bitfield
+ * @param[in]     size  The size of the bitfield
+ * @param[in]     start The number of the bit to start at
+ *
+ * @return      number of the first unset bit >= @p start
+ * @return      -1 if all bits from @p start on are set
+ */
+int bf_find_next_unset(const uint8_t field[], size_t size, size_t start);
+
+/**
+ * @brief   Get the number of the first set bit
+ *
+ * @param[in]     field The bitfield
+ * @param[in]     size  The size of the bitfield
+ *
+ * @return      number of the first set bit
+ * @return      -1 if no bit is set
+ */
+static inline int bf_find_first_set(const uint8_t field[], size_t size)
+{
+    return bf_find_next_set(field, size, 0);
+}
+
+/**
+ * @brief   Get the number of the first unset bit
+ *
+ * @param[in]     field The bitfield
+ * @param[in]     size  The size of the bitfield
+ *
+ * @return      number of the first unset bit
+ * @return      -1 if all bits are set
+ */
+static inline int bf_find_first_unset(const uint8_t field[], size_t size)
+{
+    return bf_find_next_unset(field, size, 0);
+}
+
+/**
+ * @brief   Count the set bits
+ *
+ * @param[in]     field The bitfield
+ * @param[in]     size  The size of the bitfield
+ *
+ * @return      number of set bits
+ */
+unsigned bf_popcnt(const uint8_t field[], size_t size);
+
 /**
  * @brief  Atomically get the number of an unset bit and set it
  *
@@ -127,6 +127,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "hashes.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -228,6 +230,150 @@ void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len);
  */
 bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len);
 
+/**
+ * @name Blocked and counting variants
+ *
+ * Both variants hash a key only once. The two halves h1 and h2 of the 64
+ * bit hash are combined to the k indices g_i = h1 + i * h2 (Kirsch and
+ * Mitzenmacher, "Less Hashing, Same Performance"), which yields the false
+ * positive rate of k independent hash functions.
+ * @{
+ */
+
+/**
+ * @brief Number of bits in a block of a blocked Bloom filter, one cache line
+ */
+#define BLOOM_BLOCK_BITS    (512U)
+
+/**
+ * @brief Number of bytes in a block of a blocked Bloom filter
+ */
+#define BLOOM_BLOCK_SIZE    (BLOOM_BLOCK_BITS / 8)
+
+/**
+ * @brief Number of bytes needed for @p m counters of a counting Bloom filter
+ */
+#define BLOOM_COUNTING_SIZE(m)  (((m) + 1) / 2)
+
+/**
+ * @brief blocked Bloom filter
+ *
+ * All k bits of a key lie in the same block of BLOOM_BLOCK_BITS bits, so an
+ * add or check touches a single cache line. This costs a slightly higher
+ * false positive rate than a classic filter of the same size.
+ */
+typedef struct {
+    uint8_t *a;         /**< the blocks */
+    size_t blocks;      /**< number of blocks */
+    unsigned k;         /**< number of bits per key */
+} bloom_blocked_t;
+
+/**
+ * @brief counting Bloom filter
+ *
+ * Each position is a 4 bit counter instead of a bit, so keys can be
+ * removed again. A counter that reached 15 is never decremented anymore.
+ */
+typedef struct {
+    uint8_t *counters;  /**< the counters, two per byte */
+    size_t m;           /**< number of counters */
+    unsigned k;         /**< number of counters per key */
+} bloom_counting_t;
+
+/**
+ * @brief Hash of a key, as used by the blocked and counting variants
+ *
+ * @param buf   key
+ * @param len   length of @p buf
+ *
+ * @return h2 in the upper, h1 in the lower 32 bits
+ */
+static inline uint64_t bloom_hash64(const uint8_t *buf, size_t len)
+{
+    return murmur3_fmix64(fnv1a_64_hash(buf, len));
+}
+
+/**
+ * @brief Initialize an empty blocked Bloom filter
+ *
+ * @param bloom         filter to initialize
+ * @param blocks        memory of @p blocks_numof * BLOOM_BLOCK_SIZE bytes
+ * @param blocks_numof  number of blocks
+ * @param k             number of bits per key
+ */
+void bloom_blocked_init(bloom_blocked_t *bloom, uint8_t *blocks,
+                        size_t blocks_numof, unsigned k);
+
+/**
+ * @brief Add a key to a blocked Bloom filter
+ *
+ * @param bloom  Bloom filter
+ * @param buf    key to add
+ * @param len    length of @p buf
+ */
+void bloom_blocked_add(bloom_blocked_t *bloom, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Determine if a key is in a blocked Bloom filter
+ *
+ * @param bloom  Bloom filter
+ * @param buf    key to check
+ * @param len    length of @p buf
+ *
+ * @return       false if the key is not in the filter
+ * @return       true if the key may be in the filter
+ */
+bool bloom_blocked_check(const bloom_blocked_t *bloom, const uint8_t *buf,
+                         size_t len);
+
+/**
+ * @brief Initialize an empty counting Bloom filter
+ *
+ * @param bloom     filter to initialize
+ * @param counters  memory of BLOOM_COUNTING_SIZE(@p m) bytes
+ * @param m         number of counters
+ * @param k         number of counters per key
+ */
+void bloom_counting_init(bloom_counting_t *bloom, uint8_t *counters, size_t m,
+                         unsigned k);
+
+/**
+ * @brief Add a key to a counting Bloom filter
+ *
+ * @param bloom  Bloom filter
+ * @param buf    key to add
+ * @param len    length of @p buf
+ */
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf,
+                        size_t len);
+
+/**
+ * @brief Remove a key from a counting Bloom filter
+ *
+ * @pre @p buf was added before and not removed since, otherwise keys that
+ *      were added may no longer be found.
+ *
+ * @param bloom  Bloom filter
+ * @param buf    key to remove
+ * @param len    length of @p buf
+ */
+void bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf,
+                           size_t len);
+
+/**
+ * @brief Determine if a key is in a counting Bloom filter
+ *
+ * @param bloom  Bloom filter
+ * @param buf    key to check
+ * @param len    length of @p buf
+ *
+ * @return       false if the key is not in the filter
+ * @return       true if the key may be in the filter
+ */
+bool bloom_counting_check(const bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len);
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
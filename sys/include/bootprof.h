@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_bootprof Boot profiling
+ * @ingroup     sys
+ * @brief       Cycle counter time stamps of the boot phases
+ *
+ * This module records the value of a cycle counter at the end of each boot
+ * phase: RAM initialization and board_init() in the reset handler,
+ * kernel_init() up to the start of the main thread, each phase and SAUL
+ * driver of @ref auto_init and finally auto_init() itself. The counter is
+ * the DWT cycle counter on Cortex-M3 and up, and the TSC on native (x86
+ * hosts). Cortex-M0(+) have no cycle counter, so they are not supported.
+ *
+ * The time stamps are kept in a table in RAM until they are printed with
+ * bootprof_print() or the `bootprof` shell command. Marks made by threads
+ * running in parallel (e.g. with `auto_init_parallel`) are interleaved.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Boot profiling interface
+ */
+
+#ifndef BOOTPROF_H
+#define BOOTPROF_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of time stamps kept, further marks are dropped
+ */
+#ifndef BOOTPROF_NUMOF
+#define BOOTPROF_NUMOF          (32U)
+#endif
+
+/**
+ * @brief   A single time stamp
+ */
+typedef struct {
+    const char *name;           /**< name of the phase that ended */
+    uint32_t cycles;            /**< cycle counter at the end of the phase */
+} bootprof_entry_t;
+
+/**
+ * @brief   Start the cycle counter from zero
+ *
+ * Called first thing after reset. It does not touch RAM, so it can run before
+ * .data and .bss are initialized.
+ */
+void bootprof_start(void);
+
+/**
+ * @brief   Read the cycle counter
+ *
+ * @return  cycles since bootprof_start(), wraps around at 2^32
+ */
+uint32_t bootprof_cycles(void);
+
+/**
+ * @brief   Record the end of a phase
+ *
+ * May be called from any thread.
+ *
+ * @param[in] name      name of the phase, must stay valid until printed
+ */
+void bootprof_mark(const char *name);
+
+/**
+ * @brief   Get the recorded time stamps
+ *
+ * @param[out] numof    number of entries in the table
+ *
+ * @return  the table of time stamps, in the order they were recorded
+ */
+const bootprof_entry_t *bootprof_get(unsigned *numof);
+
+/**
+ * @brief   Print all time stamps and the cycles since the previous one
+ */
+void bootprof_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BOOTPROF_H */
+/** @} */
@@ -94,6 +94,45 @@
  * -  24-31: (Reserved)      - No support
  * - 32-255: (Unassigned)    - No support
  *
+ * @par Pull parser
+ * Besides the offset based cbor_deserialize_*() functions, a CBOR document
+ * can be walked item by item with cbor_reader_next(). Strings are returned
+ * in place instead of being copied, whole arrays, maps and tagged items
+ * are skipped with cbor_reader_skip(). The reader only needs the
+ * document's buffer, e.g. the payload of a received CoAP message, no
+ * cbor_stream_t:
+ * @code
+ * cbor_reader_t reader;
+ * cbor_item_t item;
+ *
+ * cbor_reader_init(&reader, pdu->payload, pdu->payload_len);
+ * while (cbor_reader_next(&reader, &item) == 0) {
+ *     if (item.type == CBOR_ITEM_TEXT) {
+ *         printf("%.*s\n", (int)item.value, (const char *)item.data);
+ *     }
+ *     else {
+ *         cbor_reader_skip(&reader, &item);
+ *     }
+ * }
+ * @endcode
+ *
+ * @par Encoding into a CoAP message
+ * cbor_init() can be pointed at the payload of a gcoap PDU, so items are
+ * encoded right into the message. cbor_reserve_byte_string() additionally
+ * lets the caller fill a byte string in place:
+ * @code
+ * cbor_stream_t stream;
+ *
+ * cbor_init(&stream, pdu->payload, pdu->payload_len);
+ * cbor_serialize_map(&stream, 1);
+ * cbor_serialize_unicode_string(&stream, "raw");
+ * unsigned char *raw = cbor_reserve_byte_string(&stream, 8);
+ * if (raw) {
+ *     read_samples(raw, 8);
+ * }
+ * gcoap_finish(pdu, stream.pos, COAP_FORMAT_CBOR);
+ * @endcode
+ *
  * @todo API for Indefinite-Length Byte Strings and Text Strings
  *       (see https://tools.ietf.org/html/rfc7049#section-2.2.2)
  */
@@ -376,6 +415,18 @@ size_t cbor_serialize_byte_string(cbor_stream_t *stream, const char *val);
  */
 size_t cbor_serialize_byte_stringl(cbor_stream_t *stream, const char *val, size_t length);
 
+/**
+ * @brief Reserves a byte string of @p length bytes in @p stream, which the
+ *        caller writes in place afterwards
+ *
+ * @param[in, out] stream   The destination stream for serializing the header
+ * @param[in]      length   Length of the byte string
+ *
+ * @return Pointer to the @p length bytes of the string within the stream
+ * @return NULL if the string does not fit
+ */
+unsigned char *cbor_reserve_byte_string(cbor_stream_t *stream, size_t length);
+
 /**
  * @brief Deserialize bytes from @p stream to @p val
  *
@@ -637,6 +688,145 @@ bool cbor_at_break(const cbor_stream_t *stream, size_t offset);
  */
 bool cbor_at_end(const cbor_stream_t *stream, size_t offset);
 
+/**
+ * @name Pull parser
+ * @{
+ */
+
+/**
+ * @brief Major types of a cbor_item_t
+ */
+enum {
+    CBOR_ITEM_UINT   = 0,   /**< unsigned integer */
+    CBOR_ITEM_NEGINT = 1,   /**< negative integer, -1 - cbor_item_t::value */
+    CBOR_ITEM_BYTES  = 2,   /**< byte string */
+    CBOR_ITEM_TEXT   = 3,   /**< UTF-8 text string */
+    CBOR_ITEM_ARRAY  = 4,   /**< array */
+    CBOR_ITEM_MAP    = 5,   /**< map */
+    CBOR_ITEM_TAG    = 6,   /**< tag, the tagged item follows */
+    CBOR_ITEM_SIMPLE = 7,   /**< simple value, float or break */
+};
+
+/**
+ * @brief Additional information of an indefinite length item or of a break
+ */
+#define CBOR_ITEM_INDEFINITE    (31)
+
+/**
+ * @brief Maximum nesting depth cbor_reader_skip() handles
+ */
+#ifndef CBOR_READER_MAX_DEPTH
+#define CBOR_READER_MAX_DEPTH   (16)
+#endif
+
+/**
+ * @brief Position of the pull parser within a CBOR document
+ */
+typedef struct {
+    const uint8_t *pos;     /**< next item */
+    const uint8_t *end;     /**< end of the document */
+} cbor_reader_t;
+
+/**
+ * @brief A data item returned by cbor_reader_next()
+ */
+typedef struct {
+    /**
+     * @brief   the value, depending on the type:
+     *
+     * - the integer of CBOR_ITEM_UINT and CBOR_ITEM_NEGINT
+     * - the length of a definite length string
+     * - the number of items of an array, of pairs of a map
+     * - the tag of CBOR_ITEM_TAG
+     * - the simple value or the bits of the float of CBOR_ITEM_SIMPLE
+     */
+    uint64_t value;
+    const uint8_t *data;    /**< content of a definite length string, in
+                                 place, NULL otherwise */
+    uint8_t type;           /**< major type, CBOR_ITEM_* */
+    uint8_t info;           /**< additional information, e.g.
+                                 CBOR_ITEM_INDEFINITE */
+} cbor_item_t;
+
+/**
+ * @brief Initialize a pull parser
+ *
+ * @param[out] reader   The parser to initialize
+ * @param[in]  buf      The CBOR document, must stay valid while parsing
+ * @param[in]  len      Length of @p buf
+ */
+void cbor_reader_init(cbor_reader_t *reader, const uint8_t *buf, size_t len);
+
+/**
+ * @brief Read the next item
+ *
+ * The reader moves past a definite length string, but into arrays, maps
+ * and tags: the next call returns their first item. Items of indefinite
+ * length arrays, maps and strings are followed by a break.
+ *
+ * @param[in, out] reader   The parser
+ * @param[out]     item     The item read
+ *
+ * @return 0 on success
+ * @return -ENOENT at the end of the document
+ * @return -EBADMSG if the item is malformed or truncated
+ */
+int cbor_reader_next(cbor_reader_t *reader, cbor_item_t *item);
+
+/**
+ * @brief Skip the content of an item just returned by cbor_reader_next()
+ *
+ * Skips all items of an array or map, including nested ones, the item
+ * following a tag, or the chunks of an indefinite length string. Does
+ * nothing for other items.
+ *
+ * @param[in, out] reader   The parser
+ * @param[in]      item     The item to skip the content of
+ *
+ * @return 0 on success
+ * @return -EBADMSG if the content is malformed, truncated or nested deeper
+ *         than CBOR_READER_MAX_DEPTH
+ */
+int cbor_reader_skip(cbor_reader_t *reader, const cbor_item_t *item);
+
+/**
+ * @brief Whether an item is the break ending an indefinite length item
+ *
+ * @param[in] item  The item
+ *
+ * @return True for a break
+ */
+static inline bool cbor_item_is_break(const cbor_item_t *item)
+{
+    return (item->type == CBOR_ITEM_SIMPLE) &&
+           (item->info == CBOR_ITEM_INDEFINITE);
+}
+
+/**
+ * @brief Get the value of an integer item
+ *
+ * @param[in]  item The item
+ * @param[out] val  The value
+ *
+ * @return 0 on success
+ * @return -EINVAL if @p item is no integer or does not fit into @p val
+ */
+int cbor_item_get_int64(const cbor_item_t *item, int64_t *val);
+
+#ifndef CBOR_NO_FLOAT
+/**
+ * @brief Get the value of a half, single or double precision float item
+ *
+ * @param[in]  item The item
+ * @param[out] val  The value
+ *
+ * @return 0 on success
+ * @return -EINVAL if @p item is no float
+ */
+int cbor_item_get_double(const cbor_item_t *item, double *val);
+#endif /* CBOR_NO_FLOAT */
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,9 +18,14 @@
  *              instead of crc16_ccitt_calc().
  *
  *              There is a more generalized version in @ref sys_checksum_ucrc16,
- *              that does not utilize a look-up table as this implementation
- *              does (and is thus also for more memory efficient). Its caveat
- *              however is that it is slower by about factor 8 than this version.
+ *              that does not utilize a static look-up table as this
+ *              implementation does (and is thus also for more memory
+ *              efficient). Its caveat however is that it is slower than this
+ *              version.
+ *
+ *              With the `crc16_ccitt_nibble` module, a table of 16 instead of
+ *              256 entries is used (32 instead of 512 bytes of ROM), at the
+ *              cost of two look-ups per byte.
  *
  * @{
  * @file
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_checksum_crc32 CRC32
+ * @ingroup     sys_checksum
+ *
+ * @brief       CRC32 checksum algorithm
+ * @details     This is the CRC32 of IEEE 802.3, zlib and PNG (reflected
+ *              polynomial 0xEDB88320, start value and final XOR 0xFFFFFFFF).
+ *
+ *              The implementation is selected with one of these modules:
+ *
+ *              | module          | table size | speed                      |
+ *              |:--------------- |:---------- |:-------------------------- |
+ *              | (default)       | 1 KiB      | one lookup per byte        |
+ *              | `crc32_nibble`  | 64 B       | two lookups per byte       |
+ *              | `crc32_slice4`  | 4 KiB      | four lookups per 4 bytes   |
+ *              | `crc32_periph`  | -          | CRC unit of the MCU, needs |
+ *              |                 |            | the `periph_crc` feature   |
+ *
+ * @{
+ * @file
+ */
+
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief           Update CRC32
+ *
+ * @param[in]  crc  return value of a previous call to crc32_calc() or
+ *                  crc32_update(), 0 to start a new checksum
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the data given so far
+ */
+uint32_t crc32_update(uint32_t crc, const uint8_t *buf, size_t len);
+
+/**
+ * @brief           Calculate CRC32
+ *
+ * @param[in]  buf  Start of the memory area to checksum
+ * @param[in]  len  Number of bytes to checksum
+ *
+ * @return          Checksum of the specified memory area
+ */
+static inline uint32_t crc32_calc(const uint8_t *buf, size_t len)
+{
+    return crc32_update(0, buf, len);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRC32_H */
+
+/** @} */
@@ -12,8 +12,10 @@
  * @brief       Lightweight CRC16 checksum algorithms
  *
  * This CRC16 implementation does not use pre-calculated lookup tables and is
- * thus very lightweight (memory-wise), but as a caveat slower (about factor 8)
- * than the version with pre-calculated lookup tables.
+ * thus very lightweight (memory-wise), but as a caveat slower than the version
+ * with pre-calculated lookup tables. Buffers of 8 bytes or more are processed
+ * 4 bits at a time with a 32 byte table built on the stack, shorter ones bit
+ * by bit.
  *
  * Additionally compared to @ref sys_checksum_crc16_ccitt this is a generalized
  * implementation. One can easily exchange generator polynomials and starting
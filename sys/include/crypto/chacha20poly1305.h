@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       ChaCha20-Poly1305 authenticated encryption (RFC 8439)
+ *
+ * Unlike the block cipher modes this does not use the cipher_t API, the key
+ * is passed to every call. A nonce must never be used twice with one key.
+ */
+
+#ifndef CRYPTO_CHACHA20POLY1305_H_
+#define CRYPTO_CHACHA20POLY1305_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHACHA20POLY1305_KEY_SIZE   (32U)   /**< key size in bytes */
+#define CHACHA20POLY1305_NONCE_SIZE (12U)   /**< nonce size in bytes */
+#define CHACHA20POLY1305_TAG_SIZE   (16U)   /**< tag size in bytes */
+
+#define CHACHA20POLY1305_ERR_INVALID_LENGTH (-1)    /**< input too short or too long */
+#define CHACHA20POLY1305_ERR_INVALID_TAG    (-2)    /**< authentication failed */
+
+/**
+ * @brief   Encrypt and authenticate a message
+ *
+ * @p output may be the same buffer as @p input.
+ *
+ * @param[in]  key          CHACHA20POLY1305_KEY_SIZE bytes of key
+ * @param[in]  nonce        CHACHA20POLY1305_NONCE_SIZE bytes of nonce
+ * @param[in]  aad          additional data, authenticated only
+ * @param[in]  aad_len      length of @p aad
+ * @param[in]  input        plain text
+ * @param[in]  input_len    length of @p input
+ * @param[out] output       cipher text followed by the tag, must have room
+ *                          for @p input_len + CHACHA20POLY1305_TAG_SIZE bytes
+ *
+ * @return  length of @p output
+ * @return  CHACHA20POLY1305_ERR_INVALID_LENGTH if @p input_len is too large
+ */
+int chacha20poly1305_encrypt(const uint8_t *key, const uint8_t *nonce,
+                             const uint8_t *aad, size_t aad_len,
+                             const uint8_t *input, size_t input_len,
+                             uint8_t *output);
+
+/**
+ * @brief   Verify and decrypt a message
+ *
+ * @p output may be the same buffer as @p input. It is cleared if the tag
+ * does not match.
+ *
+ * @param[in]  key          CHACHA20POLY1305_KEY_SIZE bytes of key
+ * @param[in]  nonce        CHACHA20POLY1305_NONCE_SIZE bytes of nonce
+ * @param[in]  aad          additional data, authenticated only
+ * @param[in]  aad_len      length of @p aad
+ * @param[in]  input        cipher text followed by the tag
+ * @param[in]  input_len    length of @p input
+ * @param[out] output       plain text, @p input_len -
+ *                          CHACHA20POLY1305_TAG_SIZE bytes
+ *
+ * @return  length of @p output
+ * @return  CHACHA20POLY1305_ERR_INVALID_LENGTH if @p input is shorter than a tag
+ * @return  CHACHA20POLY1305_ERR_INVALID_TAG if the tag does not match
+ */
+int chacha20poly1305_decrypt(const uint8_t *key, const uint8_t *nonce,
+                             const uint8_t *aad, size_t aad_len,
+                             const uint8_t *input, size_t input_len,
+                             uint8_t *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_CHACHA20POLY1305_H_ */
+/** @} */
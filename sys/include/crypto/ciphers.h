@@ -22,6 +22,7 @@
 #ifndef CRYPTO_CIPHERS_H_
 #define CRYPTO_CIPHERS_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -100,6 +101,14 @@ typedef struct cipher_interface_st {
     /** the decrypt function */
     int (*decrypt)(const cipher_context_t* ctx, const uint8_t* cipher_block,
                    uint8_t* plain_block);
+
+    /** the multi-block encrypt function, may be NULL */
+    int (*encrypt_blocks)(const cipher_context_t* ctx, const uint8_t* input,
+                          uint8_t* output, size_t length);
+
+    /** the multi-block decrypt function, may be NULL */
+    int (*decrypt_blocks)(const cipher_context_t* ctx, const uint8_t* input,
+                          uint8_t* output, size_t length);
 } cipher_interface_t;
 
 
@@ -121,6 +130,27 @@ typedef struct {
                                               for the algorithm */
 } cipher_t;
 
+/**
+ * @brief   Alternative implementation of a cipher, e.g. a hardware engine
+ */
+typedef struct cipher_backend {
+    struct cipher_backend *next;            /**< next registered backend */
+    cipher_id_t cipher;                     /**< cipher that is implemented */
+    const cipher_interface_t *interface;    /**< the implementation */
+} cipher_backend_t;
+
+/**
+ * @brief Register an alternative implementation of a cipher
+ *
+ * cipher_init() tries the backends registered for a cipher id, the most
+ * recently registered one first, before falling back to the software
+ * implementation. A backend rejects a key it cannot handle by returning
+ * an error from its init function.
+ *
+ * @param backend    backend to register, must stay valid
+ */
+void cipher_register_backend(cipher_backend_t *backend);
+
 
 /**
  * @brief Initialize new cipher state
@@ -162,6 +192,45 @@ int cipher_encrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output
 int cipher_decrypt(const cipher_t* cipher, const uint8_t* input, uint8_t* output);
 
 
+/**
+ * @brief Encrypt several consecutive blocks independently of each other
+ *
+ * Uses the multi-block function of the cipher's implementation if it has
+ * one, and encrypts block by block otherwise.
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to input data to encrypt
+ * @param output     pointer to allocated memory for encrypted data
+ * @param length     length of @p input, a multiple of the block size
+ *
+ * @return  @p length on success
+ * @return  CIPHER_ERR_INVALID_LENGTH if @p length is no multiple of the
+ *          block size
+ * @return  CIPHER_ERR_ENC_FAILED on other errors
+ */
+int cipher_encrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t length);
+
+
+/**
+ * @brief Decrypt several consecutive blocks independently of each other
+ *
+ * @see cipher_encrypt_blocks()
+ *
+ * @param cipher     Already initialized cipher struct
+ * @param input      pointer to input data to decrypt
+ * @param output     pointer to allocated memory for decrypted data
+ * @param length     length of @p input, a multiple of the block size
+ *
+ * @return  @p length on success
+ * @return  CIPHER_ERR_INVALID_LENGTH if @p length is no multiple of the
+ *          block size
+ * @return  CIPHER_ERR_DEC_FAILED on other errors
+ */
+int cipher_decrypt_blocks(const cipher_t* cipher, const uint8_t* input,
+                          uint8_t* output, size_t length);
+
+
 /**
  * @brief Get block size of cipher
  * *
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_crypto
+ * @{
+ *
+ * @file
+ * @brief       Poly1305 one-time authenticator (RFC 8439)
+ *
+ * @warning     A key must never be used for more than one message. Use
+ *              chacha20poly1305.h, which derives a fresh key per nonce.
+ */
+
+#ifndef CRYPTO_POLY1305_H_
+#define CRYPTO_POLY1305_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define POLY1305_KEY_SIZE   (32U)   /**< key size in bytes */
+#define POLY1305_BLOCK_SIZE (16U)   /**< block size in bytes */
+#define POLY1305_MAC_SIZE   (16U)   /**< tag size in bytes */
+
+/**
+ * @brief   Poly1305 context
+ */
+typedef struct {
+    uint32_t r[5];                      /**< clamped multiplier, radix 2^26 */
+    uint32_t h[5];                      /**< accumulator, radix 2^26 */
+    uint32_t pad[4];                    /**< second half of the key */
+    uint8_t buf[POLY1305_BLOCK_SIZE];   /**< unprocessed input */
+    size_t left;                        /**< bytes in buf */
+} poly1305_ctx_t;
+
+/**
+ * @brief   Initialize a context with a one-time key
+ *
+ * @param[out] ctx  context to initialize
+ * @param[in]  key  POLY1305_KEY_SIZE bytes of key
+ */
+void poly1305_init(poly1305_ctx_t *ctx, const uint8_t *key);
+
+/**
+ * @brief   Add data to the authenticated message
+ *
+ * @param[in,out] ctx   context
+ * @param[in]     data  data to add
+ * @param[in]     len   length of @p data
+ */
+void poly1305_update(poly1305_ctx_t *ctx, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Compute the tag and wipe the context
+ *
+ * @param[in,out] ctx   context
+ * @param[out]    mac   POLY1305_MAC_SIZE bytes of tag
+ */
+void poly1305_finish(poly1305_ctx_t *ctx, uint8_t *mac);
+
+/**
+ * @brief   Compute the tag of a message in one go
+ *
+ * @param[out] mac   POLY1305_MAC_SIZE bytes of tag
+ * @param[in]  data  message
+ * @param[in]  len   length of @p data
+ * @param[in]  key   POLY1305_KEY_SIZE bytes of one-time key
+ */
+void poly1305_auth(uint8_t *mac, const uint8_t *data, size_t len,
+                   const uint8_t *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRYPTO_POLY1305_H_ */
+/** @} */
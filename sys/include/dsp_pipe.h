@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_dsp_pipe Block-based DSP pipeline
+ * @ingroup     sys
+ * @brief       Filter and FFT stages for q15 sensor streams
+ *
+ * A pipeline is a chain of stages that each process a block of q15 samples
+ * in place. Blocks come e.g. from continuous ADC sampling (see
+ * @ref dsp_pipe_from_adc()) or from the FIFO of an IMU, which already
+ * delivers signed 16-bit samples.
+ *
+ * With package `cmsis-dsp` on Cortex-M4 and M7, the stages use the CMSIS-DSP
+ * kernels. Everywhere else portable C implementations with the same
+ * numerical behavior are used, so a pipeline gives the same results on all
+ * platforms up to rounding.
+ *
+ * With module `bootprof`, every stage counts the CPU cycles it spent, see
+ * @ref dsp_pipe_print().
+ *
+ * @{
+ *
+ * @file
+ * @brief       DSP pipeline definitions
+ */
+
+#ifndef DSP_PIPE_H
+#define DSP_PIPE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(MODULE_CMSIS_DSP) && (defined(ARM_MATH_CM4) || defined(ARM_MATH_CM7))
+#define DSP_PIPE_CMSIS      (1)
+#include "arm_math.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Largest supported FFT length
+ */
+#define DSP_PIPE_FFT_MAXLEN     (1024U)
+
+/**
+ * @brief   Stage of a pipeline
+ */
+typedef struct dsp_pipe_stage dsp_pipe_stage_t;
+
+/**
+ * @brief   Processes a block of samples in place
+ *
+ * @param[in] stage     the stage
+ * @param[in,out] buf   the samples
+ * @param[in] len       number of samples in @p buf
+ *
+ * @return  number of samples in @p buf after the stage
+ */
+typedef size_t (*dsp_pipe_process_t)(dsp_pipe_stage_t *stage, int16_t *buf,
+                                     size_t len);
+
+struct dsp_pipe_stage {
+    dsp_pipe_stage_t *next;         /**< next stage of the pipeline */
+    dsp_pipe_process_t process;     /**< the processing function */
+    const char *name;               /**< name of the stage */
+#if defined(MODULE_BOOTPROF) || defined(DOXYGEN)
+    uint32_t cycles;                /**< CPU cycles spent in the stage */
+    uint32_t blocks;                /**< number of blocks processed */
+#endif
+};
+
+/**
+ * @brief   FIR filter stage
+ */
+typedef struct {
+    dsp_pipe_stage_t stage;         /**< the stage */
+#if defined(DSP_PIPE_CMSIS) || defined(DOXYGEN)
+    arm_fir_instance_q15 inst;      /**< the CMSIS-DSP filter */
+#endif
+    const int16_t *coeffs;          /**< coefficients in time reversed order */
+    int16_t *state;                 /**< past and current samples */
+    uint16_t taps;                  /**< number of coefficients */
+    uint16_t block_len;             /**< maximum block length */
+} dsp_pipe_fir_t;
+
+/**
+ * @brief   Cascade of biquad IIR filter stage
+ */
+typedef struct {
+    dsp_pipe_stage_t stage;         /**< the stage */
+#if defined(DSP_PIPE_CMSIS) || defined(DOXYGEN)
+    arm_biquad_casd_df1_inst_q15 inst;  /**< the CMSIS-DSP filter */
+#endif
+    const int16_t *coeffs;          /**< {b0, 0, b1, b2, a1, a2} per biquad */
+    int16_t *state;                 /**< {x[n-1], x[n-2], y[n-1], y[n-2]} per biquad */
+    uint8_t biquads;                /**< number of biquads */
+    int8_t post_shift;              /**< left shift of the accumulator */
+} dsp_pipe_iir_t;
+
+/**
+ * @brief   FFT magnitude stage
+ *
+ * Takes a block of exactly `len` real samples and leaves the magnitudes of
+ * the first `len / 2` bins in q15, scaled by 1 / `len`: a full scale sine
+ * wave in the center of a bin gives 0.5 in that bin.
+ */
+typedef struct {
+    dsp_pipe_stage_t stage;         /**< the stage */
+#if defined(DSP_PIPE_CMSIS) || defined(DOXYGEN)
+    arm_rfft_instance_q15 inst;     /**< the CMSIS-DSP transform */
+#endif
+    int16_t *work;                  /**< 2 * len samples of work space */
+    uint16_t len;                   /**< length of the transform */
+} dsp_pipe_fft_t;
+
+/**
+ * @brief   Initializes a FIR filter stage
+ *
+ * The coefficients are in time reversed order, i.e. `coeffs[0]` is b[taps - 1],
+ * as for CMSIS-DSP.
+ *
+ * @param[out] fir      the stage
+ * @param[in] coeffs    @p taps coefficients in q15, must stay valid
+ * @param[in] taps      number of coefficients, even and at least 4
+ * @param[in] state     buffer of `taps + block_len - 1` samples
+ * @param[in] block_len maximum number of samples per block
+ *
+ * @return  0 on success
+ * @return  -EINVAL on an unsupported number of coefficients
+ */
+int dsp_pipe_fir_init(dsp_pipe_fir_t *fir, const int16_t *coeffs,
+                      uint16_t taps, int16_t *state, uint16_t block_len);
+
+/**
+ * @brief   Initializes a biquad IIR filter stage
+ *
+ * Each biquad computes, in direct form I,
+ *
+ *     y[n] = (b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2])
+ *            << post_shift
+ *
+ * with the sign convention of CMSIS-DSP for a1 and a2.
+ *
+ * @param[out] iir      the stage
+ * @param[in] coeffs    6 coefficients in q15 per biquad, must stay valid
+ * @param[in] biquads   number of biquads
+ * @param[in] state     buffer of 4 samples per biquad
+ * @param[in] post_shift    shift of the accumulator to allow coefficients
+ *                          of magnitude >= 1
+ *
+ * @return  0 on success
+ * @return  -EINVAL on an invalid post shift
+ */
+int dsp_pipe_iir_init(dsp_pipe_iir_t *iir, const int16_t *coeffs,
+                      uint8_t biquads, int16_t *state, int8_t post_shift);
+
+/**
+ * @brief   Initializes an FFT magnitude stage
+ *
+ * @param[out] fft      the stage
+ * @param[in] work      buffer of `2 * len` samples
+ * @param[in] len       length of the transform, power of 2 from 32 to
+ *                      @ref DSP_PIPE_FFT_MAXLEN
+ *
+ * @return  0 on success
+ * @return  -EINVAL on an unsupported length
+ */
+int dsp_pipe_fft_init(dsp_pipe_fft_t *fft, int16_t *work, uint16_t len);
+
+/**
+ * @brief   Appends a stage to a pipeline
+ *
+ * @param[in,out] head  the first stage of the pipeline, NULL for none
+ * @param[in] stage     the stage to append
+ */
+void dsp_pipe_append(dsp_pipe_stage_t **head, dsp_pipe_stage_t *stage);
+
+/**
+ * @brief   Runs a block of samples through a pipeline
+ *
+ * @param[in] head      the first stage of the pipeline
+ * @param[in,out] buf   the samples
+ * @param[in] len       number of samples in @p buf
+ *
+ * @return  number of samples in @p buf after the last stage
+ */
+size_t dsp_pipe_process(dsp_pipe_stage_t *head, int16_t *buf, size_t len);
+
+/**
+ * @brief   Converts unsigned ADC samples to q15 centered around 0
+ *
+ * Can convert in place, as both sample types have the same size.
+ *
+ * @param[in] samples   the ADC samples
+ * @param[out] out      the q15 samples
+ * @param[in] len       number of samples
+ * @param[in] bits      resolution of the ADC in bits, 1 to 16
+ */
+void dsp_pipe_from_adc(const uint16_t *samples, int16_t *out, size_t len,
+                       unsigned bits);
+
+/**
+ * @brief   Prints the cycles spent per block in every stage of a pipeline
+ *
+ * Only prints the names of the stages without module `bootprof`.
+ *
+ * @param[in] head      the first stage of the pipeline
+ */
+void dsp_pipe_print(const dsp_pipe_stage_t *head);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_PIPE_H */
+/** @} */
@@ -37,14 +37,23 @@ extern "C" {
 /** Multiple bits are incorrect in the data and they cannot be corrected. */
 #define Hamming_ERROR_MULTIPLEBITS      3
 
+/**
+ * @brief   Size of the codes for @p size bytes of data, e.g. 24 bytes for a
+ *          2 KiB NAND page
+ */
+#define HAMMING256_CODE_SIZE(size)      ((((size) + 255) / 256) * 3)
+
 
 /**
  *  @brief Computes 3-bytes hamming codes for a data block whose size is multiple of
  *  256 bytes. Each 256 bytes block gets its own code.
  *
+ *  A whole NAND page can be passed at once. The last block is padded with
+ *  zeroes if @p size is no multiple of 256.
+ *
  *  @param[in]  data  Data to compute code for.
  *  @param[in]  size  Data size in bytes.
- *  @param[out] code  Codes buffer.
+ *  @param[out] code  Codes buffer of HAMMING256_CODE_SIZE(@p size) bytes.
  */
 void hamming_compute256x( const uint8_t *data, uint32_t size, uint8_t *code );
 
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event Event queue
+ * @ingroup     sys
+ * @brief       Provides an event queue to run deferred work in a thread
+ *
+ * An event queue is a list of @ref event_t structures, each with a handler
+ * function that is called by the thread owning the queue. Events can be
+ * posted from threads and from interrupt context. Posting an event that is
+ * already queued has no effect, so an event never needs to be allocated
+ * dynamically.
+ *
+ * Several modules can share one queue (and thus one thread and one stack)
+ * instead of spawning a thread each. The `event_thread` module provides such
+ * a shared queue with its own thread, see @ref event_queue_shared.
+ * Events that should be posted after a delay can be scheduled using
+ * @ref sys_event_timeout.
+ *
+ * The queue owner is woken using @ref THREAD_FLAG_EVENT, so the owner can use
+ * thread flags to wait for other things at the same time.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void _handler(event_t *event)
+ * {
+ *     (void)event;
+ *     puts("triggered");
+ * }
+ *
+ * static event_t event = { .handler = _handler };
+ *
+ * static void *thread(void *arg)
+ * {
+ *     event_queue_t queue;
+ *     event_queue_init(&queue);
+ *     event_loop(&queue);
+ *     return NULL;
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event queue API
+ */
+
+#ifndef EVENT_H
+#define EVENT_H
+
+#include <stdint.h>
+
+#include "clist.h"
+#include "kernel_defines.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Thread flag used to signal a queue owner
+ */
+#ifndef THREAD_FLAG_EVENT
+#define THREAD_FLAG_EVENT   (0x1)
+#endif
+
+/**
+ * @brief   event_t forward declaration
+ */
+typedef struct event event_t;
+
+/**
+ * @brief   Event handler type
+ */
+typedef void (*event_handler_t)(event_t *);
+
+/**
+ * @brief   Event structure
+ */
+struct event {
+    clist_node_t list_node;     /**< event queue list entry */
+    event_handler_t handler;    /**< pointer to event handler function */
+};
+
+/**
+ * @brief   Event queue structure
+ */
+typedef struct {
+    clist_node_t event_list;    /**< list of queued events */
+    thread_t *waiter;           /**< thread owning the queue */
+} event_queue_t;
+
+/**
+ * @brief   Static initializer for an event queue owned by the calling thread
+ */
+#define EVENT_QUEUE_INIT    { .waiter = (thread_t *)sched_active_thread }
+
+/**
+ * @brief   Initialize an event queue and make the calling thread its owner
+ *
+ * @param[out]  queue   event queue object to initialize
+ */
+static inline void event_queue_init(event_queue_t *queue)
+{
+    event_queue_t tmp = EVENT_QUEUE_INIT;
+    *queue = tmp;
+}
+
+/**
+ * @brief   Queue an event
+ *
+ * Does nothing if @p event is already queued. May be called from interrupt
+ * context.
+ *
+ * @param[in]   queue   event queue to queue event in
+ * @param[in]   event   event to queue
+ */
+void event_post(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Remove an event from a queue
+ *
+ * Does nothing if @p event is not queued.
+ *
+ * @param[in]   queue   event queue to remove event from
+ * @param[in]   event   event to remove
+ */
+void event_cancel(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Get the next event from a queue, non-blocking
+ *
+ * @param[in]   queue   event queue to get event from
+ *
+ * @return  pointer to the next event
+ * @return  NULL if the queue is empty
+ */
+event_t *event_get(event_queue_t *queue);
+
+/**
+ * @brief   Get the next event from a queue, blocking
+ *
+ * @pre     The calling thread owns @p queue.
+ *
+ * @param[in]   queue   event queue to get event from
+ *
+ * @return  pointer to the next event
+ */
+event_t *event_wait(event_queue_t *queue);
+
+/**
+ * @brief   Process events of a queue forever
+ *
+ * @pre     The calling thread owns @p queue.
+ *
+ * @param[in]   queue   event queue to process
+ */
+NORETURN void event_loop(event_queue_t *queue);
+
+#if defined(MODULE_EVENT_THREAD) || defined(DOXYGEN)
+/**
+ * @brief   Event queue served by the shared event thread
+ *
+ * Provided by the `event_thread` module.
+ */
+extern event_queue_t event_queue_shared;
+
+/**
+ * @brief   Start the shared event thread
+ *
+ * Called by auto_init.
+ */
+void event_thread_init(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_H */
+/** @} */
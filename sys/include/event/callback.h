@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event_callback Callback events
+ * @ingroup     sys_event
+ * @brief       Events that call a function with an argument
+ *
+ * @{
+ *
+ * @file
+ * @brief       Callback event API
+ */
+
+#ifndef EVENT_CALLBACK_H
+#define EVENT_CALLBACK_H
+
+#include "event.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Callback event structure
+ */
+typedef struct {
+    event_t super;              /**< event_t structure that gets extended */
+    void (*callback)(void *);   /**< callback function */
+    void *arg;                  /**< callback function argument */
+} event_callback_t;
+
+/**
+ * @brief   Event handler of callback events (internal)
+ *
+ * @param[in]   event   the event_callback_t to run
+ */
+void _event_callback_handler(event_t *event);
+
+/**
+ * @brief   Static initializer for a callback event
+ *
+ * @param[in]   cb      callback function
+ * @param[in]   cb_arg  argument for @p cb
+ */
+#define EVENT_CALLBACK_INIT(cb, cb_arg) \
+    { .super = { .handler = _event_callback_handler }, \
+      .callback = (cb), .arg = (void *)(cb_arg) }
+
+/**
+ * @brief   Initialize a callback event
+ *
+ * @param[out]  event_callback  object to initialize
+ * @param[in]   callback        callback function
+ * @param[in]   arg             argument for @p callback
+ */
+void event_callback_init(event_callback_t *event_callback,
+                         void (*callback)(void *), void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_CALLBACK_H */
+/** @} */
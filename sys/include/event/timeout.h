@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event_timeout Timed events
+ * @ingroup     sys_event
+ * @brief       Post events after a delay using xtimer
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event timeout API
+ */
+
+#ifndef EVENT_TIMEOUT_H
+#define EVENT_TIMEOUT_H
+
+#include "event.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Timeout event structure
+ */
+typedef struct {
+    xtimer_t timer;         /**< xtimer object used for the timeout */
+    event_queue_t *queue;   /**< event queue to post the event to */
+    event_t *event;         /**< event to post after the timeout */
+} event_timeout_t;
+
+/**
+ * @brief   Initialize a timeout event
+ *
+ * @param[out]  event_timeout   object to initialize
+ * @param[in]   queue           queue that @p event will be posted to
+ * @param[in]   event           event to post
+ */
+void event_timeout_init(event_timeout_t *event_timeout, event_queue_t *queue,
+                        event_t *event);
+
+/**
+ * @brief   Post the event after @p timeout microseconds
+ *
+ * Setting an already set timeout restarts it.
+ *
+ * @param[in]   event_timeout   timeout event object to set
+ * @param[in]   timeout         timeout in microseconds
+ */
+void event_timeout_set(event_timeout_t *event_timeout, uint32_t timeout);
+
+/**
+ * @brief   Stop a timeout event
+ *
+ * An event that was already posted is not removed from the queue.
+ *
+ * @param[in]   event_timeout   timeout event object to clear
+ */
+void event_timeout_clear(event_timeout_t *event_timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_TIMEOUT_H */
+/** @} */
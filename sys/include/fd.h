@@ -50,6 +50,15 @@ typedef struct {
 
     /** Close the file descriptor *fd*. */
     int (*close)(int fd);
+
+    /**
+     * Return the events of *events* that are pending on *fd*, as for
+     * poll(). NULL if *fd* is always ready for reading and writing.
+     */
+    short (*poll)(int fd, short events);
+
+    /** File status flags, as set with fcntl(). */
+    int flags;
 } fd_t;
 
 /**
@@ -91,6 +100,17 @@ fd_t *fd_get(int fd);
  */
 void fd_destroy(int fd);
 
+/**
+ * @brief   Wakes up the threads that wait in poll(), so they check their
+ *          file descriptors again.
+ *
+ * A file descriptor with a fd_t::poll function calls this when it becomes
+ * ready. May be called from interrupt context.
+ *
+ * @note    Only available with module `posix_poll`.
+ */
+void fd_poll_notify(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_flash_digest Flash digest
+ * @ingroup     sys
+ * @brief       Computes message digests over flash contents, e.g. to verify
+ *              firmware images
+ *
+ * Memory-mapped flash is hashed in place. Flash that has to be read through
+ * a driver, e.g. an @ref nvram_t or an SPI NOR driver, is streamed through a
+ * buffer of any size, so the image never has to fit into RAM.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Flash digest interface
+ */
+
+#ifndef FLASH_DIGEST_H
+#define FLASH_DIGEST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cpu.h"
+#include "hashes/digest.h"
+#include "nvram.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the buffer put on the stack if no buffer is given
+ */
+#ifndef FLASH_DIGEST_CHUNK
+#define FLASH_DIGEST_CHUNK      (64U)
+#endif
+
+/**
+ * @brief   Reads from flash that is not memory-mapped
+ *
+ * @param[in] arg   argument given to flash_digest_read()
+ * @param[out] dst  buffer to read into
+ * @param[in] addr  address in flash
+ * @param[in] len   number of bytes to read
+ *
+ * @return  @p len on success
+ * @return  <0 on error
+ */
+typedef int (*flash_digest_read_t)(void *arg, uint8_t *dst, uint32_t addr,
+                                   size_t len);
+
+/**
+ * @brief   Computes the digest of memory-mapped flash
+ *
+ * @param[in] algo      digest algorithm, e.g. @ref digest_sha256
+ * @param[in] addr      start of the data
+ * @param[in] len       length of the data in bytes
+ * @param[out] digest   the digest, algo->digest_len bytes
+ */
+void flash_digest_mem(const digest_algo_t *algo, const void *addr,
+                      size_t len, void *digest);
+
+#if defined(FLASHPAGE_SIZE) || defined(DOXYGEN)
+/**
+ * @brief   Computes the digest of the internal flash starting at a page
+ *
+ * @param[in] algo      digest algorithm, e.g. @ref digest_sha256
+ * @param[in] page      first page of the data
+ * @param[in] len       length of the data in bytes
+ * @param[out] digest   the digest, algo->digest_len bytes
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the data exceeds the flash
+ */
+int flash_digest_pages(const digest_algo_t *algo, int page, size_t len,
+                       void *digest);
+#endif
+
+/**
+ * @brief   Computes the digest of flash that is read through a driver
+ *
+ * @param[in] algo      digest algorithm, e.g. @ref digest_sha256
+ * @param[in] read      read function of the driver
+ * @param[in] arg       argument passed to @p read
+ * @param[in] addr      start of the data in flash
+ * @param[in] len       length of the data in bytes
+ * @param[in] buf       buffer the data is read into chunk by chunk, NULL to
+ *                      use FLASH_DIGEST_CHUNK bytes of stack
+ * @param[in] buf_len   length of @p buf
+ * @param[out] digest   the digest, algo->digest_len bytes
+ *
+ * @return  0 on success
+ * @return  the error returned by @p read
+ */
+int flash_digest_read(const digest_algo_t *algo, flash_digest_read_t read,
+                      void *arg, uint32_t addr, size_t len, uint8_t *buf,
+                      size_t buf_len, void *digest);
+
+/**
+ * @brief   Computes the digest of data on an NVRAM device
+ *
+ * @see flash_digest_read(), the parameters are the same except for @p dev
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the data exceeds the device
+ * @return  the error returned by the device's read function
+ */
+int flash_digest_nvram(const digest_algo_t *algo, nvram_t *dev, uint32_t addr,
+                       size_t len, uint8_t *buf, size_t buf_len, void *digest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FLASH_DIGEST_H */
+/** @} */
@@ -29,6 +29,17 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Maximum length of a string written by fmt_s32_dfp() with
+ *        @p fp_digits >= 0
+ */
+#define FMT_S32_DFP_MAXLEN  (12U)
+
+/**
+ * @brief Maximum length of a string written by fmt_float()
+ */
+#define FMT_FLOAT_MAXLEN    (19U)
+
 /**
  * @brief Format a byte value as hex
  *
@@ -179,14 +190,59 @@ size_t fmt_s16_dec(char *out, int16_t val);
  * been written.
  *
  * @param[out] out          Pointer to the output buffer, or NULL
- * @param[in]  val          Fixed point value, MUST be <= 4
- * @param[in]  fp_digits    Number of digits after the decimal point
+ * @param[in]  val          Fixed point value
+ * @param[in]  fp_digits    Number of digits after the decimal point, MUST be
+ *                          <= 4
  *
  * @return      Length of the resulting string
  * @return      0 if @p fp_digits is > 4
  */
 size_t fmt_s16_dfp(char *out, int16_t val, unsigned fp_digits);
 
+/**
+ * @brief Convert 32-bit fixed point number to a decimal string
+ *
+ * Works like fmt_s16_dfp(), but @p fp_digits may also be negative to scale
+ * the value up: for @p val := 42 and @p fp_digits := -3 the result will be
+ * "42000". This allows to print a value with a decimal exponent, e.g. the
+ * phydat_t::scale, directly.
+ *
+ * If @p out is NULL, will only return the number of bytes that would have
+ * been written.
+ *
+ * @param[out] out          Pointer to the output buffer, or NULL
+ * @param[in]  val          Fixed point value
+ * @param[in]  fp_digits    Number of digits after the decimal point, MUST be
+ *                          <= 9
+ *
+ * @return      Length of the resulting string, at most
+ *              @ref FMT_S32_DFP_MAXLEN for @p fp_digits >= 0
+ * @return      0 if @p fp_digits is > 9
+ */
+size_t fmt_s32_dfp(char *out, int32_t val, int fp_digits);
+
+/**
+ * @brief Format float to string
+ *
+ * Converts @p f to a decimal string with @p precision digits after the
+ * decimal point, rounded like printf("%.*f") does for most values. This is
+ * much smaller and faster than printf's float support, but only covers
+ * values up to 2^32 - 1; larger values are written as "inf". NaN is written
+ * as "nan".
+ *
+ * If @p out is NULL, will only return the number of bytes that would have
+ * been written.
+ *
+ * @param[out] out          Pointer to the output buffer, or NULL
+ * @param[in]  f            Value to convert
+ * @param[in]  precision    Number of digits after the decimal point, values
+ *                          larger than 7 are treated as 7
+ *
+ * @return      Length of the resulting string, at most
+ *              @ref FMT_FLOAT_MAXLEN
+ */
+size_t fmt_float(char *out, float f, unsigned precision);
+
 /**
  * @brief Count characters until '\0' (exclusive) in @p str
  *
@@ -245,6 +301,26 @@ void print_u32_dec(uint32_t val);
  */
 void print_s32_dec(int32_t val);
 
+/**
+ * @brief Print 32-bit fixed point value to stdout
+ *
+ * @see fmt_s32_dfp()
+ *
+ * @param[in]   val         Fixed point value
+ * @param[in]   fp_digits   Number of digits after the decimal point
+ */
+void print_s32_dfp(int32_t val, int fp_digits);
+
+/**
+ * @brief Print float value to stdout
+ *
+ * @see fmt_float()
+ *
+ * @param[in]   f           Value to print
+ * @param[in]   precision   Number of digits after the decimal point
+ */
+void print_float(float f, unsigned precision);
+
 /**
  * @brief Print uint32 value as hex to stdout
  *
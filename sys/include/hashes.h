@@ -155,6 +155,94 @@ uint32_t rotating_hash(const uint8_t *buf, size_t len);
  */
 uint32_t one_at_a_time_hash(const uint8_t *buf, size_t len);
 
+/**
+ * @brief FNV-1a, 32 bit
+ * Unlike fnv_hash() this uses the offset basis and prime of the actual
+ * FNV-1a definition (http://www.isthe.com/chongo/tech/comp/fnv/), so the
+ * results match other implementations.
+ * @param buf input buffer to hash
+ * @param len length of buffer
+ * @return 32 bit sized hash
+ */
+uint32_t fnv1a_32_hash(const uint8_t *buf, size_t len);
+
+/**
+ * @brief FNV-1a, 64 bit
+ * @param buf input buffer to hash
+ * @param len length of buffer
+ * @return 64 bit sized hash
+ */
+uint64_t fnv1a_64_hash(const uint8_t *buf, size_t len);
+
+/**
+ * @brief Finalizer of MurmurHash3, 32 bit
+ * Mixes all bits of @p h into all bits of the result. Turns integer keys or
+ * the result of a weak hash into a well distributed table index.
+ * @param h value to mix
+ * @return mixed value
+ */
+static inline uint32_t murmur3_fmix32(uint32_t h)
+{
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * @brief Finalizer of MurmurHash3, 64 bit
+ * @param h value to mix
+ * @return mixed value
+ */
+static inline uint64_t murmur3_fmix64(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * @name FNV-1a of string literals at compile time
+ *
+ * HASHES_FNV1A_32_STR("/sensors/temp") equals
+ * fnv1a_32_hash((uint8_t *)"/sensors/temp", 13), but is folded to a
+ * constant by the compiler, so it can be used in static initializers of
+ * e.g. resource or command tables. Strings are limited to
+ * HASHES_STR_MAX_LEN characters, longer ones fail to compile.
+ * @{
+ */
+#define HASHES_STR_MAX_LEN          (64U)   /**< longest string that can be hashed */
+
+/** @cond INTERNAL */
+#define _HASHES_STR_IN(s, i)        ((i) < sizeof(s) - 1)
+#define _HASHES_FNV1(s, i, h) \
+    ((uint32_t)((h) ^ (_HASHES_STR_IN(s, i) ? \
+                       (uint8_t)(s)[_HASHES_STR_IN(s, i) ? (i) : 0] : 0U)) * \
+     (_HASHES_STR_IN(s, i) ? 0x01000193UL : 1U))
+#define _HASHES_FNV4(s, i, h) \
+    _HASHES_FNV1(s, (i) + 3, _HASHES_FNV1(s, (i) + 2, \
+    _HASHES_FNV1(s, (i) + 1, _HASHES_FNV1(s, i, h))))
+#define _HASHES_FNV16(s, i, h) \
+    _HASHES_FNV4(s, (i) + 12, _HASHES_FNV4(s, (i) + 8, \
+    _HASHES_FNV4(s, (i) + 4, _HASHES_FNV4(s, i, h))))
+#define _HASHES_FNV64(s, h) \
+    _HASHES_FNV16(s, 48, _HASHES_FNV16(s, 32, \
+    _HASHES_FNV16(s, 16, _HASHES_FNV16(s, 0, h))))
+/** @endcond */
+
+/**
+ * @brief FNV-1a, 32 bit, of the string literal @p s without its terminator
+ */
+#define HASHES_FNV1A_32_STR(s) \
+    ((uint32_t)(_HASHES_FNV64(s, 0x811c9dc5UL) + \
+                0 * sizeof(char[(sizeof(s) - 1 <= HASHES_STR_MAX_LEN) ? 1 : -1])))
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_hashes
+ * @{
+ *
+ * @file
+ * @brief       Common interface to the message digests in sys/hashes
+ *
+ * Lets code that only moves data around, e.g. flash_digest, work with any
+ * of the hash functions.
+ */
+
+#ifndef HASHES_DIGEST_H
+#define HASHES_DIGEST_H
+
+#include <stddef.h>
+
+#include "hashes/md5.h"
+#include "hashes/sha1.h"
+#include "hashes/sha256.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Context large enough for any of the digests
+ */
+typedef union {
+    md5_ctx_t md5;              /**< MD5 context */
+    sha1_context sha1;          /**< SHA-1 context */
+    sha256_context_t sha256;    /**< SHA-256 context */
+} digest_ctx_t;
+
+/**
+ * @brief   Message digest algorithm
+ */
+typedef struct {
+    size_t digest_len;                                  /**< length of the
+                                                         *   digest in bytes */
+    void (*init)(digest_ctx_t *ctx);                    /**< starts a digest */
+    void (*update)(digest_ctx_t *ctx, const void *data,
+                   size_t len);                         /**< adds data */
+    void (*final)(digest_ctx_t *ctx, void *digest);     /**< writes the
+                                                         *   digest */
+} digest_algo_t;
+
+extern const digest_algo_t digest_md5;      /**< MD5 */
+extern const digest_algo_t digest_sha1;     /**< SHA-1 */
+extern const digest_algo_t digest_sha256;   /**< SHA-256 */
+
+/**
+ * @brief   Maximum length of any of the digests in bytes
+ */
+#define DIGEST_MAX_LENGTH   (SHA256_DIGEST_LENGTH)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HASHES_DIGEST_H */
+/** @} */
@@ -132,6 +132,106 @@ void *sha256(const void *data, size_t len, void *digest);
 const void *hmac_sha256(const void *key, size_t key_length,
                         const void *data, size_t len, void *digest);
 
+/**
+ * @brief HMAC-SHA256 key with the inner and outer hash states precomputed
+ *
+ * Computing several HMACs with the same key from this saves hashing the
+ * key and the two key pads for every message.
+ */
+typedef struct {
+    sha256_context_t inner;     /**< state after hashing the inner key pad */
+    sha256_context_t outer;     /**< state after hashing the outer key pad */
+} hmac_sha256_key_t;
+
+/**
+ * @brief Context for an incremental HMAC-SHA256 computation
+ */
+typedef struct {
+    sha256_context_t ctx;           /**< inner hash of the message */
+    const hmac_sha256_key_t *key;   /**< key the HMAC is computed with */
+} hmac_sha256_context_t;
+
+/**
+ * @brief Precomputes the hash states of an HMAC-SHA256 key
+ *
+ * @param[out] hkey       the precomputed key
+ * @param[in] key         key used in the hmac-sha256 computation
+ * @param[in] key_length  the size in bytes of the key
+ */
+void hmac_sha256_key_init(hmac_sha256_key_t *hkey, const void *key,
+                          size_t key_length);
+
+/**
+ * @brief Starts an HMAC-SHA256 computation with a precomputed key
+ *
+ * @param[out] ctx   the HMAC context
+ * @param[in] hkey   the precomputed key, must stay valid until
+ *                   hmac_sha256_final() was called
+ */
+void hmac_sha256_init(hmac_sha256_context_t *ctx,
+                      const hmac_sha256_key_t *hkey);
+
+/**
+ * @brief Adds bytes to an HMAC-SHA256 computation
+ *
+ * @param[in,out] ctx   the HMAC context
+ * @param[in] data      the message part
+ * @param[in] len       the length of @p data in bytes
+ */
+void hmac_sha256_update(hmac_sha256_context_t *ctx, const void *data,
+                        size_t len);
+
+/**
+ * @brief Finishes an HMAC-SHA256 computation
+ *
+ * @param[in,out] ctx   the HMAC context, cleared afterwards
+ * @param[out] digest   the computed hmac-sha256,
+ *                      length MUST be SHA256_DIGEST_LENGTH
+ */
+void hmac_sha256_final(hmac_sha256_context_t *ctx, void *digest);
+
+/**
+ * @brief HKDF-SHA256 extract step (RFC 5869)
+ *
+ * @param[in] salt       optional salt, may be NULL
+ * @param[in] salt_len   length of @p salt in bytes
+ * @param[in] ikm        input keying material
+ * @param[in] ikm_len    length of @p ikm in bytes
+ * @param[out] prk       the pseudorandom key, SHA256_DIGEST_LENGTH bytes
+ */
+void hkdf_sha256_extract(const void *salt, size_t salt_len,
+                         const void *ikm, size_t ikm_len, void *prk);
+
+/**
+ * @brief HKDF-SHA256 expand step (RFC 5869)
+ *
+ * @param[in] prk        pseudorandom key, e.g. from hkdf_sha256_extract()
+ * @param[in] prk_len    length of @p prk in bytes
+ * @param[in] info       optional context information, may be NULL
+ * @param[in] info_len   length of @p info in bytes
+ * @param[out] okm       the output keying material
+ * @param[in] okm_len    length of @p okm in bytes
+ *
+ * @return  0 on success
+ * @return  -1 if @p okm_len exceeds 255 * SHA256_DIGEST_LENGTH
+ */
+int hkdf_sha256_expand(const void *prk, size_t prk_len,
+                       const void *info, size_t info_len,
+                       void *okm, size_t okm_len);
+
+/**
+ * @brief HKDF-SHA256 (RFC 5869), extract and expand in one call
+ *
+ * @see hkdf_sha256_extract(), hkdf_sha256_expand()
+ *
+ * @return  0 on success
+ * @return  -1 if @p okm_len exceeds 255 * SHA256_DIGEST_LENGTH
+ */
+int hkdf_sha256(const void *salt, size_t salt_len,
+                const void *ikm, size_t ikm_len,
+                const void *info, size_t info_len,
+                void *okm, size_t okm_len);
+
 /**
  * @brief function to produce a hash chain statring with a given seed element.
  *        The chain is computed by taking the sha256 from the seed,
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_hashes_siphash SipHash
+ * @ingroup     sys_hashes
+ * @brief       SipHash-2-4 keyed hash for hash tables
+ *
+ * Keys of a table hashed with a secret, random key cannot be chosen by an
+ * attacker to all land in the same bucket. The input is processed eight
+ * bytes at a time.
+ *
+ * See https://131002.net/siphash/ for details.
+ *
+ * @{
+ *
+ * @file
+ * @brief       SipHash-2-4 interface definition
+ */
+
+#ifndef HASHES_SIPHASH_H
+#define HASHES_SIPHASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of a SipHash key in byte
+ */
+#define SIPHASH_KEY_LENGTH  (16)
+
+/**
+ * @brief   Computes SipHash-2-4
+ *
+ * @param[in] key   SIPHASH_KEY_LENGTH bytes of key
+ * @param[in] buf   input buffer to hash
+ * @param[in] len   length of @p buf
+ *
+ * @return  64 bit hash, as the little endian interpretation of the
+ *          reference implementation's output
+ */
+uint64_t siphash24(const uint8_t *key, const uint8_t *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HASHES_SIPHASH_H */
+/** @} */
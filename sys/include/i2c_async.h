@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_i2c_async Asynchronous I2C transfers
+ * @ingroup     sys
+ * @brief       Queues I2C transfers and reports their completion by callback
+ *
+ * Requests are queued with i2c_async_submit() and run one after another by a
+ * dedicated thread using the blocking @ref drivers_periph_i2c interface. The
+ * submitting thread continues right away and learns about the result through
+ * the request's callback, which is executed in the I2C thread. A thread
+ * reading several sensors can thus queue all reads at once and compute while
+ * they are carried out, instead of waiting for each of them in turn.
+ *
+ * Requests are not copied, so they must stay valid until their callback ran.
+ * The I2C thread acquires the bus for each request, requests can thus be
+ * mixed with blocking accesses from other threads.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Asynchronous I2C transfer API
+ */
+
+#ifndef I2C_ASYNC_H
+#define I2C_ASYNC_H
+
+#include <stdint.h>
+
+#include "event.h"
+#include "periph/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Stack size of the I2C thread
+ */
+#ifndef I2C_ASYNC_STACKSIZE
+#define I2C_ASYNC_STACKSIZE     (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the I2C thread
+ */
+#ifndef I2C_ASYNC_PRIO
+#define I2C_ASYNC_PRIO          (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @name    Request flags
+ * @{
+ */
+#define I2C_ASYNC_WRITE         (0x00)  /**< write to the device */
+#define I2C_ASYNC_READ          (0x01)  /**< read from the device */
+#define I2C_ASYNC_REG           (0x02)  /**< access the register
+                                         *   i2c_async_req_t::reg */
+/** @} */
+
+/**
+ * @brief   i2c_async_req_t forward declaration
+ */
+typedef struct i2c_async_req i2c_async_req_t;
+
+/**
+ * @brief   Completion callback, executed in the I2C thread
+ */
+typedef void (*i2c_async_cb_t)(i2c_async_req_t *req);
+
+/**
+ * @brief   Asynchronous I2C request
+ */
+struct i2c_async_req {
+    event_t event;          /**< queue entry, for internal use */
+    i2c_t dev;              /**< I2C bus to use */
+    uint8_t addr;           /**< slave address */
+    uint8_t reg;            /**< register, if I2C_ASYNC_REG is set */
+    uint8_t flags;          /**< request flags */
+    void *data;             /**< data to write or buffer to read into */
+    int len;                /**< number of bytes to transfer */
+    int res;                /**< number of bytes transferred, negative on
+                             *   error, set before @p cb is called */
+    i2c_async_cb_t cb;      /**< completion callback, may be NULL */
+    void *arg;              /**< argument for the callback's use */
+};
+
+/**
+ * @brief   Start the I2C thread
+ *
+ * Called by auto_init.
+ */
+void i2c_async_init(void);
+
+/**
+ * @brief   Queue a request
+ *
+ * Does nothing if @p req is already queued. May be called from interrupt
+ * context.
+ *
+ * @param[in]   req     request to queue, all fields but
+ *                      i2c_async_req_t::event and i2c_async_req_t::res must
+ *                      be set
+ */
+void i2c_async_submit(i2c_async_req_t *req);
+
+/**
+ * @brief   Remove a queued request
+ *
+ * Does nothing if @p req is not queued, e.g., because it is being carried out
+ * already.
+ *
+ * @param[in]   req     request to remove
+ */
+void i2c_async_cancel(i2c_async_req_t *req);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I2C_ASYNC_H */
+/** @} */
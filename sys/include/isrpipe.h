@@ -25,7 +25,7 @@
 #include <stdint.h>
 
 #include "mutex.h"
-#include "tsrb.h"
+#include "spscrb.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,13 +36,15 @@ extern "C" {
  */
 typedef struct {
     mutex_t mutex;      /**< isrpipe mutex */
-    tsrb_t tsrb;        /**< isrpipe thread safe ringbuffer */
+    spscrb_t rb;        /**< isrpipe lock-free ringbuffer */
+    unsigned watermark; /**< bytes needed to wake the reader */
 } isrpipe_t;
 
 /**
  * @brief   Static initializer for irspipe
  */
-#define ISRPIPE_INIT(tsrb_buf) { .mutex = MUTEX_INIT, .tsrb = TSRB_INIT(tsrb_buf) }
+#define ISRPIPE_INIT(buf) { .mutex = MUTEX_INIT, .rb = SPSCRB_INIT(buf, 1), \
+                            .watermark = 1 }
 
 /**
  * @brief   Initialisation function for isrpipe
@@ -53,6 +55,36 @@ typedef struct {
  */
 void isrpipe_init(isrpipe_t *isrpipe, char *buf, size_t bufsize);
 
+/**
+ * @brief   Set the number of buffered bytes that wakes a waiting reader
+ *
+ * By default, every byte written wakes the reader. With a higher watermark,
+ * a blocked reader sleeps until @p watermark bytes are buffered, the buffer
+ * is full, isrpipe_wake() is called or the timeout of
+ * isrpipe_read_timeout() expires, so a burst of bytes from an ISR costs a
+ * single context switch. Reads still return everything that is available.
+ *
+ * @param[in]   isrpipe     isrpipe object to operate on
+ * @param[in]   watermark   number of bytes, 1 to wake on every byte
+ */
+static inline void isrpipe_set_watermark(isrpipe_t *isrpipe, unsigned watermark)
+{
+    isrpipe->watermark = watermark;
+}
+
+/**
+ * @brief   Wake a reader waiting for the watermark
+ *
+ * For writers that know a burst is complete, e.g. on an idle line or at the
+ * end of a frame. Can be called from interrupt context.
+ *
+ * @param[in]   isrpipe     isrpipe object to operate on
+ */
+static inline void isrpipe_wake(isrpipe_t *isrpipe)
+{
+    mutex_unlock(&isrpipe->mutex);
+}
+
 /**
  * @brief   Put one character into the isrpipe's buffer
  *
@@ -64,6 +96,22 @@ void isrpipe_init(isrpipe_t *isrpipe, char *buf, size_t bufsize);
  */
 int isrpipe_write_one(isrpipe_t *isrpipe, char c);
 
+/**
+ * @brief   Put a burst of characters into the isrpipe's buffer
+ *
+ * The data is copied with at most two memcpy calls, so this should be
+ * preferred over calling @ref isrpipe_write_one() in a loop, e.g., from
+ * a DMA or FIFO interrupt.
+ *
+ * @param[in]   isrpipe     isrpipe object to operate on
+ * @param[in]   buf         characters to add to the isrpipe buffer
+ * @param[in]   count       number of characters in @p buf
+ *
+ * @returns     number of characters added, may be less than @p count if the
+ *              buffer is full
+ */
+size_t isrpipe_write(isrpipe_t *isrpipe, const char *buf, size_t count);
+
 /**
  * @brief   Read data from isrpipe (blocking)
  *
@@ -75,6 +123,33 @@ int isrpipe_write_one(isrpipe_t *isrpipe, char c);
  */
 int isrpipe_read(isrpipe_t *isrpipe, char *buf, size_t count);
 
+/**
+ * @brief   Get the buffered data without copying it (blocking)
+ *
+ * Waits like isrpipe_read() until data is available. The returned region
+ * is contiguous and stays valid until it is released with
+ * isrpipe_release(), so the data can be parsed in place.
+ *
+ * @param[in]   isrpipe    isrpipe object to operate on
+ * @param[out]  region     start of the buffered data
+ *
+ * @returns     number of bytes at @p region, there may be more after
+ *              releasing them
+ */
+size_t isrpipe_peek(isrpipe_t *isrpipe, char **region);
+
+/**
+ * @brief   Drop data returned by isrpipe_peek()
+ *
+ * @param[in]   isrpipe    isrpipe object to operate on
+ * @param[in]   count      number of bytes to drop, at most the return value
+ *                         of isrpipe_peek()
+ */
+static inline void isrpipe_release(isrpipe_t *isrpipe, size_t count)
+{
+    spscrb_release(&isrpipe->rb, count);
+}
+
 /**
  * @brief   Read data from isrpipe (with timeout, blocking)
  *
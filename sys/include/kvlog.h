@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_kvlog Log-structured key/value store
+ * @ingroup     sys
+ * @brief       Key/value store for flash and NVRAM with append-only writes
+ *
+ * Values are appended to a log of sectors instead of being rewritten in
+ * place, so updating a value never erases flash. A sector is erased only
+ * when it is reclaimed: the oldest sector's values that are still current
+ * are copied to the head of the log and the sector is erased. As the log
+ * cycles through all sectors, they wear evenly. The erase count of each
+ * sector is kept in its header.
+ *
+ * An index in RAM maps each key to its current record, it is rebuilt from
+ * the log by kvlog_init(). Each record is protected by a CRC, so a record
+ * torn by a reset is ignored.
+ *
+ * Reclaiming happens in kvlog_set() when the log runs out of space. A low
+ * priority thread can call kvlog_compact() to do it ahead of time, so the
+ * writers rarely wait for an erase.
+ *
+ * The store works on an @ref nvram_t. For the internal flash, a
+ * @ref kvlog_flashpage_t provides one on top of @ref
+ * drivers_periph_flashpage, which can only write whole pages: it collects
+ * the writes to one page in RAM and writes the page when the log moves on
+ * or kvlog_flush() is called, so filling a page costs a single erase.
+ * Records not flushed are lost on reset.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Log-structured key/value store interface
+ */
+
+#ifndef KVLOG_H
+#define KVLOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mutex.h"
+#include "nvram.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of keys in a store
+ */
+#ifndef KVLOG_KEYS_NUMOF
+#define KVLOG_KEYS_NUMOF        (32U)
+#endif
+
+/**
+ * @brief   Number of erased sectors kvlog_compact() keeps available
+ */
+#ifndef KVLOG_FREE_SECTORS
+#define KVLOG_FREE_SECTORS      (2U)
+#endif
+
+/**
+ * @brief   Invalid key, marks the erased space after the last record
+ */
+#define KVLOG_KEY_INVALID       (0xffff)
+
+/**
+ * @brief   Index entry
+ */
+typedef struct {
+    uint16_t key;               /**< key */
+    uint16_t len;               /**< length of the value */
+    uint32_t addr;              /**< offset of the current record */
+} kvlog_entry_t;
+
+/**
+ * @brief   Key/value store
+ */
+typedef struct {
+    nvram_t *dev;               /**< device holding the log */
+    int (*flush)(nvram_t *dev); /**< writes buffered data, may be NULL */
+    uint32_t offset;            /**< start of the log on dev */
+    uint32_t sector_size;       /**< size of a sector */
+    unsigned sectors;           /**< number of sectors */
+    unsigned head;              /**< sector written to */
+    unsigned tail;              /**< oldest sector */
+    unsigned free;              /**< number of erased sectors */
+    uint32_t pos;               /**< write position in the head sector */
+    uint32_t seq;               /**< sequence number of the next sector */
+    uint32_t erases;            /**< sectors erased since kvlog_init() */
+    unsigned keys;              /**< number of keys in index */
+    kvlog_entry_t index[KVLOG_KEYS_NUMOF];  /**< key index */
+    mutex_t lock;               /**< serializes access */
+} kvlog_t;
+
+/**
+ * @brief   Open a store, formatting sectors that were never used
+ *
+ * @param[out] kv           store to initialize
+ * @param[in] dev           device to use
+ * @param[in] offset        start of the log on @p dev
+ * @param[in] sector_size   size of a sector, the unit of erasing, a
+ *                          multiple of 4
+ * @param[in] sectors       number of sectors, at least 2
+ *
+ * @return  0 on success
+ * @return  -EIO on device errors
+ * @return  -ENOMEM if the log holds more than @ref KVLOG_KEYS_NUMOF keys
+ */
+int kvlog_init(kvlog_t *kv, nvram_t *dev, uint32_t offset,
+               uint32_t sector_size, unsigned sectors);
+
+/**
+ * @brief   Read a value
+ *
+ * @param[in] kv    store
+ * @param[in] key   key of the value
+ * @param[out] buf  buffer for the value
+ * @param[in] len   size of @p buf, a longer value is truncated
+ *
+ * @return  length of the value
+ * @return  -ENOENT if @p key is not in the store
+ * @return  -EIO on device errors
+ */
+int kvlog_get(kvlog_t *kv, uint16_t key, void *buf, size_t len);
+
+/**
+ * @brief   Write a value
+ *
+ * @param[in] kv    store
+ * @param[in] key   key of the value, not @ref KVLOG_KEY_INVALID
+ * @param[in] val   the value
+ * @param[in] len   length of @p val
+ *
+ * @return  0 on success
+ * @return  -E2BIG if the value does not fit into a sector
+ * @return  -ENOMEM if @p key is new and the index is full
+ * @return  -ENOSPC if the store is full
+ * @return  -EIO on device errors
+ */
+int kvlog_set(kvlog_t *kv, uint16_t key, const void *val, size_t len);
+
+/**
+ * @brief   Delete a value
+ *
+ * @param[in] kv    store
+ * @param[in] key   key of the value
+ *
+ * @return  0 on success
+ * @return  -ENOENT if @p key is not in the store
+ * @return  -ENOSPC if the store is full
+ * @return  -EIO on device errors
+ */
+int kvlog_delete(kvlog_t *kv, uint16_t key);
+
+/**
+ * @brief   Reclaim the oldest sector if less than @ref KVLOG_FREE_SECTORS
+ *          sectors are erased
+ *
+ * @param[in] kv    store
+ *
+ * @return  1 if a sector was reclaimed
+ * @return  0 if there was nothing to do
+ * @return  -EIO on device errors
+ */
+int kvlog_compact(kvlog_t *kv);
+
+/**
+ * @brief   Write data buffered by the device
+ *
+ * @param[in] kv    store
+ *
+ * @return  0 on success
+ * @return  -EIO on device errors
+ */
+int kvlog_flush(kvlog_t *kv);
+
+/**
+ * @brief   NVRAM on top of the flash page driver
+ *
+ * Offset 0 is the start of the first page given to kvlog_init_flashpage().
+ */
+typedef struct {
+    nvram_t nvram;              /**< device, must be the first member */
+    unsigned first;             /**< first page */
+    int page;                   /**< page in buf, -1 for none */
+    uint8_t *buf;               /**< buffer of one page */
+} kvlog_flashpage_t;
+
+/**
+ * @brief   Open a store on pages of the internal flash
+ *
+ * Each page is a sector. Needs the `periph_flashpage` feature.
+ *
+ * @param[out] kv       store to initialize
+ * @param[out] fp       flash page device to initialize
+ * @param[in] buf       buffer of one flash page
+ * @param[in] first     first page to use
+ * @param[in] pages     number of pages to use, at least 2
+ *
+ * @return  see kvlog_init()
+ */
+int kvlog_init_flashpage(kvlog_t *kv, kvlog_flashpage_t *fp, uint8_t *buf,
+                         unsigned first, unsigned pages);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KVLOG_H */
+/** @} */
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_memarray Fixed-size block pool
+ * @ingroup     sys
+ * @brief       O(1) allocator for statically allocated arrays of objects
+ *
+ * A pool hands out the elements of a user supplied array. Released elements
+ * are kept in a free list that is threaded through the elements themselves,
+ * elements that were never handed out are taken from the end of the array in
+ * order, so neither allocating nor releasing ever searches for a free slot
+ * and a pool defined with @ref MEMARRAY_INIT() does not need to be
+ * initialized at run time.
+ *
+ * Each pool keeps track of the number of elements in use and of its
+ * peak usage, which helps to size the array.
+ *
+ * By default a pool must only be used from a single thread. Pools created with
+ * @ref MEMARRAY_FLAG_IRQ_SAFE disable interrupts while the free list is
+ * modified, so they can be shared between threads and ISRs.
+ *
+ * @note    The first `sizeof(void *)` bytes of a released element are
+ *          overwritten, so elements must be at least that large and the
+ *          contents of a released element must not be relied on.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Fixed-size block pool interface
+ */
+
+#ifndef MEMARRAY_H
+#define MEMARRAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Protect the pool by disabling interrupts
+ */
+#define MEMARRAY_FLAG_IRQ_SAFE  (0x01U)
+
+/**
+ * @brief   Pool structure
+ */
+typedef struct {
+    uint8_t *data;          /**< array the elements are taken from */
+    void *free;             /**< released elements */
+    size_t size;            /**< size of one element in bytes */
+    unsigned num;           /**< number of elements in data */
+    unsigned unused;        /**< elements from here on were never used */
+    unsigned used;          /**< number of elements currently in use */
+    unsigned max_used;      /**< peak of memarray_t::used */
+    unsigned flags;         /**< MEMARRAY_FLAG_* */
+} memarray_t;
+
+/**
+ * @brief   Static initializer
+ *
+ * @param[in] ARRAY     array of elements to hand out
+ * @param[in] FLAGS     MEMARRAY_FLAG_* or 0
+ */
+#define MEMARRAY_INIT(ARRAY, FLAGS) \
+    { (uint8_t *)(ARRAY), NULL, sizeof((ARRAY)[0]), \
+      sizeof(ARRAY) / sizeof((ARRAY)[0]), 0, 0, 0, (FLAGS) }
+
+/**
+ * @brief   Initialize a pool
+ *
+ * All elements are considered free afterwards, the statistics are reset.
+ *
+ * @param[out] mem      pool to initialize
+ * @param[in] data      array of @p num elements of @p size bytes
+ * @param[in] size      size of one element in bytes, at least
+ *                      `sizeof(void *)`
+ * @param[in] num       number of elements in @p data
+ * @param[in] flags     MEMARRAY_FLAG_* or 0
+ */
+void memarray_init(memarray_t *mem, void *data, size_t size, unsigned num,
+                   unsigned flags);
+
+/**
+ * @brief   Take an element from the pool
+ *
+ * @param[in] mem   pool to allocate from
+ *
+ * @return  an element of memarray_t::size bytes, its contents are undefined
+ * @return  NULL, if all elements are in use
+ */
+void *memarray_alloc(memarray_t *mem);
+
+/**
+ * @brief   Return an element to the pool
+ *
+ * @param[in] mem   pool @p ptr was allocated from
+ * @param[in] ptr   element to release, must not be used afterwards
+ */
+void memarray_free(memarray_t *mem, void *ptr);
+
+/**
+ * @brief   Get the number of elements currently in use
+ *
+ * @param[in] mem   pool
+ *
+ * @return  number of allocated elements
+ */
+static inline unsigned memarray_used(const memarray_t *mem)
+{
+    return mem->used;
+}
+
+/**
+ * @brief   Get the highest number of elements that were in use at once
+ *
+ * @param[in] mem   pool
+ *
+ * @return  peak number of allocated elements since initialization
+ */
+static inline unsigned memarray_max_used(const memarray_t *mem)
+{
+    return mem->max_used;
+}
+
+/**
+ * @brief   Get the number of elements that can still be allocated
+ *
+ * @param[in] mem   pool
+ *
+ * @return  number of free elements
+ */
+static inline unsigned memarray_available(const memarray_t *mem)
+{
+    return mem->num - mem->used;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMARRAY_H */
+/** @} */
@@ -27,7 +27,10 @@
 
 #include <stdint.h>
 
+#include "kernel_types.h"
+#include "msg.h"
 #include "net/netdev2.h"
+#include "xtimer.h"
 
 
 #ifdef __cplusplus
@@ -78,6 +81,49 @@ typedef struct {
  */
 extern const csma_sender_conf_t CSMA_SENDER_CONF_DEFAULT;
 
+/**
+ * @brief   Message type the backoff timer of an asynchronous transmission
+ *          sends to the thread that started it
+ *
+ * The message's content.ptr points to the @ref csma_sender_t of the
+ * transmission. Hand it to csma_sender_backoff_done().
+ */
+#ifndef CSMA_SENDER_MSG_TYPE_BACKOFF
+#define CSMA_SENDER_MSG_TYPE_BACKOFF        (0x0110)
+#endif
+
+/**
+ * @brief   State of an asynchronous CSMA/CA transmission
+ */
+typedef struct csma_sender csma_sender_t;
+
+/**
+ * @brief   Reports the outcome of an asynchronous CSMA/CA transmission
+ *
+ * @param[in] csma      The transmission.
+ * @param[in] res       The result, as for csma_sender_csma_ca_send().
+ */
+typedef void (*csma_sender_cb_t)(csma_sender_t *csma, int res);
+
+/**
+ * @brief   State of an asynchronous CSMA/CA transmission
+ *
+ * @note    All members are private.
+ */
+struct csma_sender {
+    netdev2_t *dev;                     /**< device to send over */
+    struct iovec *vector;               /**< data to send */
+    unsigned count;                     /**< number of elements in
+                                         *   csma_sender_t::vector */
+    const csma_sender_conf_t *conf;     /**< backoff configuration */
+    csma_sender_cb_t cb;                /**< reports the outcome */
+    xtimer_t timer;                     /**< backoff timer */
+    msg_t msg;                          /**< message of the backoff timer */
+    kernel_pid_t pid;                   /**< thread to receive the message */
+    uint16_t nb;                        /**< number of backoffs */
+    uint8_t be;                         /**< current backoff exponent */
+};
+
 /**
  * @brief   Sends a 802.15.4 frame using the CSMA/CA method
  *
@@ -104,6 +150,60 @@ extern const csma_sender_conf_t CSMA_SENDER_CONF_DEFAULT;
 int csma_sender_csma_ca_send(netdev2_t *dev, struct iovec *vector,
                              unsigned count, const csma_sender_conf_t *conf);
 
+/**
+ * @brief   Starts sending a 802.15.4 frame using the CSMA/CA method without
+ *          blocking the calling thread
+ *
+ * @pre `csma != NULL && dev != NULL && cb != NULL`
+ *
+ * Works like csma_sender_csma_ca_send(), but instead of sleeping during the
+ * backoff periods a timer sends a @ref CSMA_SENDER_MSG_TYPE_BACKOFF message
+ * to the calling thread, which has to pass it on to
+ * csma_sender_backoff_done(). Only then the channel is assessed and the frame
+ * is sent, so the thread can handle other messages in between.
+ *
+ * The outcome is always reported via @p cb, from the calling thread. If the
+ * transceiver does CSMA/CA in hardware the frame is sent right away and
+ * @p cb is called before this function returns.
+ *
+ * @param[out] csma     State of the transmission. Must stay valid, together
+ *                      with @p vector, until @p cb was called.
+ * @param[in] dev       netdev device, needs to be already initialized
+ * @param[in] vector    pointer to the data
+ * @param[in] count     number of elements in @p vector
+ * @param[in] conf      configuration for the backoff;
+ *                      will be set to @ref CSMA_SENDER_CONF_DEFAULT if NULL.
+ * @param[in] cb        reports the outcome of the transmission
+ */
+void csma_sender_csma_ca_send_async(csma_sender_t *csma, netdev2_t *dev,
+                                    struct iovec *vector, unsigned count,
+                                    const csma_sender_conf_t *conf,
+                                    csma_sender_cb_t cb);
+
+/**
+ * @brief   Continues an asynchronous transmission after its backoff period
+ *
+ * To be called by the thread that started the transmission on a
+ * @ref CSMA_SENDER_MSG_TYPE_BACKOFF message.
+ *
+ * @param[in] csma      The transmission, i.e. the message's content.ptr.
+ */
+void csma_sender_backoff_done(csma_sender_t *csma);
+
+/**
+ * @brief   Cancels an asynchronous transmission
+ *
+ * The callback of the transmission is not called. A
+ * @ref CSMA_SENDER_MSG_TYPE_BACKOFF message already queued for it must be
+ * dropped by the thread.
+ *
+ * @param[in] csma      The transmission.
+ */
+static inline void csma_sender_cancel(csma_sender_t *csma)
+{
+    xtimer_remove(&csma->timer);
+}
+
 /**
  * @brief   Sends a 802.15.4 frame when medium is avaiable.
  *
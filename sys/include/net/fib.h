@@ -11,6 +11,18 @@
  * @ingroup     net
  * @brief       FIB implementation
  *
+ * By default the entries of a table are searched linearly on every lookup.
+ * With the `fib_trie` module, single hop tables that are given a node pool in
+ * fib_table_t::trie_nodes are indexed by a binary prefix trie instead, so the
+ * lookup cost depends on the prefix lengths rather than the number of
+ * entries. The trie returns the longest matching prefix.
+ *
+ * Lookups do not check lifetimes. One timer per table is set to the earliest
+ * lifetime; once it fired, the next access removes all expired entries at
+ * once and signals them to the registered RPs with
+ * @ref FIB_MSG_RP_SIGNAL_ENTRY_EXPIRED. The RPs are signaled after the table
+ * mutex was released, so they can refresh the route from their handler.
+ *
  * @{
  *
  * @file
@@ -59,6 +71,12 @@ typedef struct {
  */
 #define FIB_MSG_RP_SIGNAL_SOURCE_ROUTE_CREATED (0x97)
 
+/**
+ * @brief message type for RP notification: the lifetime of an entry expired
+ *        and it was removed from the table
+ */
+#define FIB_MSG_RP_SIGNAL_ENTRY_EXPIRED (0x96)
+
 /**
  * @brief entry used to collect available destinations
  */
@@ -137,6 +155,43 @@ int fib_add_entry(fib_table_t *table, kernel_pid_t iface_id, uint8_t *dst,
                   size_t next_hop_size, uint32_t next_hop_flags,
                   uint32_t lifetime);
 
+/**
+ * @brief Destination of an entry added by fib_add_entries()
+ */
+typedef struct {
+    uint8_t *dst;           /**< the destination address */
+    size_t dst_size;        /**< the destination address size */
+    uint32_t dst_flags;     /**< the destination address flags */
+} fib_dst_t;
+
+/**
+ * @brief Adds or updates entries for several destinations sharing the same
+ *        next hop in one pass
+ *
+ * Behaves like calling fib_add_entry() for every destination in @p dsts, but
+ * takes the table's mutex only once and searches free entries only once for
+ * the whole batch. A destination that cannot be added does not stop the
+ * batch.
+ *
+ * @param[in] table          the fib table the entries should be added to
+ * @param[in] iface_id       the interface ID
+ * @param[in] dsts           the destinations
+ * @param[in] dsts_numof     the number of destinations in @p dsts
+ * @param[in] next_hop       the next hop address of all destinations
+ * @param[in] next_hop_size  the next hop address size
+ * @param[in] next_hop_flags the next-hop address flags
+ * @param[in] lifetime       the lifetime in ms of all entries
+ *
+ * @return 0 on success
+ *         -ENOMEM if at least one entry cannot be created due to insufficient RAM
+ *         -EFAULT if next_hop or the address of a destination is not a valid
+ *         pointer
+ */
+int fib_add_entries(fib_table_t *table, kernel_pid_t iface_id,
+                    const fib_dst_t *dsts, size_t dsts_numof, uint8_t *next_hop,
+                    size_t next_hop_size, uint32_t next_hop_flags,
+                    uint32_t lifetime);
+
 /**
  * @brief Updates an entry in the FIB table with next hop and lifetime
  *
@@ -201,6 +256,89 @@ int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
                      uint32_t* next_hop_flags, uint8_t *dst, size_t dst_size,
                      uint32_t dst_flags);
 
+#if defined(MODULE_FIB_MULTIPATH) || defined(DOXYGEN)
+/**
+ * @brief Default weight of a next hop added by fib_add_entry()
+ */
+#define FIB_WEIGHT_DEFAULT  (1U)
+
+/**
+ * @brief Adds or updates one of several next hops for a destination
+ *
+ * The next hops of a destination share its traffic in proportion to their
+ * weights. Next hops with weight 0 are backups, they are only used while the
+ * destination has no next hop with a weight. fib_add_entry() and
+ * fib_update_entry() change the first next hop of a destination,
+ * fib_remove_entry() removes all of them.
+ *
+ * @note    Only available with module `fib_multipath`.
+ *
+ * @param[in] table          the fib table the entry should be added to
+ * @param[in] iface_id       the interface ID
+ * @param[in] dst            the destination address
+ * @param[in] dst_size       the destination address size
+ * @param[in] dst_flags      the destination address flags
+ * @param[in] next_hop       the next hop address to be added or updated
+ * @param[in] next_hop_size  the next hop address size
+ * @param[in] next_hop_flags the next-hop address flags
+ * @param[in] weight         the weight of the next hop
+ * @param[in] lifetime       the lifetime in ms
+ *
+ * @return 0 on success
+ *         -ENOMEM if the entry cannot be created due to insufficient RAM
+ *         -EFAULT if dst and/or next_hop is not a valid pointer
+ */
+int fib_add_next_hop(fib_table_t *table, kernel_pid_t iface_id, uint8_t *dst,
+                     size_t dst_size, uint32_t dst_flags, uint8_t *next_hop,
+                     size_t next_hop_size, uint32_t next_hop_flags,
+                     uint8_t weight, uint32_t lifetime);
+
+/**
+ * @brief Removes one next hop of a destination
+ *
+ * @note    Only available with module `fib_multipath`.
+ *
+ * @param[in] table          the fib table containing the entry to remove
+ * @param[in] dst            the destination address
+ * @param[in] dst_size       the destination address size
+ * @param[in] next_hop       the next hop address
+ * @param[in] next_hop_size  the next hop address size
+ */
+void fib_remove_next_hop(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                         uint8_t *next_hop, size_t next_hop_size);
+
+/**
+ * @brief Like fib_get_next_hop(), but selects among several next hops of the
+ *        destination by @p flow
+ *
+ * fib_get_next_hop() hashes the destination address as flow, so all packets
+ * to a destination take the same next hop. Callers that know more about a
+ * packet, e.g. its source address and flow label, pass a hash of these with
+ * fib_flow_hash() to spread the flows to a destination over its next hops.
+ *
+ * @note    Only available with module `fib_multipath`.
+ *
+ * @param[in] flow  hash identifying the flow of the packet
+ *
+ * @see fib_get_next_hop() for the other parameters and the return values
+ */
+int fib_get_next_hop_flow(fib_table_t *table, kernel_pid_t *iface_id,
+                          uint8_t *next_hop, size_t *next_hop_size,
+                          uint32_t *next_hop_flags, uint8_t *dst,
+                          size_t dst_size, uint32_t dst_flags, uint32_t flow);
+
+/**
+ * @brief Hashes the fields identifying a flow for fib_get_next_hop_flow()
+ *
+ * @param[in] data  the fields, e.g. the source and destination address
+ * @param[in] len   length of @p data
+ * @param[in] seed  a further field, e.g. the IPv6 flow label
+ *
+ * @return  the hash
+ */
+uint32_t fib_flow_hash(const void *data, size_t len, uint32_t seed);
+#endif
+
 /**
 * @brief provides a set of destination addresses matching the given prefix
 * If the out buffer is insufficient low or passed as NULL,
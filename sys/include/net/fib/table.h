@@ -24,6 +24,7 @@
 #include "kernel_types.h"
 #include "universal_address.h"
 #include "mutex.h"
+#include "xtimer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -51,8 +52,38 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+#if defined(MODULE_FIB_MULTIPATH) || defined(DOXYGEN)
+    /** share of the traffic to the destination, 0 for a backup next hop */
+    uint8_t weight;
+#endif
 } fib_entry_t;
 
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+/**
+ * @brief Number of trie nodes needed for a FIB table with @p size entries
+ */
+#define FIB_TRIE_NODES_NUMOF(size)  (2 * (size))
+
+/**
+ * @brief Node of the binary prefix trie indexing the entries of a FIB table
+ *
+ * The first half of the node pool is reserved for the entries (node `i`
+ * indexes entry `i`), the second half holds the branching nodes.
+ */
+typedef struct fib_trie_node {
+    /** parent node, or previous node for nodes in fib_trie_node::dup */
+    struct fib_trie_node *parent;
+    /** children, selected by the bit following the prefix */
+    struct fib_trie_node *child[2];
+    /** next node with the same prefix */
+    struct fib_trie_node *dup;
+    /** the indexed entry, NULL for branching nodes */
+    fib_entry_t *entry;
+    /** prefix length in bits */
+    uint16_t len;
+} fib_trie_node_t;
+#endif
+
 /**
 * @brief Container descriptor for a FIB source route entry
 */
@@ -133,6 +164,24 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+    /** node pool of FIB_TRIE_NODES_NUMOF(size) nodes for the lookup trie.
+    *   Single hop tables without a pool are searched linearly.
+    */
+    fib_trie_node_t *trie_nodes;
+    /** root of the lookup trie */
+    fib_trie_node_t *trie_root;
+#endif
+    /** earliest lifetime of all single hop entries */
+    uint64_t next_expiry;
+    /** timer set to fib_table_t::next_expiry */
+    xtimer_t expiry_timer;
+    /** set by fib_table_t::expiry_timer, expired entries are removed on the
+    *   next access */
+    volatile uint8_t expired;
+    /** incremented whenever a source route of this table changes, so users
+    *   can cache computed source routes */
+    volatile unsigned sr_gen;
 } fib_table_t;
 
 #ifdef __cplusplus
@@ -103,6 +103,83 @@
  *    _content_type_ attributes.
  * -# Read the payload, if any.
  *
+ * ### Confirmable requests ###
+ *
+ * gcoap_req_init() creates a non-confirmable request. To have gcoap
+ * retransmit the request until the server acknowledges it, set the type to
+ * confirmable with gcoap_hdr_set_type() before gcoap_req_send(). gcoap keeps
+ * a copy of the request in one of @ref GCOAP_RESEND_BUFS_MAX buffers and
+ * retransmits it up to @ref GCOAP_MAX_RETRANSMIT times, doubling the timeout
+ * each time (RFC 7252, section 4.2). The first timeout is chosen at random
+ * between @ref GCOAP_ACK_TIMEOUT and @ref GCOAP_ACK_TIMEOUT increased by
+ * @ref GCOAP_ACK_RANDOM_PERCENT percent. At most @ref GCOAP_NSTART
+ * confirmable requests to a destination await an acknowledgement at a time,
+ * gcoap_req_send() fails for further ones.
+ *
+ * A response piggybacked on the acknowledgement is passed to the callback
+ * like the response to a non-confirmable request. After an empty
+ * acknowledgement, gcoap waits @ref GCOAP_NON_TIMEOUT for the separate
+ * response and acknowledges it if it is confirmable.
+ *
+ * With the gcoap_cocoa module, the first timeout of a destination follows the
+ * round-trip times measured from its acknowledgements, as proposed by CoCoA
+ * (draft-ietf-core-cocoa). gcoap_dest_get() shows the timeout and
+ * retransmission counters of a destination.
+ *
+ * ## Block-wise Transfers ##
+ *
+ * Resources and payloads larger than a PDU are transferred in blocks as
+ * defined by RFC 7959. Blocks never exceed 2^(@ref GCOAP_BLOCK_SZX + 4)
+ * bytes, so a block fits into a single IEEE 802.15.4 frame by default and
+ * needs no 6LoWPAN fragmentation. A peer that asks for larger blocks gets
+ * blocks of this size, one that asks for smaller blocks gets what it asked
+ * for.
+ *
+ * A server resource handler does not need to hold the whole resource.
+ * gcoap_block2_respond() asks a gcoap_block_reader_t only for the slice of the
+ * block a request wants, and gcoap_block1_respond() passes each block of an
+ * upload to a gcoap_block_writer_t with its offset in the resource.
+ *
+ * A client reads the Block2 option of a response with gcoap_get_block(), and
+ * requests the next block with gcoap_block_finish() until the option has
+ * gcoap_block_t::more cleared. To upload, it sends each block with a Block1
+ * option. The Block1 option of the 2.31 (Continue) response carries the block
+ * size the server wants for the next blocks.
+ *
+ * ## Observe ##
+ *
+ * A client observes a resource (RFC 7641) with a GET request with Observe
+ * option 0 and stops with Observe option 1. Only resources registered with
+ * gcoap_register_observable() accept observers, up to
+ * @ref GCOAP_OBS_CLIENTS_MAX in total; a request for any other resource is
+ * answered like a plain GET.
+ *
+ * When the state of a resource changes, the application calls
+ * gcoap_obs_notify(). gcoap then calls the resource handler once and sends
+ * the result to all observers of the resource, so the notification is only
+ * encoded once. Notifications of a resource are at least
+ * gcoap_observable_t::min_interval apart; triggers within the interval are
+ * combined into one notification at its end. A notification with an error
+ * response removes the observers of the resource.
+ *
+ * ## Response Cache ##
+ *
+ * With the gcoap_cache module, gcoap keeps the rendered 2.05 (Content)
+ * responses of resources registered with gcoap_register_cacheable(), for
+ * gcoap_cacheable_t::max_age seconds. The responses are kept per resource,
+ * Accept and Uri-Query options of the request, up to @ref
+ * GCOAP_CACHE_ENTRIES in total. A GET request for a cached response is
+ * answered by copying it behind the token of the request, without calling the
+ * handler.
+ *
+ * Cached responses carry an ETag and the remaining Max-Age. A request with
+ * the current ETag is answered with 2.03 (Valid) and no payload, even if the
+ * response had to be rendered again. Requests with Observe or Block2 option
+ * are always passed to the handler.
+ *
+ * A successful PUT, POST or DELETE request, a notification of an observable
+ * and gcoap_cache_invalidate() remove the cached responses of a resource.
+ *
  * ## Implementation Notes ##
  *
  * ### Building a packet ###
@@ -122,7 +199,12 @@
  * response, so the gcoap thread does not block while waiting. The user is
  * notified via the same callback whether the message is received or the wait
  * times out. We track the response with an entry in the
- * `_coap_state.open_reqs` array.
+ * `_coap_state.open_reqs` table, which is indexed by a hash of the token.
+ *
+ * ### Finding a resource ###
+ *
+ * The resources of a listener are sorted by path, so gcoap finds the
+ * resource of a request with a binary search in each listener.
  *
  * @{
  *
@@ -135,6 +217,8 @@
 #ifndef GCOAP_H_
 #define GCOAP_H_
 
+#include <stdbool.h>
+
 #include "net/gnrc.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/udp.h"
@@ -160,19 +244,21 @@ extern "C" {
  * @brief Size of the buffer used to write options, other than Uri-Path, in a
  *        request.
  *
- * Accommodates Content-Format.
+ * Accommodates Content-Format and a Block option.
  */
-#define GCOAP_REQ_OPTIONS_BUF  (8)
+#define GCOAP_REQ_OPTIONS_BUF  (12)
 
 /**
  * @brief Size of the buffer used to write options in a response.
  *
- * Accommodates Content-Format.
+ * Accommodates Content-Format and a Block option.
  */
-#define GCOAP_RESP_OPTIONS_BUF  (8)
+#define GCOAP_RESP_OPTIONS_BUF  (12)
 
 /** @brief Maximum number of requests awaiting a response */
+#ifndef GCOAP_REQ_WAITING_MAX
 #define GCOAP_REQ_WAITING_MAX   (2)
+#endif
 
 /** @brief Maximum length in bytes for a token */
 #define GCOAP_TOKENLEN_MAX      (8)
@@ -206,9 +292,156 @@ extern "C" {
  */
 #define GCOAP_NON_TIMEOUT    (5000000U)
 
+/**
+ * @name Transmission parameters for confirmable requests, RFC 7252
+ * @{
+ */
+#ifndef GCOAP_ACK_TIMEOUT
+#define GCOAP_ACK_TIMEOUT           (2000000U)  /**< Minimum first timeout
+                                                     for an ACK, in usec */
+#endif
+#ifndef GCOAP_ACK_RANDOM_PERCENT
+#define GCOAP_ACK_RANDOM_PERCENT    (50U)       /**< Maximum random increase
+                                                     of the first timeout; RFC
+                                                     7252 ACK_RANDOM_FACTOR
+                                                     of 1.5 */
+#endif
+#ifndef GCOAP_MAX_RETRANSMIT
+#define GCOAP_MAX_RETRANSMIT        (4U)        /**< Retransmissions before
+                                                     giving up */
+#endif
+#ifndef GCOAP_NSTART
+#define GCOAP_NSTART                (1U)        /**< Unacknowledged requests
+                                                     per destination */
+#endif
+/** @} */
+
+/**
+ * @brief Maximum number of options of a received PDU gcoap indexes
+ *
+ * The options are indexed in one pass when a PDU is received, so lookups like
+ * gcoap_get_block() do not scan them again. PDUs with more options are
+ * scanned. Set to 0 to disable the index.
+ */
+#ifndef GCOAP_OPT_INDEX_MAX
+#define GCOAP_OPT_INDEX_MAX     (8)
+#endif
+
+/** @brief Number of buffers for confirmable requests awaiting an ACK */
+#ifndef GCOAP_RESEND_BUFS_MAX
+#define GCOAP_RESEND_BUFS_MAX   (1)
+#endif
+
+/**
+ * @brief Number of destinations gcoap keeps transmission state for
+ *
+ * A destination with unacknowledged requests is never replaced, so there
+ * should be at least @ref GCOAP_REQ_WAITING_MAX.
+ */
+#ifndef GCOAP_DEST_MAX
+#define GCOAP_DEST_MAX          (GCOAP_REQ_WAITING_MAX)
+#endif
+
 /** @brief Identifies a gcoap-specific timeout IPC message */
 #define GCOAP_NETAPI_MSG_TYPE_TIMEOUT    (0x1501)
 
+/** @brief Identifies a gcoap-specific IPC message to notify observers */
+#define GCOAP_NETAPI_MSG_TYPE_NOTIFY     (0x1502)
+
+/** @brief Observe option, RFC 7641 */
+#define GCOAP_OPT_OBSERVE   (6)
+
+/**
+ * @name Options and codes for caching, RFC 7252
+ * @{
+ */
+#define GCOAP_OPT_ETAG      (4)     /**< ETag option */
+#define GCOAP_OPT_MAX_AGE   (14)    /**< Max-Age option */
+#define GCOAP_OPT_URI_QUERY (15)    /**< Uri-Query option */
+#define GCOAP_OPT_ACCEPT    (17)    /**< Accept option */
+#define GCOAP_CODE_VALID    ((2 << 5) | 3)  /**< 2.03 Valid */
+/** @} */
+
+/** @brief Number of responses the gcoap_cache module keeps */
+#ifndef GCOAP_CACHE_ENTRIES
+#define GCOAP_CACHE_ENTRIES     (4)
+#endif
+
+/** @brief Length in bytes of the ETag of a cached response */
+#define GCOAP_CACHE_ETAG_LEN    (4)
+
+/** @brief Maximum length of the options and payload of a cached response */
+#define GCOAP_CACHE_DATA_SIZE   (GCOAP_PDU_BUF_SIZE - sizeof(coap_hdr_t))
+
+/** @brief Maximum number of observers of all resources */
+#ifndef GCOAP_OBS_CLIENTS_MAX
+#define GCOAP_OBS_CLIENTS_MAX   (2)
+#endif
+
+/**
+ * @name Block-wise transfer options and codes, RFC 7959
+ * @{
+ */
+#define GCOAP_OPT_BLOCK2    (23)    /**< Block2 option, response payload */
+#define GCOAP_OPT_BLOCK1    (27)    /**< Block1 option, request payload */
+#define GCOAP_CODE_CONTINUE ((2 << 5) | 31) /**< 2.31 Continue */
+/** @brief 4.08 Request Entity Incomplete */
+#define GCOAP_CODE_REQUEST_ENTITY_INCOMPLETE ((4 << 5) | 8)
+/** @} */
+
+/**
+ * @brief Largest block size exponent gcoap sends or asks for
+ *
+ * Blocks are 2^(GCOAP_BLOCK_SZX + 4) bytes long, 64 bytes by default. With
+ * the headers of a compressed IPv6/UDP datagram and CoAP this still fits into
+ * a single IEEE 802.15.4 frame. Must leave room for the headers and options
+ * in @ref GCOAP_PDU_BUF_SIZE.
+ */
+#ifndef GCOAP_BLOCK_SZX
+#define GCOAP_BLOCK_SZX     (2)
+#endif
+
+/**
+ * @brief  Value of a Block1 or Block2 option
+ */
+typedef struct {
+    uint32_t num;       /**< number of the block */
+    unsigned szx;       /**< size exponent, the block is 2^(szx + 4) bytes */
+    bool more;          /**< more blocks follow */
+} gcoap_block_t;
+
+/**
+ * @brief  Provides a slice of a resource for gcoap_block2_respond()
+ *
+ * @param[in] arg       argument passed to gcoap_block2_respond()
+ * @param[in] offset    offset of the slice in the resource
+ * @param[out] buf      buffer for the slice
+ * @param[in] len       length of the slice asked for
+ *
+ * @return  length of the slice written to @p buf, shorter than @p len only
+ *          at the end of the resource
+ * @return  < 0 on error
+ */
+typedef ssize_t (*gcoap_block_reader_t)(void *arg, size_t offset, uint8_t *buf,
+                                        size_t len);
+
+/**
+ * @brief  Consumes a block of an upload for gcoap_block1_respond()
+ *
+ * @param[in] arg       argument passed to gcoap_block1_respond()
+ * @param[in] offset    offset of the block in the resource
+ * @param[in] data      the block
+ * @param[in] len       length of @p data
+ * @param[in] more      more blocks follow
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p offset is not where the consumer expects the next
+ *          block
+ * @return  any other negative errno on error
+ */
+typedef int (*gcoap_block_writer_t)(void *arg, size_t offset,
+                                    const uint8_t *data, size_t len, bool more);
+
 /**
  * @brief  A modular collection of resources for a server
  */
@@ -227,6 +460,36 @@ typedef struct gcoap_listener {
  */
 typedef void (*gcoap_resp_handler_t)(unsigned req_state, coap_pkt_t* pdu);
 
+/**
+ * @brief  Transmission state of a destination of confirmable requests
+ */
+typedef struct {
+    ipv6_addr_t addr;                   /**< Address of the destination;
+                                             unspecified if the entry is
+                                             unused */
+    uint32_t last_used;                 /**< Time of the last request, for
+                                             replacing the entry */
+    uint32_t rto;                       /**< First timeout for the next
+                                             request, in usec */
+    unsigned outstanding;               /**< Requests awaiting an ACK */
+    unsigned con_sent;                  /**< Confirmable requests sent */
+    unsigned retransmissions;           /**< Retransmissions sent */
+    unsigned timeouts;                  /**< Requests never acknowledged */
+#if defined(MODULE_GCOAP_COCOA) || defined(DOXYGEN)
+    uint32_t srtt_strong;               /**< Smoothed RTT of requests sent
+                                             once, in usec; 0 if no sample */
+    uint32_t rttvar_strong;             /**< RTT variation of requests sent
+                                             once, in usec */
+    uint32_t srtt_weak;                 /**< Smoothed RTT of retransmitted
+                                             requests, from the first
+                                             transmission, in usec */
+    uint32_t rttvar_weak;               /**< RTT variation of retransmitted
+                                             requests, in usec */
+    uint32_t rto_updated;               /**< Time of the last update of
+                                             gcoap_dest_t::rto, for aging */
+#endif
+} gcoap_dest_t;
+
 /**
  * @brief  Memo to handle a response for a request
  */
@@ -237,18 +500,103 @@ typedef struct {
     gcoap_resp_handler_t resp_handler;  /**< Callback for the response */
     xtimer_t response_timer;            /**< Limits wait for response */
     msg_t timeout_msg;                  /**< For response timer */
+    uint8_t *msg_buf;                   /**< Copy of a confirmable request
+                                             awaiting an ACK, otherwise NULL */
+    size_t msg_len;                     /**< Length of gcoap_request_memo_t::msg_buf */
+    gcoap_dest_t *dest;                 /**< Destination of the request, while
+                                             it awaits an ACK */
+    uint16_t port;                      /**< Port at the destination */
+    uint8_t retransmits;                /**< Retransmissions so far */
+    uint32_t timeout;                   /**< Current retransmission timeout,
+                                             in usec */
+    uint32_t sent_first;                /**< Time of the first transmission */
 } gcoap_request_memo_t;
 
+/**
+ * @brief  A resource that accepts observers
+ *
+ * Only gcoap_observable_t::resource and gcoap_observable_t::min_interval are
+ * set by the application, the other members are used by gcoap.
+ */
+typedef struct gcoap_observable {
+    const coap_resource_t *resource;    /**< The resource, must be in a
+                                             registered listener */
+    uint32_t min_interval;              /**< Minimum time between two
+                                             notifications, in usec */
+    uint32_t last_notify;               /**< Time of the last notification */
+    uint32_t seq;                       /**< Last Observe sequence number */
+    bool pending;                       /**< A notification waits for the end
+                                             of the interval */
+    xtimer_t notify_timer;              /**< Ends the interval */
+    msg_t notify_msg;                   /**< For notify_timer */
+    struct gcoap_observable *next;      /**< Next observable in list */
+} gcoap_observable_t;
+
+/**
+ * @brief  Memo for an observer of a resource
+ */
+typedef struct {
+    gcoap_observable_t *observable;     /**< Observed resource; NULL if the
+                                             memo is unused */
+    ipv6_addr_t addr;                   /**< Address of the observer */
+    uint16_t port;                      /**< Port of the observer */
+    uint8_t token_len;                  /**< Length of token */
+    uint8_t token[GCOAP_TOKENLEN_MAX];  /**< Token of the registration */
+} gcoap_observe_memo_t;
+
+/**
+ * @brief  A resource whose responses the gcoap_cache module keeps
+ */
+typedef struct gcoap_cacheable {
+    const coap_resource_t *resource;    /**< The resource, must be in a
+                                             registered listener */
+    uint32_t max_age;                   /**< Time a response is kept, in
+                                             seconds */
+    struct gcoap_cacheable *next;       /**< Next cacheable in list */
+} gcoap_cacheable_t;
+
+/**
+ * @brief  Cached response
+ */
+typedef struct {
+    const gcoap_cacheable_t *cacheable; /**< Resource of the response; NULL if
+                                             the entry is unused */
+    uint32_t key;                       /**< Hash of the Accept and Uri-Query
+                                             options of the request */
+    uint64_t expires;                   /**< End of Max-Age, in usec */
+    uint8_t etag[GCOAP_CACHE_ETAG_LEN]; /**< ETag of the response */
+    uint8_t code;                       /**< Code of the response */
+    uint8_t len;                        /**< Length of data */
+    uint8_t data[GCOAP_CACHE_DATA_SIZE];/**< Options and payload of the
+                                             response */
+} gcoap_cache_entry_t;
+
 /**
  * @brief  Container for the state of gcoap itself
  */
 typedef struct {
     gnrc_netreg_entry_t netreg_port;   /**< Registration for IP port */
     gcoap_listener_t *listeners;       /**< List of registered listeners */
+    gcoap_observable_t *observables;   /**< List of observable resources */
+    gcoap_observe_memo_t observers[GCOAP_OBS_CLIENTS_MAX];
+                                       /**< Storage for observers */
+#if defined(MODULE_GCOAP_CACHE) || defined(DOXYGEN)
+    gcoap_cacheable_t *cacheables;     /**< List of cacheable resources */
+    gcoap_cache_entry_t cache[GCOAP_CACHE_ENTRIES];
+                                       /**< Cached responses */
+#endif
     gcoap_request_memo_t open_reqs[GCOAP_REQ_WAITING_MAX];
-                                       /**< Storage for open requests; if first
-                                            byte of an entry is zero, the entry
-                                            is available */
+                                       /**< Storage for open requests, hashed
+                                            by token; if first byte of an entry
+                                            is zero, the entry is available */
+    unsigned memo_max_probe;           /**< Largest distance of an open request
+                                            from the home slot of its token */
+    uint8_t resend_bufs[GCOAP_RESEND_BUFS_MAX][GCOAP_PDU_BUF_SIZE];
+                                       /**< Copies of confirmable requests
+                                            awaiting an ACK */
+    gcoap_dest_t dests[GCOAP_DEST_MAX];
+                                       /**< Destinations of confirmable
+                                            requests */
     uint16_t last_message_id;          /**< Last message ID used */
 } gcoap_state_t;
 
@@ -270,6 +618,61 @@ kernel_pid_t gcoap_init(void);
  */
 void gcoap_register_listener(gcoap_listener_t *listener);
 
+/**
+ * @brief   Finds the resource for a request.
+ *
+ * Searches the registered listeners in their order of registration.
+ *
+ * @param[in] path          Resource path of the request
+ * @param[in] method_flag   Method of the request, e.g. COAP_GET
+ *
+ * @return  the resource
+ * @return  NULL, if no listener has a resource for @p path and @p method_flag
+ */
+coap_resource_t *gcoap_find_resource(const char *path, unsigned method_flag);
+
+/**
+ * @brief   Lets clients observe a resource.
+ *
+ * @param observable The resource, with gcoap_observable_t::resource and
+ *                   gcoap_observable_t::min_interval set
+ */
+void gcoap_register_observable(gcoap_observable_t *observable);
+
+/**
+ * @brief   Notifies the observers of a resource about a change.
+ *
+ * May be called from any thread. The notification is sent by the gcoap
+ * thread, at the end of gcoap_observable_t::min_interval if the last one was
+ * sent less than that ago.
+ *
+ * @param observable The resource
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the message queue of gcoap is full
+ * @return  -ENOTCONN, if gcoap is not running
+ */
+int gcoap_obs_notify(gcoap_observable_t *observable);
+
+#if defined(MODULE_GCOAP_CACHE) || defined(DOXYGEN)
+/**
+ * @brief   Lets gcoap cache the responses of a resource.
+ *
+ * @param cacheable The resource, with gcoap_cacheable_t::resource and
+ *                  gcoap_cacheable_t::max_age set
+ */
+void gcoap_register_cacheable(gcoap_cacheable_t *cacheable);
+
+/**
+ * @brief   Removes the cached responses of a resource.
+ *
+ * Must be called from the gcoap thread, e.g. from a resource handler.
+ *
+ * @param resource The resource
+ */
+void gcoap_cache_invalidate(const coap_resource_t *resource);
+#endif
+
 /**
  * @brief  Initializes a CoAP request PDU on a buffer.
  *
@@ -301,6 +704,24 @@ int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
  */
 ssize_t gcoap_finish(coap_pkt_t *pdu, size_t payload_len, unsigned format);
 
+/**
+ * @brief  Finishes formatting a CoAP PDU with a Block option.
+ *
+ * Like gcoap_finish(), but also writes the Block1 or Block2 option.
+ *
+ * @param[in] pdu Request or response metadata
+ * @param[in] payload_len Length of the payload, or 0 if none
+ * @param[in] format Format code for the payload; use COAP_FORMAT_NONE if not
+ *                   specified
+ * @param[in] opt @ref GCOAP_OPT_BLOCK1 or @ref GCOAP_OPT_BLOCK2
+ * @param[in] block Value of the option
+ *
+ * @return size of the PDU
+ * @return < 0 on error
+ */
+ssize_t gcoap_block_finish(coap_pkt_t *pdu, size_t payload_len, unsigned format,
+                           unsigned opt, const gcoap_block_t *block);
+
 /**
  *  @brief Writes a complete CoAP request PDU when there is not a payload.
  *
@@ -322,9 +743,24 @@ static inline ssize_t gcoap_request(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                 : -1;
 }
 
+/**
+ * @brief  Sets the message type of a PDU.
+ *
+ * @param[in] hdr Header of the PDU
+ * @param[in] type COAP_TYPE_CON or COAP_TYPE_NON for a request
+ */
+static inline void gcoap_hdr_set_type(coap_hdr_t *hdr, unsigned type)
+{
+    /* the type is held in bits 5 and 4 */
+    hdr->ver_t_tkl = (hdr->ver_t_tkl & ~0x30) | ((type & 0x3) << 4);
+}
+
 /**
  * @brief  Sends a buffer containing a CoAP request to the provided host/port.
  *
+ * A confirmable request is retransmitted until it is acknowledged, see
+ * @ref GCOAP_MAX_RETRANSMIT.
+ *
  * @param[in] buf Buffer containing the PDU
  * @param[in] len Length of the buffer
  * @param[in] addr Destination for the packet
@@ -332,11 +768,25 @@ static inline ssize_t gcoap_request(coap_pkt_t *pdu, uint8_t *buf, size_t len,
  * @param[in] resp_handler Callback when response received
  *
  * @return length of the packet
- * @return 0 if cannot send
+ * @return 0 if cannot send, also if a confirmable request exceeds
+ *         @ref GCOAP_NSTART or there is no free buffer for it
  */
 size_t gcoap_req_send(uint8_t *buf, size_t len, ipv6_addr_t *addr, uint16_t port,
                                                 gcoap_resp_handler_t resp_handler);
 
+/**
+ * @brief  Gets the transmission state of a destination.
+ *
+ * The state is updated by the gcoap thread, so it may change while it is
+ * read.
+ *
+ * @param[in] addr Address of the destination
+ *
+ * @return the state, if gcoap has sent a confirmable request to @p addr
+ * @return NULL otherwise
+ */
+const gcoap_dest_t *gcoap_dest_get(const ipv6_addr_t *addr);
+
 /**
  * @brief  Initializes a CoAP response packet on a buffer.
  *
@@ -371,6 +821,110 @@ static inline ssize_t gcoap_response(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                 : -1;
 }
 
+/**
+ * @brief  Reads a Block option of a received PDU.
+ *
+ * Must be called before the PDU is overwritten, i.e. in a resource handler
+ * before gcoap_resp_init(). A block size larger than 2^(@ref GCOAP_BLOCK_SZX
+ * + 4) is reduced to that, gcoap_block_t::num is adjusted so the offset of
+ * the block stays the same.
+ *
+ * @param[in] pdu Received request or response
+ * @param[in] opt @ref GCOAP_OPT_BLOCK1 or @ref GCOAP_OPT_BLOCK2
+ * @param[out] block Value of the option; if the PDU has none, block 0 of
+ *                   size @ref GCOAP_BLOCK_SZX without more blocks
+ *
+ * @return 1 if the PDU has the option
+ * @return 0 if the PDU has no such option
+ * @return -EBADMSG if the options are malformed
+ */
+int gcoap_get_block(coap_pkt_t *pdu, unsigned opt, gcoap_block_t *block);
+
+/**
+ * @brief  Reads an unsigned integer option of a received PDU
+ *
+ * Must be called before the PDU is overwritten, like gcoap_get_block().
+ *
+ * @param[in] pdu Received request or response
+ * @param[in] opt Option number, e.g. @ref GCOAP_OPT_ACCEPT
+ * @param[out] value Value of the option
+ *
+ * @return 1 if the PDU has the option
+ * @return 0 if the PDU has no such option
+ * @return -EBADMSG if the options are malformed or the value is longer than
+ *         4 bytes
+ */
+int gcoap_get_uint(coap_pkt_t *pdu, unsigned opt, uint32_t *value);
+
+/**
+ * @brief  Gets the size of a block in bytes.
+ *
+ * @param[in] block The block
+ *
+ * @return size of the block
+ */
+static inline size_t gcoap_block_size(const gcoap_block_t *block)
+{
+    return (size_t)1 << (block->szx + 4);
+}
+
+/**
+ * @brief  Gets the offset of a block in the resource.
+ *
+ * @param[in] block The block
+ *
+ * @return offset in bytes
+ */
+static inline size_t gcoap_block_offset(const gcoap_block_t *block)
+{
+    return (size_t)block->num << (block->szx + 4);
+}
+
+/**
+ * @brief  Responds to a request with the block of a resource it asks for.
+ *
+ * Writes a 2.05 (Content) response with a Block2 option for the block in the
+ * Block2 option of the request, or for the first block if it has none. Only
+ * the slice of the block is read from @p reader; the block is made smaller if
+ * it does not fit into @p buf.
+ *
+ * @param[in] pdu Request metadata, the response is written to it
+ * @param[in] buf Buffer containing the PDU
+ * @param[in] len Length of the buffer
+ * @param[in] format Format code for the resource
+ * @param[in] reader Provides the slice of the resource
+ * @param[in] arg Argument for @p reader
+ *
+ * @return size of the PDU within the buffer
+ * @return < 0 on error; the handler returns it to send a server error
+ */
+ssize_t gcoap_block2_respond(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             unsigned format, gcoap_block_reader_t reader,
+                             void *arg);
+
+/**
+ * @brief  Passes a block of an upload to a consumer and responds to it.
+ *
+ * A request without Block1 option is passed as a single, last block. Blocks
+ * followed by more are answered with 2.31 (Continue), the last one with
+ * @p code. Both carry a Block1 option with the block size gcoap wants for the
+ * following blocks. If @p writer returns -EINVAL, gcoap responds with
+ * 4.08 (Request Entity Incomplete).
+ *
+ * @param[in] pdu Request metadata, the response is written to it
+ * @param[in] buf Buffer containing the PDU
+ * @param[in] len Length of the buffer
+ * @param[in] code Response code for the last block, e.g. 2.04 (Changed)
+ * @param[in] writer Consumes the block
+ * @param[in] arg Argument for @p writer
+ *
+ * @return size of the PDU within the buffer
+ * @return < 0 on error; the handler returns it to send a server error
+ */
+ssize_t gcoap_block1_respond(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             unsigned code, gcoap_block_writer_t writer,
+                             void *arg);
+
 /**
  * @brief Provides important operational statistics.
  *
@@ -380,6 +934,15 @@ static inline ssize_t gcoap_response(coap_pkt_t *pdu, uint8_t *buf, size_t len,
  */
 void gcoap_op_state(uint8_t *open_reqs);
 
+/**
+ * @brief Gets the number of observers of a resource.
+ *
+ * @param[in] observable The resource
+ *
+ * @return count of observers
+ */
+unsigned gcoap_obs_count(const gcoap_observable_t *observable);
+
 #ifdef __cplusplus
 }
 #endif
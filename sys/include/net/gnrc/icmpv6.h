@@ -29,6 +29,7 @@
 
 #include "kernel_types.h"
 #include "net/icmpv6.h"
+#include "net/netstats.h"
 #include "net/gnrc/pkt.h"
 
 #include "net/gnrc/icmpv6/echo.h"
@@ -75,6 +76,18 @@ gnrc_pktsnip_t *gnrc_icmpv6_build(gnrc_pktsnip_t *next, uint8_t type, uint8_t co
  */
 int gnrc_icmpv6_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr);
 
+/**
+ * @brief   Get the statistics of the ICMPv6 layer.
+ *
+ * @note    This function is only available if compiled with module
+ *          `netstats_icmpv6`. The statistics can also be requested from the
+ *          IPv6 thread with @ref NETOPT_STATS and context
+ *          @ref NETSTATS_ICMPV6.
+ *
+ * @return  A @ref netstats_icmpv6_t pointer to the statistics.
+ */
+netstats_icmpv6_t *gnrc_icmpv6_get_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
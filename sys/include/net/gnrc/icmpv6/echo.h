@@ -24,6 +24,7 @@
 
 #include "byteorder.h"
 #include "kernel_types.h"
+#include "net/gnrc/pkt.h"
 #include "net/ipv6/hdr.h"
 
 #ifdef __cplusplus
@@ -58,6 +59,22 @@ gnrc_pktsnip_t *gnrc_icmpv6_echo_build(uint8_t type, uint16_t id, uint16_t seq,
 void gnrc_icmpv6_echo_req_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6_hdr,
                                  icmpv6_echo_t *echo, uint16_t len);
 
+/**
+ * @brief   Answers an ICMPv6 echo request with the received packet
+ *
+ * Turns the request into the reply in place: the addresses are swapped and
+ * the checksum is updated incrementally, so the payload is neither copied
+ * nor summed up again unless another thread still holds the request.
+ *
+ * @pre @p pkt starts with the ICMPv6 snip, directly followed by the IPv6
+ *      header (i.e. without extension headers).
+ *
+ * @param[in] iface     The interface the echo request was received on.
+ * @param[in] pkt       The received echo request. This function takes over
+ *                      the reference of the caller.
+ */
+void gnrc_icmpv6_echo_req_reply(kernel_pid_t iface, gnrc_pktsnip_t *pkt);
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,33 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Maximum number of error messages sent in a burst
+ *
+ * Size of the token bucket that limits the rate of error messages (see
+ * [RFC 4443, section 2.4 (f)](https://tools.ietf.org/html/rfc4443#section-2.4)).
+ */
+#ifndef GNRC_ICMPV6_ERROR_BURST
+#define GNRC_ICMPV6_ERROR_BURST     (10U)
+#endif
+
+/**
+ * @brief   Interval in microseconds after which the bucket regains a token
+ *
+ * Defines the sustained rate of error messages, 10 per second by default.
+ */
+#ifndef GNRC_ICMPV6_ERROR_INTERVAL
+#define GNRC_ICMPV6_ERROR_INTERVAL  (100U * 1000U)
+#endif
+
+/**
+ * @brief   Error message statistics
+ */
+typedef struct {
+    uint32_t sent;          /**< error messages built */
+    uint32_t limited;       /**< error messages suppressed by the rate limit */
+} gnrc_icmpv6_error_stats_t;
+
 /**
  * @brief   Builds an ICMPv6 destination unreachable message for sending.
  *
@@ -40,7 +67,7 @@ extern "C" {
  * @param[in] orig_pkt  The invoking packet.
  *
  * @return  The destination unreachable message on success.
- * @return  NULL, on failure.
+ * @return  NULL, on failure or if the rate limit is exceeded.
  */
 gnrc_pktsnip_t *gnrc_icmpv6_error_dst_unr_build(uint8_t code, gnrc_pktsnip_t *orig_pkt);
 
@@ -51,7 +78,7 @@ gnrc_pktsnip_t *gnrc_icmpv6_error_dst_unr_build(uint8_t code, gnrc_pktsnip_t *or
  * @param[in] orig_pkt  The invoking packet.
  *
  * @return  The packet too big message on success.
- * @return  NULL, on failure.
+ * @return  NULL, on failure or if the rate limit is exceeded.
  */
 gnrc_pktsnip_t *gnrc_icmpv6_error_pkt_too_big_build(uint32_t mtu, gnrc_pktsnip_t *orig_pkt);
 
@@ -62,7 +89,7 @@ gnrc_pktsnip_t *gnrc_icmpv6_error_pkt_too_big_build(uint32_t mtu, gnrc_pktsnip_t
  * @param[in] orig_pkt  The invoking packet.
  *
  * @return  The time exceeded message on success.
- * @return  NULL, on failure.
+ * @return  NULL, on failure or if the rate limit is exceeded.
  */
 gnrc_pktsnip_t *gnrc_icmpv6_error_time_exc_build(uint8_t code, gnrc_pktsnip_t *orig_pkt);
 
@@ -74,11 +101,34 @@ gnrc_pktsnip_t *gnrc_icmpv6_error_time_exc_build(uint8_t code, gnrc_pktsnip_t *o
  * @param[in] orig_pkt  The invoking packet.
  *
  * @return  The parameter problem message on success.
- * @return  NULL, on failure.
+ * @return  NULL, on failure or if the rate limit is exceeded.
  */
 gnrc_pktsnip_t *gnrc_icmpv6_error_param_prob_build(uint8_t code, void *ptr,
                                                    gnrc_pktsnip_t *orig_pkt);
 
+#if defined(MODULE_GNRC_IPV6_PMTU) || defined(DOXYGEN)
+/**
+ * @brief   Handles a received ICMPv6 packet too big message.
+ *
+ * Lowers the path MTU of the destination of the invoking packet, if that
+ * packet was sent by this node (see @ref net_gnrc_ipv6_pmtu).
+ *
+ * @note    Only available with module `gnrc_ipv6_pmtu`.
+ *
+ * @param[in] ptb       The packet too big message.
+ * @param[in] size      Size of @p ptb, including the invoking packet.
+ */
+void gnrc_icmpv6_error_pkt_too_big_handle(const icmpv6_error_pkt_too_big_t *ptb,
+                                          size_t size);
+#endif
+
+/**
+ * @brief   Get the error message statistics
+ *
+ * @return  the statistics since start-up
+ */
+const gnrc_icmpv6_error_stats_t *gnrc_icmpv6_error_stats(void);
+
 /**
  * @brief   Sends an ICMPv6 destination unreachable message for sending.
  *
@@ -147,6 +147,18 @@ void gnrc_ipv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *current, gnrc_pktsnip_t
  */
 ipv6_hdr_t *gnrc_ipv6_get_header(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Get the statistics of the IPv6 layer over all interfaces.
+ *
+ * @note    This function is only available if compiled with module
+ *          `netstats_ipv6`. The statistics can also be requested from the
+ *          IPv6 thread with @ref NETOPT_STATS and context
+ *          @ref NETSTATS_IPV6.
+ *
+ * @return  A @ref netstats_ipv6_t pointer to the statistics.
+ */
+netstats_ipv6_t *gnrc_ipv6_get_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -32,11 +32,29 @@ extern "C" {
 
 /**
  * Maximum size of the blacklist.
+ *
+ * The addresses are hashed into a table of this size, lookups stay fast as
+ * long as it is not filled by more than about three quarters.
  */
 #ifndef GNRC_IPV6_BLACKLIST_SIZE
 #define GNRC_IPV6_BLACKLIST_SIZE    (8)
 #endif
 
+/**
+ * Maximum number of prefixes in the blacklist, 0 disables prefix rules.
+ */
+#ifndef GNRC_IPV6_BLACKLIST_PREFIXES
+#define GNRC_IPV6_BLACKLIST_PREFIXES    (0)
+#endif
+
+/**
+ * @brief   A blacklisted prefix
+ */
+typedef struct {
+    ipv6_addr_t prefix;     /**< the prefix */
+    uint8_t len;            /**< length of the prefix in bits, 0 if unused */
+} gnrc_ipv6_blacklist_prefix_t;
+
 /**
  * @brief   Adds an IPv6 address to the blacklist.
  *
@@ -56,9 +74,37 @@ int gnrc_ipv6_blacklist_add(const ipv6_addr_t *addr);
  */
 void gnrc_ipv6_blacklist_del(const ipv6_addr_t *addr);
 
+#if GNRC_IPV6_BLACKLIST_PREFIXES || defined(DOXYGEN)
+/**
+ * @brief   Adds an IPv6 prefix to the blacklist.
+ *
+ * Needs @ref GNRC_IPV6_BLACKLIST_PREFIXES to be set.
+ *
+ * @param[in] prefix        An IPv6 prefix.
+ * @param[in] prefix_len    Length of @p prefix in bits, 1 to 128.
+ *
+ * @return  0, on success.
+ * @return  -1, if the prefix list is full or @p prefix_len is invalid.
+ */
+int gnrc_ipv6_blacklist_add_prefix(const ipv6_addr_t *prefix, uint8_t prefix_len);
+
+/**
+ * @brief   Removes an IPv6 prefix from the blacklist.
+ *
+ * Prefixes not in the blacklist will be ignored.
+ *
+ * @param[in] prefix        An IPv6 prefix.
+ * @param[in] prefix_len    Length of @p prefix in bits.
+ */
+void gnrc_ipv6_blacklist_del_prefix(const ipv6_addr_t *prefix, uint8_t prefix_len);
+#endif
+
 /**
  * @brief   Checks if an IPv6 address is blacklisted.
  *
+ * An address is blacklisted if it was added itself or if it matches one
+ * of the blacklisted prefixes.
+ *
  * @param[in] addr  An IPv6 address.
  *
  * @return  true, if @p addr is blacklisted.
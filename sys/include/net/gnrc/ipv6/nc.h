@@ -51,6 +51,20 @@ extern "C" {
 #define GNRC_IPV6_NC_L2_ADDR_MAX    (8)
 #endif
 
+#ifndef GNRC_IPV6_NC_BUCKET_NUMOF
+/**
+ * @brief   Number of hash buckets of the neighbor cache
+ *
+ * Only used with the `gnrc_ipv6_nc_hashed` module. The entries are then
+ * additionally indexed by their IPv6 address, so gnrc_ipv6_nc_get() and
+ * gnrc_ipv6_nc_add() only scan the entries of one bucket. Costs
+ * `GNRC_IPV6_NC_BUCKET_NUMOF + GNRC_IPV6_NC_SIZE` pointers of RAM.
+ *
+ * @note    Must be a power of 2.
+ */
+#define GNRC_IPV6_NC_BUCKET_NUMOF   (16U)
+#endif
+
 /**
  * @{
  * @name Flag definitions for gnrc_ipv6_nc_t
@@ -119,7 +133,7 @@ extern "C" {
  *              RFC 4861, section 5.1
  *          </a>.
  */
-typedef struct {
+typedef struct gnrc_ipv6_nc {
 #ifdef MODULE_GNRC_NDP_NODE
     gnrc_pktqueue_t *pkts;                      /**< Packets waiting for address resolution */
 #endif
@@ -160,6 +174,13 @@ typedef struct {
     msg_t type_timeout_msg;                 /**< msg_t for gnrc_ipv6_nc_t::type_timeout */
     eui64_t eui64;                          /**< the unique EUI-64 of the neighbor (might be
                                              *   different from L2 address, if l2_addr_len == 2) */
+    /**
+     * @brief   Minute the address registration expires in, 0 if not registered
+     *
+     * @see gnrc_sixlowpan_nd_router_reg_set()
+     */
+    uint32_t reg_expiry;
+    struct gnrc_ipv6_nc *reg_next;          /**< next registration expiring in the same slot */
 #endif
 
     uint8_t probes_remaining;               /**< remaining number of unanswered probes */
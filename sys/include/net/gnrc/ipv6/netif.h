@@ -58,6 +58,17 @@ extern "C" {
 #define GNRC_IPV6_NETIF_ADDR_NUMOF  (6 + GNRC_IPV6_NETIF_RPL_ADDR + GNRC_IPV6_NETIF_RTR_ADDR)
 #endif
 
+/**
+ * @brief   Number of slots in the hashed index of the multicast groups of an
+ *          interface
+ *
+ * Must be a power of two and should be about twice as large as the number
+ * of groups joined, so lookups rarely probe more than one slot.
+ */
+#ifndef GNRC_IPV6_NETIF_GROUPS_IDX_SIZE
+#define GNRC_IPV6_NETIF_GROUPS_IDX_SIZE (16U)
+#endif
+
 /**
  * @brief   Default MTU
  *
@@ -203,6 +214,18 @@ extern "C" {
  */
 #define GNRC_IPV6_NETIF_FLAGS_IS_WIRED          (0x0080)
 
+/**
+ * @brief   Flag to indicate that the interface calculates the upper layer
+ *          checksums of sent packets (see @ref NETOPT_OFFLOAD_CSUM_TX)
+ */
+#define GNRC_IPV6_NETIF_FLAGS_CSUM_OFFLOAD      (0x0100)
+
+/**
+ * @brief   Flag to indicate that the interface filters multicast frames by
+ *          the joined groups (see @ref NETOPT_OFFLOAD_MCAST_FILTER)
+ */
+#define GNRC_IPV6_NETIF_FLAGS_L2_GROUPS         (0x0200)
+
 /**
  * @brief   Offset of the router advertisement flags compared to the position in router
  *          advertisements.
@@ -237,6 +260,7 @@ typedef struct {
     ipv6_addr_t addr;       /**< The address data */
     uint8_t flags;          /**< flags */
     uint8_t prefix_len;     /**< length of the prefix of the address */
+    uint8_t refs;           /**< number of listeners of a multicast group */
     /**
      * @{
      * @name    Neigbour discovery variables for prefixes
@@ -274,6 +298,13 @@ typedef struct {
      * @brief addresses registered to the interface
      */
     gnrc_ipv6_netif_addr_t addrs[GNRC_IPV6_NETIF_ADDR_NUMOF];
+    /**
+     * @brief   Hashed index of the multicast groups in
+     *          gnrc_ipv6_netif_t::addrs, open addressing with linear probing.
+     *          A slot holds the index into gnrc_ipv6_netif_t::addrs plus one,
+     *          0 marks a free slot.
+     */
+    uint8_t groups[GNRC_IPV6_NETIF_GROUPS_IDX_SIZE];
     mutex_t mutex;          /**< mutex for the interface */
     kernel_pid_t pid;       /**< PID of the interface */
     uint16_t flags;         /**< flags for 6LoWPAN and Neighbor Discovery */
@@ -344,6 +375,17 @@ typedef struct {
 #if defined (MODULE_GNRC_NDP_ROUTER) || defined (MODULE_GNRC_SIXLOWPAN_ND_ROUTER)
     xtimer_t rtr_adv_timer; /**< Timer for periodic router advertisements */
     msg_t rtr_adv_msg;      /**< msg_t for gnrc_ipv6_netif_t::rtr_adv_timer */
+    /**
+     * @brief   Time in microseconds the last multicast router advertisement
+     *          was sent
+     */
+    uint32_t last_mc_rtr_adv;
+    /**
+     * @brief   Time in microseconds the next multicast router advertisement
+     *          is scheduled for, if gnrc_ipv6_netif_t::rtr_adv_timer is
+     *          running with @ref GNRC_NDP_MSG_RTR_ADV_RETRANS
+     */
+    uint32_t next_mc_rtr_adv;
 #endif
 #ifdef MODULE_NETSTATS_IPV6
     netstats_t stats;                       /**< transceiver's statistics */
@@ -454,6 +496,32 @@ void gnrc_ipv6_netif_remove_addr(kernel_pid_t pid, ipv6_addr_t *addr);
  */
 void gnrc_ipv6_netif_reset_addr(kernel_pid_t pid);
 
+/**
+ * @brief   Joins a multicast group on an interface.
+ *
+ * Joins are counted, the interface stays a listener of @p group until
+ * gnrc_ipv6_netif_leave_group() was called as often as this function. On
+ * interfaces with multicast filtering in the link-layer, the filter is
+ * programmed to pass @p group.
+ *
+ * @param[in] pid       The PID to the interface.
+ * @param[in] group     A multicast address.
+ *
+ * @return  The group on the interface, on success.
+ * @return  NULL, if @p group is no multicast address or the interface has no
+ *          space left.
+ */
+ipv6_addr_t *gnrc_ipv6_netif_join_group(kernel_pid_t pid, const ipv6_addr_t *group);
+
+/**
+ * @brief   Leaves a multicast group on an interface.
+ *
+ * @param[in] pid       The PID to the interface.
+ * @param[in] group     A multicast address joined with
+ *                      gnrc_ipv6_netif_join_group().
+ */
+void gnrc_ipv6_netif_leave_group(kernel_pid_t pid, const ipv6_addr_t *group);
+
 /**
  * @brief   Searches for an address on all interfaces.
  *
@@ -468,6 +536,9 @@ kernel_pid_t gnrc_ipv6_netif_find_by_addr(ipv6_addr_t **out, const ipv6_addr_t *
 /**
  * @brief   Searches for an address on an interface.
  *
+ * Multicast addresses are looked up in the hashed group index of the
+ * interface.
+ *
  * @param[in] pid   The PID to the interface.
  * @param[in] addr  The address you want to search for.
  *
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_pmtu IPv6 path MTU cache
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Remembers the path MTU reported for recent destinations
+ *
+ * Path MTU discovery of [RFC 8201](https://tools.ietf.org/html/rfc8201):
+ * an ICMPv6 Packet Too Big message received for a packet sent by this node
+ * lowers the path MTU of its destination. The last
+ * @ref GNRC_IPV6_PMTU_SIZE destinations are kept for
+ * @ref GNRC_IPV6_PMTU_TIMEOUT seconds, after which the path MTU is unknown
+ * again and the link MTU applies.
+ *
+ * gnrc_ipv6 does not fragment, so the cache is advisory: senders query it,
+ * e.g. with gnrc_sock_udp_get_max_payload(), to size their packets.
+ * @{
+ *
+ * @file
+ * @brief   IPv6 path MTU cache definitions
+ */
+#ifndef GNRC_IPV6_PMTU_H_
+#define GNRC_IPV6_PMTU_H_
+
+#include <stdint.h>
+
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of destinations in the cache
+ */
+#ifndef GNRC_IPV6_PMTU_SIZE
+#define GNRC_IPV6_PMTU_SIZE     (4)
+#endif
+
+/**
+ * @brief   Time in seconds after which a path MTU is forgotten
+ *
+ * At least 5 minutes, see RFC 8201, section 4.
+ */
+#ifndef GNRC_IPV6_PMTU_TIMEOUT
+#define GNRC_IPV6_PMTU_TIMEOUT  (10U * 60U)
+#endif
+
+/**
+ * @brief   Lowers the path MTU of @p dst
+ *
+ * A value above the known path MTU of @p dst is ignored. Replaces the
+ * oldest entry if the cache is full.
+ *
+ * May be called from any thread.
+ *
+ * @param[in] dst   Destination address.
+ * @param[in] mtu   The path MTU, at least IPV6_MIN_MTU.
+ */
+void gnrc_ipv6_pmtu_update(const ipv6_addr_t *dst, uint32_t mtu);
+
+/**
+ * @brief   Gets the path MTU of @p dst
+ *
+ * May be called from any thread.
+ *
+ * @param[in] dst   Destination address.
+ *
+ * @return  The path MTU of @p dst.
+ * @return  0, if it is not known.
+ */
+uint16_t gnrc_ipv6_pmtu_get(const ipv6_addr_t *dst);
+
+/**
+ * @brief   Forgets all path MTUs
+ *
+ * May be called from any thread.
+ */
+void gnrc_ipv6_pmtu_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_IPV6_PMTU_H_ */
+/** @} */
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_route_cache IPv6 forwarding route cache
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Small destination cache in front of the FIB and the neighbor
+ *              cache for forwarded packets.
+ *
+ * Routers forward most packets to a few destinations, but every forwarded
+ * packet pays a FIB lookup and a neighbor cache search. With this module
+ * gnrc_ipv6 remembers the resulting interface and link-layer address of the
+ * last @ref GNRC_IPV6_ROUTE_CACHE_SIZE destinations. Only the forwarding path
+ * of `gnrc_ipv6_router` uses the cache.
+ *
+ * The whole cache is invalidated whenever the FIB, the neighbor cache, the
+ * state of a neighbor cache entry or the addresses of an interface change.
+ * FIB entries expire lazily on lookup, so entries are additionally dropped
+ * after @ref GNRC_IPV6_ROUTE_CACHE_TIMEOUT to bound the time an expired route
+ * is used.
+ * @{
+ *
+ * @file
+ * @brief   IPv6 forwarding route cache definitions
+ */
+#ifndef GNRC_IPV6_ROUTE_CACHE_H_
+#define GNRC_IPV6_ROUTE_CACHE_H_
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/ipv6/addr.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of destinations in the cache
+ */
+#ifndef GNRC_IPV6_ROUTE_CACHE_SIZE
+#define GNRC_IPV6_ROUTE_CACHE_SIZE  (4)
+#endif
+
+/**
+ * @brief   Maximum time in microseconds an entry is used before the full
+ *          lookup is done again
+ */
+#ifndef GNRC_IPV6_ROUTE_CACHE_TIMEOUT
+#define GNRC_IPV6_ROUTE_CACHE_TIMEOUT   (1U * SEC_IN_USEC)
+#endif
+
+/**
+ * @brief   Maximum link-layer address length stored in the cache
+ */
+#ifndef GNRC_IPV6_ROUTE_CACHE_L2ADDR_MAX
+#define GNRC_IPV6_ROUTE_CACHE_L2ADDR_MAX    (8)
+#endif
+
+/**
+ * @brief   Cache statistics
+ */
+typedef struct {
+    uint32_t hits;          /**< lookups answered by the cache */
+    uint32_t misses;        /**< lookups that needed the full path */
+    uint32_t flushes;       /**< number of invalidations */
+} gnrc_ipv6_route_cache_stats_t;
+
+/**
+ * @brief   Looks up the next hop for @p dst in the cache.
+ *
+ * @note    Only to be called from the IPv6 thread.
+ *
+ * @param[in] dst               Destination address.
+ * @param[out] l2addr           Link-layer address of the next hop. Must be
+ *                              able to hold @ref GNRC_IPV6_ROUTE_CACHE_L2ADDR_MAX
+ *                              bytes.
+ * @param[out] l2addr_len       Length of @p l2addr.
+ *
+ * @return  The interface to send over.
+ * @return  KERNEL_PID_UNDEF, if @p dst is not cached.
+ */
+kernel_pid_t gnrc_ipv6_route_cache_get(const ipv6_addr_t *dst, uint8_t *l2addr,
+                                       uint8_t *l2addr_len);
+
+/**
+ * @brief   Stores the next hop for @p dst in the cache.
+ *
+ * Replaces the oldest entry if the cache is full. Link-layer addresses
+ * longer than @ref GNRC_IPV6_ROUTE_CACHE_L2ADDR_MAX are not cached.
+ *
+ * @pre Called after gnrc_ipv6_route_cache_get() missed for @p dst. If the
+ *      cache was invalidated in between, the entry is dropped silently.
+ *
+ * @param[in] dst               Destination address.
+ * @param[in] iface             Interface to send over.
+ * @param[in] l2addr            Link-layer address of the next hop.
+ * @param[in] l2addr_len        Length of @p l2addr.
+ */
+void gnrc_ipv6_route_cache_add(const ipv6_addr_t *dst, kernel_pid_t iface,
+                               const uint8_t *l2addr, uint8_t l2addr_len);
+
+/**
+ * @brief   Invalidates all entries of the cache.
+ *
+ * May be called from any thread.
+ */
+void gnrc_ipv6_route_cache_invalidate(void);
+
+/**
+ * @brief   Get the cache statistics
+ *
+ * @return  the statistics since start-up
+ */
+const gnrc_ipv6_route_cache_stats_t *gnrc_ipv6_route_cache_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_IPV6_ROUTE_CACHE_H_ */
+/** @} */
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_src_cache IPv6 source address selection cache
+ * @ingroup     net_gnrc_ipv6
+ * @brief       Remembers the source address selected for recent destinations
+ *
+ * Every packet sent without a bound source address runs the source address
+ * selection of RFC 6724 over all addresses of the interface. With this
+ * module gnrc_ipv6 remembers the result for the last
+ * @ref GNRC_IPV6_SRC_CACHE_SIZE destinations and interfaces.
+ *
+ * If the selected address shares less than 64 bits with the destination,
+ * the selection is the same for the whole /64 of the destination, so one
+ * entry covers all hosts of a remote subnet. Otherwise the entry only
+ * matches the destination itself.
+ *
+ * The whole cache is invalidated whenever an address is added to or removed
+ * from an interface or its lifetimes change.
+ * @{
+ *
+ * @file
+ * @brief   IPv6 source address selection cache definitions
+ */
+#ifndef GNRC_IPV6_SRC_CACHE_H_
+#define GNRC_IPV6_SRC_CACHE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of destinations in the cache
+ */
+#ifndef GNRC_IPV6_SRC_CACHE_SIZE
+#define GNRC_IPV6_SRC_CACHE_SIZE    (4)
+#endif
+
+/**
+ * @brief   Cache statistics
+ */
+typedef struct {
+    uint32_t hits;          /**< lookups answered by the cache */
+    uint32_t misses;        /**< lookups that needed the full selection */
+    uint32_t flushes;       /**< number of invalidations */
+} gnrc_ipv6_src_cache_stats_t;
+
+/**
+ * @brief   Looks up the source address for @p dst in the cache.
+ *
+ * @note    Only to be called from the IPv6 thread.
+ *
+ * @param[in] iface     Interface to send over.
+ * @param[in] dst       Destination address.
+ * @param[in] ll_only   Only link-local source addresses were allowed.
+ *
+ * @return  The source address on @p iface.
+ * @return  NULL, if @p dst is not cached.
+ */
+ipv6_addr_t *gnrc_ipv6_src_cache_get(kernel_pid_t iface, const ipv6_addr_t *dst,
+                                     bool ll_only);
+
+/**
+ * @brief   Stores the source address selected for @p dst in the cache.
+ *
+ * Replaces the oldest entry if the cache is full.
+ *
+ * @pre Called after gnrc_ipv6_src_cache_get() missed for @p dst. If the
+ *      cache was invalidated in between, the entry is dropped silently.
+ *
+ * @param[in] iface     Interface to send over.
+ * @param[in] dst       Destination address.
+ * @param[in] ll_only   Only link-local source addresses were allowed.
+ * @param[in] src       Selected source address on @p iface.
+ */
+void gnrc_ipv6_src_cache_add(kernel_pid_t iface, const ipv6_addr_t *dst,
+                             bool ll_only, ipv6_addr_t *src);
+
+/**
+ * @brief   Invalidates all entries of the cache.
+ *
+ * May be called from any thread.
+ */
+void gnrc_ipv6_src_cache_invalidate(void);
+
+/**
+ * @brief   Get the cache statistics
+ *
+ * @return  the statistics since start-up
+ */
+const gnrc_ipv6_src_cache_stats_t *gnrc_ipv6_src_cache_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_IPV6_SRC_CACHE_H_ */
+/** @} */
@@ -30,11 +30,29 @@ extern "C" {
 
 /**
  * Maximum size of the whitelist.
+ *
+ * The addresses are hashed into a table of this size, lookups stay fast as
+ * long as it is not filled by more than about three quarters.
  */
 #ifndef GNRC_IPV6_WHITELIST_SIZE
 #define GNRC_IPV6_WHITELIST_SIZE    (8)
 #endif
 
+/**
+ * Maximum number of prefixes in the whitelist, 0 disables prefix rules.
+ */
+#ifndef GNRC_IPV6_WHITELIST_PREFIXES
+#define GNRC_IPV6_WHITELIST_PREFIXES    (0)
+#endif
+
+/**
+ * @brief   A whitelisted prefix
+ */
+typedef struct {
+    ipv6_addr_t prefix;     /**< the prefix */
+    uint8_t len;            /**< length of the prefix in bits, 0 if unused */
+} gnrc_ipv6_whitelist_prefix_t;
+
 /**
  * @brief   Adds an IPv6 address to the whitelist.
  *
@@ -54,9 +72,37 @@ int gnrc_ipv6_whitelist_add(const ipv6_addr_t *addr);
  */
 void gnrc_ipv6_whitelist_del(const ipv6_addr_t *addr);
 
+#if GNRC_IPV6_WHITELIST_PREFIXES || defined(DOXYGEN)
+/**
+ * @brief   Adds an IPv6 prefix to the whitelist.
+ *
+ * Needs @ref GNRC_IPV6_WHITELIST_PREFIXES to be set.
+ *
+ * @param[in] prefix        An IPv6 prefix.
+ * @param[in] prefix_len    Length of @p prefix in bits, 1 to 128.
+ *
+ * @return  0, on success.
+ * @return  -1, if the prefix list is full or @p prefix_len is invalid.
+ */
+int gnrc_ipv6_whitelist_add_prefix(const ipv6_addr_t *prefix, uint8_t prefix_len);
+
+/**
+ * @brief   Removes an IPv6 prefix from the whitelist.
+ *
+ * Prefixes not in the whitelist will be ignored.
+ *
+ * @param[in] prefix        An IPv6 prefix.
+ * @param[in] prefix_len    Length of @p prefix in bits.
+ */
+void gnrc_ipv6_whitelist_del_prefix(const ipv6_addr_t *prefix, uint8_t prefix_len);
+#endif
+
 /**
  * @brief   Checks if an IPv6 address is whitelisted.
  *
+ * An address is whitelisted if it was added itself or if it matches one
+ * of the whitelisted prefixes.
+ *
  * @param[in] addr  An IPv6 address.
  *
  * @return  true, if @p addr is whitelisted.
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_lwmac Phase-locked low-power listening MAC
+ * @ingroup     net_gnrc
+ * @brief       Duty-cycled MAC that keeps the radio off most of the time
+ *
+ * Every node switches its radio on for @ref GNRC_LWMAC_WAKEUP_DURATION_US
+ * every @ref GNRC_LWMAC_WAKEUP_INTERVAL_US to listen and sleeps otherwise.
+ *
+ * To reach a sleeping neighbor, the sender repeats the frame (a "strobe")
+ * until the receiver wakes up and acknowledges one copy, at most for a full
+ * wake-up interval. Broadcast frames are repeated for a full interval.
+ *
+ * The time of the acknowledged copy tells the sender the receiver's wake-up
+ * phase, which is kept in gnrc_mac_tx_neighbor_t::phase. The next frame to
+ * this neighbor is only strobed from @ref GNRC_LWMAC_PHASE_GUARD_US before
+ * the receiver is expected to wake up, so a frame costs a few copies instead
+ * of half an interval of strobing. If the phase was wrong the sender falls
+ * back to a full strobe.
+ *
+ * The radio on-time is accounted in @ref gnrc_lwmac_stats_t,
+ * see gnrc_lwmac_get_stats().
+ *
+ * The MAC replaces the gnrc_netdev2 thread of the interface, use
+ * gnrc_lwmac_init() instead of gnrc_netdev2_init().
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for GNRC_LWMAC
+ */
+
+#ifndef GNRC_LWMAC_H
+#define GNRC_LWMAC_H
+
+#include "kernel_types.h"
+#include "net/gnrc/netdev2.h"
+#include "net/gnrc/lwmac/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Time between two wake-ups of a node in microseconds
+ */
+#ifndef GNRC_LWMAC_WAKEUP_INTERVAL_US
+#define GNRC_LWMAC_WAKEUP_INTERVAL_US   (100U * MS_IN_USEC)
+#endif
+
+/**
+ * @brief   Time a node listens after waking up in microseconds
+ *
+ * Must be longer than the gap between two copies of a strobe, i.e. the time
+ * to send the longest frame and wait for its acknowledgement.
+ */
+#ifndef GNRC_LWMAC_WAKEUP_DURATION_US
+#define GNRC_LWMAC_WAKEUP_DURATION_US   (6U * MS_IN_USEC)
+#endif
+
+/**
+ * @brief   Time in microseconds a sender starts strobing before the learned
+ *          wake-up of the receiver
+ *
+ * Covers the clock drift between the two nodes since the phase was learned.
+ */
+#ifndef GNRC_LWMAC_PHASE_GUARD_US
+#define GNRC_LWMAC_PHASE_GUARD_US       (2U * MS_IN_USEC)
+#endif
+
+/**
+ * @brief   Time in microseconds the radio stays on after a reception
+ *
+ * Lets the radio send the acknowledgement and catch further frames of the
+ * same sender.
+ */
+#ifndef GNRC_LWMAC_RX_LINGER_US
+#define GNRC_LWMAC_RX_LINGER_US         (2U * MS_IN_USEC)
+#endif
+
+/**
+ * @name    Message types of GNRC_LWMAC's timers
+ * @{
+ */
+#define GNRC_LWMAC_MSG_TYPE_WAKEUP      (0x0120)    /**< start listening */
+#define GNRC_LWMAC_MSG_TYPE_SLEEP       (0x0121)    /**< stop listening */
+#define GNRC_LWMAC_MSG_TYPE_TX          (0x0122)    /**< start a strobe */
+/** @} */
+
+/**
+ * @brief   Initialize the GNRC_LWMAC thread of an interface
+ *
+ * @param[in] stack         ptr to preallocated stack buffer
+ * @param[in] stacksize     size of stack buffer
+ * @param[in] priority      priority of thread
+ * @param[in] name          name of thread
+ * @param[in] gnrc_netdev2  ptr to netdev2 device to handle in created thread
+ *
+ * @return  pid of created thread
+ * @return  KERNEL_PID_UNDEF on error
+ */
+kernel_pid_t gnrc_lwmac_init(char *stack, int stacksize, char priority,
+                             const char *name, gnrc_netdev2_t *gnrc_netdev2);
+
+/**
+ * @brief   Get the duty-cycle and transmission statistics of an interface
+ *
+ * @param[in] gnrc_netdev2  the interface
+ * @param[out] stats        the statistics, with gnrc_lwmac_stats_t::radio_on
+ *                          including a currently ongoing on-time.
+ */
+void gnrc_lwmac_get_stats(gnrc_netdev2_t *gnrc_netdev2, gnrc_lwmac_stats_t *stats);
+
+/**
+ * @brief   Get the radio duty cycle of an interface
+ *
+ * @param[in] gnrc_netdev2  the interface
+ *
+ * @return  time the radio was on since start-up in per mille
+ */
+unsigned gnrc_lwmac_duty_cycle(gnrc_netdev2_t *gnrc_netdev2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_LWMAC_H */
+/** @} */
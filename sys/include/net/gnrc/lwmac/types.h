@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_lwmac
+ * @{
+ *
+ * @file
+ * @brief       Internal types of GNRC_LWMAC
+ */
+
+#ifndef GNRC_LWMAC_TYPES_H
+#define GNRC_LWMAC_TYPES_H
+
+#include <stdint.h>
+
+#include "msg.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Radio duty-cycle and transmission statistics
+ */
+typedef struct {
+    uint64_t radio_on;          /**< time in microseconds the radio was on */
+    uint64_t since;             /**< start of the statistics in microseconds */
+    uint32_t strobes;           /**< frame copies sent */
+    uint32_t tx_success;        /**< unicast frames acknowledged */
+    uint32_t tx_failed;         /**< unicast frames never acknowledged */
+    uint32_t tx_phase_hits;     /**< unicast frames acknowledged within the
+                                 *   receiver's learned wake-up phase */
+    uint32_t rx_count;          /**< received frames */
+} gnrc_lwmac_stats_t;
+
+/**
+ * @brief   State of GNRC_LWMAC
+ *
+ * @note    All members are private.
+ */
+typedef struct {
+    xtimer_t wakeup_timer;      /**< timer of the periodic wake-up */
+    msg_t wakeup_msg;           /**< message of gnrc_lwmac_t::wakeup_timer */
+    xtimer_t sleep_timer;       /**< timer to end listening */
+    msg_t sleep_msg;            /**< message of gnrc_lwmac_t::sleep_timer */
+    xtimer_t tx_timer;          /**< timer to start a strobe */
+    msg_t tx_msg;               /**< message of gnrc_lwmac_t::tx_timer */
+    uint64_t wakeup_at;         /**< time of the next wake-up */
+    uint64_t radio_on_at;       /**< time the radio was switched on */
+    uint64_t copy_at;           /**< time the current copy was sent */
+    uint64_t strobe_end;        /**< time the current strobe gives up */
+    gnrc_lwmac_stats_t stats;   /**< statistics */
+    uint8_t flags;              /**< state flags */
+} gnrc_lwmac_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_LWMAC_TYPES_H */
+/** @} */
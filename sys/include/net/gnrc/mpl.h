@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_mpl  MPL
+ * @ingroup     net_gnrc
+ * @brief       Multicast Protocol for Low-Power and Lossy Networks
+ *
+ * Implements the proactive forwarding of
+ * [RFC 7731](https://tools.ietf.org/html/rfc7731): every MPL forwarder
+ * rebroadcasts a new multicast message a few times, timed by a Trickle timer
+ * (see @ref sys_trickle) per message. Hearing the same message from enough
+ * neighbors suppresses the own transmission, so a message costs about one
+ * transmission per neighborhood instead of one per node.
+ *
+ * With this module, packets the node sends to a multicast address of
+ * realm-local or larger scope, e.g. ff05::fd for all CoAP nodes, are
+ * encapsulated in an MPL data message to @ref GNRC_MPL_DOMAIN_ADDR and sent
+ * over the MPL interface. Received messages are delivered once if the node
+ * joined the group of the inner packet.
+ *
+ * The seed ID of messages originated by the node is its source address.
+ * Control messages (reactive forwarding) are not supported.
+ *
+ * USEMODULE
+ * ---------
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ * USEMODULE += gnrc_mpl
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * and call gnrc_mpl_init() with the interface of the MPL domain.
+ *
+ * @{
+ *
+ * @file
+ * @brief   MPL definitions
+ */
+
+#ifndef GNRC_MPL_H_
+#define GNRC_MPL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/gnrc/ipv6.h"
+#include "net/ipv6/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Default stack size to use for the MPL thread
+ */
+#ifndef GNRC_MPL_STACK_SIZE
+#define GNRC_MPL_STACK_SIZE         (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Default priority for the MPL thread
+ */
+#ifndef GNRC_MPL_PRIO
+#define GNRC_MPL_PRIO               (GNRC_IPV6_PRIO + 1)
+#endif
+
+/**
+ * @brief   Default message queue size to use for the MPL thread
+ */
+#ifndef GNRC_MPL_MSG_QUEUE_SIZE
+#define GNRC_MPL_MSG_QUEUE_SIZE     (8U)
+#endif
+
+/**
+ * @brief   Message type for the end of a Trickle interval
+ */
+#define GNRC_MPL_MSG_TYPE_TRICKLE_INTERVAL  (0x0A01)
+
+/**
+ * @brief   Message type for a Trickle transmission
+ */
+#define GNRC_MPL_MSG_TYPE_TRICKLE_CALLBACK  (0x0A02)
+
+/**
+ * @brief   The MPL domain address, ALL_MPL_FORWARDERS of realm-local scope
+ */
+#define GNRC_MPL_DOMAIN_ADDR {{ 0xff, 0x03, 0x00, 0x00, \
+                                0x00, 0x00, 0x00, 0x00, \
+                                0x00, 0x00, 0x00, 0x00, \
+                                0x00, 0x00, 0x00, 0xfc }}
+
+/**
+ * @brief   Number of seeds whose messages are tracked
+ */
+#ifndef GNRC_MPL_SEED_SET_SIZE
+#define GNRC_MPL_SEED_SET_SIZE      (4U)
+#endif
+
+/**
+ * @brief   Number of buffered messages
+ *
+ * Each buffered message takes a packet buffer copy of the message.
+ */
+#ifndef GNRC_MPL_BUFFER_SIZE
+#define GNRC_MPL_BUFFER_SIZE        (4U)
+#endif
+
+/**
+ * @brief   Time in seconds a seed without buffered messages is remembered
+ *
+ * SEED_SET_ENTRY_LIFETIME of RFC 7731.
+ */
+#ifndef GNRC_MPL_SEED_LIFETIME
+#define GNRC_MPL_SEED_LIFETIME      (30U * 60U)
+#endif
+
+/**
+ * @brief   Minimum Trickle interval of data messages in milliseconds
+ */
+#ifndef GNRC_MPL_DATA_IMIN
+#define GNRC_MPL_DATA_IMIN          (256U)
+#endif
+
+/**
+ * @brief   Maximum Trickle interval of data messages as doublings of
+ *          @ref GNRC_MPL_DATA_IMIN
+ */
+#ifndef GNRC_MPL_DATA_IMAX
+#define GNRC_MPL_DATA_IMAX          (1U)
+#endif
+
+/**
+ * @brief   Trickle redundancy constant of data messages
+ */
+#ifndef GNRC_MPL_DATA_K
+#define GNRC_MPL_DATA_K             (1U)
+#endif
+
+/**
+ * @brief   Number of Trickle intervals a data message is retransmitted in
+ */
+#ifndef GNRC_MPL_DATA_EXPIRATIONS
+#define GNRC_MPL_DATA_EXPIRATIONS   (3U)
+#endif
+
+/**
+ * @brief   Hop limit of originated MPL data messages
+ */
+#ifndef GNRC_MPL_HOP_LIMIT
+#define GNRC_MPL_HOP_LIMIT          (255U)
+#endif
+
+/**
+ * @brief   MPL statistics
+ */
+typedef struct {
+    uint32_t originated;    /**< messages sent as seed */
+    uint32_t received;      /**< new messages received */
+    uint32_t duplicates;    /**< messages received again */
+    uint32_t transmitted;   /**< (re-)transmissions */
+    uint32_t dropped;       /**< messages dropped for lack of space */
+} gnrc_mpl_stats_t;
+
+/**
+ * @brief   PID of the MPL thread
+ */
+extern kernel_pid_t gnrc_mpl_pid;
+
+/**
+ * @brief   Initialization of the MPL thread
+ *
+ * Joins @ref GNRC_MPL_DOMAIN_ADDR on @p if_pid. Only one interface is
+ * supported, a later call moves the MPL domain to @p if_pid.
+ *
+ * @param[in] if_pid    PID of the interface of the MPL domain
+ *
+ * @return  The PID of the MPL thread, on success.
+ * @return  KERNEL_PID_UNDEF, on error.
+ */
+kernel_pid_t gnrc_mpl_init(kernel_pid_t if_pid);
+
+/**
+ * @brief   Gets the interface over which packets to @p dst are sent with MPL
+ *
+ * Used by @ref net_gnrc_ipv6 to hand packets to the MPL thread instead of
+ * sending them directly.
+ *
+ * @param[in] dst   Destination of a packet.
+ *
+ * @return  The interface of the MPL domain, if @p dst is a multicast address
+ *          of realm-local or larger scope other than
+ *          @ref GNRC_MPL_DOMAIN_ADDR.
+ * @return  KERNEL_PID_UNDEF, otherwise or if MPL was not initialized.
+ */
+kernel_pid_t gnrc_mpl_iface(const ipv6_addr_t *dst);
+
+/**
+ * @brief   Checks if @p dst is the MPL domain address
+ *
+ * @param[in] dst   Destination of a received packet.
+ *
+ * @return  true, if packets to @p dst are MPL data messages for the MPL
+ *          thread.
+ */
+bool gnrc_mpl_is_domain(const ipv6_addr_t *dst);
+
+/**
+ * @brief   Get the MPL statistics
+ *
+ * @return  the statistics since start-up
+ */
+const gnrc_mpl_stats_t *gnrc_mpl_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_MPL_H_ */
+/** @} */
@@ -31,6 +31,7 @@
 #include "net/ipv6/addr.h"
 #include "net/gnrc/ipv6/nc.h"
 #include "net/gnrc/ipv6/netif.h"
+#include "net/netstats.h"
 
 #include "net/gnrc/ndp/host.h"
 #include "net/gnrc/ndp/internal.h"
@@ -146,6 +147,26 @@ extern "C" {
 #define GNRC_NDP_MAX_RAND               (15U)
 /** @} */
 
+/**
+ * @brief   Rate of multicast neighbor solicitations for address resolution
+ *          in solicitations per second, 0 for no limit
+ *
+ * All neighbor cache entries share one token bucket, so after a reboot or a
+ * partition the probes for many neighbors are spread out instead of being
+ * sent at once. Probes that find the bucket empty are postponed, not lost.
+ */
+#ifndef GNRC_NDP_NBR_SOL_RATE
+#define GNRC_NDP_NBR_SOL_RATE           (4U)
+#endif
+
+/**
+ * @brief   Number of neighbor solicitations that may exceed
+ *          @ref GNRC_NDP_NBR_SOL_RATE in a burst
+ */
+#ifndef GNRC_NDP_NBR_SOL_BURST
+#define GNRC_NDP_NBR_SOL_BURST          (8U)
+#endif
+
 /**
  * @name    Router constants
  * @{
@@ -271,6 +292,18 @@ void gnrc_ndp_retrans_nbr_sol(gnrc_ipv6_nc_t *nc_entry);
  */
 void gnrc_ndp_state_timeout(gnrc_ipv6_nc_t *nc_entry);
 
+/**
+ * @brief   Get the statistics of neighbor discovery.
+ *
+ * @note    This function is only available if compiled with module
+ *          `netstats_ndp`. The statistics can also be requested from the
+ *          IPv6 thread with @ref NETOPT_STATS and context
+ *          @ref NETSTATS_NDP.
+ *
+ * @return  A @ref netstats_ndp_t pointer to the statistics.
+ */
+netstats_ndp_t *gnrc_ndp_get_stats(void);
+
 /**
  * @brief   NDP interface initialization.
  *
@@ -72,6 +72,19 @@ void gnrc_ndp_internal_set_state(gnrc_ipv6_nc_t *nc_entry, uint8_t state);
 void gnrc_ndp_internal_send_nbr_sol(kernel_pid_t iface, ipv6_addr_t *src, ipv6_addr_t *tgt,
                                     ipv6_addr_t *dst);
 
+/**
+ * @brief   Takes a token for a multicast neighbor solicitation from the
+ *          bucket shared by all neighbors.
+ *
+ * @internal
+ *
+ * @see @ref GNRC_NDP_NBR_SOL_RATE
+ *
+ * @return  0, if the solicitation may be sent now.
+ * @return  Time in microseconds until a token is available otherwise.
+ */
+uint32_t gnrc_ndp_internal_nbr_sol_token(void);
+
 /**
  * @brief   Send precompiled neighbor advertisement.
  *
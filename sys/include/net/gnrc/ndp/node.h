@@ -20,10 +20,48 @@
 #ifndef GNRC_NDP_NODE_H_
 #define GNRC_NDP_NODE_H_
 
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/pkt.h"
+#include "net/ipv6/addr.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of packets that can wait for address resolution in total
+ */
+#ifndef GNRC_NDP_NODE_QUEUE_SIZE
+#define GNRC_NDP_NODE_QUEUE_SIZE        (GNRC_IPV6_NC_SIZE * 2)
+#endif
+
+/**
+ * @brief   Number of packets that can wait for address resolution of a
+ *          single neighbor
+ *
+ * If the queue of a neighbor is full, the oldest packet is dropped in favor
+ * of the new one (see [RFC 4861, section 7.2.2]
+ * (https://tools.ietf.org/html/rfc4861#section-7.2.2)). This keeps an
+ * unresponsive neighbor from occupying the packet buffer.
+ *
+ * @note    Must be at least 1.
+ */
+#ifndef GNRC_NDP_NODE_QUEUE_PER_NBR
+#define GNRC_NDP_NODE_QUEUE_PER_NBR     (1U)
+#endif
+
+/**
+ * @brief   Statistics of the address resolution packet queue
+ */
+typedef struct {
+    uint32_t queued;        /**< packets queued for address resolution */
+    uint32_t dropped_head;  /**< queued packets replaced by newer ones */
+    uint32_t dropped_full;  /**< packets not queued since the queue was full */
+} gnrc_ndp_node_queue_stats_t;
+
 /**
  * @brief   Get link-layer address and interface for next hop to destination
  *          IPv6 address.
@@ -45,6 +83,13 @@ kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
                                            kernel_pid_t iface, ipv6_addr_t *dst,
                                            gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Get the statistics of the address resolution packet queue
+ *
+ * @return  the statistics since start-up
+ */
+const gnrc_ndp_node_queue_stats_t *gnrc_ndp_node_queue_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -58,6 +58,7 @@
 #ifndef GNRC_NETAPI_H_
 #define GNRC_NETAPI_H_
 
+#include "msg.h"
 #include "thread.h"
 #include "net/netopt.h"
 #include "net/gnrc/nettype.h"
@@ -92,6 +93,30 @@ extern "C" {
  */
 #define GNRC_NETAPI_MSG_TYPE_ACK        (0x0205)
 
+/**
+ * @brief   Number of messages gnrc_netapi_receive_prio() looks ahead
+ *
+ * Only used with module `gnrc_netapi_prio`.
+ */
+#ifndef GNRC_NETAPI_PRIO_BACKLOG_SIZE
+#define GNRC_NETAPI_PRIO_BACKLOG_SIZE   (4U)
+#endif
+
+/**
+ * @brief   Messages taken from the message queue of a thread, but not yet
+ *          handed out by gnrc_netapi_receive_prio()
+ *
+ * Must be zero-initialized.
+ */
+typedef struct {
+#if defined(MODULE_GNRC_NETAPI_PRIO) || defined(DOXYGEN)
+    msg_t msgs[GNRC_NETAPI_PRIO_BACKLOG_SIZE];  /**< the messages, in order */
+    unsigned len;                               /**< number of messages */
+#else
+    uint8_t unused;                             /**< no backlog */
+#endif
+} gnrc_netapi_backlog_t;
+
 /**
  * @brief   Data structure to be send for setting (@ref GNRC_NETAPI_MSG_TYPE_SET)
  *          and getting (@ref GNRC_NETAPI_MSG_TYPE_GET) options
@@ -117,6 +142,10 @@ int gnrc_netapi_send(kernel_pid_t pid, gnrc_pktsnip_t *pkt);
 /**
  * @brief   Sends @p cmd to all subscribers to (@p type, @p demux_ctx).
  *
+ * @p pkt is held once for all subscribers. Subscribers whose message queue or
+ * mailbox is full are skipped and their reference to @p pkt is given back;
+ * gnrc_netreg_entry_t::drops of their registry entry counts these losses.
+ *
  * @param[in] type      type of the targeted network module.
  * @param[in] demux_ctx demultiplexing context for @p type.
  * @param[in] cmd       command for all subscribers
@@ -206,6 +235,34 @@ int gnrc_netapi_get(kernel_pid_t pid, netopt_t opt, uint16_t context,
 int gnrc_netapi_set(kernel_pid_t pid, netopt_t opt, uint16_t context,
                     void *data, size_t data_len);
 
+#if defined(MODULE_GNRC_NETAPI_PRIO) || defined(DOXYGEN)
+/**
+ * @brief   Receives the message of the most urgent packet waiting for the
+ *          calling thread
+ *
+ * Blocks like msg_receive() until a message is available. Takes up to
+ * @ref GNRC_NETAPI_PRIO_BACKLOG_SIZE messages from the message queue and
+ * hands out @ref GNRC_NETAPI_MSG_TYPE_SND and @ref GNRC_NETAPI_MSG_TYPE_RCV
+ * messages of higher priority first. The priority of a packet is derived
+ * from the traffic class of its IPv6 header or, without one, taken from its
+ * @ref gnrc_netif_hdr_t::prio. All other messages and packets of the same
+ * priority are handed out in the order they were received.
+ *
+ * Without module `gnrc_netapi_prio` this is just msg_receive().
+ *
+ * @param[in,out] backlog   backlog of the calling thread
+ * @param[out] msg          the message
+ */
+void gnrc_netapi_receive_prio(gnrc_netapi_backlog_t *backlog, msg_t *msg);
+#else
+static inline void gnrc_netapi_receive_prio(gnrc_netapi_backlog_t *backlog,
+                                            msg_t *msg)
+{
+    (void)backlog;
+    msg_receive(msg);
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
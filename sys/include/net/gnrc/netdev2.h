@@ -38,6 +38,17 @@
 #include "net/gnrc/mac/types.h"
 #include "net/ieee802154.h"
 #include "net/gnrc/mac/mac.h"
+#include "net/netstats/neighbor.h"
+
+#ifdef MODULE_GNRC_LWMAC
+#include "net/gnrc/lwmac/types.h"
+#endif
+#ifdef MODULE_GNRC_NETDEV2_DEDUP
+#include "bloom.h"
+#endif
+#ifdef MODULE_GNRC_NETDEV2_CHANHOP
+#include "xtimer.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,6 +58,93 @@ extern "C" {
 #define GNRC_NETDEV2_MAC_PRIO   (THREAD_PRIORITY_MAIN - 5)
 #endif
 
+/**
+ * @brief   Priority of the thread shared by all devices with
+ *          `gnrc_netdev2_shared`
+ */
+#ifndef GNRC_NETDEV2_SHARED_PRIO
+#define GNRC_NETDEV2_SHARED_PRIO            (GNRC_NETDEV2_MAC_PRIO)
+#endif
+
+/**
+ * @brief   Stack size of the thread shared by all devices with
+ *          `gnrc_netdev2_shared`
+ */
+#ifndef GNRC_NETDEV2_SHARED_STACKSIZE
+#define GNRC_NETDEV2_SHARED_STACKSIZE       (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Message queue size of the thread shared by all devices with
+ *          `gnrc_netdev2_shared`
+ *
+ * Must be a power of two.
+ */
+#ifndef GNRC_NETDEV2_SHARED_MSG_QUEUE_SIZE
+#define GNRC_NETDEV2_SHARED_MSG_QUEUE_SIZE  (16U)
+#endif
+
+/**
+ * @brief   Message queue size of the relay thread of a device with
+ *          `gnrc_netdev2_shared`
+ *
+ * Must be a power of two.
+ */
+#ifndef GNRC_NETDEV2_RELAY_MSG_QUEUE_SIZE
+#define GNRC_NETDEV2_RELAY_MSG_QUEUE_SIZE   (4U)
+#endif
+
+/**
+ * @brief   Stack size of the relay thread of a device with
+ *          `gnrc_netdev2_shared`
+ */
+#ifndef GNRC_NETDEV2_RELAY_STACKSIZE
+#define GNRC_NETDEV2_RELAY_STACKSIZE        (THREAD_STACKSIZE_IDLE + \
+                                             (GNRC_NETDEV2_RELAY_MSG_QUEUE_SIZE * \
+                                              sizeof(msg_t)))
+#endif
+
+/**
+ * @brief   Stack size to pass to gnrc_netdev2_init() for a device whose own
+ *          thread would need @p size
+ *
+ * With `gnrc_netdev2_shared` the thread of a device only relays messages,
+ * so it gets by with @ref GNRC_NETDEV2_RELAY_STACKSIZE.
+ */
+#ifdef MODULE_GNRC_NETDEV2_SHARED
+#define GNRC_NETDEV2_STACKSIZE(size)        (GNRC_NETDEV2_RELAY_STACKSIZE)
+#else
+#define GNRC_NETDEV2_STACKSIZE(size)        (size)
+#endif
+
+/**
+ * @brief   Number of I/O vector elements kept on the stack for sending
+ *
+ * Packets with up to this many snips (including the link layer header) are
+ * handed to netdev2_driver_t::send() without allocating the vector from the
+ * packet buffer. Longer packets fall back to @ref gnrc_pktbuf_get_iovec().
+ */
+#ifndef GNRC_NETDEV2_IOVEC_NUMOF
+#define GNRC_NETDEV2_IOVEC_NUMOF    (8U)
+#endif
+
+/**
+ * @brief   Size in bits of each filter of @ref gnrc_netdev2_dedup_t
+ */
+#ifndef GNRC_NETDEV2_DEDUP_BITS
+#define GNRC_NETDEV2_DEDUP_BITS     (512U)
+#endif
+
+/**
+ * @brief   Number of frames a filter of @ref gnrc_netdev2_dedup_t takes before
+ *          the older filter is cleared and takes over
+ *
+ * Duplicates are recognized among the last 1 to 2 times as many frames.
+ */
+#ifndef GNRC_NETDEV2_DEDUP_FRAMES
+#define GNRC_NETDEV2_DEDUP_FRAMES   (16U)
+#endif
+
 /**
  * @brief   Type for @ref msg_t if device fired an event
  */
@@ -63,6 +161,58 @@ extern "C" {
  */
 #define GNRC_NETDEV2_MAC_INFO_RX_STARTED        (0x0004U)
 
+#if defined(MODULE_NETDEV2_IEEE802154) || defined(DOXYGEN)
+/**
+ * @brief   Pre-built IEEE 802.15.4 MAC header of a destination address mode
+ *
+ * Frames sent with the device's own source address only differ from it in
+ * the sequence number and the destination address.
+ */
+typedef struct {
+    uint8_t mhr[IEEE802154_MAX_HDR_LEN];        /**< the header */
+    uint8_t len;                                /**< length of the header,
+                                                 *   0 if not built yet */
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /**< source address it was
+                                                 *   built with */
+    uint16_t flags;                             /**< device flags it was
+                                                 *   built with */
+    uint16_t pan;                               /**< PAN ID it was built with */
+} gnrc_netdev2_ieee802154_mhr_t;
+#endif
+
+#if defined(MODULE_GNRC_NETDEV2_DEDUP) || defined(DOXYGEN)
+/**
+ * @brief   Filter of recently received (source address, sequence number)
+ *          pairs of frames that request no acknowledgement
+ *
+ * Two bloom filters take turns, so old frames age out without deleting
+ * single entries. See @ref GNRC_NETDEV2_DEDUP_FRAMES.
+ */
+typedef struct {
+    bloom_t filter[2];                              /**< the filters */
+    uint8_t bits[2][GNRC_NETDEV2_DEDUP_BITS / 8];   /**< their bits */
+    uint8_t cur;        /**< filter new frames are added to */
+    uint8_t count;      /**< frames in gnrc_netdev2_dedup_t::cur */
+} gnrc_netdev2_dedup_t;
+#endif
+
+#if defined(MODULE_GNRC_NETDEV2_CHANHOP) || defined(DOXYGEN)
+/**
+ * @brief   State of @ref net_gnrc_netdev2_chanhop
+ *
+ * @note    All members are private.
+ */
+typedef struct {
+    xtimer_t timer;         /**< timer of the slot boundaries */
+    msg_t msg;              /**< message of gnrc_netdev2_chanhop_t::timer */
+    uint32_t slot_start;    /**< start of the current slot in microseconds */
+    uint32_t asn;           /**< absolute number of the current slot */
+    uint8_t enabled;        /**< hopping is enabled */
+    uint8_t pending;        /**< the channel of the current slot is not set
+                             *   yet because a transmission was ongoing */
+} gnrc_netdev2_chanhop_t;
+#endif
+
 /**
  * @brief Structure holding GNRC netdev2 adapter state
  *
@@ -99,6 +249,80 @@ typedef struct gnrc_netdev2 {
      */
     kernel_pid_t pid;
 
+    /**
+     * @brief a NETDEV2_MSG_TYPE_EVENT message is queued for this adapter
+     *
+     * Further NETDEV2_EVENT_ISR signals before the thread handles it do not
+     * queue another message.
+     */
+    volatile uint8_t isr_pending;
+
+#if defined(MODULE_GNRC_PKTTRACE) || defined(DOXYGEN)
+    /**
+     * @brief time in us of the NETDEV2_EVENT_ISR that set
+     *        gnrc_netdev2_t::isr_pending
+     */
+    uint32_t isr_time;
+#endif
+
+#if defined(MODULE_GNRC_PKTBUF_LOAN) || defined(DOXYGEN)
+    /**
+     * @brief owner of frames lent by netdev2_driver_t::recv_loan()
+     */
+    gnrc_pkt_loan_t loan;
+#endif
+
+#if defined(MODULE_NETSTATS_NEIGHBOR) || defined(DOXYGEN)
+    /**
+     * @brief transmission statistics per neighbor
+     */
+    netstats_nb_table_t nb_stats;
+#endif
+
+#if defined(MODULE_NETDEV2_IEEE802154) || defined(DOXYGEN)
+    /**
+     * @brief source address of the last received frame that requested an
+     *        acknowledgement
+     *
+     * Used to drop retransmissions if the device does not filter duplicates
+     * itself (see @ref NETOPT_OFFLOAD_DUP_FILTER).
+     */
+    uint8_t last_rx_src[IEEE802154_LONG_ADDRESS_LEN];
+
+    /**
+     * @brief length of gnrc_netdev2_t::last_rx_src, 0 if none
+     */
+    uint8_t last_rx_src_len;
+
+    /**
+     * @brief sequence number of the last received frame that requested an
+     *        acknowledgement
+     */
+    uint8_t last_rx_seq;
+
+    /**
+     * @brief pre-built MAC headers for short (index 0) and long (index 1)
+     *        destination addresses
+     */
+    gnrc_netdev2_ieee802154_mhr_t mhr_cache[2];
+
+#if defined(MODULE_GNRC_NETDEV2_DEDUP) || defined(DOXYGEN)
+    /**
+     * @brief filter of recent frames without acknowledgement request, i.e.
+     *        broadcasts, to drop copies of them before they reach the upper
+     *        layers
+     */
+    gnrc_netdev2_dedup_t dedup;
+#endif
+#endif
+
+#if defined(MODULE_GNRC_NETDEV2_CHANHOP) || defined(DOXYGEN)
+    /**
+     * @brief channel hopping state
+     */
+    gnrc_netdev2_chanhop_t chanhop;
+#endif
+
 #ifdef MODULE_GNRC_MAC
     /**
      * @brief general information for the MAC protocol
@@ -130,6 +354,13 @@ typedef struct gnrc_netdev2 {
      */
     gnrc_mac_tx_t tx;
 #endif /* ((GNRC_MAC_TX_QUEUE_SIZE != 0) || (GNRC_MAC_NEIGHBOR_COUNT == 0)) || defined(DOXYGEN) */
+
+#if defined(MODULE_GNRC_LWMAC) || defined(DOXYGEN)
+    /**
+     * @brief state of the @ref net_gnrc_lwmac protocol
+     */
+    gnrc_lwmac_t lwmac;
+#endif
 #endif /* MODULE_GNRC_MAC */
 } gnrc_netdev2_t;
 
@@ -193,16 +424,42 @@ static inline void gnrc_netdev2_set_tx_feedback(gnrc_netdev2_t *dev,
 {
     /* check if gnrc_mac_tx_feedback does not collide with
      * GNRC_NETDEV2_MAC_INFO_RX_STARTED */
-    assert(txf & GNRC_NETDEV2_MAC_INFO_RX_STARTED);
+    assert(!(txf & GNRC_NETDEV2_MAC_INFO_RX_STARTED));
     /* unset previous value */
     dev->mac_info &= ~GNRC_NETDEV2_MAC_INFO_TX_FEEDBACK_MASK;
     dev->mac_info |= (uint16_t)(txf & GNRC_NETDEV2_MAC_INFO_TX_FEEDBACK_MASK);
 }
 #endif
 
+/**
+ * @brief Receive a frame from the device into a packet snip
+ *
+ * If the driver implements netdev2_driver_t::recv_loan() and the
+ * `gnrc_pktbuf_loan` module is used, the snip references the frame in the
+ * driver's memory, which is handed back to the driver once the snip is
+ * released. Otherwise the frame is copied into the packet buffer.
+ *
+ * Supposed to be called from gnrc_netdev2_t::recv().
+ *
+ * @param[in] gnrc_netdev2  ptr to netdev2 device to receive from
+ * @param[out] info         status information for the received packet, see
+ *                          netdev2_driver_t::recv(). May be NULL.
+ *
+ * @return  snip of type @ref GNRC_NETTYPE_UNDEF containing the whole frame
+ * @return  NULL if no frame was available or on error. The frame is dropped
+ *          in that case.
+ */
+gnrc_pktsnip_t *gnrc_netdev2_recv_frame(gnrc_netdev2_t *gnrc_netdev2, void *info);
+
 /**
  * @brief Initialize GNRC netdev2 handler thread
  *
+ * With the `gnrc_netdev2_shared` module, one thread services the drivers of
+ * all devices. The thread created here then only relays the messages for the
+ * device to the shared thread, in order, so its PID still identifies the
+ * interface. The shared thread is started with the first device. Size
+ * @p stack with @ref GNRC_NETDEV2_STACKSIZE().
+ *
  * @param[in] stack         ptr to preallocated stack buffer
  * @param[in] stacksize     size of stack buffer
  * @param[in] priority      priority of thread
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netdev2_chanhop Slotted channel hopping
+ * @ingroup     net_gnrc_netdev2
+ * @brief       Switches the channel of an interface from slot to slot
+ *
+ * Time is divided into slots of @ref GNRC_NETDEV2_CHANHOP_SLOT_US. The
+ * absolute slot number (ASN) selects the channel of a slot from the hop
+ * sequence @ref GNRC_NETDEV2_CHANHOP_SEQ. Nodes with the same ASN always
+ * use the same channel, so they keep in touch while spreading their
+ * traffic, and the losses caused by interference on a single channel,
+ * over all channels of the sequence.
+ *
+ * Hopping is started with @ref NETOPT_CHANNEL_HOP. Nodes must agree on
+ * the ASN, which is set with @ref NETOPT_CHANNEL_HOP_ASN, e.g. by the
+ * application from a time source of the network. The ASN skews along
+ * with the clocks of the nodes, so it must be set again regularly.
+ *
+ * A slot boundary that falls into a transmission changes the channel
+ * only once the transmission is done.
+ *
+ * The netdev2 thread of GNRC handles this, see gnrc_netdev2_init().
+ * @{
+ *
+ * @file
+ * @brief       Interface definition of the channel hopping of gnrc_netdev2
+ */
+#ifndef GNRC_NETDEV2_CHANHOP_H
+#define GNRC_NETDEV2_CHANHOP_H
+
+#include "net/gnrc/netdev2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of a slot in microseconds
+ *
+ * Long enough to send a frame of maximum length and receive its
+ * acknowledgement with a few CSMA backoffs.
+ */
+#ifndef GNRC_NETDEV2_CHANHOP_SLOT_US
+#define GNRC_NETDEV2_CHANHOP_SLOT_US    (10000U)
+#endif
+
+/**
+ * @brief   Hop sequence as initializer of an uint8_t array
+ *
+ * Defaults to the IEEE 802.15.4 channels between and above the usual
+ * IEEE 802.11 channels 1, 6 and 11.
+ */
+#ifndef GNRC_NETDEV2_CHANHOP_SEQ
+#define GNRC_NETDEV2_CHANHOP_SEQ        { 15, 20, 25, 26 }
+#endif
+
+/**
+ * @brief   Type for @ref msg_t of the slot timer
+ */
+#define GNRC_NETDEV2_MSG_TYPE_CHANHOP   (0x1235)
+
+/**
+ * @brief   Initialize channel hopping of an interface, disabled
+ *
+ * @param[in] gnrc_netdev2  the interface
+ */
+void gnrc_netdev2_chanhop_init(gnrc_netdev2_t *gnrc_netdev2);
+
+/**
+ * @brief   Start the next slot, on @ref GNRC_NETDEV2_MSG_TYPE_CHANHOP
+ *
+ * @param[in] gnrc_netdev2  the interface
+ */
+void gnrc_netdev2_chanhop_slot(gnrc_netdev2_t *gnrc_netdev2);
+
+/**
+ * @brief   Apply a channel change deferred by a transmission
+ *
+ * Called on the TX events of the device.
+ *
+ * @param[in] gnrc_netdev2  the interface
+ */
+void gnrc_netdev2_chanhop_tx_done(gnrc_netdev2_t *gnrc_netdev2);
+
+/**
+ * @brief   Get an option of channel hopping
+ *
+ * @param[in] gnrc_netdev2  the interface
+ * @param[in] opt           the option
+ * @param[out] value        value of the option
+ * @param[in] max_len       size of @p value
+ *
+ * @return  length of @p value
+ * @return  -ENOTSUP, if @p opt is not an option of channel hopping
+ * @return  -EOVERFLOW, if @p max_len is too small
+ */
+int gnrc_netdev2_chanhop_get(gnrc_netdev2_t *gnrc_netdev2, netopt_t opt,
+                             void *value, size_t max_len);
+
+/**
+ * @brief   Set an option of channel hopping
+ *
+ * @param[in] gnrc_netdev2  the interface
+ * @param[in] opt           the option
+ * @param[in] value         value of the option
+ * @param[in] len           length of @p value
+ *
+ * @return  length of @p value
+ * @return  -ENOTSUP, if @p opt is not an option of channel hopping
+ * @return  -EINVAL, if @p len is wrong
+ */
+int gnrc_netdev2_chanhop_set(gnrc_netdev2_t *gnrc_netdev2, netopt_t opt,
+                             const void *value, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_NETDEV2_CHANHOP_H */
+/** @} */
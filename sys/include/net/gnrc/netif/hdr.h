@@ -65,6 +65,30 @@ extern "C" {
  *          this flag the same way it does @ref GNRC_NETIF_HDR_FLAGS_BROADCAST.
  */
 #define GNRC_NETIF_HDR_FLAGS_MULTICAST  (0x40)
+
+/**
+ * @brief   Upper layer checksum is taken care of
+ *
+ * @details On reception the device already verified the checksum of the
+ *          upper layer protocol (see @ref NETOPT_OFFLOAD_CSUM_RX), so the
+ *          protocol does not need to check it again.
+ *          On sending the upper layer protocol already filled in its
+ *          checksum, so the network layer must not calculate it again.
+ *          Link layers ignore this flag on sending.
+ */
+#define GNRC_NETIF_HDR_FLAGS_CSUM       (0x20)
+/**
+ * @}
+ */
+
+/**
+ * @name    Priorities of packets
+ * @brief   Values for gnrc_netif_hdr_t::prio, lower values are served first
+ * @{
+ */
+#define GNRC_NETIF_HDR_PRIO_HIGH        (0U)    /**< alarms, network control */
+#define GNRC_NETIF_HDR_PRIO_NORMAL      (1U)    /**< default */
+#define GNRC_NETIF_HDR_PRIO_LOW         (2U)    /**< background traffic */
 /**
  * @}
  */
@@ -82,6 +106,8 @@ typedef struct {
     uint8_t flags;              /**< flags as defined above */
     uint8_t rssi;               /**< rssi of received packet (optional) */
     uint8_t lqi;                /**< lqi of received packet (optional) */
+    uint8_t prio;               /**< priority of the packet, see
+                                 *   @ref GNRC_NETIF_HDR_PRIO_NORMAL */
 } gnrc_netif_hdr_t;
 
 /**
@@ -100,6 +126,31 @@ static inline void gnrc_netif_hdr_init(gnrc_netif_hdr_t *hdr, uint8_t src_l2addr
     hdr->rssi = 0;
     hdr->lqi = 0;
     hdr->flags = 0;
+    hdr->prio = GNRC_NETIF_HDR_PRIO_NORMAL;
+}
+
+/**
+ * @brief   Get the priority of a packet from its IP traffic class
+ *
+ * Expedited forwarding (DSCP 46) and the network control classes CS6 and CS7
+ * are of high priority, CS1 is background traffic.
+ *
+ * @param[in] tc    the IPv6 traffic class or IPv4 type of service
+ *
+ * @return  the priority of the packet
+ */
+static inline uint8_t gnrc_netif_hdr_prio_from_tc(uint8_t tc)
+{
+    switch (tc >> 2) {
+        case 46:
+        case 48:
+        case 56:
+            return GNRC_NETIF_HDR_PRIO_HIGH;
+        case 8:
+            return GNRC_NETIF_HDR_PRIO_LOW;
+        default:
+            return GNRC_NETIF_HDR_PRIO_NORMAL;
+    }
 }
 
 /**
@@ -48,6 +48,20 @@ typedef enum {
 } gnrc_netreg_type_t;
 #endif
 
+/**
+ * @brief   Number of hash buckets per protocol type
+ *
+ * Only used with the `gnrc_netreg_hashed` module. Entries of the same
+ * protocol type are then spread over this many lists by their
+ * gnrc_netreg_entry_t::demux_ctx, so a lookup only needs to scan one of them.
+ * Costs `GNRC_NETTYPE_NUMOF * GNRC_NETREG_BUCKET_NUMOF` pointers of RAM.
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef GNRC_NETREG_BUCKET_NUMOF
+#define GNRC_NETREG_BUCKET_NUMOF    (8U)
+#endif
+
 /**
  * @brief   Demux context value to get all packets of a certain type.
  *
@@ -67,9 +81,9 @@ typedef enum {
 #ifdef MODULE_GNRC_NETAPI_MBOX
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
-                                                      { pid } }
+                                                      { pid }, 0 }
 #else
-#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } }
+#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid }, 0 }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -86,7 +100,7 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_MBOX(demux_ctx, mbox) { NULL, demux_ctx, \
                                                        GNRC_NETREG_TYPE_MBOX, \
-                                                       { .mbox = mbox } }
+                                                       { .mbox = mbox }, 0 }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
@@ -103,7 +117,7 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, cbd)   { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_CB, \
-                                                      { .cbd = cbd } }
+                                                      { .cbd = cbd }, 0 }
 
 /**
  * @brief   Packet handler callback for netreg entries with callback.
@@ -180,6 +194,14 @@ typedef struct gnrc_netreg_entry {
         gnrc_netreg_entry_cbd_t *cbd;
 #endif
     } target;                   /**< Target for the registry entry */
+
+    /**
+     * @brief   Number of packets that could not be delivered to this entry
+     *
+     * @details Counted by @ref gnrc_netapi_dispatch() whenever the target's
+     *          message queue or mailbox was full.
+     */
+    unsigned drops;
 } gnrc_netreg_entry_t;
 
 /**
@@ -206,6 +228,7 @@ static inline void gnrc_netreg_entry_init_pid(gnrc_netreg_entry_t *entry,
     entry->type = GNRC_NETREG_TYPE_DEFAULT;
 #endif
     entry->target.pid = pid;
+    entry->drops = 0;
 }
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -227,6 +250,7 @@ static inline void gnrc_netreg_entry_init_mbox(gnrc_netreg_entry_t *entry,
     entry->demux_ctx = demux_ctx;
     entry->type = GNRC_NETREG_TYPE_MBOX;
     entry->target.mbox = mbox;
+    entry->drops = 0;
 }
 #endif
 
@@ -249,6 +273,7 @@ static inline void gnrc_netreg_entry_init_cb(gnrc_netreg_entry_t *entry,
     entry->demux_ctx = demux_ctx;
     entry->type = GNRC_NETREG_TYPE_CB;
     entry->target.cbd = cbd;
+    entry->drops = 0;
 }
 #endif
 
@@ -24,6 +24,7 @@
 
 #include <inttypes.h>
 #include <stdlib.h>
+#include <sys/uio.h>
 
 #include "kernel_types.h"
 #include "net/gnrc/nettype.h"
@@ -99,6 +100,34 @@ extern "C" {
  * @note    This type has no initializer on purpose. Please use @ref net_gnrc_pktbuf
  *          as factory.
  */
+#if defined(MODULE_GNRC_PKTBUF_LOAN) || defined(DOXYGEN)
+/**
+ * @brief   Owner of packet data that lives outside of the packet buffer
+ *
+ * Memory owned by someone else, e.g. a slot of a network device's DMA receive
+ * ring, can be lent to the packet buffer with @ref gnrc_pktbuf_add_loaned().
+ * When the last user releases the snip holding the memory,
+ * gnrc_pkt_loan_t::release() is called to hand it back to its owner.
+ *
+ * The structure is typically embedded in the owner's state, so the owner can
+ * be retrieved with @ref container_of() in the callback.
+ */
+typedef struct gnrc_pkt_loan {
+    /**
+     * @brief   Returns lent memory to its owner
+     *
+     * Called with the packet buffer locked, so it must not call into the
+     * packet buffer itself.
+     *
+     * @param[in] loan  the loan the memory was added with
+     * @param[in] data  pointer into the lent memory. Since headers may have
+     *                  been marked out of it, this is not necessarily the
+     *                  start of the memory that was lent.
+     */
+    void (*release)(struct gnrc_pkt_loan *loan, void *data);
+} gnrc_pkt_loan_t;
+#endif
+
 /* packed to be aligned correctly in the static packet buffer */
 typedef struct gnrc_pktsnip {
     /**
@@ -111,10 +140,25 @@ typedef struct gnrc_pktsnip {
     void *data;                     /**< pointer to the data of the snip */
     size_t size;                    /**< the length of the snip in byte */
     gnrc_nettype_t type;            /**< protocol of the packet snip */
+#if defined(MODULE_GNRC_PKTBUF_QUOTA) || defined(DOXYGEN)
+    uint8_t quota;                  /**< quota class the snip and its data are
+                                     *   accounted to, see
+                                     *   @ref gnrc_pktbuf_quota_t */
+#endif
 #ifdef MODULE_GNRC_NETERR
     kernel_pid_t err_sub;           /**< subscriber to errors related to this
                                      *   packet snip */
 #endif
+#if defined(MODULE_GNRC_PKTBUF_LOAN) || defined(DOXYGEN)
+    gnrc_pkt_loan_t *loan;          /**< owner of gnrc_pktsnip_t::data, if it
+                                     *   is not located in the packet buffer.
+                                     *   NULL otherwise. */
+#endif
+#if defined(MODULE_GNRC_PKTTRACE) || defined(DOXYGEN)
+    uint32_t trace;                 /**< time of the last layer transition in
+                                     *   us, 0 if not traced
+                                     *   (see @ref net_gnrc_pkttrace) */
+#endif
 } gnrc_pktsnip_t;
 
 /**
@@ -183,14 +227,39 @@ static inline size_t gnrc_pkt_count(const gnrc_pktsnip_t *pkt)
 /**
  * @brief   Searches the packet for a packet snip of a specific type
  *
+ * Packets carry a handful of snips, so this is inlined to spare the
+ * layers the call for each of their header lookups.
+ *
  * @param[in] pkt   list of packet snips
  * @param[in] type  the type to search for
  *
  * @return  the packet snip in @p pkt with @ref gnrc_nettype_t @p type
  * @return  NULL, if none of the snips in @p pkt is of @p type
  */
-gnrc_pktsnip_t *gnrc_pktsnip_search_type(gnrc_pktsnip_t *pkt,
-                                         gnrc_nettype_t type);
+static inline gnrc_pktsnip_t *gnrc_pktsnip_search_type(gnrc_pktsnip_t *pkt,
+                                                       gnrc_nettype_t type)
+{
+    while ((pkt != NULL) && (pkt->type != type)) {
+        pkt = pkt->next;
+    }
+    return pkt;
+}
+
+/**
+ * @brief   Fills an I/O vector with the snips of the given packet
+ *
+ * Unlike @ref gnrc_pktbuf_get_iovec() this does not allocate anything, the
+ * caller provides the vector, e.g. on the stack.
+ *
+ * @param[in] pkt       first snip in the packet
+ * @param[out] vec      vector of at least @p max elements
+ * @param[in] max       maximum number of elements in @p vec
+ *
+ * @return  number of elements written to @p vec
+ * @return  0, if @p pkt has more than @p max snips
+ */
+size_t gnrc_pkt_fill_iovec(const gnrc_pktsnip_t *pkt, struct iovec *vec,
+                           size_t max);
 
 #ifdef __cplusplus
 }
@@ -39,6 +39,7 @@
 #include "net/gnrc/pkt.h"
 #include "net/gnrc/neterr.h"
 #include "net/gnrc/nettype.h"
+#include "net/netstats.h"
 #include "utlist.h"
 
 #ifdef __cplusplus
@@ -59,6 +60,97 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @name    Size classes of the `gnrc_pktbuf_slab` implementation
+ *
+ * @details `gnrc_pktbuf_slab` replaces the first-fit allocator of
+ *          `gnrc_pktbuf_static` with fixed size blocks: one class for
+ *          @ref gnrc_pktsnip_t descriptors (and data fitting into one) and
+ *          three classes for packet data. Allocation and release are O(1)
+ *          and the buffer can not fragment. A request is served from the
+ *          smallest class that fits and has a free block left. Sizes must be
+ *          multiples of the pointer size.
+ * @{
+ */
+#ifndef GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define GNRC_PKTBUF_SLAB_SNIP_NUMOF     (32U)   /**< number of snip blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_SMALL_SIZE
+#define GNRC_PKTBUF_SLAB_SMALL_SIZE     (64U)   /**< size of small blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_SMALL_NUMOF
+#define GNRC_PKTBUF_SLAB_SMALL_NUMOF    (16U)   /**< number of small blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_MEDIUM_SIZE
+#define GNRC_PKTBUF_SLAB_MEDIUM_SIZE    (256U)  /**< size of medium blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_MEDIUM_NUMOF
+#define GNRC_PKTBUF_SLAB_MEDIUM_NUMOF   (6U)    /**< number of medium blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_LARGE_SIZE
+#define GNRC_PKTBUF_SLAB_LARGE_SIZE     (1536U) /**< size of large blocks */
+#endif
+#ifndef GNRC_PKTBUF_SLAB_LARGE_NUMOF
+#define GNRC_PKTBUF_SLAB_LARGE_NUMOF    (2U)    /**< number of large blocks */
+#endif
+/** @} */
+
+/**
+ * @brief   Quota classes of the `gnrc_pktbuf_quota` module
+ *
+ * Every allocation is accounted to a class. A snip added in front of
+ * another one, e.g. a header to its payload, is accounted to the class of
+ * that one; other snips of type @ref GNRC_NETTYPE_ICMPV6 to
+ * @ref GNRC_PKTBUF_QUOTA_CONTROL and the rest to
+ * @ref GNRC_PKTBUF_QUOTA_DATA, unless added with gnrc_pktbuf_add_quota().
+ * Snips created from a snip, e.g. by gnrc_pktbuf_mark(), stay in its class.
+ *
+ * Implemented by `gnrc_pktbuf_static` only.
+ */
+typedef enum {
+    GNRC_PKTBUF_QUOTA_DATA = 0,     /**< everything not classified otherwise */
+    GNRC_PKTBUF_QUOTA_CONTROL,      /**< control traffic like NDP and RPL, may
+                                     *   use @ref GNRC_PKTBUF_CONTROL_RESERVE */
+    GNRC_PKTBUF_QUOTA_RX,           /**< frames received by the link layer */
+    GNRC_PKTBUF_QUOTA_REASSEMBLY,   /**< datagrams under reassembly */
+    GNRC_PKTBUF_QUOTA_NUMOF,        /**< number of quota classes */
+} gnrc_pktbuf_quota_t;
+
+/**
+ * @name    Limits of the `gnrc_pktbuf_quota` module
+ *
+ * @details All classes but @ref GNRC_PKTBUF_QUOTA_CONTROL leave the last
+ *          @ref GNRC_PKTBUF_CONTROL_RESERVE bytes of the buffer free, so
+ *          control traffic still gets through when a burst of data fills it.
+ *          Each class is also capped. Allocations beyond that fail like the
+ *          buffer was full.
+ * @{
+ */
+#ifndef GNRC_PKTBUF_CONTROL_RESERVE
+#define GNRC_PKTBUF_CONTROL_RESERVE     (512U)  /**< control reserve */
+#endif
+#ifndef GNRC_PKTBUF_DATA_CAP
+#define GNRC_PKTBUF_DATA_CAP            (GNRC_PKTBUF_SIZE)      /**< data cap */
+#endif
+#ifndef GNRC_PKTBUF_RX_CAP
+#define GNRC_PKTBUF_RX_CAP              (GNRC_PKTBUF_SIZE / 2)  /**< RX cap */
+#endif
+#ifndef GNRC_PKTBUF_REASSEMBLY_CAP
+#define GNRC_PKTBUF_REASSEMBLY_CAP      (GNRC_PKTBUF_SIZE / 2)  /**< reassembly cap */
+#endif
+/** @} */
+
+/**
+ * @brief   Usage of a quota class
+ */
+typedef struct {
+    uint32_t used;          /**< bytes currently allocated */
+    uint32_t max_used;      /**< high-water mark of
+                             *   gnrc_pktbuf_quota_stats_t::used */
+    uint32_t alloc_failed;  /**< allocations that failed, be it for the cap,
+                             *   the reserve or a full buffer */
+} gnrc_pktbuf_quota_stats_t;
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -88,6 +180,77 @@ void gnrc_pktbuf_init(void);
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
                                 gnrc_nettype_t type);
 
+#if defined(MODULE_GNRC_PKTBUF_QUOTA) || defined(DOXYGEN)
+/**
+ * @brief   Adds a new gnrc_pktsnip_t and its packet to the packet buffer,
+ *          accounted to a quota class
+ *
+ * Like gnrc_pktbuf_add(), but the snip is accounted to @p quota instead of
+ * a class derived from @p next and @p type.
+ *
+ * @param[in] next      Next gnrc_pktsnip_t in the packet.
+ * @param[in] data      Data of the new gnrc_pktsnip_t.
+ * @param[in] size      Length of @p data.
+ * @param[in] type      Protocol type of the gnrc_pktsnip_t.
+ * @param[in] quota     Quota class to account the snip to.
+ *
+ * @return  Pointer to the packet part that represents the new gnrc_pktsnip_t.
+ * @return  NULL, if no space is left in the packet buffer or for @p quota.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_add_quota(gnrc_pktsnip_t *next, void *data,
+                                      size_t size, gnrc_nettype_t type,
+                                      gnrc_pktbuf_quota_t quota);
+
+/**
+ * @brief   Get the usage of a quota class
+ *
+ * @param[in] quota     the quota class
+ *
+ * @return  the usage of @p quota, updated under the packet buffer's lock
+ */
+gnrc_pktbuf_quota_stats_t *gnrc_pktbuf_get_quota_stats(gnrc_pktbuf_quota_t quota);
+#else
+static inline gnrc_pktsnip_t *gnrc_pktbuf_add_quota(gnrc_pktsnip_t *next,
+                                                    void *data, size_t size,
+                                                    gnrc_nettype_t type,
+                                                    gnrc_pktbuf_quota_t quota)
+{
+    (void)quota;
+    return gnrc_pktbuf_add(next, data, size, type);
+}
+#endif
+
+#if defined(MODULE_GNRC_PKTBUF_LOAN) || defined(DOXYGEN)
+/**
+ * @brief   Adds a new gnrc_pktsnip_t referencing lent memory to the packet
+ *          buffer.
+ *
+ * Unlike @ref gnrc_pktbuf_add() @p data is not copied: only the snip
+ * descriptor is allocated from the packet buffer. The memory stays in place
+ * until the snip is released by its last user, then gnrc_pkt_loan_t::release()
+ * of @p loan is called. Headers marked with @ref gnrc_pktbuf_mark() are copied
+ * into the packet buffer, so the lent memory is always owned by one snip only.
+ * Growing the data with @ref gnrc_pktbuf_realloc_data() moves it into the
+ * packet buffer and returns the lent memory right away.
+ *
+ * @pre `(data != NULL) && (size > 0) && (loan != NULL)`
+ *
+ * @param[in] next      Next gnrc_pktsnip_t in the packet. Leave NULL if you
+ *                      want to create a new packet.
+ * @param[in] data      Lent data of the new gnrc_pktsnip_t.
+ * @param[in] size      Length of @p data.
+ * @param[in] type      Protocol type of the gnrc_pktsnip_t.
+ * @param[in] loan      Owner of @p data.
+ *
+ * @return  Pointer to the packet part that represents the new gnrc_pktsnip_t.
+ * @return  NULL, if no space is left in the packet buffer. @p data is still
+ *          owned by the caller in that case.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_add_loaned(gnrc_pktsnip_t *next, void *data,
+                                       size_t size, gnrc_nettype_t type,
+                                       gnrc_pkt_loan_t *loan);
+#endif
+
 /**
  * @brief   Marks the first @p size bytes in a received packet with a new
  *          packet snip that is appended to the packet.
@@ -282,11 +445,24 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes, or, for
+ *          `gnrc_pktbuf_slab`, the usage and high-water mark of every size
+ *          class.
  */
 void gnrc_pktbuf_stats(void);
 #endif
 
+/**
+ * @brief   Get the allocation statistics of the packet buffer.
+ *
+ * @note    Only available with module `netstats_pktbuf`. Unlike
+ *          gnrc_pktbuf_stats() this does not need DEVELHELP. The counters
+ *          are updated under the packet buffer's lock.
+ *
+ * @return  A @ref netstats_pktbuf_t pointer to the statistics.
+ */
+netstats_pktbuf_t *gnrc_pktbuf_get_stats(void);
+
 /* for testing */
 #ifdef TEST_SUITES
 /**
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pktcap Capture Network Packets
+ * @ingroup     net_gnrc
+ * @brief       Capture network packets in pcap format
+ *
+ * Like @ref net_gnrc_pktdump, but instead of pretty-printing each packet it
+ * writes a compact pcap stream that can be analyzed offline, e.g. with
+ * Wireshark. Each packet is one record with a timestamp, truncated to
+ * @ref GNRC_PKTCAP_SNAPLEN bytes. Optionally the number of records per second
+ * is limited.
+ *
+ * Records are handed to a sink function as a whole, so sinks can frame them
+ * or drop them without corrupting the stream. A sink for a RAM ring buffer
+ * and one for a UART are provided; others, e.g. ethos, are a few lines:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * static int _ethos_write(const uint8_t *data, size_t len)
+ * {
+ *     ethos_send_frame(&ethos, data, len, ETHOS_FRAME_TYPE_TEXT);
+ *     return 0;
+ * }
+ *
+ * gnrc_pktcap_init(_ethos_write);
+ * gnrc_netreg_entry_init_pid(&entry, GNRC_NETREG_DEMUX_CTX_ALL,
+ *                            gnrc_pktcap_pid);
+ * gnrc_netreg_register(GNRC_NETTYPE_IPV6, &entry);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The snips of a packet, without the netif header, are written in wire order,
+ * so the link type given by @ref GNRC_PKTCAP_LINKTYPE has to match the
+ * outermost header of the registered type.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface for the pcap packet capture module
+ */
+
+#ifndef GNRC_PKTCAP_H_
+#define GNRC_PKTCAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Message queue size for the pktcap thread
+ */
+#ifndef GNRC_PKTCAP_MSG_QUEUE_SIZE
+#define GNRC_PKTCAP_MSG_QUEUE_SIZE      (8U)
+#endif
+
+/**
+ * @brief   Priority of the pktcap thread
+ */
+#ifndef GNRC_PKTCAP_PRIO
+#define GNRC_PKTCAP_PRIO                (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @brief   Stack size used for the pktcap thread
+ */
+#ifndef GNRC_PKTCAP_STACKSIZE
+#define GNRC_PKTCAP_STACKSIZE           (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Maximum number of bytes captured per packet
+ */
+#ifndef GNRC_PKTCAP_SNAPLEN
+#define GNRC_PKTCAP_SNAPLEN             (128U)
+#endif
+
+/**
+ * @brief   pcap link type of the stream
+ *
+ * Defaults to LINKTYPE_RAW, i.e. packets starting with an IPv4 or IPv6
+ * header. Use 195 (LINKTYPE_IEEE802_15_4_WITHFCS) or 1 (LINKTYPE_ETHERNET)
+ * when capturing below the network layer.
+ */
+#ifndef GNRC_PKTCAP_LINKTYPE
+#define GNRC_PKTCAP_LINKTYPE            (101U)
+#endif
+
+/**
+ * @brief   Maximum number of records per second, 0 for no limit
+ */
+#ifndef GNRC_PKTCAP_RATE
+#define GNRC_PKTCAP_RATE                (0U)
+#endif
+
+/**
+ * @brief   Number of records that may exceed @ref GNRC_PKTCAP_RATE in a burst
+ */
+#ifndef GNRC_PKTCAP_BURST
+#define GNRC_PKTCAP_BURST               (8U)
+#endif
+
+/**
+ * @brief   Size of the RAM ring buffer for gnrc_pktcap_ring_write(), 0 to
+ *          disable it
+ *
+ * Must be a power of two.
+ */
+#ifndef GNRC_PKTCAP_RING_SIZE
+#define GNRC_PKTCAP_RING_SIZE           (0U)
+#endif
+
+/**
+ * @brief   Size of the pcap file header
+ */
+#define GNRC_PKTCAP_FILE_HDR_LEN        (24U)
+
+/**
+ * @brief   Size of the pcap record header
+ */
+#define GNRC_PKTCAP_REC_HDR_LEN         (16U)
+
+/**
+ * @brief   Sink of the pcap stream
+ *
+ * Called from the pktcap thread with the file header once and with one
+ * whole record per packet afterwards.
+ *
+ * @param[in] data  the data
+ * @param[in] len   length of @p data
+ *
+ * @return  0 on success
+ * @return  negative value if the data was dropped
+ */
+typedef int (*gnrc_pktcap_write_t)(const uint8_t *data, size_t len);
+
+/**
+ * @brief   The PID of the pktcap thread
+ */
+extern kernel_pid_t gnrc_pktcap_pid;
+
+/**
+ * @brief   Start the packet capture thread and listening for incoming packets
+ *
+ * Writes the pcap file header to @p write.
+ *
+ * @param[in] write     sink of the stream
+ *
+ * @return  PID of the pktcap thread
+ * @return  negative value on error
+ */
+kernel_pid_t gnrc_pktcap_init(gnrc_pktcap_write_t write);
+
+/**
+ * @brief   Get the number of packets not captured
+ *
+ * Counts packets dropped by the rate limit or by the sink.
+ *
+ * @return  number of packets not captured
+ */
+uint32_t gnrc_pktcap_dropped(void);
+
+#if GNRC_PKTCAP_RING_SIZE || defined(DOXYGEN)
+/**
+ * @brief   Sink writing to a RAM ring buffer
+ *
+ * Records that do not fit anymore are dropped as a whole.
+ */
+int gnrc_pktcap_ring_write(const uint8_t *data, size_t len);
+
+/**
+ * @brief   Read the stream from the RAM ring buffer
+ *
+ * May be called from any thread or an ISR.
+ *
+ * @param[out] buf  buffer for the stream
+ * @param[in] len   size of @p buf
+ *
+ * @return  number of bytes read
+ */
+size_t gnrc_pktcap_ring_read(uint8_t *buf, size_t len);
+#endif
+
+#if defined(GNRC_PKTCAP_UART) || defined(DOXYGEN)
+/**
+ * @brief   Sink writing to the UART @ref GNRC_PKTCAP_UART
+ *
+ * The UART must have been initialized and must not be used for stdio.
+ * Whether the transfer uses DMA is up to the peripheral driver.
+ */
+int gnrc_pktcap_uart_write(const uint8_t *data, size_t len);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_PKTCAP_H_ */
+/** @} */
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pkttrace Packet latency tracing
+ * @ingroup     net_gnrc
+ * @brief       Latency histograms of the hops of a packet through the stack
+ *
+ * With module `gnrc_pkttrace`, every @ref gnrc_pktsnip_t carries the time
+ * of the last layer transition of its packet. Each layer takes the time
+ * since then when it gets the packet, adds it to the histogram of its hop
+ * and stamps the packet again:
+ *
+ *     RX: ISR -> netdev2 -> 6LoWPAN -> IPv6 -> UDP -> sock
+ *     TX: sock -> UDP -> IPv6 -> 6LoWPAN -> netdev2 -> driver
+ *
+ * A hop is measured from the last layer the packet passed, so a hop of a
+ * layer the packet skips (e.g. 6LoWPAN on Ethernet) is added to the next.
+ * Packets the stack builds anew on the way, like reassembled datagrams and
+ * the fragments of a sent datagram, start without time stamp and are not
+ * traced further.
+ *
+ * The `pkttrace` shell command prints the histograms.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Packet latency tracing definitions
+ */
+
+#ifndef GNRC_PKTTRACE_H
+#define GNRC_PKTTRACE_H
+
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of buckets of a histogram
+ *
+ * Bucket i counts latencies of 2^i to 2^(i+1) - 1 microseconds, bucket 0
+ * also latencies below 1us, and the last bucket everything above.
+ */
+#ifndef GNRC_PKTTRACE_BUCKETS
+#define GNRC_PKTTRACE_BUCKETS   (16U)
+#endif
+
+/**
+ * @brief   Hops of a packet
+ */
+typedef enum {
+    GNRC_PKTTRACE_RX_NETDEV = 0,    /**< ISR to packet read by netdev2 */
+    GNRC_PKTTRACE_RX_SIXLOWPAN,     /**< to the 6LoWPAN thread */
+    GNRC_PKTTRACE_RX_IPV6,          /**< to the IPv6 thread */
+    GNRC_PKTTRACE_RX_UDP,           /**< to the UDP thread */
+    GNRC_PKTTRACE_RX_SOCK,          /**< to the sock receive returning */
+    GNRC_PKTTRACE_TX_UDP,           /**< sock send to the UDP thread */
+    GNRC_PKTTRACE_TX_IPV6,          /**< to the IPv6 thread */
+    GNRC_PKTTRACE_TX_SIXLOWPAN,     /**< to the 6LoWPAN thread */
+    GNRC_PKTTRACE_TX_NETDEV,        /**< to the netdev2 thread */
+    GNRC_PKTTRACE_TX_DRIVER,        /**< time in the driver's send */
+    GNRC_PKTTRACE_NUMOF             /**< number of hops */
+} gnrc_pkttrace_hop_t;
+
+/**
+ * @brief   Latency histogram of a hop
+ */
+typedef struct {
+    uint32_t count;                         /**< number of packets */
+    uint32_t max;                           /**< maximum latency in us */
+    uint64_t sum;                           /**< sum of the latencies in us */
+    uint32_t buckets[GNRC_PKTTRACE_BUCKETS];    /**< the histogram */
+} gnrc_pkttrace_hist_t;
+
+/**
+ * @brief   Time stamps all snips of a packet to start tracing it
+ *
+ * @param[in] pkt   the packet
+ * @param[in] time  the time in us the packet was seen first
+ */
+void gnrc_pkttrace_start(gnrc_pktsnip_t *pkt, uint32_t time);
+
+/**
+ * @brief   Records a hop of a packet and time stamps it again
+ *
+ * Does nothing for a packet without time stamp.
+ *
+ * @param[in] pkt   the packet
+ * @param[in] hop   the hop the packet just completed
+ */
+void gnrc_pkttrace_hop(gnrc_pktsnip_t *pkt, gnrc_pkttrace_hop_t hop);
+
+/**
+ * @brief   Records a latency measured without packet
+ *
+ * For hops that end with the packet released, like sending by the driver.
+ *
+ * @param[in] hop   the hop
+ * @param[in] usec  the latency in us
+ */
+void gnrc_pkttrace_record(gnrc_pkttrace_hop_t hop, uint32_t usec);
+
+/**
+ * @brief   Get the histogram of a hop
+ *
+ * @param[in] hop   the hop
+ *
+ * @return  the histogram
+ */
+const gnrc_pkttrace_hist_t *gnrc_pkttrace_get(gnrc_pkttrace_hop_t hop);
+
+/**
+ * @brief   Clears all histograms
+ */
+void gnrc_pkttrace_reset(void);
+
+/**
+ * @brief   Prints the histograms of all hops a packet was traced through
+ */
+void gnrc_pkttrace_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_PKTTRACE_H */
+/** @} */
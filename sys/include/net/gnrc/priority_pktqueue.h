@@ -11,6 +11,11 @@
  * @defgroup    net_gnrc_priority_pktqueue Priority packet queue for GNRC
  * @ingroup     net_gnrc
  * @brief       Wrapper for priority_queue that holds gnrc_pktsnip_t*
+ *
+ * By default the queue is a list sorted by priority, so every push walks the
+ * queue. With @ref GNRC_PRIORITY_PKTQUEUE_LEVELS set, the queue instead keeps
+ * one FIFO per priority level and a bitmap of the non-empty levels, which
+ * makes push, pop, head and length O(1).
  * @{
  *
  * @file
@@ -31,6 +36,23 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of priority levels of the bucketed queue, 0 for the
+ *          sorted list
+ *
+ * Priorities 0 to `GNRC_PRIORITY_PKTQUEUE_LEVELS - 1` each get their own
+ * FIFO, higher priority values share the last one. Packets of the same level
+ * leave the queue in the order they were pushed. At most 16 levels are
+ * supported.
+ */
+#ifndef GNRC_PRIORITY_PKTQUEUE_LEVELS
+#define GNRC_PRIORITY_PKTQUEUE_LEVELS   (0)
+#endif
+
+#if GNRC_PRIORITY_PKTQUEUE_LEVELS > 16
+#error "GNRC_PRIORITY_PKTQUEUE_LEVELS must not exceed 16"
+#endif
+
 /**
  * @brief data type for gnrc priority packet queue nodes
  */
@@ -40,10 +62,25 @@ typedef struct gnrc_priority_pktqueue_node {
     gnrc_pktsnip_t *pkt;                        /**< queue node data */
 } gnrc_priority_pktqueue_node_t;
 
+#if GNRC_PRIORITY_PKTQUEUE_LEVELS || defined(DOXYGEN)
 /**
  * @brief data type for gnrc priority packet queues
  */
+typedef struct {
+    /**
+     * @brief   first node of each level
+     */
+    gnrc_priority_pktqueue_node_t *first[GNRC_PRIORITY_PKTQUEUE_LEVELS];
+    /**
+     * @brief   last node of each level
+     */
+    gnrc_priority_pktqueue_node_t *last[GNRC_PRIORITY_PKTQUEUE_LEVELS];
+    uint32_t length;        /**< number of queued packets */
+    unsigned used;          /**< bitmap of the non-empty levels */
+} gnrc_priority_pktqueue_t;
+#else
 typedef priority_queue_t gnrc_priority_pktqueue_t;
+#endif
 
 /**
  * @brief Static initializer for gnrc_priority_pktqueue_node_t.
@@ -53,7 +90,11 @@ typedef priority_queue_t gnrc_priority_pktqueue_t;
 /**
  * @brief Static initializer for gnrc_priority_pktqueue_t.
  */
+#if GNRC_PRIORITY_PKTQUEUE_LEVELS || defined(DOXYGEN)
+#define PRIORITY_PKTQUEUE_INIT { { NULL }, { NULL }, 0, 0 }
+#else
 #define PRIORITY_PKTQUEUE_INIT { NULL }
+#endif
 
 /**
  * @brief   Initialize a gnrc priority packet queue node object.
@@ -108,6 +108,7 @@
 #include "net/gnrc/rpl/dodag.h"
 #include "net/gnrc/rpl/of_manager.h"
 #include "net/fib.h"
+#include "net/netstats/neighbor.h"
 #include "xtimer.h"
 #include "trickle.h"
 
@@ -198,12 +199,54 @@ extern "C" {
 /**
  * @brief   Number of implemented Objective Functions
  */
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (2)
+#else
 #define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1)
+#endif
 
 /**
  * @brief   Default Objective Code Point (OF0)
  */
+#ifndef GNRC_RPL_DEFAULT_OCP
 #define GNRC_RPL_DEFAULT_OCP (0)
+#endif
+
+/**
+ * @brief   Objective Code Point of MRHOF
+ * @see <a href="https://tools.ietf.org/html/rfc6719#section-6">
+ *          RFC 6719, section 6
+ *      </a>
+ */
+#define GNRC_RPL_MRHOF_OCP (1)
+
+/**
+ * @brief   Maximum ETX of a link MRHOF still selects a parent over,
+ *          multiplied by @ref NETSTATS_NB_ETX_DIVISOR
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_LINK_METRIC
+#define GNRC_RPL_MRHOF_MAX_LINK_METRIC (4U * NETSTATS_NB_ETX_DIVISOR)
+#endif
+
+/**
+ * @brief   ETX a parent's path has to be better than the one of the preferred
+ *          parent before MRHOF switches to it, multiplied by
+ *          @ref NETSTATS_NB_ETX_DIVISOR
+ *
+ * The hysteresis keeps nodes from flapping between parents of similar
+ * quality.
+ */
+#ifndef GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD
+#define GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD ((3U * NETSTATS_NB_ETX_DIVISOR) / 2)
+#endif
+
+/**
+ * @brief   ETX link metric type
+ * @see <a href="https://tools.ietf.org/html/rfc6551#section-4.3.2">
+ *          RFC 6551, section 4.3.2
+ *      </a>
+ */
+#define GNRC_RPL_METRIC_ETX (7)
 
 /**
  * @brief   Default Instance ID
@@ -339,11 +382,24 @@ static inline bool GNRC_RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
 #ifndef GNRC_RPL_REGULAR_DAO_INTERVAL
 #define GNRC_RPL_REGULAR_DAO_INTERVAL (60)
 #endif
+/**
+ * @brief Delay in seconds before a DAO is sent, see gnrc_rpl_delay_dao()
+ */
 #ifndef GNRC_RPL_DEFAULT_DAO_DELAY
 #define GNRC_RPL_DEFAULT_DAO_DELAY (1)
 #endif
 /** @} */
 
+/**
+ * @brief Number of DAO targets installed in the FIB at once
+ *
+ * The targets of a received DAO are collected on the stack and added with
+ * one call to fib_add_entries() per batch.
+ */
+#ifndef GNRC_RPL_DAO_FIB_BATCH
+#define GNRC_RPL_DAO_FIB_BATCH (8)
+#endif
+
 /**
  * @brief Cleanup timeout in seconds
  */
@@ -569,6 +625,10 @@ void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6
 /**
  * @brief   Delay the DAO sending interval
  *
+ * Schedules a DAO in @ref GNRC_RPL_DEFAULT_DAO_DELAY seconds. A scheduled DAO
+ * that was not sent yet is not postponed further, so all targets learned
+ * from DAOs received within the delay are aggregated into one DAO.
+ *
  * @param[in] dodag     The DODAG of the DAO
  */
 void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag);
@@ -23,6 +23,8 @@
 #ifndef GNRC_RPL_SRH_H_
 #define GNRC_RPL_SRH_H_
 
+#include "kernel_types.h"
+#include "net/fib.h"
 #include "net/ipv6/hdr.h"
 #include "net/ipv6/addr.h"
 
@@ -54,6 +56,64 @@ typedef struct __attribute__((packed)) {
     uint16_t resv;      /**< reserved */
 } gnrc_rpl_srh_t;
 
+/**
+ * @brief   Maximum number of hops, including the destination, of a source
+ *          route built by gnrc_rpl_srh_build()
+ */
+#ifndef GNRC_RPL_SRH_MAX_HOPS
+#define GNRC_RPL_SRH_MAX_HOPS   (8U)
+#endif
+
+/**
+ * @brief   Maximum length of a source routing header built by
+ *          gnrc_rpl_srh_build()
+ */
+#define GNRC_RPL_SRH_MAX_LEN    (sizeof(gnrc_rpl_srh_t) + \
+                                 ((GNRC_RPL_SRH_MAX_HOPS - 1) * sizeof(ipv6_addr_t)))
+
+/**
+ * @brief   Number of destinations whose source routing header is cached
+ *
+ * @note    Only used with module `gnrc_rpl_srh_cache`
+ */
+#ifndef GNRC_RPL_SRH_CACHE_SIZE
+#define GNRC_RPL_SRH_CACHE_SIZE (2U)
+#endif
+
+/**
+ * @brief   Builds the RPL source routing header to @p dst from the source
+ *          routes in @p table
+ *
+ * The addresses are compressed against the first hop (CmprI and CmprE) and
+ * the header is padded to a multiple of 8 octets. gnrc_rpl_srh_t::nh is
+ * left 0 for the caller to set.
+ *
+ * With module `gnrc_rpl_srh_cache` the built headers of the last
+ * @ref GNRC_RPL_SRH_CACHE_SIZE destinations are cached, so repeated calls
+ * only copy the header. An entry is used until the lifetime of its source
+ * route ends or any source route of @p table changes.
+ *
+ * @note    With module `gnrc_rpl_srh_cache` only to be called from one thread.
+ *
+ * @param[in] table         A source route FIB table.
+ * @param[in] dst           The destination of the packet.
+ * @param[out] iface        The interface to send the packet over.
+ * @param[out] first_hop    The first hop to put into the IPv6 header's
+ *                          destination.
+ * @param[out] buf          Buffer for the header. Should be able to hold
+ *                          @ref GNRC_RPL_SRH_MAX_LEN bytes.
+ * @param[in] buf_size      Size of @p buf.
+ *
+ * @return  Length of the header in @p buf.
+ * @return  0, if @p dst is the first hop and no header is needed.
+ * @return  -EHOSTUNREACH, if there is no source route to @p dst.
+ * @return  -ENOBUFS, if the route has more than @ref GNRC_RPL_SRH_MAX_HOPS
+ *          hops or the header does not fit into @p buf.
+ */
+int gnrc_rpl_srh_build(fib_table_t *table, const ipv6_addr_t *dst,
+                       kernel_pid_t *iface, ipv6_addr_t *first_hop,
+                       void *buf, size_t buf_size);
+
 /**
  * @brief   Process the RPL source routing header.
  *
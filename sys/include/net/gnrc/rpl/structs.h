@@ -215,7 +215,10 @@ struct gnrc_rpl_parent {
     uint16_t rank;                  /**< rank of the parent */
     gnrc_rpl_dodag_t *dodag;        /**< DODAG the parent belongs to */
     uint32_t lifetime;              /**< lifetime of this parent in seconds */
-    double  link_metric;            /**< metric of the link */
+    uint16_t link_metric;           /**< metric of the link, for
+                                         @ref GNRC_RPL_METRIC_ETX the ETX multiplied
+                                         by @ref NETSTATS_NB_ETX_DIVISOR,
+                                         0 if unknown */
     uint8_t link_metric_type;       /**< type of the metric */
 };
 
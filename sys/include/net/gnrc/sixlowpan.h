@@ -103,6 +103,7 @@
 #include <stdbool.h>
 
 #include "kernel_types.h"
+#include "net/netstats.h"
 
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/iphc.h"
@@ -146,6 +147,18 @@ extern "C" {
  */
 kernel_pid_t gnrc_sixlowpan_init(void);
 
+/**
+ * @brief   Get the statistics of the 6LoWPAN layer.
+ *
+ * @note    This function is only available if compiled with module
+ *          `netstats_sixlowpan`. The statistics can also be requested from
+ *          the 6LoWPAN thread with @ref NETOPT_STATS and context
+ *          @ref NETSTATS_SIXLOWPAN.
+ *
+ * @return  A @ref netstats_sixlowpan_t pointer to the statistics.
+ */
+netstats_sixlowpan_t *gnrc_sixlowpan_get_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,6 +14,14 @@
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
+ *
+ * With module `gnrc_sixlowpan_frag_vrb` a router forwards fragmented
+ * datagrams without reassembling them: the IPv6 header in the first fragment
+ * is decompressed, routed and compressed again for the next hop, and all
+ * further fragments with the same tag are relayed directly to that next hop.
+ * Datagrams to the router itself, multicast datagrams, datagrams whose first
+ * fragment does not fit the next hop's link anymore, and fragments arriving
+ * before their first fragment are still reassembled.
  * @{
  *
  * @file
@@ -32,6 +40,7 @@
 #include "kernel_types.h"
 #include "net/gnrc/pkt.h"
 #include "net/sixlowpan.h"
+#include "xtimer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,6 +51,28 @@ extern "C" {
  */
 #define GNRC_SIXLOWPAN_MSG_FRAG_SND    (0x0225)
 
+/**
+ * @brief   Number of datagrams that can be fragmented concurrently
+ *
+ * Fragments of concurrent datagrams are sent alternately. Only one datagram
+ * per destination is fragmented at a time, so a receiver only has to buffer
+ * one datagram of a sender.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_MSG_NUMOF
+#define GNRC_SIXLOWPAN_FRAG_MSG_NUMOF  (1U)
+#endif
+
+/**
+ * @brief   Minimum time in microseconds between two fragments of a datagram
+ *
+ * Gives the receiver and competing traffic room between the fragments of
+ * large datagrams. With 0 the next fragment is sent as soon as the 6LoWPAN
+ * thread gets to it.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_GAP
+#define GNRC_SIXLOWPAN_FRAG_GAP        (0U)
+#endif
+
 /**
  * @brief   Definition of 6LoWPAN fragmentation type.
  */
@@ -51,11 +82,34 @@ typedef struct {
     size_t datagram_size;   /**< Length of just the IPv6 packet to be fragmented */
     uint16_t offset;        /**< Offset of the Nth fragment from the beginning of the
                              *   payload datagram */
+#if (GNRC_SIXLOWPAN_FRAG_GAP > 0) || defined(DOXYGEN)
+    xtimer_t timer;         /**< Timer for the next fragment */
+    msg_t msg;              /**< Message for the next fragment */
+#endif
 } gnrc_sixlowpan_msg_frag_t;
 
+/**
+ * @brief   Statistics of the reassembly buffer
+ */
+typedef struct {
+    uint32_t complete;  /**< datagrams reassembled completely */
+    uint32_t timeout;   /**< datagrams discarded after a timeout */
+    uint32_t evicted;   /**< datagrams discarded to make room for a new one */
+    uint32_t nobuf;     /**< datagrams discarded for lack of packet buffer space */
+    uint32_t no_int;    /**< fragments discarded for lack of interval entries */
+    uint32_t invalid;   /**< datagrams discarded due to invalid fragments */
+    uint16_t max_used;  /**< peak number of entries in use at once */
+    uint16_t ints_max_used; /**< peak number of interval entries in use */
+} gnrc_sixlowpan_frag_rbuf_stats_t;
+
 /**
  * @brief   Sends a packet fragmented.
  *
+ * Sends one fragment of gnrc_sixlowpan_msg_frag_t::pkt and schedules the next one. The
+ * packet is released with an error code of @ref net_gnrc_neterr when
+ * sending fails, and normally after the last fragment, so a subscriber
+ * learns if the whole datagram was sent.
+ *
  * @param[in] fragment_msg    Message containing status of the 6LoWPAN
  *                            fragmentation progress
  */
@@ -68,6 +122,13 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg);
  */
 void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Get the statistics of the reassembly buffer
+ *
+ * @return  the statistics since start-up
+ */
+const gnrc_sixlowpan_frag_rbuf_stats_t *gnrc_sixlowpan_frag_rbuf_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
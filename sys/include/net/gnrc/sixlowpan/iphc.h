@@ -24,11 +24,33 @@
 
 #include "net/gnrc/pkt.h"
 #include "net/sixlowpan.h"
+#include "timex.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of flows whose address compression is cached
+ *
+ * @note    Only available with module `gnrc_sixlowpan_iphc_cache`.
+ */
+#ifndef GNRC_SIXLOWPAN_IPHC_CACHE_SIZE
+#define GNRC_SIXLOWPAN_IPHC_CACHE_SIZE      (2)
+#endif
+
+/**
+ * @brief   Maximum time in microseconds a cached address compression is used
+ *
+ * Bounds the time an expired context is used for compression, since context
+ * lifetimes expire lazily.
+ *
+ * @note    Only available with module `gnrc_sixlowpan_iphc_cache`.
+ */
+#ifndef GNRC_SIXLOWPAN_IPHC_CACHE_TIMEOUT
+#define GNRC_SIXLOWPAN_IPHC_CACHE_TIMEOUT   (10U * SEC_IN_USEC)
+#endif
+
 /**
  * @brief   Decompresses a received 6LoWPAN IPHC frame.
  *
@@ -60,6 +82,21 @@ size_t gnrc_sixlowpan_iphc_decode(gnrc_pktsnip_t **dec_hdr, gnrc_pktsnip_t *pkt,
  */
 bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Invalidates all cached address compressions.
+ *
+ * With module `gnrc_sixlowpan_iphc_cache` the compressed addresses of the
+ * last @ref GNRC_SIXLOWPAN_IPHC_CACHE_SIZE flows (pair of source and
+ * destination address per interface and link-layer addresses) are reused by
+ * gnrc_sixlowpan_iphc_encode(). Called when the context table or the
+ * addresses of an interface change. May be called from any thread.
+ */
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+void gnrc_sixlowpan_iphc_cache_invalidate(void);
+#else
+#define gnrc_sixlowpan_iphc_cache_invalidate()
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -65,6 +65,11 @@ extern "C" {
  */
 #define GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT    (0x0224)
 
+/**
+ * @brief   Message type for the minute tick of the address registration lifetimes
+ */
+#define GNRC_SIXLOWPAN_ND_MSG_REG_TICK      (0x0226)
+
 #ifndef GNRC_SIXLOWPAN_ND_AR_LTIME
 /**
  * @brief   Registration lifetime in minutes for the address registration option
@@ -51,6 +51,18 @@ extern "C" {
         (GNRC_SIXLOWPAN_ND_ROUTER_ABR_NUMOF * GNRC_NETIF_NUMOF)
 #endif
 
+/**
+ * @brief   Number of slots of the timer wheel for address registration
+ *          lifetimes, one per minute
+ *
+ * Registrations expiring in the same slot modulo the wheel size are checked
+ * together once a minute, so with hundreds of registered hosts this should be
+ * large enough for few to share a slot. Must be a power of two.
+ */
+#ifndef GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL_SIZE
+#define GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL_SIZE  (64U)
+#endif
+
 /**
  * @brief   Representation for prefixes coming from a router
  */
@@ -95,6 +107,36 @@ static inline void gnrc_sixlowpan_nd_router_gc_nc(gnrc_ipv6_nc_t *nc_entry)
 
 }
 
+/**
+ * @brief   Sets or refreshes the address registration of a neighbor
+ *
+ * Marks @p nc_entry as registered. The entry is removed from the neighbor
+ * cache @p ltime minutes from now unless refreshed before. All registrations
+ * share one timer that ticks once a minute while there are any.
+ *
+ * @param[in] nc_entry  A neighbor cache entry.
+ * @param[in] ltime     The registration lifetime in minutes, must not be 0.
+ */
+void gnrc_sixlowpan_nd_router_reg_set(gnrc_ipv6_nc_t *nc_entry, uint16_t ltime);
+
+/**
+ * @brief   Removes the address registration of a neighbor from the lifetime
+ *          tracking
+ *
+ * Called when @p nc_entry is removed from the neighbor cache.
+ *
+ * @param[in] nc_entry  A neighbor cache entry.
+ */
+void gnrc_sixlowpan_nd_router_reg_remove(gnrc_ipv6_nc_t *nc_entry);
+
+/**
+ * @brief   Handles the minute tick of the address registration lifetimes
+ *
+ * Removes the registrations that expired. Called by the IPv6 thread on
+ * @ref GNRC_SIXLOWPAN_ND_MSG_REG_TICK.
+ */
+void gnrc_sixlowpan_nd_router_reg_tick(void);
+
 /**
  * @brief   Set @p netif to router mode.
  *
@@ -29,6 +29,7 @@
 #include "net/gnrc.h"
 #include "periph/uart.h"
 #include "ringbuffer.h"
+#include "tsrb.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -44,6 +45,16 @@ extern "C" {
 #define GNRC_SLIP_BUFSIZE       (1500U)
 #endif
 
+/**
+ * @brief   Size of the buffer for undecoded data from the UART
+ *
+ * The UART interrupt only copies received data into this buffer, the SLIP
+ * thread decodes it. Must be a power of two.
+ */
+#ifndef GNRC_SLIP_RAW_BUFSIZE
+#define GNRC_SLIP_RAW_BUFSIZE   (256U)
+#endif
+
 /**
  * @brief   Device descriptor for SLIP devices
  */
@@ -52,6 +63,10 @@ typedef struct {
     ringbuffer_t in_buf;            /**< RX buffer */
     ringbuffer_t out_buf;           /**< TX buffer */
     char rx_mem[GNRC_SLIP_BUFSIZE]; /**< memory used by RX buffer */
+    tsrb_t raw_buf;                 /**< undecoded data from the UART */
+    char raw_mem[GNRC_SLIP_RAW_BUFSIZE];    /**< memory used by raw_buf */
+    volatile uint8_t rx_pending;    /**< a message to decode raw_buf is
+                                     *   queued for the thread */
     uint32_t in_bytes;              /**< the number of bytes received of a
                                      *   currently incoming packet */
     uint16_t in_esc;                /**< receiver is in escape mode */
@@ -0,0 +1,420 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tcp TCP
+ * @ingroup     net_gnrc
+ * @brief       GNRC's lightweight implementation of the TCP protocol
+ *
+ * The implementation is meant for constrained nodes, so it trades throughput
+ * for memory:
+ *
+ * - Every connection has a fixed receive buffer of @ref GNRC_TCP_RCV_BUF_SIZE
+ *   bytes, which is also the largest window that is announced, and a send
+ *   buffer of @ref GNRC_TCP_SND_BUF_SIZE bytes. Both live in the connection
+ *   object, so no memory is allocated at run time apart from the packet
+ *   buffer.
+ * - Segments that arrive out of order are dropped and recovered by the
+ *   retransmission of the peer.
+ * - Acknowledgments are delayed by up to @ref GNRC_TCP_ACK_DELAY, unless a
+ *   second segment arrives or the application frees a large part of the
+ *   receive buffer.
+ * - All retransmission, delayed acknowledgment and connection timers of all
+ *   connections share a single @ref sys_xtimer "xtimer".
+ * - A closed connection does not linger in TIME-WAIT, so its object can be
+ *   reused right away.
+ *
+ * Applications should use the @ref net_sock_tcp "sock_tcp" API provided by
+ * the `gnrc_sock_tcp` module instead of the functions here.
+ *
+ * @see         <a href="https://tools.ietf.org/html/rfc793">RFC 793</a>
+ * @{
+ *
+ * @file
+ * @brief       TCP GNRC definition
+ */
+
+#ifndef GNRC_TCP_H_
+#define GNRC_TCP_H_
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "kernel_types.h"
+#include "mbox.h"
+#include "net/gnrc.h"
+#include "net/ipv6/addr.h"
+#include "net/tcp.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Default message queue size for the TCP thread
+ */
+#ifndef GNRC_TCP_MSG_QUEUE_SIZE
+#define GNRC_TCP_MSG_QUEUE_SIZE (8U)
+#endif
+
+/**
+ * @brief   Priority of the TCP thread
+ */
+#ifndef GNRC_TCP_PRIO
+#define GNRC_TCP_PRIO           (THREAD_PRIORITY_MAIN - 2)
+#endif
+
+/**
+ * @brief   Default stack size to use for the TCP thread
+ */
+#ifndef GNRC_TCP_STACK_SIZE
+#define GNRC_TCP_STACK_SIZE     (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Maximum segment size announced to peers
+ *
+ * Fits a segment into the IPv6 minimum MTU.
+ */
+#ifndef GNRC_TCP_MSS
+#define GNRC_TCP_MSS            (1220U)
+#endif
+
+/**
+ * @brief   Size of the receive buffer of a connection
+ *
+ * This is the fixed window announced to the peer.
+ */
+#ifndef GNRC_TCP_RCV_BUF_SIZE
+#define GNRC_TCP_RCV_BUF_SIZE   (GNRC_TCP_MSS)
+#endif
+
+/**
+ * @brief   Size of the send buffer of a connection
+ *
+ * Bounds the data in flight. At least two segments let peers that
+ * acknowledge every second segment do so right away.
+ */
+#ifndef GNRC_TCP_SND_BUF_SIZE
+#define GNRC_TCP_SND_BUF_SIZE   (GNRC_TCP_MSS)
+#endif
+
+/**
+ * @brief   Maximum time to delay an acknowledgment in microseconds
+ */
+#ifndef GNRC_TCP_ACK_DELAY
+#define GNRC_TCP_ACK_DELAY      (100U * MS_IN_USEC)
+#endif
+
+/**
+ * @brief   Initial retransmission timeout in microseconds
+ */
+#ifndef GNRC_TCP_RTO_INIT
+#define GNRC_TCP_RTO_INIT       (1U * SEC_IN_USEC)
+#endif
+
+/**
+ * @brief   Lower bound of the retransmission timeout in microseconds
+ */
+#ifndef GNRC_TCP_RTO_MIN
+#define GNRC_TCP_RTO_MIN        (200U * MS_IN_USEC)
+#endif
+
+/**
+ * @brief   Upper bound of the retransmission timeout in microseconds
+ */
+#ifndef GNRC_TCP_RTO_MAX
+#define GNRC_TCP_RTO_MAX        (60U * SEC_IN_USEC)
+#endif
+
+/**
+ * @brief   Number of retransmissions of a segment before the connection is
+ *          given up
+ */
+#ifndef GNRC_TCP_MAX_RETRIES
+#define GNRC_TCP_MAX_RETRIES    (5U)
+#endif
+
+/**
+ * @brief   Size of the notification queue of a connection
+ *
+ * Must be a power of two.
+ */
+#ifndef GNRC_TCP_MBOX_SIZE
+#define GNRC_TCP_MBOX_SIZE      (2U)
+#endif
+
+/**
+ * @brief   Message type the connections are notified with
+ */
+#define GNRC_TCP_MSG_TYPE_NOTIFY    (0x0320)
+
+/**
+ * @brief   Connection states, see gnrc_tcp_tcb_t::state
+ *
+ * LISTEN is represented by @ref gnrc_tcp_listener_t, TIME-WAIT is skipped.
+ */
+enum {
+    GNRC_TCP_STATE_CLOSED = 0,      /**< no connection */
+    GNRC_TCP_STATE_SYN_SENT,        /**< SYN sent, waiting for SYN-ACK */
+    GNRC_TCP_STATE_SYN_RCVD,        /**< SYN-ACK sent, waiting for ACK */
+    GNRC_TCP_STATE_ESTABLISHED,     /**< connection established */
+    GNRC_TCP_STATE_FIN_WAIT_1,      /**< FIN sent, waiting for its ACK */
+    GNRC_TCP_STATE_FIN_WAIT_2,      /**< FIN acknowledged, waiting for the
+                                     *   FIN of the peer */
+    GNRC_TCP_STATE_CLOSE_WAIT,      /**< FIN received, waiting for close */
+    GNRC_TCP_STATE_CLOSING,         /**< both sent FIN, waiting for its ACK */
+    GNRC_TCP_STATE_LAST_ACK,        /**< FIN sent after the one of the peer,
+                                     *   waiting for its ACK */
+};
+
+/**
+ * @brief   Transmission control block of a TCP connection
+ *
+ * All members are private to the TCP implementation.
+ */
+typedef struct gnrc_tcp_tcb {
+    struct gnrc_tcp_tcb *next;              /**< list of active connections */
+    struct gnrc_tcp_listener *listener;     /**< listener of a passive open */
+    ipv6_addr_t local_addr;                 /**< local address */
+    ipv6_addr_t peer_addr;                  /**< remote address */
+    kernel_pid_t netif;                     /**< interface of the connection */
+    uint16_t local_port;                    /**< local port */
+    uint16_t peer_port;                     /**< remote port */
+    uint8_t state;                          /**< GNRC_TCP_STATE_* */
+    uint8_t flags;                          /**< internal flags */
+    uint8_t retries;                        /**< retransmissions of snd_una */
+    int8_t error;                           /**< error to report, as -errno */
+    uint32_t iss;                           /**< initial send sequence number */
+    uint32_t snd_una;                       /**< oldest unacknowledged number */
+    uint32_t snd_nxt;                       /**< next sequence number to send */
+    uint32_t rcv_nxt;                       /**< next sequence number expected */
+    uint16_t snd_wnd;                       /**< window of the peer */
+    uint16_t mss;                           /**< segment size for sending */
+    uint16_t snd_len;                       /**< bytes in snd_buf */
+    uint16_t rcv_len;                       /**< bytes in rcv_buf */
+    uint16_t rcv_acked;                     /**< free space last announced */
+    uint32_t rto;                           /**< retransmission timeout */
+    uint32_t srtt;                          /**< smoothed round-trip time */
+    uint32_t rttvar;                        /**< round-trip time variation */
+    uint32_t rtt_seq;                       /**< sequence number being timed */
+    uint32_t rtt_start;                     /**< time rtt_seq was sent */
+    uint32_t rtx_deadline;                  /**< retransmission deadline */
+    uint32_t ack_deadline;                  /**< delayed acknowledgment */
+    mbox_t mbox;                            /**< notifications of the owner */
+    msg_t mbox_queue[GNRC_TCP_MBOX_SIZE];   /**< queue for gnrc_tcp_tcb_t::mbox */
+    uint8_t rcv_buf[GNRC_TCP_RCV_BUF_SIZE]; /**< data received in order */
+    uint8_t snd_buf[GNRC_TCP_SND_BUF_SIZE]; /**< data not yet acknowledged */
+} gnrc_tcp_tcb_t;
+
+/**
+ * @brief   Passive open of TCP connections on a local port
+ *
+ * All members are private to the TCP implementation.
+ */
+typedef struct gnrc_tcp_listener {
+    struct gnrc_tcp_listener *next;         /**< list of listeners */
+    ipv6_addr_t local_addr;                 /**< local address, may be
+                                             *   unspecified */
+    uint16_t local_port;                    /**< local port */
+    gnrc_tcp_tcb_t *tcbs;                   /**< connection objects */
+    unsigned tcbs_len;                      /**< number of gnrc_tcp_listener_t::tcbs */
+    mbox_t mbox;                            /**< established connections */
+    msg_t mbox_queue[GNRC_TCP_MBOX_SIZE];   /**< queue for gnrc_tcp_listener_t::mbox */
+} gnrc_tcp_listener_t;
+
+/**
+ * @brief   Initialize and start TCP
+ *
+ * @return  PID of the TCP thread
+ * @return  negative value on error
+ */
+int gnrc_tcp_init(void);
+
+/**
+ * @brief   Calculate the checksum for the given packet
+ *
+ * @param[in] hdr           Pointer to the TCP header
+ * @param[in] pseudo_hdr    Pointer to the network layer header
+ *
+ * @return  0 on success
+ * @return  -EBADMSG if @p hdr is not of type GNRC_NETTYPE_TCP
+ * @return  -EFAULT if @p hdr or @p pseudo_hdr is NULL
+ * @return  -ENOENT if gnrc_pktsnip_t::type of @p pseudo_hdr is not known
+ */
+int gnrc_tcp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr);
+
+/**
+ * @brief   Opens a connection to a peer
+ *
+ * Blocks until the connection is established or failed.
+ *
+ * @pre `(tcb != NULL) && (remote != NULL) && (remote_port != 0)`
+ *
+ * @param[out] tcb          Object for the connection.
+ * @param[in] remote        Address of the peer.
+ * @param[in] remote_port   Port of the peer.
+ * @param[in] netif         Interface to use. May be KERNEL_PID_UNDEF.
+ * @param[in] local_port    Local port. 0 for a random port.
+ *
+ * @return  0 on success.
+ * @return  -EADDRINUSE, if @p local_port is used by another connection.
+ * @return  -ECONNREFUSED, if the peer refused the connection.
+ * @return  -ENOMEM, if the packet buffer is full.
+ * @return  -ETIMEDOUT, if the peer did not answer.
+ */
+int gnrc_tcp_connect(gnrc_tcp_tcb_t *tcb, const ipv6_addr_t *remote,
+                     uint16_t remote_port, kernel_pid_t netif,
+                     uint16_t local_port);
+
+/**
+ * @brief   Accepts connections to a local port
+ *
+ * @pre `(listener != NULL) && (tcbs != NULL) && (tcbs_len > 0)`
+ *
+ * @param[out] listener     Object for the listener.
+ * @param[in] local         Local address. May be NULL for any address.
+ * @param[in] local_port    Local port.
+ * @param[in] tcbs          Objects for the accepted connections.
+ * @param[in] tcbs_len      Number of objects in @p tcbs.
+ *
+ * @return  0 on success.
+ * @return  -EADDRINUSE, if @p local_port is already listened on.
+ */
+int gnrc_tcp_listen(gnrc_tcp_listener_t *listener, const ipv6_addr_t *local,
+                    uint16_t local_port, gnrc_tcp_tcb_t *tcbs,
+                    unsigned tcbs_len);
+
+/**
+ * @brief   Stops accepting connections
+ *
+ * Connections that are not accepted yet are reset.
+ *
+ * @param[in] listener  A listener.
+ */
+void gnrc_tcp_stop_listen(gnrc_tcp_listener_t *listener);
+
+/**
+ * @brief   Waits for an established connection of a listener
+ *
+ * @param[in] listener  A listener.
+ * @param[out] tcb      The established connection.
+ * @param[in] timeout   Timeout in microseconds. 0 to return immediately,
+ *                      SOCK_NO_TIMEOUT to wait forever.
+ *
+ * @return  0 on success.
+ * @return  -EAGAIN, if @p timeout is 0 and no connection is established.
+ * @return  -ETIMEDOUT, if @p timeout expired.
+ */
+int gnrc_tcp_accept(gnrc_tcp_listener_t *listener, gnrc_tcp_tcb_t **tcb,
+                    uint32_t timeout);
+
+/**
+ * @brief   Reads data of a connection
+ *
+ * @param[in] tcb       A connection.
+ * @param[out] data     Buffer for the data.
+ * @param[in] max_len   Size of @p data.
+ * @param[in] timeout   Timeout in microseconds. 0 to return immediately,
+ *                      SOCK_NO_TIMEOUT to wait forever.
+ *
+ * @return  The number of bytes read.
+ * @return  0, if the peer closed the connection.
+ * @return  -EAGAIN, if @p timeout is 0 and no data is available.
+ * @return  -ECONNRESET, if the peer reset the connection.
+ * @return  -ENOTCONN, if @p tcb is not connected.
+ * @return  -ETIMEDOUT, if @p timeout expired or the peer stopped answering.
+ */
+ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, size_t max_len,
+                      uint32_t timeout);
+
+/**
+ * @brief   Writes data to a connection
+ *
+ * Blocks until all of @p data is in the send buffer.
+ *
+ * @param[in] tcb   A connection.
+ * @param[in] data  The data.
+ * @param[in] len   Length of @p data.
+ *
+ * @return  The number of bytes written.
+ * @return  -ECONNRESET, if the peer reset the connection.
+ * @return  -ENOTCONN, if @p tcb is not connected or already closed for
+ *          writing.
+ * @return  -ETIMEDOUT, if the peer stopped answering.
+ */
+ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, size_t len);
+
+/**
+ * @brief   Closes a connection gracefully
+ *
+ * Blocks until the data in the send buffer was acknowledged and both sides
+ * closed the connection, or the peer stopped answering. @p tcb can be reused
+ * afterwards.
+ *
+ * @param[in] tcb   A connection.
+ */
+void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief   Resets a connection
+ *
+ * @p tcb can be reused afterwards.
+ *
+ * @param[in] tcb   A connection.
+ */
+void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb);
+
+#if defined(TEST_SUITES) || defined(DOXYGEN)
+/**
+ * @brief   Processes a received segment in the context of the caller
+ *
+ * @note    Only available with `TEST_SUITES` defined.
+ *
+ * @param[in] pkt   A TCP segment, followed by its IPv6 header and optionally
+ *                  a netif header. Released by the function.
+ */
+void gnrc_tcp_receive(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Lets all pending timers of all connections expire now
+ *
+ * @note    Only available with `TEST_SUITES` defined.
+ */
+void gnrc_tcp_expire_timers(void);
+
+/**
+ * @brief   Starts closing a connection without waiting for the peer
+ *
+ * @note    Only available with `TEST_SUITES` defined.
+ *
+ * @param[in] tcb   A connection.
+ */
+void gnrc_tcp_close_start(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief   Gets the MSS option of a segment
+ *
+ * @note    Only available with `TEST_SUITES` defined.
+ *
+ * @param[in] hdr       A TCP header.
+ * @param[in] hdr_len   Length of @p hdr including its options.
+ *
+ * @return  The announced MSS.
+ * @return  0, if @p hdr carries no valid MSS option.
+ */
+uint16_t gnrc_tcp_parse_mss(const tcp_hdr_t *hdr, size_t hdr_len);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_TCP_H_ */
+/** @} */
@@ -29,6 +29,13 @@
  *  - https://tools.ietf.org/html/rfc2349
  *     (RFC2349 TFTP Timeout Interval and Transfer Size Options)
  *
+ *  - https://tools.ietf.org/html/rfc7440
+ *     (RFC7440 TFTP Windowsize Option)
+ *
+ * With the option extensions, up to @ref GNRC_TFTP_WINDOW_SIZE data blocks
+ * are sent before waiting for an acknowledgement. The message queue of the
+ * thread receiving the data should hold a window.
+ *
  * @author      Nick van IJzendoorn <nijzendoorn@engineering-spirit.nl>
  */
 
@@ -74,6 +81,26 @@ extern "C" {
 #define GNRC_TFTP_MAX_TRANSFER_UNIT         (512)
 #endif
 
+/**
+ * @brief The maximum number of data blocks in flight before an acknowledgement
+ *
+ * A client asks for this window size, a server accepts at most this one.
+ * Set it to 1 for lock-step transfers.
+ */
+#ifndef GNRC_TFTP_WINDOW_SIZE
+#define GNRC_TFTP_WINDOW_SIZE               (4)
+#endif
+
+/**
+ * @brief The number of transfers the server runs at the same time
+ *
+ * The sessions share the server thread. A request is answered with an error
+ * if all sessions are in use.
+ */
+#ifndef GNRC_TFTP_SERVER_SESSIONS
+#define GNRC_TFTP_SERVER_SESSIONS           (1)
+#endif
+
 /**
  * @brief The number of retries that must be made before stopping a transfer
  */
@@ -141,6 +168,10 @@ typedef void (*tftp_stop_cb_t)(tftp_event_t event, const char *msg);
 /**
  * @brief Start the TFTP server
  *
+ * The server runs up to @ref GNRC_TFTP_SERVER_SESSIONS transfers in the
+ * calling thread. Its callbacks can tell the transfers apart with
+ * gnrc_tftp_server_session().
+ *
  * @param [in] data_cb      called for each read data block
  * @param [in] start_cb     called if a new client connection is requested
  * @param [in] stop_cb      called if the transfer has finished
@@ -151,6 +182,14 @@ typedef void (*tftp_stop_cb_t)(tftp_event_t event, const char *msg);
  */
 int gnrc_tftp_server(tftp_data_cb_t data_cb, tftp_start_cb_t start_cb, tftp_stop_cb_t stop_cb, bool use_options);
 
+/**
+ * @brief Get the server session a callback is called for
+ *
+ * @return the session number, from 0 to GNRC_TFTP_SERVER_SESSIONS - 1
+ * @return -1 if not called from a server callback
+ */
+int gnrc_tftp_server_session(void);
+
 /**
  * @brief Stop the TFTP server
  *
@@ -11,6 +11,15 @@
  * @ingroup     net_gnrc
  * @brief       GNRC's implementation of the UDP protocol
  *
+ * By default UDP runs in a thread of its own. With the `gnrc_udp_event`
+ * module it runs on the shared event thread of @ref sys_event instead, which
+ * saves the stack of the UDP thread once another module uses the shared
+ * thread as well. UDP then runs with the priority of the shared thread and
+ * handles packets in the order they arrive, without @ref net_gnrc_netapi
+ * priorities. Only @ref GNRC_NETAPI_MSG_TYPE_SND and
+ * @ref GNRC_NETAPI_MSG_TYPE_RCV are supported in that case, statistics are
+ * available through gnrc_udp_get_stats().
+ *
  * @{
  *
  * @file
@@ -26,6 +35,7 @@
 
 #include "byteorder.h"
 #include "net/gnrc.h"
+#include "net/netstats.h"
 #include "net/udp.h"
 
 #ifdef __cplusplus
@@ -34,6 +44,9 @@ extern "C" {
 
 /**
  * @brief   Default message queue size for the UDP thread
+ *
+ * With `gnrc_udp_event` this is the number of packets that can wait for the
+ * shared event thread. Must be a power of two in that case.
  */
 #ifndef GNRC_UDP_MSG_QUEUE_SIZE
 #define GNRC_UDP_MSG_QUEUE_SIZE (8U)
@@ -83,11 +96,23 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
 /**
  * @brief   Initialize and start UDP
  *
- * @return  PID of the UDP thread
+ * @return  PID of the UDP thread (of the shared event thread with
+ *          `gnrc_udp_event`)
  * @return  negative value on error
  */
 int gnrc_udp_init(void);
 
+/**
+ * @brief   Get the statistics of the UDP layer
+ *
+ * @note    Only available with module `netstats_udp`. The statistics can
+ *          also be requested from the UDP thread with @ref NETOPT_STATS and
+ *          context @ref NETSTATS_UDP.
+ *
+ * @return  A @ref netstats_udp_t pointer to the statistics
+ */
+netstats_udp_t *gnrc_udp_get_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
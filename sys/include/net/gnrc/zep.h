@@ -68,6 +68,13 @@ extern "C" {
 #define GNRC_ZEP_MSG_QUEUE_SIZE (8U)
 #endif
 
+/**
+ * @brief   Interval in microseconds to check for frames from the ZEP hub
+ */
+#ifndef GNRC_ZEP_HUB_POLL_US
+#define GNRC_ZEP_HUB_POLL_US    (1000U)
+#endif
+
 /**
  * @brief   Default addresses if the CPUID module is not present
  * @{
@@ -232,6 +239,30 @@ typedef struct {
 kernel_pid_t gnrc_zep_init(gnrc_zep_t *dev, uint16_t src_port, ipv6_addr_t *dst,
                            uint16_t dst_port);
 
+#if defined(MODULE_ZEP_HUB) || defined(DOXYGEN)
+/**
+ * @brief   Initializion of the ZEP thread and device on a shared memory hub
+ *
+ * Instead of sending ZEP over UDP to a dispatcher, frames are delivered to
+ * the other native instances attached to the same hub file directly (see
+ * zep_hub.h). The thread checks for received frames every
+ * @ref GNRC_ZEP_HUB_POLL_US.
+ *
+ * @note    Only available with module `zep_hub` on native.
+ *
+ * @param[in] dev       Network device, will be initialized.
+ * @param[in] file      Path to the hub file.
+ * @param[in] node      Number of this node in the hub.
+ *
+ * @return  PID of the ZEP thread on success.
+ * @return  -EEXIST, if ZEP thread was already created.
+ * @return  -ENODEV, if @p dev is NULL.
+ * @return  -ENOENT, -EINVAL or -ERANGE, see zep_hub_attach()
+ * @return  -EOVERFLOW, if there are too many threads running already
+ */
+kernel_pid_t gnrc_zep_init_hub(gnrc_zep_t *dev, const char *file, unsigned node);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -73,6 +73,36 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Updates an Internet Checksum for a changed 16-bit word of its
+ *          domain
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @details Unlike the other functions, this works on the normalized checksum
+ *          as it is stored in the header, so a header that is rewritten in
+ *          place does not need a walk over its whole checksum domain.
+ *          Call it for each changed word.
+ *
+ * @param[in] csum      The normalized checksum (in host byte order).
+ * @param[in] old_word  The 16-bit word before the change (in host byte order).
+ * @param[in] new_word  The 16-bit word after the change (in host byte order).
+ *
+ * @return  The normalized checksum over the changed domain.
+ */
+static inline uint16_t inet_csum_update(uint16_t csum, uint16_t old_word,
+                                        uint16_t new_word)
+{
+    /* HC' = ~(~HC + ~m + m') (RFC 1624, eqn. 3) */
+    uint32_t sum = (uint16_t)~csum + (uint16_t)~old_word + new_word;
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -215,6 +215,10 @@ typedef enum {
      *
      * Expects a pointer to a @ref netstats_t struct that will be pointed to
      * the corresponding @ref netstats_t of the module.
+     *
+     * The 6LoWPAN, IPv6 and UDP threads answer with a pointer to their own
+     * statistics struct (e.g. @ref netstats_ipv6_t), selected by the
+     * context (e.g. @ref NETSTATS_IPV6).
      */
     NETOPT_STATS,
 
@@ -240,6 +244,50 @@ typedef enum {
      */
     NETOPT_RF_TESTMODE,
 
+    /**
+     * @brief   get the frame processing the device currently does in hardware
+     *
+     * Read-only, as uint16_t bitfield of @ref netopt_offload_t flags.
+     * Upper layers skip the corresponding work in software for flags that
+     * are set. Devices not supporting this option are assumed to offload
+     * nothing.
+     */
+    NETOPT_OFFLOADS,
+
+    /**
+     * @brief   en/disable hopping over channels from slot to slot
+     *
+     * As netopt_enable_t. Handled by the netdev2 thread of GNRC with module
+     * `gnrc_netdev2_chanhop`, see @ref net_gnrc_netdev2_chanhop.
+     */
+    NETOPT_CHANNEL_HOP,
+
+    /**
+     * @brief   get/set the absolute slot number of channel hopping
+     *
+     * As uint32_t. Setting it starts that slot immediately, nodes with the
+     * same slot number use the same channel.
+     */
+    NETOPT_CHANNEL_HOP_ASN,
+
+    /**
+     * @brief   pass frames to a link-layer multicast address
+     *
+     * Set-only, as link-layer address of the length of @ref NETOPT_ADDRESS.
+     * Devices filtering multicast frames in hardware add the address to
+     * their filter and report @ref NETOPT_OFFLOAD_MCAST_FILTER. Upper layers
+     * count joins, so the device sees one set per address.
+     */
+    NETOPT_L2_GROUP,
+
+    /**
+     * @brief   stop passing frames to a link-layer multicast address
+     *
+     * Set-only, as link-layer address of the length of @ref NETOPT_ADDRESS.
+     * Reverts @ref NETOPT_L2_GROUP.
+     */
+    NETOPT_L2_GROUP_LEAVE,
+
     /* add more options if needed */
 
     /**
@@ -290,6 +338,32 @@ typedef enum {
     NETOPT_RF_TESTMODE_CTX_PRBS9,   /**< PRBS9 continuous tx mode */
 } netopt_rf_testmode_t;
 
+/**
+ * @brief   Flags returned with @ref NETOPT_OFFLOADS
+ */
+typedef enum {
+    NETOPT_OFFLOAD_ADDR_FILTER = 0x0001,    /**< frames to other destinations
+                                             *   and ACK frames are dropped */
+    NETOPT_OFFLOAD_AUTOACK     = 0x0002,    /**< received frames are
+                                             *   acknowledged */
+    NETOPT_OFFLOAD_RETRANS     = 0x0004,    /**< unacknowledged frames are
+                                             *   retransmitted, see
+                                             *   @ref NETOPT_RETRANS */
+    NETOPT_OFFLOAD_CSMA        = 0x0008,    /**< the channel is sensed
+                                             *   before sending */
+    NETOPT_OFFLOAD_DUP_FILTER  = 0x0010,    /**< retransmitted copies of a
+                                             *   received frame are dropped */
+    NETOPT_OFFLOAD_CSUM_RX     = 0x0020,    /**< upper layer checksums of
+                                             *   received packets are verified
+                                             *   and packets with invalid
+                                             *   checksums are dropped */
+    NETOPT_OFFLOAD_CSUM_TX     = 0x0040,    /**< upper layer checksums of sent
+                                             *   packets are calculated */
+    NETOPT_OFFLOAD_MCAST_FILTER = 0x0080,   /**< multicast frames are filtered
+                                             *   by the groups set with
+                                             *   @ref NETOPT_L2_GROUP */
+} netopt_offload_t;
+
 /**
  * @brief   Get a string ptr corresponding to opt, for debugging
  *
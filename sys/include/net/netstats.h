@@ -34,6 +34,12 @@ extern "C" {
 #define NETSTATS_LAYER2     (0x01)
 #define NETSTATS_IPV6       (0x02)
 #define NETSTATS_RPL        (0x03)
+#define NETSTATS_NEIGHBOR   (0x04)
+#define NETSTATS_SIXLOWPAN  (0x05)
+#define NETSTATS_UDP        (0x06)
+#define NETSTATS_ICMPV6     (0x07)
+#define NETSTATS_PKTBUF     (0x08)
+#define NETSTATS_NDP        (0x09)
 #define NETSTATS_ALL        (0xFF)
 /** @} */
 
@@ -51,8 +57,119 @@ typedef struct {
     uint32_t tx_bytes;          /**< sent bytes */
     uint32_t rx_count;          /**< received (data) packets */
     uint32_t rx_bytes;          /**< received bytes */
+    uint32_t rx_dup_count;      /**< received duplicates that were dropped */
 } netstats_t;
 
+/**
+ * @brief       Statistics of the IPv6 layer, independent of the interface
+ *
+ * Complements the per-interface @ref netstats_t with the reasons packets
+ * are lost inside the IPv6 thread. Available with module `netstats_ipv6`.
+ */
+typedef struct {
+    uint32_t rx_count;          /**< received packets, including loopback */
+    uint32_t rx_invalid;        /**< dropped as not IPv6, with an invalid
+                                     length, or by the white-/blacklist */
+    uint32_t rx_not_for_me;     /**< dropped by a host as not addressed
+                                     to it */
+    uint32_t rx_no_receiver;    /**< dropped as no one is registered for
+                                     the next header */
+    uint32_t fwd_count;         /**< packets forwarded to another node */
+    uint32_t fwd_dropped;       /**< not forwarded for a link-local address
+                                     or an exhausted hop limit */
+    uint32_t tx_count;          /**< packets sent by upper layers */
+    uint32_t tx_dropped;        /**< packets dropped on the send path, too
+                                     big or without interface */
+    uint32_t no_route;          /**< packets without next hop */
+    uint32_t nobuf;             /**< packets dropped for lack of space in
+                                     the packet buffer */
+} netstats_ipv6_t;
+
+/**
+ * @brief       Statistics of the 6LoWPAN layer
+ *
+ * Reassembly losses are kept by the reassembly buffer itself.
+ * Available with module `netstats_sixlowpan`.
+ */
+typedef struct {
+    uint32_t rx_count;          /**< received frames */
+    uint32_t rx_frag_count;     /**< received fragments */
+    uint32_t rx_dropped;        /**< frames dropped for an unsupported
+                                     dispatch or failed decompression */
+    uint32_t rx_no_receiver;    /**< datagrams without IPv6 thread */
+    uint32_t tx_count;          /**< datagrams sent */
+    uint32_t tx_frag_count;     /**< datagrams sent in fragments */
+    uint32_t tx_dropped;        /**< datagrams dropped as too big, while a
+                                     datagram to the same destination was
+                                     fragmented, or by the interface */
+    uint32_t nobuf;             /**< datagrams dropped for lack of space in
+                                     the packet buffer */
+} netstats_sixlowpan_t;
+
+/**
+ * @brief       Statistics of the UDP layer
+ *
+ * Available with module `netstats_udp`.
+ */
+typedef struct {
+    uint32_t rx_count;          /**< received datagrams */
+    uint32_t rx_csum_err;       /**< datagrams with zero or invalid
+                                     checksum */
+    uint32_t rx_no_receiver;    /**< datagrams to a port no one is
+                                     registered for */
+    uint32_t tx_count;          /**< datagrams sent */
+    uint32_t tx_dropped;        /**< datagrams without network layer */
+    uint32_t nobuf;             /**< datagrams dropped for lack of space in
+                                     the packet buffer */
+} netstats_udp_t;
+
+/**
+ * @brief       Statistics of the ICMPv6 layer
+ *
+ * Available with module `netstats_icmpv6`.
+ */
+typedef struct {
+    uint32_t rx_count;          /**< received messages */
+    uint32_t rx_invalid;        /**< messages too short or with invalid
+                                     checksum */
+    uint32_t rx_echo_req;       /**< received echo requests */
+    uint32_t rx_nd;             /**< received neighbor discovery messages */
+    uint32_t rx_unhandled;      /**< messages of a type the stack does not
+                                     process itself */
+} netstats_icmpv6_t;
+
+/**
+ * @brief       Statistics of the packet buffer
+ *
+ * Available with module `netstats_pktbuf`.
+ */
+typedef struct {
+    uint32_t alloc_count;       /**< successful allocations */
+    uint32_t alloc_failed;      /**< failed allocations */
+    uint32_t used;              /**< bytes currently allocated */
+    uint32_t max_used;          /**< high-water mark of netstats_pktbuf_t::used */
+} netstats_pktbuf_t;
+
+/**
+ * @brief       Statistics of neighbor discovery
+ *
+ * Available with module `netstats_ndp`.
+ */
+typedef struct {
+    uint32_t rx_rtr_sol;        /**< received router solicitations */
+    uint32_t rx_rtr_adv;        /**< received router advertisements */
+    uint32_t rx_nbr_sol;        /**< received neighbor solicitations */
+    uint32_t rx_nbr_adv;        /**< received neighbor advertisements */
+    uint32_t tx_rtr_sol;        /**< sent router solicitations */
+    uint32_t tx_rtr_adv;        /**< sent router advertisements */
+    uint32_t tx_nbr_sol;        /**< sent neighbor solicitations */
+    uint32_t tx_nbr_adv;        /**< sent neighbor advertisements */
+    uint32_t rtr_adv_coalesced; /**< router solicitations answered by an
+                                     already scheduled advertisement */
+    uint32_t nbr_sol_deferred;  /**< neighbor solicitations postponed by
+                                     @ref GNRC_NDP_NBR_SOL_RATE */
+} netstats_ndp_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_netstats_neighbor Per neighbor link statistics
+ * @ingroup     net_netstats
+ * @brief       Transmission statistics and ETX estimation per link-layer
+ *              neighbor
+ *
+ * The link layer records the destination of every unicast frame with
+ * netstats_nb_record() and reports the outcome of the transmission with
+ * netstats_nb_update_tx(). From these outcomes an expected transmission
+ * count (ETX) is estimated with an exponentially weighted moving average.
+ *
+ * An interface exposes its table via @ref NETOPT_STATS with
+ * @ref NETSTATS_NEIGHBOR as context.
+ * @{
+ *
+ * @file
+ * @brief   Per neighbor link statistics definitions
+ */
+#ifndef NETSTATS_NEIGHBOR_H
+#define NETSTATS_NEIGHBOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/netstats.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of neighbors tracked per interface
+ */
+#ifndef NETSTATS_NB_SIZE
+#define NETSTATS_NB_SIZE            (8U)
+#endif
+
+/**
+ * @brief   Maximum link-layer address length of a neighbor
+ */
+#ifndef NETSTATS_NB_L2ADDR_MAX
+#define NETSTATS_NB_L2ADDR_MAX      (8U)
+#endif
+
+/**
+ * @brief   Fixed-point divisor of netstats_nb_t::etx
+ */
+#define NETSTATS_NB_ETX_DIVISOR     (128U)
+
+/**
+ * @brief   ETX of a neighbor without any transmission yet
+ */
+#ifndef NETSTATS_NB_ETX_INIT
+#define NETSTATS_NB_ETX_INIT        (2U * NETSTATS_NB_ETX_DIVISOR)
+#endif
+
+/**
+ * @brief   ETX sample for a frame that was not acknowledged
+ */
+#ifndef NETSTATS_NB_ETX_NOACK
+#define NETSTATS_NB_ETX_NOACK       (6U * NETSTATS_NB_ETX_DIVISOR)
+#endif
+
+/**
+ * @brief   Weight of a new sample in the moving average as power of 2
+ *
+ * A new sample counts with 1 / 2^NETSTATS_NB_ETX_SHIFT.
+ */
+#ifndef NETSTATS_NB_ETX_SHIFT
+#define NETSTATS_NB_ETX_SHIFT       (3U)
+#endif
+
+/**
+ * @brief   Statistics of one neighbor
+ */
+typedef struct {
+    uint8_t l2_addr[NETSTATS_NB_L2ADDR_MAX];    /**< link-layer address */
+    uint8_t l2_addr_len;                        /**< length of netstats_nb_t::l2_addr,
+                                                 *   0 if unused */
+    uint16_t etx;                               /**< ETX, multiplied by
+                                                 *   @ref NETSTATS_NB_ETX_DIVISOR */
+    uint32_t tx_success;                        /**< acknowledged frames */
+    uint32_t tx_failed;                         /**< frames not acknowledged */
+} netstats_nb_t;
+
+/**
+ * @brief   Neighbor statistics of an interface
+ */
+typedef struct {
+    netstats_nb_t entries[NETSTATS_NB_SIZE];    /**< the neighbors */
+    netstats_nb_t *pending;                     /**< neighbor of the frame currently
+                                                 *   sent, NULL if none */
+    uint8_t next;                               /**< next entry to replace */
+} netstats_nb_table_t;
+
+/**
+ * @brief   Get the statistics of a neighbor
+ *
+ * @param[in] table         The neighbor statistics of an interface.
+ * @param[in] l2_addr       Link-layer address of the neighbor.
+ * @param[in] l2_addr_len   Length of @p l2_addr.
+ *
+ * @return  The statistics of the neighbor, NULL if it is not tracked.
+ */
+const netstats_nb_t *netstats_nb_get(const netstats_nb_table_t *table,
+                                     const uint8_t *l2_addr, uint8_t l2_addr_len);
+
+/**
+ * @brief   Records the destination of a frame about to be sent
+ *
+ * Neighbors not yet tracked replace the oldest one. Frames without a
+ * destination address (e.g. broadcast) are not recorded.
+ *
+ * @param[in] table         The neighbor statistics of an interface.
+ * @param[in] l2_addr       Link-layer destination address of the frame.
+ * @param[in] l2_addr_len   Length of @p l2_addr, 0 for broadcast.
+ */
+void netstats_nb_record(netstats_nb_table_t *table, const uint8_t *l2_addr,
+                        uint8_t l2_addr_len);
+
+/**
+ * @brief   Reports the outcome of the frame recorded last.
+ *
+ * @param[in] table         The neighbor statistics of an interface.
+ * @param[in] success       true, if the frame was acknowledged.
+ */
+void netstats_nb_update_tx(netstats_nb_table_t *table, bool success);
+
+/**
+ * @brief   Drops the frame recorded last without updating the statistics,
+ *          e.g. if it could not be sent because the medium was busy.
+ *
+ * @param[in] table         The neighbor statistics of an interface.
+ */
+static inline void netstats_nb_drop_tx(netstats_nb_table_t *table)
+{
+    table->pending = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETSTATS_NEIGHBOR_H */
+/** @} */
@@ -10,6 +10,16 @@
  * @defgroup    net_sntp Simple Network Time Protocol
  * @ingroup     net
  * @brief       Simple Network Time Protocol (SNTP) implementation
+ *
+ * Besides the offset of the real time to the system time, the client
+ * estimates the frequency error (drift) of the local clock from consecutive
+ * synchronizations. The time returned by @ref sntp_get_time() is corrected
+ * by this drift, so it stays accurate between synchronizations.
+ *
+ * @ref sntp_get_interval() recommends when to synchronize next: the
+ * interval is doubled each time the drift predicted the measured offset
+ * within @ref SNTP_ACCURACY and halved if the prediction was off by more
+ * than that, bounded by @ref SNTP_INTERVAL_MIN and @ref SNTP_INTERVAL_MAX.
  * @{
  *
  * @file
@@ -29,6 +39,37 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Shortest synchronization interval in seconds
+ */
+#ifndef SNTP_INTERVAL_MIN
+#define SNTP_INTERVAL_MIN   (64U)
+#endif
+
+/**
+ * @brief   Longest synchronization interval in seconds
+ */
+#ifndef SNTP_INTERVAL_MAX
+#define SNTP_INTERVAL_MAX   (16384U)
+#endif
+
+/**
+ * @brief   Accuracy in microseconds the drift estimate must keep to
+ *          lengthen the synchronization interval
+ */
+#ifndef SNTP_ACCURACY
+#define SNTP_ACCURACY       (10000U)
+#endif
+
+/**
+ * @brief   Largest drift in parts per billion that is considered plausible
+ *
+ * Samples indicating a larger drift are discarded.
+ */
+#ifndef SNTP_DRIFT_MAX
+#define SNTP_DRIFT_MAX      (500000L)
+#endif
+
 /**
  * @brief Synchronize with time server
  *
@@ -43,10 +84,33 @@ int sntp_sync(sock_udp_ep_t *server, uint32_t timeout);
 /**
  * @brief Get real time offset from system time as returned by @ref xtimer_now64()
  *
+ * The offset is corrected by the estimated drift for the current time.
+ *
  * @return Real time offset in microseconds relative to 1900-01-01 00:00 UTC
  */
 int64_t sntp_get_offset(void);
 
+/**
+ * @brief Get the drift corrected real time
+ *
+ * @return Microseconds since 1900-01-01 00:00 UTC
+ */
+uint64_t sntp_get_time(void);
+
+/**
+ * @brief Get the estimated drift of the system clock
+ *
+ * @return Drift in parts per billion, positive if the system clock is slow
+ */
+int32_t sntp_get_drift(void);
+
+/**
+ * @brief Get the recommended time until the next synchronization
+ *
+ * @return Interval in seconds
+ */
+uint32_t sntp_get_interval(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -289,6 +289,19 @@ typedef struct _sock_tl_ep sock_udp_ep_t;   /**< An end point for a UDP sock obj
  */
 typedef struct sock_udp sock_udp_t;
 
+/**
+ * @brief   A datagram of a batch for sock_udp_send_batch() and
+ *          sock_udp_recv_batch()
+ */
+typedef struct {
+    void *data;             /**< payload of the datagram or buffer for it */
+    size_t len;             /**< length of sock_udp_msg_t::data */
+    size_t recv_len;        /**< length of the received datagram */
+    sock_udp_ep_t *remote;  /**< remote end point of the datagram, may be
+                             *   `NULL` (see sock_udp_send() and
+                             *   sock_udp_recv()) */
+} sock_udp_msg_t;
+
 /**
  * @brief   Creates a new UDP sock object
  *
@@ -399,6 +412,52 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote);
 
+/**
+ * @brief   Receives a UDP message from a remote end point without copying it
+ *
+ * The message stays in the stack's buffer and @p data points to it. Call
+ * the function again with the same @p buf_ctx when done with the message:
+ * that call releases the buffer and returns 0. Typically used in a loop:
+ *
+ * ~~~~~~~~~~~~~~~~~~~ {.c}
+ * void *data, *ctx = NULL;
+ * ssize_t res;
+ *
+ * while ((res = sock_udp_recv_buf(&sock, &data, &ctx, SOCK_NO_TIMEOUT,
+ *                                 NULL)) > 0) {
+ *     forward(data, res);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[out] data     Pointer to the received data, valid until the next
+ *                      call with @p buf_ctx. NULL after the release.
+ * @param[in,out] buf_ctx   Buffer context of the stack. Must point to NULL
+ *                      before receiving. Is NULL again after the release.
+ * @param[in] timeout   Timeout for receive in microseconds.
+ *                      If 0 and no data is available, the function returns
+ *                      immediately.
+ *                      May be @ref SOCK_NO_TIMEOUT for no timeout (wait until
+ *                      data is available).
+ * @param[out] remote   Remote end point of the received data.
+ *                      May be `NULL`, if it is not required by the application.
+ *
+ * @note    Function blocks if no packet is currently waiting.
+ *
+ * @return  The number of bytes received on success.
+ * @return  0, if the buffer of the previous message was released.
+ * @return  -EADDRNOTAVAIL, if local of @p sock is not given.
+ * @return  -EAGAIN, if @p timeout is `0` and no data is available.
+ * @return  -ENOMEM, if no memory was available to receive @p data.
+ * @return  -EPROTO, if source address of received packet did not equal
+ *          the remote of @p sock.
+ * @return  -ETIMEDOUT, if @p timeout expired.
+ */
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote);
+
 /**
  * @brief   Sends a UDP message to remote end point
  *
@@ -433,6 +492,51 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+/**
+ * @brief   Receives a batch of UDP messages
+ *
+ * Waits at most @p timeout for the first message like sock_udp_recv(), then
+ * takes the messages already queued on @p sock without waiting. Messages
+ * from a remote other than the remote end point of @p sock are dropped.
+ *
+ * @pre `(sock != NULL) && (msgs != NULL) && (count > 0)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in,out] msgs  The messages. sock_udp_msg_t::data and
+ *                      sock_udp_msg_t::len give the buffer for each message,
+ *                      sock_udp_msg_t::recv_len and sock_udp_msg_t::remote
+ *                      (if not `NULL`) are set on reception.
+ * @param[in] count     Number of elements in @p msgs.
+ * @param[in] timeout   Timeout for the first message in microseconds, see
+ *                      sock_udp_recv().
+ *
+ * @return  The number of messages received on success.
+ * @return  The errors of sock_udp_recv(), if no message was received.
+ */
+ssize_t sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                            unsigned count, uint32_t timeout);
+
+/**
+ * @brief   Sends a batch of UDP messages
+ *
+ * Consecutive messages with the same sock_udp_msg_t::remote pointer share
+ * the checks of the end points, so a message only costs its packet buffer
+ * space and the dispatch to the stack. When @p sock is `NULL` they are also
+ * sent from the same local port.
+ *
+ * @pre `((sock != NULL) || (remote of each msg != NULL)) && (msgs != NULL)`
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`, see sock_udp_send().
+ * @param[in] msgs      The messages. sock_udp_msg_t::recv_len is ignored.
+ * @param[in] count     Number of elements in @p msgs.
+ *
+ * @return  The number of messages sent on success. Less than @p count, if a
+ *          later message failed.
+ * @return  The errors of sock_udp_send(), if the first message failed.
+ */
+ssize_t sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                            unsigned count);
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_tcp TCP
+ * @ingroup     net
+ * @brief       Provides TCP header and helper definitions
+ * @see         <a href="https://tools.ietf.org/html/rfc793">
+ *                  RFC 793
+ *              </a>
+ * @{
+ *
+ * @file
+ * @brief   TCP header and helper definitions
+ */
+#ifndef TCP_H_
+#define TCP_H_
+
+#include <stddef.h>
+
+#include "byteorder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    TCP control bits
+ * @{
+ */
+#define TCP_CTL_FIN             (0x01)  /**< no more data from sender */
+#define TCP_CTL_SYN             (0x02)  /**< synchronize sequence numbers */
+#define TCP_CTL_RST             (0x04)  /**< reset the connection */
+#define TCP_CTL_PSH             (0x08)  /**< push function */
+#define TCP_CTL_ACK             (0x10)  /**< acknowledgment field significant */
+#define TCP_CTL_URG             (0x20)  /**< urgent pointer field significant */
+#define TCP_CTL_MASK            (0x3f)  /**< mask of all control bits */
+/** @} */
+
+/**
+ * @name    TCP options
+ * @{
+ */
+#define TCP_OPTION_KIND_EOL     (0)     /**< end of option list */
+#define TCP_OPTION_KIND_NOP     (1)     /**< no operation */
+#define TCP_OPTION_KIND_MSS     (2)     /**< maximum segment size */
+#define TCP_OPTION_LENGTH_MSS   (4)     /**< length of the MSS option */
+/** @} */
+
+/**
+ * @brief   Minimum length of the TCP header in 32-bit words
+ */
+#define TCP_HDR_OFFSET_MIN      (5)
+
+/**
+ * @brief   MSS to assume if a peer does not send the MSS option
+ */
+#define TCP_DEFAULT_MSS         (536)
+
+/**
+ * @brief   TCP header
+ */
+typedef struct __attribute__((packed)) {
+    network_uint16_t src_port;      /**< source port */
+    network_uint16_t dst_port;      /**< destination port */
+    network_uint32_t seq_num;       /**< sequence number */
+    network_uint32_t ack_num;       /**< acknowledgment number */
+    network_uint16_t off_ctl;       /**< data offset, reserved bits and
+                                     *   control bits */
+    network_uint16_t window;        /**< receive window */
+    network_uint16_t checksum;      /**< checksum */
+    network_uint16_t urgent_ptr;    /**< urgent pointer */
+} tcp_hdr_t;
+
+/**
+ * @brief   Gets the header length in bytes from a TCP header
+ *
+ * @param[in] hdr   A TCP header.
+ *
+ * @return  The length of @p hdr including options.
+ */
+static inline size_t tcp_hdr_get_len(const tcp_hdr_t *hdr)
+{
+    return (byteorder_ntohs(hdr->off_ctl) >> 12) * 4;
+}
+
+/**
+ * @brief   Gets the control bits from a TCP header
+ *
+ * @param[in] hdr   A TCP header.
+ *
+ * @return  The control bits of @p hdr.
+ */
+static inline uint8_t tcp_hdr_get_ctl(const tcp_hdr_t *hdr)
+{
+    return byteorder_ntohs(hdr->off_ctl) & TCP_CTL_MASK;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TCP_H_ */
+/** @} */
@@ -10,6 +10,11 @@
  * @defgroup    net_uhcp UHCP
  * @ingroup     net
  * @brief       Provides UHCP (micro host configuration protocol)
+ *
+ * A push carries the lifetime of the assigned prefix and a lease identifier
+ * that the server changes whenever the assignment changes. Clients request
+ * the prefix again after half of its lifetime and can skip reconfiguration
+ * if the lease did not change.
  * @{
  *
  * @file
@@ -33,7 +38,7 @@ extern "C" {
 #define UHCP_MAGIC  (0x55484350) /* "UHCP" in hex */
 
 /** @brief UHCP version of this header */
-#define UHCP_VER    (0)
+#define UHCP_VER    (1)
 
 /** @brief UHCP port number */
 #define UHCP_PORT       (12345U)
@@ -41,6 +46,17 @@ extern "C" {
 /** @brief UHCP port number (as string for e.g., getaddrinfo() service arg */
 #define UHCP_PORT_STR   "12345"
 
+/** @brief Lifetime in seconds the server assigns prefixes with */
+#ifndef UHCP_LIFETIME
+#define UHCP_LIFETIME   (600U)
+#endif
+
+/** @brief Time in seconds the client waits before requesting again if it
+ *         got no reply */
+#ifndef UHCP_RETRY
+#define UHCP_RETRY      (10U)
+#endif
+
 /** @brief Enum containing possible UHCP packet types */
 typedef enum {
     UHCP_REQ,               /**< packet is a request packet */
@@ -73,6 +89,10 @@ typedef struct __attribute__((packed)) {
  */
 typedef struct __attribute__((packed)) {
     uhcp_hdr_t hdr;         /**< member holding parent type */
+    uint32_t lease;         /**< lease identifier in network byte order,
+                                 changes with the assignment */
+    uint16_t lifetime;      /**< lifetime of the assigned prefix in seconds
+                                 in network byte order */
     uint8_t prefix_len;     /**< contains the prefix length of assigned
                                  prefix */
     uint8_t prefix[];       /**< contains the assigned prefix */
@@ -92,8 +112,11 @@ typedef unsigned uhcp_iface_t;
  * @param[in]   src     ptr to IPv6 source address
  * @param[in]   port    source port of packet
  * @param[in]   iface   interface number of incoming packet
+ *
+ * @return  0 if the packet was handled
+ * @return  -1 if the packet was invalid or unexpected
  */
-void uhcp_handle_udp(uint8_t *buf, size_t len, uint8_t *src, uint16_t port, uhcp_iface_t iface);
+int uhcp_handle_udp(uint8_t *buf, size_t len, uint8_t *src, uint16_t port, uhcp_iface_t iface);
 
 /**
  * @brief handle incoming UHCP request packet
@@ -131,18 +154,24 @@ void uhcp_handle_push(uhcp_push_t *req, uint8_t *src, uint16_t port, uhcp_iface_
  * Supposed to be implemented by UHCP client implementations.
  *
  * The function might be called with an already configured prefix. In that
- * case, the lifetime *MUST* be updated.
+ * case, the lifetime *MUST* be updated. If @p lease is the same as before,
+ * the assignment did not change and nothing but the lifetime needs to be
+ * updated.
  *
  * If the function is called with a different prefix than before, the old
- * prefix *MUST* be considered obsolete.
+ * prefix *MUST* be considered obsolete. A @p lifetime of 0 withdraws the
+ * prefix, the client calls the function with it if a lease expired without
+ * being renewed.
  *
  * @param[in]   prefix      ptr to assigned prefix
  * @param[in]   prefix_len  length of assigned prefix
- * @param[in]   lifetime    lifetime of prefix
+ * @param[in]   lifetime    lifetime of prefix in seconds
+ * @param[in]   lease       lease identifier of the assignment
  * @param[in]   src         ptr to IPv6 source address
  * @param[in]   iface       number of interface the packet came in
  */
-void uhcp_handle_prefix(uint8_t *prefix, uint8_t prefix_len, uint16_t lifetime, uint8_t *src, uhcp_iface_t iface);
+void uhcp_handle_prefix(uint8_t *prefix, uint8_t prefix_len, uint16_t lifetime,
+                        uint32_t lease, uint8_t *src, uhcp_iface_t iface);
 
 /**
  * @brief function to set constant values in UHCP header
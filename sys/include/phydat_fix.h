@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_phydat_fix Fixed-point phydat math
+ * @ingroup     sys_phydat
+ * @brief       Unit conversion, scaling and statistics of phydat values in
+ *              Q16.16
+ *
+ * The values of a @ref phydat_t are taken into libfixmath's Q16.16 format
+ * relative to a reference scale chosen by the caller, e.g. the scale the
+ * sensor reports in. All math is done in integers, so processing sensor
+ * data on Cortex-M0 and M3 does not pull in soft-float.
+ *
+ * Results are written back with the finest scale that holds all values in
+ * 16 bit.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Fixed-point phydat math definitions
+ */
+
+#ifndef PHYDAT_FIX_H
+#define PHYDAT_FIX_H
+
+#include <stdint.h>
+
+#include "fix16.h"
+#include "phydat.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Statistics over a stream of phydat values
+ */
+typedef struct {
+    int64_t sum[PHYDAT_DIM];    /**< sum of the values */
+    fix16_t min[PHYDAT_DIM];    /**< minimum of the values */
+    fix16_t max[PHYDAT_DIM];    /**< maximum of the values */
+    uint32_t count;             /**< number of values added */
+    uint8_t unit;               /**< unit of the values */
+    int8_t scale;               /**< reference scale of sum, min and max */
+    uint8_t dim;                /**< number of dimensions in use */
+} phydat_fix_stats_t;
+
+/**
+ * @brief   Get a value of a phydat in Q16.16
+ *
+ * Saturates to fix16_minimum and fix16_maximum, values below the resolution
+ * of Q16.16 become 0.
+ *
+ * @param[in] data      the data
+ * @param[in] idx       index of the value
+ * @param[in] scale     scale of the result, 10^*scale*
+ *
+ * @return  the value in units of 10^*scale*
+ */
+fix16_t phydat_fix_get(const phydat_t *data, uint8_t idx, int8_t scale);
+
+/**
+ * @brief   Set the values of a phydat from Q16.16
+ *
+ * Picks the finest scale all values fit in and leaves the unit untouched.
+ *
+ * @param[out] data     the data
+ * @param[in] values    @p dim values in units of 10^*scale*
+ * @param[in] dim       number of values
+ * @param[in] scale     scale of @p values, 10^*scale*
+ */
+void phydat_fix_set(phydat_t *data, const fix16_t *values, uint8_t dim,
+                    int8_t scale);
+
+/**
+ * @brief   Applies `value * factor + offset` to the values of a phydat
+ *
+ * Saturates on overflow.
+ *
+ * @param[in,out] data  the data
+ * @param[in] dim       number of values
+ * @param[in] factor    the factor
+ * @param[in] offset    the offset in units of 10^*data->scale*
+ */
+void phydat_fix_scale(phydat_t *data, uint8_t dim, fix16_t factor,
+                      fix16_t offset);
+
+/**
+ * @brief   Converts the values of a phydat to another unit
+ *
+ * Supported are conversions among @ref UNIT_TEMP_C, @ref UNIT_TEMP_F and
+ * @ref UNIT_TEMP_K, between @ref UNIT_BAR and @ref UNIT_PA, and among
+ * @ref UNIT_PERCENT, @ref UNIT_PERMILL and @ref UNIT_PPM. The latter two
+ * only change the scale and are exact.
+ *
+ * @param[in,out] data  the data
+ * @param[in] dim       number of values
+ * @param[in] unit      the target unit
+ *
+ * @return  0 on success
+ * @return  -ENOTSUP if the units can not be converted
+ * @return  -ERANGE if the scale overflows
+ */
+int phydat_fix_convert(phydat_t *data, uint8_t dim, uint8_t unit);
+
+/**
+ * @brief   Initializes statistics over a stream of phydat values
+ *
+ * @param[out] stats    the statistics
+ * @param[in] unit      unit of the values
+ * @param[in] dim       number of dimensions to track
+ * @param[in] scale     reference scale, the values must fit Q16.16 in it
+ */
+void phydat_fix_stats_init(phydat_fix_stats_t *stats, uint8_t unit,
+                           uint8_t dim, int8_t scale);
+
+/**
+ * @brief   Adds a value to statistics
+ *
+ * @param[in,out] stats the statistics
+ * @param[in] data      the value
+ *
+ * @return  0 on success
+ * @return  -EINVAL if the unit of @p data differs
+ */
+int phydat_fix_stats_add(phydat_fix_stats_t *stats, const phydat_t *data);
+
+/**
+ * @brief   Get the average of the values added to statistics
+ *
+ * @param[in] stats     the statistics
+ * @param[out] data     the average, 0 without values
+ */
+void phydat_fix_stats_avg(const phydat_fix_stats_t *stats, phydat_t *data);
+
+/**
+ * @brief   Get the minimum of the values added to statistics
+ *
+ * @param[in] stats     the statistics
+ * @param[out] data     the minimum
+ */
+void phydat_fix_stats_min(const phydat_fix_stats_t *stats, phydat_t *data);
+
+/**
+ * @brief   Get the maximum of the values added to statistics
+ *
+ * @param[in] stats     the statistics
+ * @param[out] data     the maximum
+ */
+void phydat_fix_stats_max(const phydat_fix_stats_t *stats, phydat_t *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PHYDAT_FIX_H */
+/** @} */
@@ -60,6 +60,8 @@ typedef struct riot_pipe {
                                          empty pipe. */
     void (*free)(void *);           /**< Function to call by pipe_free(). Used like
                                          `pipe->free(pipe)`. */
+    unsigned watermark;             /**< Bytes needed to wake a blocked
+                                         reader. */
     } pipe_t;
 
 /**
@@ -71,6 +73,30 @@ typedef struct riot_pipe {
  */
 void pipe_init(pipe_t *pipe, ringbuffer_t *rb, void (*free)(void *));
 
+/**
+ * @brief        Set the number of buffered bytes that wakes a blocked reader.
+ * @details      pipe_init() sets the watermark to 1, i.e. every write wakes
+ *               the reader. With a higher watermark, a blocked reader sleeps
+ *               until @p watermark bytes are buffered, the pipe is full or
+ *               pipe_flush() is called, so many small writes cost a single
+ *               context switch. Reads still return everything that is
+ *               available.
+ * @param[in]    pipe        Pipe to configure.
+ * @param        watermark   Number of bytes, 1 to wake on every write.
+ */
+static inline void pipe_set_watermark(pipe_t *pipe, unsigned watermark)
+{
+    pipe->watermark = watermark;
+}
+
+/**
+ * @brief        Wake a reader waiting for the watermark.
+ * @details      For writers that know a burst is complete.
+ *               Can be called in an ISR.
+ * @param[in]    pipe   Pipe to flush.
+ */
+void pipe_flush(pipe_t *pipe);
+
 /**
  * @brief        Read from a pipe.
  * @details      Only one thread may access the pipe readingly at once.
@@ -24,6 +24,35 @@
  *
  * In order to use this module, you'll need to implement pm_set().
  *
+ * Tickless idle
+ * -------------
+ *
+ * With the (pseudo) module `pm_layered_tickless`, @ref pm_set_lowest() also
+ * takes the time until the next xtimer event into account. CPUs can define
+ * `PM_MODE_MIN_SLEEP_US` in their periph_cpu.h as an initializer list holding,
+ * for each mode, the minimum time to the next wake-up that makes entering the
+ * mode worthwhile (wake-up latency plus energy break-even time). A mode is
+ * only entered if the next xtimer event is further away than its minimum
+ * sleep time, otherwise the next shallower mode is tried. Statistics on the
+ * idle decisions can be read with @ref pm_tickless_get_stats(). They count
+ * decisions, not wake-ups: no wake-up is removed by this module.
+ *
+ * This only selects the sleep mode, the idle is not fully tickless: xtimer
+ * keeps its period tick armed while no timer is pending, as it needs the tick
+ * to extend the low-level timer to 32/64 bit. With a 32 bit low-level timer
+ * the tick fires once per 2^32 ticks, with narrower timers (`XTIMER_MASK`)
+ * once per timer period, which limits the deepest sleep accordingly.
+ *
+ * Residency accounting
+ * --------------------
+ *
+ * With the (pseudo) module `pm_layered_residency`, @ref pm_set_lowest()
+ * timestamps entering and leaving each mode with the RTT and sums up the
+ * time spent in it, see @ref pm_residency_get(). Code that keeps the MCU out
+ * of deeper modes can use a named @ref pm_wakelock_t instead of
+ * @ref pm_block(), so the time each holder blocked the modes is recorded
+ * as well. The shell command `pm` prints both.
+ *
  * @file
  * @brief       Layered low power mode infrastructure
  *
@@ -33,6 +62,8 @@
 #ifndef PM_LAYERED_H_
 #define PM_LAYERED_H_
 
+#include <stdint.h>
+
 #include "assert.h"
 #include "periph/pm.h"
 #include "periph_cpu.h"
@@ -67,6 +98,108 @@ void pm_unblock(unsigned mode);
  */
 void pm_set(unsigned mode);
 
+#if defined(MODULE_PM_LAYERED_TICKLESS) || defined(DOXYGEN)
+/**
+ * @brief   Statistics of the tickless idle mode selection
+ */
+typedef struct {
+    uint32_t sleeps;            /**< number of calls to pm_set_lowest() */
+    uint32_t tick_candidates;   /**< sleeps with only the xtimer period tick
+                                     pending, i.e., without any timer due.
+                                     The tick still fires, these are only
+                                     candidates for a tickless idle */
+    uint32_t blocked;           /**< sleeps with all modes blocked, no mode
+                                     had to be selected */
+    uint32_t deep;              /**< sleeps where the deepest unblocked mode
+                                     was entered */
+    uint32_t shallow;           /**< sleeps where a shallower mode was chosen,
+                                     because the next event was too close */
+} pm_tickless_stats_t;
+
+/**
+ * @brief   Get the statistics of the tickless idle mode selection
+ *
+ * @return  pointer to the statistics, never NULL
+ */
+const pm_tickless_stats_t *pm_tickless_get_stats(void);
+#endif
+
+#if defined(MODULE_PM_LAYERED_RESIDENCY) || defined(DOXYGEN)
+/**
+ * @brief   Time spent in a power mode
+ */
+typedef struct {
+    uint64_t ticks;         /**< RTT ticks spent in the mode */
+    uint32_t entries;       /**< number of times the mode was entered */
+} pm_residency_t;
+
+/**
+ * @brief   Named blocker of a power mode
+ *
+ * Initialize with @ref PM_WAKELOCK_INIT. A wakelock is listed by
+ * @ref pm_wakelock_next() once it was acquired for the first time.
+ */
+typedef struct pm_wakelock {
+    struct pm_wakelock *next;   /**< next wakelock in the list */
+    const char *name;           /**< name of the holder */
+    uint8_t mode;               /**< mode blocked while held */
+    uint8_t held;               /**< 1 if currently held */
+    uint32_t since;             /**< RTT counter when last acquired */
+    uint32_t count;             /**< number of times acquired */
+    uint64_t ticks;             /**< RTT ticks held in total */
+} pm_wakelock_t;
+
+/**
+ * @brief   Static initializer for @ref pm_wakelock_t
+ *
+ * @param[in] n     name of the holder
+ * @param[in] m     mode to block while held
+ */
+#define PM_WAKELOCK_INIT(n, m)  { .name = (n), .mode = (m) }
+
+/**
+ * @brief   Initializes the residency accounting
+ *
+ * Called by auto_init. Starts the RTT, unless `xtimer_lp` already does.
+ */
+void pm_residency_init(void);
+
+/**
+ * @brief   Get the time spent in a power mode
+ *
+ * The time spent awake is not included. Sleeps longer than one RTT period
+ * are accounted modulo the RTT period.
+ *
+ * @param[in] mode  power mode, PM_NUM_MODES for the idle mode
+ *
+ * @return  pointer to the residency of @p mode, never NULL
+ */
+const pm_residency_t *pm_residency_get(unsigned mode);
+
+/**
+ * @brief   Acquire a wakelock, blocking its mode
+ *
+ * @param[in] lock  wakelock, must not be held
+ */
+void pm_wakelock_acquire(pm_wakelock_t *lock);
+
+/**
+ * @brief   Release a wakelock, unblocking its mode
+ *
+ * @param[in] lock  wakelock, must be held
+ */
+void pm_wakelock_release(pm_wakelock_t *lock);
+
+/**
+ * @brief   Iterate over all wakelocks acquired so far
+ *
+ * @param[in] prev  previous wakelock, NULL to get the first one
+ *
+ * @return  the next wakelock, NULL after the last one
+ */
+pm_wakelock_t *pm_wakelock_next(pm_wakelock_t *prev);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
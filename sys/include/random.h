@@ -17,16 +17,25 @@
  * @brief       Common interface to the software PRNG
  *
  * Various implementations of a PRNG are available:
- *  - Tiny Mersenne Twister (default)
+ *  - xoroshiro128+ (default, module prng_xoroshiro128plus)
+ *  - Tiny Mersenne Twister
  *  - Mersenne Twister
  *  - Simple Park-Miller PRNG
  *  - Musl C PRNG
+ *
+ * Only the xoroshiro128+ implementation may be used from several threads at
+ * once. Threads drawing numbers on a hot path can keep their own
+ * random_state_t instead, which needs no locking at all.
+ *
+ * With the module random_seed_hwrng the PRNG is seeded from the hardware
+ * random number generator during auto_init.
  */
 
 #ifndef RANDOM_H
 #define RANDOM_H
 
 #include <inttypes.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -75,6 +84,76 @@ static inline uint32_t random_uint32_range(uint32_t a, uint32_t b)
     return (random_uint32() % (b - a)) + a;
 }
 
+/**
+ * @brief   fills a buffer with random bytes
+ *
+ * @param[out] buf  buffer to fill
+ * @param[in]  size number of bytes to write to @p buf
+ */
+void random_bytes(uint8_t *buf, size_t size);
+
+/**
+ * @brief   seeds the PRNG from the hardware random number generator
+ *
+ * Only available with the module random_seed_hwrng, which calls it during
+ * auto_init. Call it again to reseed.
+ */
+void random_seed_hwrng(void);
+
+/**
+ * @brief   state of an independent xoroshiro128+ generator
+ *
+ * Must not be all zero, initialize it with random_state_init().
+ */
+typedef struct {
+    uint64_t s[2];      /**< generator state */
+} random_state_t;
+
+/**
+ * @brief   initializes an independent generator
+ *
+ * The state is expanded from @p seed by SplitMix64, so similar seeds (e.g.
+ * thread IDs) still yield unrelated sequences.
+ *
+ * @param[out] state    state to initialize
+ * @param[in]  seed     any value
+ */
+void random_state_init(random_state_t *state, uint64_t seed);
+
+/**
+ * @brief   generates a random number on [0,0xffffffffffffffff]-interval
+ *          from an independent generator
+ *
+ * @param[in,out] state generator state
+ *
+ * @return  a random number on [0,0xffffffffffffffff]-interval
+ */
+static inline uint64_t random_state_uint64(random_state_t *state)
+{
+    uint64_t s0 = state->s[0];
+    uint64_t s1 = state->s[1];
+    uint64_t res = s0 + s1;
+
+    s1 ^= s0;
+    state->s[0] = ((s0 << 24) | (s0 >> 40)) ^ s1 ^ (s1 << 16);
+    state->s[1] = (s1 << 37) | (s1 >> 27);
+    return res;
+}
+
+/**
+ * @brief   generates a random number on [0,0xffffffff]-interval from an
+ *          independent generator
+ *
+ * @param[in,out] state generator state
+ *
+ * @return  a random number on [0,0xffffffff]-interval
+ */
+static inline uint32_t random_state_uint32(random_state_t *state)
+{
+    /* the lowest bits of xoroshiro128+ are the weakest */
+    return (uint32_t)(random_state_uint64(state) >> 32);
+}
+
 #if PRNG_FLOAT
 /* These real versions are due to Isaku Wada, 2002/01/09 added */
 
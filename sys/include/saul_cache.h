@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_saul_cache SAUL sampling cache
+ * @ingroup     sys_saul_reg
+ * @brief       Periodically samples all SAUL devices and serves the values
+ *              from RAM
+ *
+ * A thread reads every device in the SAUL registry once per
+ * @ref SAUL_CACHE_INTERVAL in one pass. saul_cache_read() returns the last
+ * value of a device with the time it was read, without touching the device
+ * or its bus, so any number of consumers can poll cheaply.
+ *
+ * Consumers that want to know about changes subscribe with
+ * saul_cache_subscribe(). The callback runs in the sampling thread whenever a
+ * read returned a different value than the one before.
+ *
+ * Only the first @ref SAUL_CACHE_NUMOF devices of the registry are sampled.
+ *
+ * @{
+ *
+ * @file
+ * @brief       SAUL sampling cache interface definition
+ */
+
+#ifndef SAUL_CACHE_H
+#define SAUL_CACHE_H
+
+#include <stdint.h>
+
+#include "phydat.h"
+#include "saul_reg.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of sampled devices
+ */
+#ifndef SAUL_CACHE_NUMOF
+#define SAUL_CACHE_NUMOF        (16U)
+#endif
+
+/**
+ * @brief   Sampling interval in microseconds
+ */
+#ifndef SAUL_CACHE_INTERVAL
+#define SAUL_CACHE_INTERVAL     (1U * SEC_IN_USEC)
+#endif
+
+/**
+ * @brief   Callback for changed values
+ *
+ * Called in the sampling thread while the cache is locked, so it must not
+ * call any saul_cache function.
+ *
+ * @param[in] dev       device the value was read from
+ * @param[in] data      the new value
+ * @param[in] dim       number of dimensions in @p data
+ * @param[in] arg       argument given on subscription
+ */
+typedef void (*saul_cache_cb_t)(saul_reg_t *dev, const phydat_t *data,
+                                int dim, void *arg);
+
+/**
+ * @brief   Subscription to value changes
+ */
+typedef struct saul_cache_sub {
+    struct saul_cache_sub *next;    /**< next subscription */
+    saul_reg_t *dev;                /**< device to watch, NULL for all */
+    saul_cache_cb_t cb;             /**< called on changes */
+    void *arg;                      /**< argument for saul_cache_sub_t::cb */
+} saul_cache_sub_t;
+
+/**
+ * @brief   Start the sampling thread
+ *
+ * Called by auto_init, after the SAUL devices were registered.
+ */
+void saul_cache_init(void);
+
+/**
+ * @brief   Read all devices now
+ *
+ * Runs in the caller's context, e.g. to refresh the values right before
+ * serving them. Passes are serialized.
+ */
+void saul_cache_update(void);
+
+/**
+ * @brief   Get the last value read from a device
+ *
+ * @param[in] dev       device to get the value of
+ * @param[out] res      the value
+ * @param[out] time     time the value was read in microseconds
+ *                      (xtimer_now_usec()), may be NULL
+ *
+ * @return  the number of dimensions in @p res [1-3]
+ * @return  -ENODEV if @p dev is not sampled
+ * @return  -EAGAIN if @p dev was not read yet
+ * @return  the error of the last saul_reg_read() of @p dev
+ */
+int saul_cache_read(saul_reg_t *dev, phydat_t *res, uint32_t *time);
+
+/**
+ * @brief   Subscribe to value changes
+ *
+ * @param[in] sub       pre-populated subscription, must stay valid until
+ *                      unsubscribed
+ */
+void saul_cache_subscribe(saul_cache_sub_t *sub);
+
+/**
+ * @brief   Cancel a subscription
+ *
+ * @param[in] sub       subscription given to saul_cache_subscribe()
+ */
+void saul_cache_unsubscribe(saul_cache_sub_t *sub);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SAUL_CACHE_H */
+/** @} */
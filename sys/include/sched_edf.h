@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_edf Earliest deadline first scheduling
+ * @ingroup     sys
+ * @brief       Deadline-driven scheduling class for periodic threads
+ *
+ * Threads that call sched_edf_enter() move to the priority level
+ * @ref SCHED_EDF_PRIO and are scheduled among each other by their absolute
+ * deadline: whenever the scheduler picks from that level, the runnable thread
+ * with the earliest deadline runs, and a thread released with an earlier
+ * deadline than the running one preempts it. Threads of a higher priority,
+ * e.g. the network stack, still preempt all of them, and the best-effort
+ * threads of lower priority only run when no deadline thread is runnable.
+ *
+ * A deadline thread runs one job per period:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * static sched_edf_t edf;
+ *
+ * sched_edf_enter(&edf, 10000, 8000);
+ * while (1) {
+ *     control_loop_step();
+ *     sched_edf_wait_period();
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Releases are timed by xtimer_periodic_wakeup(), so periods do not drift.
+ * A job that completes after its deadline is counted as a miss; the counters
+ * are shown by `ps`. As with any EDF scheduler, all deadlines are met if the
+ * total utilization of the deadline threads stays below 1 minus the share of
+ * the higher priority threads.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Earliest deadline first scheduling interface
+ */
+
+#ifndef SCHED_EDF_H
+#define SCHED_EDF_H
+
+#include <stdint.h>
+
+#include "clist.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Priority level of the deadline threads
+ *
+ * Threads with a higher priority (a lower value) are not affected by
+ * deadlines, threads with a lower priority form the best-effort band.
+ */
+#ifndef SCHED_EDF_PRIO
+#define SCHED_EDF_PRIO      (THREAD_PRIORITY_MAIN - 2)
+#endif
+
+/**
+ * @brief   Deadline state of a thread
+ */
+typedef struct sched_edf {
+    xtimer_ticks32_t release;   /**< start of the current period */
+    uint32_t period;            /**< period in microseconds */
+    uint32_t rel_deadline;      /**< deadline relative to the release in
+                                     xtimer ticks */
+    uint32_t deadline;          /**< absolute deadline in xtimer ticks */
+    uint32_t jobs;              /**< completed jobs */
+    uint32_t misses;            /**< jobs completed after their deadline */
+    uint8_t priority;           /**< priority before sched_edf_enter() */
+} sched_edf_t;
+
+/**
+ * @brief   Makes the calling thread a deadline thread
+ *
+ * The first period starts now.
+ *
+ * @param[out] edf      deadline state, must stay valid until
+ *                      sched_edf_leave() or the end of the thread
+ * @param[in] period    period in microseconds
+ * @param[in] deadline  deadline of each job in microseconds after its
+ *                      release, usually at most @p period
+ */
+void sched_edf_enter(sched_edf_t *edf, uint32_t period, uint32_t deadline);
+
+/**
+ * @brief   Completes the current job and sleeps until the next release
+ *
+ * @pre     The calling thread is a deadline thread.
+ */
+void sched_edf_wait_period(void);
+
+/**
+ * @brief   Makes the calling thread a best-effort thread again
+ *
+ * Restores the priority the thread had before sched_edf_enter().
+ */
+void sched_edf_leave(void);
+
+/**
+ * @brief   Sorts the thread with the earliest deadline to the head of the
+ *          run queue @p rq
+ *
+ * Called by the scheduler from @ref sched_run() with interrupts disabled
+ * when it picks a thread of @ref SCHED_EDF_PRIO.
+ *
+ * @param[in,out] rq    run queue of @ref SCHED_EDF_PRIO
+ */
+void sched_edf_update(clist_node_t *rq);
+
+/**
+ * @brief   Checks if a runnable thread has an earlier deadline than the
+ *          active one
+ *
+ * Called by the scheduler from @ref sched_switch() when a thread of
+ * @ref SCHED_EDF_PRIO became runnable while another one is active.
+ *
+ * @return  1 if the active thread has to be preempted
+ * @return  0 otherwise
+ */
+int sched_edf_preempt(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_EDF_H */
+/** @} */
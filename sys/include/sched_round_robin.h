@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_round_robin Round-robin time slicing
+ * @ingroup     sys
+ * @brief       Preemptive time slicing among threads of equal priority
+ *
+ * Without this module, a thread that never blocks or yields starves all
+ * other threads of its priority. With it, the scheduler arms an xtimer
+ * whenever the thread it selects shares its runqueue with other runnable
+ * threads. When the time slice of @ref SCHED_ROUND_ROBIN_TIMESLICE_US
+ * expires, the runqueue is rotated, just as if the running thread had called
+ * @ref thread_yield().
+ *
+ * Threads alone on their priority level are not affected: the timer is
+ * neither armed nor touched for them, so the per context switch overhead for
+ * them is a single comparison.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Round-robin time slicing interface
+ */
+
+#ifndef SCHED_ROUND_ROBIN_H
+#define SCHED_ROUND_ROBIN_H
+
+#include <stdint.h>
+
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of one time slice in microseconds
+ */
+#ifndef SCHED_ROUND_ROBIN_TIMESLICE_US
+#define SCHED_ROUND_ROBIN_TIMESLICE_US  (10000U)
+#endif
+
+/**
+ * @brief   Update the time slice for the thread that is about to run
+ *
+ * Called by the scheduler from @ref sched_run() with interrupts disabled.
+ *
+ * @param[in]   thread  the thread that was selected to run next
+ */
+void sched_round_robin_update(thread_t *thread);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_ROUND_ROBIN_H */
+/** @} */
@@ -63,6 +63,73 @@ typedef struct shell_command_t {
     shell_command_handler_t handler; /**< The callback function. */
 } shell_command_t;
 
+/**
+ * @name    Shell flags
+ * @{
+ */
+#define SHELL_BATCH     (0x01)  /**< don't echo the input or print a prompt */
+#define SHELL_SORTED    (0x02)  /**< the application's commands are sorted
+                                 *   by name (in strcmp() order) */
+/** @} */
+
+/**
+ * @brief           State of a shell that is fed by shell_input()
+ * @details         All members are private.
+ */
+typedef struct {
+    const shell_command_t *commands;    /**< application commands */
+    unsigned numof;                     /**< number of application commands */
+    char *line_buf;                     /**< line buffer */
+    uint16_t size;                      /**< size of line_buf */
+    uint16_t pos;                       /**< length of the current line */
+    uint8_t flags;                      /**< SHELL_* flags */
+    uint8_t overflow;                   /**< current line did not fit */
+} shell_t;
+
+/**
+ * @brief           Initialize a shell that is fed by shell_input()
+ * @details         This prints the first prompt unless @ref SHELL_BATCH is
+ *                  given.
+ *
+ * @param[out]      shell       shell to initialize
+ * @param[in]       commands    ptr to array of command structs, may be NULL
+ * @param[in]       line_buf    Buffer that will be used for reading a line
+ * @param[in]       len         nr of bytes that fit in line_buf
+ * @param[in]       flags       SHELL_* flags
+ */
+void shell_init(shell_t *shell, const shell_command_t *commands,
+                char *line_buf, int len, unsigned flags);
+
+/**
+ * @brief           Feed a character into a shell
+ * @details         The command handler runs in the context of the caller once
+ *                  a line is complete, so this is meant to be called from a
+ *                  thread that already waits for input (e.g. an event loop)
+ *                  instead of running a dedicated shell thread. Lines that
+ *                  do not fit into the line buffer are dropped.
+ *
+ * @param[in,out]   shell       shell to feed
+ * @param[in]       c           input character
+ *
+ * @return          1 if a command line was executed
+ * @return          0 otherwise
+ */
+int shell_input(shell_t *shell, int c);
+
+/**
+ * @brief           Run the commands read from stdin until end of file
+ * @details         Neither the input is echoed nor a prompt printed, so
+ *                  scripted command streams only produce the output of the
+ *                  commands.
+ *
+ * @param[in]       commands    ptr to array of command structs
+ * @param[in]       line_buf    Buffer that will be used for reading a line
+ * @param[in]       len         nr of bytes that fit in line_buf
+ * @param[in]       flags       additional SHELL_* flags
+ */
+void shell_run_batch(const shell_command_t *commands, char *line_buf, int len,
+                     unsigned flags);
+
 /**
  * @brief           Start a shell.
  *
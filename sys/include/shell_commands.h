@@ -32,8 +32,17 @@ extern "C" {
 #define DISK_READ_SECTOR_CMD    "dread_sec"
 #define DISK_READ_BYTES_CMD     "dread"
 
+/**
+ * @brief   Builtin shell commands, sorted by name
+ */
 extern const shell_command_t _shell_command_list[];
 
+/**
+ * @brief   Number of entries in @ref _shell_command_list, without the
+ *          terminating one
+ */
+extern const unsigned _shell_command_numof;
+
 #ifdef __cplusplus
 }
 #endif
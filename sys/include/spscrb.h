@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_spscrb Single-producer/single-consumer ringbuffer
+ * @ingroup     sys
+ * @brief       Lock-free ringbuffer with configurable element size and a
+ *              contiguous region API
+ *
+ * This ringbuffer can be used without locking as long as there is only one
+ * producer (e.g., an ISR) and one consumer (e.g., a thread). Apart from
+ * copying elements in and out, both sides can work directly on the buffer
+ * memory:
+ *
+ * - the producer calls @ref spscrb_reserve() to get the largest contiguous
+ *   free region, fills it (e.g., using memcpy or DMA) and makes the data
+ *   visible to the consumer with @ref spscrb_commit().
+ * - the consumer calls @ref spscrb_peek() to get the largest contiguous
+ *   readable region, processes it and frees it with @ref spscrb_release().
+ *
+ * As the buffer wraps around, a region never spans the end of the buffer and
+ * may thus be shorter than the total free (or available) space. Calling the
+ * function again after committing (or releasing) returns the rest.
+ *
+ * @note    The number of elements must be a power of two.
+ * @note    Only a compiler barrier is used between buffer and index
+ *          accesses, which is sufficient on single-core MCUs.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Single-producer/single-consumer ringbuffer interface
+ */
+
+#ifndef SPSCRB_H
+#define SPSCRB_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Ringbuffer structure
+ */
+typedef struct {
+    uint8_t *buf;               /**< buffer to operate on */
+    unsigned size;              /**< number of elements in buf */
+    unsigned elem_size;         /**< size of one element in bytes */
+    volatile unsigned reads;    /**< total number of elements read */
+    volatile unsigned writes;   /**< total number of elements written */
+} spscrb_t;
+
+/**
+ * @brief   Static initializer
+ *
+ * @param[in] BUF       buffer to use
+ * @param[in] ELEM_SIZE size of one element in bytes. The number of elements
+ *                      `sizeof(BUF) / ELEM_SIZE` must be a power of two.
+ */
+#define SPSCRB_INIT(BUF, ELEM_SIZE) \
+    { (uint8_t *)(BUF), sizeof(BUF) / (ELEM_SIZE), (ELEM_SIZE), 0, 0 }
+
+/**
+ * @brief   Initialize a ringbuffer
+ *
+ * @param[out]  rb          ringbuffer to initialize
+ * @param[in]   buf         buffer of `size * elem_size` bytes
+ * @param[in]   size        number of elements, must be a power of two
+ * @param[in]   elem_size   size of one element in bytes
+ */
+static inline void spscrb_init(spscrb_t *rb, void *buf, unsigned size,
+                               unsigned elem_size)
+{
+    assert((size != 0) && !(size & (size - 1)));
+
+    rb->buf = buf;
+    rb->size = size;
+    rb->elem_size = elem_size;
+    rb->reads = 0;
+    rb->writes = 0;
+}
+
+/**
+ * @brief   Get number of elements available for reading
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ *
+ * @return  number of readable elements
+ */
+static inline unsigned spscrb_avail(const spscrb_t *rb)
+{
+    return rb->writes - rb->reads;
+}
+
+/**
+ * @brief   Get number of free elements
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ *
+ * @return  number of elements that can be written
+ */
+static inline unsigned spscrb_free(const spscrb_t *rb)
+{
+    return rb->size - spscrb_avail(rb);
+}
+
+/**
+ * @brief   Test if the ringbuffer is empty
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ *
+ * @return  1 if empty, 0 otherwise
+ */
+static inline int spscrb_empty(const spscrb_t *rb)
+{
+    return rb->reads == rb->writes;
+}
+
+/**
+ * @brief   Test if the ringbuffer is full
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ *
+ * @return  1 if full, 0 otherwise
+ */
+static inline int spscrb_full(const spscrb_t *rb)
+{
+    return spscrb_avail(rb) == rb->size;
+}
+
+/**
+ * @brief   Get the largest contiguous free region (producer side)
+ *
+ * @param[in]   rb      ringbuffer to operate on
+ * @param[out]  region  start of the free region
+ *
+ * @return  number of elements that can be written to @p region
+ */
+unsigned spscrb_reserve(spscrb_t *rb, void **region);
+
+/**
+ * @brief   Make elements written to a reserved region readable
+ *
+ * @pre     @p n is not larger than the value returned by the preceding
+ *          @ref spscrb_reserve()
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ * @param[in]   n   number of elements written
+ */
+void spscrb_commit(spscrb_t *rb, unsigned n);
+
+/**
+ * @brief   Get the largest contiguous readable region (consumer side)
+ *
+ * @param[in]   rb      ringbuffer to operate on
+ * @param[out]  region  start of the readable region
+ *
+ * @return  number of elements that can be read from @p region
+ */
+unsigned spscrb_peek(spscrb_t *rb, void **region);
+
+/**
+ * @brief   Free elements read from a peeked region
+ *
+ * @pre     @p n is not larger than the value returned by the preceding
+ *          @ref spscrb_peek()
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ * @param[in]   n   number of elements to free
+ */
+void spscrb_release(spscrb_t *rb, unsigned n);
+
+/**
+ * @brief   Copy elements into the ringbuffer
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ * @param[in]   src elements to copy
+ * @param[in]   n   maximum number of elements to copy
+ *
+ * @return  number of elements copied
+ */
+unsigned spscrb_put(spscrb_t *rb, const void *src, unsigned n);
+
+/**
+ * @brief   Copy elements out of the ringbuffer
+ *
+ * @param[in]   rb  ringbuffer to operate on
+ * @param[out]  dst buffer to copy to
+ * @param[in]   n   maximum number of elements to copy
+ *
+ * @return  number of elements copied
+ */
+unsigned spscrb_get(spscrb_t *rb, void *dst, unsigned n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPSCRB_H */
+/** @} */
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_threadprof Thread profiling
+ * @ingroup     sys
+ * @brief       Per-thread CPU load over a sliding window and stack high-water
+ *              marks
+ *
+ * This module periodically samples the run time statistics kept by the
+ * scheduler (see `schedstatistics`) into a ring of @ref THREADPROF_WINDOW_NUMOF
+ * windows of @ref THREADPROF_WINDOW_US each. From that, the CPU load of every
+ * thread over the last `THREADPROF_WINDOW_NUMOF * THREADPROF_WINDOW_US` can be
+ * queried cheaply.
+ *
+ * When `DEVELHELP` is enabled, the stack high-water mark of every thread is
+ * updated by the idle thread each time it runs and whenever the data of a
+ * thread is requested, never from the sampling timer. Like
+ * thread_measure_stack_free(), the scan starts at the bottom of the stack
+ * and stops at the first overwritten word, so untouched words in the used
+ * part of the stack (e.g. in large local arrays) do not hide deeper use. The
+ * scan ends at the previously found mark at the latest. The mark of a thread
+ * is kept when it exits.
+ *
+ * From the high-water marks, threadprof_print_stacks() recommends a stack
+ * size for every thread: the high-water mark plus
+ * @ref THREADPROF_STACK_MARGIN percent, rounded up to
+ * @ref THREADPROF_STACK_ALIGN. Run the application through its worst case,
+ * then compare the recommendations with the configured sizes. On native,
+ * the report is printed when the process exits.
+ *
+ * Sampling is started by @ref auto_init, the values can be printed with the
+ * `threadprof` shell command or by `ps`, the stack report with
+ * `threadprof stack`.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Thread profiling interface
+ */
+
+#ifndef THREADPROF_H
+#define THREADPROF_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of windows kept per thread
+ */
+#ifndef THREADPROF_WINDOW_NUMOF
+#define THREADPROF_WINDOW_NUMOF     (4U)
+#endif
+
+/**
+ * @brief   Length of one window in microseconds
+ */
+#ifndef THREADPROF_WINDOW_US
+#define THREADPROF_WINDOW_US        (1000000U)
+#endif
+
+/**
+ * @brief   Safety margin added to the stack high-water mark in percent
+ */
+#ifndef THREADPROF_STACK_MARGIN
+#define THREADPROF_STACK_MARGIN     (25U)
+#endif
+
+/**
+ * @brief   Alignment of the recommended stack sizes in bytes, must be a power
+ *          of two
+ */
+#ifndef THREADPROF_STACK_ALIGN
+#define THREADPROF_STACK_ALIGN      (16U)
+#endif
+
+/**
+ * @brief   Number of exited threads whose stack usage is kept for the report
+ */
+#ifndef THREADPROF_EXITED_NUMOF
+#define THREADPROF_EXITED_NUMOF     (4U)
+#endif
+
+/**
+ * @brief   Profiling data of one thread
+ */
+typedef struct {
+    uint32_t cpu_permille;      /**< CPU load over all windows in 1/1000 */
+    uint32_t cpu_last_permille; /**< CPU load in the last complete window */
+    uint32_t switches;          /**< context switches to the thread over all
+                                     windows */
+    int stack_max;              /**< stack high-water mark in bytes, or -1 if
+                                     unknown (no `DEVELHELP`) */
+} threadprof_t;
+
+/**
+ * @brief   Start periodic sampling
+ *
+ * Called by auto_init.
+ */
+void threadprof_init(void);
+
+/**
+ * @brief   Take a sample now and advance to the next window
+ *
+ * This is usually called periodically by the module itself, but can be
+ * called manually, e.g., from a test, to get deterministic windows. Safe to
+ * be called from interrupt context.
+ */
+void threadprof_sample(void);
+
+/**
+ * @brief   Update the stack high-water marks of all threads
+ *
+ * Called by the idle thread. Does nothing without `DEVELHELP`.
+ */
+void threadprof_stack_sample(void);
+
+/**
+ * @brief   Keep the stack high-water mark of the running thread
+ *
+ * Called by the scheduler when the running thread exits.
+ */
+void threadprof_thread_exit(void);
+
+/**
+ * @brief   Get the recommended stack size for a high-water mark
+ *
+ * @param[in]   stack_max   the high-water mark in bytes
+ *
+ * @return  @p stack_max plus @ref THREADPROF_STACK_MARGIN percent, rounded up
+ *          to @ref THREADPROF_STACK_ALIGN
+ */
+static inline unsigned threadprof_stack_recommend(unsigned stack_max)
+{
+    unsigned size = stack_max + (stack_max * THREADPROF_STACK_MARGIN) / 100;
+
+    return (size + THREADPROF_STACK_ALIGN - 1) & ~(THREADPROF_STACK_ALIGN - 1);
+}
+
+/**
+ * @brief   Get the profiling data of a thread
+ *
+ * @param[in]   pid     the thread to get the data for
+ * @param[out]  out     the profiling data
+ *
+ * @return      0 on success
+ * @return      -1 if @p pid is not a running thread
+ */
+int threadprof_get(kernel_pid_t pid, threadprof_t *out);
+
+/**
+ * @brief   Print the profiling data of all threads to stdout
+ */
+void threadprof_print(void);
+
+/**
+ * @brief   Print the stack size, high-water mark and recommended stack size
+ *          of all running and exited threads to stdout
+ */
+void threadprof_print_stacks(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THREADPROF_H */
+/** @} */
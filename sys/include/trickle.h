@@ -11,6 +11,12 @@
 /**
  * @defgroup sys_trickle Trickle Timer
  * @ingroup sys
+ *
+ * Every trickle timer uses two xtimers to send its interval and callback
+ * messages. With the module `trickle_sched` all trickle timers share a single
+ * xtimer instead: the timers are kept in a list sorted by their next event,
+ * and all events due within @ref TRICKLE_SCHED_SLACK are delivered to their
+ * threads in one timer interrupt.
  * @{
  */
 
@@ -38,8 +44,18 @@ typedef struct {
     void *args;                 /**< a generic parameter for the callback function pointer */
 } trickle_callback_t;
 
+/**
+ * @brief   Time in microseconds events of different trickle timers may be
+ *          delivered early to deliver them together
+ *
+ * @note    Only used with module `trickle_sched`
+ */
+#ifndef TRICKLE_SCHED_SLACK
+#define TRICKLE_SCHED_SLACK     (1000U)
+#endif
+
 /** @brief all state variables for a trickle timer */
-typedef struct {
+typedef struct trickle {
     uint8_t k;                      /**< redundancy constant */
     uint8_t Imax;                   /**< maximum interval size, described as doublings */
     uint16_t c;                     /**< counter */
@@ -51,12 +67,21 @@ typedef struct {
                                          after each interval */
     msg_t msg_interval;             /**< the msg_t to use for intervals */
     uint64_t msg_interval_time;     /**< interval in ms */
-    xtimer_t msg_interval_timer;    /**< xtimer to send a msg_t to the target thread
-                                         for a new interval */
+    uint64_t interval_at;           /**< system time in microseconds of the
+                                         next interval, 0 if stopped */
     msg_t msg_callback;             /**< the msg_t to use for callbacks */
     uint64_t msg_callback_time;     /**< callback interval in ms */
+    uint64_t callback_at;           /**< system time in microseconds of the
+                                         next callback, 0 if none pending */
+#ifdef MODULE_TRICKLE_SCHED
+    struct trickle *next;           /**< next timer in the scheduler's list,
+                                         sorted by next event */
+#else
+    xtimer_t msg_interval_timer;    /**< xtimer to send a msg_t to the target thread
+                                         for a new interval */
     xtimer_t msg_callback_timer;    /**< xtimer to send a msg_t to the target thread
                                          for a callback */
+#endif
 } trickle_t;
 
 /**
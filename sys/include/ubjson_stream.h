@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_ubjson_stream UBJSON streams
+ * @ingroup     sys_ubjson
+ * @brief       Buffered UBJSON output and UBJSON input from packets
+ *
+ * The UBJSON writer calls its write function several times per value, with a
+ * few bytes each. @ref ubjson_writer_t collects these writes in a buffer and
+ * hands them on in chunks of the buffer size, e.g. one UDP payload per chunk:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * static ssize_t _send(ubjson_writer_t *writer, const void *data, size_t len)
+ * {
+ *     return sock_udp_send(&sock, data, len, &remote);
+ * }
+ *
+ * ubjson_writer_init(&writer, buf, sizeof(buf), _send);
+ * ubjson_open_object(&writer.cookie);
+ * ...
+ * ubjson_close_object(&writer.cookie);
+ * ubjson_writer_flush(&writer);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * A value may be split between two chunks, so a datagram based receiver has
+ * to concatenate the chunks, or the buffer must hold a whole record.
+ *
+ * @ref ubjson_reader_t reads UBJSON data directly from the snips of a
+ * received packet, without copying the packet into one buffer first.
+ *
+ * @{
+ *
+ * @file
+ * @brief       UBJSON stream definitions
+ */
+
+#ifndef UBJSON_STREAM_H
+#define UBJSON_STREAM_H
+
+#include "ubjson.h"
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Forward declaration of the buffered writer
+ */
+typedef struct ubjson_writer ubjson_writer_t;
+
+/**
+ * @brief   Function to hand on a chunk of buffered UBJSON output
+ *
+ * @param[in] writer    the writer
+ * @param[in] data      the chunk
+ * @param[in] len       length of @p data, never 0
+ *
+ * @return  `< 0` on error
+ * @return  `>= 0` on success
+ */
+typedef ssize_t (*ubjson_flush_t)(ubjson_writer_t *writer, const void *data,
+                                  size_t len);
+
+/**
+ * @brief   Buffered UBJSON writer
+ */
+struct ubjson_writer {
+    ubjson_cookie_t cookie; /**< cookie for ubjson_write_null() and friends */
+    ubjson_flush_t flush;   /**< function to hand on a chunk */
+    uint8_t *buf;           /**< the buffer */
+    size_t size;            /**< size of the buffer */
+    size_t len;             /**< bytes in the buffer */
+    unsigned flushes;       /**< number of chunks handed on */
+};
+
+/**
+ * @brief   Buffered UBJSON reader for a packet
+ */
+typedef struct {
+    ubjson_cookie_t cookie;         /**< cookie for ubjson_read() */
+    const gnrc_pktsnip_t *snip;     /**< current snip */
+    size_t pos;                     /**< position in the current snip */
+} ubjson_reader_t;
+
+/**
+ * @brief   Initializes a buffered writer
+ *
+ * Pass ubjson_writer_t::cookie to ubjson_write_null() and friends.
+ *
+ * @param[out] writer   the writer
+ * @param[in] buf       the buffer, e.g. of the size of a packet payload
+ * @param[in] size      size of @p buf, must not be 0
+ * @param[in] flush     function to hand on a full buffer
+ */
+void ubjson_writer_init(ubjson_writer_t *writer, void *buf, size_t size,
+                        ubjson_flush_t flush);
+
+/**
+ * @brief   Hands on the buffered output
+ *
+ * Call this after the last value was written.
+ *
+ * @param[in] writer    the writer
+ *
+ * @return  the result of ubjson_writer_t::flush
+ * @return  0 if the buffer was empty
+ */
+ssize_t ubjson_writer_flush(ubjson_writer_t *writer);
+
+/**
+ * @brief   Initializes a reader for a packet
+ *
+ * The data of all snips of @p pkt, in order, are read as one stream. Use
+ * ubjson_reader_t::cookie and ubjson_reader_read() with ubjson_read():
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * ubjson_reader_init(&reader, pkt);
+ * ubjson_read(&reader.cookie, ubjson_reader_read, callback);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @param[out] reader   the reader
+ * @param[in] pkt       the packet, must not be released while reading
+ */
+void ubjson_reader_init(ubjson_reader_t *reader, const gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Read function of a reader initialized with ubjson_reader_init()
+ *
+ * @param[in] cookie    ubjson_reader_t::cookie of the reader
+ * @param[out] buf      buffer for the data
+ * @param[in] max_len   size of @p buf
+ *
+ * @return  the number of bytes read
+ * @return  -1 at the end of the packet
+ */
+ssize_t ubjson_reader_read(ubjson_cookie_t *__restrict cookie, void *buf,
+                           size_t max_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UBJSON_STREAM_H */
+/** @} */
@@ -20,6 +20,22 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * With the pseudo module `xtimer_heap`, the lists are replaced by pairing
+ * heaps. Insertion is O(1) and removal O(log n) amortized, at the cost of
+ * two more pointers per timer. Timers with the same target may then expire
+ * in any order. As the fields of a set timer are followed on removal, the
+ * xtimer_t::target and xtimer_t::long_target fields *must* be initialized
+ * with 0 on first use.
+ *
+ * With the pseudo module `xtimer_lp`, timers set at least
+ * @ref XTIMER_LP_THRESHOLD microseconds ahead are kept on the real time timer
+ * (periph/rtt) instead of the high-frequency `XTIMER_DEV`. While no short
+ * timer is pending, the high-frequency timer only has to serve its period
+ * tick, so power management may pick deeper modes. These timers expire with
+ * the resolution of `RTT_FREQUENCY` and never early. The RTT alarm is owned
+ * by xtimer then. xtimer_now() is still based on `XTIMER_DEV`, so it does
+ * not advance in modes that stop that timer.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -31,6 +47,7 @@
 
 #include <stdint.h>
 #include "timex.h"
+#include "mbox.h"
 #include "msg.h"
 #include "mutex.h"
 
@@ -69,6 +86,11 @@ typedef void (*xtimer_callback_t)(void*);
  */
 typedef struct xtimer {
     struct xtimer *next;        /**< reference to next timer in timer lists */
+#if defined(MODULE_XTIMER_HEAP) || defined(DOXYGEN)
+    struct xtimer *child;       /**< first child in the timer heap */
+    struct xtimer *prev;        /**< previous sibling or parent in the timer
+                                     heap */
+#endif
     uint32_t target;            /**< lower 32bit absolute target time */
     uint32_t long_target;       /**< upper 32bit absolute target time */
     xtimer_callback_t callback;  /**< callback function to call when timer
@@ -271,6 +293,24 @@ static inline void xtimer_set_wakeup(xtimer_t *timer, uint32_t offset, kernel_pi
  */
 static inline void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_pid_t pid);
 
+#if defined(MODULE_CORE_THREAD_FLAGS) || defined(DOXYGEN)
+/**
+ * @brief Set a timer that sets THREAD_FLAG_TIMEOUT on a thread, 64bit version
+ *
+ * Unlike xtimer_set_wakeup64(), this also ends a wait in
+ * thread_flags_wait_any() for THREAD_FLAG_TIMEOUT, and the flag stays set if
+ * the thread was not waiting yet.
+ *
+ * @param[in] timer         timer struct to work with.
+ *                          Its xtimer_t::target and xtimer_t::long_target
+ *                          fields need to be initialized with 0 on first use
+ * @param[in] offset        microseconds from now
+ * @param[in] thread        thread to set the flag on
+ */
+static inline void xtimer_set_timeout_flag64(xtimer_t *timer, uint64_t offset,
+                                             thread_t *thread);
+#endif
+
 /**
  * @brief Set a timer to execute a callback at some time in the future
  *
@@ -291,6 +331,23 @@ static inline void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_
  */
 static inline void xtimer_set(xtimer_t *timer, uint32_t offset);
 
+/**
+ * @brief Set a timer that may expire late to share a wake-up
+ *
+ * Like xtimer_set(), but the callback may be executed up to @p slack
+ * microseconds after @p offset. If another timer is due within that window,
+ * the timer expires together with it, so the MCU wakes up once for both.
+ *
+ * @param[in] timer     the timer structure to use.
+ *                      Its xtimer_t::target and xtimer_t::long_target
+ *                      fields need to be initialized with 0 on first use
+ * @param[in] offset    time in microseconds from now specifying that timer's
+ *                      earliest execution time
+ * @param[in] slack     tolerated delay in microseconds
+ */
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset,
+                                    uint32_t slack);
+
 /**
  * @brief remove a timer
  *
@@ -426,6 +483,128 @@ static inline bool xtimer_less(xtimer_ticks32_t a, xtimer_ticks32_t b);
  */
 static inline bool xtimer_less64(xtimer_ticks64_t a, xtimer_ticks64_t b);
 
+/**
+ * @brief   Get the time until the low-level timer will fire next
+ *
+ * This is meant to be used by power management code running in the idle
+ * thread, e.g., to decide how deep the MCU may sleep. The low-level timer is
+ * always armed, either for the first pending timer or for the period tick
+ * xtimer needs to keep track of the time when no timer is due in the current
+ * period.
+ *
+ * @param[out]  ticks   ticks until the next low-level timer interrupt
+ *
+ * @return      1, if the next interrupt will fire a timer
+ * @return      0, if the next interrupt is only the period tick
+ */
+int xtimer_next_event(uint32_t *ticks);
+
+/**
+ * @brief xtimer statistics
+ */
+typedef struct {
+    uint32_t wakeups;           /**< low-level timer interrupts */
+    uint32_t fired;             /**< timers expired in these interrupts */
+    uint32_t coalesced;         /**< timers moved onto the expiry of another
+                                     timer with xtimer_set_slack() */
+} xtimer_stats_t;
+
+/**
+ * @brief Get the xtimer statistics
+ *
+ * The number of timers per wake-up, xtimer_stats_t::fired divided by
+ * xtimer_stats_t::wakeups, shows how well timers are coalesced.
+ *
+ * @return  the statistics since start-up
+ */
+const xtimer_stats_t *xtimer_get_stats(void);
+
+/**
+ * @brief xtimer timing parameters, in hardware ticks
+ */
+typedef struct {
+    uint32_t backoff;           /**< timers closer than this spin, see
+                                     XTIMER_BACKOFF */
+    uint32_t overhead;          /**< correction of the low-level timer
+                                     target, see XTIMER_OVERHEAD */
+    uint32_t isr_backoff;       /**< timers this close to the end of an
+                                     interrupt spin, see XTIMER_ISR_BACKOFF */
+} xtimer_calibration_t;
+
+/**
+ * @brief Get the timing parameters xtimer uses
+ *
+ * With `xtimer_calibrate`, these are measured by xtimer_init(), otherwise
+ * they are XTIMER_BACKOFF, XTIMER_OVERHEAD and XTIMER_ISR_BACKOFF.
+ *
+ * @return  the timing parameters
+ */
+const xtimer_calibration_t *xtimer_get_calibration(void);
+
+/**
+ * @brief Reserve a hard timer
+ *
+ * Hard timers use a channel of the low-level timer on their own. Their
+ * callback is executed straight from the timer interrupt, without going
+ * through the xtimer lists and without XTIMER_ISR_BACKOFF spinning, so it is
+ * not delayed by other timers expiring around the same time.
+ *
+ * Hard timer @p idx uses channel XTIMER_HARD_CHAN + @p idx of XTIMER_DEV,
+ * which the board must provide.
+ *
+ * @note this requires xtimer_hard to be enabled
+ *
+ * @param[in] idx       hard timer to reserve, < XTIMER_HARD_NUMOF
+ * @param[in] callback  callback to execute in interrupt context
+ * @param[in] arg       argument for @p callback
+ *
+ * @return      0 on success
+ * @return      -EINVAL, if @p idx is out of range
+ * @return      -EBUSY, if the hard timer is reserved already
+ */
+int xtimer_hard_init(unsigned idx, xtimer_callback_t callback, void *arg);
+
+/**
+ * @brief Stop and release a hard timer reserved with xtimer_hard_init()
+ *
+ * @param[in] idx       hard timer to release
+ */
+void xtimer_hard_release(unsigned idx);
+
+/**
+ * @brief Set a hard timer to an absolute time
+ *
+ * Setting the target from the previous one, e.g., from within the callback,
+ * gives a periodic timer without drift.
+ *
+ * @param[in] idx       reserved hard timer
+ * @param[in] target    absolute time, must be less than one low-level timer
+ *                      period after xtimer_now()
+ *
+ * @return      0 on success
+ * @return      -EINVAL, if @p idx is not reserved
+ */
+int xtimer_hard_set_absolute(unsigned idx, xtimer_ticks32_t target);
+
+/**
+ * @brief Set a hard timer relative to now
+ *
+ * @param[in] idx       reserved hard timer
+ * @param[in] offset    time in microseconds from now, must be less than one
+ *                      low-level timer period
+ *
+ * @return      0 on success
+ * @return      -EINVAL, if @p idx is not reserved or @p offset is too large
+ */
+int xtimer_hard_set(unsigned idx, uint32_t offset);
+
+/**
+ * @brief Stop a hard timer without releasing it
+ *
+ * @param[in] idx       reserved hard timer
+ */
+void xtimer_hard_clear(unsigned idx);
+
 /**
  * @brief lock a mutex but with timeout
  *
@@ -439,13 +618,33 @@ static inline bool xtimer_less64(xtimer_ticks64_t a, xtimer_ticks64_t b);
  */
 int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us);
 
+/**
+ * @brief get a message from a mailbox but with timeout
+ *
+ * Unlike pairing @ref mbox_get() with a timer that posts a timeout message,
+ * this does not occupy a mailbox slot and cannot leave a stale timeout
+ * message behind.
+ *
+ * @note this requires core_mbox to be enabled
+ *
+ * @param[in]    mbox    mailbox to get the message from
+ * @param[out]   msg     pointer to a msg_t which will be filled in case of
+ *                       no timeout
+ * @param[in]    timeout timeout in microseconds relative, 0 to not block
+ *
+ * @return       0, when a message was retrieved
+ * @return       -1, when the timeout occurred
+ */
+int xtimer_mbox_get_timeout(mbox_t *mbox, msg_t *msg, uint32_t timeout);
+
 /**
  * @brief xtimer backoff value
  *
  * All timers that are less than XTIMER_BACKOFF microseconds in the future will
  * just spin.
  *
- * This is supposed to be defined per-device in e.g., periph_conf.h.
+ * This is supposed to be defined per-device in e.g., periph_conf.h, or
+ * measured at boot with `xtimer_calibrate`.
  */
 #ifndef XTIMER_BACKOFF
 #define XTIMER_BACKOFF 30
@@ -486,6 +685,21 @@ int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us);
 #define XTIMER_ISR_BACKOFF 20
 #endif
 
+#ifndef XTIMER_CALIBRATE_RUNS
+/**
+ * @brief   Number of timers `xtimer_calibrate` measures at boot
+ */
+#define XTIMER_CALIBRATE_RUNS (8U)
+#endif
+
+#ifndef XTIMER_CALIBRATE_MARGIN
+/**
+ * @brief   Offset in hardware ticks beyond the backoff of the timers
+ *          `xtimer_calibrate` measures
+ */
+#define XTIMER_CALIBRATE_MARGIN (100U)
+#endif
+
 #ifndef XTIMER_PERIODIC_SPIN
 /**
  * @brief   xtimer_periodic_wakeup spin cutoff
@@ -493,8 +707,12 @@ int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us);
  * If the difference between target time and now is less than this value, then
  * xtimer_periodic_wakeup will use xtimer_spin instead of setting a timer.
  */
+#if defined(MODULE_XTIMER_CALIBRATE) && !defined(DOXYGEN)
+#define XTIMER_PERIODIC_SPIN (xtimer_get_calibration()->backoff * 2)
+#else
 #define XTIMER_PERIODIC_SPIN (XTIMER_BACKOFF * 2)
 #endif
+#endif
 
 #ifndef XTIMER_PERIODIC_RELATIVE
 /**
@@ -509,6 +727,14 @@ int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us);
 #define XTIMER_PERIODIC_RELATIVE (512)
 #endif
 
+#ifndef XTIMER_LP_THRESHOLD
+/**
+ * @brief   Minimum offset in microseconds of timers that are moved to the
+ *          RTT with `xtimer_lp`
+ */
+#define XTIMER_LP_THRESHOLD (10U * SEC_IN_USEC)
+#endif
+
 #ifndef XTIMER_SHIFT
 /**
  * @brief   xtimer prescaler value
@@ -573,6 +799,20 @@ int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t us);
 #define XTIMER_MASK (0)
 #endif
 
+#ifndef XTIMER_HARD_CHAN
+/**
+ * @brief First low-level timer channel used by `xtimer_hard`
+ */
+#define XTIMER_HARD_CHAN (XTIMER_CHAN + 1)
+#endif
+
+#ifndef XTIMER_HARD_NUMOF
+/**
+ * @brief Number of hard timers, each one uses a low-level timer channel
+ */
+#define XTIMER_HARD_NUMOF (1U)
+#endif
+
 #ifndef XTIMER_HZ
 /**
  * @brief  Frequency of the underlying hardware timer
@@ -63,11 +63,13 @@ uint64_t _xtimer_now64(void);
 int _xtimer_set_absolute(xtimer_t *timer, uint32_t target);
 void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset);
 void _xtimer_set(xtimer_t *timer, uint32_t offset);
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack);
 void _xtimer_periodic_wakeup(uint32_t *last_wakeup, uint32_t period);
 void _xtimer_set_msg(xtimer_t *timer, uint32_t offset, msg_t *msg, kernel_pid_t target_pid);
 void _xtimer_set_msg64(xtimer_t *timer, uint64_t offset, msg_t *msg, kernel_pid_t target_pid);
 void _xtimer_set_wakeup(xtimer_t *timer, uint32_t offset, kernel_pid_t pid);
 void _xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_pid_t pid);
+void _xtimer_set_timeout_flag64(xtimer_t *timer, uint64_t offset, thread_t *thread);
 void _xtimer_set(xtimer_t *timer, uint32_t offset);
 int _xtimer_msg_receive_timeout(msg_t *msg, uint32_t ticks);
 int _xtimer_msg_receive_timeout64(msg_t *msg, uint64_t ticks);
@@ -76,6 +78,32 @@ int _xtimer_msg_receive_timeout64(msg_t *msg, uint64_t ticks);
  * @brief  Sleep for the given number of ticks
  */
 void _xtimer_tsleep(uint32_t offset, uint32_t long_offset);
+
+#ifdef MODULE_XTIMER_LP
+/**
+ * @brief  Initializes the RTT backed timer list
+ */
+void _xtimer_lp_init(void);
+
+/**
+ * @brief  Sets a timer on the RTT, the timer must not be set
+ */
+void _xtimer_lp_set(xtimer_t *timer, uint64_t offset);
+
+/**
+ * @brief  Removes a timer from the RTT backed list
+ *
+ * @return 1 if @p timer was on the list, 0 otherwise
+ */
+int _xtimer_lp_remove(xtimer_t *timer);
+#endif
+
+#ifdef MODULE_XTIMER_HARD
+/**
+ * @brief  Executes the hard timer on low-level timer channel @p chan
+ */
+void _xtimer_hard_callback(int chan);
+#endif
 /** @} */
 
 #ifndef XTIMER_MIN_SPIN
@@ -211,11 +239,26 @@ static inline void xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_
     _xtimer_set_wakeup64(timer, _xtimer_ticks_from_usec64(offset), pid);
 }
 
+#ifdef MODULE_CORE_THREAD_FLAGS
+static inline void xtimer_set_timeout_flag64(xtimer_t *timer, uint64_t offset,
+                                             thread_t *thread)
+{
+    _xtimer_set_timeout_flag64(timer, _xtimer_ticks_from_usec64(offset), thread);
+}
+#endif
+
 static inline void xtimer_set(xtimer_t *timer, uint32_t offset)
 {
     _xtimer_set(timer, _xtimer_ticks_from_usec(offset));
 }
 
+static inline void xtimer_set_slack(xtimer_t *timer, uint32_t offset,
+                                    uint32_t slack)
+{
+    _xtimer_set_slack(timer, _xtimer_ticks_from_usec(offset),
+                      _xtimer_ticks_from_usec(slack));
+}
+
 static inline int xtimer_msg_receive_timeout(msg_t *msg, uint32_t timeout)
 {
     return _xtimer_msg_receive_timeout(msg, _xtimer_ticks_from_usec(timeout));
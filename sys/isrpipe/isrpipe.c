@@ -25,17 +25,36 @@
 void isrpipe_init(isrpipe_t *isrpipe, char *buf, size_t bufsize)
 {
     mutex_init(&isrpipe->mutex);
-    tsrb_init(&isrpipe->tsrb, buf, bufsize);
+    spscrb_init(&isrpipe->rb, buf, bufsize, 1);
+    isrpipe->watermark = 1;
+}
+
+/* called by the writer after adding data */
+static inline void _wake(isrpipe_t *isrpipe)
+{
+    if ((spscrb_avail(&isrpipe->rb) >= isrpipe->watermark) ||
+        spscrb_full(&isrpipe->rb)) {
+        mutex_unlock(&isrpipe->mutex);
+    }
 }
 
 int isrpipe_write_one(isrpipe_t *isrpipe, char c)
 {
-    int res = tsrb_add_one(&isrpipe->tsrb, c);
+    int res = (spscrb_put(&isrpipe->rb, &c, 1) == 1) ? 0 : -1;
 
     /* `res` is either 0 on success or -1 when the buffer is full. Either way,
-     * unlocking the mutex is fine.
+     * waking the reader is fine.
      */
-    mutex_unlock(&isrpipe->mutex);
+    _wake(isrpipe);
+
+    return res;
+}
+
+size_t isrpipe_write(isrpipe_t *isrpipe, const char *buf, size_t count)
+{
+    size_t res = spscrb_put(&isrpipe->rb, buf, count);
+
+    _wake(isrpipe);
 
     return res;
 }
@@ -44,7 +63,17 @@ int isrpipe_read(isrpipe_t *isrpipe, char *buffer, size_t count)
 {
     int res;
 
-    while (!(res = tsrb_get(&isrpipe->tsrb, buffer, count))) {
+    while (!(res = spscrb_get(&isrpipe->rb, buffer, count))) {
+        mutex_lock(&isrpipe->mutex);
+    }
+    return res;
+}
+
+size_t isrpipe_peek(isrpipe_t *isrpipe, char **region)
+{
+    size_t res;
+
+    while (!(res = spscrb_peek(&isrpipe->rb, (void **)region))) {
         mutex_lock(&isrpipe->mutex);
     }
     return res;
@@ -72,7 +101,7 @@ int isrpipe_read_timeout(isrpipe_t *isrpipe, char *buffer, size_t count, uint32_
     xtimer_t timer = { .callback = _cb, .arg = &_timeout };
 
     xtimer_set(&timer, timeout);
-    while (!(res = tsrb_get(&isrpipe->tsrb, buffer, count))) {
+    while (!(res = spscrb_get(&isrpipe->rb, buffer, count))) {
         mutex_lock(&isrpipe->mutex);
         if (_timeout.flag) {
             res = -ETIMEDOUT;
@@ -0,0 +1,492 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_kvlog
+ * @{
+ *
+ * @file
+ * @brief       Log-structured key/value store implementation
+ *
+ * Each sector starts with a header of two words: the erase count, written
+ * right after erasing, and the sequence number, written when the sector
+ * becomes the head of the log. A sector with an unwritten sequence number is
+ * free. The records follow the header, each padded to a multiple of 4 bytes.
+ * The first record with an unwritten key ends a sector.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "kvlog.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define ERASED          (0xffffffff)
+#define HDR_SIZE        (sizeof(sector_hdr_t))
+#define REC_SIZE(len)   (sizeof(rec_hdr_t) + ((((len) + 3) / 4) * 4))
+#define FLAG_DELETED    (0x0001)
+/* size of the buffer for copying and erasing */
+#define CHUNK           (32U)
+
+typedef struct {
+    uint32_t erase_count;
+    uint32_t seq;
+} sector_hdr_t;
+
+typedef struct {
+    uint16_t key;
+    uint16_t len;
+    uint16_t crc;
+    uint16_t flags;
+} rec_hdr_t;
+
+static int _read(kvlog_t *kv, uint32_t addr, void *dst, size_t len)
+{
+    int res = kv->dev->read(kv->dev, dst, kv->offset + addr, len);
+
+    return (res == (int)len) ? 0 : -EIO;
+}
+
+static int _write(kvlog_t *kv, uint32_t addr, const void *src, size_t len)
+{
+    int res = kv->dev->write(kv->dev, src, kv->offset + addr, len);
+
+    return (res == (int)len) ? 0 : -EIO;
+}
+
+static inline uint32_t _addr(kvlog_t *kv, unsigned sector)
+{
+    return sector * kv->sector_size;
+}
+
+static inline unsigned _next(kvlog_t *kv, unsigned sector)
+{
+    return (sector + 1 == kv->sectors) ? 0 : sector + 1;
+}
+
+static kvlog_entry_t *_find(kvlog_t *kv, uint16_t key)
+{
+    for (unsigned i = 0; i < kv->keys; i++) {
+        if (kv->index[i].key == key) {
+            return &kv->index[i];
+        }
+    }
+    return NULL;
+}
+
+static void _remove(kvlog_t *kv, kvlog_entry_t *entry)
+{
+    *entry = kv->index[--kv->keys];
+}
+
+/* CRC of the header fields, the value is added by the caller */
+static uint16_t _crc(const rec_hdr_t *hdr)
+{
+    uint16_t crc = crc16_ccitt_calc((const unsigned char *)hdr,
+                                    offsetof(rec_hdr_t, crc));
+
+    return crc16_ccitt_update(crc, (const unsigned char *)&hdr->flags,
+                              sizeof(hdr->flags));
+}
+
+static int _erase(kvlog_t *kv, unsigned sector)
+{
+    uint32_t addr = _addr(kv, sector);
+    uint8_t buf[CHUNK];
+    uint32_t count;
+    int res;
+
+    if ((res = _read(kv, addr, &count, sizeof(count))) < 0) {
+        return res;
+    }
+    count = (count == ERASED) ? 0 : count + 1;
+
+    memset(buf, 0xff, sizeof(buf));
+    for (uint32_t pos = 0; pos < kv->sector_size; pos += CHUNK) {
+        size_t n = kv->sector_size - pos;
+
+        if ((res = _write(kv, addr + pos, buf, (n < CHUNK) ? n : CHUNK)) < 0) {
+            return res;
+        }
+    }
+    kv->erases++;
+    DEBUG("kvlog: erased sector %u, %u times\n", sector, (unsigned)count + 1);
+    return _write(kv, addr, &count, sizeof(count));
+}
+
+static int _activate(kvlog_t *kv, unsigned sector)
+{
+    uint32_t seq = kv->seq++;
+    int res = _write(kv, _addr(kv, sector) + offsetof(sector_hdr_t, seq),
+                     &seq, sizeof(seq));
+
+    kv->head = sector;
+    kv->pos = HDR_SIZE;
+    kv->free--;
+    return res;
+}
+
+/* appends a record, its value is copied from src if given, else from the
+ * record at from */
+static int _append(kvlog_t *kv, rec_hdr_t *hdr, const void *src,
+                   uint32_t from)
+{
+    uint32_t addr = _addr(kv, kv->head) + kv->pos;
+    int res;
+
+    if (src) {
+        hdr->crc = crc16_ccitt_update(_crc(hdr), src, hdr->len);
+        if (((res = _write(kv, addr, hdr, sizeof(*hdr))) < 0) ||
+            ((res = _write(kv, addr + sizeof(*hdr), src, hdr->len)) < 0)) {
+            return res;
+        }
+    }
+    else {
+        /* the header is copied with its CRC, the value was checked when
+         * the log was replayed */
+        uint8_t buf[CHUNK];
+
+        if ((res = _write(kv, addr, hdr, sizeof(*hdr))) < 0) {
+            return res;
+        }
+        for (unsigned pos = 0; pos < hdr->len; pos += CHUNK) {
+            size_t n = hdr->len - pos;
+
+            n = (n < CHUNK) ? n : CHUNK;
+            if (((res = _read(kv, from + sizeof(*hdr) + pos, buf, n)) < 0) ||
+                ((res = _write(kv, addr + sizeof(*hdr) + pos, buf, n)) < 0)) {
+                return res;
+            }
+        }
+    }
+    kv->pos += REC_SIZE(hdr->len);
+    return (int)addr;
+}
+
+/* moves the current records of the tail sector to the head and erases it */
+static int _reclaim(kvlog_t *kv)
+{
+    uint32_t start = _addr(kv, kv->tail);
+    uint32_t live = 0;
+    int res;
+
+    for (unsigned i = 0; i < kv->keys; i++) {
+        uint32_t addr = kv->index[i].addr;
+
+        if ((addr >= start) && (addr < start + kv->sector_size)) {
+            live += REC_SIZE(kv->index[i].len);
+        }
+    }
+    /* the live records of one sector always fit into an empty one */
+    if (kv->pos + live > kv->sector_size) {
+        if (kv->free == 0) {
+            return -ENOSPC;
+        }
+        if ((res = _activate(kv, _next(kv, kv->head))) < 0) {
+            return res;
+        }
+    }
+
+    for (unsigned i = 0; i < kv->keys; i++) {
+        kvlog_entry_t *entry = &kv->index[i];
+        rec_hdr_t hdr;
+
+        if ((entry->addr < start) || (entry->addr >= start + kv->sector_size)) {
+            continue;
+        }
+        if ((res = _read(kv, entry->addr, &hdr, sizeof(hdr))) < 0) {
+            return res;
+        }
+        if ((res = _append(kv, &hdr, NULL, entry->addr)) < 0) {
+            return res;
+        }
+        entry->addr = (uint32_t)res;
+    }
+
+    if ((res = _erase(kv, kv->tail)) < 0) {
+        return res;
+    }
+    kv->tail = _next(kv, kv->tail);
+    kv->free++;
+    return 0;
+}
+
+/* makes room for size bytes in the head sector, keeping one sector free to
+ * reclaim into */
+static int _make_room(kvlog_t *kv, uint32_t size)
+{
+    for (unsigned n = 0; kv->pos + size > kv->sector_size; n++) {
+        int res;
+
+        if (kv->free > 1) {
+            res = _activate(kv, _next(kv, kv->head));
+        }
+        else if ((kv->tail != kv->head) && (n <= kv->sectors)) {
+            res = _reclaim(kv);
+        }
+        else {
+            return -ENOSPC;
+        }
+        if (res < 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+static int _replay(kvlog_t *kv, unsigned sector)
+{
+    uint32_t addr = _addr(kv, sector);
+    uint32_t pos = HDR_SIZE;
+    int res;
+
+    while (pos + sizeof(rec_hdr_t) <= kv->sector_size) {
+        rec_hdr_t hdr;
+        uint8_t buf[CHUNK];
+
+        if ((res = _read(kv, addr + pos, &hdr, sizeof(hdr))) < 0) {
+            return res;
+        }
+        if (hdr.key == KVLOG_KEY_INVALID) {
+            break;
+        }
+        if (pos + REC_SIZE(hdr.len) > kv->sector_size) {
+            DEBUG("kvlog: bad record at 0x%lx\n", (unsigned long)(addr + pos));
+            pos = kv->sector_size;
+            break;
+        }
+
+        uint16_t crc = _crc(&hdr);
+        for (unsigned i = 0; i < hdr.len; i += CHUNK) {
+            size_t n = hdr.len - i;
+
+            n = (n < CHUNK) ? n : CHUNK;
+            if ((res = _read(kv, addr + pos + sizeof(hdr) + i, buf, n)) < 0) {
+                return res;
+            }
+            crc = crc16_ccitt_update(crc, buf, n);
+        }
+        if (crc != hdr.crc) {
+            /* torn by a reset, nothing after it can be trusted */
+            DEBUG("kvlog: bad CRC at 0x%lx\n", (unsigned long)(addr + pos));
+            pos = kv->sector_size;
+            break;
+        }
+
+        kvlog_entry_t *entry = _find(kv, hdr.key);
+        if (hdr.flags & FLAG_DELETED) {
+            if (entry) {
+                _remove(kv, entry);
+            }
+        }
+        else {
+            if (entry == NULL) {
+                if (kv->keys == KVLOG_KEYS_NUMOF) {
+                    return -ENOMEM;
+                }
+                entry = &kv->index[kv->keys++];
+                entry->key = hdr.key;
+            }
+            entry->len = hdr.len;
+            entry->addr = addr + pos;
+        }
+        pos += REC_SIZE(hdr.len);
+    }
+
+    if (sector == kv->head) {
+        /* a record may have been torn before its header was written */
+        for (uint32_t i = pos; i < kv->sector_size; i += 4) {
+            uint32_t word;
+
+            if ((res = _read(kv, addr + i, &word, sizeof(word))) < 0) {
+                return res;
+            }
+            if (word != ERASED) {
+                pos = kv->sector_size;
+                break;
+            }
+        }
+        kv->pos = pos;
+    }
+    return 0;
+}
+
+int kvlog_init(kvlog_t *kv, nvram_t *dev, uint32_t offset,
+               uint32_t sector_size, unsigned sectors)
+{
+    uint32_t first = ERASED;
+    uint32_t last = 0;
+    int res;
+
+    if ((sectors < 2) || (sector_size % 4) ||
+        (sector_size < HDR_SIZE + sizeof(rec_hdr_t))) {
+        return -EINVAL;
+    }
+
+    memset(kv, 0, sizeof(*kv));
+    mutex_init(&kv->lock);
+    kv->dev = dev;
+    kv->offset = offset;
+    kv->sector_size = sector_size;
+    kv->sectors = sectors;
+
+    /* the used sectors follow each other in the ring, the oldest one is
+     * the tail and the newest one the head. The sequence number does not
+     * wrap in the lifetime of any flash. */
+    for (unsigned i = 0; i < sectors; i++) {
+        sector_hdr_t hdr;
+
+        if ((res = _read(kv, _addr(kv, i), &hdr, sizeof(hdr))) < 0) {
+            return res;
+        }
+        if (hdr.erase_count == ERASED) {
+            DEBUG("kvlog: formatting sector %u\n", i);
+            if ((res = _erase(kv, i)) < 0) {
+                return res;
+            }
+        }
+        if ((hdr.erase_count == ERASED) || (hdr.seq == ERASED)) {
+            kv->free++;
+            continue;
+        }
+        if ((first == ERASED) || (hdr.seq < first)) {
+            first = hdr.seq;
+            kv->tail = i;
+        }
+        if (hdr.seq >= last) {
+            last = hdr.seq;
+            kv->head = i;
+        }
+    }
+
+    if (kv->free == sectors) {
+        return _activate(kv, 0);
+    }
+    kv->seq = last + 1;
+    if (kv->free == 0) {
+        /* reset while reclaiming into the reserve sector, which holds copies
+         * of the tail's records only, start over */
+        if ((res = _erase(kv, kv->head)) < 0) {
+            return res;
+        }
+        kv->free++;
+        kv->head = (kv->head == 0) ? sectors - 1 : kv->head - 1;
+    }
+    for (unsigned i = kv->tail; ; i = _next(kv, i)) {
+        if ((res = _replay(kv, i)) < 0) {
+            return res;
+        }
+        if (i == kv->head) {
+            break;
+        }
+    }
+    return 0;
+}
+
+int kvlog_get(kvlog_t *kv, uint16_t key, void *buf, size_t len)
+{
+    int res = -ENOENT;
+
+    mutex_lock(&kv->lock);
+    kvlog_entry_t *entry = _find(kv, key);
+    if (entry) {
+        if (len > entry->len) {
+            len = entry->len;
+        }
+        res = _read(kv, entry->addr + sizeof(rec_hdr_t), buf, len);
+        if (res == 0) {
+            res = entry->len;
+        }
+    }
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int kvlog_set(kvlog_t *kv, uint16_t key, const void *val, size_t len)
+{
+    rec_hdr_t hdr = { .key = key, .len = len, .flags = 0 };
+    int res;
+
+    if ((key == KVLOG_KEY_INVALID) || (len >= KVLOG_KEY_INVALID) ||
+        (REC_SIZE(len) > kv->sector_size - HDR_SIZE)) {
+        return -E2BIG;
+    }
+
+    mutex_lock(&kv->lock);
+    kvlog_entry_t *entry = _find(kv, key);
+    if ((entry == NULL) && (kv->keys == KVLOG_KEYS_NUMOF)) {
+        res = -ENOMEM;
+    }
+    else if ((res = _make_room(kv, REC_SIZE(len))) == 0) {
+        res = _append(kv, &hdr, val, 0);
+    }
+    if (res >= 0) {
+        if (entry == NULL) {
+            entry = &kv->index[kv->keys++];
+            entry->key = key;
+        }
+        entry->len = len;
+        entry->addr = (uint32_t)res;
+        res = 0;
+    }
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int kvlog_delete(kvlog_t *kv, uint16_t key)
+{
+    rec_hdr_t hdr = { .key = key, .len = 0, .flags = FLAG_DELETED };
+    int res = -ENOENT;
+
+    mutex_lock(&kv->lock);
+    kvlog_entry_t *entry = _find(kv, key);
+    if (entry) {
+        /* the tombstone hides the older records until they are reclaimed */
+        if ((res = _make_room(kv, REC_SIZE(0))) == 0) {
+            res = _append(kv, &hdr, "", 0);
+        }
+        if (res >= 0) {
+            _remove(kv, entry);
+            res = 0;
+        }
+    }
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int kvlog_compact(kvlog_t *kv)
+{
+    int res = 0;
+
+    mutex_lock(&kv->lock);
+    if ((kv->free < KVLOG_FREE_SECTORS) && (kv->tail != kv->head)) {
+        res = _reclaim(kv);
+        if (res == 0) {
+            res = 1;
+        }
+    }
+    mutex_unlock(&kv->lock);
+    return res;
+}
+
+int kvlog_flush(kvlog_t *kv)
+{
+    int res = 0;
+
+    mutex_lock(&kv->lock);
+    if (kv->flush) {
+        res = kv->flush(kv->dev);
+    }
+    mutex_unlock(&kv->lock);
+    return res;
+}
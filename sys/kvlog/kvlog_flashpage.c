@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_kvlog
+ * @{
+ *
+ * @file
+ * @brief       NVRAM on flash pages for the key/value store
+ *
+ * The flash can only be written a page at a time, so the page written to is
+ * kept in RAM until a write goes to another page or the store is flushed.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "kvlog.h"
+
+#ifdef FLASHPAGE_SIZE
+#include "periph/flashpage.h"
+
+static int _flush(nvram_t *dev)
+{
+    kvlog_flashpage_t *fp = (kvlog_flashpage_t *)dev;
+
+    if (fp->page >= 0) {
+        if (flashpage_write_and_verify(fp->first + fp->page, fp->buf) !=
+            FLASHPAGE_OK) {
+            return -EIO;
+        }
+        fp->page = -1;
+    }
+    return 0;
+}
+
+static int _read(nvram_t *dev, uint8_t *dst, uint32_t src, size_t len)
+{
+    kvlog_flashpage_t *fp = (kvlog_flashpage_t *)dev;
+    int page = src / FLASHPAGE_SIZE;
+
+    /* the store never crosses a page boundary */
+    if (page == fp->page) {
+        memcpy(dst, fp->buf + (src % FLASHPAGE_SIZE), len);
+    }
+    else {
+        memcpy(dst, (uint8_t *)flashpage_addr(fp->first) + src, len);
+    }
+    return len;
+}
+
+static int _write(nvram_t *dev, const uint8_t *src, uint32_t dst, size_t len)
+{
+    kvlog_flashpage_t *fp = (kvlog_flashpage_t *)dev;
+    int page = dst / FLASHPAGE_SIZE;
+
+    if (page != fp->page) {
+        if (_flush(dev) < 0) {
+            return -EIO;
+        }
+        flashpage_read(fp->first + page, fp->buf);
+        fp->page = page;
+    }
+    memcpy(fp->buf + (dst % FLASHPAGE_SIZE), src, len);
+    return len;
+}
+
+int kvlog_init_flashpage(kvlog_t *kv, kvlog_flashpage_t *fp, uint8_t *buf,
+                         unsigned first, unsigned pages)
+{
+    int res;
+
+    fp->nvram.read = _read;
+    fp->nvram.write = _write;
+    fp->nvram.size = pages * FLASHPAGE_SIZE;
+    fp->nvram.extra = NULL;
+    fp->nvram.readv = NULL;
+    fp->nvram.writev = NULL;
+    fp->first = first;
+    fp->page = -1;
+    fp->buf = buf;
+
+    res = kvlog_init(kv, &fp->nvram, 0, FLASHPAGE_SIZE, pages);
+    kv->flush = _flush;
+    return res;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* FLASHPAGE_SIZE */
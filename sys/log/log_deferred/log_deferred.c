@@ -0,0 +1,399 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_log_deferred
+ * @{
+ *
+ * @file
+ * @brief       Deferred log module implementation
+ *
+ * A message is stored as a record_t header followed by the raw argument
+ * values in the order of the conversions in the format string. Both sides
+ * walk the format string with _next_conv() to know the type of each value.
+ *
+ * @}
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "log.h"
+#include "spscrb.h"
+#include "thread.h"
+#include "thread_flags.h"
+
+/**
+ * @brief   Stack size of the log thread
+ */
+#ifndef LOG_DEFERRED_STACKSIZE
+#define LOG_DEFERRED_STACKSIZE  (THREAD_STACKSIZE_DEFAULT + THREAD_EXTRA_STACKSIZE_PRINTF)
+#endif
+
+/**
+ * @brief   Priority of the log thread
+ */
+#ifndef LOG_DEFERRED_PRIO
+#define LOG_DEFERRED_PRIO       (THREAD_PRIORITY_MIN - 1)
+#endif
+
+#define FLAG_NEW                (0x1)
+/* longest conversion specification that is printed as a whole */
+#define CONV_MAX                (16U)
+
+typedef enum {
+    CONV_NONE,                  /* "%%" or unsupported, no argument */
+    CONV_INT,
+    CONV_LONG,
+    CONV_LLONG,
+    CONV_SIZE,
+    CONV_INTMAX,
+    CONV_PTRDIFF,
+    CONV_PTR,
+    CONV_DOUBLE,
+    CONV_LDOUBLE,
+    CONV_STR,
+} conv_type_t;
+
+typedef struct {
+    const char *start;          /* the '%' */
+    const char *end;            /* after the conversion character */
+    conv_type_t type;
+    uint8_t stars;              /* '*' width and precision, int arguments */
+} conv_t;
+
+typedef struct {
+    const char *format;
+    uint16_t len;               /* bytes of argument values following */
+    uint8_t level;
+} record_t;
+
+static uint8_t _buf[LOG_DEFERRED_BUF_SIZE];
+static spscrb_t _rb = SPSCRB_INIT(_buf, 1);
+static unsigned _dropped;
+static thread_t *_thread;
+static char _stack[LOG_DEFERRED_STACKSIZE];
+
+/* finds the next conversion in fmt, returns 0 if there is none */
+static int _next_conv(const char *fmt, conv_t *conv)
+{
+    unsigned longs = 0;
+
+    fmt = strchr(fmt, '%');
+    if (fmt == NULL) {
+        return 0;
+    }
+    conv->start = fmt++;
+    conv->stars = 0;
+    conv->type = CONV_INT;
+    for (; *fmt != '\0'; fmt++) {
+        switch (*fmt) {
+            case '*':
+                conv->stars++;
+                continue;
+            case 'l':
+                conv->type = (++longs == 1) ? CONV_LONG : CONV_LLONG;
+                continue;
+            case 'z':
+                conv->type = CONV_SIZE;
+                continue;
+            case 'j':
+                conv->type = CONV_INTMAX;
+                continue;
+            case 't':
+                conv->type = CONV_PTRDIFF;
+                continue;
+            case 'L':
+                conv->type = CONV_LDOUBLE;
+                continue;
+            case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+            case 'c':
+                break;
+            case 'p':
+                conv->type = CONV_PTR;
+                break;
+            case 's':
+                conv->type = CONV_STR;
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+            case 'a': case 'A':
+                if (conv->type != CONV_LDOUBLE) {
+                    conv->type = CONV_DOUBLE;
+                }
+                break;
+            default:
+                /* flags, width, precision and the hh and h modifiers need
+                 * no attention, as the promoted argument is an int */
+                if (strchr("-+ #0123456789.h", *fmt) != NULL) {
+                    continue;
+                }
+                conv->type = CONV_NONE;
+                conv->stars = 0;
+                break;
+        }
+        break;
+    }
+    if (*fmt == '\0') {
+        conv->type = CONV_NONE;
+        conv->stars = 0;
+        conv->end = fmt;
+    }
+    else {
+        conv->end = fmt + 1;
+    }
+    return 1;
+}
+
+#define PUT(type, promoted) \
+    do { \
+        type v = (type)va_arg(args, promoted); \
+        if ((pos + sizeof(v)) > sizeof(buf)) { \
+            goto out; \
+        } \
+        memcpy(&buf[pos], &v, sizeof(v)); \
+        pos += sizeof(v); \
+    } while (0)
+
+void log_write(unsigned level, const char *format, ...)
+{
+    uint8_t buf[LOG_DEFERRED_RECORD_MAX];
+    record_t rec = { .format = format, .level = level };
+    size_t pos = sizeof(rec);
+    conv_t conv;
+    va_list args;
+
+    va_start(args, format);
+    for (const char *fmt = format; _next_conv(fmt, &conv); fmt = conv.end) {
+        for (unsigned i = 0; i < conv.stars; i++) {
+            PUT(int, int);
+        }
+        switch (conv.type) {
+            case CONV_NONE:
+                break;
+            case CONV_INT:
+                PUT(int, int);
+                break;
+            case CONV_LONG:
+                PUT(long, long);
+                break;
+            case CONV_LLONG:
+                PUT(long long, long long);
+                break;
+            case CONV_SIZE:
+                PUT(size_t, size_t);
+                break;
+            case CONV_INTMAX:
+                PUT(intmax_t, intmax_t);
+                break;
+            case CONV_PTRDIFF:
+                PUT(ptrdiff_t, ptrdiff_t);
+                break;
+            case CONV_PTR:
+                PUT(void *, void *);
+                break;
+            case CONV_DOUBLE:
+                PUT(double, double);
+                break;
+            case CONV_LDOUBLE:
+                PUT(long double, long double);
+                break;
+            case CONV_STR: {
+                const char *str = va_arg(args, const char *);
+                size_t len;
+
+                if (str == NULL) {
+                    str = "(null)";
+                }
+                len = strlen(str);
+
+                if (pos >= sizeof(buf)) {
+                    goto out;
+                }
+                if (len > LOG_DEFERRED_STR_MAX) {
+                    len = LOG_DEFERRED_STR_MAX;
+                }
+                if (len > (sizeof(buf) - pos - 1)) {
+                    len = sizeof(buf) - pos - 1;
+                }
+                memcpy(&buf[pos], str, len);
+                pos += len;
+                buf[pos++] = '\0';
+                break;
+            }
+        }
+    }
+out:
+    va_end(args);
+
+    rec.len = pos - sizeof(rec);
+    memcpy(buf, &rec, sizeof(rec));
+
+    /* producers may be threads and ISRs, a record must be stored as a
+     * whole */
+    unsigned state = irq_disable();
+    if (spscrb_free(&_rb) >= pos) {
+        spscrb_put(&_rb, buf, pos);
+    }
+    else {
+        _dropped++;
+    }
+    irq_restore(state);
+
+    if (_thread != NULL) {
+        thread_flags_set(_thread, FLAG_NEW);
+    }
+}
+
+#define PRINT(type) \
+    do { \
+        type v; \
+        if ((pos + sizeof(v)) > end) { \
+            goto missing; \
+        } \
+        memcpy(&v, &buf[pos], sizeof(v)); \
+        pos += sizeof(v); \
+        switch (conv.stars) { \
+            case 0: printf(spec, v); break; \
+            case 1: printf(spec, stars[0], v); break; \
+            default: printf(spec, stars[0], stars[1], v); break; \
+        } \
+    } while (0)
+
+static void _print(const uint8_t *buf)
+{
+    record_t rec;
+    char spec[CONV_MAX + 1];
+    size_t pos = sizeof(rec);
+    size_t end;
+    const char *fmt;
+    conv_t conv;
+
+    memcpy(&rec, buf, sizeof(rec));
+    end = pos + rec.len;
+    for (fmt = rec.format; _next_conv(fmt, &conv); fmt = conv.end) {
+        int stars[2] = { 0, 0 };
+        size_t spec_len = conv.end - conv.start;
+
+        printf("%.*s", (int)(conv.start - fmt), fmt);
+        if ((spec_len == 2) && (conv.start[1] == '%')) {
+            putchar('%');
+            continue;
+        }
+        if ((conv.type == CONV_NONE) || (spec_len > CONV_MAX) ||
+            (conv.stars > 2)) {
+            /* nothing this module can print */
+            printf("%.*s", (int)spec_len, conv.start);
+            continue;
+        }
+        memcpy(spec, conv.start, spec_len);
+        spec[spec_len] = '\0';
+        for (unsigned i = 0; i < conv.stars; i++) {
+            if ((pos + sizeof(int)) > end) {
+                goto missing;
+            }
+            memcpy(&stars[i], &buf[pos], sizeof(int));
+            pos += sizeof(int);
+        }
+        switch (conv.type) {
+            case CONV_NONE:
+                break;
+            case CONV_INT:
+                PRINT(int);
+                break;
+            case CONV_LONG:
+                PRINT(long);
+                break;
+            case CONV_LLONG:
+                PRINT(long long);
+                break;
+            case CONV_SIZE:
+                PRINT(size_t);
+                break;
+            case CONV_INTMAX:
+                PRINT(intmax_t);
+                break;
+            case CONV_PTRDIFF:
+                PRINT(ptrdiff_t);
+                break;
+            case CONV_PTR:
+                PRINT(void *);
+                break;
+            case CONV_DOUBLE:
+                PRINT(double);
+                break;
+            case CONV_LDOUBLE:
+                PRINT(long double);
+                break;
+            case CONV_STR: {
+                const char *v = (const char *)&buf[pos];
+
+                if (pos >= end) {
+                    goto missing;
+                }
+                pos += strlen(v) + 1;
+                switch (conv.stars) {
+                    case 0: printf(spec, v); break;
+                    case 1: printf(spec, stars[0], v); break;
+                    default: printf(spec, stars[0], stars[1], v); break;
+                }
+                break;
+            }
+        }
+        continue;
+missing:
+        /* the value did not fit into the record */
+        putchar('?');
+    }
+    printf("%s", fmt);
+}
+
+static void *_log_thread(void *arg)
+{
+    static uint8_t buf[LOG_DEFERRED_RECORD_MAX];
+
+    (void)arg;
+    while (1) {
+        record_t rec;
+        unsigned dropped;
+
+        thread_flags_wait_any(FLAG_NEW);
+        /* this is the only consumer, so a complete record is available once
+         * its header is */
+        while (spscrb_avail(&_rb) >= sizeof(rec)) {
+            spscrb_get(&_rb, buf, sizeof(rec));
+            memcpy(&rec, buf, sizeof(rec));
+            spscrb_get(&_rb, &buf[sizeof(rec)], rec.len);
+            _print(buf);
+        }
+        /* the messages were dropped after the ones in the buffer */
+        unsigned state = irq_disable();
+        dropped = _dropped;
+        _dropped = 0;
+        irq_restore(state);
+        if (dropped) {
+            printf("[log: %u messages dropped]\n", dropped);
+        }
+    }
+    return NULL;
+}
+
+void log_deferred_init(void)
+{
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack), LOG_DEFERRED_PRIO,
+                                     THREAD_CREATE_WOUT_YIELD |
+                                     THREAD_CREATE_STACKTEST,
+                                     _log_thread, NULL, "log");
+
+    _thread = (thread_t *)sched_threads[pid];
+    /* messages logged before are waiting already */
+    thread_flags_set(_thread, FLAG_NEW);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_log_deferred Deferred log module
+ * @ingroup     sys
+ * @brief       Log module that formats messages in a low priority thread
+ *
+ * log_write() does not format the message. It only stores the address of the
+ * format string and the raw values of the arguments in a ring buffer, which
+ * is cheap enough for ISRs and network paths and does not block on the
+ * UART. A thread with the lowest priority above idle formats and prints the
+ * messages when nothing else has to be done.
+ *
+ * Strings passed for `%s` are copied, truncated to @ref LOG_DEFERRED_STR_MAX
+ * bytes. If a message does not fit into @ref LOG_DEFERRED_RECORD_MAX bytes,
+ * the arguments that did not fit are printed as `?`. If the ring buffer is
+ * full, the message is dropped and the number of dropped messages is printed
+ * with the next one.
+ *
+ * @note    Messages are printed in the order they were logged, but only when
+ *          the log thread gets to run. Messages logged right before a crash
+ *          may never be printed.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Deferred log module interface
+ */
+
+#ifndef LOG_MODULE_H
+#define LOG_MODULE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the ring buffer in bytes, must be a power of two
+ */
+#ifndef LOG_DEFERRED_BUF_SIZE
+#define LOG_DEFERRED_BUF_SIZE       (512U)
+#endif
+
+/**
+ * @brief   Maximum size of one stored message in bytes
+ *
+ * A buffer of this size is put on the stack of the caller of log_write().
+ */
+#ifndef LOG_DEFERRED_RECORD_MAX
+#define LOG_DEFERRED_RECORD_MAX     (64U)
+#endif
+
+/**
+ * @brief   Maximum number of bytes copied for a `%s` argument
+ */
+#ifndef LOG_DEFERRED_STR_MAX
+#define LOG_DEFERRED_STR_MAX        (24U)
+#endif
+
+/**
+ * @brief   Store a log message to be printed later
+ *
+ * @param[in] level     log level of the message
+ * @param[in] format    format string, must stay valid forever (i.e. be a
+ *                      string literal)
+ */
+void log_write(unsigned level, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief   Start the thread printing the messages
+ *
+ * Messages can be logged before, they are printed once the thread runs.
+ * Called by auto_init.
+ */
+void log_deferred_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOG_MODULE_H */
+/** @} */
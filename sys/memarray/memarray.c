@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_memarray
+ * @{
+ *
+ * @file
+ * @brief       Fixed-size block pool implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "irq.h"
+#include "memarray.h"
+
+static inline unsigned _lock(const memarray_t *mem)
+{
+    return (mem->flags & MEMARRAY_FLAG_IRQ_SAFE) ? irq_disable() : 0;
+}
+
+static inline void _unlock(const memarray_t *mem, unsigned state)
+{
+    if (mem->flags & MEMARRAY_FLAG_IRQ_SAFE) {
+        irq_restore(state);
+    }
+}
+
+void memarray_init(memarray_t *mem, void *data, size_t size, unsigned num,
+                   unsigned flags)
+{
+    assert(size >= sizeof(void *));
+    mem->data = data;
+    mem->free = NULL;
+    mem->size = size;
+    mem->num = num;
+    mem->unused = 0;
+    mem->used = 0;
+    mem->max_used = 0;
+    mem->flags = flags;
+}
+
+void *memarray_alloc(memarray_t *mem)
+{
+    unsigned state = _lock(mem);
+    void *res = mem->free;
+
+    if (res != NULL) {
+        /* the link may be unaligned for packed element types */
+        memcpy(&mem->free, res, sizeof(void *));
+    }
+    else if (mem->unused < mem->num) {
+        res = mem->data + (mem->unused++ * mem->size);
+    }
+    if (res != NULL) {
+        if (++mem->used > mem->max_used) {
+            mem->max_used = mem->used;
+        }
+    }
+    _unlock(mem, state);
+
+    return res;
+}
+
+void memarray_free(memarray_t *mem, void *ptr)
+{
+    assert(((uint8_t *)ptr >= mem->data) &&
+           ((uint8_t *)ptr < (mem->data + (mem->unused * mem->size))) &&
+           ((((uint8_t *)ptr - mem->data) % mem->size) == 0));
+
+    unsigned state = _lock(mem);
+
+    memcpy(ptr, &mem->free, sizeof(void *));
+    mem->free = ptr;
+    mem->used--;
+    _unlock(mem, state);
+}
@@ -18,6 +18,9 @@
  * @}
  */
 
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
 #include <string.h>
 #include "net/sntp.h"
 #include "net/ntp_packet.h"
@@ -34,9 +37,80 @@ static int64_t _sntp_offset = 0;
 static mutex_t _sntp_mutex = MUTEX_INIT;
 static ntp_packet_t _sntp_packet;
 
+/* system time of the last synchronization, the offset refers to it */
+static uint64_t _sntp_ref = 0;
+static int32_t _sntp_drift = 0;
+static uint32_t _sntp_interval = SNTP_INTERVAL_MIN;
+static bool _sntp_synced = false;
+static bool _sntp_drift_valid = false;
+
+static uint64_t _ntp_to_usec(const ntp_timestamp_t *ts)
+{
+    return ((uint64_t)byteorder_ntohl(ts->seconds) * SEC_IN_USEC) +
+           (((uint64_t)byteorder_ntohl(ts->fraction) * SEC_IN_USEC) >> 32);
+}
+
+/* offset at system time now, extrapolated by the drift; in milliseconds
+ * resolution to keep the product in range for long intervals */
+static int64_t _offset_at(uint64_t now)
+{
+    int64_t elapsed_ms = (int64_t)((now - _sntp_ref) / 1000);
+
+    return _sntp_offset + ((elapsed_ms * _sntp_drift) / 1000000);
+}
+
+static void _update(int64_t offset, uint64_t now)
+{
+    uint64_t elapsed = now - _sntp_ref;
+    int64_t diff = offset - _sntp_offset;
+    int64_t error = offset - _offset_at(now);
+
+    if (!_sntp_synced) {
+        _sntp_synced = true;
+    }
+    else if ((uint64_t)((diff < 0) ? -diff : diff) >
+             (elapsed / (1000000000L / SNTP_DRIFT_MAX))) {
+        /* a step of the server or of the system time, start over */
+        DEBUG("sntp: offset changed by %" PRIi32 " us, resetting drift\n",
+              (int32_t)diff);
+        _sntp_drift = 0;
+        _sntp_drift_valid = false;
+        _sntp_interval = SNTP_INTERVAL_MIN;
+    }
+    else if (elapsed >= SEC_IN_USEC) {
+        int32_t sample = (int32_t)((diff * 1000000) / (int64_t)(elapsed / 1000));
+
+        if (_sntp_drift_valid) {
+            /* a well predicted sample refines the estimate, otherwise the
+             * drift changed (e.g. with temperature) and is replaced */
+            if (((error < 0) ? -error : error) <= SNTP_ACCURACY) {
+                _sntp_drift += (sample - _sntp_drift) / 4;
+                if (_sntp_interval < SNTP_INTERVAL_MAX) {
+                    _sntp_interval *= 2;
+                }
+            }
+            else {
+                _sntp_drift = sample;
+                if (_sntp_interval > SNTP_INTERVAL_MIN) {
+                    _sntp_interval /= 2;
+                }
+            }
+        }
+        else {
+            _sntp_drift = sample;
+            _sntp_drift_valid = true;
+        }
+        DEBUG("sntp: error %" PRIi32 " us, drift %" PRIi32 " ppb, next in %"
+              PRIu32 " s\n", (int32_t)error, _sntp_drift, _sntp_interval);
+    }
+    _sntp_offset = offset;
+    _sntp_ref = now;
+}
+
 int sntp_sync(sock_udp_ep_t *server, uint32_t timeout)
 {
     int result;
+    uint64_t t1, t2, t3, t4;
 
     mutex_lock(&_sntp_mutex);
     if ((result = sock_udp_create(&_sntp_sock,
@@ -51,6 +125,7 @@ int sntp_sync(sock_udp_ep_t *server, uint32_t timeout)
     ntp_packet_set_vn(&_sntp_packet);
     ntp_packet_set_mode(&_sntp_packet, NTP_MODE_CLIENT);
 
+    t1 = xtimer_now_usec64();
     if ((result = (int)sock_udp_send(&_sntp_sock,
                                      &_sntp_packet,
                                      sizeof(_sntp_packet),
@@ -70,10 +145,21 @@ int sntp_sync(sock_udp_ep_t *server, uint32_t timeout)
         mutex_unlock(&_sntp_mutex);
         return result;
     }
+    t4 = xtimer_now_usec64();
     sock_udp_close(&_sntp_sock);
-    _sntp_offset = (byteorder_ntohl(_sntp_packet.transmit.seconds) * SEC_IN_USEC) +
-                   ((byteorder_ntohl(_sntp_packet.transmit.fraction) * 232)
-                   / 1000000) - xtimer_now64();
+    if ((result < (int)sizeof(_sntp_packet)) ||
+        (ntp_packet_get_mode(&_sntp_packet) != NTP_MODE_SERVER) ||
+        (_sntp_packet.stratum == 0) ||
+        (byteorder_ntohl(_sntp_packet.transmit.seconds) == 0)) {
+        DEBUG("Invalid or kiss-o'-death response\n");
+        mutex_unlock(&_sntp_mutex);
+        return -EBADMSG;
+    }
+    t2 = _ntp_to_usec(&_sntp_packet.receive);
+    t3 = _ntp_to_usec(&_sntp_packet.transmit);
+    /* RFC 5905, section 8: the server's processing time is not part of the
+     * round trip, half of the remaining round trip is the one-way delay */
+    _update((((int64_t)(t2 - t1)) + ((int64_t)(t3 - t4))) / 2, t4);
     mutex_unlock(&_sntp_mutex);
     return 0;
 }
@@ -83,7 +169,39 @@ int64_t sntp_get_offset(void)
     int64_t result;
 
     mutex_lock(&_sntp_mutex);
-    result = _sntp_offset;
+    result = _offset_at(xtimer_now_usec64());
+    mutex_unlock(&_sntp_mutex);
+    return result;
+}
+
+uint64_t sntp_get_time(void)
+{
+    uint64_t now;
+    int64_t offset;
+
+    mutex_lock(&_sntp_mutex);
+    now = xtimer_now_usec64();
+    offset = _offset_at(now);
+    mutex_unlock(&_sntp_mutex);
+    return now + offset;
+}
+
+int32_t sntp_get_drift(void)
+{
+    int32_t result;
+
+    mutex_lock(&_sntp_mutex);
+    result = _sntp_drift;
+    mutex_unlock(&_sntp_mutex);
+    return result;
+}
+
+uint32_t sntp_get_interval(void)
+{
+    uint32_t result;
+
+    mutex_lock(&_sntp_mutex);
+    result = _sntp_interval;
     mutex_unlock(&_sntp_mutex);
     return result;
 }
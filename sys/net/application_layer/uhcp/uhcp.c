@@ -14,7 +14,7 @@
 
 #include "net/uhcp.h"
 
-void uhcp_handle_udp(uint8_t *buf, size_t len, uint8_t *src, uint16_t port, uhcp_iface_t iface)
+int uhcp_handle_udp(uint8_t *buf, size_t len, uint8_t *src, uint16_t port, uhcp_iface_t iface)
 {
     char addr_str[INET6_ADDRSTRLEN];
     inet_ntop(AF_INET6, src, addr_str, INET6_ADDRSTRLEN);
@@ -22,14 +22,14 @@ void uhcp_handle_udp(uint8_t *buf, size_t len, uint8_t *src, uint16_t port, uhcp
 
     if (len < sizeof(uhcp_req_t)) {
         puts("error: packet too small.");
-        return;
+        return -1;
     }
 
     uhcp_hdr_t *hdr = (uhcp_hdr_t *)buf;
 
     if (! (ntohl(hdr->uhcp_magic) == UHCP_MAGIC)) {
         puts("error: wrong magic number.");
-        return;
+        return -1;
     }
 
     unsigned ver, type;
@@ -38,6 +38,7 @@ void uhcp_handle_udp(uint8_t *buf, size_t len, uint8_t *src, uint16_t port, uhcp
 
     if (ver != UHCP_VER) {
         puts("error: wrong protocol version.");
+        return -1;
     }
 
     switch(type) {
@@ -45,35 +46,36 @@ void uhcp_handle_udp(uint8_t *buf, size_t len, uint8_t *src, uint16_t port, uhcp
         case UHCP_REQ:
             if (len < sizeof(uhcp_req_t)) {
                 puts("error: request too small\n");
+                return -1;
             }
-            else {
-                uhcp_handle_req((uhcp_req_t*)hdr, src, port, iface);
-            }
-            break;
+            uhcp_handle_req((uhcp_req_t*)hdr, src, port, iface);
+            return 0;
 #endif
 #ifdef UHCP_CLIENT
         case UHCP_PUSH:
             {
                 uhcp_push_t *push = (uhcp_push_t*)hdr;
                 if ((len < sizeof(uhcp_push_t))
-                    || (len < (sizeof(uhcp_push_t) + (push->prefix_len >> 3)))
+                    || (push->prefix_len > 128)
+                    || (len < (sizeof(uhcp_push_t) + ((push->prefix_len + 7) >> 3)))
                    ) {
                     puts("error: request too small\n");
+                    return -1;
                 }
-                else {
-                    uhcp_handle_push(push, src, port, iface);
-                }
-                break;
+                uhcp_handle_push(push, src, port, iface);
+                return 0;
             }
 #endif
         default:
              puts("error: unexpected type\n");
+             return -1;
     }
 }
 
 #ifdef UHCP_SERVER
 extern char _prefix[16];
 extern unsigned _prefix_len;
+extern uint32_t _lease;
 void uhcp_handle_req(uhcp_req_t *req, uint8_t *src, uint16_t port, uhcp_iface_t iface)
 {
     size_t prefix_bytes = (_prefix_len + 7)>>3;
@@ -82,6 +84,8 @@ void uhcp_handle_req(uhcp_req_t *req, uint8_t *src, uint16_t port, uhcp_iface_t
     uhcp_push_t *reply = (uhcp_push_t *)packet;
     uhcp_hdr_set(&reply->hdr, UHCP_PUSH);
 
+    reply->lease = htonl(_lease);
+    reply->lifetime = htons(UHCP_LIFETIME);
     reply->prefix_len = _prefix_len;
     memcpy(reply->prefix, _prefix, prefix_bytes);
 
@@ -100,12 +104,15 @@ void uhcp_handle_push(uhcp_push_t *req, uint8_t *src, uint16_t port, uhcp_iface_
     inet_ntop(AF_INET6, src, addr_str, INET6_ADDRSTRLEN);
     uint8_t prefix[16];
     size_t prefix_bytes = (req->prefix_len + 7)>>3;
-    memset(prefix + 16 - prefix_bytes, '\0', 16 - prefix_bytes);
+    memset(prefix + prefix_bytes, '\0', 16 - prefix_bytes);
     memcpy(prefix, req->prefix, prefix_bytes);
 
     inet_ntop(AF_INET6, prefix, prefix_str, INET6_ADDRSTRLEN);
 
-    printf("uhcp: push from %s:%u prefix=%s/%u\n", addr_str, (unsigned)port, prefix_str, req->prefix_len);
-    uhcp_handle_prefix(prefix, req->prefix_len, 0xFFFF, src, iface);
+    printf("uhcp: push from %s:%u prefix=%s/%u lifetime=%u\n", addr_str,
+           (unsigned)port, prefix_str, req->prefix_len,
+           (unsigned)ntohs(req->lifetime));
+    uhcp_handle_prefix(prefix, req->prefix_len, ntohs(req->lifetime),
+                       ntohl(req->lease), src, iface);
 }
 #endif
@@ -7,6 +7,8 @@
  */
 
 #include <arpa/inet.h>
+#include <stdio.h>
+#include <string.h>
 
 #include "net/af.h"
 #include "net/sock/udp.h"
@@ -17,7 +19,9 @@
  * @brief Request prefix from uhcp server
  *
  * Never returns.
- * Calls @c uhcp_handle_prefix() when a prefix or prefix change is received.
+ * Calls @c uhcp_handle_prefix() when a prefix or prefix change is received,
+ * and with a lifetime of 0 when the lease expired without being renewed.
+ * The prefix is requested again after half of its lifetime.
  *
  * @param[in]   iface   interface to request prefix on
  */
@@ -26,7 +30,7 @@ void uhcp_client(uhcp_iface_t iface)
     sock_udp_t sock;
     sock_udp_ep_t local = { .family=AF_INET6, .port=UHCP_PORT, .netif=iface };
     sock_udp_ep_t req_target = { .family=AF_INET6, .port=UHCP_PORT, .netif=iface };
-    sock_udp_ep_t remote;
+    sock_udp_ep_t remote, server;
 
     inet_pton(AF_INET6, "ff15::abcd", req_target.addr.ipv6);
 
@@ -39,17 +43,41 @@ void uhcp_client(uhcp_iface_t iface)
     int res = sock_udp_create(&sock, &local, NULL, 0);
 
     uint8_t buf[sizeof(uhcp_push_t) + 16];
+    /* last push received, to withdraw its prefix once the lease expired */
+    uint8_t lease_buf[sizeof(uhcp_push_t) + 16];
+    uhcp_push_t *lease = (uhcp_push_t *)lease_buf;
+    uint64_t expires = 0;
 
     while(1) {
+        uint32_t wait = UHCP_RETRY;
+
         puts("uhcp_client(): sending REQ...");
         sock_udp_send(&sock, &req, sizeof(uhcp_req_t), &req_target);
-        res = sock_udp_recv(&sock, buf, sizeof(buf), 10U*SEC_IN_USEC, &remote);
-        if (res > 0) {
-            uhcp_handle_udp(buf, res, remote.addr.ipv6, remote.port, iface);
-            xtimer_sleep(60);
+        res = sock_udp_recv(&sock, buf, sizeof(buf), UHCP_RETRY * SEC_IN_USEC, &remote);
+        if ((res > 0) &&
+            (uhcp_handle_udp(buf, res, remote.addr.ipv6, remote.port, iface) == 0) &&
+            ((((uhcp_hdr_t *)buf)->ver_type & 0xF) == UHCP_PUSH)) {
+            uhcp_push_t *push = (uhcp_push_t *)buf;
+            uint16_t lifetime = ntohs(push->lifetime);
+
+            memcpy(lease_buf, buf, res);
+            server = remote;
+            expires = xtimer_now_usec64() + ((uint64_t)lifetime * SEC_IN_USEC);
+            if ((lifetime / 2) > wait) {
+                wait = lifetime / 2;
+            }
         }
         else {
             puts("uhcp_client(): no reply received");
+            if ((expires != 0) && (xtimer_now_usec64() >= expires)) {
+                puts("uhcp_client(): lease expired");
+                lease->lifetime = 0;
+                uhcp_handle_push(lease, server.addr.ipv6, server.port, iface);
+                expires = 0;
+            }
+            /* the receive timeout already was the retry delay */
+            continue;
         }
+        xtimer_sleep(wait);
     }
 }
@@ -14,15 +14,125 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
+#if defined(__SSE2__) && !defined(INET_CSUM_GENERIC)
+#include <emmintrin.h>
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* Adds the remaining words of buf (len < 16, even) in the CPU's byte order */
+static inline uint64_t _sum_tail(uint64_t sum, const uint8_t *buf, size_t len)
+{
+    uint32_t word;
+    uint16_t half;
+
+    for (; len >= 4; buf += 4, len -= 4) {
+        memcpy(&word, buf, sizeof(word));
+        sum += word;
+    }
+    if (len >= 2) {
+        memcpy(&half, buf, sizeof(half));
+        sum += half;
+    }
+    return sum;
+}
+
+/*
+ * Sums the 16-bit words of buf (len even) in the CPU's byte order.
+ *
+ * The one's complement sum does not depend on the byte order (RFC 1071,
+ * section 2 B), so the words are added as wide as possible with the carries
+ * collected in the upper bits and folded only once at the end.
+ */
+#if defined(__SSE2__) && !defined(INET_CSUM_GENERIC)
+static uint32_t _sum_words(const uint8_t *buf, size_t len)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero;
+    uint32_t lanes[4];
+    uint64_t sum;
+
+    /* each 32-bit lane takes two words per block, so it can not overflow
+     * for the at most 64 KiB of a checksum domain */
+    for (; len >= 16; buf += 16, len -= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)buf);
+
+        acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(v, zero));
+        acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(v, zero));
+    }
+    _mm_storeu_si128((__m128i *)lanes, acc);
+    sum = (uint64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    sum = _sum_tail(sum, buf, len);
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    return (uint32_t)((sum & 0xffffffff) + (sum >> 32));
+}
+#elif (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)) && \
+      !defined(INET_CSUM_GENERIC)
+static uint32_t _sum_words(const uint8_t *buf, size_t len)
+{
+    uint64_t sum = 0;
+
+    if (!((uintptr_t)buf & 1)) {
+        uint32_t acc = 0;
+
+        /* LDM needs word alignment */
+        if (((uintptr_t)buf & 2) && (len >= 2)) {
+            acc = *((const uint16_t *)buf);
+            buf += 2;
+            len -= 2;
+        }
+        /* add-with-carry chain, the carry of each block wraps around */
+        for (; len >= 16; len -= 16) {
+            __asm__ volatile (
+                "ldmia  %[p]!, {r2-r5}      \n"
+                "adds   %[s], %[s], r2      \n"
+                "adcs   %[s], %[s], r3      \n"
+                "adcs   %[s], %[s], r4      \n"
+                "adcs   %[s], %[s], r5      \n"
+                "adc    %[s], %[s], #0      \n"
+                : [s] "+r" (acc), [p] "+r" (buf)
+                :
+                : "r2", "r3", "r4", "r5", "cc", "memory"
+            );
+        }
+        sum = acc;
+    }
+    /* odd addresses take the unaligned loads of the tail */
+    for (; len >= 16; buf += 16, len -= 16) {
+        sum = _sum_tail(sum, buf, 16);
+    }
+    sum = _sum_tail(sum, buf, len);
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    return (uint32_t)((sum & 0xffffffff) + (sum >> 32));
+}
+#else
+static uint32_t _sum_words(const uint8_t *buf, size_t len)
+{
+    uint64_t sum = 0;
+
+    for (; len >= 16; buf += 16, len -= 16) {
+        uint32_t words[4];
+
+        memcpy(words, buf, sizeof(words));
+        sum += (uint64_t)words[0] + words[1] + words[2] + words[3];
+    }
+    sum = _sum_tail(sum, buf, len);
+    sum = (sum & 0xffffffff) + (sum >> 32);
+    return (uint32_t)((sum & 0xffffffff) + (sum >> 32));
+}
+#endif
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
+    uint32_t words;
 
     DEBUG("inet_sum: sum = 0x%04" PRIx16 ", len = %" PRIu16, sum, len);
 #if ENABLE_DEBUG
@@ -44,13 +154,18 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         accum_len++;
     }
 
-    for (int i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    words = _sum_words(buf, len & ~1U);
+    while (words >> 16) {
+        words = (words & 0xffff) + (words >> 16);
     }
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    /* words were added in the wrong byte order, which only swaps the sum */
+    words = byteorder_swaps((uint16_t)words);
+#endif
+    csum += words;
 
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
+    if (len & 1)                                    /* if accumulated length is odd */
+        csum += (uint16_t)(buf[len - 1] << 8);      /* add last byte as top half of 16-byte word */
 
     while (csum >> 16) {
         uint16_t carry = csum >> 16;
@@ -58,6 +58,11 @@ static const char *_netopt_strmap[] = {
     [NETOPT_ENCRYPTION]      = "NETOPT_ENCRYPTION",
     [NETOPT_ENCRYPTION_KEY]  = "NETOPT_ENCRYPTION_KEY",
     [NETOPT_RF_TESTMODE]     = "NETOPT_RF_TESTMODE",
+    [NETOPT_OFFLOADS]        = "NETOPT_OFFLOADS",
+    [NETOPT_CHANNEL_HOP]     = "NETOPT_CHANNEL_HOP",
+    [NETOPT_CHANNEL_HOP_ASN] = "NETOPT_CHANNEL_HOP_ASN",
+    [NETOPT_L2_GROUP]        = "NETOPT_L2_GROUP",
+    [NETOPT_L2_GROUP_LEAVE]  = "NETOPT_L2_GROUP_LEAVE",
     [NETOPT_NUMOF]           = "NETOPT_NUMOF",
 };
 
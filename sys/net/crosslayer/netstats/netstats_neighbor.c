@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "net/netstats/neighbor.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static netstats_nb_t *_find(const netstats_nb_table_t *table,
+                            const uint8_t *l2_addr, uint8_t l2_addr_len)
+{
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        const netstats_nb_t *entry = &table->entries[i];
+
+        if ((entry->l2_addr_len == l2_addr_len) &&
+            (memcmp(entry->l2_addr, l2_addr, l2_addr_len) == 0)) {
+            return (netstats_nb_t *)entry;
+        }
+    }
+    return NULL;
+}
+
+const netstats_nb_t *netstats_nb_get(const netstats_nb_table_t *table,
+                                     const uint8_t *l2_addr, uint8_t l2_addr_len)
+{
+    if ((l2_addr_len == 0) || (l2_addr_len > NETSTATS_NB_L2ADDR_MAX)) {
+        return NULL;
+    }
+    return _find(table, l2_addr, l2_addr_len);
+}
+
+void netstats_nb_record(netstats_nb_table_t *table, const uint8_t *l2_addr,
+                        uint8_t l2_addr_len)
+{
+    netstats_nb_t *entry;
+
+    if ((l2_addr_len == 0) || (l2_addr_len > NETSTATS_NB_L2ADDR_MAX)) {
+        table->pending = NULL;
+        return;
+    }
+    if ((entry = _find(table, l2_addr, l2_addr_len)) == NULL) {
+        entry = &table->entries[table->next];
+        DEBUG("netstats_nb: track new neighbor in entry %u\n",
+              (unsigned)table->next);
+        table->next = (table->next + 1) % NETSTATS_NB_SIZE;
+        memcpy(entry->l2_addr, l2_addr, l2_addr_len);
+        entry->l2_addr_len = l2_addr_len;
+        entry->etx = NETSTATS_NB_ETX_INIT;
+        entry->tx_success = 0;
+        entry->tx_failed = 0;
+    }
+    table->pending = entry;
+}
+
+void netstats_nb_update_tx(netstats_nb_table_t *table, bool success)
+{
+    netstats_nb_t *entry = table->pending;
+    uint32_t sample;
+
+    if (entry == NULL) {
+        return;
+    }
+    table->pending = NULL;
+    if (success) {
+        entry->tx_success++;
+        sample = NETSTATS_NB_ETX_DIVISOR;
+    }
+    else {
+        entry->tx_failed++;
+        sample = NETSTATS_NB_ETX_NOACK;
+    }
+    entry->etx = (uint16_t)((((uint32_t)entry->etx << NETSTATS_NB_ETX_SHIFT) -
+                             entry->etx + sample) >> NETSTATS_NB_ETX_SHIFT);
+}
+
+/** @} */
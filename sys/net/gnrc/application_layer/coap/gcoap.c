@@ -35,13 +35,70 @@ static int _register_port(gnrc_netreg_entry_t *netreg_port, uint16_t port);
 static void _receive(gnrc_pktsnip_t *pkt, ipv6_addr_t *src, uint16_t port);
 static size_t _send(gnrc_pktsnip_t *coap_snip, ipv6_addr_t *addr, uint16_t port);
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len);
-static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len);
-static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len);
-static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              unsigned opt, const gcoap_block_t *block);
+static size_t _put_block_option(uint8_t *buf, unsigned last_optnum,
+                                unsigned opt, const gcoap_block_t *block);
+static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                          ipv6_addr_t *src, uint16_t port);
+static ssize_t _handle_observe(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               ssize_t pdu_len, const coap_resource_t *resource,
+                               uint32_t obs_value, ipv6_addr_t *src,
+                               uint16_t port);
+static void _notify(gcoap_observable_t *observable);
+static size_t _put_option_hdr(uint8_t *buf, unsigned delta, unsigned len_nibble);
+static size_t _encode_uint(uint8_t *buf, uint32_t value);
+static int _next_option(uint8_t **bufpos, uint8_t *end, unsigned *optnum,
+                        uint8_t **value);
+static int _get_option(coap_pkt_t *pdu, unsigned opt, uint8_t **value);
+static int _get_option_uint(coap_pkt_t *pdu, unsigned opt, uint32_t *value);
+static ssize_t _insert_option(uint8_t *buf, size_t len, size_t max_len,
+                              unsigned opt, const uint8_t *val, size_t val_len);
+static ssize_t _add_observe_option(uint8_t *buf, size_t len, size_t max_len,
+                                   uint32_t seq);
+static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                           unsigned opt, const gcoap_block_t *block);
 static size_t _send_buf( uint8_t *buf, size_t len, ipv6_addr_t *src, uint16_t port);
 static void _expire_request(gcoap_request_memo_t *memo);
+static void _finish_memo(gcoap_request_memo_t *memo, unsigned state);
+static void _handle_empty(coap_pkt_t *pdu, ipv6_addr_t *src, uint16_t port);
+static void _send_empty(unsigned type, uint16_t id, ipv6_addr_t *addr,
+                        uint16_t port);
+static gcoap_request_memo_t *_find_con_memo(uint16_t id, const ipv6_addr_t *src);
+static void _end_con(gcoap_request_memo_t *memo, bool acked);
+static gcoap_dest_t *_get_dest(const ipv6_addr_t *addr, bool create);
+static uint32_t _first_timeout(gcoap_dest_t *dest);
+static uint32_t _backoff(const gcoap_dest_t *dest, uint32_t timeout);
+static uint8_t *_alloc_resend_buf(void);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                                                             uint8_t *buf, size_t len);
+#ifdef MODULE_GCOAP_CACHE
+/* Properties of a request its cached response depends on */
+typedef struct {
+    const gcoap_cacheable_t *cacheable;     /* resource, NULL if not cached */
+    uint32_t key;                           /* see gcoap_cache_entry_t::key */
+    bool has_etag;                          /* request has an ETag of ours */
+    uint8_t etag[GCOAP_CACHE_ETAG_LEN];     /* the ETag */
+} _cache_req_t;
+
+static void _cache_req(coap_pkt_t *pdu, const coap_resource_t *resource,
+                       _cache_req_t *req);
+static ssize_t _cache_lookup(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             const _cache_req_t *req);
+static ssize_t _cache_store(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            ssize_t pdu_len, const _cache_req_t *req);
+#endif
+
+#if GCOAP_OPT_INDEX_MAX
+/* Option of the PDU being received */
+typedef struct {
+    uint16_t num;           /* option number */
+    uint16_t offset;        /* offset of the value from the header */
+    uint16_t len;           /* length of the value */
+} _opt_entry_t;
+
+static void _index_options(coap_pkt_t *pdu);
+#endif
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -54,6 +111,23 @@ static gcoap_listener_t _default_listener = {
     NULL
 };
 
+#if GCOAP_OPT_INDEX_MAX
+/* Options of the PDU being received, hdr is NULL if not indexed */
+static struct {
+    const coap_hdr_t *hdr;
+    unsigned numof;
+    _opt_entry_t opts[GCOAP_OPT_INDEX_MAX];
+} _opt_index;
+#endif
+
+#ifdef MODULE_GCOAP_CACHE
+/* /.well-known/core only changes when a listener is registered */
+static gcoap_cacheable_t _default_cacheable = {
+    .resource = &_default_resources[0],
+    .max_age  = 3600,
+};
+#endif
+
 static gcoap_state_t _coap_state = {
     .netreg_port = GNRC_NETREG_ENTRY_INIT_PID(0, KERNEL_PID_UNDEF),
     .listeners   = &_default_listener,
@@ -106,6 +180,10 @@ static void *_event_loop(void *arg)
                 _expire_request((gcoap_request_memo_t *)msg_rcvd.content.ptr);
                 break;
 
+            case GCOAP_NETAPI_MSG_TYPE_NOTIFY:
+                _notify((gcoap_observable_t *)msg_rcvd.content.ptr);
+                break;
+
             default:
                 break;
         }
@@ -134,25 +212,53 @@ static void _receive(gnrc_pktsnip_t *pkt, ipv6_addr_t *src, uint16_t port)
         /* If a response, can't clear memo, but it will timeout later. */
         goto exit;
     }
+    /* without payload, the options end at the end of the PDU */
+    if (pdu.payload_len == 0) {
+        pdu.payload = buf + pkt_size;
+    }
+#if GCOAP_OPT_INDEX_MAX
+    _index_options(&pdu);
+#endif
 
+    /* empty message, i.e. ACK or RST for a confirmable request */
+    if (pdu.hdr->code == 0) {
+        _handle_empty(&pdu, src, port);
+    }
     /* incoming request */
-    if (coap_get_code_class(&pdu) == COAP_CLASS_REQ) {
+    else if (coap_get_code_class(&pdu) == COAP_CLASS_REQ) {
+        unsigned type = coap_get_type(&pdu);
+
         if (pkt->size > sizeof(buf)) {
+            /* tell the client the block size for a block-wise transfer */
+            gcoap_block_t block = { .num = 0, .szx = GCOAP_BLOCK_SZX };
+
             DEBUG("gcoap: request too big: %u\n", pkt->size);
-            pdu_len = gcoap_response(&pdu, buf, sizeof(buf),
-                                           COAP_CODE_REQUEST_ENTITY_TOO_LARGE);
+            gcoap_resp_init(&pdu, buf, sizeof(buf),
+                            COAP_CODE_REQUEST_ENTITY_TOO_LARGE);
+            pdu_len = gcoap_block_finish(&pdu, 0, COAP_FORMAT_NONE,
+                                         GCOAP_OPT_BLOCK1, &block);
         } else {
-            pdu_len = _handle_req(&pdu, buf, sizeof(buf));
+            pdu_len = _handle_req(&pdu, buf, sizeof(buf), src, port);
         }
         if (pdu_len > 0) {
+            /* piggyback the response on the ACK of a confirmable request */
+            if (type == COAP_TYPE_CON) {
+                gcoap_hdr_set_type((coap_hdr_t *)buf, COAP_TYPE_ACK);
+            }
             _send_buf(buf, pdu_len, src, port);
         }
     }
     /* incoming response */
     else {
         _find_req_memo(&memo, &pdu, buf, sizeof(buf));
+        /* a confirmable separate response must be acknowledged */
+        if (coap_get_type(&pdu) == COAP_TYPE_CON) {
+            _send_empty(memo ? COAP_TYPE_ACK : COAP_TYPE_RST, coap_get_id(&pdu),
+                        src, port);
+        }
         if (memo) {
             xtimer_remove(&memo->response_timer);
+            _end_con(memo, true);
             if (pkt->size > sizeof(buf)) {
                 memo->state = GCOAP_MEMO_ERR;
                 DEBUG("gcoap: response too big: %u\n", pkt->size);
@@ -163,6 +269,9 @@ static void _receive(gnrc_pktsnip_t *pkt, ipv6_addr_t *src, uint16_t port)
     }
 
 exit:
+#if GCOAP_OPT_INDEX_MAX
+    _opt_index.hdr = NULL;
+#endif
     gnrc_pktbuf_release(pkt);
 }
 
@@ -171,53 +280,393 @@ exit:
  *
  * Caller must finish the PDU and send it.
  */
-static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                          ipv6_addr_t *src, uint16_t port)
 {
     unsigned method_flag = coap_method2flag(coap_get_code_detail(pdu));
+    coap_resource_t *resource = gcoap_find_resource((char *)&pdu->url[0],
+                                                    method_flag);
 
-    /* Find path for CoAP msg among listener resources and execute callback. */
-    gcoap_listener_t *listener = _coap_state.listeners;
-    while (listener) {
-        coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
-            }
-            if (! (resource->methods & method_flag)) {
-                continue;
-            }
+    if (!resource) {
+        return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
+    }
 
-            int res = strcmp((char *)&pdu->url[0], resource->path);
-            if (res > 0) {
-                continue;
-            }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
-                break;
-            }
-            else {
-                ssize_t pdu_len = resource->handler(pdu, buf, len);
-                if (pdu_len < 0) {
-                    pdu_len = gcoap_response(pdu, buf, len,
-                                             COAP_CODE_INTERNAL_SERVER_ERROR);
+    /* read before the handler overwrites the request */
+    uint32_t obs_value;
+    int has_obs = _get_option_uint(pdu, GCOAP_OPT_OBSERVE, &obs_value);
+
+#ifdef MODULE_GCOAP_CACHE
+    _cache_req_t cache_req = { .cacheable = NULL };
+
+    if (method_flag == COAP_GET) {
+        _cache_req(pdu, resource, &cache_req);
+        ssize_t cached_len = _cache_lookup(pdu, buf, len, &cache_req);
+        if (cached_len > 0) {
+            return cached_len;
+        }
+    }
+#endif
+
+    ssize_t pdu_len = resource->handler(pdu, buf, len);
+    if (pdu_len < 0) {
+        pdu_len = gcoap_response(pdu, buf, len,
+                                 COAP_CODE_INTERNAL_SERVER_ERROR);
+    }
+    else if ((has_obs > 0) && (method_flag == COAP_GET)) {
+        pdu_len = _handle_observe(pdu, buf, len, pdu_len, resource,
+                                  obs_value, src, port);
+    }
+#ifdef MODULE_GCOAP_CACHE
+    else if (method_flag == COAP_GET) {
+        pdu_len = _cache_store(pdu, buf, len, pdu_len, &cache_req);
+    }
+    else if (coap_get_code_class(pdu) == COAP_CLASS_SUCCESS) {
+        /* the request may have changed the resource */
+        gcoap_cache_invalidate(resource);
+    }
+#endif
+    return pdu_len;
+}
+
+/*
+ * Registers or deregisters the sender of a request with Observe option.
+ *
+ * pdu_len is the length of the response the handler wrote. Returns the length
+ * of the response, with Observe option if the sender is registered.
+ */
+static ssize_t _handle_observe(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               ssize_t pdu_len, const coap_resource_t *resource,
+                               uint32_t obs_value, ipv6_addr_t *src,
+                               uint16_t port)
+{
+    gcoap_observable_t *observable = _coap_state.observables;
+    gcoap_observe_memo_t *observer = NULL;
+
+    while (observable && (observable->resource != resource)) {
+        observable = observable->next;
+    }
+    if (!observable) {
+        /* not observable, answer like a plain GET */
+        return pdu_len;
+    }
+    /* the same endpoint replaces its registration */
+    for (int i = 0; i < GCOAP_OBS_CLIENTS_MAX; i++) {
+        gcoap_observe_memo_t *memo = &_coap_state.observers[i];
+
+        if ((memo->observable == observable) && (memo->port == port) &&
+            ipv6_addr_equal(&memo->addr, src)) {
+            observer = memo;
+            break;
+        }
+        if (!memo->observable && !observer) {
+            observer = memo;
+        }
+    }
+
+    if (obs_value == 1) {
+        /* deregister */
+        if (observer && (observer->observable == observable)) {
+            observer->observable = NULL;
+        }
+        return pdu_len;
+    }
+    if ((obs_value != 0) || (coap_get_code_class(pdu) != COAP_CLASS_SUCCESS)) {
+        return pdu_len;
+    }
+    if (!observer) {
+        DEBUG("gcoap: no space for observer\n");
+        return pdu_len;
+    }
+
+    ssize_t obs_len = _add_observe_option(buf, pdu_len, len, observable->seq);
+    if (obs_len < 0) {
+        return pdu_len;
+    }
+    observer->observable = observable;
+    observer->addr       = *src;
+    observer->port       = port;
+    observer->token_len  = coap_get_token_len(pdu);
+    memcpy(observer->token, pdu->token, observer->token_len);
+    DEBUG("gcoap: registered observer for %s\n", resource->path);
+    return obs_len;
+}
+
+/*
+ * Sends a notification to the observers of a resource, or defers it to the end
+ * of the minimum notification interval.
+ *
+ * The response is built only once, without token, and copied for each
+ * observer with its own token.
+ */
+static void _notify(gcoap_observable_t *observable)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    uint32_t now = xtimer_now_usec();
+    uint32_t since = now - observable->last_notify;
+    ssize_t pdu_len;
+    size_t hdr_len;
+
+    if (since < observable->min_interval) {
+        /* later triggers are covered by the pending notification */
+        if (!observable->pending) {
+            observable->pending                = true;
+            observable->notify_msg.type        = GCOAP_NETAPI_MSG_TYPE_NOTIFY;
+            observable->notify_msg.content.ptr = (char *)observable;
+            xtimer_set_msg(&observable->notify_timer,
+                           observable->min_interval - since,
+                           &observable->notify_msg, _pid);
+        }
+        return;
+    }
+    observable->pending = false;
+#ifdef MODULE_GCOAP_CACHE
+    /* the resource changed */
+    gcoap_cache_invalidate(observable->resource);
+#endif
+    if (!gcoap_obs_count(observable)) {
+        return;
+    }
+
+    /* let the handler answer a GET without token */
+    pdu.hdr = (coap_hdr_t *)buf;
+    hdr_len = coap_build_hdr(pdu.hdr, COAP_TYPE_NON, NULL, 0, COAP_METHOD_GET, 0);
+    memset(pdu.url, 0, NANOCOAP_URL_MAX);
+    strncpy((char *)pdu.url, observable->resource->path, NANOCOAP_URL_MAX - 1);
+    pdu.payload      = buf + hdr_len;
+    pdu.payload_len  = 0;
+    pdu.content_type = COAP_FORMAT_NONE;
+    pdu_len = observable->resource->handler(&pdu, buf, sizeof(buf));
+    if (pdu_len > 0) {
+        pdu_len = _add_observe_option(buf, pdu_len, sizeof(buf), ++observable->seq);
+    }
+    if (pdu_len <= 0) {
+        DEBUG("gcoap: unable to build notification for %s\n",
+              observable->resource->path);
+        return;
+    }
+    observable->last_notify = now;
+
+    bool failed = (coap_get_code_class(&pdu) != COAP_CLASS_SUCCESS);
+    unsigned code = (coap_get_code_class(&pdu) << 5) | coap_get_code_detail(&pdu);
+
+    for (int i = 0; i < GCOAP_OBS_CLIENTS_MAX; i++) {
+        gcoap_observe_memo_t *observer = &_coap_state.observers[i];
+        gnrc_pktsnip_t *snip;
+
+        if (observer->observable != observable) {
+            continue;
+        }
+        snip = gnrc_pktbuf_add(NULL, NULL, pdu_len + observer->token_len,
+                               GNRC_NETTYPE_UNDEF);
+        if (snip) {
+            size_t len = coap_build_hdr((coap_hdr_t *)snip->data, COAP_TYPE_NON,
+                                        observer->token, observer->token_len,
+                                        code, ++_coap_state.last_message_id);
+
+            memcpy((uint8_t *)snip->data + len, buf + hdr_len, pdu_len - hdr_len);
+            _send(snip, &observer->addr, observer->port);
+        }
+        /* an error ends the observation */
+        if (failed) {
+            observer->observable = NULL;
+        }
+    }
+}
+
+#ifdef MODULE_GCOAP_CACHE
+/* FNV-1a hash */
+static uint32_t _cache_hash(uint32_t hash, const uint8_t *data, size_t len)
+{
+    while (len--) {
+        hash = (hash ^ *data++) * 16777619U;
+    }
+    return hash;
+}
+
+/*
+ * Reads the properties of a GET request its cached response depends on.
+ *
+ * Leaves req->cacheable NULL, if the response must not be taken from or put
+ * into the cache.
+ */
+static void _cache_req(coap_pkt_t *pdu, const coap_resource_t *resource,
+                       _cache_req_t *req)
+{
+    const gcoap_cacheable_t *cacheable = _coap_state.cacheables;
+    uint8_t *bufpos = (uint8_t *)pdu->hdr + coap_get_total_hdr_len(pdu);
+    uint8_t *end = (pdu->payload_len) ? pdu->payload - 1 : pdu->payload;
+    unsigned optnum = 0;
+    uint8_t *val;
+    int val_len;
+
+    while (cacheable && (cacheable->resource != resource)) {
+        cacheable = cacheable->next;
+    }
+    if (!cacheable) {
+        return;
+    }
+
+    req->key      = 2166136261U;
+    req->has_etag = false;
+    while ((val_len = _next_option(&bufpos, end, &optnum, &val)) >= 0) {
+        uint8_t sep[2] = { optnum, val_len };
+
+        switch (optnum) {
+            case GCOAP_OPT_ETAG:
+                if (!req->has_etag && (val_len == GCOAP_CACHE_ETAG_LEN)) {
+                    memcpy(req->etag, val, GCOAP_CACHE_ETAG_LEN);
+                    req->has_etag = true;
                 }
-                return pdu_len;
-            }
+                break;
+            case GCOAP_OPT_URI_QUERY:
+            case GCOAP_OPT_ACCEPT:
+                req->key = _cache_hash(req->key, sep, sizeof(sep));
+                req->key = _cache_hash(req->key, val, val_len);
+                break;
+            case GCOAP_OPT_OBSERVE:
+            case GCOAP_OPT_BLOCK2:
+                /* always up to the handler */
+                return;
+            default:
+                break;
         }
-        listener = listener->next;
     }
-    /* resource not found */
-    return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
+    if (val_len == -ENOENT) {
+        req->cacheable = cacheable;
+    }
+}
+
+/*
+ * Writes a cached response behind the header and token of the request, with
+ * ETag and the remaining Max-Age. Only the options are written for 2.03.
+ *
+ * Returns the length of the response, or < 0 if it does not fit.
+ */
+static ssize_t _cache_respond(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              const gcoap_cache_entry_t *entry, bool valid,
+                              uint64_t now)
+{
+    size_t pdu_len = coap_get_total_hdr_len(pdu);
+    uint8_t max_age[4];
+    size_t max_age_len;
+    ssize_t res;
+
+    /* ETag and Max-Age with the headers of both and of the next option */
+    if (pdu_len + entry->len + 2 * 3 + GCOAP_CACHE_ETAG_LEN + sizeof(max_age) > len) {
+        return -ENOBUFS;
+    }
+    max_age_len = _encode_uint(max_age, (entry->expires - now + SEC_IN_USEC - 1)
+                                        / SEC_IN_USEC);
+    if (valid) {
+        coap_hdr_set_code(pdu->hdr, GCOAP_CODE_VALID);
+    }
+    else {
+        coap_hdr_set_code(pdu->hdr, entry->code);
+        memcpy(buf + pdu_len, entry->data, entry->len);
+        pdu_len += entry->len;
+    }
+    res = _insert_option(buf, pdu_len, len, GCOAP_OPT_ETAG, entry->etag,
+                         GCOAP_CACHE_ETAG_LEN);
+    if (res > 0) {
+        res = _insert_option(buf, res, len, GCOAP_OPT_MAX_AGE, max_age,
+                             max_age_len);
+    }
+    return res;
 }
 
+/*
+ * Answers a GET request from the cache.
+ *
+ * Returns the length of the response, or 0 if it is not in the cache.
+ */
+static ssize_t _cache_lookup(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             const _cache_req_t *req)
+{
+    uint64_t now = xtimer_now_usec64();
+
+    if (!req->cacheable) {
+        return 0;
+    }
+    for (int i = 0; i < GCOAP_CACHE_ENTRIES; i++) {
+        gcoap_cache_entry_t *entry = &_coap_state.cache[i];
+
+        if ((entry->cacheable != req->cacheable) || (entry->key != req->key)) {
+            continue;
+        }
+        if (now >= entry->expires) {
+            entry->cacheable = NULL;
+            return 0;
+        }
+        bool valid = req->has_etag &&
+                     !memcmp(req->etag, entry->etag, GCOAP_CACHE_ETAG_LEN);
+        ssize_t res = _cache_respond(pdu, buf, len, entry, valid, now);
+        return (res > 0) ? res : 0;
+    }
+    return 0;
+}
+
+/*
+ * Puts a response to a GET request into the cache, replacing the entry that
+ * expires first if the cache is full.
+ *
+ * Returns the length of the response, which gets ETag and Max-Age options
+ * if it has been cached.
+ */
+static ssize_t _cache_store(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            ssize_t pdu_len, const _cache_req_t *req)
+{
+    gcoap_cache_entry_t *entry = NULL;
+    size_t hdr_len = coap_get_total_hdr_len(pdu);
+    uint64_t now = xtimer_now_usec64();
+    uint32_t etag;
+
+    if (!req->cacheable || (pdu_len - hdr_len > GCOAP_CACHE_DATA_SIZE) ||
+        (coap_get_code_class(pdu) != COAP_CLASS_SUCCESS) ||
+        (coap_get_code_detail(pdu) != (COAP_CODE_CONTENT & 0x1f))) {
+        return pdu_len;
+    }
+    for (int i = 0; i < GCOAP_CACHE_ENTRIES; i++) {
+        gcoap_cache_entry_t *tmp = &_coap_state.cache[i];
+
+        if (!tmp->cacheable || ((tmp->cacheable == req->cacheable) &&
+                                (tmp->key == req->key))) {
+            entry = tmp;
+            break;
+        }
+        if (!entry || (tmp->expires < entry->expires)) {
+            entry = tmp;
+        }
+    }
+
+    entry->cacheable = req->cacheable;
+    entry->key       = req->key;
+    entry->expires   = now + (uint64_t)req->cacheable->max_age * SEC_IN_USEC;
+    entry->code      = COAP_CODE_CONTENT;
+    entry->len       = pdu_len - hdr_len;
+    memcpy(entry->data, buf + hdr_len, entry->len);
+    /* the same content keeps its ETag, so renewed responses still validate */
+    etag = _cache_hash(2166136261U, entry->data, entry->len);
+    for (unsigned i = 0; i < GCOAP_CACHE_ETAG_LEN; i++) {
+        entry->etag[i] = etag >> (i * 8);
+    }
+
+    bool valid = req->has_etag &&
+                 !memcmp(req->etag, entry->etag, GCOAP_CACHE_ETAG_LEN);
+    ssize_t res = _cache_respond(pdu, buf, len, entry, valid, now);
+    return (res > 0) ? res : pdu_len;
+}
+#endif
+
 /*
  * Finishes handling a PDU -- write options and reposition payload.
  *
  * Returns the size of the PDU within the buffer, or < 0 on error.
  */
-static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                           unsigned opt, const gcoap_block_t *block)
 {
-    ssize_t hdr_len = _write_options(pdu, buf, len);
+    ssize_t hdr_len = _write_options(pdu, buf, len, opt, block);
     DEBUG("gcoap: header length: %u\n", hdr_len);
 
     if (hdr_len > 0) {
@@ -233,67 +682,326 @@ static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len)
     }
 }
 
+/*
+ * Gets the home slot of a token in the _coap_state.open_reqs table.
+ *
+ * Tokens are random, so their first bytes distribute well.
+ */
+static unsigned _memo_hash(const uint8_t *token, size_t token_len)
+{
+    uint32_t hash = 0;
+
+    memcpy(&hash, token, (token_len < sizeof(hash)) ? token_len : sizeof(hash));
+    return hash % GCOAP_REQ_WAITING_MAX;
+}
+
 /*
  * Finds the memo for an outstanding request within the _coap_state.open_reqs
- * array. Matches on token.
+ * table. Matches on token.
+ *
+ * A memo is stored at the home slot of its token or in one of the
+ * _coap_state.memo_max_probe following slots, so only those are searched.
  *
  * src_pdu Source for the match token
  */
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
                                                             uint8_t *buf, size_t len)
 {
-    gcoap_request_memo_t *memo;
-    coap_pkt_t memo_pdu = { .token = NULL };
+    size_t token_len = coap_get_token_len(src_pdu);
+    unsigned slot = _memo_hash(src_pdu->token, token_len);
     (void) buf;
     (void) len;
 
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED)
-            continue;
+    for (unsigned i = 0; i <= _coap_state.memo_max_probe; i++) {
+        gcoap_request_memo_t *memo = &_coap_state.open_reqs[slot];
+        coap_pkt_t memo_pdu = { .hdr = (coap_hdr_t *)&memo->hdr_buf[0] };
 
-        /* setup memo PDU from memo header */
-        memo                 = &_coap_state.open_reqs[i];
-        coap_hdr_t *memo_hdr = (coap_hdr_t *) &memo->hdr_buf[0];
-        memo_pdu.hdr         = memo_hdr;
-        if (coap_get_token_len(&memo_pdu)) {
-            memo_pdu.token = &memo_hdr->data[0];
+        slot = (slot + 1) % GCOAP_REQ_WAITING_MAX;
+        if (memo->state == GCOAP_MEMO_UNUSED) {
+            continue;
         }
         /* match on token */
-        if (coap_get_token_len(src_pdu) == coap_get_token_len(&memo_pdu)) {
-            uint8_t *src_byte  = src_pdu->token;
-            uint8_t *memo_byte = memo_pdu.token;
-            size_t j;
-            for (j = 0; j < coap_get_token_len(src_pdu); j++) {
-                if (*src_byte++ != *memo_byte++) {
-                    break;      /* token mismatch */
-                }
-            }
-            if (j == coap_get_token_len(src_pdu)) {
-                *memo_ptr = memo;
-            }
+        if ((coap_get_token_len(&memo_pdu) == token_len) &&
+            (memcmp(&memo_pdu.hdr->data[0], src_pdu->token, token_len) == 0)) {
+            *memo_ptr = memo;
+            return;
         }
     }
 }
 
-/* Calls handler callback on receipt of a timeout message. */
-static void _expire_request(gcoap_request_memo_t *memo)
+/* Calls the handler of a request without response and frees the memo. */
+static void _finish_memo(gcoap_request_memo_t *memo, unsigned state)
 {
     coap_pkt_t req;
 
+    memo->state = state;
+    /* Pass response to handler */
+    if (memo->resp_handler) {
+        req.hdr = (coap_hdr_t *)&memo->hdr_buf[0];   /* for reference */
+        /* the memo holds no options */
+        req.payload = &memo->hdr_buf[0] + coap_get_total_hdr_len(&req);
+        req.payload_len = 0;
+        memo->resp_handler(memo->state, &req);
+    }
+    memo->state = GCOAP_MEMO_UNUSED;
+}
+
+/*
+ * Retransmits a confirmable request, or calls handler callback on receipt of
+ * a timeout message.
+ */
+static void _expire_request(gcoap_request_memo_t *memo)
+{
     DEBUG("coap: received timeout message\n");
-    if (memo->state == GCOAP_MEMO_WAIT) {
-        memo->state = GCOAP_MEMO_TIMEOUT;
-        /* Pass response to handler */
-        if (memo->resp_handler) {
-            req.hdr = (coap_hdr_t *)&memo->hdr_buf[0];   /* for reference */
-            memo->resp_handler(memo->state, &req);
+    if (memo->state != GCOAP_MEMO_WAIT) {
+        /* Response already handled; timeout must have fired while response */
+        /* was in queue. */
+        return;
+    }
+    if (memo->msg_buf && (memo->retransmits < GCOAP_MAX_RETRANSMIT)) {
+        gcoap_dest_t *dest = memo->dest;
+
+        memo->retransmits++;
+        memo->timeout = _backoff(dest, memo->timeout);
+        dest->retransmissions++;
+        DEBUG("gcoap: retransmission %u, next timeout %" PRIu32 " usec\n",
+              memo->retransmits, memo->timeout);
+        /* a failed send counts like a lost message */
+        _send_buf(memo->msg_buf, memo->msg_len, &dest->addr, memo->port);
+        xtimer_set_msg(&memo->response_timer, memo->timeout,
+                                              &memo->timeout_msg, _pid);
+        return;
+    }
+    if (memo->msg_buf) {
+        memo->dest->timeouts++;
+    }
+    _end_con(memo, false);
+    _finish_memo(memo, GCOAP_MEMO_TIMEOUT);
+}
+
+/*
+ * Handles an empty message: an ACK or RST for a confirmable request, or a
+ * ping.
+ */
+static void _handle_empty(coap_pkt_t *pdu, ipv6_addr_t *src, uint16_t port)
+{
+    unsigned type = coap_get_type(pdu);
+    gcoap_request_memo_t *memo;
+
+    if (type == COAP_TYPE_CON) {
+        /* a ping is answered with a RST, RFC 7252, section 4.3 */
+        _send_empty(COAP_TYPE_RST, coap_get_id(pdu), src, port);
+        return;
+    }
+    memo = _find_con_memo(coap_get_id(pdu), src);
+    if (!memo) {
+        return;
+    }
+    xtimer_remove(&memo->response_timer);
+    _end_con(memo, true);
+    if (type == COAP_TYPE_RST) {
+        DEBUG("gcoap: request rejected\n");
+        _finish_memo(memo, GCOAP_MEMO_ERR);
+    }
+    else if (GCOAP_NON_TIMEOUT > 0) {
+        /* wait for the separate response */
+        xtimer_set_msg(&memo->response_timer, GCOAP_NON_TIMEOUT,
+                                              &memo->timeout_msg, _pid);
+    }
+}
+
+/* Sends an empty ACK or RST for the message with ID id. */
+static void _send_empty(unsigned type, uint16_t id, ipv6_addr_t *addr,
+                        uint16_t port)
+{
+    uint8_t buf[sizeof(coap_hdr_t)];
+    ssize_t len = coap_build_hdr((coap_hdr_t *)buf, type, NULL, 0, 0, id);
+
+    if (len > 0) {
+        _send_buf(buf, len, addr, port);
+    }
+}
+
+/* Finds the confirmable request from src awaiting an ACK with message ID id. */
+static gcoap_request_memo_t *_find_con_memo(uint16_t id, const ipv6_addr_t *src)
+{
+    for (unsigned i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
+        coap_pkt_t memo_pdu = { .hdr = (coap_hdr_t *)&memo->hdr_buf[0] };
+
+        if ((memo->state == GCOAP_MEMO_WAIT) && memo->msg_buf &&
+            (coap_get_id(&memo_pdu) == id) &&
+            ipv6_addr_equal(&memo->dest->addr, src)) {
+            return memo;
         }
-        memo->state = GCOAP_MEMO_UNUSED;
+    }
+    return NULL;
+}
+
+#ifdef MODULE_GCOAP_COCOA
+/** Upper bound of the RTO of a destination, in usec */
+#define COCOA_RTO_MAX       (60U * SEC_IN_USEC)
+
+/* Updates a smoothed RTT and its variation like RFC 6298, section 2. */
+static void _update_rtt(uint32_t *srtt, uint32_t *rttvar, uint32_t rtt)
+{
+    if (*srtt == 0) {
+        *srtt = rtt;
+        *rttvar = rtt / 2;
     }
     else {
-        /* Response already handled; timeout must have fired while response */
-        /* was in queue. */
+        uint32_t err = (rtt > *srtt) ? (rtt - *srtt) : (*srtt - rtt);
+
+        *rttvar = (3 * *rttvar + err) / 4;
+        *srtt = (7 * *srtt + rtt) / 8;
+    }
+}
+
+/*
+ * Updates the RTO of a destination with the RTT of an acknowledged request,
+ * see draft-ietf-core-cocoa, section 4.2.
+ *
+ * A request sent once gives a strong estimate. The RTT of a retransmitted
+ * request is measured from the first transmission, as it is not known which
+ * transmission was acknowledged, and only weakly changes the RTO.
+ */
+static void _update_rto(gcoap_dest_t *dest, const gcoap_request_memo_t *memo)
+{
+    uint32_t now = xtimer_now_usec();
+    uint32_t rtt = now - memo->sent_first;
+
+    if (memo->retransmits == 0) {
+        _update_rtt(&dest->srtt_strong, &dest->rttvar_strong, rtt);
+        dest->rto = (dest->rto + dest->srtt_strong
+                     + 4 * dest->rttvar_strong) / 2;
+    }
+    else if (memo->retransmits <= 2) {
+        _update_rtt(&dest->srtt_weak, &dest->rttvar_weak, rtt);
+        dest->rto = (3 * dest->rto + dest->srtt_weak + dest->rttvar_weak) / 4;
     }
+    else {
+        /* too ambiguous */
+        return;
+    }
+    if (dest->rto > COCOA_RTO_MAX) {
+        dest->rto = COCOA_RTO_MAX;
+    }
+    dest->rto_updated = now;
+    DEBUG("gcoap: RTT %" PRIu32 ", RTO %" PRIu32 " usec\n", rtt, dest->rto);
+}
+#endif
+
+/* Ends the retransmission of a confirmable request, if it is one. */
+static void _end_con(gcoap_request_memo_t *memo, bool acked)
+{
+    if (!memo->msg_buf) {
+        return;
+    }
+#ifdef MODULE_GCOAP_COCOA
+    if (acked) {
+        _update_rto(memo->dest, memo);
+    }
+#else
+    (void)acked;
+#endif
+    memo->dest->outstanding--;
+    memo->dest = NULL;
+    memo->msg_buf = NULL;
+}
+
+/*
+ * Finds the transmission state of a destination. If create is set, a new
+ * entry replaces an unused one or the least recently used one without
+ * outstanding requests.
+ */
+static gcoap_dest_t *_get_dest(const ipv6_addr_t *addr, bool create)
+{
+    gcoap_dest_t *unused = NULL, *oldest = NULL;
+
+    for (unsigned i = 0; i < GCOAP_DEST_MAX; i++) {
+        gcoap_dest_t *dest = &_coap_state.dests[i];
+
+        if (ipv6_addr_is_unspecified(&dest->addr)) {
+            unused = dest;
+        }
+        else if (ipv6_addr_equal(&dest->addr, addr)) {
+            return dest;
+        }
+        else if ((dest->outstanding == 0) &&
+                 (!oldest || ((int32_t)(dest->last_used - oldest->last_used) < 0))) {
+            oldest = dest;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    if (unused) {
+        oldest = unused;
+    }
+    if (oldest) {
+        memset(oldest, 0, sizeof(*oldest));
+        oldest->addr = *addr;
+        oldest->rto = GCOAP_ACK_TIMEOUT;
+    }
+    return oldest;
+}
+
+/* Gets the first retransmission timeout of a request to a destination. */
+static uint32_t _first_timeout(gcoap_dest_t *dest)
+{
+#ifdef MODULE_GCOAP_COCOA
+    /* let an RTO that has not been updated for long return to the default,
+     * draft-ietf-core-cocoa, section 4.3 */
+    uint32_t idle = xtimer_now_usec() - dest->rto_updated;
+
+    if ((dest->rto < SEC_IN_USEC) && (idle > 16 * dest->rto)) {
+        dest->rto *= 2;
+        dest->rto_updated += idle;
+    }
+    else if ((dest->rto > 3U * SEC_IN_USEC) && (idle > 4 * dest->rto)) {
+        dest->rto = (dest->rto + GCOAP_ACK_TIMEOUT) / 2;
+        dest->rto_updated += idle;
+    }
+#endif
+    return dest->rto + random_uint32() % (dest->rto / 100 * GCOAP_ACK_RANDOM_PERCENT + 1);
+}
+
+/* Gets the timeout of the next retransmission. */
+static uint32_t _backoff(const gcoap_dest_t *dest, uint32_t timeout)
+{
+#ifdef MODULE_GCOAP_COCOA
+    /* variable backoff, draft-ietf-core-cocoa, section 4.4 */
+    if (dest->rto < SEC_IN_USEC) {
+        return timeout * 3;
+    }
+    if (dest->rto > 3U * SEC_IN_USEC) {
+        return timeout + timeout / 2;
+    }
+#else
+    (void)dest;
+#endif
+    return timeout * 2;
+}
+
+/* Finds a buffer no confirmable request uses. */
+static uint8_t *_alloc_resend_buf(void)
+{
+    for (unsigned i = 0; i < GCOAP_RESEND_BUFS_MAX; i++) {
+        uint8_t *resend_buf = &_coap_state.resend_bufs[i][0];
+        bool used = false;
+
+        for (unsigned j = 0; j < GCOAP_REQ_WAITING_MAX; j++) {
+            if ((_coap_state.open_reqs[j].state != GCOAP_MEMO_UNUSED) &&
+                (_coap_state.open_reqs[j].msg_buf == resend_buf)) {
+                used = true;
+                break;
+            }
+        }
+        if (!used) {
+            return resend_buf;
+        }
+    }
+    return NULL;
 }
 
 /* Registers receive/send port with GNRC registry. */
@@ -406,12 +1114,299 @@ static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t le
     return gcoap_finish(pdu, bufpos - pdu->payload, COAP_FORMAT_LINK);
 }
 
+/*
+ * Writes a Block1 or Block2 option.
+ *
+ * Returns length of the option.
+ */
+static size_t _put_block_option(uint8_t *buf, unsigned last_optnum,
+                                unsigned opt, const gcoap_block_t *block)
+{
+    uint32_t value = (block->num << 4) | (block->more << 3) | block->szx;
+    uint8_t val[4];
+    /* value is an unsigned integer of minimal length, so at most 3 bytes */
+    size_t val_len = _encode_uint(val, value);
+    size_t hdr_len = _put_option_hdr(buf, opt - last_optnum, val_len);
+
+    memcpy(buf + hdr_len, val, val_len);
+    return hdr_len + val_len;
+}
+
+/*
+ * Reads the extended delta or length of an option, if any.
+ *
+ * Returns the value, or -1 if the option is malformed.
+ */
+static int _get_option_ext(uint8_t **bufpos, uint8_t *end, unsigned nibble)
+{
+    uint8_t *pos = *bufpos;
+
+    switch (nibble) {
+        case 13:
+            if (pos + 1 > end) {
+                return -1;
+            }
+            *bufpos = pos + 1;
+            return pos[0] + 13;
+        case 14:
+            if (pos + 2 > end) {
+                return -1;
+            }
+            *bufpos = pos + 2;
+            return ((pos[0] << 8) | pos[1]) + 269;
+        case 15:
+            return -1;
+        default:
+            return nibble;
+    }
+}
+
+/*
+ * Writes the header of an option, without extended length.
+ *
+ * Returns length of the header.
+ */
+static size_t _put_option_hdr(uint8_t *buf, unsigned delta, unsigned len_nibble)
+{
+    if (delta < 13) {
+        buf[0] = (delta << 4) | len_nibble;
+        return 1;
+    }
+    else if (delta < 269) {
+        buf[0] = (13 << 4) | len_nibble;
+        buf[1] = delta - 13;
+        return 2;
+    }
+    buf[0] = (14 << 4) | len_nibble;
+    buf[1] = (delta - 269) >> 8;
+    buf[2] = (delta - 269) & 0xff;
+    return 3;
+}
+
+/*
+ * Encodes an unsigned integer option value of minimal length.
+ *
+ * Returns length of the value, at most 4.
+ */
+static size_t _encode_uint(uint8_t *buf, uint32_t value)
+{
+    size_t len = 0;
+
+    for (uint32_t tmp = value; tmp; tmp >>= 8) {
+        len++;
+    }
+    for (size_t i = len; i > 0; i--) {
+        *buf++ = value >> ((i - 1) * 8);
+    }
+    return len;
+}
+
+/*
+ * Reads the option at *bufpos and advances *bufpos to the next one. Adds the
+ * delta of the option to *optnum.
+ *
+ * Returns the length of the value, -ENOENT at the end of the options, or
+ * -EBADMSG if the option is malformed.
+ */
+static int _next_option(uint8_t **bufpos, uint8_t *end, unsigned *optnum,
+                        uint8_t **value)
+{
+    uint8_t *pos = *bufpos;
+    int delta, val_len;
+
+    if ((pos >= end) || (*pos == GCOAP_PAYLOAD_MARKER)) {
+        return -ENOENT;
+    }
+    pos++;
+    delta = _get_option_ext(&pos, end, **bufpos >> 4);
+    val_len = _get_option_ext(&pos, end, **bufpos & 0xf);
+    if ((delta < 0) || (val_len < 0) || (pos + val_len > end)) {
+        return -EBADMSG;
+    }
+    *optnum += delta;
+    *value   = pos;
+    *bufpos  = pos + val_len;
+    return val_len;
+}
+
+/*
+ * Finds the first option opt of a received PDU.
+ *
+ * Returns the length of the value, -ENOENT if not found, or -EBADMSG on
+ * malformed options.
+ */
+static int _get_option(coap_pkt_t *pdu, unsigned opt, uint8_t **value)
+{
+    uint8_t *bufpos = (uint8_t *)pdu->hdr + coap_get_total_hdr_len(pdu);
+    /* options end at the payload marker */
+    uint8_t *end = (pdu->payload_len) ? pdu->payload - 1 : pdu->payload;
+    unsigned optnum = 0;
+    int res;
+
+#if GCOAP_OPT_INDEX_MAX
+    if (_opt_index.hdr == pdu->hdr) {
+        for (unsigned i = 0; i < _opt_index.numof; i++) {
+            const _opt_entry_t *entry = &_opt_index.opts[i];
+
+            if (entry->num == opt) {
+                *value = (uint8_t *)pdu->hdr + entry->offset;
+                return entry->len;
+            }
+            if (entry->num > opt) {
+                break;
+            }
+        }
+        return -ENOENT;
+    }
+#endif
+    while ((res = _next_option(&bufpos, end, &optnum, value)) >= 0) {
+        if (optnum == opt) {
+            return res;
+        }
+        if (optnum > opt) {
+            /* options are ordered by number */
+            break;
+        }
+    }
+    return (res == -EBADMSG) ? res : -ENOENT;
+}
+
+/*
+ * Reads an option with an unsigned integer value from a received PDU.
+ *
+ * Returns 1 if found, 0 if not found, or -EBADMSG on malformed options.
+ */
+static int _get_option_uint(coap_pkt_t *pdu, unsigned opt, uint32_t *value)
+{
+    uint8_t *val;
+    int val_len = _get_option(pdu, opt, &val);
+
+    if (val_len == -ENOENT) {
+        return 0;
+    }
+    if ((val_len < 0) || (val_len > 4)) {
+        return -EBADMSG;
+    }
+    *value = 0;
+    for (int i = 0; i < val_len; i++) {
+        *value = (*value << 8) | val[i];
+    }
+    return 1;
+}
+
+#if GCOAP_OPT_INDEX_MAX
+/*
+ * Records the options of a received PDU in _opt_index, in the pass that also
+ * validates them. Leaves the PDU unindexed if the options are malformed or
+ * too many, so lookups scan and report the error.
+ */
+static void _index_options(coap_pkt_t *pdu)
+{
+    uint8_t *bufpos = (uint8_t *)pdu->hdr + coap_get_total_hdr_len(pdu);
+    uint8_t *end = (pdu->payload_len) ? pdu->payload - 1 : pdu->payload;
+    unsigned optnum = 0;
+    uint8_t *value;
+    int res;
+
+    _opt_index.hdr = NULL;
+    _opt_index.numof = 0;
+    while ((res = _next_option(&bufpos, end, &optnum, &value)) >= 0) {
+        if (_opt_index.numof == GCOAP_OPT_INDEX_MAX) {
+            return;
+        }
+        _opt_entry_t *entry = &_opt_index.opts[_opt_index.numof++];
+
+        entry->num    = optnum;
+        entry->offset = value - (uint8_t *)pdu->hdr;
+        entry->len    = res;
+    }
+    if (res == -ENOENT) {
+        _opt_index.hdr = pdu->hdr;
+    }
+}
+#endif
+
+/*
+ * Inserts an option into a finished PDU, after the options with lower or equal
+ * numbers. The value must be shorter than 13 bytes.
+ *
+ * Returns the new length of the PDU, -ENOBUFS if it does not fit, or -EBADMSG
+ * on malformed options.
+ */
+static ssize_t _insert_option(uint8_t *buf, size_t len, size_t max_len,
+                              unsigned opt, const uint8_t *val, size_t val_len)
+{
+    coap_pkt_t pdu = { .hdr = (coap_hdr_t *)buf };
+    uint8_t *pos = buf + coap_get_total_hdr_len(&pdu);
+    uint8_t *end = buf + len;
+    uint8_t *rest;
+    uint8_t opts[3 + 12 + 3];
+    size_t opts_len;
+    unsigned optnum = 0;
+
+    assert(val_len < 13);
+    while (1) {
+        uint8_t *next = pos;
+        unsigned num = optnum;
+        uint8_t *tmp;
+        int res = _next_option(&next, end, &num, &tmp);
+
+        if (res == -EBADMSG) {
+            return res;
+        }
+        if ((res < 0) || (num > opt)) {
+            break;
+        }
+        pos    = next;
+        optnum = num;
+    }
+    opts_len = _put_option_hdr(opts, opt - optnum, val_len);
+    memcpy(&opts[opts_len], val, val_len);
+    opts_len += val_len;
+
+    /* the delta of the following option now is relative to the new one */
+    rest = pos;
+    if ((pos < end) && (*pos != GCOAP_PAYLOAD_MARKER)) {
+        unsigned len_nibble = *pos & 0xf;
+
+        rest = pos + 1;
+        unsigned delta = _get_option_ext(&rest, end, *pos >> 4);
+        opts_len += _put_option_hdr(&opts[opts_len], optnum + delta - opt,
+                                    len_nibble);
+    }
+
+    if ((pos - buf) + opts_len + (end - rest) > max_len) {
+        return -ENOBUFS;
+    }
+    memmove(pos + opts_len, rest, end - rest);
+    memcpy(pos, opts, opts_len);
+    return (pos - buf) + opts_len + (end - rest);
+}
+
+/*
+ * Adds an Observe option to a finished response PDU.
+ *
+ * Returns the new length of the PDU, or -ENOBUFS if it does not fit.
+ */
+static ssize_t _add_observe_option(uint8_t *buf, size_t len, size_t max_len,
+                                   uint32_t seq)
+{
+    uint8_t val[4];
+
+    /* Observe is a 24 bit sequence number */
+    return _insert_option(buf, len, max_len, GCOAP_OPT_OBSERVE, val,
+                          _encode_uint(val, seq & 0xffffff));
+}
+
 /*
  * Creates CoAP options and sets payload marker, if any.
  *
+ * Writes the Block option opt, if block is not NULL.
+ *
  * Returns length of header + options, or -EINVAL on illegal path.
  */
-static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              unsigned opt, const gcoap_block_t *block)
 {
     uint8_t last_optnum = 0;
     (void)len;
@@ -433,8 +1428,14 @@ static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len)
     /* Content-Format */
     if (pdu->content_type != COAP_FORMAT_NONE) {
         bufpos += coap_put_option_ct(bufpos, last_optnum, pdu->content_type);
-        /* uncomment when add an option after Content-Format */
-        /* last_optnum = COAP_OPT_CONTENT_FORMAT; */
+        last_optnum = COAP_OPT_CONTENT_FORMAT;
+    }
+
+    /* Block1 or Block2 */
+    if (block) {
+        bufpos += _put_block_option(bufpos, last_optnum, opt, block);
+        /* uncomment when add an option after the Block option */
+        /* last_optnum = opt; */
     }
 
     /* write payload marker */
@@ -464,10 +1465,49 @@ kernel_pid_t gcoap_init(void)
     memset(&_coap_state.open_reqs[0], 0, sizeof(_coap_state.open_reqs));
     /* randomize initial value */
     _coap_state.last_message_id = random_uint32() & 0xFFFF;
+#ifdef MODULE_GCOAP_CACHE
+    gcoap_register_cacheable(&_default_cacheable);
+#endif
 
     return _pid;
 }
 
+coap_resource_t *gcoap_find_resource(const char *path, unsigned method_flag)
+{
+    for (gcoap_listener_t *listener = _coap_state.listeners; listener;
+         listener = listener->next) {
+        /* resources expected in alphabetical order */
+        size_t lo = 0, hi = listener->resources_len;
+
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            int res = strcmp(path, listener->resources[mid].path);
+
+            if (res > 0) {
+                lo = mid + 1;
+            }
+            else if (res < 0) {
+                hi = mid;
+            }
+            else {
+                /* entries of the same path may differ in their methods */
+                while ((mid > 0) &&
+                       !strcmp(path, listener->resources[mid - 1].path)) {
+                    mid--;
+                }
+                for (; (mid < listener->resources_len) &&
+                       !strcmp(path, listener->resources[mid].path); mid++) {
+                    if (listener->resources[mid].methods & method_flag) {
+                        return &listener->resources[mid];
+                    }
+                }
+                break;
+            }
+        }
+    }
+    return NULL;
+}
+
 void gcoap_register_listener(gcoap_listener_t *listener)
 {
     /* Add the listener to the end of the linked list. */
@@ -477,6 +1517,50 @@ void gcoap_register_listener(gcoap_listener_t *listener)
 
     listener->next = NULL;
     _last->next = listener;
+#ifdef MODULE_GCOAP_CACHE
+    gcoap_cache_invalidate(&_default_resources[0]);
+#endif
+}
+
+void gcoap_register_observable(gcoap_observable_t *observable)
+{
+    observable->seq         = 0;
+    observable->pending     = false;
+    /* allow the first notification at once */
+    observable->last_notify = xtimer_now_usec() - observable->min_interval;
+    observable->next        = _coap_state.observables;
+    _coap_state.observables = observable;
+}
+
+#ifdef MODULE_GCOAP_CACHE
+void gcoap_register_cacheable(gcoap_cacheable_t *cacheable)
+{
+    cacheable->next = _coap_state.cacheables;
+    _coap_state.cacheables = cacheable;
+}
+
+void gcoap_cache_invalidate(const coap_resource_t *resource)
+{
+    for (int i = 0; i < GCOAP_CACHE_ENTRIES; i++) {
+        gcoap_cache_entry_t *entry = &_coap_state.cache[i];
+
+        if (entry->cacheable && (entry->cacheable->resource == resource)) {
+            entry->cacheable = NULL;
+        }
+    }
+}
+#endif
+
+int gcoap_obs_notify(gcoap_observable_t *observable)
+{
+    msg_t msg;
+
+    if (_pid == KERNEL_PID_UNDEF) {
+        return -ENOTCONN;
+    }
+    msg.type        = GCOAP_NETAPI_MSG_TYPE_NOTIFY;
+    msg.content.ptr = (char *)observable;
+    return (msg_try_send(&msg, _pid) == 1) ? 0 : -ENOBUFS;
 }
 
 int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
@@ -518,42 +1602,88 @@ int gcoap_req_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code,
 }
 
 ssize_t gcoap_finish(coap_pkt_t *pdu, size_t payload_len, unsigned format)
+{
+    return gcoap_block_finish(pdu, payload_len, format, 0, NULL);
+}
+
+ssize_t gcoap_block_finish(coap_pkt_t *pdu, size_t payload_len, unsigned format,
+                           unsigned opt, const gcoap_block_t *block)
 {
     /* reconstruct full PDU buffer length */
     size_t len = pdu->payload_len + (pdu->payload - (uint8_t *)pdu->hdr);
 
     pdu->content_type = format;
     pdu->payload_len  = payload_len;
-    return _finish_pdu(pdu, (uint8_t *)pdu->hdr, len);
+    return _finish_pdu(pdu, (uint8_t *)pdu->hdr, len, opt, block);
 }
 
 size_t gcoap_req_send(uint8_t *buf, size_t len, ipv6_addr_t *addr, uint16_t port,
                                                  gcoap_resp_handler_t resp_handler)
 {
     gcoap_request_memo_t *memo = NULL;
+    coap_pkt_t pdu = { .hdr = (coap_hdr_t *)buf };
+    gcoap_dest_t *dest = NULL;
+    uint8_t *resend_buf = NULL;
+    uint32_t timeout = GCOAP_NON_TIMEOUT;
     assert(resp_handler != NULL);
 
-    /* Find empty slot in list of open requests. */
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
-            memo = &_coap_state.open_reqs[i];
+    if (coap_get_type(&pdu) == COAP_TYPE_CON) {
+        dest = _get_dest(addr, true);
+        if (!dest || (dest->outstanding >= GCOAP_NSTART)) {
+            DEBUG("gcoap: dropping request; too many outstanding\n");
+            return 0;
+        }
+        resend_buf = _alloc_resend_buf();
+        if (!resend_buf || (len > GCOAP_PDU_BUF_SIZE)) {
+            DEBUG("gcoap: dropping request; no space for retransmission\n");
+            return 0;
+        }
+    }
+
+    /* Find empty slot in table of open requests, starting at the home slot
+     * of the token. */
+    unsigned slot = _memo_hash(&pdu.hdr->data[0], coap_get_token_len(&pdu));
+    for (unsigned i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+        if (_coap_state.open_reqs[slot].state == GCOAP_MEMO_UNUSED) {
+            memo = &_coap_state.open_reqs[slot];
             memo->state = GCOAP_MEMO_WAIT;
+            if (i > _coap_state.memo_max_probe) {
+                _coap_state.memo_max_probe = i;
+            }
             break;
         }
+        slot = (slot + 1) % GCOAP_REQ_WAITING_MAX;
     }
     if (memo) {
         memcpy(&memo->hdr_buf[0], buf, GCOAP_HEADER_MAXLEN);
         memo->resp_handler = resp_handler;
+        memo->msg_buf = NULL;
+        if (dest) {
+            /* keep the request until it is acknowledged */
+            memcpy(resend_buf, buf, len);
+            memo->msg_buf = resend_buf;
+            memo->msg_len = len;
+            memo->dest = dest;
+            memo->port = port;
+            memo->retransmits = 0;
+            memo->timeout = _first_timeout(dest);
+            memo->sent_first = xtimer_now_usec();
+            timeout = memo->timeout;
+            dest->last_used = memo->sent_first;
+            dest->outstanding++;
+            dest->con_sent++;
+        }
 
         size_t res = _send_buf(buf, len, addr, port);
-        if (res && (GCOAP_NON_TIMEOUT > 0)) {
+        if (res && (timeout > 0)) {
             /* start response wait timer */
             memo->timeout_msg.type        = GCOAP_NETAPI_MSG_TYPE_TIMEOUT;
             memo->timeout_msg.content.ptr = (char *)memo;
-            xtimer_set_msg(&memo->response_timer, GCOAP_NON_TIMEOUT,
+            xtimer_set_msg(&memo->response_timer, timeout,
                                                   &memo->timeout_msg, _pid);
         }
         else if (!res) {
+            _end_con(memo, false);
             memo->state = GCOAP_MEMO_UNUSED;
         }
         return res;
@@ -563,9 +1693,21 @@ size_t gcoap_req_send(uint8_t *buf, size_t len, ipv6_addr_t *addr, uint16_t port
     }
 }
 
+const gcoap_dest_t *gcoap_dest_get(const ipv6_addr_t *addr)
+{
+    return _get_dest(addr, false);
+}
+
 int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
 {
-    /* Assume NON type request, so response type is the same. */
+#if GCOAP_OPT_INDEX_MAX
+    /* the response overwrites the options */
+    if (_opt_index.hdr == pdu->hdr) {
+        _opt_index.hdr = NULL;
+    }
+#endif
+    /* Response type is the same as a NON request; the response to a CON
+     * request is turned into an ACK when sent. */
     coap_hdr_set_code(pdu->hdr, code);
     /* Create message ID since NON? */
 
@@ -579,6 +1721,101 @@ int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
     return 0;
 }
 
+int gcoap_get_uint(coap_pkt_t *pdu, unsigned opt, uint32_t *value)
+{
+    return _get_option_uint(pdu, opt, value);
+}
+
+int gcoap_get_block(coap_pkt_t *pdu, unsigned opt, gcoap_block_t *block)
+{
+    uint32_t value;
+    int res = _get_option_uint(pdu, opt, &value);
+
+    block->num  = 0;
+    block->szx  = GCOAP_BLOCK_SZX;
+    block->more = false;
+    if (res <= 0) {
+        return res;
+    }
+    /* szx 7 is reserved */
+    if ((value & 0x7) == 7) {
+        return -EBADMSG;
+    }
+    block->num  = value >> 4;
+    block->more = (value & 0x8);
+    block->szx  = value & 0x7;
+    if (block->szx > GCOAP_BLOCK_SZX) {
+        /* same offset in smaller blocks */
+        block->num <<= block->szx - GCOAP_BLOCK_SZX;
+        block->szx = GCOAP_BLOCK_SZX;
+    }
+    return 1;
+}
+
+ssize_t gcoap_block2_respond(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             unsigned format, gcoap_block_reader_t reader,
+                             void *arg)
+{
+    gcoap_block_t block;
+    size_t block_size;
+    ssize_t read_len;
+
+    if (gcoap_get_block(pdu, GCOAP_OPT_BLOCK2, &block) < 0) {
+        return gcoap_response(pdu, buf, len, COAP_CODE_BAD_REQUEST);
+    }
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+
+    /* the reader is asked for one byte more to know if more blocks follow;
+     * a smaller block keeps the offset */
+    while ((gcoap_block_size(&block) >= pdu->payload_len) && (block.szx > 0)) {
+        block.szx--;
+        block.num <<= 1;
+    }
+    block_size = gcoap_block_size(&block);
+    if (block_size >= pdu->payload_len) {
+        return -ENOBUFS;
+    }
+    read_len = reader(arg, gcoap_block_offset(&block), pdu->payload,
+                      block_size + 1);
+    if (read_len < 0) {
+        return read_len;
+    }
+    block.more = ((size_t)read_len > block_size);
+    if (block.more) {
+        read_len = block_size;
+    }
+    return gcoap_block_finish(pdu, read_len, format, GCOAP_OPT_BLOCK2, &block);
+}
+
+ssize_t gcoap_block1_respond(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             unsigned code, gcoap_block_writer_t writer,
+                             void *arg)
+{
+    gcoap_block_t block;
+    int res;
+
+    int has_block = gcoap_get_block(pdu, GCOAP_OPT_BLOCK1, &block);
+    if (has_block < 0) {
+        return gcoap_response(pdu, buf, len, COAP_CODE_BAD_REQUEST);
+    }
+    res = writer(arg, gcoap_block_offset(&block), pdu->payload,
+                 pdu->payload_len, block.more);
+    if (res == -EINVAL) {
+        return gcoap_response(pdu, buf, len,
+                              GCOAP_CODE_REQUEST_ENTITY_INCOMPLETE);
+    }
+    else if (res < 0) {
+        return res;
+    }
+
+    gcoap_resp_init(pdu, buf, len, (block.more) ? GCOAP_CODE_CONTINUE : code);
+    if (!has_block) {
+        return gcoap_finish(pdu, 0, COAP_FORMAT_NONE);
+    }
+    /* block.szx already is the size wanted for the following blocks */
+    return gcoap_block_finish(pdu, 0, COAP_FORMAT_NONE, GCOAP_OPT_BLOCK1, &block);
+}
+
 void gcoap_op_state(uint8_t *open_reqs)
 {
     uint8_t count = 0;
@@ -590,4 +1827,15 @@ void gcoap_op_state(uint8_t *open_reqs)
     *open_reqs = count;
 }
 
+unsigned gcoap_obs_count(const gcoap_observable_t *observable)
+{
+    unsigned count = 0;
+    for (int i = 0; i < GCOAP_OBS_CLIENTS_MAX; i++) {
+        if (_coap_state.observers[i].observable == observable) {
+            count++;
+        }
+    }
+    return count;
+}
+
 /** @} */
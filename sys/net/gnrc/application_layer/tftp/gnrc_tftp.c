@@ -27,7 +27,7 @@
 #include "net/gnrc/ipv6.h"
 #include "random.h"
 
-#define ENABLE_DEBUG                (1)
+#define ENABLE_DEBUG                (0)
 #include "debug.h"
 
 #if ENABLE_DEBUG
@@ -111,6 +111,7 @@ typedef enum {
     TOPT_BLKSIZE,
     TOPT_TIMEOUT,
     TOPT_TSIZE,
+    TOPT_WINDOWSIZE,
 } tftp_options_t;
 
 /* ordered as @see tftp_options_t */
@@ -118,6 +119,7 @@ tftp_opt_t _tftp_options[] = {
     [TOPT_BLKSIZE] = MODE(blksize),
     [TOPT_TIMEOUT] = MODE(timeout),
     [TOPT_TSIZE]   = MODE(tsize),
+    [TOPT_WINDOWSIZE] = MODE(windowsize),
 };
 
 /**
@@ -157,16 +159,26 @@ typedef struct {
     gnrc_netreg_entry_t entry;
 
     /* transfer parameters */
-    uint16_t block_nr;
+    uint16_t block_nr;              /**< last block acknowledged or received */
     uint16_t block_size;
     size_t transfer_size;
     uint32_t block_timeout;
     uint32_t retries;
+    uint16_t window_size;           /**< blocks sent per acknowledgement */
+    uint16_t window_count;          /**< blocks received since the last ACK */
+    uint16_t last_sent;             /**< last block of the window sent */
     bool use_options;
     bool enable_options;
     bool write_finished;
+    bool active;                    /**< server session listening on src_port */
 } tftp_context_t;
 
+/* the transfers of the server, all handled by its thread */
+static tftp_context_t _tftp_sessions[GNRC_TFTP_SERVER_SESSIONS];
+
+/* the server session the callbacks are called for */
+static tftp_context_t *_tftp_session;
+
 /**
  * @brief The default TFTP header
  */
@@ -223,12 +235,18 @@ static tftp_state _tftp_send_start(tftp_context_t *ctxt, gnrc_pktsnip_t *buf);
 /* send data or and ack depending if we are reading or writing */
 static tftp_state _tftp_send_dack(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tftp_opcodes_t op);
 
+/* send the window of data blocks following the last acknowledged block */
+static tftp_state _tftp_send_window(tftp_context_t *ctxt, gnrc_pktsnip_t *buf);
+
 /* send and TFTP error to the client */
 static tftp_state _tftp_send_error(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tftp_err_codes_t err, const char *err_msg);
 
 /* this function sends the actual packet */
 static tftp_state _tftp_send(gnrc_pktsnip_t *buf, tftp_context_t *ctxt, size_t len);
 
+/* start the timeout of the current block, if enabled */
+static void _tftp_set_timer(tftp_context_t *ctxt);
+
 /* decode the default TFTP start packet */
 static int _tftp_decode_start(tftp_context_t *ctxt, uint8_t *buf, gnrc_pktsnip_t *outbuf);
 
@@ -245,7 +263,22 @@ static int _tftp_process_data(tftp_context_t *ctxt, gnrc_pktsnip_t *buf);
 static int _tftp_decode_error(uint8_t *buf, tftp_err_codes_t *err, const char * *err_msg);
 
 /* TFTP super loop server */
-static int _tftp_server(tftp_context_t *ctxt);
+static int _tftp_server(void);
+
+/* get the server session of a message, or a free one for a new request */
+static tftp_context_t *_tftp_server_session_get(msg_t *m);
+
+/* stop listening for a server session and free it */
+static void _tftp_server_session_close(tftp_context_t *ctxt);
+
+/* reject a request if all server sessions are in use */
+static void _tftp_server_busy(ipv6_addr_t *addr, uint16_t port);
+
+/* check if we send the data blocks of the transfer */
+static inline bool _tftp_is_sender(tftp_context_t *ctxt)
+{
+    return (ctxt->ct == CT_SERVER) == (ctxt->op == TO_RRQ);
+}
 
 /* get the maximum allowed transfer unit to avoid 6Lo fragmentation */
 static uint16_t _tftp_get_maximum_block_size(void)
@@ -277,7 +310,7 @@ int gnrc_tftp_client_read(ipv6_addr_t *addr, const char *file_name, tftp_mode_t
     }
 
     /* set the transfer options */
-    uint16_t mtu = _tftp_get_maximum_block_size();
+    uint16_t mtu = MIN(_tftp_get_maximum_block_size(), GNRC_TFTP_MAX_TRANSFER_UNIT);
     if (!use_option_extensions ||
         _tftp_set_opts(&ctxt, mtu, GNRC_TFTP_DEFAULT_TIMEOUT, 0) != TS_FINISHED) {
         _tftp_set_default_options(&ctxt);
@@ -310,7 +343,7 @@ int gnrc_tftp_client_write(ipv6_addr_t *addr, const char *file_name, tftp_mode_t
     }
 
     /* set the transfer options */
-    uint16_t mtu = _tftp_get_maximum_block_size();
+    uint16_t mtu = MIN(_tftp_get_maximum_block_size(), GNRC_TFTP_MAX_TRANSFER_UNIT);
     if (!use_option_extensions ||
         _tftp_set_opts(&ctxt, mtu, GNRC_TFTP_DEFAULT_TIMEOUT, total_size) != TS_FINISHED) {
 
@@ -359,7 +392,9 @@ int _tftp_init_ctxt(ipv6_addr_t *addr, const char *file_name,
 
     /* transport layer parameters */
     ctxt->block_size = GNRC_TFTP_MAX_TRANSFER_UNIT;
+    ctxt->timeout = GNRC_TFTP_DEFAULT_TIMEOUT;
     ctxt->block_timeout = GNRC_TFTP_DEFAULT_TIMEOUT;
+    ctxt->window_size = 1;
     ctxt->write_finished = false;
 
     /* generate a random source UDP source port */
@@ -376,6 +411,7 @@ void _tftp_set_default_options(tftp_context_t *ctxt)
     ctxt->timeout = GNRC_TFTP_DEFAULT_TIMEOUT;
     ctxt->block_timeout = GNRC_TFTP_DEFAULT_TIMEOUT;
     ctxt->transfer_size = 0;
+    ctxt->window_size = 1;
     ctxt->use_options = false;
 }
 
@@ -389,6 +425,7 @@ int _tftp_set_opts(tftp_context_t *ctxt, size_t blksize, uint32_t timeout, size_
     ctxt->timeout = timeout;
     ctxt->block_timeout = timeout;
     ctxt->transfer_size = total_size;
+    ctxt->window_size = GNRC_TFTP_WINDOW_SIZE;
     ctxt->use_options = true;
 
     return TS_FINISHED;
@@ -402,26 +439,25 @@ int gnrc_tftp_server(tftp_data_cb_t data_cb, tftp_start_cb_t start_cb, tftp_stop
         return -1;
     }
 
-    /* context will be initialized when a connection is established */
-    tftp_context_t ctxt;
-    ctxt.data_cb = data_cb;
-    ctxt.start_cb = start_cb;
-    ctxt.stop_cb = stop_cb;
-    ctxt.enable_options = use_options;
-
     /* validate our arguments */
     assert(data_cb);
     assert(start_cb);
     assert(stop_cb);
 
+    /* sessions will be initialized when a connection is established */
+    memset(_tftp_sessions, 0, sizeof(_tftp_sessions));
+    for (unsigned i = 0; i < GNRC_TFTP_SERVER_SESSIONS; ++i) {
+        _tftp_sessions[i].data_cb = data_cb;
+        _tftp_sessions[i].start_cb = start_cb;
+        _tftp_sessions[i].stop_cb = stop_cb;
+        _tftp_sessions[i].enable_options = use_options;
+    }
+
     /* save our kernel PID */
     _tftp_kernel_pid = thread_getpid();
 
     /* start the server */
-    int ret = _tftp_server(&ctxt);
-
-    /* remove possibly stale timer */
-    xtimer_remove(&(ctxt.timer));
+    int ret = _tftp_server();
 
     /* reset the kernel PID */
     _tftp_kernel_pid = KERNEL_PID_UNDEF;
@@ -429,6 +465,15 @@ int gnrc_tftp_server(tftp_data_cb_t data_cb, tftp_start_cb_t start_cb, tftp_stop
     return ret;
 }
 
+int gnrc_tftp_server_session(void)
+{
+    if (!_tftp_session) {
+        return -1;
+    }
+
+    return _tftp_session - _tftp_sessions;
+}
+
 int gnrc_tftp_server_stop(void)
 {
     /* check if there is a server running */
@@ -450,68 +495,142 @@ int gnrc_tftp_server_stop(void)
     return 0;
 }
 
-int _tftp_server(tftp_context_t *ctxt)
+int _tftp_server(void)
 {
     msg_t msg;
-    bool active = true;
     gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(GNRC_TFTP_DEFAULT_DST_PORT,
                                                            sched_active_pid);
 
-    while (active) {
-        int ret = TS_BUSY;
-        bool got_client = false;
+    /* register the servers main listening port */
+    if (gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry)) {
+        DEBUG("tftp: error starting server.\n");
+        return TS_FAILED;
+    }
+
+    /* main processing loop, the sessions share this thread */
+    while (1) {
+        /* wait for a message */
+        msg_receive(&msg);
 
-        /* register the servers main listening port */
-        if (gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry)) {
-            DEBUG("tftp: error starting server.\n");
-            return TS_FAILED;
+        /* check if the server stop message has been received */
+        if (msg.type == TFTP_STOP_SERVER_MSG) {
+            break;
         }
 
-        /* main processing loop */
-        while (ret == TS_BUSY) {
-            /* wait for a message */
-            msg_receive(&msg);
-
-            /* check if the server stop message has been received */
-            if (msg.type == TFTP_STOP_SERVER_MSG) {
-                active = false;
-                ret = TS_FAILED;
-                break;
+        /* continue normal server opration */
+        DEBUG("tftp: message incoming\n");
+        tftp_context_t *ctxt = _tftp_server_session_get(&msg);
+        if (ctxt) {
+            _tftp_session = ctxt;
+            if (_tftp_state_processes(ctxt, &msg) != TS_BUSY) {
+                _tftp_server_session_close(ctxt);
             }
-            else {
-                /* continue normal server opration */
-                DEBUG("tftp: message incoming\n");
-                ret = _tftp_state_processes(ctxt, &msg);
+            _tftp_session = NULL;
+        }
 
-                /* release packet if we received one */
-                if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
-                    gnrc_pktbuf_release(msg.content.ptr);
-                }
-            }
+        /* release packet if we received one */
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
 
-            /* if we just accepted a client, disable the server main listening port */
-            if (!got_client) {
-                gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &entry);
+    /* abort the running transfers */
+    for (unsigned i = 0; i < GNRC_TFTP_SERVER_SESSIONS; ++i) {
+        _tftp_server_session_close(_tftp_sessions + i);
+    }
 
-                if (ret == TS_BUSY) {
-                    got_client = true;
-                    DEBUG("tftp: connection established\n");
-                }
-            }
+    /* unregister our UDP listener on this thread */
+    gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &entry);
+
+    return 0;
+}
+
+tftp_context_t *_tftp_server_session_get(msg_t *m)
+{
+    if (m->type == TFTP_TIMEOUT_MSG) {
+        /* the timer of a closed session may have fired already */
+        tftp_context_t *ctxt = m->content.ptr;
+        return ctxt->active ? ctxt : NULL;
+    }
+    else if (m->type != GNRC_NETAPI_MSG_TYPE_RCV) {
+        DEBUG("tftp: unknown message\n");
+        return NULL;
+    }
+
+    gnrc_pktsnip_t *pkt = m->content.ptr;
+    gnrc_pktsnip_t *tmp;
+    tmp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
+    udp_hdr_t *udp = (udp_hdr_t *)tmp->data;
+
+    tmp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+    ipv6_hdr_t *ip = (ipv6_hdr_t *)tmp->data;
+
+    uint16_t port = byteorder_ntohs(udp->dst_port);
+    tftp_context_t *unused = NULL;
+
+    for (unsigned i = 0; i < GNRC_TFTP_SERVER_SESSIONS; ++i) {
+        tftp_context_t *ctxt = _tftp_sessions + i;
+
+        if (!ctxt->active) {
+            unused = unused ? unused : ctxt;
+        }
+        else if (port == ctxt->src_port) {
+            return ctxt;
         }
+        else if ((port == GNRC_TFTP_DEFAULT_DST_PORT)
+                 && (ctxt->dst_port == byteorder_ntohs(udp->src_port))
+                 && ipv6_addr_equal(&(ctxt->peer), &(ip->src))) {
+            /* the session answers a repeated request on its timeout */
+            DEBUG("tftp: dropping repeated request\n");
+            return NULL;
+        }
+    }
 
-        /* remove any stall timers */
-        xtimer_remove(&(ctxt->timer));
+    /* only a request opens a new session */
+    tftp_opcodes_t op = _tftp_parse_type(pkt->data);
+    if ((port != GNRC_TFTP_DEFAULT_DST_PORT) || ((op != TO_RRQ) && (op != TO_WRQ))) {
+        DEBUG("tftp: no session for packet on port %" PRIu16 "\n", port);
+        return NULL;
+    }
+
+    if (!unused) {
+        DEBUG("tftp: all sessions in use\n");
+        _tftp_server_busy(&(ip->src), byteorder_ntohs(udp->src_port));
+    }
+
+    return unused;
+}
 
-        /* if the server transfer has finished, unregister the client dst port */
+void _tftp_server_session_close(tftp_context_t *ctxt)
+{
+    /* remove any stall timers */
+    xtimer_remove(&(ctxt->timer));
+
+    /* if the server transfer has finished, unregister the client dst port */
+    if (ctxt->active) {
         gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &(ctxt->entry));
+        ctxt->active = false;
         DEBUG("tftp: connection terminated\n");
     }
+}
+
+void _tftp_server_busy(ipv6_addr_t *addr, uint16_t port)
+{
+    tftp_context_t ctxt;
+    gnrc_pktsnip_t *buf = gnrc_pktbuf_add(NULL, NULL, TFTP_DEFAULT_DATA_SIZE,
+                                          GNRC_NETTYPE_UNDEF);
+
+    if (!buf) {
+        return;
+    }
 
-    /* unregister our UDP listener on this thread */
-    gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &entry);
+    /* answer from the request port, there is no transfer to stop */
+    memset(&ctxt, 0, sizeof(ctxt));
+    memcpy(&(ctxt.peer), addr, sizeof(ctxt.peer));
+    ctxt.src_port = GNRC_TFTP_DEFAULT_DST_PORT;
+    ctxt.dst_port = port;
 
-    return 0;
+    _tftp_send_error(&ctxt, buf, TE_UN_DEF, "Server busy");
 }
 
 int _tftp_do_client_transfer(tftp_context_t *ctxt)
@@ -583,11 +702,19 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
             /* we are still negotiating resent, start */
             return _tftp_send_start(ctxt, outbuf);
         }
+        else if ((ctxt->ct == CT_SERVER) && ctxt->use_options
+                 && !ctxt->block_nr && !ctxt->last_sent) {
+            DEBUG("tftp: option ACK lost, re-sending\n");
+            return _tftp_send_dack(ctxt, outbuf, TO_OACK);
+        }
+        else if (_tftp_is_sender(ctxt)) {
+            DEBUG("tftp: window not acknowledged, resending\n");
+            return _tftp_send_window(ctxt, outbuf);
+        }
         else {
-            DEBUG("tftp: last data or ack packet lost, resending\n");
-            /* we are sending / receiving data */
-            /* if we are reading resent the ACK, if writing the DATA */
-            return _tftp_send_dack(ctxt, outbuf, (ctxt->op == TO_RRQ) ? TO_ACK : TO_DATA);
+            DEBUG("tftp: data lost, acknowledging the last block received\n");
+            ctxt->window_count = 0;
+            return _tftp_send_dack(ctxt, outbuf, TO_ACK);
         }
     }
     else if (m->type != GNRC_NETAPI_MSG_TYPE_RCV) {
@@ -640,6 +767,7 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
             gnrc_netreg_entry_init_pid(&(ctxt->entry), ctxt->src_port,
                                        sched_active_pid);
             gnrc_netreg_register(GNRC_NETTYPE_UDP, &(ctxt->entry));
+            ctxt->active = true;
 
             /* try to decode the options */
             tftp_state state;
@@ -649,6 +777,7 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
                 DEBUG("tftp: send option ACK\n");
 
                 /* the client send the TFTP options */
+                ctxt->use_options = true;
                 opcode = TO_OACK;
             }
             else {
@@ -659,7 +788,6 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
 
                 /* send the first data block */
                 if (ctxt->op == TO_RRQ) {
-                    ++(ctxt->block_nr);
                     opcode = TO_DATA;
                 }
                 else {
@@ -676,7 +804,12 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
             }
 
             /* the client send the TFTP options */
-            state = _tftp_send_dack(ctxt, outbuf, opcode);
+            if (opcode == TO_DATA) {
+                state = _tftp_send_window(ctxt, outbuf);
+            }
+            else {
+                state = _tftp_send_dack(ctxt, outbuf, opcode);
+            }
 
             /* check if the client negotiation was successful */
             if (state != TS_BUSY) {
@@ -688,7 +821,13 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
         case TO_DATA: {
             /* try to process the data */
             int proc = _tftp_process_data(ctxt, pkt);
-            if (proc < 0) {
+            if (proc == -EAGAIN) {
+                /* a duplicate, or a block of the window was lost: tell the
+                 * sender where to continue, see RFC 7440 section 4 */
+                ctxt->window_count = 0;
+                return _tftp_send_dack(ctxt, outbuf, TO_ACK);
+            }
+            else if (proc < 0) {
                 DEBUG("tftp: data not accepted\n");
                 /* the data is not accepted return */
                 gnrc_pktbuf_release(outbuf);
@@ -697,8 +836,7 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
 
             /* check if this is the first block */
             if (!ctxt->block_nr
-                && ctxt->dst_port == GNRC_TFTP_DEFAULT_DST_PORT
-                && !ctxt->use_options) {
+                && ctxt->dst_port == GNRC_TFTP_DEFAULT_DST_PORT) {
                 /* no OACK received, restore default TFTP parameters */
                 _tftp_set_default_options(ctxt);
                 DEBUG("tftp: restore default TFTP parameters\n");
@@ -707,14 +845,13 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
                 ctxt->dst_port = byteorder_ntohs(udp->src_port);
             }
 
-            /* wait for the next data block */
-            DEBUG("tftp: wait for the next data block\n");
             ++(ctxt->block_nr);
-            _tftp_send_dack(ctxt, outbuf, TO_ACK);
+            ctxt->retries = 0;
 
             /* check if the data transfer has finished */
             if (proc < ctxt->block_size) {
                 DEBUG("tftp: transfer finished\n");
+                _tftp_send_dack(ctxt, outbuf, TO_ACK);
 
                 if (ctxt->stop_cb) {
                     ctxt->stop_cb(TFTP_SUCCESS, NULL);
@@ -723,19 +860,36 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
                 return TS_FINISHED;
             }
 
+            /* acknowledge a complete window */
+            if (++(ctxt->window_count) >= ctxt->window_size) {
+                DEBUG("tftp: wait for the next window\n");
+                ctxt->window_count = 0;
+                return _tftp_send_dack(ctxt, outbuf, TO_ACK);
+            }
+
+            /* wait for the rest of the window */
+            gnrc_pktbuf_release(outbuf);
+            ctxt->block_timeout = ctxt->timeout;
+            _tftp_set_timer(ctxt);
+
             return TS_BUSY;
         } break;
 
         case TO_ACK: {
             /* validate if this is the ACK we are waiting for */
             if (!_tftp_validate_ack(ctxt, data)) {
-                /* invalid packet ACK, drop */
+                /* invalid or duplicate packet ACK, drop but keep waiting */
                 gnrc_pktbuf_release(outbuf);
+                _tftp_set_timer(ctxt);
                 return TS_BUSY;
             }
 
+            /* the blocks up to the acknowledged one arrived */
+            ctxt->block_nr = byteorder_ntohs(((tftp_packet_data_t *)data)->block_nr);
+            ctxt->retries = 0;
+
             /* check if the write action is finished */
-            if (ctxt->write_finished) {
+            if (ctxt->write_finished && (ctxt->block_nr == ctxt->last_sent)) {
                 gnrc_pktbuf_release(outbuf);
 
                 if (ctxt->stop_cb) {
@@ -754,10 +908,8 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
                 ctxt->dst_port = byteorder_ntohs(udp->src_port);
             }
 
-            /* send the next data block */
-            ++(ctxt->block_nr);
-
-            return _tftp_send_dack(ctxt, outbuf, TO_DATA);
+            /* send the next window, or the rest of a partly received one */
+            return _tftp_send_window(ctxt, outbuf);
         } break;
 
         case TO_ERROR: {
@@ -782,22 +934,23 @@ tftp_state _tftp_state_processes(tftp_context_t *ctxt, msg_t *m)
             if (ctxt->dst_port != byteorder_ntohs(udp->src_port)) {
                 DEBUG("tftp: TO_OACK received\n");
 
-                /* decode the options */
+                /* decode the options, without windowsize the server
+                 * wants lock-step */
+                ctxt->window_size = 1;
                 _tftp_decode_options(ctxt, pkt, 0);
 
                 /* take the new source port */
                 ctxt->dst_port = byteorder_ntohs(udp->src_port);
-
-                /* we must send block one to finish the negotiation in send mode */
-                if (ctxt->op == TO_WRQ) {
-                    ++(ctxt->block_nr);
-                }
             }
             else {
                 DEBUG("tftp: dropping double TO_OACK\n");
             }
 
-            return _tftp_send_dack(ctxt, outbuf, (ctxt->op == TO_WRQ) ? TO_DATA : TO_ACK);
+            /* we must send the first window to finish the negotiation in send mode */
+            if (ctxt->op == TO_WRQ) {
+                return _tftp_send_window(ctxt, outbuf);
+            }
+            return _tftp_send_dack(ctxt, outbuf, TO_ACK);
         } break;
     }
 
@@ -836,6 +989,11 @@ uint32_t _tftp_append_options(tftp_context_t *ctxt, tftp_header_t *hdr, uint32_t
         offset += _tftp_add_option(hdr->data + offset, _tftp_options + TOPT_TSIZE, ctxt->transfer_size);
     }
 
+    /* a window of one block is the default */
+    if (ctxt->window_size > 1) {
+        offset += _tftp_add_option(hdr->data + offset, _tftp_options + TOPT_WINDOWSIZE, ctxt->window_size);
+    }
+
     return offset;
 }
 
@@ -888,8 +1046,8 @@ tftp_state _tftp_send_dack(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tftp_opcod
         /* append the options */
         len = _tftp_append_options(ctxt, (tftp_header_t *)pkt, 0);
 
-        /* disable timeout*/
-        ctxt->block_timeout = 0;
+        /* resend the OACK until the client answers it */
+        ctxt->block_timeout = ctxt->timeout;
     }
     else if (op == TO_ACK) {
         /* disable timeout*/
@@ -900,6 +1058,48 @@ tftp_state _tftp_send_dack(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tftp_opcod
     return _tftp_send(buf, ctxt, sizeof(tftp_packet_data_t) + len);
 }
 
+tftp_state _tftp_send_window(tftp_context_t *ctxt, gnrc_pktsnip_t *buf)
+{
+    uint16_t acked = ctxt->block_nr;
+    tftp_state state = TS_BUSY;
+
+    for (uint16_t i = 0; (i < ctxt->window_size) && (state == TS_BUSY); ++i) {
+        if (!buf) {
+            buf = gnrc_pktbuf_add(NULL, NULL, TFTP_DEFAULT_DATA_SIZE, GNRC_NETTYPE_UNDEF);
+            if (!buf) {
+                /* the timeout of the blocks already sent resends the window */
+                DEBUG("tftp: no buffer for block %" PRIu16 "\n", i);
+                break;
+            }
+        }
+
+        /* the data blocks take their number from the context */
+        ++(ctxt->block_nr);
+        state = _tftp_send_dack(ctxt, buf, TO_DATA);
+        buf = NULL;
+
+        /* the last block of the transfer ends the window */
+        if (ctxt->write_finished) {
+            break;
+        }
+    }
+
+    if (buf) {
+        gnrc_pktbuf_release(buf);
+    }
+    else if (ctxt->block_nr == acked) {
+        /* nothing sent, try again on timeout */
+        ctxt->block_timeout = ctxt->timeout;
+        _tftp_set_timer(ctxt);
+    }
+
+    DEBUG("tftp: sent blocks %" PRIu16 " to %" PRIu16 "\n", acked + 1, ctxt->block_nr);
+    ctxt->last_sent = ctxt->block_nr;
+    ctxt->block_nr = acked;
+
+    return state;
+}
+
 tftp_state _tftp_send_error(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, tftp_err_codes_t err, const char *err_msg)
 {
     int strl = err_msg
@@ -997,21 +1197,35 @@ tftp_state _tftp_send(gnrc_pktsnip_t *buf, tftp_context_t *ctxt, size_t len)
         return TS_FAILED;
     }
 
+    _tftp_set_timer(ctxt);
+
+    return TS_BUSY;
+}
+
+void _tftp_set_timer(tftp_context_t *ctxt)
+{
     /* only set timeout if enabled for this block */
     if (ctxt->block_timeout) {
         ctxt->timer_msg.type = TFTP_TIMEOUT_MSG;
+        ctxt->timer_msg.content.ptr = ctxt;
         xtimer_set_msg(&(ctxt->timer), ctxt->block_timeout, &(ctxt->timer_msg), thread_getpid());
         DEBUG("tftp: set timeout %" PRIu32 " ms\n", ctxt->block_timeout / MS_IN_USEC);
     }
-
-    return TS_BUSY;
 }
 
 bool _tftp_validate_ack(tftp_context_t *ctxt, uint8_t *buf)
 {
     tftp_packet_data_t *pkt = (tftp_packet_data_t *) buf;
+    uint16_t outstanding = ctxt->last_sent - ctxt->block_nr;
 
-    return ctxt->block_nr == byteorder_ntohs(pkt->block_nr);
+    /* without blocks in flight only the last block is acknowledged, e.g. by
+     * the ACK of a write request */
+    if (!outstanding) {
+        return ctxt->block_nr == byteorder_ntohs(pkt->block_nr);
+    }
+
+    /* any block of the window, but not the last acknowledged one again */
+    return (uint16_t)(byteorder_ntohs(pkt->block_nr) - ctxt->block_nr - 1) < outstanding;
 }
 
 int _tftp_decode_start(tftp_context_t *ctxt, uint8_t *buf, gnrc_pktsnip_t *outbuf)
@@ -1070,7 +1284,11 @@ int _tftp_decode_options(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, uint32_t sta
                 /* set the option value of the known options */
                 switch (idx) {
                     case TOPT_BLKSIZE:
-                        ctxt->block_size = atoi(value);
+                        /* we can't send or receive larger blocks, RFC 2348
+                         * allows 8 bytes at least */
+                        if (atoi(value) >= 8) {
+                            ctxt->block_size = MIN(atoi(value), GNRC_TFTP_MAX_TRANSFER_UNIT);
+                        }
                         DEBUG("tftp: got option TOPT_BLKSIZE = %" PRIu16 "\n", ctxt->block_size);
                         break;
 
@@ -1083,6 +1301,13 @@ int _tftp_decode_options(tftp_context_t *ctxt, gnrc_pktsnip_t *buf, uint32_t sta
                         }
                         break;
 
+                    case TOPT_WINDOWSIZE:
+                        if (atoi(value) > 0) {
+                            ctxt->window_size = MIN(atoi(value), GNRC_TFTP_WINDOW_SIZE);
+                        }
+                        DEBUG("tftp: got option TOPT_WINDOWSIZE = %" PRIu16 "\n", ctxt->window_size);
+                        break;
+
                     case TOPT_TIMEOUT:
                         ctxt->timeout = atoi(value) * SEC_IN_USEC;
                         DEBUG("tftp: option TOPT_TIMEOUT = %" PRIu32 " ms\n", ctxt->timeout / MS_IN_USEC);
@@ -1107,15 +1332,15 @@ int _tftp_process_data(tftp_context_t *ctxt, gnrc_pktsnip_t *buf)
     uint16_t block_nr = byteorder_ntohs(pkt->block_nr);
 
     /* check if this is the packet we are waiting for */
-    if (block_nr != (ctxt->block_nr + 1)) {
+    if (block_nr != (uint16_t)(ctxt->block_nr + 1)) {
         DEBUG("tftp: not the packet we were wating for\n");
-        return TS_BUSY;
+        return -EAGAIN;
     }
 
     /* send the user data trough to the user application */
     if (ctxt->data_cb(ctxt->block_nr * ctxt->block_size, pkt->data, buf->size - sizeof(tftp_packet_data_t)) < 0) {
         DEBUG("tftp: error in data callback\n");
-        return TS_BUSY;
+        return -EIO;
     }
 
     /* return the number of data bytes received */
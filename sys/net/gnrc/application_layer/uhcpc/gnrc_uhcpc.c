@@ -58,11 +58,23 @@ static void set_interface_roles(void)
 }
 
 static ipv6_addr_t _prefix;
+static uint32_t _lease;
 
-void uhcp_handle_prefix(uint8_t *prefix, uint8_t prefix_len, uint16_t lifetime, uint8_t *src, uhcp_iface_t iface)
+static void _remove_prefix(void)
+{
+    if (!ipv6_addr_is_unspecified(&_prefix)) {
+        gnrc_ipv6_netif_remove_addr(gnrc_wireless_interface, &_prefix);
+        print_str("gnrc_uhcpc: uhcp_handle_prefix(): removed old prefix ");
+        ipv6_addr_print(&_prefix);
+        puts("/64");
+        ipv6_addr_set_unspecified(&_prefix);
+    }
+}
+
+void uhcp_handle_prefix(uint8_t *prefix, uint8_t prefix_len, uint16_t lifetime,
+                        uint32_t lease, uint8_t *src, uhcp_iface_t iface)
 {
     (void)prefix_len;
-    (void)lifetime;
     (void)src;
 
     eui64_t iid;
@@ -76,6 +88,11 @@ void uhcp_handle_prefix(uint8_t *prefix, uint8_t prefix_len, uint16_t lifetime,
         return;
     }
 
+    if (lifetime == 0) {
+        _remove_prefix();
+        return;
+    }
+
     if (gnrc_netapi_get(gnrc_wireless_interface, NETOPT_IPV6_IID, 0, &iid,
                         sizeof(eui64_t)) >= 0) {
         ipv6_addr_set_aiid((ipv6_addr_t*)prefix, iid.uint8);
@@ -86,27 +103,24 @@ void uhcp_handle_prefix(uint8_t *prefix, uint8_t prefix_len, uint16_t lifetime,
     }
 
     if (ipv6_addr_equal(&_prefix, (ipv6_addr_t*)prefix)) {
-        LOG_WARNING("gnrc_uhcpc: uhcp_handle_prefix(): got same prefix again\n");
+        /* the address has no lifetime, a renewed lease needs no reconfiguration */
+        if (lease != _lease) {
+            LOG_INFO("gnrc_uhcpc: uhcp_handle_prefix(): same prefix with new lease\n");
+            _lease = lease;
+        }
         return;
     }
 
+    _remove_prefix();
     gnrc_ipv6_netif_add_addr(gnrc_wireless_interface, (ipv6_addr_t*)prefix, 64,
                              GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST |
                              GNRC_IPV6_NETIF_ADDR_FLAGS_NDP_AUTO);
-
-    gnrc_ipv6_netif_remove_addr(gnrc_wireless_interface, &_prefix);
     print_str("gnrc_uhcpc: uhcp_handle_prefix(): configured new prefix ");
     ipv6_addr_print((ipv6_addr_t*)prefix);
     puts("/64");
 
-    if (!ipv6_addr_is_unspecified(&_prefix)) {
-        gnrc_ipv6_netif_remove_addr(gnrc_wireless_interface, &_prefix);
-        print_str("gnrc_uhcpc: uhcp_handle_prefix(): removed old prefix ");
-        ipv6_addr_print(&_prefix);
-        puts("/64");
-    }
-
     memcpy(&_prefix, prefix, 16);
+    _lease = lease;
 }
 
 extern void uhcp_client(uhcp_iface_t iface);
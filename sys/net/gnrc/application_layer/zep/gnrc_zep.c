@@ -31,6 +31,10 @@
 #include "random.h"
 
 #include "net/gnrc/zep.h"
+#ifdef MODULE_ZEP_HUB
+#include "xtimer.h"
+#include "zep_hub.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -49,6 +53,11 @@ static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _rx_stack[GNRC_ZEP_STACK_SIZE];
 static char _rx_buf_array[_RX_BUF_SIZE];
 static ringbuffer_t _rx_buf = RINGBUFFER_INIT(_rx_buf_array);
+#ifdef MODULE_ZEP_HUB
+#define _MSG_TYPE_HUB_POLL      (0x7a01)
+static xtimer_t _hub_timer;
+static msg_t _hub_msg = { .type = _MSG_TYPE_HUB_POLL };
+#endif
 
 /* gnrc_netdev driver definitions */
 static int _send(gnrc_netdev_t *dev, gnrc_pktsnip_t *pkt);
@@ -87,34 +96,13 @@ static size_t _get_frame_hdr_len(uint8_t *mhr);
 gnrc_pktsnip_t *_make_netif_hdr(uint8_t *mhr);
 static uint16_t _calc_fcs(uint16_t fcs, const uint8_t *frame, uint8_t frame_len);
 
-kernel_pid_t gnrc_zep_init(gnrc_zep_t *dev, uint16_t src_port, ipv6_addr_t *dst,
-                           uint16_t dst_port)
+static void _init_dev(gnrc_zep_t *dev)
 {
 #if CPUID_LEN
     uint8_t cpuid[CPUID_LEN];
     uint32_t hash1, hash2;
 #endif
 
-    if (_pid != KERNEL_PID_UNDEF) {
-        DEBUG("zep: ZEP thread already running at pid=%" PRIkernel_pid "\n", _pid);
-        return -EEXIST;
-    }
-
-    if (dev == NULL) {
-        DEBUG("zep: dev was NULL\n");
-        return -ENODEV;
-    }
-
-    if ((dst == NULL) || (ipv6_addr_is_unspecified(dst))) {
-        DEBUG("zep: dst (%s) was NULL or unspecified\n", dst);
-        return -ENOTSUP;
-    }
-
-    if (gnrc_netreg_lookup(GNRC_NETTYPE_UDP, src_port)) {
-        DEBUG("zep: port (%" PRIu16 ") already registered\n", src_port);
-        return -EADDRINUSE;
-    }
-
     dev->driver = (gnrc_netdev_driver_t *)&_zep_driver;
     dev->chan = GNRC_ZEP_DEFAULT_CHANNEL;
     dev->pan = byteorder_btols(byteorder_htons(GNRC_ZEP_DEFAULT_PANID));
@@ -154,12 +142,38 @@ kernel_pid_t gnrc_zep_init(gnrc_zep_t *dev, uint16_t src_port, ipv6_addr_t *dst,
 #endif
 
     dev->seq = random_uint32();
+    dev->version = 2;
+    dev->lqi_mode = 1;
+}
+
+kernel_pid_t gnrc_zep_init(gnrc_zep_t *dev, uint16_t src_port, ipv6_addr_t *dst,
+                           uint16_t dst_port)
+{
+    if (_pid != KERNEL_PID_UNDEF) {
+        DEBUG("zep: ZEP thread already running at pid=%" PRIkernel_pid "\n", _pid);
+        return -EEXIST;
+    }
+
+    if (dev == NULL) {
+        DEBUG("zep: dev was NULL\n");
+        return -ENODEV;
+    }
+
+    if ((dst == NULL) || (ipv6_addr_is_unspecified(dst))) {
+        DEBUG("zep: dst (%s) was NULL or unspecified\n", dst);
+        return -ENOTSUP;
+    }
+
+    if (gnrc_netreg_lookup(GNRC_NETTYPE_UDP, src_port)) {
+        DEBUG("zep: port (%" PRIu16 ") already registered\n", src_port);
+        return -EADDRINUSE;
+    }
+
+    _init_dev(dev);
     dev->src_port = src_port;
     dev->dst.u64[0] = dst->u64[0];
     dev->dst.u64[1] = dst->u64[1];
     dev->dst_port = dst_port;
-    dev->version = 2;
-    dev->lqi_mode = 1;
 
     _pid = thread_create(_rx_stack, GNRC_ZEP_STACK_SIZE, GNRC_ZEP_PRIO,
                          THREAD_CREATE_STACKTEST, _event_loop, dev, "zep_app");
@@ -169,6 +183,40 @@ kernel_pid_t gnrc_zep_init(gnrc_zep_t *dev, uint16_t src_port, ipv6_addr_t *dst,
     return _pid;
 }
 
+#ifdef MODULE_ZEP_HUB
+kernel_pid_t gnrc_zep_init_hub(gnrc_zep_t *dev, const char *file, unsigned node)
+{
+    int res;
+
+    if (_pid != KERNEL_PID_UNDEF) {
+        DEBUG("zep: ZEP thread already running at pid=%" PRIkernel_pid "\n", _pid);
+        return -EEXIST;
+    }
+
+    if (dev == NULL) {
+        DEBUG("zep: dev was NULL\n");
+        return -ENODEV;
+    }
+
+    if ((res = zep_hub_attach(file, node)) < 0) {
+        DEBUG("zep: unable to attach to hub %s\n", file);
+        return res;
+    }
+
+    _init_dev(dev);
+    dev->src_port = 0;
+    memset(&dev->dst, 0, sizeof(dev->dst));
+    dev->dst_port = 0;
+
+    _pid = thread_create(_rx_stack, GNRC_ZEP_STACK_SIZE, GNRC_ZEP_PRIO,
+                         THREAD_CREATE_STACKTEST, _event_loop, dev, "zep_app");
+
+    DEBUG("zep: started thread with PID %" PRIkernel_pid "\n", _pid);
+
+    return _pid;
+}
+#endif
+
 /* helper functions for options to avoid type pruning */
 static inline void _set_uint16_ptr(uint16_t *ptr, uint16_t val)
 {
@@ -230,28 +278,6 @@ static int _send(gnrc_netdev_t *netdev, gnrc_pktsnip_t *pkt)
 
     zep = new_pkt->data;
 
-    hdr = gnrc_udp_hdr_build(new_pkt, dev->src_port, dev->dst_port);
-
-    if (hdr == NULL) {
-        DEBUG("zep: could not allocate UDP header in pktbuf\n");
-        gnrc_pktbuf_release(pkt);
-        gnrc_pktbuf_release(new_pkt);
-        return -ENOBUFS;
-    }
-
-    new_pkt = hdr;
-
-    hdr = gnrc_ipv6_hdr_build(new_pkt, NULL, &(dev->dst));
-
-    if (hdr == NULL) {
-        DEBUG("zep: could not allocate IPv6 header in pktbuf\n");
-        gnrc_pktbuf_release(pkt);
-        gnrc_pktbuf_release(new_pkt);
-        return -ENOBUFS;
-    }
-
-    new_pkt = hdr;
-
     mhr_offset = _zep_hdr_fill(dev, zep, payload_len + hdr_len + IEEE802154_FCS_LEN);
 
     if (mhr_offset == 0) {
@@ -279,6 +305,34 @@ static int _send(gnrc_netdev_t *netdev, gnrc_pktsnip_t *pkt)
     DEBUG("zep: set frame FCS to 0x%04 " PRIx16 "\n", fcs);
     _set_uint16_ptr((uint16_t *)data, byteorder_btols(byteorder_htons(fcs)).u16);
 
+#ifdef MODULE_ZEP_HUB
+    if (zep_hub_attached()) {
+        zep_hub_send(new_pkt->data, new_pkt->size);
+        gnrc_pktbuf_release(new_pkt);
+        return payload_len + hdr_len + IEEE802154_FCS_LEN;
+    }
+#endif
+
+    hdr = gnrc_udp_hdr_build(new_pkt, dev->src_port, dev->dst_port);
+
+    if (hdr == NULL) {
+        DEBUG("zep: could not allocate UDP header in pktbuf\n");
+        gnrc_pktbuf_release(new_pkt);
+        return -ENOBUFS;
+    }
+
+    new_pkt = hdr;
+
+    hdr = gnrc_ipv6_hdr_build(new_pkt, NULL, &(dev->dst));
+
+    if (hdr == NULL) {
+        DEBUG("zep: could not allocate IPv6 header in pktbuf\n");
+        gnrc_pktbuf_release(new_pkt);
+        return -ENOBUFS;
+    }
+
+    new_pkt = hdr;
+
     if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_UDP, GNRC_NETREG_DEMUX_CTX_ALL, new_pkt)) {
         DEBUG("zep: no UDP handler found: dropping packet\n");
         gnrc_pktbuf_release(new_pkt);
@@ -552,6 +606,34 @@ static void _isr_event(gnrc_netdev_t *dev, uint32_t event_type)
     }
 }
 
+#ifdef MODULE_ZEP_HUB
+/* moves frames from the hub into the RX queue, as many as it takes */
+static void _hub_poll(gnrc_netdev_t *dev)
+{
+    uint8_t buf[ZEP_HUB_FRAME_LEN];
+    int res;
+
+    while ((ringbuffer_get_free(&_rx_buf) >= sizeof(gnrc_pktsnip_t *)) &&
+           ((res = zep_hub_recv(buf, sizeof(buf))) != 0)) {
+        gnrc_pktsnip_t *pkt;
+        msg_t ack;
+
+        if (res < 0) {
+            continue;
+        }
+        pkt = gnrc_pktbuf_add(NULL, buf, res, GNRC_NETTYPE_UNDEF);
+        if (pkt == NULL) {
+            DEBUG("zep: no space left in packet buffer for hub frame\n");
+            break;
+        }
+        ringbuffer_add(&_rx_buf, (void *)&pkt, sizeof(gnrc_pktsnip_t *));
+        ack.type = GNRC_NETDEV_MSG_TYPE_EVENT;
+        ack.content.value = _EVENT_RX_STARTED;
+        msg_send_int(&ack, dev->mac_pid);
+    }
+}
+#endif
+
 void *_event_loop(void *args)
 {
     msg_t msg, ack, msg_q[GNRC_ZEP_MSG_QUEUE_SIZE];
@@ -562,6 +644,12 @@ void *_event_loop(void *args)
 
     msg_init_queue(msg_q, GNRC_ZEP_MSG_QUEUE_SIZE);
 
+#ifdef MODULE_ZEP_HUB
+    if (zep_hub_attached()) {
+        xtimer_set_msg(&_hub_timer, GNRC_ZEP_HUB_POLL_US, &_hub_msg, sched_active_pid);
+    }
+    else
+#endif
     gnrc_netreg_register(GNRC_NETTYPE_UDP, &my_reg);
 
     while (1) {
@@ -577,6 +665,14 @@ void *_event_loop(void *args)
                 msg_send_int(&ack, dev->mac_pid);
                 break;
 
+#ifdef MODULE_ZEP_HUB
+            case _MSG_TYPE_HUB_POLL:
+                _hub_poll(dev);
+                xtimer_set_msg(&_hub_timer, GNRC_ZEP_HUB_POLL_US, &_hub_msg,
+                               sched_active_pid);
+                break;
+#endif
+
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("zep: GNRC_NETAPI_MSG_TYPE_SND\n");
                 _send(dev, msg.content.ptr);
@@ -0,0 +1,437 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_gnrc_lwmac
+ * @file
+ * @brief       Implementation of the phase-locked low-power listening MAC
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "net/gnrc.h"
+#include "net/gnrc/mac/internal.h"
+#include "net/gnrc/lwmac/lwmac.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if (GNRC_MAC_TX_QUEUE_SIZE == 0) || (GNRC_MAC_NEIGHBOR_COUNT == 0)
+#error "gnrc_lwmac needs GNRC_MAC_TX_QUEUE_SIZE and GNRC_MAC_NEIGHBOR_COUNT"
+#endif
+
+#define LWMAC_MSG_QUEUE_SIZE    (8U)
+
+/**
+ * @name    State flags
+ * @{
+ */
+#define FLAG_RADIO_ON           (0x01)  /**< radio is switched on */
+#define FLAG_LISTENING          (0x02)  /**< in the own wake-up window */
+#define FLAG_TX_WAIT            (0x04)  /**< waiting for the receiver's phase */
+#define FLAG_STROBING           (0x08)  /**< repeating the current frame */
+#define FLAG_PHASED             (0x10)  /**< strobe relies on the learned phase */
+/** @} */
+
+/* the phases are stored shifted by one, so GNRC_MAC_PHASE_UNINITIALIZED
+ * keeps meaning "unknown" */
+static inline bool _phase_known(uint32_t phase)
+{
+    return (phase != GNRC_MAC_PHASE_UNINITIALIZED) &&
+           (phase != (uint32_t)GNRC_MAC_PHASE_MAX);
+}
+
+static void _update_radio(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+    netdev2_t *dev = gnrc_netdev2->dev;
+    bool on = (lwmac->flags & (FLAG_LISTENING | FLAG_STROBING));
+    netopt_state_t state;
+    uint64_t now;
+
+    if (on == !!(lwmac->flags & FLAG_RADIO_ON)) {
+        return;
+    }
+    state = (on) ? NETOPT_STATE_IDLE : NETOPT_STATE_SLEEP;
+    dev->driver->set(dev, NETOPT_STATE, &state, sizeof(state));
+    now = xtimer_now_usec64();
+    if (on) {
+        lwmac->radio_on_at = now;
+        lwmac->flags |= FLAG_RADIO_ON;
+    }
+    else {
+        lwmac->stats.radio_on += now - lwmac->radio_on_at;
+        lwmac->flags &= ~FLAG_RADIO_ON;
+    }
+    DEBUG("lwmac: radio %s\n", (on) ? "on" : "off");
+}
+
+static void _wakeup(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+    uint64_t now = xtimer_now_usec64();
+
+    /* keep the period fixed, so neighbors can rely on the learned phase */
+    lwmac->wakeup_at += GNRC_LWMAC_WAKEUP_INTERVAL_US;
+    if (lwmac->wakeup_at <= now) {
+        lwmac->wakeup_at = now + GNRC_LWMAC_WAKEUP_INTERVAL_US;
+    }
+    xtimer_set_msg64(&lwmac->wakeup_timer, lwmac->wakeup_at - now,
+                     &lwmac->wakeup_msg, gnrc_netdev2->pid);
+    lwmac->flags |= FLAG_LISTENING;
+    xtimer_set_msg(&lwmac->sleep_timer, GNRC_LWMAC_WAKEUP_DURATION_US,
+                   &lwmac->sleep_msg, gnrc_netdev2->pid);
+    _update_radio(gnrc_netdev2);
+}
+
+static void _sleep(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+
+    if (gnrc_netdev2_get_rx_started(gnrc_netdev2)) {
+        /* don't cut off a frame in reception */
+        xtimer_set_msg(&lwmac->sleep_timer, GNRC_LWMAC_RX_LINGER_US,
+                       &lwmac->sleep_msg, gnrc_netdev2->pid);
+        return;
+    }
+    lwmac->flags &= ~FLAG_LISTENING;
+    _update_radio(gnrc_netdev2);
+}
+
+static void _strobe_done(gnrc_netdev2_t *gnrc_netdev2);
+
+static void _send_copy(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+    gnrc_mac_tx_t *tx = &gnrc_netdev2->tx;
+
+    /* gnrc_netdev2_t::send() releases the packet */
+    gnrc_pktbuf_hold(tx->packet, 1);
+    lwmac->copy_at = xtimer_now_usec64();
+    lwmac->stats.strobes++;
+    gnrc_netdev2_set_tx_feedback(gnrc_netdev2, TX_FEEDBACK_UNDEF);
+    if (gnrc_netdev2->send(gnrc_netdev2, tx->packet) < 0) {
+        DEBUG("lwmac: unable to send copy\n");
+        gnrc_netdev2->tx.current_neighbor->phase = GNRC_MAC_PHASE_MAX;
+        _strobe_done(gnrc_netdev2);
+    }
+}
+
+static void _strobe_start(gnrc_netdev2_t *gnrc_netdev2, uint32_t duration)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+
+    lwmac->flags &= ~FLAG_TX_WAIT;
+    lwmac->flags |= FLAG_STROBING;
+    lwmac->strobe_end = xtimer_now_usec64() + duration;
+    _update_radio(gnrc_netdev2);
+    _send_copy(gnrc_netdev2);
+}
+
+static void _tx_next(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+    gnrc_mac_tx_t *tx = &gnrc_netdev2->tx;
+    gnrc_mac_tx_neighbor_t *neighbor = NULL;
+
+    if (tx->packet != NULL) {
+        return;
+    }
+    for (unsigned i = 0; i <= GNRC_MAC_NEIGHBOR_COUNT; i++) {
+        if (gnrc_priority_pktqueue_length(&tx->neighbors[i].queue) > 0) {
+            neighbor = &tx->neighbors[i];
+            break;
+        }
+    }
+    if (neighbor == NULL) {
+        return;
+    }
+    tx->packet = gnrc_priority_pktqueue_pop(&neighbor->queue);
+    tx->current_neighbor = neighbor;
+    lwmac->flags &= ~FLAG_PHASED;
+    if ((neighbor != &tx->neighbors[0]) && _phase_known(neighbor->phase)) {
+        uint32_t now = xtimer_now_usec64() % GNRC_LWMAC_WAKEUP_INTERVAL_US;
+        uint32_t start = (neighbor->phase - 1 + GNRC_LWMAC_WAKEUP_INTERVAL_US -
+                          GNRC_LWMAC_PHASE_GUARD_US) % GNRC_LWMAC_WAKEUP_INTERVAL_US;
+        uint32_t wait = (start + GNRC_LWMAC_WAKEUP_INTERVAL_US - now) %
+                        GNRC_LWMAC_WAKEUP_INTERVAL_US;
+
+        DEBUG("lwmac: strobe to known phase in %" PRIu32 " us\n", wait);
+        lwmac->flags |= (FLAG_TX_WAIT | FLAG_PHASED);
+        xtimer_set_msg(&lwmac->tx_timer, wait, &lwmac->tx_msg, gnrc_netdev2->pid);
+        return;
+    }
+    /* unknown phase or broadcast: cover a full interval of the receivers */
+    _strobe_start(gnrc_netdev2, GNRC_LWMAC_WAKEUP_INTERVAL_US +
+                                GNRC_LWMAC_WAKEUP_DURATION_US);
+}
+
+static void _strobe_done(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+    gnrc_mac_tx_t *tx = &gnrc_netdev2->tx;
+
+    gnrc_pktbuf_release(tx->packet);
+    tx->packet = NULL;
+    tx->current_neighbor = NULL;
+    lwmac->flags &= ~(FLAG_STROBING | FLAG_PHASED);
+    _update_radio(gnrc_netdev2);
+    _tx_next(gnrc_netdev2);
+}
+
+static void _tx_feedback(gnrc_netdev2_t *gnrc_netdev2, gnrc_mac_tx_feedback_t feedback)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+    gnrc_mac_tx_neighbor_t *neighbor = gnrc_netdev2->tx.current_neighbor;
+    bool broadcast = (neighbor == &gnrc_netdev2->tx.neighbors[0]);
+
+    gnrc_netdev2_set_tx_feedback(gnrc_netdev2, feedback);
+    if (!(lwmac->flags & FLAG_STROBING)) {
+        return;
+    }
+    if (!broadcast && (feedback == TX_FEEDBACK_SUCCESS)) {
+        /* the receiver was listening when this copy started */
+        neighbor->phase = (lwmac->copy_at % GNRC_LWMAC_WAKEUP_INTERVAL_US) + 1;
+        lwmac->stats.tx_success++;
+        if (lwmac->flags & FLAG_PHASED) {
+            lwmac->stats.tx_phase_hits++;
+        }
+        DEBUG("lwmac: acknowledged after %" PRIu32 " us\n",
+              (uint32_t)(xtimer_now_usec64() - lwmac->strobe_end));
+        _strobe_done(gnrc_netdev2);
+        return;
+    }
+    if (xtimer_now_usec64() >= lwmac->strobe_end) {
+        if (broadcast) {
+            _strobe_done(gnrc_netdev2);
+            return;
+        }
+        if (!(lwmac->flags & FLAG_PHASED)) {
+            DEBUG("lwmac: receiver never woke up\n");
+            lwmac->stats.tx_failed++;
+            neighbor->phase = GNRC_MAC_PHASE_MAX;
+            _strobe_done(gnrc_netdev2);
+            return;
+        }
+        /* the receiver drifted away from the learned phase, search for it */
+        DEBUG("lwmac: phase lost, strobe a full interval\n");
+        lwmac->flags &= ~FLAG_PHASED;
+        neighbor->phase = GNRC_MAC_PHASE_MAX;
+        lwmac->strobe_end = xtimer_now_usec64() + GNRC_LWMAC_WAKEUP_INTERVAL_US +
+                            GNRC_LWMAC_WAKEUP_DURATION_US;
+    }
+    _send_copy(gnrc_netdev2);
+}
+
+static void _event_cb(netdev2_t *dev, netdev2_event_t event)
+{
+    gnrc_netdev2_t *gnrc_netdev2 = (gnrc_netdev2_t *) dev->context;
+
+    if (event == NETDEV2_EVENT_ISR) {
+        msg_t msg;
+
+        if (gnrc_netdev2->isr_pending) {
+            return;
+        }
+        gnrc_netdev2->isr_pending = 1;
+
+        msg.type = NETDEV2_MSG_TYPE_EVENT;
+        msg.content.ptr = gnrc_netdev2;
+
+        if (msg_try_send(&msg, gnrc_netdev2->pid) <= 0) {
+            gnrc_netdev2->isr_pending = 0;
+            puts("gnrc_lwmac: possibly lost interrupt.");
+        }
+        return;
+    }
+    DEBUG("lwmac: event triggered -> %i\n", event);
+    switch (event) {
+        case NETDEV2_EVENT_RX_STARTED:
+            gnrc_netdev2_set_rx_started(gnrc_netdev2, true);
+            break;
+        case NETDEV2_EVENT_RX_COMPLETE: {
+            gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+            gnrc_pktsnip_t *pkt = gnrc_netdev2->recv(gnrc_netdev2);
+
+            gnrc_netdev2_set_rx_started(gnrc_netdev2, false);
+            if (pkt == NULL) {
+                break;
+            }
+            lwmac->stats.rx_count++;
+            if (lwmac->flags & FLAG_LISTENING) {
+                /* give the sender the chance to send more */
+                xtimer_set_msg(&lwmac->sleep_timer, GNRC_LWMAC_RX_LINGER_US,
+                               &lwmac->sleep_msg, gnrc_netdev2->pid);
+            }
+            if (!gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+                DEBUG("lwmac: unable to forward packet of type %i\n", pkt->type);
+                gnrc_pktbuf_release(pkt);
+            }
+            break;
+        }
+        case NETDEV2_EVENT_TX_COMPLETE:
+            _tx_feedback(gnrc_netdev2, TX_FEEDBACK_SUCCESS);
+            break;
+        case NETDEV2_EVENT_TX_NOACK:
+            _tx_feedback(gnrc_netdev2, TX_FEEDBACK_NOACK);
+            break;
+        case NETDEV2_EVENT_TX_MEDIUM_BUSY:
+            _tx_feedback(gnrc_netdev2, TX_FEEDBACK_BUSY);
+            break;
+        default:
+            DEBUG("lwmac: warning: unhandled event %u.\n", event);
+    }
+}
+
+static void _init(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+    netdev2_t *dev = gnrc_netdev2->dev;
+    netopt_enable_t enable = NETOPT_ENABLE;
+    uint8_t retrans = 0;
+
+    /* the MAC repeats the frames itself */
+    dev->driver->set(dev, NETOPT_RETRANS, &retrans, sizeof(retrans));
+    dev->driver->set(dev, NETOPT_RX_START_IRQ, &enable, sizeof(enable));
+    dev->driver->set(dev, NETOPT_TX_END_IRQ, &enable, sizeof(enable));
+
+    lwmac->wakeup_msg.type = GNRC_LWMAC_MSG_TYPE_WAKEUP;
+    lwmac->sleep_msg.type = GNRC_LWMAC_MSG_TYPE_SLEEP;
+    lwmac->tx_msg.type = GNRC_LWMAC_MSG_TYPE_TX;
+    lwmac->stats.since = xtimer_now_usec64();
+    lwmac->wakeup_at = lwmac->stats.since;
+    /* the radio is on after initialization */
+    lwmac->radio_on_at = lwmac->stats.since;
+    lwmac->flags = FLAG_RADIO_ON;
+    _wakeup(gnrc_netdev2);
+}
+
+static void *_lwmac_thread(void *args)
+{
+    gnrc_netdev2_t *gnrc_netdev2 = (gnrc_netdev2_t *) args;
+    netdev2_t *dev = gnrc_netdev2->dev;
+    gnrc_netapi_opt_t *opt;
+    int res;
+    msg_t msg, reply, msg_queue[LWMAC_MSG_QUEUE_SIZE];
+
+    DEBUG("lwmac: starting thread\n");
+    gnrc_netdev2->pid = thread_getpid();
+    msg_init_queue(msg_queue, LWMAC_MSG_QUEUE_SIZE);
+
+    /* register the event callback with the device driver */
+    dev->event_callback = _event_cb;
+    dev->context = (void *) gnrc_netdev2;
+
+    /* register the device to the network stack*/
+    gnrc_netif_add(thread_getpid());
+
+    /* initialize low-level driver */
+    dev->driver->init(dev);
+    _init(gnrc_netdev2);
+
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case NETDEV2_MSG_TYPE_EVENT:
+                gnrc_netdev2->isr_pending = 0;
+                dev->driver->isr(dev);
+                break;
+            case GNRC_LWMAC_MSG_TYPE_WAKEUP:
+                _wakeup(gnrc_netdev2);
+                break;
+            case GNRC_LWMAC_MSG_TYPE_SLEEP:
+                _sleep(gnrc_netdev2);
+                break;
+            case GNRC_LWMAC_MSG_TYPE_TX:
+                _strobe_start(gnrc_netdev2, 2 * GNRC_LWMAC_PHASE_GUARD_US +
+                                            GNRC_LWMAC_WAKEUP_DURATION_US);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SND: {
+                gnrc_pktsnip_t *pkt = msg.content.ptr;
+                gnrc_netif_hdr_t *netif_hdr = pkt->data;
+
+                /* the queues serve lower values first, like the priorities
+                 * of the netif header */
+                if (!gnrc_mac_queue_tx_packet(&gnrc_netdev2->tx, netif_hdr->prio,
+                                              pkt)) {
+                    DEBUG("lwmac: TX queue full, drop packet\n");
+                    gnrc_pktbuf_release(pkt);
+                }
+                _tx_next(gnrc_netdev2);
+                break;
+            }
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                opt = msg.content.ptr;
+                res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
+                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+                reply.content.value = (uint32_t)res;
+                msg_reply(&msg, &reply);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET:
+                opt = msg.content.ptr;
+                res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
+                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+                reply.content.value = (uint32_t)res;
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                DEBUG("lwmac: Unknown command %" PRIu16 "\n", msg.type);
+                break;
+        }
+    }
+    /* never reached */
+    return NULL;
+}
+
+kernel_pid_t gnrc_lwmac_init(char *stack, int stacksize, char priority,
+                             const char *name, gnrc_netdev2_t *gnrc_netdev2)
+{
+    kernel_pid_t res;
+
+    /* check if given netdev device is defined and the driver is set */
+    if (gnrc_netdev2 == NULL || gnrc_netdev2->dev == NULL) {
+        return -ENODEV;
+    }
+
+    res = thread_create(stack, stacksize, priority, THREAD_CREATE_STACKTEST,
+                        _lwmac_thread, (void *)gnrc_netdev2, name);
+    if (res <= 0) {
+        return -EINVAL;
+    }
+
+    return res;
+}
+
+void gnrc_lwmac_get_stats(gnrc_netdev2_t *gnrc_netdev2, gnrc_lwmac_stats_t *stats)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+
+    *stats = lwmac->stats;
+    if (lwmac->flags & FLAG_RADIO_ON) {
+        stats->radio_on += xtimer_now_usec64() - lwmac->radio_on_at;
+    }
+}
+
+unsigned gnrc_lwmac_duty_cycle(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_lwmac_stats_t stats;
+    uint64_t total;
+
+    gnrc_lwmac_get_stats(gnrc_netdev2, &stats);
+    total = xtimer_now_usec64() - stats.since;
+    if (total == 0) {
+        return 1000;
+    }
+    return (unsigned)((stats.radio_on * 1000) / total);
+}
@@ -22,6 +22,7 @@
 
 #include "msg.h"
 #include "thread.h"
+#include "kernel_defines.h"
 
 #include "net/gnrc.h"
 #include "net/gnrc/nettype.h"
@@ -29,6 +30,13 @@
 
 #include "net/gnrc/netdev2.h"
 #include "net/ethernet/hdr.h"
+#ifdef MODULE_GNRC_NETDEV2_CHANHOP
+#include "net/gnrc/netdev2/chanhop.h"
+#endif
+#ifdef MODULE_GNRC_PKTTRACE
+#include "net/gnrc/pkttrace.h"
+#include "xtimer.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -39,6 +47,18 @@
 
 #define NETDEV2_NETAPI_MSG_QUEUE_SIZE 8
 
+#ifdef MODULE_GNRC_NETDEV2_SHARED
+/**
+ * @brief   Type for @ref msg_t of a relay thread adding its device to the
+ *          shared thread
+ */
+#define NETDEV2_MSG_TYPE_ADD    (0x1235)
+
+static kernel_pid_t _shared_pid = KERNEL_PID_UNDEF;
+static char _shared_stack[GNRC_NETDEV2_SHARED_STACKSIZE];
+static gnrc_netdev2_t *_shared_devs[GNRC_NETIF_NUMOF];
+#endif
+
 static void _pass_on_packet(gnrc_pktsnip_t *pkt);
 
 /**
@@ -53,32 +73,74 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event)
     if (event == NETDEV2_EVENT_ISR) {
         msg_t msg;
 
+        /* the thread runs the driver's ISR handler once for everything that
+         * is pending by then, so one queued message is enough */
+        if (gnrc_netdev2->isr_pending) {
+            return;
+        }
+        gnrc_netdev2->isr_pending = 1;
+#ifdef MODULE_GNRC_PKTTRACE
+        gnrc_netdev2->isr_time = xtimer_now_usec();
+#endif
+
         msg.type = NETDEV2_MSG_TYPE_EVENT;
         msg.content.ptr = gnrc_netdev2;
 
-        if (msg_send(&msg, gnrc_netdev2->pid) <= 0) {
+        /* don't block, the driver may signal from within the thread itself */
+#ifdef MODULE_GNRC_NETDEV2_SHARED
+        if (msg_try_send(&msg, _shared_pid) <= 0) {
+#else
+        if (msg_try_send(&msg, gnrc_netdev2->pid) <= 0) {
+#endif
+            gnrc_netdev2->isr_pending = 0;
             puts("gnrc_netdev2: possibly lost interrupt.");
         }
     }
     else {
         DEBUG("gnrc_netdev2: event triggered -> %i\n", event);
+#ifdef MODULE_GNRC_NETDEV2_CHANHOP
+        if ((event == NETDEV2_EVENT_TX_COMPLETE) || (event == NETDEV2_EVENT_TX_NOACK) ||
+            (event == NETDEV2_EVENT_TX_MEDIUM_BUSY)) {
+            gnrc_netdev2_chanhop_tx_done(gnrc_netdev2);
+        }
+#endif
         switch(event) {
             case NETDEV2_EVENT_RX_COMPLETE:
                 {
                     gnrc_pktsnip_t *pkt = gnrc_netdev2->recv(gnrc_netdev2);
 
                     if (pkt) {
+#ifdef MODULE_GNRC_PKTTRACE
+                        gnrc_pkttrace_start(pkt, gnrc_netdev2->isr_time);
+                        gnrc_pkttrace_hop(pkt, GNRC_PKTTRACE_RX_NETDEV);
+#endif
                         _pass_on_packet(pkt);
                     }
 
                     break;
                 }
-#ifdef MODULE_NETSTATS_L2
+#if defined(MODULE_NETSTATS_L2) || defined(MODULE_NETSTATS_NEIGHBOR)
             case NETDEV2_EVENT_TX_MEDIUM_BUSY:
+#ifdef MODULE_NETSTATS_L2
                 dev->stats.tx_failed++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                /* the frame never made it to the neighbor */
+                netstats_nb_drop_tx(&gnrc_netdev2->nb_stats);
+#endif
                 break;
             case NETDEV2_EVENT_TX_COMPLETE:
+#ifdef MODULE_NETSTATS_L2
                 dev->stats.tx_success++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                netstats_nb_update_tx(&gnrc_netdev2->nb_stats, true);
+#endif
+                break;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+            case NETDEV2_EVENT_TX_NOACK:
+                netstats_nb_update_tx(&gnrc_netdev2->nb_stats, false);
                 break;
 #endif
             default:
@@ -97,6 +159,301 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+static void _loan_release(gnrc_pkt_loan_t *loan, void *data)
+{
+    gnrc_netdev2_t *gnrc_netdev2 = container_of(loan, gnrc_netdev2_t, loan);
+    netdev2_t *dev = gnrc_netdev2->dev;
+
+    dev->driver->recv_return(dev, data);
+}
+#endif
+
+gnrc_pktsnip_t *gnrc_netdev2_recv_frame(gnrc_netdev2_t *gnrc_netdev2, void *info)
+{
+    netdev2_t *dev = gnrc_netdev2->dev;
+    gnrc_pktsnip_t *pkt;
+    int nread;
+
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+    if (dev->driver->recv_loan != NULL) {
+        void *buf;
+
+        nread = dev->driver->recv_loan(dev, &buf, info);
+        if (nread <= 0) {
+            return NULL;
+        }
+        pkt = gnrc_pktbuf_add_loaned(NULL, buf, nread, GNRC_NETTYPE_UNDEF,
+                                     &gnrc_netdev2->loan);
+        if (pkt == NULL) {
+            DEBUG("gnrc_netdev2: cannot allocate pktsnip.\n");
+            dev->driver->recv_return(dev, buf);
+        }
+        return pkt;
+    }
+#endif
+    nread = dev->driver->recv(dev, NULL, 0, NULL);
+    if (nread <= 0) {
+        return NULL;
+    }
+    pkt = gnrc_pktbuf_add_quota(NULL, NULL, nread, GNRC_NETTYPE_UNDEF,
+                                GNRC_PKTBUF_QUOTA_RX);
+    if (pkt == NULL) {
+        DEBUG("gnrc_netdev2: cannot allocate pktsnip.\n");
+        /* drop the packet */
+        dev->driver->recv(dev, NULL, nread, NULL);
+        return NULL;
+    }
+    nread = dev->driver->recv(dev, pkt->data, pkt->size, info);
+    if (nread <= 0) {
+        DEBUG("gnrc_netdev2: read error.\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    if ((size_t)nread < pkt->size) {
+        /* we've got less then the expected packet size,
+         * so free the unused space.*/
+        gnrc_pktbuf_realloc_data(pkt, nread);
+    }
+    return pkt;
+}
+
+#ifdef MODULE_NETSTATS_NEIGHBOR
+/**
+ * @brief   Records the link-layer destination of a packet to send
+ *
+ * The outcome of the transmission is reported by the TX events of the device,
+ * which arrive before the next packet is sent.
+ */
+static void _nb_record(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr;
+
+    if ((pkt == NULL) || (pkt->type != GNRC_NETTYPE_NETIF)) {
+        netstats_nb_drop_tx(&gnrc_netdev2->nb_stats);
+        return;
+    }
+    hdr = pkt->data;
+    if (hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        netstats_nb_drop_tx(&gnrc_netdev2->nb_stats);
+        return;
+    }
+    netstats_nb_record(&gnrc_netdev2->nb_stats, gnrc_netif_hdr_get_dst_addr(hdr),
+                       hdr->dst_l2addr_len);
+}
+#endif
+
+/**
+ * @brief   Sets up the device from the thread that services its driver
+ */
+static void _setup(gnrc_netdev2_t *gnrc_netdev2)
+{
+    netdev2_t *dev = gnrc_netdev2->dev;
+
+    /* register the event callback with the device driver */
+    dev->event_callback = _event_cb;
+    dev->context = (void*) gnrc_netdev2;
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+    gnrc_netdev2->loan.release = _loan_release;
+#endif
+
+    /* register the device to the network stack*/
+    gnrc_netif_add(gnrc_netdev2->pid);
+
+    /* initialize low-level driver */
+    dev->driver->init(dev);
+#ifdef MODULE_GNRC_NETDEV2_CHANHOP
+    gnrc_netdev2_chanhop_init(gnrc_netdev2);
+#endif
+}
+
+/**
+ * @brief   Dispatches a NETDEV or NETAPI message for a device
+ */
+static void _handle(gnrc_netdev2_t *gnrc_netdev2, msg_t *msg)
+{
+    netdev2_t *dev = gnrc_netdev2->dev;
+    gnrc_netapi_opt_t *opt;
+    int res;
+    msg_t reply;
+
+    switch (msg->type) {
+        case NETDEV2_MSG_TYPE_EVENT:
+            DEBUG("gnrc_netdev2: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
+            gnrc_netdev2->isr_pending = 0;
+            dev->driver->isr(dev);
+            break;
+#ifdef MODULE_GNRC_NETDEV2_CHANHOP
+        case GNRC_NETDEV2_MSG_TYPE_CHANHOP:
+            gnrc_netdev2_chanhop_slot(gnrc_netdev2);
+            break;
+#endif
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SND received\n");
+            gnrc_pktsnip_t *pkt = msg->content.ptr;
+#ifdef MODULE_NETSTATS_NEIGHBOR
+            _nb_record(gnrc_netdev2, pkt);
+#endif
+#ifdef MODULE_GNRC_PKTTRACE
+            gnrc_pkttrace_hop(pkt, GNRC_PKTTRACE_TX_NETDEV);
+            uint32_t send_start = xtimer_now_usec();
+#endif
+            gnrc_netdev2->send(gnrc_netdev2, pkt);
+#ifdef MODULE_GNRC_PKTTRACE
+            /* the packet is released by now */
+            gnrc_pkttrace_record(GNRC_PKTTRACE_TX_DRIVER,
+                                 xtimer_now_usec() - send_start);
+#endif
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SET:
+            /* read incoming options */
+            opt = msg->content.ptr;
+            DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SET received. opt=%s\n",
+                    netopt2str(opt->opt));
+#ifdef MODULE_GNRC_NETDEV2_CHANHOP
+            res = gnrc_netdev2_chanhop_set(gnrc_netdev2, opt->opt, opt->data,
+                                           opt->data_len);
+            if (res == -ENOTSUP)
+#endif
+            /* set option for device driver */
+            res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
+            DEBUG("gnrc_netdev2: response of netdev->set: %i\n", res);
+            /* send reply to calling thread */
+            reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+            reply.content.value = (uint32_t)res;
+            msg_reply(msg, &reply);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_GET:
+            /* read incoming options */
+            opt = msg->content.ptr;
+            DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_GET received. opt=%s\n",
+                    netopt2str(opt->opt));
+#ifdef MODULE_NETSTATS_NEIGHBOR
+            if ((opt->opt == NETOPT_STATS) && (opt->context == NETSTATS_NEIGHBOR)) {
+                assert(opt->data_len == sizeof(uintptr_t));
+                *((netstats_nb_table_t **)opt->data) = &gnrc_netdev2->nb_stats;
+                res = sizeof(uintptr_t);
+            }
+            else
+#endif
+#ifdef MODULE_GNRC_NETDEV2_CHANHOP
+            if ((res = gnrc_netdev2_chanhop_get(gnrc_netdev2, opt->opt, opt->data,
+                                                opt->data_len)) == -ENOTSUP)
+#endif
+            /* get option from device driver */
+            res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
+            DEBUG("gnrc_netdev2: response of netdev->get: %i\n", res);
+            /* send reply to calling thread */
+            reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+            reply.content.value = (uint32_t)res;
+            msg_reply(msg, &reply);
+            break;
+        default:
+            DEBUG("gnrc_netdev2: Unknown command %" PRIu16 "\n", msg->type);
+            break;
+    }
+}
+
+#ifdef MODULE_GNRC_NETDEV2_SHARED
+/**
+ * @brief   Shared thread: event loop servicing the drivers of all devices
+ *
+ * Device events carry their device. NETAPI messages arrive from the relay
+ * threads, whose PIDs identify the devices.
+ *
+ * @return          never returns
+ */
+static void *_shared_thread(void *args)
+{
+    (void)args;
+    msg_t msg, reply, msg_queue[GNRC_NETDEV2_SHARED_MSG_QUEUE_SIZE];
+    gnrc_netapi_backlog_t backlog = { 0 };
+
+    DEBUG("gnrc_netdev2: starting shared thread\n");
+    msg_init_queue(msg_queue, GNRC_NETDEV2_SHARED_MSG_QUEUE_SIZE);
+
+    while (1) {
+        gnrc_netdev2_t *gnrc_netdev2 = NULL;
+
+        gnrc_netapi_receive_prio(&backlog, &msg);
+        if (msg.type == NETDEV2_MSG_TYPE_EVENT) {
+            gnrc_netdev2 = msg.content.ptr;
+        }
+        else if (msg.type == NETDEV2_MSG_TYPE_ADD) {
+            reply.content.value = (uint32_t)(-ENOMEM);
+            for (unsigned i = 0; i < GNRC_NETIF_NUMOF; i++) {
+                if (_shared_devs[i] == NULL) {
+                    _shared_devs[i] = msg.content.ptr;
+                    _setup(_shared_devs[i]);
+                    reply.content.value = 0;
+                    break;
+                }
+            }
+            msg_reply(&msg, &reply);
+            continue;
+        }
+        else {
+            for (unsigned i = 0; i < GNRC_NETIF_NUMOF; i++) {
+                if ((_shared_devs[i] != NULL) &&
+                    (_shared_devs[i]->pid == msg.sender_pid)) {
+                    gnrc_netdev2 = _shared_devs[i];
+                    break;
+                }
+            }
+        }
+        if (gnrc_netdev2 == NULL) {
+            DEBUG("gnrc_netdev2: message from unknown device %" PRIkernel_pid "\n",
+                  msg.sender_pid);
+            continue;
+        }
+        _handle(gnrc_netdev2, &msg);
+    }
+    /* never reached */
+    return NULL;
+}
+
+/**
+ * @brief   Relay thread of a device: hands its NETAPI messages to the shared
+ *          thread in the order they arrive
+ *
+ * @param[in] args  expects a pointer to the gnrc_netdev2 device
+ *
+ * @return          only if the shared thread has no room for the device
+ */
+static void *_relay_thread(void *args)
+{
+    gnrc_netdev2_t *gnrc_netdev2 = (gnrc_netdev2_t*) args;
+    msg_t msg, reply, msg_queue[GNRC_NETDEV2_RELAY_MSG_QUEUE_SIZE];
+
+    gnrc_netdev2->pid = thread_getpid();
+    msg_init_queue(msg_queue, GNRC_NETDEV2_RELAY_MSG_QUEUE_SIZE);
+
+    msg.type = NETDEV2_MSG_TYPE_ADD;
+    msg.content.ptr = gnrc_netdev2;
+    msg_send_receive(&msg, &reply, _shared_pid);
+    if (reply.content.value != 0) {
+        DEBUG("gnrc_netdev2: no room for device in shared thread\n");
+        return NULL;
+    }
+
+    while (1) {
+        msg_receive(&msg);
+        if ((msg.type == GNRC_NETAPI_MSG_TYPE_GET) ||
+            (msg.type == GNRC_NETAPI_MSG_TYPE_SET)) {
+            kernel_pid_t sender_pid = msg.sender_pid;
+
+            msg_send_receive(&msg, &reply, _shared_pid);
+            msg.sender_pid = sender_pid;
+            msg_reply(&msg, &reply);
+        }
+        else {
+            msg_send(&msg, _shared_pid);
+        }
+    }
+    /* never reached */
+    return NULL;
+}
+#else
 /**
  * @brief   Startup code and event loop of the gnrc_netdev2 layer
  *
@@ -109,76 +466,27 @@ static void *_gnrc_netdev2_thread(void *args)
     DEBUG("gnrc_netdev2: starting thread\n");
 
     gnrc_netdev2_t *gnrc_netdev2 = (gnrc_netdev2_t*) args;
-    netdev2_t *dev = gnrc_netdev2->dev;
+    msg_t msg, msg_queue[NETDEV2_NETAPI_MSG_QUEUE_SIZE];
+    gnrc_netapi_backlog_t backlog = { 0 };
 
     gnrc_netdev2->pid = thread_getpid();
 
-    gnrc_netapi_opt_t *opt;
-    int res;
-    msg_t msg, reply, msg_queue[NETDEV2_NETAPI_MSG_QUEUE_SIZE];
-
     /* setup the MAC layers message queue */
     msg_init_queue(msg_queue, NETDEV2_NETAPI_MSG_QUEUE_SIZE);
 
-    /* register the event callback with the device driver */
-    dev->event_callback = _event_cb;
-    dev->context = (void*) gnrc_netdev2;
-
-    /* register the device to the network stack*/
-    gnrc_netif_add(thread_getpid());
-
-    /* initialize low-level driver */
-    dev->driver->init(dev);
+    _setup(gnrc_netdev2);
 
     /* start the event loop */
     while (1) {
         DEBUG("gnrc_netdev2: waiting for incoming messages\n");
-        msg_receive(&msg);
+        gnrc_netapi_receive_prio(&backlog, &msg);
         /* dispatch NETDEV and NETAPI messages */
-        switch (msg.type) {
-            case NETDEV2_MSG_TYPE_EVENT:
-                DEBUG("gnrc_netdev2: GNRC_NETDEV_MSG_TYPE_EVENT received\n");
-                dev->driver->isr(dev);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SND received\n");
-                gnrc_pktsnip_t *pkt = msg.content.ptr;
-                gnrc_netdev2->send(gnrc_netdev2, pkt);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_SET:
-                /* read incoming options */
-                opt = msg.content.ptr;
-                DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SET received. opt=%s\n",
-                        netopt2str(opt->opt));
-                /* set option for device driver */
-                res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
-                DEBUG("gnrc_netdev2: response of netdev->set: %i\n", res);
-                /* send reply to calling thread */
-                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
-                reply.content.value = (uint32_t)res;
-                msg_reply(&msg, &reply);
-                break;
-            case GNRC_NETAPI_MSG_TYPE_GET:
-                /* read incoming options */
-                opt = msg.content.ptr;
-                DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_GET received. opt=%s\n",
-                        netopt2str(opt->opt));
-                /* get option from device driver */
-                res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
-                DEBUG("gnrc_netdev2: response of netdev->get: %i\n", res);
-                /* send reply to calling thread */
-                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
-                reply.content.value = (uint32_t)res;
-                msg_reply(&msg, &reply);
-                break;
-            default:
-                DEBUG("gnrc_netdev2: Unknown command %" PRIu16 "\n", msg.type);
-                break;
-        }
+        _handle(gnrc_netdev2, &msg);
     }
     /* never reached */
     return NULL;
 }
+#endif
 
 kernel_pid_t gnrc_netdev2_init(char *stack, int stacksize, char priority,
                         const char *name, gnrc_netdev2_t *gnrc_netdev2)
@@ -190,9 +498,25 @@ kernel_pid_t gnrc_netdev2_init(char *stack, int stacksize, char priority,
         return -ENODEV;
     }
 
+#ifdef MODULE_GNRC_NETDEV2_SHARED
+    if (_shared_pid == KERNEL_PID_UNDEF) {
+        res = thread_create(_shared_stack, sizeof(_shared_stack),
+                            GNRC_NETDEV2_SHARED_PRIO, THREAD_CREATE_STACKTEST,
+                            _shared_thread, NULL, "netdev2");
+        if (res <= 0) {
+            return -EINVAL;
+        }
+        _shared_pid = res;
+    }
+
+    /* create the relay thread of the device */
+    res = thread_create(stack, stacksize, priority, THREAD_CREATE_STACKTEST,
+                        _relay_thread, (void *)gnrc_netdev2, name);
+#else
     /* create new gnrc_netdev2 thread */
     res = thread_create(stack, stacksize, priority, THREAD_CREATE_STACKTEST,
                          _gnrc_netdev2_thread, (void *)gnrc_netdev2, name);
+#endif
     if (res <= 0) {
         return -EINVAL;
     }
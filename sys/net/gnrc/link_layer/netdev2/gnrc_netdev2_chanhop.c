@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#ifdef MODULE_GNRC_NETDEV2_CHANHOP
+
+#include <errno.h>
+#include <inttypes.h>
+
+#include "xtimer.h"
+#include "net/gnrc/netdev2/chanhop.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static const uint8_t _seq[] = GNRC_NETDEV2_CHANHOP_SEQ;
+
+#define _SEQ_LEN    (sizeof(_seq) / sizeof(_seq[0]))
+
+static void _set_chan(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_netdev2_chanhop_t *hop = &gnrc_netdev2->chanhop;
+    netdev2_t *dev = gnrc_netdev2->dev;
+    netopt_state_t state;
+    uint16_t chan = _seq[hop->asn % _SEQ_LEN];
+
+    if ((dev->driver->get(dev, NETOPT_STATE, &state, sizeof(state)) > 0) &&
+        (state == NETOPT_STATE_TX)) {
+        DEBUG("gnrc_netdev2_chanhop: slot %" PRIu32 " waits for TX\n", hop->asn);
+        hop->pending = 1;
+        return;
+    }
+    hop->pending = 0;
+    DEBUG("gnrc_netdev2_chanhop: slot %" PRIu32 " on channel %u\n", hop->asn,
+          (unsigned)chan);
+    dev->driver->set(dev, NETOPT_CHANNEL, &chan, sizeof(chan));
+}
+
+static void _start(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_netdev2_chanhop_t *hop = &gnrc_netdev2->chanhop;
+
+    hop->slot_start = xtimer_now_usec();
+    _set_chan(gnrc_netdev2);
+    xtimer_set_msg(&hop->timer, GNRC_NETDEV2_CHANHOP_SLOT_US, &hop->msg,
+                   gnrc_netdev2->pid);
+}
+
+void gnrc_netdev2_chanhop_init(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_netdev2_chanhop_t *hop = &gnrc_netdev2->chanhop;
+
+    hop->msg.type = GNRC_NETDEV2_MSG_TYPE_CHANHOP;
+    hop->msg.content.ptr = gnrc_netdev2;
+    hop->asn = 0;
+    hop->enabled = 0;
+    hop->pending = 0;
+}
+
+void gnrc_netdev2_chanhop_slot(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_netdev2_chanhop_t *hop = &gnrc_netdev2->chanhop;
+    int32_t late;
+
+    if (!hop->enabled) {
+        return;
+    }
+    /* a message of the timer from before a restart */
+    if ((int32_t)(xtimer_now_usec() - hop->slot_start) <
+        (int32_t)(GNRC_NETDEV2_CHANHOP_SLOT_US / 2)) {
+        return;
+    }
+    /* skip the slots the thread was too busy for, so the ASN keeps in step
+     * with time */
+    do {
+        hop->slot_start += GNRC_NETDEV2_CHANHOP_SLOT_US;
+        hop->asn++;
+        late = (int32_t)(xtimer_now_usec() - hop->slot_start);
+    } while (late >= (int32_t)GNRC_NETDEV2_CHANHOP_SLOT_US);
+    _set_chan(gnrc_netdev2);
+    xtimer_set_msg(&hop->timer, GNRC_NETDEV2_CHANHOP_SLOT_US - ((late > 0) ? late : 0),
+                   &hop->msg, gnrc_netdev2->pid);
+}
+
+void gnrc_netdev2_chanhop_tx_done(gnrc_netdev2_t *gnrc_netdev2)
+{
+    if (gnrc_netdev2->chanhop.enabled && gnrc_netdev2->chanhop.pending) {
+        _set_chan(gnrc_netdev2);
+    }
+}
+
+int gnrc_netdev2_chanhop_get(gnrc_netdev2_t *gnrc_netdev2, netopt_t opt,
+                             void *value, size_t max_len)
+{
+    gnrc_netdev2_chanhop_t *hop = &gnrc_netdev2->chanhop;
+
+    switch (opt) {
+        case NETOPT_CHANNEL_HOP:
+            if (max_len < sizeof(netopt_enable_t)) {
+                return -EOVERFLOW;
+            }
+            *((netopt_enable_t *)value) = (hop->enabled) ? NETOPT_ENABLE
+                                                         : NETOPT_DISABLE;
+            return sizeof(netopt_enable_t);
+        case NETOPT_CHANNEL_HOP_ASN:
+            if (max_len < sizeof(uint32_t)) {
+                return -EOVERFLOW;
+            }
+            *((uint32_t *)value) = hop->asn;
+            return sizeof(uint32_t);
+        default:
+            return -ENOTSUP;
+    }
+}
+
+int gnrc_netdev2_chanhop_set(gnrc_netdev2_t *gnrc_netdev2, netopt_t opt,
+                             const void *value, size_t len)
+{
+    gnrc_netdev2_chanhop_t *hop = &gnrc_netdev2->chanhop;
+
+    switch (opt) {
+        case NETOPT_CHANNEL_HOP:
+            if (len != sizeof(netopt_enable_t)) {
+                return -EINVAL;
+            }
+            xtimer_remove(&hop->timer);
+            hop->enabled = (*((const netopt_enable_t *)value) == NETOPT_ENABLE);
+            if (hop->enabled) {
+                _start(gnrc_netdev2);
+            }
+            return sizeof(netopt_enable_t);
+        case NETOPT_CHANNEL_HOP_ASN:
+            if (len != sizeof(uint32_t)) {
+                return -EINVAL;
+            }
+            hop->asn = *((const uint32_t *)value);
+            if (hop->enabled) {
+                xtimer_remove(&hop->timer);
+                _start(gnrc_netdev2);
+            }
+            return sizeof(uint32_t);
+        default:
+            return -ENOTSUP;
+    }
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_NETDEV2_CHANHOP */
+
+/** @} */
@@ -31,38 +31,9 @@
 
 static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
 {
-    netdev2_t *dev = gnrc_netdev2->dev;
-    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
-    gnrc_pktsnip_t *pkt = NULL;
-
-    if (bytes_expected > 0) {
-        pkt = gnrc_pktbuf_add(NULL, NULL,
-                bytes_expected,
-                GNRC_NETTYPE_UNDEF);
-
-        if(!pkt) {
-            DEBUG("_recv_ethernet_packet: cannot allocate pktsnip.\n");
-
-            /* drop the packet */
-            dev->driver->recv(dev, NULL, bytes_expected, NULL);
-
-            goto out;
-        }
-
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
-        if(nread <= 0) {
-            DEBUG("_recv_ethernet_packet: read error.\n");
-            goto safe_out;
-        }
-
-        if (nread < bytes_expected) {
-            /* we've got less then the expected packet size,
-             * so free the unused space.*/
-
-            DEBUG("_recv_ethernet_packet: reallocating.\n");
-            gnrc_pktbuf_realloc_data(pkt, nread);
-        }
+    gnrc_pktsnip_t *pkt = gnrc_netdev2_recv_frame(gnrc_netdev2, NULL);
 
+    if (pkt != NULL) {
         /* mark ethernet header */
         gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
         if (!eth_hdr) {
@@ -90,21 +61,31 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
         gnrc_netif_hdr_init(netif_hdr->data, ETHERNET_ADDR_LEN, ETHERNET_ADDR_LEN);
         gnrc_netif_hdr_set_src_addr(netif_hdr->data, hdr->src, ETHERNET_ADDR_LEN);
         gnrc_netif_hdr_set_dst_addr(netif_hdr->data, hdr->dst, ETHERNET_ADDR_LEN);
-        ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = thread_getpid();
+        ((gnrc_netif_hdr_t *)netif_hdr->data)->if_pid = gnrc_netdev2->pid;
+
+        netdev2_t *dev = gnrc_netdev2->dev;
+        uint16_t offloads;
+
+        if ((dev->driver->get(dev, NETOPT_OFFLOADS, &offloads,
+                              sizeof(offloads)) >= 0) &&
+            (offloads & NETOPT_OFFLOAD_CSUM_RX)) {
+            /* upper layers can skip their checksum check */
+            ((gnrc_netif_hdr_t *)netif_hdr->data)->flags |= GNRC_NETIF_HDR_FLAGS_CSUM;
+        }
 
         DEBUG("gnrc_netdev2_eth: received packet from %02x:%02x:%02x:%02x:%02x:%02x "
                 "of length %d\n",
                 hdr->src[0], hdr->src[1], hdr->src[2], hdr->src[3], hdr->src[4],
-                hdr->src[5], nread);
+                hdr->src[5], (int)(eth_hdr->size + pkt->size));
 #if defined(MODULE_OD) && ENABLE_DEBUG
-        od_hex_dump(hdr, nread, OD_WIDTH_DEFAULT);
+        od_hex_dump(hdr, eth_hdr->size, OD_WIDTH_DEFAULT);
+        od_hex_dump(pkt->data, pkt->size, OD_WIDTH_DEFAULT);
 #endif
 
         gnrc_pktbuf_remove_snip(pkt, eth_hdr);
         LL_APPEND(pkt, netif_hdr);
     }
 
-out:
     return pkt;
 
 safe_out:
@@ -198,26 +179,33 @@ static int _send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
           hdr.dst[0], hdr.dst[1], hdr.dst[2],
           hdr.dst[3], hdr.dst[4], hdr.dst[5]);
 
-    size_t n;
-    payload = gnrc_pktbuf_get_iovec(pkt, &n);   /* use payload as temporary
-                                                 * variable */
-    res = -ENOBUFS;
-    if (payload != NULL) {
+    struct iovec stack_vec[GNRC_NETDEV2_IOVEC_NUMOF];
+    struct iovec *vector = stack_vec;
+    size_t n = gnrc_pkt_fill_iovec(pkt, stack_vec, GNRC_NETDEV2_IOVEC_NUMOF);
+
+    if (n == 0) {
+        payload = gnrc_pktbuf_get_iovec(pkt, &n);   /* use payload as temporary
+                                                     * variable */
+        if (payload == NULL) {
+            gnrc_pktbuf_release(pkt);
+            return -ENOBUFS;
+        }
         pkt = payload;      /* reassign for later release; vec_snip is prepended to pkt */
-        struct iovec *vector = (struct iovec *)pkt->data;
-        vector[0].iov_base = (char*)&hdr;
-        vector[0].iov_len = sizeof(ethernet_hdr_t);
+        vector = (struct iovec *)pkt->data;
+    }
+    /* the netif header snip is replaced by the ethernet header */
+    vector[0].iov_base = (char*)&hdr;
+    vector[0].iov_len = sizeof(ethernet_hdr_t);
 #ifdef MODULE_NETSTATS_L2
-        if ((netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_BROADCAST) ||
-            (netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
-            gnrc_netdev2->dev->stats.tx_mcast_count++;
-        }
-        else {
-            gnrc_netdev2->dev->stats.tx_unicast_count++;
-        }
-#endif
-        res = dev->driver->send(dev, vector, n);
+    if ((netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_BROADCAST) ||
+        (netif_hdr->flags & GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        gnrc_netdev2->dev->stats.tx_mcast_count++;
     }
+    else {
+        gnrc_netdev2->dev->stats.tx_unicast_count++;
+    }
+#endif
+    res = dev->driver->send(dev, vector, n);
 
     gnrc_pktbuf_release(pkt);
 
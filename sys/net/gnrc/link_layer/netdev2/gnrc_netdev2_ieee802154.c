@@ -13,8 +13,11 @@
  * @author  Martine Lenders <mlenders@inf.fu-berlin.de>
  */
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 
+#include "hashes.h"
 #include "od.h"
 #include "net/gnrc.h"
 #include "net/ieee802154.h"
@@ -27,29 +30,82 @@
 static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2);
 static int _send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt);
 
+#if defined(MODULE_NETDEV2_IEEE802154) && defined(MODULE_GNRC_NETDEV2_DEDUP)
+/* the hashes of sys/hashes take the length as size_t */
+static uint32_t _djb2(const uint8_t *buf, int len)
+{
+    return djb2_hash(buf, len);
+}
+
+static uint32_t _sdbm(const uint8_t *buf, int len)
+{
+    return sdbm_hash(buf, len);
+}
+
+static uint32_t _fnv(const uint8_t *buf, int len)
+{
+    return fnv_hash(buf, len);
+}
+
+static hashfp_t _dedup_hashes[] = { _djb2, _sdbm, _fnv };
+#endif
+
 int gnrc_netdev2_ieee802154_init(gnrc_netdev2_t *gnrc_netdev2,
                                  netdev2_ieee802154_t *dev)
 {
     gnrc_netdev2->send = _send;
     gnrc_netdev2->recv = _recv;
     gnrc_netdev2->dev = (netdev2_t *)dev;
+#if defined(MODULE_NETDEV2_IEEE802154) && defined(MODULE_GNRC_NETDEV2_DEDUP)
+    for (unsigned i = 0; i < 2; i++) {
+        memset(gnrc_netdev2->dedup.bits[i], 0, sizeof(gnrc_netdev2->dedup.bits[i]));
+        bloom_init(&gnrc_netdev2->dedup.filter[i], GNRC_NETDEV2_DEDUP_BITS,
+                   gnrc_netdev2->dedup.bits[i], _dedup_hashes,
+                   sizeof(_dedup_hashes) / sizeof(_dedup_hashes[0]));
+    }
+    gnrc_netdev2->dedup.cur = 0;
+    gnrc_netdev2->dedup.count = 0;
+#endif
 
     return 0;
 }
 
-static gnrc_pktsnip_t *_make_netif_hdr(uint8_t *mhr)
+/* Parses the common header shapes directly: short or long addresses on both
+ * sides with PAN ID compression. Returns the header length, or 0 if the frame
+ * needs the generic parser. */
+static size_t _parse_common(const uint8_t *mhr, uint8_t *src, uint8_t *dst,
+                            int *addr_len)
 {
-    gnrc_pktsnip_t *snip;
-    uint8_t src[IEEE802154_LONG_ADDRESS_LEN], dst[IEEE802154_LONG_ADDRESS_LEN];
-    int src_len, dst_len;
-    le_uint16_t _pan_tmp;   /* TODO: hand-up PAN IDs to GNRC? */
-
-    dst_len = ieee802154_get_dst(mhr, dst, &_pan_tmp);
-    src_len = ieee802154_get_src(mhr, src, &_pan_tmp);
-    if ((dst_len < 0) || (src_len < 0)) {
-        DEBUG("_make_netif_hdr: unable to get addresses\n");
-        return NULL;
+    unsigned len;
+
+    if (!(mhr[0] & IEEE802154_FCF_PAN_COMP)) {
+        return 0;
+    }
+    switch (mhr[1] & (IEEE802154_FCF_DST_ADDR_MASK | IEEE802154_FCF_SRC_ADDR_MASK)) {
+        case (IEEE802154_FCF_DST_ADDR_SHORT | IEEE802154_FCF_SRC_ADDR_SHORT):
+            len = IEEE802154_SHORT_ADDRESS_LEN;
+            break;
+        case (IEEE802154_FCF_DST_ADDR_LONG | IEEE802154_FCF_SRC_ADDR_LONG):
+            len = IEEE802154_LONG_ADDRESS_LEN;
+            break;
+        default:
+            return 0;
     }
+    /* 0-1: FCF, 2: seq, 3-4: dst PAN, addresses in little endian */
+    mhr += 5;
+    for (unsigned i = 0; i < len; i++) {
+        dst[len - 1 - i] = mhr[i];
+        src[len - 1 - i] = mhr[len + i];
+    }
+    *addr_len = len;
+    return 5 + (2 * len);
+}
+
+static gnrc_pktsnip_t *_make_netif_hdr(uint8_t *src, int src_len,
+                                       uint8_t *dst, int dst_len)
+{
+    gnrc_pktsnip_t *snip;
+
     /* allocate space for header */
     snip = gnrc_netif_hdr_build(src, (size_t)src_len, dst, (size_t)dst_len);
     if (snip == NULL) {
@@ -64,37 +120,130 @@ static gnrc_pktsnip_t *_make_netif_hdr(uint8_t *mhr)
     return snip;
 }
 
+#if defined(MODULE_NETDEV2_IEEE802154) && defined(MODULE_GNRC_NETDEV2_DEDUP)
+/* Returns true if the frame was seen before, remembers it otherwise */
+static bool _dedup(gnrc_netdev2_dedup_t *dedup, uint8_t seq, const uint8_t *src,
+                   int src_len)
+{
+    uint8_t key[1 + IEEE802154_LONG_ADDRESS_LEN];
+    size_t key_len = 1 + src_len;
+
+    key[0] = seq;
+    memcpy(&key[1], src, src_len);
+    if (bloom_check(&dedup->filter[0], key, key_len) ||
+        bloom_check(&dedup->filter[1], key, key_len)) {
+        return true;
+    }
+    if (dedup->count >= GNRC_NETDEV2_DEDUP_FRAMES) {
+        /* the older filter takes over */
+        dedup->cur ^= 1;
+        memset(dedup->bits[dedup->cur], 0, sizeof(dedup->bits[dedup->cur]));
+        dedup->count = 0;
+    }
+    bloom_add(&dedup->filter[dedup->cur], key, key_len);
+    dedup->count++;
+    return false;
+}
+#endif
+
+/* Does in software what the device does not report in NETOPT_OFFLOADS.
+ * Returns true if the frame is to be dropped. */
+static bool _sw_filter(gnrc_netdev2_t *gnrc_netdev2, const uint8_t *mhr,
+                       const uint8_t *src, int src_len)
+{
+    netdev2_t *dev = gnrc_netdev2->dev;
+    uint16_t offloads;
+
+    if (dev->driver->get(dev, NETOPT_OFFLOADS, &offloads, sizeof(offloads)) < 0) {
+        offloads = 0;
+    }
+    /* acknowledgements are for the radio, not for the upper layers */
+    if (!(offloads & NETOPT_OFFLOAD_ADDR_FILTER) &&
+        ((mhr[0] & IEEE802154_FCF_TYPE_MASK) == IEEE802154_FCF_TYPE_ACK)) {
+        DEBUG("_recv_ieee802154: dropping ACK frame\n");
+        return true;
+    }
+#ifdef MODULE_NETDEV2_IEEE802154
+    if (src_len <= 0) {
+        return false;
+    }
+#ifdef MODULE_GNRC_NETDEV2_DEDUP
+    /* copies of frames without acknowledgement come from frame repetitions
+     * of the MAC layer or from the same broadcast taking several paths */
+    if (!(mhr[0] & IEEE802154_FCF_ACK_REQ)) {
+        if (_dedup(&gnrc_netdev2->dedup, ieee802154_get_seq(mhr), src, src_len)) {
+            DEBUG("_recv_ieee802154: dropping duplicate broadcast\n");
+#ifdef MODULE_NETSTATS_L2
+            dev->stats.rx_dup_count++;
+#endif
+            return true;
+        }
+        return false;
+    }
+#endif
+    if ((offloads & NETOPT_OFFLOAD_DUP_FILTER) || !(mhr[0] & IEEE802154_FCF_ACK_REQ)) {
+        return false;
+    }
+    /* a retransmission because our acknowledgement got lost */
+    if ((ieee802154_get_seq(mhr) == gnrc_netdev2->last_rx_seq) &&
+        ((unsigned)src_len == gnrc_netdev2->last_rx_src_len) &&
+        (memcmp(src, gnrc_netdev2->last_rx_src, src_len) == 0)) {
+        DEBUG("_recv_ieee802154: dropping duplicate frame\n");
+#ifdef MODULE_NETSTATS_L2
+        dev->stats.rx_dup_count++;
+#endif
+        return true;
+    }
+    memcpy(gnrc_netdev2->last_rx_src, src, src_len);
+    gnrc_netdev2->last_rx_src_len = src_len;
+    gnrc_netdev2->last_rx_seq = ieee802154_get_seq(mhr);
+#else
+    (void)src;
+    (void)src_len;
+#endif
+    return false;
+}
+
 static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
 {
-    netdev2_t *netdev = gnrc_netdev2->dev;
     netdev2_ieee802154_rx_info_t rx_info;
     netdev2_ieee802154_t *state = (netdev2_ieee802154_t *)gnrc_netdev2->dev;
-    gnrc_pktsnip_t *pkt = NULL;
-    int bytes_expected = netdev->driver->recv(netdev, NULL, 0, NULL);
+    gnrc_pktsnip_t *pkt = gnrc_netdev2_recv_frame(gnrc_netdev2, &rx_info);
 
-    if (bytes_expected > 0) {
-        int nread;
+    if (pkt != NULL) {
+        int nread = pkt->size;
 
-        pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
-        if (pkt == NULL) {
-            DEBUG("_recv_ieee802154: cannot allocate pktsnip.\n");
-            return NULL;
-        }
-        nread = netdev->driver->recv(netdev, pkt->data, bytes_expected, &rx_info);
-        if (nread <= 0) {
-            gnrc_pktbuf_release(pkt);
-            return NULL;
-        }
         if (!(state->flags & NETDEV2_IEEE802154_RAW)) {
             gnrc_pktsnip_t *ieee802154_hdr, *netif_hdr;
             gnrc_netif_hdr_t *hdr;
+            uint8_t src[IEEE802154_LONG_ADDRESS_LEN], dst[IEEE802154_LONG_ADDRESS_LEN];
+            int src_len, dst_len;
 #if ENABLE_DEBUG
             char src_str[GNRC_NETIF_HDR_L2ADDR_PRINT_LEN];
 #endif
-            size_t mhr_len = ieee802154_get_frame_hdr_len(pkt->data);
+            size_t mhr_len = _parse_common(pkt->data, src, dst, &src_len);
 
-            if (mhr_len == 0) {
-                DEBUG("_recv_ieee802154: illegally formatted frame received\n");
+            if (mhr_len > 0) {
+                dst_len = src_len;
+            }
+            else {
+                le_uint16_t _pan_tmp;   /* TODO: hand-up PAN IDs to GNRC? */
+
+                mhr_len = ieee802154_get_frame_hdr_len(pkt->data);
+                if (mhr_len == 0) {
+                    DEBUG("_recv_ieee802154: illegally formatted frame received\n");
+                    gnrc_pktbuf_release(pkt);
+                    return NULL;
+                }
+                dst_len = ieee802154_get_dst(pkt->data, dst, &_pan_tmp);
+                src_len = ieee802154_get_src(pkt->data, src, &_pan_tmp);
+                if ((dst_len < 0) || (src_len < 0)) {
+                    DEBUG("_recv_ieee802154: unable to get addresses\n");
+                    gnrc_pktbuf_release(pkt);
+                    return NULL;
+                }
+            }
+            if (_sw_filter(gnrc_netdev2, pkt->data, src, src_len)) {
                 gnrc_pktbuf_release(pkt);
                 return NULL;
             }
@@ -106,7 +255,7 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
                 gnrc_pktbuf_release(pkt);
                 return NULL;
             }
-            netif_hdr = _make_netif_hdr(ieee802154_hdr->data);
+            netif_hdr = _make_netif_hdr(src, src_len, dst, dst_len);
             if (netif_hdr == NULL) {
                 DEBUG("_recv_ieee802154: no space left in packet buffer\n");
                 gnrc_pktbuf_release(pkt);
@@ -115,7 +264,7 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
             hdr = netif_hdr->data;
             hdr->lqi = rx_info.lqi;
             hdr->rssi = rx_info.rssi;
-            hdr->if_pid = thread_getpid();
+            hdr->if_pid = gnrc_netdev2->pid;
             pkt->type = state->proto;
 #if ENABLE_DEBUG
             DEBUG("_recv_ieee802154: received packet from %s of length %u\n",
@@ -138,6 +287,50 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
     return pkt;
 }
 
+#ifdef MODULE_NETDEV2_IEEE802154
+/* Copies the pre-built header for the destination address mode and patches in
+ * sequence number and destination. The header is rebuilt when the flags, PAN
+ * ID or source address of the device changed since. */
+static size_t _hdr_from_cache(gnrc_netdev2_t *gnrc_netdev2, uint8_t *mhr,
+                              const uint8_t *src, size_t src_len,
+                              const uint8_t *dst, size_t dst_len, uint8_t flags)
+{
+    static const uint8_t _no_addr[IEEE802154_LONG_ADDRESS_LEN];
+    netdev2_ieee802154_t *state = (netdev2_ieee802154_t *)gnrc_netdev2->dev;
+    gnrc_netdev2_ieee802154_mhr_t *tmpl;
+
+    tmpl = &gnrc_netdev2->mhr_cache[dst_len == IEEE802154_LONG_ADDRESS_LEN];
+    if ((tmpl->len == 0) || (tmpl->flags != state->flags) ||
+        (tmpl->pan != state->pan) || (memcmp(tmpl->src, src, src_len) != 0)) {
+        le_uint16_t dev_pan = byteorder_btols(byteorder_htons(state->pan));
+
+        /* a placeholder destination keeps the ACK request of broadcasts out
+         * of the template */
+        tmpl->len = ieee802154_set_frame_hdr(tmpl->mhr, src, src_len,
+                                             _no_addr, dst_len, dev_pan,
+                                             dev_pan, flags, 0);
+        memcpy(tmpl->src, src, src_len);
+        tmpl->flags = state->flags;
+        tmpl->pan = state->pan;
+        if (tmpl->len == 0) {
+            return 0;
+        }
+    }
+    memcpy(mhr, tmpl->mhr, tmpl->len);
+    mhr[2] = state->seq++;
+    /* destination address follows FCF, seq and PAN ID in little endian */
+    for (unsigned i = 0; i < dst_len; i++) {
+        mhr[5 + i] = dst[dst_len - 1 - i];
+    }
+    if ((dst_len == IEEE802154_SHORT_ADDRESS_LEN) &&
+        (memcmp(dst, ieee802154_addr_bcast, sizeof(ieee802154_addr_bcast)) == 0)) {
+        /* do not request ACKs for broadcast address */
+        mhr[0] &= ~IEEE802154_FCF_ACK_REQ;
+    }
+    return tmpl->len;
+}
+#endif
+
 static int _send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
 {
     netdev2_t *netdev = gnrc_netdev2->dev;
@@ -184,35 +377,47 @@ static int _send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
         src = state->short_addr;
     }
     /* fill MAC header, seq should be set by device */
-    if ((res = ieee802154_set_frame_hdr(mhr, src, src_len,
-                                        dst, dst_len, dev_pan,
-                                        dev_pan, flags, state->seq++)) == 0) {
+#ifdef MODULE_NETDEV2_IEEE802154
+    if ((netif_hdr->src_l2addr_len == 0) &&
+        ((dst_len == IEEE802154_SHORT_ADDRESS_LEN) ||
+         (dst_len == IEEE802154_LONG_ADDRESS_LEN))) {
+        res = _hdr_from_cache(gnrc_netdev2, mhr, src, src_len, dst, dst_len, flags);
+    }
+    else
+#endif
+    res = ieee802154_set_frame_hdr(mhr, src, src_len, dst, dst_len, dev_pan,
+                                   dev_pan, flags, state->seq++);
+    if (res == 0) {
         DEBUG("_send_ieee802154: Error preperaring frame\n");
         return -EINVAL;
     }
     /* prepare packet for sending */
-    vec_snip = gnrc_pktbuf_get_iovec(pkt, &n);
-    if (vec_snip != NULL) {
-        struct iovec *vector;
+    struct iovec stack_vec[GNRC_NETDEV2_IOVEC_NUMOF];
+    struct iovec *vector = stack_vec;
 
+    n = gnrc_pkt_fill_iovec(pkt, stack_vec, GNRC_NETDEV2_IOVEC_NUMOF);
+    if (n == 0) {
+        vec_snip = gnrc_pktbuf_get_iovec(pkt, &n);
+        if (vec_snip == NULL) {
+            gnrc_pktbuf_release(pkt);
+            return -ENOBUFS;
+        }
         pkt = vec_snip;     /* reassign for later release; vec_snip is prepended to pkt */
         vector = (struct iovec *)pkt->data;
-        vector[0].iov_base = mhr;
-        vector[0].iov_len = (size_t)res;
+    }
+    /* the netif header snip is replaced by the MAC header */
+    vector[0].iov_base = mhr;
+    vector[0].iov_len = (size_t)res;
 #ifdef MODULE_NETSTATS_L2
     if (netif_hdr->flags &
         (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
-            gnrc_netdev2->dev->stats.tx_mcast_count++;
-        }
-        else {
-            gnrc_netdev2->dev->stats.tx_unicast_count++;
-        }
-#endif
-        res = netdev->driver->send(netdev, vector, n);
+        gnrc_netdev2->dev->stats.tx_mcast_count++;
     }
     else {
-        return -ENOBUFS;
+        gnrc_netdev2->dev->stats.tx_unicast_count++;
     }
+#endif
+    res = netdev->driver->send(netdev, vector, n);
     /* release old data */
     gnrc_pktbuf_release(pkt);
     return res;
@@ -49,47 +49,21 @@
 
 #define _SLIP_DEV(arg)    ((gnrc_slip_dev_t *)arg)
 
-/* UART callbacks */
-static void _slip_rx_cb(void *arg, uint8_t data)
+/* UART callback, only queues the data for the thread */
+static void _slip_rx_cb(void *arg, const uint8_t *data, size_t len)
 {
-    if (data == (uint8_t)_SLIP_END) {
-        msg_t msg;
-
-        msg.type = _SLIP_MSG_TYPE;
-        msg.content.value = _SLIP_DEV(arg)->in_bytes;
+    gnrc_slip_dev_t *dev = _SLIP_DEV(arg);
 
-        msg_send_int(&msg, _SLIP_DEV(arg)->slip_pid);
-
-        _SLIP_DEV(arg)->in_bytes = 0;
+    if (tsrb_add(&dev->raw_buf, (const char *)data, len) != (int)len) {
+        DEBUG("slip: raw buffer full, dropping data\n");
     }
-    else if (_SLIP_DEV(arg)->in_esc) {
-        _SLIP_DEV(arg)->in_esc = 0;
-
-        switch (data) {
-            case ((uint8_t)_SLIP_END_ESC):
-                if (ringbuffer_add_one(&_SLIP_DEV(arg)->in_buf, _SLIP_END) < 0) {
-                    _SLIP_DEV(arg)->in_bytes++;
-                }
-
-                break;
-
-            case ((uint8_t)_SLIP_ESC_ESC):
-                if (ringbuffer_add_one(&_SLIP_DEV(arg)->in_buf, _SLIP_ESC) < 0) {
-                    _SLIP_DEV(arg)->in_bytes++;
-                }
-
-                break;
+    if ((memchr(data, _SLIP_END, len) != NULL) && !dev->rx_pending) {
+        msg_t msg;
 
-            default:
-                break;
-        }
-    }
-    else if (data == (uint8_t)_SLIP_ESC) {
-        _SLIP_DEV(arg)->in_esc = 1;
-    }
-    else {
-        if (ringbuffer_add_one(&_SLIP_DEV(arg)->in_buf, data) < 0) {
-            _SLIP_DEV(arg)->in_bytes++;
+        msg.type = _SLIP_MSG_TYPE;
+        dev->rx_pending = 1;
+        if (msg_send_int(&msg, dev->slip_pid) <= 0) {
+            dev->rx_pending = 0;
         }
     }
 }
@@ -139,6 +113,54 @@ static void _slip_receive(gnrc_slip_dev_t *dev, size_t bytes)
     }
 }
 
+/* Decode the received data in thread context. Runs of bytes needing no
+ * unescaping are copied into the RX buffer in one go. */
+static void _slip_decode(gnrc_slip_dev_t *dev)
+{
+    char chunk[32];
+    int n;
+
+    dev->rx_pending = 0;
+    while ((n = tsrb_get(&dev->raw_buf, chunk, sizeof(chunk))) > 0) {
+        int i = 0;
+
+        while (i < n) {
+            if (dev->in_esc) {
+                dev->in_esc = 0;
+                if ((chunk[i] == _SLIP_END_ESC) || (chunk[i] == _SLIP_ESC_ESC)) {
+                    char c = (chunk[i] == _SLIP_END_ESC) ? _SLIP_END : _SLIP_ESC;
+
+                    dev->in_bytes += ringbuffer_add(&dev->in_buf, &c, 1);
+                }
+                i++;
+            }
+            else if (chunk[i] == _SLIP_ESC) {
+                dev->in_esc = 1;
+                i++;
+            }
+            else if (chunk[i] == _SLIP_END) {
+                DEBUG("slip: incoming frame of size %" PRIu32 " from UART_%d in buffer\n",
+                      dev->in_bytes, dev->uart);
+                if (dev->in_bytes > 0) {
+                    _slip_receive(dev, (size_t)dev->in_bytes);
+                }
+                dev->in_bytes = 0;
+                i++;
+            }
+            else {
+                int run = i;
+
+                while ((run < n) && (chunk[run] != _SLIP_END) &&
+                       (chunk[run] != _SLIP_ESC)) {
+                    run++;
+                }
+                dev->in_bytes += ringbuffer_add(&dev->in_buf, &chunk[i], run - i);
+                i = run;
+            }
+        }
+    }
+}
+
 static inline void _slip_send_char(gnrc_slip_dev_t *dev, char c)
 {
     uart_write(dev->uart, (uint8_t *)&c, 1);
@@ -211,9 +233,7 @@ static void *_slip(void *args)
 
         switch (msg.type) {
             case _SLIP_MSG_TYPE:
-                DEBUG("slip: incoming message of size %" PRIu32 " from UART_%d in buffer\n",
-                      msg.content.value, dev->uart);
-                _slip_receive(dev, (size_t)msg.content.value);
+                _slip_decode(dev);
                 break;
 
             case GNRC_NETAPI_MSG_TYPE_SND:
@@ -251,15 +271,17 @@ kernel_pid_t gnrc_slip_init(gnrc_slip_dev_t *dev, uart_t uart, uint32_t baudrate
     dev->uart = uart;
     dev->in_bytes = 0;
     dev->in_esc = 0;
+    dev->rx_pending = 0;
     dev->slip_pid = KERNEL_PID_UNDEF;
 
     /* initialize buffers */
     ringbuffer_init(&dev->in_buf, dev->rx_mem, sizeof(dev->rx_mem));
+    tsrb_init(&dev->raw_buf, dev->raw_mem, sizeof(dev->raw_mem));
 
     /* initialize UART */
     DEBUG("slip: initialize UART_%d with baudrate %" PRIu32 "\n", uart,
           baudrate);
-    if (uart_init(uart, baudrate, _slip_rx_cb, dev) != UART_OK) {
+    if (uart_init_block(uart, baudrate, _slip_rx_cb, dev) != UART_OK) {
         DEBUG("slip: error initializing UART_%i with baudrate %" PRIu32 "\n",
               uart, baudrate);
         return -ENODEV;
@@ -23,6 +23,14 @@
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
+#ifdef MODULE_GNRC_NETAPI_PRIO
+#include <string.h>
+
+#include "net/gnrc/netif/hdr.h"
+#ifdef MODULE_GNRC_IPV6
+#include "net/ipv6/hdr.h"
+#endif
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -91,6 +99,32 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 }
 #endif
 
+/* returns 0 if the entry's target could not take the packet */
+static int _dispatch_entry(gnrc_netreg_entry_t *sendto, uint16_t cmd,
+                           gnrc_pktsnip_t *pkt)
+{
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+    switch (sendto->type) {
+        case GNRC_NETREG_TYPE_DEFAULT:
+            return (_snd_rcv(sendto->target.pid, cmd, pkt) > 0);
+#ifdef MODULE_GNRC_NETAPI_MBOX
+        case GNRC_NETREG_TYPE_MBOX:
+            return (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) > 0);
+#endif
+#ifdef MODULE_GNRC_NETAPI_CALLBACKS
+        case GNRC_NETREG_TYPE_CB:
+            sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
+            return 1;
+#endif
+        default:
+            /* unknown dispatch type */
+            return 0;
+    }
+#else
+    return (_snd_rcv(sendto->target.pid, cmd, pkt) > 0);
+#endif
+}
+
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                          uint16_t cmd, gnrc_pktsnip_t *pkt)
 {
@@ -98,48 +132,24 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
 
     if (numof != 0) {
         gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+        unsigned dropped = 0;
 
+        /* take the references for all subscribers at once */
         gnrc_pktbuf_hold(pkt, numof - 1);
 
         while (sendto) {
-#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
-            int release = 0;
-            switch (sendto->type) {
-                case GNRC_NETREG_TYPE_DEFAULT:
-                    if (_snd_rcv(sendto->target.pid, cmd, pkt) < 1) {
-                        /* unable to dispatch packet */
-                        release = 1;
-                    }
-                    break;
-#ifdef MODULE_GNRC_NETAPI_MBOX
-                case GNRC_NETREG_TYPE_MBOX:
-                    if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
-                        /* unable to dispatch packet */
-                        release = 1;
-                    }
-                    break;
-#endif
-#ifdef MODULE_GNRC_NETAPI_CALLBACKS
-                case GNRC_NETREG_TYPE_CB:
-                    sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
-                    break;
-#endif
-                default:
-                    /* unknown dispatch type */
-                    release = 1;
-                    break;
-            }
-            if (release) {
-                gnrc_pktbuf_release(pkt);
-            }
-#else
-            if (_snd_rcv(sendto->target.pid, cmd, pkt) < 1) {
-                /* unable to dispatch packet */
-                gnrc_pktbuf_release(pkt);
+            if (!_dispatch_entry(sendto, cmd, pkt)) {
+                /* don't retry, but keep track of the lost packet */
+                sendto->drops++;
+                dropped++;
             }
-#endif
             sendto = gnrc_netreg_getnext(sendto);
         }
+        /* give back the references no subscriber took. They were never
+         * handed out, so the packet is still valid until here */
+        while (dropped--) {
+            gnrc_pktbuf_release(pkt);
+        }
     }
 
     return numof;
@@ -168,3 +178,57 @@ int gnrc_netapi_set(kernel_pid_t pid, netopt_t opt, uint16_t context,
     return _get_set(pid, GNRC_NETAPI_MSG_TYPE_SET, opt, context,
                     data, data_len);
 }
+
+#ifdef MODULE_GNRC_NETAPI_PRIO
+static uint8_t _prio(const msg_t *msg)
+{
+    gnrc_pktsnip_t *snip;
+
+    if ((msg->type != GNRC_NETAPI_MSG_TYPE_SND) &&
+        (msg->type != GNRC_NETAPI_MSG_TYPE_RCV)) {
+        return GNRC_NETIF_HDR_PRIO_NORMAL;
+    }
+#ifdef MODULE_GNRC_IPV6
+    /* received packets are not parsed yet below the IPv6 layer, but the
+     * snip still starts with the header */
+    snip = gnrc_pktsnip_search_type(msg->content.ptr, GNRC_NETTYPE_IPV6);
+    if ((snip != NULL) && (snip->size >= sizeof(ipv6_hdr_t)) &&
+        ipv6_hdr_is(snip->data)) {
+        return gnrc_netif_hdr_prio_from_tc(ipv6_hdr_get_tc(snip->data));
+    }
+#endif
+    snip = gnrc_pktsnip_search_type(msg->content.ptr, GNRC_NETTYPE_NETIF);
+    if (snip != NULL) {
+        return ((gnrc_netif_hdr_t *)snip->data)->prio;
+    }
+    return GNRC_NETIF_HDR_PRIO_NORMAL;
+}
+
+void gnrc_netapi_receive_prio(gnrc_netapi_backlog_t *backlog, msg_t *msg)
+{
+    unsigned best = 0;
+    uint8_t best_prio;
+
+    if (backlog->len == 0) {
+        msg_receive(&backlog->msgs[backlog->len++]);
+    }
+    while ((backlog->len < GNRC_NETAPI_PRIO_BACKLOG_SIZE) &&
+           (msg_try_receive(&backlog->msgs[backlog->len]) == 1)) {
+        backlog->len++;
+    }
+    best_prio = _prio(&backlog->msgs[0]);
+    for (unsigned i = 1; (i < backlog->len) &&
+                         (best_prio != GNRC_NETIF_HDR_PRIO_HIGH); i++) {
+        uint8_t prio = _prio(&backlog->msgs[i]);
+
+        if (prio < best_prio) {
+            best = i;
+            best_prio = prio;
+        }
+    }
+    *msg = backlog->msgs[best];
+    backlog->len--;
+    memmove(&backlog->msgs[best], &backlog->msgs[best + 1],
+            (backlog->len - best) * sizeof(msg_t));
+}
+#endif
@@ -14,6 +14,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 #include "kernel_types.h"
 #include "net/gnrc/netif.h"
 
@@ -33,32 +34,52 @@ static gnrc_netif_handler_t if_handler[] = {
 };
 
 static kernel_pid_t ifs[GNRC_NETIF_NUMOF];
+/* index + 1 into ifs for every valid PID, 0 if the PID is no interface */
+static uint8_t ifs_idx[MAXTHREADS];
+
+static int _find(kernel_pid_t pid)
+{
+    if (pid_is_valid(pid)) {
+        return ifs_idx[pid - KERNEL_PID_FIRST] - 1;
+    }
+    for (int i = 0; i < GNRC_NETIF_NUMOF; i++) {
+        if (ifs[i] == pid) {
+            return i;
+        }
+    }
+    return -1;
+}
 
 void gnrc_netif_init(void)
 {
     for (int i = 0; i < GNRC_NETIF_NUMOF; i++) {
         ifs[i] = KERNEL_PID_UNDEF;
     }
+    memset(ifs_idx, 0, sizeof(ifs_idx));
 }
 
 int gnrc_netif_add(kernel_pid_t pid)
 {
-    kernel_pid_t *free_entry = NULL;
+    int free_entry = -1;
 
+    if (_find(pid) >= 0) {
+        return 0;
+    }
     for (int i = 0; i < GNRC_NETIF_NUMOF; i++) {
-        if (ifs[i] == pid) {
-            return 0;
-        }
-        else if (ifs[i] == KERNEL_PID_UNDEF && !free_entry) {
-            free_entry = &ifs[i];
+        if (ifs[i] == KERNEL_PID_UNDEF) {
+            free_entry = i;
+            break;
         }
     }
 
-    if (!free_entry) {
+    if (free_entry < 0) {
         return -ENOMEM;
     }
 
-    *free_entry = pid;
+    ifs[free_entry] = pid;
+    if (pid_is_valid(pid)) {
+        ifs_idx[pid - KERNEL_PID_FIRST] = free_entry + 1;
+    }
 
     for (int j = 0; if_handler[j].add != NULL; j++) {
         if_handler[j].add(pid);
@@ -69,18 +90,19 @@ int gnrc_netif_add(kernel_pid_t pid)
 
 void gnrc_netif_remove(kernel_pid_t pid)
 {
-    int i;
+    int i = _find(pid);
 
-    for (i = 0; i < GNRC_NETIF_NUMOF; i++) {
-        if (ifs[i] == pid) {
-            ifs[i] = KERNEL_PID_UNDEF;
+    if (i < 0) {
+        return;
+    }
 
-            for (int j = 0; if_handler[j].remove != NULL; j++) {
-                if_handler[j].remove(pid);
-            }
+    ifs[i] = KERNEL_PID_UNDEF;
+    if (pid_is_valid(pid)) {
+        ifs_idx[pid - KERNEL_PID_FIRST] = 0;
+    }
 
-            return;
-        }
+    for (int j = 0; if_handler[j].remove != NULL; j++) {
+        if_handler[j].remove(pid);
     }
 }
 
@@ -99,12 +121,7 @@ size_t gnrc_netif_get(kernel_pid_t *netifs)
 
 bool gnrc_netif_exist(kernel_pid_t pid)
 {
-    for (int i = 0; i < GNRC_NETIF_NUMOF; i++) {
-        if (ifs[i] == pid) {
-            return true;
-        }
-    }
-    return false;
+    return (_find(pid) >= 0);
 }
 
 /** @} */
@@ -22,17 +22,42 @@
 #include "net/gnrc/pkt.h"
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/tcp.h"
 #include "net/gnrc/udp.h"
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#ifdef MODULE_GNRC_NETREG_HASHED
+#if (GNRC_NETREG_BUCKET_NUMOF & (GNRC_NETREG_BUCKET_NUMOF - 1)) != 0
+#error "GNRC_NETREG_BUCKET_NUMOF must be a power of 2"
+#endif
+
+/* The registry as lookup table by gnrc_nettype_t and hashed demux context */
+static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF][GNRC_NETREG_BUCKET_NUMOF];
+
+static inline gnrc_netreg_entry_t **_list(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    /* fold all bytes into the lower ones, so both port numbers and
+     * GNRC_NETREG_DEMUX_CTX_ALL spread */
+    demux_ctx ^= demux_ctx >> 16;
+    demux_ctx ^= demux_ctx >> 8;
+    return &netreg[type][demux_ctx & (GNRC_NETREG_BUCKET_NUMOF - 1)];
+}
+#else
 /* The registry as lookup table by gnrc_nettype_t */
 static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
 
+static inline gnrc_netreg_entry_t **_list(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    (void)demux_ctx;
+    return &netreg[type];
+}
+#endif
+
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -52,7 +77,9 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    gnrc_netreg_entry_t **list = _list(type, entry->demux_ctx);
+
+    LL_PREPEND(*list, entry);
 
     return 0;
 }
@@ -63,7 +90,9 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    gnrc_netreg_entry_t **list = _list(type, entry->demux_ctx);
+
+    LL_DELETE(*list, entry);
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
@@ -74,7 +103,8 @@ gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
         return NULL;
     }
 
-    LL_SEARCH_SCALAR(netreg[type], res, demux_ctx, demux_ctx);
+    res = *_list(type, demux_ctx);
+    LL_SEARCH_SCALAR(res, res, demux_ctx, demux_ctx);
 
     return res;
 }
@@ -88,7 +118,7 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
         return 0;
     }
 
-    entry = netreg[type];
+    entry = *_list(type, demux_ctx);
 
     while (entry != NULL) {
         if (entry->demux_ctx == demux_ctx) {
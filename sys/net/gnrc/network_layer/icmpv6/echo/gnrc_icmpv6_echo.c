@@ -18,6 +18,8 @@
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/icmpv6/echo.h"
 #include "net/gnrc/ipv6/hdr.h"
+#include "net/inet_csum.h"
+#include "net/protnum.h"
 #include "utlist.h"
 
 #define ENABLE_DEBUG    (0)
@@ -66,6 +68,7 @@ void gnrc_icmpv6_echo_req_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6_hdr,
 {
     uint8_t *payload = ((uint8_t *)echo) + sizeof(icmpv6_echo_t);
     gnrc_pktsnip_t *hdr, *pkt;
+    bool csum_set = false;
 
     if ((echo == NULL) || (len < sizeof(icmpv6_echo_t))) {
         DEBUG("icmpv6_echo: echo was NULL or len (%" PRIu16
@@ -87,6 +90,19 @@ void gnrc_icmpv6_echo_req_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6_hdr,
     }
     else {
         hdr = gnrc_ipv6_hdr_build(pkt, &ipv6_hdr->dst, &ipv6_hdr->src);
+        if ((ipv6_hdr->nh == PROTNUM_ICMPV6) &&
+            (byteorder_ntohs(ipv6_hdr->len) == len)) {
+            /* the reply only swaps the addresses of the pseudo header and
+             * changes the type, so the checksum of the request can be
+             * updated instead of summing up the payload again */
+            icmpv6_echo_t *rep = pkt->data;
+
+            rep->csum = byteorder_htons(
+                inet_csum_update(byteorder_ntohs(echo->csum),
+                                 (echo->type << 8) | echo->code,
+                                 (rep->type << 8) | rep->code));
+            csum_set = true;
+        }
     }
 
     if (hdr == NULL) {
@@ -98,7 +114,16 @@ void gnrc_icmpv6_echo_req_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6_hdr,
     pkt = hdr;
     hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
 
+    if (hdr == NULL) {
+        DEBUG("icmpv6_echo: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
     ((gnrc_netif_hdr_t *)hdr->data)->if_pid = iface;
+    if (csum_set) {
+        ((gnrc_netif_hdr_t *)hdr->data)->flags |= GNRC_NETIF_HDR_FLAGS_CSUM;
+    }
 
     LL_PREPEND(pkt, hdr);
 
@@ -109,4 +134,99 @@ void gnrc_icmpv6_echo_req_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6_hdr,
     }
 }
 
+void gnrc_icmpv6_echo_req_reply(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *icmpv6, *ipv6, *netif;
+    ipv6_hdr_t *ipv6_hdr;
+    icmpv6_echo_t *echo;
+    bool csum_set = false;
+
+    assert((pkt != NULL) && (pkt->type == GNRC_NETTYPE_ICMPV6) &&
+           (pkt->next != NULL) && (pkt->next->type == GNRC_NETTYPE_IPV6));
+
+    if (pkt->size < sizeof(icmpv6_echo_t)) {
+        DEBUG("icmpv6_echo: len (%u) was < sizeof(icmpv6_echo_t)\n",
+              (unsigned)pkt->size);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
+    /* only snips other threads still hold are duplicated here */
+    if ((icmpv6 = gnrc_pktbuf_start_write(pkt)) == NULL) {
+        DEBUG("icmpv6_echo: unable to get write access to echo request\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    pkt = icmpv6;
+    if ((ipv6 = gnrc_pktbuf_start_write(icmpv6->next)) == NULL) {
+        DEBUG("icmpv6_echo: unable to get write access to IPv6 header\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    icmpv6->next = ipv6;
+
+    /* drop the received link-layer header and reverse the remaining snips */
+    if ((netif = gnrc_pktsnip_search_type(ipv6, GNRC_NETTYPE_NETIF)) != NULL) {
+        gnrc_pktbuf_remove_snip(ipv6, netif);
+    }
+    icmpv6->next = NULL;
+    ipv6->next = icmpv6;
+    pkt = ipv6;
+
+    ipv6_hdr = ipv6->data;
+    echo = icmpv6->data;
+    if (ipv6_addr_is_multicast(&ipv6_hdr->dst)) {
+        /* source is selected when sending, so the checksum is summed up
+         * again */
+        ipv6_hdr->dst = ipv6_hdr->src;
+        ipv6_addr_set_unspecified(&ipv6_hdr->src);
+        echo->type = ICMPV6_ECHO_REP;
+        echo->csum.u16 = 0;
+    }
+    else {
+        ipv6_addr_t tmp = ipv6_hdr->src;
+
+        ipv6_hdr->src = ipv6_hdr->dst;
+        ipv6_hdr->dst = tmp;
+        if ((ipv6_hdr->nh == PROTNUM_ICMPV6) &&
+            (byteorder_ntohs(ipv6_hdr->len) == icmpv6->size)) {
+            /* swapping the addresses leaves the sum of the pseudo header as
+             * is, so only the type needs to be accounted for */
+            echo->csum = byteorder_htons(
+                inet_csum_update(byteorder_ntohs(echo->csum),
+                                 (echo->type << 8) | echo->code,
+                                 (ICMPV6_ECHO_REP << 8) | echo->code));
+            csum_set = true;
+        }
+        else {
+            echo->csum.u16 = 0;
+        }
+        echo->type = ICMPV6_ECHO_REP;
+    }
+    /* reset traffic class, flow label and hop limit like a fresh header */
+    ipv6_hdr->v_tc_fl.u32 = 0;
+    ipv6_hdr_set_version(ipv6_hdr);
+    ipv6_hdr->nh = PROTNUM_ICMPV6;
+    ipv6_hdr->hl = 0;
+
+    if ((netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0)) == NULL) {
+        DEBUG("icmpv6_echo: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = iface;
+    if (csum_set) {
+        ((gnrc_netif_hdr_t *)netif->data)->flags |= GNRC_NETIF_HDR_FLAGS_CSUM;
+    }
+
+    LL_PREPEND(pkt, netif);
+
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL,
+                                   pkt)) {
+        DEBUG("icmpv6_echo: no receivers for IPv6 packets\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
 /** @} */
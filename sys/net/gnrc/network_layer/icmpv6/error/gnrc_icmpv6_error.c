@@ -18,6 +18,11 @@
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/icmpv6/error.h"
 #include "net/gnrc/icmpv6.h"
+#ifdef MODULE_GNRC_IPV6_PMTU
+#include "net/gnrc/ipv6/pmtu.h"
+#endif
+#include "mutex.h"
+#include "xtimer.h"
 
 /* all error messages are basically the same size and format */
 #define ICMPV6_ERROR_SZ (sizeof(icmpv6_error_dst_unr_t))
@@ -27,6 +32,40 @@
 /* TODO: generalize and centralize (see https://github.com/RIOT-OS/RIOT/pull/3184) */
 #define MIN(a, b)   ((a) < (b)) ? (a) : (b)
 
+static mutex_t _mutex = MUTEX_INIT;
+static uint32_t _last;      /* time the bucket last gained a token */
+static unsigned _tokens = GNRC_ICMPV6_ERROR_BURST;
+static gnrc_icmpv6_error_stats_t _stats;
+
+/* token bucket of RFC 4443, section 2.4 (f) */
+static bool _rate_limited(void)
+{
+    uint32_t now, gained;
+    bool res = false;
+
+    mutex_lock(&_mutex);
+    now = xtimer_now_usec();
+    gained = (now - _last) / GNRC_ICMPV6_ERROR_INTERVAL;
+    if (gained >= (GNRC_ICMPV6_ERROR_BURST - _tokens)) {
+        _tokens = GNRC_ICMPV6_ERROR_BURST;
+        _last = now;
+    }
+    else if (gained > 0) {
+        _tokens += gained;
+        _last += gained * GNRC_ICMPV6_ERROR_INTERVAL;
+    }
+    if (_tokens > 0) {
+        _tokens--;
+        _stats.sent++;
+    }
+    else {
+        _stats.limited++;
+        res = true;
+    }
+    mutex_unlock(&_mutex);
+    return res;
+}
+
 static inline size_t _fit(gnrc_pktsnip_t *pkt)
 {
     /* TODO: replace IPV6_MIN_MTU with known path MTU? */
@@ -37,7 +76,12 @@ static inline size_t _fit(gnrc_pktsnip_t *pkt)
 static gnrc_pktsnip_t *_icmpv6_error_build(uint8_t type, uint8_t code,
                                            gnrc_pktsnip_t *orig_pkt, uint32_t value)
 {
-    gnrc_pktsnip_t *pkt = gnrc_icmpv6_build(NULL, type, code, _fit(orig_pkt));
+    gnrc_pktsnip_t *pkt;
+
+    if (_rate_limited()) {
+        return NULL;
+    }
+    pkt = gnrc_icmpv6_build(NULL, type, code, _fit(orig_pkt));
 
     /* copy as much of the originating packet into error message as fits the message's size */
     if (pkt != NULL) {
@@ -78,8 +122,12 @@ static inline bool _in_range(uint8_t *ptr, uint8_t *start, size_t sz)
 gnrc_pktsnip_t *gnrc_icmpv6_error_param_prob_build(uint8_t code, void *ptr,
                                                    gnrc_pktsnip_t *orig_pkt)
 {
-    gnrc_pktsnip_t *pkt = gnrc_icmpv6_build(NULL, ICMPV6_PARAM_PROB, code,
-                                            _fit(orig_pkt));
+    gnrc_pktsnip_t *pkt;
+
+    if (_rate_limited()) {
+        return NULL;
+    }
+    pkt = gnrc_icmpv6_build(NULL, ICMPV6_PARAM_PROB, code, _fit(orig_pkt));
 
     /* copy as much of the originating packet into error message and
      * determine relative *ptr* offset */
@@ -119,4 +167,29 @@ gnrc_pktsnip_t *gnrc_icmpv6_error_param_prob_build(uint8_t code, void *ptr,
     return pkt;
 }
 
+#ifdef MODULE_GNRC_IPV6_PMTU
+void gnrc_icmpv6_error_pkt_too_big_handle(const icmpv6_error_pkt_too_big_t *ptb,
+                                          size_t size)
+{
+    const ipv6_hdr_t *orig;
+
+    if ((size < (sizeof(icmpv6_error_pkt_too_big_t) + sizeof(ipv6_hdr_t))) ||
+        (ptb->code != 0)) {
+        return;
+    }
+    orig = (const ipv6_hdr_t *)(ptb + 1);
+    /* only trust reports about packets we sent */
+    if (!ipv6_hdr_is(orig) ||
+        (gnrc_ipv6_netif_find_by_addr(NULL, &orig->src) == KERNEL_PID_UNDEF)) {
+        return;
+    }
+    gnrc_ipv6_pmtu_update(&orig->dst, byteorder_ntohl(ptb->mtu));
+}
+#endif
+
+const gnrc_icmpv6_error_stats_t *gnrc_icmpv6_error_stats(void)
+{
+    return &_stats;
+}
+
 /** @} */
@@ -30,10 +30,18 @@
 
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/icmpv6/echo.h"
+#include "net/gnrc/icmpv6/error.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_NETSTATS_ICMPV6
+static netstats_icmpv6_t _stats;
+#define _STATS_INC(field)   (_stats.field++)
+#else
+#define _STATS_INC(field)
+#endif
+
 static inline uint16_t _calc_csum(gnrc_pktsnip_t *hdr,
                                   gnrc_pktsnip_t *pseudo_hdr,
                                   gnrc_pktsnip_t *payload)
@@ -68,8 +76,10 @@ void gnrc_icmpv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 
     assert(ipv6 != NULL);
 
+    _STATS_INC(rx_count);
     if (icmpv6->size < sizeof(icmpv6_hdr_t)) {
         DEBUG("icmpv6: packet too short.\n");
+        _STATS_INC(rx_invalid);
         return;
     }
 
@@ -78,17 +88,35 @@ void gnrc_icmpv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 
     hdr = (icmpv6_hdr_t *)icmpv6->data;
 
-    if (_calc_csum(icmpv6, ipv6, pkt)) {
+    if (!(gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM) &&
+        /* device did not verify the checksum already */
+        _calc_csum(icmpv6, ipv6, pkt)) {
         DEBUG("icmpv6: wrong checksum.\n");
+        _STATS_INC(rx_invalid);
         /* don't release: IPv6 does this */
         return;
     }
 
     switch (hdr->type) {
-        /* TODO: handle ICMPv6 errors */
+        /* TODO: handle other ICMPv6 errors */
+#ifdef MODULE_GNRC_IPV6_PMTU
+        case ICMPV6_PKT_TOO_BIG:
+            DEBUG("icmpv6: packet too big received\n");
+            gnrc_icmpv6_error_pkt_too_big_handle((icmpv6_error_pkt_too_big_t *)hdr,
+                                                 icmpv6->size);
+            break;
+#endif
+
 #ifdef MODULE_GNRC_ICMPV6_ECHO
         case ICMPV6_ECHO_REQ:
             DEBUG("icmpv6: handle echo request.\n");
+            _STATS_INC(rx_echo_req);
+            if ((icmpv6 == pkt) && (icmpv6->next == ipv6) &&
+                (gnrc_netreg_num(GNRC_NETTYPE_ICMPV6, hdr->type) == 0)) {
+                /* nobody else gets the request, so it becomes the reply */
+                gnrc_icmpv6_echo_req_reply(iface, pkt);
+                return;
+            }
             gnrc_icmpv6_echo_req_handle(iface, (ipv6_hdr_t *)ipv6->data,
                                         (icmpv6_echo_t *)hdr, icmpv6->size);
             break;
@@ -97,6 +125,7 @@ void gnrc_icmpv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 #if (defined(MODULE_GNRC_NDP_ROUTER) || defined(MODULE_GNRC_SIXLOWPAN_ND_ROUTER))
         case ICMPV6_RTR_SOL:
             DEBUG("icmpv6: router solicitation received\n");
+            _STATS_INC(rx_nd);
             gnrc_ndp_rtr_sol_handle(iface, pkt, ipv6->data, (ndp_rtr_sol_t *)hdr,
                                     icmpv6->size);
             break;
@@ -105,18 +134,21 @@ void gnrc_icmpv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 #ifdef MODULE_GNRC_NDP
         case ICMPV6_RTR_ADV:
             DEBUG("icmpv6: router advertisement received\n");
+            _STATS_INC(rx_nd);
             gnrc_ndp_rtr_adv_handle(iface, pkt, ipv6->data, (ndp_rtr_adv_t *)hdr,
                                     icmpv6->size);
             break;
 
         case ICMPV6_NBR_SOL:
             DEBUG("icmpv6: neighbor solicitation received\n");
+            _STATS_INC(rx_nd);
             gnrc_ndp_nbr_sol_handle(iface, pkt, ipv6->data, (ndp_nbr_sol_t *)hdr,
                                     icmpv6->size);
             break;
 
         case ICMPV6_NBR_ADV:
             DEBUG("icmpv6: neighbor advertisement received\n");
+            _STATS_INC(rx_nd);
             gnrc_ndp_nbr_adv_handle(iface, pkt, ipv6->data, (ndp_nbr_adv_t *)hdr,
                                     icmpv6->size);
             break;
@@ -124,11 +156,13 @@ void gnrc_icmpv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 
         case ICMPV6_REDIRECT:
             DEBUG("icmpv6: redirect message received\n");
+            _STATS_INC(rx_unhandled);
             /* TODO */
             break;
 
         default:
             DEBUG("icmpv6: unknown type field %u\n", hdr->type);
+            _STATS_INC(rx_unhandled);
             break;
     }
 
@@ -185,6 +219,13 @@ int gnrc_icmpv6_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
     return 0;
 }
 
+#ifdef MODULE_NETSTATS_ICMPV6
+netstats_icmpv6_t *gnrc_icmpv6_get_stats(void)
+{
+    return &_stats;
+}
+#endif
+
 /**
  * @}
  */
@@ -31,10 +31,12 @@ enum gnrc_ipv6_ext_demux_status {
     GNRC_IPV6_EXT_ERROR,
 };
 
-static enum gnrc_ipv6_ext_demux_status _handle_rh(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt)
+/* the routing header is at offset in current */
+static enum gnrc_ipv6_ext_demux_status _handle_rh(gnrc_pktsnip_t *current, size_t offset,
+                                                  gnrc_pktsnip_t *pkt)
 {
     gnrc_pktsnip_t *ipv6;
-    ipv6_ext_t *ext = (ipv6_ext_t *) current->data;
+    ipv6_ext_t *ext = (ipv6_ext_t *)(((uint8_t *)current->data) + offset);
     size_t current_offset;
     ipv6_hdr_t *hdr;
 
@@ -47,7 +49,7 @@ static enum gnrc_ipv6_ext_demux_status _handle_rh(gnrc_pktsnip_t *current, gnrc_
        the head. `ipv6_ext_rh_process` modifies the IPv6 header as well as
        the extension header */
 
-    current_offset = gnrc_pkt_len_upto(current->next, GNRC_NETTYPE_IPV6);
+    current_offset = gnrc_pkt_len_upto(current->next, GNRC_NETTYPE_IPV6) + offset;
 
     if (pkt->users != 1) {
         if ((ipv6 = gnrc_pktbuf_duplicate_upto(pkt, GNRC_NETTYPE_IPV6)) == NULL) {
@@ -90,65 +92,33 @@ static enum gnrc_ipv6_ext_demux_status _handle_rh(gnrc_pktsnip_t *current, gnrc_
 #endif
 
 /**
- * @brief marks IPv6 extension header if needed.
- *   updates pkt and returns next header.
- * @param[in] current  The current header
- * @param[in,out] pkt  The whole packet
- * @return The next header
- * @return NULL on error
+ * @brief   Marks the first @p size bytes of @p pkt as extension headers
+ *
+ * @param[in,out] pkt   The whole packet
+ * @param[in] size      Length of the extension headers
+ *
+ * @return  true on success
+ * @return  false on error, @p pkt is released then
  */
-static gnrc_pktsnip_t *_mark_extension_header(gnrc_pktsnip_t *current,
-                                              gnrc_pktsnip_t **pkt)
+static bool _mark_extension_headers(gnrc_pktsnip_t **pkt, size_t size)
 {
-    gnrc_pktsnip_t *tmp, *next;
-    ipv6_ext_t *ext = (ipv6_ext_t *) current->data;
-    size_t offset = ((ext->len * IPV6_EXT_LEN_UNIT) + IPV6_EXT_LEN_UNIT);
-
-    if (current == *pkt) {
-        gnrc_pktsnip_t *ext_snip;
-        if ((tmp = gnrc_pktbuf_start_write(*pkt)) == NULL) {
-            DEBUG("ipv6: could not get a copy of pkt\n");
-            gnrc_pktbuf_release(*pkt);
-            return NULL;
-        }
-        *pkt = tmp;
+    gnrc_pktsnip_t *tmp;
 
-        ext_snip = gnrc_pktbuf_mark(*pkt, offset, GNRC_NETTYPE_IPV6_EXT);
-        next = *pkt;
-
-        if (ext_snip == NULL) {
-            gnrc_pktbuf_release(*pkt);
-            return NULL;
-        }
+    if ((tmp = gnrc_pktbuf_start_write(*pkt)) == NULL) {
+        DEBUG("ipv6: could not get a copy of pkt\n");
+        gnrc_pktbuf_release(*pkt);
+        return false;
     }
-    else {
-        /* the header is already marked */
-
-        next = NULL;
-
-        for (tmp = *pkt; tmp != NULL; tmp = tmp->next) {
-            if (tmp->next == current) {
-                next = tmp;
-                break;
-            }
-        }
-
-        assert(next != NULL);
+    *pkt = tmp;
+    if (gnrc_pktbuf_mark(*pkt, size, GNRC_NETTYPE_IPV6_EXT) == NULL) {
+        gnrc_pktbuf_release(*pkt);
+        return false;
     }
-
-    return next;
+    return true;
 }
 
-static inline bool _has_valid_size(gnrc_pktsnip_t *pkt, uint8_t nh)
+static inline bool _is_ext(uint8_t nh)
 {
-    ipv6_ext_t *ext;
-
-    if (pkt->size < sizeof(ipv6_ext_t)) {
-        return false;
-    }
-
-    ext = pkt->data;
-
     switch (nh) {
         case PROTNUM_IPV6_EXT_RH:
         case PROTNUM_IPV6_EXT_HOPOPT:
@@ -157,10 +127,10 @@ static inline bool _has_valid_size(gnrc_pktsnip_t *pkt, uint8_t nh)
         case PROTNUM_IPV6_EXT_AH:
         case PROTNUM_IPV6_EXT_ESP:
         case PROTNUM_IPV6_EXT_MOB:
-            return ((ext->len * IPV6_EXT_LEN_UNIT) + IPV6_EXT_LEN_UNIT) <= pkt->size;
+            return true;
 
         default:
-            return true;
+            return false;
     }
 }
 
@@ -169,89 +139,80 @@ static inline bool _has_valid_size(gnrc_pktsnip_t *pkt, uint8_t nh)
  *         |                       |
  *         v                       v
  * IPv6 <- IPv6_EXT <- IPv6_EXT <- UNDEF
+ *
+ * Headers already marked are walked snip by snip. The headers in pkt are
+ * walked in place and only marked, all at once, when the next header is
+ * handed to another thread or the upper layer.
  */
 void gnrc_ipv6_ext_demux(kernel_pid_t iface,
                          gnrc_pktsnip_t *current,
                          gnrc_pktsnip_t *pkt,
                          uint8_t nh)
 {
-    ipv6_ext_t *ext;
-
-    while (true) {
-        ext = (ipv6_ext_t *) current->data;
-
-        switch (nh) {
-            case PROTNUM_IPV6_EXT_RH:
-#ifdef MODULE_GNRC_RPL_SRH
-                /* if current != pkt, size is already checked */
-                if (current == pkt && !_has_valid_size(pkt, nh)) {
-                    DEBUG("ipv6_ext: invalid size\n");
-                    gnrc_pktbuf_release(pkt);
-                    return;
-                }
-
-                switch (_handle_rh(current, pkt)) {
-                    case GNRC_IPV6_EXT_OK:
-                        /* We are the final destination. So proceeds like normal packet. */
-                        nh = ext->nh;
-                        DEBUG("ipv6_ext: next header = %" PRIu8 "\n", nh);
+    /* offset of the current header in pkt */
+    size_t offset = 0;
 
-                        if ((current = _mark_extension_header(current, &pkt)) == NULL) {
-                            return;
-                        }
+    while (_is_ext(nh)) {
+        ipv6_ext_t *ext = (ipv6_ext_t *)(((uint8_t *)current->data) + offset);
+        size_t avail = current->size - offset;
+        size_t len;
 
-                        gnrc_ipv6_demux(iface, current, pkt, nh); /* demultiplex next header */
+        if ((avail < sizeof(ipv6_ext_t)) ||
+            ((len = (ext->len * IPV6_EXT_LEN_UNIT) + IPV6_EXT_LEN_UNIT) > avail)) {
+            DEBUG("ipv6_ext: invalid size\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
 
-                        return;
+#ifdef MODULE_GNRC_RPL_SRH
+        if (nh == PROTNUM_IPV6_EXT_RH) {
+            /* returns OK if we are the final destination, so proceed like
+             * with any other header */
+            if (_handle_rh(current, offset, pkt) != GNRC_IPV6_EXT_OK) {
+                /* forwarded or released on error */
+                return;
+            }
+        }
+#endif
+        /* TODO: add handling of other types */
 
-                    case GNRC_IPV6_EXT_ERROR:
-                        /* already released by _handle_rh, so no release here */
-                        return;
+        nh = ext->nh;
+        DEBUG("ipv6_ext: next header = %" PRIu8 "\n", nh);
 
-                    case GNRC_IPV6_EXT_FORWARDED:
-                        /* the packet is forwarded and released. finish processing */
-                        return;
-                }
+        if (current == pkt) {
+            offset += len;
+        }
+        else {
+            /* the header is already marked */
+            gnrc_pktsnip_t *tmp;
 
-                break;
-#endif
+            for (tmp = pkt; tmp->next != current; tmp = tmp->next) {
+                assert(tmp->next != NULL);
+            }
+            current = tmp;
+        }
 
-            case PROTNUM_IPV6_EXT_HOPOPT:
-            case PROTNUM_IPV6_EXT_DST:
-            case PROTNUM_IPV6_EXT_FRAG:
-            case PROTNUM_IPV6_EXT_AH:
-            case PROTNUM_IPV6_EXT_ESP:
-            case PROTNUM_IPV6_EXT_MOB:
-                /* TODO: add handling of types */
-
-                /* if current != pkt, size is already checked */
-                if (current == pkt && !_has_valid_size(pkt, nh)) {
-                    DEBUG("ipv6_ext: invalid size\n");
-                    gnrc_pktbuf_release(pkt);
-                    return;
-                }
-
-                nh = ext->nh;
-                DEBUG("ipv6_ext: next header = %" PRIu8 "\n", nh);
-
-                if ((current = _mark_extension_header(current, &pkt)) == NULL) {
-                    return;
-                }
-
-                gnrc_pktbuf_hold(pkt, 1);   /* don't release on next dispatch */
-                if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6, nh, pkt) == 0) {
-                    gnrc_pktbuf_release(pkt);
-                }
-
-                break;
-
-            default:
-                gnrc_ipv6_demux(iface, current, pkt, nh); /* demultiplex next header */
+        if (_is_ext(nh) && (gnrc_netreg_num(GNRC_NETTYPE_IPV6, nh) > 0)) {
+            /* someone is interested in the next header */
+            if ((offset > 0) && !_mark_extension_headers(&pkt, offset)) {
                 return;
+            }
+            current = pkt;
+            offset = 0;
+            gnrc_pktbuf_hold(pkt, 1);   /* don't release on next dispatch */
+            if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6, nh, pkt) == 0) {
+                gnrc_pktbuf_release(pkt);
+            }
         }
     }
 
-    assert(false); /* never reaches here */
+    if (offset > 0) {
+        if (!_mark_extension_headers(&pkt, offset)) {
+            return;
+        }
+        current = pkt;
+    }
+    gnrc_ipv6_demux(iface, current, pkt, nh); /* demultiplex next header */
 }
 
 gnrc_pktsnip_t *gnrc_ipv6_ext_build(gnrc_pktsnip_t *ipv6, gnrc_pktsnip_t *next,
@@ -36,11 +36,31 @@
 
 #include "net/gnrc/ipv6.h"
 
+#ifdef MODULE_GNRC_IPV6_ROUTE_CACHE
+#include "net/gnrc/ipv6/route_cache.h"
+#endif
+#ifdef MODULE_GNRC_IPV6_SRC_CACHE
+#include "net/gnrc/ipv6/src_cache.h"
+#endif
+#ifdef MODULE_GNRC_MPL
+#include "net/gnrc/mpl.h"
+#endif
+#ifdef MODULE_GNRC_PKTTRACE
+#include "net/gnrc/pkttrace.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
 #define _MAX_L2_ADDR_LEN    (8U)
 
+#ifdef MODULE_NETSTATS_IPV6
+static netstats_ipv6_t _stats;
+#define _STATS_INC(field)   (_stats.field++)
+#else
+#define _STATS_INC(field)
+#endif
+
 #if ENABLE_DEBUG
 static char _stack[GNRC_IPV6_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
@@ -55,6 +75,13 @@ static char _stack[GNRC_IPV6_STACK_SIZE];
  */
 static fib_entry_t _fib_entries[GNRC_IPV6_FIB_TABLE_SIZE];
 
+#ifdef MODULE_FIB_TRIE
+/**
+ * @brief lookup trie nodes for the IPv6 forwarding table
+ */
+static fib_trie_node_t _fib_trie_nodes[FIB_TRIE_NODES_NUMOF(GNRC_IPV6_FIB_TABLE_SIZE)];
+#endif
+
 /**
  * @brief the IPv6 forwarding table
  */
@@ -91,6 +118,9 @@ kernel_pid_t gnrc_ipv6_init(void)
     gnrc_ipv6_fib_table.data.entries = _fib_entries;
     gnrc_ipv6_fib_table.table_type = FIB_TABLE_TYPE_SH;
     gnrc_ipv6_fib_table.size = GNRC_IPV6_FIB_TABLE_SIZE;
+#ifdef MODULE_FIB_TRIE
+    gnrc_ipv6_fib_table.trie_nodes = _fib_trie_nodes;
+#endif
     fib_init(&gnrc_ipv6_fib_table);
 #endif
 
@@ -100,6 +130,29 @@ kernel_pid_t gnrc_ipv6_init(void)
 static void _dispatch_next_header(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt,
                                   uint8_t nh, bool interested);
 
+#ifdef MODULE_GNRC_MPL
+/* MPL data messages are decapsulated by the MPL thread, which delivers each
+ * message only once */
+static bool _mpl_receive(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *outer = pkt->next;
+
+    while ((outer != NULL) && (outer->type != GNRC_NETTYPE_IPV6)) {
+        outer = outer->next;
+    }
+    if ((outer == NULL) ||
+        !gnrc_mpl_is_domain(&((ipv6_hdr_t *)outer->data)->dst)) {
+        return false;
+    }
+    DEBUG("ipv6: hand MPL data message to MPL\n");
+    if (gnrc_netapi_receive(gnrc_mpl_pid, pkt) < 1) {
+        DEBUG("ipv6: unable to hand message to MPL\n");
+        gnrc_pktbuf_release(pkt);
+    }
+    return true;
+}
+#endif
+
 /*
  *         current                 pkt
  *         |                       |
@@ -110,6 +163,12 @@ void gnrc_ipv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *current, gnrc_pktsnip_t
 {
     bool interested = false;
 
+#ifdef MODULE_GNRC_MPL
+    if ((nh == PROTNUM_IPV6) && _mpl_receive(pkt)) {
+        return;
+    }
+#endif
+
     current->type = gnrc_nettype_from_protnum(nh);
 
     switch (nh) {
@@ -244,13 +303,50 @@ static void _dispatch_next_header(gnrc_pktsnip_t *current, gnrc_pktsnip_t *pkt,
                                      * next dispatch */
     }
     if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6, nh, pkt) == 0) {
+        if (!interested) {
+            _STATS_INC(rx_no_receiver);
+        }
         gnrc_pktbuf_release(pkt);
     }
 }
 
+#if defined(MODULE_NETSTATS_IPV6) || defined(MODULE_NETSTATS_ICMPV6) || \
+    defined(MODULE_NETSTATS_NDP)
+static int _get_stats(gnrc_netapi_opt_t *opt)
+{
+    void *stats = NULL;
+
+    switch (opt->context) {
+#ifdef MODULE_NETSTATS_IPV6
+        case NETSTATS_IPV6:
+            stats = &_stats;
+            break;
+#endif
+#ifdef MODULE_NETSTATS_ICMPV6
+        case NETSTATS_ICMPV6:
+            stats = gnrc_icmpv6_get_stats();
+            break;
+#endif
+#ifdef MODULE_NETSTATS_NDP
+        case NETSTATS_NDP:
+            stats = gnrc_ndp_get_stats();
+            break;
+#endif
+        default:
+            break;
+    }
+    if ((stats == NULL) || (opt->data_len != sizeof(uintptr_t))) {
+        return -ENOTSUP;
+    }
+    *((void **)opt->data) = stats;
+    return sizeof(uintptr_t);
+}
+#endif
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_IPV6_MSG_QUEUE_SIZE];
+    gnrc_netapi_backlog_t backlog = { 0 };
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
 
@@ -266,20 +362,36 @@ static void *_event_loop(void *args)
     /* start event loop */
     while (1) {
         DEBUG("ipv6: waiting for incoming message.\n");
-        msg_receive(&msg);
+        gnrc_netapi_receive_prio(&backlog, &msg);
 
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV received\n");
+#ifdef MODULE_GNRC_PKTTRACE
+                gnrc_pkttrace_hop(msg.content.ptr, GNRC_PKTTRACE_RX_IPV6);
+#endif
                 _receive(msg.content.ptr);
                 break;
 
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
+                _STATS_INC(tx_count);
+#ifdef MODULE_GNRC_PKTTRACE
+                gnrc_pkttrace_hop(msg.content.ptr, GNRC_PKTTRACE_TX_IPV6);
+#endif
                 _send(msg.content.ptr, true);
                 break;
 
             case GNRC_NETAPI_MSG_TYPE_GET:
+#if defined(MODULE_NETSTATS_IPV6) || defined(MODULE_NETSTATS_ICMPV6) || \
+    defined(MODULE_NETSTATS_NDP)
+                if (((gnrc_netapi_opt_t *)msg.content.ptr)->opt == NETOPT_STATS) {
+                    reply.content.value = _get_stats(msg.content.ptr);
+                    msg_reply(&msg, &reply);
+                    break;
+                }
+#endif
+                /* falls through */
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("ipv6: reply to unsupported get/set\n");
                 reply.content.value = -ENOTSUP;
@@ -348,6 +460,10 @@ static void *_event_loop(void *args)
                 DEBUG("ipv6: border router timeout event received\n");
                 gnrc_sixlowpan_nd_router_abr_remove(msg.content.ptr);
                 break;
+            case GNRC_SIXLOWPAN_ND_MSG_REG_TICK:
+                DEBUG("ipv6: address registration lifetime tick received\n");
+                gnrc_sixlowpan_nd_router_reg_tick();
+                break;
             /* XXX reactivate when https://github.com/RIOT-OS/RIOT/issues/5122 is
              * solved properly */
             /* case GNRC_SIXLOWPAN_ND_MSG_AR_TIMEOUT: */
@@ -371,12 +487,21 @@ static void *_event_loop(void *args)
 
 static void _send_to_iface(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 {
-    ((gnrc_netif_hdr_t *)pkt->data)->if_pid = iface;
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
     gnrc_ipv6_netif_t *if_entry = gnrc_ipv6_netif_get(iface);
+    uint8_t prio = gnrc_netif_hdr_prio_from_tc(ipv6_hdr_get_tc(pkt->next->data));
+
+    netif_hdr->if_pid = iface;
+    /* a traffic class other than the default overrides the priority an upper
+     * layer may have set */
+    if (prio != GNRC_NETIF_HDR_PRIO_NORMAL) {
+        netif_hdr->prio = prio;
+    }
 
     assert(if_entry != NULL);
     if (gnrc_pkt_len(pkt->next) > if_entry->mtu) {
         DEBUG("ipv6: packet too big\n");
+        _STATS_INC(tx_dropped);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -409,6 +534,7 @@ static gnrc_pktsnip_t *_create_netif_hdr(uint8_t *dst_l2addr,
 
     if (netif == NULL) {
         DEBUG("ipv6: error on interface header allocation, dropping packet\n");
+        _STATS_INC(nobuf);
         gnrc_pktbuf_release(pkt);
         return NULL;
     }
@@ -424,6 +550,7 @@ static gnrc_pktsnip_t *_create_netif_hdr(uint8_t *dst_l2addr,
         gnrc_netif_hdr_t *netif_new = netif->data, *netif_old = pkt->data;
         netif_new->flags = netif_old->flags & \
                            ~(GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST);
+        netif_new->prio = netif_old->prio;
         DEBUG("ipv6: removed old interface header\n");
         pkt = gnrc_pktbuf_remove_snip(pkt, pkt);
     }
@@ -450,8 +577,16 @@ static void _send_unicast(kernel_pid_t iface, uint8_t *dst_l2addr,
     _send_to_iface(iface, pkt);
 }
 
+/* the device of iface fills in the upper layer checksum */
+static inline bool _csum_offloaded(kernel_pid_t iface)
+{
+    gnrc_ipv6_netif_t *netif = gnrc_ipv6_netif_get(iface);
+
+    return (netif != NULL) && (netif->flags & GNRC_IPV6_NETIF_FLAGS_CSUM_OFFLOAD);
+}
+
 static int _fill_ipv6_hdr(kernel_pid_t iface, gnrc_pktsnip_t *ipv6,
-                          gnrc_pktsnip_t *payload)
+                          gnrc_pktsnip_t *payload, bool calc_csum)
 {
     int res;
     ipv6_hdr_t *hdr = ipv6->data;
@@ -486,7 +621,18 @@ static int _fill_ipv6_hdr(kernel_pid_t iface, gnrc_pktsnip_t *ipv6,
             ipv6_addr_set_loopback(&hdr->src);
         }
         else {
+#ifdef MODULE_GNRC_IPV6_SRC_CACHE
+            ipv6_addr_t *src = gnrc_ipv6_src_cache_get(iface, &hdr->dst, false);
+
+            if (src == NULL) {
+                src = gnrc_ipv6_netif_find_best_src_addr(iface, &hdr->dst, false);
+                if (src != NULL) {
+                    gnrc_ipv6_src_cache_add(iface, &hdr->dst, false, src);
+                }
+            }
+#else
             ipv6_addr_t *src = gnrc_ipv6_netif_find_best_src_addr(iface, &hdr->dst, false);
+#endif
 
             if (src != NULL) {
                 DEBUG("ipv6: set packet source to %s\n",
@@ -497,6 +643,11 @@ static int _fill_ipv6_hdr(kernel_pid_t iface, gnrc_pktsnip_t *ipv6,
         }
     }
 
+    if (!calc_csum) {
+        DEBUG("ipv6: checksum of upper header is taken care of.\n");
+        return 0;
+    }
+
     DEBUG("ipv6: calculate checksum for upper header.\n");
 
     if ((res = gnrc_netreg_calc_csum(payload, ipv6)) < 0) {
@@ -523,7 +674,7 @@ static inline void _send_multicast_over_iface(kernel_pid_t iface, gnrc_pktsnip_t
 
 static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                             gnrc_pktsnip_t *ipv6, gnrc_pktsnip_t *payload,
-                            bool prep_hdr)
+                            bool prep_hdr, bool calc_csum)
 {
     kernel_pid_t ifs[GNRC_NETIF_NUMOF];
     size_t ifnum = 0;
@@ -535,6 +686,7 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
         /* throw away packet if no one is interested */
         if (ifnum == 0) {
             DEBUG("ipv6: no interfaces registered, dropping packet\n");
+            _STATS_INC(tx_dropped);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -558,6 +710,7 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                 if (ipv6 == NULL) {
                     DEBUG("ipv6: unable to get write access to IPv6 header, "
                           "for interface %" PRIkernel_pid "\n", ifs[i]);
+                    _STATS_INC(nobuf);
                     gnrc_pktbuf_release(pkt);
                     return;
                 }
@@ -569,6 +722,7 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                     tmp->next = gnrc_pktbuf_start_write(ptr);
                     if (tmp->next == NULL) {
                         DEBUG("ipv6: unable to get write access to payload, drop it\n");
+                        _STATS_INC(nobuf);
                         gnrc_pktbuf_release(ipv6);
                         return;
                     }
@@ -576,8 +730,10 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                     ptr = ptr->next;
                 }
 
-                if (_fill_ipv6_hdr(ifs[i], ipv6, tmp) < 0) {
+                if (_fill_ipv6_hdr(ifs[i], ipv6, tmp,
+                                   calc_csum && !_csum_offloaded(ifs[i])) < 0) {
                     /* error on filling up header */
+                    _STATS_INC(tx_dropped);
                     gnrc_pktbuf_release(ipv6);
                     return;
                 }
@@ -592,8 +748,10 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
     }
     else {
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+            if (_fill_ipv6_hdr(iface, ipv6, payload,
+                               calc_csum && !_csum_offloaded(iface)) < 0) {
                 /* error on filling up header */
+                _STATS_INC(tx_dropped);
                 gnrc_pktbuf_release(pkt);
                 return;
             }
@@ -613,8 +771,10 @@ static void _send_multicast(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
     }
 
     if (prep_hdr) {
-        if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+        if (_fill_ipv6_hdr(iface, ipv6, payload,
+                           calc_csum && !_csum_offloaded(iface)) < 0) {
             /* error on filling up header */
+            _STATS_INC(tx_dropped);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -654,22 +814,54 @@ static inline kernel_pid_t _next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len
     return found_iface;
 }
 
+#ifdef MODULE_GNRC_MPL
+/* multicast beyond the link is sent network-wide by MPL, which needs the
+ * complete packet to encapsulate it */
+static bool _mpl_send(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
+                      gnrc_pktsnip_t *ipv6, gnrc_pktsnip_t *payload,
+                      bool calc_csum)
+{
+    kernel_pid_t mpl_iface = gnrc_mpl_iface(&((ipv6_hdr_t *)ipv6->data)->dst);
+
+    if ((mpl_iface == KERNEL_PID_UNDEF) ||
+        ((iface != KERNEL_PID_UNDEF) && (iface != mpl_iface))) {
+        return false;
+    }
+    if (_fill_ipv6_hdr(mpl_iface, ipv6, payload, calc_csum) < 0) {
+        _STATS_INC(tx_dropped);
+        gnrc_pktbuf_release(pkt);
+        return true;
+    }
+    DEBUG("ipv6: send multicast with MPL\n");
+    if (gnrc_netapi_send(gnrc_mpl_pid, pkt) < 1) {
+        DEBUG("ipv6: unable to hand packet to MPL\n");
+        gnrc_pktbuf_release(pkt);
+    }
+    return true;
+}
+#endif
+
 static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
 {
     kernel_pid_t iface = KERNEL_PID_UNDEF;
     gnrc_pktsnip_t *ipv6, *payload;
     ipv6_addr_t *tmp;
     ipv6_hdr_t *hdr;
+    bool calc_csum = true;
     /* get IPv6 snip and (if present) generic interface header */
     if (pkt->type == GNRC_NETTYPE_NETIF) {
         /* If there is already a netif header (routing protocols and
          * neighbor discovery might add them to preset sending interface) */
         iface = ((gnrc_netif_hdr_t *)pkt->data)->if_pid;
+        /* upper layer might have set its checksum already */
+        calc_csum = !(((gnrc_netif_hdr_t *)pkt->data)->flags &
+                      GNRC_NETIF_HDR_FLAGS_CSUM);
         /* seize payload as temporary variable */
         ipv6 = gnrc_pktbuf_start_write(pkt); /* write protect for later removal
                                               * in _send_unicast() */
         if (ipv6 == NULL) {
             DEBUG("ipv6: unable to get write access to netif header, dropping packet\n");
+            _STATS_INC(nobuf);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -684,6 +876,7 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     payload = gnrc_pktbuf_start_write(ipv6);
     if (payload == NULL) {
         DEBUG("ipv6: unable to get write access to IPv6 header, dropping packet\n");
+        _STATS_INC(nobuf);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -698,8 +891,13 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     hdr = ipv6->data;
     payload = ipv6->next;
 
+#ifdef MODULE_GNRC_MPL
+    if (prep_hdr && _mpl_send(iface, pkt, ipv6, payload, calc_csum)) {
+        return;
+    }
+#endif
     if (ipv6_addr_is_multicast(&hdr->dst)) {
-        _send_multicast(iface, pkt, ipv6, payload, prep_hdr);
+        _send_multicast(iface, pkt, ipv6, payload, prep_hdr, calc_csum);
     }
     else if ((ipv6_addr_is_loopback(&hdr->dst)) ||      /* dst is loopback address */
              ((iface == KERNEL_PID_UNDEF) && /* or dst registered to any local interface */
@@ -710,8 +908,11 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         gnrc_pktsnip_t *ptr = ipv6, *rcv_pkt;
 
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+            /* packet does not leave the node, so no device fills in the
+             * checksum */
+            if (_fill_ipv6_hdr(iface, ipv6, payload, calc_csum) < 0) {
                 /* error on filling up header */
+                _STATS_INC(tx_dropped);
                 gnrc_pktbuf_release(pkt);
                 return;
             }
@@ -721,6 +922,7 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
 
         if (rcv_pkt == NULL) {
             DEBUG("ipv6: error on generating loopback packet\n");
+            _STATS_INC(nobuf);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -740,6 +942,7 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
 
         if (gnrc_netapi_receive(gnrc_ipv6_pid, rcv_pkt) < 1) {
             DEBUG("ipv6: unable to deliver packet\n");
+            _STATS_INC(tx_dropped);
             gnrc_pktbuf_release(rcv_pkt);
         }
     }
@@ -751,13 +954,16 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
 
         if (iface == KERNEL_PID_UNDEF) {
             DEBUG("ipv6: error determining next hop's link layer address\n");
+            _STATS_INC(no_route);
             gnrc_pktbuf_release(pkt);
             return;
         }
 
         if (prep_hdr) {
-            if (_fill_ipv6_hdr(iface, ipv6, payload) < 0) {
+            if (_fill_ipv6_hdr(iface, ipv6, payload,
+                               calc_csum && !_csum_offloaded(iface)) < 0) {
                 /* error on filling up header */
+                _STATS_INC(tx_dropped);
                 gnrc_pktbuf_release(pkt);
                 return;
             }
@@ -767,6 +973,32 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
     }
 }
 
+#if defined(MODULE_GNRC_IPV6_ROUTE_CACHE) && defined(MODULE_GNRC_IPV6_ROUTER)
+/* pkt must start with a writable IPv6 header to a unicast destination */
+static void _forward(gnrc_pktsnip_t *pkt)
+{
+    ipv6_hdr_t *hdr = pkt->data;
+    uint8_t l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
+    uint8_t l2addr[l2addr_len];
+    kernel_pid_t iface;
+
+    iface = gnrc_ipv6_route_cache_get(&hdr->dst, l2addr, &l2addr_len);
+    if (iface == KERNEL_PID_UNDEF) {
+        l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
+        iface = _next_hop_l2addr(l2addr, &l2addr_len, KERNEL_PID_UNDEF,
+                                 &hdr->dst, pkt);
+        if (iface == KERNEL_PID_UNDEF) {
+            DEBUG("ipv6: error determining next hop's link layer address\n");
+            _STATS_INC(no_route);
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        gnrc_ipv6_route_cache_add(&hdr->dst, iface, l2addr, l2addr_len);
+    }
+    _send_unicast(iface, l2addr, l2addr_len, pkt);
+}
+#endif
+
 /* functions for receiving */
 static inline bool _pkt_not_for_me(kernel_pid_t *iface, ipv6_hdr_t *hdr)
 {
@@ -795,6 +1027,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
 
     assert(pkt != NULL);
 
+    _STATS_INC(rx_count);
     netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
 
     if (netif != NULL) {
@@ -822,12 +1055,14 @@ static void _receive(gnrc_pktsnip_t *pkt)
     if (ipv6 == NULL) {
         if (!ipv6_hdr_is(pkt->data)) {
             DEBUG("ipv6: Received packet was not IPv6, dropping packet\n");
+            _STATS_INC(rx_invalid);
             gnrc_pktbuf_release(pkt);
             return;
         }
 #ifdef MODULE_GNRC_IPV6_WHITELIST
         if (!gnrc_ipv6_whitelisted(&((ipv6_hdr_t *)(pkt->data))->src)) {
             DEBUG("ipv6: Source address not whitelisted, dropping packet\n");
+            _STATS_INC(rx_invalid);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -835,6 +1070,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
 #ifdef MODULE_GNRC_IPV6_BLACKLIST
         if (gnrc_ipv6_blacklisted(&((ipv6_hdr_t *)(pkt->data))->src)) {
             DEBUG("ipv6: Source address blacklisted, dropping packet\n");
+            _STATS_INC(rx_invalid);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -844,6 +1080,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
 
         if (ipv6 == NULL) {
             DEBUG("ipv6: unable to get write access to packet, drop it\n");
+            _STATS_INC(nobuf);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -857,6 +1094,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
 
         if (ipv6 == NULL) {
             DEBUG("ipv6: error marking IPv6 header, dropping packet\n");
+            _STATS_INC(nobuf);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -865,6 +1103,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
     else if (!gnrc_ipv6_whitelisted(&((ipv6_hdr_t *)(ipv6->data))->src)) {
         /* if ipv6 header already marked*/
         DEBUG("ipv6: Source address not whitelisted, dropping packet\n");
+        _STATS_INC(rx_invalid);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -873,6 +1112,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
     else if (gnrc_ipv6_blacklisted(&((ipv6_hdr_t *)(ipv6->data))->src)) {
         /* if ipv6 header already marked*/
         DEBUG("ipv6: Source address blacklisted, dropping packet\n");
+        _STATS_INC(rx_invalid);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -891,6 +1131,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
         DEBUG("ipv6: invalid payload length: %d, actual: %d, dropping packet\n",
               (int) byteorder_ntohs(hdr->len),
               (int) (gnrc_pkt_len_upto(pkt, GNRC_NETTYPE_IPV6) - sizeof(ipv6_hdr_t)));
+        _STATS_INC(rx_invalid);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -915,6 +1156,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
         if ((ipv6_addr_is_link_local(&(hdr->src))) || (ipv6_addr_is_link_local(&(hdr->dst)))) {
             DEBUG("ipv6: do not forward packets with link-local source or"
                   " destination address\n");
+            _STATS_INC(fwd_dropped);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -928,6 +1170,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
             ipv6 = gnrc_pktbuf_start_write(ipv6);
             if (ipv6 == NULL) {
                 DEBUG("ipv6: unable to get write access to packet: dropping it\n");
+                _STATS_INC(nobuf);
                 gnrc_pktbuf_release(pkt);
                 return;
             }
@@ -944,6 +1187,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
                 ptr = gnrc_pktbuf_start_write(ptr);     /* duplicate if not already done */
                 if (ptr == NULL) {
                     DEBUG("ipv6: unable to get write access to packet: dropping it\n");
+                    _STATS_INC(nobuf);
                     gnrc_pktbuf_release(reversed_pkt);
                     gnrc_pktbuf_release(pkt);
                     return;
@@ -953,11 +1197,19 @@ static void _receive(gnrc_pktsnip_t *pkt)
                 reversed_pkt = ptr;
                 ptr = next;
             }
+            _STATS_INC(fwd_count);
+#ifdef MODULE_GNRC_IPV6_ROUTE_CACHE
+            if (!ipv6_addr_is_multicast(&hdr->dst)) {
+                _forward(reversed_pkt);
+                return;
+            }
+#endif
             _send(reversed_pkt, false);
             return;
         }
         else {
             DEBUG("ipv6: hop limit reached 0: drop packet\n");
+            _STATS_INC(fwd_dropped);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -965,6 +1217,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
 #else  /* MODULE_GNRC_IPV6_ROUTER */
         DEBUG("ipv6: dropping packet\n");
         /* non rounting hosts just drop the packet */
+        _STATS_INC(rx_not_for_me);
         gnrc_pktbuf_release(pkt);
         return;
 #endif /* MODULE_GNRC_IPV6_ROUTER */
@@ -991,4 +1244,11 @@ static void _decapsulate(gnrc_pktsnip_t *pkt)
     _receive(pkt);
 }
 
+#ifdef MODULE_NETSTATS_IPV6
+netstats_ipv6_t *gnrc_ipv6_get_stats(void)
+{
+    return &_stats;
+}
+#endif
+
 /** @} */
@@ -25,6 +25,14 @@
 #include "thread.h"
 #include "xtimer.h"
 
+#ifdef MODULE_GNRC_IPV6_ROUTE_CACHE
+#include "net/gnrc/ipv6/route_cache.h"
+/* next hops cached by gnrc_ipv6 may have changed */
+#define _NEIGHBORS_CHANGED()    gnrc_ipv6_route_cache_invalidate()
+#else
+#define _NEIGHBORS_CHANGED()
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -37,6 +45,53 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 static gnrc_ipv6_nc_t ncache[GNRC_IPV6_NC_SIZE];
 
+#ifdef MODULE_GNRC_IPV6_NC_HASHED
+#if (GNRC_IPV6_NC_BUCKET_NUMOF & (GNRC_IPV6_NC_BUCKET_NUMOF - 1)) != 0
+#error "GNRC_IPV6_NC_BUCKET_NUMOF must be a power of 2"
+#endif
+
+/* index over ncache by hashed address, chained through _next */
+static gnrc_ipv6_nc_t *_buckets[GNRC_IPV6_NC_BUCKET_NUMOF];
+static gnrc_ipv6_nc_t *_next[GNRC_IPV6_NC_SIZE];
+
+static inline gnrc_ipv6_nc_t **_bucket(const ipv6_addr_t *ipv6_addr)
+{
+    /* fold all bytes into the lower ones, neighbors often only differ in
+     * the interface identifier */
+    uint32_t hash = ipv6_addr->u32[0].u32 ^ ipv6_addr->u32[1].u32 ^
+                    ipv6_addr->u32[2].u32 ^ ipv6_addr->u32[3].u32;
+
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return &_buckets[hash & (GNRC_IPV6_NC_BUCKET_NUMOF - 1)];
+}
+
+static inline gnrc_ipv6_nc_t **_next_ptr(gnrc_ipv6_nc_t *entry)
+{
+    return &_next[entry - ncache];
+}
+
+static void _index_add(gnrc_ipv6_nc_t *entry)
+{
+    gnrc_ipv6_nc_t **bucket = _bucket(&entry->ipv6_addr);
+
+    *_next_ptr(entry) = *bucket;
+    *bucket = entry;
+}
+
+static void _index_remove(gnrc_ipv6_nc_t *entry)
+{
+    for (gnrc_ipv6_nc_t **ptr = _bucket(&entry->ipv6_addr); *ptr != NULL;
+         ptr = _next_ptr(*ptr)) {
+        if (*ptr == entry) {
+            *ptr = *_next_ptr(entry);
+            *_next_ptr(entry) = NULL;
+            return;
+        }
+    }
+}
+#endif
+
 static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
 {
     (void) iface;
@@ -57,6 +112,7 @@ static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
 #endif
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_ROUTER
     xtimer_remove(&entry->type_timeout);
+    gnrc_sixlowpan_nd_router_reg_remove(entry);
 
     gnrc_ipv6_netif_t *if_entry = gnrc_ipv6_netif_get(iface);
 
@@ -73,9 +129,15 @@ static void _nc_remove(kernel_pid_t iface, gnrc_ipv6_nc_t *entry)
     xtimer_remove(&entry->nbr_sol_timer);
     xtimer_remove(&entry->nbr_adv_timer);
 
+#ifdef MODULE_GNRC_IPV6_NC_HASHED
+    if (!ipv6_addr_is_unspecified(&(entry->ipv6_addr))) {
+        _index_remove(entry);
+    }
+#endif
     ipv6_addr_set_unspecified(&(entry->ipv6_addr));
     entry->iface = KERNEL_PID_UNDEF;
     entry->flags = 0;
+    _NEIGHBORS_CHANGED();
 }
 
 void gnrc_ipv6_nc_init(void)
@@ -86,6 +148,10 @@ void gnrc_ipv6_nc_init(void)
         _nc_remove(entry->iface, entry);
     }
     memset(ncache, 0, sizeof(ncache));
+#ifdef MODULE_GNRC_IPV6_NC_HASHED
+    memset(_buckets, 0, sizeof(_buckets));
+    memset(_next, 0, sizeof(_next));
+#endif
 }
 
 gnrc_ipv6_nc_t *_find_free_entry(void)
@@ -99,6 +165,27 @@ gnrc_ipv6_nc_t *_find_free_entry(void)
     return NULL;
 }
 
+static gnrc_ipv6_nc_t *_nc_update(gnrc_ipv6_nc_t *entry, const void *l2_addr,
+                                  size_t l2_addr_len, uint8_t flags)
+{
+    DEBUG("ipv6_nc: Address %s already registered.\n",
+          ipv6_addr_to_str(addr_str, &entry->ipv6_addr, sizeof(addr_str)));
+
+    if ((l2_addr != NULL) && (l2_addr_len > 0)) {
+        DEBUG("ipv6_nc: Update to L2 address %s",
+              gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
+                                     l2_addr, l2_addr_len));
+
+        memcpy(&(entry->l2_addr), l2_addr, l2_addr_len);
+        entry->l2_addr_len = l2_addr_len;
+        entry->flags = flags;
+        DEBUG(" with flags = 0x%0x\n", flags);
+        _NEIGHBORS_CHANGED();
+
+    }
+    return entry;
+}
+
 gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_addr,
                                  const void *l2_addr, size_t l2_addr_len, uint8_t flags)
 {
@@ -114,23 +201,18 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
         return NULL;
     }
 
+#ifdef MODULE_GNRC_IPV6_NC_HASHED
+    for (gnrc_ipv6_nc_t *entry = *_bucket(ipv6_addr); entry != NULL;
+         entry = *_next_ptr(entry)) {
+        if (ipv6_addr_equal(&(entry->ipv6_addr), ipv6_addr)) {
+            return _nc_update(entry, l2_addr, l2_addr_len, flags);
+        }
+    }
+    free_entry = _find_free_entry();
+#else
     for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
         if (ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
-            DEBUG("ipv6_nc: Address %s already registered.\n",
-                  ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
-
-            if ((l2_addr != NULL) && (l2_addr_len > 0)) {
-                DEBUG("ipv6_nc: Update to L2 address %s",
-                      gnrc_netif_addr_to_str(addr_str, sizeof(addr_str),
-                                             l2_addr, l2_addr_len));
-
-                memcpy(&(ncache[i].l2_addr), l2_addr, l2_addr_len);
-                ncache[i].l2_addr_len = l2_addr_len;
-                ncache[i].flags = flags;
-                DEBUG(" with flags = 0x%0x\n", flags);
-
-            }
-            return &ncache[i];
+            return _nc_update(&ncache[i], l2_addr, l2_addr_len, flags);
         }
 
         if (ipv6_addr_is_unspecified(&(ncache[i].ipv6_addr)) && !free_entry) {
@@ -138,6 +220,7 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
             free_entry = &ncache[i];
         }
     }
+#endif
 
     if (!free_entry) {
         /* reached end of NC without finding updateable or free entry */
@@ -152,6 +235,9 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
     free_entry->pkts = NULL;
 #endif
     memcpy(&(free_entry->ipv6_addr), ipv6_addr, sizeof(ipv6_addr_t));
+#ifdef MODULE_GNRC_IPV6_NC_HASHED
+    _index_add(free_entry);
+#endif
     DEBUG("ipv6_nc: Register %s for interface %" PRIkernel_pid,
           ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
           iface);
@@ -187,6 +273,7 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_add(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
 #endif
 
     free_entry->nbr_sol_msg.content.ptr = free_entry;
+    _NEIGHBORS_CHANGED();
 
     return free_entry;
 }
@@ -204,16 +291,22 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_get(kernel_pid_t iface, const ipv6_addr_t *ipv6_add
         return NULL;
     }
 
-    for (int i = 0; i < GNRC_IPV6_NC_SIZE; i++) {
-        if (((ncache[i].iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
-             (iface == ncache[i].iface)) &&
-            ipv6_addr_equal(&(ncache[i].ipv6_addr), ipv6_addr)) {
+#ifdef MODULE_GNRC_IPV6_NC_HASHED
+    for (gnrc_ipv6_nc_t *entry = *_bucket(ipv6_addr); entry != NULL;
+         entry = *_next_ptr(entry)) {
+#else
+    for (gnrc_ipv6_nc_t *entry = ncache; entry < (ncache + GNRC_IPV6_NC_SIZE);
+         entry++) {
+#endif
+        if (((entry->iface == KERNEL_PID_UNDEF) || (iface == KERNEL_PID_UNDEF) ||
+             (iface == entry->iface)) &&
+            ipv6_addr_equal(&(entry->ipv6_addr), ipv6_addr)) {
             DEBUG("ipv6_nc: Found entry for %s on interface %" PRIkernel_pid
                   " (0 = all interfaces) [%p]\n",
                   ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)),
-                  iface, (void *)(ncache + i));
+                  iface, (void *)entry);
 
-            return ncache + i;
+            return entry;
         }
     }
 
@@ -275,6 +368,7 @@ gnrc_ipv6_nc_t *gnrc_ipv6_nc_still_reachable(const ipv6_addr_t *ipv6_addr)
               ipv6_addr_to_str(addr_str, ipv6_addr, sizeof(addr_str)));
         entry->flags &= ~(GNRC_IPV6_NC_STATE_MASK >> GNRC_IPV6_NC_STATE_POS);
         entry->flags |= (GNRC_IPV6_NC_STATE_REACHABLE >> GNRC_IPV6_NC_STATE_POS);
+        _NEIGHBORS_CHANGED();
     }
 
     return entry;
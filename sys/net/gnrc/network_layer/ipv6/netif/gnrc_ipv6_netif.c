@@ -29,10 +29,13 @@
 #include "net/gnrc/netapi.h"
 #include "net/gnrc/netif.h"
 #include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/sixlowpan/nd.h"
 #include "net/gnrc/sixlowpan/netif.h"
 
 #include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/ipv6/route_cache.h"
+#include "net/gnrc/ipv6/src_cache.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -52,11 +55,84 @@
 #define RULE_3_PTS          (1)
 
 static gnrc_ipv6_netif_t ipv6_ifs[GNRC_NETIF_NUMOF];
+/* index + 1 into ipv6_ifs for every valid PID, 0 if the PID is no interface */
+static uint8_t ipv6_ifs_idx[MAXTHREADS];
 
 #if ENABLE_DEBUG
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+#if (GNRC_IPV6_NETIF_GROUPS_IDX_SIZE & (GNRC_IPV6_NETIF_GROUPS_IDX_SIZE - 1)) || \
+    (GNRC_IPV6_NETIF_GROUPS_IDX_SIZE <= GNRC_IPV6_NETIF_ADDR_NUMOF)
+#error "GNRC_IPV6_NETIF_GROUPS_IDX_SIZE must be a power of two > GNRC_IPV6_NETIF_ADDR_NUMOF"
+#endif
+
+static inline unsigned _group_hash(const ipv6_addr_t *addr)
+{
+    /* the group ID is in the last bytes, the scope in the second byte */
+    uint32_t key = addr->u32[3].u32 ^ addr->u8[1];
+
+    return (unsigned)((key * 2654435761U) >> 24) & (GNRC_IPV6_NETIF_GROUPS_IDX_SIZE - 1);
+}
+
+static gnrc_ipv6_netif_addr_t *_find_group(gnrc_ipv6_netif_t *entry,
+                                           const ipv6_addr_t *addr)
+{
+    unsigned slot = _group_hash(addr);
+
+    for (unsigned i = 0; i < GNRC_IPV6_NETIF_GROUPS_IDX_SIZE; i++) {
+        uint8_t idx = entry->groups[slot];
+
+        if (idx == 0) {
+            break;
+        }
+        if (ipv6_addr_equal(&entry->addrs[idx - 1].addr, addr)) {
+            return &entry->addrs[idx - 1];
+        }
+        slot = (slot + 1) & (GNRC_IPV6_NETIF_GROUPS_IDX_SIZE - 1);
+    }
+    return NULL;
+}
+
+static void _index_group(gnrc_ipv6_netif_t *entry, gnrc_ipv6_netif_addr_t *group)
+{
+    unsigned slot = _group_hash(&group->addr);
+
+    /* the index is larger than addrs, so there always is a free slot */
+    while (entry->groups[slot] != 0) {
+        slot = (slot + 1) & (GNRC_IPV6_NETIF_GROUPS_IDX_SIZE - 1);
+    }
+    entry->groups[slot] = (uint8_t)(group - entry->addrs) + 1;
+}
+
+static void _reindex_groups(gnrc_ipv6_netif_t *entry)
+{
+    /* removal from a linearly probed table would need tombstones, groups
+     * change rarely enough to rebuild the index instead */
+    memset(entry->groups, 0, sizeof(entry->groups));
+    for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
+        if (ipv6_addr_is_multicast(&entry->addrs[i].addr)) {
+            _index_group(entry, &entry->addrs[i]);
+        }
+    }
+}
+
+/* programs the link-layer multicast filter, called with the entry locked */
+static void _set_l2_group(gnrc_ipv6_netif_t *entry, const ipv6_addr_t *group,
+                          netopt_t opt)
+{
+    /* RFC 2464, section 7; only Ethernet devices filter multicast */
+    uint8_t l2addr[] = { 0x33, 0x33, group->u8[12], group->u8[13],
+                         group->u8[14], group->u8[15] };
+
+    if (!(entry->flags & GNRC_IPV6_NETIF_FLAGS_L2_GROUPS)) {
+        return;
+    }
+    mutex_unlock(&entry->mutex);    /* netapi call blocks on the interface */
+    gnrc_netapi_set(entry->pid, opt, 0, l2addr, sizeof(l2addr));
+    mutex_lock(&entry->mutex);
+}
+
 static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr_t *addr,
                                        uint8_t prefix_len, uint8_t flags)
 {
@@ -64,6 +140,9 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
 
     for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
         if (ipv6_addr_equal(&(entry->addrs[i].addr), addr)) {
+            if (entry->addrs[i].refs < UINT8_MAX) {
+                entry->addrs[i].refs++;
+            }
             return &(entry->addrs[i].addr);
         }
 
@@ -86,6 +165,7 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
 
     tmp_addr->prefix_len = prefix_len;
     tmp_addr->flags = flags;
+    tmp_addr->refs = 1;
 
 #ifdef MODULE_GNRC_SIXLOWPAN_ND
     if (!ipv6_addr_is_multicast(&(tmp_addr->addr)) &&
@@ -102,6 +182,8 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
 
     if (ipv6_addr_is_multicast(addr)) {
         tmp_addr->flags |= GNRC_IPV6_NETIF_ADDR_FLAGS_NON_UNICAST;
+        _index_group(entry, tmp_addr);
+        _set_l2_group(entry, addr, NETOPT_L2_GROUP);
     }
     else {
         if (!ipv6_addr_is_link_local(addr)) {
@@ -165,6 +247,10 @@ static void _reset_addr_from_entry(gnrc_ipv6_netif_t *entry)
 {
     DEBUG("ipv6 netif: Reset IPv6 addresses on interface %" PRIkernel_pid "\n", entry->pid);
     memset(entry->addrs, 0, sizeof(entry->addrs));
+    memset(entry->groups, 0, sizeof(entry->groups));
+#ifdef MODULE_GNRC_IPV6_SRC_CACHE
+    gnrc_ipv6_src_cache_invalidate();
+#endif
 }
 
 static void _ipv6_netif_remove(gnrc_ipv6_netif_t *entry)
@@ -184,6 +270,9 @@ static void _ipv6_netif_remove(gnrc_ipv6_netif_t *entry)
 #endif
     _reset_addr_from_entry(entry);
     DEBUG("ipv6 netif: Remove IPv6 interface %" PRIkernel_pid "\n", entry->pid);
+    if (pid_is_valid(entry->pid)) {
+        ipv6_ifs_idx[entry->pid - KERNEL_PID_FIRST] = 0;
+    }
     entry->pid = KERNEL_PID_UNDEF;
     entry->flags = 0;
 
@@ -196,6 +285,7 @@ void gnrc_ipv6_netif_init(void)
         mutex_init(&(ipv6_ifs[i].mutex));
         _ipv6_netif_remove(&ipv6_ifs[i]);
     }
+    memset(ipv6_ifs_idx, 0, sizeof(ipv6_ifs_idx));
 }
 
 void gnrc_ipv6_netif_add(kernel_pid_t pid)
@@ -226,6 +316,9 @@ void gnrc_ipv6_netif_add(kernel_pid_t pid)
     DEBUG("ipv6 netif: Add IPv6 interface %" PRIkernel_pid " (i = %d)\n", pid,
           free_entry - ipv6_ifs);
     free_entry->pid = pid;
+    if (pid_is_valid(pid)) {
+        ipv6_ifs_idx[pid - KERNEL_PID_FIRST] = (free_entry - ipv6_ifs) + 1;
+    }
     free_entry->mtu = GNRC_IPV6_NETIF_DEFAULT_MTU;
     free_entry->cur_hl = GNRC_IPV6_NETIF_DEFAULT_HL;
     free_entry->flags = 0;
@@ -253,6 +346,18 @@ void gnrc_ipv6_netif_remove(kernel_pid_t pid)
 
 gnrc_ipv6_netif_t *gnrc_ipv6_netif_get(kernel_pid_t pid)
 {
+    if (pid_is_valid(pid)) {
+        int i = ipv6_ifs_idx[pid - KERNEL_PID_FIRST] - 1;
+
+        if (i < 0) {
+            return NULL;
+        }
+        DEBUG("ipv6 netif: Get IPv6 interface %" PRIkernel_pid " (%p, i = %d)\n", pid,
+              (void *)(&(ipv6_ifs[i])), i);
+        return &(ipv6_ifs[i]);
+    }
+
+    /* PIDs out of range are only looked up linearly */
     for (int i = 0; i < GNRC_NETIF_NUMOF; i++) {
         if (ipv6_ifs[i].pid == pid) {
             DEBUG("ipv6 netif: Get IPv6 interface %" PRIkernel_pid " (%p, i = %d)\n", pid,
@@ -308,6 +413,15 @@ ipv6_addr_t *gnrc_ipv6_netif_add_addr(kernel_pid_t pid, const ipv6_addr_t *addr,
     res = _add_addr_to_entry(entry, addr, prefix_len, flags);
 
     mutex_unlock(&entry->mutex);
+#ifdef MODULE_GNRC_IPV6_ROUTE_CACHE
+    /* on-link prefixes may have changed */
+    gnrc_ipv6_route_cache_invalidate();
+#endif
+#ifdef MODULE_GNRC_IPV6_SRC_CACHE
+    gnrc_ipv6_src_cache_invalidate();
+#endif
+    /* addresses compressed against the interface's IID may have changed */
+    gnrc_sixlowpan_iphc_cache_invalidate();
 
     return res;
 }
@@ -320,8 +434,28 @@ static void _remove_addr_from_entry(gnrc_ipv6_netif_t *entry, ipv6_addr_t *addr)
         if (ipv6_addr_equal(&(entry->addrs[i].addr), addr)) {
             DEBUG("ipv6 netif: Remove %s to interface %" PRIkernel_pid "\n",
                   ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), entry->pid);
+            if (ipv6_addr_is_multicast(addr)) {
+                ipv6_addr_t group = *addr;  /* addr may point into entry */
+
+                ipv6_addr_set_unspecified(&(entry->addrs[i].addr));
+                entry->addrs[i].flags = 0;
+                entry->addrs[i].refs = 0;
+                _reindex_groups(entry);
+                _set_l2_group(entry, &group, NETOPT_L2_GROUP_LEAVE);
+                mutex_unlock(&entry->mutex);
+                return;
+            }
             ipv6_addr_set_unspecified(&(entry->addrs[i].addr));
             entry->addrs[i].flags = 0;
+            entry->addrs[i].refs = 0;
+#ifdef MODULE_GNRC_IPV6_ROUTE_CACHE
+            /* on-link prefixes may have changed */
+            gnrc_ipv6_route_cache_invalidate();
+#endif
+#ifdef MODULE_GNRC_IPV6_SRC_CACHE
+            gnrc_ipv6_src_cache_invalidate();
+#endif
+            gnrc_sixlowpan_iphc_cache_invalidate();
 #ifdef MODULE_GNRC_NDP_ROUTER
             /* Removal of prefixes MAY allow the router to retransmit up to
              * GNRC_NDP_MAX_INIT_RTR_ADV_NUMOF unsolicited RA
@@ -382,6 +516,43 @@ void gnrc_ipv6_netif_reset_addr(kernel_pid_t pid)
     mutex_unlock(&entry->mutex);
 }
 
+ipv6_addr_t *gnrc_ipv6_netif_join_group(kernel_pid_t pid, const ipv6_addr_t *group)
+{
+    if (!ipv6_addr_is_multicast(group)) {
+        return NULL;
+    }
+    return gnrc_ipv6_netif_add_addr(pid, group, IPV6_ADDR_BIT_LEN, 0);
+}
+
+void gnrc_ipv6_netif_leave_group(kernel_pid_t pid, const ipv6_addr_t *group)
+{
+    gnrc_ipv6_netif_t *entry = gnrc_ipv6_netif_get(pid);
+    gnrc_ipv6_netif_addr_t *tmp;
+
+    if ((entry == NULL) || !ipv6_addr_is_multicast(group)) {
+        return;
+    }
+
+    mutex_lock(&entry->mutex);
+    if ((tmp = _find_group(entry, group)) != NULL) {
+        if (tmp->refs > 1) {
+            tmp->refs--;
+        }
+        else {
+            ipv6_addr_t left = *group;  /* group may point into entry */
+
+            DEBUG("ipv6 netif: Leave %s on interface %" PRIkernel_pid "\n",
+                  ipv6_addr_to_str(addr_str, group, sizeof(addr_str)), pid);
+            ipv6_addr_set_unspecified(&tmp->addr);
+            tmp->flags = 0;
+            tmp->refs = 0;
+            _reindex_groups(entry);
+            _set_l2_group(entry, &left, NETOPT_L2_GROUP_LEAVE);
+        }
+    }
+    mutex_unlock(&entry->mutex);
+}
+
 kernel_pid_t gnrc_ipv6_netif_find_by_addr(ipv6_addr_t **out, const ipv6_addr_t *addr)
 {
     for (int i = 0; i < GNRC_NETIF_NUMOF; i++) {
@@ -421,6 +592,13 @@ ipv6_addr_t *gnrc_ipv6_netif_find_addr(kernel_pid_t pid, const ipv6_addr_t *addr
 
     mutex_lock(&entry->mutex);
 
+    if (ipv6_addr_is_multicast(addr)) {
+        gnrc_ipv6_netif_addr_t *group = _find_group(entry, addr);
+
+        mutex_unlock(&entry->mutex);
+        return (group != NULL) ? &group->addr : NULL;
+    }
+
     for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
         if (ipv6_addr_equal(&(entry->addrs[i].addr), addr)) {
             mutex_unlock(&entry->mutex);
@@ -679,15 +857,12 @@ static ipv6_addr_t *_source_address_selection(gnrc_ipv6_netif_t *iface, const ip
     uint8_t dst_scope = _get_scope(dst, true);
     DEBUG("finding the best match within the source address candidates\n");
 
-    for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
+    /* entries which are not part of the candidate set can be ignored */
+    for (int i = bf_find_first_set(candidate_set, GNRC_IPV6_NETIF_ADDR_NUMOF); i >= 0;
+         i = bf_find_next_set(candidate_set, GNRC_IPV6_NETIF_ADDR_NUMOF, i + 1)) {
         gnrc_ipv6_netif_addr_t *iter = &(iface->addrs[i]);
         DEBUG("Checking address: %s\n",
               ipv6_addr_to_str(addr_str, &(iter->addr), sizeof(addr_str)));
-        /* entries which are not  part of the candidate set can be ignored */
-        if (!(bf_isset(candidate_set, i))) {
-            DEBUG("Not part of the candidate set - skipping\n");
-            continue;
-        }
 
         /* Rule 1: if we have an address configured that equals the destination
          * use this one as source */
@@ -752,7 +927,7 @@ static ipv6_addr_t *_source_address_selection(gnrc_ipv6_netif_t *iface, const ip
     }
 
     /* reset candidate set to mark winners */
-    memset(candidate_set, 0, (GNRC_IPV6_NETIF_ADDR_NUMOF + 7) / 8);
+    bf_unset_range(candidate_set, 0, GNRC_IPV6_NETIF_ADDR_NUMOF);
     /* check if we have a clear winner */
     /* collect candidates with maximum points */
     for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
@@ -870,6 +1045,24 @@ void gnrc_ipv6_netif_init_by_dev(void)
             ipv6_if->flags &= ~GNRC_IPV6_NETIF_FLAGS_IS_WIRED;
         }
 
+        if (gnrc_netapi_get(ifs[i], NETOPT_OFFLOADS, 0, &tmp,
+                            sizeof(uint16_t)) >= 0) {
+            if (tmp & NETOPT_OFFLOAD_CSUM_TX) {
+                ipv6_if->flags |= GNRC_IPV6_NETIF_FLAGS_CSUM_OFFLOAD;
+            }
+            if (tmp & NETOPT_OFFLOAD_MCAST_FILTER) {
+                ipv6_if->flags |= GNRC_IPV6_NETIF_FLAGS_L2_GROUPS;
+                /* pass the groups joined before the flag was known */
+                for (int j = 0; j < GNRC_IPV6_NETIF_ADDR_NUMOF; j++) {
+                    if (ipv6_addr_is_multicast(&ipv6_if->addrs[j].addr)) {
+                        ipv6_addr_t group = ipv6_if->addrs[j].addr;
+
+                        _set_l2_group(ipv6_if, &group, NETOPT_L2_GROUP);
+                    }
+                }
+            }
+        }
+
         mutex_unlock(&ipv6_if->mutex);
 #if (defined(MODULE_GNRC_NDP_ROUTER) || defined(MODULE_GNRC_SIXLOWPAN_ND_ROUTER))
         gnrc_ipv6_netif_set_router(ipv6_if, true);
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <inttypes.h>
+
+#include "mutex.h"
+#include "net/ipv6.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#include "net/gnrc/ipv6/pmtu.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+typedef struct {
+    ipv6_addr_t dst;
+    uint32_t updated;           /* in seconds */
+    uint16_t mtu;               /* 0 marks unused entries */
+} _entry_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+static _entry_t _cache[GNRC_IPV6_PMTU_SIZE];
+
+static inline uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / SEC_IN_USEC);
+}
+
+/* expects _mutex to be locked */
+static _entry_t *_find(const ipv6_addr_t *dst, uint32_t now)
+{
+    for (unsigned i = 0; i < GNRC_IPV6_PMTU_SIZE; i++) {
+        _entry_t *entry = &_cache[i];
+
+        if ((entry->mtu != 0) &&
+            ((now - entry->updated) >= GNRC_IPV6_PMTU_TIMEOUT)) {
+            DEBUG("ipv6 pmtu: %u expired\n", i);
+            entry->mtu = 0;
+        }
+        if ((entry->mtu != 0) && ipv6_addr_equal(&entry->dst, dst)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+void gnrc_ipv6_pmtu_update(const ipv6_addr_t *dst, uint32_t mtu)
+{
+    uint32_t now = _now();
+    _entry_t *entry;
+
+    if (mtu < IPV6_MIN_MTU) {
+        return;
+    }
+    mutex_lock(&_mutex);
+    entry = _find(dst, now);
+    if (entry == NULL) {
+        entry = &_cache[0];
+        /* take an unused entry or the oldest */
+        for (unsigned i = 0; (i < GNRC_IPV6_PMTU_SIZE) && (entry->mtu != 0); i++) {
+            if ((_cache[i].mtu == 0) ||
+                ((now - _cache[i].updated) > (now - entry->updated))) {
+                entry = &_cache[i];
+            }
+        }
+        entry->dst = *dst;
+    }
+    else if (mtu >= entry->mtu) {
+        /* the path MTU is only lowered, RFC 8201, section 4 */
+        mutex_unlock(&_mutex);
+        return;
+    }
+    DEBUG("ipv6 pmtu: %" PRIu32 "\n", mtu);
+    entry->mtu = (mtu > UINT16_MAX) ? UINT16_MAX : (uint16_t)mtu;
+    entry->updated = now;
+    mutex_unlock(&_mutex);
+}
+
+uint16_t gnrc_ipv6_pmtu_get(const ipv6_addr_t *dst)
+{
+    _entry_t *entry;
+    uint16_t mtu = 0;
+
+    mutex_lock(&_mutex);
+    entry = _find(dst, _now());
+    if (entry != NULL) {
+        mtu = entry->mtu;
+    }
+    mutex_unlock(&_mutex);
+    return mtu;
+}
+
+void gnrc_ipv6_pmtu_flush(void)
+{
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < GNRC_IPV6_PMTU_SIZE; i++) {
+        _cache[i].mtu = 0;
+    }
+    mutex_unlock(&_mutex);
+}
+
+/** @} */
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "net/gnrc/ipv6/route_cache.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+typedef struct {
+    ipv6_addr_t dst;
+    unsigned gen;                   /* entry is valid if equal to _gen */
+    uint32_t expires;
+    kernel_pid_t iface;
+    uint8_t l2addr_len;
+    uint8_t l2addr[GNRC_IPV6_ROUTE_CACHE_L2ADDR_MAX];
+} _entry_t;
+
+static _entry_t _cache[GNRC_IPV6_ROUTE_CACHE_SIZE];
+static unsigned _next;  /* next entry to replace */
+/* generation of the cache. Starts at 1 so the zeroed entries are invalid.
+ * Changing it invalidates all entries at once, so invalidation is safe from
+ * any thread while lookups only happen in the IPv6 thread. */
+static volatile unsigned _gen = 1;
+/* generation at the last miss. An entry is only stored with it, so a result
+ * computed while the cache got invalidated is never used */
+static unsigned _miss_gen;
+static gnrc_ipv6_route_cache_stats_t _stats;
+
+kernel_pid_t gnrc_ipv6_route_cache_get(const ipv6_addr_t *dst, uint8_t *l2addr,
+                                       uint8_t *l2addr_len)
+{
+    unsigned gen = _gen;
+    uint32_t now = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_IPV6_ROUTE_CACHE_SIZE; i++) {
+        _entry_t *entry = &_cache[i];
+
+        if ((entry->gen == gen) && ((int32_t)(now - entry->expires) < 0) &&
+            ipv6_addr_equal(&entry->dst, dst)) {
+            memcpy(l2addr, entry->l2addr, entry->l2addr_len);
+            *l2addr_len = entry->l2addr_len;
+            _stats.hits++;
+            return entry->iface;
+        }
+    }
+    _miss_gen = gen;
+    _stats.misses++;
+    return KERNEL_PID_UNDEF;
+}
+
+void gnrc_ipv6_route_cache_add(const ipv6_addr_t *dst, kernel_pid_t iface,
+                               const uint8_t *l2addr, uint8_t l2addr_len)
+{
+    _entry_t *entry = &_cache[_next];
+
+    if (l2addr_len > GNRC_IPV6_ROUTE_CACHE_L2ADDR_MAX) {
+        return;
+    }
+    entry->gen = 0;
+    entry->dst = *dst;
+    entry->expires = xtimer_now_usec() + GNRC_IPV6_ROUTE_CACHE_TIMEOUT;
+    entry->iface = iface;
+    entry->l2addr_len = l2addr_len;
+    memcpy(entry->l2addr, l2addr, l2addr_len);
+    entry->gen = _miss_gen;
+    _next = (_next + 1) % GNRC_IPV6_ROUTE_CACHE_SIZE;
+}
+
+void gnrc_ipv6_route_cache_invalidate(void)
+{
+    unsigned gen = _gen + 1;
+
+    DEBUG("ipv6 route cache: invalidate\n");
+    /* skip 0, it marks unused entries */
+    _gen = (gen == 0) ? 1 : gen;
+    _stats.flushes++;
+}
+
+const gnrc_ipv6_route_cache_stats_t *gnrc_ipv6_route_cache_stats(void)
+{
+    return &_stats;
+}
+
+/** @} */
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include "net/gnrc/ipv6/src_cache.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* a selection with less common bits than that is the same for the whole
+ * /64, see gnrc_ipv6_netif_find_best_src_addr() */
+#define PREFIX_LEN      (64U)
+
+typedef struct {
+    ipv6_addr_t dst;
+    ipv6_addr_t *src;
+    unsigned gen;                   /* entry is valid if equal to _gen */
+    kernel_pid_t iface;
+    uint8_t dst_len;                /* bits of dst the entry matches */
+    bool ll_only;
+} _entry_t;
+
+static _entry_t _cache[GNRC_IPV6_SRC_CACHE_SIZE];
+static unsigned _next;  /* next entry to replace */
+/* generation of the cache, see gnrc_ipv6_route_cache.c */
+static volatile unsigned _gen = 1;
+static unsigned _miss_gen;
+static gnrc_ipv6_src_cache_stats_t _stats;
+
+ipv6_addr_t *gnrc_ipv6_src_cache_get(kernel_pid_t iface, const ipv6_addr_t *dst,
+                                     bool ll_only)
+{
+    unsigned gen = _gen;
+
+    for (unsigned i = 0; i < GNRC_IPV6_SRC_CACHE_SIZE; i++) {
+        _entry_t *entry = &_cache[i];
+
+        if ((entry->gen == gen) && (entry->iface == iface) &&
+            (entry->ll_only == ll_only) &&
+            (ipv6_addr_match_prefix(&entry->dst, dst) >= entry->dst_len)) {
+            _stats.hits++;
+            return entry->src;
+        }
+    }
+    _miss_gen = gen;
+    _stats.misses++;
+    return NULL;
+}
+
+void gnrc_ipv6_src_cache_add(kernel_pid_t iface, const ipv6_addr_t *dst,
+                             bool ll_only, ipv6_addr_t *src)
+{
+    _entry_t *entry = &_cache[_next];
+
+    entry->gen = 0;
+    entry->dst = *dst;
+    entry->src = src;
+    entry->iface = iface;
+    entry->ll_only = ll_only;
+    /* multicast destinations have no subnet */
+    entry->dst_len = (!ipv6_addr_is_multicast(dst) &&
+                      (ipv6_addr_match_prefix(src, dst) < PREFIX_LEN)) ?
+                     PREFIX_LEN : IPV6_ADDR_BIT_LEN;
+    entry->gen = _miss_gen;
+    _next = (_next + 1) % GNRC_IPV6_SRC_CACHE_SIZE;
+}
+
+void gnrc_ipv6_src_cache_invalidate(void)
+{
+    unsigned gen = _gen + 1;
+
+    DEBUG("ipv6 src cache: invalidate\n");
+    /* skip 0, it marks unused entries */
+    _gen = (gen == 0) ? 1 : gen;
+    _stats.flushes++;
+}
+
+const gnrc_ipv6_src_cache_stats_t *gnrc_ipv6_src_cache_stats(void)
+{
+    return &_stats;
+}
+
+/** @} */
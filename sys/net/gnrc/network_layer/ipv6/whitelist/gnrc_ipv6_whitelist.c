@@ -21,16 +21,52 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* addresses are kept in an open addressing hash table over this array */
 ipv6_addr_t gnrc_ipv6_whitelist[GNRC_IPV6_WHITELIST_SIZE];
 BITFIELD(gnrc_ipv6_whitelist_set, GNRC_IPV6_WHITELIST_SIZE);
+#if GNRC_IPV6_WHITELIST_PREFIXES
+gnrc_ipv6_whitelist_prefix_t gnrc_ipv6_whitelist_prefixes[GNRC_IPV6_WHITELIST_PREFIXES];
+#endif
 
 #if ENABLE_DEBUG
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+static unsigned _slot(const ipv6_addr_t *addr)
+{
+    uint32_t h = addr->u32[0].u32 ^ addr->u32[1].u32 ^ addr->u32[2].u32 ^
+                 addr->u32[3].u32;
+
+    h ^= h >> 16;
+    h ^= h >> 8;
+    return h % GNRC_IPV6_WHITELIST_SIZE;
+}
+
+static int _find(const ipv6_addr_t *addr)
+{
+    unsigned i = _slot(addr);
+
+    /* the probe sequence of an address ends at the first free slot */
+    for (int n = 0; n < GNRC_IPV6_WHITELIST_SIZE; n++) {
+        if (!bf_isset(gnrc_ipv6_whitelist_set, i)) {
+            break;
+        }
+        if (ipv6_addr_equal(addr, &gnrc_ipv6_whitelist[i])) {
+            return i;
+        }
+        i = (i + 1) % GNRC_IPV6_WHITELIST_SIZE;
+    }
+    return -1;
+}
+
 int gnrc_ipv6_whitelist_add(const ipv6_addr_t *addr)
 {
-    for (int i = 0; i < GNRC_IPV6_WHITELIST_SIZE; i++) {
+    unsigned i = _slot(addr);
+
+    if (_find(addr) >= 0) {
+        return 0;
+    }
+    for (int n = 0; n < GNRC_IPV6_WHITELIST_SIZE; n++) {
         if (!bf_isset(gnrc_ipv6_whitelist_set, i)) {
             bf_set(gnrc_ipv6_whitelist_set, i);
             memcpy(&gnrc_ipv6_whitelist[i], addr, sizeof(*addr));
@@ -38,29 +74,99 @@ int gnrc_ipv6_whitelist_add(const ipv6_addr_t *addr)
                   ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
             return 0;
         }
+        i = (i + 1) % GNRC_IPV6_WHITELIST_SIZE;
     }
     return -1;
 }
 
 void gnrc_ipv6_whitelist_del(const ipv6_addr_t *addr)
 {
-    for (int i = 0; i < GNRC_IPV6_WHITELIST_SIZE; i++) {
-        if (ipv6_addr_equal(addr, &gnrc_ipv6_whitelist[i])) {
-            bf_unset(gnrc_ipv6_whitelist_set, i);
-            DEBUG("IPv6 whitelist: unwhitelisted %s\n",
-                  ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
+    int i = _find(addr);
+
+    if (i < 0) {
+        return;
+    }
+    bf_unset(gnrc_ipv6_whitelist_set, i);
+    DEBUG("IPv6 whitelist: unwhitelisted %s\n",
+          ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
+    /* move entries of the probe sequence into the gap so lookups still
+     * find them */
+    for (unsigned j = (i + 1) % GNRC_IPV6_WHITELIST_SIZE;
+         bf_isset(gnrc_ipv6_whitelist_set, j);
+         j = (j + 1) % GNRC_IPV6_WHITELIST_SIZE) {
+        unsigned home = _slot(&gnrc_ipv6_whitelist[j]);
+        unsigned dist_gap = (i - home + GNRC_IPV6_WHITELIST_SIZE) %
+                            GNRC_IPV6_WHITELIST_SIZE;
+        unsigned dist_j = (j - home + GNRC_IPV6_WHITELIST_SIZE) %
+                          GNRC_IPV6_WHITELIST_SIZE;
+
+        if (dist_gap < dist_j) {
+            memcpy(&gnrc_ipv6_whitelist[i], &gnrc_ipv6_whitelist[j],
+                   sizeof(ipv6_addr_t));
+            bf_set(gnrc_ipv6_whitelist_set, i);
+            bf_unset(gnrc_ipv6_whitelist_set, j);
+            i = j;
         }
     }
 }
 
+#if GNRC_IPV6_WHITELIST_PREFIXES
+int gnrc_ipv6_whitelist_add_prefix(const ipv6_addr_t *prefix, uint8_t prefix_len)
+{
+    gnrc_ipv6_whitelist_prefix_t *unused = NULL;
+
+    for (int i = 0; i < GNRC_IPV6_WHITELIST_PREFIXES; i++) {
+        gnrc_ipv6_whitelist_prefix_t *entry = &gnrc_ipv6_whitelist_prefixes[i];
+
+        if (entry->len == 0) {
+            unused = (unused) ? unused : entry;
+        }
+        else if ((entry->len == prefix_len) &&
+                 (ipv6_addr_match_prefix(&entry->prefix, prefix) >= prefix_len)) {
+            return 0;
+        }
+    }
+    if ((unused == NULL) || (prefix_len == 0) || (prefix_len > 128)) {
+        return -1;
+    }
+    ipv6_addr_init_prefix(&unused->prefix, prefix, prefix_len);
+    unused->len = prefix_len;
+    DEBUG("IPv6 whitelist: whitelisted %s/%u\n",
+          ipv6_addr_to_str(addr_str, prefix, sizeof(addr_str)), prefix_len);
+    return 0;
+}
+
+void gnrc_ipv6_whitelist_del_prefix(const ipv6_addr_t *prefix, uint8_t prefix_len)
+{
+    for (int i = 0; i < GNRC_IPV6_WHITELIST_PREFIXES; i++) {
+        gnrc_ipv6_whitelist_prefix_t *entry = &gnrc_ipv6_whitelist_prefixes[i];
+
+        if ((entry->len != 0) && (entry->len == prefix_len) &&
+            (ipv6_addr_match_prefix(&entry->prefix, prefix) >= prefix_len)) {
+            entry->len = 0;
+            DEBUG("IPv6 whitelist: unwhitelisted %s/%u\n",
+                  ipv6_addr_to_str(addr_str, prefix, sizeof(addr_str)),
+                  prefix_len);
+        }
+    }
+}
+#endif
+
 bool gnrc_ipv6_whitelisted(const ipv6_addr_t *addr)
 {
-    for (int i = 0; i < GNRC_IPV6_WHITELIST_SIZE; i++) {
-        if (bf_isset(gnrc_ipv6_whitelist_set, i) &&
-            ipv6_addr_equal(addr, &gnrc_ipv6_whitelist[i])) {
+    if (_find(addr) >= 0) {
+        return true;
+    }
+#if GNRC_IPV6_WHITELIST_PREFIXES
+    for (int i = 0; i < GNRC_IPV6_WHITELIST_PREFIXES; i++) {
+        gnrc_ipv6_whitelist_prefix_t *entry = &gnrc_ipv6_whitelist_prefixes[i];
+
+        if ((entry->len != 0) &&
+            (ipv6_addr_match_prefix(&entry->prefix, addr) >= entry->len)) {
             return true;
         }
     }
+#endif
     return false;
 }
 
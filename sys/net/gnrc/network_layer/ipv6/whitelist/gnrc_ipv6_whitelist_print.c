@@ -22,15 +22,27 @@
 
 extern ipv6_addr_t gnrc_ipv6_whitelist[GNRC_IPV6_WHITELIST_SIZE];
 extern BITFIELD(gnrc_ipv6_whitelist_set, GNRC_IPV6_WHITELIST_SIZE);
+#if GNRC_IPV6_WHITELIST_PREFIXES
+extern gnrc_ipv6_whitelist_prefix_t gnrc_ipv6_whitelist_prefixes[GNRC_IPV6_WHITELIST_PREFIXES];
+#endif
 
 void gnrc_ipv6_whitelist_print(void)
 {
     char addr_str[IPV6_ADDR_MAX_STR_LEN];
-    for (int i = 0; i < GNRC_IPV6_WHITELIST_SIZE; i++) {
-        if (bf_isset(gnrc_ipv6_whitelist_set, i)) {
-            puts(ipv6_addr_to_str(addr_str, &gnrc_ipv6_whitelist[i], sizeof(addr_str)));
+    for (int i = bf_find_first_set(gnrc_ipv6_whitelist_set, GNRC_IPV6_WHITELIST_SIZE);
+         i >= 0; i = bf_find_next_set(gnrc_ipv6_whitelist_set, GNRC_IPV6_WHITELIST_SIZE, i + 1)) {
+        puts(ipv6_addr_to_str(addr_str, &gnrc_ipv6_whitelist[i], sizeof(addr_str)));
+    }
+#if GNRC_IPV6_WHITELIST_PREFIXES
+    for (int i = 0; i < GNRC_IPV6_WHITELIST_PREFIXES; i++) {
+        gnrc_ipv6_whitelist_prefix_t *entry = &gnrc_ipv6_whitelist_prefixes[i];
+
+        if (entry->len != 0) {
+            printf("%s/%u\n", ipv6_addr_to_str(addr_str, &entry->prefix, sizeof(addr_str)),
+                   entry->len);
         }
     }
+#endif
 }
 
 /** @} */
@@ -46,6 +46,12 @@
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+#ifdef MODULE_NETSTATS_NDP
+#define _STATS_INC(field)   (gnrc_ndp_get_stats()->field++)
+#else
+#define _STATS_INC(field)
+#endif
+
 /* sets an entry to stale if its l2addr differs from the given one or creates it stale if it
  * does not exist */
 static void _stale_nc(kernel_pid_t iface, ipv6_addr_t *ipaddr, uint8_t *l2addr,
@@ -104,6 +110,8 @@ void gnrc_ndp_nbr_sol_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
     sixlowpan_nd_opt_ar_t *ar_opt = NULL;
 #endif
     int sicmpv6_size = (int)icmpv6_size, l2src_len = 0;
+
+    _STATS_INC(rx_nbr_sol);
     DEBUG("ndp: received neighbor solicitation (src: %s, ",
           ipv6_addr_to_str(addr_str, &ipv6->src, sizeof(addr_str)));
     DEBUG("dst: %s, ",
@@ -216,6 +224,7 @@ void gnrc_ndp_nbr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
     gnrc_pktsnip_t *netif;
     gnrc_netif_hdr_t *netif_hdr = NULL;
 
+    _STATS_INC(rx_nbr_adv);
     DEBUG("ndp: received neighbor advertisement (src: %s, ",
           ipv6_addr_to_str(addr_str, &ipv6->src, sizeof(addr_str)));
     DEBUG("dst: %s, ",
@@ -380,6 +389,7 @@ void gnrc_ndp_rtr_sol_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
 {
     gnrc_ipv6_netif_t *if_entry = gnrc_ipv6_netif_get(iface);
 
+    _STATS_INC(rx_rtr_sol);
     if (if_entry->flags & GNRC_IPV6_NETIF_FLAGS_ROUTER) {
         gnrc_ipv6_nc_t *nc_entry;
         int sicmpv6_size = (int)icmpv6_size, l2src_len = 0;
@@ -434,12 +444,12 @@ void gnrc_ndp_rtr_sol_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
             }
 #endif
             delay = random_uint32_range(0, ms);
-            xtimer_remove(&if_entry->rtr_adv_timer);
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_ROUTER
             /* in case of a 6LBR we have to check if the interface is actually
              * the 6lo interface */
             if (if_entry->flags & GNRC_IPV6_NETIF_FLAGS_SIXLOWPAN) {
                 gnrc_ipv6_nc_t *nc_entry = gnrc_ipv6_nc_get(iface, &ipv6->src);
+                xtimer_remove(&if_entry->rtr_adv_timer);
                 if (nc_entry != NULL) {
                     if_entry->rtr_adv_msg.type = GNRC_NDP_MSG_RTR_ADV_SIXLOWPAN_DELAY;
                     if_entry->rtr_adv_msg.content.ptr = nc_entry;
@@ -448,22 +458,30 @@ void gnrc_ndp_rtr_sol_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
                 }
             }
 #elif defined(MODULE_GNRC_NDP_ROUTER) || defined(MODULE_GNRC_SIXLOWPAN_ND_BORDER_ROUTER)
-            if (ipv6_addr_is_unspecified(&ipv6->src)) {
-                /* either multicast, if source unspecified */
-                if_entry->rtr_adv_msg.type = GNRC_NDP_MSG_RTR_ADV_RETRANS;
-                if_entry->rtr_adv_msg.content.ptr = if_entry;
-                xtimer_set_msg(&if_entry->rtr_adv_timer, delay, &if_entry->rtr_adv_msg,
-                               gnrc_ipv6_pid);
+            /* answer all solicitations with one multicast advertisement, which
+             * must be at least GNRC_NDP_MIN_RTR_ADV_DELAY after the last one
+             * (https://tools.ietf.org/html/rfc4861#section-6.2.6) */
+            uint32_t now = xtimer_now_usec();
+            uint32_t next = now + delay;
+
+            if ((now - if_entry->last_mc_rtr_adv) <
+                (GNRC_NDP_MIN_RTR_ADV_DELAY * SEC_IN_USEC)) {
+                next = if_entry->last_mc_rtr_adv +
+                       (GNRC_NDP_MIN_RTR_ADV_DELAY * SEC_IN_USEC) + delay;
+            }
+            if ((if_entry->rtr_adv_msg.type == GNRC_NDP_MSG_RTR_ADV_RETRANS) &&
+                ((int32_t)(if_entry->next_mc_rtr_adv - now) >= 0) &&
+                ((int32_t)(if_entry->next_mc_rtr_adv - next) <= 0)) {
+                DEBUG("ndp: router advertisement already scheduled\n");
+                _STATS_INC(rtr_adv_coalesced);
             }
             else {
-                /* or unicast, if source is known */
-                /* XXX: can't just use GNRC_NETAPI_MSG_TYPE_SND, since the next retransmission
-                 * must also be set. */
-                nc_entry = gnrc_ipv6_nc_get(iface, &ipv6->src);
-                if (nc_entry) {
-                    xtimer_set_msg(&nc_entry->rtr_adv_timer, delay, &nc_entry->rtr_adv_msg,
-                                   gnrc_ipv6_pid);
-                }
+                xtimer_remove(&if_entry->rtr_adv_timer);
+                if_entry->rtr_adv_msg.type = GNRC_NDP_MSG_RTR_ADV_RETRANS;
+                if_entry->rtr_adv_msg.content.ptr = if_entry;
+                if_entry->next_mc_rtr_adv = next;
+                xtimer_set_msg(&if_entry->rtr_adv_timer, next - now,
+                               &if_entry->rtr_adv_msg, gnrc_ipv6_pid);
             }
 #endif
         }
@@ -502,6 +520,7 @@ void gnrc_ndp_rtr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt, ipv6_hdr_t
     int sicmpv6_size = (int)icmpv6_size, l2src_len = 0;
     uint16_t opt_offset = 0;
 
+    _STATS_INC(rx_rtr_adv);
     if (!ipv6_addr_is_link_local(&ipv6->src) ||
         ipv6_addr_is_multicast(&ipv6->src) ||
         (ipv6->hl != 255) || (rtr_adv->code != 0) ||
@@ -652,7 +671,17 @@ void gnrc_ndp_retrans_nbr_sol(gnrc_ipv6_nc_t *nc_entry)
         (gnrc_ipv6_nc_get_state(nc_entry) == GNRC_IPV6_NC_STATE_PROBE)) {
         if (nc_entry->probes_remaining > 1) {
             ipv6_addr_t dst;
-
+            uint32_t wait = gnrc_ndp_internal_nbr_sol_token();
+
+            if (wait > 0) {
+                /* too many solicitations recently, try again without
+                 * counting this probe */
+                DEBUG("ndp: Postpone neighbor solicitation for %" PRIu32 " us\n", wait);
+                gnrc_ndp_internal_reset_nbr_sol_timer(nc_entry, wait,
+                                                      GNRC_NDP_MSG_NBR_SOL_RETRANS,
+                                                      gnrc_ipv6_pid);
+                return;
+            }
             DEBUG("ndp: Retransmit neighbor solicitation for %s\n",
                   ipv6_addr_to_str(addr_str, &nc_entry->ipv6_addr, sizeof(addr_str)));
 
@@ -810,7 +839,9 @@ static inline size_t _ceil8(uint8_t length)
 gnrc_pktsnip_t *gnrc_ndp_opt_build(uint8_t type, size_t size, gnrc_pktsnip_t *next)
 {
     ndp_opt_t *opt;
-    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(next, NULL, _ceil8(size), GNRC_NETTYPE_UNDEF);
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add_quota(next, NULL, _ceil8(size),
+                                                GNRC_NETTYPE_UNDEF,
+                                                GNRC_PKTBUF_QUOTA_CONTROL);
 
     if (pkt == NULL) {
         DEBUG("ndp: no space left in packet buffer\n");
@@ -16,6 +16,8 @@
 
 #include "net/eui64.h"
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/route_cache.h"
+#include "net/gnrc/ipv6/src_cache.h"
 #include "net/gnrc/ndp.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/nd.h"
@@ -31,6 +33,19 @@
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+#ifdef MODULE_NETSTATS_NDP
+static netstats_ndp_t _stats;
+#define _STATS_INC(field)   (_stats.field++)
+#else
+#define _STATS_INC(field)
+#endif
+
+#if GNRC_NDP_NBR_SOL_RATE
+static uint32_t _nbr_sol_last;
+/* in units of 1 / GNRC_NDP_NBR_SOL_RATE solicitations */
+static uint64_t _nbr_sol_tokens = (uint64_t)GNRC_NDP_NBR_SOL_BURST * SEC_IN_USEC;
+#endif
+
 static gnrc_ipv6_nc_t *_last_router = NULL; /* last router chosen as default
                                              * router. Only used if reachability
                                              * is suspect (i. e. incomplete or
@@ -56,6 +71,27 @@ static inline void _send_delayed(xtimer_t *t, msg_t *msg, uint32_t interval, gnr
 }
 
 
+uint32_t gnrc_ndp_internal_nbr_sol_token(void)
+{
+#if GNRC_NDP_NBR_SOL_RATE
+    const uint64_t max = (uint64_t)GNRC_NDP_NBR_SOL_BURST * SEC_IN_USEC;
+    uint32_t now = xtimer_now_usec();
+
+    _nbr_sol_tokens += (uint64_t)(now - _nbr_sol_last) * GNRC_NDP_NBR_SOL_RATE;
+    _nbr_sol_last = now;
+    if (_nbr_sol_tokens > max) {
+        _nbr_sol_tokens = max;
+    }
+    if (_nbr_sol_tokens < SEC_IN_USEC) {
+        _STATS_INC(nbr_sol_deferred);
+        return (SEC_IN_USEC - _nbr_sol_tokens + GNRC_NDP_NBR_SOL_RATE - 1) /
+               GNRC_NDP_NBR_SOL_RATE;
+    }
+    _nbr_sol_tokens -= SEC_IN_USEC;
+#endif
+    return 0;
+}
+
 ipv6_addr_t *gnrc_ndp_internal_default_router(void)
 {
     gnrc_ipv6_nc_t *router = gnrc_ipv6_nc_get_next_router(NULL);
@@ -95,6 +131,9 @@ void gnrc_ndp_internal_set_state(gnrc_ipv6_nc_t *nc_entry, uint8_t state)
 
     nc_entry->flags &= ~GNRC_IPV6_NC_STATE_MASK;
     nc_entry->flags |= state;
+#ifdef MODULE_GNRC_IPV6_ROUTE_CACHE
+    gnrc_ipv6_route_cache_invalidate();
+#endif
 
     DEBUG("ndp internal: set %s state to ",
           ipv6_addr_to_str(addr_str, &nc_entry->ipv6_addr, sizeof(addr_str)));
@@ -218,11 +257,15 @@ void gnrc_ndp_internal_send_nbr_adv(kernel_pid_t iface, ipv6_addr_t *tgt, ipv6_a
         assert(nc_entry);
 
         _send_delayed(&nc_entry->nbr_adv_timer, &nc_entry->nbr_adv_msg, delay, hdr);
+        _STATS_INC(tx_nbr_adv);
     }
     else if (gnrc_netapi_send(gnrc_ipv6_pid, hdr) < 1) {
         DEBUG("ndp internal: unable to send neighbor advertisement\n");
         gnrc_pktbuf_release(hdr);
     }
+    else {
+        _STATS_INC(tx_nbr_adv);
+    }
 }
 
 void gnrc_ndp_internal_send_nbr_sol(kernel_pid_t iface, ipv6_addr_t *src, ipv6_addr_t *tgt,
@@ -302,6 +345,9 @@ void gnrc_ndp_internal_send_nbr_sol(kernel_pid_t iface, ipv6_addr_t *src, ipv6_a
         DEBUG("ndp internal: unable to send neighbor solicitation\n");
         gnrc_pktbuf_release(hdr);
     }
+    else {
+        _STATS_INC(tx_nbr_sol);
+    }
 }
 
 void gnrc_ndp_internal_send_rtr_sol(kernel_pid_t iface, ipv6_addr_t *dst)
@@ -347,6 +393,9 @@ void gnrc_ndp_internal_send_rtr_sol(kernel_pid_t iface, ipv6_addr_t *dst)
         DEBUG("ndp internal: unable to send router solicitation\n");
         gnrc_pktbuf_release(hdr);
     }
+    else {
+        _STATS_INC(tx_rtr_sol);
+    }
 }
 
 #if (defined(MODULE_GNRC_NDP_ROUTER) || defined(MODULE_GNRC_SIXLOWPAN_ND_ROUTER))
@@ -484,11 +533,9 @@ void gnrc_ndp_internal_send_rtr_adv(kernel_pid_t iface, ipv6_addr_t *src, ipv6_a
                 }
                 prf = prf->next;
             }
-            for (unsigned int i = 0; i < GNRC_SIXLOWPAN_CTX_SIZE; i++) {
+            for (int i = bf_find_first_set(abr->ctxs, GNRC_SIXLOWPAN_CTX_SIZE); i >= 0;
+                 i = bf_find_next_set(abr->ctxs, GNRC_SIXLOWPAN_CTX_SIZE, i + 1)) {
                 gnrc_sixlowpan_ctx_t *ctx;
-                if (!bf_isset(abr->ctxs, i)) {
-                    continue;
-                }
                 ctx = gnrc_sixlowpan_ctx_lookup_id(i);
                 hdr = gnrc_sixlowpan_nd_opt_6ctx_build(ctx->prefix_len, ctx->flags_id, ctx->ltime,
                                                        &ctx->prefix, pkt);
@@ -588,6 +635,9 @@ void gnrc_ndp_internal_send_rtr_adv(kernel_pid_t iface, ipv6_addr_t *src, ipv6_a
         DEBUG("ndp internal: unable to send router advertisement\n");
         gnrc_pktbuf_release(hdr);
     }
+    else {
+        _STATS_INC(tx_rtr_adv);
+    }
 }
 #endif
 
@@ -790,6 +840,10 @@ bool gnrc_ndp_internal_pi_opt_handle(kernel_pid_t iface, uint8_t icmpv6_type,
     }
     netif_addr->valid = byteorder_ntohl(pi_opt->valid_ltime);
     netif_addr->preferred = byteorder_ntohl(pi_opt->pref_ltime);
+#ifdef MODULE_GNRC_IPV6_SRC_CACHE
+    /* deprecated addresses lose in source address selection */
+    gnrc_ipv6_src_cache_invalidate();
+#endif
     if (netif_addr->valid != UINT32_MAX) {
         xtimer_set_msg(&netif_addr->valid_timeout,
                        (byteorder_ntohl(pi_opt->valid_ltime) * SEC_IN_USEC),
@@ -855,4 +909,11 @@ static gnrc_pktsnip_t *_build_headers(kernel_pid_t iface, gnrc_pktsnip_t *payloa
     return l2hdr;
 }
 
+#ifdef MODULE_NETSTATS_NDP
+netstats_ndp_t *gnrc_ndp_get_stats(void)
+{
+    return &_stats;
+}
+#endif
+
 /** @} */
@@ -20,7 +20,9 @@
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/ndp.h"
 #include "net/gnrc/pkt.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/pktqueue.h"
+#include "utlist.h"
 
 #include "net/gnrc/ndp/internal.h"
 
@@ -29,11 +31,16 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#if GNRC_NDP_NODE_QUEUE_PER_NBR == 0
+#error "GNRC_NDP_NODE_QUEUE_PER_NBR must be at least 1"
+#endif
+
 #if ENABLE_DEBUG
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
-static gnrc_pktqueue_t _pkt_nodes[GNRC_IPV6_NC_SIZE * 2];
+static gnrc_pktqueue_t _pkt_nodes[GNRC_NDP_NODE_QUEUE_SIZE];
+static gnrc_ndp_node_queue_stats_t _queue_stats;
 
 /**
  * @brief   Allocates a node for the packet queue.
@@ -55,6 +62,66 @@ static gnrc_pktqueue_t *_alloc_pkt_node(gnrc_pktsnip_t *pkt)
     return NULL;
 }
 
+/**
+ * @brief   Drops the oldest packet waiting for address resolution of a
+ *          neighbor.
+ *
+ * @param[in] nc_entry  Neighbor cache entry of the neighbor.
+ *
+ * @return  The freed packet queue node.
+ */
+static gnrc_pktqueue_t *_drop_head(gnrc_ipv6_nc_t *nc_entry)
+{
+    gnrc_pktqueue_t *pkt_node = gnrc_pktqueue_remove_head(&nc_entry->pkts);
+
+    gnrc_pktbuf_release(pkt_node->pkt);
+    pkt_node->pkt = NULL;
+    _queue_stats.dropped_head++;
+
+    return pkt_node;
+}
+
+/**
+ * @brief   Queues a packet until address resolution for a neighbor finished.
+ *
+ * @param[in] nc_entry  Neighbor cache entry of the neighbor.
+ * @param[in] pkt       Packet to queue.
+ */
+static void _queue_pkt(gnrc_ipv6_nc_t *nc_entry, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktqueue_t *pkt_node, *tmp;
+    unsigned queued;
+
+    if (pkt == NULL) {
+        return;
+    }
+
+    LL_COUNT(nc_entry->pkts, tmp, queued);
+
+    if (queued >= GNRC_NDP_NODE_QUEUE_PER_NBR) {
+        _drop_head(nc_entry);
+    }
+
+    pkt_node = _alloc_pkt_node(pkt);
+
+    if ((pkt_node == NULL) && (nc_entry->pkts != NULL)) {
+        /* all nodes are in use: prefer the new packet over our oldest one */
+        pkt_node = _drop_head(nc_entry);
+        pkt_node->pkt = pkt;
+    }
+
+    if (pkt_node == NULL) {
+        DEBUG("ndp node: could not add packet to packet queue\n");
+        _queue_stats.dropped_full++;
+        return;
+    }
+
+    /* prevent packet from being released by IPv6 */
+    gnrc_pktbuf_hold(pkt_node->pkt, 1);
+    gnrc_pktqueue_add(&nc_entry->pkts, pkt_node);
+    _queue_stats.queued++;
+}
+
 kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
                                            kernel_pid_t iface, ipv6_addr_t *dst,
                                            gnrc_pktsnip_t *pkt)
@@ -70,11 +137,30 @@ kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
         size_t next_hop_size = sizeof(ipv6_addr_t);
         uint32_t next_hop_flags = 0;
 
+#ifdef MODULE_FIB_MULTIPATH
+        gnrc_pktsnip_t *ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+        uint32_t flow = fib_flow_hash(dst, sizeof(ipv6_addr_t), 0);
+
+        if (ipv6 != NULL) {
+            ipv6_hdr_t *hdr = ipv6->data;
+
+            /* source and destination address are adjacent */
+            flow = fib_flow_hash(&hdr->src, 2 * sizeof(ipv6_addr_t),
+                                 ipv6_hdr_get_fl(hdr));
+        }
+        if ((next_hop_ip == NULL) &&
+            (fib_get_next_hop_flow(&gnrc_ipv6_fib_table, &iface,
+                                   next_hop_actual.u8, &next_hop_size,
+                                   &next_hop_flags, (uint8_t *)dst,
+                                   sizeof(ipv6_addr_t), 0, flow) >= 0) &&
+            (next_hop_size == sizeof(ipv6_addr_t))) {
+#else
         if ((next_hop_ip == NULL) &&
             (fib_get_next_hop(&gnrc_ipv6_fib_table, &iface, next_hop_actual.u8,
                               &next_hop_size, &next_hop_flags, (uint8_t *)dst,
                               sizeof(ipv6_addr_t), 0) >= 0) &&
             (next_hop_size == sizeof(ipv6_addr_t))) {
+#endif
             next_hop_ip = &next_hop_actual;
         }
     }
@@ -125,7 +211,6 @@ kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
         return gnrc_ipv6_nc_get_l2_addr(l2addr, l2addr_len, nc_entry);
     }
     else if (nc_entry == NULL) {
-        gnrc_pktqueue_t *pkt_node;
         ipv6_addr_t dst_sol;
 
         nc_entry = gnrc_ipv6_nc_add(iface, next_hop_ip, NULL, 0,
@@ -136,21 +221,22 @@ kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
             return KERNEL_PID_UNDEF;
         }
 
-        pkt_node = _alloc_pkt_node(pkt);
-
-        if (pkt_node == NULL) {
-            DEBUG("ndp node: could not add packet to packet queue\n");
-        }
-        else {
-            /* prevent packet from being released by IPv6 */
-            gnrc_pktbuf_hold(pkt_node->pkt, 1);
-            gnrc_pktqueue_add(&nc_entry->pkts, pkt_node);
-        }
+        _queue_pkt(nc_entry, pkt);
 
         /* address resolution */
         ipv6_addr_set_solicited_nodes(&dst_sol, next_hop_ip);
 
-        if (iface == KERNEL_PID_UNDEF) {
+        uint32_t wait = gnrc_ndp_internal_nbr_sol_token();
+
+        if (wait > 0) {
+            /* too many solicitations recently, leave the first one to the
+             * retransmission, which counts it as a probe */
+            DEBUG("ndp node: postpone neighbor solicitation for %" PRIu32 " us\n", wait);
+            nc_entry->probes_remaining++;
+            gnrc_ndp_internal_reset_nbr_sol_timer(nc_entry, wait,
+                                                  GNRC_NDP_MSG_NBR_SOL_RETRANS, gnrc_ipv6_pid);
+        }
+        else if (iface == KERNEL_PID_UNDEF) {
             kernel_pid_t ifs[GNRC_NETIF_NUMOF];
             size_t ifnum = gnrc_netif_get(ifs);
 
@@ -172,9 +258,18 @@ kernel_pid_t gnrc_ndp_node_next_hop_l2addr(uint8_t *l2addr, uint8_t *l2addr_len,
             mutex_unlock(&ipv6_iface->mutex);
         }
     }
+    else if (gnrc_ipv6_nc_get_state(nc_entry) == GNRC_IPV6_NC_STATE_INCOMPLETE) {
+        /* address resolution is already running */
+        _queue_pkt(nc_entry, pkt);
+    }
 
     return KERNEL_PID_UNDEF;
 }
 
+const gnrc_ndp_node_queue_stats_t *gnrc_ndp_node_queue_stats(void)
+{
+    return &_queue_stats;
+}
+
 
 /** @} */
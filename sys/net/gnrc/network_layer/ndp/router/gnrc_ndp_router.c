@@ -84,7 +84,7 @@ void gnrc_ndp_router_send_rtr_adv(gnrc_ipv6_nc_t *neighbor)
 static void _send_rtr_adv(gnrc_ipv6_netif_t *iface, ipv6_addr_t *dst)
 {
     bool fin;
-    uint32_t interval;
+    uint32_t interval, now = xtimer_now_usec();
 
     mutex_lock(&iface->mutex);
     fin = (iface->adv_ltime == 0);
@@ -107,9 +107,13 @@ static void _send_rtr_adv(gnrc_ipv6_netif_t *iface, ipv6_addr_t *dst)
         xtimer_remove(&iface->rtr_adv_timer);
         iface->rtr_adv_msg.type = GNRC_NDP_MSG_RTR_ADV_RETRANS;
         iface->rtr_adv_msg.content.ptr = iface;
+        iface->next_mc_rtr_adv = now + (interval * SEC_IN_USEC);
         xtimer_set_msg(&iface->rtr_adv_timer, interval * SEC_IN_USEC, &iface->rtr_adv_msg,
                        gnrc_ipv6_pid);
     }
+    if (dst == NULL) {
+        iface->last_mc_rtr_adv = now;
+    }
     mutex_unlock(&iface->mutex);
     for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
         ipv6_addr_t *src = &iface->addrs[i].addr;
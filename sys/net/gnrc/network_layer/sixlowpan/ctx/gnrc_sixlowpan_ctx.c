@@ -14,9 +14,11 @@
 
 #include <stdbool.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "mutex.h"
 #include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
 #include "xtimer.h"
 
 #define ENABLE_DEBUG    (0)
@@ -24,6 +26,10 @@
 
 static gnrc_sixlowpan_ctx_t _ctxs[GNRC_SIXLOWPAN_CTX_SIZE];
 static uint32_t _ctx_inval_times[GNRC_SIXLOWPAN_CTX_SIZE];
+/* IDs of the contexts in use, sorted by descending prefix length so the first
+ * matching context is the longest prefix match */
+static uint8_t _ctx_order[GNRC_SIXLOWPAN_CTX_SIZE];
+static uint8_t _ctx_order_len;
 static mutex_t _ctx_mutex = MUTEX_INIT;
 
 static uint32_t _current_minute(void);
@@ -39,21 +45,56 @@ static inline bool _valid(uint8_t id)
     return (_ctxs[id].prefix_len > 0);
 }
 
+static bool _prefix_match(const gnrc_sixlowpan_ctx_t *ctx, const ipv6_addr_t *addr)
+{
+    unsigned bytes = ctx->prefix_len / 8;
+    unsigned bits = ctx->prefix_len % 8;
+
+    if (memcmp(&ctx->prefix, addr, bytes) != 0) {
+        return false;
+    }
+    return (bits == 0) ||
+           (((ctx->prefix.u8[bytes] ^ addr->u8[bytes]) & (0xff << (8 - bits))) == 0);
+}
+
+static void _order_rem(uint8_t id)
+{
+    for (unsigned i = 0; i < _ctx_order_len; i++) {
+        if (_ctx_order[i] == id) {
+            _ctx_order_len--;
+            memmove(&_ctx_order[i], &_ctx_order[i + 1], _ctx_order_len - i);
+            return;
+        }
+    }
+}
+
+static void _order_add(uint8_t id)
+{
+    unsigned i = _ctx_order_len;
+
+    /* insertion sort: shift shorter prefixes back */
+    while ((i > 0) && (_ctxs[_ctx_order[i - 1]].prefix_len < _ctxs[id].prefix_len)) {
+        _ctx_order[i] = _ctx_order[i - 1];
+        i--;
+    }
+    _ctx_order[i] = id;
+    _ctx_order_len++;
+}
+
 gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr)
 {
-    uint8_t best = 0;
     gnrc_sixlowpan_ctx_t *res = NULL;
 
     mutex_lock(&_ctx_mutex);
 
-    for (unsigned int id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
-        if (_valid(id)) {
-            uint8_t match = ipv6_addr_match_prefix(&_ctxs[id].prefix, addr);
+    for (unsigned i = 0; i < _ctx_order_len; i++) {
+        uint8_t id = _ctx_order[i];
 
-            if ((_ctxs[id].prefix_len <= match) && (match > best)) {
-                best = match;
-                res = &(_ctxs[id]);
-            }
+        /* the prefix length may have been cleared through a returned entry */
+        if ((_ctxs[id].prefix_len > 0) && _prefix_match(&_ctxs[id], addr)) {
+            _update_lifetime(id);
+            res = &(_ctxs[id]);
+            break;
         }
     }
 
@@ -126,11 +167,28 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
           id, ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
           _ctxs[id].prefix_len, _ctxs[id].ltime);
     _ctx_inval_times[id] = ltime + _current_minute();
+    _order_rem(id);
+    _order_add(id);
 
     mutex_unlock(&_ctx_mutex);
+    gnrc_sixlowpan_iphc_cache_invalidate();
     return &(_ctxs[id]);
 }
 
+void gnrc_sixlowpan_ctx_remove(uint8_t id)
+{
+    if (id >= GNRC_SIXLOWPAN_CTX_SIZE) {
+        return;
+    }
+
+    mutex_lock(&_ctx_mutex);
+    DEBUG("6lo ctx: remove context %u\n", id);
+    _ctxs[id].prefix_len = 0;
+    _order_rem(id);
+    mutex_unlock(&_ctx_mutex);
+    gnrc_sixlowpan_iphc_cache_invalidate();
+}
+
 static uint32_t _current_minute(void)
 {
     return xtimer_now_usec() / (SEC_IN_USEC * 60);
@@ -158,11 +216,10 @@ static void _update_lifetime(uint8_t id)
 }
 
 #ifdef TEST_SUITES
-#include <string.h>
-
 void gnrc_sixlowpan_ctx_reset(void)
 {
     memset(_ctxs, 0, sizeof(_ctxs));
+    _ctx_order_len = 0;
 }
 #endif
 
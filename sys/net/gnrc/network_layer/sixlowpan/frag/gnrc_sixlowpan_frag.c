@@ -16,6 +16,8 @@
  * @author  Peter Kietzmann <peter.kietzmann@haw-hamburg.de>
  */
 
+#include <errno.h>
+
 #include "kernel_types.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/netapi.h"
@@ -24,8 +26,18 @@
 #include "net/gnrc/sixlowpan/netif.h"
 #include "net/sixlowpan.h"
 #include "utlist.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/gnrc/sixlowpan/nd.h"
+#include "net/ipv6/hdr.h"
+#include "net/udp.h"
+#endif
 
 #include "rbuf.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "vrb.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -66,6 +78,7 @@ static gnrc_pktsnip_t *_build_frag_pkt(gnrc_pktsnip_t *pkt, size_t payload_len,
     new_hdr->flags = hdr->flags;
     new_hdr->rssi = hdr->rssi;
     new_hdr->lqi = hdr->lqi;
+    new_hdr->prio = hdr->prio;
 
     frag = gnrc_pktbuf_add(NULL, NULL, _min(size, payload_len),
                            GNRC_NETTYPE_SIXLOWPAN);
@@ -216,6 +229,25 @@ static uint16_t _send_nth_fragment(gnrc_sixlowpan_netif_t *iface, gnrc_pktsnip_t
     return local_offset;
 }
 
+/* schedules sending of the next fragment */
+static void _send_next(gnrc_sixlowpan_msg_frag_t *fragment_msg)
+{
+#if GNRC_SIXLOWPAN_FRAG_GAP > 0
+    fragment_msg->msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
+    fragment_msg->msg.content.ptr = (void *)fragment_msg;
+    xtimer_set_msg(&fragment_msg->timer, GNRC_SIXLOWPAN_FRAG_GAP,
+                   &fragment_msg->msg, sched_active_pid);
+#else
+    msg_t msg;
+
+    /* send message to self*/
+    msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
+    msg.content.ptr = (void *)fragment_msg;
+    msg_send_to_self(&msg);
+    thread_yield();
+#endif
+}
+
 void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
 {
     gnrc_sixlowpan_netif_t *iface = gnrc_sixlowpan_netif_get(fragment_msg->pid);
@@ -223,7 +255,6 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
     /* payload_len: actual size of the packet vs
      * datagram_size: size of the uncompressed IPv6 packet */
     size_t payload_len = gnrc_pkt_len(fragment_msg->pkt->next);
-    msg_t msg;
 
 #if defined(DEVELHELP) && defined(ENABLE_DEBUG)
     if (iface == NULL) {
@@ -243,17 +274,12 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
         if ((res = _send_1st_fragment(iface, fragment_msg->pkt, payload_len, fragment_msg->datagram_size)) == 0) {
             /* error sending first fragment */
             DEBUG("6lo frag: error sending 1st fragment\n");
-            gnrc_pktbuf_release(fragment_msg->pkt);
+            gnrc_pktbuf_release_error(fragment_msg->pkt, ENOBUFS);
             fragment_msg->pkt = NULL;
             return;
         }
         fragment_msg->offset += res;
-
-        /* send message to self*/
-        msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = (void *)fragment_msg;
-        msg_send_to_self(&msg);
-        thread_yield();
+        _send_next(fragment_msg);
     }
     else {
         /* (offset + (datagram_size - payload_len) < datagram_size) simplified */
@@ -263,17 +289,12 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
                 /* error sending subsequent fragment */
                 DEBUG("6lo frag: error sending subsequent fragment (offset = %" PRIu16
                       ")\n", fragment_msg->offset);
-                gnrc_pktbuf_release(fragment_msg->pkt);
+                gnrc_pktbuf_release_error(fragment_msg->pkt, ENOBUFS);
                 fragment_msg->pkt = NULL;
                 return;
                 }
             fragment_msg->offset += res;
-
-            /* send message to self*/
-            msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-            msg.content.ptr = (void *)fragment_msg;
-            msg_send_to_self(&msg);
-            thread_yield();
+            _send_next(fragment_msg);
         }
         else {
             gnrc_pktbuf_release(fragment_msg->pkt);
@@ -282,6 +303,205 @@ void gnrc_sixlowpan_frag_send(gnrc_sixlowpan_msg_frag_t *fragment_msg)
     }
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+static gnrc_pktsnip_t *_vrb_netif_build(vrb_t *entry)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, entry->out_dst,
+                                                 entry->out_dst_len);
+
+    if (netif != NULL) {
+        ((gnrc_netif_hdr_t *)netif->data)->if_pid = entry->out_iface;
+    }
+
+    return netif;
+}
+
+/* relays a subsequent fragment of a forwarded datagram, consumes pkt */
+static void _vrb_forward_nth(vrb_t *entry, gnrc_pktsnip_t *pkt, size_t frag_size)
+{
+    gnrc_pktsnip_t *netif;
+    sixlowpan_frag_n_t *hdr;
+
+    if (frag_size >= entry->remaining) {
+        vrb_rem(entry);
+    }
+    else {
+        entry->remaining -= frag_size;
+    }
+
+    pkt = gnrc_pktbuf_start_write(pkt);
+    if (pkt == NULL) {
+        DEBUG("6lo vrb: unable to get write access to fragment\n");
+        return;
+    }
+    /* replace the link-layer header of the receiving interface */
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    netif = _vrb_netif_build(entry);
+    if (netif == NULL) {
+        DEBUG("6lo vrb: error allocating link-layer header\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    LL_PREPEND(pkt, netif);
+
+    hdr = netif->next->data;
+    hdr->tag = byteorder_htons(entry->out_tag);
+
+    DEBUG("6lo vrb: forward subsequent fragment (datagram tag: %" PRIu16
+          ", offset: %" PRIu8 ")\n", entry->out_tag, hdr->offset);
+    if (gnrc_netapi_send(entry->out_iface, pkt) < 1) {
+        DEBUG("6lo vrb: unable to forward subsequent fragment\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+/* decompresses the IPv6 header of the first fragment, routes it and
+ * recompresses it for the next hop. Returns false, if the datagram is to be
+ * reassembled instead. Does not consume pkt. */
+static bool _vrb_forward_1st(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
+                             size_t frag_size, uint16_t datagram_size)
+{
+    sixlowpan_frag_t *frag = pkt->data;
+    uint8_t *data = (uint8_t *)(frag + 1);
+    gnrc_pktsnip_t *dec, *payload, *netif;
+    gnrc_sixlowpan_netif_t *iface;
+    ipv6_hdr_t *ipv6_hdr;
+    vrb_t *entry;
+    uint8_t l2addr[RBUF_L2ADDR_MAX_LEN];
+    uint8_t l2addr_len = sizeof(l2addr);
+    size_t iphc_len, nh_len = 0;
+    kernel_pid_t out_iface;
+
+    if ((frag_size == 0) || !sixlowpan_iphc_is(data)) {
+        return false;
+    }
+
+    /* room for the IPv6 header and a UDP header decompressed by NHC */
+    dec = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t),
+                          GNRC_NETTYPE_IPV6);
+    if (dec == NULL) {
+        DEBUG("6lo vrb: error allocating IPv6 header\n");
+        return false;
+    }
+    memset(dec->data, 0, dec->size);
+    iphc_len = gnrc_sixlowpan_iphc_decode(&dec, pkt, datagram_size,
+                                          sizeof(sixlowpan_frag_t), &nh_len);
+    ipv6_hdr = dec->data;
+
+    if ((iphc_len == 0) || (iphc_len > frag_size) ||
+        ipv6_addr_is_multicast(&ipv6_hdr->dst) || (ipv6_hdr->hl <= 1) ||
+        (gnrc_ipv6_netif_find_by_addr(NULL, &ipv6_hdr->dst) != KERNEL_PID_UNDEF)) {
+        /* leave everything not just to be routed to IPv6 */
+        gnrc_pktbuf_release(dec);
+        return false;
+    }
+
+    out_iface = gnrc_sixlowpan_nd_next_hop_l2addr(l2addr, &l2addr_len,
+                                                  KERNEL_PID_UNDEF, &ipv6_hdr->dst);
+    iface = gnrc_sixlowpan_netif_get(out_iface);
+    if ((out_iface <= KERNEL_PID_UNDEF) || (iface == NULL) || !iface->iphc_enabled) {
+        gnrc_pktbuf_release(dec);
+        return false;
+    }
+    ipv6_hdr->hl--;
+
+    /* build netif header -> IPv6 header -> next header -> rest of fragment */
+    payload = gnrc_pktbuf_add(NULL, data + iphc_len, frag_size - iphc_len,
+                              GNRC_NETTYPE_UNDEF);
+    if ((payload != NULL) && (nh_len > 0)) {
+        payload = gnrc_pktbuf_add(payload, ((uint8_t *)dec->data) + sizeof(ipv6_hdr_t),
+                                  nh_len, GNRC_NETTYPE_UNDEF);
+    }
+    if (payload != NULL) {
+        payload = gnrc_pktbuf_add(payload, dec->data, sizeof(ipv6_hdr_t),
+                                  GNRC_NETTYPE_IPV6);
+    }
+    gnrc_pktbuf_release(dec);
+    if (payload == NULL) {
+        DEBUG("6lo vrb: error allocating first fragment\n");
+        return false;
+    }
+    if (gnrc_pkt_len(payload) > datagram_size) {
+        DEBUG("6lo vrb: fragment too big for resulting datagram\n");
+        gnrc_pktbuf_release(payload);
+        return false;
+    }
+
+    entry = vrb_add(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
+                    datagram_size, byteorder_ntohs(frag->tag));
+    entry->out_iface = out_iface;
+    memcpy(entry->out_dst, l2addr, l2addr_len);
+    entry->out_dst_len = l2addr_len;
+    entry->out_tag = ++_tag;
+    /* bytes of the uncompressed datagram in this fragment */
+    entry->remaining -= gnrc_pkt_len(payload);
+
+    netif = _vrb_netif_build(entry);
+    if (netif == NULL) {
+        DEBUG("6lo vrb: error allocating link-layer header\n");
+        gnrc_pktbuf_release(payload);
+        vrb_rem(entry);
+        return false;
+    }
+    netif->next = payload;
+
+    if (!gnrc_sixlowpan_iphc_encode(netif) ||
+        ((gnrc_pkt_len(netif->next) + sizeof(sixlowpan_frag_t)) > iface->max_frag_size) ||
+        ((payload = gnrc_pktbuf_add(netif->next, NULL, sizeof(sixlowpan_frag_t),
+                                    GNRC_NETTYPE_SIXLOWPAN)) == NULL)) {
+        /* compression for the next hop might be worse than for this one */
+        DEBUG("6lo vrb: unable to build first fragment for next hop\n");
+        gnrc_pktbuf_release(netif);
+        vrb_rem(entry);
+        return false;
+    }
+    netif->next = payload;
+    frag = payload->data;
+    frag->disp_size = byteorder_htons(datagram_size);
+    frag->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+    frag->tag = byteorder_htons(entry->out_tag);
+
+    DEBUG("6lo vrb: forward first fragment (datagram size: %" PRIu16
+          ", datagram tag: %" PRIu16 ")\n", datagram_size, entry->out_tag);
+    if (gnrc_netapi_send(out_iface, netif) < 1) {
+        DEBUG("6lo vrb: unable to forward first fragment\n");
+        gnrc_pktbuf_release(netif);
+    }
+
+    return true;
+}
+
+/* forwards the fragment if its datagram is not to be reassembled.
+ * Consumes pkt on success */
+static bool _vrb_forward(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
+                         size_t frag_size, uint16_t offset)
+{
+    sixlowpan_frag_t *frag = pkt->data;
+    uint16_t datagram_size = byteorder_ntohs(frag->disp_size) & SIXLOWPAN_FRAG_SIZE_MASK;
+    vrb_t *entry = vrb_get(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                           netif_hdr->src_l2addr_len, datagram_size,
+                           byteorder_ntohs(frag->tag));
+
+    if (offset == 0) {
+        if (entry != NULL) {
+            /* retransmission of the datagram: route it again */
+            vrb_rem(entry);
+        }
+        if (_vrb_forward_1st(netif_hdr, pkt, frag_size, datagram_size)) {
+            gnrc_pktbuf_release(pkt);
+            return true;
+        }
+        return false;
+    }
+    else if (entry != NULL) {
+        _vrb_forward_nth(entry, pkt, frag_size);
+        return true;
+    }
+
+    return false;
+}
+#endif
+
 void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt)
 {
     gnrc_netif_hdr_t *hdr = pkt->next->data;
@@ -306,6 +526,12 @@ void gnrc_sixlowpan_frag_handle_pkt(gnrc_pktsnip_t *pkt)
             return;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    if (_vrb_forward(hdr, pkt, frag_size, offset)) {
+        return;
+    }
+#endif
+
     rbuf_add(hdr, pkt, frag_size, offset);
 
     gnrc_pktbuf_release(pkt);
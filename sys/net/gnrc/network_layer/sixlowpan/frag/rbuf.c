@@ -22,6 +22,7 @@
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/sixlowpan.h"
+#include "memarray.h"
 #include "thread.h"
 #include "xtimer.h"
 #include "utlist.h"
@@ -42,9 +43,22 @@
 #define RBUF_INT_SIZE (DIV_CEIL(GNRC_IPV6_NETIF_DEFAULT_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * RBUF_SIZE)
 #endif
 
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_HASHED) && \
+    ((RBUF_BUCKET_NUMOF & (RBUF_BUCKET_NUMOF - 1)) != 0)
+#error "RBUF_BUCKET_NUMOF must be a power of 2"
+#endif
+
 static rbuf_int_t rbuf_int[RBUF_INT_SIZE];
+static memarray_t _ints = MEMARRAY_INIT(rbuf_int, 0);
 
 static rbuf_t rbuf[RBUF_SIZE];
+static memarray_t _entries = MEMARRAY_INIT(rbuf, 0);
+static rbuf_t *_lru;                /* used entries, least recently used first */
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_HASHED
+static rbuf_t *_buckets[RBUF_BUCKET_NUMOF];
+#endif
+
+static gnrc_sixlowpan_frag_rbuf_stats_t _stats;
 
 #if ENABLE_DEBUG
 static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
@@ -57,11 +71,13 @@ static char l2addr_str[3 * RBUF_L2ADDR_MAX_LEN];
 static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, uint16_t end);
 /* gets a free entry from interval buffer */
 static rbuf_int_t *_rbuf_int_get_free(void);
+/* gets a free entry from reassembly buffer, removes the oldest if full */
+static rbuf_t *_rbuf_get_free(void);
 /* remove entry from reassembly buffer */
 static void _rbuf_rem(rbuf_t *entry);
 /* update interval buffer of entry */
 static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size);
-/* checks timeouts and removes entries if necessary (oldest if full) */
+/* removes timed out entries */
 static void _rbuf_gc(void);
 /* gets an entry identified by its tupel */
 static rbuf_t *_rbuf_get(const void *src, size_t src_len,
@@ -87,7 +103,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                       byteorder_ntohs(frag->tag));
 
     if (entry == NULL) {
-        DEBUG("6lo rbuf: reassembly buffer full.\n");
+        DEBUG("6lo rbuf: could not get reassembly buffer entry.\n");
         return;
     }
 
@@ -106,6 +122,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                                                   sizeof(sixlowpan_frag_t), &nh_len);
             if (iphc_len == 0) {
                 DEBUG("6lo rfrag: could not decode IPHC dispatch\n");
+                _stats.invalid++;
                 gnrc_pktbuf_release(entry->pkt);
                 _rbuf_rem(entry);
                 return;
@@ -125,6 +142,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
 
     if ((offset + frag_size) > entry->pkt->size) {
         DEBUG("6lo rfrag: fragment too big for resulting datagram, discarding datagram\n");
+        _stats.invalid++;
         gnrc_pktbuf_release(entry->pkt);
         _rbuf_rem(entry);
         return;
@@ -136,6 +154,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     while (ptr != NULL) {
         if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
             DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
+            _stats.invalid++;
             gnrc_pktbuf_release(entry->pkt);
             _rbuf_rem(entry);
 
@@ -163,6 +182,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
 
         if (netif == NULL) {
             DEBUG("6lo rbuf: error allocating netif header\n");
+            _stats.nobuf++;
             gnrc_pktbuf_release(entry->pkt);
             _rbuf_rem(entry);
             return;
@@ -178,6 +198,7 @@ void rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         new_netif_hdr->lqi = netif_hdr->lqi;
         new_netif_hdr->rssi = netif_hdr->rssi;
         LL_APPEND(entry->pkt, netif);
+        _stats.complete++;
 
         if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL,
                                           entry->pkt)) {
@@ -196,15 +217,46 @@ static inline bool _rbuf_int_overlap_partially(rbuf_int_t *i, uint16_t start, ui
         ((start != i->start) || (end != i->end)); /* not identical */
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_HASHED
+static inline unsigned _bucket(const uint8_t *src, size_t src_len, uint16_t tag)
+{
+    uint32_t h = tag;
+
+    for (size_t i = 0; i < src_len; i++) {
+        h = (h << 8) ^ (h >> 24) ^ src[i];
+    }
+    h ^= h >> 16;
+    h ^= h >> 8;
+
+    return h & (RBUF_BUCKET_NUMOF - 1);
+}
+#endif
+
 static rbuf_int_t *_rbuf_int_get_free(void)
 {
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
+    rbuf_int_t *res = memarray_alloc(&_ints);
+
+    if (res != NULL) {
+        res->next = NULL;
+    }
+
+    return res;
+}
+
+static rbuf_t *_rbuf_get_free(void)
+{
+    rbuf_t *res = memarray_alloc(&_entries);
+
+    if (res == NULL) {
+        DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
+        _stats.evicted++;
+        gnrc_pktbuf_release(_lru->pkt);
+        _rbuf_rem(_lru);
+        res = memarray_alloc(&_entries);
     }
+    res->ints = NULL;
 
-    return NULL;
+    return res;
 }
 
 static void _rbuf_rem(rbuf_t *entry)
@@ -212,13 +264,22 @@ static void _rbuf_rem(rbuf_t *entry)
     while (entry->ints != NULL) {
         rbuf_int_t *next = entry->ints->next;
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
+        memarray_free(&_ints, entry->ints);
         entry->ints = next;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_HASHED
+    rbuf_t **ptr = &_buckets[_bucket(entry->src, entry->src_len, entry->tag)];
+
+    while (*ptr != entry) {
+        ptr = &(*ptr)->bucket_next;
+    }
+    *ptr = entry->bucket_next;
+#endif
+    DL_DELETE(_lru, entry);
+
     entry->pkt = NULL;
+    memarray_free(&_entries, entry);
 }
 
 static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
@@ -230,6 +291,7 @@ static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
 
     if (new == NULL) {
         DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
+        _stats.no_int++;
         return false;
     }
 
@@ -251,22 +313,20 @@ static bool _rbuf_update_ints(rbuf_t *entry, uint16_t offset, size_t frag_size)
 static void _rbuf_gc(void)
 {
     uint32_t now_usec = xtimer_now_usec();
-    unsigned int i;
-
-    for (i = 0; i < RBUF_SIZE; i++) {
-        /* since pkt occupies pktbuf, aggressivly collect garbage */
-        if ((rbuf[i].pkt != NULL) &&
-              ((now_usec - rbuf[i].arrival) > RBUF_TIMEOUT)) {
-            DEBUG("6lo rfrag: entry (%s, ", gnrc_netif_addr_to_str(l2addr_str,
-                    sizeof(l2addr_str), rbuf[i].src, rbuf[i].src_len));
-            DEBUG("%s, %u, %u) timed out\n",
-                  gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), rbuf[i].dst,
-                                         rbuf[i].dst_len),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-
-            gnrc_pktbuf_release(rbuf[i].pkt);
-            _rbuf_rem(&(rbuf[i]));
-        }
+
+    /* the LRU list is ordered by the arrival of the last fragment, so just
+     * check from its head until the first entry that did not time out */
+    while ((_lru != NULL) && ((now_usec - _lru->arrival) > RBUF_TIMEOUT)) {
+        DEBUG("6lo rfrag: entry (%s, ", gnrc_netif_addr_to_str(l2addr_str,
+                sizeof(l2addr_str), _lru->src, _lru->src_len));
+        DEBUG("%s, %u, %u) timed out\n",
+              gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), _lru->dst,
+                                     _lru->dst_len),
+              (unsigned)_lru->pkt->size, _lru->tag);
+
+        _stats.timeout++;
+        gnrc_pktbuf_release(_lru->pkt);
+        _rbuf_rem(_lru);
     }
 }
 
@@ -274,54 +334,47 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
                          const void *dst, size_t dst_len,
                          size_t size, uint16_t tag)
 {
-    rbuf_t *res = NULL, *oldest = NULL;
     uint32_t now_usec = xtimer_now_usec();
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_HASHED
+    unsigned bucket = _bucket(src, src_len, tag);
+    rbuf_t *res = _buckets[bucket];
+#else
+    rbuf_t *res = _lru;
+#endif
 
-    for (unsigned int i = 0; i < RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].pkt->size == size) &&
-            (rbuf[i].tag == tag) && (rbuf[i].src_len == src_len) &&
-            (rbuf[i].dst_len == dst_len) &&
-            (memcmp(rbuf[i].src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
+    /* check first if entry already available */
+    while (res != NULL) {
+        if ((res->pkt->size == size) && (res->tag == tag) &&
+            (res->src_len == src_len) && (res->dst_len == dst_len) &&
+            (memcmp(res->src, src, src_len) == 0) &&
+            (memcmp(res->dst, dst, dst_len) == 0)) {
+            DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
                   gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                         rbuf[i].src, rbuf[i].src_len));
+                                         res->src, res->src_len));
             DEBUG("%s, %u, %u) found\n",
                   gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str),
-                                         rbuf[i].dst, rbuf[i].dst_len),
-                  (unsigned)rbuf[i].pkt->size, rbuf[i].tag);
-            rbuf[i].arrival = now_usec;
-            return &(rbuf[i]);
-        }
-
-        /* if there is a free spot: remember it */
-        if ((res == NULL) && (rbuf[i].pkt == NULL)) {
-            res = &(rbuf[i]);
-        }
-
-        /* remember oldest slot */
-        /* note that xtimer_now will overflow in ~1.2 hours */
-        if ((oldest == NULL) || (oldest->arrival - rbuf[i].arrival < UINT32_MAX / 2)) {
-            oldest = &(rbuf[i]);
+                                         res->dst, res->dst_len),
+                  (unsigned)res->pkt->size, res->tag);
+            res->arrival = now_usec;
+            /* move to the end of the LRU list */
+            DL_DELETE(_lru, res);
+            DL_APPEND(_lru, res);
+            return res;
         }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_HASHED
+        res = res->bucket_next;
+#else
+        res = res->next;
+#endif
     }
 
-    /* entry not in buffer and no empty spot found */
-    if (res == NULL) {
-        assert(oldest != NULL);
-        assert(oldest->pkt != NULL); /* if oldest->pkt == NULL, res must not be NULL */
-        DEBUG("6lo rfrag: reassembly buffer full, remove oldest entry\n");
-        gnrc_pktbuf_release(oldest->pkt);
-        _rbuf_rem(oldest);
-        res = oldest;
-    }
-
-    /* now we have an empty spot */
-
-    res->pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_IPV6);
+    res = _rbuf_get_free();
+    res->pkt = gnrc_pktbuf_add_quota(NULL, NULL, size, GNRC_NETTYPE_IPV6,
+                                     GNRC_PKTBUF_QUOTA_REASSEMBLY);
     if (res->pkt == NULL) {
         DEBUG("6lo rfrag: can not allocate reassembly buffer space.\n");
+        _stats.nobuf++;
+        memarray_free(&_entries, res);
         return NULL;
     }
 
@@ -334,6 +387,11 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     res->dst_len = dst_len;
     res->tag = tag;
     res->cur_size = 0;
+    DL_APPEND(_lru, res);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_HASHED
+    res->bucket_next = _buckets[bucket];
+    _buckets[bucket] = res;
+#endif
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(l2addr_str, sizeof(l2addr_str), res->src,
@@ -346,4 +404,11 @@ static rbuf_t *_rbuf_get(const void *src, size_t src_len,
     return res;
 }
 
+const gnrc_sixlowpan_frag_rbuf_stats_t *gnrc_sixlowpan_frag_rbuf_stats(void)
+{
+    _stats.max_used = memarray_max_used(&_entries);
+    _stats.ints_max_used = memarray_max_used(&_ints);
+    return &_stats;
+}
+
 /** @} */
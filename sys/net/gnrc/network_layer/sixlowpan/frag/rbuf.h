@@ -31,8 +31,32 @@ extern "C" {
 #endif
 
 #define RBUF_L2ADDR_MAX_LEN (8U)               /**< maximum length for link-layer addresses */
-#define RBUF_SIZE           (4U)               /**< size of the reassembly buffer */
-#define RBUF_TIMEOUT        (3U * SEC_IN_USEC) /**< timeout for reassembly in microseconds */
+
+/**
+ * @brief   Number of datagrams that can be reassembled concurrently
+ */
+#ifndef RBUF_SIZE
+#define RBUF_SIZE           (4U)
+#endif
+
+/**
+ * @brief   Timeout for reassembly in microseconds
+ */
+#ifndef RBUF_TIMEOUT
+#define RBUF_TIMEOUT        (3U * SEC_IN_USEC)
+#endif
+
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_HASHED) || defined(DOXYGEN)
+/**
+ * @brief   Number of hash buckets to look up reassembly buffer entries
+ *
+ * @note    Only available with module `gnrc_sixlowpan_frag_hashed`.
+ *          Must be a power of 2.
+ */
+#ifndef RBUF_BUCKET_NUMOF
+#define RBUF_BUCKET_NUMOF   (8U)
+#endif
+#endif
 
 /**
  * @brief   Fragment intervals to identify limits of fragments.
@@ -70,7 +94,12 @@ typedef struct rbuf_int {
  *
  * @internal
  */
-typedef struct {
+typedef struct rbuf {
+    struct rbuf *prev;                  /**< previous entry in LRU list */
+    struct rbuf *next;                  /**< next entry in LRU list */
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_HASHED) || defined(DOXYGEN)
+    struct rbuf *bucket_next;           /**< next entry in the hash bucket */
+#endif
     rbuf_int_t *ints;                   /**< intervals of the fragment */
     gnrc_pktsnip_t *pkt;                /**< the reassembled packet in packet buffer */
     uint32_t arrival;                   /**< time in microseconds of arrival of
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "vrb.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+static vrb_t vrb[VRB_SIZE];
+
+vrb_t *vrb_get(const uint8_t *src, size_t src_len, uint16_t datagram_size,
+               uint16_t tag)
+{
+    uint32_t now_usec = xtimer_now_usec();
+
+    for (unsigned i = 0; i < VRB_SIZE; i++) {
+        vrb_t *entry = &vrb[i];
+
+        if ((entry->datagram_size == 0) || (entry->datagram_size != datagram_size) ||
+            (entry->tag != tag) || (entry->src_len != src_len) ||
+            (memcmp(entry->src, src, src_len) != 0)) {
+            continue;
+        }
+        if ((now_usec - entry->arrival) > VRB_TIMEOUT) {
+            DEBUG("6lo vrb: entry %p timed out\n", (void *)entry);
+            vrb_rem(entry);
+            return NULL;
+        }
+        entry->arrival = now_usec;
+        return entry;
+    }
+
+    return NULL;
+}
+
+vrb_t *vrb_add(const uint8_t *src, size_t src_len, uint16_t datagram_size,
+               uint16_t tag)
+{
+    uint32_t now_usec = xtimer_now_usec();
+    vrb_t *res = NULL;
+
+    for (unsigned i = 0; i < VRB_SIZE; i++) {
+        vrb_t *entry = &vrb[i];
+
+        if ((entry->datagram_size == 0) ||
+            ((now_usec - entry->arrival) > VRB_TIMEOUT)) {
+            res = entry;
+            break;
+        }
+        if ((res == NULL) || ((now_usec - entry->arrival) > (now_usec - res->arrival))) {
+            res = entry;
+        }
+    }
+
+    DEBUG("6lo vrb: add entry %p (size: %u, tag: %u)\n", (void *)res,
+          (unsigned)datagram_size, (unsigned)tag);
+    res->arrival = now_usec;
+    memcpy(res->src, src, src_len);
+    res->src_len = src_len;
+    res->datagram_size = datagram_size;
+    res->tag = tag;
+    res->out_dst_len = 0;
+    res->out_iface = KERNEL_PID_UNDEF;
+    res->out_tag = 0;
+    res->remaining = datagram_size;
+
+    return res;
+}
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
+/** @} */
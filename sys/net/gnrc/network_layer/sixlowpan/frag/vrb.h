@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @{
+ *
+ * @file
+ * @internal
+ * @brief   6LoWPAN virtual reassembly buffer
+ *
+ * Remembers where the fragments of a datagram that is forwarded without
+ * reassembly go to.
+ */
+#ifndef GNRC_SIXLOWPAN_FRAG_VRB_H_
+#define GNRC_SIXLOWPAN_FRAG_VRB_H_
+
+#include <inttypes.h>
+
+#include "kernel_types.h"
+
+#include "rbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of datagrams that can be forwarded concurrently
+ */
+#ifndef VRB_SIZE
+#define VRB_SIZE            (4U)
+#endif
+
+/**
+ * @brief   Timeout for an entry in microseconds
+ */
+#ifndef VRB_TIMEOUT
+#define VRB_TIMEOUT         (RBUF_TIMEOUT)
+#endif
+
+/**
+ * @brief   An entry in the virtual reassembly buffer.
+ *
+ * Identified by the source address, size and tag of the incoming datagram
+ * (see rbuf_t).
+ *
+ * @internal
+ */
+typedef struct {
+    uint32_t arrival;                       /**< time in microseconds of arrival of
+                                             *   last received fragment */
+    uint8_t src[RBUF_L2ADDR_MAX_LEN];       /**< source address */
+    uint8_t out_dst[RBUF_L2ADDR_MAX_LEN];   /**< link-layer address of the next hop */
+    uint8_t src_len;                        /**< length of source address */
+    uint8_t out_dst_len;                    /**< length of next hop address */
+    kernel_pid_t out_iface;                 /**< interface to forward over */
+    uint16_t datagram_size;                 /**< the datagram's size, 0 if unused */
+    uint16_t tag;                           /**< the datagram's tag */
+    uint16_t out_tag;                       /**< tag of the forwarded datagram */
+    uint16_t remaining;                     /**< datagram bytes not forwarded yet */
+} vrb_t;
+
+/**
+ * @brief   Get the entry of a datagram
+ *
+ * @param[in] src           Link-layer source address of the datagram.
+ * @param[in] src_len       Length of @p src.
+ * @param[in] datagram_size Size of the datagram.
+ * @param[in] tag           Tag of the datagram.
+ *
+ * @return  The entry, NULL if the datagram is not forwarded.
+ *
+ * @internal
+ */
+vrb_t *vrb_get(const uint8_t *src, size_t src_len, uint16_t datagram_size,
+               uint16_t tag);
+
+/**
+ * @brief   Adds an entry for a datagram, replacing the oldest one if the
+ *          buffer is full.
+ *
+ * @param[in] src           Link-layer source address of the datagram.
+ * @param[in] src_len       Length of @p src.
+ * @param[in] datagram_size Size of the datagram.
+ * @param[in] tag           Tag of the datagram.
+ *
+ * @return  The entry, with the members for the outgoing datagram unset.
+ *
+ * @internal
+ */
+vrb_t *vrb_add(const uint8_t *src, size_t src_len, uint16_t datagram_size,
+               uint16_t tag);
+
+/**
+ * @brief   Removes an entry
+ *
+ * @param[in] entry     The entry.
+ *
+ * @internal
+ */
+static inline void vrb_rem(vrb_t *entry)
+{
+    entry->datagram_size = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_SIXLOWPAN_FRAG_VRB_H_ */
+/** @} */
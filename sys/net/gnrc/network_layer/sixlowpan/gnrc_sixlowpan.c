@@ -12,6 +12,9 @@
  * @file
  */
 
+#include <errno.h>
+#include <string.h>
+
 #include "kernel_types.h"
 #include "net/gnrc.h"
 #include "thread.h"
@@ -23,6 +26,9 @@
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/sixlowpan/netif.h"
 #include "net/sixlowpan.h"
+#ifdef MODULE_GNRC_PKTTRACE
+#include "net/gnrc/pkttrace.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -32,10 +38,17 @@
 #include <inttypes.h>
 #endif
 
+#ifdef MODULE_NETSTATS_SIXLOWPAN
+static netstats_sixlowpan_t _stats;
+#define _STATS_INC(field)   (_stats.field++)
+#else
+#define _STATS_INC(field)
+#endif
+
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-static gnrc_sixlowpan_msg_frag_t fragment_msg = {KERNEL_PID_UNDEF, NULL, 0, 0};
+static gnrc_sixlowpan_msg_frag_t fragment_msg[GNRC_SIXLOWPAN_FRAG_MSG_NUMOF];
 #endif
 
 #if ENABLE_DEBUG
@@ -69,6 +82,10 @@ static void _receive(gnrc_pktsnip_t *pkt)
     gnrc_pktsnip_t *payload;
     uint8_t *dispatch;
 
+    _STATS_INC(rx_count);
+#ifdef MODULE_GNRC_PKTTRACE
+    gnrc_pkttrace_hop(pkt, GNRC_PKTTRACE_RX_SIXLOWPAN);
+#endif
     /* seize payload as a temporary variable */
     payload = gnrc_pktbuf_start_write(pkt); /* need to duplicate since pkt->next
                                              * might get replaced */
@@ -78,6 +95,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
 #if defined(DEVELHELP) && ENABLE_DEBUG
         gnrc_pktbuf_stats();
 #endif
+        _STATS_INC(nobuf);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -88,6 +106,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
 
     if ((payload == NULL) || (payload->size < 1)) {
         DEBUG("6lo: Received packet has no 6LoWPAN payload\n");
+        _STATS_INC(rx_dropped);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -104,6 +123,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
 #if defined(DEVELHELP) && ENABLE_DEBUG
             gnrc_pktbuf_stats();
 #endif
+            _STATS_INC(nobuf);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -113,6 +133,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
 
         if (sixlowpan == NULL) {
             DEBUG("6lo: can not mark 6LoWPAN dispatch\n");
+            _STATS_INC(nobuf);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -123,6 +144,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
     else if (sixlowpan_frag_is((sixlowpan_frag_t *)dispatch)) {
         DEBUG("6lo: received 6LoWPAN fragment\n");
+        _STATS_INC(rx_frag_count);
         gnrc_sixlowpan_frag_handle_pkt(pkt);
         return;
     }
@@ -137,6 +159,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
             (dispatch_size = gnrc_sixlowpan_iphc_decode(&dec_hdr, pkt, 0, 0,
                                                         &nh_len)) == 0) {
             DEBUG("6lo: error on IPHC decoding\n");
+            _STATS_INC(rx_dropped);
             if (dec_hdr != NULL) {
                 gnrc_pktbuf_release(dec_hdr);
             }
@@ -146,6 +169,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
         sixlowpan = gnrc_pktbuf_mark(pkt, dispatch_size, GNRC_NETTYPE_SIXLOWPAN);
         if (sixlowpan == NULL) {
             DEBUG("6lo: error on marking IPHC dispatch\n");
+            _STATS_INC(nobuf);
             gnrc_pktbuf_release(dec_hdr);
             gnrc_pktbuf_release(pkt);
             return;
@@ -160,11 +184,13 @@ static void _receive(gnrc_pktsnip_t *pkt)
     else {
         DEBUG("6lo: dispatch %02" PRIx8 " ... is not supported\n",
               dispatch[0]);
+        _STATS_INC(rx_dropped);
         gnrc_pktbuf_release(pkt);
         return;
     }
     if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
         DEBUG("6lo: No receivers for this packet found\n");
+        _STATS_INC(rx_no_receiver);
         gnrc_pktbuf_release(pkt);
     }
 }
@@ -188,22 +214,58 @@ static inline bool _add_uncompr_disp(gnrc_pktsnip_t *pkt)
     return true;
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+/* gets a free fragmentation slot, if no datagram to the same destination is
+ * fragmented yet */
+static gnrc_sixlowpan_msg_frag_t *_get_frag_msg(gnrc_netif_hdr_t *hdr)
+{
+    gnrc_sixlowpan_msg_frag_t *res = NULL;
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_MSG_NUMOF; i++) {
+        gnrc_netif_hdr_t *cur;
+
+        if (fragment_msg[i].pkt == NULL) {
+            res = (res == NULL) ? &fragment_msg[i] : res;
+            continue;
+        }
+        cur = fragment_msg[i].pkt->data;
+        if ((cur->if_pid == hdr->if_pid) &&
+            (cur->dst_l2addr_len == hdr->dst_l2addr_len) &&
+            (memcmp(gnrc_netif_hdr_get_dst_addr(cur), gnrc_netif_hdr_get_dst_addr(hdr),
+                    hdr->dst_l2addr_len) == 0)) {
+            return NULL;
+        }
+    }
+
+    return res;
+}
+#endif
+
 static void _send(gnrc_pktsnip_t *pkt)
 {
     gnrc_netif_hdr_t *hdr;
     gnrc_pktsnip_t *pkt2;
     gnrc_sixlowpan_netif_t *iface;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+    gnrc_sixlowpan_msg_frag_t *frag_msg;
+#endif
     /* datagram_size: pure IPv6 packet without 6LoWPAN dispatches or compression */
     size_t datagram_size;
 
+#ifdef MODULE_GNRC_PKTTRACE
+    gnrc_pkttrace_hop(pkt, GNRC_PKTTRACE_TX_SIXLOWPAN);
+#endif
+
     if ((pkt == NULL) || (pkt->size < sizeof(gnrc_netif_hdr_t))) {
         DEBUG("6lo: Sending packet has no netif header\n");
+        _STATS_INC(tx_dropped);
         gnrc_pktbuf_release(pkt);
         return;
     }
 
     if ((pkt->next == NULL) || (pkt->next->type != GNRC_NETTYPE_IPV6)) {
         DEBUG("6lo: Sending packet has no IPv6 header\n");
+        _STATS_INC(tx_dropped);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -212,6 +274,7 @@ static void _send(gnrc_pktsnip_t *pkt)
 
     if (pkt2 == NULL) {
         DEBUG("6lo: no space left in packet buffer\n");
+        _STATS_INC(nobuf);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -222,6 +285,7 @@ static void _send(gnrc_pktsnip_t *pkt)
 
     if (iface == NULL) {
         DEBUG("6lo: Can not get 6LoWPAN specific interface information.\n");
+        _STATS_INC(tx_dropped);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -230,6 +294,7 @@ static void _send(gnrc_pktsnip_t *pkt)
     if (iface->iphc_enabled) {
         if (!gnrc_sixlowpan_iphc_encode(pkt2)) {
             DEBUG("6lo: error on IPHC encoding\n");
+            _STATS_INC(nobuf);
             gnrc_pktbuf_release(pkt2);
             return;
         }
@@ -240,6 +305,7 @@ static void _send(gnrc_pktsnip_t *pkt)
         if (!_add_uncompr_disp(pkt2)) {
             /* adding uncompressed dispatch failed */
             DEBUG("6lo: no space left in packet buffer\n");
+            _STATS_INC(nobuf);
             gnrc_pktbuf_release(pkt2);
             return;
         }
@@ -250,6 +316,7 @@ static void _send(gnrc_pktsnip_t *pkt)
     if (!_add_uncompr_disp(pkt2)) {
         /* adding uncompressed dispatch failed */
         DEBUG("6lo: no space left in packet buffer\n");
+        _STATS_INC(nobuf);
         gnrc_pktbuf_release(pkt2);
         return;
     }
@@ -266,15 +333,20 @@ static void _send(gnrc_pktsnip_t *pkt)
               (void *)pkt2, hdr->if_pid);
         if (gnrc_netapi_send(hdr->if_pid, pkt2) < 1) {
             DEBUG("6lo: unable to send %p over %" PRIu16 "\n", (void *)pkt, hdr->if_pid);
+            _STATS_INC(tx_dropped);
             gnrc_pktbuf_release(pkt2);
         }
+        else {
+            _STATS_INC(tx_count);
+        }
 
         return;
     }
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG
-    else if (fragment_msg.pkt != NULL) {
+    else if ((frag_msg = _get_frag_msg(hdr)) == NULL) {
         DEBUG("6lo: Fragmentation already ongoing. Dropping packet\n");
-        gnrc_pktbuf_release(pkt2);
+        _STATS_INC(tx_dropped);
+        gnrc_pktbuf_release_error(pkt2, EBUSY);
         return;
     }
     else if (datagram_size <= SIXLOWPAN_FRAG_MAX_LEN) {
@@ -282,34 +354,56 @@ static void _send(gnrc_pktsnip_t *pkt)
               (unsigned int)datagram_size, iface->max_frag_size);
         msg_t msg;
 
-        fragment_msg.pid = hdr->if_pid;
-        fragment_msg.pkt = pkt2;
-        fragment_msg.datagram_size = datagram_size;
+        frag_msg->pid = hdr->if_pid;
+        frag_msg->pkt = pkt2;
+        frag_msg->datagram_size = datagram_size;
         /* Sending the first fragment has an offset==0 */
-        fragment_msg.offset = 0;
+        frag_msg->offset = 0;
 
         /* set the outgoing message's fields */
         msg.type = GNRC_SIXLOWPAN_MSG_FRAG_SND;
-        msg.content.ptr = &fragment_msg;
+        msg.content.ptr = frag_msg;
         /* send message to self */
         msg_send_to_self(&msg);
+        _STATS_INC(tx_count);
+        _STATS_INC(tx_frag_count);
     }
     else {
         DEBUG("6lo: packet too big (%u > %" PRIu16 ")\n",
               (unsigned int)datagram_size, (uint16_t)SIXLOWPAN_FRAG_MAX_LEN);
+        _STATS_INC(tx_dropped);
         gnrc_pktbuf_release(pkt2);
     }
 #else
     (void) datagram_size;
     DEBUG("6lo: packet too big (%u > %" PRIu16 ")\n",
           (unsigned int)datagram_size, iface->max_frag_size);
+    _STATS_INC(tx_dropped);
     gnrc_pktbuf_release(pkt2);
 #endif
 }
 
+#ifdef MODULE_NETSTATS_SIXLOWPAN
+static int _get_stats(gnrc_netapi_opt_t *opt)
+{
+    if ((opt->context != NETSTATS_SIXLOWPAN) ||
+        (opt->data_len != sizeof(uintptr_t))) {
+        return -ENOTSUP;
+    }
+    *((netstats_sixlowpan_t **)opt->data) = &_stats;
+    return sizeof(uintptr_t);
+}
+
+netstats_sixlowpan_t *gnrc_sixlowpan_get_stats(void)
+{
+    return &_stats;
+}
+#endif
+
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[GNRC_SIXLOWPAN_MSG_QUEUE_SIZE];
+    gnrc_netapi_backlog_t backlog = { 0 };
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
 
@@ -325,7 +419,7 @@ static void *_event_loop(void *args)
     /* start event loop */
     while (1) {
         DEBUG("6lo: waiting for incoming message.\n");
-        msg_receive(&msg);
+        gnrc_netapi_receive_prio(&backlog, &msg);
 
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
@@ -339,6 +433,14 @@ static void *_event_loop(void *args)
                 break;
 
             case GNRC_NETAPI_MSG_TYPE_GET:
+#ifdef MODULE_NETSTATS_SIXLOWPAN
+                if (((gnrc_netapi_opt_t *)msg.content.ptr)->opt == NETOPT_STATS) {
+                    reply.content.value = _get_stats(msg.content.ptr);
+                    msg_reply(&msg, &reply);
+                    break;
+                }
+#endif
+                /* falls through */
             case GNRC_NETAPI_MSG_TYPE_SET:
                 DEBUG("6lo: reply to unsupported get/set\n");
                 reply.content.value = -ENOTSUP;
@@ -29,6 +29,9 @@
 #include "net/gnrc/udp.h"
 
 #include "net/gnrc/sixlowpan/iphc.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+#include "xtimer.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -581,27 +584,24 @@ inline static size_t iphc_nhc_udp_encode(gnrc_pktsnip_t *udp, ipv6_hdr_t *ipv6_h
 }
 #endif
 
-bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
+/* result of the address compression */
+typedef struct {
+    uint8_t iphc2;      /* second byte of the IPHC dispatch */
+    uint8_t cid_ext;    /* context identifier extension */
+    uint8_t len;        /* length of inline_addr */
+    uint8_t inline_addr[2 * sizeof(ipv6_addr_t)];   /* inline address fields */
+} _addr_comp_t;
+
+/* compresses the addresses of ipv6_hdr into res */
+static void _addr_encode(gnrc_netif_hdr_t *netif_hdr, ipv6_hdr_t *ipv6_hdr,
+                         _addr_comp_t *res)
 {
-    gnrc_netif_hdr_t *netif_hdr = pkt->data;
-    ipv6_hdr_t *ipv6_hdr = pkt->next->data;
-    uint8_t *iphc_hdr;
-    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
-    bool addr_comp = false, nhc_comp = false;
+    uint8_t inline_pos = 0;
+    bool addr_comp = false;
     gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    gnrc_pktsnip_t *dispatch = gnrc_pktbuf_add(NULL, NULL, pkt->next->size,
-                                               GNRC_NETTYPE_SIXLOWPAN);
 
-    if (dispatch == NULL) {
-        DEBUG("6lo iphc: error allocating dispatch space\n");
-        return false;
-    }
-
-    iphc_hdr = dispatch->data;
-
-    /* set initial dispatch value*/
-    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
-    iphc_hdr[IPHC2_IDX] = 0;
+    res->iphc2 = 0;
+    res->cid_ext = 0;
 
     /* check for available contexts */
     if (!ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
@@ -623,95 +623,24 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
     }
 
     /* if contexts available and both != 0 */
-    /* since this moves inline_pos we have to do this ahead*/
     if (((src_ctx != NULL) &&
             ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) ||
         ((dst_ctx != NULL) &&
             ((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0))) {
         /* add context identifier extension */
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_CID_EXT;
-        iphc_hdr[CID_EXT_IDX] = 0;
-
-        /* move position to behind CID extension */
-        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
-    }
-
-    /* compress flow label and traffic class */
-    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
-        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
-            /* elide both traffic class and flow label */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
-        }
-        else {
-            /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-        }
-    }
-    else {
-        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
-            /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
-                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
-        }
-        else {
-            /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
-            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
-        }
-
-        /* copy remaining byteos of flow label */
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff) >> 8);
-    }
-
-    /* compress next header */
-    switch (ipv6_hdr->nh) {
-#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
-        case PROTNUM_UDP:
-            iphc_nhc_udp_encode(pkt->next->next, ipv6_hdr);
-            iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
-            nhc_comp = true;
-            break;
-#endif
-
-        default:
-            iphc_hdr[inline_pos++] = ipv6_hdr->nh;
-            break;
-    }
-
-    /* compress hop limit */
-    switch (ipv6_hdr->hl) {
-        case 1:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_1;
-            break;
-
-        case 64:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_64;
-            break;
-
-        case 255:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_255;
-            break;
-
-        default:
-            iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
-            iphc_hdr[inline_pos++] = ipv6_hdr->hl;
-            break;
+        res->iphc2 |= SIXLOWPAN_IPHC2_CID_EXT;
     }
 
     if (ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
-        iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_UNSPEC;
+        res->iphc2 |= IPHC_SAC_SAM_UNSPEC;
     }
     else {
         if (src_ctx != NULL) {
             /* stateful source address compression */
-            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_SAC;
+            res->iphc2 |= SIXLOWPAN_IPHC2_SAC;
 
             if (((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) {
-                iphc_hdr[CID_EXT_IDX] |= ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) << 4);
+                res->cid_ext |= ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) << 4);
             }
         }
 
@@ -735,21 +664,21 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
             if ((ipv6_hdr->src.u64[1].u64 == iid.uint64.u64) ||
                 _context_overlaps_iid(src_ctx, &ipv6_hdr->src, &iid)) {
                 /* 0 bits. The address is derived from link-layer address */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_L2;
+                res->iphc2 |= IPHC_SAC_SAM_L2;
                 addr_comp = true;
             }
             else if ((byteorder_ntohl(ipv6_hdr->src.u32[2]) == 0x000000ff) &&
                      (byteorder_ntohs(ipv6_hdr->src.u16[6]) == 0xfe00)) {
                 /* 16 bits. The address is derived using 16 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_16;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u16 + 7, 2);
+                res->iphc2 |= IPHC_SAC_SAM_16;
+                memcpy(res->inline_addr + inline_pos, ipv6_hdr->src.u16 + 7, 2);
                 inline_pos += 2;
                 addr_comp = true;
             }
             else {
                 /* 64 bits. The address is derived using 64 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_64;
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u64 + 1, 8);
+                res->iphc2 |= IPHC_SAC_SAM_64;
+                memcpy(res->inline_addr + inline_pos, ipv6_hdr->src.u64 + 1, 8);
                 inline_pos += 8;
                 addr_comp = true;
             }
@@ -757,8 +686,8 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 
         if (!addr_comp) {
             /* full address is carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_FULL;
-            memcpy(iphc_hdr + inline_pos, &ipv6_hdr->src, 16);
+            res->iphc2 |= IPHC_SAC_SAM_FULL;
+            memcpy(res->inline_addr + inline_pos, &ipv6_hdr->src, 16);
             inline_pos += 16;
         }
     }
@@ -767,7 +696,7 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 
     /* M: Multicast compression */
     if (ipv6_addr_is_multicast(&(ipv6_hdr->dst))) {
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_M;
+        res->iphc2 |= SIXLOWPAN_IPHC2_M;
 
         /* if multicast address is of format ffXX::XXXX:XXXX:XXXX */
         if ((ipv6_hdr->dst.u16[1].u16 == 0) &&
@@ -779,26 +708,26 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
                 (ipv6_hdr->dst.u16[6].u16 == 0) &&
                 (ipv6_hdr->dst.u8[14] == 0)) {
                 /* 8 bits. The address is derived using 8 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_8;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[15];
+                res->iphc2 |= IPHC_M_DAC_DAM_M_8;
+                res->inline_addr[inline_pos++] = ipv6_hdr->dst.u8[15];
                 addr_comp = true;
             }
             /* if multicast address is of format ffXX::XX:XXXX */
             else if ((ipv6_hdr->dst.u16[5].u16 == 0) &&
                      (ipv6_hdr->dst.u8[12] == 0)) {
                 /* 32 bits. The address is derived using 32 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_32;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 13, 3);
+                res->iphc2 |= IPHC_M_DAC_DAM_M_32;
+                res->inline_addr[inline_pos++] = ipv6_hdr->dst.u8[1];
+                memcpy(res->inline_addr + inline_pos, ipv6_hdr->dst.u8 + 13, 3);
                 inline_pos += 3;
                 addr_comp = true;
             }
             /* if multicast address is of format ffXX::XX:XXXX:XXXX */
             else if (ipv6_hdr->dst.u8[10] == 0) {
                 /* 48 bits. The address is derived using 48 bits carried inline */
-                iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_M_48;
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u8 + 11, 5);
+                res->iphc2 |= IPHC_M_DAC_DAM_M_48;
+                res->inline_addr[inline_pos++] = ipv6_hdr->dst.u8[1];
+                memcpy(res->inline_addr + inline_pos, ipv6_hdr->dst.u8 + 11, 5);
                 inline_pos += 5;
                 addr_comp = true;
             }
@@ -819,13 +748,13 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
                 /* Unicast prefix based IPv6 multicast address
                  * (https://tools.ietf.org/html/rfc3306) with given context
                  * for unicast prefix -> context based compression */
-                iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
+                res->iphc2 |= SIXLOWPAN_IPHC2_DAC;
                 if ((ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0) {
-                    iphc_hdr[CID_EXT_IDX] |= (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+                    res->cid_ext |= (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
                 }
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[2];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u16 + 6, 4);
+                res->inline_addr[inline_pos++] = ipv6_hdr->dst.u8[1];
+                res->inline_addr[inline_pos++] = ipv6_hdr->dst.u8[2];
+                memcpy(res->inline_addr + inline_pos, ipv6_hdr->dst.u16 + 6, 4);
                 inline_pos += 4;
                 addr_comp = true;
             }
@@ -837,10 +766,10 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 
         if (dst_ctx != NULL) {
             /* stateful destination address compression */
-            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
+            res->iphc2 |= SIXLOWPAN_IPHC2_DAC;
 
             if (((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) {
-                iphc_hdr[CID_EXT_IDX] |= (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+                res->cid_ext |= (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
             }
         }
 
@@ -850,21 +779,21 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
         if ((ipv6_hdr->dst.u64[1].u64 == iid.uint64.u64) ||
             _context_overlaps_iid(dst_ctx, &(ipv6_hdr->dst), &iid)) {
             /* 0 bits. The address is derived using the link-layer address */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_L2;
+            res->iphc2 |= IPHC_M_DAC_DAM_U_L2;
             addr_comp = true;
         }
         else if ((byteorder_ntohl(ipv6_hdr->dst.u32[2]) == 0x000000ff) &&
                  (byteorder_ntohs(ipv6_hdr->dst.u16[6]) == 0xfe00)) {
             /* 16 bits. The address is derived using 16 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_16;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u16[7]), 2);
+            res->iphc2 |= IPHC_M_DAC_DAM_U_16;
+            memcpy(&(res->inline_addr[inline_pos]), &(ipv6_hdr->dst.u16[7]), 2);
             inline_pos += 2;
             addr_comp = true;
         }
         else {
             /* 64 bits. The address is derived using 64 bits carried inline */
-            iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_64;
-            memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u8[8]), 8);
+            res->iphc2 |= IPHC_M_DAC_DAM_U_64;
+            memcpy(&(res->inline_addr[inline_pos]), &(ipv6_hdr->dst.u8[8]), 8);
             inline_pos += 8;
             addr_comp = true;
         }
@@ -872,11 +801,205 @@ bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
 
     if (!addr_comp) {
         /* full destination address is carried inline */
-        iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_FULL;
-        memcpy(iphc_hdr + inline_pos, &ipv6_hdr->dst, 16);
+        res->iphc2 |= IPHC_SAC_SAM_FULL;
+        memcpy(res->inline_addr + inline_pos, &ipv6_hdr->dst, 16);
         inline_pos += 16;
     }
 
+    res->len = inline_pos;
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+typedef struct {
+    ipv6_addr_t src;
+    ipv6_addr_t dst;
+    unsigned gen;           /* entry is valid if equal to _cache_gen */
+    uint32_t expires;
+    kernel_pid_t iface;
+    uint8_t src_l2addr[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];
+    uint8_t dst_l2addr[GNRC_NETIF_HDR_L2ADDR_MAX_LEN];
+    uint8_t src_l2addr_len;
+    uint8_t dst_l2addr_len;
+    _addr_comp_t comp;
+} _cache_entry_t;
+
+static _cache_entry_t _cache[GNRC_SIXLOWPAN_IPHC_CACHE_SIZE];
+static unsigned _cache_next;    /* next entry to replace */
+/* generation of the cache. Starts at 1 so the zeroed entries are invalid. */
+static volatile unsigned _cache_gen = 1;
+
+static inline bool _cache_match(const _cache_entry_t *entry, gnrc_netif_hdr_t *netif_hdr,
+                                ipv6_hdr_t *ipv6_hdr)
+{
+    return (entry->iface == netif_hdr->if_pid) &&
+           ipv6_addr_equal(&entry->src, &ipv6_hdr->src) &&
+           ipv6_addr_equal(&entry->dst, &ipv6_hdr->dst) &&
+           (entry->src_l2addr_len == netif_hdr->src_l2addr_len) &&
+           (entry->dst_l2addr_len == netif_hdr->dst_l2addr_len) &&
+           (memcmp(entry->src_l2addr, gnrc_netif_hdr_get_src_addr(netif_hdr),
+                   netif_hdr->src_l2addr_len) == 0) &&
+           (memcmp(entry->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                   netif_hdr->dst_l2addr_len) == 0);
+}
+
+/* gets the compressed addresses of ipv6_hdr from the cache, compresses and
+ * caches them on a miss */
+static _addr_comp_t *_cache_get(gnrc_netif_hdr_t *netif_hdr, ipv6_hdr_t *ipv6_hdr)
+{
+    unsigned gen = _cache_gen;
+    uint32_t now = xtimer_now_usec();
+    _cache_entry_t *entry;
+
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_IPHC_CACHE_SIZE; i++) {
+        entry = &_cache[i];
+
+        if ((entry->gen == gen) && ((int32_t)(now - entry->expires) < 0) &&
+            _cache_match(entry, netif_hdr, ipv6_hdr)) {
+            DEBUG("6lo iphc: use cached address compression\n");
+            return &entry->comp;
+        }
+    }
+
+    entry = &_cache[_cache_next];
+    _cache_next = (_cache_next + 1) % GNRC_SIXLOWPAN_IPHC_CACHE_SIZE;
+    entry->gen = 0;
+    _addr_encode(netif_hdr, ipv6_hdr, &entry->comp);
+    if ((netif_hdr->src_l2addr_len <= GNRC_NETIF_HDR_L2ADDR_MAX_LEN) &&
+        (netif_hdr->dst_l2addr_len <= GNRC_NETIF_HDR_L2ADDR_MAX_LEN)) {
+        entry->src = ipv6_hdr->src;
+        entry->dst = ipv6_hdr->dst;
+        entry->expires = now + GNRC_SIXLOWPAN_IPHC_CACHE_TIMEOUT;
+        entry->iface = netif_hdr->if_pid;
+        entry->src_l2addr_len = netif_hdr->src_l2addr_len;
+        entry->dst_l2addr_len = netif_hdr->dst_l2addr_len;
+        memcpy(entry->src_l2addr, gnrc_netif_hdr_get_src_addr(netif_hdr),
+               netif_hdr->src_l2addr_len);
+        memcpy(entry->dst_l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+               netif_hdr->dst_l2addr_len);
+        /* an entry computed while the cache got invalidated is never used */
+        entry->gen = gen;
+    }
+
+    return &entry->comp;
+}
+
+void gnrc_sixlowpan_iphc_cache_invalidate(void)
+{
+    unsigned gen = _cache_gen + 1;
+
+    DEBUG("6lo iphc: invalidate cache\n");
+    /* skip 0, it marks unused entries */
+    _cache_gen = (gen == 0) ? 1 : gen;
+}
+#endif
+
+bool gnrc_sixlowpan_iphc_encode(gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->data;
+    ipv6_hdr_t *ipv6_hdr = pkt->next->data;
+    uint8_t *iphc_hdr;
+    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+    bool nhc_comp = false;
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    _addr_comp_t *comp;
+#else
+    _addr_comp_t comp_buf, *comp = &comp_buf;
+#endif
+    gnrc_pktsnip_t *dispatch = gnrc_pktbuf_add(NULL, NULL, pkt->next->size,
+                                               GNRC_NETTYPE_SIXLOWPAN);
+
+    if (dispatch == NULL) {
+        DEBUG("6lo iphc: error allocating dispatch space\n");
+        return false;
+    }
+
+    iphc_hdr = dispatch->data;
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_CACHE
+    comp = _cache_get(netif_hdr, ipv6_hdr);
+#else
+    _addr_encode(netif_hdr, ipv6_hdr, comp);
+#endif
+
+    /* set initial dispatch value*/
+    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
+    iphc_hdr[IPHC2_IDX] = comp->iphc2;
+
+    if (comp->iphc2 & SIXLOWPAN_IPHC2_CID_EXT) {
+        iphc_hdr[CID_EXT_IDX] = comp->cid_ext;
+        /* move position to behind CID extension */
+        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
+    }
+
+    /* compress flow label and traffic class */
+    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
+        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
+            /* elide both traffic class and flow label */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
+        }
+        else {
+            /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
+            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
+        }
+    }
+    else {
+        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
+            /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
+            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
+                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
+        }
+        else {
+            /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
+            iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
+            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
+            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
+        }
+
+        /* copy remaining byteos of flow label */
+        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
+        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff) >> 8);
+    }
+
+    /* compress next header */
+    switch (ipv6_hdr->nh) {
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_NHC
+        case PROTNUM_UDP:
+            iphc_nhc_udp_encode(pkt->next->next, ipv6_hdr);
+            iphc_hdr[IPHC1_IDX] |= SIXLOWPAN_IPHC1_NH;
+            nhc_comp = true;
+            break;
+#endif
+
+        default:
+            iphc_hdr[inline_pos++] = ipv6_hdr->nh;
+            break;
+    }
+
+    /* compress hop limit */
+    switch (ipv6_hdr->hl) {
+        case 1:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_1;
+            break;
+
+        case 64:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_64;
+            break;
+
+        case 255:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_255;
+            break;
+
+        default:
+            iphc_hdr[IPHC1_IDX] |= IPHC_HL_INLINE;
+            iphc_hdr[inline_pos++] = ipv6_hdr->hl;
+            break;
+    }
+
+    memcpy(iphc_hdr + inline_pos, comp->inline_addr, comp->len);
+    inline_pos += comp->len;
+
     if (nhc_comp) {
         iphc_hdr[inline_pos++] = ipv6_hdr->nh;
     }
@@ -353,12 +353,9 @@ uint8_t gnrc_sixlowpan_nd_opt_ar_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6,
                     }
                     nc_entry->eui64 = ar_opt->eui64;
                 }
-                nc_entry->flags &= ~GNRC_IPV6_NC_TYPE_MASK;
-                nc_entry->flags |= GNRC_IPV6_NC_TYPE_REGISTERED;
                 reg_ltime = byteorder_ntohs(ar_opt->ltime);
                 /* TODO: notify routing protocol */
-                xtimer_set_msg(&nc_entry->type_timeout, (reg_ltime * 60 * SEC_IN_USEC),
-                               &nc_entry->type_timeout_msg, gnrc_ipv6_pid);
+                gnrc_sixlowpan_nd_router_reg_set(nc_entry, reg_ltime);
             }
             break;
 #endif
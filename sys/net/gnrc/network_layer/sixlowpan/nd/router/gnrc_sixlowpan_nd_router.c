@@ -19,12 +19,21 @@
 #include "net/icmpv6.h"
 #include "net/ndp.h"
 #include "net/sixlowpan/nd.h"
+#include "xtimer.h"
 
 #include "net/gnrc/sixlowpan/nd/router.h"
 
 static gnrc_sixlowpan_nd_router_abr_t _abrs[GNRC_SIXLOWPAN_ND_ROUTER_ABR_NUMOF];
 static gnrc_sixlowpan_nd_router_prf_t _prefixes[GNRC_SIXLOWPAN_ND_ROUTER_ABR_PRF_NUMOF];
 
+/* registrations by slot of their gnrc_ipv6_nc_t::reg_expiry */
+static gnrc_ipv6_nc_t *_reg_wheel[GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL_SIZE];
+/* minutes since the first registration, starts at 1 as 0 means unregistered */
+static uint32_t _reg_now = 1;
+static unsigned _reg_numof;
+static xtimer_t _reg_timer;
+static msg_t _reg_msg = { .type = GNRC_SIXLOWPAN_ND_MSG_REG_TICK };
+
 static gnrc_sixlowpan_nd_router_abr_t *_get_abr(ipv6_addr_t *addr)
 {
     gnrc_sixlowpan_nd_router_abr_t *abr = NULL;
@@ -110,6 +119,71 @@ static inline bool _is_me(ipv6_addr_t *addr)
 #define _is_me(ignore)  (false)
 #endif
 
+static inline gnrc_ipv6_nc_t **_reg_slot(uint32_t expiry)
+{
+    return &_reg_wheel[expiry & (GNRC_SIXLOWPAN_ND_ROUTER_REG_WHEEL_SIZE - 1)];
+}
+
+void gnrc_sixlowpan_nd_router_reg_set(gnrc_ipv6_nc_t *nc_entry, uint16_t ltime)
+{
+    assert(ltime != 0);
+    gnrc_sixlowpan_nd_router_reg_remove(nc_entry);
+    /* the tentative lifetime ends with the registration */
+    xtimer_remove(&nc_entry->type_timeout);
+    nc_entry->flags &= ~GNRC_IPV6_NC_TYPE_MASK;
+    nc_entry->flags |= GNRC_IPV6_NC_TYPE_REGISTERED;
+    /* the current minute already started, so expire at its end at earliest */
+    nc_entry->reg_expiry = _reg_now + ltime + 1;
+    nc_entry->reg_next = *_reg_slot(nc_entry->reg_expiry);
+    *_reg_slot(nc_entry->reg_expiry) = nc_entry;
+    if (_reg_numof++ == 0) {
+        xtimer_set_msg(&_reg_timer, 60 * SEC_IN_USEC, &_reg_msg, gnrc_ipv6_pid);
+    }
+}
+
+void gnrc_sixlowpan_nd_router_reg_remove(gnrc_ipv6_nc_t *nc_entry)
+{
+    if (nc_entry->reg_expiry == 0) {
+        return;
+    }
+    for (gnrc_ipv6_nc_t **ptr = _reg_slot(nc_entry->reg_expiry); *ptr != NULL;
+         ptr = &(*ptr)->reg_next) {
+        if (*ptr == nc_entry) {
+            *ptr = nc_entry->reg_next;
+            break;
+        }
+    }
+    nc_entry->reg_expiry = 0;
+    nc_entry->reg_next = NULL;
+    if (--_reg_numof == 0) {
+        xtimer_remove(&_reg_timer);
+    }
+}
+
+void gnrc_sixlowpan_nd_router_reg_tick(void)
+{
+    gnrc_ipv6_nc_t **ptr = _reg_slot(++_reg_now);
+
+    while (*ptr != NULL) {
+        gnrc_ipv6_nc_t *nc_entry = *ptr;
+
+        if (nc_entry->reg_expiry > _reg_now) {
+            /* expires in a later round of the wheel */
+            ptr = &nc_entry->reg_next;
+            continue;
+        }
+        *ptr = nc_entry->reg_next;
+        nc_entry->reg_expiry = 0;
+        nc_entry->reg_next = NULL;
+        _reg_numof--;
+        /* reg_expiry is already 0, so this does not unlink again */
+        gnrc_sixlowpan_nd_router_gc_nc(nc_entry);
+    }
+    if (_reg_numof > 0) {
+        xtimer_set_msg(&_reg_timer, 60 * SEC_IN_USEC, &_reg_msg, gnrc_ipv6_pid);
+    }
+}
+
 void gnrc_sixlowpan_nd_router_set_rtr_adv(gnrc_ipv6_netif_t *netif, bool enable)
 {
     if (enable && (gnrc_ipv6_netif_add_addr(netif->pid, &ipv6_addr_all_routers_link_local, 128,
@@ -166,12 +240,11 @@ bool gnrc_sixlowpan_nd_router_abr_older(sixlowpan_nd_opt_abr_t *abr_opt)
 
 void gnrc_sixlowpan_nd_router_abr_remove(gnrc_sixlowpan_nd_router_abr_t *abr)
 {
-    for (int i = 0; i < GNRC_SIXLOWPAN_CTX_SIZE; i++) {
-        if (bf_isset(abr->ctxs, i)) {
-            gnrc_sixlowpan_ctx_remove(i);
-            bf_unset(abr->ctxs, i);
-        }
+    for (int i = bf_find_first_set(abr->ctxs, GNRC_SIXLOWPAN_CTX_SIZE); i >= 0;
+         i = bf_find_next_set(abr->ctxs, GNRC_SIXLOWPAN_CTX_SIZE, i + 1)) {
+        gnrc_sixlowpan_ctx_remove(i);
     }
+    bf_unset_range(abr->ctxs, 0, GNRC_SIXLOWPAN_CTX_SIZE);
 
     while (abr->prfs != NULL) {
         gnrc_sixlowpan_nd_router_prf_t *prefix = abr->prfs;
@@ -17,16 +17,21 @@
 
 #include "net/gnrc/pkt.h"
 
-gnrc_pktsnip_t *gnrc_pktsnip_search_type(gnrc_pktsnip_t *ptr,
-                                         gnrc_nettype_t type)
+size_t gnrc_pkt_fill_iovec(const gnrc_pktsnip_t *pkt, struct iovec *vec,
+                           size_t max)
 {
-    while (ptr != NULL) {
-        if (ptr->type == type) {
-            return ptr;
+    size_t count = 0;
+
+    while (pkt != NULL) {
+        if (count == max) {
+            return 0;
         }
-        ptr = ptr->next;
+        vec[count].iov_base = pkt->data;
+        vec[count].iov_len = pkt->size;
+        count++;
+        pkt = pkt->next;
     }
-    return NULL;
+    return count;
 }
 
 /** @} */
@@ -0,0 +1,631 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer implementation based on fixed size classes
+ *
+ * Every size class is an array of equally sized blocks with a free list
+ * threaded through the unused blocks. A data pointer anywhere inside a block
+ * identifies its block, so snips whose data was shrunk from the front (see
+ * @ref gnrc_pktbuf_mark()) still release the whole block.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "mutex.h"
+#include "utlist.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _ALIGNMENT_MASK     (sizeof(void *) - 1)
+#define _ALIGN(size)        (((size) + _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK))
+#define _SNIP_SIZE          _ALIGN(sizeof(gnrc_pktsnip_t))
+
+typedef struct _free_block {
+    struct _free_block *next;
+} _free_block_t;
+
+typedef struct {
+    uint8_t *base;          /**< first block of the class */
+    _free_block_t *free;    /**< list of unused blocks */
+    uint16_t size;          /**< size of one block */
+    uint16_t numof;         /**< number of blocks */
+    uint16_t used;          /**< number of blocks in use */
+    uint16_t max_used;      /**< high-water mark of used */
+} _slab_class_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+
+static uint8_t _snip_blocks[_SNIP_SIZE * GNRC_PKTBUF_SLAB_SNIP_NUMOF]
+    __attribute__((aligned(sizeof(void *))));
+static uint8_t _small_blocks[GNRC_PKTBUF_SLAB_SMALL_SIZE *
+                             GNRC_PKTBUF_SLAB_SMALL_NUMOF]
+    __attribute__((aligned(sizeof(void *))));
+static uint8_t _medium_blocks[GNRC_PKTBUF_SLAB_MEDIUM_SIZE *
+                              GNRC_PKTBUF_SLAB_MEDIUM_NUMOF]
+    __attribute__((aligned(sizeof(void *))));
+static uint8_t _large_blocks[GNRC_PKTBUF_SLAB_LARGE_SIZE *
+                             GNRC_PKTBUF_SLAB_LARGE_NUMOF]
+    __attribute__((aligned(sizeof(void *))));
+
+/* ordered by ascending block size */
+static _slab_class_t _classes[] = {
+    { .base = _snip_blocks, .size = _SNIP_SIZE,
+      .numof = GNRC_PKTBUF_SLAB_SNIP_NUMOF },
+    { .base = _small_blocks, .size = GNRC_PKTBUF_SLAB_SMALL_SIZE,
+      .numof = GNRC_PKTBUF_SLAB_SMALL_NUMOF },
+    { .base = _medium_blocks, .size = GNRC_PKTBUF_SLAB_MEDIUM_SIZE,
+      .numof = GNRC_PKTBUF_SLAB_MEDIUM_NUMOF },
+    { .base = _large_blocks, .size = GNRC_PKTBUF_SLAB_LARGE_SIZE,
+      .numof = GNRC_PKTBUF_SLAB_LARGE_NUMOF },
+};
+
+#define _CLASSES_NUMOF      (sizeof(_classes) / sizeof(_classes[0]))
+#define _MAX_BLOCK_SIZE     (GNRC_PKTBUF_SLAB_LARGE_SIZE)
+
+#ifdef DEVELHELP
+/* number of allocations that could not be served */
+static uint16_t _alloc_fails = 0;
+#endif
+
+#ifdef MODULE_NETSTATS_PKTBUF
+static netstats_pktbuf_t _stats;
+#endif
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(size_t size);
+static void _pktbuf_free(void *data);
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+    pkt->loan = NULL;
+#endif
+#ifdef MODULE_GNRC_PKTTRACE
+    pkt->trace = 0;
+#endif
+}
+
+/* frees the data of pkt or hands it back to its lender */
+static inline void _free_data(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+    if (pkt->loan != NULL) {
+        pkt->loan->release(pkt->loan, pkt->data);
+        pkt->loan = NULL;
+        return;
+    }
+#endif
+    _pktbuf_free(pkt->data);
+}
+
+/* returns the class containing ptr and the start of its block, or NULL */
+static _slab_class_t *_find_block(void *ptr, uint8_t **block)
+{
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _slab_class_t *cls = &_classes[i];
+        size_t offset = (uint8_t *)ptr - cls->base;
+
+        if (((uint8_t *)ptr >= cls->base) &&
+            (offset < ((size_t)cls->size * cls->numof))) {
+            if (block != NULL) {
+                *block = cls->base + (offset - (offset % cls->size));
+            }
+            return cls;
+        }
+    }
+    return NULL;
+}
+
+static inline bool _pktbuf_contains(void *ptr)
+{
+    return _find_block(ptr, NULL) != NULL;
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _slab_class_t *cls = &_classes[i];
+
+        cls->free = NULL;
+        /* thread free list in reverse, so that blocks are handed out from the
+         * start of the class */
+        for (unsigned j = cls->numof; j > 0; j--) {
+            _free_block_t *block = (_free_block_t *)(cls->base +
+                                                     ((j - 1) * cls->size));
+            block->next = cls->free;
+            cls->free = block;
+        }
+        cls->used = 0;
+        cls->max_used = 0;
+    }
+#ifdef MODULE_NETSTATS_PKTBUF
+    _stats.used = 0;
+#endif
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > _MAX_BLOCK_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SLAB_LARGE_SIZE (%u)\n",
+              (unsigned)size, (unsigned)_MAX_BLOCK_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+gnrc_pktsnip_t *gnrc_pktbuf_add_loaned(gnrc_pktsnip_t *next, void *data,
+                                       size_t size, gnrc_nettype_t type,
+                                       gnrc_pkt_loan_t *loan)
+{
+    gnrc_pktsnip_t *pkt;
+
+    assert((data != NULL) && (size > 0) && (loan != NULL));
+    mutex_lock(&_mutex);
+    pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(pkt, next, data, size, type);
+    pkt->loan = loan;
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+#endif
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data_marked;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->size != size) {
+        /* a block is released as a whole, so the marked data gets its own
+         * block while the rest stays where it is */
+        new_data_marked = _pktbuf_alloc(size);
+        if (new_data_marked == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            _pktbuf_free(marked_snip);
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        memcpy(new_data_marked, pkt->data, size);
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else {
+        new_data_marked = pkt->data;
+        pkt->data = NULL;
+    }
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+    if (pkt->data == NULL) {
+        /* lent memory moved to marked snip as a whole */
+        marked_snip->loan = pkt->loan;
+        pkt->loan = NULL;
+    }
+#endif
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    uint8_t *block = NULL;
+    _slab_class_t *cls = NULL;
+
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) &&
+            ((pkt->loan != NULL) || _pktbuf_contains(pkt->data))));
+#else
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
+#endif
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    if (pkt->data != NULL) {
+        cls = _find_block(pkt->data, &block);
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _free_data(pkt);
+        pkt->data = NULL;
+    }
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+    else if ((pkt->loan != NULL) && (size < pkt->size)) {
+        /* lent memory is returned as a whole, just cut it */
+    }
+#endif
+    /* new size does not fit into the current block */
+    else if ((cls == NULL) ||
+             ((((uint8_t *)pkt->data) - block) + size > cls->size)) {
+        void *new_data = _pktbuf_alloc(size);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {            /* if old data exist */
+            memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+        }
+        _free_data(pkt);
+        pkt->data = new_data;
+    }
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_pktbuf_contains(pkt));
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _free_data(pkt);
+            _pktbuf_free(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if ((pkt == NULL) || (pkt->size == 0)) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_get_iovec(gnrc_pktsnip_t *pkt, size_t *len)
+{
+    size_t length;
+    gnrc_pktsnip_t *head;
+    struct iovec *vec;
+
+    assert(len != NULL);
+    if (pkt == NULL) {
+        *len = 0;
+        return NULL;
+    }
+
+    /* count the number of snips in the packet and allocate the IOVEC */
+    length = gnrc_pkt_count(pkt);
+    head = gnrc_pktbuf_add(pkt, NULL, (length * sizeof(struct iovec)),
+                           GNRC_NETTYPE_IOVEC);
+    if (head == NULL) {
+        *len = 0;
+        return NULL;
+    }
+
+    assert(head->data != NULL);
+    vec = (struct iovec *)(head->data);
+    /* fill the IOVEC */
+    while (pkt != NULL) {
+        vec->iov_base = pkt->data;
+        vec->iov_len = pkt->size;
+        ++vec;
+        pkt = pkt->next;
+    }
+    *len = length;
+    return head;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    printf("packet buffer: %u size classes, %u failed allocations\n",
+           (unsigned)_CLASSES_NUMOF, _alloc_fails);
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _slab_class_t *cls = &_classes[i];
+
+        printf("  class %u: %4u byte blocks, used: %2u/%2u, max. used: %2u\n",
+               i, cls->size, cls->used, cls->numof, cls->max_used);
+    }
+}
+#endif
+
+#ifdef MODULE_NETSTATS_PKTBUF
+netstats_pktbuf_t *gnrc_pktbuf_get_stats(void)
+{
+    return &_stats;
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        if (_classes[i].used != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - forall blocks in a class' free list: the block lies within the class
+     *    and at a block boundary
+     *  - forall classes: length of free list == numof - used
+     */
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _slab_class_t *cls = &_classes[i];
+        unsigned free_numof = 0;
+
+        for (_free_block_t *ptr = cls->free; ptr; ptr = ptr->next) {
+            uint8_t *block;
+
+            if ((_find_block(ptr, &block) != cls) || (block != (uint8_t *)ptr) ||
+                (free_numof >= cls->numof)) {
+                return false;
+            }
+            free_numof++;
+        }
+        if ((free_numof + cls->used) != cls->numof) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _pktbuf_free(pkt);
+            return NULL;
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    if (data != NULL) {
+        memcpy(_data, data, size);
+    }
+    return pkt;
+}
+
+static void *_pktbuf_alloc(size_t size)
+{
+    for (unsigned i = 0; i < _CLASSES_NUMOF; i++) {
+        _slab_class_t *cls = &_classes[i];
+
+        if ((size <= cls->size) && (cls->free != NULL)) {
+            _free_block_t *block = cls->free;
+
+            cls->free = block->next;
+            if (++cls->used > cls->max_used) {
+                cls->max_used = cls->used;
+            }
+#ifdef MODULE_NETSTATS_PKTBUF
+            _stats.alloc_count++;
+            _stats.used += cls->size;
+            if (_stats.used > _stats.max_used) {
+                _stats.max_used = _stats.used;
+            }
+#endif
+            return block;
+        }
+    }
+    DEBUG("pktbuf: no block left for %u byte\n", (unsigned)size);
+#ifdef DEVELHELP
+    _alloc_fails++;
+#endif
+#ifdef MODULE_NETSTATS_PKTBUF
+    _stats.alloc_failed++;
+#endif
+    return NULL;
+}
+
+static void _pktbuf_free(void *data)
+{
+    uint8_t *block;
+    _slab_class_t *cls = _find_block(data, &block);
+
+    if (cls == NULL) {
+        return;
+    }
+    ((_free_block_t *)block)->next = cls->free;
+    cls->free = (_free_block_t *)block;
+    cls->used--;
+#ifdef MODULE_NETSTATS_PKTBUF
+    _stats.used -= cls->size;
+#endif
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_remove_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *snip)
+{
+    LL_DELETE(pkt, snip);
+    snip->next = NULL;
+    gnrc_pktbuf_release(snip);
+
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_replace_snip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *old, gnrc_pktsnip_t *add)
+{
+    /* If add is a list we need to preserve its tail */
+    if (add->next != NULL) {
+        gnrc_pktsnip_t *tail = add->next;
+        gnrc_pktsnip_t *back;
+        LL_SEARCH_SCALAR(tail, back, next, NULL); /* find the last snip in add */
+        /* Replace old */
+        LL_REPLACE_ELEM(pkt, old, add);
+        /* and wire in the tail between */
+        back->next = add->next;
+        add->next = tail;
+    }
+    else {
+        /* add is a single element, has no tail, simply replace */
+        LL_REPLACE_ELEM(pkt, old, add);
+    }
+    old->next = NULL;
+    gnrc_pktbuf_release(old);
+
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t type)
+{
+    mutex_lock(&_mutex);
+
+    bool is_shared = pkt->users > 1;
+    size_t size = gnrc_pkt_len_upto(pkt, type);
+
+    DEBUG("ipv6_ext: duplicating %d octets\n", (int) size);
+
+    gnrc_pktsnip_t *tmp;
+    gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
+    gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+
+    if (new == NULL) {
+        mutex_unlock(&_mutex);
+
+        return NULL;
+    }
+
+    /* copy payloads */
+    for (tmp = pkt; tmp != NULL; tmp = tmp->next) {
+        uint8_t *dest = ((uint8_t *)new->data) + (size - tmp->size);
+
+        memcpy(dest, tmp->data, tmp->size);
+
+        size -= tmp->size;
+
+        if (tmp->type == type) {
+            break;
+        }
+    }
+
+    /* decrements reference counters */
+
+    if (target != NULL) {
+        target->next = NULL;
+    }
+
+    _release_error_locked(pkt, GNRC_NETERR_SUCCESS);
+
+    if (is_shared && (target != NULL)) {
+        target->next = next;
+    }
+
+    mutex_unlock(&_mutex);
+
+    return new;
+}
+
+/** @} */
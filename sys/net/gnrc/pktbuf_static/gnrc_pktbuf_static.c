@@ -50,11 +50,31 @@ static _unused_t *_first_unused;
 static uint16_t max_byte_count = 0;
 #endif
 
+#ifdef MODULE_NETSTATS_PKTBUF
+static netstats_pktbuf_t _stats;
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+static const uint32_t _quota_cap[GNRC_PKTBUF_QUOTA_NUMOF] = {
+    GNRC_PKTBUF_DATA_CAP,
+    GNRC_PKTBUF_SIZE,
+    GNRC_PKTBUF_RX_CAP,
+    GNRC_PKTBUF_REASSEMBLY_CAP,
+};
+static gnrc_pktbuf_quota_stats_t _quota_stats[GNRC_PKTBUF_QUOTA_NUMOF];
+/* bytes allocated in all classes */
+static uint32_t _quota_used;
+
+#define _QUOTA(pkt)     ((pkt)->quota)
+#else
+#define _QUOTA(pkt)     (GNRC_PKTBUF_QUOTA_DATA)
+#endif
+
 /* internal gnrc_pktbuf functions */
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
-                                    gnrc_nettype_t type);
-static void *_pktbuf_alloc(size_t size);
-static void _pktbuf_free(void *data, size_t size);
+                                    gnrc_nettype_t type, unsigned quota);
+static void *_pktbuf_alloc(size_t size, unsigned quota);
+static void _pktbuf_free(void *data, size_t size, unsigned quota);
 
 static inline bool _pktbuf_contains(void *ptr)
 {
@@ -68,16 +88,75 @@ static inline size_t _align(size_t size)
 }
 
 static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
-                                void *data, size_t size, gnrc_nettype_t type)
+                                void *data, size_t size, gnrc_nettype_t type,
+                                unsigned quota)
 {
     pkt->next = next;
     pkt->data = data;
     pkt->size = size;
     pkt->type = type;
     pkt->users = 1;
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+    pkt->quota = quota;
+#else
+    (void)quota;
+#endif
 #ifdef MODULE_GNRC_NETERR
     pkt->err_sub = KERNEL_PID_UNDEF;
 #endif
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+    pkt->loan = NULL;
+#endif
+#ifdef MODULE_GNRC_PKTTRACE
+    pkt->trace = 0;
+#endif
+}
+
+/* frees the data of pkt or hands it back to its lender */
+static inline void _free_data(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+    if (pkt->loan != NULL) {
+        pkt->loan->release(pkt->loan, pkt->data);
+        pkt->loan = NULL;
+        return;
+    }
+#endif
+    _pktbuf_free(pkt->data, pkt->size, _QUOTA(pkt));
+}
+
+/* headers count with their payload */
+static inline unsigned _quota_of(gnrc_pktsnip_t *next, gnrc_nettype_t type)
+{
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+    if ((next != NULL) && _pktbuf_contains(next)) {
+        return next->quota;
+    }
+#ifdef MODULE_GNRC_ICMPV6
+    if (type == GNRC_NETTYPE_ICMPV6) {
+        return GNRC_PKTBUF_QUOTA_CONTROL;
+    }
+#endif
+#endif
+    (void)next;
+    (void)type;
+    return GNRC_PKTBUF_QUOTA_DATA;
+}
+
+static gnrc_pktsnip_t *_add(gnrc_pktsnip_t *next, void *data, size_t size,
+                            gnrc_nettype_t type, unsigned quota)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > GNRC_PKTBUF_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SIZE (%u)\n",
+              (unsigned)size, GNRC_PKTBUF_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type, quota);
+    mutex_unlock(&_mutex);
+    return pkt;
 }
 
 void gnrc_pktbuf_init(void)
@@ -86,24 +165,60 @@ void gnrc_pktbuf_init(void)
     _first_unused = (_unused_t *)_pktbuf;
     _first_unused->next = NULL;
     _first_unused->size = sizeof(_pktbuf);
+#ifdef MODULE_NETSTATS_PKTBUF
+    _stats.used = 0;
+#endif
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+    memset(_quota_stats, 0, sizeof(_quota_stats));
+    _quota_used = 0;
+#endif
     mutex_unlock(&_mutex);
 }
 
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, void *data, size_t size,
                                 gnrc_nettype_t type)
+{
+    return _add(next, data, size, type, _quota_of(next, type));
+}
+
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+gnrc_pktsnip_t *gnrc_pktbuf_add_quota(gnrc_pktsnip_t *next, void *data,
+                                      size_t size, gnrc_nettype_t type,
+                                      gnrc_pktbuf_quota_t quota)
+{
+    assert(quota < GNRC_PKTBUF_QUOTA_NUMOF);
+    return _add(next, data, size, type, quota);
+}
+
+gnrc_pktbuf_quota_stats_t *gnrc_pktbuf_get_quota_stats(gnrc_pktbuf_quota_t quota)
+{
+    assert(quota < GNRC_PKTBUF_QUOTA_NUMOF);
+    return &_quota_stats[quota];
+}
+#endif
+
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+gnrc_pktsnip_t *gnrc_pktbuf_add_loaned(gnrc_pktsnip_t *next, void *data,
+                                       size_t size, gnrc_nettype_t type,
+                                       gnrc_pkt_loan_t *loan)
 {
     gnrc_pktsnip_t *pkt;
 
-    if (size > GNRC_PKTBUF_SIZE) {
-        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SIZE (%u)\n",
-              (unsigned)size, GNRC_PKTBUF_SIZE);
+    assert((data != NULL) && (size > 0) && (loan != NULL));
+    mutex_lock(&_mutex);
+    /* only the link layer lends frames */
+    pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t), GNRC_PKTBUF_QUOTA_RX);
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        mutex_unlock(&_mutex);
         return NULL;
     }
-    mutex_lock(&_mutex);
-    pkt = _create_snip(next, data, size, type);
+    _set_pktsnip(pkt, next, data, size, type, GNRC_PKTBUF_QUOTA_RX);
+    pkt->loan = loan;
     mutex_unlock(&_mutex);
     return pkt;
 }
+#endif
 
 gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
 {
@@ -123,35 +238,62 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         return NULL;
     }
     /* create new snip descriptor for marked data */
-    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t), _QUOTA(pkt));
     if (marked_snip == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
         mutex_unlock(&_mutex);
         return NULL;
     }
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+    if (pkt->loan != NULL) {
+        if (pkt->size == size) {
+            /* lent memory moves to marked snip as a whole */
+            _set_pktsnip(marked_snip, pkt->next, pkt->data, size, type,
+                         _QUOTA(pkt));
+            marked_snip->loan = pkt->loan;
+            pkt->loan = NULL;
+            pkt->data = NULL;
+            pkt->size = 0;
+            pkt->next = marked_snip;
+            mutex_unlock(&_mutex);
+            return marked_snip;
+        }
+        /* the rest keeps the loan, so copy the marked data */
+        new_data_marked = _pktbuf_alloc(size, _QUOTA(pkt));
+        if (new_data_marked == NULL) {
+            DEBUG("pktbuf: could not reallocate marked section.\n");
+            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t), _QUOTA(pkt));
+            mutex_unlock(&_mutex);
+            return NULL;
+        }
+        memcpy(new_data_marked, pkt->data, size);
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    else
+#endif
     /* marked data would not fit _unused_t marker => move data around to allow
      * for proper free */
     if ((pkt->size != size) &&
         ((size < required_new_size) || ((pkt->size - size) < sizeof(_unused_t)))) {
         void *new_data_rest;
-        new_data_marked = _pktbuf_alloc(size);
+        new_data_marked = _pktbuf_alloc(size, _QUOTA(pkt));
         if (new_data_marked == NULL) {
             DEBUG("pktbuf: could not reallocate marked section.\n");
-            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
+            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t), _QUOTA(pkt));
             mutex_unlock(&_mutex);
             return NULL;
         }
-        new_data_rest = _pktbuf_alloc(pkt->size - size);
+        new_data_rest = _pktbuf_alloc(pkt->size - size, _QUOTA(pkt));
         if (new_data_rest == NULL) {
             DEBUG("pktbuf: could not reallocate remaining section.\n");
-            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t));
-            _pktbuf_free(new_data_marked, size);
+            _pktbuf_free(marked_snip, sizeof(gnrc_pktsnip_t), _QUOTA(pkt));
+            _pktbuf_free(new_data_marked, size, _QUOTA(pkt));
             mutex_unlock(&_mutex);
             return NULL;
         }
         memcpy(new_data_marked, pkt->data, size);
         memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
-        _pktbuf_free(pkt->data, pkt->size);
+        _pktbuf_free(pkt->data, pkt->size, _QUOTA(pkt));
         marked_snip->data = new_data_marked;
         pkt->data = new_data_rest;
     }
@@ -162,7 +304,8 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
                                           NULL;
     }
     pkt->size -= size;
-    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type,
+                 _QUOTA(pkt));
     pkt->next = marked_snip;
     mutex_unlock(&_mutex);
     return marked_snip;
@@ -175,8 +318,14 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
 
     mutex_lock(&_mutex);
     assert(pkt != NULL);
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) &&
+            ((pkt->loan != NULL) || _pktbuf_contains(pkt->data))));
+#else
     assert(((pkt->size == 0) && (pkt->data == NULL)) ||
            ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
+#endif
     /* new size and old size are equal */
     if (size == pkt->size) {
         /* nothing to do */
@@ -186,13 +335,18 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     /* new size is 0 and data pointer isn't already NULL */
     if ((size == 0) && (pkt->data != NULL)) {
         /* set data pointer to NULL */
-        _pktbuf_free(pkt->data, pkt->size);
+        _free_data(pkt);
         pkt->data = NULL;
     }
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+    else if ((pkt->loan != NULL) && (size < pkt->size)) {
+        /* lent memory is returned as a whole, just cut it */
+    }
+#endif
     /* if new size is bigger than old size */
     else if ((size > pkt->size) ||                          /* new size does not fit */
         ((pkt->size - aligned_size) < sizeof(_unused_t))) { /* resulting hole would not fit marker */
-        void *new_data = _pktbuf_alloc(size);
+        void *new_data = _pktbuf_alloc(size, _QUOTA(pkt));
         if (new_data == NULL) {
             DEBUG("pktbuf: error allocating new data section\n");
             mutex_unlock(&_mutex);
@@ -201,12 +355,12 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         if (pkt->data != NULL) {            /* if old data exist */
             memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
         }
-        _pktbuf_free(pkt->data, pkt->size);
+        _free_data(pkt);
         pkt->data = new_data;
     }
     else if (_align(pkt->size) > aligned_size) {
         _pktbuf_free(((uint8_t *)pkt->data) + aligned_size,
-                     pkt->size - aligned_size);
+                     pkt->size - aligned_size, _QUOTA(pkt));
     }
     pkt->size = size;
     mutex_unlock(&_mutex);
@@ -231,8 +385,8 @@ static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
         tmp = pkt->next;
         if (pkt->users == 1) {
             pkt->users = 0; /* not necessary but to be on the safe side */
-            _pktbuf_free(pkt->data, pkt->size);
-            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+            _free_data(pkt);
+            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t), _QUOTA(pkt));
         }
         else {
             pkt->users--;
@@ -259,7 +413,8 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
     }
     if (pkt->users > 1) {
         gnrc_pktsnip_t *new;
-        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type,
+                           _QUOTA(pkt));
         if (new != NULL) {
             pkt->users--;
         }
@@ -363,6 +518,13 @@ void gnrc_pktbuf_stats(void)
 }
 #endif
 
+#ifdef MODULE_NETSTATS_PKTBUF
+netstats_pktbuf_t *gnrc_pktbuf_get_stats(void)
+{
+    return &_stats;
+}
+#endif
+
 #ifdef TEST_SUITES
 bool gnrc_pktbuf_is_empty(void)
 {
@@ -403,9 +565,9 @@ bool gnrc_pktbuf_is_sane(void)
 #endif
 
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t size,
-                                    gnrc_nettype_t type)
+                                    gnrc_nettype_t type, unsigned quota)
 {
-    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t), quota);
     void *_data = NULL;
 
     if (pkt == NULL) {
@@ -413,31 +575,49 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, void *data, size_t siz
         return NULL;
     }
     if (size > 0) {
-        _data = _pktbuf_alloc(size);
+        _data = _pktbuf_alloc(size, quota);
         if (_data == NULL) {
             DEBUG("pktbuf: error allocating data for new packet snip\n");
-            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t), quota);
             return NULL;
         }
     }
-    _set_pktsnip(pkt, next, _data, size, type);
+    _set_pktsnip(pkt, next, _data, size, type, quota);
     if (data != NULL) {
         memcpy(_data, data, size);
     }
     return pkt;
 }
 
-static void *_pktbuf_alloc(size_t size)
+static void *_pktbuf_alloc(size_t size, unsigned quota)
 {
     _unused_t *prev = NULL, *ptr = _first_unused;
 
     size = (size < sizeof(_unused_t)) ? _align(sizeof(_unused_t)) : _align(size);
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+    /* only control traffic may dip into the reserve */
+    if (((_quota_stats[quota].used + size) > _quota_cap[quota]) ||
+        ((quota != GNRC_PKTBUF_QUOTA_CONTROL) &&
+         ((_quota_used + size) > (GNRC_PKTBUF_SIZE - GNRC_PKTBUF_CONTROL_RESERVE)))) {
+        DEBUG("pktbuf: no space left for quota class %u\n", quota);
+        ptr = NULL;
+    }
+    else
+#else
+    (void)quota;
+#endif
     while (ptr && (size > ptr->size)) {
         prev = ptr;
         ptr = ptr->next;
     }
     if (ptr == NULL) {
         DEBUG("pktbuf: no space left in packet buffer\n");
+#ifdef MODULE_NETSTATS_PKTBUF
+        _stats.alloc_failed++;
+#endif
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+        _quota_stats[quota].alloc_failed++;
+#endif
         return NULL;
     }
     /* _unused_t struct would fit => add new space at ptr */
@@ -470,6 +650,20 @@ static void *_pktbuf_alloc(size_t size)
     if (last_byte > max_byte_count) {
         max_byte_count = last_byte;
     }
+#endif
+#ifdef MODULE_NETSTATS_PKTBUF
+    _stats.alloc_count++;
+    _stats.used += size;
+    if (_stats.used > _stats.max_used) {
+        _stats.max_used = _stats.used;
+    }
+#endif
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+    _quota_used += size;
+    _quota_stats[quota].used += size;
+    if (_quota_stats[quota].used > _quota_stats[quota].max_used) {
+        _quota_stats[quota].max_used = _quota_stats[quota].used;
+    }
 #endif
     return (void *)ptr;
 }
@@ -488,7 +682,7 @@ static inline _unused_t *_merge(_unused_t *a, _unused_t *b)
     return a;
 }
 
-static void _pktbuf_free(void *data, size_t size)
+static void _pktbuf_free(void *data, size_t size, unsigned quota)
 {
     size_t bytes_at_end;
     _unused_t *new = (_unused_t *)data, *prev = NULL, *ptr = _first_unused;
@@ -502,6 +696,15 @@ static void _pktbuf_free(void *data, size_t size)
     }
     new->next = ptr;
     new->size = (size < sizeof(_unused_t)) ? _align(sizeof(_unused_t)) : _align(size);
+#ifdef MODULE_NETSTATS_PKTBUF
+    _stats.used -= new->size;
+#endif
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+    _quota_used -= new->size;
+    _quota_stats[quota].used -= new->size;
+#else
+    (void)quota;
+#endif
     /* calculate number of bytes between new _unused_t chunk and end of packet
      * buffer */
     bytes_at_end = ((&_pktbuf[0] + GNRC_PKTBUF_SIZE) - (((uint8_t *)new) + new->size));
@@ -569,7 +772,7 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
     gnrc_pktsnip_t *tmp;
     gnrc_pktsnip_t *target = gnrc_pktsnip_search_type(pkt, type);
     gnrc_pktsnip_t *next = (target == NULL) ? NULL : target->next;
-    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type);
+    gnrc_pktsnip_t *new = _create_snip(next, NULL, size, type, _QUOTA(pkt));
 
     if (new == NULL) {
         mutex_unlock(&_mutex);
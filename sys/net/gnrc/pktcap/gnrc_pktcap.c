@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_pktcap
+ * @{
+ *
+ * @file
+ * @brief       Module to capture packets received via netapi in pcap format
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "timex.h"
+#include "xtimer.h"
+#include "net/gnrc.h"
+#include "net/gnrc/pktcap.h"
+
+#if GNRC_PKTCAP_RING_SIZE
+#include "tsrb.h"
+#endif
+#ifdef GNRC_PKTCAP_UART
+#include "periph/uart.h"
+#endif
+
+#define PCAP_MAGIC          (0xa1b2c3d4)
+#define PCAP_VERSION_MAJOR  (2U)
+#define PCAP_VERSION_MINOR  (4U)
+
+/* the pcap file header, in host byte order as readers detect it from the
+ * magic */
+typedef struct {
+    uint32_t magic;
+    uint16_t version_major;
+    uint16_t version_minor;
+    int32_t thiszone;       /* GMT to local correction */
+    uint32_t sigfigs;       /* accuracy of timestamps */
+    uint32_t snaplen;
+    uint32_t network;       /* link type */
+} pcap_hdr_t;
+
+/**
+ * @brief   PID of the pktcap thread
+ */
+kernel_pid_t gnrc_pktcap_pid = KERNEL_PID_UNDEF;
+
+/**
+ * @brief   Stack for the pktcap thread
+ */
+static char _stack[GNRC_PKTCAP_STACKSIZE];
+
+static gnrc_pktcap_write_t _write;
+static uint32_t _dropped;
+
+/* the record under construction, starting with the record header */
+static uint32_t _rec[(GNRC_PKTCAP_REC_HDR_LEN + GNRC_PKTCAP_SNAPLEN + 3) / 4];
+
+#if GNRC_PKTCAP_RATE
+static uint64_t _last_refill;
+/* in units of 1 / GNRC_PKTCAP_RATE records */
+static uint64_t _tokens = (uint64_t)GNRC_PKTCAP_BURST * SEC_IN_USEC;
+
+/* token bucket, refilled with GNRC_PKTCAP_RATE records per second */
+static int _rate_limit(uint64_t now)
+{
+    const uint64_t max = (uint64_t)GNRC_PKTCAP_BURST * SEC_IN_USEC;
+
+    _tokens += (now - _last_refill) * GNRC_PKTCAP_RATE;
+    _last_refill = now;
+    if (_tokens > max) {
+        _tokens = max;
+    }
+    if (_tokens < SEC_IN_USEC) {
+        return -EAGAIN;
+    }
+    _tokens -= SEC_IN_USEC;
+    return 0;
+}
+#endif
+
+static gnrc_pktsnip_t *_snip(gnrc_pktsnip_t *pkt, unsigned idx)
+{
+    for (; pkt != NULL; pkt = pkt->next) {
+        if (pkt->type == GNRC_NETTYPE_NETIF) {
+            continue;
+        }
+        if (idx-- == 0) {
+            break;
+        }
+    }
+    return pkt;
+}
+
+static void _capture(gnrc_pktsnip_t *pkt, bool rcv)
+{
+    uint8_t *data = (uint8_t *)&_rec[GNRC_PKTCAP_REC_HDR_LEN / 4];
+    unsigned numof = 0;
+    size_t orig_len = 0, incl_len = 0;
+    uint64_t now = xtimer_now_usec64();
+
+#if GNRC_PKTCAP_RATE
+    if (_rate_limit(now) < 0) {
+        _dropped++;
+        return;
+    }
+#endif
+    for (gnrc_pktsnip_t *snip = pkt; snip != NULL; snip = snip->next) {
+        if (snip->type != GNRC_NETTYPE_NETIF) {
+            orig_len += snip->size;
+            numof++;
+        }
+    }
+    /* received packets start with the payload, packets to send with the
+     * outermost header */
+    for (unsigned i = 0; (i < numof) && (incl_len < GNRC_PKTCAP_SNAPLEN); i++) {
+        gnrc_pktsnip_t *snip = _snip(pkt, rcv ? (numof - 1 - i) : i);
+        size_t len = snip->size;
+
+        if (len > (GNRC_PKTCAP_SNAPLEN - incl_len)) {
+            len = GNRC_PKTCAP_SNAPLEN - incl_len;
+        }
+        memcpy(&data[incl_len], snip->data, len);
+        incl_len += len;
+    }
+    _rec[0] = (uint32_t)(now / SEC_IN_USEC);
+    _rec[1] = (uint32_t)(now % SEC_IN_USEC);
+    _rec[2] = incl_len;
+    _rec[3] = orig_len;
+    if (_write((uint8_t *)_rec, GNRC_PKTCAP_REC_HDR_LEN + incl_len) < 0) {
+        _dropped++;
+    }
+}
+
+static void *_eventloop(void *arg)
+{
+    (void)arg;
+    msg_t msg, reply;
+    msg_t msg_queue[GNRC_PKTCAP_MSG_QUEUE_SIZE];
+
+    /* setup the message queue */
+    msg_init_queue(msg_queue, GNRC_PKTCAP_MSG_QUEUE_SIZE);
+
+    reply.content.value = (uint32_t)(-ENOTSUP);
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+
+    while (1) {
+        msg_receive(&msg);
+
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_RCV:
+                _capture(msg.content.ptr, true);
+                gnrc_pktbuf_release(msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SND:
+                _capture(msg.content.ptr, false);
+                gnrc_pktbuf_release(msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                break;
+        }
+    }
+
+    /* never reached */
+    return NULL;
+}
+
+kernel_pid_t gnrc_pktcap_init(gnrc_pktcap_write_t write)
+{
+    if (gnrc_pktcap_pid == KERNEL_PID_UNDEF) {
+        const pcap_hdr_t hdr = {
+            .magic = PCAP_MAGIC,
+            .version_major = PCAP_VERSION_MAJOR,
+            .version_minor = PCAP_VERSION_MINOR,
+            .snaplen = GNRC_PKTCAP_SNAPLEN,
+            .network = GNRC_PKTCAP_LINKTYPE,
+        };
+
+        _write = write;
+        _write((const uint8_t *)&hdr, sizeof(hdr));
+#if GNRC_PKTCAP_RATE
+        _last_refill = xtimer_now_usec64();
+#endif
+        gnrc_pktcap_pid = thread_create(_stack, sizeof(_stack), GNRC_PKTCAP_PRIO,
+                                        THREAD_CREATE_STACKTEST,
+                                        _eventloop, NULL, "pktcap");
+    }
+    return gnrc_pktcap_pid;
+}
+
+uint32_t gnrc_pktcap_dropped(void)
+{
+    return _dropped;
+}
+
+#if GNRC_PKTCAP_RING_SIZE
+static char _ring_buf[GNRC_PKTCAP_RING_SIZE];
+static tsrb_t _ring = TSRB_INIT(_ring_buf);
+
+int gnrc_pktcap_ring_write(const uint8_t *data, size_t len)
+{
+    /* only this thread writes, so the free space can only grow */
+    if (tsrb_free(&_ring) < len) {
+        return -ENOBUFS;
+    }
+    tsrb_add(&_ring, (const char *)data, len);
+    return 0;
+}
+
+size_t gnrc_pktcap_ring_read(uint8_t *buf, size_t len)
+{
+    return tsrb_get(&_ring, (char *)buf, len);
+}
+#endif
+
+#ifdef GNRC_PKTCAP_UART
+int gnrc_pktcap_uart_write(const uint8_t *data, size_t len)
+{
+    uart_write(GNRC_PKTCAP_UART, data, len);
+    return 0;
+}
+#endif
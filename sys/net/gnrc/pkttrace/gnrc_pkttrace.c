@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_pkttrace
+ * @{
+ *
+ * @file
+ * @brief       Packet latency tracing implementation
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "irq.h"
+#include "xtimer.h"
+
+#include "net/gnrc/pkttrace.h"
+
+static gnrc_pkttrace_hist_t _hist[GNRC_PKTTRACE_NUMOF];
+
+static const char *_names[] = {
+    "rx netdev2",
+    "rx 6lowpan",
+    "rx ipv6",
+    "rx udp",
+    "rx sock",
+    "tx udp",
+    "tx ipv6",
+    "tx 6lowpan",
+    "tx netdev2",
+    "tx driver",
+};
+
+/* 0 marks a packet without time stamp */
+static inline uint32_t _now(void)
+{
+    uint32_t now = xtimer_now_usec();
+
+    return (now != 0) ? now : 1;
+}
+
+static void _stamp(gnrc_pktsnip_t *pkt, uint32_t time)
+{
+    /* every snip gets it, as the stack replaces single snips on the way */
+    while (pkt != NULL) {
+        pkt->trace = time;
+        pkt = pkt->next;
+    }
+}
+
+void gnrc_pkttrace_start(gnrc_pktsnip_t *pkt, uint32_t time)
+{
+    _stamp(pkt, (time != 0) ? time : 1);
+}
+
+void gnrc_pkttrace_hop(gnrc_pktsnip_t *pkt, gnrc_pkttrace_hop_t hop)
+{
+    uint32_t now = _now();
+
+    for (gnrc_pktsnip_t *ptr = pkt; ptr != NULL; ptr = ptr->next) {
+        if (ptr->trace != 0) {
+            gnrc_pkttrace_record(hop, now - ptr->trace);
+            _stamp(pkt, now);
+            return;
+        }
+    }
+}
+
+void gnrc_pkttrace_record(gnrc_pkttrace_hop_t hop, uint32_t usec)
+{
+    gnrc_pkttrace_hist_t *hist = &_hist[hop];
+    unsigned bucket = (usec > 1) ? bitarithm_msb(usec) : 0;
+
+    if (bucket >= GNRC_PKTTRACE_BUCKETS) {
+        bucket = GNRC_PKTTRACE_BUCKETS - 1;
+    }
+    /* the sock hops are recorded from any thread */
+    unsigned state = irq_disable();
+    hist->count++;
+    hist->sum += usec;
+    if (usec > hist->max) {
+        hist->max = usec;
+    }
+    hist->buckets[bucket]++;
+    irq_restore(state);
+}
+
+const gnrc_pkttrace_hist_t *gnrc_pkttrace_get(gnrc_pkttrace_hop_t hop)
+{
+    return &_hist[hop];
+}
+
+void gnrc_pkttrace_reset(void)
+{
+    unsigned state = irq_disable();
+    memset(_hist, 0, sizeof(_hist));
+    irq_restore(state);
+}
+
+void gnrc_pkttrace_print(void)
+{
+    printf("%-11s %8s %8s %8s  histogram (bucket i: < 2^(i+1) us)\n",
+           "hop", "count", "avg us", "max us");
+    for (unsigned i = 0; i < GNRC_PKTTRACE_NUMOF; i++) {
+        gnrc_pkttrace_hist_t hist;
+        unsigned state = irq_disable();
+
+        hist = _hist[i];
+        irq_restore(state);
+        if (hist.count == 0) {
+            continue;
+        }
+        printf("%-11s %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " ", _names[i],
+               hist.count, (uint32_t)(hist.sum / hist.count), hist.max);
+        for (unsigned j = 0; j < GNRC_PKTTRACE_BUCKETS; j++) {
+            printf(" %" PRIu32, hist.buckets[j]);
+        }
+        puts("");
+    }
+}
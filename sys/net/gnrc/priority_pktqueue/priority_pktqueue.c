@@ -19,9 +19,119 @@
  * @}
  */
 
+#include "bitarithm.h"
 #include "net/gnrc/pktbuf.h"
 #include <net/gnrc/priority_pktqueue.h>
 
+#if GNRC_PRIORITY_PKTQUEUE_LEVELS
+/******************************************************************************/
+
+static inline unsigned _level(uint32_t priority)
+{
+    return (priority < GNRC_PRIORITY_PKTQUEUE_LEVELS) ?
+           priority : (GNRC_PRIORITY_PKTQUEUE_LEVELS - 1);
+}
+
+/******************************************************************************/
+
+static gnrc_priority_pktqueue_node_t *_remove_head(gnrc_priority_pktqueue_t *queue)
+{
+    if (queue->used == 0) {
+        return NULL;
+    }
+    unsigned level = bitarithm_lsb(queue->used);
+    gnrc_priority_pktqueue_node_t *head = queue->first[level];
+
+    queue->first[level] = head->next;
+    if (head->next == NULL) {
+        queue->last[level] = NULL;
+        queue->used &= ~(1U << level);
+    }
+    queue->length--;
+    return head;
+}
+
+/******************************************************************************/
+
+static inline void _free_node(gnrc_priority_pktqueue_node_t *node)
+{
+    assert(node != NULL);
+
+    gnrc_priority_pktqueue_node_init(node, 0, NULL);
+}
+
+/******************************************************************************/
+
+gnrc_pktsnip_t* gnrc_priority_pktqueue_pop(gnrc_priority_pktqueue_t* queue)
+{
+    if (!queue) {
+        return NULL;
+    }
+    gnrc_priority_pktqueue_node_t *head = _remove_head(queue);
+    if (!head) {
+        return NULL;
+    }
+    gnrc_pktsnip_t* pkt = head->pkt;
+    _free_node(head);
+    return pkt;
+}
+
+/******************************************************************************/
+
+gnrc_pktsnip_t* gnrc_priority_pktqueue_head(gnrc_priority_pktqueue_t* queue)
+{
+    if (!queue || (queue->used == 0)) {
+        return NULL;
+    }
+    return queue->first[bitarithm_lsb(queue->used)]->pkt;
+}
+
+/******************************************************************************/
+
+void gnrc_priority_pktqueue_push(gnrc_priority_pktqueue_t* queue,
+                                 gnrc_priority_pktqueue_node_t *node)
+{
+    assert(queue != NULL);
+    assert(node != NULL);
+    assert(node->pkt != NULL);
+
+    unsigned level = _level(node->priority);
+
+    node->next = NULL;
+    if (queue->last[level]) {
+        queue->last[level]->next = node;
+    }
+    else {
+        queue->first[level] = node;
+        queue->used |= (1U << level);
+    }
+    queue->last[level] = node;
+    queue->length++;
+}
+
+/******************************************************************************/
+
+void gnrc_priority_pktqueue_flush(gnrc_priority_pktqueue_t* queue)
+{
+    assert(queue != NULL);
+
+    gnrc_priority_pktqueue_node_t* node;
+    while ((node = _remove_head(queue))) {
+        gnrc_pktbuf_release(node->pkt);
+        _free_node(node);
+    }
+}
+
+/******************************************************************************/
+
+uint32_t gnrc_priority_pktqueue_length(gnrc_priority_pktqueue_t *queue)
+{
+    assert(queue != NULL);
+
+    return queue->length;
+}
+
+#else /* GNRC_PRIORITY_PKTQUEUE_LEVELS */
 /******************************************************************************/
 
 static inline void _free_node(gnrc_priority_pktqueue_node_t *node)
@@ -35,7 +145,7 @@ static inline void _free_node(gnrc_priority_pktqueue_node_t *node)
 
 gnrc_pktsnip_t* gnrc_priority_pktqueue_pop(gnrc_priority_pktqueue_t* queue)
 {
-    if(!queue || (gnrc_priority_pktqueue_length(queue) == 0)){
+    if(!queue || !queue->first){
         return NULL;
     }
     priority_queue_node_t *head = priority_queue_remove_head(queue);
@@ -48,7 +158,7 @@ gnrc_pktsnip_t* gnrc_priority_pktqueue_pop(gnrc_priority_pktqueue_t* queue)
 
 gnrc_pktsnip_t* gnrc_priority_pktqueue_head(gnrc_priority_pktqueue_t* queue)
 {
-    if(!queue || (gnrc_priority_pktqueue_length(queue) == 0)){
+    if(!queue || !queue->first){
         return NULL;
     }
     return (gnrc_pktsnip_t *)queue->first->data;
@@ -101,3 +211,5 @@ uint32_t gnrc_priority_pktqueue_length(gnrc_priority_pktqueue_t *queue)
     }
     return length;
 }
+
+#endif /* GNRC_PRIORITY_PKTQUEUE_LEVELS */
@@ -0,0 +1,520 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/ipv6/ext.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "thread.h"
+#include "timex.h"
+#include "trickle.h"
+#include "xtimer.h"
+
+#include "net/gnrc/mpl.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* option of RFC 7731, section 4 */
+#define OPT_TYPE_PAD1       (0x00)
+#define OPT_TYPE_MPL        (0x6d)
+#define OPT_FLAG_M          (0x20)
+#define OPT_FLAG_V          (0x10)
+#define OPT_S_POS           (6U)
+#define OPT_MIN_LEN         (2U)    /* flags and sequence */
+
+/* the hop-by-hop header of originated messages, S = 0 */
+#define HBH_LEN             (8U)
+
+typedef struct {
+    uint8_t id[sizeof(ipv6_addr_t)];
+    uint32_t expires;               /* in seconds, when unreferenced */
+    uint8_t id_len;                 /* 0 marks unused entries */
+    uint8_t min_seq;                /* messages before were seen already */
+} _seed_t;
+
+typedef struct {
+    trickle_t trickle;
+    gnrc_pktsnip_t *pkt;            /* IPv6 header, then the rest, or NULL */
+    _seed_t *seed;
+    uint8_t seq;
+    uint8_t expirations;            /* Trickle intervals since the start */
+} _msg_t;
+
+static const ipv6_addr_t _domain = GNRC_MPL_DOMAIN_ADDR;
+static char _stack[GNRC_MPL_STACK_SIZE];
+static msg_t _msg_q[GNRC_MPL_MSG_QUEUE_SIZE];
+static _seed_t _seeds[GNRC_MPL_SEED_SET_SIZE];
+static _msg_t _msgs[GNRC_MPL_BUFFER_SIZE];
+static unsigned _next;              /* next message to replace if all active */
+static uint8_t _seq;                /* sequence of the next own message */
+static kernel_pid_t _iface = KERNEL_PID_UNDEF;
+static gnrc_mpl_stats_t _stats;
+
+kernel_pid_t gnrc_mpl_pid = KERNEL_PID_UNDEF;
+
+static void *_event_loop(void *args);
+
+kernel_pid_t gnrc_mpl_init(kernel_pid_t if_pid)
+{
+    if (gnrc_mpl_pid == KERNEL_PID_UNDEF) {
+        gnrc_mpl_pid = thread_create(_stack, sizeof(_stack), GNRC_MPL_PRIO,
+                                     THREAD_CREATE_STACKTEST,
+                                     _event_loop, NULL, "mpl");
+        if (gnrc_mpl_pid == KERNEL_PID_UNDEF) {
+            DEBUG("mpl: could not start the event loop\n");
+            return KERNEL_PID_UNDEF;
+        }
+    }
+    if ((_iface != KERNEL_PID_UNDEF) && (_iface != if_pid)) {
+        gnrc_ipv6_netif_remove_addr(_iface, (ipv6_addr_t *)&_domain);
+    }
+    if (gnrc_ipv6_netif_add_addr(if_pid, &_domain, IPV6_ADDR_BIT_LEN, 0) == NULL) {
+        DEBUG("mpl: could not join the MPL domain\n");
+        return KERNEL_PID_UNDEF;
+    }
+    _iface = if_pid;
+    return gnrc_mpl_pid;
+}
+
+kernel_pid_t gnrc_mpl_iface(const ipv6_addr_t *dst)
+{
+    if (!ipv6_addr_is_multicast(dst) ||
+        ((dst->u8[1] & 0x0f) < IPV6_ADDR_MCAST_SCP_REALM_LOCAL) ||
+        ipv6_addr_equal(dst, &_domain)) {
+        return KERNEL_PID_UNDEF;
+    }
+    return _iface;
+}
+
+bool gnrc_mpl_is_domain(const ipv6_addr_t *dst)
+{
+    return (_iface != KERNEL_PID_UNDEF) && ipv6_addr_equal(dst, &_domain);
+}
+
+const gnrc_mpl_stats_t *gnrc_mpl_stats(void)
+{
+    return &_stats;
+}
+
+static inline uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / SEC_IN_USEC);
+}
+
+/* sequence numbers are compared in serial number arithmetic */
+static inline bool _seq_before(uint8_t a, uint8_t b)
+{
+    return (int8_t)(a - b) < 0;
+}
+
+static bool _seed_in_use(const _seed_t *seed)
+{
+    for (unsigned i = 0; i < GNRC_MPL_BUFFER_SIZE; i++) {
+        if ((_msgs[i].pkt != NULL) && (_msgs[i].seed == seed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static _seed_t *_seed_get(const uint8_t *id, uint8_t id_len)
+{
+    uint32_t now = _now();
+    _seed_t *free = NULL;
+
+    for (unsigned i = 0; i < GNRC_MPL_SEED_SET_SIZE; i++) {
+        _seed_t *seed = &_seeds[i];
+
+        if ((seed->id_len == id_len) && (memcmp(seed->id, id, id_len) == 0)) {
+            return seed;
+        }
+        if ((free == NULL) &&
+            ((seed->id_len == 0) ||
+             (((int32_t)(now - seed->expires) >= 0) && !_seed_in_use(seed)))) {
+            free = seed;
+        }
+    }
+    if (free != NULL) {
+        memcpy(free->id, id, id_len);
+        free->id_len = id_len;
+        free->min_seq = 0;
+        free->expires = now + GNRC_MPL_SEED_LIFETIME;
+    }
+    return free;
+}
+
+static void _msg_remove(_msg_t *msg)
+{
+    trickle_stop(&msg->trickle);
+    gnrc_pktbuf_release(msg->pkt);
+    msg->pkt = NULL;
+    /* the message stays known as seen */
+    if (!_seq_before(msg->seq, msg->seed->min_seq)) {
+        msg->seed->min_seq = msg->seq + 1;
+    }
+    msg->seed->expires = _now() + GNRC_MPL_SEED_LIFETIME;
+}
+
+static _msg_t *_msg_find(const _seed_t *seed, uint8_t seq)
+{
+    for (unsigned i = 0; i < GNRC_MPL_BUFFER_SIZE; i++) {
+        if ((_msgs[i].pkt != NULL) && (_msgs[i].seed == seed) &&
+            (_msgs[i].seq == seq)) {
+            return &_msgs[i];
+        }
+    }
+    return NULL;
+}
+
+static _msg_t *_msg_alloc(void)
+{
+    _msg_t *msg;
+
+    /* prefer unused entries, then messages that are not sent anymore */
+    for (unsigned i = 0; i < GNRC_MPL_BUFFER_SIZE; i++) {
+        if (_msgs[i].pkt == NULL) {
+            return &_msgs[i];
+        }
+    }
+    for (unsigned i = 0; i < GNRC_MPL_BUFFER_SIZE; i++) {
+        if (_msgs[i].expirations >= GNRC_MPL_DATA_EXPIRATIONS) {
+            _msg_remove(&_msgs[i]);
+            return &_msgs[i];
+        }
+    }
+    msg = &_msgs[_next];
+    _next = (_next + 1) % GNRC_MPL_BUFFER_SIZE;
+    _msg_remove(msg);
+    return msg;
+}
+
+static void _transmit(void *arg)
+{
+    _msg_t *msg = arg;
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+
+    if (netif == NULL) {
+        DEBUG("mpl: no space left in packet buffer\n");
+        return;
+    }
+    DEBUG("mpl: transmit %u\n", msg->seq);
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _iface;
+    /* the message is sent as it is */
+    ((gnrc_netif_hdr_t *)netif->data)->flags |= GNRC_NETIF_HDR_FLAGS_CSUM;
+    gnrc_pktbuf_hold(msg->pkt, 1);
+    netif->next = msg->pkt;
+    if (gnrc_netapi_send(gnrc_ipv6_pid, netif) < 1) {
+        DEBUG("mpl: unable to send message\n");
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    _stats.transmitted++;
+}
+
+static void _msg_add(_seed_t *seed, uint8_t seq, gnrc_pktsnip_t *pkt)
+{
+    _msg_t *msg = _msg_alloc();
+
+    msg->pkt = pkt;
+    msg->seed = seed;
+    msg->seq = seq;
+    if (((ipv6_hdr_t *)pkt->data)->hl == 0) {
+        /* delivered, but not forwarded */
+        msg->expirations = GNRC_MPL_DATA_EXPIRATIONS;
+        return;
+    }
+    msg->expirations = 0;
+    msg->trickle.callback.func = _transmit;
+    msg->trickle.callback.args = msg;
+    trickle_start(gnrc_mpl_pid, &msg->trickle, GNRC_MPL_MSG_TYPE_TRICKLE_INTERVAL,
+                  GNRC_MPL_MSG_TYPE_TRICKLE_CALLBACK, GNRC_MPL_DATA_IMIN,
+                  GNRC_MPL_DATA_IMAX, GNRC_MPL_DATA_K);
+}
+
+/* builds the message to buffer: the IPv6 header, then a snip with the
+ * remaining headers and the payload */
+static gnrc_pktsnip_t *_msg_build(const ipv6_hdr_t *hdr, size_t len)
+{
+    gnrc_pktsnip_t *payload, *ipv6;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    ipv6 = gnrc_pktbuf_add(payload, (void *)hdr, sizeof(ipv6_hdr_t),
+                           GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    return ipv6;
+}
+
+static void _originate(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ipv6 = pkt, *msg;
+    ipv6_hdr_t *inner, outer;
+    uint8_t *data;
+    _seed_t *seed;
+
+    if (ipv6->type == GNRC_NETTYPE_NETIF) {
+        ipv6 = ipv6->next;
+    }
+    inner = ipv6->data;
+    if (ipv6_addr_is_unspecified(&inner->src) ||
+        ((seed = _seed_get(inner->src.u8, sizeof(ipv6_addr_t))) == NULL)) {
+        DEBUG("mpl: no seed ID\n");
+        _stats.dropped++;
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
+    memset(&outer, 0, sizeof(outer));
+    ipv6_hdr_set_version(&outer);
+    outer.len = byteorder_htons(HBH_LEN + gnrc_pkt_len(ipv6));
+    outer.nh = PROTNUM_IPV6_EXT_HOPOPT;
+    outer.hl = GNRC_MPL_HOP_LIMIT;
+    outer.src = inner->src;
+    outer.dst = _domain;
+    msg = _msg_build(&outer, HBH_LEN + gnrc_pkt_len(ipv6));
+    if (msg == NULL) {
+        DEBUG("mpl: no space left in packet buffer\n");
+        _stats.dropped++;
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    data = msg->next->data;
+    /* hop-by-hop header with the MPL option and a PadN option */
+    data[0] = PROTNUM_IPV6;
+    data[1] = 0;
+    data[2] = OPT_TYPE_MPL;
+    data[3] = OPT_MIN_LEN;
+    data[4] = OPT_FLAG_M;
+    data[5] = _seq;
+    data[6] = 1;
+    data[7] = 0;
+    data += HBH_LEN;
+    for (gnrc_pktsnip_t *snip = ipv6; snip != NULL; snip = snip->next) {
+        memcpy(data, snip->data, snip->size);
+        data += snip->size;
+    }
+    gnrc_pktbuf_release(pkt);
+
+    DEBUG("mpl: originate %u\n", _seq);
+    _msg_add(seed, _seq++, msg);
+    _stats.originated++;
+}
+
+/* finds the MPL option in the hop-by-hop header at the start of ext */
+static const uint8_t *_find_opt(const uint8_t *ext, size_t size)
+{
+    size_t len = (ext[1] * IPV6_EXT_LEN_UNIT) + IPV6_EXT_LEN_UNIT;
+
+    if (len > size) {
+        return NULL;
+    }
+    for (size_t i = sizeof(ipv6_ext_t); i < len;) {
+        if (ext[i] == OPT_TYPE_PAD1) {
+            i++;
+            continue;
+        }
+        if (((i + 2) > len) || ((i + 2 + ext[i + 1]) > len)) {
+            return NULL;
+        }
+        if ((ext[i] == OPT_TYPE_MPL) && (ext[i + 1] >= OPT_MIN_LEN)) {
+            return &ext[i];
+        }
+        i += 2 + ext[i + 1];
+    }
+    return NULL;
+}
+
+static void _deliver(gnrc_pktsnip_t *netif, const uint8_t *inner, size_t len)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if ((len < sizeof(ipv6_hdr_t)) ||
+        (gnrc_ipv6_netif_find_by_addr(NULL, &((const ipv6_hdr_t *)inner)->dst) ==
+         KERNEL_PID_UNDEF)) {
+        /* not a member of the group */
+        return;
+    }
+    netif = gnrc_pktbuf_add(NULL, netif->data, netif->size, GNRC_NETTYPE_NETIF);
+    if (netif == NULL) {
+        return;
+    }
+    pkt = gnrc_pktbuf_add(netif, (void *)inner, len, GNRC_NETTYPE_IPV6);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    if (gnrc_netapi_receive(gnrc_ipv6_pid, pkt) < 1) {
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+/* pkt is received in reverse order: the encapsulated packet, the extension
+ * headers, the outer IPv6 header and the netif header */
+static void _receive(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ext = pkt->next, *ipv6, *netif, *msg;
+    const uint8_t *opt, *id;
+    ipv6_hdr_t *hdr;
+    uint8_t id_len, seq, *data;
+    _seed_t *seed;
+    _msg_t *old;
+
+    if ((ext == NULL) || (ext->type != GNRC_NETTYPE_IPV6_EXT) ||
+        ((ipv6 = ext->next) == NULL) || (ipv6->type != GNRC_NETTYPE_IPV6) ||
+        ((netif = ipv6->next) == NULL) || (netif->type != GNRC_NETTYPE_NETIF)) {
+        DEBUG("mpl: unexpected packet layout\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    hdr = ipv6->data;
+    if ((hdr->nh != PROTNUM_IPV6_EXT_HOPOPT) || (ext->size < sizeof(ipv6_ext_t)) ||
+        ((opt = _find_opt(ext->data, ext->size)) == NULL) ||
+        (opt[2] & OPT_FLAG_V)) {
+        DEBUG("mpl: no valid MPL option\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    seq = opt[3];
+    switch (opt[2] >> OPT_S_POS) {
+        case 0:
+            id = hdr->src.u8;
+            id_len = sizeof(ipv6_addr_t);
+            break;
+        case 1:
+            id = &opt[4];
+            id_len = 2;
+            break;
+        case 2:
+            id = &opt[4];
+            id_len = 8;
+            break;
+        default:
+            id = &opt[4];
+            id_len = 16;
+            break;
+    }
+    if ((id != hdr->src.u8) && ((OPT_MIN_LEN + id_len) > opt[1])) {
+        DEBUG("mpl: seed ID truncated\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if ((seed = _seed_get(id, id_len)) == NULL) {
+        DEBUG("mpl: seed set full\n");
+        _stats.dropped++;
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if ((old = _msg_find(seed, seq)) != NULL) {
+        DEBUG("mpl: duplicate %u\n", seq);
+        _stats.duplicates++;
+        /* a consistent transmission, see RFC 7731, section 9.3 */
+        trickle_increment_counter(&old->trickle);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (_seq_before(seq, seed->min_seq)) {
+        _stats.duplicates++;
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
+    DEBUG("mpl: new message %u\n", seq);
+    _stats.received++;
+    msg = _msg_build(hdr, ext->size + pkt->size);
+    if (msg == NULL) {
+        DEBUG("mpl: no space left in packet buffer\n");
+        _stats.dropped++;
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    /* forwarders decrement the hop limit of the outer header */
+    ((ipv6_hdr_t *)msg->data)->hl = (hdr->hl > 0) ? (hdr->hl - 1) : 0;
+    data = msg->next->data;
+    memcpy(data, ext->data, ext->size);
+    memcpy(data + ext->size, pkt->data, pkt->size);
+    _deliver(netif, data + ext->size, pkt->size);
+    gnrc_pktbuf_release(pkt);
+    _msg_add(seed, seq, msg);
+}
+
+static void _interval(trickle_t *trickle)
+{
+    _msg_t *msg = container_of(trickle, _msg_t, trickle);
+
+    if (msg->pkt == NULL) {
+        return;
+    }
+    if (++msg->expirations >= GNRC_MPL_DATA_EXPIRATIONS) {
+        DEBUG("mpl: %u done\n", msg->seq);
+        trickle_stop(trickle);
+        return;
+    }
+    trickle_interval(trickle);
+}
+
+static void *_event_loop(void *args)
+{
+    msg_t msg, reply;
+
+    (void)args;
+    msg_init_queue(_msg_q, GNRC_MPL_MSG_QUEUE_SIZE);
+
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+    reply.content.value = (uint32_t)(-ENOTSUP);
+
+    while (1) {
+        msg_receive(&msg);
+
+        switch (msg.type) {
+            case GNRC_MPL_MSG_TYPE_TRICKLE_INTERVAL:
+                _interval(msg.content.ptr);
+                break;
+            case GNRC_MPL_MSG_TYPE_TRICKLE_CALLBACK:
+                /* messages of stopped timers may still be queued */
+                if (container_of((trickle_t *)msg.content.ptr, _msg_t,
+                                 trickle)->pkt != NULL) {
+                    trickle_callback(msg.content.ptr);
+                }
+                break;
+            case GNRC_NETAPI_MSG_TYPE_RCV:
+                _receive(msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SND:
+                _originate(msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                break;
+        }
+    }
+
+    return NULL;
+}
+
+/** @} */
@@ -304,6 +304,11 @@ void _update_lifetime(void)
 
 void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag)
 {
+    if ((dodag->dao_counter == 0) && !dodag->dao_ack_received &&
+        (dodag->dao_time <= GNRC_RPL_DEFAULT_DAO_DELAY)) {
+        /* a DAO is pending anyway and will carry all current targets */
+        return;
+    }
     dodag->dao_time = GNRC_RPL_DEFAULT_DAO_DELAY;
     dodag->dao_counter = 0;
     dodag->dao_ack_received = false;
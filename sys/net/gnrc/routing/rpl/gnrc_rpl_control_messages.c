@@ -105,8 +105,9 @@ gnrc_pktsnip_t *_dio_dodag_conf_build(gnrc_pktsnip_t *pkt, gnrc_rpl_dodag_t *dod
 {
     gnrc_rpl_opt_dodag_conf_t *dodag_conf;
     gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_dodag_conf_t),
-                                    GNRC_NETTYPE_UNDEF)) == NULL) {
+    if ((opt_snip = gnrc_pktbuf_add_quota(pkt, NULL, sizeof(gnrc_rpl_opt_dodag_conf_t),
+                                          GNRC_NETTYPE_UNDEF,
+                                          GNRC_PKTBUF_QUOTA_CONTROL)) == NULL) {
         DEBUG("RPL: BUILD DODAG CONF - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
         return NULL;
@@ -132,8 +133,9 @@ gnrc_pktsnip_t *_dio_prefix_info_build(gnrc_pktsnip_t *pkt, gnrc_rpl_dodag_t *do
 {
     gnrc_rpl_opt_prefix_info_t *prefix_info;
     gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_prefix_info_t),
-                                    GNRC_NETTYPE_UNDEF)) == NULL) {
+    if ((opt_snip = gnrc_pktbuf_add_quota(pkt, NULL, sizeof(gnrc_rpl_opt_prefix_info_t),
+                                          GNRC_NETTYPE_UNDEF,
+                                          GNRC_PKTBUF_QUOTA_CONTROL)) == NULL) {
         DEBUG("RPL: BUILD PREFIX INFO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
         return NULL;
@@ -192,7 +194,9 @@ void gnrc_rpl_send_DIO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination)
         dodag->dio_opts &= ~GNRC_RPL_REQ_DIO_OPT_DODAG_CONF;
     }
 
-    if ((tmp = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_dio_t), GNRC_NETTYPE_UNDEF)) == NULL) {
+    if ((tmp = gnrc_pktbuf_add_quota(pkt, NULL, sizeof(gnrc_rpl_dio_t),
+                                     GNRC_NETTYPE_UNDEF,
+                                     GNRC_PKTBUF_QUOTA_CONTROL)) == NULL) {
         DEBUG("RPL: Send DIO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
         return;
@@ -306,6 +310,51 @@ void gnrc_rpl_recv_DIS(gnrc_rpl_dis_t *dis, kernel_pid_t iface, ipv6_addr_t *src
     }
 }
 
+/**
+ * @brief   Installs routes via @p src for all target options in [@p opt, @p end)
+ *
+ * The routes are added to the FIB in batches of @ref GNRC_RPL_DAO_FIB_BATCH.
+ */
+static void _dao_targets_add(gnrc_rpl_dodag_t *dodag, gnrc_rpl_opt_t *opt,
+                             gnrc_rpl_opt_t *end, ipv6_addr_t *src,
+                             uint32_t next_hop_flags, uint32_t lifetime)
+{
+    fib_dst_t dsts[GNRC_RPL_DAO_FIB_BATCH];
+    size_t num = 0;
+
+    while (opt < end) {
+        if (opt->type == GNRC_RPL_OPT_PAD1) {
+            opt = (gnrc_rpl_opt_t *) (((uint8_t *) opt) + 1);
+            continue;
+        }
+        if (opt->type == GNRC_RPL_OPT_TARGET) {
+            gnrc_rpl_opt_target_t *target = (gnrc_rpl_opt_target_t *) opt;
+
+            dsts[num].dst = target->target.u8;
+            dsts[num].dst_size = sizeof(ipv6_addr_t);
+            dsts[num].dst_flags = 0;
+            if (target->prefix_length <= IPV6_ADDR_BIT_LEN) {
+                dsts[num].dst_flags = ((uint32_t)(target->prefix_length) <<
+                                       FIB_FLAG_NET_PREFIX_SHIFT);
+            }
+            DEBUG("RPL: adding fib entry %s/%d 0x%" PRIx32 "\n",
+                  ipv6_addr_to_str(addr_str, &(target->target), sizeof(addr_str)),
+                  target->prefix_length, dsts[num].dst_flags);
+            if (++num == GNRC_RPL_DAO_FIB_BATCH) {
+                fib_add_entries(&gnrc_ipv6_fib_table, dodag->iface, dsts, num,
+                                src->u8, sizeof(ipv6_addr_t), next_hop_flags,
+                                lifetime);
+                num = 0;
+            }
+        }
+        opt = (gnrc_rpl_opt_t *) (((uint8_t *) (opt + 1)) + opt->length);
+    }
+    if (num > 0) {
+        fib_add_entries(&gnrc_ipv6_fib_table, dodag->iface, dsts, num,
+                        src->u8, sizeof(ipv6_addr_t), next_hop_flags, lifetime);
+    }
+}
+
 /** @todo allow target prefixes in target options to be of variable length */
 bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt, uint16_t len,
                     ipv6_addr_t *src, uint32_t *included_opts)
@@ -388,27 +437,10 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                 DEBUG("RPL: RPL TARGET DAO option parsed\n");
                 *included_opts |= ((uint32_t) 1) << GNRC_RPL_OPT_TARGET;
 
-                gnrc_rpl_opt_target_t *target = (gnrc_rpl_opt_target_t *) opt;
+                /* the routes are installed with the following transit */
                 if (first_target == NULL) {
-                    first_target = target;
-                }
-
-                uint32_t fib_dst_flags = 0;
-
-                if (target->prefix_length <= IPV6_ADDR_BIT_LEN) {
-                    fib_dst_flags = ((uint32_t)(target->prefix_length) << FIB_FLAG_NET_PREFIX_SHIFT);
+                    first_target = (gnrc_rpl_opt_target_t *) opt;
                 }
-
-                DEBUG("RPL: adding fib entry %s/%d 0x%" PRIx32 "\n",
-                      ipv6_addr_to_str(addr_str, &(target->target), sizeof(addr_str)),
-                      target->prefix_length,
-                      fib_dst_flags);
-
-                fib_add_entry(&gnrc_ipv6_fib_table, dodag->iface, target->target.u8,
-                              sizeof(ipv6_addr_t), fib_dst_flags, src->u8,
-                              sizeof(ipv6_addr_t), FIB_FLAG_RPL_ROUTE,
-                              (dodag->default_lifetime * dodag->lifetime_unit) *
-                              SEC_IN_MS);
                 break;
 
             case (GNRC_RPL_OPT_TRANSIT):
@@ -421,24 +453,10 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                     break;
                 }
 
-                do {
-                    DEBUG("RPL: updating fib entry %s/%d\n",
-                          ipv6_addr_to_str(addr_str, &(first_target->target), sizeof(addr_str)),
-                          first_target->prefix_length);
-
-                    fib_update_entry(&gnrc_ipv6_fib_table,
-                                     first_target->target.u8,
-                                     sizeof(ipv6_addr_t), src->u8,
-                                     sizeof(ipv6_addr_t),
-                                     ((transit->e_flags & GNRC_RPL_OPT_TRANSIT_E_FLAG) ?
-                                      0x0 : FIB_FLAG_RPL_ROUTE),
-                                     (transit->path_lifetime *
-                                      dodag->lifetime_unit * SEC_IN_MS));
-                    first_target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (first_target)) +
-                                   sizeof(gnrc_rpl_opt_t) + first_target->length);
-                }
-                while (first_target->type == GNRC_RPL_OPT_TARGET);
-
+                _dao_targets_add(dodag, (gnrc_rpl_opt_t *) first_target, opt, src,
+                                 ((transit->e_flags & GNRC_RPL_OPT_TRANSIT_E_FLAG) ?
+                                  0x0 : FIB_FLAG_RPL_ROUTE),
+                                 (transit->path_lifetime * dodag->lifetime_unit * SEC_IN_MS));
                 first_target = NULL;
                 break;
 
@@ -451,6 +469,13 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
         l += opt->length + sizeof(gnrc_rpl_opt_t);
         opt = (gnrc_rpl_opt_t *) (((uint8_t *) (opt + 1)) + opt->length);
     }
+
+    if (first_target != NULL) {
+        /* targets without a transit get the DODAG's default lifetime */
+        _dao_targets_add(dodag, (gnrc_rpl_opt_t *) first_target, opt, src,
+                         FIB_FLAG_RPL_ROUTE,
+                         (dodag->default_lifetime * dodag->lifetime_unit) * SEC_IN_MS);
+    }
     return true;
 }
 
@@ -661,8 +686,9 @@ gnrc_pktsnip_t *_dao_target_build(gnrc_pktsnip_t *pkt, ipv6_addr_t *addr, uint8_
 {
     gnrc_rpl_opt_target_t *target;
     gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_target_t),
-                               GNRC_NETTYPE_UNDEF)) == NULL) {
+    if ((opt_snip = gnrc_pktbuf_add_quota(pkt, NULL, sizeof(gnrc_rpl_opt_target_t),
+                                          GNRC_NETTYPE_UNDEF,
+                                          GNRC_PKTBUF_QUOTA_CONTROL)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
         return NULL;
@@ -680,8 +706,9 @@ gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool e
 {
     gnrc_rpl_opt_transit_t *transit;
     gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t),
-                               GNRC_NETTYPE_UNDEF)) == NULL) {
+    if ((opt_snip = gnrc_pktbuf_add_quota(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t),
+                                          GNRC_NETTYPE_UNDEF,
+                                          GNRC_PKTBUF_QUOTA_CONTROL)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
         return NULL;
@@ -806,8 +833,9 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     bool local_instance = (inst->id & GNRC_RPL_INSTANCE_ID_MSB) ? true : false;
 
     if (local_instance) {
-        if ((tmp = gnrc_pktbuf_add(pkt, &dodag->dodag_id, sizeof(ipv6_addr_t),
-                                   GNRC_NETTYPE_UNDEF)) == NULL) {
+        if ((tmp = gnrc_pktbuf_add_quota(pkt, &dodag->dodag_id, sizeof(ipv6_addr_t),
+                                         GNRC_NETTYPE_UNDEF,
+                                         GNRC_PKTBUF_QUOTA_CONTROL)) == NULL) {
             DEBUG("RPL: Send DAO - no space left in packet buffer\n");
             gnrc_pktbuf_release(pkt);
             return;
@@ -815,7 +843,9 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
         pkt = tmp;
     }
 
-    if ((tmp = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_dao_t), GNRC_NETTYPE_UNDEF)) == NULL) {
+    if ((tmp = gnrc_pktbuf_add_quota(pkt, NULL, sizeof(gnrc_rpl_dao_t),
+                                     GNRC_NETTYPE_UNDEF,
+                                     GNRC_PKTBUF_QUOTA_CONTROL)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
         return;
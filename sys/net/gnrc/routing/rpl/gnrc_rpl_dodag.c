@@ -22,6 +22,10 @@
 #include "net/gnrc/rpl/dodag.h"
 #include "net/gnrc/rpl/structs.h"
 #include "utlist.h"
+#ifdef MODULE_NETSTATS_NEIGHBOR
+#include "net/gnrc/ipv6/nc.h"
+#include "net/netstats/neighbor.h"
+#endif
 
 #include "net/gnrc/rpl.h"
 #ifdef MODULE_GNRC_RPL_P2P
@@ -39,6 +43,36 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *dodag);
 static void _rpl_trickle_send_dio(void *args);
 
+/**
+ * @brief   Installs the default route via @p parent
+ *
+ * With module `fib_multipath` other parents are installed as backup next hops,
+ * which take over as soon as the preferred parent is removed.
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ * @param[in] parent    Pointer to the parent
+ * @param[in] backup    Install the route as backup
+ * @param[in] lifetime  Lifetime of the route in ms
+ */
+static void _default_route_add(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent,
+                               bool backup, uint32_t lifetime)
+{
+#ifdef MODULE_FIB_MULTIPATH
+    fib_add_next_hop(&gnrc_ipv6_fib_table, dodag->iface,
+                     (uint8_t *) ipv6_addr_unspecified.u8, sizeof(ipv6_addr_t),
+                     0x00, parent->addr.u8, sizeof(ipv6_addr_t),
+                     FIB_FLAG_RPL_ROUTE, backup ? 0 : FIB_WEIGHT_DEFAULT,
+                     lifetime);
+#else
+    if (!backup) {
+        fib_add_entry(&gnrc_ipv6_fib_table, dodag->iface,
+                      (uint8_t *) ipv6_addr_unspecified.u8, sizeof(ipv6_addr_t),
+                      0x00, parent->addr.u8, sizeof(ipv6_addr_t),
+                      FIB_FLAG_RPL_ROUTE, lifetime);
+    }
+#endif
+}
+
 static void _rpl_trickle_send_dio(void *args)
 {
     gnrc_rpl_instance_t *inst = (gnrc_rpl_instance_t *) args;
@@ -218,23 +252,22 @@ bool gnrc_rpl_parent_remove(gnrc_rpl_parent_t *parent)
 
     gnrc_rpl_dodag_t *dodag = parent->dodag;
 
+#ifdef MODULE_FIB_MULTIPATH
+    fib_remove_next_hop(&gnrc_ipv6_fib_table, (uint8_t *) ipv6_addr_unspecified.u8,
+                        sizeof(ipv6_addr_t), parent->addr.u8, sizeof(ipv6_addr_t));
+#endif
     if (parent == dodag->parents) {
+#ifndef MODULE_FIB_MULTIPATH
         fib_remove_entry(&gnrc_ipv6_fib_table,
                          (uint8_t *) ipv6_addr_unspecified.u8,
                          sizeof(ipv6_addr_t));
+#endif
 
         /* set the default route to the next parent for now */
         if (parent->next) {
             uint32_t now = xtimer_now_usec() / SEC_IN_USEC;
-            fib_add_entry(&gnrc_ipv6_fib_table,
-                          dodag->iface,
-                          (uint8_t *) ipv6_addr_unspecified.u8,
-                          sizeof(ipv6_addr_t),
-                          0x0,
-                          parent->next->addr.u8,
-                          sizeof(ipv6_addr_t),
-                          FIB_FLAG_RPL_ROUTE,
-                          (parent->next->lifetime - now) * SEC_IN_MS);
+            _default_route_add(dodag, parent->next, false,
+                               (parent->next->lifetime - now) * SEC_IN_MS);
         }
     }
     LL_DELETE(dodag->parents, parent);
@@ -262,26 +295,57 @@ void gnrc_rpl_local_repair(gnrc_rpl_dodag_t *dodag)
     }
 }
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+/**
+ * @brief   Takes the ETX the interface estimated for @p parent as link metric
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ * @param[in] parent    Pointer to the parent
+ */
+static void _parent_update_link_metric(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
+{
+    netstats_nb_table_t *table;
+    const netstats_nb_t *nb;
+    gnrc_ipv6_nc_t *nc_entry;
+    eui64_t iid;
+    const uint8_t *l2addr = iid.uint8;
+    uint8_t l2addr_len = sizeof(iid);
+
+    if (gnrc_netapi_get(dodag->iface, NETOPT_STATS, NETSTATS_NEIGHBOR, &table,
+                        sizeof(table)) < 0) {
+        return;
+    }
+    nc_entry = gnrc_ipv6_nc_get(dodag->iface, &parent->addr);
+    if ((nc_entry != NULL) && (nc_entry->l2_addr_len > 0)) {
+        l2addr = nc_entry->l2_addr;
+        l2addr_len = nc_entry->l2_addr_len;
+    }
+    else {
+        /* frames to link-local addresses without NCE go to the EUI-64 in the IID */
+        memcpy(&iid, &parent->addr.u8[8], sizeof(iid));
+        iid.uint8[0] ^= 0x02;
+    }
+    if ((nb = netstats_nb_get(table, l2addr, l2addr_len)) != NULL) {
+        parent->link_metric = nb->etx;
+        parent->link_metric_type = GNRC_RPL_METRIC_ETX;
+    }
+}
+#endif
+
 void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
 {
     /* update Parent lifetime */
     if (parent != NULL) {
         uint32_t now = xtimer_now_usec();
+#ifdef MODULE_NETSTATS_NEIGHBOR
+        _parent_update_link_metric(dodag, parent);
+#endif
         parent->lifetime = (now / SEC_IN_USEC) + (dodag->default_lifetime * dodag->lifetime_unit);
 #ifdef MODULE_GNRC_RPL_P2P
         if (dodag->instance->mop != GNRC_RPL_P2P_MOP) {
 #endif
-        if (parent == dodag->parents) {
-            fib_add_entry(&gnrc_ipv6_fib_table,
-                          dodag->iface,
-                          (uint8_t *) ipv6_addr_unspecified.u8,
-                          sizeof(ipv6_addr_t),
-                          0x00,
-                          parent->addr.u8,
-                          sizeof(ipv6_addr_t),
-                          FIB_FLAG_RPL_ROUTE,
-                          (dodag->default_lifetime * dodag->lifetime_unit) * SEC_IN_MS);
-        }
+        _default_route_add(dodag, parent, (parent != dodag->parents),
+                           (dodag->default_lifetime * dodag->lifetime_unit) * SEC_IN_MS);
 #ifdef MODULE_GNRC_RPL_P2P
         }
 #endif
@@ -332,15 +396,13 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
 #ifdef MODULE_GNRC_RPL_P2P
     if (dodag->instance->mop != GNRC_RPL_P2P_MOP) {
 #endif
-        fib_add_entry(&gnrc_ipv6_fib_table,
-                      dodag->iface,
-                      (uint8_t *) ipv6_addr_unspecified.u8,
-                      sizeof(ipv6_addr_t),
-                      0x00,
-                      dodag->parents->addr.u8,
-                      sizeof(ipv6_addr_t),
-                      FIB_FLAG_RPL_ROUTE,
-                      (dodag->default_lifetime * dodag->lifetime_unit) * SEC_IN_MS);
+        uint32_t now = xtimer_now_usec() / SEC_IN_USEC;
+
+        /* the old preferred parent stays as backup */
+        _default_route_add(dodag, old_best, true,
+                           (old_best->lifetime - now) * SEC_IN_MS);
+        _default_route_add(dodag, new_best, false,
+                           (dodag->default_lifetime * dodag->lifetime_unit) * SEC_IN_MS);
 #ifdef MODULE_GNRC_RPL_P2P
     }
 #endif
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_rpl
+ * @{
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function.
+ *
+ * Implementation of MRHOF (RFC 6719) with the ETX the link layer estimates
+ * per neighbor (see @ref net_netstats_neighbor).
+ * @}
+ */
+
+#include "mrhof.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/structs.h"
+
+#ifdef MODULE_GNRC_RPL_MRHOF
+static uint16_t calc_rank(gnrc_rpl_parent_t *, uint16_t);
+static gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *, gnrc_rpl_dodag_t *);
+static void reset(gnrc_rpl_dodag_t *);
+
+static gnrc_rpl_of_t gnrc_rpl_mrhof = {
+    GNRC_RPL_MRHOF_OCP,
+    calc_rank,
+    which_parent,
+    which_dodag,
+    reset,
+    NULL,
+    NULL,
+    NULL
+};
+
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void)
+{
+    return &gnrc_rpl_mrhof;
+}
+
+/* converts an ETX into the rank increase over a link */
+static inline uint32_t _etx_to_rank(gnrc_rpl_parent_t *parent, uint32_t etx)
+{
+    return (etx * parent->dodag->instance->min_hop_rank_inc) / NETSTATS_NB_ETX_DIVISOR;
+}
+
+static uint32_t _link_cost(gnrc_rpl_parent_t *parent)
+{
+    uint32_t etx = parent->link_metric;
+    uint32_t cost;
+
+    if (etx == 0) {
+        etx = NETSTATS_NB_ETX_INIT;
+    }
+    if (etx > GNRC_RPL_MRHOF_MAX_LINK_METRIC) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+    cost = _etx_to_rank(parent, etx);
+    /* the rank has to increase by at least MinHopRankIncrease per hop */
+    if (cost < parent->dodag->instance->min_hop_rank_inc) {
+        cost = parent->dodag->instance->min_hop_rank_inc;
+    }
+    return cost;
+}
+
+static uint32_t _path_cost(gnrc_rpl_parent_t *parent)
+{
+    uint32_t cost;
+
+    if (parent->rank == GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+    cost = parent->rank + _link_cost(parent);
+    return (cost > GNRC_RPL_INFINITE_RANK) ? GNRC_RPL_INFINITE_RANK : cost;
+}
+
+void reset(gnrc_rpl_dodag_t *dodag)
+{
+    /* the link metrics are kept by the parents */
+    (void) dodag;
+}
+
+uint16_t calc_rank(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    uint32_t add;
+
+    if (base_rank == 0) {
+        if (parent == NULL) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+
+        base_rank = parent->rank;
+    }
+
+    if (parent != NULL) {
+        add = _link_cost(parent);
+    }
+    else {
+        add = GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+    }
+
+    if ((base_rank + add) >= GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    return base_rank + add;
+}
+
+/* Return the parent with the lower path cost, but only switch away from the
+ * preferred parent if the other one is better by the switch threshold */
+gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *p1, gnrc_rpl_parent_t *p2)
+{
+    gnrc_rpl_parent_t *preferred = p1->dodag->parents;
+    uint32_t c1 = _path_cost(p1);
+    uint32_t c2 = _path_cost(p2);
+    uint32_t threshold = _etx_to_rank(p1, GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD);
+
+    if (p1 == preferred) {
+        return ((c2 + threshold) < c1) ? p2 : p1;
+    }
+    if (p2 == preferred) {
+        return ((c1 + threshold) < c2) ? p1 : p2;
+    }
+    return (c1 <= c2) ? p1 : p2;
+}
+
+/* Not used yet */
+gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *d1, gnrc_rpl_dodag_t *d2)
+{
+    (void) d2;
+    return d1;
+}
+#endif /* MODULE_GNRC_RPL_MRHOF */
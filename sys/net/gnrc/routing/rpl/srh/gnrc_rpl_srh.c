@@ -12,9 +12,13 @@
  * @file
  */
 
+#include <errno.h>
 #include <string.h>
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/rpl/srh.h"
+#ifdef MODULE_GNRC_RPL_SRH_CACHE
+#include "xtimer.h"
+#endif
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -93,4 +97,150 @@ int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh)
     return EXT_RH_CODE_FORWARD;
 }
 
+#ifdef MODULE_FIB
+/* number of leading octets of b that equal a, at least one octet of b is
+ * always carried inline */
+static unsigned _common_octets(const uint8_t *a, const uint8_t *b)
+{
+    unsigned i = 0;
+
+    while ((i < (sizeof(ipv6_addr_t) - 1)) && (a[i] == b[i])) {
+        i++;
+    }
+    return i;
+}
+
+static int _build(fib_table_t *table, const ipv6_addr_t *dst, kernel_pid_t *iface,
+                  ipv6_addr_t *first_hop, uint8_t *buf, size_t buf_size,
+                  uint64_t *lifetime)
+{
+    uint8_t hops[GNRC_RPL_SRH_MAX_HOPS * UNIVERSAL_ADDRESS_SIZE];
+    size_t hops_numof = GNRC_RPL_SRH_MAX_HOPS, hop_size = UNIVERSAL_ADDRESS_SIZE;
+    uint32_t flags = 0;
+    fib_sr_t *sr = NULL;
+    gnrc_rpl_srh_t *rh = (gnrc_rpl_srh_t *)buf;
+    unsigned n, compri, compre, size, pad;
+    uint8_t *vec;
+    int res;
+
+    res = fib_sr_get_route(table, (uint8_t *)dst, sizeof(ipv6_addr_t), iface,
+                           &flags, hops, &hops_numof, &hop_size, false, &sr);
+    if (res < 0) {
+        return res;
+    }
+    if (hops_numof == 0) {
+        return -EHOSTUNREACH;
+    }
+    memcpy(first_hop, hops, sizeof(ipv6_addr_t));
+    *lifetime = sr->sr_lifetime;
+    /* the route's addresses are in order, the last one is the destination */
+    n = hops_numof - 1;
+    if (n == 0) {
+        return 0;
+    }
+    /* every hop restores the elided octets of the next address from the
+     * current destination, i.e. the address before it in the route */
+    compre = _common_octets(&hops[(n - 1) * hop_size], &hops[n * hop_size]);
+    /* with only one address CmprI does not matter */
+    compri = (n > 1) ? (sizeof(ipv6_addr_t) - 1) : compre;
+    for (unsigned i = 1; i < n; i++) {
+        unsigned common = _common_octets(&hops[(i - 1) * hop_size],
+                                         &hops[i * hop_size]);
+
+        if (common < compri) {
+            compri = common;
+        }
+    }
+    size = sizeof(gnrc_rpl_srh_t) + ((n - 1) * (sizeof(ipv6_addr_t) - compri)) +
+           (sizeof(ipv6_addr_t) - compre);
+    pad = (8 - (size & 0x7)) & 0x7;
+    if ((size + pad) > buf_size) {
+        return -ENOBUFS;
+    }
+
+    rh->nh = 0;
+    rh->len = ((size + pad) / 8) - 1;
+    rh->type = GNRC_RPL_SRH_TYPE;
+    rh->seg_left = n;
+    rh->compr = (compri << 4) | compre;
+    rh->pad_resv = pad << 4;
+    rh->resv = 0;
+    vec = (uint8_t *)(rh + 1);
+    for (unsigned i = 1; i < n; i++) {
+        memcpy(vec, &hops[(i * hop_size) + compri], sizeof(ipv6_addr_t) - compri);
+        vec += sizeof(ipv6_addr_t) - compri;
+    }
+    memcpy(vec, &hops[(n * hop_size) + compre], sizeof(ipv6_addr_t) - compre);
+    vec += sizeof(ipv6_addr_t) - compre;
+    memset(vec, 0, pad);
+
+    DEBUG("RPL SRH: built header with %u addresses (CmprI: %u, CmprE: %u)\n",
+          n, compri, compre);
+    return size + pad;
+}
+
+#ifdef MODULE_GNRC_RPL_SRH_CACHE
+typedef struct {
+    fib_table_t *table;
+    ipv6_addr_t dst;
+    ipv6_addr_t first_hop;
+    uint64_t expires;           /* lifetime of the source route, 0 if unused */
+    unsigned gen;               /* fib_table_t::sr_gen when built */
+    kernel_pid_t iface;
+    uint16_t len;
+    uint8_t hdr[GNRC_RPL_SRH_MAX_LEN];
+} _cache_entry_t;
+
+static _cache_entry_t _cache[GNRC_RPL_SRH_CACHE_SIZE];
+static unsigned _cache_next;    /* next entry to replace */
+#endif
+
+int gnrc_rpl_srh_build(fib_table_t *table, const ipv6_addr_t *dst,
+                       kernel_pid_t *iface, ipv6_addr_t *first_hop,
+                       void *buf, size_t buf_size)
+{
+    uint64_t lifetime;
+    int res;
+#ifdef MODULE_GNRC_RPL_SRH_CACHE
+    /* read before building, so a change in between is never cached */
+    unsigned gen = table->sr_gen;
+    uint64_t now = xtimer_now_usec64();
+    _cache_entry_t *entry;
+
+    for (unsigned i = 0; i < GNRC_RPL_SRH_CACHE_SIZE; i++) {
+        entry = &_cache[i];
+        if ((entry->table == table) && (entry->gen == gen) &&
+            (entry->expires > now) && ipv6_addr_equal(&entry->dst, dst)) {
+            if (entry->len > buf_size) {
+                return -ENOBUFS;
+            }
+            *iface = entry->iface;
+            *first_hop = entry->first_hop;
+            memcpy(buf, entry->hdr, entry->len);
+            return entry->len;
+        }
+    }
+#endif
+
+    res = _build(table, dst, iface, first_hop, buf, buf_size, &lifetime);
+#ifdef MODULE_GNRC_RPL_SRH_CACHE
+    if (res >= 0) {
+        entry = &_cache[_cache_next];
+        entry->table = table;
+        entry->dst = *dst;
+        entry->first_hop = *first_hop;
+        entry->expires = lifetime;
+        entry->gen = gen;
+        entry->iface = *iface;
+        entry->len = res;
+        memcpy(entry->hdr, buf, res);
+        _cache_next = (_cache_next + 1) % GNRC_RPL_SRH_CACHE_SIZE;
+    }
+#else
+    (void)lifetime;
+#endif
+    return res;
+}
+#endif /* MODULE_FIB */
+
 /** @} */
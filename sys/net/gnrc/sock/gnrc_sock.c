@@ -15,11 +15,15 @@
 
 #include <errno.h>
 
+#include "irq.h"
 #include "net/af.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/netreg.h"
+#ifdef MODULE_GNRC_PKTTRACE
+#include "net/gnrc/pkttrace.h"
+#endif
 #include "net/udp.h"
 #include "utlist.h"
 #include "xtimer.h"
@@ -27,27 +31,82 @@
 #include "sock_types.h"
 #include "gnrc_sock_internal.h"
 
-#ifdef MODULE_XTIMER
-#define _TIMEOUT_MAGIC      (0xF38A0B63U)
-#define _TIMEOUT_MSG_TYPE   (0x8474)
+#ifdef MODULE_GNRC_SOCK_ASYNC
+static void _netreg_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    gnrc_sock_reg_t *reg = ctx;
+    msg_t msg;
+
+    msg.type = cmd;
+    msg.content.ptr = pkt;
+    if (!mbox_try_put(&reg->mbox, &msg)) {
+        reg->entry.drops++;
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (reg->async_cb == NULL) {
+        return;
+    }
+#ifdef MODULE_EVENT
+    if (reg->event_queue != NULL) {
+        /* already queued events are not queued again */
+        event_post(reg->event_queue, &reg->event);
+        return;
+    }
+#endif
+    reg->async_cb(reg);
+}
 
-static void _callback_put(void *arg)
+#ifdef MODULE_EVENT
+static void _event_handler(event_t *event)
 {
-    msg_t timeout_msg = { .sender_pid = KERNEL_PID_UNDEF,
-                          .type = _TIMEOUT_MSG_TYPE,
-                          .content = { .value = _TIMEOUT_MAGIC } };
-    gnrc_sock_reg_t *reg = arg;
-
-    /* should be safe, because otherwise if mbox were filled this callback is
-     * senseless */
-    mbox_try_put(&reg->mbox, &timeout_msg);
+    gnrc_sock_reg_t *reg = container_of(event, gnrc_sock_reg_t, event);
+
+    if (reg->async_cb != NULL) {
+        reg->async_cb(reg);
+    }
+}
+#endif
+
+void gnrc_sock_async_set(gnrc_sock_reg_t *reg,
+                         void (*async_cb)(gnrc_sock_reg_t *reg),
+                         void *queue)
+{
+    unsigned state = irq_disable();
+
+#ifdef MODULE_EVENT
+    reg->event.handler = _event_handler;
+    reg->event_queue = queue;
+#else
+    assert(queue == NULL);
+#endif
+    reg->async_cb = async_cb;
+    irq_restore(state);
+}
+
+void gnrc_sock_async_close(gnrc_sock_reg_t *reg)
+{
+#ifdef MODULE_EVENT
+    if (reg->event_queue != NULL) {
+        event_cancel(reg->event_queue, &reg->event);
+    }
+#endif
+    gnrc_sock_async_clear(reg);
 }
 #endif
 
 void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx)
 {
     mbox_init(&reg->mbox, reg->mbox_queue, SOCK_MBOX_SIZE);
+    reg->high_water = 0;
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    /* fill the mbox from a callback to notify the owner */
+    reg->netreg_cb.cb = _netreg_cb;
+    reg->netreg_cb.ctx = reg;
+    gnrc_netreg_entry_init_cb(&reg->entry, demux_ctx, &reg->netreg_cb);
+#else
     gnrc_netreg_entry_init_mbox(&reg->entry, demux_ctx, &reg->mbox);
+#endif
     gnrc_netreg_register(type, &reg->entry);
 }
 
@@ -57,36 +116,30 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
     gnrc_pktsnip_t *pkt, *ip, *netif;
     msg_t msg;
 
-#ifdef MODULE_XTIMER
-    xtimer_t timeout_timer;
-
-    if ((timeout != SOCK_NO_TIMEOUT) && (timeout != 0)) {
-        timeout_timer.callback = _callback_put;
-        timeout_timer.arg = reg;
-        xtimer_set(&timeout_timer, timeout);
-    }
-#endif
-    if (timeout != 0) {
-        mbox_get(&reg->mbox, &msg);
-    }
-    else {
+    if (timeout == 0) {
         if (!mbox_try_get(&reg->mbox, &msg)) {
             return -EAGAIN;
         }
     }
 #ifdef MODULE_XTIMER
-    xtimer_remove(&timeout_timer);
+    else if (timeout != SOCK_NO_TIMEOUT) {
+        if (xtimer_mbox_get_timeout(&reg->mbox, &msg, timeout) < 0) {
+            return -ETIMEDOUT;
+        }
+    }
 #endif
+    else {
+        mbox_get(&reg->mbox, &msg);
+    }
+    /* the queue is fullest right before a packet is taken from it */
+    unsigned queued = cib_avail(&reg->mbox.cib) + 1;
+    if (queued > reg->high_water) {
+        reg->high_water = queued;
+    }
     switch (msg.type) {
         case GNRC_NETAPI_MSG_TYPE_RCV:
             pkt = msg.content.ptr;
             break;
-#ifdef MODULE_XTIMER
-        case _TIMEOUT_MSG_TYPE:
-            if (msg.content.value == _TIMEOUT_MAGIC) {
-                return -ETIMEDOUT;
-            }
-#endif
         default:
             return -EINTR;
     }
@@ -107,12 +160,15 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
         /* TODO: use API in #5511 */
         remote->netif = (uint16_t)netif_hdr->if_pid;
     }
+#ifdef MODULE_GNRC_PKTTRACE
+    gnrc_pkttrace_hop(pkt, GNRC_PKTTRACE_RX_SOCK);
+#endif
     *pkt_out = pkt; /* set out parameter */
     return 0;
 }
 
 ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
-                       const sock_ip_ep_t *remote, uint8_t nh)
+                       const sock_ip_ep_t *remote, uint8_t nh, uint8_t tc)
 {
     gnrc_pktsnip_t *pkt;
     kernel_pid_t iface = KERNEL_PID_UNDEF;
@@ -141,11 +197,13 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
             }
             hdr = pkt->data;
             hdr->nh = nh;
+            ipv6_hdr_set_tc(hdr, tc);
             break;
         }
 #endif
         default:
             (void)nh;
+            (void)tc;
             gnrc_pktbuf_release(payload);
             return -EAFNOSUPPORT;
     }
@@ -171,6 +229,9 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
     }
 #ifdef MODULE_GNRC_NETERR
     gnrc_neterr_reg(pkt);   /* no error should occur since pkt was created here */
+#endif
+#ifdef MODULE_GNRC_PKTTRACE
+    gnrc_pkttrace_start(pkt, xtimer_now_usec());
 #endif
     if (!gnrc_netapi_dispatch_send(type, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
         /* this should not happen, but just in case */
@@ -194,4 +255,40 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
     return payload_len;
 }
 
+int gnrc_sock_set_queue(gnrc_sock_reg_t *reg, msg_t *queue, unsigned size)
+{
+    cib_t cib = CIB_INIT(size);
+    unsigned state;
+    int idx;
+
+    assert((queue != NULL) && (size > 0) && ((size & (size - 1)) == 0));
+    state = irq_disable();
+    if (cib_avail(&reg->mbox.cib) > size) {
+        irq_restore(state);
+        return -ENOBUFS;
+    }
+    while ((idx = cib_get(&reg->mbox.cib)) >= 0) {
+        queue[cib_put(&cib)] = reg->mbox.msg_array[idx];
+    }
+    /* waiting readers stay registered with the mbox */
+    reg->mbox.cib = cib;
+    reg->mbox.msg_array = queue;
+    irq_restore(state);
+    return 0;
+}
+
+void gnrc_sock_get_queue_stats(gnrc_sock_reg_t *reg,
+                               gnrc_sock_queue_stats_t *stats)
+{
+    unsigned state = irq_disable();
+
+    stats->drops = reg->entry.drops;
+    stats->queued = cib_avail(&reg->mbox.cib);
+    stats->size = reg->mbox.cib.mask + 1;
+    /* packets still queued may exceed what was seen on reception */
+    stats->high_water = (stats->queued > reg->high_water) ? stats->queued
+                                                          : reg->high_water;
+    irq_restore(state);
+}
+
 /** @} */
@@ -67,6 +67,39 @@ static inline bool gnrc_ep_addr_any(const sock_ip_ep_t *ep)
     return true;
 }
 
+/**
+ * @brief   Clear the asynchronous callbacks of a sock internally
+ * @internal
+ */
+static inline void gnrc_sock_async_clear(gnrc_sock_reg_t *reg)
+{
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    reg->async_cb = NULL;
+#ifdef MODULE_EVENT
+    reg->event_queue = NULL;
+#endif
+#else
+    (void)reg;
+#endif
+}
+
+#if defined(MODULE_GNRC_SOCK_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Set the type-specific dispatcher of asynchronous callbacks
+ *          internally
+ * @internal
+ */
+void gnrc_sock_async_set(gnrc_sock_reg_t *reg,
+                         void (*async_cb)(gnrc_sock_reg_t *reg),
+                         void *queue);
+
+/**
+ * @brief   Stop asynchronous callbacks of a closed sock internally
+ * @internal
+ */
+void gnrc_sock_async_close(gnrc_sock_reg_t *reg);
+#endif
+
 /**
  * @brief   Create a sock internally
  * @internal
@@ -81,11 +114,24 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt, uint32_t time
                        sock_ip_ep_t *remote);
 
 /**
- * @brief   Send a packet internally
+ * @brief   Send a packet internally, with IP traffic class @p tc
  * @internal
  */
 ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
-                       const sock_ip_ep_t *remote, uint8_t nh);
+                       const sock_ip_ep_t *remote, uint8_t nh, uint8_t tc);
+
+/**
+ * @brief   Replace the receive queue internally
+ * @internal
+ */
+int gnrc_sock_set_queue(gnrc_sock_reg_t *reg, msg_t *queue, unsigned size);
+
+/**
+ * @brief   Get the receive queue statistics internally
+ * @internal
+ */
+void gnrc_sock_get_queue_stats(gnrc_sock_reg_t *reg,
+                               gnrc_sock_queue_stats_t *stats);
 /**
  * @}
  */
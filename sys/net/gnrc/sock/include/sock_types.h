@@ -26,18 +26,32 @@
 #include <stdint.h>
 
 #include "mbox.h"
+#ifdef MODULE_EVENT
+#include "event.h"
+#endif
 #include "net/af.h"
 #include "net/gnrc.h"
 #include "net/gnrc/netreg.h"
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
+#ifdef MODULE_GNRC_SOCK_TCP
+#include "net/gnrc/tcp.h"
+#include "net/sock/tcp.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Size for gnrc_sock_reg_t::mbox_queue
+ *
+ * Every sock carries a queue of this size. Socks that need a deeper queue
+ * can be given one with gnrc_sock_udp_set_queue() or gnrc_sock_ip_set_queue(),
+ * so this can be kept small for the other socks.
+ */
 #ifndef SOCK_MBOX_SIZE
-#define SOCK_MBOX_SIZE      (8)         /**< Size for gnrc_sock_reg_t::mbox_queue */
+#define SOCK_MBOX_SIZE      (8)
 #endif
 
 /**
@@ -51,8 +65,52 @@ typedef struct gnrc_sock_reg {
     gnrc_netreg_entry_t entry;          /**< @ref net_gnrc_netreg entry for mbox */
     mbox_t mbox;                        /**< @ref core_mbox target for the sock */
     msg_t mbox_queue[SOCK_MBOX_SIZE];   /**< queue for gnrc_sock_reg_t::mbox */
+    uint16_t high_water;                /**< most packets queued at once */
+#if defined(MODULE_GNRC_SOCK_ASYNC) || defined(DOXYGEN)
+    /**
+     * @brief   netreg callback that fills gnrc_sock_reg_t::mbox
+     */
+    gnrc_netreg_entry_cbd_t netreg_cb;
+    /**
+     * @brief   Calls the user callback of the sock type, NULL if none is set
+     */
+    void (*async_cb)(struct gnrc_sock_reg *reg);
+#if defined(MODULE_EVENT) || defined(DOXYGEN)
+    event_t event;                      /**< event to run async_cb in */
+    event_queue_t *event_queue;         /**< queue for gnrc_sock_reg_t::event,
+                                         *   NULL to call async_cb directly */
+#endif
+#endif
 } gnrc_sock_reg_t;
 
+/**
+ * @brief   Callback for received packets of a raw IPv4/IPv6 sock
+ *
+ * @param[in] sock  The sock that received a packet. Take it with
+ *                  sock_ip_recv() and timeout 0.
+ * @param[in] arg   Argument given with the callback.
+ */
+typedef void (*gnrc_sock_ip_cb_t)(sock_ip_t *sock, void *arg);
+
+/**
+ * @brief   Callback for received messages of a UDP sock
+ *
+ * @param[in] sock  The sock that received a message. Take it with
+ *                  sock_udp_recv() and timeout 0.
+ * @param[in] arg   Argument given with the callback.
+ */
+typedef void (*gnrc_sock_udp_cb_t)(sock_udp_t *sock, void *arg);
+
+/**
+ * @brief   Statistics of the receive queue of a sock
+ */
+typedef struct {
+    unsigned drops;         /**< packets dropped because the queue was full */
+    unsigned high_water;    /**< most packets queued at once */
+    unsigned queued;        /**< packets currently queued */
+    unsigned size;          /**< size of the queue */
+} gnrc_sock_queue_stats_t;
+
 /**
  * @brief   Raw IP sock type
  * @internal
@@ -62,6 +120,10 @@ struct sock_ip {
     sock_ip_ep_t local;                 /**< local end-point */
     sock_ip_ep_t remote;                /**< remote end-point */
     uint16_t flags;                     /**< option flags */
+#if defined(MODULE_GNRC_SOCK_ASYNC) || defined(DOXYGEN)
+    gnrc_sock_ip_cb_t async_cb;         /**< callback on reception */
+    void *async_arg;                    /**< argument of sock_ip::async_cb */
+#endif
 };
 
 /**
@@ -73,8 +135,225 @@ struct sock_udp {
     sock_udp_ep_t local;                /**< local end-point */
     sock_udp_ep_t remote;               /**< remote end-point */
     uint16_t flags;                     /**< option flags */
+    uint8_t tc;                         /**< IP traffic class of sent packets */
+#if defined(MODULE_GNRC_SOCK_ASYNC) || defined(DOXYGEN)
+    gnrc_sock_udp_cb_t async_cb;        /**< callback on reception */
+    void *async_arg;                    /**< argument of sock_udp::async_cb */
+#endif
 };
 
+#if defined(MODULE_GNRC_SOCK_TCP) || defined(DOXYGEN)
+/**
+ * @brief   TCP sock type
+ * @internal
+ */
+struct sock_tcp {
+    gnrc_tcp_tcb_t tcb;                 /**< the connection */
+};
+
+/**
+ * @brief   TCP queue type
+ * @internal
+ */
+struct sock_tcp_queue {
+    gnrc_tcp_listener_t listener;       /**< the listener */
+};
+#endif
+
+/**
+ * @brief   Sends a pre-built payload as UDP message to remote end point
+ *
+ * Like sock_udp_send(), but the payload is already in the packet buffer, so
+ * it is not copied again.
+ *
+ * @param[in] sock      A UDP sock object. May be NULL.
+ * @param[in] payload   Payload of the message. Is released on error and
+ *                      handed to the stack on success.
+ * @param[in] remote    Remote end point for the sent data.
+ *
+ * @return  The number of bytes sent on success.
+ * @return  see sock_udp_send() for the errors.
+ */
+ssize_t gnrc_sock_udp_send_pkt(sock_udp_t *sock, gnrc_pktsnip_t *payload,
+                               const sock_udp_ep_t *remote);
+
+/**
+ * @brief   Replaces the receive queue of a raw IPv4/IPv6 sock
+ *
+ * Packets already queued are moved to @p queue.
+ *
+ * @pre `(sock != NULL) && (queue != NULL)`
+ * @pre @p size is a power of two
+ *
+ * @param[in] sock      A raw IPv4/IPv6 sock object.
+ * @param[in] queue     The new queue. Must stay valid until the sock is
+ *                      closed.
+ * @param[in] size      Number of elements in @p queue.
+ *
+ * @return  0 on success.
+ * @return  -ENOBUFS, if more packets than @p size are currently queued.
+ */
+int gnrc_sock_ip_set_queue(sock_ip_t *sock, msg_t *queue, unsigned size);
+
+/**
+ * @brief   Get the receive queue statistics of a raw IPv4/IPv6 sock
+ *
+ * @pre `(sock != NULL) && (stats != NULL)`
+ *
+ * @param[in] sock      A raw IPv4/IPv6 sock object.
+ * @param[out] stats    The statistics.
+ */
+void gnrc_sock_ip_get_queue_stats(sock_ip_t *sock,
+                                  gnrc_sock_queue_stats_t *stats);
+
+/**
+ * @brief   Replaces the receive queue of a UDP sock
+ *
+ * Packets already queued are moved to @p queue.
+ *
+ * @pre `(sock != NULL) && (queue != NULL)`
+ * @pre @p size is a power of two
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in] queue     The new queue. Must stay valid until the sock is
+ *                      closed.
+ * @param[in] size      Number of elements in @p queue.
+ *
+ * @return  0 on success.
+ * @return  -EADDRNOTAVAIL, if @p sock has no local end point (yet).
+ * @return  -ENOBUFS, if more packets than @p size are currently queued.
+ */
+int gnrc_sock_udp_set_queue(sock_udp_t *sock, msg_t *queue, unsigned size);
+
+/**
+ * @brief   Get the receive queue statistics of a UDP sock
+ *
+ * @pre `(sock != NULL) && (stats != NULL)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[out] stats    The statistics.
+ *
+ * @return  0 on success.
+ * @return  -EADDRNOTAVAIL, if @p sock has no local end point (yet).
+ */
+int gnrc_sock_udp_get_queue_stats(sock_udp_t *sock,
+                                  gnrc_sock_queue_stats_t *stats);
+
+/**
+ * @brief   Sets the IP traffic class of the packets sent with a UDP sock
+ *
+ * The stack derives the priority of a packet from its traffic class, see
+ * gnrc_netif_hdr_prio_from_tc(). With module `gnrc_netapi_prio` the GNRC
+ * threads and the MAC queues serve packets with e.g. expedited forwarding
+ * (`tc = 46 << 2`) before all others, so alarms get through under
+ * congestion.
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock  A UDP sock object.
+ * @param[in] tc    The traffic class, DSCP in the upper 6 bits. Defaults to 0.
+ */
+void gnrc_sock_udp_set_tc(sock_udp_t *sock, uint8_t tc);
+
+/**
+ * @brief   Gets the largest payload a UDP sock can send to a remote without
+ *          exceeding the path MTU
+ *
+ * This is the MTU of the sending interface, lowered by a path MTU learned
+ * from ICMPv6 Packet Too Big messages with module `gnrc_ipv6_pmtu`, minus
+ * the IPv6 and UDP headers. If the interface is not known, i.e. neither
+ * @p sock nor @p remote are bound to one and there is more than one
+ * interface, IPV6_MIN_MTU is assumed for the link.
+ *
+ * @pre `((sock != NULL) || (remote != NULL))`
+ *
+ * @param[in] sock      A UDP sock object. May be NULL.
+ * @param[in] remote    Remote end point. May be NULL, if @p sock has a
+ *                      remote end point.
+ *
+ * @return  The maximum payload size in bytes.
+ * @return  -ENOTCONN, if neither @p remote nor the remote end point of
+ *          @p sock is set.
+ */
+ssize_t gnrc_sock_udp_get_max_payload(sock_udp_t *sock,
+                                      const sock_udp_ep_t *remote);
+
+#if defined(MODULE_GNRC_SOCK_ASYNC) || defined(DOXYGEN)
+/**
+ * @brief   Sets the reception callback of a raw IPv4/IPv6 sock
+ *
+ * @p cb is called in the context of the network stack thread that delivers
+ * the packet, so it should only hand the work off. The packet is queued in
+ * the sock as usual before.
+ *
+ * @note    Only available with module `gnrc_sock_async`.
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock  A raw IPv4/IPv6 sock object, after sock_ip_create().
+ * @param[in] cb    The callback. NULL to remove the callback.
+ * @param[in] arg   Argument for @p cb.
+ */
+void gnrc_sock_ip_set_cb(sock_ip_t *sock, gnrc_sock_ip_cb_t cb, void *arg);
+
+/**
+ * @brief   Sets the reception callback of a UDP sock
+ *
+ * @p cb is called in the context of the network stack thread that delivers
+ * the message, so it should only hand the work off. The message is queued in
+ * the sock as usual before.
+ *
+ * @note    Only available with module `gnrc_sock_async`.
+ *
+ * @pre `(sock != NULL)`
+ *
+ * @param[in] sock  A UDP sock object, after sock_udp_create().
+ * @param[in] cb    The callback. NULL to remove the callback.
+ * @param[in] arg   Argument for @p cb.
+ */
+void gnrc_sock_udp_set_cb(sock_udp_t *sock, gnrc_sock_udp_cb_t cb, void *arg);
+
+#if defined(MODULE_EVENT) || defined(DOXYGEN)
+/**
+ * @brief   Handles the receptions of a raw IPv4/IPv6 sock in an event queue
+ *
+ * @p cb is called by the thread of @p queue. It is called once for any
+ * number of packets that arrived since its last call, so it should take
+ * packets with timeout 0 until there are none left.
+ *
+ * @note    Only available with modules `gnrc_sock_async` and `event`.
+ *
+ * @pre `(sock != NULL) && (queue != NULL) && (cb != NULL)`
+ *
+ * @param[in] sock  A raw IPv4/IPv6 sock object, after sock_ip_create().
+ * @param[in] queue The event queue.
+ * @param[in] cb    The callback.
+ * @param[in] arg   Argument for @p cb.
+ */
+void gnrc_sock_ip_event_init(sock_ip_t *sock, event_queue_t *queue,
+                             gnrc_sock_ip_cb_t cb, void *arg);
+
+/**
+ * @brief   Handles the receptions of a UDP sock in an event queue
+ *
+ * @p cb is called by the thread of @p queue. It is called once for any
+ * number of messages that arrived since its last call, so it should take
+ * messages with timeout 0 until there are none left.
+ *
+ * @note    Only available with modules `gnrc_sock_async` and `event`.
+ *
+ * @pre `(sock != NULL) && (queue != NULL) && (cb != NULL)`
+ *
+ * @param[in] sock  A UDP sock object, after sock_udp_create().
+ * @param[in] queue The event queue.
+ * @param[in] cb    The callback.
+ * @param[in] arg   Argument for @p cb.
+ */
+void gnrc_sock_udp_event_init(sock_udp_t *sock, event_queue_t *queue,
+                              gnrc_sock_udp_cb_t cb, void *arg);
+#endif
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -53,6 +53,7 @@ int sock_ip_create(sock_ip_t *sock, const sock_ip_ep_t *local,
         }
         memcpy(&sock->remote, remote, sizeof(sock_ip_ep_t));
     }
+    gnrc_sock_async_clear(&sock->reg);
     gnrc_sock_create(&sock->reg, GNRC_NETTYPE_IPV6,
                      proto);
     sock->flags = flags;
@@ -63,6 +64,9 @@ void sock_ip_close(sock_ip_t *sock)
 {
     assert(sock != NULL);
     gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, &sock->reg.entry);
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    gnrc_sock_async_close(&sock->reg);
+#endif
 }
 
 int sock_ip_get_local(sock_ip_t *sock, sock_ip_ep_t *local)
@@ -75,6 +79,47 @@ int sock_ip_get_local(sock_ip_t *sock, sock_ip_ep_t *local)
     return 0;
 }
 
+int gnrc_sock_ip_set_queue(sock_ip_t *sock, msg_t *queue, unsigned size)
+{
+    assert(sock != NULL);
+    return gnrc_sock_set_queue(&sock->reg, queue, size);
+}
+
+void gnrc_sock_ip_get_queue_stats(sock_ip_t *sock,
+                                  gnrc_sock_queue_stats_t *stats)
+{
+    assert((sock != NULL) && (stats != NULL));
+    gnrc_sock_get_queue_stats(&sock->reg, stats);
+}
+
+#ifdef MODULE_GNRC_SOCK_ASYNC
+static void _async_cb(gnrc_sock_reg_t *reg)
+{
+    sock_ip_t *sock = (sock_ip_t *)reg;
+
+    sock->async_cb(sock, sock->async_arg);
+}
+
+void gnrc_sock_ip_set_cb(sock_ip_t *sock, gnrc_sock_ip_cb_t cb, void *arg)
+{
+    assert(sock != NULL);
+    sock->async_cb = cb;
+    sock->async_arg = arg;
+    gnrc_sock_async_set(&sock->reg, (cb != NULL) ? _async_cb : NULL, NULL);
+}
+
+#ifdef MODULE_EVENT
+void gnrc_sock_ip_event_init(sock_ip_t *sock, event_queue_t *queue,
+                             gnrc_sock_ip_cb_t cb, void *arg)
+{
+    assert((sock != NULL) && (queue != NULL) && (cb != NULL));
+    sock->async_cb = cb;
+    sock->async_arg = arg;
+    gnrc_sock_async_set(&sock->reg, _async_cb, queue);
+}
+#endif
+#endif
+
 int sock_ip_get_remote(sock_ip_t *sock, sock_ip_ep_t *remote)
 {
     assert(sock && remote);
@@ -189,7 +234,7 @@ ssize_t sock_ip_send(sock_ip_t *sock, const void *data, size_t len,
     if (pkt == NULL) {
         return -ENOMEM;
     }
-    res = gnrc_sock_send(pkt, &local, &rem, proto);
+    res = gnrc_sock_send(pkt, &local, &rem, proto, 0);
     if (res <= 0) {
         return res;
     }
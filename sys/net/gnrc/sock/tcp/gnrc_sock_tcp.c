@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       GNRC implementation of @ref net_sock_tcp
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "net/sock/tcp.h"
+
+#include "gnrc_sock_internal.h"
+
+static void _set_ep(sock_tcp_ep_t *ep, const ipv6_addr_t *addr, uint16_t port,
+                    kernel_pid_t netif)
+{
+    ep->family = AF_INET6;
+    memcpy(&ep->addr.ipv6, addr, sizeof(ipv6_addr_t));
+    ep->port = port;
+    /* TODO: use API in #5511 */
+    ep->netif = (netif == KERNEL_PID_UNDEF) ? SOCK_ADDR_ANY_NETIF : (uint16_t)netif;
+}
+
+int sock_tcp_connect(sock_tcp_t *sock, const sock_tcp_ep_t *remote,
+                     uint16_t local_port, uint16_t flags)
+{
+    assert((sock != NULL) && (remote != NULL) && (remote->port != 0));
+    (void)flags;
+    if (gnrc_af_not_supported(remote->family)) {
+        return -EAFNOSUPPORT;
+    }
+    if (ipv6_addr_is_unspecified((ipv6_addr_t *)&remote->addr.ipv6) ||
+        ipv6_addr_is_multicast((ipv6_addr_t *)&remote->addr.ipv6)) {
+        return -EINVAL;
+    }
+    /* TODO: use API in #5511 */
+    return gnrc_tcp_connect(&sock->tcb, (ipv6_addr_t *)&remote->addr.ipv6,
+                            remote->port,
+                            (remote->netif == SOCK_ADDR_ANY_NETIF) ?
+                            KERNEL_PID_UNDEF : (kernel_pid_t)remote->netif,
+                            local_port);
+}
+
+int sock_tcp_listen(sock_tcp_queue_t *queue, const sock_tcp_ep_t *local,
+                    sock_tcp_t *queue_array, unsigned queue_len,
+                    uint16_t flags)
+{
+    const ipv6_addr_t *addr = (const ipv6_addr_t *)&local->addr.ipv6;
+
+    assert((queue != NULL) && (local != NULL) && (local->port != 0));
+    assert((queue_array != NULL) && (queue_len != 0));
+    (void)flags;
+    if (gnrc_af_not_supported(local->family)) {
+        return -EAFNOSUPPORT;
+    }
+    /* sock_tcp_t only wraps gnrc_tcp_tcb_t, so the array can be handed on */
+    return gnrc_tcp_listen(&queue->listener,
+                           ipv6_addr_is_unspecified(addr) ? NULL : addr,
+                           local->port, &queue_array->tcb, queue_len);
+}
+
+void sock_tcp_disconnect(sock_tcp_t *sock)
+{
+    assert(sock != NULL);
+    gnrc_tcp_close(&sock->tcb);
+}
+
+void sock_tcp_stop_listen(sock_tcp_queue_t *queue)
+{
+    assert(queue != NULL);
+    gnrc_tcp_stop_listen(&queue->listener);
+}
+
+int sock_tcp_get_local(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+    if (sock->tcb.local_port == 0) {
+        return -EADDRNOTAVAIL;
+    }
+    _set_ep(ep, &sock->tcb.local_addr, sock->tcb.local_port, sock->tcb.netif);
+    return 0;
+}
+
+int sock_tcp_get_remote(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+    if (sock->tcb.peer_port == 0) {
+        return -ENOTCONN;
+    }
+    _set_ep(ep, &sock->tcb.peer_addr, sock->tcb.peer_port, sock->tcb.netif);
+    return 0;
+}
+
+int sock_tcp_queue_get_local(sock_tcp_queue_t *queue, sock_tcp_ep_t *ep)
+{
+    assert((queue != NULL) && (ep != NULL));
+    if (queue->listener.local_port == 0) {
+        return -EADDRNOTAVAIL;
+    }
+    _set_ep(ep, &queue->listener.local_addr, queue->listener.local_port,
+            KERNEL_PID_UNDEF);
+    return 0;
+}
+
+int sock_tcp_accept(sock_tcp_queue_t *queue, sock_tcp_t **sock,
+                    uint32_t timeout)
+{
+    gnrc_tcp_tcb_t *tcb;
+    int res;
+
+    assert((queue != NULL) && (sock != NULL));
+    if (queue->listener.tcbs == NULL) {
+        return -EINVAL;
+    }
+    if ((res = gnrc_tcp_accept(&queue->listener, &tcb, timeout)) < 0) {
+        return res;
+    }
+    *sock = container_of(tcb, sock_tcp_t, tcb);
+    return 0;
+}
+
+ssize_t sock_tcp_read(sock_tcp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout)
+{
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    return gnrc_tcp_recv(&sock->tcb, data, max_len, timeout);
+}
+
+ssize_t sock_tcp_write(sock_tcp_t *sock, const void *data, size_t len)
+{
+    assert(sock != NULL);
+    assert((len == 0) || (data != NULL));
+    return gnrc_tcp_send(&sock->tcb, data, len);
+}
+
+/** @} */
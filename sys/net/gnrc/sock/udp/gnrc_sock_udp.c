@@ -21,6 +21,11 @@
 #include "net/af.h"
 #include "net/protnum.h"
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/netif.h"
+#ifdef MODULE_GNRC_IPV6_PMTU
+#include "net/gnrc/ipv6/pmtu.h"
+#endif
+#include "net/gnrc/netif.h"
 #include "net/gnrc/udp.h"
 #include "net/sock/udp.h"
 #include "net/udp.h"
@@ -74,12 +79,14 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
         }
         memcpy(&sock->remote, remote, sizeof(sock_udp_ep_t));
     }
+    gnrc_sock_async_clear(&sock->reg);
     if (local != NULL) {
         /* listen only with local given */
         gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP,
                          local->port);
     }
     sock->flags = flags;
+    sock->tc = 0;
     return 0;
 }
 
@@ -87,6 +94,9 @@ void sock_udp_close(sock_udp_t *sock)
 {
     assert(sock != NULL);
     gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &sock->reg.entry);
+#ifdef MODULE_GNRC_SOCK_ASYNC
+    gnrc_sock_async_close(&sock->reg);
+#endif
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
     if (_udp_socks != NULL) {
         gnrc_sock_reg_t *head = (gnrc_sock_reg_t *)_udp_socks;
@@ -105,6 +115,99 @@ int sock_udp_get_local(sock_udp_t *sock, sock_udp_ep_t *local)
     return 0;
 }
 
+int gnrc_sock_udp_set_queue(sock_udp_t *sock, msg_t *queue, unsigned size)
+{
+    assert(sock != NULL);
+    if (sock->local.family == AF_UNSPEC) {
+        return -EADDRNOTAVAIL;
+    }
+    return gnrc_sock_set_queue(&sock->reg, queue, size);
+}
+
+int gnrc_sock_udp_get_queue_stats(sock_udp_t *sock,
+                                  gnrc_sock_queue_stats_t *stats)
+{
+    assert((sock != NULL) && (stats != NULL));
+    if (sock->local.family == AF_UNSPEC) {
+        return -EADDRNOTAVAIL;
+    }
+    gnrc_sock_get_queue_stats(&sock->reg, stats);
+    return 0;
+}
+
+void gnrc_sock_udp_set_tc(sock_udp_t *sock, uint8_t tc)
+{
+    assert(sock != NULL);
+    sock->tc = tc;
+}
+
+ssize_t gnrc_sock_udp_get_max_payload(sock_udp_t *sock,
+                                      const sock_udp_ep_t *remote)
+{
+    uint16_t netif = SOCK_ADDR_ANY_NETIF, mtu = IPV6_MIN_MTU;
+    kernel_pid_t ifs[GNRC_NETIF_NUMOF];
+
+    assert((sock != NULL) || (remote != NULL));
+    if (remote == NULL) {
+        if (sock->remote.family == AF_UNSPEC) {
+            return -ENOTCONN;
+        }
+        remote = &sock->remote;
+    }
+    if (remote->netif != SOCK_ADDR_ANY_NETIF) {
+        netif = remote->netif;
+    }
+    else if (sock != NULL) {
+        netif = sock->local.netif;
+    }
+    if ((netif == SOCK_ADDR_ANY_NETIF) && (gnrc_netif_get(ifs) == 1)) {
+        netif = ifs[0];
+    }
+    if (netif != SOCK_ADDR_ANY_NETIF) {
+        gnrc_ipv6_netif_t *if_entry = gnrc_ipv6_netif_get(netif);
+
+        if (if_entry != NULL) {
+            mtu = if_entry->mtu;
+        }
+    }
+#ifdef MODULE_GNRC_IPV6_PMTU
+    uint16_t pmtu = gnrc_ipv6_pmtu_get((const ipv6_addr_t *)&remote->addr.ipv6);
+
+    if ((pmtu != 0) && (pmtu < mtu)) {
+        mtu = pmtu;
+    }
+#endif
+    return (ssize_t)mtu - sizeof(ipv6_hdr_t) - sizeof(udp_hdr_t);
+}
+
+#ifdef MODULE_GNRC_SOCK_ASYNC
+static void _async_cb(gnrc_sock_reg_t *reg)
+{
+    sock_udp_t *sock = (sock_udp_t *)reg;
+
+    sock->async_cb(sock, sock->async_arg);
+}
+
+void gnrc_sock_udp_set_cb(sock_udp_t *sock, gnrc_sock_udp_cb_t cb, void *arg)
+{
+    assert(sock != NULL);
+    sock->async_cb = cb;
+    sock->async_arg = arg;
+    gnrc_sock_async_set(&sock->reg, (cb != NULL) ? _async_cb : NULL, NULL);
+}
+
+#ifdef MODULE_EVENT
+void gnrc_sock_udp_event_init(sock_udp_t *sock, event_queue_t *queue,
+                              gnrc_sock_udp_cb_t cb, void *arg)
+{
+    assert((sock != NULL) && (queue != NULL) && (cb != NULL));
+    sock->async_cb = cb;
+    sock->async_arg = arg;
+    gnrc_sock_async_set(&sock->reg, _async_cb, queue);
+}
+#endif
+#endif
+
 int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
 {
     assert(sock && remote);
@@ -115,15 +218,14 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
     return 0;
 }
 
-ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
-                      uint32_t timeout, sock_udp_ep_t *remote)
+static ssize_t _recv(sock_udp_t *sock, gnrc_pktsnip_t **pkt_out,
+                     size_t max_len, uint32_t timeout, sock_udp_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt, *udp;
     udp_hdr_t *hdr;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
     if (sock->local.family == AF_UNSPEC) {
         return -EADDRNOTAVAIL;
     }
@@ -154,22 +256,76 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
+    *pkt_out = pkt;
+    return (int)pkt->size;
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = _recv(sock, &pkt, max_len, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
     memcpy(data, pkt->data, pkt->size);
     gnrc_pktbuf_release(pkt);
-    return (int)pkt->size;
+    return res;
 }
 
-ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
-                      const sock_udp_ep_t *remote)
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    ssize_t res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    if (*buf_ctx != NULL) {
+        /* the caller is done with the previous datagram */
+        gnrc_pktbuf_release(*buf_ctx);
+        *buf_ctx = NULL;
+        *data = NULL;
+        return 0;
+    }
+    res = _recv(sock, &pkt, SIZE_MAX, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return res;
+}
+
+/* releases a payload handed in by the caller on early errors */
+static inline ssize_t _drop(gnrc_pktsnip_t *payload, ssize_t res)
+{
+    if (payload != NULL) {
+        gnrc_pktbuf_release(payload);
+    }
+    return res;
+}
+
+/* end points and ports a datagram is sent with */
+typedef struct {
+    sock_ip_ep_t local;
+    sock_ip_ep_t rem;
+    uint16_t src_port;
+    uint16_t dst_port;
+    uint8_t tc;
+} _send_ctx_t;
+
+/* checks the end points and binds sock implicitly if required */
+static int _resolve(sock_udp_t *sock, const sock_udp_ep_t *remote,
+                    _send_ctx_t *ctx)
 {
-    int res;
-    gnrc_pktsnip_t *payload, *pkt;
     uint16_t src_port = 0, dst_port;
     sock_ip_ep_t local;
     sock_ip_ep_t rem;
 
     assert((sock != NULL) || (remote != NULL));
-    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
     if ((remote != NULL) && (sock != NULL) &&
         (sock->local.netif != SOCK_ADDR_ANY_NETIF) &&
         (remote->netif != SOCK_ADDR_ANY_NETIF) &&
@@ -265,20 +421,114 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
          * there was no remote given on create, take from local */
         rem.family = local.family;
     }
-    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    memcpy(&ctx->local, &local, sizeof(local));
+    memcpy(&ctx->rem, &rem, sizeof(rem));
+    ctx->src_port = src_port;
+    ctx->dst_port = dst_port;
+    ctx->tc = (sock != NULL) ? sock->tc : 0;
+    return 0;
+}
+
+static ssize_t _send_resolved(_send_ctx_t *ctx, gnrc_pktsnip_t *payload,
+                              const void *data, size_t len)
+{
+    gnrc_pktsnip_t *pkt;
+    int res;
+
     if (payload == NULL) {
-        return -ENOMEM;
+        payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+        if (payload == NULL) {
+            return -ENOMEM;
+        }
     }
-    pkt = gnrc_udp_hdr_build(payload, src_port, dst_port);
+    pkt = gnrc_udp_hdr_build(payload, ctx->src_port, ctx->dst_port);
     if (pkt == NULL) {
         gnrc_pktbuf_release(payload);
         return -ENOMEM;
     }
-    res = gnrc_sock_send(pkt, &local, &rem, PROTNUM_UDP);
+    res = gnrc_sock_send(pkt, &ctx->local, &ctx->rem, PROTNUM_UDP, ctx->tc);
     if (res <= 0) {
         return res;
     }
     return res - sizeof(udp_hdr_t);
 }
 
+static ssize_t _send(sock_udp_t *sock, gnrc_pktsnip_t *payload,
+                     const void *data, size_t len, const sock_udp_ep_t *remote)
+{
+    _send_ctx_t ctx;
+    int res = _resolve(sock, remote, &ctx);
+
+    if (res < 0) {
+        return _drop(payload, res);
+    }
+    return _send_resolved(&ctx, payload, data, len);
+}
+
+ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    assert((len == 0) || (data != NULL)); /* (len != 0) => (data != NULL) */
+    return _send(sock, NULL, data, len, remote);
+}
+
+ssize_t gnrc_sock_udp_send_pkt(sock_udp_t *sock, gnrc_pktsnip_t *payload,
+                               const sock_udp_ep_t *remote)
+{
+    assert(payload != NULL);
+    return _send(sock, payload, NULL, 0, remote);
+}
+
+ssize_t sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                            unsigned count, uint32_t timeout)
+{
+    unsigned i = 0;
+
+    assert((sock != NULL) && (msgs != NULL) && (count > 0));
+    while (i < count) {
+        sock_udp_msg_t *msg = &msgs[i];
+        /* only wait for the first message */
+        ssize_t res = sock_udp_recv(sock, msg->data, msg->len,
+                                    (i == 0) ? timeout : 0, msg->remote);
+
+        if (res == -EPROTO) {
+            /* message was from another remote and is dropped */
+            if (i == 0) {
+                return res;
+            }
+            continue;
+        }
+        if (res < 0) {
+            return (i == 0) ? res : (ssize_t)i;
+        }
+        msg->recv_len = res;
+        i++;
+    }
+    return i;
+}
+
+ssize_t sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                            unsigned count)
+{
+    _send_ctx_t ctx;
+
+    assert((msgs != NULL) || (count == 0));
+    for (unsigned i = 0; i < count; i++) {
+        const sock_udp_msg_t *msg = &msgs[i];
+        ssize_t res = 0;
+
+        assert((msg->len == 0) || (msg->data != NULL));
+        if ((i == 0) || (msg->remote != msgs[i - 1].remote)) {
+            res = _resolve(sock, msg->remote, &ctx);
+        }
+        if (res == 0) {
+            res = _send_resolved(&ctx, NULL, msg->data, msg->len);
+        }
+        if (res < 0) {
+            return (i == 0) ? res : (ssize_t)i;
+        }
+    }
+    return count;
+}
+
 /** @} */
@@ -0,0 +1,1241 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tcp
+ * @{
+ *
+ * @file
+ * @brief       TCP implementation
+ *
+ * The TCP thread handles received segments and timeouts. The API functions
+ * are called by the owners of the connections and send segments from their
+ * own context. One mutex serializes both.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "msg.h"
+#include "mutex.h"
+#include "random.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/tcp.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/sock.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @name    Flags of gnrc_tcp_tcb_t::flags
+ * @{
+ */
+#define _FLAG_IN_USE        (0x01)  /**< passive connection is taken */
+#define _FLAG_ACCEPTED      (0x02)  /**< passive connection was accepted */
+#define _FLAG_RTX           (0x04)  /**< gnrc_tcp_tcb_t::rtx_deadline is set */
+#define _FLAG_ACK_DELAYED   (0x08)  /**< gnrc_tcp_tcb_t::ack_deadline is set */
+#define _FLAG_RTT           (0x10)  /**< gnrc_tcp_tcb_t::rtt_seq is timed */
+#define _FLAG_FIN_RCVD      (0x20)  /**< peer closed the connection */
+#define _FLAG_CLOSE         (0x40)  /**< owner closed the connection */
+/** @} */
+
+/**
+ * @brief   Message type of the shared timer
+ */
+#define _MSG_TYPE_TIMER     (0x0321)
+
+/**
+ * @brief   Start of the ephemeral port range
+ */
+#define _EPHEMERAL_PORT_MIN (49152U)
+
+#define _SEQ_LT(a, b)       ((int32_t)((a) - (b)) < 0)
+#define _SEQ_LEQ(a, b)      ((int32_t)((a) - (b)) <= 0)
+#define _SEQ_GT(a, b)       ((int32_t)((a) - (b)) > 0)
+
+/**
+ * @brief   A segment, as received or to be sent
+ */
+typedef struct {
+    const ipv6_addr_t *src;     /**< source address, may be NULL on send */
+    const ipv6_addr_t *dst;     /**< destination address */
+    kernel_pid_t netif;         /**< interface */
+    uint16_t src_port;          /**< source port */
+    uint16_t dst_port;          /**< destination port */
+    uint32_t seq;               /**< sequence number */
+    uint32_t ack;               /**< acknowledgment number */
+    uint16_t wnd;               /**< window */
+    uint16_t mss;               /**< MSS option, 0 if none */
+    uint8_t ctl;                /**< control bits */
+    const uint8_t *data;        /**< payload */
+    size_t len;                 /**< length of _seg_t::data */
+} _seg_t;
+
+/**
+ * @brief   Save the TCP's thread PID for later reference
+ */
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+
+/**
+ * @brief   Allocate memory for the TCP thread's stack
+ */
+#if ENABLE_DEBUG
+static char _stack[GNRC_TCP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
+#else
+static char _stack[GNRC_TCP_STACK_SIZE];
+#endif
+
+/**
+ * @brief   Protects all connections and listeners
+ */
+static mutex_t _lock = MUTEX_INIT;
+static gnrc_tcp_tcb_t *_tcbs = NULL;
+static gnrc_tcp_listener_t *_listeners = NULL;
+
+/**
+ * @brief   The one timer for all connections
+ */
+static xtimer_t _timer;
+static msg_t _timer_msg = { .type = _MSG_TYPE_TIMER };
+
+static inline size_t _min(size_t a, size_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static void _notify(mbox_t *mbox)
+{
+    msg_t msg;
+
+    msg.type = GNRC_TCP_MSG_TYPE_NOTIFY;
+    /* a full queue already wakes the owner up */
+    mbox_try_put(mbox, &msg);
+}
+
+/**
+ * @brief   Waits for a notification with _lock released
+ */
+static int _wait(mbox_t *mbox, uint32_t timeout, uint32_t start)
+{
+    msg_t msg;
+    int res = 0;
+
+    if (timeout == 0) {
+        return -EAGAIN;
+    }
+    mutex_unlock(&_lock);
+    if (timeout == SOCK_NO_TIMEOUT) {
+        mbox_get(mbox, &msg);
+    }
+    else {
+        uint32_t elapsed = xtimer_now_usec() - start;
+
+        if ((elapsed >= timeout) ||
+            (xtimer_mbox_get_timeout(mbox, &msg, timeout - elapsed) < 0)) {
+            res = -ETIMEDOUT;
+        }
+    }
+    mutex_lock(&_lock);
+    return res;
+}
+
+static void _timer_update(void)
+{
+    gnrc_tcp_tcb_t *tcb;
+    uint32_t now = xtimer_now_usec();
+    uint32_t next = 0;
+    bool pending = false;
+
+    LL_FOREACH(_tcbs, tcb) {
+        if ((tcb->flags & _FLAG_RTX) &&
+            (!pending || _SEQ_LT(tcb->rtx_deadline, next))) {
+            next = tcb->rtx_deadline;
+            pending = true;
+        }
+        if ((tcb->flags & _FLAG_ACK_DELAYED) &&
+            (!pending || _SEQ_LT(tcb->ack_deadline, next))) {
+            next = tcb->ack_deadline;
+            pending = true;
+        }
+    }
+    if (!pending) {
+        xtimer_remove(&_timer);
+        return;
+    }
+    xtimer_set_msg(&_timer, _SEQ_GT(next, now) ? (next - now) : 0,
+                   &_timer_msg, _pid);
+}
+
+static void _start_rtx(gnrc_tcp_tcb_t *tcb, uint32_t timeout)
+{
+    tcb->rtx_deadline = xtimer_now_usec() + timeout;
+    tcb->flags |= _FLAG_RTX;
+}
+
+static uint16_t _calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr,
+                           gnrc_pktsnip_t *payload)
+{
+    uint16_t csum = 0;
+    uint16_t len = (uint16_t)hdr->size;
+
+    /* process the payload */
+    while (payload && payload != hdr && payload != pseudo_hdr) {
+        csum = inet_csum_slice(csum, (uint8_t *)(payload->data), payload->size, len);
+        len += (uint16_t)payload->size;
+        payload = payload->next;
+    }
+    /* process TCP header with options */
+    csum = inet_csum(csum, (uint8_t *)hdr->data, hdr->size);
+    return ipv6_hdr_inet_csum(csum, pseudo_hdr->data, PROTNUM_TCP, len);
+}
+
+static int _xmit(const _seg_t *seg)
+{
+    gnrc_pktsnip_t *payload = NULL, *tcp, *pkt;
+    tcp_hdr_t *hdr;
+    size_t hdr_len = sizeof(tcp_hdr_t) + ((seg->mss) ? TCP_OPTION_LENGTH_MSS : 0);
+
+    if (seg->len > 0) {
+        payload = gnrc_pktbuf_add(NULL, (void *)seg->data, seg->len,
+                                  GNRC_NETTYPE_UNDEF);
+        if (payload == NULL) {
+            DEBUG("tcp: unable to allocate payload\n");
+            return -ENOMEM;
+        }
+    }
+    tcp = gnrc_pktbuf_add(payload, NULL, hdr_len, GNRC_NETTYPE_TCP);
+    if (tcp == NULL) {
+        DEBUG("tcp: unable to allocate header\n");
+        if (payload != NULL) {
+            gnrc_pktbuf_release(payload);
+        }
+        return -ENOMEM;
+    }
+    hdr = tcp->data;
+    memset(hdr, 0, hdr_len);
+    hdr->src_port = byteorder_htons(seg->src_port);
+    hdr->dst_port = byteorder_htons(seg->dst_port);
+    hdr->seq_num = byteorder_htonl(seg->seq);
+    hdr->ack_num = byteorder_htonl(seg->ack);
+    hdr->off_ctl = byteorder_htons(((hdr_len / 4) << 12) | seg->ctl);
+    hdr->window = byteorder_htons(seg->wnd);
+    if (seg->mss) {
+        uint8_t *opt = (uint8_t *)(hdr + 1);
+
+        opt[0] = TCP_OPTION_KIND_MSS;
+        opt[1] = TCP_OPTION_LENGTH_MSS;
+        opt[2] = (uint8_t)(seg->mss >> 8);
+        opt[3] = (uint8_t)(seg->mss);
+    }
+    /* the checksum is calculated by IPv6 once the source is known */
+    pkt = gnrc_ipv6_hdr_build(tcp, seg->src, seg->dst);
+    if (pkt == NULL) {
+        DEBUG("tcp: unable to allocate IPv6 header\n");
+        gnrc_pktbuf_release(tcp);
+        return -ENOMEM;
+    }
+    if (seg->netif != KERNEL_PID_UNDEF) {
+        gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+
+        if (netif == NULL) {
+            gnrc_pktbuf_release(pkt);
+            return -ENOMEM;
+        }
+        ((gnrc_netif_hdr_t *)netif->data)->if_pid = seg->netif;
+        LL_PREPEND(pkt, netif);
+    }
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL,
+                                   pkt)) {
+        DEBUG("tcp: cannot send packet: network layer not found\n");
+        gnrc_pktbuf_release(pkt);
+        return -EBADMSG;
+    }
+    return 0;
+}
+
+static int _tcb_xmit(gnrc_tcp_tcb_t *tcb, uint8_t ctl, uint32_t seq,
+                     const uint8_t *data, size_t len)
+{
+    uint16_t wnd = GNRC_TCP_RCV_BUF_SIZE - tcb->rcv_len;
+    _seg_t seg = {
+        .src = ipv6_addr_is_unspecified(&tcb->local_addr) ? NULL : &tcb->local_addr,
+        .dst = &tcb->peer_addr,
+        .netif = tcb->netif,
+        .src_port = tcb->local_port,
+        .dst_port = tcb->peer_port,
+        .seq = seq,
+        .ack = (ctl & TCP_CTL_ACK) ? tcb->rcv_nxt : 0,
+        .wnd = wnd,
+        .mss = (ctl & TCP_CTL_SYN) ? GNRC_TCP_MSS : 0,
+        .ctl = ctl,
+        .data = data,
+        .len = len,
+    };
+
+    if (ctl & TCP_CTL_ACK) {
+        /* this acknowledges everything received so far */
+        tcb->flags &= ~_FLAG_ACK_DELAYED;
+        tcb->rcv_acked = wnd;
+    }
+    return _xmit(&seg);
+}
+
+static void _send_rst(const _seg_t *in)
+{
+    _seg_t out = {
+        .src = in->dst,
+        .dst = in->src,
+        .netif = in->netif,
+        .src_port = in->dst_port,
+        .dst_port = in->src_port,
+    };
+
+    if (in->ctl & TCP_CTL_ACK) {
+        out.seq = in->ack;
+        out.ctl = TCP_CTL_RST;
+    }
+    else {
+        out.ack = in->seq + in->len + ((in->ctl & TCP_CTL_SYN) ? 1 : 0) +
+                  ((in->ctl & TCP_CTL_FIN) ? 1 : 0);
+        out.ctl = TCP_CTL_RST | TCP_CTL_ACK;
+    }
+    _xmit(&out);
+}
+
+static void _tcb_init(gnrc_tcp_tcb_t *tcb, gnrc_tcp_listener_t *listener)
+{
+    /* the buffers do not need to be cleared */
+    memset(tcb, 0, offsetof(gnrc_tcp_tcb_t, mbox));
+    tcb->listener = listener;
+    tcb->netif = KERNEL_PID_UNDEF;
+    tcb->mss = TCP_DEFAULT_MSS;
+    tcb->rto = GNRC_TCP_RTO_INIT;
+    mbox_init(&tcb->mbox, tcb->mbox_queue, GNRC_TCP_MBOX_SIZE);
+}
+
+static void _terminate(gnrc_tcp_tcb_t *tcb, int error)
+{
+    DEBUG("tcp: connection on port %u closed (%d)\n", tcb->local_port, error);
+    if (tcb->state != GNRC_TCP_STATE_CLOSED) {
+        LL_DELETE(_tcbs, tcb);
+    }
+    tcb->state = GNRC_TCP_STATE_CLOSED;
+    tcb->error = error;
+    tcb->flags &= ~(_FLAG_RTX | _FLAG_ACK_DELAYED | _FLAG_RTT);
+    if ((tcb->listener != NULL) && !(tcb->flags & _FLAG_ACCEPTED)) {
+        /* never handed out, so it is free for the next connection */
+        tcb->flags = 0;
+    }
+    _notify(&tcb->mbox);
+}
+
+static bool _port_in_use(uint16_t port)
+{
+    gnrc_tcp_tcb_t *tcb;
+    gnrc_tcp_listener_t *listener;
+
+    LL_SEARCH_SCALAR(_tcbs, tcb, local_port, port);
+    LL_SEARCH_SCALAR(_listeners, listener, local_port, port);
+    return (tcb != NULL) || (listener != NULL);
+}
+
+static uint16_t _random_port(void)
+{
+    uint16_t port;
+
+    do {
+        port = (uint16_t)random_uint32_range(_EPHEMERAL_PORT_MIN, UINT16_MAX + 1);
+    } while (_port_in_use(port));
+    return port;
+}
+
+static void _rtt_sample(gnrc_tcp_tcb_t *tcb)
+{
+    /* RFC 6298, section 2 */
+    uint32_t rtt = xtimer_now_usec() - tcb->rtt_start;
+
+    if (tcb->srtt == 0) {
+        tcb->srtt = rtt;
+        tcb->rttvar = rtt / 2;
+    }
+    else {
+        uint32_t delta = (tcb->srtt > rtt) ? (tcb->srtt - rtt) : (rtt - tcb->srtt);
+
+        tcb->rttvar = (3 * tcb->rttvar + delta) / 4;
+        tcb->srtt = (7 * tcb->srtt + rtt) / 8;
+    }
+    tcb->rto = tcb->srtt + 4 * tcb->rttvar;
+    if (tcb->rto < GNRC_TCP_RTO_MIN) {
+        tcb->rto = GNRC_TCP_RTO_MIN;
+    }
+    else if (tcb->rto > GNRC_TCP_RTO_MAX) {
+        tcb->rto = GNRC_TCP_RTO_MAX;
+    }
+    tcb->flags &= ~_FLAG_RTT;
+}
+
+static void _rtt_start(gnrc_tcp_tcb_t *tcb, uint32_t seq)
+{
+    if (!(tcb->flags & _FLAG_RTT)) {
+        tcb->rtt_seq = seq;
+        tcb->rtt_start = xtimer_now_usec();
+        tcb->flags |= _FLAG_RTT;
+    }
+}
+
+/**
+ * @brief   Sends the data and FIN the window of the peer allows
+ */
+static void _output(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->state < GNRC_TCP_STATE_ESTABLISHED) {
+        return;
+    }
+    while (1) {
+        uint32_t sent = tcb->snd_nxt - tcb->snd_una;
+        uint32_t wnd_end = tcb->snd_una + tcb->snd_wnd;
+        size_t len, unsent;
+        uint8_t ctl = TCP_CTL_ACK;
+
+        if (sent >= tcb->snd_len) {
+            break;
+        }
+        unsent = tcb->snd_len - sent;
+        len = _SEQ_LT(tcb->snd_nxt, wnd_end) ? (wnd_end - tcb->snd_nxt) : 0;
+        len = _min(_min(len, unsent), tcb->mss);
+        if (len == 0) {
+            break;
+        }
+        if (len == unsent) {
+            ctl |= TCP_CTL_PSH;
+        }
+        if (_tcb_xmit(tcb, ctl, tcb->snd_nxt, &tcb->snd_buf[sent], len) < 0) {
+            /* retried on the retransmission timeout */
+            break;
+        }
+        _rtt_start(tcb, tcb->snd_nxt + len);
+        tcb->snd_nxt += len;
+    }
+    if ((tcb->flags & _FLAG_CLOSE) &&
+        (tcb->snd_nxt == (tcb->snd_una + tcb->snd_len)) &&
+        (tcb->state != GNRC_TCP_STATE_FIN_WAIT_2)) {
+        /* all data is sent, but the FIN is not yet (or needs to be again) */
+        if (_tcb_xmit(tcb, TCP_CTL_FIN | TCP_CTL_ACK, tcb->snd_nxt, NULL, 0) == 0) {
+            tcb->snd_nxt++;
+        }
+        if (tcb->state == GNRC_TCP_STATE_ESTABLISHED) {
+            tcb->state = GNRC_TCP_STATE_FIN_WAIT_1;
+        }
+        else if (tcb->state == GNRC_TCP_STATE_CLOSE_WAIT) {
+            tcb->state = GNRC_TCP_STATE_LAST_ACK;
+        }
+    }
+    if (!(tcb->flags & _FLAG_RTX) &&
+        ((tcb->snd_nxt != tcb->snd_una) || (tcb->snd_len > 0) ||
+         (tcb->flags & _FLAG_CLOSE))) {
+        /* also probes a zero window and retries a failed send */
+        _start_rtx(tcb, tcb->rto);
+    }
+}
+
+static void _retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    tcb->flags &= ~(_FLAG_RTX | _FLAG_RTT);
+    if (tcb->state == GNRC_TCP_STATE_FIN_WAIT_2) {
+        DEBUG("tcp: peer did not close the connection\n");
+        _terminate(tcb, 0);
+        return;
+    }
+    if ((tcb->snd_wnd == 0) && (tcb->snd_nxt == tcb->snd_una) &&
+        (tcb->snd_len > 0)) {
+        /* probe the zero window with one byte, RFC 1122 4.2.2.17 */
+        _tcb_xmit(tcb, TCP_CTL_ACK, tcb->snd_una, tcb->snd_buf, 1);
+        _start_rtx(tcb, tcb->rto);
+        return;
+    }
+    if (++tcb->retries > GNRC_TCP_MAX_RETRIES) {
+        DEBUG("tcp: peer stopped answering\n");
+        if (tcb->state != GNRC_TCP_STATE_SYN_SENT) {
+            _tcb_xmit(tcb, TCP_CTL_RST, tcb->snd_nxt, NULL, 0);
+        }
+        _terminate(tcb, -ETIMEDOUT);
+        return;
+    }
+    tcb->rto = _min(2 * tcb->rto, GNRC_TCP_RTO_MAX);
+    switch (tcb->state) {
+        case GNRC_TCP_STATE_SYN_SENT:
+            _tcb_xmit(tcb, TCP_CTL_SYN, tcb->iss, NULL, 0);
+            break;
+        case GNRC_TCP_STATE_SYN_RCVD:
+            _tcb_xmit(tcb, TCP_CTL_SYN | TCP_CTL_ACK, tcb->iss, NULL, 0);
+            break;
+        default:
+            /* go back to the first unacknowledged byte */
+            tcb->snd_nxt = tcb->snd_una;
+            _output(tcb);
+            break;
+    }
+    _start_rtx(tcb, tcb->rto);
+}
+
+static void _timeout(void)
+{
+    gnrc_tcp_tcb_t *tcb, *tmp;
+    uint32_t now = xtimer_now_usec();
+
+    mutex_lock(&_lock);
+    LL_FOREACH_SAFE(_tcbs, tcb, tmp) {
+        if ((tcb->flags & _FLAG_ACK_DELAYED) && _SEQ_LEQ(tcb->ack_deadline, now)) {
+            _tcb_xmit(tcb, TCP_CTL_ACK, tcb->snd_nxt, NULL, 0);
+        }
+        if ((tcb->flags & _FLAG_RTX) && _SEQ_LEQ(tcb->rtx_deadline, now)) {
+            _retransmit(tcb);
+        }
+    }
+    _timer_update();
+    mutex_unlock(&_lock);
+}
+
+static uint16_t _parse_mss(const tcp_hdr_t *hdr, size_t hdr_len)
+{
+    const uint8_t *opt = (const uint8_t *)(hdr + 1);
+    const uint8_t *end = (const uint8_t *)hdr + hdr_len;
+
+    while (opt < end) {
+        if (*opt == TCP_OPTION_KIND_EOL) {
+            break;
+        }
+        if (*opt == TCP_OPTION_KIND_NOP) {
+            opt++;
+            continue;
+        }
+        if (((opt + 1) >= end) || (opt[1] < 2) || ((opt + opt[1]) > end)) {
+            break;
+        }
+        if ((opt[0] == TCP_OPTION_KIND_MSS) && (opt[1] == TCP_OPTION_LENGTH_MSS)) {
+            return (opt[2] << 8) | opt[3];
+        }
+        opt += opt[1];
+    }
+    return 0;
+}
+
+static void _set_mss(gnrc_tcp_tcb_t *tcb, const _seg_t *seg)
+{
+    tcb->mss = (seg->mss != 0) ? seg->mss : TCP_DEFAULT_MSS;
+    if (tcb->mss > GNRC_TCP_MSS) {
+        tcb->mss = GNRC_TCP_MSS;
+    }
+}
+
+static gnrc_tcp_tcb_t *_find_tcb(const _seg_t *seg)
+{
+    gnrc_tcp_tcb_t *tcb;
+
+    LL_FOREACH(_tcbs, tcb) {
+        if ((tcb->local_port == seg->dst_port) &&
+            (tcb->peer_port == seg->src_port) &&
+            ipv6_addr_equal(&tcb->peer_addr, seg->src) &&
+            (ipv6_addr_is_unspecified(&tcb->local_addr) ||
+             ipv6_addr_equal(&tcb->local_addr, seg->dst))) {
+            return tcb;
+        }
+    }
+    return NULL;
+}
+
+static gnrc_tcp_listener_t *_find_listener(const _seg_t *seg)
+{
+    gnrc_tcp_listener_t *listener;
+
+    LL_FOREACH(_listeners, listener) {
+        if ((listener->local_port == seg->dst_port) &&
+            (ipv6_addr_is_unspecified(&listener->local_addr) ||
+             ipv6_addr_equal(&listener->local_addr, seg->dst))) {
+            return listener;
+        }
+    }
+    return NULL;
+}
+
+static void _passive_open(gnrc_tcp_listener_t *listener, const _seg_t *seg)
+{
+    gnrc_tcp_tcb_t *tcb = NULL;
+
+    for (unsigned i = 0; i < listener->tcbs_len; i++) {
+        if ((listener->tcbs[i].state == GNRC_TCP_STATE_CLOSED) &&
+            !(listener->tcbs[i].flags & _FLAG_IN_USE)) {
+            tcb = &listener->tcbs[i];
+            break;
+        }
+    }
+    if (tcb == NULL) {
+        /* the peer retries the SYN, maybe a connection is free then */
+        DEBUG("tcp: no free connection on port %u\n", seg->dst_port);
+        return;
+    }
+    _tcb_init(tcb, listener);
+    memcpy(&tcb->local_addr, seg->dst, sizeof(ipv6_addr_t));
+    memcpy(&tcb->peer_addr, seg->src, sizeof(ipv6_addr_t));
+    tcb->netif = seg->netif;
+    tcb->local_port = seg->dst_port;
+    tcb->peer_port = seg->src_port;
+    tcb->flags = _FLAG_IN_USE;
+    tcb->iss = random_uint32();
+    tcb->snd_una = tcb->iss;
+    tcb->snd_nxt = tcb->iss + 1;
+    tcb->rcv_nxt = seg->seq + 1;
+    tcb->snd_wnd = seg->wnd;
+    _set_mss(tcb, seg);
+    tcb->state = GNRC_TCP_STATE_SYN_RCVD;
+    LL_PREPEND(_tcbs, tcb);
+    _tcb_xmit(tcb, TCP_CTL_SYN | TCP_CTL_ACK, tcb->iss, NULL, 0);
+    _rtt_start(tcb, tcb->snd_nxt);
+    _start_rtx(tcb, tcb->rto);
+}
+
+static void _process_syn_sent(gnrc_tcp_tcb_t *tcb, const _seg_t *seg)
+{
+    if ((seg->ctl & TCP_CTL_ACK) && (seg->ack != tcb->snd_nxt)) {
+        if (!(seg->ctl & TCP_CTL_RST)) {
+            _send_rst(seg);
+        }
+        return;
+    }
+    if (seg->ctl & TCP_CTL_RST) {
+        if (seg->ctl & TCP_CTL_ACK) {
+            _terminate(tcb, -ECONNREFUSED);
+        }
+        return;
+    }
+    if ((seg->ctl & (TCP_CTL_SYN | TCP_CTL_ACK)) != (TCP_CTL_SYN | TCP_CTL_ACK)) {
+        /* simultaneous open is not supported */
+        return;
+    }
+    /* the address the peer answered to is the source from now on */
+    memcpy(&tcb->local_addr, seg->dst, sizeof(ipv6_addr_t));
+    if (tcb->netif == KERNEL_PID_UNDEF) {
+        tcb->netif = seg->netif;
+    }
+    tcb->rcv_nxt = seg->seq + 1;
+    tcb->snd_una = seg->ack;
+    tcb->snd_wnd = seg->wnd;
+    _set_mss(tcb, seg);
+    if (tcb->flags & _FLAG_RTT) {
+        _rtt_sample(tcb);
+    }
+    tcb->retries = 0;
+    tcb->flags &= ~_FLAG_RTX;
+    tcb->state = GNRC_TCP_STATE_ESTABLISHED;
+    _tcb_xmit(tcb, TCP_CTL_ACK, tcb->snd_nxt, NULL, 0);
+    _notify(&tcb->mbox);
+}
+
+static void _process_ack(gnrc_tcp_tcb_t *tcb, const _seg_t *seg)
+{
+    uint32_t acked = seg->ack - tcb->snd_una;
+    size_t data_acked = _min(acked, tcb->snd_len);
+    bool fin_acked = (acked > data_acked);
+
+    if (acked == 0) {
+        /* nothing new, but the window may have changed */
+        tcb->snd_wnd = seg->wnd;
+        return;
+    }
+    memmove(tcb->snd_buf, &tcb->snd_buf[data_acked], tcb->snd_len - data_acked);
+    tcb->snd_len -= data_acked;
+    tcb->snd_una = seg->ack;
+    tcb->snd_wnd = seg->wnd;
+    tcb->retries = 0;
+    if ((tcb->flags & _FLAG_RTT) && _SEQ_LEQ(tcb->rtt_seq, seg->ack)) {
+        _rtt_sample(tcb);
+    }
+    tcb->flags &= ~_FLAG_RTX;
+    if (tcb->snd_una != tcb->snd_nxt) {
+        _start_rtx(tcb, tcb->rto);
+    }
+    if (fin_acked) {
+        switch (tcb->state) {
+            case GNRC_TCP_STATE_FIN_WAIT_1:
+                tcb->state = GNRC_TCP_STATE_FIN_WAIT_2;
+                /* do not wait forever for the FIN of the peer */
+                _start_rtx(tcb, GNRC_TCP_RTO_MAX);
+                break;
+            case GNRC_TCP_STATE_CLOSING:
+            case GNRC_TCP_STATE_LAST_ACK:
+                _terminate(tcb, 0);
+                return;
+            default:
+                break;
+        }
+    }
+    _notify(&tcb->mbox);
+}
+
+static void _process_data(gnrc_tcp_tcb_t *tcb, const _seg_t *seg)
+{
+    bool fin = (seg->ctl & TCP_CTL_FIN);
+
+    if (seg->len > 0) {
+        size_t len = seg->len;
+
+        if (tcb->flags & _FLAG_CLOSE) {
+            /* nobody reads anymore, just let the peer finish */
+        }
+        else {
+            len = _min(len, GNRC_TCP_RCV_BUF_SIZE - tcb->rcv_len);
+            memcpy(&tcb->rcv_buf[tcb->rcv_len], seg->data, len);
+            tcb->rcv_len += len;
+        }
+        tcb->rcv_nxt += len;
+        if (len < seg->len) {
+            /* the rest is retransmitted once there is space again */
+            fin = false;
+        }
+        if ((tcb->flags & _FLAG_ACK_DELAYED) || (len < seg->len)) {
+            /* acknowledge at least every second segment */
+            _tcb_xmit(tcb, TCP_CTL_ACK, tcb->snd_nxt, NULL, 0);
+        }
+        else if (!fin) {
+            tcb->ack_deadline = xtimer_now_usec() + GNRC_TCP_ACK_DELAY;
+            tcb->flags |= _FLAG_ACK_DELAYED;
+        }
+        _notify(&tcb->mbox);
+    }
+    if (fin) {
+        tcb->rcv_nxt++;
+        tcb->flags |= _FLAG_FIN_RCVD;
+        _tcb_xmit(tcb, TCP_CTL_ACK, tcb->snd_nxt, NULL, 0);
+        switch (tcb->state) {
+            case GNRC_TCP_STATE_ESTABLISHED:
+                tcb->state = GNRC_TCP_STATE_CLOSE_WAIT;
+                break;
+            case GNRC_TCP_STATE_FIN_WAIT_1:
+                tcb->state = GNRC_TCP_STATE_CLOSING;
+                break;
+            case GNRC_TCP_STATE_FIN_WAIT_2:
+                _terminate(tcb, 0);
+                return;
+            default:
+                break;
+        }
+        _notify(&tcb->mbox);
+    }
+}
+
+static void _process(_seg_t *seg)
+{
+    gnrc_tcp_tcb_t *tcb = _find_tcb(seg);
+
+    if (tcb == NULL) {
+        gnrc_tcp_listener_t *listener;
+
+        if (seg->ctl & TCP_CTL_RST) {
+            return;
+        }
+        if (((seg->ctl & (TCP_CTL_SYN | TCP_CTL_ACK)) == TCP_CTL_SYN) &&
+            ((listener = _find_listener(seg)) != NULL)) {
+            _passive_open(listener, seg);
+            return;
+        }
+        _send_rst(seg);
+        return;
+    }
+    if (tcb->state == GNRC_TCP_STATE_SYN_SENT) {
+        _process_syn_sent(tcb, seg);
+        return;
+    }
+    /* trim data that was already received */
+    if (_SEQ_LT(seg->seq, tcb->rcv_nxt) &&
+        _SEQ_GT(seg->seq + seg->len, tcb->rcv_nxt)) {
+        uint32_t skip = tcb->rcv_nxt - seg->seq;
+
+        seg->data += skip;
+        seg->len -= skip;
+        seg->seq = tcb->rcv_nxt;
+    }
+    if (seg->seq != tcb->rcv_nxt) {
+        /* out of order or duplicate: only data is acknowledged again */
+        if ((tcb->state == GNRC_TCP_STATE_SYN_RCVD) && (seg->ctl & TCP_CTL_SYN)) {
+            _tcb_xmit(tcb, TCP_CTL_SYN | TCP_CTL_ACK, tcb->iss, NULL, 0);
+        }
+        else if (!(seg->ctl & TCP_CTL_RST) &&
+                 ((seg->len > 0) || (seg->ctl & (TCP_CTL_SYN | TCP_CTL_FIN)))) {
+            _tcb_xmit(tcb, TCP_CTL_ACK, tcb->snd_nxt, NULL, 0);
+        }
+        return;
+    }
+    if (seg->ctl & TCP_CTL_RST) {
+        _terminate(tcb, -ECONNRESET);
+        return;
+    }
+    if (seg->ctl & TCP_CTL_SYN) {
+        _tcb_xmit(tcb, TCP_CTL_RST, tcb->snd_nxt, NULL, 0);
+        _terminate(tcb, -ECONNRESET);
+        return;
+    }
+    if (!(seg->ctl & TCP_CTL_ACK)) {
+        return;
+    }
+    if (tcb->state == GNRC_TCP_STATE_SYN_RCVD) {
+        if (seg->ack != tcb->snd_nxt) {
+            _send_rst(seg);
+            return;
+        }
+        /* the SYN is acknowledged, but it must not be taken for a FIN */
+        tcb->snd_una = seg->ack;
+        if (tcb->flags & _FLAG_RTT) {
+            _rtt_sample(tcb);
+        }
+        tcb->retries = 0;
+        tcb->flags &= ~_FLAG_RTX;
+        tcb->state = GNRC_TCP_STATE_ESTABLISHED;
+        DEBUG("tcp: connection on port %u established\n", tcb->local_port);
+        _notify(&tcb->listener->mbox);
+    }
+    if (_SEQ_GT(seg->ack, tcb->snd_nxt)) {
+        /* acknowledges something that was not sent */
+        _tcb_xmit(tcb, TCP_CTL_ACK, tcb->snd_nxt, NULL, 0);
+        return;
+    }
+    if (_SEQ_LEQ(tcb->snd_una, seg->ack)) {
+        _process_ack(tcb, seg);
+        if (tcb->state == GNRC_TCP_STATE_CLOSED) {
+            return;
+        }
+    }
+    switch (tcb->state) {
+        case GNRC_TCP_STATE_ESTABLISHED:
+        case GNRC_TCP_STATE_FIN_WAIT_1:
+        case GNRC_TCP_STATE_FIN_WAIT_2:
+            _process_data(tcb, seg);
+            if (tcb->state == GNRC_TCP_STATE_CLOSED) {
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+    _output(tcb);
+}
+
+static void _receive(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ipv6, *netif;
+    ipv6_hdr_t *ipv6_hdr;
+    tcp_hdr_t *hdr;
+    size_t hdr_len;
+    _seg_t seg;
+
+    ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+
+    assert(ipv6 != NULL);
+
+    if (pkt->size < sizeof(tcp_hdr_t)) {
+        DEBUG("tcp: segment too short, dropping it\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    hdr = pkt->data;
+    hdr_len = tcp_hdr_get_len(hdr);
+    if ((hdr_len < sizeof(tcp_hdr_t)) || (hdr_len > pkt->size)) {
+        DEBUG("tcp: invalid header length, dropping segment\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (!(gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM) &&
+        /* device did not verify the checksum already */
+        (ipv6_hdr_inet_csum(inet_csum(0, pkt->data, pkt->size), ipv6->data,
+                            PROTNUM_TCP, pkt->size) != 0xFFFF)) {
+        DEBUG("tcp: received segment with invalid checksum, dropping it\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    ipv6_hdr = ipv6->data;
+    netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    seg.src = &ipv6_hdr->src;
+    seg.dst = &ipv6_hdr->dst;
+    seg.netif = (netif != NULL) ? ((gnrc_netif_hdr_t *)netif->data)->if_pid
+                                : KERNEL_PID_UNDEF;
+    seg.src_port = byteorder_ntohs(hdr->src_port);
+    seg.dst_port = byteorder_ntohs(hdr->dst_port);
+    seg.seq = byteorder_ntohl(hdr->seq_num);
+    seg.ack = byteorder_ntohl(hdr->ack_num);
+    seg.wnd = byteorder_ntohs(hdr->window);
+    seg.ctl = tcp_hdr_get_ctl(hdr);
+    seg.mss = (seg.ctl & TCP_CTL_SYN) ? _parse_mss(hdr, hdr_len) : 0;
+    seg.data = (uint8_t *)pkt->data + hdr_len;
+    seg.len = pkt->size - hdr_len;
+
+    mutex_lock(&_lock);
+    _process(&seg);
+    _timer_update();
+    mutex_unlock(&_lock);
+    gnrc_pktbuf_release(pkt);
+}
+
+static void *_event_loop(void *arg)
+{
+    (void)arg;
+    msg_t msg, reply;
+    msg_t msg_queue[GNRC_TCP_MSG_QUEUE_SIZE];
+    gnrc_netreg_entry_t netreg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                            sched_active_pid);
+    /* preset reply message */
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+    reply.content.value = (uint32_t)-ENOTSUP;
+    /* initialize message queue */
+    msg_init_queue(msg_queue, GNRC_TCP_MSG_QUEUE_SIZE);
+    /* register TCP at netreg */
+    gnrc_netreg_register(GNRC_NETTYPE_TCP, &netreg);
+
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_RCV:
+                DEBUG("tcp: GNRC_NETAPI_MSG_TYPE_RCV\n");
+                _receive(msg.content.ptr);
+                break;
+            case _MSG_TYPE_TIMER:
+                _timeout();
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SND:
+                /* segments are only sent by this module */
+                gnrc_pktbuf_release(msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SET:
+            case GNRC_NETAPI_MSG_TYPE_GET:
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                DEBUG("tcp: received unidentified message\n");
+                break;
+        }
+    }
+
+    /* never reached */
+    return NULL;
+}
+
+int gnrc_tcp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
+{
+    uint16_t csum;
+
+    if ((hdr == NULL) || (pseudo_hdr == NULL)) {
+        return -EFAULT;
+    }
+    if (hdr->type != GNRC_NETTYPE_TCP) {
+        return -EBADMSG;
+    }
+    if (pseudo_hdr->type != GNRC_NETTYPE_IPV6) {
+        return -ENOENT;
+    }
+    /* the checksum field is part of the sum, so clear it first */
+    ((tcp_hdr_t *)hdr->data)->checksum = byteorder_htons(0);
+    csum = _calc_csum(hdr, pseudo_hdr, hdr->next);
+    ((tcp_hdr_t *)hdr->data)->checksum = byteorder_htons(~csum);
+    return 0;
+}
+
+int gnrc_tcp_connect(gnrc_tcp_tcb_t *tcb, const ipv6_addr_t *remote,
+                     uint16_t remote_port, kernel_pid_t netif,
+                     uint16_t local_port)
+{
+    int res;
+
+    assert((tcb != NULL) && (remote != NULL) && (remote_port != 0));
+    mutex_lock(&_lock);
+    if (local_port == 0) {
+        local_port = _random_port();
+    }
+    else if (_port_in_use(local_port)) {
+        mutex_unlock(&_lock);
+        return -EADDRINUSE;
+    }
+    _tcb_init(tcb, NULL);
+    memcpy(&tcb->peer_addr, remote, sizeof(ipv6_addr_t));
+    tcb->netif = netif;
+    tcb->local_port = local_port;
+    tcb->peer_port = remote_port;
+    tcb->iss = random_uint32();
+    tcb->snd_una = tcb->iss;
+    tcb->snd_nxt = tcb->iss + 1;
+    if ((res = _tcb_xmit(tcb, TCP_CTL_SYN, tcb->iss, NULL, 0)) < 0) {
+        mutex_unlock(&_lock);
+        return res;
+    }
+    tcb->state = GNRC_TCP_STATE_SYN_SENT;
+    LL_PREPEND(_tcbs, tcb);
+    _rtt_start(tcb, tcb->snd_nxt);
+    _start_rtx(tcb, tcb->rto);
+    _timer_update();
+    while (tcb->state == GNRC_TCP_STATE_SYN_SENT) {
+        _wait(&tcb->mbox, SOCK_NO_TIMEOUT, 0);
+    }
+    res = (tcb->state == GNRC_TCP_STATE_CLOSED) ? tcb->error : 0;
+    mutex_unlock(&_lock);
+    return res;
+}
+
+int gnrc_tcp_listen(gnrc_tcp_listener_t *listener, const ipv6_addr_t *local,
+                    uint16_t local_port, gnrc_tcp_tcb_t *tcbs,
+                    unsigned tcbs_len)
+{
+    gnrc_tcp_listener_t *tmp;
+
+    assert((listener != NULL) && (tcbs != NULL) && (tcbs_len > 0));
+    mutex_lock(&_lock);
+    LL_SEARCH_SCALAR(_listeners, tmp, local_port, local_port);
+    if (tmp != NULL) {
+        mutex_unlock(&_lock);
+        return -EADDRINUSE;
+    }
+    if (local == NULL) {
+        ipv6_addr_set_unspecified(&listener->local_addr);
+    }
+    else {
+        memcpy(&listener->local_addr, local, sizeof(ipv6_addr_t));
+    }
+    listener->local_port = local_port;
+    listener->tcbs = tcbs;
+    listener->tcbs_len = tcbs_len;
+    mbox_init(&listener->mbox, listener->mbox_queue, GNRC_TCP_MBOX_SIZE);
+    for (unsigned i = 0; i < tcbs_len; i++) {
+        _tcb_init(&tcbs[i], listener);
+    }
+    LL_PREPEND(_listeners, listener);
+    mutex_unlock(&_lock);
+    return 0;
+}
+
+void gnrc_tcp_stop_listen(gnrc_tcp_listener_t *listener)
+{
+    mutex_lock(&_lock);
+    LL_DELETE(_listeners, listener);
+    for (unsigned i = 0; i < listener->tcbs_len; i++) {
+        gnrc_tcp_tcb_t *tcb = &listener->tcbs[i];
+
+        if ((tcb->state != GNRC_TCP_STATE_CLOSED) && !(tcb->flags & _FLAG_ACCEPTED)) {
+            _tcb_xmit(tcb, TCP_CTL_RST, tcb->snd_nxt, NULL, 0);
+            _terminate(tcb, -ECONNABORTED);
+        }
+    }
+    _timer_update();
+    mutex_unlock(&_lock);
+}
+
+int gnrc_tcp_accept(gnrc_tcp_listener_t *listener, gnrc_tcp_tcb_t **tcb,
+                    uint32_t timeout)
+{
+    uint32_t start = xtimer_now_usec();
+    int res;
+
+    mutex_lock(&_lock);
+    while (1) {
+        for (unsigned i = 0; i < listener->tcbs_len; i++) {
+            gnrc_tcp_tcb_t *tmp = &listener->tcbs[i];
+
+            /* the peer may have sent data or even closed already */
+            if ((tmp->state >= GNRC_TCP_STATE_ESTABLISHED) &&
+                !(tmp->flags & _FLAG_ACCEPTED)) {
+                tmp->flags |= _FLAG_ACCEPTED;
+                *tcb = tmp;
+                mutex_unlock(&_lock);
+                return 0;
+            }
+        }
+        if ((res = _wait(&listener->mbox, timeout, start)) < 0) {
+            mutex_unlock(&_lock);
+            return res;
+        }
+    }
+}
+
+ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, size_t max_len,
+                      uint32_t timeout)
+{
+    uint32_t start = xtimer_now_usec();
+    ssize_t res;
+    uint16_t wnd;
+
+    mutex_lock(&_lock);
+    while (tcb->rcv_len == 0) {
+        if (tcb->flags & _FLAG_FIN_RCVD) {
+            res = 0;
+            goto out;
+        }
+        if (tcb->state == GNRC_TCP_STATE_CLOSED) {
+            res = (tcb->error != 0) ? tcb->error : -ENOTCONN;
+            goto out;
+        }
+        if ((res = _wait(&tcb->mbox, timeout, start)) < 0) {
+            goto out;
+        }
+    }
+    res = _min(max_len, tcb->rcv_len);
+    memcpy(data, tcb->rcv_buf, res);
+    tcb->rcv_len -= res;
+    memmove(tcb->rcv_buf, &tcb->rcv_buf[res], tcb->rcv_len);
+    /* announce the freed space if it is worth it, RFC 1122 4.2.3.3 */
+    wnd = GNRC_TCP_RCV_BUF_SIZE - tcb->rcv_len;
+    if ((tcb->state >= GNRC_TCP_STATE_ESTABLISHED) &&
+        (tcb->state <= GNRC_TCP_STATE_FIN_WAIT_2) &&
+        ((size_t)(wnd - tcb->rcv_acked) >=
+         _min(GNRC_TCP_MSS, GNRC_TCP_RCV_BUF_SIZE / 2))) {
+        _tcb_xmit(tcb, TCP_CTL_ACK, tcb->snd_nxt, NULL, 0);
+        _timer_update();
+    }
+out:
+    mutex_unlock(&_lock);
+    return res;
+}
+
+ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, size_t len)
+{
+    const uint8_t *bytes = data;
+    size_t done = 0;
+    ssize_t res = 0;
+
+    mutex_lock(&_lock);
+    while (done < len) {
+        size_t chunk;
+
+        if (tcb->state == GNRC_TCP_STATE_CLOSED) {
+            res = (tcb->error != 0) ? tcb->error : -ENOTCONN;
+            break;
+        }
+        if (((tcb->state != GNRC_TCP_STATE_ESTABLISHED) &&
+             (tcb->state != GNRC_TCP_STATE_CLOSE_WAIT)) ||
+            (tcb->flags & _FLAG_CLOSE)) {
+            res = -ENOTCONN;
+            break;
+        }
+        chunk = _min(len - done, GNRC_TCP_SND_BUF_SIZE - tcb->snd_len);
+        if (chunk == 0) {
+            /* wait for acknowledgments to make space */
+            _wait(&tcb->mbox, SOCK_NO_TIMEOUT, 0);
+            continue;
+        }
+        memcpy(&tcb->snd_buf[tcb->snd_len], &bytes[done], chunk);
+        tcb->snd_len += chunk;
+        done += chunk;
+        _output(tcb);
+        _timer_update();
+    }
+    mutex_unlock(&_lock);
+    return (done > 0) ? (ssize_t)done : res;
+}
+
+/**
+ * @brief   Starts closing a connection
+ *
+ * @return  true, if the peer needs to acknowledge the close
+ */
+static bool _close(gnrc_tcp_tcb_t *tcb)
+{
+    switch (tcb->state) {
+        case GNRC_TCP_STATE_CLOSED:
+            return false;
+        case GNRC_TCP_STATE_SYN_SENT:
+            _terminate(tcb, 0);
+            return false;
+        case GNRC_TCP_STATE_SYN_RCVD:
+            _tcb_xmit(tcb, TCP_CTL_RST, tcb->snd_nxt, NULL, 0);
+            _terminate(tcb, 0);
+            return false;
+        default:
+            tcb->flags |= _FLAG_CLOSE;
+            _output(tcb);
+            _timer_update();
+            return true;
+    }
+}
+
+void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
+{
+    mutex_lock(&_lock);
+    if (_close(tcb)) {
+        while (tcb->state != GNRC_TCP_STATE_CLOSED) {
+            _wait(&tcb->mbox, SOCK_NO_TIMEOUT, 0);
+        }
+    }
+    /* hand a passive connection back to its listener */
+    tcb->flags = 0;
+    _timer_update();
+    mutex_unlock(&_lock);
+}
+
+void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
+{
+    mutex_lock(&_lock);
+    if (tcb->state != GNRC_TCP_STATE_CLOSED) {
+        if (tcb->state != GNRC_TCP_STATE_SYN_SENT) {
+            _tcb_xmit(tcb, TCP_CTL_RST, tcb->snd_nxt, NULL, 0);
+        }
+        _terminate(tcb, -ECONNABORTED);
+    }
+    tcb->flags = 0;
+    _timer_update();
+    mutex_unlock(&_lock);
+}
+
+int gnrc_tcp_init(void)
+{
+    /* check if thread is already running */
+    if (_pid == KERNEL_PID_UNDEF) {
+        /* start TCP thread */
+        _pid = thread_create(_stack, sizeof(_stack), GNRC_TCP_PRIO,
+                             THREAD_CREATE_STACKTEST, _event_loop, NULL, "tcp");
+    }
+    return _pid;
+}
+
+#ifdef TEST_SUITES
+void gnrc_tcp_receive(gnrc_pktsnip_t *pkt)
+{
+    _receive(pkt);
+}
+
+void gnrc_tcp_expire_timers(void)
+{
+    gnrc_tcp_tcb_t *tcb;
+    uint32_t now = xtimer_now_usec();
+
+    mutex_lock(&_lock);
+    LL_FOREACH(_tcbs, tcb) {
+        tcb->rtx_deadline = now;
+        tcb->ack_deadline = now;
+    }
+    mutex_unlock(&_lock);
+    _timeout();
+}
+
+void gnrc_tcp_close_start(gnrc_tcp_tcb_t *tcb)
+{
+    mutex_lock(&_lock);
+    _close(tcb);
+    mutex_unlock(&_lock);
+}
+
+uint16_t gnrc_tcp_parse_mss(const tcp_hdr_t *hdr, size_t hdr_len)
+{
+    return _parse_mss(hdr, hdr_len);
+}
+#endif
@@ -28,16 +28,43 @@
 #include "net/gnrc/udp.h"
 #include "net/gnrc.h"
 #include "net/inet_csum.h"
+#ifdef MODULE_GNRC_UDP_EVENT
+#include "cib.h"
+#include "event.h"
+#include "irq.h"
+#endif
+#ifdef MODULE_GNRC_PKTTRACE
+#include "net/gnrc/pkttrace.h"
+#endif
 
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_NETSTATS_UDP
+static netstats_udp_t _stats;
+#define _STATS_INC(field)   (_stats.field++)
+#else
+#define _STATS_INC(field)
+#endif
+
 /**
  * @brief   Save the UDP's thread PID for later reference
  */
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 
+#ifdef MODULE_GNRC_UDP_EVENT
+/**
+ * @brief   A packet waiting for the shared event thread
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;    /**< the packet */
+    uint16_t cmd;           /**< GNRC_NETAPI_MSG_TYPE_SND or _RCV */
+} _queued_t;
+
+static _queued_t _queue[GNRC_UDP_MSG_QUEUE_SIZE];
+static cib_t _queue_cib = CIB_INIT(GNRC_UDP_MSG_QUEUE_SIZE);
+#else
 /**
  * @brief   Allocate memory for the UDP thread's stack
  */
@@ -46,6 +73,7 @@ static char _stack[GNRC_UDP_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
 #else
 static char _stack[GNRC_UDP_STACK_SIZE];
 #endif
+#endif
 
 /**
  * @brief   Calculate the UDP checksum dependent on the network protocol
@@ -104,10 +132,12 @@ static void _receive(gnrc_pktsnip_t *pkt)
     udp_hdr_t *hdr;
     uint32_t port;
 
+    _STATS_INC(rx_count);
     /* mark UDP header */
     udp = gnrc_pktbuf_start_write(pkt);
     if (udp == NULL) {
         DEBUG("udp: unable to get write access to packet\n");
+        _STATS_INC(nobuf);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -126,6 +156,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
         udp = gnrc_pktbuf_mark(pkt, sizeof(udp_hdr_t), GNRC_NETTYPE_UDP);
         if (udp == NULL) {
             DEBUG("udp: error marking UDP header, dropping packet\n");
+            _STATS_INC(nobuf);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -142,11 +173,15 @@ static void _receive(gnrc_pktsnip_t *pkt)
          * and should log the error."
          */
         DEBUG("udp: received packet with zero checksum, dropping it\n");
+        _STATS_INC(rx_csum_err);
         gnrc_pktbuf_release(pkt);
         return;
     }
-    if (_calc_csum(udp, ipv6, pkt) != 0xFFFF) {
+    if (!(gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_CSUM) &&
+        /* device did not verify the checksum already */
+        (_calc_csum(udp, ipv6, pkt) != 0xFFFF)) {
         DEBUG("udp: received packet with invalid checksum, dropping it\n");
+        _STATS_INC(rx_csum_err);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -157,6 +192,7 @@ static void _receive(gnrc_pktsnip_t *pkt)
     /* send payload to receivers */
     if (!gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP, port, pkt)) {
         DEBUG("udp: unable to forward packet as no one is interested in it\n");
+        _STATS_INC(rx_no_receiver);
         gnrc_pktbuf_release(pkt);
     }
 }
@@ -171,6 +207,7 @@ static void _send(gnrc_pktsnip_t *pkt)
     tmp = gnrc_pktbuf_start_write(pkt);
     if (tmp == NULL) {
         DEBUG("udp: cannot send packet: unable to allocate packet\n");
+        _STATS_INC(nobuf);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -182,6 +219,7 @@ static void _send(gnrc_pktsnip_t *pkt)
         udp_snip = gnrc_pktbuf_start_write(udp_snip);
         if (udp_snip == NULL) {
             DEBUG("udp: cannot send packet: unable to allocate packet\n");
+            _STATS_INC(nobuf);
             gnrc_pktbuf_release(pkt);
             return;
         }
@@ -196,6 +234,7 @@ static void _send(gnrc_pktsnip_t *pkt)
     udp_snip = gnrc_pktbuf_start_write(udp_snip);
     if (udp_snip == NULL) {
         DEBUG("udp: cannot send packet: unable to allocate packet\n");
+        _STATS_INC(nobuf);
         gnrc_pktbuf_release(pkt);
         return;
     }
@@ -213,15 +252,99 @@ static void _send(gnrc_pktsnip_t *pkt)
     if (!gnrc_netapi_dispatch_send(target_type, GNRC_NETREG_DEMUX_CTX_ALL,
                                    pkt)) {
         DEBUG("udp: cannot send packet: network layer not found\n");
+        _STATS_INC(tx_dropped);
         gnrc_pktbuf_release(pkt);
+        return;
+    }
+    _STATS_INC(tx_count);
+}
+
+#if defined(MODULE_NETSTATS_UDP) && !defined(MODULE_GNRC_UDP_EVENT)
+static int _get_stats(gnrc_netapi_opt_t *opt)
+{
+    if ((opt->context != NETSTATS_UDP) || (opt->data_len != sizeof(uintptr_t))) {
+        return -ENOTSUP;
     }
+    *((netstats_udp_t **)opt->data) = &_stats;
+    return sizeof(uintptr_t);
 }
+#endif
+
+static void _handle(uint16_t cmd, gnrc_pktsnip_t *pkt)
+{
+    switch (cmd) {
+        case GNRC_NETAPI_MSG_TYPE_RCV:
+            DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
+#ifdef MODULE_GNRC_PKTTRACE
+            gnrc_pkttrace_hop(pkt, GNRC_PKTTRACE_RX_UDP);
+#endif
+            _receive(pkt);
+            break;
+        case GNRC_NETAPI_MSG_TYPE_SND:
+            DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
+#ifdef MODULE_GNRC_PKTTRACE
+            gnrc_pkttrace_hop(pkt, GNRC_PKTTRACE_TX_UDP);
+#endif
+            _send(pkt);
+            break;
+        default:
+            break;
+    }
+}
+
+#ifdef MODULE_GNRC_UDP_EVENT
+static void _event_handler(event_t *event)
+{
+    (void)event;
+
+    while (1) {
+        _queued_t queued;
+        unsigned state = irq_disable();
+        int idx = cib_get(&_queue_cib);
 
+        /* copy the entry out before the slot can be reused */
+        if (idx >= 0) {
+            queued = _queue[idx];
+        }
+        irq_restore(state);
+        if (idx < 0) {
+            break;
+        }
+        _handle(queued.cmd, queued.pkt);
+    }
+}
+
+static event_t _event = { .handler = _event_handler };
+
+/* runs in the context of the thread that dispatched the packet */
+static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)ctx;
+    unsigned state = irq_disable();
+    int idx = cib_put(&_queue_cib);
+
+    if (idx >= 0) {
+        _queue[idx].pkt = pkt;
+        _queue[idx].cmd = cmd;
+    }
+    irq_restore(state);
+    if (idx < 0) {
+        DEBUG("udp: queue full, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    event_post(&event_queue_shared, &_event);
+}
+
+static gnrc_netreg_entry_cbd_t _netreg_cbd = { .cb = _netapi_cb };
+static gnrc_netreg_entry_t _netreg;
+#else
 static void *_event_loop(void *arg)
 {
     (void)arg;
     msg_t msg, reply;
     msg_t msg_queue[GNRC_UDP_MSG_QUEUE_SIZE];
+    gnrc_netapi_backlog_t backlog = { 0 };
     gnrc_netreg_entry_t netreg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
     /* preset reply message */
@@ -234,18 +357,24 @@ static void *_event_loop(void *arg)
 
     /* dispatch NETAPI messages */
     while (1) {
-        msg_receive(&msg);
+        gnrc_netapi_receive_prio(&backlog, &msg);
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
-                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_RCV\n");
-                _receive(msg.content.ptr);
-                break;
             case GNRC_NETAPI_MSG_TYPE_SND:
-                DEBUG("udp: GNRC_NETAPI_MSG_TYPE_SND\n");
-                _send(msg.content.ptr);
+                _handle(msg.type, msg.content.ptr);
                 break;
-            case GNRC_NETAPI_MSG_TYPE_SET:
             case GNRC_NETAPI_MSG_TYPE_GET:
+#ifdef MODULE_NETSTATS_UDP
+                if (((gnrc_netapi_opt_t *)msg.content.ptr)->opt == NETOPT_STATS) {
+                    msg_t stats_reply = { .type = GNRC_NETAPI_MSG_TYPE_ACK };
+
+                    stats_reply.content.value = _get_stats(msg.content.ptr);
+                    msg_reply(&msg, &stats_reply);
+                    break;
+                }
+#endif
+                /* falls through */
+            case GNRC_NETAPI_MSG_TYPE_SET:
                 msg_reply(&msg, &reply);
                 break;
             default:
@@ -257,6 +386,7 @@ static void *_event_loop(void *arg)
     /* never reached */
     return NULL;
 }
+#endif
 
 int gnrc_udp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
 {
@@ -296,13 +426,31 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
     return res;
 }
 
+#ifdef MODULE_NETSTATS_UDP
+netstats_udp_t *gnrc_udp_get_stats(void)
+{
+    return &_stats;
+}
+#endif
+
 int gnrc_udp_init(void)
 {
+#ifdef MODULE_GNRC_UDP_EVENT
+    if (_pid == KERNEL_PID_UNDEF) {
+        /* packets are queued by the callback and handled by the shared
+         * event thread */
+        gnrc_netreg_entry_init_cb(&_netreg, GNRC_NETREG_DEMUX_CTX_ALL,
+                                  &_netreg_cbd);
+        gnrc_netreg_register(GNRC_NETTYPE_UDP, &_netreg);
+        _pid = event_queue_shared.waiter->pid;
+    }
+#else
     /* check if thread is already running */
     if (_pid == KERNEL_PID_UNDEF) {
         /* start UDP thread */
         _pid = thread_create(_stack, sizeof(_stack), GNRC_UDP_PRIO,
                              THREAD_CREATE_STACKTEST, _event_loop, NULL, "udp");
     }
+#endif
     return _pid;
 }
@@ -22,6 +22,7 @@
 #include <errno.h>
 #include <stdbool.h>
 
+#include "thread.h"
 #include "xtimer.h"
 #include "random.h"
 #include "net/netdev2.h"
@@ -63,11 +64,15 @@ static inline uint32_t choose_backoff_period(int be,
     if (be > conf->max_be) {
         be = conf->max_be;
     }
-    uint32_t max_backoff = ((1 << be) - 1) * CSMA_SENDER_BACKOFF_PERIOD_UNIT;
+    uint32_t max_backoff = ((1 << be) - 1) * conf->backoff_period;
+
+    if (max_backoff < conf->backoff_period) {
+        return conf->backoff_period;
+    }
 
     uint32_t period = random_uint32() % max_backoff;
-    if (period < CSMA_SENDER_BACKOFF_PERIOD_UNIT) {
-        period = CSMA_SENDER_BACKOFF_PERIOD_UNIT;
+    if (period < conf->backoff_period) {
+        period = conf->backoff_period;
     }
 
     return period;
@@ -115,24 +120,25 @@ static int send_if_cca(netdev2_t *device, struct iovec *vector, unsigned count)
     return -EBUSY;
 }
 
-/*------------------------- "EXPORTED" FUNCTIONS -------------------------*/
-
-int csma_sender_csma_ca_send(netdev2_t *dev, struct iovec *vector,
-                             unsigned count, const csma_sender_conf_t *conf)
+/**
+ * @brief Check if the transceiver does CSMA/CA in hardware
+ *
+ * @param[in] device    netdev device, needs to be already initialized
+ *
+ * @return              1 if the device does CSMA/CA when sending
+ * @return              0 if CSMA/CA must be done in software
+ * @return              -ENODEV if @p device is invalid
+ * @return              -ECANCELED if an internal driver error occurred
+ */
+static int hw_csma(netdev2_t *device)
 {
     netopt_enable_t hwfeat;
 
-    assert(dev);
-    /* choose default configuration if none is given */
-    if (conf == NULL) {
-        conf = &CSMA_SENDER_CONF_DEFAULT;
-    }
     /* Does the transceiver do automatic CSMA/CA when sending? */
-    int res = dev->driver->get(dev,
-                               NETOPT_CSMA,
-                               (void *) &hwfeat,
-                               sizeof(netopt_enable_t));
-    bool ok = false;
+    int res = device->driver->get(device,
+                                  NETOPT_CSMA,
+                                  (void *) &hwfeat,
+                                  sizeof(netopt_enable_t));
 
     switch (res) {
         case -ENODEV:
@@ -140,17 +146,46 @@ int csma_sender_csma_ca_send(netdev2_t *dev, struct iovec *vector,
             return -ENODEV;
         case -ENOTSUP:
             /* device doesn't make auto-CSMA/CA */
-            break;
+            return 0;
         case -EOVERFLOW: /* (normally impossible...*/
         case -ECANCELED:
             DEBUG("csma: !!! DEVICE DRIVER FAILURE! TRANSMISSION ABORTED!\n");
             /* internal driver error! */
             return -ECANCELED;
         default:
-            ok = (hwfeat == NETOPT_ENABLE);
+            return (hwfeat == NETOPT_ENABLE);
     }
+}
 
-    if (ok) {
+/**
+ * @brief Start the next backoff period of an asynchronous transmission
+ *
+ * @param[in] csma      the transmission
+ */
+static inline void async_backoff(csma_sender_t *csma)
+{
+    uint32_t bp = choose_backoff_period(csma->be, csma->conf);
+
+    DEBUG("csma: backoff for %" PRIu32 " us\n", bp);
+    xtimer_set_msg(&csma->timer, bp, &csma->msg, csma->pid);
+}
+
+/*------------------------- "EXPORTED" FUNCTIONS -------------------------*/
+
+int csma_sender_csma_ca_send(netdev2_t *dev, struct iovec *vector,
+                             unsigned count, const csma_sender_conf_t *conf)
+{
+    assert(dev);
+    /* choose default configuration if none is given */
+    if (conf == NULL) {
+        conf = &CSMA_SENDER_CONF_DEFAULT;
+    }
+    int res = hw_csma(dev);
+
+    if (res < 0) {
+        return res;
+    }
+    if (res > 0) {
         /* device does CSMA/CA all by itself: let it do its job */
         DEBUG("csma: Network device does hardware CSMA/CA\n");
         return dev->driver->send(dev, vector, count);
@@ -163,7 +198,7 @@ int csma_sender_csma_ca_send(netdev2_t *dev, struct iovec *vector,
 
     int nb = 0, be = conf->min_be;
 
-    while (nb <= conf->max_be) {
+    while (nb <= conf->max_backoffs) {
         /* delay for an adequate random backoff period */
         uint32_t bp = choose_backoff_period(be, conf);
         xtimer_usleep(bp);
@@ -194,6 +229,67 @@ int csma_sender_csma_ca_send(netdev2_t *dev, struct iovec *vector,
     return -EBUSY;
 }
 
+void csma_sender_csma_ca_send_async(csma_sender_t *csma, netdev2_t *dev,
+                                    struct iovec *vector, unsigned count,
+                                    const csma_sender_conf_t *conf,
+                                    csma_sender_cb_t cb)
+{
+    assert(csma && dev && cb);
+    /* choose default configuration if none is given */
+    if (conf == NULL) {
+        conf = &CSMA_SENDER_CONF_DEFAULT;
+    }
+    csma->dev = dev;
+    csma->vector = vector;
+    csma->count = count;
+    csma->conf = conf;
+    csma->cb = cb;
+
+    int res = hw_csma(dev);
+
+    if (res < 0) {
+        cb(csma, res);
+        return;
+    }
+    if (res > 0) {
+        /* device does CSMA/CA all by itself: let it do its job */
+        DEBUG("csma: Network device does hardware CSMA/CA\n");
+        cb(csma, dev->driver->send(dev, vector, count));
+        return;
+    }
+
+    DEBUG("csma: Starting asynchronous software CSMA/CA....\n");
+    csma->pid = thread_getpid();
+    csma->msg.type = CSMA_SENDER_MSG_TYPE_BACKOFF;
+    csma->msg.content.ptr = csma;
+    csma->nb = 0;
+    csma->be = conf->min_be;
+    async_backoff(csma);
+}
+
+void csma_sender_backoff_done(csma_sender_t *csma)
+{
+    /* try to send after a CCA */
+    int res = send_if_cca(csma->dev, csma->vector, csma->count);
+
+    if (res != -EBUSY) {
+        /* TX done or something has gone wrong */
+        csma->cb(csma, res);
+        return;
+    }
+
+    /* medium is busy: increment CSMA counters */
+    if (csma->be < csma->conf->max_be) {
+        csma->be++;
+    }
+    if (++csma->nb > csma->conf->max_backoffs) {
+        DEBUG("csma: Software CSMA/CA failure: medium never available.\n");
+        csma->cb(csma, -EBUSY);
+        return;
+    }
+    /* ... and try again if we have no exceeded the retry limit */
+    async_backoff(csma);
+}
 
 int csma_sender_cca_send(netdev2_t *dev, struct iovec *vector, unsigned count)
 {
@@ -19,6 +19,7 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -42,6 +43,14 @@
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #endif
 
+#ifdef MODULE_GNRC_IPV6_ROUTE_CACHE
+#include "net/gnrc/ipv6/route_cache.h"
+/* next hops derived from the FIB may have changed */
+#define _ROUTES_CHANGED()   gnrc_ipv6_route_cache_invalidate()
+#else
+#define _ROUTES_CHANGED()
+#endif
+
 #ifdef MODULE_IPV6_ADDR
     #define FIB_ADDR_PRINT_LEN      39
 #else
@@ -65,6 +74,429 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * MS_IN_USEC);
 }
 
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+static int fib_signal_rp(fib_table_t *table, uint16_t type, uint8_t *dat,
+                         size_t dat_size, uint32_t dat_flags);
+
+#ifdef MODULE_FIB_TRIE
+/**
+ * @brief returns the bit at position @p pos (0 is the MSB of the first byte)
+ */
+static inline unsigned _trie_bit(const uint8_t *key, size_t pos)
+{
+    return (key[pos >> 3] >> (7 - (pos & 7))) & 0x01;
+}
+
+/**
+ * @brief returns the number of equal leading bits of @p a and @p b,
+ *        at most @p max
+ */
+static size_t _trie_common_bits(const uint8_t *a, const uint8_t *b, size_t max)
+{
+    size_t i = 0;
+
+    while ((i + 8) <= max) {
+        if (a[i >> 3] != b[i >> 3]) {
+            break;
+        }
+        i += 8;
+    }
+    while ((i < max) && (_trie_bit(a, i) == _trie_bit(b, i))) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief returns the prefix length in bits an entry is matched with
+ */
+static uint16_t _trie_entry_len(fib_entry_t *entry)
+{
+    size_t size = entry->global->address_size;
+    size_t len = size << 3;
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        if (entry->global->address[i] != 0) {
+            break;
+        }
+    }
+    if (i == size) {
+        /* default route, e.g. ::/0 for IPv6 */
+        return 0;
+    }
+    if (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) {
+        size_t prefix_len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                            >> FIB_FLAG_NET_PREFIX_SHIFT;
+        if (prefix_len < len) {
+            len = prefix_len;
+        }
+    }
+    return (uint16_t)len;
+}
+
+/**
+ * @brief returns the bits of a node, taken from an entry below it for
+ *        branching nodes
+ */
+static const uint8_t *_trie_key(fib_trie_node_t *node)
+{
+    /* branching nodes always have two children */
+    while (node->entry == NULL) {
+        node = node->child[0];
+    }
+    return node->entry->global->address;
+}
+
+/**
+ * @brief replaces @p old by @p new (may be NULL) in the trie
+ */
+static void _trie_replace(fib_table_t *table, fib_trie_node_t *old,
+                          fib_trie_node_t *new)
+{
+    fib_trie_node_t *parent = old->parent;
+
+    if (new != NULL) {
+        new->parent = parent;
+    }
+    if (parent == NULL) {
+        table->trie_root = new;
+    }
+    else {
+        parent->child[(parent->child[1] == old)] = new;
+    }
+}
+
+/**
+ * @brief moves the children of @p from to @p to
+ */
+static void _trie_move_children(fib_trie_node_t *from, fib_trie_node_t *to)
+{
+    for (unsigned i = 0; i < 2; i++) {
+        to->child[i] = from->child[i];
+        if (to->child[i] != NULL) {
+            to->child[i]->parent = to;
+        }
+        from->child[i] = NULL;
+    }
+}
+
+static fib_trie_node_t *_trie_branch_alloc(fib_table_t *table, uint16_t len)
+{
+    fib_trie_node_t *branches = &table->trie_nodes[table->size];
+
+    for (size_t i = 0; i < table->size; i++) {
+        /* unused branching nodes have no children */
+        if (branches[i].child[0] == NULL) {
+            branches[i].len = len;
+            return &branches[i];
+        }
+    }
+    /* there are always less branching nodes than entries */
+    assert(false);
+    return NULL;
+}
+
+static inline void _trie_branch_free(fib_trie_node_t *node)
+{
+    memset(node, 0, sizeof(fib_trie_node_t));
+}
+
+static void _trie_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_trie_node_t *new = &table->trie_nodes[entry - table->data.entries];
+    fib_trie_node_t *node = table->trie_root, *parent = NULL;
+    const uint8_t *key = entry->global->address;
+    uint16_t len = _trie_entry_len(entry);
+
+    memset(new, 0, sizeof(fib_trie_node_t));
+    new->entry = entry;
+    new->len = len;
+
+    while (node != NULL) {
+        size_t common = _trie_common_bits(key, _trie_key(node),
+                                          (len < node->len) ? len : node->len);
+
+        if (common < node->len) {
+            /* the new prefix ends or diverges above node */
+            _trie_replace(table, node, new);
+            if (common == len) {
+                new->child[_trie_bit(_trie_key(node), len)] = node;
+                node->parent = new;
+            }
+            else {
+                fib_trie_node_t *branch = _trie_branch_alloc(table, common);
+
+                _trie_replace(table, new, branch);
+                branch->child[_trie_bit(key, common)] = new;
+                branch->child[_trie_bit(_trie_key(node), common)] = node;
+                new->parent = branch;
+                node->parent = branch;
+            }
+            return;
+        }
+        if (node->len == len) {
+            if (node->entry == NULL) {
+                /* the new entry takes the place of the branching node */
+                _trie_replace(table, node, new);
+                _trie_move_children(node, new);
+                _trie_branch_free(node);
+            }
+            else {
+                /* same prefix as another entry */
+                new->dup = node->dup;
+                if (new->dup != NULL) {
+                    new->dup->parent = new;
+                }
+                node->dup = new;
+                new->parent = node;
+            }
+            return;
+        }
+        parent = node;
+        node = node->child[_trie_bit(key, node->len)];
+    }
+    new->parent = parent;
+    if (parent == NULL) {
+        table->trie_root = new;
+    }
+    else {
+        parent->child[_trie_bit(key, parent->len)] = new;
+    }
+}
+
+static void _trie_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    fib_trie_node_t *node = &table->trie_nodes[entry - table->data.entries];
+    fib_trie_node_t *parent = node->parent;
+
+    if (node->entry == NULL) {
+        /* not in the trie */
+        return;
+    }
+    if ((parent != NULL) && (parent->dup == node)) {
+        /* unlink from the list of equal prefixes */
+        parent->dup = node->dup;
+        if (node->dup != NULL) {
+            node->dup->parent = parent;
+        }
+    }
+    else if (node->dup != NULL) {
+        fib_trie_node_t *dup = node->dup;
+
+        _trie_replace(table, node, dup);
+        _trie_move_children(node, dup);
+    }
+    else if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+        fib_trie_node_t *branch = _trie_branch_alloc(table, node->len);
+
+        _trie_replace(table, node, branch);
+        _trie_move_children(node, branch);
+    }
+    else {
+        fib_trie_node_t *child = (node->child[0] != NULL) ? node->child[0]
+                                                          : node->child[1];
+        _trie_replace(table, node, child);
+        if ((child == NULL) && (parent != NULL) && (parent->entry == NULL)) {
+            /* parent is a branching node with only one child left */
+            _trie_replace(table, parent,
+                          (parent->child[0] != NULL) ? parent->child[0]
+                                                     : parent->child[1]);
+            _trie_branch_free(parent);
+        }
+    }
+    memset(node, 0, sizeof(fib_trie_node_t));
+}
+
+/**
+ * @brief trie variant of fib_find_entry()
+ */
+static int _trie_find(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                      fib_entry_t **entry_arr, size_t *entry_arr_size)
+{
+    fib_trie_node_t *node = table->trie_root;
+    size_t dst_len = dst_size << 3;
+    fib_entry_t *best = NULL;
+
+    while ((node != NULL) && (node->len <= dst_len)) {
+        if (node->entry != NULL) {
+            if (_trie_common_bits(dst, node->entry->global->address,
+                                  node->len) < node->len) {
+                /* no entry below can match either */
+                break;
+            }
+            fib_entry_t *match = NULL;
+
+            for (fib_trie_node_t *n = node; n != NULL; n = n->dup) {
+                if (n->entry->global->address_size != dst_size) {
+                    continue;
+                }
+                if (memcmp(n->entry->global->address, dst, dst_size) == 0) {
+                    entry_arr[0] = n->entry;
+                    *entry_arr_size = 1;
+                    return 1;
+                }
+                if (match == NULL) {
+                    match = n->entry;
+                }
+            }
+            if (match != NULL) {
+                /* deeper nodes have longer prefixes */
+                best = match;
+            }
+        }
+        if (node->len == dst_len) {
+            break;
+        }
+        node = node->child[_trie_bit(dst, node->len)];
+    }
+
+    if (best == NULL) {
+        *entry_arr_size = 0;
+        return -EHOSTUNREACH;
+    }
+    entry_arr[0] = best;
+    *entry_arr_size = 1;
+    return 0;
+}
+
+static void _trie_reset(fib_table_t *table)
+{
+    if (table->trie_nodes != NULL) {
+        memset(table->trie_nodes, 0,
+               FIB_TRIE_NODES_NUMOF(table->size) * sizeof(fib_trie_node_t));
+    }
+    table->trie_root = NULL;
+}
+#endif /* MODULE_FIB_TRIE */
+
+static void _expiry_cb(void *arg)
+{
+    ((fib_table_t *)arg)->expired = 1;
+}
+
+/**
+ * @brief sets the expiry timer of @p table to fib_table_t::next_expiry
+ */
+static void _expiry_arm(fib_table_t *table)
+{
+    uint64_t now;
+    uint64_t offset = 0;
+
+    xtimer_remove(&table->expiry_timer);
+    if (table->next_expiry == FIB_LIFETIME_NO_EXPIRE) {
+        return;
+    }
+    now = xtimer_now_usec64();
+    if (table->next_expiry > now) {
+        offset = table->next_expiry - now;
+    }
+    if (offset > UINT32_MAX) {
+        /* fires early, the sweep then just sets the timer again */
+        offset = UINT32_MAX;
+    }
+    table->expiry_timer.callback = _expiry_cb;
+    table->expiry_timer.arg = table;
+    xtimer_set(&table->expiry_timer, (uint32_t)offset);
+}
+
+/**
+ * @brief notes the lifetime of a new or updated entry for the expiry timer
+ */
+static void _expiry_update(fib_table_t *table, uint64_t lifetime)
+{
+    if (lifetime < table->next_expiry) {
+        table->next_expiry = lifetime;
+        _expiry_arm(table);
+    }
+}
+
+/**
+ * @brief number of expired entries removed before the RPs are signaled
+ */
+#define FIB_EXPIRED_NUMOF   (4U)
+
+/**
+ * @brief an expired entry, kept to signal it to the RPs after the table
+ *        mutex was released
+ */
+typedef struct {
+    uint8_t address[UNIVERSAL_ADDRESS_SIZE];    /**< destination */
+    size_t address_size;                        /**< size of address */
+    uint32_t address_flags;                     /**< flags of the entry */
+} _expired_t;
+
+/**
+ * @brief removes up to @p expired_numof expired entries in bulk, called with
+ *        the table mutex held after the expiry timer fired
+ *
+ * @return  the number of entries removed and written to @p expired.
+ *          fib_table_t::expired stays set if there are more.
+ */
+static size_t _expiry_sweep(fib_table_t *table, _expired_t *expired,
+                            size_t expired_numof)
+{
+    uint64_t now = xtimer_now_usec64();
+    size_t num = 0;
+
+    table->expired = 0;
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_entry_t *entry = &table->data.entries[i];
+
+        if ((entry->lifetime == 0) || (entry->lifetime == FIB_LIFETIME_NO_EXPIRE)) {
+            continue;
+        }
+        if (entry->lifetime <= now) {
+            if (num == expired_numof) {
+                /* the caller comes back for the rest */
+                table->expired = 1;
+                return num;
+            }
+            expired[num].address_size = entry->global->address_size;
+            memcpy(expired[num].address, entry->global->address,
+                   expired[num].address_size);
+            expired[num].address_flags = entry->global_flags;
+            num++;
+            fib_remove(table, entry);
+        }
+        else if (entry->lifetime < table->next_expiry) {
+            table->next_expiry = entry->lifetime;
+        }
+    }
+    _expiry_arm(table);
+    return num;
+}
+
+/**
+ * @brief removes the expired entries once the expiry timer fired and signals
+ *        them to the RPs
+ *
+ * Must be called without holding the table mutex: fib_signal_rp() waits for
+ * the reply of each RP, and an RP may refresh the route from its handler.
+ */
+static void _expiry_handle(fib_table_t *table)
+{
+    while (table->expired) {
+        _expired_t expired[FIB_EXPIRED_NUMOF];
+        size_t num = 0;
+
+        mutex_lock(&(table->mtx_access));
+        if (table->expired) {
+            num = _expiry_sweep(table, expired, FIB_EXPIRED_NUMOF);
+        }
+        mutex_unlock(&(table->mtx_access));
+
+        /* let the responsible RPs refresh the routes if they want to */
+        for (size_t i = 0; i < num; i++) {
+            fib_signal_rp(table, FIB_MSG_RP_SIGNAL_ENTRY_EXPIRED,
+                          expired[i].address, expired[i].address_size,
+                          expired[i].address_flags);
+        }
+    }
+}
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -81,8 +513,6 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
-    uint64_t now = xtimer_now_usec64();
-
     size_t count = 0;
     size_t prefix_size = 0;
     size_t match_size = dst_size << 3;
@@ -97,6 +527,12 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     DEBUG("\n");
 #endif
 
+#ifdef MODULE_FIB_TRIE
+    if (table->trie_nodes != NULL) {
+        return _trie_find(table, dst, dst_size, entry_arr, entry_arr_size);
+    }
+#endif
+
     for (size_t i = 0; i < dst_size; ++i) {
         if (dst[i] != 0) {
             is_all_zeros_addr = false;
@@ -105,30 +541,6 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     }
 
     for (size_t i = 0; i < table->size; ++i) {
-
-        /* autoinvalidate if the entry lifetime is not set to not expire */
-        if (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE) {
-
-            /* check if the lifetime expired */
-            if (table->data.entries[i].lifetime < now) {
-                /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
-
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
-                }
-
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
-                }
-            }
-        }
-
         if ((prefix_size < (dst_size<<3)) && (table->data.entries[i].global != NULL)) {
 
             int ret_comp = universal_address_compare(table->data.entries[i].global, dst, &match_size);
@@ -192,6 +604,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table the entry belongs to
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -201,7 +614,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @return 0 if the entry has been updated
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry, uint8_t *next_hop,
                          size_t next_hop_size, uint32_t next_hop_flags,
                          uint32_t lifetime)
 {
@@ -221,6 +634,8 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
     else {
         entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
     }
+    _expiry_update(table, entry->lifetime);
+    _ROUTES_CHANGED();
 
     return 0;
 }
@@ -237,6 +652,9 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
  * @param[in] next_hop_size  the next hop address size
  * @param[in] next_hop_flags the next-hop address flags
  * @param[in] lifetime       the lifetime in ms
+ * @param[in, out] free_idx  index to start searching for a free entry at.
+ *                           Set to the index after the created entry, so
+ *                           a batch of entries is created in one pass.
  *
  * @return 0 on success
  *         -ENOMEM if no new entry can be created
@@ -244,9 +662,9 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
 static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                             uint8_t *dst, size_t dst_size, uint32_t dst_flags,
                             uint8_t *next_hop, size_t next_hop_size, uint32_t
-                            next_hop_flags, uint32_t lifetime)
+                            next_hop_flags, uint32_t lifetime, size_t *free_idx)
 {
-    for (size_t i = 0; i < table->size; ++i) {
+    for (size_t i = *free_idx; i < table->size; ++i) {
         if (table->data.entries[i].lifetime == 0) {
 
             table->data.entries[i].global = universal_address_add(dst, dst_size);
@@ -260,6 +678,9 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
             if (table->data.entries[i].next_hop != NULL) {
                 /* everything worked fine */
                 table->data.entries[i].iface_id = iface_id;
+#ifdef MODULE_FIB_MULTIPATH
+                table->data.entries[i].weight = FIB_WEIGHT_DEFAULT;
+#endif
 
                 if (lifetime != (uint32_t) FIB_LIFETIME_NO_EXPIRE) {
                     fib_lifetime_to_absolute(lifetime, &table->data.entries[i].lifetime);
@@ -267,9 +688,24 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                 else {
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
+#ifdef MODULE_FIB_TRIE
+                if (table->trie_nodes != NULL) {
+                    _trie_insert(table, &table->data.entries[i]);
+                }
+#endif
+                _expiry_update(table, table->data.entries[i].lifetime);
+                _ROUTES_CHANGED();
+                *free_idx = i + 1;
 
                 return 0;
             }
+            else if (table->data.entries[i].global != NULL) {
+                /* free entries are not cleaned up on lookup, so do not leave
+                 * the destination behind */
+                universal_address_rem(table->data.entries[i].global);
+                table->data.entries[i].global = NULL;
+                table->data.entries[i].global_flags = 0;
+            }
         }
     }
 
@@ -279,12 +715,20 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table the entry belongs to
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+#ifdef MODULE_FIB_TRIE
+    if (table->trie_nodes != NULL) {
+        _trie_remove(table, entry);
+    }
+#else
+    (void)table;
+#endif
     if (entry->global != NULL) {
         universal_address_rem(entry->global);
     }
@@ -300,6 +744,10 @@ static int fib_remove(fib_entry_t *entry)
 
     entry->iface_id = KERNEL_PID_UNDEF;
     entry->lifetime = 0;
+#ifdef MODULE_FIB_MULTIPATH
+    entry->weight = 0;
+#endif
+    _ROUTES_CHANGED();
 
     return 0;
 }
@@ -388,6 +836,7 @@ int fib_add_entry(fib_table_t *table,
                   uint32_t dst_flags, uint8_t *next_hop, size_t next_hop_size,
                   uint32_t next_hop_flags, uint32_t lifetime)
 {
+    _expiry_handle(table);
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_add_entry]\n");
     size_t count = 1;
@@ -399,25 +848,75 @@ int fib_add_entry(fib_table_t *table,
         return -EFAULT;
     }
 
+    size_t free_idx = 0;
     int ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count);
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
-                               next_hop, next_hop_size, next_hop_flags, lifetime);
+                               next_hop, next_hop_size, next_hop_flags, lifetime,
+                               &free_idx);
     }
 
     mutex_unlock(&(table->mtx_access));
     return ret;
 }
 
+int fib_add_entries(fib_table_t *table, kernel_pid_t iface_id,
+                    const fib_dst_t *dsts, size_t dsts_numof, uint8_t *next_hop,
+                    size_t next_hop_size, uint32_t next_hop_flags,
+                    uint32_t lifetime)
+{
+    size_t free_idx = 0;
+    int res = 0;
+
+    if (next_hop == NULL) {
+        return -EFAULT;
+    }
+
+    _expiry_handle(table);
+    mutex_lock(&(table->mtx_access));
+    DEBUG("[fib_add_entries] %u entries\n", (unsigned)dsts_numof);
+
+    for (size_t i = 0; i < dsts_numof; i++) {
+        size_t count = 1;
+        fib_entry_t *entry[count];
+        int ret;
+
+        if (dsts[i].dst == NULL) {
+            res = -EFAULT;
+            continue;
+        }
+        if (fib_find_entry(table, dsts[i].dst, dsts[i].dst_size, &(entry[0]),
+                           &count) == 1) {
+            ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size,
+                                next_hop_flags, lifetime);
+        }
+        else {
+            /* the entries before free_idx are in use, the search for a
+             * free one continues from there */
+            ret = fib_create_entry(table, iface_id, dsts[i].dst,
+                                   dsts[i].dst_size, dsts[i].dst_flags,
+                                   next_hop, next_hop_size, next_hop_flags,
+                                   lifetime, &free_idx);
+        }
+        if ((ret < 0) && (res == 0)) {
+            res = ret;
+        }
+    }
+
+    mutex_unlock(&(table->mtx_access));
+    return res;
+}
+
 int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                      uint8_t *next_hop, size_t next_hop_size,
                      uint32_t next_hop_flags, uint32_t lifetime)
 {
+    _expiry_handle(table);
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_update_entry]\n");
     size_t count = 1;
@@ -433,7 +932,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -448,6 +947,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 
 void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 {
+    _expiry_handle(table);
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_remove_entry]\n");
     size_t count = 1;
@@ -457,7 +957,13 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
+#ifdef MODULE_FIB_MULTIPATH
+        /* and all other next hops of the destination */
+        while (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
+            fib_remove(table, entry[0]);
+        }
+#endif
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,18 +983,143 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
     mutex_unlock(&(table->mtx_access));
 }
 
-int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
-                     uint8_t *next_hop, size_t *next_hop_size,
-                     uint32_t *next_hop_flags, uint8_t *dst, size_t dst_size,
-                     uint32_t dst_flags)
+#ifdef MODULE_FIB_MULTIPATH
+static bool _same_dst(const fib_entry_t *a, const fib_entry_t *b)
+{
+    /* equal addresses share their container */
+    return (a->global == b->global) && (a->global_flags == b->global_flags);
+}
+
+/* selects one of the next hops of the destination of entry, weighted */
+static fib_entry_t *_select_next_hop(fib_table_t *table, fib_entry_t *entry,
+                                     uint32_t flow)
+{
+    unsigned total = 0;
+
+    for (size_t i = 0; i < table->size; ++i) {
+        if (_same_dst(&table->data.entries[i], entry)) {
+            total += table->data.entries[i].weight;
+        }
+    }
+    if (total == 0) {
+        /* only backups left */
+        return entry;
+    }
+    flow %= total;
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_entry_t *e = &table->data.entries[i];
+
+        if (_same_dst(e, entry)) {
+            if (flow < e->weight) {
+                return e;
+            }
+            flow -= e->weight;
+        }
+    }
+    /* not reached */
+    return entry;
+}
+
+static bool _addr_equal(universal_address_container_t *container,
+                        const uint8_t *addr, size_t addr_size)
+{
+    return (container != NULL) && (container->address_size == addr_size) &&
+           (memcmp(container->address, addr, addr_size) == 0);
+}
+
+static fib_entry_t *_find_next_hop(fib_table_t *table, uint8_t *dst,
+                                   size_t dst_size, uint8_t *next_hop,
+                                   size_t next_hop_size)
+{
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_entry_t *e = &table->data.entries[i];
+
+        if (_addr_equal(e->global, dst, dst_size) &&
+            _addr_equal(e->next_hop, next_hop, next_hop_size)) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+uint32_t fib_flow_hash(const void *data, size_t len, uint32_t seed)
+{
+    const uint8_t *p = data;
+    /* FNV-1a */
+    uint32_t hash = 2166136261U ^ seed;
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 16777619U;
+    }
+    /* the low bits select the next hop, fold the well-mixed high bits in */
+    return hash ^ (hash >> 16);
+}
+
+int fib_add_next_hop(fib_table_t *table, kernel_pid_t iface_id, uint8_t *dst,
+                     size_t dst_size, uint32_t dst_flags, uint8_t *next_hop,
+                     size_t next_hop_size, uint32_t next_hop_flags,
+                     uint8_t weight, uint32_t lifetime)
+{
+    fib_entry_t *entry;
+    size_t free_idx = 0;
+    int ret;
+
+    if ((dst == NULL) || (next_hop == NULL)) {
+        return -EFAULT;
+    }
+
+    _expiry_handle(table);
+    mutex_lock(&(table->mtx_access));
+    DEBUG("[fib_add_next_hop]\n");
+    entry = _find_next_hop(table, dst, dst_size, next_hop, next_hop_size);
+    if (entry != NULL) {
+        ret = fib_upd_entry(table, entry, next_hop, next_hop_size,
+                            next_hop_flags, lifetime);
+        entry->iface_id = iface_id;
+    }
+    else {
+        ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
+                               next_hop, next_hop_size, next_hop_flags,
+                               lifetime, &free_idx);
+        entry = &table->data.entries[free_idx - 1];
+    }
+    if (ret == 0) {
+        entry->weight = weight;
+    }
+    mutex_unlock(&(table->mtx_access));
+    return ret;
+}
+
+void fib_remove_next_hop(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                         uint8_t *next_hop, size_t next_hop_size)
+{
+    fib_entry_t *entry;
+
+    _expiry_handle(table);
+    mutex_lock(&(table->mtx_access));
+    DEBUG("[fib_remove_next_hop]\n");
+    entry = _find_next_hop(table, dst, dst_size, next_hop, next_hop_size);
+    if (entry != NULL) {
+        fib_remove(table, entry);
+    }
+    mutex_unlock(&(table->mtx_access));
+}
+#endif
+
+static int _get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
+                         uint8_t *next_hop, size_t *next_hop_size,
+                         uint32_t *next_hop_flags, uint8_t *dst,
+                         size_t dst_size, uint32_t dst_flags, uint32_t flow)
 {
+    _expiry_handle(table);
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_get_next_hop]\n");
     size_t count = 1;
@@ -518,6 +1149,11 @@ int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
     }
 
     if (ret == 0 || ret == 1) {
+#ifdef MODULE_FIB_MULTIPATH
+        entry[0] = _select_next_hop(table, entry[0], flow);
+#else
+        (void)flow;
+#endif
 
         uint8_t *address_ret = universal_address_get_address(entry[0]->next_hop,
                                next_hop, next_hop_size);
@@ -538,11 +1174,39 @@ int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
     return 0;
 }
 
+int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
+                     uint8_t *next_hop, size_t *next_hop_size,
+                     uint32_t *next_hop_flags, uint8_t *dst, size_t dst_size,
+                     uint32_t dst_flags)
+{
+    uint32_t flow = 0;
+
+#ifdef MODULE_FIB_MULTIPATH
+    if (dst != NULL) {
+        flow = fib_flow_hash(dst, dst_size, 0);
+    }
+#endif
+    return _get_next_hop(table, iface_id, next_hop, next_hop_size,
+                         next_hop_flags, dst, dst_size, dst_flags, flow);
+}
+
+#ifdef MODULE_FIB_MULTIPATH
+int fib_get_next_hop_flow(fib_table_t *table, kernel_pid_t *iface_id,
+                          uint8_t *next_hop, size_t *next_hop_size,
+                          uint32_t *next_hop_flags, uint8_t *dst,
+                          size_t dst_size, uint32_t dst_flags, uint32_t flow)
+{
+    return _get_next_hop(table, iface_id, next_hop, next_hop_size,
+                         next_hop_flags, dst, dst_size, dst_flags, flow);
+}
+#endif
+
 int fib_get_destination_set(fib_table_t *table, uint8_t *prefix,
                             size_t prefix_size,
                             fib_destination_set_entry_t *dst_set,
                             size_t* dst_set_size)
 {
+    _expiry_handle(table);
     mutex_lock(&(table->mtx_access));
     int ret = -EHOSTUNREACH;
     size_t found_entries = 0;
@@ -589,6 +1253,7 @@ void fib_init(fib_table_t *table)
     table->notify_rp_pos = 0;
 
     if (table->table_type == FIB_TABLE_TYPE_SR) {
+        table->sr_gen++;
         memset(table->data.source_routes->headers, 0,
                sizeof(fib_sr_t) * table->size);
         memset(table->data.source_routes->entry_pool, 0,
@@ -596,6 +1261,12 @@ void fib_init(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_TRIE
+        _trie_reset(table);
+#endif
+        xtimer_remove(&table->expiry_timer);
+        table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+        table->expired = 0;
     }
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
@@ -614,6 +1285,7 @@ void fib_deinit(fib_table_t *table)
     table->notify_rp_pos = 0;
 
     if (table->table_type == FIB_TABLE_TYPE_SR) {
+        table->sr_gen++;
         memset(table->data.source_routes->headers, 0,
                sizeof(fib_sr_t) * table->size);
         memset(table->data.source_routes->entry_pool, 0,
@@ -621,6 +1293,12 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_TRIE
+        _trie_reset(table);
+#endif
+        xtimer_remove(&table->expiry_timer);
+        table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+        table->expired = 0;
     }
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
@@ -654,6 +1332,7 @@ int fib_register_rp(fib_table_t *table, uint8_t *prefix, size_t prefix_addr_type
 
 int fib_get_num_used_entries(fib_table_t *table)
 {
+    _expiry_handle(table);
     mutex_lock(&(table->mtx_access));
     size_t used_entries = 0;
 
@@ -689,6 +1368,7 @@ int fib_sr_create(fib_table_t *table, fib_sr_t **fib_sr, kernel_pid_t sr_iface_i
                 table->data.source_routes->headers[i].sr_lifetime = FIB_LIFETIME_NO_EXPIRE;
             }
             *fib_sr = &table->data.source_routes->headers[i];
+            table->sr_gen++;
             mutex_unlock(&(table->mtx_access));
             return 0;
         }
@@ -838,6 +1518,7 @@ int fib_sr_set(fib_table_t *table, fib_sr_t *fib_sr, kernel_pid_t *sr_iface_id,
     if (sr_lifetime != NULL) {
         fib_lifetime_to_absolute(*sr_lifetime, &(fib_sr->sr_lifetime));
     }
+    table->sr_gen++;
 
     mutex_unlock(&(table->mtx_access));
     return 0;
@@ -862,6 +1543,7 @@ int fib_sr_delete(fib_table_t *table, fib_sr_t *fib_sr)
         }
         fib_sr->sr_path = NULL;
     }
+    table->sr_gen++;
 
     mutex_unlock(&(table->mtx_access));
     return 0;
@@ -976,6 +1658,7 @@ int fib_sr_entry_append(fib_table_t *table, fib_sr_t *fib_sr,
             fib_sr->sr_path = new_entry[0];
         }
         fib_sr->sr_dest = new_entry[0];
+        table->sr_gen++;
     }
 
     mutex_unlock(&(table->mtx_access));
@@ -1032,6 +1715,7 @@ int fib_sr_entry_add(fib_table_t *table, fib_sr_t *fib_sr,
                 new_entry[0]->next = NULL;
                 fib_sr->sr_dest = new_entry[0];
             }
+            table->sr_gen++;
         }
     }
 
@@ -1079,12 +1763,14 @@ int fib_sr_entry_delete(fib_table_t *table, fib_sr_t *fib_sr, uint8_t *addr, siz
                 /* if we remove the last entry we must adjust the destination */
                 fib_sr->sr_dest = tmp;
             }
+            table->sr_gen++;
             mutex_unlock(&(table->mtx_access));
             return 0;
         }
         tmp = elt;
     }
 
+    mutex_unlock(&(table->mtx_access));
     return -ENOENT;
 }
 
@@ -1133,6 +1819,7 @@ int fib_sr_entry_overwrite(fib_table_t *table, fib_sr_t *fib_sr,
             return -ENOMEM;
         }
         elt_repl->address = add;
+        table->sr_gen++;
     }
 
     mutex_unlock(&(table->mtx_access));
@@ -1613,6 +2300,7 @@ int fib_devel_get_lifetime(fib_table_t *table, uint64_t *lifetime, uint8_t *dst,
         size_t count = 1;
         fib_entry_t *entry[count];
 
+        _expiry_handle(table);
         int ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count);
         if (ret == 1 ) {
             /* only return lifetime of exact matches */
@@ -23,6 +23,17 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of hash buckets of the central address storage
+ *
+ * Must be a power of two. Lookups walk one bucket instead of all known
+ * addresses, so this should be in the order of the expected number of
+ * addresses of all neighbors and 2-hop neighbors.
+ */
+#ifndef NHDP_ADDR_DB_BUCKETS
+#define NHDP_ADDR_DB_BUCKETS        (16)
+#endif
+
 /**
  * @brief   NHDP address representation
  */
@@ -34,6 +45,7 @@ typedef struct nhdp_addr {
     uint8_t in_tmp_table;               /**< Signals usage in a writers temp table */
     uint16_t tmp_metric_val;            /**< Encoded metric value used during HELLO processing */
     struct nhdp_addr *next;             /**< Pointer to next address (used in central storage) */
+    struct nhdp_addr *tmp_next;         /**< Pointer to next address with a temp usage */
 } nhdp_addr_t;
 
 /**
@@ -107,6 +119,20 @@ void nhdp_free_addr_list(nhdp_addr_entry_t *list_head);
  */
 void nhdp_free_addr_entry(nhdp_addr_entry_t *addr_entry);
 
+/**
+ * @brief                   Set the temp usage of a NHDP address
+ *
+ * The address is tracked until the next call of nhdp_reset_addresses_tmp_usg(),
+ * which thereby only touches the addresses of the current message.
+ *
+ * @note
+ * Must not be called from outside the NHDP writer's or reader's message creation process.
+ *
+ * @param[in] addr          Pointer to the NHDP address
+ * @param[in] tmp_type      New temp usage flags of the address
+ */
+void nhdp_set_addr_tmp_usg(nhdp_addr_t *addr, uint8_t tmp_type);
+
 /**
  * @brief                   Construct an addr list containing all addresses with
  *                          the given tmp_type
@@ -127,12 +153,14 @@ nhdp_addr_entry_t *nhdp_generate_addr_list_from_tmp(uint8_t tmp_type);
 void nhdp_reset_addresses_tmp_usg(uint8_t decr_usg);
 
 /**
- * @brief                   Get a pointer to the head of the address storage list
+ * @brief                   Get a pointer to the head of the list of addresses with a temp usage
+ *
+ * The list is linked through nhdp_addr_t::tmp_next.
  *
- * @return                  Pointer to the head of the central storage address list
- * @return                  NULL if no addresses are registered
+ * @return                  Pointer to the head of the temp usage address list
+ * @return                  NULL if no address has a temp usage
  */
-nhdp_addr_t *nhdp_get_addr_db_head(void);
+nhdp_addr_t *nhdp_get_addr_tmp_head(void);
 
 #ifdef __cplusplus
 }
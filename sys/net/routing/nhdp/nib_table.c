@@ -125,7 +125,7 @@ void nib_fill_wr_addresses(struct rfc5444_writer *wr)
                                          RFC5444_OTHERNEIGHB_SYMMETRIC,
                                          rfc5444_metric_encode(nib_elt->metric_in),
                                          rfc5444_metric_encode(nib_elt->metric_out));
-                    addr_elt->address->in_tmp_table = NHDP_ADDR_TMP_SYM;
+                    nhdp_set_addr_tmp_usg(addr_elt->address, NHDP_ADDR_TMP_SYM);
                 }
             }
         }
@@ -248,7 +248,8 @@ static void clear_nb_addresses(nib_entry_t *nib_entry, timex_t *now)
         if (!NHDP_ADDR_TMP_IN_NB_LIST(nib_elt->address)) {
             /* Address is not in the newly received address list of the neighbor */
             /* Add it to the Removed Address List */
-            nib_elt->address->in_tmp_table |= NHDP_ADDR_TMP_REM_LIST;
+            nhdp_set_addr_tmp_usg(nib_elt->address,
+                                  nib_elt->address->in_tmp_table | NHDP_ADDR_TMP_REM_LIST);
             /* Increment usage counter of address in central NHDP address storage */
             nib_elt->address->usg_count++;
 
@@ -18,7 +18,6 @@
  * @}
  */
 
-#include <stdio.h>
 #include <stdint.h>
 
 #include "fmt.h"
@@ -27,32 +26,32 @@
 void phydat_dump(phydat_t *data, uint8_t dim)
 {
     if (data == NULL || dim > PHYDAT_DIM) {
-        puts("Unable to display data object");
+        print_str("Unable to display data object\n");
         return;
     }
-    printf("Data:");
+    print_str("Data:");
     for (uint8_t i = 0; i < dim; i++) {
         char scale_str = phydat_scale_to_str(data->scale);
 
-        printf("\t[%i] ", (int)i);
+        print_str("\t[");
+        print_u32_dec(i);
+        print_str("] ");
 
         if (scale_str) {
-            printf("%i%c", (int)data->val[i], scale_str);
+            print_s32_dec(data->val[i]);
+            print(&scale_str, 1);
         }
-        else if (data->scale == 0) {
-            printf("%i", (int)data->val[i]);
-        }
-        else if ((data->scale > -5) && (data->scale < 0)) {
-            char num[8];
-            size_t len = fmt_s16_dfp(num, data->val[i], data->scale * -1);
-            num[len] = '\0';
-            printf("%s", num);
+        else if ((data->scale > -5) && (data->scale <= 0)) {
+            print_s32_dfp(data->val[i], -data->scale);
         }
         else {
-            printf("%iE%i", (int)data->val[i], (int)data->scale);
+            print_s32_dec(data->val[i]);
+            print_str("E");
+            print_s32_dec(data->scale);
         }
 
-        printf("%s\n", phydat_unit_to_str(data->unit));
+        print_str(phydat_unit_to_str(data->unit));
+        print_str("\n");
     }
 }
 
@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_phydat_fix
+ * @{
+ *
+ * @file
+ * @brief       Fixed-point phydat math implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "phydat_fix.h"
+
+/* the finest scale phydat_fix_set() tries, a bit finer than Q16.16 */
+#define FINEST_SCALE        (-5)
+
+/* temperatures are converted at this reference scale */
+#define TEMP_SCALE          (0)
+
+/* marks units without a power of ten relative to the others of their group */
+#define NO_EXP              (INT8_MIN)
+
+static const int32_t _pow10[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+fix16_t phydat_fix_get(const phydat_t *data, uint8_t idx, int8_t scale)
+{
+    int shift = data->scale - scale;
+    fix16_t v = fix16_from_int(data->val[idx]);
+
+    if (shift < 0) {
+        /* the values of phydat are too small for Q16.16 below this */
+        if (-shift >= (int)(sizeof(_pow10) / sizeof(_pow10[0]))) {
+            return 0;
+        }
+        int32_t d = _pow10[-shift];
+        int32_t q = v / d;
+        int32_t r = v % d;
+
+        /* round to nearest, 2 * r stays below 2^31 as d <= 10^9 */
+        if (2 * r >= d) {
+            q++;
+        }
+        else if (-2 * r >= d) {
+            q--;
+        }
+        return q;
+    }
+    for (; (shift > 0) && (v != 0); shift--) {
+        if (v > (fix16_maximum / 10)) {
+            return fix16_maximum;
+        }
+        if (v < (fix16_minimum / 10)) {
+            return fix16_minimum;
+        }
+        v *= 10;
+    }
+    return v;
+}
+
+/* rounds v * 10^-s to an integer, returns false if it does not fit 16 bit */
+static bool _to_int16(fix16_t v, int s, int16_t *res)
+{
+    int64_t p = v;
+    int64_t i;
+
+    if (s <= 0) {
+        p *= _pow10[-s];
+        i = (p >= 0) ? ((p + 0x8000) >> 16) : -((-p + 0x8000) >> 16);
+    }
+    else {
+        int64_t d = (int64_t)_pow10[s] << 16;
+
+        i = (p >= 0) ? ((p + (d / 2)) / d) : -((-p + (d / 2)) / d);
+    }
+    if ((i > INT16_MAX) || (i < INT16_MIN)) {
+        return false;
+    }
+    *res = (int16_t)i;
+    return true;
+}
+
+void phydat_fix_set(phydat_t *data, const fix16_t *values, uint8_t dim,
+                    int8_t scale)
+{
+    int s = FINEST_SCALE;
+    bool zero = true;
+
+    for (unsigned i = 0; i < dim; i++) {
+        zero = zero && (values[i] == 0);
+    }
+    if (zero) {
+        memset(data->val, 0, sizeof(data->val));
+        data->scale = scale;
+        return;
+    }
+    /* with a scale of 1 all of Q16.16 fits, so this ends there latest */
+    for (;; s++) {
+        unsigned i = 0;
+
+        while ((i < dim) && _to_int16(values[i], s, &data->val[i])) {
+            i++;
+        }
+        if (i == dim) {
+            break;
+        }
+    }
+    for (unsigned i = dim; i < PHYDAT_DIM; i++) {
+        data->val[i] = 0;
+    }
+    data->scale = scale + s;
+}
+
+void phydat_fix_scale(phydat_t *data, uint8_t dim, fix16_t factor,
+                      fix16_t offset)
+{
+    fix16_t values[PHYDAT_DIM];
+
+    for (unsigned i = 0; i < dim; i++) {
+        fix16_t v = phydat_fix_get(data, i, data->scale);
+
+        values[i] = fix16_sadd(fix16_smul(v, factor), offset);
+    }
+    phydat_fix_set(data, values, dim, data->scale);
+}
+
+static bool _is_temp(uint8_t unit)
+{
+    return (unit == UNIT_TEMP_C) || (unit == UNIT_TEMP_F) ||
+           (unit == UNIT_TEMP_K);
+}
+
+static fix16_t _to_celsius(uint8_t unit, fix16_t v)
+{
+    switch (unit) {
+        case UNIT_TEMP_F:
+            return fix16_smul(fix16_ssub(v, F16(32)), F16(5.0 / 9.0));
+        case UNIT_TEMP_K:
+            return fix16_ssub(v, F16(273.15));
+        default:
+            return v;
+    }
+}
+
+static fix16_t _from_celsius(uint8_t unit, fix16_t v)
+{
+    switch (unit) {
+        case UNIT_TEMP_F:
+            return fix16_sadd(fix16_smul(v, F16(9.0 / 5.0)), F16(32));
+        case UNIT_TEMP_K:
+            return fix16_sadd(v, F16(273.15));
+        default:
+            return v;
+    }
+}
+
+/* power of ten of a unit relative to the other units of its group */
+static int _exp(uint8_t unit, uint8_t *group)
+{
+    switch (unit) {
+        case UNIT_BAR:
+            *group = UNIT_PA;
+            return 5;
+        case UNIT_PA:
+            *group = UNIT_PA;
+            return 0;
+        case UNIT_PERCENT:
+            *group = UNIT_PPM;
+            return -2;
+        case UNIT_PERMILL:
+            *group = UNIT_PPM;
+            return -3;
+        case UNIT_PPM:
+            *group = UNIT_PPM;
+            return -6;
+        default:
+            *group = UNIT_UNDEF;
+            return NO_EXP;
+    }
+}
+
+int phydat_fix_convert(phydat_t *data, uint8_t dim, uint8_t unit)
+{
+    uint8_t group_from, group_to;
+    int exp_from, exp_to;
+
+    if (unit == data->unit) {
+        return 0;
+    }
+    if (_is_temp(unit) && _is_temp(data->unit)) {
+        fix16_t values[PHYDAT_DIM];
+
+        for (unsigned i = 0; i < dim; i++) {
+            fix16_t v = phydat_fix_get(data, i, TEMP_SCALE);
+
+            values[i] = _from_celsius(unit, _to_celsius(data->unit, v));
+        }
+        phydat_fix_set(data, values, dim, TEMP_SCALE);
+        data->unit = unit;
+        return 0;
+    }
+    exp_from = _exp(data->unit, &group_from);
+    exp_to = _exp(unit, &group_to);
+    if ((exp_from == NO_EXP) || (exp_to == NO_EXP) || (group_from != group_to)) {
+        return -ENOTSUP;
+    }
+    int scale = data->scale + exp_from - exp_to;
+
+    if ((scale > INT8_MAX) || (scale < INT8_MIN)) {
+        return -ERANGE;
+    }
+    data->scale = scale;
+    data->unit = unit;
+    return 0;
+}
+
+void phydat_fix_stats_init(phydat_fix_stats_t *stats, uint8_t unit,
+                           uint8_t dim, int8_t scale)
+{
+    memset(stats, 0, sizeof(*stats));
+    for (unsigned i = 0; i < PHYDAT_DIM; i++) {
+        stats->min[i] = fix16_maximum;
+        stats->max[i] = fix16_minimum;
+    }
+    stats->unit = unit;
+    stats->dim = dim;
+    stats->scale = scale;
+}
+
+int phydat_fix_stats_add(phydat_fix_stats_t *stats, const phydat_t *data)
+{
+    if (data->unit != stats->unit) {
+        return -EINVAL;
+    }
+    for (unsigned i = 0; i < stats->dim; i++) {
+        fix16_t v = phydat_fix_get(data, i, stats->scale);
+
+        stats->sum[i] += v;
+        if (v < stats->min[i]) {
+            stats->min[i] = v;
+        }
+        if (v > stats->max[i]) {
+            stats->max[i] = v;
+        }
+    }
+    stats->count++;
+    return 0;
+}
+
+static void _stats_get(const phydat_fix_stats_t *stats, const fix16_t *values,
+                       phydat_t *data)
+{
+    static const fix16_t zero[PHYDAT_DIM] = { 0 };
+
+    phydat_fix_set(data, (stats->count != 0) ? values : zero, stats->dim,
+                   stats->scale);
+    data->unit = stats->unit;
+}
+
+void phydat_fix_stats_avg(const phydat_fix_stats_t *stats, phydat_t *data)
+{
+    fix16_t values[PHYDAT_DIM] = { 0 };
+
+    for (unsigned i = 0; (stats->count != 0) && (i < stats->dim); i++) {
+        values[i] = (fix16_t)(stats->sum[i] / (int64_t)stats->count);
+    }
+    _stats_get(stats, values, data);
+}
+
+void phydat_fix_stats_min(const phydat_fix_stats_t *stats, phydat_t *data)
+{
+    _stats_get(stats, stats->min, data);
+}
+
+void phydat_fix_stats_max(const phydat_fix_stats_t *stats, phydat_t *data)
+{
+    _stats_get(stats, stats->max, data);
+}
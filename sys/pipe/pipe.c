@@ -36,7 +36,8 @@ static ssize_t pipe_rw(ringbuffer_t *rb,
                        size_t n,
                        thread_t **other_op_blocked,
                        thread_t **this_op_blocked,
-                       ringbuffer_op_t ringbuffer_op)
+                       ringbuffer_op_t ringbuffer_op,
+                       unsigned wake_avail)
 {
     if (n == 0) {
         return 0;
@@ -50,7 +51,8 @@ static ssize_t pipe_rw(ringbuffer_t *rb,
         if (count > 0) {
             thread_t *other_thread = *other_op_blocked;
             int other_prio = -1;
-            if (other_thread) {
+            if (other_thread &&
+                ((rb->avail >= wake_avail) || ringbuffer_full(rb))) {
                 *other_op_blocked = NULL;
                 other_prio = other_thread->priority;
                 sched_set_status(other_thread, STATUS_PENDING);
@@ -81,13 +83,14 @@ static ssize_t pipe_rw(ringbuffer_t *rb,
 ssize_t pipe_read(pipe_t *pipe, void *buf, size_t n)
 {
     return pipe_rw(pipe->rb, (char *) buf, n,
-                   &pipe->write_blocked, &pipe->read_blocked, ringbuffer_get);
+                   &pipe->write_blocked, &pipe->read_blocked, ringbuffer_get, 0);
 }
 
 ssize_t pipe_write(pipe_t *pipe, const void *buf, size_t n)
 {
     return pipe_rw(pipe->rb, (char *) buf, n,
-                   &pipe->read_blocked, &pipe->write_blocked, (ringbuffer_op_t) ringbuffer_add);
+                   &pipe->read_blocked, &pipe->write_blocked, (ringbuffer_op_t) ringbuffer_add,
+                   pipe->watermark);
 }
 
 void pipe_init(pipe_t *pipe, ringbuffer_t *rb, void (*free)(void *))
@@ -97,5 +100,22 @@ void pipe_init(pipe_t *pipe, ringbuffer_t *rb, void (*free)(void *))
         .read_blocked = NULL,
         .write_blocked = NULL,
         .free = free,
+        .watermark = 1,
     };
 }
+
+void pipe_flush(pipe_t *pipe)
+{
+    unsigned old_state = irq_disable();
+    thread_t *reader = pipe->read_blocked;
+
+    if (reader) {
+        pipe->read_blocked = NULL;
+        sched_set_status(reader, STATUS_PENDING);
+    }
+    irq_restore(old_state);
+
+    if (reader) {
+        sched_switch(reader->priority);
+    }
+}
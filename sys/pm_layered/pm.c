@@ -22,6 +22,14 @@
 #include "periph/pm.h"
 #include "pm_layered.h"
 
+#ifdef MODULE_PM_LAYERED_TICKLESS
+#include "xtimer.h"
+#endif
+
+#ifdef MODULE_PM_LAYERED_RESIDENCY
+#include "periph/rtt.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -46,6 +54,107 @@ typedef union {
  */
 volatile pm_blocker_t pm_blocker = PM_BLOCKER_INITIAL;
 
+#ifdef MODULE_PM_LAYERED_TICKLESS
+#ifndef PM_MODE_MIN_SLEEP_US
+#define PM_MODE_MIN_SLEEP_US { 0 }
+#endif
+
+static const uint32_t _min_sleep[PM_NUM_MODES] = PM_MODE_MIN_SLEEP_US;
+static pm_tickless_stats_t _stats;
+
+/* must be called with interrupts disabled */
+static unsigned _tickless_mode(unsigned mode)
+{
+    uint32_t ticks;
+    unsigned deepest = mode;
+
+    _stats.sleeps++;
+    if (mode == PM_NUM_MODES) {
+        /* every mode is blocked, there is nothing to select */
+        _stats.blocked++;
+        return mode;
+    }
+    if (!xtimer_next_event(&ticks)) {
+        /* the period tick stays armed, see pm_layered.h */
+        _stats.tick_candidates++;
+    }
+    uint32_t usec = xtimer_usec_from_ticks(xtimer_ticks(ticks));
+
+    while ((mode < PM_NUM_MODES) && (usec < _min_sleep[mode])) {
+        mode++;
+    }
+
+    if (mode == deepest) {
+        _stats.deep++;
+    }
+    else {
+        _stats.shallow++;
+    }
+
+    return mode;
+}
+
+const pm_tickless_stats_t *pm_tickless_get_stats(void)
+{
+    return &_stats;
+}
+#endif
+
+#ifdef MODULE_PM_LAYERED_RESIDENCY
+static pm_residency_t _residency[PM_NUM_MODES + 1];
+static pm_wakelock_t *_wakelocks;
+
+static inline uint32_t _rtt_since(uint32_t start)
+{
+    return (rtt_get_counter() - start) & RTT_MAX_VALUE;
+}
+
+void pm_residency_init(void)
+{
+#ifndef MODULE_XTIMER_LP
+    rtt_init();
+#endif
+}
+
+const pm_residency_t *pm_residency_get(unsigned mode)
+{
+    assert(mode <= PM_NUM_MODES);
+    return &_residency[mode];
+}
+
+void pm_wakelock_acquire(pm_wakelock_t *lock)
+{
+    assert(!lock->held && (pm_blocker.val_u8[lock->mode] != 255));
+
+    unsigned state = irq_disable();
+    if (lock->count == 0) {
+        lock->next = _wakelocks;
+        _wakelocks = lock;
+    }
+    lock->held = 1;
+    lock->count++;
+    lock->since = rtt_get_counter();
+    pm_blocker.val_u8[lock->mode]++;
+    irq_restore(state);
+}
+
+void pm_wakelock_release(pm_wakelock_t *lock)
+{
+    assert(lock->held);
+
+    unsigned state = irq_disable();
+    lock->ticks += _rtt_since(lock->since);
+    lock->held = 0;
+    pm_blocker.val_u8[lock->mode]--;
+    irq_restore(state);
+}
+
+pm_wakelock_t *pm_wakelock_next(pm_wakelock_t *prev)
+{
+    return (prev) ? prev->next : _wakelocks;
+}
+#endif
+
 void pm_set_lowest(void)
 {
     pm_blocker_t blocker = (pm_blocker_t) pm_blocker;
@@ -60,8 +169,19 @@ void pm_set_lowest(void)
     /* set lowest mode if blocker is still the same */
     unsigned state = irq_disable();
     if (blocker.val_u32 == pm_blocker.val_u32) {
+#ifdef MODULE_PM_LAYERED_TICKLESS
+        mode = _tickless_mode(mode);
+#endif
         DEBUG("pm: setting mode %u\n", mode);
+#ifdef MODULE_PM_LAYERED_RESIDENCY
+        uint32_t start = rtt_get_counter();
+        pm_set(mode);
+        /* pm_set() returns once an interrupt woke the MCU up */
+        _residency[mode].ticks += _rtt_since(start);
+        _residency[mode].entries++;
+#else
         pm_set(mode);
+#endif
     }
     else {
         DEBUG("pm: mode block changed\n");
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @file
+ * @brief   Providing implementation for fcntl for fds defined in fd.h.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+
+#include "fd.h"
+
+int fcntl(int fildes, int cmd, ...)
+{
+    fd_t *fd_obj = fd_get(fildes);
+    va_list ap;
+    int res = 0;
+
+    if (!fd_obj || !fd_obj->internal_active) {
+        errno = EBADF;
+        return -1;
+    }
+
+    va_start(ap, cmd);
+    switch (cmd) {
+        case F_GETFL:
+            res = fd_obj->flags;
+            break;
+        case F_SETFL:
+            /* O_NONBLOCK is the only status flag the fds know */
+            fd_obj->flags = va_arg(ap, int) & O_NONBLOCK;
+            break;
+        default:
+            errno = EINVAL;
+            res = -1;
+            break;
+    }
+    va_end(ap);
+
+    return res;
+}
+
+/**
+ * @}
+ */
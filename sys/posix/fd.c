@@ -65,6 +65,8 @@ int fd_new(int internal_fd, ssize_t (*internal_read)(int, void *, size_t),
         fd_s->read = internal_read;
         fd_s->write = internal_write;
         fd_s->close = internal_close;
+        fd_s->poll = NULL;
+        fd_s->flags = 0;
     }
     else {
         errno = ENFILE;
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    posix_poll POSIX poll
+ * @ingroup     posix
+ * @brief       Waiting for file descriptors to become ready
+ *
+ * Works on the file descriptors of @ref fd.h. Sockets of the
+ * @ref posix_sockets "POSIX socket API" report received data with POLLIN.
+ * Other file descriptors without a fd_t::poll function are always ready.
+ *
+ * @{
+ * @file
+ * @brief   Waiting for file descriptors to become ready
+ * @see     <a href="http://pubs.opengroup.org/onlinepubs/9699919799/basedefs/poll.h.html">
+ *              The Open Group Base Specifications Issue 7, <poll.h>
+ *          </a>
+ */
+
+#ifndef POSIX_POLL_H_
+#define POSIX_POLL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Poll events
+ * @{
+ */
+#define POLLIN      (0x0001)    /**< Data may be read without blocking */
+#define POLLOUT     (0x0004)    /**< Data may be written without blocking */
+#define POLLERR     (0x0008)    /**< An error has occurred (revents only) */
+#define POLLHUP     (0x0010)    /**< Device has been disconnected (revents only) */
+#define POLLNVAL    (0x0020)    /**< Invalid fd member (revents only) */
+/** @} */
+
+/**
+ * @brief   Type for the number of file descriptors
+ */
+typedef unsigned int nfds_t;
+
+/**
+ * @brief   File descriptor to poll
+ */
+struct pollfd {
+    int fd;             /**< The file descriptor, ignored if negative */
+    short events;       /**< The events of interest */
+    short revents;      /**< The events that occurred */
+};
+
+/**
+ * @brief   Waits for one of a set of file descriptors to become ready
+ *
+ * The calling thread sleeps until a file descriptor is ready. It uses
+ * thread flag `(1 << 12)` to be woken up.
+ *
+ * @see <a href="http://pubs.opengroup.org/onlinepubs/9699919799/functions/poll.html">
+ *          The Open Group Base Specification Issue 7, poll
+ *      </a>
+ *
+ * @param[in,out] fds   The file descriptors to wait for. The events that
+ *                      occurred are returned in pollfd::revents.
+ * @param[in] nfds      The number of elements in @p fds.
+ * @param[in] timeout   The time to wait in milliseconds. 0 to return at
+ *                      once, -1 to wait until a file descriptor is ready.
+ *
+ * @return  The number of file descriptors with events.
+ * @return  0 on timeout.
+ */
+int poll(struct pollfd fds[], nfds_t nfds, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POSIX_POLL_H_ */
+/** @} */
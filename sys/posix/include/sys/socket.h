@@ -94,6 +94,13 @@ extern "C" {
 #define SO_TYPE         (15)    /**< Socket type. */
 /** @} */
 
+/**
+ * @name    Message flags
+ * @{
+ */
+#define MSG_DONTWAIT    (0x0040)    /**< Do not block if no message is available. */
+/** @} */
+
 typedef unsigned short sa_family_t;   /**< address family type */
 
 /**
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Waiting for the fds of fd.h to become ready
+ */
+
+#include <stdbool.h>
+
+#include "fd.h"
+#include "irq.h"
+#include "list.h"
+#include "sched.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#include "poll.h"
+
+/* the thread flag that wakes a waiting thread to check its fds again */
+#define POLL_THREAD_FLAG    (0x1 << 12)
+
+typedef struct {
+    list_node_t node;           /* node in _waiters */
+    thread_t *thread;           /* the thread waiting in poll() */
+} _waiter_t;
+
+/* the threads waiting in poll() */
+static list_node_t _waiters;
+
+void fd_poll_notify(void)
+{
+    bool woken = false;
+    unsigned state = irq_disable();
+
+    for (list_node_t *node = _waiters.next; node != NULL; node = node->next) {
+        thread_t *thread = ((_waiter_t *)node)->thread;
+
+        thread->flags |= POLL_THREAD_FLAG;
+        woken |= thread_flags_wake(thread);
+    }
+    irq_restore(state);
+    /* switch once, after all waiting threads are runnable */
+    if (woken) {
+        thread_yield_higher();
+    }
+}
+
+static void _timeout(void *arg)
+{
+    thread_flags_set(arg, THREAD_FLAG_TIMEOUT);
+}
+
+static int _check(struct pollfd fds[], nfds_t nfds)
+{
+    int ready = 0;
+
+    for (nfds_t i = 0; i < nfds; i++) {
+        fd_t *fd_obj;
+
+        fds[i].revents = 0;
+        if (fds[i].fd < 0) {
+            continue;
+        }
+        fd_obj = fd_get(fds[i].fd);
+        if (!fd_obj || !fd_obj->internal_active) {
+            fds[i].revents = POLLNVAL;
+        }
+        else if (fd_obj->poll) {
+            /* errors and hang-ups are reported without being asked for */
+            fds[i].revents = fd_obj->poll(fd_obj->internal_fd,
+                                          fds[i].events | POLLERR | POLLHUP);
+        }
+        else {
+            fds[i].revents = fds[i].events & (POLLIN | POLLOUT);
+        }
+        if (fds[i].revents) {
+            ready++;
+        }
+    }
+    return ready;
+}
+
+int poll(struct pollfd fds[], nfds_t nfds, int timeout)
+{
+    _waiter_t waiter = { { NULL }, (thread_t *)sched_active_thread };
+    xtimer_t timer = { .callback = _timeout, .arg = waiter.thread };
+    unsigned state;
+    int ready;
+
+    /* register before checking, so a notification in between is not missed */
+    thread_flags_clear(POLL_THREAD_FLAG | THREAD_FLAG_TIMEOUT);
+    state = irq_disable();
+    list_add(&_waiters, &waiter.node);
+    irq_restore(state);
+    if (timeout > 0) {
+        xtimer_set(&timer, (uint32_t)timeout * MS_IN_USEC);
+    }
+
+    while (((ready = _check(fds, nfds)) == 0) && (timeout != 0)) {
+        if (thread_flags_wait_any(POLL_THREAD_FLAG | THREAD_FLAG_TIMEOUT) &
+            THREAD_FLAG_TIMEOUT) {
+            /* a last look, an fd may have become ready meanwhile */
+            ready = _check(fds, nfds);
+            break;
+        }
+    }
+
+    if (timeout > 0) {
+        xtimer_remove(&timer);
+    }
+    state = irq_disable();
+    list_remove(&_waiters, &waiter.node);
+    irq_restore(state);
+    thread_flags_clear(POLL_THREAD_FLAG | THREAD_FLAG_TIMEOUT);
+    return ready;
+}
+
+/**
+ * @}
+ */
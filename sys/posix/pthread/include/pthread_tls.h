@@ -22,6 +22,19 @@
 extern "C" {
 #endif
 
+#ifdef DOXYGEN
+/**
+ * @brief   Number of thread-specific keys kept in a fixed array per thread
+ * @details If this is defined (e.g. `CFLAGS += -DPTHREAD_TLS_SLOTS=4`), every
+ *          pthread holds an array of this many values, making
+ *          pthread_getspecific() and pthread_setspecific() O(1). At most
+ *          this many keys can exist at a time then, it acts as
+ *          PTHREAD_KEYS_MAX. Otherwise the values are kept in a list per
+ *          thread, allocated on first use of a key.
+ */
+#define PTHREAD_TLS_SLOTS
+#endif
+
 /**
  * @brief   Internal representation of a thread-specific key.
  * @internal
@@ -83,6 +96,14 @@ void __pthread_keys_exit(int self_id);
  */
 struct __pthread_tls_datum **__pthread_get_tls_head(int self_id) PURE;
 
+#ifdef PTHREAD_TLS_SLOTS
+/**
+ * @brief Returns the array of thread-specific values.
+ * @internal
+ */
+void **__pthread_get_tls_slots(int self_id) PURE;
+#endif
+
 #ifdef __cplusplus
 }
 #endif
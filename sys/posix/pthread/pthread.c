@@ -65,7 +65,11 @@ typedef struct {
 
     char *stack;
 
+#ifdef PTHREAD_TLS_SLOTS
+    void *tls_slots[PTHREAD_TLS_SLOTS];
+#else
     struct __pthread_tls_datum *tls_head;
+#endif
 
     __pthread_cleanup_datum_t *cleanup_top;
 } pthread_thread_t;
@@ -364,8 +368,16 @@ void __pthread_cleanup_pop(__pthread_cleanup_datum_t *datum, int execute)
     }
 }
 
+#ifdef PTHREAD_TLS_SLOTS
+void **__pthread_get_tls_slots(int self_id)
+{
+    pthread_thread_t *self = pthread_sched_threads[self_id-1];
+    return self ? self->tls_slots : NULL;
+}
+#else
 struct __pthread_tls_datum **__pthread_get_tls_head(int self_id)
 {
     pthread_thread_t *self = pthread_sched_threads[self_id-1];
     return self ? &self->tls_head : NULL;
 }
+#endif
@@ -19,8 +19,11 @@
  * @}
  */
 
+#include <errno.h>
+
 #include "pthread_cond.h"
 #include "thread.h"
+#include "thread_flags.h"
 #include "xtimer.h"
 #include "sched.h"
 #include "irq.h"
@@ -92,47 +95,95 @@ int pthread_cond_destroy(pthread_cond_t *cond)
     return 0;
 }
 
-int pthread_cond_wait(pthread_cond_t *cond, mutex_t *mutex)
+/*
+ * A waiter queues itself and waits for THREAD_FLAG_COND_SIGNALED, which the
+ * signaling thread sets after removing it from the queue. As the flag stays
+ * set, a signal arriving between unlocking the mutex and blocking is not
+ * lost.
+ */
+static int _wait(pthread_cond_t *cond, mutex_t *mutex, xtimer_t *timer,
+                 uint64_t reltime)
 {
+    thread_t *me = (thread_t *) sched_active_thread;
     priority_queue_node_t n;
-    n.priority = sched_active_thread->priority;
-    n.data = sched_active_pid;
+    n.priority = me->priority;
+    n.data = me->pid;
     n.next = NULL;
 
+    /* left over from an earlier wait that ended by timeout */
+    thread_flags_clear(THREAD_FLAG_COND_SIGNALED | THREAD_FLAG_TIMEOUT);
+
     /* the signaling thread may not hold the mutex, the queue is not thread safe */
     unsigned old_state = irq_disable();
     priority_queue_add(&(cond->queue), &n);
     irq_restore(old_state);
 
-    mutex_unlock_and_sleep(mutex);
+    if (timer) {
+        xtimer_set_timeout_flag64(timer, reltime, me);
+    }
+    mutex_unlock(mutex);
 
-    if (n.data != -1u) {
-        /* on signaling n.data is set to -1u */
-        /* if it isn't set, then the wakeup is either spurious or a timer wakeup */
+    thread_flags_t flags = thread_flags_wait_any(THREAD_FLAG_COND_SIGNALED |
+                                                 THREAD_FLAG_TIMEOUT);
+    if (timer) {
+        xtimer_remove(timer);
+    }
+
+    int res = 0;
+    if (!(flags & THREAD_FLAG_COND_SIGNALED)) {
         old_state = irq_disable();
-        priority_queue_remove(&(cond->queue), &n);
+        if (me->flags & THREAD_FLAG_COND_SIGNALED) {
+            /* signaled right after the timeout, don't swallow the signal */
+            me->flags &= ~THREAD_FLAG_COND_SIGNALED;
+        }
+        else {
+            priority_queue_remove(&(cond->queue), &n);
+            res = ETIMEDOUT;
+        }
         irq_restore(old_state);
     }
 
     mutex_lock(mutex);
+    return res;
+}
+
+int pthread_cond_wait(pthread_cond_t *cond, mutex_t *mutex)
+{
+    _wait(cond, mutex, NULL, 0);
     return 0;
 }
 
 int pthread_cond_timedwait(pthread_cond_t *cond, mutex_t *mutex, const struct timespec *abstime)
 {
-    timex_t now, then, reltime;
+    timex_t now, then;
 
     xtimer_now_timex(&now);
     then.seconds = abstime->tv_sec;
     then.microseconds = abstime->tv_nsec / 1000u;
-    reltime = timex_sub(then, now);
+    timex_normalize(&then);
+
+    if (timex_cmp(then, now) <= 0) {
+        return ETIMEDOUT;
+    }
 
     xtimer_t timer;
-    xtimer_set_wakeup64(&timer, timex_uint64(reltime) , sched_active_pid);
-    int result = pthread_cond_wait(cond, mutex);
-    xtimer_remove(&timer);
+    timer.target = timer.long_target = 0;
+    return _wait(cond, mutex, &timer, timex_uint64(timex_sub(then, now)));
+}
 
-    return result;
+/* sets the flag on the thread of a removed queue node, returns the priority
+ * if that woke up the thread */
+static int _signal(priority_queue_node_t *head)
+{
+    thread_t *other_thread = (thread_t *) sched_threads[head->data];
+
+    if (other_thread) {
+        other_thread->flags |= THREAD_FLAG_COND_SIGNALED;
+        if (thread_flags_wake(other_thread)) {
+            return other_thread->priority;
+        }
+    }
+    return -1;
 }
 
 int pthread_cond_signal(pthread_cond_t *cond)
@@ -142,12 +193,7 @@ int pthread_cond_signal(pthread_cond_t *cond)
     priority_queue_node_t *head = priority_queue_remove_head(&(cond->queue));
     int other_prio = -1;
     if (head != NULL) {
-        thread_t *other_thread = (thread_t *) sched_threads[head->data];
-        if (other_thread) {
-            other_prio = other_thread->priority;
-            sched_set_status(other_thread, STATUS_PENDING);
-        }
-        head->data = -1u;
+        other_prio = _signal(head);
     }
 
     irq_restore(old_state);
@@ -176,12 +222,10 @@ int pthread_cond_broadcast(pthread_cond_t *cond)
             break;
         }
 
-        thread_t *other_thread = (thread_t *) sched_threads[head->data];
-        if (other_thread) {
-            other_prio = max_prio(other_prio, other_thread->priority);
-            sched_set_status(other_thread, STATUS_PENDING);
+        int prio = _signal(head);
+        if (prio >= 0) {
+            other_prio = max_prio(other_prio, prio);
         }
-        head->data = -1u;
     }
 
     irq_restore(old_state);
@@ -28,6 +28,7 @@
  * @}
  */
 
+#include "irq.h"
 #include "pthread.h"
 #include "sched.h"
 #include "xtimer.h"
@@ -97,6 +98,42 @@ bool __pthread_rwlock_blocked_writingly(const pthread_rwlock_t *rwlock)
     return rwlock->readers != 0;
 }
 
+/*
+ * Fast paths: The slow paths only modify the lock while holding
+ * rwlock->mutex, so while the mutex is free and interrupts are disabled the
+ * state is consistent and can be changed in place. Readers enter this way as
+ * long as no thread is queued, so they never touch the mutex while no writer
+ * is around.
+ */
+static bool _fast_rdlock(pthread_rwlock_t *rwlock)
+{
+    bool res = false;
+    unsigned state = irq_disable();
+
+    if ((rwlock->mutex.queue.next == NULL) && (rwlock->readers >= 0) &&
+        (rwlock->queue.first == NULL)) {
+        ++rwlock->readers;
+        res = true;
+    }
+    irq_restore(state);
+    return res;
+}
+
+static bool _fast_rdunlock(pthread_rwlock_t *rwlock)
+{
+    bool res = false;
+    unsigned state = irq_disable();
+
+    /* the last reader needs the slow path to hand the lock to a waiter */
+    if ((rwlock->mutex.queue.next == NULL) && (rwlock->readers > 0) &&
+        ((rwlock->readers > 1) || (rwlock->queue.first == NULL))) {
+        --rwlock->readers;
+        res = true;
+    }
+    irq_restore(state);
+    return res;
+}
+
 static int pthread_rwlock_lock(pthread_rwlock_t *rwlock,
                                bool (*is_blocked)(const pthread_rwlock_t *rwlock),
                                bool is_writer,
@@ -200,6 +237,7 @@ static int pthread_rwlock_timedlock(pthread_rwlock_t *rwlock,
         timex_t reltime = timex_sub(then, now);
 
         xtimer_t timer;
+        timer.target = timer.long_target = 0;
         xtimer_set_wakeup64(&timer, timex_uint64(reltime) , sched_active_pid);
         int result = pthread_rwlock_lock(rwlock, is_blocked, is_writer, incr_when_held, true);
         if (result != ETIMEDOUT) {
@@ -212,6 +250,9 @@ static int pthread_rwlock_timedlock(pthread_rwlock_t *rwlock,
 
 int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 {
+    if ((rwlock != NULL) && _fast_rdlock(rwlock)) {
+        return 0;
+    }
     return pthread_rwlock_lock(rwlock, __pthread_rwlock_blocked_readingly, false, +1, false);
 }
 
@@ -222,6 +263,9 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 
 int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
 {
+    if ((rwlock != NULL) && _fast_rdlock(rwlock)) {
+        return 0;
+    }
     return pthread_rwlock_trylock(rwlock, __pthread_rwlock_blocked_readingly, +1);
 }
 
@@ -232,6 +276,9 @@ int pthread_rwlock_trywrlock(pthread_rwlock_t *rwlock)
 
 int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock, const struct timespec *abstime)
 {
+    if ((rwlock != NULL) && _fast_rdlock(rwlock)) {
+        return 0;
+    }
     return pthread_rwlock_timedlock(rwlock, __pthread_rwlock_blocked_readingly, false, +1, abstime);
 }
 
@@ -247,6 +294,11 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
         return EINVAL;
     }
 
+    if (_fast_rdunlock(rwlock)) {
+        DEBUG("Thread %" PRIkernel_pid ": pthread_rwlock_%s(): release %s lock\n", thread_pid, "unlock", "read");
+        return 0;
+    }
+
     mutex_lock(&rwlock->mutex);
     if (rwlock->readers == 0) {
         /* the lock is open */
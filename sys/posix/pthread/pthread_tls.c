@@ -23,14 +23,11 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
-typedef struct __pthread_tls_datum {
-    pthread_key_t key;
-    struct __pthread_tls_datum *next;
-    void *value;
-} tls_data_t;
-
 struct __pthread_tls_key {
     void (*destructor)(void *);
+#ifdef PTHREAD_TLS_SLOTS
+    bool used;
+#endif
 };
 
 /**
@@ -38,6 +35,106 @@ struct __pthread_tls_key {
  */
 static mutex_t tls_mutex;
 
+#ifdef PTHREAD_TLS_SLOTS
+/**
+ * @brief   The keys, a key's index is the index of its value in the threads'
+ *          slots.
+ */
+static struct __pthread_tls_key tls_keys[PTHREAD_TLS_SLOTS];
+
+int pthread_key_create(pthread_key_t *key, void (*destructor)(void *))
+{
+    mutex_lock(&tls_mutex);
+    for (unsigned i = 0; i < PTHREAD_TLS_SLOTS; ++i) {
+        if (!tls_keys[i].used) {
+            tls_keys[i].used = true;
+            tls_keys[i].destructor = destructor;
+            *key = &tls_keys[i];
+            mutex_unlock(&tls_mutex);
+            return 0;
+        }
+    }
+    mutex_unlock(&tls_mutex);
+
+    return EAGAIN;
+}
+
+int pthread_key_delete(pthread_key_t key)
+{
+    if (!key) {
+        return EINVAL;
+    }
+
+    mutex_lock(&tls_mutex);
+    for (unsigned i = 1; i <= MAXTHREADS; ++i) {
+        void **slots = __pthread_get_tls_slots(i);
+        if (slots) {
+            slots[key - tls_keys] = NULL;
+        }
+    }
+    key->used = false;
+    mutex_unlock(&tls_mutex);
+
+    return 0;
+}
+
+void *pthread_getspecific(pthread_key_t key)
+{
+    pthread_t self_id = pthread_self();
+
+    if (!key || (self_id == 0)) {
+        return NULL;
+    }
+
+    void **slots = __pthread_get_tls_slots(self_id);
+    return slots ? slots[key - tls_keys] : NULL;
+}
+
+int pthread_setspecific(pthread_key_t key, const void *value)
+{
+    pthread_t self_id = pthread_self();
+
+    if (!key) {
+        return EINVAL;
+    }
+    if (self_id == 0) {
+        DEBUG("ERROR called pthread_self() returned 0 in \"%s\"!\n", __func__);
+        return ENOMEM;
+    }
+
+    void **slots = __pthread_get_tls_slots(self_id);
+    if (!slots) {
+        return ENOMEM;
+    }
+    slots[key - tls_keys] = (void *) value;
+    return 0;
+}
+
+void __pthread_keys_exit(int self_id)
+{
+    void **slots = __pthread_get_tls_slots(self_id);
+
+    /* a single pass, values set by the destructors are not destructed again */
+    for (unsigned i = 0; i < PTHREAD_TLS_SLOTS; ++i) {
+        void *value = slots[i];
+        if (!value) {
+            continue;
+        }
+        slots[i] = NULL;
+
+        void (*destructor)(void *) = tls_keys[i].destructor;
+        if (destructor) {
+            destructor(value);
+        }
+    }
+}
+#else
+typedef struct __pthread_tls_datum {
+    pthread_key_t key;
+    struct __pthread_tls_datum *next;
+    void *value;
+} tls_data_t;
+
 /**
  * @brief        Find a thread-specific datum.
  * @param[in]    tls    Pointer to the list of the thread-specific datums.
@@ -196,3 +293,4 @@ void __pthread_keys_exit(int self_id)
     }
     mutex_unlock(&tls_mutex);
 }
+#endif
@@ -18,28 +18,33 @@
 
 #include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <stdbool.h>
 #include <string.h>
 
 #include "fd.h"
 #include "mutex.h"
-#include "net/conn.h"
 #include "net/ipv4/addr.h"
 #include "net/ipv6/addr.h"
+#include "net/sock.h"
 #include "random.h"
 
 #include "sys/socket.h"
 #include "netinet/in.h"
 
-#ifdef  MODULE_CONN_IP
-#   include "net/conn/ip.h"
-#endif  /* MODULE_CONN_IP */
+#ifdef  MODULE_GNRC_SOCK_IP
+#   include "net/sock/ip.h"
+#endif  /* MODULE_GNRC_SOCK_IP */
 #ifdef  MODULE_CONN_TCP
+#   include "net/conn.h"
 #   include "net/conn/tcp.h"
 #endif  /* MODULE_CONN_TCP */
-#ifdef  MODULE_CONN_UDP
-#   include "net/conn/udp.h"
-#endif  /* MODULE_CONN_UDP */
+#ifdef  MODULE_GNRC_SOCK_UDP
+#   include "net/sock/udp.h"
+#endif  /* MODULE_GNRC_SOCK_UDP */
+#ifdef  MODULE_POSIX_POLL
+#   include "poll.h"
+#endif  /* MODULE_POSIX_POLL */
 
 #define SOCKET_POOL_SIZE    (4)
 
@@ -50,15 +55,15 @@ typedef union {
     /* is not supposed to be used */
     /* cppcheck-suppress unusedStructMember */
     int undef;                  /**< for case that no connection module is present */
-#ifdef  MODULE_CONN_IP
-    conn_ip_t raw;              /**< raw IP connection */
-#endif  /* MODULE_CONN_IP */
+#ifdef  MODULE_GNRC_SOCK_IP
+    sock_ip_t raw;              /**< raw IP sock */
+#endif  /* MODULE_GNRC_SOCK_IP */
 #ifdef  MODULE_CONN_TCP
     conn_tcp_t tcp;             /**< TCP connection */
 #endif  /* MODULE_CONN_TCP */
-#ifdef  MODULE_CONN_UDP
-    conn_udp_t udp;             /**< UDP connection */
-#endif  /* MODULE_CONN_UDP */
+#ifdef  MODULE_GNRC_SOCK_UDP
+    sock_udp_t udp;             /**< UDP sock */
+#endif  /* MODULE_GNRC_SOCK_UDP */
 } socket_conn_t;
 
 typedef struct {
@@ -90,7 +95,7 @@ static socket_t *_get_free_socket(void)
 static socket_t *_get_socket(int fd)
 {
     for (int i = 0; i < SOCKET_POOL_SIZE; i++) {
-        if (_pool[i].fd == fd) {
+        if ((_pool[i].domain != AF_UNSPEC) && (_pool[i].fd == fd)) {
             return &_pool[i];
         }
     }
@@ -110,7 +115,7 @@ static inline int _choose_ipproto(int type, int protocol)
             }
             break;
 #endif
-#ifdef MODULE_CONN_UDP
+#ifdef MODULE_GNRC_SOCK_UDP
         case SOCK_DGRAM:
             if ((protocol == 0) || (protocol == IPPROTO_UDP)) {
                 return protocol;
@@ -120,7 +125,7 @@ static inline int _choose_ipproto(int type, int protocol)
             }
             break;
 #endif
-#ifdef MODULE_CONN_IP
+#ifdef MODULE_GNRC_SOCK_IP
         case SOCK_RAW:
             return protocol;
 #endif
@@ -191,51 +196,141 @@ static inline int _get_data_from_sockaddr(const struct sockaddr *address, size_t
     return 0;
 }
 
-static int _implicit_bind(socket_t *s, void *addr)
+static inline int _sockaddr_to_ep(const struct sockaddr *address, socklen_t address_len,
+                                  struct _sock_tl_ep *ep)
 {
-    ipv6_addr_t unspec;
-    ipv6_addr_t *best_match;
-    int res;
+    void *addr;
+    size_t addr_len;
+    network_uint16_t port;
+
+    if (_get_data_from_sockaddr(address, address_len, &addr, &addr_len, &port) < 0) {
+        return -1;
+    }
+    if (addr_len > sizeof(ep->addr)) {
+        errno = EAFNOSUPPORT;
+        return -1;
+    }
+    memset(ep, 0, sizeof(struct _sock_tl_ep));
+    ep->family = address->sa_family;
+    memcpy(&ep->addr, addr, addr_len);
+    ep->port = byteorder_ntohs(port);
+    return 0;
+}
 
+static inline socklen_t _ep_to_sockaddr(const struct _sock_tl_ep *ep,
+                                        struct sockaddr_storage *out)
+{
+    memset(out, 0, sizeof(struct sockaddr_storage));
+    out->ss_family = ep->family;
+    switch (ep->family) {
+        case AF_INET:
+            memcpy(_in_addr_ptr(out), &ep->addr, sizeof(ipv4_addr_t));
+            *_in_port_ptr(out) = htons(ep->port);
+            return sizeof(struct sockaddr_in);
+        case AF_INET6:
+            memcpy(_in6_addr_ptr(out), &ep->addr, sizeof(ipv6_addr_t));
+            *_in6_port_ptr(out) = htons(ep->port);
+            return sizeof(struct sockaddr_in6);
+        default:
+            return 0;
+    }
+}
+
+static inline uint16_t _random_port(void)
+{
     /* TODO: ensure that this port hasn't been used yet */
-    s->src_port = (uint16_t)random_uint32_range(1LU << 10U, 1LU << 16U);
+    return (uint16_t)random_uint32_range(1LU << 10U, 1LU << 16U);
+}
+
+#ifdef MODULE_POSIX_POLL
+#ifdef MODULE_GNRC_SOCK_IP
+static void _raw_cb(sock_ip_t *sock, void *arg)
+{
+    (void)sock;
+    (void)arg;
+    fd_poll_notify();
+}
+#endif
 
-    /* find the best matching source address */
-    if ((best_match = conn_find_best_source(addr)) == NULL) {
-        ipv6_addr_set_unspecified(&unspec);
-        best_match = &unspec;
+#ifdef MODULE_GNRC_SOCK_UDP
+static void _udp_cb(sock_udp_t *sock, void *arg)
+{
+    (void)sock;
+    (void)arg;
+    fd_poll_notify();
+}
+#endif
+#endif
+
+static void _set_bound(socket_t *s)
+{
+    s->bound = true;
+#ifdef MODULE_POSIX_POLL
+    /* wake up threads in poll() when something arrives for this socket */
+    switch (s->type) {
+#ifdef MODULE_GNRC_SOCK_IP
+        case SOCK_RAW:
+            gnrc_sock_ip_set_cb(&s->conn.raw, _raw_cb, NULL);
+            break;
+#endif
+#ifdef MODULE_GNRC_SOCK_UDP
+        case SOCK_DGRAM:
+            gnrc_sock_udp_set_cb(&s->conn.udp, _udp_cb, NULL);
+            break;
+#endif
+        default:
+            break;
     }
+#endif
+}
+
+static int _implicit_bind(socket_t *s, void *addr)
+{
+    int res;
+
+    s->src_port = _random_port();
     switch (s->type) {
 #ifdef MODULE_CONN_TCP
-        case SOCK_STREAM:
-            res = conn_tcp_create(&s->conn.udp, best_match, sizeof(unspec),
+        case SOCK_STREAM: {
+            ipv6_addr_t unspec;
+            ipv6_addr_t *best_match;
+
+            /* find the best matching source address */
+            if ((best_match = conn_find_best_source(addr)) == NULL) {
+                ipv6_addr_set_unspecified(&unspec);
+                best_match = &unspec;
+            }
+            res = conn_tcp_create(&s->conn.tcp, best_match, sizeof(unspec),
                                   s->domain, s->src_port);
             break;
+        }
 #endif
-#ifdef MODULE_CONN_UDP
-        case SOCK_DGRAM:
-            res = conn_udp_create(&s->conn.udp, best_match, sizeof(unspec),
-                                  s->domain, s->src_port);
+#ifdef MODULE_GNRC_SOCK_UDP
+        case SOCK_DGRAM: {
+            sock_udp_ep_t local = { .family = s->domain, .port = s->src_port };
+
+            res = sock_udp_create(&s->conn.udp, &local, NULL, 0);
             break;
+        }
 #endif
         default:
-            res = -1;
+            (void)addr;
+            res = -EOPNOTSUPP;
             break;
     }
     if (res < 0) {
         errno = -res;
+        return -1;
     }
-    else {
-        s->bound = true;
-    }
-    return res;
+    _set_bound(s);
+    return 0;
 }
 
 static int socket_close(int socket)
 {
     socket_t *s;
     int res = 0;
-    if ((unsigned)(socket - 1) > (SOCKET_POOL_SIZE - 1)) {
+    if ((unsigned)socket >= SOCKET_POOL_SIZE) {
         return -1;
     }
     mutex_lock(&_pool_mutex);
@@ -245,14 +340,14 @@ static int socket_close(int socket)
             case AF_INET:
             case AF_INET6:
                 switch (s->type) {
-#ifdef MODULE_CONN_UDP
+#ifdef MODULE_GNRC_SOCK_UDP
                     case SOCK_DGRAM:
-                        conn_udp_close(&s->conn.udp);
+                        sock_udp_close(&s->conn.udp);
                         break;
 #endif
-#ifdef MODULE_CONN_IP
+#ifdef MODULE_GNRC_SOCK_IP
                     case SOCK_RAW:
-                        conn_ip_close(&s->conn.raw);
+                        sock_ip_close(&s->conn.raw);
                         break;
 #endif
 #ifdef MODULE_CONN_TCP
@@ -273,10 +368,56 @@ static int socket_close(int socket)
     }
     s->domain = AF_UNSPEC;
     s->src_port = 0;
+    s->bound = false;
     mutex_unlock(&_pool_mutex);
     return res;
 }
 
+#ifdef MODULE_POSIX_POLL
+static short socket_poll(int socket, short events)
+{
+    socket_t *s;
+    /* sending never blocks on the datagram socks */
+    short revents = POLLOUT;
+
+    if ((unsigned)socket >= SOCKET_POOL_SIZE) {
+        return POLLNVAL;
+    }
+    s = &_pool[socket];
+    switch (s->type) {
+#ifdef MODULE_GNRC_SOCK_IP
+        case SOCK_RAW:
+            if (s->bound) {
+                gnrc_sock_queue_stats_t stats;
+
+                gnrc_sock_ip_get_queue_stats(&s->conn.raw, &stats);
+                if (stats.queued > 0) {
+                    revents |= POLLIN;
+                }
+            }
+            break;
+#endif
+#ifdef MODULE_GNRC_SOCK_UDP
+        case SOCK_DGRAM:
+            if (s->bound) {
+                gnrc_sock_queue_stats_t stats;
+
+                if ((gnrc_sock_udp_get_queue_stats(&s->conn.udp, &stats) == 0) &&
+                    (stats.queued > 0)) {
+                    revents |= POLLIN;
+                }
+            }
+            break;
+#endif
+        default:
+            /* conn_tcp has no way to check for readiness */
+            revents |= POLLIN;
+            break;
+    }
+    return revents & events;
+}
+#endif
+
 static ssize_t socket_read(int socket, void *buf, size_t n)
 {
     return recv(socket, buf, n, 0);
@@ -322,6 +463,9 @@ int socket(int domain, int type, int protocol)
             res = -1;
         }
         else {
+#ifdef MODULE_POSIX_POLL
+            fd_get(fd)->poll = socket_poll;
+#endif
             s->fd = res = fd;
         }
     }
@@ -434,6 +578,9 @@ int bind(int socket, const struct sockaddr *address, socklen_t address_len)
     void *addr;
     size_t addr_len;
     network_uint16_t port = { 0 };
+    /* May be kept unassigned if no sock module is available */
+    /* cppcheck-suppress unassignedVariable */
+    struct _sock_tl_ep local;
     mutex_lock(&_pool_mutex);
     s = _get_socket(socket);
     mutex_unlock(&_pool_mutex);
@@ -448,11 +595,14 @@ int bind(int socket, const struct sockaddr *address, socklen_t address_len)
     if (_get_data_from_sockaddr(address, address_len, &addr, &addr_len, &port) < 0) {
         return -1;
     }
+    if (_sockaddr_to_ep(address, address_len, &local) < 0) {
+        return -1;
+    }
     switch (s->type) {
-#ifdef MODULE_CONN_IP
+#ifdef MODULE_GNRC_SOCK_IP
         case SOCK_RAW:
-            (void)port;
-            if ((res = conn_ip_create(&s->conn.raw, addr, addr_len, s->domain, s->protocol)) < 0) {
+            if ((res = sock_ip_create(&s->conn.raw, (sock_ip_ep_t *)&local, NULL,
+                                      s->protocol, 0)) < 0) {
                 errno = -res;
                 return -1;
             }
@@ -467,14 +617,17 @@ int bind(int socket, const struct sockaddr *address, socklen_t address_len)
             }
             break;
 #endif
-#ifdef MODULE_CONN_UDP
+#ifdef MODULE_GNRC_SOCK_UDP
         case SOCK_DGRAM:
-            if ((res = conn_udp_create(&s->conn.udp, addr, addr_len, s->domain,
-                                       byteorder_ntohs(port))) < 0) {
-
+            if (local.port == 0) {
+                /* any port, as on implicit binding */
+                local.port = _random_port();
+            }
+            if ((res = sock_udp_create(&s->conn.udp, &local, NULL, 0)) < 0) {
                 errno = -res;
                 return -1;
             }
+            port = byteorder_htons(local.port);
             break;
 #endif
         default:
@@ -482,11 +635,12 @@ int bind(int socket, const struct sockaddr *address, socklen_t address_len)
             (void)addr_len;
             (void)port;
             (void)res;
+            (void)local;
             errno = EOPNOTSUPP;
             return -1;
     }
     s->src_port = byteorder_ntohs(port);
-    s->bound = true;
+    _set_bound(s);
     return 0;
 }
 
@@ -613,8 +767,8 @@ int getsockname(int socket, struct sockaddr *__restrict address,
     /* May be kept unassigned if no conn module is available */
     /* cppcheck-suppress unassignedVariable */
     struct sockaddr_storage tmp;
-    void *addr;
-    uint16_t *port;
+    /* cppcheck-suppress unassignedVariable */
+    struct _sock_tl_ep ep;
     socklen_t tmp_len;
     mutex_lock(&_pool_mutex);
     s = _get_socket(socket);
@@ -629,21 +783,16 @@ int getsockname(int socket, struct sockaddr *__restrict address,
     }
     switch (s->domain) {
         case AF_INET:
-            addr = _in_addr_ptr(&tmp);
-            port = _in_port_ptr(&tmp);
             tmp_len = sizeof(struct sockaddr_in);
             break;
         case AF_INET6:
-            addr = _in6_addr_ptr(&tmp);
-            port = _in6_port_ptr(&tmp);
             tmp_len = sizeof(struct sockaddr_in6);
             break;
         default:
             (void)address;
             (void)address_len;
             (void)tmp;
-            (void)addr;
-            (void)port;
+            (void)ep;
             (void)tmp_len;
             (void)res;
             errno = EBADF;
@@ -653,38 +802,42 @@ int getsockname(int socket, struct sockaddr *__restrict address,
         errno = EINVAL;
         return -1;
     }
+    memset(&ep, 0, sizeof(ep));
     switch (s->type) {
-#ifdef MODULE_CONN_UDP
+#ifdef MODULE_GNRC_SOCK_UDP
         case SOCK_DGRAM:
-            if ((res = conn_udp_getlocaladdr(&s->conn.udp, addr, port)) < 0) {
+            if ((res = sock_udp_get_local(&s->conn.udp, &ep)) < 0) {
                 errno = -res;
                 return -1;
             }
             break;
 #endif
-#ifdef MODULE_CONN_IP
+#ifdef MODULE_GNRC_SOCK_IP
         case SOCK_RAW:
-            if ((res = conn_ip_getlocaladdr(&s->conn.raw, addr)) < 0) {
+            if ((res = sock_ip_get_local(&s->conn.raw, (sock_ip_ep_t *)&ep)) < 0) {
                 errno = -res;
                 return -1;
             }
             break;
 #endif
 #ifdef MODULE_CONN_TCP
-        case SOCK_STREAM:
-            if ((res = conn_tcp_getlocaladdr(&s->conn.tcp, addr, port)) < 0) {
+        case SOCK_STREAM: {
+            uint16_t port;
+
+            if ((res = conn_tcp_getlocaladdr(&s->conn.tcp, &ep.addr, &port)) < 0) {
                 errno = -res;
                 return -1;
             }
+            ep.port = port;
             break;
+        }
 #endif
         default:
             errno = EOPNOTSUPP;
             return -1;
     }
-    tmp.ss_family = AF_INET;
-    *port = htons(*port); /* XXX: sin(6)_port is supposed to be network byte
-                             order */
+    ep.family = s->domain;
+    tmp_len = _ep_to_sockaddr(&ep, &tmp);
     *address_len = _addr_truncate(address, *address_len, &tmp, tmp_len);
     return 0;
 }
@@ -740,11 +893,9 @@ ssize_t recvfrom(int socket, void *restrict buffer, size_t length, int flags,
     /* May be kept unassigned if no conn module is available */
     /* cppcheck-suppress unassignedVariable */
     struct sockaddr_storage tmp;
-    void *addr;
-    size_t addr_len;
-    uint16_t *port;
-    socklen_t tmp_len;
-    (void)flags;
+    /* cppcheck-suppress unassignedVariable */
+    struct _sock_tl_ep ep;
+    uint32_t timeout = SOCK_NO_TIMEOUT;
     mutex_lock(&_pool_mutex);
     s = _get_socket(socket);
     mutex_unlock(&_pool_mutex);
@@ -756,19 +907,9 @@ ssize_t recvfrom(int socket, void *restrict buffer, size_t length, int flags,
         errno = EINVAL;
         return -1;
     }
-    memset(&tmp, 0, sizeof(struct sockaddr_storage));
     switch (s->domain) {
         case AF_INET:
-            addr = _in_addr_ptr(&tmp);
-            port = _in_port_ptr(&tmp);
-            addr_len = sizeof(ipv4_addr_t);
-            tmp_len = sizeof(struct sockaddr_in);
-            break;
         case AF_INET6:
-            addr = _in6_addr_ptr(&tmp);
-            port = _in6_port_ptr(&tmp);
-            addr_len = sizeof(ipv6_addr_t);
-            tmp_len = sizeof(struct sockaddr_in6);
             break;
         default:
             (void)buffer;
@@ -776,51 +917,58 @@ ssize_t recvfrom(int socket, void *restrict buffer, size_t length, int flags,
             (void)address;
             (void)address_len;
             (void)tmp;
-            (void)addr;
-            (void)port;
-            (void)tmp_len;
+            (void)ep;
+            (void)timeout;
             errno = EAFNOSUPPORT;
             return -1;
     }
+    if ((flags & MSG_DONTWAIT) || (fd_get(s->fd)->flags & O_NONBLOCK)) {
+        timeout = 0;
+    }
+    memset(&ep, 0, sizeof(ep));
     switch (s->type) {
-#ifdef MODULE_CONN_UDP
+#ifdef MODULE_GNRC_SOCK_UDP
         case SOCK_DGRAM:
-            if ((res = conn_udp_recvfrom(&s->conn.udp, buffer, length, addr,
-                                         &addr_len, port)) < 0) {
-                errno = -res;
-                return -1;
-            }
+            res = sock_udp_recv(&s->conn.udp, buffer, length, timeout, &ep);
             break;
 #endif
-#ifdef MODULE_CONN_IP
+#ifdef MODULE_GNRC_SOCK_IP
         case SOCK_RAW:
-            if ((res = conn_ip_recvfrom(&s->conn.raw, buffer, length, addr, &addr_len)) < 0) {
-                errno = -res;
-                return -1;
-            }
+            res = sock_ip_recv(&s->conn.raw, buffer, length, timeout,
+                               (sock_ip_ep_t *)&ep);
             break;
 #endif
 #ifdef MODULE_CONN_TCP
-        case SOCK_STREAM:
+        case SOCK_STREAM: {
+            uint16_t port;
+            int peer_res;
+
             if ((res = conn_tcp_recv(&s->conn.tcp, buffer, length)) < 0) {
-                errno = -res;
-                return -1;
+                break;
             }
-            if ((res = conn_tcp_getpeeraddr(&s->conn.tcp, addr, port)) < 0) {
-                errno = -res;
-                return -1;
+            if ((peer_res = conn_tcp_getpeeraddr(&s->conn.tcp, &ep.addr, &port)) < 0) {
+                res = peer_res;
+                break;
             }
+            ep.port = port;
             break;
+        }
 #endif
         default:
-            (void)addr_len;
+            (void)timeout;
             errno = EOPNOTSUPP;
             return -1;
     }
+    if (res < 0) {
+        /* a timeout of 0 returns -ETIMEDOUT when nothing is queued */
+        errno = ((res == -ETIMEDOUT) || (res == -EAGAIN)) ? EAGAIN : -res;
+        return -1;
+    }
     if ((address != NULL) && (address_len != NULL)) {
-        tmp.ss_family = s->domain;
-        *port = htons(*port); /* XXX: sin(6)_port is supposed to be network
-                                 byte order */
+        socklen_t tmp_len;
+
+        ep.family = s->domain;
+        tmp_len = _ep_to_sockaddr(&ep, &tmp);
         *address_len = _addr_truncate(address, *address_len, &tmp, tmp_len);
     }
     return res;
@@ -839,6 +987,9 @@ ssize_t sendto(int socket, const void *buffer, size_t length, int flags,
     void *addr = NULL;
     size_t addr_len = 0;
     network_uint16_t port;
+    /* May be kept unassigned if no sock module is available */
+    /* cppcheck-suppress unassignedVariable */
+    struct _sock_tl_ep remote;
     port.u16 = 0;
     (void)flags;
     mutex_lock(&_pool_mutex);
@@ -856,32 +1007,19 @@ ssize_t sendto(int socket, const void *buffer, size_t length, int flags,
         if (_get_data_from_sockaddr(address, address_len, &addr, &addr_len, &port) < 0) {
             return -1;
         }
+        if (_sockaddr_to_ep(address, address_len, &remote) < 0) {
+            return -1;
+        }
     }
     switch (s->type) {
-#ifdef MODULE_CONN_IP
+#ifdef MODULE_GNRC_SOCK_IP
         case SOCK_RAW:
-            if ((address != NULL) && (s->bound)) {
-                uint8_t src_addr[sizeof(ipv6_addr_t)];
-                size_t src_len;
-                int res = conn_ip_getlocaladdr(&s->conn.raw, src_addr);
-                if (res < 0) {
-                    errno = ENOTSOCK;   /* Something seems to be wrong with the socket */
-                    return -1;
-                }
-                src_len = (size_t)res;
-                /* cppcheck bug? res is read below in l824 */
-                /* cppcheck-suppress unreadVariable */
-                res = conn_ip_sendto(buffer, length, src_addr, src_len, addr, addr_len, s->domain,
-                                     s->protocol);
-            }
-            else if (address != NULL) {
-                res = conn_ip_sendto(buffer, length, NULL, 0, addr, addr_len, s->domain,
-                                     s->protocol);
-            }
-            else {
+            if (address == NULL) {
                 errno = ENOTCONN;
                 return -1;
             }
+            res = sock_ip_send((s->bound) ? &s->conn.raw : NULL, buffer, length,
+                               s->protocol, (sock_ip_ep_t *)&remote);
             if (res < 0) {
                 errno = -res;
                 return -1;
@@ -904,34 +1042,16 @@ ssize_t sendto(int socket, const void *buffer, size_t length, int flags,
             }
             break;
 #endif
-#ifdef MODULE_CONN_UDP
+#ifdef MODULE_GNRC_SOCK_UDP
         case SOCK_DGRAM:
-            if ((address != NULL) && (s->bound)) {
-                uint8_t src_addr[sizeof(ipv6_addr_t)];
-                size_t src_len;
-                uint16_t sport;
-                int res = conn_udp_getlocaladdr(&s->conn.udp, src_addr, &sport);
-                if (res < 0) {
-                    errno = ENOTSOCK;   /* Something seems to be wrong with the socket */
-                    return -1;
-                }
-                src_len = (size_t)res;
-                /* cppcheck bug? res is read below in l824 */
-                /* cppcheck-suppress unreadVariable */
-                res = conn_udp_sendto(buffer, length, src_addr, src_len, addr, addr_len, s->domain,
-                                      sport, byteorder_ntohs(port));
-            }
-            else if (address != NULL) {
-                if ((res = _implicit_bind(s, addr)) < 0) {
-                    return res;
-                }
-                res = conn_udp_sendto(buffer, length, NULL, 0, addr, addr_len, s->domain,
-                                      s->src_port, byteorder_ntohs(port));
-            }
-            else {
+            if (address == NULL) {
                 errno = ENOTCONN;
                 return -1;
             }
+            if (!s->bound && (_implicit_bind(s, addr) < 0)) {
+                return -1;
+            }
+            res = sock_udp_send(&s->conn.udp, buffer, length, &remote);
             if (res < 0) {
                 errno = -res;
                 return -1;
@@ -941,6 +1061,8 @@ ssize_t sendto(int socket, const void *buffer, size_t length, int flags,
         default:
             (void)buffer;
             (void)length;
+            (void)addr_len;
+            (void)remote;
             errno = EOPNOTSUPP;
             return -1;
     }
@@ -30,6 +30,14 @@
 #include "tlsf.h"
 #endif
 
+#ifdef MODULE_THREADPROF
+#include "threadprof.h"
+#endif
+
+#ifdef MODULE_SCHED_EDF
+#include "sched_edf.h"
+#endif
+
 /* list of states copied from tcb.h */
 const char *state_names[] = {
     [STATUS_RUNNING] = "running",
@@ -64,6 +72,12 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
            "| runtime | switches"
+#endif
+#ifdef MODULE_THREADPROF
+           " | cpu (win)"
+#endif
+#ifdef MODULE_SCHED_EDF
+           " | dl miss/jobs"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -90,15 +104,29 @@ void ps(void)
             int state = p->status;                                                 /* copy state */
             const char *sname = state_names[state];                                /* get state name */
             const char *queued = &queued_name[(int)(state >= STATUS_ON_RUNQUEUE)]; /* get queued flag */
+#ifdef MODULE_THREADPROF
+            threadprof_t prof;
+            threadprof_get(i, &prof);
+#endif
 #ifdef DEVELHELP
             int stacksz = p->stack_size;                                           /* get stack size */
             overall_stacksz += stacksz;
+#ifdef MODULE_THREADPROF
+            /* use the incrementally maintained high-water mark */
+            stacksz = prof.stack_max;
+#else
             stacksz -= thread_measure_stack_free(p->stack_start);
+#endif
             overall_used += stacksz;
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
-            double runtime_ticks =  sched_pidlist[i].runtime_ticks / (double) xtimer_now() * 100;
+            double runtime_ticks =  sched_pidlist[i].runtime_ticks / (double) xtimer_now().ticks32 * 100;
             int switches = sched_pidlist[i].schedules;
+#endif
+#ifdef MODULE_SCHED_EDF
+            /* 0/0 for best-effort threads */
+            unsigned long misses = (p->edf != NULL) ? p->edf->misses : 0;
+            unsigned long jobs = (p->edf != NULL) ? p->edf->jobs : 0;
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef DEVELHELP
@@ -110,6 +138,12 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    " | %6.3f%% |  %8d"
+#endif
+#ifdef MODULE_THREADPROF
+                   " |  %3u.%u%%"
+#endif
+#ifdef MODULE_SCHED_EDF
+                   " | %5lu/%-6lu"
 #endif
                    "\n",
                    p->pid,
@@ -122,6 +156,13 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_ticks, switches
+#endif
+#ifdef MODULE_THREADPROF
+                   , (unsigned)(prof.cpu_permille / 10),
+                   (unsigned)(prof.cpu_permille % 10)
+#endif
+#ifdef MODULE_SCHED_EDF
+                   , misses, jobs
 #endif
                   );
         }
@@ -71,3 +71,14 @@ void random_init(uint32_t val)
     }
     _seed = val;
 }
+
+void random_init_by_array(uint32_t init_key[], int key_length)
+{
+    uint32_t seed = 0;
+
+    /* the state only holds 32 bit anyway */
+    for (int i = 0; i < key_length; i++) {
+        seed ^= init_key[i];
+    }
+    random_init(seed);
+}
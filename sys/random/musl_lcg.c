@@ -43,3 +43,14 @@ uint32_t random_uint32(void)
     _seed = 6364136223846793005ULL*_seed + 1;
     return _seed>>32;
 }
+
+void random_init_by_array(uint32_t init_key[], int key_length)
+{
+    uint32_t seed = 0;
+
+    /* the state only holds 32 bit anyway */
+    for (int i = 0; i < key_length; i++) {
+        seed ^= init_key[i];
+    }
+    random_init(seed);
+}
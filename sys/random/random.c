@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_random
+ * @{
+ * @file
+ *
+ * @brief Functions common to all PRNG implementations
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "random.h"
+
+#ifdef MODULE_RANDOM_SEED_HWRNG
+#include "periph/hwrng.h"
+#endif
+
+void random_bytes(uint8_t *buf, size_t size)
+{
+    while (size) {
+        uint32_t r = random_uint32();
+        size_t n = (size < sizeof(r)) ? size : sizeof(r);
+
+        memcpy(buf, &r, n);
+        buf += n;
+        size -= n;
+    }
+}
+
+#ifdef MODULE_RANDOM_SEED_HWRNG
+void random_seed_hwrng(void)
+{
+    uint32_t seed[4];
+
+    hwrng_init();
+    hwrng_read((uint8_t *)seed, sizeof(seed));
+    random_init_by_array(seed, sizeof(seed) / sizeof(seed[0]));
+    memset(seed, 0, sizeof(seed));
+}
+#endif
+
+void random_state_init(random_state_t *state, uint64_t seed)
+{
+    /* SplitMix64, as recommended by the xoroshiro authors, never yields an
+     * all zero state */
+    for (unsigned i = 0; i < 2; i++) {
+        uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        state->s[i] = z ^ (z >> 31);
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_random
+ * @{
+ * @file
+ *
+ * @brief xoroshiro128+ PRNG by David Blackman and Sebastiano Vigna
+ *
+ * See http://xoshiro.di.unimi.it for details. The 16 byte state is updated
+ * with interrupts disabled, which takes only a few instructions, so the
+ * generator can be shared between threads and interrupt handlers.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+
+#include "irq.h"
+#include "random.h"
+
+/* usable without random_init() */
+static random_state_t _state = {
+    { 0x9e3779b97f4a7c15ULL, 0xbf58476d1ce4e5b9ULL }
+};
+
+void random_init(uint32_t seed)
+{
+    random_state_t state;
+
+    random_state_init(&state, seed);
+
+    unsigned irq = irq_disable();
+    _state = state;
+    irq_restore(irq);
+}
+
+void random_init_by_array(uint32_t init_key[], int key_length)
+{
+    random_state_t state;
+
+    random_state_init(&state, (uint64_t)key_length);
+    for (int i = 0; i < key_length; i++) {
+        state.s[(i / 2) % 2] ^= (uint64_t)init_key[i] << (32 * (i % 2));
+        /* mix, so later keys cannot cancel earlier ones */
+        random_state_uint64(&state);
+    }
+    if (!(state.s[0] | state.s[1])) {
+        state.s[0] = 1;
+    }
+
+    unsigned irq = irq_disable();
+    _state = state;
+    irq_restore(irq);
+}
+
+uint32_t random_uint32(void)
+{
+    unsigned irq = irq_disable();
+    uint32_t res = random_state_uint32(&_state);
+    irq_restore(irq);
+
+    return res;
+}
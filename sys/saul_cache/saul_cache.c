@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_saul_cache
+ * @{
+ *
+ * @file
+ * @brief       SAUL sampling cache implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "saul_cache.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @brief   Stack size of the sampling thread
+ */
+#ifndef SAUL_CACHE_STACKSIZE
+#define SAUL_CACHE_STACKSIZE    (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the sampling thread
+ */
+#ifndef SAUL_CACHE_PRIO
+#define SAUL_CACHE_PRIO         (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+typedef struct {
+    saul_reg_t *dev;
+    phydat_t data;
+    uint32_t time;
+    int res;                    /* dimensions or error of the last read */
+} entry_t;
+
+static entry_t _cache[SAUL_CACHE_NUMOF];
+static saul_cache_sub_t *_subs;
+/* protects _cache and _subs */
+static mutex_t _lock = MUTEX_INIT;
+/* serializes passes over the devices */
+static mutex_t _pass_lock = MUTEX_INIT;
+static char _stack[SAUL_CACHE_STACKSIZE];
+
+static entry_t *_find(saul_reg_t *dev)
+{
+    for (unsigned i = 0; i < SAUL_CACHE_NUMOF; i++) {
+        if (_cache[i].dev == dev) {
+            return &_cache[i];
+        }
+    }
+    return NULL;
+}
+
+static void _notify(saul_reg_t *dev, const phydat_t *data, int dim)
+{
+    for (saul_cache_sub_t *sub = _subs; sub; sub = sub->next) {
+        if ((sub->dev == NULL) || (sub->dev == dev)) {
+            sub->cb(dev, data, dim, sub->arg);
+        }
+    }
+}
+
+void saul_cache_update(void)
+{
+    saul_reg_t *dev = saul_reg;
+
+    mutex_lock(&_pass_lock);
+    for (unsigned i = 0; i < SAUL_CACHE_NUMOF; i++) {
+        entry_t *entry = &_cache[i];
+        phydat_t data;
+        int res;
+
+        if (entry->dev != dev) {
+            /* the registry changed, start over for this slot */
+            mutex_lock(&_lock);
+            entry->dev = dev;
+            entry->res = -EAGAIN;
+            mutex_unlock(&_lock);
+        }
+        if (dev == NULL) {
+            continue;
+        }
+
+        /* the device is read without the lock, so consumers are served
+         * while the bus is busy */
+        memset(&data, 0, sizeof(data));
+        res = saul_reg_read(dev, &data);
+
+        mutex_lock(&_lock);
+        entry->time = xtimer_now_usec();
+        if ((res != entry->res) ||
+            ((res > 0) && (memcmp(&data, &entry->data, sizeof(data)) != 0))) {
+            entry->res = res;
+            entry->data = data;
+            if (res > 0) {
+                _notify(dev, &data, res);
+            }
+        }
+        mutex_unlock(&_lock);
+        DEBUG("saul_cache: read %s: %d\n", dev->name, res);
+
+        dev = dev->next;
+    }
+    mutex_unlock(&_pass_lock);
+}
+
+int saul_cache_read(saul_reg_t *dev, phydat_t *res, uint32_t *time)
+{
+    entry_t *entry;
+    int dim = -ENODEV;
+
+    mutex_lock(&_lock);
+    entry = (dev) ? _find(dev) : NULL;
+    if (entry) {
+        dim = entry->res;
+        *res = entry->data;
+        if (time) {
+            *time = entry->time;
+        }
+    }
+    mutex_unlock(&_lock);
+    return dim;
+}
+
+void saul_cache_subscribe(saul_cache_sub_t *sub)
+{
+    mutex_lock(&_lock);
+    sub->next = _subs;
+    _subs = sub;
+    mutex_unlock(&_lock);
+}
+
+void saul_cache_unsubscribe(saul_cache_sub_t *sub)
+{
+    mutex_lock(&_lock);
+    for (saul_cache_sub_t **tmp = &_subs; *tmp; tmp = &(*tmp)->next) {
+        if (*tmp == sub) {
+            *tmp = sub->next;
+            break;
+        }
+    }
+    mutex_unlock(&_lock);
+}
+
+static void *_sampler(void *arg)
+{
+    xtimer_ticks32_t last_wakeup = xtimer_now();
+
+    (void)arg;
+    while (1) {
+        saul_cache_update();
+        xtimer_periodic_wakeup(&last_wakeup, SAUL_CACHE_INTERVAL);
+    }
+    return NULL;
+}
+
+void saul_cache_init(void)
+{
+    thread_create(_stack, sizeof(_stack), SAUL_CACHE_PRIO,
+                  THREAD_CREATE_STACKTEST, _sampler, NULL, "saul_cache");
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sched_edf
+ * @{
+ *
+ * @file
+ * @brief       Earliest deadline first scheduling implementation
+ *
+ * The run queue of @ref SCHED_EDF_PRIO stays a plain clist. Instead of
+ * keeping it sorted on every insertion, the scheduler rotates the thread
+ * with the earliest deadline to its head right before picking from it, so
+ * the running thread is the head of its run queue as the rest of the
+ * scheduler expects. Deadline threads are few, the scan is short.
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "irq.h"
+#include "sched.h"
+#include "sched_edf.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static inline int _earlier(const thread_t *a, const thread_t *b)
+{
+    return (int32_t)(a->edf->deadline - b->edf->deadline) < 0;
+}
+
+void sched_edf_update(clist_node_t *rq)
+{
+    clist_node_t *tail = rq->next;
+    clist_node_t *prev = tail, *best_prev = NULL;
+    thread_t *best = NULL;
+    clist_node_t *node;
+
+    do {
+        node = prev->next;
+        thread_t *thread = container_of(node, thread_t, rq_entry);
+
+        if ((thread->edf != NULL) && ((best == NULL) || _earlier(thread, best))) {
+            best = thread;
+            best_prev = prev;
+        }
+        prev = node;
+    } while (node != tail);
+
+    if (best != NULL) {
+        /* best becomes the head, the order of the others is kept */
+        rq->next = best_prev;
+    }
+}
+
+int sched_edf_preempt(void)
+{
+    unsigned state = irq_disable();
+    clist_node_t *rq = &sched_runqueues[SCHED_EDF_PRIO];
+    int res;
+
+    sched_edf_update(rq);
+    res = (container_of(rq->next->next, thread_t, rq_entry) !=
+           (thread_t *)sched_active_thread);
+    irq_restore(state);
+    return res;
+}
+
+void sched_edf_enter(sched_edf_t *edf, uint32_t period, uint32_t deadline)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+
+    edf->release = xtimer_now();
+    edf->period = period;
+    edf->rel_deadline = xtimer_ticks_from_usec(deadline).ticks32;
+    edf->deadline = edf->release.ticks32 + edf->rel_deadline;
+    edf->jobs = 0;
+    edf->misses = 0;
+
+    unsigned state = irq_disable();
+    if (me->edf == NULL) {
+        edf->priority = me->priority;
+    }
+    me->edf = edf;
+    sched_change_priority(me, SCHED_EDF_PRIO);
+    irq_restore(state);
+    DEBUG("sched_edf: %" PRIkernel_pid " enters, period %" PRIu32 " us\n",
+          me->pid, period);
+    /* higher priority threads might be waiting now */
+    thread_yield_higher();
+}
+
+void sched_edf_wait_period(void)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+    sched_edf_t *edf = me->edf;
+
+    assert(edf != NULL);
+    edf->jobs++;
+    if ((int32_t)(xtimer_now().ticks32 - edf->deadline) > 0) {
+        DEBUG("sched_edf: %" PRIkernel_pid " missed its deadline\n", me->pid);
+        edf->misses++;
+    }
+    /* the scheduler has to know the deadline of the next job already when
+     * the timer releases it */
+    unsigned state = irq_disable();
+    edf->deadline = edf->release.ticks32 +
+                    xtimer_ticks_from_usec(edf->period).ticks32 +
+                    edf->rel_deadline;
+    irq_restore(state);
+    xtimer_periodic_wakeup(&edf->release, edf->period);
+}
+
+void sched_edf_leave(void)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+    unsigned state = irq_disable();
+
+    if (me->edf != NULL) {
+        sched_change_priority(me, me->edf->priority);
+        me->edf = NULL;
+    }
+    irq_restore(state);
+    thread_yield_higher();
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sched_round_robin
+ * @{
+ *
+ * @file
+ * @brief       Round-robin time slicing implementation
+ *
+ * @}
+ */
+
+#include "clist.h"
+#include "sched.h"
+#include "sched_round_robin.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static void _expired(void *arg);
+
+static xtimer_t _timer = { .callback = _expired };
+/* thread the current time slice belongs to, NULL if no slice is running */
+static thread_t *_owner;
+
+static void _expired(void *arg)
+{
+    (void)arg;
+    thread_t *active = (thread_t *)sched_active_thread;
+    thread_t *owner = _owner;
+
+    _owner = NULL;
+    /* the slice owner might have blocked meanwhile without the scheduler
+     * having picked another thread of the same level */
+    if ((active == owner) && (active->status == STATUS_RUNNING)) {
+        DEBUG("sched_round_robin: slice of %" PRIkernel_pid " expired\n",
+              active->pid);
+        clist_lpoprpush(&sched_runqueues[active->priority]);
+        sched_context_switch_request = 1;
+    }
+}
+
+void sched_round_robin_update(thread_t *thread)
+{
+    clist_node_t *rq = &sched_runqueues[thread->priority];
+
+    if (rq->next->next != rq->next) {
+        /* other threads are waiting on this level: start a fresh slice if
+         * it is not this thread's slice already running */
+        if (_owner != thread) {
+            _owner = thread;
+            xtimer_set(&_timer, SCHED_ROUND_ROBIN_TIMESLICE_US);
+        }
+    }
+    else if (_owner) {
+        _owner = NULL;
+        xtimer_remove(&_timer);
+    }
+}
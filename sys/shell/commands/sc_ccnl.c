@@ -119,6 +119,7 @@ int _ccnl_content(int argc, char **argv)
     struct ccnl_prefix_s *prefix = ccnl_URItoPrefix(argv[1], suite, NULL, NULL);
 
     arg_len = ccnl_ndntlv_prependContent(prefix, (unsigned char*) body, arg_len, NULL, NULL, &offs, _out);
+    free_prefix(prefix);
 
     unsigned char *olddata;
     unsigned char *data = olddata = _out + offs;
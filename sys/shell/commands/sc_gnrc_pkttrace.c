@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the packet latency tracing
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/pkttrace.h"
+
+int _gnrc_pkttrace(int argc, char **argv)
+{
+    if (argc < 2) {
+        gnrc_pkttrace_print();
+        return 0;
+    }
+    if (strcmp(argv[1], "reset") == 0) {
+        gnrc_pkttrace_reset();
+        return 0;
+    }
+    printf("usage: %s [reset]\n", argv[0]);
+    return 1;
+}
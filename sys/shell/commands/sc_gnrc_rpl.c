@@ -45,16 +45,22 @@ int _gnrc_rpl_init(char *arg)
     return 0;
 }
 
-int _gnrc_rpl_dodag_root(char *arg1, char *arg2)
+int _gnrc_rpl_dodag_root(char *arg1, char *arg2, char *arg3)
 {
     uint8_t instance_id = (uint8_t) atoi(arg1);
     ipv6_addr_t dodag_id;
+    gnrc_rpl_of_t *of = NULL;
 
     if (ipv6_addr_from_str(&dodag_id, arg2) == NULL) {
         puts("error: <dodag_id> must be a valid IPv6 address");
         return 1;
     }
 
+    if ((arg3 != NULL) && ((of = gnrc_rpl_get_of_for_ocp((uint16_t) atoi(arg3))) == NULL)) {
+        puts("error: <ocp> is not supported");
+        return 1;
+    }
+
     gnrc_rpl_instance_t *inst = NULL;
     inst = gnrc_rpl_root_init(instance_id, &dodag_id, false, false);
     if (inst == NULL) {
@@ -64,6 +70,10 @@ int _gnrc_rpl_dodag_root(char *arg1, char *arg2)
         return 1;
     }
 
+    if (of != NULL) {
+        inst->of = of;
+    }
+
     printf("successfully added a new RPL DODAG\n");
     return 0;
 }
@@ -274,12 +284,10 @@ int _gnrc_rpl_dodag_show(void)
                 gnrc_rpl_instances[i].mop, gnrc_rpl_instances[i].of->ocp,
                 gnrc_rpl_instances[i].min_hop_rank_inc, gnrc_rpl_instances[i].max_rank_inc);
 
-        tc = (((uint64_t) dodag->trickle.msg_callback_timer.long_target << 32)
-                | dodag->trickle.msg_callback_timer.target) - xnow;
+        tc = dodag->trickle.callback_at - xnow;
         tc = (int64_t) tc < 0 ? 0 : tc / SEC_IN_USEC;
 
-        ti = (((uint64_t) dodag->trickle.msg_interval_timer.long_target << 32)
-                | dodag->trickle.msg_interval_timer.target) - xnow;
+        ti = dodag->trickle.interval_at - xnow;
         ti = (int64_t) ti < 0 ? 0 : ti / SEC_IN_USEC;
 
         cleanup = dodag->instance->cleanup < 0 ? 0 : dodag->instance->cleanup;
@@ -361,7 +369,10 @@ int _gnrc_rpl(int argc, char **argv)
         return _gnrc_rpl_init(argv[2]);
     }
     else if ((argc == 4) && strcmp(argv[1], "root") == 0) {
-        return _gnrc_rpl_dodag_root(argv[2], argv[3]);
+        return _gnrc_rpl_dodag_root(argv[2], argv[3], NULL);
+    }
+    else if ((argc == 5) && strcmp(argv[1], "root") == 0) {
+        return _gnrc_rpl_dodag_root(argv[2], argv[3], argv[4]);
     }
     else if (strcmp(argv[1], "rm") == 0) {
         if (argc == 3) {
@@ -431,7 +442,7 @@ int _gnrc_rpl(int argc, char **argv)
     puts("* trickle start <instance_id>\t\t- start the trickle timer");
     puts("* trickle stop <instance_id>\t\t- stop the trickle timer");
     puts("* rm <instance_id>\t\t\t- delete the given instance and related dodag");
-    puts("* root <inst_id> <dodag_id>\t\t- add a dodag to a new or existing instance");
+    puts("* root <inst_id> <dodag_id> [<ocp>]\t- add a dodag to a new or existing instance");
     puts("* router <instance_id>\t\t\t- operate as router in the instance");
     puts("* send dis\t\t\t\t- send a multicast DIS");
 #ifndef GNRC_RPL_WITHOUT_PIO
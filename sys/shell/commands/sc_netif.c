@@ -114,12 +114,13 @@ static int _netif_stats(kernel_pid_t dev, unsigned module, bool reset)
     }
     else {
         printf("           Statistics for %s\n"
-               "            RX packets %u  bytes %u\n"
+               "            RX packets %u  bytes %u  duplicates %u\n"
                "            TX packets %u (Multicast: %u)  bytes %u\n"
                "            TX succeeded %u errors %u\n",
                _netstats_module_to_str(module),
                (unsigned) stats->rx_count,
                (unsigned) stats->rx_bytes,
+               (unsigned) stats->rx_dup_count,
                (unsigned) (stats->tx_unicast_count + stats->tx_mcast_count),
                (unsigned) stats->tx_mcast_count,
                (unsigned) stats->tx_bytes,
@@ -169,7 +170,7 @@ static void _hl_usage(char *cmd_name)
 
 static void _flag_usage(char *cmd_name)
 {
-    printf("usage: %s <if_id> [-]{promisc|autoack|ack_req|csma|autocca|cca_threshold|preload|iphc|rtr_adv}\n", cmd_name);
+    printf("usage: %s <if_id> [-]{promisc|autoack|ack_req|csma|autocca|cca_threshold|preload|iphc|rtr_adv|chanhop}\n", cmd_name);
 }
 
 static void _add_usage(char *cmd_name)
@@ -848,6 +849,9 @@ static int _netif_flag(char *cmd, kernel_pid_t dev, char *flag)
     else if (strcmp(flag, "autocca") == 0) {
         return _netif_set_flag(dev, NETOPT_AUTOCCA, set);
     }
+    else if (strcmp(flag, "chanhop") == 0) {
+        return _netif_set_flag(dev, NETOPT_CHANNEL_HOP, set);
+    }
     else if (strcmp(flag, "iphc") == 0) {
 #if defined(MODULE_GNRC_SIXLOWPAN_NETIF) && defined(MODULE_GNRC_SIXLOWPAN_IPHC)
         gnrc_sixlowpan_netif_t *entry = gnrc_sixlowpan_netif_get(dev);
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command printing the per-layer network statistics
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/netstats.h"
+#include "net/gnrc/icmpv6.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ndp.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/udp.h"
+
+static void _print(const char *name, uint32_t value)
+{
+    printf("    %-16s %10" PRIu32 "\n", name, value);
+}
+
+#ifdef MODULE_NETSTATS_PKTBUF
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+static const char *_quota_names[GNRC_PKTBUF_QUOTA_NUMOF] = {
+    "data", "control", "rx", "reassembly"
+};
+#endif
+
+static void _pktbuf(bool reset)
+{
+    netstats_pktbuf_t *stats = gnrc_pktbuf_get_stats();
+
+    if (reset) {
+        /* the bytes in use are not a counter */
+        stats->alloc_count = 0;
+        stats->alloc_failed = 0;
+        stats->max_used = stats->used;
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+        for (unsigned i = 0; i < GNRC_PKTBUF_QUOTA_NUMOF; i++) {
+            gnrc_pktbuf_quota_stats_t *quota = gnrc_pktbuf_get_quota_stats(i);
+
+            quota->alloc_failed = 0;
+            quota->max_used = quota->used;
+        }
+#endif
+        return;
+    }
+    puts("pktbuf");
+    _print("alloc", stats->alloc_count);
+    _print("alloc failed", stats->alloc_failed);
+    _print("bytes used", stats->used);
+    _print("bytes max used", stats->max_used);
+#ifdef MODULE_GNRC_PKTBUF_QUOTA
+    for (unsigned i = 0; i < GNRC_PKTBUF_QUOTA_NUMOF; i++) {
+        gnrc_pktbuf_quota_stats_t *quota = gnrc_pktbuf_get_quota_stats(i);
+
+        printf("  %s\n", _quota_names[i]);
+        _print("bytes used", quota->used);
+        _print("bytes max used", quota->max_used);
+        _print("alloc failed", quota->alloc_failed);
+    }
+#endif
+}
+#endif
+
+#ifdef MODULE_NETSTATS_SIXLOWPAN
+static void _sixlowpan(bool reset)
+{
+    netstats_sixlowpan_t *stats = gnrc_sixlowpan_get_stats();
+
+    if (reset) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    puts("6lowpan");
+    _print("rx", stats->rx_count);
+    _print("rx fragments", stats->rx_frag_count);
+    _print("rx dropped", stats->rx_dropped);
+    _print("rx no receiver", stats->rx_no_receiver);
+    _print("tx", stats->tx_count);
+    _print("tx fragmented", stats->tx_frag_count);
+    _print("tx dropped", stats->tx_dropped);
+    _print("no buffer", stats->nobuf);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+    const gnrc_sixlowpan_frag_rbuf_stats_t *rbuf = gnrc_sixlowpan_frag_rbuf_stats();
+
+    _print("rbuf complete", rbuf->complete);
+    _print("rbuf timeout", rbuf->timeout);
+    _print("rbuf evicted", rbuf->evicted);
+    _print("rbuf no buffer", rbuf->nobuf);
+    _print("rbuf invalid", rbuf->invalid);
+#endif
+}
+#endif
+
+#ifdef MODULE_NETSTATS_IPV6
+static void _ipv6(bool reset)
+{
+    netstats_ipv6_t *stats = gnrc_ipv6_get_stats();
+
+    if (reset) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    puts("ipv6");
+    _print("rx", stats->rx_count);
+    _print("rx invalid", stats->rx_invalid);
+    _print("rx not for me", stats->rx_not_for_me);
+    _print("rx no receiver", stats->rx_no_receiver);
+    _print("forwarded", stats->fwd_count);
+    _print("fwd dropped", stats->fwd_dropped);
+    _print("tx", stats->tx_count);
+    _print("tx dropped", stats->tx_dropped);
+    _print("no route", stats->no_route);
+    _print("no buffer", stats->nobuf);
+}
+#endif
+
+#ifdef MODULE_NETSTATS_ICMPV6
+static void _icmpv6(bool reset)
+{
+    netstats_icmpv6_t *stats = gnrc_icmpv6_get_stats();
+
+    if (reset) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    puts("icmpv6");
+    _print("rx", stats->rx_count);
+    _print("rx invalid", stats->rx_invalid);
+    _print("rx echo request", stats->rx_echo_req);
+    _print("rx nd", stats->rx_nd);
+    _print("rx unhandled", stats->rx_unhandled);
+}
+#endif
+
+#ifdef MODULE_NETSTATS_NDP
+static void _ndp(bool reset)
+{
+    netstats_ndp_t *stats = gnrc_ndp_get_stats();
+
+    if (reset) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    puts("ndp");
+    _print("rx rtr sol", stats->rx_rtr_sol);
+    _print("rx rtr adv", stats->rx_rtr_adv);
+    _print("rx nbr sol", stats->rx_nbr_sol);
+    _print("rx nbr adv", stats->rx_nbr_adv);
+    _print("tx rtr sol", stats->tx_rtr_sol);
+    _print("tx rtr adv", stats->tx_rtr_adv);
+    _print("tx nbr sol", stats->tx_nbr_sol);
+    _print("tx nbr adv", stats->tx_nbr_adv);
+    _print("rtr adv coalesced", stats->rtr_adv_coalesced);
+    _print("nbr sol deferred", stats->nbr_sol_deferred);
+}
+#endif
+
+#ifdef MODULE_NETSTATS_UDP
+static void _udp(bool reset)
+{
+    netstats_udp_t *stats = gnrc_udp_get_stats();
+
+    if (reset) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    puts("udp");
+    _print("rx", stats->rx_count);
+    _print("rx bad checksum", stats->rx_csum_err);
+    _print("rx no receiver", stats->rx_no_receiver);
+    _print("tx", stats->tx_count);
+    _print("tx dropped", stats->tx_dropped);
+    _print("no buffer", stats->nobuf);
+}
+#endif
+
+int _netstat_handler(int argc, char **argv)
+{
+    bool reset = false;
+
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+        reset = true;
+    }
+    else if (argc > 1) {
+        printf("usage: %s [reset]\n", argv[0]);
+        return 1;
+    }
+    /* the counters are written by the layer threads without locking, so a
+     * reset may miss an increment that happens at the same time */
+#ifdef MODULE_NETSTATS_PKTBUF
+    _pktbuf(reset);
+#endif
+#ifdef MODULE_NETSTATS_SIXLOWPAN
+    _sixlowpan(reset);
+#endif
+#ifdef MODULE_NETSTATS_IPV6
+    _ipv6(reset);
+#endif
+#ifdef MODULE_NETSTATS_ICMPV6
+    _icmpv6(reset);
+#endif
+#ifdef MODULE_NETSTATS_NDP
+    _ndp(reset);
+#endif
+#ifdef MODULE_NETSTATS_UDP
+    _udp(reset);
+#endif
+    return 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the pm_layered residency accounting
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "periph/rtt.h"
+#include "pm_layered.h"
+
+static uint32_t _ms(uint64_t ticks)
+{
+    return (uint32_t)((ticks * 1000U) / RTT_FREQUENCY);
+}
+
+int _pm_handler(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    puts("mode   entries        time [ms]");
+    for (unsigned mode = 0; mode <= PM_NUM_MODES; mode++) {
+        const pm_residency_t *res = pm_residency_get(mode);
+
+        if (mode == PM_NUM_MODES) {
+            printf("idle");
+        }
+        else {
+            printf("%4u", mode);
+        }
+        printf(" %9" PRIu32 " %16" PRIu32 "\n", res->entries, _ms(res->ticks));
+    }
+
+    puts("wakelock          mode held    count        time [ms]");
+    for (pm_wakelock_t *lock = pm_wakelock_next(NULL); lock;
+         lock = pm_wakelock_next(lock)) {
+        printf("%-16s %5u %4s %8" PRIu32 " %16" PRIu32 "\n", lock->name,
+               (unsigned)lock->mode, (lock->held) ? "yes" : "no", lock->count,
+               _ms(lock->ticks));
+    }
+    return 0;
+}
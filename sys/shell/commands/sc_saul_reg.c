@@ -23,6 +23,7 @@
 #include <string.h>
 #include <stdlib.h>
 
+#include "fmt.h"
 #include "saul_reg.h"
 
 /* this function does not check, if the given device is valid */
@@ -33,12 +34,19 @@ static void probe(int num, saul_reg_t *dev)
 
     dim = saul_reg_read(dev, &res);
     if (dim <= 0) {
-        printf("error: failed to read from device #%i\n", num);
+        print_str("error: failed to read from device #");
+        print_s32_dec(num);
+        print_str("\n");
         return;
     }
-    /* print results */
-    printf("Reading from #%i (%s|%s)\n", num, dev->name,
-           saul_class_to_str(dev->driver->type));
+    /* print results, phydat_dump() does not use stdio either */
+    print_str("Reading from #");
+    print_s32_dec(num);
+    print_str(" (");
+    print_str(dev->name);
+    print_str("|");
+    print_str(saul_class_to_str(dev->driver->type));
+    print_str(")\n");
     phydat_dump(&res, dim);
 }
 
@@ -49,7 +57,7 @@ static void probe_all(void)
 
     while (dev) {
         probe(i++, dev);
-        puts("");
+        print_str("\n");
         dev = dev->next;
     }
 }
@@ -119,7 +127,11 @@ static void write(int argc, char **argv)
         data.val[i] = (int16_t)atoi(argv[i + 3]);
     }
     /* print values before writing */
-    printf("Writing to device #%i - %s\n", num, dev->name);
+    print_str("Writing to device #");
+    print_s32_dec(num);
+    print_str(" - ");
+    print_str(dev->name);
+    print_str("\n");
     phydat_dump(&data, dim);
     /* write values to device */
     dim = saul_reg_write(dev, &data);
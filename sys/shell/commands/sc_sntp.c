@@ -16,6 +16,9 @@
  * @author      Luminița Lăzărescu <cluminita.lazarescu@gmail.com>
  */
 
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 #include "net/sntp.h"
 #include "net/ntp_packet.h"
@@ -48,5 +51,7 @@ int _ntpdate(int argc, char **argv)
         return 1;
     }
     printf("Offset: %i\n", (int)sntp_get_offset());
+    printf("Drift: %" PRIi32 " ppb, next sync in %" PRIu32 " s\n",
+           sntp_get_drift(), sntp_get_interval());
     return 0;
 }
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command for the threadprof module
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "threadprof.h"
+
+int _threadprof_handler(int argc, char **argv)
+{
+    if (argc < 2) {
+        threadprof_print();
+    }
+    else if (strcmp(argv[1], "stack") == 0) {
+        threadprof_print_stacks();
+    }
+    else {
+        printf("usage: %s [stack]\n", argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -16,6 +16,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include "net/ipv6/addr.h"
 #include "net/gnrc/ipv6/netif.h"
@@ -35,20 +36,37 @@ int _zep_init(int argc, char **argv)
 
     if (argc < 2) {
         printf("usage: %s dst_addr [src_port [dst_port]]\n", argv[0]);
+#ifdef MODULE_ZEP_HUB
+        printf("       %s hub <file> <node>\n", argv[0]);
+#endif
         return 1;
     }
 
-    if (argc > 2) {
-        src_port = (uint16_t)atoi(argv[2]);
+#ifdef MODULE_ZEP_HUB
+    if (strcmp(argv[1], "hub") == 0) {
+        if (argc < 4) {
+            printf("usage: %s hub <file> <node>\n", argv[0]);
+            return 1;
+        }
+        res = gnrc_zep_init_hub(&zep, argv[2], (unsigned)atoi(argv[3]));
     }
+    else
+#endif
+    {
+        if (argc > 2) {
+            src_port = (uint16_t)atoi(argv[2]);
+        }
 
-    if (argc > 3) {
-        dst_port = (uint16_t)atoi(argv[3]);
-    }
+        if (argc > 3) {
+            dst_port = (uint16_t)atoi(argv[3]);
+        }
 
-    ipv6_addr_from_str(&dst_addr, argv[1]);
+        ipv6_addr_from_str(&dst_addr, argv[1]);
 
-    if ((res = gnrc_zep_init(&zep, src_port, &dst_addr, dst_port)) < 0) {
+        res = gnrc_zep_init(&zep, src_port, &dst_addr, dst_port);
+    }
+
+    if (res < 0) {
         switch (res) {
             case -EADDRINUSE:
                 printf("error: Source port %" PRIu16 " already in use\n", src_port);
@@ -66,6 +84,17 @@ int _zep_init(int argc, char **argv)
                 puts("error: too many threads running");
                 break;
 
+#ifdef MODULE_ZEP_HUB
+            case -ENOENT:
+            case -EINVAL:
+                printf("error: %s is no hub file\n", argv[2]);
+                break;
+
+            case -ERANGE:
+                printf("error: node %s not in hub\n", argv[3]);
+                break;
+#endif
+
             default:
                 puts("unexpected error");
                 break;
@@ -29,14 +29,26 @@ extern int _reboot_handler(int argc, char **argv);
 extern int _id_handler(int argc, char **argv);
 #endif
 
-#ifdef MODULE_LPC_COMMON
+#if defined(MODULE_LPC_COMMON) || defined(MODULE_TLSF_MALLOC)
 extern int _heap_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_BOOTPROF
+extern int _bootprof_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_PS
 extern int _ps_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_THREADPROF
+extern int _threadprof_handler(int argc, char **argv);
+#endif
+
+#ifdef MODULE_PM_LAYERED_RESIDENCY
+extern int _pm_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_SHT11
 extern int _get_temperature_handler(int argc, char **argv);
 extern int _get_humidity_handler(int argc, char **argv);
@@ -89,6 +101,13 @@ extern int _netif_config(int argc, char **argv);
 extern int _netif_send(int argc, char **argv);
 #endif
 
+#if defined(MODULE_NETSTATS_ICMPV6) || defined(MODULE_NETSTATS_IPV6) || \
+    defined(MODULE_NETSTATS_PKTBUF) || defined(MODULE_NETSTATS_SIXLOWPAN) || \
+    defined(MODULE_NETSTATS_UDP) || defined(MODULE_NETSTATS_NDP)
+#define SC_NETSTAT
+extern int _netstat_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_FIB
 extern int _fib_route_handler(int argc, char **argv);
 #endif
@@ -116,6 +135,10 @@ extern int _zep_init(int argc, char **argv);
 extern int _gnrc_rpl(int argc, char **argv);
 #endif
 
+#ifdef MODULE_GNRC_PKTTRACE
+extern int _gnrc_pkttrace(int argc, char **argv);
+#endif
+
 #ifdef MODULE_GNRC_SIXLOWPAN_CTX
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_BORDER_ROUTER
 extern int _gnrc_6ctx(int argc, char **argv);
@@ -133,93 +156,124 @@ extern int _ccnl_fib(int argc, char **argv);
 extern int _ntpdate(int argc, char **argv);
 #endif
 
+/* sorted by name (in strcmp() order), so the shell can bisect it */
 const shell_command_t _shell_command_list[] = {
-    {"reboot", "Reboot the node", _reboot_handler},
-#ifdef MODULE_CONFIG
-    {"id", "Gets or sets the node's id.", _id_handler},
+#ifdef MODULE_GNRC_SIXLOWPAN_CTX
+#ifdef MODULE_GNRC_SIXLOWPAN_ND_BORDER_ROUTER
+    {"6ctx", "6LoWPAN context configuration tool", _gnrc_6ctx },
 #endif
-#ifdef MODULE_LPC_COMMON
-    {"heap", "Shows the heap state for the LPC2387 on the command shell.", _heap_handler},
 #endif
-#ifdef MODULE_PS
-    {"ps", "Prints information about running threads.", _ps_handler},
+#ifdef MODULE_AT30TSE75X
+    {"at30tse75x", "Test AT30TSE75X temperature sensor", _at30tse75x_handler},
 #endif
-#ifdef MODULE_SHT11
-    {"temp", "Prints measured temperature.", _get_temperature_handler},
-    {"hum", "Prints measured humidity.", _get_humidity_handler},
-    {"weather", "Prints measured humidity and temperature.", _get_weather_handler},
-    {"offset", "Set temperature offset.", _set_offset_handler},
+#ifdef MODULE_GNRC_IPV6_BLACKLIST
+    {"blacklist", "blacklists an address for receival ('blacklist [add|del|help]')", _blacklist },
+#endif
+#ifdef MODULE_CCN_LITE_UTILS
+    { "ccnl_cont", "create content and populated it", _ccnl_content },
+    { "ccnl_fib", "shows or modifies the CCN-Lite FIB", _ccnl_fib },
+    { "ccnl_int", "sends an interest", _ccnl_interest },
+    { "ccnl_open", "opens an interface or socket", _ccnl_open },
 #endif
 #ifdef MODULE_LTC4150
     {"cur", "Prints current and average power consumption.", _get_current_handler},
-    {"rstcur", "Resets coulomb counter.", _reset_current_handler},
-#endif
-#ifdef MODULE_AT30TSE75X
-    {"at30tse75x", "Test AT30TSE75X temperature sensor", _at30tse75x_handler},
 #endif
 #ifdef MODULE_MCI
-    {DISK_READ_SECTOR_CMD, "Reads the specified sector of inserted memory card", _read_sector},
-    {DISK_READ_BYTES_CMD, "Reads the specified bytes from inserted memory card", _read_bytes},
-    {DISK_GET_SECTOR_SIZE, "Get the sector size of inserted memory card", _get_sectorsize},
-    {DISK_GET_SECTOR_COUNT, "Get the sector count of inserted memory card", _get_sectorcount},
     {DISK_GET_BLOCK_SIZE, "Get the block size of inserted memory card", _get_blocksize},
+    {DISK_GET_SECTOR_COUNT, "Get the sector count of inserted memory card", _get_sectorcount},
+    {DISK_GET_SECTOR_SIZE, "Get the sector size of inserted memory card", _get_sectorsize},
+    {DISK_READ_BYTES_CMD, "Reads the specified bytes from inserted memory card", _read_bytes},
+    {DISK_READ_SECTOR_CMD, "Reads the specified sector of inserted memory card", _read_sector},
 #endif
-#ifdef MODULE_GNRC_ICMPV6_ECHO
-#ifdef MODULE_XTIMER
-    { "ping6", "Ping via ICMPv6", _icmpv6_ping },
-#endif
+#ifdef MODULE_FIB
+    {"fibroute", "Manipulate the FIB (info: 'fibroute [add|del]')", _fib_route_handler},
 #endif
-#ifdef MODULE_RANDOM
-    { "random_init", "initializes the PRNG", _random_init },
-    { "random_get", "returns 32 bit of pseudo randomness", _random_get },
+#if defined(MODULE_LPC_COMMON) || defined(MODULE_TLSF_MALLOC)
+    {"heap", "Shows the heap state.", _heap_handler},
 #endif
-#if FEATURE_PERIPH_RTC
-    {"rtc", "control RTC peripheral interface",  _rtc_handler},
+#ifdef MODULE_SHT11
+    {"hum", "Prints measured humidity.", _get_humidity_handler},
 #endif
-#ifdef CPU_X86
-    {"lspci", "Lists PCI devices", _x86_lspci},
+#ifdef MODULE_CONFIG
+    {"id", "Gets or sets the node's id.", _id_handler},
 #endif
 #ifdef MODULE_GNRC_NETIF
     {"ifconfig", "Configure network interfaces", _netif_config},
-    {"txtsnd", "Sends a custom string as is over the link layer", _netif_send },
 #endif
-#ifdef MODULE_FIB
-    {"fibroute", "Manipulate the FIB (info: 'fibroute [add|del]')", _fib_route_handler},
+#ifdef CPU_X86
+    {"lspci", "Lists PCI devices", _x86_lspci},
 #endif
 #ifdef MODULE_GNRC_IPV6_NC
     {"ncache", "manage neighbor cache by hand", _ipv6_nc_manage },
-    {"routers", "IPv6 default router list", _ipv6_nc_routers },
 #endif
-#ifdef MODULE_GNRC_IPV6_WHITELIST
-    {"whitelist", "whitelists an address for receival ('whitelist [add|del|help]')", _whitelist },
+#ifdef SC_NETSTAT
+    {"netstat", "Prints or resets the network statistics per layer", _netstat_handler},
 #endif
-#ifdef MODULE_GNRC_IPV6_BLACKLIST
-    {"blacklist", "blacklists an address for receival ('blacklist [add|del|help]')", _blacklist },
+#ifdef MODULE_SNTP
+    { "ntpdate", "synchronizes with a remote time server", _ntpdate },
 #endif
-#ifdef MODULE_GNRC_ZEP
-#ifdef MODULE_IPV6_ADDR
-    {"zep_init", "initializes ZEP (Zigbee Encapsulation Protocol)", _zep_init },
+#ifdef MODULE_SHT11
+    {"offset", "Set temperature offset.", _set_offset_handler},
+#endif
+#ifdef MODULE_GNRC_ICMPV6_ECHO
+#ifdef MODULE_XTIMER
+    { "ping6", "Ping via ICMPv6", _icmpv6_ping },
+#endif
+#endif
+#ifdef MODULE_PM_LAYERED_RESIDENCY
+    {"pm", "Prints the time spent in each power mode and held wakelocks", _pm_handler},
+#endif
+#ifdef MODULE_BOOTPROF
+    {"bootprof", "Prints the time stamps of the boot phases", _bootprof_handler},
+#endif
+#ifdef MODULE_GNRC_PKTTRACE
+    {"pkttrace", "Prints or resets the packet latency per stack hop", _gnrc_pkttrace},
+#endif
+#ifdef MODULE_PS
+    {"ps", "Prints information about running threads.", _ps_handler},
+#endif
+#ifdef MODULE_RANDOM
+    { "random_get", "returns 32 bit of pseudo randomness", _random_get },
+    { "random_init", "initializes the PRNG", _random_init },
 #endif
+    {"reboot", "Reboot the node", _reboot_handler},
+#ifdef MODULE_GNRC_IPV6_NC
+    {"routers", "IPv6 default router list", _ipv6_nc_routers },
 #endif
 #ifdef MODULE_GNRC_RPL
     {"rpl", "rpl configuration tool ('rpl help' for more information)", _gnrc_rpl },
 #endif
-#ifdef MODULE_GNRC_SIXLOWPAN_CTX
-#ifdef MODULE_GNRC_SIXLOWPAN_ND_BORDER_ROUTER
-    {"6ctx", "6LoWPAN context configuration tool", _gnrc_6ctx },
+#ifdef MODULE_LTC4150
+    {"rstcur", "Resets coulomb counter.", _reset_current_handler},
 #endif
+#if FEATURE_PERIPH_RTC
+    {"rtc", "control RTC peripheral interface",  _rtc_handler},
 #endif
 #ifdef MODULE_SAUL_REG
     {"saul", "interact with sensors and actuators using SAUL", _saul },
 #endif
-#ifdef MODULE_CCN_LITE_UTILS
-    { "ccnl_open", "opens an interface or socket", _ccnl_open },
-    { "ccnl_int", "sends an interest", _ccnl_interest },
-    { "ccnl_cont", "create content and populated it", _ccnl_content },
-    { "ccnl_fib", "shows or modifies the CCN-Lite FIB", _ccnl_fib },
+#ifdef MODULE_SHT11
+    {"temp", "Prints measured temperature.", _get_temperature_handler},
+#endif
+#ifdef MODULE_THREADPROF
+    {"threadprof", "Prints CPU load and stack high-water mark of all threads", _threadprof_handler},
+#endif
+#ifdef MODULE_GNRC_NETIF
+    {"txtsnd", "Sends a custom string as is over the link layer", _netif_send },
+#endif
+#ifdef MODULE_SHT11
+    {"weather", "Prints measured humidity and temperature.", _get_weather_handler},
+#endif
+#ifdef MODULE_GNRC_IPV6_WHITELIST
+    {"whitelist", "whitelists an address for receival ('whitelist [add|del|help]')", _whitelist },
+#endif
+#ifdef MODULE_GNRC_ZEP
+#ifdef MODULE_IPV6_ADDR
+    {"zep_init", "initializes ZEP (Zigbee Encapsulation Protocol)", _zep_init },
 #endif
-#ifdef MODULE_SNTP
-    { "ntpdate", "synchronizes with a remote time server", _ntpdate },
 #endif
     {NULL, NULL, NULL}
 };
+
+const unsigned _shell_command_numof = (sizeof(_shell_command_list) /
+                                       sizeof(_shell_command_list[0])) - 1;
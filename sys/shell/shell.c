@@ -44,32 +44,55 @@ static void _putchar(int c) {
 #endif
 #endif
 
-static shell_command_handler_t find_handler(const shell_command_t *command_list, char *command)
+static const shell_command_t *bisect(const shell_command_t *list,
+                                     unsigned numof, const char *command)
 {
-    const shell_command_t *command_lists[] = {
-        command_list,
-#ifdef MODULE_SHELL_COMMANDS
-        _shell_command_list,
-#endif
-    };
+    unsigned lo = 0;
+    unsigned hi = numof;
 
-    const shell_command_t *entry;
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+        int cmp = strcmp(command, list[mid].name);
 
-    /* iterating over command_lists */
-    for (unsigned int i = 0; i < sizeof(command_lists) / sizeof(entry); i++) {
-        if ((entry = command_lists[i])) {
-            /* iterating over commands in command_lists entry */
-            while (entry->name != NULL) {
-                if (strcmp(entry->name, command) == 0) {
-                    return entry->handler;
-                }
-                else {
-                    entry++;
-                }
+        if (cmp == 0) {
+            return &list[mid];
+        }
+        else if (cmp < 0) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+    return NULL;
+}
+
+static shell_command_handler_t find_handler(const shell_t *shell, char *command)
+{
+    const shell_command_t *entry = shell->commands;
+
+    /* the application's commands take precedence over the builtin ones */
+    if (entry && (shell->flags & SHELL_SORTED)) {
+        entry = bisect(entry, shell->numof, command);
+        if (entry) {
+            return entry->handler;
+        }
+    }
+    else if (entry) {
+        for (; entry->name != NULL; entry++) {
+            if (strcmp(entry->name, command) == 0) {
+                return entry->handler;
             }
         }
     }
 
+#ifdef MODULE_SHELL_COMMANDS
+    entry = bisect(_shell_command_list, _shell_command_numof, command);
+    if (entry) {
+        return entry->handler;
+    }
+#endif
+
     return NULL;
 }
 
@@ -99,7 +122,7 @@ static void print_help(const shell_command_t *command_list)
     }
 }
 
-static void handle_input_line(const shell_command_t *command_list, char *line)
+static void handle_input_line(const shell_t *shell, char *line)
 {
     static const char *INCORRECT_QUOTING = "shell: incorrect quoting";
 
@@ -203,13 +226,13 @@ static void handle_input_line(const shell_command_t *command_list, char *line)
     }
 
     /* then we call the appropriate handler */
-    shell_command_handler_t handler = find_handler(command_list, argv[0]);
+    shell_command_handler_t handler = find_handler(shell, argv[0]);
     if (handler != NULL) {
         handler(argc, argv);
     }
     else {
         if (strcmp("help", argv[0]) == 0) {
-            print_help(command_list);
+            print_help(shell->commands);
         }
         else {
             printf("shell: command not found: %s\n", argv[0]);
@@ -217,80 +240,126 @@ static void handle_input_line(const shell_command_t *command_list, char *line)
     }
 }
 
-static int readline(char *buf, size_t size)
+static inline void echo(const shell_t *shell, int c)
 {
-    char *line_buf_ptr = buf;
-
-    while (1) {
-        if ((line_buf_ptr - buf) >= ((int) size) - 1) {
-            return -1;
-        }
+#ifndef SHELL_NO_ECHO
+    if (!(shell->flags & SHELL_BATCH)) {
+        _putchar(c);
+    }
+#else
+    (void)shell;
+    (void)c;
+#endif
+}
 
-        int c = getchar();
-        if (c < 0) {
-            return 1;
-        }
+static inline void print_prompt(const shell_t *shell)
+{
+#ifndef SHELL_NO_PROMPT
+    if (!(shell->flags & SHELL_BATCH)) {
+        _putchar('>');
+        _putchar(' ');
+    }
+#else
+    (void)shell;
+#endif
 
-        /* We allow Unix linebreaks (\n), DOS linebreaks (\r\n), and Mac linebreaks (\r). */
-        /* QEMU transmits only a single '\r' == 13 on hitting enter ("-serial stdio"). */
-        /* DOS newlines are handled like hitting enter twice, but empty lines are ignored. */
-        if (c == '\r' || c == '\n') {
-            *line_buf_ptr = '\0';
-#ifndef SHELL_NO_ECHO
-            _putchar('\r');
-            _putchar('\n');
+#ifdef MODULE_NEWLIB
+    fflush(stdout);
 #endif
+}
 
-            /* return 1 if line is empty, 0 otherwise */
-            return line_buf_ptr == buf;
+void shell_init(shell_t *shell, const shell_command_t *commands,
+                char *line_buf, int len, unsigned flags)
+{
+    shell->commands = commands;
+    shell->numof = 0;
+    if (commands) {
+        while (commands[shell->numof].name != NULL) {
+            shell->numof++;
         }
-        /* QEMU uses 0x7f (DEL) as backspace, while 0x08 (BS) is for most terminals */
-        else if (c == 0x08 || c == 0x7f) {
-            if (line_buf_ptr == buf) {
-                /* The line is empty. */
-                continue;
-            }
+    }
+    shell->line_buf = line_buf;
+    shell->size = len;
+    shell->pos = 0;
+    shell->flags = flags;
+    shell->overflow = 0;
 
-            *--line_buf_ptr = '\0';
-            /* white-tape the character */
-#ifndef SHELL_NO_ECHO
-            _putchar('\b');
-            _putchar(' ');
-            _putchar('\b');
-#endif
+    print_prompt(shell);
+}
+
+int shell_input(shell_t *shell, int c)
+{
+    int res = 0;
+
+    /* We allow Unix linebreaks (\n), DOS linebreaks (\r\n), and Mac linebreaks (\r). */
+    /* QEMU transmits only a single '\r' == 13 on hitting enter ("-serial stdio"). */
+    /* DOS newlines are handled like hitting enter twice, but empty lines are ignored. */
+    if (c == '\r' || c == '\n') {
+        shell->line_buf[shell->pos] = '\0';
+        echo(shell, '\r');
+        echo(shell, '\n');
+
+        if (shell->overflow) {
+            puts("shell: line too long");
         }
-        else {
-            *line_buf_ptr++ = c;
-#ifndef SHELL_NO_ECHO
-            _putchar(c);
-#endif
+        else if (shell->pos > 0) {
+            handle_input_line(shell, shell->line_buf);
+            res = 1;
+        }
+        shell->pos = 0;
+        shell->overflow = 0;
+        print_prompt(shell);
+    }
+    /* QEMU uses 0x7f (DEL) as backspace, while 0x08 (BS) is for most terminals */
+    else if (c == 0x08 || c == 0x7f) {
+        if (shell->pos == 0) {
+            /* The line is empty. */
+            return 0;
         }
+
+        shell->pos--;
+        /* white-tape the character */
+        echo(shell, '\b');
+        echo(shell, ' ');
+        echo(shell, '\b');
+    }
+    else if (shell->pos >= (shell->size - 1)) {
+        /* the rest of the line is dropped */
+        shell->overflow = 1;
     }
+    else {
+        shell->line_buf[shell->pos++] = c;
+        echo(shell, c);
+    }
+
+    return res;
 }
 
-static inline void print_prompt(void)
+void shell_run_batch(const shell_command_t *shell_commands, char *line_buf,
+                     int len, unsigned flags)
 {
-#ifndef SHELL_NO_PROMPT
-    _putchar('>');
-    _putchar(' ');
-#endif
+    shell_t shell;
+    int c;
 
-#ifdef MODULE_NEWLIB
-    fflush(stdout);
-#endif
+    shell_init(&shell, shell_commands, line_buf, len, flags | SHELL_BATCH);
+    while ((c = getchar()) >= 0) {
+        shell_input(&shell, c);
+    }
+    /* the last line may lack its line break */
+    shell_input(&shell, '\n');
 }
 
 void shell_run(const shell_command_t *shell_commands, char *line_buf, int len)
 {
-    print_prompt();
+    shell_t shell;
+
+    shell_init(&shell, shell_commands, line_buf, len, 0);
 
     while (1) {
-        int res = readline(line_buf, len);
+        int c = getchar();
 
-        if (!res) {
-            handle_input_line(shell_commands, line_buf);
+        if (c >= 0) {
+            shell_input(&shell, c);
         }
-
-        print_prompt();
     }
 }
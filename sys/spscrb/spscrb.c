@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_spscrb
+ * @{
+ *
+ * @file
+ * @brief       Single-producer/single-consumer ringbuffer implementation
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "spscrb.h"
+
+/* buffer accesses must not be moved across index updates */
+#define BARRIER()   __asm__ volatile ("" : : : "memory")
+
+static inline unsigned _min(unsigned a, unsigned b)
+{
+    return (a < b) ? a : b;
+}
+
+static inline uint8_t *_elem(const spscrb_t *rb, unsigned count)
+{
+    return rb->buf + ((count & (rb->size - 1)) * rb->elem_size);
+}
+
+unsigned spscrb_reserve(spscrb_t *rb, void **region)
+{
+    unsigned writes = rb->writes;
+    unsigned to_end = rb->size - (writes & (rb->size - 1));
+
+    *region = _elem(rb, writes);
+    return _min(spscrb_free(rb), to_end);
+}
+
+void spscrb_commit(spscrb_t *rb, unsigned n)
+{
+    assert(n <= spscrb_free(rb));
+    BARRIER();
+    rb->writes += n;
+}
+
+unsigned spscrb_peek(spscrb_t *rb, void **region)
+{
+    unsigned reads = rb->reads;
+    unsigned to_end = rb->size - (reads & (rb->size - 1));
+    unsigned avail = spscrb_avail(rb);
+
+    BARRIER();
+    *region = _elem(rb, reads);
+    return _min(avail, to_end);
+}
+
+void spscrb_release(spscrb_t *rb, unsigned n)
+{
+    assert(n <= spscrb_avail(rb));
+    BARRIER();
+    rb->reads += n;
+}
+
+unsigned spscrb_put(spscrb_t *rb, const void *src, unsigned n)
+{
+    const uint8_t *pos = src;
+    unsigned done = 0;
+
+    /* at most two iterations: up to the end of the buffer and from its
+     * start */
+    while (done < n) {
+        void *region;
+        unsigned len = _min(spscrb_reserve(rb, &region), n - done);
+        if (len == 0) {
+            break;
+        }
+        memcpy(region, pos, len * rb->elem_size);
+        spscrb_commit(rb, len);
+        pos += len * rb->elem_size;
+        done += len;
+    }
+
+    return done;
+}
+
+unsigned spscrb_get(spscrb_t *rb, void *dst, unsigned n)
+{
+    uint8_t *pos = dst;
+    unsigned done = 0;
+
+    while (done < n) {
+        void *region;
+        unsigned len = _min(spscrb_peek(rb, &region), n - done);
+        if (len == 0) {
+            break;
+        }
+        memcpy(pos, region, len * rb->elem_size);
+        spscrb_release(rb, len);
+        pos += len * rb->elem_size;
+        done += len;
+    }
+
+    return done;
+}
@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_threadprof
+ * @{
+ *
+ * @file
+ * @brief       Thread profiling implementation
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "irq.h"
+#include "sched.h"
+#include "thread.h"
+#include "threadprof.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define PID_NUMOF       (KERNEL_PID_LAST + 1)
+
+static uint32_t _runtime[THREADPROF_WINDOW_NUMOF][PID_NUMOF];
+static uint32_t _switches[THREADPROF_WINDOW_NUMOF][PID_NUMOF];
+static uint32_t _duration[THREADPROF_WINDOW_NUMOF];
+static uint32_t _last_runtime[PID_NUMOF];
+static uint32_t _last_switches[PID_NUMOF];
+static uint32_t _last_sample;
+static unsigned _cur;
+
+#ifdef DEVELHELP
+/* start of the stack a mark was computed for, to detect re-used PIDs */
+static char *_stack_start[PID_NUMOF];
+/* lowest stack address found to be used */
+static uintptr_t *_stack_mark[PID_NUMOF];
+
+/* stack usage of exited threads */
+static struct {
+    const char *name;
+    int size;
+    int max;
+} _exited[THREADPROF_EXITED_NUMOF];
+static unsigned _exited_next;
+#endif
+
+static xtimer_t _timer;
+
+static void _timer_cb(void *arg)
+{
+    (void)arg;
+    threadprof_sample();
+    xtimer_set(&_timer, THREADPROF_WINDOW_US);
+}
+
+#ifdef DEVELHELP
+static void _update_stack_mark(kernel_pid_t pid, thread_t *thread)
+{
+    uintptr_t *p = (uintptr_t *)thread->stack_start;
+    uintptr_t *end;
+
+    if (_stack_start[pid] != thread->stack_start) {
+        /* new thread: nothing is known about its stack yet */
+        _stack_start[pid] = thread->stack_start;
+        end = (uintptr_t *)(thread->stack_start + thread->stack_size);
+    }
+    else {
+        /* everything from the old mark up is known to be used */
+        end = _stack_mark[pid];
+    }
+
+    /* the stack grows downwards and unused words hold their own address.
+     * Like thread_measure_stack_free(), scan up from the bottom: words above
+     * the deepest use may still be untouched, e.g. in large local arrays */
+    while ((p < end) && (*p == (uintptr_t)p)) {
+        p++;
+    }
+    _stack_mark[pid] = p;
+}
+
+static int _stack_max(kernel_pid_t pid, thread_t *thread)
+{
+    return (thread->stack_start + thread->stack_size) - (char *)_stack_mark[pid];
+}
+
+static void _print_stack(const char *pid, const char *name, int size, int max)
+{
+    int rec = threadprof_stack_recommend(max);
+
+    printf("\t%3s | %-20s | %5i | %5i | %5i | %5i%s\n", pid, name, size, max,
+           rec, size - rec, (rec > size) ? " !" : "");
+}
+#endif
+
+void threadprof_init(void)
+{
+    _last_sample = xtimer_now().ticks32;
+    _timer.callback = _timer_cb;
+    xtimer_set(&_timer, THREADPROF_WINDOW_US);
+}
+
+void threadprof_sample(void)
+{
+    unsigned state = irq_disable();
+    uint32_t now = xtimer_now().ticks32;
+
+    _duration[_cur] = now - _last_sample;
+    _last_sample = now;
+
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        thread_t *thread = (thread_t *)sched_threads[pid];
+        schedstat *stat = &sched_pidlist[pid];
+        uint32_t runtime = stat->runtime_ticks;
+
+        /* the active thread's current slice is not accounted yet */
+        if ((pid == sched_active_pid) && stat->laststart) {
+            runtime += now - stat->laststart;
+        }
+
+        if (thread) {
+            _runtime[_cur][pid] = runtime - _last_runtime[pid];
+            _switches[_cur][pid] = stat->schedules - _last_switches[pid];
+        }
+        else {
+            _runtime[_cur][pid] = 0;
+            _switches[_cur][pid] = 0;
+        }
+        _last_runtime[pid] = runtime;
+        _last_switches[pid] = stat->schedules;
+    }
+
+    _cur = (_cur + 1) % THREADPROF_WINDOW_NUMOF;
+    irq_restore(state);
+}
+
+static uint32_t _permille(uint32_t part, uint32_t total)
+{
+    if (total == 0) {
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)part * 1000) / total);
+}
+
+void threadprof_stack_sample(void)
+{
+#ifdef DEVELHELP
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        /* one thread at a time, to keep the time with IRQs disabled short */
+        unsigned state = irq_disable();
+        thread_t *thread = (thread_t *)sched_threads[pid];
+
+        if (thread) {
+            _update_stack_mark(pid, thread);
+        }
+        irq_restore(state);
+    }
+#endif
+}
+
+void threadprof_thread_exit(void)
+{
+#ifdef DEVELHELP
+    unsigned state = irq_disable();
+    kernel_pid_t pid = sched_active_pid;
+    thread_t *thread = (thread_t *)sched_active_thread;
+    const char *name = thread->name ? thread->name : "-";
+    unsigned i;
+
+    _update_stack_mark(pid, thread);
+    int max = _stack_max(pid, thread);
+    /* the PID and the stack may be reused by the next thread */
+    _stack_start[pid] = NULL;
+
+    /* threads that are started again and again share one entry */
+    for (i = 0; i < THREADPROF_EXITED_NUMOF; i++) {
+        if (_exited[i].name && (strcmp(_exited[i].name, name) == 0)) {
+            break;
+        }
+    }
+    if (i == THREADPROF_EXITED_NUMOF) {
+        i = _exited_next;
+        _exited_next = (_exited_next + 1) % THREADPROF_EXITED_NUMOF;
+        _exited[i].name = name;
+        _exited[i].max = 0;
+    }
+    _exited[i].size = thread->stack_size;
+    if (max > _exited[i].max) {
+        _exited[i].max = max;
+    }
+    irq_restore(state);
+#endif
+}
+
+int threadprof_get(kernel_pid_t pid, threadprof_t *out)
+{
+    if (!pid_is_valid(pid)) {
+        return -1;
+    }
+
+    unsigned state = irq_disable();
+    thread_t *thread = (thread_t *)sched_threads[pid];
+
+    if (thread == NULL) {
+        irq_restore(state);
+        return -1;
+    }
+
+    uint32_t runtime = 0, duration = 0, switches = 0;
+    for (unsigned i = 0; i < THREADPROF_WINDOW_NUMOF; i++) {
+        runtime += _runtime[i][pid];
+        duration += _duration[i];
+        switches += _switches[i][pid];
+    }
+    unsigned last = (_cur + THREADPROF_WINDOW_NUMOF - 1) % THREADPROF_WINDOW_NUMOF;
+
+    out->cpu_permille = _permille(runtime, duration);
+    out->cpu_last_permille = _permille(_runtime[last][pid], _duration[last]);
+    out->switches = switches;
+#ifdef DEVELHELP
+    _update_stack_mark(pid, thread);
+    out->stack_max = _stack_max(pid, thread);
+#else
+    out->stack_max = -1;
+#endif
+    irq_restore(state);
+
+    return 0;
+}
+
+void threadprof_print(void)
+{
+    printf("\tpid | "
+#ifdef DEVELHELP
+           "%-21s| "
+#endif
+           "cpu (win) | cpu (last) | switches "
+#ifdef DEVELHELP
+           "| stack ( max) "
+#endif
+           "\n"
+#ifdef DEVELHELP
+           , "name"
+#endif
+           );
+
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        threadprof_t prof;
+        if (threadprof_get(pid, &prof) < 0) {
+            continue;
+        }
+#ifdef DEVELHELP
+        thread_t *thread = (thread_t *)sched_threads[pid];
+#endif
+        printf("\t%3" PRIkernel_pid
+#ifdef DEVELHELP
+               " | %-20s"
+#endif
+               " |  %3" PRIu32 ".%" PRIu32 "%% |   %3" PRIu32 ".%" PRIu32
+               "%% | %8" PRIu32
+#ifdef DEVELHELP
+               " | %5i (%4i)"
+#endif
+               "\n", pid,
+#ifdef DEVELHELP
+               thread->name,
+#endif
+               prof.cpu_permille / 10, prof.cpu_permille % 10,
+               prof.cpu_last_permille / 10, prof.cpu_last_permille % 10,
+               prof.switches
+#ifdef DEVELHELP
+               , thread->stack_size, prof.stack_max
+#endif
+               );
+    }
+}
+
+void threadprof_print_stacks(void)
+{
+#ifdef DEVELHELP
+    int total = 0, total_rec = 0;
+    char pid_str[4];
+
+    printf("\tpid | %-20s |  size |   max |   rec | slack\n", "name");
+
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        threadprof_t prof;
+        if (threadprof_get(pid, &prof) < 0) {
+            continue;
+        }
+        thread_t *thread = (thread_t *)sched_threads[pid];
+
+        snprintf(pid_str, sizeof(pid_str), "%" PRIkernel_pid, pid);
+        _print_stack(pid_str, thread->name, thread->stack_size, prof.stack_max);
+        total += thread->stack_size;
+        total_rec += threadprof_stack_recommend(prof.stack_max);
+    }
+    for (unsigned i = 0; i < THREADPROF_EXITED_NUMOF; i++) {
+        if (_exited[i].name == NULL) {
+            continue;
+        }
+        /* exited threads have no PID anymore */
+        _print_stack("-", _exited[i].name, _exited[i].size, _exited[i].max);
+        total += _exited[i].size;
+        total_rec += threadprof_stack_recommend(_exited[i].max);
+    }
+    printf("\t%3s | %-20s | %5i |       | %5i | %5i\n", "", "SUM", total,
+           total_rec, total - total_rec);
+#else
+    puts("threadprof: stack usage needs DEVELHELP");
+#endif
+}
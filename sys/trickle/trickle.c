@@ -18,12 +18,99 @@
 #include <stdlib.h>
 
 #include "inttypes.h"
+#include "irq.h"
+#include "msg.h"
 #include "random.h"
 #include "trickle.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_TRICKLE_SCHED
+static trickle_t *_sched_list;  /* sorted by _sched_due() */
+static xtimer_t _sched_timer;
+
+static inline uint64_t _sched_due(const trickle_t *trickle)
+{
+    if ((trickle->callback_at != 0) && (trickle->callback_at < trickle->interval_at)) {
+        return trickle->callback_at;
+    }
+    return trickle->interval_at;
+}
+
+/* all _sched_* functions are called with interrupts disabled */
+static void _sched_remove(trickle_t *trickle)
+{
+    for (trickle_t **ptr = &_sched_list; *ptr != NULL; ptr = &(*ptr)->next) {
+        if (*ptr == trickle) {
+            *ptr = trickle->next;
+            trickle->next = NULL;
+            return;
+        }
+    }
+}
+
+static void _sched_insert(trickle_t *trickle)
+{
+    uint64_t due = _sched_due(trickle);
+    trickle_t **ptr = &_sched_list;
+
+    while ((*ptr != NULL) && (_sched_due(*ptr) <= due)) {
+        ptr = &(*ptr)->next;
+    }
+    trickle->next = *ptr;
+    *ptr = trickle;
+}
+
+static void _sched_cb(void *arg);
+
+static void _sched_arm(void)
+{
+    uint64_t now, offset = 0;
+
+    xtimer_remove(&_sched_timer);
+    if (_sched_list == NULL) {
+        return;
+    }
+    now = xtimer_now_usec64();
+    if (_sched_due(_sched_list) > now) {
+        offset = _sched_due(_sched_list) - now;
+    }
+    if (offset > UINT32_MAX) {
+        /* fires early, the callback then just sets the timer again */
+        offset = UINT32_MAX;
+    }
+    _sched_timer.callback = _sched_cb;
+    xtimer_set_slack(&_sched_timer, (uint32_t)offset, TRICKLE_SCHED_SLACK);
+}
+
+static void _sched_cb(void *arg)
+{
+    uint64_t now = xtimer_now_usec64() + TRICKLE_SCHED_SLACK;
+
+    (void)arg;
+    while ((_sched_list != NULL) && (_sched_due(_sched_list) <= now)) {
+        trickle_t *trickle = _sched_list;
+
+        _sched_list = trickle->next;
+        /* callback is never after the interval's end, so the order of the
+         * messages is kept */
+        if ((trickle->callback_at != 0) && (trickle->callback_at <= now)) {
+            trickle->callback_at = 0;
+            msg_send_int(&trickle->msg_callback, trickle->pid);
+        }
+        if (trickle->interval_at <= now) {
+            trickle->interval_at = 0;
+            msg_send_int(&trickle->msg_interval, trickle->pid);
+        }
+        else {
+            _sched_insert(trickle);
+        }
+    }
+    _sched_arm();
+}
+#endif /* MODULE_TRICKLE_SCHED */
+
 void trickle_callback(trickle_t *trickle)
 {
     /* Handle k=0 like k=infinity (according to RFC6206, section 6.5) */
@@ -49,12 +136,32 @@ void trickle_interval(trickle_t *trickle)
     trickle->t = (trickle->I / 2) + random_uint32_range(0, (trickle->I / 2) + 1);
 
     trickle->msg_callback_time = trickle->t * SEC_IN_MS;
+    trickle->msg_interval_time = trickle->I * SEC_IN_MS;
+
+#ifdef MODULE_TRICKLE_SCHED
+    unsigned state = irq_disable();
+    uint64_t now = xtimer_now_usec64();
+    bool rearm = (_sched_list == trickle);
+
+    _sched_remove(trickle);
+    trickle->callback_at = now + trickle->msg_callback_time;
+    trickle->interval_at = now + trickle->msg_interval_time;
+    _sched_insert(trickle);
+    if (rearm || (_sched_list == trickle)) {
+        _sched_arm();
+    }
+    irq_restore(state);
+#else
+    uint64_t now = xtimer_now_usec64();
+
+    trickle->callback_at = now + trickle->msg_callback_time;
     xtimer_set_msg64(&trickle->msg_callback_timer, trickle->msg_callback_time,
                      &trickle->msg_callback, trickle->pid);
 
-    trickle->msg_interval_time = trickle->I * SEC_IN_MS;
+    trickle->interval_at = now + trickle->msg_interval_time;
     xtimer_set_msg64(&trickle->msg_interval_timer, trickle->msg_interval_time,
                      &trickle->msg_interval, trickle->pid);
+#endif
 }
 
 void trickle_reset_timer(trickle_t *trickle)
@@ -85,8 +192,21 @@ void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t interval_msg_t
 
 void trickle_stop(trickle_t *trickle)
 {
+#ifdef MODULE_TRICKLE_SCHED
+    unsigned state = irq_disable();
+    bool rearm = (_sched_list == trickle);
+
+    _sched_remove(trickle);
+    if (rearm) {
+        _sched_arm();
+    }
+    irq_restore(state);
+#else
     xtimer_remove(&trickle->msg_interval_timer);
     xtimer_remove(&trickle->msg_callback_timer);
+#endif
+    trickle->callback_at = 0;
+    trickle->interval_at = 0;
 }
 
 void trickle_increment_counter(trickle_t *trickle)
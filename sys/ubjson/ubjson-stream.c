@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_ubjson_stream
+ * @{
+ * @file
+ * @brief       Buffered UBJSON output and UBJSON input from packets
+ * @}
+ */
+
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "ubjson_stream.h"
+
+static ssize_t _write(ubjson_cookie_t *__restrict cookie, const void *buf,
+                      size_t len)
+{
+    ubjson_writer_t *writer = container_of(cookie, ubjson_writer_t, cookie);
+
+    if ((writer->len + len) > writer->size) {
+        ssize_t res = ubjson_writer_flush(writer);
+
+        if (res < 0) {
+            return res;
+        }
+        if (len > writer->size) {
+            /* does not fit into the buffer at all: hand it on directly */
+            writer->flushes++;
+            res = writer->flush(writer, buf, len);
+            return (res < 0) ? res : (ssize_t)len;
+        }
+    }
+    memcpy(&writer->buf[writer->len], buf, len);
+    writer->len += len;
+    return len;
+}
+
+void ubjson_writer_init(ubjson_writer_t *writer, void *buf, size_t size,
+                        ubjson_flush_t flush)
+{
+    ubjson_write_init(&writer->cookie, _write);
+    writer->flush = flush;
+    writer->buf = buf;
+    writer->size = size;
+    writer->len = 0;
+    writer->flushes = 0;
+}
+
+ssize_t ubjson_writer_flush(ubjson_writer_t *writer)
+{
+    ssize_t res = 0;
+
+    if (writer->len > 0) {
+        writer->flushes++;
+        res = writer->flush(writer, writer->buf, writer->len);
+        writer->len = 0;
+    }
+    return res;
+}
+
+void ubjson_reader_init(ubjson_reader_t *reader, const gnrc_pktsnip_t *pkt)
+{
+    memset(&reader->cookie, 0, sizeof(reader->cookie));
+    reader->snip = pkt;
+    reader->pos = 0;
+}
+
+ssize_t ubjson_reader_read(ubjson_cookie_t *__restrict cookie, void *buf,
+                           size_t max_len)
+{
+    ubjson_reader_t *reader = container_of(cookie, ubjson_reader_t, cookie);
+
+    /* skip exhausted and empty snips */
+    while ((reader->snip != NULL) && (reader->pos >= reader->snip->size)) {
+        reader->snip = reader->snip->next;
+        reader->pos = 0;
+    }
+    if (reader->snip == NULL) {
+        /* ubjson_read() retries on 0, so the end must be an error */
+        return -1;
+    }
+
+    size_t len = reader->snip->size - reader->pos;
+
+    if (len > max_len) {
+        len = max_len;
+    }
+    memcpy(buf, (const uint8_t *)reader->snip->data + reader->pos, len);
+    reader->pos += len;
+    return len;
+}
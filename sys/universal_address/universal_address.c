@@ -46,6 +46,17 @@
 #   define UNIVERSAL_ADDRESS_MAX_ENTRIES    (UA_ADD0)
 #endif
 
+#if UNIVERSAL_ADDRESS_MAX_ENTRIES >= UINT16_MAX
+#error "UNIVERSAL_ADDRESS_MAX_ENTRIES must be below UINT16_MAX"
+#endif
+
+/**
+ * @brief Number of hash buckets for the address lookup
+ */
+#ifndef UNIVERSAL_ADDRESS_HASH_BUCKETS
+#define UNIVERSAL_ADDRESS_HASH_BUCKETS  ((UNIVERSAL_ADDRESS_MAX_ENTRIES / 2) + 1)
+#endif
+
 /**
  * @brief counter indicating the number of entries allocated
  */
@@ -56,11 +67,53 @@ static size_t universal_address_table_filled = 0;
  */
 static universal_address_container_t universal_address_table[UNIVERSAL_ADDRESS_MAX_ENTRIES];
 
+/**
+ * @brief Links of the containers, either to the next container in the same
+ *        hash bucket or to the next free container.
+ *        Links store the index + 1, 0 terminates a list.
+ */
+static uint16_t universal_address_link[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
+/**
+ * @brief The hash buckets of used containers
+ */
+static uint16_t universal_address_bucket[UNIVERSAL_ADDRESS_HASH_BUCKETS];
+
+/**
+ * @brief The list of containers released after their first use
+ */
+static uint16_t universal_address_free = 0;
+
+/**
+ * @brief The number of containers used at least once, the remaining ones are free
+ */
+static size_t universal_address_touched = 0;
+
 /**
  * @brief access mutex to control exclusive operations on calls
  */
 static mutex_t mtx_access = MUTEX_INIT;
 
+/**
+ * @brief computes the hash bucket for the given address
+ *
+ * @param[in] addr       pointer to the address
+ * @param[in] addr_size  the number of bytes of the address
+ *
+ * @return pointer to the head of the hash bucket
+ */
+static uint16_t *universal_address_get_bucket(uint8_t *addr, size_t addr_size)
+{
+    uint32_t hash = 2166136261UL;
+
+    /* FNV-1a */
+    for (size_t i = 0; i < addr_size; ++i) {
+        hash = (hash ^ addr[i]) * 16777619UL;
+    }
+
+    return &universal_address_bucket[hash % UNIVERSAL_ADDRESS_HASH_BUCKETS];
+}
+
 /**
  * @brief finds the universal address container for the given address
  *
@@ -72,10 +125,14 @@ static mutex_t mtx_access = MUTEX_INIT;
  */
 static universal_address_container_t *universal_address_find_entry(uint8_t *addr, size_t addr_size)
 {
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        if (universal_address_table[i].address_size == addr_size) {
-            if (memcmp((universal_address_table[i].address), addr, addr_size) == 0) {
-                return &(universal_address_table[i]);
+    uint16_t i = *universal_address_get_bucket(addr, addr_size);
+
+    for (; i != 0; i = universal_address_link[i - 1]) {
+        universal_address_container_t *entry = &universal_address_table[i - 1];
+
+        if (entry->address_size == addr_size) {
+            if (memcmp((entry->address), addr, addr_size) == 0) {
+                return entry;
             }
         }
     }
@@ -84,24 +141,56 @@ static universal_address_container_t *universal_address_find_entry(uint8_t *addr
 }
 
 /**
- * @brief finds the next empty or unused universal address containers
+ * @brief takes the next empty or unused universal address container
  *
  * @return pointer to the next free/unused universal_address_container_t
  *         or NULL if no memory is left in universal_address_table
  */
 static universal_address_container_t *universal_address_get_next_unused_entry(void)
 {
-    if (universal_address_table_filled < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
-        for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-            if (universal_address_table[i].use_count == 0) {
-                return &(universal_address_table[i]);
-            }
-        }
+    if (universal_address_free != 0) {
+        uint16_t i = universal_address_free;
+
+        universal_address_free = universal_address_link[i - 1];
+        return &universal_address_table[i - 1];
+    }
+
+    if (universal_address_touched < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
+        return &universal_address_table[universal_address_touched++];
     }
 
     return NULL;
 }
 
+/**
+ * @brief removes a container from its hash bucket and puts it on the free list
+ *
+ * @param[in] entry      the container, its use_count dropped to 0
+ */
+static void universal_address_release_entry(universal_address_container_t *entry)
+{
+    uint16_t idx = (entry - universal_address_table) + 1;
+    uint16_t *link = universal_address_get_bucket(entry->address, entry->address_size);
+
+    while (*link != idx) {
+        link = &universal_address_link[*link - 1];
+    }
+    *link = universal_address_link[idx - 1];
+
+    universal_address_link[idx - 1] = universal_address_free;
+    universal_address_free = idx;
+}
+
+/**
+ * @brief empties the hash buckets and marks all containers free
+ */
+static void universal_address_clear_index(void)
+{
+    memset(universal_address_bucket, 0, sizeof(universal_address_bucket));
+    universal_address_free = 0;
+    universal_address_touched = 0;
+}
+
 universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_size)
 {
     mutex_lock(&mtx_access);
@@ -124,11 +213,16 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
 
             /* set the used bytes */
             pEntry->address_size = addr_size;
-            pEntry->use_count = 0;
         }
+        pEntry->use_count = 0;
 
         /* copy the address */
         memcpy((pEntry->address), addr, addr_size);
+
+        /* make it findable */
+        uint16_t *bucket = universal_address_get_bucket(addr, addr_size);
+        universal_address_link[pEntry - universal_address_table] = *bucket;
+        *bucket = (pEntry - universal_address_table) + 1;
     }
 
     pEntry->use_count++;
@@ -155,6 +249,7 @@ void universal_address_rem(universal_address_container_t *entry)
 
             if (entry->use_count == 0) {
                 universal_address_table_filled--;
+                universal_address_release_entry(entry);
             }
         }
         else {
@@ -300,6 +395,7 @@ void universal_address_init(void)
         memset(universal_address_table[i].address, 0, UNIVERSAL_ADDRESS_SIZE);
     }
 
+    universal_address_clear_index();
     mutex_unlock(&mtx_access);
 }
 
@@ -312,6 +408,7 @@ void universal_address_reset(void)
     }
 
     universal_address_table_filled = 0;
+    universal_address_clear_index();
     mutex_unlock(&mtx_access);
 }
 
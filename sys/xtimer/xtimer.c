@@ -24,6 +24,9 @@
 #include "xtimer.h"
 #include "mutex.h"
 #include "thread.h"
+#ifdef MODULE_CORE_THREAD_FLAGS
+#include "thread_flags.h"
+#endif
 #include "irq.h"
 #include "div.h"
 #include "list.h"
@@ -39,6 +42,14 @@ typedef struct {
     int timeout;
 } mutex_thread_t;
 
+#ifdef MODULE_CORE_MBOX
+typedef struct {
+    mbox_t *mbox;
+    thread_t *thread;
+    volatile unsigned timeout;
+} mbox_thread_t;
+#endif
+
 static void _callback_unlock_mutex(void* arg)
 {
     mutex_t *mutex = (mutex_t *) arg;
@@ -71,6 +82,7 @@ void _xtimer_periodic_wakeup(uint32_t *last_wakeup, uint32_t period) {
 
     timer.callback = _callback_unlock_mutex;
     timer.arg = (void*) &mutex;
+    timer.target = timer.long_target = 0;
 
     uint32_t target = (*last_wakeup) + period;
     uint32_t now = _xtimer_now();
@@ -178,6 +190,21 @@ void _xtimer_set_wakeup64(xtimer_t *timer, uint64_t offset, kernel_pid_t pid)
     _xtimer_set64(timer, offset, offset >> 32);
 }
 
+#ifdef MODULE_CORE_THREAD_FLAGS
+static void _callback_timeout_flag(void *arg)
+{
+    thread_flags_set((thread_t *)arg, THREAD_FLAG_TIMEOUT);
+}
+
+void _xtimer_set_timeout_flag64(xtimer_t *timer, uint64_t offset, thread_t *thread)
+{
+    timer->callback = _callback_timeout_flag;
+    timer->arg = thread;
+
+    _xtimer_set64(timer, offset, offset >> 32);
+}
+#endif
+
 void xtimer_now_timex(timex_t *out)
 {
     uint64_t now = xtimer_usec_from_ticks64(xtimer_now64());
@@ -243,6 +270,7 @@ int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t timeout)
     xtimer_t t;
     mutex_thread_t mt = { mutex, (thread_t *)sched_active_thread, 0 };
 
+    t.target = t.long_target = 0;
     if (timeout != 0) {
         t.callback = _mutex_timeout;
         t.arg = (void *)((mutex_thread_t *)&mt);
@@ -253,3 +281,31 @@ int xtimer_mutex_lock_timeout(mutex_t *mutex, uint64_t timeout)
     xtimer_remove(&t);
     return -mt.timeout;
 }
+
+#ifdef MODULE_CORE_MBOX
+static void _mbox_timeout(void *arg)
+{
+    mbox_thread_t *mt = (mbox_thread_t *)arg;
+
+    _mbox_cancel_get(mt->mbox, mt->thread, &mt->timeout);
+}
+
+int xtimer_mbox_get_timeout(mbox_t *mbox, msg_t *msg, uint32_t timeout)
+{
+    xtimer_t t;
+    mbox_thread_t mt = { mbox, (thread_t *)sched_active_thread, 0 };
+
+    if (timeout == 0) {
+        return mbox_try_get(mbox, msg) ? 0 : -1;
+    }
+
+    t.callback = _mbox_timeout;
+    t.arg = (void *)&mt;
+    t.target = t.long_target = 0;
+    xtimer_set(&t, timeout);
+
+    int res = _mbox_get_cancelable(mbox, msg, &mt.timeout);
+    xtimer_remove(&t);
+    return res ? 0 : -1;
+}
+#endif
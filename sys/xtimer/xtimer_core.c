@@ -35,14 +35,44 @@ static volatile uint32_t _long_cnt = 0;
 volatile uint32_t _xtimer_high_cnt = 0;
 #endif
 
+/* The counters at the start of the current period, for lock-free reading of
+ * the 64 bit time. Only _next_period() writes them: while it updates one
+ * copy, _period_seq makes readers use the other one, so even an interrupt
+ * that preempts the writer reads a consistent pair without spinning. */
+typedef struct {
+    uint32_t long_cnt;
+    uint32_t high_cnt;
+} _period_t;
+static volatile _period_t _period[2];
+static volatile unsigned _period_seq;
+
 static inline void xtimer_spin_until(uint32_t value);
 
+static xtimer_stats_t _stats;
+
+static xtimer_calibration_t _calibration = {
+    .backoff = XTIMER_BACKOFF,
+    .overhead = XTIMER_OVERHEAD,
+    .isr_backoff = XTIMER_ISR_BACKOFF,
+};
+
+#ifdef MODULE_XTIMER_CALIBRATE
+#define BACKOFF         (_calibration.backoff)
+#define OVERHEAD        (_calibration.overhead)
+#define ISR_BACKOFF     (_calibration.isr_backoff)
+#else
+#define BACKOFF         (XTIMER_BACKOFF)
+#define OVERHEAD        (XTIMER_OVERHEAD)
+#define ISR_BACKOFF     (XTIMER_ISR_BACKOFF)
+#endif
+
 static xtimer_t *timer_list_head = NULL;
 static xtimer_t *overflow_list_head = NULL;
 static xtimer_t *long_list_head = NULL;
 
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer);
 static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer);
+static xtimer_t *_pop_timer(xtimer_t **list_head);
 static void _shoot(xtimer_t *timer);
 static void _remove(xtimer_t *timer);
 static inline void _lltimer_set(uint32_t target);
@@ -66,6 +96,74 @@ static inline void xtimer_spin_until(uint32_t target) {
     while (_xtimer_lltimer_now() < target);
 }
 
+#ifdef MODULE_XTIMER_CALIBRATE
+static volatile uint32_t _calibrate_fired;
+static volatile int _calibrate_done;
+
+static void _calibrate_cb(void *arg)
+{
+    (void)arg;
+    _calibrate_fired = _xtimer_lltimer_now();
+    _calibrate_done = 1;
+}
+
+/* measures how late timers fire without correction and how long setting a
+ * timer takes, on the clock configuration actually running */
+static void _calibrate(void)
+{
+    xtimer_t timer = { .callback = _calibrate_cb };
+    uint32_t min_late = UINT32_MAX;
+    uint32_t max_late = 0;
+    uint32_t max_set = 0;
+    unsigned i;
+
+    _calibration.overhead = 0;
+    for (i = 0; i < XTIMER_CALIBRATE_RUNS; i++) {
+        uint32_t offset = _calibration.backoff + XTIMER_CALIBRATE_MARGIN;
+        uint32_t start = _xtimer_now();
+        uint32_t target = start + offset;
+
+        _calibrate_done = 0;
+        _xtimer_set_absolute(&timer, target);
+        uint32_t set = _xtimer_now() - start;
+        /* xtimer_init() might run with interrupts disabled on some platforms */
+        while (!_calibrate_done && ((_xtimer_now() - start) < (offset * 2))) {}
+        if (!_calibrate_done) {
+            xtimer_remove(&timer);
+            break;
+        }
+        uint32_t late = _xtimer_lltimer_mask(_calibrate_fired - target);
+        if (late < min_late) {
+            min_late = late;
+        }
+        if (late > max_late) {
+            max_late = late;
+        }
+        if (set > max_set) {
+            max_set = set;
+        }
+    }
+    if (i < XTIMER_CALIBRATE_RUNS) {
+        DEBUG("xtimer_init(): calibration failed, keeping defaults\n");
+        _calibration.overhead = XTIMER_OVERHEAD;
+        return;
+    }
+    /* correct by the smallest delay, so timers never fire early, but back
+     * off by the largest one */
+    _calibration.overhead = min_late;
+    _calibration.isr_backoff = max_late;
+    _calibration.backoff = max_set + max_late;
+    DEBUG("xtimer_init(): backoff=%" PRIu32 " overhead=%" PRIu32
+          " isr_backoff=%" PRIu32 "\n", _calibration.backoff,
+          _calibration.overhead, _calibration.isr_backoff);
+}
+#endif
+
+const xtimer_calibration_t *xtimer_get_calibration(void)
+{
+    return &_calibration;
+}
+
 void xtimer_init(void)
 {
     /* initialize low-level timer */
@@ -73,22 +171,44 @@ void xtimer_init(void)
 
     /* register initial overflow tick */
     _lltimer_set(0xFFFFFFFF);
+
+#ifdef MODULE_XTIMER_LP
+    _xtimer_lp_init();
+#endif
+
+#ifdef MODULE_XTIMER_CALIBRATE
+    _calibrate();
+#endif
+}
+
+static void _publish_period(void)
+{
+    _period_seq++;
+    /* readers use _period[1] now */
+    _period[0].long_cnt = _long_cnt;
+#if XTIMER_MASK
+    _period[0].high_cnt = _xtimer_high_cnt;
+#endif
+    _period_seq++;
+    /* readers use _period[0] now */
+    _period[1].long_cnt = _period[0].long_cnt;
+    _period[1].high_cnt = _period[0].high_cnt;
 }
 
 static void _xtimer_now_internal(uint32_t *short_term, uint32_t *long_term)
 {
-    uint32_t before, after, long_value;
+    unsigned seq;
+    uint32_t now;
 
-    /* loop to cope with possible overflow of _xtimer_now() */
+    /* retry if the period changed while reading */
     do {
-        before = _xtimer_now();
-        long_value = _long_cnt;
-        after = _xtimer_now();
-
-    } while(before > after);
+        seq = _period_seq;
+        *long_term = _period[seq & 1].long_cnt;
+        *short_term = _period[seq & 1].high_cnt;
+        now = _xtimer_lltimer_now();
+    } while (seq != _period_seq);
 
-    *short_term = after;
-    *long_term = long_value;
+    *short_term |= now;
 }
 
 uint64_t _xtimer_now64(void)
@@ -102,6 +222,13 @@ uint64_t _xtimer_now64(void)
 void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
 {
     DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
+#ifdef MODULE_XTIMER_LP
+    if (long_offset) {
+        xtimer_remove(timer);
+        _xtimer_lp_set(timer, ((uint64_t)long_offset << 32) | offset);
+        return;
+    }
+#endif
     if (!long_offset) {
         /* timer fits into the short timer */
         _xtimer_set(timer, (uint32_t) offset);
@@ -136,7 +263,14 @@ void _xtimer_set(xtimer_t *timer, uint32_t offset)
 
     xtimer_remove(timer);
 
-    if (offset < XTIMER_BACKOFF) {
+#ifdef MODULE_XTIMER_LP
+    if (_xtimer_usec_from_ticks(offset) >= XTIMER_LP_THRESHOLD) {
+        _xtimer_lp_set(timer, offset);
+        return;
+    }
+#endif
+
+    if (offset < BACKOFF) {
         _xtimer_spin(offset);
         _shoot(timer);
     }
@@ -146,14 +280,81 @@ void _xtimer_set(xtimer_t *timer, uint32_t offset)
     }
 }
 
-static void _periph_timer_callback(void *arg, int chan)
+/* finds a timer of the current period due within slack ticks after target.
+ * Timers of later periods are never found, as the candidates lie before. */
+static xtimer_t *_coalesce_with(uint32_t target, uint32_t slack)
+{
+#ifdef MODULE_XTIMER_HEAP
+    /* only the next timer can be found without walking the heap */
+    xtimer_t *timer = timer_list_head;
+
+    if (timer && ((timer->target - target) <= slack)) {
+        return timer;
+    }
+#else
+    for (xtimer_t *timer = timer_list_head; timer; timer = timer->next) {
+        if ((timer->target - target) <= slack) {
+            return timer;
+        }
+    }
+#endif
+    return NULL;
+}
+
+void _xtimer_set_slack(xtimer_t *timer, uint32_t offset, uint32_t slack)
+{
+    xtimer_t *other;
+
+    if (!timer->callback) {
+        DEBUG("timer_set_slack(): timer has no callback.\n");
+        return;
+    }
+    if ((slack == 0) || (offset < BACKOFF)) {
+        _xtimer_set(timer, offset);
+        return;
+    }
+#ifdef MODULE_XTIMER_LP
+    if (_xtimer_usec_from_ticks(offset) >= XTIMER_LP_THRESHOLD) {
+        _xtimer_set(timer, offset);
+        return;
+    }
+#endif
+
+    xtimer_remove(timer);
+
+    unsigned state = irq_disable();
+    uint32_t target = _xtimer_now() + offset;
+
+    if ((other = _coalesce_with(target, slack)) != NULL) {
+        DEBUG("timer_set_slack(): expire with timer at %" PRIu32 "\n",
+              other->target);
+        target = other->target;
+        _stats.coalesced++;
+    }
+    _xtimer_set_absolute(timer, target);
+    irq_restore(state);
+}
+
+const xtimer_stats_t *xtimer_get_stats(void)
+{
+    return &_stats;
+}
+
+static void RAMFUNC _periph_timer_callback(void *arg, int chan)
 {
     (void)arg;
+#ifdef MODULE_XTIMER_HARD
+    if (chan != XTIMER_CHAN) {
+        _xtimer_hard_callback(chan);
+        return;
+    }
+#else
     (void)chan;
+#endif
     _timer_callback();
 }
 
-static void _shoot(xtimer_t *timer)
+static void RAMFUNC _shoot(xtimer_t *timer)
 {
     timer->callback(timer->arg);
 }
@@ -174,10 +375,9 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
 
     DEBUG("timer_set_absolute(): now=%" PRIu32 " target=%" PRIu32 "\n", now, target);
 
-    timer->next = NULL;
-    if ((target >= now) && ((target - XTIMER_BACKOFF) < now)) {
+    if ((target >= now) && ((target - BACKOFF) < now)) {
         /* backoff */
-        xtimer_spin_until(target + XTIMER_BACKOFF);
+        xtimer_spin_until(target + BACKOFF);
         _shoot(timer);
         return 0;
     }
@@ -208,7 +408,7 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
 
             if (timer_list_head == timer) {
                 DEBUG("timer_set_absolute(): timer is new list head. updating lltimer.\n");
-                _lltimer_set(target - XTIMER_OVERHEAD);
+                _lltimer_set(target - OVERHEAD);
             }
         }
     }
@@ -218,6 +418,142 @@ int _xtimer_set_absolute(xtimer_t *timer, uint32_t target)
     return res;
 }
 
+#ifdef MODULE_XTIMER_HEAP
+/*
+ * The lists are pairing heaps: a timer's next field links it to its next
+ * sibling, child points to its first child and prev to the previous sibling,
+ * or to the parent for a first child. A timer with prev == NULL is the root
+ * of a heap.
+ *
+ * All heaps use the order of the long list. The timers of the current and
+ * the overflow list share their long_target, so for them it is the order of
+ * the short lists. This way a timer can be removed without knowing its heap.
+ */
+static inline int _before(xtimer_t *a, xtimer_t *b)
+{
+    if (a->long_target != b->long_target) {
+        return a->long_target < b->long_target;
+    }
+    return a->target < b->target;
+}
+
+static xtimer_t *_meld(xtimer_t *a, xtimer_t *b)
+{
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+    if (_before(b, a)) {
+        xtimer_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    /* b becomes the first child of a */
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    a->next = NULL;
+    a->prev = NULL;
+    return a;
+}
+
+/* two-pass pairing of the siblings starting at first */
+static xtimer_t *_merge_pairs(xtimer_t *first)
+{
+    xtimer_t *pairs = NULL, *res = NULL;
+
+    while (first) {
+        xtimer_t *a = first, *b = first->next;
+
+        first = b ? b->next : NULL;
+        a->next = NULL;
+        if (b) {
+            b->next = NULL;
+        }
+        a = _meld(a, b);
+        /* stack the pairs up, so the second pass runs right to left */
+        a->next = pairs;
+        pairs = a;
+    }
+    while (pairs) {
+        xtimer_t *next = pairs->next;
+
+        pairs->next = NULL;
+        res = _meld(pairs, res);
+        pairs = next;
+    }
+    if (res) {
+        res->prev = NULL;
+    }
+    return res;
+}
+
+static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    timer->next = NULL;
+    timer->prev = NULL;
+    timer->child = NULL;
+    *list_head = _meld(*list_head, timer);
+}
+
+static void _add_timer_to_long_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    _add_timer_to_list(list_head, timer);
+}
+
+static RAMFUNC xtimer_t *_pop_timer(xtimer_t **list_head)
+{
+    xtimer_t *timer = *list_head;
+
+    *list_head = _merge_pairs(timer->child);
+    timer->child = NULL;
+    return timer;
+}
+
+static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
+{
+    xtimer_t *repl;
+
+    if (*list_head == timer) {
+        _pop_timer(list_head);
+        return 1;
+    }
+    if (!timer->prev) {
+        /* root of another heap (or of none at all) */
+        return 0;
+    }
+    /* the children are not before the timer, so their merged heap can take
+     * its place without knowing which heap the timer belongs to */
+    repl = _merge_pairs(timer->child);
+    if (repl) {
+        repl->next = timer->next;
+        if (timer->next) {
+            timer->next->prev = repl;
+        }
+    }
+    else {
+        repl = timer->next;
+    }
+    if (timer->prev->child == timer) {
+        timer->prev->child = repl;
+    }
+    else {
+        timer->prev->next = repl;
+    }
+    if (repl) {
+        repl->prev = timer->prev;
+    }
+    timer->next = NULL;
+    timer->prev = NULL;
+    timer->child = NULL;
+    return 1;
+}
+#else
 static void _add_timer_to_list(xtimer_t **list_head, xtimer_t *timer)
 {
     while (*list_head && (*list_head)->target <= timer->target) {
@@ -253,14 +589,23 @@ static int _remove_timer_from_list(xtimer_t **list_head, xtimer_t *timer)
     return 0;
 }
 
+static RAMFUNC xtimer_t *_pop_timer(xtimer_t **list_head)
+{
+    xtimer_t *timer = *list_head;
+
+    *list_head = timer->next;
+    return timer;
+}
+#endif
+
 static void _remove(xtimer_t *timer)
 {
     if (timer_list_head == timer) {
         uint32_t next;
-        timer_list_head = timer->next;
+        _pop_timer(&timer_list_head);
         if (timer_list_head) {
             /* schedule callback on next timer target time */
-            next = timer_list_head->target - XTIMER_OVERHEAD;
+            next = timer_list_head->target - OVERHEAD;
         }
         else {
             next = _xtimer_lltimer_mask(0xFFFFFFFF);
@@ -270,7 +615,11 @@ static void _remove(xtimer_t *timer)
     else {
         if (!_remove_timer_from_list(&timer_list_head, timer)) {
             if (!_remove_timer_from_list(&overflow_list_head, timer)) {
-                _remove_timer_from_list(&long_list_head, timer);
+                if (!_remove_timer_from_list(&long_list_head, timer)) {
+#ifdef MODULE_XTIMER_LP
+                    _xtimer_lp_remove(timer);
+#endif
+                }
             }
         }
     }
@@ -285,6 +634,26 @@ void xtimer_remove(xtimer_t *timer)
     irq_restore(state);
 }
 
+int xtimer_next_event(uint32_t *ticks)
+{
+    int res;
+    unsigned state = irq_disable();
+    uint32_t now = _xtimer_lltimer_now();
+
+    if (timer_list_head) {
+        uint32_t target = _xtimer_lltimer_mask(timer_list_head->target);
+        *ticks = (target > now) ? (target - now) : 0;
+        res = 1;
+    }
+    else {
+        *ticks = _xtimer_lltimer_mask(0xFFFFFFFF) - now;
+        res = 0;
+    }
+
+    irq_restore(state);
+    return res;
+}
+
 static uint32_t _time_left(uint32_t target, uint32_t reference)
 {
     uint32_t now = _xtimer_lltimer_now();
@@ -310,6 +679,19 @@ static inline int _this_high_period(uint32_t target) {
 #endif
 }
 
+#ifdef MODULE_XTIMER_HEAP
+/**
+ * @brief move the long timers that expire in the current short timer period
+ *        to the current timer list
+ */
+static void _select_long_timers(void)
+{
+    while (long_list_head && (long_list_head->long_target <= _long_cnt) &&
+           _this_high_period(long_list_head->target)) {
+        _add_timer_to_list(&timer_list_head, _pop_timer(&long_list_head));
+    }
+}
+#else
 /**
  * @brief compare two timers' target values, return the one with lower value.
  *
@@ -399,11 +781,12 @@ static void _select_long_timers(void)
         }
     }
 }
+#endif
 
 /**
  * @brief handle low-level timer overflow, advance to next short timer period
  */
-static void _next_period(void)
+static void RAMFUNC _next_period(void)
 {
 #if XTIMER_MASK
     /* advance <32bit mask register */
@@ -416,6 +799,7 @@ static void _next_period(void)
     /* advance >32bit counter */
     _long_cnt++;
 #endif
+    _publish_period();
 
     /* swap overflow list to current timer list */
     timer_list_head = overflow_list_head;
@@ -427,12 +811,13 @@ static void _next_period(void)
 /**
  * @brief main xtimer callback function
  */
-static void _timer_callback(void)
+static void RAMFUNC _timer_callback(void)
 {
     uint32_t next_target;
     uint32_t reference;
 
     _in_handler = 1;
+    _stats.wakeups++;
 
     DEBUG("_timer_callback() now=%" PRIu32 " (%" PRIu32 ")pleft=%" PRIu32 "\n", xtimer_now(),
             _xtimer_lltimer_mask(xtimer_now()), _xtimer_lltimer_mask(0xffffffff - xtimer_now()));
@@ -442,15 +827,15 @@ static void _timer_callback(void)
         /* there's no timer for this timer period,
          * so this was a timer overflow callback.
          *
-         * In this case, we advance to the next timer period.
+         * In this case, we advance to the next timer period, once the timer
+         * counter also arrived there. Otherwise the time read in between
+         * would already be a period ahead.
          */
+        while (_xtimer_lltimer_now() == _xtimer_lltimer_mask(0xFFFFFFFF));
+
         _next_period();
 
         reference = 0;
-
-        /* make sure the timer counter also arrived
-         * in the next timer period */
-        while (_xtimer_lltimer_now() == _xtimer_lltimer_mask(0xFFFFFFFF));
     }
     else {
         /* we ended up in _timer_callback and there is
@@ -462,7 +847,7 @@ static void _timer_callback(void)
 
 overflow:
     /* check if next timers are close to expiring */
-    while (timer_list_head && (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference) < XTIMER_ISR_BACKOFF)) {
+    while (timer_list_head && (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference) < ISR_BACKOFF)) {
         /* make sure we don't fire too early */
         while (_time_left(_xtimer_lltimer_mask(timer_list_head->target), reference));
 
@@ -470,13 +855,14 @@ overflow:
         xtimer_t *timer = timer_list_head;
 
         /* advance list */
-        timer_list_head = timer->next;
+        _pop_timer(&timer_list_head);
 
         /* make sure timer is recognized as being already fired */
         timer->target = 0;
         timer->long_target = 0;
 
         /* fire timer */
+        _stats.fired++;
         _shoot(timer);
     }
 
@@ -493,10 +879,10 @@ overflow:
 
     if (timer_list_head) {
         /* schedule callback on next timer target time */
-        next_target = timer_list_head->target - XTIMER_OVERHEAD;
+        next_target = timer_list_head->target - OVERHEAD;
 
         /* make sure we're not setting a time in the past */
-        if (next_target < (_xtimer_lltimer_now() + XTIMER_ISR_BACKOFF)) {
+        if (next_target < (_xtimer_lltimer_now() + ISR_BACKOFF)) {
             goto overflow;
         }
     }
@@ -514,7 +900,7 @@ overflow:
         }
         else {
             /* check if the end of this period is very soon */
-            if (_xtimer_lltimer_mask(now + XTIMER_ISR_BACKOFF) < now) {
+            if (_xtimer_lltimer_mask(now + ISR_BACKOFF) < now) {
                 /* spin until next period, then advance */
                 while (_xtimer_lltimer_now() >= now);
                 _next_period();
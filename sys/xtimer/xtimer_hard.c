@@ -0,0 +1,108 @@
+/**
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup xtimer
+ * @{
+ * @file
+ * @brief xtimer hard timers on dedicated low-level timer channels
+ * @}
+ */
+
+#ifdef MODULE_XTIMER_HARD
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "irq.h"
+#include "periph/timer.h"
+#include "xtimer.h"
+
+#if XTIMER_HARD_CHAN <= XTIMER_CHAN
+#error "XTIMER_HARD_CHAN must come after XTIMER_CHAN"
+#endif
+
+typedef struct {
+    xtimer_callback_t callback;
+    void *arg;
+} _hard_t;
+
+static _hard_t _hard[XTIMER_HARD_NUMOF];
+
+static inline int _reserved(unsigned idx)
+{
+    return (idx < XTIMER_HARD_NUMOF) && (_hard[idx].callback != NULL);
+}
+
+void _xtimer_hard_callback(int chan)
+{
+    unsigned idx = (unsigned)(chan - XTIMER_HARD_CHAN);
+
+    if (_reserved(idx)) {
+        _hard[idx].callback(_hard[idx].arg);
+    }
+}
+
+int xtimer_hard_init(unsigned idx, xtimer_callback_t callback, void *arg)
+{
+    int res = 0;
+
+    if ((idx >= XTIMER_HARD_NUMOF) || (callback == NULL)) {
+        return -EINVAL;
+    }
+    unsigned state = irq_disable();
+    if (_hard[idx].callback) {
+        res = -EBUSY;
+    }
+    else {
+        _hard[idx].callback = callback;
+        _hard[idx].arg = arg;
+    }
+    irq_restore(state);
+    return res;
+}
+
+void xtimer_hard_release(unsigned idx)
+{
+    if (_reserved(idx)) {
+        unsigned state = irq_disable();
+        timer_clear(XTIMER_DEV, XTIMER_HARD_CHAN + idx);
+        _hard[idx].callback = NULL;
+        irq_restore(state);
+    }
+}
+
+int xtimer_hard_set_absolute(unsigned idx, xtimer_ticks32_t target)
+{
+    if (!_reserved(idx)) {
+        return -EINVAL;
+    }
+    timer_set_absolute(XTIMER_DEV, XTIMER_HARD_CHAN + idx,
+                       _xtimer_lltimer_mask(target.ticks32));
+    return 0;
+}
+
+int xtimer_hard_set(unsigned idx, uint32_t offset)
+{
+    uint32_t ticks = _xtimer_ticks_from_usec(offset);
+
+    if (_xtimer_lltimer_mask(ticks) != ticks) {
+        return -EINVAL;
+    }
+    return xtimer_hard_set_absolute(idx,
+                                    xtimer_ticks(_xtimer_lltimer_now() + ticks));
+}
+
+void xtimer_hard_clear(unsigned idx)
+{
+    if (_reserved(idx)) {
+        timer_clear(XTIMER_DEV, XTIMER_HARD_CHAN + idx);
+    }
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_XTIMER_HARD */
@@ -0,0 +1,165 @@
+/**
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ * @ingroup xtimer
+ * @{
+ * @file
+ * @brief xtimer timers with long deadlines on the real time timer
+ * @}
+ */
+
+#ifdef MODULE_XTIMER_LP
+
+#include <stdint.h>
+
+#include "irq.h"
+#include "periph/rtt.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+/* the alarm is never set further ahead, so the ticks elapsed since _base can
+ * always be told from the wrapping counter */
+#define LP_ALARM_MAX    ((RTT_MAX_VALUE >> 1) + 1)
+/* alarms closer than this might be missed while being set */
+#define LP_ALARM_MIN    (2U)
+
+/* timers sorted by the ticks between _base and their expiry. The ticks are
+ * kept in xtimer_t::long_target and xtimer_t::target, which are never both
+ * 0 for a pending timer. */
+static xtimer_t *_list;
+static uint32_t _base;
+
+static inline uint64_t _get_ticks(xtimer_t *timer)
+{
+    return ((uint64_t)timer->long_target << 32) | timer->target;
+}
+
+static inline void _set_ticks(xtimer_t *timer, uint64_t ticks)
+{
+    timer->target = (uint32_t)ticks;
+    timer->long_target = (uint32_t)(ticks >> 32);
+}
+
+static inline uint32_t _elapsed(uint32_t now)
+{
+    return (now - _base) & RTT_MAX_VALUE;
+}
+
+static void _alarm_cb(void *arg);
+
+/* must be called with interrupts disabled */
+static void _set_alarm(uint32_t now)
+{
+    uint64_t left;
+
+    if (!_list) {
+        rtt_clear_alarm();
+        return;
+    }
+    left = _get_ticks(_list) - _elapsed(now);
+    if (_get_ticks(_list) < (_elapsed(now) + LP_ALARM_MIN)) {
+        left = LP_ALARM_MIN;
+    }
+    else if (left > LP_ALARM_MAX) {
+        left = LP_ALARM_MAX;
+    }
+    rtt_set_alarm((now + (uint32_t)left) & RTT_MAX_VALUE, _alarm_cb, NULL);
+}
+
+static void _alarm_cb(void *arg)
+{
+    (void)arg;
+
+    unsigned state = irq_disable();
+    uint32_t now = rtt_get_counter();
+    uint32_t elapsed = _elapsed(now);
+
+    while (_list && (_get_ticks(_list) <= elapsed)) {
+        xtimer_t *timer = _list;
+
+        _list = timer->next;
+        timer->target = timer->long_target = 0;
+        irq_restore(state);
+        timer->callback(timer->arg);
+        state = irq_disable();
+    }
+    /* move _base to now, so it never falls a full counter period behind.
+     * Timers set by the callbacks are relative to the old _base as well. */
+    for (xtimer_t *timer = _list; timer; timer = timer->next) {
+        _set_ticks(timer, _get_ticks(timer) - elapsed);
+    }
+    _base = now;
+    _set_alarm(rtt_get_counter());
+    irq_restore(state);
+}
+
+void _xtimer_lp_init(void)
+{
+    rtt_init();
+}
+
+void _xtimer_lp_set(xtimer_t *timer, uint64_t offset)
+{
+    xtimer_t **pos = &_list;
+    uint64_t ticks;
+
+    /* round up, a timer must not expire early */
+    ticks = ((_xtimer_usec_from_ticks64(offset) * RTT_FREQUENCY) + SEC_IN_USEC - 1) /
+            SEC_IN_USEC;
+
+    unsigned state = irq_disable();
+    uint32_t now = rtt_get_counter();
+
+    if (!_list) {
+        _base = now;
+    }
+    ticks += _elapsed(now);
+    DEBUG("xtimer_lp_set(): %" PRIu32 " ticks after %" PRIu32 "\n",
+          (uint32_t)ticks, _base);
+
+#ifdef MODULE_XTIMER_HEAP
+    timer->prev = NULL;
+    timer->child = NULL;
+#endif
+    _set_ticks(timer, ticks);
+    while (*pos && (_get_ticks(*pos) <= ticks)) {
+        pos = &((*pos)->next);
+    }
+    timer->next = *pos;
+    *pos = timer;
+    if (_list == timer) {
+        _set_alarm(now);
+    }
+    irq_restore(state);
+}
+
+int _xtimer_lp_remove(xtimer_t *timer)
+{
+    xtimer_t **pos = &_list;
+    int res = 0;
+
+    unsigned state = irq_disable();
+    while (*pos) {
+        if (*pos == timer) {
+            *pos = timer->next;
+            if (pos == &_list) {
+                _set_alarm(rtt_get_counter());
+            }
+            res = 1;
+            break;
+        }
+        pos = &((*pos)->next);
+    }
+    irq_restore(state);
+    return res;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_XTIMER_LP */
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the throughput of base64_encode() and base64_decode()
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "base64.h"
+#include "xtimer.h"
+
+#define RUNS_NUMOF      (100U)
+/* a chunk of a firmware image or certificate */
+#define DATA_LEN        (1026U)
+
+static unsigned char _data[DATA_LEN];
+static unsigned char _base64[BASE64_ENCODED_LEN(DATA_LEN)];
+
+static void _print(const char *name, size_t len, uint32_t us)
+{
+    printf("%-6s | %5u | %8lu | %8lu\n", name, (unsigned)len,
+           (unsigned long)(((uint64_t)us * 1000) / RUNS_NUMOF),
+           (us) ? (unsigned long)(((uint64_t)len * RUNS_NUMOF) / us) : 0UL);
+}
+
+int main(void)
+{
+    size_t size = 0;
+    uint32_t start;
+
+    for (unsigned i = 0; i < sizeof(_data); i++) {
+        _data[i] = (unsigned char)i;
+    }
+
+    puts("base64 benchmark");
+    puts("       | bytes |  ns/call | bytes/us");
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < RUNS_NUMOF; i++) {
+        size = sizeof(_base64);
+        base64_encode(_data, sizeof(_data), _base64, &size);
+    }
+    _print("encode", sizeof(_data), xtimer_now_usec() - start);
+    if (size != sizeof(_base64)) {
+        puts("encoding failed");
+        return 1;
+    }
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < RUNS_NUMOF; i++) {
+        size = sizeof(_data);
+        base64_decode(_base64, sizeof(_base64), _data, &size);
+    }
+    _print("decode", sizeof(_base64), xtimer_now_usec() - start);
+    if (size != sizeof(_data)) {
+        puts("decoding failed");
+        return 1;
+    }
+
+    puts("Test done");
+    return 0;
+}
@@ -25,6 +25,7 @@
 #include "xtimer.h"
 
 #include "hashes.h"
+#include "hashes/siphash.h"
 #include "bloom.h"
 #include "random.h"
 #include "bitfield.h"
@@ -49,6 +50,8 @@ hashfp_t hashes[BLOOM_HASHF] = {
     (hashfp_t) rotating_hash, (hashfp_t) one_at_a_time_hash,
 };
 
+#define HASH_RUNS (1000)
+
 static void buf_fill(uint32_t *buf, int len)
 {
     for (int k = 0; k < len; k++) {
@@ -56,15 +59,97 @@ static void buf_fill(uint32_t *buf, int len)
     }
 }
 
-int main(void)
+static uint32_t fnv1a_64_fold(const uint8_t *data, size_t len)
 {
-    xtimer_init();
+    return (uint32_t)fnv1a_64_hash(data, len);
+}
 
-    bloom_init(&bloom, BLOOM_BITS, bf, hashes, BLOOM_HASHF);
+static uint32_t siphash24_fold(const uint8_t *data, size_t len)
+{
+    static const uint8_t key[SIPHASH_KEY_LENGTH] = { 0 };
 
-    printf("Testing Bloom filter.\n\n");
-    printf("m: %" PRIu32 " k: %" PRIu32 "\n\n", (uint32_t) bloom.m,
-           (uint32_t) bloom.k);
+    return (uint32_t)siphash24(key, data, len);
+}
+
+static const struct {
+    const char *name;
+    uint32_t (*hash)(const uint8_t *, size_t);
+} throughput[] = {
+    { "djb2", djb2_hash },
+    { "sdbm", sdbm_hash },
+    { "one_at_a_time", one_at_a_time_hash },
+    { "fnv1a_32", fnv1a_32_hash },
+    { "fnv1a_64", fnv1a_64_fold },
+    { "siphash24", siphash24_fold },
+};
+
+static void hash_throughput(void)
+{
+    volatile uint32_t sink = 0;
+
+    buf_fill(buf, BUF_SIZE);
+    for (unsigned i = 0; i < sizeof(throughput) / sizeof(throughput[0]); i++) {
+        uint32_t start = xtimer_now_usec();
+
+        for (int j = 0; j < HASH_RUNS; j++) {
+            sink += throughput[i].hash((uint8_t *) buf, sizeof(buf));
+        }
+        uint32_t usec = xtimer_now_usec() - start;
+        printf("%-14s %" PRIu32 " bytes/ms\n", throughput[i].name,
+               (uint32_t)(((uint64_t)HASH_RUNS * sizeof(buf) * 1000) /
+                          (usec ? usec : 1)));
+    }
+    (void)sink;
+    printf("\n");
+}
+
+static bloom_blocked_t blocked;
+static uint8_t blocks[BLOOM_BITS / 8];
+static bloom_counting_t counting;
+static uint8_t counters[BLOOM_COUNTING_SIZE(BLOOM_BITS)];
+
+static void classic_add(const uint8_t *data, size_t len)
+{
+    bloom_add(&bloom, data, len);
+}
+
+static bool classic_check(const uint8_t *data, size_t len)
+{
+    return bloom_check(&bloom, data, len);
+}
+
+static void blocked_add(const uint8_t *data, size_t len)
+{
+    bloom_blocked_add(&blocked, data, len);
+}
+
+static bool blocked_check(const uint8_t *data, size_t len)
+{
+    return bloom_blocked_check(&blocked, data, len);
+}
+
+static void counting_add(const uint8_t *data, size_t len)
+{
+    bloom_counting_add(&counting, data, len);
+}
+
+static bool counting_check(const uint8_t *data, size_t len)
+{
+    return bloom_counting_check(&counting, data, len);
+}
+
+static void counting_remove(const uint8_t *data, size_t len)
+{
+    bloom_counting_remove(&counting, data, len);
+}
+
+/* feeds the same lenB elements to add and the same lenA elements to check
+ * for every variant */
+static void run(const char *name,
+                void (*add)(const uint8_t *, size_t),
+                bool (*check)(const uint8_t *, size_t))
+{
+    printf("%s Bloom filter:\n", name);
 
     random_init(myseed);
 
@@ -73,9 +158,7 @@ int main(void)
     for (int i = 0; i < lenB; i++) {
         buf_fill(buf, BUF_SIZE);
         buf[0] = MAGIC_B;
-        bloom_add(&bloom,
-                  (uint8_t *) buf,
-                  BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t));
+        add((uint8_t *) buf, BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t));
     }
 
     unsigned long t2 = xtimer_now_usec();
@@ -91,9 +174,8 @@ int main(void)
         buf_fill(buf, BUF_SIZE);
         buf[0] = MAGIC_A;
 
-        if (bloom_check(&bloom,
-                        (uint8_t *) buf,
-                        BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t))) {
+        if (check((uint8_t *) buf,
+                  BUF_SIZE * sizeof(uint32_t) / sizeof(uint8_t))) {
             in++;
         }
         else {
@@ -105,11 +187,48 @@ int main(void)
     printf("checking %d elements took %" PRIu32 "ms\n", lenA,
            (uint32_t) (t4 - t3) / 1000);
 
-    printf("\n");
     printf("%d elements probably in the filter.\n", in);
     printf("%d elements not in the filter.\n", not_in);
     double false_positive_rate = (double) in / (double) lenA;
-    printf("%f false positive rate.\n", false_positive_rate);
+    printf("%f false positive rate.\n\n", false_positive_rate);
+}
+
+int main(void)
+{
+    xtimer_init();
+
+    bloom_init(&bloom, BLOOM_BITS, bf, hashes, BLOOM_HASHF);
+    bloom_blocked_init(&blocked, blocks, sizeof(blocks) / BLOOM_BLOCK_SIZE,
+                       BLOOM_HASHF);
+    bloom_counting_init(&counting, counters, BLOOM_BITS, BLOOM_HASHF);
+
+    printf("Testing Bloom filter.\n\n");
+    printf("m: %" PRIu32 " k: %" PRIu32 "\n\n", (uint32_t) bloom.m,
+           (uint32_t) bloom.k);
+
+    hash_throughput();
+
+    run("classic", classic_add, classic_check);
+    run("blocked", blocked_add, blocked_check);
+    run("counting", counting_add, counting_check);
+
+    /* removing every element again must empty the counting filter */
+    random_init(myseed);
+    unsigned long t1 = xtimer_now_usec();
+    for (int i = 0; i < lenB; i++) {
+        buf_fill(buf, BUF_SIZE);
+        buf[0] = MAGIC_B;
+        counting_remove((uint8_t *) buf, sizeof(buf));
+    }
+    unsigned long t2 = xtimer_now_usec();
+    printf("removing %d elements took %" PRIu32 "ms\n", lenB,
+           (uint32_t) (t2 - t1) / 1000);
+
+    int left = 0;
+    for (unsigned i = 0; i < sizeof(counters); i++) {
+        left += (counters[i] != 0);
+    }
+    printf("%d counter bytes left non-zero.\n", left);
 
     bloom_del(&bloom);
     printf("\nAll done!\n");
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the Interest/Data throughput of CCN-Lite versus the
+ *              size of the content store
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sched.h"
+#include "xtimer.h"
+#include "net/gnrc/netreg.h"
+#include "ccn-lite-riot.h"
+#include "ccnl-pkt-ndntlv.h"
+
+#define BUF_SIZE        (64)
+#define NAME_LEN        (16)
+#define TEST_RUNS       (1000U)
+
+static const unsigned _sizes[] = { 1, 4, 16, 64 };
+
+static unsigned char _int_buf[BUF_SIZE];
+static unsigned char _cont_buf[BUF_SIZE];
+static unsigned char _out[CCNL_MAX_PACKET_SIZE];
+
+static int _add_content(char *name)
+{
+    static const char body[] = "Start the RIOT!";
+    int offs = CCNL_MAX_PACKET_SIZE;
+    int arg_len, len;
+    unsigned typ;
+    unsigned char *data;
+    struct ccnl_prefix_s *prefix;
+    struct ccnl_pkt_s *pk;
+    struct ccnl_content_s *c;
+
+    prefix = ccnl_URItoPrefix(name, CCNL_SUITE_NDNTLV, NULL, NULL);
+    if (prefix == NULL) {
+        return -1;
+    }
+    arg_len = ccnl_ndntlv_prependContent(prefix, (unsigned char *)body,
+                                         sizeof(body), NULL, NULL, &offs,
+                                         _out);
+    free_prefix(prefix);
+    data = _out + offs;
+    if (ccnl_ndntlv_dehead(&data, &arg_len, (int *)&typ, &len) ||
+        typ != NDN_TLV_Data) {
+        return -1;
+    }
+    pk = ccnl_ndntlv_bytes2pkt(typ, _out + offs, &data, &arg_len);
+    c = ccnl_content_new(&ccnl_relay, &pk);
+    if (c == NULL) {
+        return -1;
+    }
+    ccnl_content_add2cache(&ccnl_relay, c);
+    return 0;
+}
+
+static void _bench(unsigned size)
+{
+    char name[NAME_LEN];
+    uint32_t start, time;
+    const ccnl_pool_stats_t *stats = ccnl_pool_stats();
+    uint32_t pool_allocs, heap_allocs;
+
+    while (ccnl_relay.contents != NULL) {
+        ccnl_content_remove(&ccnl_relay, ccnl_relay.contents);
+    }
+    ccnl_relay.max_cache_entries = size;
+    for (unsigned i = 0; i < size; i++) {
+        snprintf(name, sizeof(name), "/bench/%u", i);
+        if (_add_content(name) < 0) {
+            printf("CS size %2u: adding %s failed\n", size, name);
+            return;
+        }
+    }
+
+    pool_allocs = stats->pool_allocs;
+    heap_allocs = stats->heap_allocs;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        struct ccnl_prefix_s *prefix;
+
+        snprintf(name, sizeof(name), "/bench/%u", i % size);
+        prefix = ccnl_URItoPrefix(name, CCNL_SUITE_NDNTLV, NULL, 0);
+        if ((ccnl_send_interest(prefix, _int_buf, BUF_SIZE) == NULL) ||
+            (ccnl_wait_for_chunk(_cont_buf, BUF_SIZE, 0) < 0)) {
+            ccnl_free(prefix);
+            printf("CS size %2u: no content for %s\n", size, name);
+            return;
+        }
+    }
+    time = xtimer_now_usec() - start;
+
+    printf("CS size %2u: %4u Interests/s, pool: %4u allocs, %2u from heap, "
+           "%2u blocks max\n", size,
+           (unsigned)(((uint64_t)TEST_RUNS * SEC_IN_USEC) / time),
+           (unsigned)(stats->pool_allocs - pool_allocs),
+           (unsigned)(stats->heap_allocs - heap_allocs),
+           (unsigned)stats->max_used);
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t ne =
+        GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                   sched_active_pid);
+
+    ccnl_start();
+    /* register for content chunks */
+    gnrc_netreg_register(GNRC_NETTYPE_CCN_CHUNK, &ne);
+
+    printf("%u Interests per content store size\n", TEST_RUNS);
+    for (unsigned i = 0; i < sizeof(_sizes) / sizeof(_sizes[0]); i++) {
+        _bench(_sizes[i]);
+    }
+
+    gnrc_netreg_unregister(GNRC_NETTYPE_CCN_CHUNK, &ne);
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the throughput of the checksum functions
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "checksum/crc32.h"
+#include "checksum/fletcher16.h"
+#include "checksum/fletcher32.h"
+#include "checksum/ucrc16.h"
+#include "xtimer.h"
+
+#define RUNS_NUMOF      (100U)
+/* an IPv6 MTU worth of data */
+#define BUF_LEN         (1280U)
+
+/* fletcher32() takes 16 bit words */
+static uint16_t _words[BUF_LEN / 2];
+static uint8_t *const _buf = (uint8_t *)_words;
+static uint32_t _start;
+
+static void _begin(void)
+{
+    _start = xtimer_now_usec();
+}
+
+static void _end(const char *name)
+{
+    uint32_t us = xtimer_now_usec() - _start;
+
+    printf("%-11s | %8lu | %8lu\n", name,
+           (unsigned long)(((uint64_t)us * 1000) / RUNS_NUMOF),
+           (us) ? (unsigned long)(((uint64_t)BUF_LEN * RUNS_NUMOF) / us) : 0UL);
+}
+
+int main(void)
+{
+    uint32_t res = 0;
+
+    for (unsigned i = 0; i < BUF_LEN; i++) {
+        _buf[i] = (uint8_t)i;
+    }
+
+    puts("checksum benchmark");
+    printf("%u bytes per call\n", BUF_LEN);
+    puts("function    |  ns/call | bytes/us");
+
+    _begin();
+    for (unsigned i = 0; i < RUNS_NUMOF; i++) {
+        res += crc16_ccitt_calc(_buf, BUF_LEN);
+    }
+    _end("crc16_ccitt");
+
+    _begin();
+    for (unsigned i = 0; i < RUNS_NUMOF; i++) {
+        res += ucrc16_calc_be(_buf, BUF_LEN, UCRC16_CCITT_POLY_BE, 0x1d0f);
+    }
+    _end("ucrc16");
+
+    _begin();
+    for (unsigned i = 0; i < RUNS_NUMOF; i++) {
+        res += crc32_calc(_buf, BUF_LEN);
+    }
+    _end("crc32");
+
+    _begin();
+    for (unsigned i = 0; i < RUNS_NUMOF; i++) {
+        res += fletcher16(_buf, BUF_LEN);
+    }
+    _end("fletcher16");
+
+    _begin();
+    for (unsigned i = 0; i < RUNS_NUMOF; i++) {
+        res += fletcher32(_words, BUF_LEN / 2);
+    }
+    _end("fletcher32");
+
+    /* keeps the loops from being optimized out */
+    printf("sum: 0x%08lx\n", (unsigned long)res);
+
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the AES-128 throughput of the software implementation
+ *              and of the backend picked by cipher_init(), and AES-CCM
+ *              with ChaCha20-Poly1305
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "crypto/aes.h"
+#include "crypto/chacha20poly1305.h"
+#include "crypto/ciphers.h"
+#include "crypto/modes/ccm.h"
+#include "crypto/modes/ctr.h"
+#include "crypto/modes/ecb.h"
+#include "periph_conf.h"
+#include "xtimer.h"
+
+#define TEST_LEN        (256U)
+#define TEST_RUNS       (100U)
+#define TEST_FRAME_LEN  (127U)
+#define TEST_MAC_LEN    (8U)
+
+/* native has no core clock, report nanoseconds per byte there */
+#ifndef CLOCK_CORECLOCK
+#define CLOCK_CORECLOCK (1000000000U)
+#endif
+
+static const uint8_t _key[AES_KEY_SIZE] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+static uint8_t _in[TEST_LEN];
+static uint8_t _out[2][TEST_LEN + CHACHA20POLY1305_TAG_SIZE];
+
+/* prints the cycles per byte with one decimal place */
+static void _print(const char *name, uint32_t usec, size_t len)
+{
+    uint64_t cycles = ((uint64_t)usec * (CLOCK_CORECLOCK / 1000000U) * 10U) /
+                      ((uint64_t)len * TEST_RUNS);
+
+    printf("%-10s %5u bytes: %5u.%u cycles/byte\n", name, (unsigned)len,
+           (unsigned)(cycles / 10), (unsigned)(cycles % 10));
+}
+
+static uint32_t _ecb(cipher_t *cipher, size_t len, uint8_t *out)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        cipher_encrypt_ecb(cipher, _in, len, out);
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _ctr(cipher_t *cipher, size_t len, uint8_t *out)
+{
+    uint8_t nonce_counter[16] = { 0 };
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        cipher_encrypt_ctr(cipher, nonce_counter, 8, _in, len, out);
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _ccm(cipher_t *cipher, size_t len, uint8_t *out)
+{
+    uint8_t nonce[13] = { 0 };
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        cipher_encrypt_ccm(cipher, NULL, 0, TEST_MAC_LEN, 2, nonce,
+                           sizeof(nonce), _in, len, out);
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _chacha20poly1305(size_t len, uint8_t *out)
+{
+    uint8_t key[CHACHA20POLY1305_KEY_SIZE] = { 0 };
+    uint8_t nonce[CHACHA20POLY1305_NONCE_SIZE] = { 0 };
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        chacha20poly1305_encrypt(key, nonce, NULL, 0, _in, len, out);
+    }
+    return xtimer_now_usec() - start;
+}
+
+static void _run(cipher_t *sw, cipher_t *hw, const char *mode, size_t len,
+                 uint32_t (*bench)(cipher_t *, size_t, uint8_t *))
+{
+    char name[12];
+
+    snprintf(name, sizeof(name), "%s sw", mode);
+    _print(name, bench(sw, len, _out[0]), len);
+    snprintf(name, sizeof(name), "%s hw", mode);
+    _print(name, bench(hw, len, _out[1]), len);
+    if (memcmp(_out[0], _out[1], len) != 0) {
+        printf("%s: results differ\n", mode);
+    }
+}
+
+int main(void)
+{
+    cipher_t sw, hw;
+
+    for (unsigned i = 0; i < TEST_LEN; i++) {
+        _in[i] = (uint8_t)i;
+    }
+
+    /* bypass the backends for the reference */
+    sw.interface = CIPHER_AES_128;
+    if ((sw.interface->init(&sw.context, _key, sizeof(_key)) != CIPHER_INIT_SUCCESS) ||
+        (cipher_init(&hw, CIPHER_AES_128, _key, sizeof(_key)) != CIPHER_INIT_SUCCESS)) {
+        puts("cipher initialization failed, is CRYPTO_AES defined?");
+        return 1;
+    }
+    printf("backend: %s\n", (hw.interface == CIPHER_AES_128) ?
+           "software (no hardware backend)" : "hardware");
+
+    _run(&sw, &hw, "ecb", AES_BLOCK_SIZE, _ecb);
+    _run(&sw, &hw, "ecb", TEST_LEN, _ecb);
+    _run(&sw, &hw, "ctr", AES_BLOCK_SIZE, _ctr);
+    _run(&sw, &hw, "ctr", TEST_LEN, _ctr);
+    _run(&sw, &hw, "ccm", TEST_FRAME_LEN, _ccm);
+    _print("chachapoly", _chacha20poly1305(TEST_FRAME_LEN, _out[0]),
+           TEST_FRAME_LEN);
+
+    puts("Test done");
+    return 0;
+}
@@ -31,6 +31,22 @@
 using namespace std;
 using namespace riot;
 
+namespace {
+
+unsigned schedules() {
+#ifdef MODULE_SCHEDSTATISTICS
+  unsigned res = 0;
+  for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; ++pid) {
+    res += sched_pidlist[pid].schedules;
+  }
+  return res;
+#else
+  return 0;
+#endif
+}
+
+} // namespace
+
 /* http://en.cppreference.com/w/cpp/thread/condition_variable */
 int main() {
   puts("\n************ C++ condition_variable test ***********");
@@ -123,6 +139,41 @@ int main() {
   }
   puts("Done\n");
 
+  puts("Ping-pong ...");
+  {
+    constexpr unsigned round_trips = 10000;
+    mutex m;
+    condition_variable cv;
+    bool ping = true;
+    unsigned switches = schedules();
+    uint32_t start = xtimer_now_usec();
+    thread pong([&] {
+      unique_lock<mutex> lk(m);
+      for (unsigned i = 0; i < round_trips; ++i) {
+        cv.wait(lk, [&ping] { return !ping; });
+        ping = true;
+        cv.notify_one();
+      }
+    });
+    {
+      unique_lock<mutex> lk(m);
+      for (unsigned i = 0; i < round_trips; ++i) {
+        ping = false;
+        cv.notify_one();
+        cv.wait(lk, [&ping] { return ping; });
+      }
+    }
+    pong.join();
+    uint32_t usec = xtimer_now_usec() - start;
+    switches = schedules() - switches;
+    printf("%u round trips: %lu ns and %u.%02u context switches per round "
+           "trip\n", round_trips,
+           (unsigned long)(((uint64_t)usec * 1000u) / round_trips),
+           (switches * 100u / round_trips) / 100u,
+           (switches * 100u / round_trips) % 100u);
+  }
+  puts("Done\n");
+
   puts("Bye, bye. ");
   puts("******************************************************\n");
 
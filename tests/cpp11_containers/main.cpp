@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test the allocation free containers and the memarray allocator
+ *
+ * @}
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <list>
+#include <map>
+#include <new>
+#include <stdexcept>
+
+#include "riot/memarray_allocator.hpp"
+#include "riot/static_vector.hpp"
+
+using namespace std;
+using namespace riot;
+
+namespace {
+
+constexpr unsigned pool_size = 4;
+
+/* large enough for the nodes of std::list and std::map on all platforms */
+uint8_t nodes[pool_size][8 * sizeof(void*)];
+memarray_t pool = MEMARRAY_INIT(nodes, 0);
+
+} // namespace
+
+int main() {
+  puts("\n************ C++ containers test ***********");
+
+  puts("static_vector ...");
+  {
+    static_vector<int, 4> vec;
+    for (int i = 0; i < 4; ++i) {
+      vec.push_back(i);
+    }
+    assert(vec.full() && vec.size() == 4);
+    bool thrown = false;
+    try {
+      vec.push_back(4);
+    } catch (length_error&) {
+      thrown = true;
+    }
+    assert(thrown);
+    int sum = 0;
+    for (int val : vec) {
+      sum += val;
+    }
+    assert(sum == 6);
+    vec.pop_back();
+    assert(vec.back() == 2);
+    static_vector<int, 4> copy = vec;
+    vec.clear();
+    assert(vec.empty() && copy.size() == 3 && copy[2] == 2);
+  }
+  puts("Done\n");
+
+  puts("static_ring ...");
+  {
+    static_ring<int, 3> ring;
+    for (int i = 0; i < 10; ++i) {
+      ring.push_back(i);
+      if (ring.full()) {
+        assert(ring.front() == i - 2);
+        ring.pop_front();
+      }
+    }
+    assert(ring.size() == 2 && ring[0] == 8 && ring.back() == 9);
+  }
+  puts("Done\n");
+
+  puts("memarray_allocator ...");
+  {
+    using alloc = memarray_allocator<pair<const int, int>>;
+    map<int, int, less<int>, alloc> m{less<int>(), alloc(pool)};
+    for (int i = 0; i < (int)pool_size; ++i) {
+      m[i] = i * i;
+    }
+    assert(memarray_available(&pool) == 0);
+    bool thrown = false;
+    try {
+      m[pool_size] = 0;
+    } catch (bad_alloc&) {
+      thrown = true;
+    }
+    assert(thrown && m.size() == pool_size && m[3] == 9);
+    m.clear();
+    assert(memarray_used(&pool) == 0);
+
+    list<int, memarray_allocator<int>> l{memarray_allocator<int>(pool)};
+    l.push_back(1);
+    l.push_back(2);
+    assert(memarray_used(&pool) == 2);
+  }
+  assert(memarray_used(&pool) == 0);
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("******************************************************\n");
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief test riot::thread_pool and compare its dispatch overhead with
+ *        creating a riot::thread per task
+ *
+ * @}
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+
+#include "xtimer.h"
+
+#include "riot/thread.hpp"
+#include "riot/thread_pool.hpp"
+
+using namespace std;
+using namespace riot;
+
+namespace {
+
+constexpr unsigned bench_tasks = 100;
+
+volatile unsigned counter;
+
+void work() { ++counter; }
+
+} // namespace
+
+int main() {
+  puts("\n************ C++ thread_pool test ***********");
+
+  // constructed here, the workers can't be created before the kernel runs
+  static thread_pool<2, 4> pool;
+
+  puts("Results and exceptions ...");
+  {
+    auto answer = make_pool_task([] { return 6 * 7; });
+    auto fail = make_pool_task([]() -> int { throw runtime_error("fail"); });
+    pool.submit(answer);
+    pool.submit(fail);
+    assert(answer.get() == 42);
+    bool thrown = false;
+    try {
+      fail.get();
+    } catch (runtime_error&) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+  puts("Done\n");
+
+  puts("Dispatch overhead ...");
+  {
+    counter = 0;
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < bench_tasks; ++i) {
+      auto task = make_pool_task(work);
+      pool.submit(task);
+      task.wait();
+    }
+    uint32_t pool_usec = xtimer_now_usec() - start;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < bench_tasks; ++i) {
+      thread t(work);
+      t.join();
+    }
+    uint32_t thread_usec = xtimer_now_usec() - start;
+
+    assert(counter == 2 * bench_tasks);
+    printf("thread_pool: %lu us per task\n",
+           (unsigned long)(pool_usec / bench_tasks));
+    printf("riot::thread: %lu us per task\n",
+           (unsigned long)(thread_usec / bench_tasks));
+  }
+  puts("Done\n");
+
+  puts("Bye, bye.");
+  puts("******************************************************\n");
+
+  return 0;
+}
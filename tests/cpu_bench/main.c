@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       CPU bound benchmark in the style of CoreMark
+ *
+ * Runs list processing, a matrix multiplication, a state machine and a CRC,
+ * the same kinds of kernels CoreMark uses, and prints the iterations per
+ * second. Use it to compare flash acceleration settings of a board.
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "checksum/crc16_ccitt.h"
+#include "xtimer.h"
+
+#define TEST_RUNS       (200U)
+#define LIST_LEN        (64U)
+#define MATRIX_N        (12U)
+
+typedef struct node {
+    struct node *next;
+    int16_t val;
+} node_t;
+
+static node_t _nodes[LIST_LEN];
+static int16_t _a[MATRIX_N][MATRIX_N], _b[MATRIX_N][MATRIX_N];
+static int32_t _c[MATRIX_N][MATRIX_N];
+static const char _input[] = "123,-45,6.78,9e3,0x1f,+17,-.5,,42,1e-2,x,880";
+
+static uint16_t _list(unsigned seed)
+{
+    node_t *head = NULL, *sorted = NULL;
+    uint16_t res = 0;
+
+    for (unsigned i = 0; i < LIST_LEN; i++) {
+        _nodes[i].val = (int16_t)((i * 7919 + seed) & 0x3ff);
+        _nodes[i].next = head;
+        head = &_nodes[i];
+    }
+    /* insertion sort */
+    while (head) {
+        node_t *n = head, **pos = &sorted;
+
+        head = head->next;
+        while (*pos && (*pos)->val < n->val) {
+            pos = &(*pos)->next;
+        }
+        n->next = *pos;
+        *pos = n;
+    }
+    for (node_t *n = sorted; n; n = n->next) {
+        res = (uint16_t)(res * 31 + n->val);
+    }
+    return res;
+}
+
+static uint16_t _matrix(unsigned seed)
+{
+    uint16_t res = 0;
+
+    for (unsigned i = 0; i < MATRIX_N; i++) {
+        for (unsigned j = 0; j < MATRIX_N; j++) {
+            _a[i][j] = (int16_t)(i * j + seed);
+            _b[i][j] = (int16_t)(i - j + seed);
+        }
+    }
+    for (unsigned i = 0; i < MATRIX_N; i++) {
+        for (unsigned j = 0; j < MATRIX_N; j++) {
+            int32_t sum = 0;
+
+            for (unsigned k = 0; k < MATRIX_N; k++) {
+                sum += (int32_t)_a[i][k] * _b[k][j];
+            }
+            _c[i][j] = sum;
+            res += (uint16_t)sum;
+        }
+    }
+    return res;
+}
+
+enum { S_START, S_INT, S_FRAC, S_EXP, S_HEX, S_INVALID };
+
+static uint16_t _state(void)
+{
+    unsigned counts[S_INVALID + 1] = { 0 };
+    unsigned state = S_START;
+    uint16_t res = 0;
+
+    for (const char *c = _input; ; c++) {
+        if (*c == ',' || *c == '\0') {
+            counts[state]++;
+            state = S_START;
+            if (*c == '\0') {
+                break;
+            }
+            continue;
+        }
+        switch (state) {
+            case S_START:
+                if ((*c >= '0' && *c <= '9') || *c == '+' || *c == '-') {
+                    state = S_INT;
+                }
+                else if (*c == '.') {
+                    state = S_FRAC;
+                }
+                else {
+                    state = S_INVALID;
+                }
+                break;
+            case S_INT:
+                if (*c == '.') {
+                    state = S_FRAC;
+                }
+                else if (*c == 'e') {
+                    state = S_EXP;
+                }
+                else if (*c == 'x') {
+                    state = S_HEX;
+                }
+                else if (*c < '0' || *c > '9') {
+                    state = S_INVALID;
+                }
+                break;
+            case S_FRAC:
+                if (*c == 'e') {
+                    state = S_EXP;
+                }
+                else if (*c < '0' || *c > '9') {
+                    state = S_INVALID;
+                }
+                break;
+            case S_EXP:
+                if ((*c < '0' || *c > '9') && *c != '-') {
+                    state = S_INVALID;
+                }
+                break;
+            case S_HEX:
+                if (!((*c >= '0' && *c <= '9') || (*c >= 'a' && *c <= 'f'))) {
+                    state = S_INVALID;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    for (unsigned i = 0; i <= S_INVALID; i++) {
+        res = (uint16_t)(res * 7 + counts[i]);
+    }
+    return res;
+}
+
+static uint16_t _crc(void)
+{
+    return crc16_ccitt_calc((const unsigned char *)_c, sizeof(_c));
+}
+
+int main(void)
+{
+    uint16_t check = 0;
+    uint32_t start, time;
+
+    puts("CPU benchmark (list, matrix, state machine, CRC)");
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        check ^= _list(i);
+        check ^= _matrix(i);
+        check ^= _state();
+        check ^= _crc();
+    }
+    time = xtimer_now_usec() - start;
+
+    printf("%u iterations in %u us, %u iterations/s\n", TEST_RUNS,
+           (unsigned)time, (unsigned)((uint64_t)TEST_RUNS * 1000000 / time));
+    printf("checksum 0x%04x\n", check);
+    puts("Test done");
+    return 0;
+}
@@ -14,6 +14,7 @@
  */
 
 #include <errno.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -21,7 +22,9 @@
 #include "net/netdev2/ieee802154.h"
 #include "net/ieee802154.h"
 
+#include "at86rf2xx_internal.h"
 #include "common.h"
+#include "xtimer.h"
 
 #include "od.h"
 
@@ -177,6 +180,47 @@ int txtsnd(int argc, char **argv)
     return send(iface, pan, addr, (size_t)res, text);
 }
 
+int fbbench(int argc, char **argv)
+{
+    static uint8_t frame[AT86RF2XX_MAX_PKT_LENGTH];
+    unsigned iface, rounds = 100;
+    uint32_t start, write_us = 0, read_us = 0;
+
+    if ((argc < 2) || (argc > 3)) {
+        printf("usage: %s <iface> [<rounds>]\n", argv[0]);
+        return 1;
+    }
+    iface = (unsigned)atoi(argv[1]);
+    if (iface >= AT86RF2XX_NUM) {
+        puts("error: invalid interface given");
+        return 1;
+    }
+    if (argc == 3) {
+        rounds = (unsigned)atoi(argv[2]);
+    }
+    if (rounds == 0) {
+        rounds = 1;
+    }
+    for (unsigned i = 0; i < sizeof(frame); i++) {
+        frame[i] = (uint8_t)i;
+    }
+
+    /* note: this overwrites the frame buffer of the transceiver */
+    for (unsigned i = 0; i < rounds; i++) {
+        start = xtimer_now_usec();
+        at86rf2xx_sram_write(&devs[iface], 1, frame, sizeof(frame));
+        write_us += xtimer_now_usec() - start;
+        start = xtimer_now_usec();
+        at86rf2xx_sram_read(&devs[iface], 1, frame, sizeof(frame));
+        read_us += xtimer_now_usec() - start;
+    }
+    printf("%u byte frame buffer access over %u rounds\n",
+           (unsigned)sizeof(frame), rounds);
+    printf("write: %" PRIu32 " us, read: %" PRIu32 " us\n",
+           write_us / rounds, read_us / rounds);
+    return 0;
+}
+
 static inline int _dehex(char c, int default_)
 {
     if ('0' <= c && c <= '9') {
@@ -39,6 +39,7 @@ at86rf2xx_t devs[AT86RF2XX_NUM];
 static const shell_command_t shell_commands[] = {
     { "ifconfig", "Configure netdev2", ifconfig },
     { "txtsnd", "Send IEEE 802.15.4 packet", txtsnd },
+    { "fbbench", "Measure frame buffer access time", fbbench },
     { NULL, NULL, NULL }
 };
 
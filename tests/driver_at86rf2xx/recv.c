@@ -13,12 +13,14 @@
  * @author Martine Lenders <mlenders@inf.fu-berlin.de>
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "at86rf2xx.h"
 #include "od.h"
 #include "net/ieee802154.h"
 #include "net/netdev2.h"
+#include "xtimer.h"
 
 #include "common.h"
 
@@ -32,9 +34,12 @@ void recv(netdev2_t *dev)
     size_t mhr_len, data_len, src_len, dst_len;
     netdev2_ieee802154_rx_info_t rx_info;
     le_uint16_t src_pan, dst_pan;
+    uint32_t start, read_us;
 
     putchar('\n');
+    start = xtimer_now_usec();
     data_len = dev->driver->recv(dev, buffer, sizeof(buffer), &rx_info);
+    read_us = xtimer_now_usec() - start;
     mhr_len = ieee802154_get_frame_hdr_len(buffer);
     if (mhr_len == 0) {
         puts("Unexpected MHR for incoming packet");
@@ -111,7 +116,8 @@ void recv(netdev2_t *dev)
         }
     }
     printf("\n");
-    printf("RSSI: %u, LQI: %u\n\n", rx_info.rssi, rx_info.lqi);
+    printf("RSSI: %u, LQI: %u\n", rx_info.rssi, rx_info.lqi);
+    printf("Read from radio in %" PRIu32 " us\n\n", read_us);
 }
 
 /** @} */
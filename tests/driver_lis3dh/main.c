@@ -76,7 +76,7 @@ static void test_int1(void *arg)
 int main(void)
 {
     lis3dh_t dev;
-    lis3dh_data_t acc_data;
+    lis3dh_data_t acc_data[LIS3DH_FIFO_SIZE];
 
     puts("LIS3DH accelerometer driver test application\n");
     printf("Initializing SPI_%i... ", TEST_LIS3DH_SPI);
@@ -164,26 +164,25 @@ int main(void)
 
     while (1) {
         int fifo_level;
+        int16_t temperature;
 
-        fifo_level = lis3dh_get_fifo_level(&dev);
         printf("int1_count = %d\n", int1_count);
-        printf("Reading %d measurements\n", fifo_level);
-        while (fifo_level > 0) {
-            int16_t temperature;
-            int int1;
-            if (lis3dh_read_xyz(&dev, &acc_data) != 0) {
-                puts("Reading acceleration data... ");
-                puts("[Failed]\n");
-            }
-            if (lis3dh_read_aux_adc3(&dev, &temperature) != 0) {
-                puts("Reading temperature data... ");
-                puts("[Failed]\n");
-                return 1;
-            }
-            int1 = gpio_read(TEST_LIS3DH_INT1);
-            printf("X: %6d Y: %6d Z: %6d Temp: %6d, INT1: %08x\n",
-                   acc_data.acc_x, acc_data.acc_y, acc_data.acc_z, temperature, int1);
-            --fifo_level;
+        fifo_level = lis3dh_read_fifo(&dev, acc_data, LIS3DH_FIFO_SIZE);
+        if (fifo_level < 0) {
+            puts("Reading acceleration data... ");
+            puts("[Failed]\n");
+            fifo_level = 0;
+        }
+        if (lis3dh_read_aux_adc3(&dev, &temperature) != 0) {
+            puts("Reading temperature data... ");
+            puts("[Failed]\n");
+            return 1;
+        }
+        printf("Read %d measurements, Temp: %6d, INT1: %08x\n", fifo_level,
+               temperature, gpio_read(TEST_LIS3DH_INT1));
+        for (int i = 0; i < fifo_level; i++) {
+            printf("X: %6d Y: %6d Z: %6d\n",
+                   acc_data[i].acc_x, acc_data[i].acc_y, acc_data[i].acc_z);
         }
 
         xtimer_usleep(SLEEP);
@@ -39,6 +39,9 @@
 #ifndef TEST_NVRAM_SPI_ADDRESS_COUNT
 #error "TEST_NVRAM_SPI_ADDRESS_COUNT not defined"
 #endif
+#ifndef TEST_NVRAM_SPI_PAGE_SIZE
+#define TEST_NVRAM_SPI_PAGE_SIZE (0)
+#endif
 
 #ifdef TEST_NVRAM_SPI_CONF
 #define SPI_CONF    (TEST_NVRAM_SPI_CONF)
@@ -56,6 +59,7 @@
  * memories which do not fit inside free RAM */
 static uint8_t buf_out[TEST_NVRAM_SPI_SIZE];
 static uint8_t buf_in[TEST_NVRAM_SPI_SIZE];
+static uint8_t cache[16];
 
 /**
  * @brief xxd-like printing of a binary buffer
@@ -116,6 +120,7 @@ int main(void)
         .spi = TEST_NVRAM_SPI_DEV,
         .cs = TEST_NVRAM_SPI_CS,
         .address_count = TEST_NVRAM_SPI_ADDRESS_COUNT,
+        .page_size = TEST_NVRAM_SPI_PAGE_SIZE,
     };
     nvram_t dev;
     uint32_t start_delay = 10;
@@ -246,6 +251,45 @@ int main(void)
     }
     puts("[OK]");
 
+    puts("Writing bytewise inverted data through the write-back cache");
+    spi_params.cache = cache;
+    spi_params.cache_size = sizeof(cache);
+    for (i = 0; i < TEST_NVRAM_SPI_SIZE; ++i) {
+        buf_out[i] = ~buf_out[i];
+        if (dev.write(&dev, &buf_out[i], i, 1) != 1) {
+            puts("[Failed]\n");
+            return 1;
+        }
+    }
+    if (nvram_spi_flush(&dev) != 0) {
+        puts("[Failed]\n");
+        return 1;
+    }
+    puts("[OK]");
+
+    puts("Reading back vectored");
+    memset(buf_in, 0x00, sizeof(buf_in));
+    {
+        struct iovec vec[] = {
+            { .iov_base = buf_in, .iov_len = TEST_NVRAM_SPI_SIZE / 2 },
+            { .iov_base = &buf_in[TEST_NVRAM_SPI_SIZE / 2],
+              .iov_len = TEST_NVRAM_SPI_SIZE - (TEST_NVRAM_SPI_SIZE / 2) },
+        };
+        if (nvram_readv(&dev, vec, 2, 0) != TEST_NVRAM_SPI_SIZE) {
+            puts("[Failed]\n");
+            return 1;
+        }
+    }
+    puts("[OK]");
+    puts("Verifying contents...");
+    if (memcmp(buf_in, buf_out, TEST_NVRAM_SPI_SIZE) != 0) {
+        puts("buf_in:");
+        print_buffer(buf_in, sizeof(buf_in));
+        puts("[Failed]\n");
+        return 1;
+    }
+    puts("[OK]");
+
     puts("All tests passed!");
 
     while(1);
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs a test signal through a FIR, IIR and FFT pipeline
+ *
+ * @}
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "dsp_pipe.h"
+
+#define BLOCK_LEN       (256U)
+#define BLOCKS          (16U)
+#define SIGNAL_BIN      (16U)
+#define FIR_TAPS        (8U)
+
+/* moving average, symmetric so the order does not matter */
+static const int16_t _fir_coeffs[FIR_TAPS] = {
+    4096, 4096, 4096, 4096, 4096, 4096, 4096, 4096
+};
+
+/* y[n] = x[n] - x[n-1] + 0.99 y[n-1], halved for a post shift of 1 */
+static const int16_t _iir_coeffs[6] = { 16384, 0, -16384, 0, 16220, 0 };
+
+static int16_t _fir_state[FIR_TAPS + BLOCK_LEN - 1];
+static int16_t _iir_state[4];
+static int16_t _fft_work[2 * BLOCK_LEN];
+static int16_t _buf[BLOCK_LEN];
+
+static dsp_pipe_fir_t _fir;
+static dsp_pipe_iir_t _iir;
+static dsp_pipe_fft_t _fft;
+
+int main(void)
+{
+    dsp_pipe_stage_t *pipe = NULL;
+    size_t len = 0;
+    unsigned peak = 0;
+
+    printf("dsp_pipe on %s, %u blocks of %u samples\n", RIOT_BOARD, BLOCKS,
+           BLOCK_LEN);
+    if ((dsp_pipe_fir_init(&_fir, _fir_coeffs, FIR_TAPS, _fir_state,
+                           BLOCK_LEN) < 0) ||
+        (dsp_pipe_iir_init(&_iir, _iir_coeffs, 1, _iir_state, 1) < 0) ||
+        (dsp_pipe_fft_init(&_fft, _fft_work, BLOCK_LEN) < 0)) {
+        puts("error: initializing the stages failed");
+        return 1;
+    }
+    dsp_pipe_append(&pipe, &_fir.stage);
+    dsp_pipe_append(&pipe, &_iir.stage);
+    dsp_pipe_append(&pipe, &_fft.stage);
+
+    for (unsigned b = 0; b < BLOCKS; b++) {
+        for (unsigned i = 0; i < BLOCK_LEN; i++) {
+            float x = sinf((2 * (float)M_PI * SIGNAL_BIN * i) / BLOCK_LEN);
+
+            _buf[i] = (int16_t)(8000 + 16000 * x);
+        }
+        len = dsp_pipe_process(pipe, _buf, BLOCK_LEN);
+    }
+
+    for (unsigned i = 1; i < len; i++) {
+        if (_buf[i] > _buf[peak]) {
+            peak = i;
+        }
+    }
+    printf("peak in bin %u\n", peak);
+    dsp_pipe_print(pipe);
+    if ((peak != SIGNAL_BIN) || (_buf[0] > (_buf[peak] / 8))) {
+        puts("error: unexpected spectrum");
+        return 1;
+    }
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Event queue test application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "event.h"
+#include "event/callback.h"
+#include "event/timeout.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TIMEOUT_US      (100000U)
+
+static unsigned order;
+static unsigned errors;
+static uint32_t before;
+
+static void _expect(unsigned pos, const char *name)
+{
+    if (order++ != pos) {
+        printf("%s: wrong order\n", name);
+        errors++;
+    }
+    else {
+        printf("%s handled\n", name);
+    }
+}
+
+static void _handler1(event_t *event)
+{
+    (void)event;
+    _expect(0, "event1");
+}
+
+static void _handler2(event_t *event)
+{
+    (void)event;
+    _expect(1, "event2");
+}
+
+static void _callback(void *arg)
+{
+    _expect(2, (const char *)arg);
+}
+
+static void _timeout_handler(event_t *event)
+{
+    (void)event;
+    uint32_t diff = xtimer_now_usec() - before;
+    _expect(3, "timeout event");
+    if (diff < TIMEOUT_US) {
+        printf("timeout event came too early (%u us)\n", (unsigned)diff);
+        errors++;
+    }
+}
+
+static event_t event1 = { .handler = _handler1 };
+static event_t event2 = { .handler = _handler2 };
+static event_t event_cancelled = { .handler = _handler2 };
+static event_callback_t event_cb = EVENT_CALLBACK_INIT(_callback, "callback event");
+static event_t event_timed = { .handler = _timeout_handler };
+static event_timeout_t event_timeout;
+
+int main(void)
+{
+    puts("event test application");
+
+    /* the shared event thread runs with a lower priority than main (see
+     * Makefile), so nothing is handled before main goes to sleep */
+    event_post(&event_queue_shared, &event1);
+    event_post(&event_queue_shared, &event2);
+    /* posting twice must not queue the event twice */
+    event_post(&event_queue_shared, &event2);
+    event_post(&event_queue_shared, &event_cancelled);
+    event_cancel(&event_queue_shared, &event_cancelled);
+    event_post(&event_queue_shared, &event_cb.super);
+
+    before = xtimer_now_usec();
+    event_timeout_init(&event_timeout, &event_queue_shared, &event_timed);
+    event_timeout_set(&event_timeout, TIMEOUT_US);
+
+    xtimer_usleep(2 * TIMEOUT_US);
+
+    if (!errors && (order == 4)) {
+        puts("[SUCCESS]");
+    }
+    else {
+        puts("[FAILED]");
+    }
+
+    return 0;
+}
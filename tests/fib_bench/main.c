@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures FIB inserts and lookups with the linear and the trie
+ *              lookup over the number of entries
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/fib.h"
+#include "xtimer.h"
+
+#ifndef FIB_BENCH_SIZE
+#define FIB_BENCH_SIZE  (128U)
+#endif
+#define LOOKUPS_NUMOF   (1024U)
+#define ADDR_LEN        (16U)
+
+static fib_entry_t _entries[FIB_BENCH_SIZE];
+static fib_trie_node_t _nodes[FIB_TRIE_NODES_NUMOF(FIB_BENCH_SIZE)];
+static fib_table_t _table = { .data.entries = _entries,
+                              .table_type = FIB_TABLE_TYPE_SH,
+                              .mtx_access = MUTEX_INIT };
+
+static const unsigned _sizes[] = { 16, 128, 512 };
+
+/* one /48 per entry, e.g. the downward routes of a RPL root */
+static void _set_dst(uint8_t *dst, unsigned idx)
+{
+    memset(dst, 0, ADDR_LEN);
+    dst[0] = 0x20;
+    dst[1] = 0x01;
+    dst[4] = (uint8_t)(idx >> 8);
+    dst[5] = (uint8_t)idx;
+}
+
+static void _set_nxt(uint8_t *nxt, unsigned idx)
+{
+    memset(nxt, 0, ADDR_LEN);
+    nxt[0] = 0xfe;
+    nxt[1] = 0x80;
+    nxt[15] = (uint8_t)(idx & 0x3);
+}
+
+static uint32_t _insert(unsigned num)
+{
+    uint8_t dst[ADDR_LEN], nxt[ADDR_LEN];
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < num; i++) {
+        _set_dst(dst, i);
+        _set_nxt(nxt, i);
+        if (fib_add_entry(&_table, 42, dst, ADDR_LEN,
+                          (48UL << FIB_FLAG_NET_PREFIX_SHIFT), nxt, ADDR_LEN, 0,
+                          (uint32_t)FIB_LIFETIME_NO_EXPIRE) != 0) {
+            puts("insert failed");
+            return 0;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _lookup(unsigned num)
+{
+    uint8_t dst[ADDR_LEN], nxt[ADDR_LEN];
+    kernel_pid_t iface = KERNEL_PID_UNDEF;
+    uint32_t flags = 0;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < LOOKUPS_NUMOF; i++) {
+        unsigned idx = (i * 7) % num;
+        size_t nxt_len = ADDR_LEN;
+
+        _set_dst(dst, idx);
+        /* any address in the /48 */
+        dst[15] = (uint8_t)i;
+        if ((fib_get_next_hop(&_table, &iface, nxt, &nxt_len, &flags,
+                              dst, ADDR_LEN, 0) != 0) ||
+            (nxt[15] != (idx & 0x3))) {
+            puts("wrong lookup result");
+            return 0;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+static void _run(unsigned num, fib_trie_node_t *nodes)
+{
+    _table.size = num;
+    _table.trie_nodes = nodes;
+    fib_init(&_table);
+
+    uint32_t insert = _insert(num);
+    uint32_t lookup = _lookup(num);
+
+    printf("%7u | %-6s | %9lu | %9lu\n", num, (nodes) ? "trie" : "linear",
+           (unsigned long)(((uint64_t)insert * 1000) / num),
+           (unsigned long)(((uint64_t)lookup * 1000) / LOOKUPS_NUMOF));
+    fib_deinit(&_table);
+}
+
+int main(void)
+{
+    puts("FIB benchmark");
+    puts("entries | lookup | insert ns | lookup ns");
+
+    for (unsigned i = 0; i < sizeof(_sizes) / sizeof(_sizes[0]); i++) {
+        if (_sizes[i] > FIB_BENCH_SIZE) {
+            break;
+        }
+        _run(_sizes[i], NULL);
+        _run(_sizes[i], _nodes);
+    }
+
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,29 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the FIB unittests with multiple next hops per entry (fib_multipath)
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "tests-fib.h"
+
+int main(void)
+{
+    TESTS_START();
+    tests_fib();
+    TESTS_END();
+
+    return 0;
+}
@@ -14,17 +14,92 @@
  * @brief       fmt print test application
  *
  * This test is supposed to check for "compilabilty" of the fmt print_* instructions.
+ * It also times formatting fixed point and float values with fmt, or with
+ * snprintf() if built with FMT_PRINT_PRINTF=1.
  *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  *
  * @}
  */
 
+#include <stdio.h>
+#include <stdlib.h>
+
 #include "fmt.h"
+#include "xtimer.h"
+
+#define TEST_RUNS   (1000U)
+
+static char _buf[FMT_FLOAT_MAXLEN + 1];
+
+#ifdef FMT_PRINT_PRINTF
+#define IMPL        "snprintf"
+
+static void _fixed(int32_t val)
+{
+    snprintf(_buf, sizeof(_buf), "%s%ld.%03ld", (val < 0) ? "-" : "",
+             labs((long)val) / 1000, labs((long)val) % 1000);
+}
+
+static void _float(float f)
+{
+    snprintf(_buf, sizeof(_buf), "%.3f", (double)f);
+}
+#else
+#define IMPL        "fmt"
+
+static void _fixed(int32_t val)
+{
+    _buf[fmt_s32_dfp(_buf, val, 3)] = '\0';
+}
+
+static void _float(float f)
+{
+    _buf[fmt_float(_buf, f, 3)] = '\0';
+}
+#endif
+
+static void _bench(const char *name, void (*func)(void))
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        func();
+    }
+    uint32_t ns = ((xtimer_now_usec() - start) * 1000U) / TEST_RUNS;
+
+    print_str(IMPL " ");
+    print_str(name);
+    print_str(": ");
+    print_str(_buf);
+    print_str(", ");
+    print_u32_dec(ns);
+    print_str(" ns\n");
+}
+
+static void _bench_fixed(void)
+{
+    _fixed(-123456);
+}
+
+static void _bench_float(void)
+{
+    _float(-123.456f);
+}
 
 int main(void)
 {
     print_str("If you can read this:\n");
+    print_s32_dfp(-2345, 2);
+    print_str(" ");
+    print_s32_dfp(42, -3);
+    print_str(" ");
+    print_float(3.14159f, 3);
+    print_str("\n");
+
+    _bench("fixed", _bench_fixed);
+    _bench("float", _bench_float);
+
     print_str("Test successful.\n");
 
     return 0;
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the gcoap server resource lookup
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/gnrc/coap.h"
+#include "xtimer.h"
+
+#ifndef RESOURCES_NUMOF
+#define RESOURCES_NUMOF (80U)
+#endif
+#define LOOKUPS_NUMOF   (10000U)
+
+static char _paths[RESOURCES_NUMOF][sizeof("/res/0000")];
+/* paths between the ones of the resources */
+static char _miss_paths[RESOURCES_NUMOF][sizeof("/res/0000")];
+static coap_resource_t _resources[RESOURCES_NUMOF];
+static gcoap_listener_t _listener;
+
+static ssize_t _handler(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static uint32_t _lookup(char (*paths)[sizeof("/res/0000")], int hit)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < LOOKUPS_NUMOF; i++) {
+        unsigned idx = (i * 7) % RESOURCES_NUMOF;
+        coap_resource_t *res = gcoap_find_resource(paths[idx], COAP_GET);
+
+        if (res != ((hit) ? &_resources[idx] : NULL)) {
+            puts("wrong lookup result");
+            return 0;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    /* the paths are sorted, as gcoap requires */
+    for (unsigned i = 0; i < RESOURCES_NUMOF; i++) {
+        sprintf(_paths[i], "/res/%04u", 2 * i);
+        sprintf(_miss_paths[i], "/res/%04u", (2 * i) + 1);
+        _resources[i].path = _paths[i];
+        _resources[i].methods = COAP_GET;
+        _resources[i].handler = _handler;
+    }
+    _listener.resources = _resources;
+    _listener.resources_len = RESOURCES_NUMOF;
+    gcoap_register_listener(&_listener);
+
+    uint32_t hit = _lookup(_paths, 1);
+    uint32_t miss = _lookup(_miss_paths, 0);
+
+    puts("gcoap benchmark");
+    puts("resources |   hit ns |  miss ns");
+    printf("%9u | %8lu | %8lu\n", RESOURCES_NUMOF,
+           (unsigned long)(((uint64_t)hit * 1000) / LOOKUPS_NUMOF),
+           (unsigned long)(((uint64_t)miss * 1000) / LOOKUPS_NUMOF));
+
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,441 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Network stack benchmark suite
+ *
+ * Measures the packet buffer, UDP over the IPv6 loopback, 6LoWPAN
+ * fragmentation and reassembly, and IPv6 forwarding. Like the interfaces of
+ * @ref net_gnrc_nettest, a thread of the test stands in for the network
+ * device, so the numbers do not depend on a radio or on the host.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/fib.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/netif.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef BENCH_PKTBUF_COUNT
+#define BENCH_PKTBUF_COUNT  (10000U)
+#endif
+#ifndef BENCH_COUNT
+#define BENCH_COUNT         (1000U)
+#endif
+#ifndef BENCH_WINDOW
+#define BENCH_WINDOW        (4U)
+#endif
+/* maximum fragment size of the fake interface, as on IEEE 802.15.4 */
+#ifndef BENCH_FRAG_SIZE
+#define BENCH_FRAG_SIZE     (102U)
+#endif
+#define BENCH_PAYLOAD_MAX   (1024U)
+#define BENCH_PORT          (61616U)
+#define BENCH_PROTNUM       (253U)      /* RFC 3692 experimental */
+#define BENCH_HL            (64U)
+#define BENCH_TIMEOUT_US    (100U * MS_IN_USEC)
+#define BENCH_MSG_SENT      (0x8a00)
+#define SINK_QUEUE_SIZE     (16U)
+#define MAIN_QUEUE_SIZE     (16U)
+
+/* the fake interface sink and its peer (the IIDs follow from the l2 addresses) */
+static uint8_t _sink_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+static uint8_t _peer_l2[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02 };
+static const ipv6_addr_t _sink_ll = { {
+    0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01
+} };
+static const ipv6_addr_t _peer_ll = { {
+    0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x02
+} };
+/* source of forwarded packets, destinations are 2001:db8:<i>::1 */
+static const ipv6_addr_t _remote = { {
+    0x20, 0x01, 0x0d, 0xb8, 0xff, 0xff, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+} };
+
+static const size_t _pktbuf_sizes[] = { 16, 128, 512 };
+static const size_t _udp_sizes[] = { 16, 256, 1024 };
+static const size_t _sixlowpan_sizes[] = { 256, 1024 };
+
+static char _sink_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _main_queue[MAIN_QUEUE_SIZE];
+static kernel_pid_t _sink_pid = KERNEL_PID_UNDEF;
+static kernel_pid_t _main_pid;
+static uint8_t _buf[BENCH_PAYLOAD_MAX];
+
+static void _print(const char *test, unsigned param, unsigned count,
+                   uint32_t usec, uint64_t units, const char *unit)
+{
+    uint32_t rate = (usec > 0) ? (uint32_t)((units * SEC_IN_USEC) / usec) : 0;
+
+    printf("bench,%s,%u,%u,%" PRIu32 ",%" PRIu32 ",%s\n", test, param, count,
+           usec, rate, unit);
+}
+
+/* turns a frame sent by 6LoWPAN around as if the peer had sent it */
+static void _sink_loop(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif, *rcv;
+    uint8_t *data;
+
+    netif = gnrc_pktbuf_add(NULL, pkt->data, pkt->size, GNRC_NETTYPE_NETIF);
+    if (netif == NULL) {
+        return;
+    }
+    rcv = gnrc_pktbuf_add(netif, NULL, gnrc_pkt_len(pkt->next),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (rcv == NULL) {
+        gnrc_pktbuf_release(netif);
+        return;
+    }
+    data = rcv->data;
+    for (gnrc_pktsnip_t *ptr = pkt->next; ptr != NULL; ptr = ptr->next) {
+        memcpy(data, ptr->data, ptr->size);
+        data += ptr->size;
+    }
+    if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN,
+                                     GNRC_NETREG_DEMUX_CTX_ALL, rcv) == 0) {
+        gnrc_pktbuf_release(rcv);
+    }
+}
+
+static void *_sink(void *arg)
+{
+    msg_t msg, reply, queue[SINK_QUEUE_SIZE];
+
+    (void)arg;
+    msg_init_queue(queue, SINK_QUEUE_SIZE);
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+    reply.content.value = (uint32_t)(-ENOTSUP);
+
+    while (1) {
+        gnrc_pktsnip_t *pkt;
+
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_SND:
+                pkt = msg.content.ptr;
+                if (pkt->next->type == GNRC_NETTYPE_SIXLOWPAN) {
+                    _sink_loop(pkt);
+                }
+                else if ((pkt->next->type == GNRC_NETTYPE_IPV6) &&
+                         (((ipv6_hdr_t *)pkt->next->data)->nh == BENCH_PROTNUM)) {
+                    /* a forwarded packet, anything else is neighbor
+                     * discovery */
+                    msg_t sent = { .type = BENCH_MSG_SENT };
+
+                    msg_send(&sent, _main_pid);
+                }
+                gnrc_pktbuf_release(pkt);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                break;
+        }
+    }
+    return NULL;
+}
+
+static void _pktbuf(size_t size)
+{
+    uint32_t start = xtimer_now_usec();
+    unsigned done;
+
+    for (done = 0; done < BENCH_PKTBUF_COUNT; done++) {
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, size,
+                                              GNRC_NETTYPE_UNDEF);
+
+        if (pkt == NULL) {
+            break;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    _print("pktbuf", size, done, xtimer_now_usec() - start, done, "ops/s");
+}
+
+static void _udp(size_t size)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_ep_t remote = SOCK_IPV6_EP_ANY;
+    sock_udp_t server, client;
+    unsigned sent = 0, done = 0;
+    uint32_t start, elapsed;
+
+    local.port = BENCH_PORT;
+    remote.port = BENCH_PORT;
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    if (sock_udp_create(&server, &local, NULL, 0) < 0) {
+        puts("error: unable to create server sock");
+        return;
+    }
+    if (sock_udp_create(&client, NULL, &remote, 0) < 0) {
+        puts("error: unable to create client sock");
+        sock_udp_close(&server);
+        return;
+    }
+
+    start = xtimer_now_usec();
+    while ((sent < BENCH_WINDOW) && (sent < BENCH_COUNT)) {
+        sent += (sock_udp_send(&client, _buf, size, NULL) < 0) ? 0 : 1;
+    }
+    while (done < sent) {
+        if (sock_udp_recv(&server, _buf, sizeof(_buf), BENCH_TIMEOUT_US,
+                          NULL) < 0) {
+            break;
+        }
+        done++;
+        if (sent < BENCH_COUNT) {
+            sent += (sock_udp_send(&client, _buf, size, NULL) < 0) ? 0 : 1;
+        }
+    }
+    elapsed = xtimer_now_usec() - start;
+    sock_udp_close(&client);
+    sock_udp_close(&server);
+
+    _print("udp", size, done, elapsed, done, "pps");
+    _print("udp", size, done, elapsed, (uint64_t)done * size, "B/s");
+}
+
+/* builds a packet as received by the fake interface from its peer */
+static gnrc_pktsnip_t *_build_rcv(const ipv6_addr_t *src,
+                                  const ipv6_addr_t *dst, size_t size)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+    ipv6_hdr_t *hdr;
+
+    netif = gnrc_netif_hdr_build(_peer_l2, sizeof(_peer_l2), _sink_l2,
+                                 sizeof(_sink_l2));
+    if (netif == NULL) {
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _sink_pid;
+    pkt = gnrc_pktbuf_add(netif, NULL, sizeof(ipv6_hdr_t) + size,
+                          GNRC_NETTYPE_IPV6);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    hdr = pkt->data;
+    memset(hdr, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(hdr);
+    hdr->len = byteorder_htons(size);
+    hdr->nh = BENCH_PROTNUM;
+    hdr->hl = BENCH_HL;
+    hdr->src = *src;
+    hdr->dst = *dst;
+    memcpy(hdr + 1, _buf, size);
+    return pkt;
+}
+
+/* builds a datagram to send from the peer to the fake interface */
+static gnrc_pktsnip_t *_build_send(size_t size)
+{
+    gnrc_pktsnip_t *netif, *ipv6, *payload;
+    ipv6_hdr_t *hdr;
+
+    payload = gnrc_pktbuf_add(NULL, _buf, size, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    ipv6 = gnrc_ipv6_hdr_build(payload, &_peer_ll, &_sink_ll);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    hdr = ipv6->data;
+    hdr->len = byteorder_htons(size);
+    hdr->nh = BENCH_PROTNUM;
+    hdr->hl = BENCH_HL;
+    netif = gnrc_netif_hdr_build(_peer_l2, sizeof(_peer_l2), _sink_l2,
+                                 sizeof(_sink_l2));
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _sink_pid;
+    netif->next = ipv6;
+    return netif;
+}
+
+static void _sixlowpan(size_t size)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(BENCH_PROTNUM,
+                                                           _main_pid);
+    unsigned done;
+    uint32_t start, elapsed;
+
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &entry);
+    start = xtimer_now_usec();
+    /* 6LoWPAN fragments one datagram at a time */
+    for (done = 0; done < BENCH_COUNT; done++) {
+        gnrc_pktsnip_t *pkt = _build_send(size);
+        msg_t msg;
+
+        if (pkt == NULL) {
+            break;
+        }
+        if (gnrc_netapi_dispatch_send(GNRC_NETTYPE_SIXLOWPAN,
+                                      GNRC_NETREG_DEMUX_CTX_ALL, pkt) == 0) {
+            gnrc_pktbuf_release(pkt);
+            break;
+        }
+        if ((xtimer_msg_receive_timeout(&msg, BENCH_TIMEOUT_US) < 0) ||
+            (msg.type != GNRC_NETAPI_MSG_TYPE_RCV)) {
+            break;
+        }
+        gnrc_pktbuf_release(msg.content.ptr);
+    }
+    elapsed = xtimer_now_usec() - start;
+    gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, &entry);
+
+    _print("sixlowpan", size, done, elapsed, done, "datagrams/s");
+    _print("sixlowpan", size, done, elapsed, (uint64_t)done * size, "B/s");
+}
+
+static void _prefix(ipv6_addr_t *addr, unsigned i)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->u16[0] = byteorder_htons(0x2001);
+    addr->u16[1] = byteorder_htons(0x0db8);
+    addr->u16[2] = byteorder_htons(i);
+}
+
+static int _inject(unsigned entries, unsigned i)
+{
+    ipv6_addr_t dst;
+    gnrc_pktsnip_t *pkt;
+
+    _prefix(&dst, i % entries);
+    dst.u8[15] = 1;
+    pkt = _build_rcv(&_remote, &dst, 16);
+    if (pkt == NULL) {
+        return 0;
+    }
+    if (gnrc_netapi_receive(gnrc_ipv6_pid, pkt) < 1) {
+        gnrc_pktbuf_release(pkt);
+        return 0;
+    }
+    return 1;
+}
+
+static void _forward(unsigned entries)
+{
+    unsigned sent = 0, done = 0;
+    uint32_t start, elapsed;
+
+    fib_flush(&gnrc_ipv6_fib_table, _sink_pid);
+    for (unsigned i = 0; i < entries; i++) {
+        ipv6_addr_t prefix;
+
+        _prefix(&prefix, i);
+        if (fib_add_entry(&gnrc_ipv6_fib_table, _sink_pid, prefix.u8,
+                          sizeof(prefix), (64UL << FIB_FLAG_NET_PREFIX_SHIFT),
+                          (uint8_t *)_peer_ll.u8, sizeof(_peer_ll), 0,
+                          (uint32_t)FIB_LIFETIME_NO_EXPIRE) < 0) {
+            printf("error: unable to add FIB entry %u\n", i);
+            return;
+        }
+    }
+
+    start = xtimer_now_usec();
+    while ((sent < BENCH_WINDOW) && (sent < BENCH_COUNT)) {
+        sent += _inject(entries, sent);
+    }
+    while (done < sent) {
+        msg_t msg;
+
+        if ((xtimer_msg_receive_timeout(&msg, BENCH_TIMEOUT_US) < 0) ||
+            (msg.type != BENCH_MSG_SENT)) {
+            break;
+        }
+        done++;
+        if (sent < BENCH_COUNT) {
+            sent += _inject(entries, sent);
+        }
+    }
+    elapsed = xtimer_now_usec() - start;
+
+    _print("ipv6_fwd", entries, done, elapsed, done, "pps");
+}
+
+static int _init_sink(void)
+{
+    _sink_pid = thread_create(_sink_stack, sizeof(_sink_stack),
+                              THREAD_PRIORITY_MAIN - 4,
+                              THREAD_CREATE_STACKTEST, _sink, NULL, "sink");
+    if (_sink_pid <= KERNEL_PID_UNDEF) {
+        return -1;
+    }
+    gnrc_ipv6_netif_add(_sink_pid);
+    gnrc_sixlowpan_netif_add(_sink_pid, BENCH_FRAG_SIZE);
+    if (gnrc_ipv6_netif_add_addr(_sink_pid, &_sink_ll, 64,
+                                 GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST) == NULL) {
+        return -1;
+    }
+    /* static, so no neighbor discovery runs for the next hop */
+    if (gnrc_ipv6_nc_add(_sink_pid, &_peer_ll, _peer_l2, sizeof(_peer_l2),
+                         GNRC_IPV6_NC_STATE_UNMANAGED) == NULL) {
+        return -1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    const unsigned fib_entries[] = { 1, GNRC_IPV6_FIB_TABLE_SIZE / 2,
+                                     GNRC_IPV6_FIB_TABLE_SIZE };
+
+    puts("gnrc network stack benchmark");
+    _main_pid = sched_active_pid;
+    msg_init_queue(_main_queue, MAIN_QUEUE_SIZE);
+    if (_init_sink() < 0) {
+        puts("error: unable to set up the fake interface");
+        return 1;
+    }
+    memset(_buf, 0xaa, sizeof(_buf));
+
+    puts("bench,test,param,count,us,rate,unit");
+    for (unsigned i = 0; i < sizeof(_pktbuf_sizes) / sizeof(_pktbuf_sizes[0]); i++) {
+        _pktbuf(_pktbuf_sizes[i]);
+    }
+    for (unsigned i = 0; i < sizeof(_udp_sizes) / sizeof(_udp_sizes[0]); i++) {
+        _udp(_udp_sizes[i]);
+    }
+    for (unsigned i = 0; i < sizeof(_sixlowpan_sizes) / sizeof(_sixlowpan_sizes[0]); i++) {
+        _sixlowpan(_sixlowpan_sizes[i]);
+    }
+    for (unsigned i = 0; i < sizeof(fib_entries) / sizeof(fib_entries[0]); i++) {
+        _forward(fib_entries[i]);
+    }
+    puts("Test done");
+    return 0;
+}
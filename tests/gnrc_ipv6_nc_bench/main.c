@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures neighbor cache lookups over the number of neighbors
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/gnrc/ipv6/nc.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#define LOOKUPS_NUMOF   (10000U)
+#define NETIF           (7)
+
+#ifdef MODULE_GNRC_IPV6_NC_HASHED
+#define VARIANT         "hashed"
+#else
+#define VARIANT         "linear"
+#endif
+
+static const uint8_t _l2_addr[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+
+/* link-local address of neighbor idx */
+static void _set_addr(ipv6_addr_t *addr, unsigned idx)
+{
+    ipv6_addr_set_link_local_prefix(addr);
+    addr->u32[2] = byteorder_htonl(0x020000ff);
+    addr->u32[3] = byteorder_htonl(0xfe000000 | idx);
+}
+
+static uint32_t _lookup(unsigned num, unsigned offset)
+{
+    ipv6_addr_t addr;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < LOOKUPS_NUMOF; i++) {
+        _set_addr(&addr, (i % num) + offset);
+        if ((gnrc_ipv6_nc_get(NETIF, &addr) == NULL) != (offset != 0)) {
+            puts("wrong lookup result");
+            return 0;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    puts("gnrc_ipv6_nc benchmark");
+    printf("index: %s\n", VARIANT);
+    puts("entries |   hit ns |  miss ns");
+
+    for (unsigned num = 1; num <= GNRC_IPV6_NC_SIZE; num <<= 1) {
+        ipv6_addr_t addr;
+
+        gnrc_ipv6_nc_init();
+        for (unsigned i = 0; i < num; i++) {
+            _set_addr(&addr, i);
+            if (gnrc_ipv6_nc_add(NETIF, &addr, _l2_addr, sizeof(_l2_addr),
+                                 0) == NULL) {
+                puts("adding neighbor failed");
+                return 1;
+            }
+        }
+        /* neighbors num to 2 * num - 1 are never added */
+        uint32_t hit = _lookup(num, 0);
+        uint32_t miss = _lookup(num, num);
+
+        printf("%7u | %8lu | %8lu\n", num,
+               (unsigned long)(((uint64_t)hit * 1000) / LOOKUPS_NUMOF),
+               (unsigned long)(((uint64_t)miss * 1000) / LOOKUPS_NUMOF));
+    }
+
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,29 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Runs the neighbor cache unittests against gnrc_ipv6_nc_hashed
+ *
+ * @}
+ */
+
+#include "embUnit.h"
+#include "tests-ipv6_nc.h"
+
+int main(void)
+{
+    TESTS_START();
+    tests_ipv6_nc();
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures gnrc_netreg lookups over the number of registrations
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc/netreg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define ENTRIES_NUMOF   (64U)
+#define LOOKUPS_NUMOF   (10000U)
+/* first port and distance between the registered ports */
+#define PORT_FIRST      (5683U)
+#define PORT_STEP       (97U)
+#define MSG_QUEUE_SIZE  (4U)
+
+#ifdef MODULE_GNRC_NETREG_HASHED
+#define VARIANT         "hashed"
+#else
+#define VARIANT         "linear"
+#endif
+
+static gnrc_netreg_entry_t _entries[ENTRIES_NUMOF];
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+
+static uint32_t _lookup(unsigned num, uint32_t offset)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < LOOKUPS_NUMOF; i++) {
+        uint32_t port = PORT_FIRST + ((i % num) * PORT_STEP) + offset;
+
+        if ((gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF, port) == NULL) !=
+            (offset != 0)) {
+            puts("wrong lookup result");
+            return 0;
+        }
+    }
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    /* gnrc_netreg_register() requires the target to have a message queue */
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+
+    puts("gnrc_netreg benchmark");
+    printf("demultiplexing: %s\n", VARIANT);
+    puts("entries |   hit ns |  miss ns");
+
+    for (unsigned num = 1; num <= ENTRIES_NUMOF; num <<= 1) {
+        gnrc_netreg_init();
+        for (unsigned i = 0; i < num; i++) {
+            gnrc_netreg_entry_init_pid(&_entries[i], PORT_FIRST + i * PORT_STEP,
+                                       thread_getpid());
+            gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &_entries[i]);
+        }
+        /* a port between the registered ones is never registered */
+        uint32_t hit = _lookup(num, 0);
+        uint32_t miss = _lookup(num, 1);
+
+        printf("%7u | %8lu | %8lu\n", num,
+               (unsigned long)(((uint64_t)hit * 1000) / LOOKUPS_NUMOF),
+               (unsigned long)(((uint64_t)miss * 1000) / LOOKUPS_NUMOF));
+    }
+
+    puts("Test done");
+    return 0;
+}
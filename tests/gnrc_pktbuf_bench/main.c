@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures allocation and release in the packet buffer
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+
+#define TEST_RUNS       (1000U)
+#define PKT_NUMOF       (4U)
+#define FILL_SIZE       (96U)
+
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+#define BACKEND         "slab"
+#else
+#define BACKEND         "static"
+#endif
+
+static gnrc_pktsnip_t *_fill[GNRC_PKTBUF_SIZE / FILL_SIZE];
+
+static void _print(const char *name, uint32_t usec, unsigned ops)
+{
+    printf("%-16s %6lu ns/op\n", name,
+           (unsigned long)(((uint64_t)usec * 1000) / ops));
+}
+
+/* allocates and releases packets of varying size, one at a time */
+static unsigned _add_release(void)
+{
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, 16 + (i % 8) * 64,
+                                              GNRC_NETTYPE_UNDEF);
+        if (pkt == NULL) {
+            return 0;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    return TEST_RUNS * 2;
+}
+
+/* bursty 6LoWPAN like traffic: frames arrive, headers get marked and the
+ * packets are released out of order */
+static unsigned _bursty(void)
+{
+    gnrc_pktsnip_t *pkts[PKT_NUMOF] = { NULL };
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        unsigned slot = (i * 3) % PKT_NUMOF;
+
+        if (pkts[slot] != NULL) {
+            gnrc_pktbuf_release(pkts[slot]);
+        }
+        pkts[slot] = gnrc_pktbuf_add(NULL, NULL, 102 + (i % 26),
+                                     GNRC_NETTYPE_UNDEF);
+        if ((pkts[slot] == NULL) ||
+            (gnrc_pktbuf_mark(pkts[slot], 2 + (i % 3),
+                              GNRC_NETTYPE_UNDEF) == NULL) ||
+            (gnrc_pktbuf_mark(pkts[slot], 40, GNRC_NETTYPE_UNDEF) == NULL)) {
+            return 0;
+        }
+    }
+    for (unsigned i = 0; i < PKT_NUMOF; i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    /* add, two marks and release per packet */
+    return TEST_RUNS * 4;
+}
+
+/* number of packets of FILL_SIZE bytes the buffer holds at once */
+static unsigned _capacity(void)
+{
+    unsigned n = 0;
+
+    while (n < (sizeof(_fill) / sizeof(_fill[0]))) {
+        _fill[n] = gnrc_pktbuf_add(NULL, NULL, FILL_SIZE, GNRC_NETTYPE_UNDEF);
+        if (_fill[n] == NULL) {
+            break;
+        }
+        n++;
+    }
+    for (unsigned i = 0; i < n; i++) {
+        gnrc_pktbuf_release(_fill[i]);
+    }
+    return n;
+}
+
+int main(void)
+{
+    uint32_t start;
+    unsigned ops;
+
+    puts("gnrc_pktbuf benchmark");
+    printf("backend: %s\n", BACKEND);
+
+    start = xtimer_now_usec();
+    ops = _add_release();
+    if (ops == 0) {
+        puts("add/release: allocation failed");
+        return 1;
+    }
+    _print("add/release:", xtimer_now_usec() - start, ops);
+
+    start = xtimer_now_usec();
+    ops = _bursty();
+    if (ops == 0) {
+        puts("bursty: allocation failed");
+        return 1;
+    }
+    _print("bursty:", xtimer_now_usec() - start, ops);
+
+    printf("capacity:        %6u packets of %u bytes\n", _capacity(),
+           FILL_SIZE);
+
+    gnrc_pktbuf_stats();
+
+    puts("Test done");
+    return 0;
+}
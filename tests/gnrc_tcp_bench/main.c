@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       TCP goodput benchmark
+ *
+ * One node runs a discard server, the other one connects to it, writes a
+ * number of bytes and reports the goodput.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/ipv6/addr.h"
+#include "net/sock/tcp.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define BENCH_PORT          (9U)
+#define BENCH_DEFAULT_SIZE  (64U * 1024U)
+#define BENCH_CHUNK_SIZE    (256U)
+
+static char _server_stack[THREAD_STACKSIZE_MAIN];
+static kernel_pid_t _server_pid = KERNEL_PID_UNDEF;
+static sock_tcp_t _server_socks[1];
+static sock_tcp_queue_t _server_queue;
+static uint8_t _server_buf[BENCH_CHUNK_SIZE];
+
+static sock_tcp_t _client_sock;
+static uint8_t _client_buf[BENCH_CHUNK_SIZE];
+
+static void _print_rate(const char *prefix, uint32_t bytes, uint64_t elapsed)
+{
+    printf("%s: %" PRIu32 " bytes in %" PRIu32 " us: %" PRIu32 " B/s\n",
+           prefix, bytes, (uint32_t)elapsed,
+           (elapsed > 0) ? (uint32_t)(((uint64_t)bytes * SEC_IN_USEC) / elapsed) : 0);
+}
+
+static void *_server(void *arg)
+{
+    sock_tcp_ep_t local = SOCK_IPV6_EP_ANY;
+
+    local.port = (uint16_t)(uintptr_t)arg;
+    if (sock_tcp_listen(&_server_queue, &local, _server_socks,
+                        sizeof(_server_socks) / sizeof(_server_socks[0]), 0) < 0) {
+        puts("error: unable to listen");
+        _server_pid = KERNEL_PID_UNDEF;
+        return NULL;
+    }
+    printf("discard server listening on port %u\n", local.port);
+    while (1) {
+        sock_tcp_t *sock;
+        uint32_t bytes = 0;
+        uint64_t start;
+        ssize_t res;
+
+        if (sock_tcp_accept(&_server_queue, &sock, SOCK_NO_TIMEOUT) < 0) {
+            continue;
+        }
+        start = xtimer_now_usec64();
+        while ((res = sock_tcp_read(sock, _server_buf, sizeof(_server_buf),
+                                    SOCK_NO_TIMEOUT)) > 0) {
+            bytes += res;
+        }
+        _print_rate((res == 0) ? "received" : "aborted", bytes,
+                    xtimer_now_usec64() - start);
+        sock_tcp_disconnect(sock);
+    }
+    return NULL;
+}
+
+static int _cmd_server(int argc, char **argv)
+{
+    unsigned port = (argc > 1) ? (unsigned)atoi(argv[1]) : BENCH_PORT;
+
+    if (_server_pid != KERNEL_PID_UNDEF) {
+        puts("server already running");
+        return 1;
+    }
+    _server_pid = thread_create(_server_stack, sizeof(_server_stack),
+                                THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                                _server, (void *)(uintptr_t)port, "discard");
+    return (_server_pid > KERNEL_PID_UNDEF) ? 0 : 1;
+}
+
+static int _cmd_bench(int argc, char **argv)
+{
+    sock_tcp_ep_t remote = SOCK_IPV6_EP_ANY;
+    uint32_t size, done = 0;
+    uint64_t start;
+    int res;
+
+    if (argc < 2) {
+        printf("usage: %s <addr> [<size> [<port>]]\n", argv[0]);
+        return 1;
+    }
+    if (ipv6_addr_from_str((ipv6_addr_t *)&remote.addr.ipv6, argv[1]) == NULL) {
+        puts("error: unable to parse server address");
+        return 1;
+    }
+    size = (argc > 2) ? (uint32_t)atoi(argv[2]) : BENCH_DEFAULT_SIZE;
+    remote.port = (argc > 3) ? (uint16_t)atoi(argv[3]) : BENCH_PORT;
+    memset(_client_buf, 0xaa, sizeof(_client_buf));
+
+    start = xtimer_now_usec64();
+    if ((res = sock_tcp_connect(&_client_sock, &remote, 0, 0)) < 0) {
+        printf("error: unable to connect (%d)\n", res);
+        return 1;
+    }
+    while (done < size) {
+        uint32_t chunk = size - done;
+
+        if (chunk > sizeof(_client_buf)) {
+            chunk = sizeof(_client_buf);
+        }
+        if ((res = sock_tcp_write(&_client_sock, _client_buf, chunk)) < 0) {
+            printf("error: unable to write (%d)\n", res);
+            break;
+        }
+        done += res;
+    }
+    /* returns once everything is acknowledged */
+    sock_tcp_disconnect(&_client_sock);
+    _print_rate((done == size) ? "sent" : "aborted", done,
+                xtimer_now_usec64() - start);
+    return 0;
+}
+
+static int _cmd_size(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    printf("sock_tcp_t: %u bytes, sock_tcp_queue_t: %u bytes\n",
+           (unsigned)sizeof(sock_tcp_t), (unsigned)sizeof(sock_tcp_queue_t));
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "server", "start the discard server [<port>]", _cmd_server },
+    { "bench", "measure the goodput to a discard server", _cmd_bench },
+    { "size", "print the RAM used per connection", _cmd_size },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    puts("TCP goodput benchmark");
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
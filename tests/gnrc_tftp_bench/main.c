@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       TFTP transfer rate benchmark
+ *
+ * One node runs a TFTP server for synthetic files, the other one reads or
+ * writes such a file and reports the bytes per second.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc/tftp.h"
+#include "net/ipv6/addr.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+/* must be a power of two, holds a window of the default size and more */
+#define BENCH_QUEUE_SIZE    (16)
+#define BENCH_DEFAULT_SIZE  (64U * 1024U)
+#define BENCH_FILE_NAME     "bench"
+
+static char _server_stack[THREAD_STACKSIZE_MAIN];
+static msg_t _server_msg_queue[BENCH_QUEUE_SIZE];
+static msg_t _main_msg_queue[BENCH_QUEUE_SIZE];
+static kernel_pid_t _server_pid = KERNEL_PID_UNDEF;
+
+static size_t _server_size;
+static size_t _client_size;
+static size_t _client_done;
+static tftp_event_t _client_event;
+
+/* serves a file of size bytes, or accepts any written data */
+static int _data(size_t size, uint32_t offset, void *data, size_t data_len,
+                 tftp_action_t action)
+{
+    if (action == TFTP_WRITE) {
+        return data_len;
+    }
+    if (offset >= size) {
+        return 0;
+    }
+    if (offset + data_len > size) {
+        data_len = size - offset;
+    }
+    memset(data, 0xaa, data_len);
+    return data_len;
+}
+
+static tftp_action_t _server_action[GNRC_TFTP_SERVER_SESSIONS];
+
+static bool _server_start_cb(tftp_action_t action, tftp_mode_t mode,
+                             const char *file_name, size_t *len)
+{
+    (void)mode;
+    (void)file_name;
+
+    _server_action[gnrc_tftp_server_session()] = action;
+    if (action == TFTP_READ) {
+        *len = _server_size;
+    }
+    return true;
+}
+
+static int _server_data_cb(uint32_t offset, void *data, size_t data_len)
+{
+    return _data(_server_size, offset, data, data_len,
+                 _server_action[gnrc_tftp_server_session()]);
+}
+
+static void _server_stop_cb(tftp_event_t event, const char *msg)
+{
+    if (event != TFTP_SUCCESS) {
+        printf("server: transfer failed: %s\n", (msg == NULL) ? "" : msg);
+    }
+}
+
+static void *_server(void *arg)
+{
+    (void)arg;
+
+    msg_init_queue(_server_msg_queue, BENCH_QUEUE_SIZE);
+    puts("TFTP server listening on port 69");
+    gnrc_tftp_server(_server_data_cb, _server_start_cb, _server_stop_cb, true);
+    _server_pid = KERNEL_PID_UNDEF;
+    return NULL;
+}
+
+static int _cmd_server(int argc, char **argv)
+{
+    _server_size = (argc > 1) ? (size_t)atoi(argv[1]) : BENCH_DEFAULT_SIZE;
+
+    if (_server_pid != KERNEL_PID_UNDEF) {
+        printf("serving %u bytes\n", (unsigned)_server_size);
+        return 0;
+    }
+    _server_pid = thread_create(_server_stack, sizeof(_server_stack),
+                                THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                                _server, NULL, "tftp");
+    return (_server_pid > KERNEL_PID_UNDEF) ? 0 : 1;
+}
+
+static bool _client_start_cb(tftp_action_t action, tftp_mode_t mode,
+                             const char *file_name, size_t *len)
+{
+    (void)action;
+    (void)mode;
+    (void)file_name;
+    (void)len;
+    return true;
+}
+
+static int _client_read_cb(uint32_t offset, void *data, size_t data_len)
+{
+    (void)data;
+
+    _client_done = offset + data_len;
+    return data_len;
+}
+
+static int _client_write_cb(uint32_t offset, void *data, size_t data_len)
+{
+    int res = _data(_client_size, offset, data, data_len, TFTP_READ);
+
+    _client_done = offset + res;
+    return res;
+}
+
+static void _client_stop_cb(tftp_event_t event, const char *msg)
+{
+    _client_event = event;
+    if (event != TFTP_SUCCESS) {
+        printf("transfer failed: %s\n", (msg == NULL) ? "" : msg);
+    }
+}
+
+static int _cmd_bench(int argc, char **argv)
+{
+    ipv6_addr_t addr;
+    bool options = true;
+    uint64_t start, elapsed;
+
+    if (argc < 3) {
+        printf("usage: %s <addr> <get|put> [<size> [lockstep]]\n", argv[0]);
+        return 1;
+    }
+    if (ipv6_addr_from_str(&addr, argv[1]) == NULL) {
+        puts("error: unable to parse server address");
+        return 1;
+    }
+    _client_size = (argc > 3) ? (size_t)atoi(argv[3]) : BENCH_DEFAULT_SIZE;
+    if ((argc > 4) && (strcmp(argv[4], "lockstep") == 0)) {
+        options = false;
+    }
+    _client_done = 0;
+    _client_event = TFTP_INTERN_ERROR;
+
+    start = xtimer_now_usec64();
+    if (strcmp(argv[2], "get") == 0) {
+        gnrc_tftp_client_read(&addr, BENCH_FILE_NAME, TTM_OCTET,
+                              _client_read_cb, _client_start_cb,
+                              _client_stop_cb, options);
+    }
+    else if (strcmp(argv[2], "put") == 0) {
+        gnrc_tftp_client_write(&addr, BENCH_FILE_NAME, TTM_OCTET,
+                               _client_write_cb, _client_size,
+                               _client_stop_cb, options);
+    }
+    else {
+        printf("error: unknown action %s\n", argv[2]);
+        return 1;
+    }
+    elapsed = xtimer_now_usec64() - start;
+
+    printf("%s: %u bytes in %" PRIu32 " us: %" PRIu32 " B/s\n",
+           (_client_event == TFTP_SUCCESS) ? "done" : "aborted",
+           (unsigned)_client_done, (uint32_t)elapsed,
+           (elapsed > 0) ? (uint32_t)(((uint64_t)_client_done * SEC_IN_USEC) / elapsed) : 0);
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "server", "start the TFTP server [<file size>]", _cmd_server },
+    { "bench", "measure the TFTP transfer rate to a server", _cmd_bench },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    /* the client runs in this thread and receives a window at once */
+    msg_init_queue(_main_msg_queue, BENCH_QUEUE_SIZE);
+
+    puts("TFTP transfer rate benchmark");
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       IPv6/UDP echo throughput benchmark
+ *
+ * One node runs an echo server, the other one keeps a window of packets in
+ * flight to it and reports the echoed packets per second.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define BENCH_PORT          (7U)
+#define BENCH_MAX_SIZE      (1024U)
+#define BENCH_TIMEOUT_US    (100U * MS_IN_USEC)
+
+static char _server_stack[THREAD_STACKSIZE_MAIN];
+static kernel_pid_t _server_pid = KERNEL_PID_UNDEF;
+static uint8_t _server_buf[BENCH_MAX_SIZE];
+static uint8_t _client_buf[BENCH_MAX_SIZE];
+
+static void *_server(void *arg)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_t sock;
+
+    local.port = (uint16_t)(uintptr_t)arg;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("error: unable to create server sock");
+        _server_pid = KERNEL_PID_UNDEF;
+        return NULL;
+    }
+    printf("echo server listening on port %u\n", local.port);
+    while (1) {
+        sock_udp_ep_t remote;
+        ssize_t res = sock_udp_recv(&sock, _server_buf, sizeof(_server_buf),
+                                    SOCK_NO_TIMEOUT, &remote);
+
+        if (res >= 0) {
+            sock_udp_send(&sock, _server_buf, res, &remote);
+        }
+    }
+    return NULL;
+}
+
+static int _cmd_server(int argc, char **argv)
+{
+    unsigned port = (argc > 1) ? (unsigned)atoi(argv[1]) : BENCH_PORT;
+
+    if (_server_pid != KERNEL_PID_UNDEF) {
+        puts("error: server already running");
+        return 1;
+    }
+    _server_pid = thread_create(_server_stack, sizeof(_server_stack),
+                                THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                                _server, (void *)(uintptr_t)port, "echo");
+    return (_server_pid > KERNEL_PID_UNDEF) ? 0 : 1;
+}
+
+static int _send(sock_udp_t *sock, size_t size, const sock_udp_ep_t *remote)
+{
+    return (sock_udp_send(sock, _client_buf, size, remote) < 0) ? 0 : 1;
+}
+
+static int _cmd_bench(int argc, char **argv)
+{
+    sock_udp_ep_t remote = SOCK_IPV6_EP_ANY;
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_t sock;
+    unsigned count, size, window, sent = 0, echoed = 0;
+    uint64_t start, elapsed;
+
+    if (argc < 3) {
+        printf("usage: %s <addr> <count> [<size> [<window> [<port>]]]\n", argv[0]);
+        return 1;
+    }
+    if (ipv6_addr_from_str((ipv6_addr_t *)&remote.addr.ipv6, argv[1]) == NULL) {
+        puts("error: unable to parse destination address");
+        return 1;
+    }
+    count = (unsigned)atoi(argv[2]);
+    size = (argc > 3) ? (unsigned)atoi(argv[3]) : 64;
+    window = (argc > 4) ? (unsigned)atoi(argv[4]) : 4;
+    remote.port = (argc > 5) ? (uint16_t)atoi(argv[5]) : BENCH_PORT;
+    if ((size > sizeof(_client_buf)) || (window == 0)) {
+        puts("error: invalid size or window");
+        return 1;
+    }
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("error: unable to create client sock");
+        return 1;
+    }
+    memset(_client_buf, 0xaa, size);
+
+    start = xtimer_now_usec64();
+    while ((sent < window) && (sent < count)) {
+        sent += _send(&sock, size, &remote);
+    }
+    while (echoed < sent) {
+        if (sock_udp_recv(&sock, _client_buf, sizeof(_client_buf),
+                          BENCH_TIMEOUT_US, NULL) < 0) {
+            /* the rest of the window got lost */
+            break;
+        }
+        echoed++;
+        if (sent < count) {
+            sent += _send(&sock, size, &remote);
+        }
+    }
+    elapsed = xtimer_now_usec64() - start;
+    sock_udp_close(&sock);
+
+    printf("%u of %u packets of %u bytes echoed in %" PRIu32 " us: %" PRIu32 " pps\n",
+           echoed, count, size, (uint32_t)elapsed,
+           (elapsed > 0) ? (uint32_t)((echoed * SEC_IN_USEC) / elapsed) : 0);
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "server", "start the UDP echo server [<port>]", _cmd_server },
+    { "bench", "measure the UDP echo rate to a server", _cmd_bench },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    puts("IPv6/UDP echo throughput benchmark");
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the throughput of the Hamming code over a NAND page
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "ecc/hamming256.h"
+#include "xtimer.h"
+
+#define RUNS_NUMOF      (100U)
+/* a 2 KiB NAND page */
+#define PAGE_SIZE       (2048U)
+
+static uint8_t _page[PAGE_SIZE];
+static uint8_t _ecc[HAMMING256_CODE_SIZE(PAGE_SIZE)];
+
+static void _print(const char *name, uint32_t us)
+{
+    printf("%-7s | %8lu | %8lu\n", name,
+           (unsigned long)(((uint64_t)us * 1000) / RUNS_NUMOF),
+           (us) ? (unsigned long)(((uint64_t)PAGE_SIZE * RUNS_NUMOF) / us) : 0UL);
+}
+
+int main(void)
+{
+    unsigned errors = 0;
+    uint32_t start;
+
+    for (unsigned i = 0; i < PAGE_SIZE; i++) {
+        _page[i] = (uint8_t)i;
+    }
+
+    puts("hamming256 benchmark");
+    printf("%u bytes per call\n", PAGE_SIZE);
+    puts("        |  ns/call | bytes/us");
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < RUNS_NUMOF; i++) {
+        hamming_compute256x(_page, PAGE_SIZE, _ecc);
+    }
+    _print("compute", xtimer_now_usec() - start);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < RUNS_NUMOF; i++) {
+        errors += hamming_verify256x(_page, PAGE_SIZE, _ecc);
+    }
+    _print("verify", xtimer_now_usec() - start);
+
+    if (errors != 0) {
+        puts("verification failed");
+        return 1;
+    }
+
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the throughput of SHA-256 and of HMAC-SHA256 with
+ *              and without a precomputed key
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "xtimer.h"
+
+#define TEST_LEN        (1024U)
+#define TEST_SMALL_LEN  (32U)
+#define TEST_RUNS       (200U)
+
+static uint8_t _data[TEST_LEN];
+static const uint8_t _key[] = "a key used for many messages";
+
+/* prints the throughput in MB/s with two decimal places */
+static void _print(const char *name, size_t len, uint32_t usec)
+{
+    uint64_t rate = ((uint64_t)len * TEST_RUNS * 100U) / (usec ? usec : 1);
+
+    printf("%-16s %4u bytes: %3u.%02u MB/s\n", name, (unsigned)len,
+           (unsigned)(rate / 100), (unsigned)(rate % 100));
+}
+
+static void _bench(size_t len)
+{
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    hmac_sha256_key_t hkey;
+    hmac_sha256_context_t ctx;
+    uint32_t start;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        sha256(_data, len, digest);
+    }
+    _print("sha256", len, xtimer_now_usec() - start);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        hmac_sha256(_key, sizeof(_key), _data, len, digest);
+    }
+    _print("hmac one-shot", len, xtimer_now_usec() - start);
+
+    hmac_sha256_key_init(&hkey, _key, sizeof(_key));
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        hmac_sha256_init(&ctx, &hkey);
+        hmac_sha256_update(&ctx, _data, len);
+        hmac_sha256_final(&ctx, digest);
+    }
+    _print("hmac precomputed", len, xtimer_now_usec() - start);
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < TEST_LEN; i++) {
+        _data[i] = (uint8_t)i;
+    }
+
+    _bench(TEST_SMALL_LEN);
+    _bench(TEST_LEN);
+
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the cycle time of reading sensors with blocking
+ *              and with asynchronous I2C transfers
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "i2c_async.h"
+#include "mutex.h"
+#include "xtimer.h"
+
+#define TEST_SENSORS    (10U)
+#define TEST_LEN        (4U)
+#define TEST_CYCLES     (100U)
+#define TEST_LOOPS      (2000U)
+
+static i2c_async_req_t _reqs[TEST_SENSORS];
+static uint8_t _buf[TEST_SENSORS][TEST_LEN];
+static unsigned _pending;
+static unsigned _errors;
+static mutex_t _done = MUTEX_INIT_LOCKED;
+
+/* stands in for processing the previous cycle's samples */
+static void _compute(void)
+{
+    for (volatile unsigned i = 0; i < TEST_LOOPS; i++) {}
+}
+
+static void _cb(i2c_async_req_t *req)
+{
+    if (req->res != TEST_LEN) {
+        _errors++;
+    }
+    if (--_pending == 0) {
+        mutex_unlock(&_done);
+    }
+}
+
+static uint32_t _cycle_blocking(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    i2c_acquire(I2C_DEV(TEST_I2C));
+    for (unsigned i = 0; i < TEST_SENSORS; i++) {
+        if (i2c_read_regs(I2C_DEV(TEST_I2C), TEST_ADDR, TEST_REG, _buf[i],
+                          TEST_LEN) != TEST_LEN) {
+            _errors++;
+        }
+    }
+    i2c_release(I2C_DEV(TEST_I2C));
+    _compute();
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _cycle_async(void)
+{
+    uint32_t start = xtimer_now_usec();
+
+    _pending = TEST_SENSORS;
+    for (unsigned i = 0; i < TEST_SENSORS; i++) {
+        i2c_async_submit(&_reqs[i]);
+    }
+    _compute();
+    mutex_lock(&_done);
+    return xtimer_now_usec() - start;
+}
+
+static void _run(const char *name, uint32_t (*cycle)(void))
+{
+    uint32_t sum = 0;
+    uint32_t max = 0;
+
+    _errors = 0;
+    for (unsigned i = 0; i < TEST_CYCLES; i++) {
+        uint32_t time = cycle();
+
+        sum += time;
+        if (time > max) {
+            max = time;
+        }
+    }
+    printf("%-8s cycle avg %6" PRIu32 " us max %6" PRIu32 " us, %u errors\n",
+           name, sum / TEST_CYCLES, max, _errors);
+}
+
+int main(void)
+{
+    puts("I2C asynchronous transfer benchmark");
+    printf("%u sensors, %u bytes each, at 0x%02x on I2C_DEV(%u)\n",
+           TEST_SENSORS, TEST_LEN, TEST_ADDR, TEST_I2C);
+
+    if (i2c_init_master(I2C_DEV(TEST_I2C), I2C_SPEED_NORMAL) < 0) {
+        puts("error: could not initialize I2C");
+        return 1;
+    }
+    for (unsigned i = 0; i < TEST_SENSORS; i++) {
+        _reqs[i].dev = I2C_DEV(TEST_I2C);
+        _reqs[i].addr = TEST_ADDR;
+        _reqs[i].reg = TEST_REG;
+        _reqs[i].flags = I2C_ASYNC_READ | I2C_ASYNC_REG;
+        _reqs[i].data = _buf[i];
+        _reqs[i].len = TEST_LEN;
+        _reqs[i].cb = _cb;
+    }
+
+    _run("blocking", _cycle_blocking);
+    _run("async", _cycle_async);
+    puts("Test done");
+    return 0;
+}
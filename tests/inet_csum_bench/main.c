@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the throughput of inet_csum()
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+#define RUNS_NUMOF      (1000U)
+/* an IPv6 MTU worth of payload */
+#define BUF_LEN         (1280U)
+
+static uint8_t _buf[BUF_LEN + 1];
+
+static uint16_t _run(const uint8_t *buf, const char *name)
+{
+    uint16_t csum = 0;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < RUNS_NUMOF; i++) {
+        csum = inet_csum(csum, buf, BUF_LEN);
+    }
+    start = xtimer_now_usec() - start;
+    printf("%-9s | %8lu | %8lu\n", name,
+           (unsigned long)(((uint64_t)start * 1000) / RUNS_NUMOF),
+           (start) ? (unsigned long)(((uint64_t)BUF_LEN * RUNS_NUMOF) / start)
+                   : 0UL);
+    return csum;
+}
+
+int main(void)
+{
+    uint16_t csum;
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        _buf[i] = (uint8_t)i;
+    }
+
+    puts("inet_csum benchmark");
+    printf("%u bytes per call\n", BUF_LEN);
+    puts("buffer    |  ns/call | bytes/us");
+    csum = _run(_buf, "aligned");
+    csum ^= _run(&_buf[1], "unaligned");
+    /* keeps the loops from being optimized out */
+    printf("checksum: 0x%04x\n", csum);
+
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the cost of the kernel's scheduling and IPC
+ *              primitives in CPU cycles
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "bootprof.h"
+#include "mbox.h"
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+
+#define TEST_RUNS       (1000U)
+#define TEST_FLAG       (0x1)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _main_pid;
+static mutex_t _mutex = MUTEX_INIT;
+
+static void _print(const char *name, uint32_t cycles, unsigned ops)
+{
+    printf("%-28s %10" PRIu32 "\n", name, cycles / ops);
+}
+
+/* runs fn as helper thread at the given priority, it must return after
+ * TEST_RUNS iterations */
+static kernel_pid_t _helper(void *(*fn)(void *), uint8_t prio)
+{
+    return thread_create(_stack, sizeof(_stack), prio,
+                         THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                         fn, NULL, "helper");
+}
+
+/* waits for the helper to send its done message */
+static void _join(void)
+{
+    msg_t msg;
+
+    msg_receive(&msg);
+}
+
+static void _done(void)
+{
+    msg_t msg;
+
+    msg_send(&msg, _main_pid);
+}
+
+static void *_yield(void *arg)
+{
+    (void)arg;
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        thread_yield();
+    }
+    _done();
+    return NULL;
+}
+
+static void _bench_yield(void)
+{
+    uint32_t start;
+
+    _helper(_yield, THREAD_PRIORITY_MAIN);
+    start = bootprof_cycles();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        thread_yield();
+    }
+    /* each yield switches to the helper and back */
+    _print("context switch (yield)", bootprof_cycles() - start, 2 * TEST_RUNS);
+    _join();
+}
+
+static void *_msg_echo(void *arg)
+{
+    (void)arg;
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        msg_reply(&msg, &msg);
+    }
+    _done();
+    return NULL;
+}
+
+static void _bench_msg(void)
+{
+    kernel_pid_t pid = _helper(_msg_echo, THREAD_PRIORITY_MAIN - 1);
+    uint32_t start = bootprof_cycles();
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        msg_t msg, reply;
+
+        msg_send_receive(&msg, &reply, pid);
+    }
+    _print("msg send/receive/reply", bootprof_cycles() - start, TEST_RUNS);
+    _join();
+}
+
+static void _bench_mutex(void)
+{
+    uint32_t start = bootprof_cycles();
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        mutex_lock(&_mutex);
+        mutex_unlock(&_mutex);
+    }
+    _print("mutex lock/unlock", bootprof_cycles() - start, TEST_RUNS);
+}
+
+static void *_mutex_waiter(void *arg)
+{
+    (void)arg;
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        thread_sleep();
+        mutex_lock(&_mutex);
+        mutex_unlock(&_mutex);
+    }
+    _done();
+    return NULL;
+}
+
+static void _bench_mutex_contended(void)
+{
+    kernel_pid_t pid = _helper(_mutex_waiter, THREAD_PRIORITY_MAIN - 1);
+    uint32_t start = bootprof_cycles();
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        mutex_lock(&_mutex);
+        /* the helper runs and blocks on the mutex */
+        thread_wakeup(pid);
+        /* hands the mutex to the helper */
+        mutex_unlock(&_mutex);
+    }
+    _print("mutex contended + wakeup", bootprof_cycles() - start, TEST_RUNS);
+    _join();
+}
+
+static void *_flags_echo(void *arg)
+{
+    thread_t *main_thread = (thread_t *)thread_get(_main_pid);
+
+    (void)arg;
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        thread_flags_wait_any(TEST_FLAG);
+        thread_flags_set(main_thread, TEST_FLAG);
+    }
+    _done();
+    return NULL;
+}
+
+static void _bench_thread_flags(void)
+{
+    kernel_pid_t pid = _helper(_flags_echo, THREAD_PRIORITY_MAIN - 1);
+    thread_t *helper = (thread_t *)thread_get(pid);
+    uint32_t start = bootprof_cycles();
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        thread_flags_set(helper, TEST_FLAG);
+        thread_flags_wait_any(TEST_FLAG);
+    }
+    _print("thread_flags set/wait", bootprof_cycles() - start, TEST_RUNS);
+    _join();
+}
+
+static void _bench_mbox(void)
+{
+    msg_t queue[1];
+    mbox_t mbox;
+    uint32_t start;
+
+    mbox_init(&mbox, queue, sizeof(queue) / sizeof(queue[0]));
+    start = bootprof_cycles();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        msg_t msg;
+
+        mbox_put(&mbox, &msg);
+        mbox_get(&mbox, &msg);
+    }
+    _print("mbox put/get", bootprof_cycles() - start, TEST_RUNS);
+}
+
+static void _bench_xtimer(void)
+{
+    xtimer_t timer = { .callback = NULL };
+    uint32_t start = bootprof_cycles();
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        xtimer_set(&timer, SEC_IN_USEC);
+        xtimer_remove(&timer);
+    }
+    _print("xtimer set/remove", bootprof_cycles() - start, TEST_RUNS);
+}
+
+int main(void)
+{
+    _main_pid = thread_getpid();
+
+    printf("kernel benchmark on %s", RIOT_BOARD);
+#ifdef CLOCK_CORECLOCK
+    printf(" at %" PRIu32 " Hz", (uint32_t)CLOCK_CORECLOCK);
+#endif
+    printf(", %u runs\n", TEST_RUNS);
+    printf("%-28s %10s\n", "operation", "cycles/op");
+
+    _bench_yield();
+    _bench_msg();
+    _bench_mutex();
+    _bench_mutex_contended();
+    _bench_thread_flags();
+    _bench_mbox();
+    _bench_xtimer();
+
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures write latency and erase counts of the log-structured
+ *              key/value store
+ *
+ * The store runs on a RAM disk, so the latencies exclude the flash; the
+ * erase counts are what the flash would see.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "kvlog.h"
+#include "xtimer.h"
+
+#define SECTOR_SIZE     (512U)
+#define SECTORS         (4U)
+#define KEYS            (8U)
+#define VALUE_LEN       (16U)
+#define TEST_RUNS       (2000U)
+
+static uint8_t _mem[SECTOR_SIZE * SECTORS];
+static kvlog_t _kv;
+
+static int _read(nvram_t *dev, uint8_t *dst, uint32_t src, size_t len)
+{
+    (void)dev;
+    memcpy(dst, &_mem[src], len);
+    return len;
+}
+
+static int _write(nvram_t *dev, const uint8_t *src, uint32_t dst, size_t len)
+{
+    (void)dev;
+    memcpy(&_mem[dst], src, len);
+    return len;
+}
+
+static nvram_t _dev = {
+    .read = _read,
+    .write = _write,
+    .size = sizeof(_mem),
+};
+
+static void _bench(const char *name, int compact)
+{
+    uint8_t val[VALUE_LEN];
+    uint32_t total = 0, max = 0;
+    uint32_t min_erases = UINT32_MAX, max_erases = 0;
+
+    memset(_mem, 0xff, sizeof(_mem));
+    kvlog_init(&_kv, &_dev, 0, SECTOR_SIZE, SECTORS);
+    _kv.erases = 0;
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        uint32_t start, time;
+
+        memset(val, i, sizeof(val));
+        start = xtimer_now_usec();
+        if (kvlog_set(&_kv, i % KEYS, val, sizeof(val)) < 0) {
+            printf("%s: write %u failed\n", name, i);
+            return;
+        }
+        time = xtimer_now_usec() - start;
+        total += time;
+        max = (time > max) ? time : max;
+        if (compact) {
+            /* what a low priority thread does while the writer waits */
+            kvlog_compact(&_kv);
+        }
+    }
+
+    for (unsigned i = 0; i < SECTORS; i++) {
+        uint32_t count;
+
+        memcpy(&count, &_mem[i * SECTOR_SIZE], sizeof(count));
+        min_erases = (count < min_erases) ? count : min_erases;
+        max_erases = (count > max_erases) ? count : max_erases;
+    }
+
+    printf("%-12s avg %4u us, max %5u us, %4u erases (%u..%u per sector)\n",
+           name, (unsigned)(total / TEST_RUNS), (unsigned)max,
+           (unsigned)_kv.erases, (unsigned)min_erases, (unsigned)max_erases);
+}
+
+int main(void)
+{
+    printf("%u updates of %u keys, %u sectors of %u bytes\n", TEST_RUNS, KEYS,
+           SECTORS, SECTOR_SIZE);
+    printf("rewriting in place: %u erases of one sector\n", TEST_RUNS);
+
+    _bench("inline", 0);
+    _bench("background", 1);
+
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2016 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare message throughput of msg_send()/msg_receive() and
+ *              msg_send_bulk()/msg_receive_bulk()
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_MSG_NUM
+#define TEST_MSG_NUM    (10000U)
+#endif
+
+#define BULK_SIZE       (8U)
+#define QUEUE_SIZE      (8U)
+
+static char rcv_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t rcv_queue[QUEUE_SIZE];
+static kernel_pid_t rcv_pid;
+
+static volatile unsigned received;
+static volatile uint32_t checksum;
+
+static void *rcv(void *arg)
+{
+    msg_t msgs[BULK_SIZE];
+    (void)arg;
+
+    msg_init_queue(rcv_queue, QUEUE_SIZE);
+
+    while (1) {
+        int n = msg_receive_bulk(msgs, BULK_SIZE);
+        for (int i = 0; i < n; i++) {
+            checksum += msgs[i].content.value;
+        }
+        received += n;
+    }
+
+    return NULL;
+}
+
+static uint32_t expected_checksum(void)
+{
+    return (TEST_MSG_NUM * (TEST_MSG_NUM - 1)) / 2;
+}
+
+static uint32_t run_single(void)
+{
+    msg_t msg;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_MSG_NUM; i++) {
+        msg.content.value = i;
+        msg_send(&msg, rcv_pid);
+    }
+
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t run_bulk(void)
+{
+    msg_t msgs[BULK_SIZE];
+    unsigned i = 0;
+    uint32_t start = xtimer_now_usec();
+
+    while (i < TEST_MSG_NUM) {
+        unsigned n = 0;
+        while ((n < BULK_SIZE) && ((i + n) < TEST_MSG_NUM)) {
+            msgs[n].content.value = i + n;
+            n++;
+        }
+        unsigned sent = 0;
+        while (sent < n) {
+            int res = msg_send_bulk(&msgs[sent], n - sent, rcv_pid);
+            if (res < 0) {
+                return 0;
+            }
+            sent += res;
+        }
+        i += n;
+    }
+
+    return xtimer_now_usec() - start;
+}
+
+static int report(const char *name, uint32_t usec)
+{
+    if ((received != TEST_MSG_NUM) || (checksum != expected_checksum())) {
+        printf("%s: received %u of %u messages or checksum mismatch\n",
+               name, received, TEST_MSG_NUM);
+        return -1;
+    }
+    printf("%s: %u messages in %" PRIu32 " us (%" PRIu32 " msg/s)\n",
+           name, TEST_MSG_NUM, usec,
+           (uint32_t)((TEST_MSG_NUM * 1000000ULL) / (usec ? usec : 1)));
+    received = 0;
+    checksum = 0;
+    return 0;
+}
+
+int main(void)
+{
+    int res = 0;
+
+    puts("msg bulk throughput test");
+
+    rcv_pid = thread_create(rcv_stack, sizeof(rcv_stack),
+                            THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                            rcv, NULL, "rcv");
+
+    res |= report("msg_send", run_single());
+    res |= report("msg_send_bulk", run_bulk());
+
+    if (res == 0) {
+        puts("Test successful.");
+    }
+    else {
+        puts("Test failed.");
+    }
+
+    return 0;
+}
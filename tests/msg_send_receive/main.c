@@ -11,7 +11,7 @@
  * @{
  *
  * @file
- * @brief       Test msg_send_receive().
+ * @brief       Test msg_send_receive() and measure its round trip time.
  *
  * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
  * @author      René Kijewski <rene.kijewski@fu-berlin.de>
@@ -20,10 +20,12 @@
  * @}
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "cpu_conf.h"
 #include "thread.h"
+#include "xtimer.h"
 
 #define THREAD1_STACKSIZE   (THREAD_STACKSIZE_MAIN)
 #define THREAD2_STACKSIZE   (THREAD_STACKSIZE_MAIN)
@@ -32,6 +34,10 @@
 #define TEST_EXECUTION_NUM  (10)
 #endif
 
+#ifndef TEST_PINGPONG_NUM
+#define TEST_PINGPONG_NUM   (1000)
+#endif
+
 static char thread1_stack[THREAD1_STACKSIZE];
 static char thread2_stack[THREAD2_STACKSIZE];
 
@@ -63,6 +69,13 @@ static void *thread1(void *args)
     }
 
     if (success) {
+        uint32_t start = xtimer_now_usec();
+
+        for (int i = 0; i < TEST_PINGPONG_NUM; i++) {
+            msg_send_receive(&msg_req, &msg_resp, thread2_pid);
+        }
+        printf("Round trip: %" PRIu32 " us per msg_send_receive()\n",
+               (xtimer_now_usec() - start) / TEST_PINGPONG_NUM);
         puts("Test successful.");
     }
     else {
@@ -91,6 +104,11 @@ static void *thread2(void *args)
         msg_reply(&msg_req, &msg_resp);
     }
 
+    for (int i = 0; i < TEST_PINGPONG_NUM; i++) {
+        msg_receive(&msg_req);
+        msg_reply(&msg_req, &msg_resp);
+    }
+
     return NULL;
 }
 
@@ -13,6 +13,7 @@ sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
 import testrunner
 
 def testfunc(child):
+    child.expect(u"Round trip: \\d+ us per msg_send_receive\\(\\)")
     child.expect(u"Test successful.")
 
 if __name__ == "__main__":
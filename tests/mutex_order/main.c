@@ -21,9 +21,16 @@
 
 #include "mutex.h"
 #include "thread.h"
+#include "xtimer.h"
 
 #define THREAD_NUMOF            (5U)
 
+/* timing of the priority inversion scenario in microseconds */
+#define LOW_HOLD_US             (5000U)
+#define MID_HOG_US              (20000U)
+#define HIGH_DELAY_US           (1000U)
+#define MID_DELAY_US            (2000U)
+
 extern volatile thread_t *sched_active_thread;
 
 static char stacks[THREAD_NUMOF][THREAD_STACKSIZE_MAIN];
@@ -50,6 +57,69 @@ static void *lockme(void *arg)
     return NULL;
 }
 
+static mutex_t pilock;
+static uint32_t high_wait;
+
+static void _spin(uint32_t us)
+{
+    uint32_t start = xtimer_now_usec();
+    while ((xtimer_now_usec() - start) < us) {}
+}
+
+static void *pi_low(void *arg)
+{
+    (void)arg;
+    mutex_lock(&pilock);
+    _spin(LOW_HOLD_US);
+    mutex_unlock(&pilock);
+    return NULL;
+}
+
+static void *pi_mid(void *arg)
+{
+    (void)arg;
+    xtimer_usleep(MID_DELAY_US);
+    _spin(MID_HOG_US);
+    return NULL;
+}
+
+static void *pi_high(void *arg)
+{
+    (void)arg;
+    xtimer_usleep(HIGH_DELAY_US);
+    uint32_t start = xtimer_now_usec();
+    mutex_lock(&pilock);
+    high_wait = xtimer_now_usec() - start;
+    mutex_unlock(&pilock);
+    return NULL;
+}
+
+static void measure_inversion(void)
+{
+    mutex_init(&pilock);
+
+    /* high and mid go to sleep right away, low locks the mutex and keeps it
+     * for LOW_HOLD_US. Without priority inheritance, mid preempts low and
+     * high has to wait for both. */
+    thread_create(stacks[0], sizeof(stacks[0]), THREAD_PRIORITY_MAIN - 3, 0,
+                  pi_high, NULL, "high");
+    thread_create(stacks[1], sizeof(stacks[1]), THREAD_PRIORITY_MAIN - 2, 0,
+                  pi_mid, NULL, "mid");
+    thread_create(stacks[2], sizeof(stacks[2]), THREAD_PRIORITY_MAIN - 1, 0,
+                  pi_low, NULL, "low");
+
+    xtimer_usleep(LOW_HOLD_US + MID_HOG_US + MID_DELAY_US);
+
+    printf("Priority inversion: high waited %lu us for the mutex "
+           "(low holds it for %u us, mid hogs the CPU for %u us)\n",
+           (unsigned long)high_wait, LOW_HOLD_US, MID_HOG_US);
+#ifdef MODULE_CORE_MUTEX_PI
+    puts("core_mutex_pi enabled, expected wait is below the hold time");
+#else
+    puts("core_mutex_pi disabled, expected wait includes the hog time");
+#endif
+}
+
 int main(void)
 {
     puts("Mutex order test");
@@ -70,5 +140,7 @@ int main(void)
     mutex_lock(&testlock);
     puts("\nTest END, check the order of priorities above.");
 
+    measure_inversion();
+
     return 0;
 }
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for continuous ADC sampling
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "analog_util.h"
+#include "irq.h"
+#include "periph/adc.h"
+#include "xtimer.h"
+
+#define LINE            ADC_LINE(0)
+#define RES             ADC_RES_12BIT
+#define FREQ            (20000U)
+#define BUF_LEN         (1000U)
+#define TEST_SECONDS    (5U)
+
+static uint16_t _buf[BUF_LEN];
+static volatile unsigned _blocks;
+static volatile unsigned _samples;
+static adc_util_stats_t _stats;
+
+static void _cb(void *arg, const uint16_t *samples, size_t len)
+{
+    (void)arg;
+    adc_util_block_stats(samples, len, &_stats);
+    _samples += len;
+    _blocks++;
+}
+
+int main(void)
+{
+    puts("\nRIOT continuous ADC sampling test\n");
+    printf("Sampling ADC_LINE(0) at %u Hz in blocks of %u samples\n\n",
+           FREQ, BUF_LEN / 2);
+
+    if (adc_init(LINE) < 0) {
+        puts("Initialization of ADC_LINE(0) failed");
+        return 1;
+    }
+    if (adc_continuous_start(LINE, RES, FREQ, _buf, BUF_LEN, _cb, NULL) < 0) {
+        puts("Starting continuous sampling failed");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < TEST_SECONDS; i++) {
+        xtimer_sleep(1);
+
+        unsigned state = irq_disable();
+        unsigned samples = _samples;
+        unsigned blocks = _blocks;
+        adc_util_stats_t stats = _stats;
+        _samples = 0;
+        _blocks = 0;
+        irq_restore(state);
+
+        printf("%u samples in %u blocks, last block: min %u max %u mean %u "
+               "rms %u\n", samples, blocks, stats.min, stats.max, stats.mean,
+               stats.rms);
+    }
+
+    adc_continuous_stop(LINE);
+    puts("Test done");
+    return 0;
+}
@@ -164,6 +164,41 @@ static int cmd_write(int argc, char **argv)
     return 0;
 }
 
+#ifdef FLASHPAGE_RAW_BLOCKSIZE
+static int cmd_write_raw(int argc, char **argv)
+{
+    /* aligned buffer, the data is padded to whole blocks */
+    static uint32_t raw_buf[64 / sizeof(uint32_t)];
+    uint32_t addr;
+    size_t len;
+
+    if (argc < 3) {
+        printf("usage: %s <addr> <data>\n", argv[0]);
+        return 1;
+    }
+
+    addr = strtoul(argv[1], NULL, 0);
+    if (addr % FLASHPAGE_RAW_ALIGNMENT) {
+        printf("error: addr must be aligned to %i bytes\n",
+               (int)FLASHPAGE_RAW_ALIGNMENT);
+        return 1;
+    }
+    len = strlen(argv[2]);
+    if (len > sizeof(raw_buf)) {
+        len = sizeof(raw_buf);
+    }
+    memset(raw_buf, 0xff, sizeof(raw_buf));
+    memcpy(raw_buf, argv[2], len);
+    len = ((len + FLASHPAGE_RAW_BLOCKSIZE - 1) / FLASHPAGE_RAW_BLOCKSIZE) *
+          FLASHPAGE_RAW_BLOCKSIZE;
+
+    flashpage_write_raw((void *)addr, raw_buf, len);
+
+    printf("wrote %u bytes to addr 0x%08x\n", (unsigned)len, (unsigned)addr);
+    return 0;
+}
+#endif
+
 static int cmd_erase(int argc, char **argv)
 {
     int page;
@@ -248,6 +283,10 @@ static const shell_command_t shell_commands[] = {
     { "dump_local", "Dump the local page buffer to STDOUT", cmd_dump_local },
     { "read", "Read and output the given page", cmd_read },
     { "write", "Write (ASCII) data to the given page", cmd_write },
+#ifdef FLASHPAGE_RAW_BLOCKSIZE
+    { "write_raw", "Write (ASCII) data to erased flash at the given address",
+      cmd_write_raw },
+#endif
     { "erase", "Erase the given page", cmd_erase },
     { "edit", "Write bytes to the local page", cmd_edit },
     { "test", "Write and verify test pattern", cmd_test },
@@ -22,8 +22,11 @@
 #include <stdlib.h>
 
 #include "shell.h"
+#include "xtimer.h"
 #include "periph/gpio.h"
 
+#define BENCH_RUNS_DEFAULT      (1000UL * 100)
+
 static void cb(void *arg)
 {
     printf("INT: external interrupt from pin %i\n", (int)arg);
@@ -203,6 +206,65 @@ static int toggle(int argc, char **argv)
     return 0;
 }
 
+static void bench_print(const char *name, unsigned long runs, uint32_t time)
+{
+    unsigned long rate = (time) ? ((uint64_t)runs * SEC_IN_USEC) / time : 0;
+
+    printf("%-20s %8lu toggles in %10lu us, %9lu toggles/s\n", name, runs,
+           (unsigned long)time, rate);
+}
+
+static int bench(int argc, char **argv)
+{
+    if (argc < 3) {
+        printf("usage: %s <port> <pin> [# of runs]\n", argv[0]);
+        return 1;
+    }
+
+    gpio_t pin = GPIO_PIN(atoi(argv[1]), atoi(argv[2]));
+    unsigned long runs = BENCH_RUNS_DEFAULT;
+    uint32_t time;
+
+    if (argc > 3) {
+        runs = (unsigned long)atol(argv[3]);
+    }
+
+    puts("\nGPIO driver toggle benchmark\n");
+
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < runs; i++) {
+        gpio_toggle(pin);
+    }
+    bench_print("gpio_toggle", runs, xtimer_now_usec() - time);
+
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < runs / 2; i++) {
+        gpio_set(pin);
+        gpio_clear(pin);
+    }
+    bench_print("gpio_set/clear", runs, xtimer_now_usec() - time);
+
+#ifdef PERIPH_GPIO_HAS_PORT
+    uint32_t mask = (1UL << atoi(argv[2]));
+
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < runs; i++) {
+        gpio_port_toggle(pin, mask);
+    }
+    bench_print("gpio_port_toggle", runs, xtimer_now_usec() - time);
+
+    time = xtimer_now_usec();
+    for (unsigned long i = 0; i < runs / 2; i++) {
+        gpio_port_write(pin, mask, mask);
+        gpio_port_write(pin, mask, 0);
+    }
+    bench_print("gpio_port_write", runs, xtimer_now_usec() - time);
+#endif
+
+    puts("\n --- DONE ---");
+    return 0;
+}
+
 static const shell_command_t shell_commands[] = {
     { "init_out", "init as output (push-pull mode)", init_out },
     { "init_in", "init as input w/o pull resistor", init_in },
@@ -215,6 +277,7 @@ static const shell_command_t shell_commands[] = {
     { "set", "set pin to HIGH", set },
     { "clear", "set pin to LOW", clear },
     { "toggle", "toggle pin", toggle },
+    { "bench", "run a set of predefined benchmarks", bench },
     { NULL, NULL, NULL }
 };
 
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tokenizes a JSON document in small chunks and picks values by
+ *              their path
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "jsmn_stream.h"
+
+#define CHUNK_LEN       (7U)
+
+static const char *JSON_STRING =
+    "{\"user\": \"johndoe\", \"admin\": false, \"uid\": 1000,\n  "
+    "\"groups\": [\"users\", \"wheel\", \"audio\", \"video\"]}";
+
+static void _cb(jsmn_stream_t *stream, jsmntype_t type, const char *path,
+                const char *value, size_t len, void *arg)
+{
+    (void)stream;
+    (void)len;
+    unsigned *groups = arg;
+
+    if (strcmp(path, "/user") == 0) {
+        printf("- User: %s\n", value);
+    }
+    else if (strcmp(path, "/admin") == 0) {
+        printf("- Admin: %s\n", value);
+    }
+    else if (strcmp(path, "/uid") == 0) {
+        printf("- UID: %s\n", value);
+    }
+    else if (strcmp(path, "/groups") == 0) {
+        printf("- Groups:\n");
+    }
+    else if ((strncmp(path, "/groups/", 8) == 0) && (type == JSMN_STRING)) {
+        printf("  * %s\n", value);
+        (*groups)++;
+    }
+}
+
+int main(void)
+{
+    jsmn_stream_t stream;
+    unsigned groups = 0;
+    size_t len = strlen(JSON_STRING);
+    int res;
+
+    jsmn_stream_init(&stream, _cb, &groups);
+    /* feed the document as if it arrived in small packets */
+    for (size_t i = 0; i < len; i += CHUNK_LEN) {
+        size_t chunk = ((len - i) < CHUNK_LEN) ? (len - i) : CHUNK_LEN;
+
+        res = jsmn_stream_feed(&stream, &JSON_STRING[i], chunk);
+        if (res < 0) {
+            printf("Failed to parse JSON: %d\n", res);
+            return 1;
+        }
+    }
+    res = jsmn_stream_finish(&stream);
+    if (res < 0) {
+        printf("Incomplete JSON: %d\n", res);
+        return 1;
+    }
+    printf("%u groups, %u bytes of tokenizer state\n", groups,
+           (unsigned)sizeof(stream));
+
+    return 0;
+}
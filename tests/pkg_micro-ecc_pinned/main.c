@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares ECDSA verification with and without pinned key
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "uECC.h"
+#include "uecc_pinned.h"
+#include "xtimer.h"
+
+#define SIGS            (8U)
+
+typedef struct {
+    uECC_HashContext uECC;
+    sha256_context_t ctx;
+} sha256_hash_context_t;
+
+/* pre-generated key pair, as not every board has a hardware RNG */
+static const uint8_t _private[] = {
+    0x9b, 0x4c, 0x4b, 0xa0, 0xb7, 0xb1, 0x25, 0x23,
+    0x9c, 0x09, 0x85, 0x4f, 0x9a, 0x21, 0xb4, 0x14,
+    0x70, 0xe0, 0xce, 0x21, 0x25, 0x00, 0xa5, 0x62,
+    0x34, 0xa4, 0x25, 0xf0, 0x0f, 0x00, 0xeb, 0xe7,
+};
+static const uint8_t _public[] = {
+    0x54, 0x3e, 0x98, 0xf8, 0x14, 0x55, 0x08, 0x13,
+    0xb5, 0x1a, 0x1d, 0x02, 0x02, 0xd7, 0x0e, 0xab,
+    0xa0, 0x98, 0x74, 0x61, 0x91, 0x12, 0x3d, 0x96,
+    0x50, 0xfa, 0xd5, 0x94, 0xa2, 0x86, 0xa8, 0xb0,
+    0xd0, 0x7b, 0xda, 0x36, 0xba, 0x8e, 0xd3, 0x9a,
+    0xa0, 0x16, 0x11, 0x0e, 0x1b, 0x6e, 0x81, 0x13,
+    0xd7, 0xf4, 0x23, 0xa1, 0xb2, 0x9b, 0xaf, 0xf6,
+    0x6b, 0xc4, 0x2a, 0xdf, 0xbd, 0xe4, 0x61, 0x5c,
+};
+
+static uint8_t _hash[SIGS][SHA256_DIGEST_LENGTH];
+static uint8_t _sig[SIGS][64];
+static uint8_t _tmp[2 * SHA256_DIGEST_LENGTH + SHA256_INTERNAL_BLOCK_SIZE];
+static uecc_pinned_t _key;
+
+static void _init_sha256(const uECC_HashContext *base)
+{
+    sha256_hash_context_t *context = (sha256_hash_context_t *)base;
+
+    sha256_init(&context->ctx);
+}
+
+static void _update_sha256(const uECC_HashContext *base,
+                           const uint8_t *message, unsigned message_size)
+{
+    sha256_hash_context_t *context = (sha256_hash_context_t *)base;
+
+    sha256_update(&context->ctx, message, message_size);
+}
+
+static void _finish_sha256(const uECC_HashContext *base, uint8_t *hash_result)
+{
+    sha256_hash_context_t *context = (sha256_hash_context_t *)base;
+
+    sha256_final(&context->ctx, hash_result);
+}
+
+static void _print(const char *name, uint32_t usec, unsigned ops)
+{
+    printf("%-20s %12" PRIu32 "\n", name, usec / ops);
+}
+
+int main(void)
+{
+    uECC_Curve curve = uECC_secp256r1();
+    sha256_hash_context_t ctx = {
+        .uECC = {
+            .init_hash = _init_sha256,
+            .update_hash = _update_sha256,
+            .finish_hash = _finish_sha256,
+            .block_size = SHA256_INTERNAL_BLOCK_SIZE,
+            .result_size = SHA256_DIGEST_LENGTH,
+            .tmp = _tmp,
+        },
+    };
+    unsigned errors = 0;
+    uint32_t start;
+
+    printf("micro-ecc pinned key benchmark on %s, %u signatures\n",
+           RIOT_BOARD, SIGS);
+    for (unsigned i = 0; i < SIGS; i++) {
+        uint8_t msg = i;
+
+        sha256(&msg, sizeof(msg), _hash[i]);
+        if (!uECC_sign_deterministic(_private, _hash[i], sizeof(_hash[i]),
+                                     &ctx.uECC, _sig[i], curve)) {
+            puts("error: signing failed");
+            return 1;
+        }
+    }
+    printf("%-20s %12s\n", "operation", "us/op");
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < SIGS; i++) {
+        errors += !uECC_verify(_public, _hash[i], sizeof(_hash[i]), _sig[i],
+                               curve);
+    }
+    _print("uECC_verify", xtimer_now_usec() - start, SIGS);
+
+    start = xtimer_now_usec();
+    if (uecc_pinned_init(&_key, _public, curve) < 0) {
+        puts("error: pinning the key failed");
+        return 1;
+    }
+    _print("uecc_pinned_init", xtimer_now_usec() - start, 1);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < SIGS; i++) {
+        errors += !uecc_pinned_verify(&_key, _hash[i], sizeof(_hash[i]),
+                                      _sig[i]);
+    }
+    _print("uecc_pinned_verify", xtimer_now_usec() - start, SIGS);
+
+    _sig[0][7] ^= 0x10;
+    errors += uECC_verify(_public, _hash[0], sizeof(_hash[0]), _sig[0], curve);
+    errors += uecc_pinned_verify(&_key, _hash[0], sizeof(_hash[0]), _sig[0]);
+
+    if (errors != 0) {
+        printf("error: %u verification(s) failed\n", errors);
+        return 1;
+    }
+    puts("Test done");
+    return 0;
+}
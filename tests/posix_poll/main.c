@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for poll() and non-blocking sockets
+ *
+ * Sends UDP datagrams over the loopback address and checks that poll()
+ * reports them.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "msg.h"
+
+#define TEST_PORT       (61616)
+#define TEST_TIMEOUT    (100)   /* in ms */
+
+#define MAIN_QUEUE_SIZE (8)
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+
+static char _buf[16];
+
+static int _check(int cond, const char *msg)
+{
+    if (!cond) {
+        printf("FAILED: %s (errno: %d)\n", msg, errno);
+    }
+    return !cond;
+}
+
+int main(void)
+{
+    struct sockaddr_in6 addr;
+    struct pollfd pfd;
+    int server, client, res;
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    puts("posix_poll test");
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin6_family = AF_INET6;
+    addr.sin6_port = htons(TEST_PORT);
+    server = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    client = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    if (_check((server >= 0) && (client >= 0), "socket") ||
+        _check(bind(server, (struct sockaddr *)&addr, sizeof(addr)) == 0, "bind")) {
+        return 1;
+    }
+
+    pfd.fd = server;
+    pfd.events = POLLIN;
+    res = poll(&pfd, 1, TEST_TIMEOUT);
+    if (_check(res == 0, "poll() on empty socket")) {
+        return 1;
+    }
+    res = recv(server, _buf, sizeof(_buf), MSG_DONTWAIT);
+    if (_check((res < 0) && (errno == EAGAIN), "recv(MSG_DONTWAIT)")) {
+        return 1;
+    }
+    if (_check(fcntl(server, F_SETFL, O_NONBLOCK) == 0, "fcntl(F_SETFL)") ||
+        _check(fcntl(server, F_GETFL) == O_NONBLOCK, "fcntl(F_GETFL)")) {
+        return 1;
+    }
+    res = recv(server, _buf, sizeof(_buf), 0);
+    if (_check((res < 0) && (errno == EAGAIN), "recv(O_NONBLOCK)")) {
+        return 1;
+    }
+    puts("empty socket: OK");
+
+    inet_pton(AF_INET6, "::1", &addr.sin6_addr);
+    res = sendto(client, "hello", sizeof("hello"), 0, (struct sockaddr *)&addr,
+                 sizeof(addr));
+    if (_check(res == sizeof("hello"), "sendto")) {
+        return 1;
+    }
+    pfd.revents = 0;
+    res = poll(&pfd, 1, -1);
+    if (_check((res == 1) && (pfd.revents & POLLIN), "poll() on datagram")) {
+        return 1;
+    }
+    res = recv(server, _buf, sizeof(_buf), 0);
+    if (_check((res == sizeof("hello")) && (strcmp(_buf, "hello") == 0), "recv")) {
+        return 1;
+    }
+    puts("datagram: OK");
+
+    close(client);
+    close(server);
+    puts("SUCCESS");
+    return 0;
+}
@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include "pthread.h"
 #include "thread.h"
+#include "xtimer.h"
 
 static mutex_t mutex = MUTEX_INIT;
 static pthread_cond_t cv;
@@ -29,6 +30,27 @@ static volatile long count;
 static volatile long expected_value;
 static char stack[THREAD_STACKSIZE_MAIN];
 
+static unsigned schedules(kernel_pid_t pid)
+{
+#ifdef MODULE_SCHEDSTATISTICS
+    return sched_pidlist[pid].schedules;
+#else
+    (void) pid;
+    return 0;
+#endif
+}
+
+/**
+ * @brief   Prints the time and the number of context switches per round trip
+ */
+static void print_stats(uint32_t usec, unsigned switches)
+{
+    printf("%ld round trips: %lu ns and %u.%02u context switches per round trip\n",
+           count, (unsigned long)(((uint64_t)usec * 1000u) / count),
+           (unsigned)(((uint64_t)switches * 100u / count) / 100u),
+           (unsigned)(((uint64_t)switches * 100u / count) % 100u));
+}
+
 /**
  * @brief   This thread tries to lock the mutex to enter the critical section.
  *          Then it signals one waiting thread to check the condition and it goes to sleep again
@@ -60,6 +82,8 @@ int main(void)
     kernel_pid_t pid = thread_create(stack,sizeof(stack), THREAD_PRIORITY_MAIN - 1,
                                      THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
                                      second_thread, NULL, "second_thread");
+    unsigned start_switches = schedules(pid) + schedules(thread_getpid());
+    uint32_t start = xtimer_now_usec();
 
     while (1) {
         mutex_lock(&mutex);
@@ -71,6 +95,8 @@ int main(void)
         }
 
         if (count == expected_value) {
+            print_stats(xtimer_now_usec() - start,
+                        schedules(pid) + schedules(thread_getpid()) - start_switches);
             puts("condition fulfilled.");
             is_finished = 1;
             mutex_unlock(&mutex);
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the reader throughput of pthread_rwlock with 1 to 8
+ *              reading threads
+ *
+ * @}
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define MAX_READERS     (8U)
+#define TEST_RUNS       (10000U)
+/* readers yield while holding the lock every YIELD_EVERY iterations, so
+ * the others find it held for reading */
+#define YIELD_EVERY     (16U)
+
+static char _stacks[MAX_READERS][THREAD_STACKSIZE_DEFAULT];
+static pthread_rwlock_t _rwlock;
+static kernel_pid_t _main_pid;
+static volatile unsigned _shared;
+
+static void *_reader(void *arg)
+{
+    msg_t msg;
+    unsigned sum = 0;
+
+    (void)arg;
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        pthread_rwlock_rdlock(&_rwlock);
+        sum += _shared;
+        if ((i % YIELD_EVERY) == 0) {
+            thread_yield();
+        }
+        pthread_rwlock_unlock(&_rwlock);
+    }
+    msg.content.value = sum;
+    msg_send(&msg, _main_pid);
+    return NULL;
+}
+
+static void _bench(unsigned readers)
+{
+    msg_t msg;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < readers; i++) {
+        thread_create(_stacks[i], sizeof(_stacks[i]), THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                      _reader, NULL, "reader");
+    }
+    /* the readers run at a higher priority, this returns after they ran */
+    for (unsigned i = 0; i < readers; i++) {
+        msg_receive(&msg);
+    }
+    uint32_t usec = xtimer_now_usec() - start;
+    uint32_t ns = (uint32_t)(((uint64_t)usec * 1000U) / (readers * TEST_RUNS));
+
+    printf("%u readers: %" PRIu32 " us, %" PRIu32 " ns per rdlock/unlock\n",
+           readers, usec, ns);
+}
+
+int main(void)
+{
+    puts("pthread_rwlock reader benchmark");
+
+    _main_pid = thread_getpid();
+    pthread_rwlock_init(&_rwlock, NULL);
+
+    for (unsigned readers = 1; readers <= MAX_READERS; readers++) {
+        _bench(readers);
+    }
+
+    if (pthread_rwlock_destroy(&_rwlock) != 0) {
+        puts("Test failed: lock still held");
+        return 1;
+    }
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures message round trips and xtimer ISR latency, to
+ *              compare builds with and without the ramfunc module
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_RUNS       (10000U)
+#define TIMER_RUNS      (1000U)
+#define TIMER_OFFSET    (1000U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static mutex_t _fired = MUTEX_INIT_LOCKED;
+static uint32_t _fired_at;
+
+static void *_pong(void *arg)
+{
+    msg_t m;
+
+    (void)arg;
+    while (1) {
+        msg_receive(&m);
+        msg_reply(&m, &m);
+    }
+    return NULL;
+}
+
+static void _timer_cb(void *arg)
+{
+    (void)arg;
+    _fired_at = xtimer_now_usec();
+    mutex_unlock(&_fired);
+}
+
+int main(void)
+{
+    kernel_pid_t pong;
+    uint32_t start, total = 0, max = 0;
+    msg_t m;
+
+#ifdef MODULE_RAMFUNC
+    puts("hot paths running from RAM");
+#else
+    puts("hot paths running from flash");
+#endif
+
+    pong = thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                         THREAD_CREATE_STACKTEST, _pong, NULL, "pong");
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        msg_send_receive(&m, &m, pong);
+    }
+    printf("msg round trip: %u ns\n",
+           (unsigned)((xtimer_now_usec() - start) * 1000 / TEST_RUNS));
+
+    for (unsigned i = 0; i < TIMER_RUNS; i++) {
+        xtimer_t timer = { .callback = _timer_cb };
+        uint32_t target = xtimer_now_usec() + TIMER_OFFSET;
+        uint32_t latency;
+
+        xtimer_set(&timer, TIMER_OFFSET);
+        mutex_lock(&_fired);
+        latency = _fired_at - target;
+        total += latency;
+        max = (latency > max) ? latency : max;
+    }
+    printf("xtimer ISR latency: avg %u us, max %u us\n",
+           (unsigned)(total / TIMER_RUNS), (unsigned)max);
+
+    puts("Test done");
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for earliest deadline first scheduling
+ *
+ * Runs two periodic deadline threads with a total utilization of 50%. With
+ * fixed priorities and the long job above the short one, the short one would
+ * miss every deadline its release shares with a long job; scheduled by
+ * deadline, none is missed.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "ps.h"
+#include "sched_edf.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define RUN_TIME_US     (1000U * 1000U)
+
+typedef struct {
+    uint32_t period;
+    uint32_t exec;
+    sched_edf_t edf;
+} task_t;
+
+static char stacks[2][THREAD_STACKSIZE_DEFAULT];
+static task_t tasks[] = {
+    { .period = 20000, .exec = 4000 },
+    { .period = 60000, .exec = 18000 },
+};
+
+static void *worker(void *arg)
+{
+    task_t *task = arg;
+
+    sched_edf_enter(&task->edf, task->period, task->period);
+    while (1) {
+        xtimer_spin(xtimer_ticks_from_usec(task->exec));
+        sched_edf_wait_period();
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    puts("EDF scheduling test");
+
+    /* create the long job with the higher fixed priority */
+    thread_create(stacks[1], sizeof(stacks[1]), THREAD_PRIORITY_MAIN - 4,
+                  THREAD_CREATE_WOUT_YIELD, worker, &tasks[1], "long");
+    thread_create(stacks[0], sizeof(stacks[0]), THREAD_PRIORITY_MAIN - 3,
+                  THREAD_CREATE_WOUT_YIELD, worker, &tasks[0], "short");
+
+    xtimer_usleep(RUN_TIME_US);
+
+    for (unsigned i = 0; i < sizeof(tasks) / sizeof(tasks[0]); i++) {
+        printf("task %u: %lu jobs, %lu misses\n", i,
+               (unsigned long)tasks[i].edf.jobs,
+               (unsigned long)tasks[i].edf.misses);
+        if ((tasks[i].edf.jobs == 0) || (tasks[i].edf.misses != 0)) {
+            failed = 1;
+        }
+    }
+    ps();
+
+    puts(failed ? "[FAILED]" : "[SUCCESS]");
+
+    return 0;
+}
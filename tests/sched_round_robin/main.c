@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for round-robin time slicing
+ *
+ * Starts some busy threads of equal priority that never yield. Without time
+ * slicing, only the first of them would ever run.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "thread.h"
+#include "xtimer.h"
+
+#define WORKER_NUMOF    (3U)
+#define RUN_TIME_US     (500U * 1000U)
+
+static char stacks[WORKER_NUMOF][THREAD_STACKSIZE_DEFAULT];
+static volatile unsigned long counters[WORKER_NUMOF];
+
+static void *worker(void *arg)
+{
+    volatile unsigned long *counter = arg;
+
+    while (1) {
+        (*counter)++;
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    int failed = 0;
+
+    puts("Round-robin time slicing test");
+
+    for (unsigned i = 0; i < WORKER_NUMOF; i++) {
+        thread_create(stacks[i], sizeof(stacks[i]), THREAD_PRIORITY_MAIN + 1,
+                      THREAD_CREATE_WOUT_YIELD, worker,
+                      (void *)&counters[i], "worker");
+    }
+
+    xtimer_usleep(RUN_TIME_US);
+
+    for (unsigned i = 0; i < WORKER_NUMOF; i++) {
+        printf("worker %u: %lu\n", i, counters[i]);
+        if (counters[i] == 0) {
+            failed = 1;
+        }
+    }
+
+    puts(failed ? "[FAILED]" : "[SUCCESS]");
+
+    return 0;
+}
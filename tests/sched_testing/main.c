@@ -10,16 +10,26 @@
  * @ingroup     tests
  * @{
  * @file
- * @brief       Test thread_yield()
+ * @brief       Test thread_yield() and measure context switch latency
  * @author      Oliver Hahm <oliver.hahm@inria.fr>
  * @author      René Kijewski <rene.kijewski@fu-berlin.de>
  * @}
  */
 
+#include <inttypes.h>
 #include <stdio.h>
+
 #include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_YIELD_NUM
+#define TEST_YIELD_NUM  (10000U)
+#endif
 
 char snd_thread_stack[THREAD_STACKSIZE_MAIN];
+char yield_thread_stack[THREAD_STACKSIZE_DEFAULT];
+
+static volatile unsigned yield_run = 1;
 
 void *snd_thread(void *unused)
 {
@@ -28,6 +38,37 @@ void *snd_thread(void *unused)
     return NULL;
 }
 
+void *yield_thread(void *unused)
+{
+    (void) unused;
+    while (yield_run) {
+        thread_yield();
+    }
+    return NULL;
+}
+
+static void measure_latency(void)
+{
+    thread_create(yield_thread_stack, sizeof(yield_thread_stack),
+                  THREAD_PRIORITY_MAIN, THREAD_CREATE_WOUT_YIELD,
+                  yield_thread, NULL, "yield");
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_YIELD_NUM; i++) {
+        thread_yield();
+    }
+    uint32_t diff = xtimer_now_usec() - start;
+
+    yield_run = 0;
+    thread_yield();
+
+    /* every thread_yield() of main switches to the yield thread and back */
+    printf("SCHED_PRIO_LEVELS: %u, context switches: %u\n",
+           (unsigned)SCHED_PRIO_LEVELS, 2 * TEST_YIELD_NUM);
+    printf("total: %" PRIu32 " us, per switch: %" PRIu32 " ns\n",
+           diff, (uint32_t)(((uint64_t)diff * 1000) / (2 * TEST_YIELD_NUM)));
+}
+
 int main(void)
 {
     puts("The output should be: yield 1, snd_thread running, yield 2, done");
@@ -40,6 +81,7 @@ int main(void)
     thread_yield();
     puts("yield 2");
     thread_yield();
+    measure_latency();
     puts("done");
 
     return 0;
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for statically declared threads
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "thread_static.h"
+
+#define MSG_NUMOF       (4U)
+
+static unsigned ran_before_main;
+
+static void *_worker(void *arg)
+{
+    msg_t msg;
+
+    (void)arg;
+    /* higher priority than main, so this runs before main() */
+    ran_before_main = 1;
+    /* the message queue was set up by the kernel */
+    while (1) {
+        msg_receive(&msg);
+        msg.content.value++;
+        msg_reply(&msg, &msg);
+    }
+
+    return NULL;
+}
+
+THREAD_STATIC_MSG(worker, THREAD_STACKSIZE_DEFAULT, THREAD_PRIORITY_MAIN - 1,
+                  0, _worker, NULL, MSG_NUMOF);
+
+int main(void)
+{
+    msg_t msg = { .content.value = 41 };
+    unsigned errors = 0;
+
+    puts("static thread test");
+
+    if (worker_pid <= KERNEL_PID_UNDEF) {
+        puts("worker: not created");
+        errors++;
+    }
+    else if (!ran_before_main) {
+        puts("worker: did not run before main()");
+        errors++;
+    }
+    else if ((msg_send_receive(&msg, &msg, worker_pid) != 1) ||
+             (msg.content.value != 42)) {
+        puts("worker: wrong reply");
+        errors++;
+    }
+    else {
+        puts("worker: ok");
+    }
+
+    puts(errors ? "[FAILED]" : "[SUCCESS]");
+
+    return 0;
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Static thread declared in an object nothing else references
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "thread.h"
+#include "thread_static.h"
+
+static void *_other(void *arg)
+{
+    (void)arg;
+    puts("other: running");
+    return NULL;
+}
+
+THREAD_STATIC(other, THREAD_STACKSIZE_DEFAULT + THREAD_EXTRA_STACKSIZE_PRINTF,
+              THREAD_PRIORITY_MAIN - 1, 0, _other, NULL);
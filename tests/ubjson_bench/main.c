@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares buffered and unbuffered UBJSON output and UBJSON
+ *              input from a packet with CBOR
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "xtimer.h"
+#include "cbor.h"
+#include "ubjson_stream.h"
+
+#define TEST_RUNS       (1000U)
+#define MTU             (64U)
+#define SAMPLES_NUMOF   (8U)
+#define OUT_SIZE        (128U)
+#define KEY_LEN         (8U)
+
+/* sum of the integers of a record, to check the decoders */
+#define RECORD_SUM      (17 + 21 + 48 + (100 * SAMPLES_NUMOF) + \
+                         ((SAMPLES_NUMOF * (SAMPLES_NUMOF - 1)) / 2))
+
+typedef struct {
+    ubjson_cookie_t cookie;
+    uint8_t *buf;
+    size_t len;
+    unsigned calls;
+} unbuffered_t;
+
+static uint8_t _out[OUT_SIZE];
+static size_t _out_len;
+static uint8_t _mtu_buf[MTU];
+static int32_t _sum;
+
+/* --- writing --- */
+
+static ssize_t _write_direct(ubjson_cookie_t *__restrict cookie,
+                             const void *buf, size_t len)
+{
+    unbuffered_t *u = container_of(cookie, unbuffered_t, cookie);
+
+    /* stands in for sock_udp_send() or pipe_write() per call */
+    memcpy(&u->buf[u->len], buf, len);
+    u->len += len;
+    u->calls++;
+    return len;
+}
+
+static ssize_t _write_chunk(ubjson_writer_t *writer, const void *data,
+                            size_t len)
+{
+    (void)writer;
+    /* stands in for sock_udp_send() or pipe_write() per chunk */
+    memcpy(&_out[_out_len], data, len);
+    _out_len += len;
+    return len;
+}
+
+static void _ubjson_record(ubjson_cookie_t *cookie)
+{
+    ubjson_open_object(cookie);
+    ubjson_write_key(cookie, "node", 4);
+    ubjson_write_string(cookie, "n-17", 4);
+    ubjson_write_key(cookie, "seq", 3);
+    ubjson_write_i32(cookie, 17);
+    ubjson_write_key(cookie, "temp", 4);
+    ubjson_write_float(cookie, 21.5f);
+    ubjson_write_key(cookie, "hum", 3);
+    ubjson_write_i32(cookie, 48);
+    ubjson_write_key(cookie, "samples", 7);
+    ubjson_open_array(cookie);
+    for (unsigned i = 0; i < SAMPLES_NUMOF; i++) {
+        ubjson_write_i32(cookie, 100 + i);
+    }
+    ubjson_close_array(cookie);
+    ubjson_close_object(cookie);
+}
+
+static size_t _cbor_record(cbor_stream_t *stream)
+{
+    cbor_clear(stream);
+    cbor_serialize_map(stream, 5);
+    cbor_serialize_unicode_string(stream, "node");
+    cbor_serialize_unicode_string(stream, "n-17");
+    cbor_serialize_unicode_string(stream, "seq");
+    cbor_serialize_int(stream, 17);
+    cbor_serialize_unicode_string(stream, "temp");
+    cbor_serialize_float(stream, 21.5f);
+    cbor_serialize_unicode_string(stream, "hum");
+    cbor_serialize_int(stream, 48);
+    cbor_serialize_unicode_string(stream, "samples");
+    cbor_serialize_array(stream, SAMPLES_NUMOF);
+    for (unsigned i = 0; i < SAMPLES_NUMOF; i++) {
+        cbor_serialize_int(stream, 100 + i);
+    }
+    return stream->pos;
+}
+
+/* --- reading --- */
+
+static ubjson_read_callback_result_t _value(ubjson_cookie_t *__restrict cookie,
+                                            ubjson_type_t type, ssize_t content)
+{
+    int32_t i;
+    float f;
+    char str[KEY_LEN];
+
+    switch (type) {
+        case UBJSON_TYPE_INT32:
+            if (ubjson_get_i32(cookie, content, &i) < 0) {
+                return UBJSON_PREMATURELY_ENDED;
+            }
+            _sum += i;
+            break;
+        case UBJSON_TYPE_FLOAT:
+            if (ubjson_get_float(cookie, content, &f) < 0) {
+                return UBJSON_PREMATURELY_ENDED;
+            }
+            _sum += (int32_t)f;
+            break;
+        case UBJSON_TYPE_STRING:
+            if ((content > (ssize_t)sizeof(str)) ||
+                (ubjson_get_string(cookie, content, str) < 0)) {
+                return UBJSON_INVALID_DATA;
+            }
+            break;
+        case UBJSON_ENTER_ARRAY:
+            return ubjson_read_array(cookie);
+        case UBJSON_ENTER_OBJECT:
+            return ubjson_read_object(cookie);
+        default:
+            return UBJSON_INVALID_DATA;
+    }
+    return UBJSON_OKAY;
+}
+
+static ubjson_read_callback_result_t _read_cb(ubjson_cookie_t *__restrict cookie,
+                                              ubjson_type_t type1,
+                                              ssize_t content1,
+                                              ubjson_type_t type2,
+                                              ssize_t content2)
+{
+    ubjson_read_callback_result_t res;
+    char key[KEY_LEN];
+
+    switch (type1) {
+        case UBJSON_KEY:
+            if ((content1 > (ssize_t)sizeof(key)) ||
+                (ubjson_get_string(cookie, content1, key) < 0)) {
+                return UBJSON_INVALID_DATA;
+            }
+            /* fall through */
+        case UBJSON_INDEX:
+            res = ubjson_peek_value(cookie, &type2, &content2);
+            if (res != UBJSON_OKAY) {
+                return res;
+            }
+            return _value(cookie, type2, content2);
+        default:
+            return _value(cookie, type1, content1);
+    }
+}
+
+static int _cbor_read(const uint8_t *buf, size_t len)
+{
+    cbor_reader_t reader;
+    cbor_item_t item;
+    int64_t i;
+    double d;
+    int res;
+
+    cbor_reader_init(&reader, buf, len);
+    while ((res = cbor_reader_next(&reader, &item)) == 0) {
+        if (cbor_item_get_int64(&item, &i) == 0) {
+            _sum += (int32_t)i;
+        }
+        else if (cbor_item_get_double(&item, &d) == 0) {
+            _sum += (int32_t)d;
+        }
+    }
+    return (res == -ENOENT) ? 0 : res;
+}
+
+/* --- measurement --- */
+
+static void _check_sum(void)
+{
+    if (_sum != (int32_t)(RECORD_SUM * TEST_RUNS)) {
+        puts("wrong values decoded");
+    }
+}
+
+static void _print(const char *name, size_t len, unsigned calls,
+                   uint32_t start)
+{
+    uint32_t diff = xtimer_now_usec() - start;
+
+    printf("%-20s %3u byte, %3u calls, %5lu us/record\n", name,
+           (unsigned)len, calls, (unsigned long)(diff / TEST_RUNS));
+}
+
+int main(void)
+{
+    uint8_t direct_buf[OUT_SIZE];
+    unbuffered_t direct = { .buf = direct_buf };
+    ubjson_writer_t writer;
+    ubjson_reader_t reader;
+    cbor_stream_t stream;
+    uint8_t cbor_buf[OUT_SIZE];
+    uint32_t start;
+    size_t len = 0;
+
+    puts("ubjson stream benchmark");
+    printf("%u records, chunks of %u byte\n", TEST_RUNS, MTU);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        ubjson_write_init(&direct.cookie, _write_direct);
+        direct.len = 0;
+        direct.calls = 0;
+        _ubjson_record(&direct.cookie);
+    }
+    _print("ubjson unbuffered:", direct.len, direct.calls, start);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        _out_len = 0;
+        ubjson_writer_init(&writer, _mtu_buf, sizeof(_mtu_buf), _write_chunk);
+        _ubjson_record(&writer.cookie);
+        ubjson_writer_flush(&writer);
+    }
+    _print("ubjson buffered:", _out_len, writer.flushes, start);
+
+    cbor_init(&stream, cbor_buf, sizeof(cbor_buf));
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        len = _cbor_record(&stream);
+    }
+    _print("cbor write:", len, 1, start);
+
+    /* the record as received: split over two snips, like a reassembled
+     * datagram */
+    gnrc_pktsnip_t tail = { .data = &_out[_out_len / 2],
+                            .size = _out_len - (_out_len / 2) };
+    gnrc_pktsnip_t head = { .next = &tail, .data = _out,
+                            .size = _out_len / 2 };
+
+    _sum = 0;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        ubjson_reader_init(&reader, &head);
+        if (ubjson_read(&reader.cookie, ubjson_reader_read,
+                        _read_cb) != UBJSON_OKAY) {
+            puts("ubjson read failed");
+            break;
+        }
+    }
+    _print("ubjson read (pkt):", _out_len, 0, start);
+    _check_sum();
+
+    _sum = 0;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        if (_cbor_read(cbor_buf, len) < 0) {
+            puts("cbor read failed");
+            break;
+        }
+    }
+    _print("cbor read:", len, 0, start);
+    _check_sum();
+
+    puts("Test done");
+    return 0;
+}
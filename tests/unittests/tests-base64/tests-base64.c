@@ -380,6 +380,60 @@ static void test_base64_09_encode_size_determination(void)
     TEST_ASSERT_EQUAL_INT(required_out_size, expected_out_size);
 }
 
+static void test_base64_10_stream_chunks(void)
+{
+    unsigned char data[100];
+    unsigned char expected[BASE64_ENCODED_LEN(sizeof(data))];
+    unsigned char encoded[sizeof(expected)];
+    unsigned char decoded[sizeof(data)];
+    size_t expected_size = sizeof(expected);
+
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        data[i] = (unsigned char)(i * 7);
+    }
+    int ret = base64_encode(data, sizeof(data), expected, &expected_size);
+    TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+
+    /* every chunk size leaves a different remainder in the context */
+    for (size_t chunk = 1; chunk <= 7; chunk++) {
+        base64_ctx_t ctx = BASE64_CTX_INIT;
+        size_t len = 0;
+
+        for (size_t pos = 0; pos < sizeof(data); pos += chunk) {
+            size_t n = sizeof(data) - pos;
+
+            n = (n < chunk) ? n : chunk;
+            len += base64_encode_update(&ctx, data + pos, n, encoded + len);
+        }
+        len += base64_encode_finish(&ctx, encoded + len);
+        TEST_ASSERT_EQUAL_INT(expected_size, len);
+        TEST_ASSERT(memcmp(expected, encoded, len) == 0);
+
+        len = 0;
+        for (size_t pos = 0; pos < expected_size; pos += chunk) {
+            size_t n = expected_size - pos;
+
+            n = (n < chunk) ? n : chunk;
+            len += base64_decode_update(&ctx, encoded + pos, n, decoded + len);
+        }
+        len += base64_decode_finish(&ctx, decoded + len);
+        TEST_ASSERT_EQUAL_INT(sizeof(data), len);
+        TEST_ASSERT(memcmp(data, decoded, len) == 0);
+    }
+}
+
+static void test_base64_11_decode_in_place(void)
+{
+    unsigned char buf[] = "SGVsbG8g\r\nUklPVA";
+    size_t size = strlen((char *)buf);
+
+    /* line breaks are skipped, the unpadded rest is decoded as well */
+    int ret = base64_decode(buf, strlen((char *)buf), buf, &size);
+    TEST_ASSERT_EQUAL_INT(BASE64_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_INT(strlen("Hello RIOT"), size);
+    TEST_ASSERT(memcmp(buf, "Hello RIOT", size) == 0);
+}
+
 Test *tests_base64_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -392,6 +446,8 @@ Test *tests_base64_tests(void)
         new_TestFixture(test_base64_07_stream_decode),
         new_TestFixture(test_base64_08_encode_16_bytes),
         new_TestFixture(test_base64_09_encode_size_determination),
+        new_TestFixture(test_base64_10_stream_chunks),
+        new_TestFixture(test_base64_11_decode_in_place),
     };
 
     EMB_UNIT_TESTCALLER(base64_tests, NULL, NULL, fixtures);
@@ -116,6 +116,59 @@ static void test_bf_get_unset_lastbyte(void)
     TEST_ASSERT_EQUAL_INT(39, res);
 }
 
+static void test_bf_find_set(void)
+{
+    uint8_t field[11];
+    memset(field, 0, sizeof(field));
+
+    TEST_ASSERT_EQUAL_INT(-1, bf_find_first_set(field, 85));
+    bf_set(field, 84);
+    TEST_ASSERT_EQUAL_INT(84, bf_find_first_set(field, 85));
+    TEST_ASSERT_EQUAL_INT(-1, bf_find_first_set(field, 84));
+    bf_set(field, 3);
+    bf_set(field, 37);
+    TEST_ASSERT_EQUAL_INT(3, bf_find_first_set(field, 85));
+    TEST_ASSERT_EQUAL_INT(3, bf_find_next_set(field, 85, 3));
+    TEST_ASSERT_EQUAL_INT(37, bf_find_next_set(field, 85, 4));
+    TEST_ASSERT_EQUAL_INT(84, bf_find_next_set(field, 85, 38));
+    TEST_ASSERT_EQUAL_INT(-1, bf_find_next_set(field, 85, 85));
+}
+
+static void test_bf_find_unset(void)
+{
+    uint8_t field[11];
+    memset(field, 0xff, sizeof(field));
+
+    TEST_ASSERT_EQUAL_INT(-1, bf_find_first_unset(field, 85));
+    bf_unset(field, 80);
+    TEST_ASSERT_EQUAL_INT(80, bf_find_first_unset(field, 85));
+    TEST_ASSERT_EQUAL_INT(-1, bf_find_first_unset(field, 80));
+    bf_unset(field, 17);
+    TEST_ASSERT_EQUAL_INT(17, bf_find_first_unset(field, 85));
+    TEST_ASSERT_EQUAL_INT(80, bf_find_next_unset(field, 85, 18));
+    TEST_ASSERT_EQUAL_INT(-1, bf_find_next_unset(field, 85, 81));
+}
+
+static void test_bf_range(void)
+{
+    uint8_t field[11];
+    memset(field, 0, sizeof(field));
+
+    bf_set_range(field, 5, 70);
+    for (int i = 0; i < 88; i++) {
+        TEST_ASSERT_EQUAL_INT((i >= 5) && (i < 75), bf_isset(field, i));
+    }
+    TEST_ASSERT_EQUAL_INT(70, bf_popcnt(field, 88));
+    TEST_ASSERT_EQUAL_INT(65, bf_popcnt(field, 70));
+
+    bf_unset_range(field, 6, 2);
+    bf_unset_range(field, 16, 40);
+    TEST_ASSERT_EQUAL_INT(28, bf_popcnt(field, 88));
+    TEST_ASSERT_EQUAL_INT(5, bf_find_first_set(field, 88));
+    TEST_ASSERT_EQUAL_INT(8, bf_find_next_set(field, 88, 6));
+    TEST_ASSERT_EQUAL_INT(56, bf_find_next_set(field, 88, 16));
+}
+
 Test *tests_bitfield_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -123,6 +176,9 @@ Test *tests_bitfield_tests(void)
         new_TestFixture(test_bf_get_unset_firstbyte),
         new_TestFixture(test_bf_get_unset_middle),
         new_TestFixture(test_bf_get_unset_lastbyte),
+        new_TestFixture(test_bf_find_set),
+        new_TestFixture(test_bf_find_unset),
+        new_TestFixture(test_bf_range),
     };
 
     EMB_UNIT_TESTCALLER(bitfield_tests, NULL, NULL, fixtures);
@@ -22,6 +22,9 @@
 #define TESTS_BLOOM_PROB_IN_FILTER (4)
 #define TESTS_BLOOM_NOT_IN_FILTER (996)
 #define TESTS_BLOOM_FALSE_POS_RATE_THR (0.005)
+/* words of B that are in A as well */
+#define TESTS_BLOOM_IN_BOTH_SETS (2)
+#define TESTS_BLOOM_COUNTERS (1024)
 
 static bloom_t bloom;
 BITFIELD(bf, TESTS_BLOOM_BITS);
@@ -85,11 +88,63 @@ static void test_bloom_based_on_dictionary_fixture(void)
     TEST_ASSERT(false_positive_rate < TESTS_BLOOM_FALSE_POS_RATE_THR);
 }
 
+static void test_bloom_blocked_dictionary(void)
+{
+    static uint8_t blocks[BLOOM_BLOCK_SIZE];
+    bloom_blocked_t blocked;
+    int in = 0;
+
+    bloom_blocked_init(&blocked, blocks, 1, TESTS_BLOOM_HASHF);
+    for (int i = 0; i < lenB; i++) {
+        bloom_blocked_add(&blocked, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    for (int i = 0; i < lenB; i++) {
+        TEST_ASSERT(bloom_blocked_check(&blocked, (const uint8_t *) B[i],
+                                        strlen(B[i])));
+    }
+    for (int i = 0; i < lenA; i++) {
+        in += bloom_blocked_check(&blocked, (const uint8_t *) A[i],
+                                  strlen(A[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(TESTS_BLOOM_IN_BOTH_SETS, in);
+}
+
+static void test_bloom_counting_remove(void)
+{
+    static uint8_t counters[BLOOM_COUNTING_SIZE(TESTS_BLOOM_COUNTERS)];
+    bloom_counting_t counting;
+    int in = 0;
+
+    bloom_counting_init(&counting, counters, TESTS_BLOOM_COUNTERS,
+                        TESTS_BLOOM_HASHF);
+    for (int i = 0; i < lenB; i++) {
+        bloom_counting_add(&counting, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    for (int i = 0; i < lenA; i++) {
+        in += bloom_counting_check(&counting, (const uint8_t *) A[i],
+                                   strlen(A[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(TESTS_BLOOM_IN_BOTH_SETS, in);
+
+    /* remove all but the first key */
+    for (int i = 1; i < lenB; i++) {
+        bloom_counting_remove(&counting, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    TEST_ASSERT(bloom_counting_check(&counting, (const uint8_t *) B[0],
+                                     strlen(B[0])));
+    for (int i = 1; i < lenB; i++) {
+        TEST_ASSERT(!bloom_counting_check(&counting, (const uint8_t *) B[i],
+                                          strlen(B[i])));
+    }
+}
+
 Test *tests_bloom_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_bloom_parameters_bytes_hashf),
         new_TestFixture(test_bloom_based_on_dictionary_fixture),
+        new_TestFixture(test_bloom_blocked_dictionary),
+        new_TestFixture(test_bloom_counting_remove),
     };
 
     EMB_UNIT_TESTCALLER(bloom_tests, set_up_bloom, tear_down_bloom, fixtures);
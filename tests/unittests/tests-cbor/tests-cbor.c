@@ -18,6 +18,7 @@
 #include "bitarithm.h"
 #include "cbor.h"
 
+#include <errno.h>
 #include <float.h>
 #include <math.h>
 #include <stdio.h>
@@ -687,6 +688,118 @@ static void test_double_invalid(void)
 }
 #endif /* CBOR_NO_FLOAT */
 
+static void test_reserve_byte_string(void)
+{
+    unsigned char *raw = cbor_reserve_byte_string(&stream, 3);
+    unsigned char data[] = {0x43, 0x01, 0x02, 0x03};
+
+    TEST_ASSERT_NOT_NULL(raw);
+    TEST_ASSERT(raw == stream.data + 1);
+    raw[0] = 1;
+    raw[1] = 2;
+    raw[2] = 3;
+    TEST_ASSERT_EQUAL_INT(sizeof(data), stream.pos);
+    CBOR_CHECK_SERIALIZED(stream, data, sizeof(data));
+
+    TEST_ASSERT_NULL(cbor_reserve_byte_string(&empty_stream, 3));
+    TEST_ASSERT_EQUAL_INT(0, empty_stream.pos);
+}
+
+static void test_reader(void)
+{
+    cbor_reader_t reader;
+    cbor_item_t item;
+    int64_t val;
+
+    /* [-2, {"a": [1, 2], "b": "c"}, "xyz", [_ 1, 2]] */
+    cbor_serialize_array(&stream, 4);
+    cbor_serialize_int(&stream, -2);
+    cbor_serialize_map(&stream, 2);
+    cbor_serialize_unicode_string(&stream, "a");
+    cbor_serialize_array(&stream, 2);
+    cbor_serialize_int(&stream, 1);
+    cbor_serialize_int(&stream, 2);
+    cbor_serialize_unicode_string(&stream, "b");
+    cbor_serialize_unicode_string(&stream, "c");
+    cbor_serialize_unicode_string(&stream, "xyz");
+    cbor_serialize_array_indefinite(&stream);
+    cbor_serialize_int(&stream, 1);
+    cbor_serialize_int(&stream, 2);
+    cbor_write_break(&stream);
+
+    cbor_reader_init(&reader, stream.data, stream.pos);
+
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_ARRAY, item.type);
+    TEST_ASSERT_EQUAL_INT(4, item.value);
+
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(0, cbor_item_get_int64(&item, &val));
+    TEST_ASSERT(val == -2);
+
+    /* skip the whole map */
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_MAP, item.type);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader, &item));
+
+    /* strings are not copied */
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_TEXT, item.type);
+    TEST_ASSERT_EQUAL_INT(3, item.value);
+    TEST_ASSERT(item.data > stream.data && item.data < stream.data + stream.pos);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(item.data, "xyz", 3));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, cbor_item_get_int64(&item, &val));
+
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_ARRAY, item.type);
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_INDEFINITE, item.info);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_skip(&reader, &item));
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, cbor_reader_next(&reader, &item));
+}
+
+static void test_reader_invalid(void)
+{
+    cbor_reader_t reader;
+    cbor_item_t item;
+    /* string longer than the data, truncated integer, array missing items */
+    unsigned char long_string[] = {0x63, 0x61, 0x62};
+    unsigned char short_int[] = {0x19, 0x01};
+    unsigned char short_array[] = {0x82, 0x01};
+
+    cbor_reader_init(&reader, long_string, sizeof(long_string));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_reader_next(&reader, &item));
+    cbor_reader_init(&reader, short_int, sizeof(short_int));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_reader_next(&reader, &item));
+    cbor_reader_init(&reader, short_array, sizeof(short_array));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_reader_skip(&reader, &item));
+}
+
+#ifndef CBOR_NO_FLOAT
+static void test_reader_float(void)
+{
+    cbor_reader_t reader;
+    cbor_item_t item;
+    double val;
+
+    cbor_serialize_float_half(&stream, 1.5f);
+    cbor_serialize_float(&stream, 0.25f);
+    cbor_serialize_double(&stream, -4.1);
+
+    cbor_reader_init(&reader, stream.data, stream.pos);
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(0, cbor_item_get_double(&item, &val));
+    TEST_ASSERT(EQUAL_FLOAT(1.5, val));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(0, cbor_item_get_double(&item, &val));
+    TEST_ASSERT(EQUAL_FLOAT(0.25, val));
+    TEST_ASSERT_EQUAL_INT(0, cbor_reader_next(&reader, &item));
+    TEST_ASSERT_EQUAL_INT(0, cbor_item_get_double(&item, &val));
+    TEST_ASSERT(EQUAL_FLOAT(-4.1, val));
+}
+#endif /* CBOR_NO_FLOAT */
+
 #ifndef CBOR_NO_PRINT
 /**
  * Manual test for testing the cbor_stream_decode function
@@ -786,7 +899,11 @@ TestRef tests_cbor_all(void)
                         new_TestFixture(test_float_invalid),
                         new_TestFixture(test_double),
                         new_TestFixture(test_double_invalid),
+                        new_TestFixture(test_reader_float),
 #endif /* CBOR_NO_FLOAT */
+                        new_TestFixture(test_reserve_byte_string),
+                        new_TestFixture(test_reader),
+                        new_TestFixture(test_reader_invalid),
     };
 
     EMB_UNIT_TESTCALLER(CborTest, setUp, tearDown, fixtures);
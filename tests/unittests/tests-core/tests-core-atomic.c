@@ -188,6 +188,35 @@ static void test_atomic_cas_diff(void)
     TEST_ASSERT_EQUAL_INT(-12345, ATOMIC_VALUE(res));
 }
 
+/* Test atomic_fetch_add */
+static void test_atomic_fetch_add(void)
+{
+    atomic_int_t res = ATOMIC_INIT(-5);
+
+    TEST_ASSERT_EQUAL_INT(-5, atomic_fetch_add(&res, 12));
+    TEST_ASSERT_EQUAL_INT(7, ATOMIC_VALUE(res));
+    TEST_ASSERT_EQUAL_INT(7, atomic_fetch_add(&res, -10));
+    TEST_ASSERT_EQUAL_INT(-3, ATOMIC_VALUE(res));
+    TEST_ASSERT_EQUAL_INT(-3, atomic_fetch_add(&res, 0));
+    TEST_ASSERT_EQUAL_INT(-3, ATOMIC_VALUE(res));
+    ATOMIC_VALUE(res) = INT_MAX - 1;
+    TEST_ASSERT_EQUAL_INT(INT_MAX - 1, atomic_fetch_add(&res, 3));
+    TEST_ASSERT_EQUAL_INT(INT_MIN + 1, ATOMIC_VALUE(res));
+}
+
+/* Test atomic_swap */
+static void test_atomic_swap(void)
+{
+    atomic_int_t res = ATOMIC_INIT(42);
+
+    TEST_ASSERT_EQUAL_INT(42, atomic_swap(&res, -1));
+    TEST_ASSERT_EQUAL_INT(-1, ATOMIC_VALUE(res));
+    TEST_ASSERT_EQUAL_INT(-1, atomic_swap(&res, -1));
+    TEST_ASSERT_EQUAL_INT(-1, ATOMIC_VALUE(res));
+    TEST_ASSERT_EQUAL_INT(-1, atomic_swap(&res, 0));
+    TEST_ASSERT_EQUAL_INT(0, ATOMIC_VALUE(res));
+}
+
 /* Test ATOMIC_VALUE */
 static void test_atomic_value(void)
 {
@@ -222,6 +251,8 @@ Test *tests_core_atomic_tests(void)
         new_TestFixture(test_atomic_dec_rollover),
         new_TestFixture(test_atomic_cas_same),
         new_TestFixture(test_atomic_cas_diff),
+        new_TestFixture(test_atomic_fetch_add),
+        new_TestFixture(test_atomic_swap),
         new_TestFixture(test_atomic_value),
     };
 
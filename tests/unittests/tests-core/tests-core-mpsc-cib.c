@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include "embUnit.h"
+
+#include "mpsc_cib.h"
+
+#include "tests-core.h"
+
+#define TEST_MPSC_CIB_SIZE  4
+
+static atomic_int_t seq[TEST_MPSC_CIB_SIZE];
+static mpsc_cib_t cib;
+
+static void set_up(void)
+{
+    mpsc_cib_init(&cib, seq, TEST_MPSC_CIB_SIZE);
+}
+
+static void test_mpsc_cib_put_full(void)
+{
+    for (int i = 0; i < TEST_MPSC_CIB_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(i, mpsc_cib_put(&cib));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, mpsc_cib_put(&cib));
+    /* committing does not free a slot */
+    mpsc_cib_commit(&cib, 0);
+    TEST_ASSERT_EQUAL_INT(-1, mpsc_cib_put(&cib));
+}
+
+static void test_mpsc_cib_peek_uncommitted(void)
+{
+    TEST_ASSERT_EQUAL_INT(-1, mpsc_cib_peek(&cib));
+    TEST_ASSERT_EQUAL_INT(0, mpsc_cib_put(&cib));
+    TEST_ASSERT_EQUAL_INT(1, mpsc_cib_put(&cib));
+    /* slot 1 is not visible before slot 0 is committed */
+    mpsc_cib_commit(&cib, 1);
+    TEST_ASSERT_EQUAL_INT(-1, mpsc_cib_peek(&cib));
+    mpsc_cib_commit(&cib, 0);
+    TEST_ASSERT_EQUAL_INT(0, mpsc_cib_peek(&cib));
+    TEST_ASSERT_EQUAL_INT(0, mpsc_cib_peek(&cib));
+    mpsc_cib_release(&cib);
+    TEST_ASSERT_EQUAL_INT(1, mpsc_cib_peek(&cib));
+    mpsc_cib_release(&cib);
+    TEST_ASSERT_EQUAL_INT(-1, mpsc_cib_peek(&cib));
+}
+
+static void test_mpsc_cib_wrap(void)
+{
+    int buf[TEST_MPSC_CIB_SIZE];
+
+    for (int i = 0; i < (5 * TEST_MPSC_CIB_SIZE) + 1; i++) {
+        int idx = mpsc_cib_put(&cib);
+
+        TEST_ASSERT(idx >= 0);
+        buf[idx] = i;
+        mpsc_cib_commit(&cib, idx);
+        if (i > 0) {
+            /* stay one element behind */
+            idx = mpsc_cib_peek(&cib);
+            TEST_ASSERT(idx >= 0);
+            TEST_ASSERT_EQUAL_INT(i - 1, buf[idx]);
+            mpsc_cib_release(&cib);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(5 * TEST_MPSC_CIB_SIZE, buf[mpsc_cib_peek(&cib)]);
+    mpsc_cib_release(&cib);
+    TEST_ASSERT_EQUAL_INT(-1, mpsc_cib_peek(&cib));
+}
+
+static void test_mpsc_cib_release_frees(void)
+{
+    for (int i = 0; i < TEST_MPSC_CIB_SIZE; i++) {
+        mpsc_cib_commit(&cib, mpsc_cib_put(&cib));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, mpsc_cib_put(&cib));
+    TEST_ASSERT_EQUAL_INT(0, mpsc_cib_peek(&cib));
+    mpsc_cib_release(&cib);
+    TEST_ASSERT_EQUAL_INT(0, mpsc_cib_put(&cib));
+    TEST_ASSERT_EQUAL_INT(-1, mpsc_cib_put(&cib));
+}
+
+Test *tests_core_mpsc_cib_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mpsc_cib_put_full),
+        new_TestFixture(test_mpsc_cib_peek_uncommitted),
+        new_TestFixture(test_mpsc_cib_wrap),
+        new_TestFixture(test_mpsc_cib_release_frees),
+    };
+
+    EMB_UNIT_TESTCALLER(core_mpsc_cib_tests, set_up, NULL, fixtures);
+
+    return (Test *)&core_mpsc_cib_tests;
+}
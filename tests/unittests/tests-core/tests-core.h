@@ -85,6 +85,13 @@ Test *tests_core_byteorder_tests(void);
  */
 Test *tests_core_ringbuffer_tests(void);
 
+/**
+ * @brief   Generates tests for mpsc_cib.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_core_mpsc_cib_tests(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+#include "tests-crypto.h"
+
+#include "crypto/chacha20poly1305.h"
+#include "crypto/poly1305.h"
+
+/* RFC 8439, section 2.5.2 */
+static const uint8_t POLY1305_KEY[32] = {
+    0x85, 0xd6, 0xbe, 0x78, 0x57, 0x55, 0x6d, 0x33,
+    0x7f, 0x44, 0x52, 0xfe, 0x42, 0xd5, 0x06, 0xa8,
+    0x01, 0x03, 0x80, 0x8a, 0xfb, 0x0d, 0xb2, 0xfd,
+    0x4a, 0xbf, 0xf6, 0xaf, 0x41, 0x49, 0xf5, 0x1b,
+};
+
+static const char POLY1305_MSG[] = "Cryptographic Forum Research Group";
+
+static const uint8_t POLY1305_MAC[16] = {
+    0xa8, 0x06, 0x1d, 0xc1, 0x30, 0x51, 0x36, 0xc6,
+    0xc2, 0x2b, 0x8b, 0xaf, 0x0c, 0x01, 0x27, 0xa9,
+};
+
+/* RFC 8439, section 2.8.2 */
+static const uint8_t AEAD_KEY[32] = {
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+    0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f,
+};
+
+static const uint8_t AEAD_NONCE[12] = {
+    0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43,
+    0x44, 0x45, 0x46, 0x47,
+};
+
+static const uint8_t AEAD_AAD[12] = {
+    0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7,
+};
+
+static const char AEAD_PLAIN[] = "Ladies and Gentlemen of the class of '99: "
+    "If I could offer you only one tip for the future, sunscreen would be it.";
+
+static const uint8_t AEAD_CIPHER[130] = {
+    0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb,
+    0x7b, 0x86, 0xaf, 0xbc, 0x53, 0xef, 0x7e, 0xc2,
+    0xa4, 0xad, 0xed, 0x51, 0x29, 0x6e, 0x08, 0xfe,
+    0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6,
+    0x3d, 0xbe, 0xa4, 0x5e, 0x8c, 0xa9, 0x67, 0x12,
+    0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b,
+    0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29,
+    0x05, 0xd6, 0xa5, 0xb6, 0x7e, 0xcd, 0x3b, 0x36,
+    0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c,
+    0x98, 0x03, 0xae, 0xe3, 0x28, 0x09, 0x1b, 0x58,
+    0xfa, 0xb3, 0x24, 0xe4, 0xfa, 0xd6, 0x75, 0x94,
+    0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7, 0xbc,
+    0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d,
+    0xe5, 0x76, 0xd2, 0x65, 0x86, 0xce, 0xc6, 0x4b,
+    0x61, 0x16, 0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09,
+    0xe2, 0x6a, 0x7e, 0x90, 0x2e, 0xcb, 0xd0, 0x60,
+    0x06, 0x91,
+};
+
+#define AEAD_PLAIN_LEN  (sizeof(AEAD_PLAIN) - 1)
+
+static uint8_t data[sizeof(AEAD_CIPHER)];
+
+static void test_crypto_poly1305(void)
+{
+    uint8_t mac[POLY1305_MAC_SIZE];
+    poly1305_ctx_t ctx;
+
+    poly1305_auth(mac, (const uint8_t *)POLY1305_MSG,
+                  sizeof(POLY1305_MSG) - 1, POLY1305_KEY);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(mac, POLY1305_MAC, sizeof(mac)));
+
+    /* the same in uneven pieces */
+    poly1305_init(&ctx, POLY1305_KEY);
+    poly1305_update(&ctx, (const uint8_t *)POLY1305_MSG, 5);
+    poly1305_update(&ctx, (const uint8_t *)POLY1305_MSG + 5, 20);
+    poly1305_update(&ctx, (const uint8_t *)POLY1305_MSG + 25,
+                    sizeof(POLY1305_MSG) - 26);
+    poly1305_finish(&ctx, mac);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(mac, POLY1305_MAC, sizeof(mac)));
+}
+
+static void test_crypto_chacha20poly1305_encrypt(void)
+{
+    int len = chacha20poly1305_encrypt(AEAD_KEY, AEAD_NONCE,
+                                       AEAD_AAD, sizeof(AEAD_AAD),
+                                       (const uint8_t *)AEAD_PLAIN,
+                                       AEAD_PLAIN_LEN, data);
+
+    TEST_ASSERT_EQUAL_INT(sizeof(AEAD_CIPHER), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, AEAD_CIPHER, sizeof(AEAD_CIPHER)));
+}
+
+static void test_crypto_chacha20poly1305_decrypt_in_place(void)
+{
+    int len;
+
+    memcpy(data, AEAD_CIPHER, sizeof(AEAD_CIPHER));
+    len = chacha20poly1305_decrypt(AEAD_KEY, AEAD_NONCE,
+                                   AEAD_AAD, sizeof(AEAD_AAD),
+                                   data, sizeof(data), data);
+    TEST_ASSERT_EQUAL_INT(AEAD_PLAIN_LEN, len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(data, AEAD_PLAIN, AEAD_PLAIN_LEN));
+}
+
+static void test_crypto_chacha20poly1305_decrypt_forged(void)
+{
+    uint8_t plain[AEAD_PLAIN_LEN];
+    int len;
+
+    memcpy(data, AEAD_CIPHER, sizeof(AEAD_CIPHER));
+    data[0] ^= 1;
+    len = chacha20poly1305_decrypt(AEAD_KEY, AEAD_NONCE,
+                                   AEAD_AAD, sizeof(AEAD_AAD),
+                                   data, sizeof(data), plain);
+    TEST_ASSERT_EQUAL_INT(CHACHA20POLY1305_ERR_INVALID_TAG, len);
+    TEST_ASSERT_EQUAL_INT(0, plain[0]);
+
+    len = chacha20poly1305_decrypt(AEAD_KEY, AEAD_NONCE, NULL, 0, data,
+                                   CHACHA20POLY1305_TAG_SIZE - 1, plain);
+    TEST_ASSERT_EQUAL_INT(CHACHA20POLY1305_ERR_INVALID_LENGTH, len);
+}
+
+Test *tests_crypto_chacha20poly1305_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_crypto_poly1305),
+        new_TestFixture(test_crypto_chacha20poly1305_encrypt),
+        new_TestFixture(test_crypto_chacha20poly1305_decrypt_in_place),
+        new_TestFixture(test_crypto_chacha20poly1305_decrypt_forged),
+    };
+    EMB_UNIT_TESTCALLER(crypto_chacha20poly1305_tests, NULL, NULL, fixtures);
+    return (Test *) &crypto_chacha20poly1305_tests;
+}
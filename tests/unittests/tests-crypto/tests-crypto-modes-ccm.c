@@ -147,12 +147,49 @@ static void test_crypto_modes_ccm_decrypt(void)
                     TEST_2_INPUT_LEN);
 }
 
+/* an 802.15.4 frame sized payload, en- and decrypted in place */
+static void test_crypto_modes_ccm_frame_in_place(void)
+{
+    cipher_t cipher;
+    uint8_t data[127 + 8], plain[127];
+    int len;
+
+    for (unsigned i = 0; i < sizeof(plain); i++) {
+        plain[i] = (uint8_t)(i * 7);
+    }
+    memcpy(data, plain, sizeof(plain));
+
+    TEST_ASSERT_EQUAL_INT(1, cipher_init(&cipher, CIPHER_AES_128, TEST_1_KEY,
+                                         TEST_1_KEY_LEN));
+    len = cipher_encrypt_ccm(&cipher, TEST_1_INPUT, TEST_1_ADATA_LEN, 8, 2,
+                             TEST_1_NONCE, TEST_1_NONCE_LEN, data,
+                             sizeof(plain), data);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), len);
+
+    len = cipher_decrypt_ccm(&cipher, TEST_1_INPUT, TEST_1_ADATA_LEN, 8, 2,
+                             TEST_1_NONCE, TEST_1_NONCE_LEN, data,
+                             sizeof(data), data);
+    TEST_ASSERT_EQUAL_INT(sizeof(plain), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(plain, data, sizeof(plain)));
+
+    /* a modified frame must not be accepted */
+    cipher_encrypt_ccm(&cipher, TEST_1_INPUT, TEST_1_ADATA_LEN, 8, 2,
+                       TEST_1_NONCE, TEST_1_NONCE_LEN, data, sizeof(plain),
+                       data);
+    data[100] ^= 0x01;
+    len = cipher_decrypt_ccm(&cipher, TEST_1_INPUT, TEST_1_ADATA_LEN, 8, 2,
+                             TEST_1_NONCE, TEST_1_NONCE_LEN, data,
+                             sizeof(data), data);
+    TEST_ASSERT_EQUAL_INT(CCM_ERR_INVALID_CBC_MAC, len);
+}
+
 
 Test* tests_crypto_modes_ccm_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_crypto_modes_ccm_encrypt),
-                        new_TestFixture(test_crypto_modes_ccm_decrypt)
+                        new_TestFixture(test_crypto_modes_ccm_decrypt),
+                        new_TestFixture(test_crypto_modes_ccm_frame_in_place)
     };
 
     EMB_UNIT_TESTCALLER(crypto_modes_ccm_tests, NULL, NULL, fixtures);
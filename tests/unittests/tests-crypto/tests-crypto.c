@@ -12,6 +12,7 @@
 void tests_crypto(void)
 {
     TESTS_RUN(tests_crypto_chacha_tests());
+    TESTS_RUN(tests_crypto_chacha20poly1305_tests());
     TESTS_RUN(tests_crypto_aes_tests());
     TESTS_RUN(tests_crypto_3des_tests());
     TESTS_RUN(tests_crypto_twofish_tests());
@@ -19,6 +19,11 @@
 
 #include "ecc/hamming256.h"
 
+/* a 2 KiB NAND page */
+#define TEST_ECC_PAGE_SIZE      (2048U)
+
+static uint8_t page[TEST_ECC_PAGE_SIZE];
+
 static void test_single(void)
 {
     uint8_t data[256];
@@ -73,11 +78,44 @@ static void test_padding(void)
     TEST_ASSERT_EQUAL_INT(Hamming_ERROR_ECC, result);
 }
 
+static void test_page(void)
+{
+    uint8_t ecc[HAMMING256_CODE_SIZE(TEST_ECC_PAGE_SIZE)];
+
+    for (unsigned i = 0; i < TEST_ECC_PAGE_SIZE; i++) {
+        page[i] = (uint8_t)(i * 37);
+    }
+    hamming_compute256x(page, TEST_ECC_PAGE_SIZE, ecc);
+
+    /* every bit of one block is corrected at its position */
+    for (unsigned i = 5 * 256; i < 6 * 256; i++) {
+        for (unsigned bit = 0; bit < 8; bit++) {
+            page[i] ^= (1 << bit);
+            TEST_ASSERT_EQUAL_INT(Hamming_ERROR_SINGLEBIT,
+                                  hamming_verify256x(page, TEST_ECC_PAGE_SIZE,
+                                                     ecc));
+            TEST_ASSERT_EQUAL_INT((uint8_t)(i * 37), page[i]);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(Hamming_ERROR_NONE,
+                          hamming_verify256x(page, TEST_ECC_PAGE_SIZE, ecc));
+
+    /* one error in each of two blocks */
+    page[3] ^= 0x10;
+    page[TEST_ECC_PAGE_SIZE - 1] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(Hamming_ERROR_SINGLEBIT,
+                          hamming_verify256x(page, TEST_ECC_PAGE_SIZE, ecc));
+    TEST_ASSERT_EQUAL_INT((uint8_t)(3 * 37), page[3]);
+    TEST_ASSERT_EQUAL_INT((uint8_t)((TEST_ECC_PAGE_SIZE - 1) * 37),
+                          page[TEST_ECC_PAGE_SIZE - 1]);
+}
+
 TestRef test_all(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_single),
         new_TestFixture(test_padding),
+        new_TestFixture(test_page),
     };
 
     EMB_UNIT_TESTCALLER(EccTest, 0, 0, fixtures);
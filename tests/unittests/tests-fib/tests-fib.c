@@ -21,11 +21,18 @@
 
 #define TEST_FIB_TABLE_SIZE (20)
 static fib_entry_t _entries[TEST_FIB_TABLE_SIZE];
+#ifdef MODULE_FIB_TRIE
+static fib_trie_node_t _nodes[FIB_TRIE_NODES_NUMOF(TEST_FIB_TABLE_SIZE)];
+#endif
 static fib_table_t test_fib_table = { .data.entries = _entries,
                                       .table_type = FIB_TABLE_TYPE_SH,
                                       .size = TEST_FIB_TABLE_SIZE,
                                       .mtx_access = MUTEX_INIT,
-                                      .notify_rp_pos = 0 };
+                                      .notify_rp_pos = 0,
+#ifdef MODULE_FIB_TRIE
+                                      .trie_nodes = _nodes,
+#endif
+                                    };
 
 /*
 * @brief helper to fill FIB with unique entries
@@ -977,6 +984,235 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
+/*
+* @brief testing nested and equal prefixes while adding and removing them
+*/
+static void test_fib_21_nested_prefixes(void)
+{
+    size_t add_buf_size = 16;
+    uint8_t addr_dst[add_buf_size];
+    uint8_t addr_nxt[add_buf_size];
+    uint8_t addr_lookup[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+    /* prefix lengths of the entries, added in this order. The two /32
+    *  and the /20 differ in their (insignificant) trailing bits */
+    static const uint8_t lens[] = { 32, 16, 48, 32, 20, 0 };
+    static const uint8_t dst_extra[] = { 0, 0, 0, 0x01, 0x02, 0 };
+
+    for (unsigned i = 0; i < sizeof(lens); i++) {
+        memset(addr_dst, 0, add_buf_size);
+        memset(addr_nxt, 0, add_buf_size);
+        if (lens[i] > 0) {
+            addr_dst[0] = 0x20;
+            addr_dst[1] = 0x01;
+        }
+        if (lens[i] > 16) {
+            addr_dst[2] = 0x0d;
+            addr_dst[3] = 0xb8;
+        }
+        if (lens[i] > 32) {
+            addr_dst[5] = 0x01;
+        }
+        addr_dst[15] = dst_extra[i];
+        addr_nxt[15] = i + 1;
+        TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, 42, addr_dst,
+                              add_buf_size,
+                              ((uint32_t)lens[i] << FIB_FLAG_NET_PREFIX_SHIFT),
+                              addr_nxt, add_buf_size, 0, 100000));
+    }
+
+    memset(addr_lookup, 0, add_buf_size);
+    addr_lookup[0] = 0x20;
+    addr_lookup[1] = 0x01;
+    addr_lookup[2] = 0x0d;
+    addr_lookup[3] = 0xb8;
+    addr_lookup[5] = 0x01;
+    addr_lookup[15] = 0x42;
+
+    /* expected next hop after removing the entries from the front */
+    static const uint8_t expect[] = { 3, 3, 3, 4, 5, 6 };
+    for (unsigned i = 0; i < sizeof(lens); i++) {
+        add_buf_size = 16;
+        memset(addr_nxt, 0, add_buf_size);
+        TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                              addr_nxt, &add_buf_size, &next_hop_flags,
+                              addr_lookup, add_buf_size, 0));
+        TEST_ASSERT_EQUAL_INT(expect[i], addr_nxt[15]);
+
+        add_buf_size = 16;
+        memset(addr_dst, 0, add_buf_size);
+        if (lens[i] > 0) {
+            addr_dst[0] = 0x20;
+            addr_dst[1] = 0x01;
+        }
+        if (lens[i] > 16) {
+            addr_dst[2] = 0x0d;
+            addr_dst[3] = 0xb8;
+        }
+        if (lens[i] > 32) {
+            addr_dst[5] = 0x01;
+        }
+        addr_dst[15] = dst_extra[i];
+        fib_remove_entry(&test_fib_table, addr_dst, add_buf_size);
+        TEST_ASSERT_EQUAL_INT(sizeof(lens) - i - 1,
+                              fib_get_num_used_entries(&test_fib_table));
+    }
+
+    add_buf_size = 16;
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, fib_get_next_hop(&test_fib_table,
+                          &iface_id, addr_nxt, &add_buf_size, &next_hop_flags,
+                          addr_lookup, add_buf_size, 0));
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief testing that expired entries are removed after the expiry timer fired
+*/
+static void test_fib_23_lifetime_expiry(void)
+{
+    size_t add_buf_size = 16;
+    char addr_dst[] = "Test address231";
+    char addr_dst2[] = "Test address232";
+    char addr_nxt[] = "Test address233";
+    char addr_lookup[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, 42,
+                          (uint8_t *)addr_dst, add_buf_size - 1, 0x23,
+                          (uint8_t *)addr_nxt, add_buf_size - 1, 0x23, 1));
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, 42,
+                          (uint8_t *)addr_dst2, add_buf_size - 1, 0x23,
+                          (uint8_t *)addr_nxt, add_buf_size - 1, 0x23, 100000));
+    TEST_ASSERT_EQUAL_INT(2, fib_get_num_used_entries(&test_fib_table));
+
+    xtimer_usleep(5000);
+
+    TEST_ASSERT_EQUAL_INT(1, fib_get_num_used_entries(&test_fib_table));
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, fib_get_next_hop(&test_fib_table,
+                          &iface_id, (uint8_t *)addr_lookup, &add_buf_size,
+                          &next_hop_flags, (uint8_t *)addr_dst,
+                          add_buf_size - 1, 0x23));
+    add_buf_size = 16;
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table,
+                          &iface_id, (uint8_t *)addr_lookup, &add_buf_size,
+                          &next_hop_flags, (uint8_t *)addr_dst2,
+                          add_buf_size - 1, 0x23));
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief adding several destinations with one call updates the known one,
+* creates the others and fills the table up to its size
+*/
+static void test_fib_24_add_entries(void)
+{
+    size_t add_buf_size = 16;
+    char addr_dsts[TEST_FIB_TABLE_SIZE + 2][add_buf_size];
+    fib_dst_t dsts[TEST_FIB_TABLE_SIZE + 2];
+    char addr_nxt[] = "Test address241";
+    char addr_old_nxt[] = "Test address242";
+    char addr_lookup[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    for (unsigned i = 0; i < (TEST_FIB_TABLE_SIZE + 2); i++) {
+        snprintf(addr_dsts[i], add_buf_size, "Test dst %06u", i);
+        dsts[i].dst = (uint8_t *)addr_dsts[i];
+        dsts[i].dst_size = add_buf_size - 1;
+        dsts[i].dst_flags = 0x24;
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, 42,
+                          (uint8_t *)addr_dsts[1], add_buf_size - 1, 0x24,
+                          (uint8_t *)addr_old_nxt, add_buf_size - 1, 0x24,
+                          100000));
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entries(&test_fib_table, 42, dsts, 4,
+                          (uint8_t *)addr_nxt, add_buf_size - 1, 0x24, 100000));
+    TEST_ASSERT_EQUAL_INT(4, fib_get_num_used_entries(&test_fib_table));
+
+    for (unsigned i = 0; i < 4; i++) {
+        add_buf_size = 16;
+        TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                              (uint8_t *)addr_lookup, &add_buf_size,
+                              &next_hop_flags, (uint8_t *)addr_dsts[i],
+                              add_buf_size - 1, 0x24));
+        TEST_ASSERT_EQUAL_INT(0, strncmp(addr_nxt, addr_lookup, add_buf_size));
+    }
+
+    add_buf_size = 16;
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, fib_add_entries(&test_fib_table, 42,
+                          &dsts[4], TEST_FIB_TABLE_SIZE - 2,
+                          (uint8_t *)addr_nxt, add_buf_size - 1, 0x24, 100000));
+    TEST_ASSERT_EQUAL_INT(TEST_FIB_TABLE_SIZE,
+                          fib_get_num_used_entries(&test_fib_table));
+    fib_deinit(&test_fib_table);
+}
+
+#ifdef MODULE_FIB_MULTIPATH
+/*
+* @brief several weighted next hops and a backup for one destination
+*/
+static void test_fib_26_multipath(void)
+{
+    size_t add_buf_size = 16;
+    char addr_dst[] = "Test address261";
+    char addr_nxt[3][16] = { "Test address262", "Test address263",
+                             "Test address264" };
+    char addr_lookup[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+    unsigned used[3] = { 0 };
+
+    for (unsigned i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(0, fib_add_next_hop(&test_fib_table, 42,
+                              (uint8_t *)addr_dst, add_buf_size - 1, 0x26,
+                              (uint8_t *)addr_nxt[i], add_buf_size - 1, 0x26,
+                              (i < 2) ? FIB_WEIGHT_DEFAULT : 0, 100000));
+    }
+    TEST_ASSERT_EQUAL_INT(3, fib_get_num_used_entries(&test_fib_table));
+
+    for (uint32_t flow = 0; flow < 64; flow++) {
+        add_buf_size = 16;
+        TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop_flow(&test_fib_table, &iface_id,
+                              (uint8_t *)addr_lookup, &add_buf_size,
+                              &next_hop_flags, (uint8_t *)addr_dst,
+                              add_buf_size - 1, 0x26,
+                              fib_flow_hash(&flow, sizeof(flow), 0)));
+        for (unsigned i = 0; i < 3; i++) {
+            if (strncmp(addr_nxt[i], addr_lookup, add_buf_size) == 0) {
+                used[i]++;
+            }
+        }
+    }
+    TEST_ASSERT(used[0] > 0);
+    TEST_ASSERT(used[1] > 0);
+    TEST_ASSERT_EQUAL_INT(64, used[0] + used[1]);
+
+    /* the backup takes over */
+    add_buf_size = 16;
+    fib_remove_next_hop(&test_fib_table, (uint8_t *)addr_dst, add_buf_size - 1,
+                        (uint8_t *)addr_nxt[0], add_buf_size - 1);
+    fib_remove_next_hop(&test_fib_table, (uint8_t *)addr_dst, add_buf_size - 1,
+                        (uint8_t *)addr_nxt[1], add_buf_size - 1);
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                          (uint8_t *)addr_lookup, &add_buf_size,
+                          &next_hop_flags, (uint8_t *)addr_dst,
+                          add_buf_size - 1, 0x26));
+    TEST_ASSERT_EQUAL_INT(0, strncmp(addr_nxt[2], addr_lookup, add_buf_size));
+
+    add_buf_size = 16;
+    TEST_ASSERT_EQUAL_INT(0, fib_add_next_hop(&test_fib_table, 42,
+                          (uint8_t *)addr_dst, add_buf_size - 1, 0x26,
+                          (uint8_t *)addr_nxt[0], add_buf_size - 1, 0x26,
+                          FIB_WEIGHT_DEFAULT, 100000));
+    fib_remove_entry(&test_fib_table, (uint8_t *)addr_dst, add_buf_size - 1);
+    TEST_ASSERT_EQUAL_INT(0, fib_get_num_used_entries(&test_fib_table));
+    fib_deinit(&test_fib_table);
+}
+#endif
+
 Test *tests_fib_tests(void)
 {
     fib_init(&test_fib_table);
@@ -1001,6 +1237,12 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_nested_prefixes),
+                        new_TestFixture(test_fib_23_lifetime_expiry),
+                        new_TestFixture(test_fib_24_add_entries),
+#ifdef MODULE_FIB_MULTIPATH
+                        new_TestFixture(test_fib_26_multipath),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
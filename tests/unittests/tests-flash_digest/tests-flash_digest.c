@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "flash_digest.h"
+
+#define FLASH_LEN   (1000U)
+
+static uint8_t _flash[FLASH_LEN];
+static unsigned _reads;
+
+static int _read(void *arg, uint8_t *dst, uint32_t addr, size_t len)
+{
+    (void)arg;
+    _reads++;
+    memcpy(dst, &_flash[addr], len);
+    return len;
+}
+
+static int _read_fail(void *arg, uint8_t *dst, uint32_t addr, size_t len)
+{
+    (void)arg;
+    (void)dst;
+    (void)addr;
+    (void)len;
+    return -EIO;
+}
+
+static int _nvram_read(nvram_t *dev, uint8_t *dst, uint32_t src, size_t size)
+{
+    return _read(dev, dst, src, size);
+}
+
+static void set_up(void)
+{
+    for (unsigned i = 0; i < FLASH_LEN; i++) {
+        _flash[i] = (uint8_t)(i * 31);
+    }
+    _reads = 0;
+}
+
+static void test_flash_digest_mem(void)
+{
+    uint8_t expected[SHA256_DIGEST_LENGTH], digest[SHA256_DIGEST_LENGTH];
+
+    sha256(_flash, FLASH_LEN, expected);
+    flash_digest_mem(&digest_sha256, _flash, FLASH_LEN, digest);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, digest, sizeof(digest)));
+}
+
+static void test_flash_digest_read_chunks(void)
+{
+    uint8_t expected[MD5_DIGEST_LENGTH], digest[MD5_DIGEST_LENGTH];
+    uint8_t buf[7];
+
+    md5(expected, &_flash[3], FLASH_LEN - 3);
+    TEST_ASSERT_EQUAL_INT(0, flash_digest_read(&digest_md5, _read, NULL, 3,
+                                               FLASH_LEN - 3, buf, sizeof(buf),
+                                               digest));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, digest, sizeof(digest)));
+    TEST_ASSERT_EQUAL_INT((FLASH_LEN - 3 + sizeof(buf) - 1) / sizeof(buf),
+                          _reads);
+}
+
+static void test_flash_digest_read_default_buffer(void)
+{
+    uint8_t expected[SHA1_DIGEST_LENGTH], digest[SHA1_DIGEST_LENGTH];
+
+    sha1(expected, _flash, FLASH_LEN);
+    TEST_ASSERT_EQUAL_INT(0, flash_digest_read(&digest_sha1, _read, NULL, 0,
+                                               FLASH_LEN, NULL, 0, digest));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, digest, sizeof(digest)));
+}
+
+static void test_flash_digest_read_error(void)
+{
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+
+    TEST_ASSERT_EQUAL_INT(-EIO, flash_digest_read(&digest_sha256, _read_fail,
+                                                  NULL, 0, FLASH_LEN, NULL, 0,
+                                                  digest));
+}
+
+static void test_flash_digest_nvram(void)
+{
+    nvram_t dev = { .read = _nvram_read, .size = FLASH_LEN };
+    uint8_t expected[SHA256_DIGEST_LENGTH], digest[SHA256_DIGEST_LENGTH];
+
+    sha256(&_flash[100], 200, expected);
+    TEST_ASSERT_EQUAL_INT(0, flash_digest_nvram(&digest_sha256, &dev, 100, 200,
+                                                NULL, 0, digest));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, digest, sizeof(digest)));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, flash_digest_nvram(&digest_sha256, &dev,
+                                                      FLASH_LEN - 1, 2, NULL,
+                                                      0, digest));
+}
+
+Test *tests_flash_digest_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_flash_digest_mem),
+        new_TestFixture(test_flash_digest_read_chunks),
+        new_TestFixture(test_flash_digest_read_default_buffer),
+        new_TestFixture(test_flash_digest_read_error),
+        new_TestFixture(test_flash_digest_nvram),
+    };
+
+    EMB_UNIT_TESTCALLER(flash_digest_tests, set_up, NULL, fixtures);
+
+    return (Test *)&flash_digest_tests;
+}
+
+void tests_flash_digest(void)
+{
+    TESTS_RUN(tests_flash_digest_tests());
+}
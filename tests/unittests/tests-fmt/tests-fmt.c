@@ -120,6 +120,17 @@ static void test_fmt_s32_dec(void)
     TEST_ASSERT_EQUAL_STRING("-9876", (char *) out);
 }
 
+static void test_fmt_s32_dec_min(void)
+{
+    char out[12] = "-----------";
+    uint8_t chars = 0;
+
+    chars = fmt_s32_dec(out, INT32_MIN);
+    TEST_ASSERT_EQUAL_INT(11, chars);
+    out[chars] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-2147483648", (char *) out);
+}
+
 static void test_fmt_u64_dec_a(void)
 {
     char out[21] = "------------------";
@@ -245,6 +256,72 @@ static void test_rmt_s16_dfp(void)
     TEST_ASSERT_EQUAL_STRING("", (char *)out);
 }
 
+static void test_fmt_s32_dfp(void)
+{
+    char out[FMT_S32_DFP_MAXLEN + 1];
+    size_t len;
+
+    len = fmt_s32_dfp(out, INT32_MIN, 9);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(FMT_S32_DFP_MAXLEN, len);
+    TEST_ASSERT_EQUAL_INT(len, fmt_s32_dfp(NULL, INT32_MIN, 9));
+    TEST_ASSERT_EQUAL_STRING("-2.147483648", (char *)out);
+
+    len = fmt_s32_dfp(out, 123456, 2);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("1234.56", (char *)out);
+
+    len = fmt_s32_dfp(out, -5, 3);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-0.005", (char *)out);
+
+    len = fmt_s32_dfp(out, -42, -3);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(6, len);
+    TEST_ASSERT_EQUAL_INT(len, fmt_s32_dfp(NULL, -42, -3));
+    TEST_ASSERT_EQUAL_STRING("-42000", (char *)out);
+
+    len = fmt_s32_dfp(out, 0, -3);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("0", (char *)out);
+
+    TEST_ASSERT_EQUAL_INT(0, fmt_s32_dfp(out, 1, 10));
+}
+
+static void test_fmt_float(void)
+{
+    char out[FMT_FLOAT_MAXLEN + 1];
+    size_t len;
+
+    len = fmt_float(out, 3.14159f, 3);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(5, len);
+    TEST_ASSERT_EQUAL_INT(len, fmt_float(NULL, 3.14159f, 3));
+    TEST_ASSERT_EQUAL_STRING("3.142", (char *)out);
+
+    len = fmt_float(out, -0.26f, 1);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-0.3", (char *)out);
+
+    /* rounding carries over into the integer part */
+    len = fmt_float(out, 9.999f, 2);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("10.00", (char *)out);
+
+    len = fmt_float(out, 1234.5f, 0);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("1235", (char *)out);
+
+    len = fmt_float(out, -4294967040.0f, 7);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_INT(FMT_FLOAT_MAXLEN, len);
+    TEST_ASSERT_EQUAL_STRING("-4294967040.0000000", (char *)out);
+
+    len = fmt_float(out, 1e10f, 2);
+    out[len] = '\0';
+    TEST_ASSERT_EQUAL_STRING("inf", (char *)out);
+}
+
 static void test_fmt_strlen(void)
 {
     const char *empty_str = "";
@@ -288,8 +365,11 @@ Test *tests_fmt_tests(void)
         new_TestFixture(test_fmt_u64_dec_c),
         new_TestFixture(test_fmt_u16_dec),
         new_TestFixture(test_fmt_s32_dec),
+        new_TestFixture(test_fmt_s32_dec_min),
         new_TestFixture(test_rmt_s16_dec),
         new_TestFixture(test_rmt_s16_dfp),
+        new_TestFixture(test_fmt_s32_dfp),
+        new_TestFixture(test_fmt_float),
         new_TestFixture(test_fmt_strlen),
         new_TestFixture(test_fmt_str),
         new_TestFixture(test_scn_u32_dec),
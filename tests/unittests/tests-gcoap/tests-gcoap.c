@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 #include "embUnit.h"
@@ -51,6 +52,29 @@ static void test_gcoap__client_get_req(void)
     TEST_ASSERT_EQUAL_INT(sizeof(pdu_data), len);
 }
 
+/*
+ * Client confirmable request. Test setting the type keeps the rest of the
+ * header.
+ */
+static void test_gcoap__client_con_req(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    char path[] = "/time";
+
+    gcoap_request(&pdu, &buf[0], GCOAP_PDU_BUF_SIZE, COAP_METHOD_GET,
+                                                     &path[0]);
+    gcoap_hdr_set_type(pdu.hdr, COAP_TYPE_CON);
+
+    TEST_ASSERT_EQUAL_INT(COAP_TYPE_CON, coap_get_type(&pdu));
+    TEST_ASSERT_EQUAL_INT(4 + GCOAP_TOKENLEN, coap_get_total_hdr_len(&pdu));
+    TEST_ASSERT_EQUAL_INT(GCOAP_TOKENLEN, coap_get_token_len(&pdu));
+    TEST_ASSERT_EQUAL_INT(COAP_METHOD_GET, coap_get_code(&pdu));
+
+    gcoap_hdr_set_type(pdu.hdr, COAP_TYPE_NON);
+    TEST_ASSERT_EQUAL_INT(COAP_TYPE_NON, coap_get_type(&pdu));
+}
+
 /*
  * Client GET response success case. Test parsing response.
  * Response for /time resource from libcoap example
@@ -156,13 +180,87 @@ static void test_gcoap__server_get_resp(void)
     }
 }
 
+/* Server reading unsigned integer options of a request. */
+static void test_gcoap__server_get_uint(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    gcoap_block_t block;
+    uint32_t value;
+
+    /* GET /cli, Accept: 40, Block2: 0/0/64, payload "x" */
+    uint8_t pdu_data[] = {
+        0x52, 0x01, 0x12, 0x34, 0xab, 0xcd, 0xb3, 0x63,
+        0x6c, 0x69, 0x61, 0x28, 0x61, 0x02, 0xff, 0x78
+    };
+    memcpy(buf, pdu_data, sizeof(pdu_data));
+
+    TEST_ASSERT_EQUAL_INT(0, coap_parse(&pdu, &buf[0], sizeof(pdu_data)));
+    TEST_ASSERT_EQUAL_INT(1, gcoap_get_uint(&pdu, GCOAP_OPT_ACCEPT, &value));
+    TEST_ASSERT_EQUAL_INT(COAP_FORMAT_LINK, value);
+    TEST_ASSERT_EQUAL_INT(0, gcoap_get_uint(&pdu, GCOAP_OPT_MAX_AGE, &value));
+    TEST_ASSERT_EQUAL_INT(1, gcoap_get_block(&pdu, GCOAP_OPT_BLOCK2, &block));
+    TEST_ASSERT_EQUAL_INT(0, block.num);
+    TEST_ASSERT_EQUAL_INT(2, block.szx);
+    TEST_ASSERT_EQUAL_INT(0, gcoap_get_block(&pdu, GCOAP_OPT_BLOCK1, &block));
+}
+
+#define TEST_GCOAP_RESOURCES    (80U)
+
+static char _paths[TEST_GCOAP_RESOURCES][sizeof("/res/00")];
+static coap_resource_t _resources[TEST_GCOAP_RESOURCES];
+static gcoap_listener_t _listener;
+
+static ssize_t _dummy_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static void _register_resources(void)
+{
+    if (_listener.resources) {
+        return;
+    }
+    for (unsigned i = 0; i < TEST_GCOAP_RESOURCES; i++) {
+        sprintf(_paths[i], "/res/%02u", i);
+        _resources[i].path = _paths[i];
+        /* odd resources only accept PUT */
+        _resources[i].methods = (i & 1) ? COAP_PUT : COAP_GET;
+        _resources[i].handler = _dummy_handler;
+    }
+    _listener.resources = _resources;
+    _listener.resources_len = TEST_GCOAP_RESOURCES;
+    gcoap_register_listener(&_listener);
+}
+
+/* Server resource lookup in a large, sorted listener. */
+static void test_gcoap__server_find_resource(void)
+{
+    _register_resources();
+
+    for (unsigned i = 0; i < TEST_GCOAP_RESOURCES; i++) {
+        unsigned method = (i & 1) ? COAP_PUT : COAP_GET;
+        unsigned other = (i & 1) ? COAP_GET : COAP_PUT;
+
+        TEST_ASSERT(&_resources[i] == gcoap_find_resource(_paths[i], method));
+        TEST_ASSERT_NULL(gcoap_find_resource(_paths[i], other));
+    }
+    TEST_ASSERT_NULL(gcoap_find_resource("/res", COAP_GET));
+    TEST_ASSERT_NULL(gcoap_find_resource("/res/800", COAP_GET));
+    /* resource of gcoap itself */
+    TEST_ASSERT_NOT_NULL(gcoap_find_resource("/.well-known/core", COAP_GET));
+}
+
 Test *tests_gcoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_gcoap__client_get_req),
+        new_TestFixture(test_gcoap__client_con_req),
         new_TestFixture(test_gcoap__client_get_resp),
         new_TestFixture(test_gcoap__server_get_req),
         new_TestFixture(test_gcoap__server_get_resp),
+        new_TestFixture(test_gcoap__server_get_uint),
+        new_TestFixture(test_gcoap__server_find_resource),
     };
 
     EMB_UNIT_TESTCALLER(gcoap_tests, NULL, NULL, fixtures);
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/fib.h"
+#include "net/gnrc/ipv6/route_cache.h"
+#include "net/ipv6/addr.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_ipv6_route_cache.h"
+
+/* default interface for testing */
+#define DEFAULT_TEST_NETIF      (TEST_UINT8)
+/* default destination for testing */
+#define DEFAULT_TEST_IPV6_ADDR  { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+            0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f \
+        } \
+    }
+/* another destination for testing */
+#define OTHER_TEST_IPV6_ADDR    { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+            0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f \
+        } \
+    }
+/* next hop for FIB entries */
+#define NEXT_HOP_IPV6_ADDR      { { \
+            0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 \
+        } \
+    }
+
+#define TEST_FIB_TABLE_SIZE     (4)
+
+static fib_entry_t _entries[TEST_FIB_TABLE_SIZE];
+static fib_table_t _fib_table = { .data.entries = _entries,
+                                  .table_type = FIB_TABLE_TYPE_SH,
+                                  .size = TEST_FIB_TABLE_SIZE,
+                                  .mtx_access = MUTEX_INIT };
+
+static const uint8_t _l2addr[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x01 };
+
+static void set_up(void)
+{
+    /* drops all entries the previous test left */
+    gnrc_ipv6_route_cache_invalidate();
+    fib_init(&_fib_table);
+}
+
+static void tear_down(void)
+{
+    fib_deinit(&_fib_table);
+}
+
+/* looks up dst and, as the forwarding path does on a miss, stores it */
+static void _cache(const ipv6_addr_t *dst)
+{
+    uint8_t l2addr[GNRC_IPV6_ROUTE_CACHE_L2ADDR_MAX];
+    uint8_t l2addr_len;
+
+    TEST_ASSERT_EQUAL_INT(KERNEL_PID_UNDEF,
+                          gnrc_ipv6_route_cache_get(dst, l2addr, &l2addr_len));
+    gnrc_ipv6_route_cache_add(dst, DEFAULT_TEST_NETIF, _l2addr, sizeof(_l2addr));
+}
+
+static int _is_cached(const ipv6_addr_t *dst)
+{
+    uint8_t l2addr[GNRC_IPV6_ROUTE_CACHE_L2ADDR_MAX];
+    uint8_t l2addr_len;
+
+    return gnrc_ipv6_route_cache_get(dst, l2addr, &l2addr_len) != KERNEL_PID_UNDEF;
+}
+
+static void _fib_add(ipv6_addr_t *dst)
+{
+    ipv6_addr_t next_hop = NEXT_HOP_IPV6_ADDR;
+
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&_fib_table, DEFAULT_TEST_NETIF,
+                                           dst->u8, sizeof(ipv6_addr_t), 0,
+                                           next_hop.u8, sizeof(ipv6_addr_t), 0,
+                                           FIB_LIFETIME_NO_EXPIRE));
+}
+
+static void test_route_cache_get__empty(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_IPV6_ADDR;
+
+    TEST_ASSERT(!_is_cached(&dst));
+}
+
+static void test_route_cache_get__hit(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_IPV6_ADDR;
+    uint8_t l2addr[GNRC_IPV6_ROUTE_CACHE_L2ADDR_MAX];
+    uint8_t l2addr_len = 0;
+    uint32_t hits = gnrc_ipv6_route_cache_stats()->hits;
+
+    _cache(&dst);
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_NETIF,
+                          gnrc_ipv6_route_cache_get(&dst, l2addr, &l2addr_len));
+    TEST_ASSERT_EQUAL_INT(sizeof(_l2addr), l2addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_l2addr, l2addr, sizeof(_l2addr)));
+    TEST_ASSERT_EQUAL_INT(hits + 1, gnrc_ipv6_route_cache_stats()->hits);
+}
+
+static void test_route_cache_get__other_dst(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t other = OTHER_TEST_IPV6_ADDR;
+
+    _cache(&dst);
+    TEST_ASSERT(!_is_cached(&other));
+    TEST_ASSERT(_is_cached(&dst));
+}
+
+static void test_route_cache_add__l2addr_too_long(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_IPV6_ADDR;
+    uint8_t l2addr[GNRC_IPV6_ROUTE_CACHE_L2ADDR_MAX + 1] = { 0 };
+
+    TEST_ASSERT(!_is_cached(&dst));
+    gnrc_ipv6_route_cache_add(&dst, DEFAULT_TEST_NETIF, l2addr, sizeof(l2addr));
+    TEST_ASSERT(!_is_cached(&dst));
+}
+
+static void test_route_cache_add__full(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t first = DEFAULT_TEST_IPV6_ADDR;
+
+    /* the oldest entry is replaced */
+    for (unsigned i = 0; i <= GNRC_IPV6_ROUTE_CACHE_SIZE; i++) {
+        dst.u8[15] = i;
+        _cache(&dst);
+    }
+    first.u8[15] = 0;
+    TEST_ASSERT(!_is_cached(&first));
+    TEST_ASSERT(_is_cached(&dst));
+}
+
+static void test_route_cache_add__invalidated_after_miss(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_IPV6_ADDR;
+
+    /* the next hop was computed from state that changed meanwhile */
+    TEST_ASSERT(!_is_cached(&dst));
+    gnrc_ipv6_route_cache_invalidate();
+    gnrc_ipv6_route_cache_add(&dst, DEFAULT_TEST_NETIF, _l2addr, sizeof(_l2addr));
+    TEST_ASSERT(!_is_cached(&dst));
+}
+
+static void test_route_cache_invalidate(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_IPV6_ADDR;
+    uint32_t flushes = gnrc_ipv6_route_cache_stats()->flushes;
+
+    _cache(&dst);
+    gnrc_ipv6_route_cache_invalidate();
+    TEST_ASSERT(!_is_cached(&dst));
+    TEST_ASSERT_EQUAL_INT(flushes + 1, gnrc_ipv6_route_cache_stats()->flushes);
+}
+
+static void test_route_cache_invalidate__fib_add(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_IPV6_ADDR;
+    ipv6_addr_t other = OTHER_TEST_IPV6_ADDR;
+
+    _cache(&dst);
+    _fib_add(&other);
+    TEST_ASSERT(!_is_cached(&dst));
+}
+
+static void test_route_cache_invalidate__fib_remove(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_IPV6_ADDR;
+
+    _fib_add(&dst);
+    _cache(&dst);
+    fib_remove_entry(&_fib_table, dst.u8, sizeof(ipv6_addr_t));
+    TEST_ASSERT(!_is_cached(&dst));
+}
+
+static void test_route_cache_invalidate__fib_flush(void)
+{
+    ipv6_addr_t dst = DEFAULT_TEST_IPV6_ADDR;
+
+    _fib_add(&dst);
+    _cache(&dst);
+    fib_flush(&_fib_table, KERNEL_PID_UNDEF);
+    TEST_ASSERT(!_is_cached(&dst));
+}
+
+Test *tests_gnrc_ipv6_route_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_route_cache_get__empty),
+        new_TestFixture(test_route_cache_get__hit),
+        new_TestFixture(test_route_cache_get__other_dst),
+        new_TestFixture(test_route_cache_add__l2addr_too_long),
+        new_TestFixture(test_route_cache_add__full),
+        new_TestFixture(test_route_cache_add__invalidated_after_miss),
+        new_TestFixture(test_route_cache_invalidate),
+        new_TestFixture(test_route_cache_invalidate__fib_add),
+        new_TestFixture(test_route_cache_invalidate__fib_remove),
+        new_TestFixture(test_route_cache_invalidate__fib_flush),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_ipv6_route_cache_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_ipv6_route_cache_tests;
+}
+
+void tests_gnrc_ipv6_route_cache(void)
+{
+    TESTS_RUN(tests_gnrc_ipv6_route_cache_tests());
+}
+/** @} */
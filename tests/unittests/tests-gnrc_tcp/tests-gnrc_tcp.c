@@ -0,0 +1,620 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "msg.h"
+#include "thread.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_tcp.h"
+
+/* our address */
+#define LOCAL_IPV6_ADDR     { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 \
+        } \
+    }
+/* address of the peer */
+#define PEER_IPV6_ADDR      { { \
+            0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 \
+        } \
+    }
+
+#define LOCAL_PORT          (80U)
+#define PEER_PORT           (50000U)
+#define PEER_ISS            (0x10000000UL)
+#define PEER_WND            (1000U)
+#define PEER_MSS            (500U)
+
+#define TEST_TCBS_NUMOF     (2U)
+#define TEST_MSG_QUEUE_SIZE (8U)
+
+/* a segment as sent by the TCP implementation */
+typedef struct {
+    uint32_t seq;
+    uint32_t ack;
+    uint16_t wnd;
+    uint16_t mss;
+    uint8_t ctl;
+    size_t len;
+} sent_t;
+
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+static gnrc_netreg_entry_t _netreg;
+static gnrc_tcp_listener_t _listener;
+static gnrc_tcp_tcb_t _tcbs[TEST_TCBS_NUMOF];
+/* initial send sequence number of the last connection */
+static uint32_t _iss;
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    /* segments sent to IPv6 end up in our own queue */
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    gnrc_netreg_entry_init_pid(&_netreg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               thread_getpid());
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_netreg);
+    gnrc_tcp_listen(&_listener, NULL, LOCAL_PORT, _tcbs, TEST_TCBS_NUMOF);
+}
+
+static void tear_down(void)
+{
+    msg_t msg;
+
+    for (unsigned i = 0; i < TEST_TCBS_NUMOF; i++) {
+        gnrc_tcp_abort(&_tcbs[i]);
+    }
+    gnrc_tcp_stop_listen(&_listener);
+    while (msg_try_receive(&msg) > 0) {
+        gnrc_pktbuf_release(msg.content.ptr);
+    }
+    gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, &_netreg);
+}
+
+/* lets the peer send a segment to LOCAL_PORT */
+static void _receive(uint16_t dst_port, uint8_t ctl, uint32_t seq, uint32_t ack,
+                     uint16_t wnd, const void *data, size_t len)
+{
+    ipv6_addr_t local = LOCAL_IPV6_ADDR;
+    ipv6_addr_t peer = PEER_IPV6_ADDR;
+    size_t hdr_len = sizeof(tcp_hdr_t) + ((ctl & TCP_CTL_SYN) ? TCP_OPTION_LENGTH_MSS : 0);
+    gnrc_pktsnip_t *ipv6, *tcp;
+    ipv6_hdr_t *ipv6_hdr;
+    tcp_hdr_t *hdr;
+
+    TEST_ASSERT_NOT_NULL(ipv6 = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t),
+                                                GNRC_NETTYPE_IPV6));
+    ipv6_hdr = ipv6->data;
+    memset(ipv6_hdr, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(ipv6_hdr);
+    ipv6_hdr->len = byteorder_htons(hdr_len + len);
+    ipv6_hdr->nh = PROTNUM_TCP;
+    ipv6_hdr->src = peer;
+    ipv6_hdr->dst = local;
+    /* header and data in one snip, as IPv6 hands it up */
+    TEST_ASSERT_NOT_NULL(tcp = gnrc_pktbuf_add(ipv6, NULL, hdr_len + len,
+                                               GNRC_NETTYPE_TCP));
+    hdr = tcp->data;
+    memset(hdr, 0, hdr_len);
+    hdr->src_port = byteorder_htons(PEER_PORT);
+    hdr->dst_port = byteorder_htons(dst_port);
+    hdr->seq_num = byteorder_htonl(seq);
+    hdr->ack_num = byteorder_htonl(ack);
+    hdr->off_ctl = byteorder_htons(((hdr_len / 4) << 12) | ctl);
+    hdr->window = byteorder_htons(wnd);
+    if (ctl & TCP_CTL_SYN) {
+        uint8_t *opt = (uint8_t *)(hdr + 1);
+
+        opt[0] = TCP_OPTION_KIND_MSS;
+        opt[1] = TCP_OPTION_LENGTH_MSS;
+        opt[2] = (uint8_t)(PEER_MSS >> 8);
+        opt[3] = (uint8_t)(PEER_MSS);
+    }
+    if (len > 0) {
+        memcpy((uint8_t *)tcp->data + hdr_len, data, len);
+    }
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tcp_calc_csum(tcp, ipv6));
+    gnrc_tcp_receive(tcp);
+}
+
+/* takes the next segment the TCP implementation sent */
+static void _sent(sent_t *sent)
+{
+    ipv6_addr_t peer = PEER_IPV6_ADDR;
+    gnrc_pktsnip_t *pkt, *ipv6, *tcp;
+    tcp_hdr_t *hdr;
+    msg_t msg;
+
+    memset(sent, 0, sizeof(sent_t));
+    TEST_ASSERT_EQUAL_INT(1, msg_try_receive(&msg));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_SND, msg.type);
+    pkt = msg.content.ptr;
+    TEST_ASSERT_NOT_NULL(ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6));
+    TEST_ASSERT(ipv6_addr_equal(&peer, &((ipv6_hdr_t *)ipv6->data)->dst));
+    TEST_ASSERT_NOT_NULL(tcp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_TCP));
+    hdr = tcp->data;
+    sent->seq = byteorder_ntohl(hdr->seq_num);
+    sent->ack = byteorder_ntohl(hdr->ack_num);
+    sent->wnd = byteorder_ntohs(hdr->window);
+    sent->ctl = tcp_hdr_get_ctl(hdr);
+    sent->mss = gnrc_tcp_parse_mss(hdr, tcp->size);
+    sent->len = (tcp->next != NULL) ? tcp->next->size : 0;
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _expect(uint8_t ctl, uint32_t seq, uint32_t ack, size_t len)
+{
+    sent_t sent;
+
+    _sent(&sent);
+    TEST_ASSERT_EQUAL_INT(ctl, sent.ctl);
+    TEST_ASSERT_EQUAL_INT(seq, sent.seq);
+    TEST_ASSERT_EQUAL_INT(ack, sent.ack);
+    TEST_ASSERT_EQUAL_INT(len, sent.len);
+}
+
+static void _expect_nothing(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+}
+
+/* passive open, the connection is accepted as _tcbs[0] */
+static void _establish(uint16_t wnd)
+{
+    gnrc_tcp_tcb_t *tcb = NULL;
+    sent_t sent;
+
+    _receive(LOCAL_PORT, TCP_CTL_SYN, PEER_ISS, 0, wnd, NULL, 0);
+    _sent(&sent);
+    _iss = sent.seq;
+    _receive(LOCAL_PORT, TCP_CTL_ACK, PEER_ISS + 1, _iss + 1, wnd, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tcp_accept(&_listener, &tcb, 0));
+    TEST_ASSERT(tcb == &_tcbs[0]);
+}
+
+/* gets the MSS of a header with the given options */
+static uint16_t _parse_mss(const uint8_t *opt, size_t opt_len)
+{
+    union {
+        tcp_hdr_t hdr;
+        uint8_t raw[sizeof(tcp_hdr_t) + 8];
+    } seg;
+
+    memset(&seg, 0, sizeof(seg));
+    if (opt_len > 0) {
+        memcpy(&seg.raw[sizeof(tcp_hdr_t)], opt, opt_len);
+    }
+    return gnrc_tcp_parse_mss(&seg.hdr, sizeof(tcp_hdr_t) + opt_len);
+}
+
+static void test_tcp_parse_mss(void)
+{
+    const uint8_t opt[] = { TCP_OPTION_KIND_MSS, TCP_OPTION_LENGTH_MSS, 0x04, 0xc4 };
+
+    TEST_ASSERT_EQUAL_INT(1220, _parse_mss(opt, sizeof(opt)));
+}
+
+static void test_tcp_parse_mss__no_options(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _parse_mss(NULL, 0));
+}
+
+static void test_tcp_parse_mss__nop(void)
+{
+    const uint8_t opt[] = { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP,
+                            TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP,
+                            TCP_OPTION_KIND_MSS, TCP_OPTION_LENGTH_MSS, 0x02, 0x18 };
+
+    TEST_ASSERT_EQUAL_INT(536, _parse_mss(opt, sizeof(opt)));
+}
+
+static void test_tcp_parse_mss__after_other(void)
+{
+    /* window scale option, skipped */
+    const uint8_t opt[] = { 3, 3, 7, TCP_OPTION_KIND_NOP,
+                            TCP_OPTION_KIND_MSS, TCP_OPTION_LENGTH_MSS, 0x02, 0x18 };
+
+    TEST_ASSERT_EQUAL_INT(536, _parse_mss(opt, sizeof(opt)));
+}
+
+static void test_tcp_parse_mss__eol(void)
+{
+    const uint8_t opt[] = { TCP_OPTION_KIND_EOL, 0, 0, 0,
+                            TCP_OPTION_KIND_MSS, TCP_OPTION_LENGTH_MSS, 0x02, 0x18 };
+
+    TEST_ASSERT_EQUAL_INT(0, _parse_mss(opt, sizeof(opt)));
+}
+
+static void test_tcp_parse_mss__length_missing(void)
+{
+    const uint8_t opt[] = { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP,
+                            TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_MSS };
+
+    TEST_ASSERT_EQUAL_INT(0, _parse_mss(opt, sizeof(opt)));
+}
+
+static void test_tcp_parse_mss__truncated(void)
+{
+    /* the option claims more bytes than the header holds */
+    const uint8_t opt[] = { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_MSS,
+                            TCP_OPTION_LENGTH_MSS, 0x04 };
+
+    TEST_ASSERT_EQUAL_INT(0, _parse_mss(opt, sizeof(opt)));
+}
+
+static void test_tcp_parse_mss__zero_length(void)
+{
+    /* must not loop forever */
+    const uint8_t opt[] = { 3, 0, TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP,
+                            TCP_OPTION_KIND_MSS, TCP_OPTION_LENGTH_MSS, 0x02, 0x18 };
+
+    TEST_ASSERT_EQUAL_INT(0, _parse_mss(opt, sizeof(opt)));
+}
+
+static void test_tcp_parse_mss__one_length(void)
+{
+    const uint8_t opt[] = { TCP_OPTION_KIND_MSS, 1, 0x02, 0x18 };
+
+    TEST_ASSERT_EQUAL_INT(0, _parse_mss(opt, sizeof(opt)));
+}
+
+static void test_tcp_parse_mss__wrong_length(void)
+{
+    const uint8_t opt[] = { TCP_OPTION_KIND_MSS, 3, 0x02, TCP_OPTION_KIND_EOL };
+
+    TEST_ASSERT_EQUAL_INT(0, _parse_mss(opt, sizeof(opt)));
+}
+
+static void test_tcp_handshake(void)
+{
+    gnrc_tcp_tcb_t *tcb = NULL;
+    sent_t sent;
+
+    _receive(LOCAL_PORT, TCP_CTL_SYN, PEER_ISS, 0, PEER_WND, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_SYN_RCVD, _tcbs[0].state);
+    TEST_ASSERT_EQUAL_INT(-EAGAIN, gnrc_tcp_accept(&_listener, &tcb, 0));
+    _sent(&sent);
+    TEST_ASSERT_EQUAL_INT(TCP_CTL_SYN | TCP_CTL_ACK, sent.ctl);
+    TEST_ASSERT_EQUAL_INT(PEER_ISS + 1, sent.ack);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_MSS, sent.mss);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE, sent.wnd);
+    _receive(LOCAL_PORT, TCP_CTL_ACK, PEER_ISS + 1, sent.seq + 1, PEER_WND, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_ESTABLISHED, _tcbs[0].state);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tcp_accept(&_listener, &tcb, 0));
+    TEST_ASSERT(tcb == &_tcbs[0]);
+    TEST_ASSERT_EQUAL_INT(PEER_MSS, tcb->mss);
+    TEST_ASSERT_EQUAL_INT(PEER_WND, tcb->snd_wnd);
+    _expect_nothing();
+}
+
+static void test_tcp_handshake__syn_ack_rtx(void)
+{
+    sent_t sent;
+    uint32_t rto;
+
+    _receive(LOCAL_PORT, TCP_CTL_SYN, PEER_ISS, 0, PEER_WND, NULL, 0);
+    _sent(&sent);
+    rto = _tcbs[0].rto;
+    gnrc_tcp_expire_timers();
+    _expect(TCP_CTL_SYN | TCP_CTL_ACK, sent.seq, PEER_ISS + 1, 0);
+    TEST_ASSERT_EQUAL_INT(2 * rto, _tcbs[0].rto);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_SYN_RCVD, _tcbs[0].state);
+    /* a retransmitted SYN is answered as well */
+    _receive(LOCAL_PORT, TCP_CTL_SYN, PEER_ISS, 0, PEER_WND, NULL, 0);
+    _expect(TCP_CTL_SYN | TCP_CTL_ACK, sent.seq, PEER_ISS + 1, 0);
+}
+
+static void test_tcp_handshake__wrong_ack(void)
+{
+    sent_t sent;
+
+    _receive(LOCAL_PORT, TCP_CTL_SYN, PEER_ISS, 0, PEER_WND, NULL, 0);
+    _sent(&sent);
+    _receive(LOCAL_PORT, TCP_CTL_ACK, PEER_ISS + 1, sent.seq + 2, PEER_WND, NULL, 0);
+    _expect(TCP_CTL_RST, sent.seq + 2, 0, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_SYN_RCVD, _tcbs[0].state);
+}
+
+static void test_tcp_handshake__closed_port(void)
+{
+    _receive(LOCAL_PORT + 1, TCP_CTL_SYN, PEER_ISS, 0, PEER_WND, NULL, 0);
+    _expect(TCP_CTL_RST | TCP_CTL_ACK, 0, PEER_ISS + 1, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_CLOSED, _tcbs[0].state);
+}
+
+static void test_tcp_rst(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    char buf[4];
+
+    _establish(PEER_WND);
+
+    _receive(LOCAL_PORT, TCP_CTL_RST, PEER_ISS + 1, 0, 0, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_CLOSED, tcb->state);
+    TEST_ASSERT_EQUAL_INT(-ECONNRESET, gnrc_tcp_recv(tcb, buf, sizeof(buf), 0));
+    _expect_nothing();
+}
+
+static void test_tcp_recv(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    char buf[8];
+
+    _establish(PEER_WND);
+
+    TEST_ASSERT_EQUAL_INT(-EAGAIN, gnrc_tcp_recv(tcb, buf, sizeof(buf), 0));
+    _receive(LOCAL_PORT, TCP_CTL_ACK | TCP_CTL_PSH, PEER_ISS + 1, _iss + 1,
+             PEER_WND, "hello", 5);
+    /* the acknowledgment is delayed */
+    _expect_nothing();
+    TEST_ASSERT_EQUAL_INT(5, gnrc_tcp_recv(tcb, buf, sizeof(buf), 0));
+    TEST_ASSERT_EQUAL_INT(0, memcmp("hello", buf, 5));
+    gnrc_tcp_expire_timers();
+    _expect(TCP_CTL_ACK, _iss + 1, PEER_ISS + 6, 0);
+    /* a duplicate is acknowledged right away, but not delivered again */
+    _receive(LOCAL_PORT, TCP_CTL_ACK | TCP_CTL_PSH, PEER_ISS + 1, _iss + 1,
+             PEER_WND, "hello", 5);
+    _expect(TCP_CTL_ACK, _iss + 1, PEER_ISS + 6, 0);
+    TEST_ASSERT_EQUAL_INT(-EAGAIN, gnrc_tcp_recv(tcb, buf, sizeof(buf), 0));
+}
+
+static void test_tcp_send__rtx(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+
+    _establish(PEER_WND);
+    uint32_t rto;
+
+    TEST_ASSERT_EQUAL_INT(4, gnrc_tcp_send(tcb, "abcd", 4));
+    _expect(TCP_CTL_ACK | TCP_CTL_PSH, _iss + 1, PEER_ISS + 1, 4);
+    rto = tcb->rto;
+    gnrc_tcp_expire_timers();
+    _expect(TCP_CTL_ACK | TCP_CTL_PSH, _iss + 1, PEER_ISS + 1, 4);
+    TEST_ASSERT_EQUAL_INT(2 * rto, tcb->rto);
+    _receive(LOCAL_PORT, TCP_CTL_ACK, PEER_ISS + 1, _iss + 5, PEER_WND, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(0, tcb->snd_len);
+    TEST_ASSERT_EQUAL_INT(0, tcb->retries);
+    /* nothing left to retransmit */
+    gnrc_tcp_expire_timers();
+    _expect_nothing();
+}
+
+static void test_tcp_send__max_retries(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    char buf[4];
+
+    _establish(PEER_WND);
+
+    TEST_ASSERT_EQUAL_INT(4, gnrc_tcp_send(tcb, "abcd", 4));
+    _expect(TCP_CTL_ACK | TCP_CTL_PSH, _iss + 1, PEER_ISS + 1, 4);
+    for (unsigned i = 0; i < GNRC_TCP_MAX_RETRIES; i++) {
+        gnrc_tcp_expire_timers();
+        _expect(TCP_CTL_ACK | TCP_CTL_PSH, _iss + 1, PEER_ISS + 1, 4);
+    }
+    gnrc_tcp_expire_timers();
+    _expect(TCP_CTL_RST, _iss + 5, 0, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_CLOSED, tcb->state);
+    TEST_ASSERT_EQUAL_INT(-ETIMEDOUT, gnrc_tcp_recv(tcb, buf, sizeof(buf), 0));
+    TEST_ASSERT_EQUAL_INT(-ETIMEDOUT, gnrc_tcp_send(tcb, "abcd", 4));
+}
+
+static void test_tcp_send__zero_window(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+
+    _establish(0);
+
+    TEST_ASSERT_EQUAL_INT(4, gnrc_tcp_send(tcb, "abcd", 4));
+    _expect_nothing();
+    /* probed with one byte, RFC 1122 4.2.2.17 */
+    gnrc_tcp_expire_timers();
+    _expect(TCP_CTL_ACK, _iss + 1, PEER_ISS + 1, 1);
+    TEST_ASSERT_EQUAL_INT(0, tcb->retries);
+    gnrc_tcp_expire_timers();
+    _expect(TCP_CTL_ACK, _iss + 1, PEER_ISS + 1, 1);
+    /* the window opens */
+    _receive(LOCAL_PORT, TCP_CTL_ACK, PEER_ISS + 1, _iss + 1, PEER_WND, NULL, 0);
+    _expect(TCP_CTL_ACK | TCP_CTL_PSH, _iss + 1, PEER_ISS + 1, 4);
+}
+
+static void test_tcp_send__small_window(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+
+    _establish(2);
+
+    TEST_ASSERT_EQUAL_INT(4, gnrc_tcp_send(tcb, "abcd", 4));
+    _expect(TCP_CTL_ACK, _iss + 1, PEER_ISS + 1, 2);
+    _expect_nothing();
+    _receive(LOCAL_PORT, TCP_CTL_ACK, PEER_ISS + 1, _iss + 3, 2, NULL, 0);
+    _expect(TCP_CTL_ACK | TCP_CTL_PSH, _iss + 3, PEER_ISS + 1, 2);
+    TEST_ASSERT_EQUAL_INT(2, tcb->snd_len);
+}
+
+static void test_tcp_close__passive(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    char buf[4];
+
+    _establish(PEER_WND);
+
+    _receive(LOCAL_PORT, TCP_CTL_FIN | TCP_CTL_ACK, PEER_ISS + 1, _iss + 1,
+             PEER_WND, NULL, 0);
+    _expect(TCP_CTL_ACK, _iss + 1, PEER_ISS + 2, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_CLOSE_WAIT, tcb->state);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tcp_recv(tcb, buf, sizeof(buf), 0));
+    gnrc_tcp_close_start(tcb);
+    _expect(TCP_CTL_FIN | TCP_CTL_ACK, _iss + 1, PEER_ISS + 2, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_LAST_ACK, tcb->state);
+    _receive(LOCAL_PORT, TCP_CTL_ACK, PEER_ISS + 2, _iss + 2, PEER_WND, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_CLOSED, tcb->state);
+    TEST_ASSERT_EQUAL_INT(0, tcb->error);
+    _expect_nothing();
+}
+
+static void test_tcp_close__active(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+
+    _establish(PEER_WND);
+
+    gnrc_tcp_close_start(tcb);
+    _expect(TCP_CTL_FIN | TCP_CTL_ACK, _iss + 1, PEER_ISS + 1, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_FIN_WAIT_1, tcb->state);
+    TEST_ASSERT_EQUAL_INT(-ENOTCONN, gnrc_tcp_send(tcb, "abcd", 4));
+    /* the FIN is retransmitted as well */
+    gnrc_tcp_expire_timers();
+    _expect(TCP_CTL_FIN | TCP_CTL_ACK, _iss + 1, PEER_ISS + 1, 0);
+    _receive(LOCAL_PORT, TCP_CTL_ACK, PEER_ISS + 1, _iss + 2, PEER_WND, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_FIN_WAIT_2, tcb->state);
+    _receive(LOCAL_PORT, TCP_CTL_FIN | TCP_CTL_ACK, PEER_ISS + 1, _iss + 2,
+             PEER_WND, NULL, 0);
+    _expect(TCP_CTL_ACK, _iss + 2, PEER_ISS + 2, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_CLOSED, tcb->state);
+    TEST_ASSERT_EQUAL_INT(0, tcb->error);
+    _expect_nothing();
+}
+
+static void test_tcp_close__active_with_data(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+
+    _establish(PEER_WND);
+
+    TEST_ASSERT_EQUAL_INT(4, gnrc_tcp_send(tcb, "abcd", 4));
+    _expect(TCP_CTL_ACK | TCP_CTL_PSH, _iss + 1, PEER_ISS + 1, 4);
+    gnrc_tcp_close_start(tcb);
+    /* the FIN follows the data right away */
+    _expect(TCP_CTL_FIN | TCP_CTL_ACK, _iss + 5, PEER_ISS + 1, 0);
+    _receive(LOCAL_PORT, TCP_CTL_ACK, PEER_ISS + 1, _iss + 5, PEER_WND, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_FIN_WAIT_1, tcb->state);
+    _receive(LOCAL_PORT, TCP_CTL_ACK, PEER_ISS + 1, _iss + 6, PEER_WND, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_FIN_WAIT_2, tcb->state);
+}
+
+static void test_tcp_close__simultaneous(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+
+    _establish(PEER_WND);
+
+    gnrc_tcp_close_start(tcb);
+    _expect(TCP_CTL_FIN | TCP_CTL_ACK, _iss + 1, PEER_ISS + 1, 0);
+    /* the FIN of the peer crossed ours */
+    _receive(LOCAL_PORT, TCP_CTL_FIN | TCP_CTL_ACK, PEER_ISS + 1, _iss + 1,
+             PEER_WND, NULL, 0);
+    _expect(TCP_CTL_ACK, _iss + 2, PEER_ISS + 2, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_CLOSING, tcb->state);
+    _receive(LOCAL_PORT, TCP_CTL_ACK, PEER_ISS + 2, _iss + 2, PEER_WND, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_CLOSED, tcb->state);
+    _expect_nothing();
+}
+
+static void test_tcp_close__fin_wait_2_timeout(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+
+    _establish(PEER_WND);
+
+    gnrc_tcp_close_start(tcb);
+    _expect(TCP_CTL_FIN | TCP_CTL_ACK, _iss + 1, PEER_ISS + 1, 0);
+    _receive(LOCAL_PORT, TCP_CTL_ACK, PEER_ISS + 1, _iss + 2, PEER_WND, NULL, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_FIN_WAIT_2, tcb->state);
+    /* the peer never closes its side */
+    gnrc_tcp_expire_timers();
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_CLOSED, tcb->state);
+    _expect_nothing();
+}
+
+static void test_tcp_close__syn_rcvd(void)
+{
+    sent_t sent;
+
+    _receive(LOCAL_PORT, TCP_CTL_SYN, PEER_ISS, 0, PEER_WND, NULL, 0);
+    _sent(&sent);
+    gnrc_tcp_close_start(&_tcbs[0]);
+    _expect(TCP_CTL_RST, sent.seq + 1, 0, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_STATE_CLOSED, _tcbs[0].state);
+}
+
+static void test_tcp_stop_listen(void)
+{
+    sent_t sent;
+
+    _receive(LOCAL_PORT, TCP_CTL_SYN, PEER_ISS, 0, PEER_WND, NULL, 0);
+    _sent(&sent);
+    gnrc_tcp_stop_listen(&_listener);
+    _expect(TCP_CTL_RST, sent.seq + 1, 0, 0);
+    TEST_ASSERT_EQUAL_INT(-ECONNABORTED, _tcbs[0].error);
+    /* nobody listens anymore */
+    _receive(LOCAL_PORT, TCP_CTL_SYN, PEER_ISS, 0, PEER_WND, NULL, 0);
+    _expect(TCP_CTL_RST | TCP_CTL_ACK, 0, PEER_ISS + 1, 0);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    /* tear_down stops it again */
+    gnrc_tcp_listen(&_listener, NULL, LOCAL_PORT, _tcbs, TEST_TCBS_NUMOF);
+}
+
+Test *tests_gnrc_tcp_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tcp_parse_mss),
+        new_TestFixture(test_tcp_parse_mss__no_options),
+        new_TestFixture(test_tcp_parse_mss__nop),
+        new_TestFixture(test_tcp_parse_mss__after_other),
+        new_TestFixture(test_tcp_parse_mss__eol),
+        new_TestFixture(test_tcp_parse_mss__length_missing),
+        new_TestFixture(test_tcp_parse_mss__truncated),
+        new_TestFixture(test_tcp_parse_mss__zero_length),
+        new_TestFixture(test_tcp_parse_mss__one_length),
+        new_TestFixture(test_tcp_parse_mss__wrong_length),
+        new_TestFixture(test_tcp_handshake),
+        new_TestFixture(test_tcp_handshake__syn_ack_rtx),
+        new_TestFixture(test_tcp_handshake__wrong_ack),
+        new_TestFixture(test_tcp_handshake__closed_port),
+        new_TestFixture(test_tcp_rst),
+        new_TestFixture(test_tcp_recv),
+        new_TestFixture(test_tcp_send__rtx),
+        new_TestFixture(test_tcp_send__max_retries),
+        new_TestFixture(test_tcp_send__zero_window),
+        new_TestFixture(test_tcp_send__small_window),
+        new_TestFixture(test_tcp_close__passive),
+        new_TestFixture(test_tcp_close__active),
+        new_TestFixture(test_tcp_close__active_with_data),
+        new_TestFixture(test_tcp_close__simultaneous),
+        new_TestFixture(test_tcp_close__fin_wait_2_timeout),
+        new_TestFixture(test_tcp_close__syn_rcvd),
+        new_TestFixture(test_tcp_stop_listen),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_tcp_tests;
+}
+
+void tests_gnrc_tcp(void)
+{
+    TESTS_RUN(tests_gnrc_tcp_tests());
+}
+/** @} */
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "hashes.h"
+
+#include "tests-hashes.h"
+
+/* must be usable in static initializers */
+static const uint32_t path_hash = HASHES_FNV1A_32_STR("/sensors/temp");
+
+static void test_hashes_fnv1a_32(void)
+{
+    TEST_ASSERT_EQUAL_INT(0x811c9dc5, fnv1a_32_hash(NULL, 0));
+    TEST_ASSERT_EQUAL_INT(0xe40c292c, fnv1a_32_hash((uint8_t *)"a", 1));
+    TEST_ASSERT_EQUAL_INT(0xbf9cf968, fnv1a_32_hash((uint8_t *)"foobar", 6));
+}
+
+static void test_hashes_fnv1a_64(void)
+{
+    TEST_ASSERT(fnv1a_64_hash((uint8_t *)"a", 1) == 0xaf63dc4c8601ec8cULL);
+    TEST_ASSERT(fnv1a_64_hash((uint8_t *)"foobar", 6) == 0x85944171f73967e8ULL);
+}
+
+static void test_hashes_fnv1a_32_str(void)
+{
+    static const char long_str[] =
+        "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef";
+
+    TEST_ASSERT_EQUAL_INT(0x811c9dc5, HASHES_FNV1A_32_STR(""));
+    TEST_ASSERT_EQUAL_INT(0xbf9cf968, HASHES_FNV1A_32_STR("foobar"));
+    TEST_ASSERT_EQUAL_INT(fnv1a_32_hash((uint8_t *)"/sensors/temp", 13),
+                          path_hash);
+    TEST_ASSERT_EQUAL_INT(fnv1a_32_hash((uint8_t *)long_str,
+                                        strlen(long_str)),
+                          HASHES_FNV1A_32_STR("0123456789abcdef0123456789abcdef"
+                                              "0123456789abcdef0123456789abcdef"));
+}
+
+static void test_hashes_murmur3_fmix(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, murmur3_fmix32(0));
+    TEST_ASSERT(murmur3_fmix32(1) != murmur3_fmix32(2));
+    TEST_ASSERT(murmur3_fmix64(0) == 0);
+    TEST_ASSERT(murmur3_fmix64(1) != murmur3_fmix64(2));
+}
+
+Test *tests_hashes_fnv_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_hashes_fnv1a_32),
+        new_TestFixture(test_hashes_fnv1a_64),
+        new_TestFixture(test_hashes_fnv1a_32_str),
+        new_TestFixture(test_hashes_murmur3_fmix),
+    };
+
+    EMB_UNIT_TESTCALLER(hashes_fnv_tests, NULL, NULL, fixtures);
+
+    return (Test *)&hashes_fnv_tests;
+}
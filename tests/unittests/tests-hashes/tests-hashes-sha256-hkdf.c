@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "hashes/sha256.h"
+
+#include "tests-hashes.h"
+
+/*
+        The followig testcases are taken from:
+        https://tools.ietf.org/html/rfc5869#appendix-A
+*/
+
+static const uint8_t ikm[22] = {
+    0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+    0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b
+};
+
+static void test_hashes_hkdf_sha256_case1(void)
+{
+    static const uint8_t salt[] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a,
+        0x0b, 0x0c
+    };
+    static const uint8_t info[] = {
+        0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9
+    };
+    static const uint8_t prk_expected[] = {
+        0x07, 0x77, 0x09, 0x36, 0x2c, 0x2e, 0x32, 0xdf, 0x0d, 0xdc, 0x3f,
+        0x0d, 0xc4, 0x7b, 0xba, 0x63, 0x90, 0xb6, 0xc7, 0x3b, 0xb5, 0x0f,
+        0x9c, 0x31, 0x22, 0xec, 0x84, 0x4a, 0xd7, 0xc2, 0xb3, 0xe5
+    };
+    static const uint8_t okm_expected[] = {
+        0x3c, 0xb2, 0x5f, 0x25, 0xfa, 0xac, 0xd5, 0x7a, 0x90, 0x43, 0x4f,
+        0x64, 0xd0, 0x36, 0x2f, 0x2a, 0x2d, 0x2d, 0x0a, 0x90, 0xcf, 0x1a,
+        0x5a, 0x4c, 0x5d, 0xb0, 0x2d, 0x56, 0xec, 0xc4, 0xc5, 0xbf, 0x34,
+        0x00, 0x72, 0x08, 0xd5, 0xb8, 0x87, 0x18, 0x58, 0x65
+    };
+    uint8_t prk[SHA256_DIGEST_LENGTH];
+    uint8_t okm[sizeof(okm_expected)];
+
+    hkdf_sha256_extract(salt, sizeof(salt), ikm, sizeof(ikm), prk);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(prk_expected, prk, sizeof(prk)));
+
+    TEST_ASSERT_EQUAL_INT(0, hkdf_sha256_expand(prk, sizeof(prk), info,
+                                                sizeof(info), okm,
+                                                sizeof(okm)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(okm_expected, okm, sizeof(okm)));
+
+    memset(okm, 0, sizeof(okm));
+    TEST_ASSERT_EQUAL_INT(0, hkdf_sha256(salt, sizeof(salt), ikm, sizeof(ikm),
+                                         info, sizeof(info), okm,
+                                         sizeof(okm)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(okm_expected, okm, sizeof(okm)));
+}
+
+static void test_hashes_hkdf_sha256_case3(void)
+{
+    /* no salt and no info */
+    static const uint8_t okm_expected[] = {
+        0x8d, 0xa4, 0xe7, 0x75, 0xa5, 0x63, 0xc1, 0x8f, 0x71, 0x5f, 0x80,
+        0x2a, 0x06, 0x3c, 0x5a, 0x31, 0xb8, 0xa1, 0x1f, 0x5c, 0x5e, 0xe1,
+        0x87, 0x9e, 0xc3, 0x45, 0x4e, 0x5f, 0x3c, 0x73, 0x8d, 0x2d, 0x9d,
+        0x20, 0x13, 0x95, 0xfa, 0xa4, 0xb6, 0x1a, 0x96, 0xc8
+    };
+    uint8_t okm[sizeof(okm_expected)];
+
+    TEST_ASSERT_EQUAL_INT(0, hkdf_sha256(NULL, 0, ikm, sizeof(ikm), NULL, 0,
+                                         okm, sizeof(okm)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(okm_expected, okm, sizeof(okm)));
+}
+
+static void test_hashes_hkdf_sha256_too_long(void)
+{
+    uint8_t prk[SHA256_DIGEST_LENGTH] = { 0 };
+    uint8_t okm[1];
+
+    TEST_ASSERT_EQUAL_INT(-1, hkdf_sha256_expand(prk, sizeof(prk), NULL, 0, okm,
+                                                 (255 * SHA256_DIGEST_LENGTH) + 1));
+}
+
+Test *tests_hashes_sha256_hkdf_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_hashes_hkdf_sha256_case1),
+        new_TestFixture(test_hashes_hkdf_sha256_case3),
+        new_TestFixture(test_hashes_hkdf_sha256_too_long),
+    };
+
+    EMB_UNIT_TESTCALLER(hashes_sha256_hkdf_tests, NULL, NULL,
+                        fixtures);
+
+    return (Test *)&hashes_sha256_hkdf_tests;
+}
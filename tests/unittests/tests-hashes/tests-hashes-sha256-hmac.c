@@ -153,6 +153,26 @@ static void test_hashes_hmac_sha256_hash_PRF6(void)
                  "9b09ffa71b942fcb27635fbcd5b0e944bfdc63644f0713938a7f51535c3a35e2", hmac));
 }
 
+static void test_hashes_hmac_sha256_precomputed_key(void)
+{
+    /* Test Case PRF-2, fed in pieces, twice with the same key */
+    const unsigned char strPRF2[] = "what do ya want for nothing?";
+    unsigned char key[4] = {'J', 'e', 'f', 'e'};
+    unsigned char hmac[SHA256_DIGEST_LENGTH];
+    hmac_sha256_key_t hkey;
+    hmac_sha256_context_t ctx;
+
+    hmac_sha256_key_init(&hkey, key, sizeof(key));
+    for (unsigned i = 0; i < 2; i++) {
+        hmac_sha256_init(&ctx, &hkey);
+        hmac_sha256_update(&ctx, strPRF2, 5);
+        hmac_sha256_update(&ctx, strPRF2 + 5, strlen((char*)strPRF2) - 5);
+        hmac_sha256_final(&ctx, hmac);
+        TEST_ASSERT(compare_str_vs_digest(
+                     "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843", hmac));
+    }
+}
+
 Test *tests_hashes_sha256_hmac_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -163,6 +183,7 @@ Test *tests_hashes_sha256_hmac_tests(void)
         new_TestFixture(test_hashes_hmac_sha256_hash_PRF4),
         new_TestFixture(test_hashes_hmac_sha256_hash_PRF5),
         new_TestFixture(test_hashes_hmac_sha256_hash_PRF6),
+        new_TestFixture(test_hashes_hmac_sha256_precomputed_key),
     };
 
     EMB_UNIT_TESTCALLER(hashes_sha256_tests, NULL, NULL,
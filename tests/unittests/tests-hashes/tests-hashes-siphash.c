@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include "embUnit/embUnit.h"
+
+#include "hashes/siphash.h"
+
+#include "tests-hashes.h"
+
+/* key and inputs of the reference implementation's test vectors */
+static uint8_t key[SIPHASH_KEY_LENGTH];
+static uint8_t input[64];
+
+static void set_up(void)
+{
+    for (unsigned i = 0; i < sizeof(input); i++) {
+        input[i] = i;
+    }
+    for (unsigned i = 0; i < sizeof(key); i++) {
+        key[i] = i;
+    }
+}
+
+static void test_hashes_siphash24(void)
+{
+    TEST_ASSERT(siphash24(key, input, 0) == 0x726fdb47dd0e0e31ULL);
+    TEST_ASSERT(siphash24(key, input, 8) == 0x93f5f5799a932462ULL);
+    TEST_ASSERT(siphash24(key, input, 15) == 0xa129ca6149be45e5ULL);
+    TEST_ASSERT(siphash24(key, input, 63) == 0x958a324ceb064572ULL);
+}
+
+Test *tests_hashes_siphash_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_hashes_siphash24),
+    };
+
+    EMB_UNIT_TESTCALLER(hashes_siphash_tests, set_up, NULL, fixtures);
+
+    return (Test *)&hashes_siphash_tests;
+}
@@ -58,6 +58,13 @@ Test *tests_hashes_sha256_tests(void);
  */
 Test *tests_hashes_sha256_hmac_tests(void);
 
+/**
+ * @brief   Generates tests for hashes/sha256.h - hkdf
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_hashes_sha256_hkdf_tests(void);
+
 /**
  * @brief   Generates tests for hashes/sha256.h - sha256-chain
  *
@@ -65,6 +72,20 @@ Test *tests_hashes_sha256_hmac_tests(void);
  */
 Test *tests_hashes_sha256_chain_tests(void);
 
+/**
+ * @brief   Generates tests for hashes.h - FNV-1a and Murmur3 finalizers
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_hashes_fnv_tests(void);
+
+/**
+ * @brief   Generates tests for hashes/siphash.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_hashes_siphash_tests(void);
+
 #ifdef __cplusplus
 }
 #endif
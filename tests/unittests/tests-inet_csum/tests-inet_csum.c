@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,69 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static void test_inet_csum__update(void)
+{
+    /* ICMPv6 echo request (type 0x80) that becomes a reply (type 0x81) */
+    uint8_t data[] = {
+        0x80, 0x00, 0x00, 0x00, 0x12, 0x34, 0x00, 0x01, 0xab, 0xcd, 0xef
+    };
+    uint16_t csum = ~inet_csum(0, data, sizeof(data));
+    uint16_t updated = inet_csum_update(csum, 0x8000, 0x8100);
+
+    data[0] = 0x81;
+    TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, data, sizeof(data)), updated);
+    /* changing the word back restores the checksum */
+    TEST_ASSERT_EQUAL_INT(csum, inet_csum_update(updated, 0x8100, 0x8000));
+    /* a word that does not change keeps the checksum */
+    TEST_ASSERT_EQUAL_INT(csum, inet_csum_update(csum, 0x1234, 0x1234));
+}
+
+/* an IPv6 MTU worth of payload plus room for the offsets */
+static uint8_t test_buf[1280U + 8];
+
+/* byte-wise reference of inet_csum_slice() */
+static uint16_t _ref_csum(uint16_t sum, const uint8_t *buf, uint16_t len,
+                          size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    for (uint16_t i = 0; i < len; i++) {
+        csum += ((accum_len + i) & 1) ? buf[i] : (buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void test_inet_csum__alignments(void)
+{
+    for (unsigned i = 0; i < sizeof(test_buf); i++) {
+        test_buf[i] = (uint8_t)((i * 73) + 0xa5);
+    }
+    /* all offsets and lengths cover every prologue and tail of the
+     * word-at-a-time paths */
+    for (unsigned off = 0; off < 8; off++) {
+        for (uint16_t len = 0; len <= TEST_UINT8; len++) {
+            for (size_t accum = 0; accum < 2; accum++) {
+                TEST_ASSERT_EQUAL_INT(_ref_csum(0xfedc, &test_buf[off], len, accum),
+                                      inet_csum_slice(0xfedc, &test_buf[off],
+                                                      len, accum));
+            }
+        }
+    }
+}
+
+static void test_inet_csum__all_ones(void)
+{
+    /* maximizes the carries collected before folding */
+    memset(test_buf, 0xff, sizeof(test_buf));
+    TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0xffff, test_buf, sizeof(test_buf)));
+    TEST_ASSERT_EQUAL_INT(_ref_csum(0x1234, &test_buf[1], sizeof(test_buf) - 1, 1),
+                          inet_csum_slice(0x1234, &test_buf[1],
+                                          sizeof(test_buf) - 1, 1));
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +240,9 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__update),
+        new_TestFixture(test_inet_csum__alignments),
+        new_TestFixture(test_inet_csum__all_ones),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
@@ -440,6 +440,49 @@ static void test_ipv6_nc_get_l2_addr__reachable(void)
     TEST_ASSERT_EQUAL_INT(sizeof(TEST_STRING4), l2_addr_len);
 }
 
+static void test_ipv6_nc_get__many(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+
+    for (unsigned num = 1; num <= GNRC_IPV6_NC_SIZE; num <<= 1) {
+        gnrc_ipv6_nc_t *entry;
+        unsigned count = 0;
+
+        gnrc_ipv6_nc_init();
+        for (unsigned i = 0; i < num; i++) {
+            addr.u16[7].u16 = i;
+            TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_add(DEFAULT_TEST_NETIF, &addr,
+                                                  TEST_STRING4,
+                                                  sizeof(TEST_STRING4), 0));
+        }
+        for (unsigned i = 0; i < num; i++) {
+            addr.u16[7].u16 = i;
+            TEST_ASSERT_NOT_NULL((entry = gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF,
+                                                           &addr)));
+            TEST_ASSERT(ipv6_addr_equal(&addr, &entry->ipv6_addr));
+        }
+        addr.u16[7].u16 = num;
+        TEST_ASSERT_NULL(gnrc_ipv6_nc_get(DEFAULT_TEST_NETIF, &addr));
+        TEST_ASSERT_NULL(gnrc_ipv6_nc_get(OTHER_TEST_NETIF, &addr));
+
+        /* remove every other entry */
+        for (unsigned i = 0; i < num; i += 2) {
+            addr.u16[7].u16 = i;
+            gnrc_ipv6_nc_remove(DEFAULT_TEST_NETIF, &addr);
+            TEST_ASSERT_NULL(gnrc_ipv6_nc_get(KERNEL_PID_UNDEF, &addr));
+        }
+        for (unsigned i = 1; i < num; i += 2) {
+            addr.u16[7].u16 = i;
+            TEST_ASSERT_NOT_NULL(gnrc_ipv6_nc_get(KERNEL_PID_UNDEF, &addr));
+        }
+        entry = NULL;
+        while ((entry = gnrc_ipv6_nc_get_next(entry)) != NULL) {
+            count++;
+        }
+        TEST_ASSERT_EQUAL_INT(num / 2, count);
+    }
+}
+
 Test *tests_ipv6_nc_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -460,6 +503,7 @@ Test *tests_ipv6_nc_tests(void)
         new_TestFixture(test_ipv6_nc_get__different_addr),
         new_TestFixture(test_ipv6_nc_get__success_if_local),
         new_TestFixture(test_ipv6_nc_get__success_if_global),
+        new_TestFixture(test_ipv6_nc_get__many),
         new_TestFixture(test_ipv6_nc_get_next__empty),
         new_TestFixture(test_ipv6_nc_get_next__1_entry),
         new_TestFixture(test_ipv6_nc_get_next__2_entries),
@@ -322,6 +322,38 @@ static void test_ipv6_netif_find_addr__success(void)
     TEST_ASSERT_EQUAL_INT(true, ipv6_addr_equal(out, &addr));
 }
 
+static void test_ipv6_netif_join_group__no_multicast(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_IPV6_ADDR;
+
+    test_ipv6_netif_add__success(); /* adds DEFAULT_TEST_NETIF as interface */
+    TEST_ASSERT_NULL(gnrc_ipv6_netif_join_group(DEFAULT_TEST_NETIF, &addr));
+}
+
+static void test_ipv6_netif_join_group__success(void)
+{
+    ipv6_addr_t group = IPV6_ADDR_ALL_ROUTERS_SITE_LOCAL;
+    ipv6_addr_t other = IPV6_ADDR_ALL_ROUTERS_LINK_LOCAL;
+
+    test_ipv6_netif_add__success(); /* adds DEFAULT_TEST_NETIF as interface */
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_join_group(DEFAULT_TEST_NETIF, &group));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_join_group(DEFAULT_TEST_NETIF, &other));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_join_group(DEFAULT_TEST_NETIF, &group));
+
+    /* stays joined until left as often as joined */
+    gnrc_ipv6_netif_leave_group(DEFAULT_TEST_NETIF, &group);
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_find_addr(DEFAULT_TEST_NETIF, &group));
+    gnrc_ipv6_netif_leave_group(DEFAULT_TEST_NETIF, &group);
+    TEST_ASSERT_NULL(gnrc_ipv6_netif_find_addr(DEFAULT_TEST_NETIF, &group));
+
+    /* other groups are still found after the index was rebuilt */
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_find_addr(DEFAULT_TEST_NETIF, &other));
+    TEST_ASSERT_NOT_NULL(gnrc_ipv6_netif_find_addr(DEFAULT_TEST_NETIF,
+                                                   &ipv6_addr_all_nodes_link_local));
+    TEST_ASSERT_EQUAL_INT(DEFAULT_TEST_NETIF,
+                          gnrc_ipv6_netif_find_by_addr(NULL, &other));
+}
+
 static void test_ipv6_netif_find_by_prefix__success1(void)
 {
     ipv6_addr_t addr = DEFAULT_TEST_IPV6_PREFIX23;
@@ -555,6 +587,8 @@ Test *tests_ipv6_netif_tests(void)
         new_TestFixture(test_ipv6_netif_find_addr__wrong_iface),
         new_TestFixture(test_ipv6_netif_find_addr__wrong_addr),
         new_TestFixture(test_ipv6_netif_find_addr__success),
+        new_TestFixture(test_ipv6_netif_join_group__no_multicast),
+        new_TestFixture(test_ipv6_netif_join_group__success),
         new_TestFixture(test_ipv6_netif_find_by_prefix__success1),
         new_TestFixture(test_ipv6_netif_find_by_prefix__success2),
         new_TestFixture(test_ipv6_netif_find_by_prefix__success3),
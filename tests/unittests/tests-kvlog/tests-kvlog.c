@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "kvlog.h"
+
+#define SECTOR_SIZE (128U)
+#define SECTORS     (4U)
+
+static uint8_t _mem[SECTOR_SIZE * SECTORS];
+static kvlog_t _kv;
+
+static int _read(nvram_t *dev, uint8_t *dst, uint32_t src, size_t len)
+{
+    (void)dev;
+    memcpy(dst, &_mem[src], len);
+    return len;
+}
+
+static int _write(nvram_t *dev, const uint8_t *src, uint32_t dst, size_t len)
+{
+    (void)dev;
+    memcpy(&_mem[dst], src, len);
+    return len;
+}
+
+static nvram_t _dev = {
+    .read = _read,
+    .write = _write,
+    .size = sizeof(_mem),
+};
+
+static uint32_t _erase_count(unsigned sector)
+{
+    uint32_t count;
+
+    memcpy(&count, &_mem[sector * SECTOR_SIZE], sizeof(count));
+    return count;
+}
+
+static void set_up(void)
+{
+    memset(_mem, 0xff, sizeof(_mem));
+    TEST_ASSERT_EQUAL_INT(0, kvlog_init(&_kv, &_dev, 0, SECTOR_SIZE, SECTORS));
+}
+
+static void test_kvlog_get_empty(void)
+{
+    uint8_t buf[4];
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvlog_get(&_kv, 1, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvlog_delete(&_kv, 1));
+    for (unsigned i = 0; i < SECTORS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _erase_count(i));
+    }
+}
+
+static void test_kvlog_set_get(void)
+{
+    char buf[8];
+
+    TEST_ASSERT_EQUAL_INT(0, kvlog_set(&_kv, 1, "hello", 5));
+    TEST_ASSERT_EQUAL_INT(0, kvlog_set(&_kv, 2, "abc", 3));
+    TEST_ASSERT_EQUAL_INT(0, kvlog_set(&_kv, 1, "world!", 6));
+    TEST_ASSERT_EQUAL_INT(6, kvlog_get(&_kv, 1, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, "world!", 6));
+    TEST_ASSERT_EQUAL_INT(3, kvlog_get(&_kv, 2, buf, 2));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, "ab", 2));
+    TEST_ASSERT_EQUAL_INT(-E2BIG, kvlog_set(&_kv, 3, buf, SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(-E2BIG, kvlog_set(&_kv, KVLOG_KEY_INVALID, buf, 1));
+}
+
+static void test_kvlog_delete(void)
+{
+    char buf[8];
+
+    TEST_ASSERT_EQUAL_INT(0, kvlog_set(&_kv, 1, "hello", 5));
+    TEST_ASSERT_EQUAL_INT(0, kvlog_delete(&_kv, 1));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvlog_get(&_kv, 1, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, kvlog_delete(&_kv, 1));
+}
+
+static void test_kvlog_remount(void)
+{
+    char buf[8];
+
+    for (unsigned i = 0; i < 50; i++) {
+        TEST_ASSERT_EQUAL_INT(0, kvlog_set(&_kv, i % 5, &i, sizeof(i)));
+    }
+    TEST_ASSERT_EQUAL_INT(0, kvlog_delete(&_kv, 2));
+
+    TEST_ASSERT_EQUAL_INT(0, kvlog_init(&_kv, &_dev, 0, SECTOR_SIZE, SECTORS));
+    for (unsigned i = 45; i < 50; i++) {
+        unsigned val;
+
+        if (i % 5 == 2) {
+            TEST_ASSERT_EQUAL_INT(-ENOENT,
+                                  kvlog_get(&_kv, i % 5, buf, sizeof(buf)));
+            continue;
+        }
+        TEST_ASSERT_EQUAL_INT(sizeof(val),
+                              kvlog_get(&_kv, i % 5, &val, sizeof(val)));
+        TEST_ASSERT_EQUAL_INT(i, val);
+    }
+    TEST_ASSERT_EQUAL_INT(0, kvlog_set(&_kv, 7, "x", 1));
+    TEST_ASSERT_EQUAL_INT(1, kvlog_get(&_kv, 7, buf, sizeof(buf)));
+}
+
+static void test_kvlog_wear(void)
+{
+    uint32_t min = UINT32_MAX, max = 0;
+
+    for (unsigned i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL_INT(0, kvlog_set(&_kv, i % 3, &i, sizeof(i)));
+    }
+    for (unsigned i = 0; i < SECTORS; i++) {
+        uint32_t count = _erase_count(i);
+
+        min = (count < min) ? count : min;
+        max = (count > max) ? count : max;
+    }
+    TEST_ASSERT(_kv.erases > 0);
+    TEST_ASSERT(max - min <= 1);
+}
+
+static void test_kvlog_full(void)
+{
+    uint8_t val[48];
+    unsigned i;
+    int res = 0;
+
+    memset(val, 0x5a, sizeof(val));
+    for (i = 0; i < 10; i++) {
+        if ((res = kvlog_set(&_kv, i, val, sizeof(val))) < 0) {
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOSPC, res);
+    TEST_ASSERT(i > 0);
+    /* what was stored survives */
+    for (unsigned j = 0; j < i; j++) {
+        TEST_ASSERT_EQUAL_INT(sizeof(val),
+                              kvlog_get(&_kv, j, val, sizeof(val)));
+    }
+    /* deleting makes room again */
+    TEST_ASSERT_EQUAL_INT(0, kvlog_delete(&_kv, 0));
+    TEST_ASSERT_EQUAL_INT(0, kvlog_set(&_kv, i, val, sizeof(val)));
+}
+
+static void test_kvlog_torn(void)
+{
+    uint32_t addr;
+    char buf[8];
+
+    TEST_ASSERT_EQUAL_INT(0, kvlog_set(&_kv, 1, "old", 3));
+    TEST_ASSERT_EQUAL_INT(0, kvlog_set(&_kv, 1, "new", 3));
+    /* break the value of the last record */
+    addr = _kv.index[0].addr;
+    _mem[addr + 8] ^= 0x01;
+
+    TEST_ASSERT_EQUAL_INT(0, kvlog_init(&_kv, &_dev, 0, SECTOR_SIZE, SECTORS));
+    TEST_ASSERT_EQUAL_INT(3, kvlog_get(&_kv, 1, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, "old", 3));
+    /* the broken sector is not written to anymore */
+    TEST_ASSERT_EQUAL_INT(0, kvlog_set(&_kv, 1, "new", 3));
+    TEST_ASSERT(_kv.index[0].addr >= SECTOR_SIZE);
+}
+
+static void test_kvlog_compact(void)
+{
+    unsigned erases;
+
+    TEST_ASSERT_EQUAL_INT(0, kvlog_compact(&_kv));
+    for (unsigned i = 0; i < 40; i++) {
+        TEST_ASSERT_EQUAL_INT(0, kvlog_set(&_kv, 1, &i, sizeof(i)));
+    }
+    TEST_ASSERT(_kv.free < KVLOG_FREE_SECTORS);
+    erases = _kv.erases;
+    TEST_ASSERT_EQUAL_INT(1, kvlog_compact(&_kv));
+    TEST_ASSERT_EQUAL_INT(erases + 1, _kv.erases);
+    TEST_ASSERT_EQUAL_INT(KVLOG_FREE_SECTORS, _kv.free);
+    TEST_ASSERT_EQUAL_INT(0, kvlog_compact(&_kv));
+}
+
+Test *tests_kvlog_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_kvlog_get_empty),
+        new_TestFixture(test_kvlog_set_get),
+        new_TestFixture(test_kvlog_delete),
+        new_TestFixture(test_kvlog_remount),
+        new_TestFixture(test_kvlog_wear),
+        new_TestFixture(test_kvlog_full),
+        new_TestFixture(test_kvlog_torn),
+        new_TestFixture(test_kvlog_compact),
+    };
+
+    EMB_UNIT_TESTCALLER(kvlog_tests, set_up, NULL, fixtures);
+
+    return (Test *)&kvlog_tests;
+}
+
+void tests_kvlog(void)
+{
+    TESTS_RUN(tests_kvlog_tests());
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "memarray.h"
+
+#include "tests-memarray.h"
+
+#define ELEM_NUMOF  (4U)
+
+typedef struct {
+    void *next;
+    uint32_t a;
+    uint8_t b;
+} elem_t;
+
+static elem_t _buf[ELEM_NUMOF];
+static memarray_t _mem;
+
+static void set_up(void)
+{
+    memset(_buf, 0, sizeof(_buf));
+    memarray_init(&_mem, _buf, sizeof(elem_t), ELEM_NUMOF, 0);
+}
+
+static void test_memarray_init(void)
+{
+    memarray_t mem = MEMARRAY_INIT(_buf, MEMARRAY_FLAG_IRQ_SAFE);
+
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, mem.num);
+    TEST_ASSERT_EQUAL_INT(sizeof(elem_t), mem.size);
+    TEST_ASSERT_EQUAL_INT(0, memarray_used(&mem));
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, memarray_available(&mem));
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, memarray_available(&_mem));
+}
+
+static void test_memarray_alloc_all(void)
+{
+    for (unsigned i = 0; i < ELEM_NUMOF; i++) {
+        elem_t *elem = memarray_alloc(&_mem);
+
+        TEST_ASSERT(elem == &_buf[i]);
+        elem->a = i;
+    }
+    TEST_ASSERT_NULL(memarray_alloc(&_mem));
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, memarray_used(&_mem));
+    TEST_ASSERT_EQUAL_INT(0, memarray_available(&_mem));
+    for (unsigned i = 0; i < ELEM_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(i, _buf[i].a);
+    }
+}
+
+static void test_memarray_free_reuse(void)
+{
+    elem_t *elems[ELEM_NUMOF];
+
+    for (unsigned i = 0; i < ELEM_NUMOF; i++) {
+        elems[i] = memarray_alloc(&_mem);
+    }
+    memarray_free(&_mem, elems[1]);
+    memarray_free(&_mem, elems[3]);
+    TEST_ASSERT_EQUAL_INT(2, memarray_used(&_mem));
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, memarray_max_used(&_mem));
+
+    /* last released, first reused */
+    TEST_ASSERT(memarray_alloc(&_mem) == elems[3]);
+    TEST_ASSERT(memarray_alloc(&_mem) == elems[1]);
+    TEST_ASSERT_NULL(memarray_alloc(&_mem));
+}
+
+static void test_memarray_max_used(void)
+{
+    elem_t *a = memarray_alloc(&_mem);
+    elem_t *b = memarray_alloc(&_mem);
+
+    memarray_free(&_mem, a);
+    memarray_free(&_mem, b);
+    a = memarray_alloc(&_mem);
+    TEST_ASSERT_EQUAL_INT(1, memarray_used(&_mem));
+    TEST_ASSERT_EQUAL_INT(2, memarray_max_used(&_mem));
+    /* never used elements are still handed out after the released ones */
+    for (unsigned i = 1; i < ELEM_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL(memarray_alloc(&_mem));
+    }
+    TEST_ASSERT_NULL(memarray_alloc(&_mem));
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, memarray_max_used(&_mem));
+}
+
+Test *tests_memarray_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_memarray_init),
+        new_TestFixture(test_memarray_alloc_all),
+        new_TestFixture(test_memarray_free_reuse),
+        new_TestFixture(test_memarray_max_used),
+    };
+
+    EMB_UNIT_TESTCALLER(memarray_tests, set_up, NULL, fixtures);
+
+    return (Test *)&memarray_tests;
+}
+
+void tests_memarray(void)
+{
+    TESTS_RUN(tests_memarray_tests());
+}
@@ -21,11 +21,16 @@
 #include "unittests-constants.h"
 #include "tests-netreg.h"
 
+/* maximum number of registrations in test_netreg_lookup__many() */
+#define MANY_ENTRIES_NUMOF  (64U)
+
 static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8),
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
 };
 
+static gnrc_netreg_entry_t many_entries[MANY_ENTRIES_NUMOF];
+
 static void set_up(void)
 {
     gnrc_netreg_init();
@@ -139,6 +144,40 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_lookup__many(void)
+{
+    for (unsigned num = 1; num <= MANY_ENTRIES_NUMOF; num <<= 1) {
+        gnrc_netreg_entry_t *res;
+
+        gnrc_netreg_init();
+        for (unsigned i = 0; i < num; i++) {
+            gnrc_netreg_entry_init_pid(&many_entries[i], TEST_UINT16 + i,
+                                       TEST_UINT8);
+            TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST,
+                                                          &many_entries[i]));
+        }
+        for (unsigned i = 0; i < num; i++) {
+            uint32_t demux_ctx = TEST_UINT16 + i;
+
+            res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, demux_ctx);
+            TEST_ASSERT_NOT_NULL(res);
+            TEST_ASSERT_EQUAL_INT(demux_ctx, res->demux_ctx);
+        }
+        TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                            TEST_UINT16 + num));
+        for (unsigned i = 0; i < num; i++) {
+            TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_TEST,
+                                                     TEST_UINT16 + i));
+            TEST_ASSERT_NULL(gnrc_netreg_getnext(&many_entries[i]));
+        }
+        for (unsigned i = 0; i < num; i++) {
+            gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &many_entries[i]);
+            TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST,
+                                                TEST_UINT16 + i));
+        }
+    }
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +194,7 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_lookup__many),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
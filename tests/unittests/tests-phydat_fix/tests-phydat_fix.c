@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+
+#include "embUnit.h"
+
+#include "phydat_fix.h"
+
+#include "tests-phydat_fix.h"
+
+static void test_phydat_fix_get(void)
+{
+    phydat_t data = { { 2315, -32768, 7 }, UNIT_TEMP_C, -2 };
+
+    TEST_ASSERT_EQUAL_INT(F16(23.15), phydat_fix_get(&data, 0, 0));
+    TEST_ASSERT_EQUAL_INT(F16(-327.68), phydat_fix_get(&data, 1, 0));
+    TEST_ASSERT_EQUAL_INT(fix16_from_int(7), phydat_fix_get(&data, 2, -2));
+    TEST_ASSERT_EQUAL_INT(fix16_from_int(700), phydat_fix_get(&data, 2, -4));
+    /* saturates and drops values below the resolution */
+    TEST_ASSERT_EQUAL_INT(fix16_minimum, phydat_fix_get(&data, 1, -4));
+    TEST_ASSERT_EQUAL_INT(0, phydat_fix_get(&data, 2, 10));
+}
+
+static void test_phydat_fix_set(void)
+{
+    const fix16_t values[] = { F16(1.5), F16(-20.25) };
+    phydat_t data = { { 1, 2, 3 }, UNIT_V, 0 };
+
+    phydat_fix_set(&data, values, 2, 0);
+    TEST_ASSERT_EQUAL_INT(1500, data.val[0]);
+    TEST_ASSERT_EQUAL_INT(-20250, data.val[1]);
+    TEST_ASSERT_EQUAL_INT(0, data.val[2]);
+    TEST_ASSERT_EQUAL_INT(-3, data.scale);
+    TEST_ASSERT_EQUAL_INT(UNIT_V, data.unit);
+
+    phydat_fix_set(&data, values, 2, 3);
+    TEST_ASSERT_EQUAL_INT(0, data.scale);
+}
+
+static void test_phydat_fix_scale(void)
+{
+    phydat_t data = { { 30000, -100, 0 }, UNIT_NONE, 2 };
+
+    phydat_fix_scale(&data, 2, F16(0.5), fix16_from_int(100));
+    TEST_ASSERT_EQUAL_INT(15100, data.val[0]);
+    TEST_ASSERT_EQUAL_INT(50, data.val[1]);
+    TEST_ASSERT_EQUAL_INT(2, data.scale);
+}
+
+static void test_phydat_fix_convert_temp(void)
+{
+    phydat_t data = { { 2315, -1000, 0 }, UNIT_TEMP_C, -2 };
+
+    TEST_ASSERT_EQUAL_INT(0, phydat_fix_convert(&data, 2, UNIT_TEMP_F));
+    TEST_ASSERT_EQUAL_INT(UNIT_TEMP_F, data.unit);
+    TEST_ASSERT_EQUAL_INT(7367, data.val[0]);
+    TEST_ASSERT_EQUAL_INT(1400, data.val[1]);
+    TEST_ASSERT_EQUAL_INT(-2, data.scale);
+
+    TEST_ASSERT_EQUAL_INT(0, phydat_fix_convert(&data, 2, UNIT_TEMP_K));
+    TEST_ASSERT_EQUAL_INT(29630, data.val[0]);
+    TEST_ASSERT_EQUAL_INT(26315, data.val[1]);
+    TEST_ASSERT_EQUAL_INT(-2, data.scale);
+}
+
+static void test_phydat_fix_convert_scale(void)
+{
+    phydat_t data = { { 1013, 0, 0 }, UNIT_BAR, -3 };
+
+    TEST_ASSERT_EQUAL_INT(0, phydat_fix_convert(&data, 1, UNIT_PA));
+    TEST_ASSERT_EQUAL_INT(1013, data.val[0]);
+    TEST_ASSERT_EQUAL_INT(2, data.scale);
+
+    data.unit = UNIT_PERCENT;
+    data.scale = 0;
+    TEST_ASSERT_EQUAL_INT(0, phydat_fix_convert(&data, 1, UNIT_PPM));
+    TEST_ASSERT_EQUAL_INT(4, data.scale);
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, phydat_fix_convert(&data, 1, UNIT_PA));
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, phydat_fix_convert(&data, 1, UNIT_TEMP_C));
+}
+
+static void test_phydat_fix_stats(void)
+{
+    phydat_fix_stats_t stats;
+    phydat_t data;
+
+    phydat_fix_stats_init(&stats, UNIT_G, 3, -3);
+    for (int i = 0; i < 10; i++) {
+        phydat_t sample = { { 1000 + i, -i, 3 * i }, UNIT_G, -3 };
+
+        TEST_ASSERT_EQUAL_INT(0, phydat_fix_stats_add(&stats, &sample));
+    }
+    data.unit = UNIT_DPS;
+    TEST_ASSERT_EQUAL_INT(-EINVAL, phydat_fix_stats_add(&stats, &data));
+
+    phydat_fix_stats_avg(&stats, &data);
+    TEST_ASSERT_EQUAL_INT(UNIT_G, data.unit);
+    TEST_ASSERT_EQUAL_INT(-4, data.scale);
+    TEST_ASSERT_EQUAL_INT(10045, data.val[0]);
+    TEST_ASSERT_EQUAL_INT(-45, data.val[1]);
+    TEST_ASSERT_EQUAL_INT(135, data.val[2]);
+
+    phydat_fix_stats_min(&stats, &data);
+    TEST_ASSERT_EQUAL_INT(10000, data.val[0]);
+    TEST_ASSERT_EQUAL_INT(-90, data.val[1]);
+    TEST_ASSERT_EQUAL_INT(0, data.val[2]);
+
+    phydat_fix_stats_max(&stats, &data);
+    TEST_ASSERT_EQUAL_INT(10090, data.val[0]);
+    TEST_ASSERT_EQUAL_INT(0, data.val[1]);
+    TEST_ASSERT_EQUAL_INT(270, data.val[2]);
+}
+
+Test *tests_phydat_fix_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_phydat_fix_get),
+        new_TestFixture(test_phydat_fix_set),
+        new_TestFixture(test_phydat_fix_scale),
+        new_TestFixture(test_phydat_fix_convert_temp),
+        new_TestFixture(test_phydat_fix_convert_scale),
+        new_TestFixture(test_phydat_fix_stats),
+    };
+
+    EMB_UNIT_TESTCALLER(phydat_fix_tests, NULL, NULL, fixtures);
+
+    return (Test *)&phydat_fix_tests;
+}
+
+void tests_phydat_fix(void)
+{
+    TESTS_RUN(tests_phydat_fix_tests());
+}
+/** @} */
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``phydat_fix`` module
+ */
+#ifndef TESTS_PHYDAT_FIX_H
+#define TESTS_PHYDAT_FIX_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_phydat_fix(void);
+
+/**
+ * @brief   Generates tests for phydat_fix
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_phydat_fix_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_PHYDAT_FIX_H */
+/** @} */
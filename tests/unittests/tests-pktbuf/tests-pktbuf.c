@@ -14,6 +14,7 @@
  */
 #include <errno.h>
 #include <stdint.h>
+#include <string.h>
 #include <sys/uio.h>
 
 #include "embUnit.h"
@@ -200,6 +201,8 @@ static void test_pktbuf_add__memfull(void)
     TEST_ASSERT(!gnrc_pktbuf_is_empty());
 }
 
+/* depends on the capacity and layout of the static arena */
+#ifdef MODULE_GNRC_PKTBUF_STATIC
 static void test_pktbuf_add__success(void)
 {
     gnrc_pktsnip_t *pkt, *pkt_prev = NULL;
@@ -223,6 +226,7 @@ static void test_pktbuf_add__success(void)
     }
     TEST_ASSERT(gnrc_pktbuf_is_sane());
 }
+#endif
 
 static void test_pktbuf_add__packed_struct(void)
 {
@@ -243,6 +247,8 @@ static void test_pktbuf_add__packed_struct(void)
     TEST_ASSERT_EQUAL_INT(data.s64, data_cpy->s64);
 }
 
+/* depends on the capacity and layout of the static arena */
+#ifdef MODULE_GNRC_PKTBUF_STATIC
 static void test_pktbuf_add__unaligned_in_aligned_hole(void)
 {
     gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
@@ -261,6 +267,7 @@ static void test_pktbuf_add__unaligned_in_aligned_hole(void)
     gnrc_pktbuf_release(pkt4);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
+#endif
 
 static void test_pktbuf_add__0_sized_release(void)
 {
@@ -317,7 +324,8 @@ static void test_pktbuf_mark__pkt_NOT_NULL__size_greater_than_pkt_size(void)
 
 static void test_pktbuf_mark__pkt_NOT_NULL__pkt_data_NULL(void)
 {
-    gnrc_pktsnip_t pkt = { 1, NULL, NULL, sizeof(TEST_STRING16), GNRC_NETTYPE_TEST };
+    gnrc_pktsnip_t pkt = { .users = 1, .size = sizeof(TEST_STRING16),
+                           .type = GNRC_NETTYPE_TEST };
 
     TEST_ASSERT_NULL(gnrc_pktbuf_mark(&pkt, sizeof(TEST_STRING16) - 1,
                                       GNRC_NETTYPE_TEST));
@@ -655,7 +663,9 @@ static void test_pktbuf_hold__pkt_null(void)
 
 static void test_pktbuf_hold__pkt_external(void)
 {
-    gnrc_pktsnip_t pkt = { 1, NULL, TEST_STRING8, sizeof(TEST_STRING8), GNRC_NETTYPE_TEST };
+    gnrc_pktsnip_t pkt = { .users = 1, .data = TEST_STRING8,
+                           .size = sizeof(TEST_STRING8),
+                           .type = GNRC_NETTYPE_TEST };
 
     gnrc_pktbuf_hold(&pkt, 1);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
@@ -722,6 +732,129 @@ static void test_pktbuf_release__success(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+static void test_pktbuf_bursty(void)
+{
+    /* mimics bursty 6LoWPAN traffic: frames arrive, headers get marked and
+     * the packets are released out of order */
+    gnrc_pktsnip_t *pkts[4] = { NULL };
+
+    for (unsigned i = 0; i < 64; i++) {
+        unsigned slot = (i * 3) % 4;
+        gnrc_pktsnip_t *hdr;
+
+        if (pkts[slot] != NULL) {
+            gnrc_pktbuf_release(pkts[slot]);
+        }
+        pkts[slot] = gnrc_pktbuf_add(NULL, NULL, 102 + (i % 26),
+                                     GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(pkts[slot]);
+        hdr = gnrc_pktbuf_mark(pkts[slot], 2 + (i % 3), GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(hdr);
+        hdr = gnrc_pktbuf_mark(pkts[slot], 40, GNRC_NETTYPE_TEST);
+        TEST_ASSERT_NOT_NULL(hdr);
+        TEST_ASSERT(gnrc_pktbuf_is_sane());
+    }
+    for (unsigned i = 0; i < 4; i++) {
+        gnrc_pktbuf_release(pkts[i]);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+static unsigned loan_released;
+static void *loan_data;
+
+static void _loan_release(gnrc_pkt_loan_t *loan, void *data)
+{
+    (void)loan;
+    loan_released++;
+    loan_data = data;
+}
+
+static gnrc_pkt_loan_t loan = { .release = _loan_release };
+
+static void test_pktbuf_add_loaned__release(void)
+{
+    uint8_t buf[64];
+    gnrc_pktsnip_t *pkt;
+
+    loan_released = 0;
+    pkt = gnrc_pktbuf_add_loaned(NULL, buf, sizeof(buf), GNRC_NETTYPE_TEST,
+                                 &loan);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(pkt->data == buf);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), pkt->size);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_hold(pkt, 1);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(0, loan_released);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(1, loan_released);
+    TEST_ASSERT(loan_data == buf);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_add_loaned__mark(void)
+{
+    uint8_t buf[64];
+    gnrc_pktsnip_t *pkt, *hdr;
+
+    memset(buf, TEST_UINT8, sizeof(buf));
+    loan_released = 0;
+    pkt = gnrc_pktbuf_add_loaned(NULL, buf, sizeof(buf), GNRC_NETTYPE_TEST,
+                                 &loan);
+    TEST_ASSERT_NOT_NULL(pkt);
+    hdr = gnrc_pktbuf_mark(pkt, 10, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr);
+    /* header is copied, payload stays in place */
+    TEST_ASSERT(((uint8_t *)hdr->data < buf) ||
+                ((uint8_t *)hdr->data >= (buf + sizeof(buf))));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(hdr->data, buf, 10));
+    TEST_ASSERT(pkt->data == (buf + 10));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf) - 10, pkt->size);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_remove_snip(pkt, hdr);
+    TEST_ASSERT_EQUAL_INT(0, loan_released);
+    /* payload moves to marked snip as a whole */
+    hdr = gnrc_pktbuf_mark(pkt, pkt->size, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(hdr);
+    TEST_ASSERT(hdr->data == (buf + 10));
+    TEST_ASSERT_NULL(pkt->data);
+    gnrc_pktbuf_remove_snip(pkt, pkt);
+    TEST_ASSERT_EQUAL_INT(0, loan_released);
+    gnrc_pktbuf_release(hdr);
+    TEST_ASSERT_EQUAL_INT(1, loan_released);
+    TEST_ASSERT(loan_data == (buf + 10));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_add_loaned__realloc_data(void)
+{
+    uint8_t buf[32];
+    gnrc_pktsnip_t *pkt;
+
+    memset(buf, TEST_UINT8, sizeof(buf));
+    loan_released = 0;
+    pkt = gnrc_pktbuf_add_loaned(NULL, buf, sizeof(buf), GNRC_NETTYPE_TEST,
+                                 &loan);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* shrinking keeps the data in place */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 16));
+    TEST_ASSERT(pkt->data == buf);
+    TEST_ASSERT_EQUAL_INT(0, loan_released);
+    /* growing moves it to the packet buffer */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 48));
+    TEST_ASSERT(pkt->data != buf);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pkt->data, buf, 16));
+    TEST_ASSERT_EQUAL_INT(1, loan_released);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(1, loan_released);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif
+
 static void test_pktbuf_start_write__NULL(void)
 {
     gnrc_pktbuf_start_write(NULL);
@@ -824,9 +957,13 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_add__pkt_NOT_NULL__data_NULL__size_not_0),
         new_TestFixture(test_pktbuf_add__pkt_NOT_NULL__data_NOT_NULL__size_not_0),
         new_TestFixture(test_pktbuf_add__memfull),
+#ifdef MODULE_GNRC_PKTBUF_STATIC
         new_TestFixture(test_pktbuf_add__success),
+#endif
         new_TestFixture(test_pktbuf_add__packed_struct),
+#ifdef MODULE_GNRC_PKTBUF_STATIC
         new_TestFixture(test_pktbuf_add__unaligned_in_aligned_hole),
+#endif
         new_TestFixture(test_pktbuf_add__0_sized_release),
         new_TestFixture(test_pktbuf_mark__pkt_NULL__size_0),
         new_TestFixture(test_pktbuf_mark__pkt_NULL__size_not_0),
@@ -852,6 +989,12 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_hold__success2),
         new_TestFixture(test_pktbuf_release__short_pktsnips),
         new_TestFixture(test_pktbuf_release__success),
+        new_TestFixture(test_pktbuf_bursty),
+#ifdef MODULE_GNRC_PKTBUF_LOAN
+        new_TestFixture(test_pktbuf_add_loaned__release),
+        new_TestFixture(test_pktbuf_add_loaned__mark),
+        new_TestFixture(test_pktbuf_add_loaned__realloc_data),
+#endif
         new_TestFixture(test_pktbuf_start_write__NULL),
         new_TestFixture(test_pktbuf_start_write__pkt_users_1),
         new_TestFixture(test_pktbuf_start_write__pkt_users_2),
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+#include "tests-random.h"
+
+#include "random.h"
+
+/* SplitMix64 seeded with 1, then xoroshiro128+ */
+static const uint64_t state_seq[] = {
+    0x4ff5bb8dee914928ULL,
+    0xf4bb636399efc448ULL,
+    0x676ce74bb045e184ULL,
+    0x85a5e2153b0d8255ULL,
+};
+
+static void test_random_state_sequence(void)
+{
+    random_state_t state;
+
+    random_state_init(&state, 1);
+    for (unsigned i = 0; i < sizeof(state_seq) / sizeof(state_seq[0]); i++) {
+        TEST_ASSERT(random_state_uint64(&state) == state_seq[i]);
+    }
+
+    random_state_init(&state, 1);
+    TEST_ASSERT_EQUAL_INT(state_seq[0] >> 32, random_state_uint32(&state));
+}
+
+static void test_random_state_independent(void)
+{
+    random_state_t a, b;
+
+    random_state_init(&a, 1);
+    random_state_init(&b, 2);
+    TEST_ASSERT(random_state_uint64(&a) != random_state_uint64(&b));
+}
+
+static void test_random_bytes(void)
+{
+    uint32_t expected[3];
+    uint8_t buf[11];
+
+    random_init(42);
+    for (unsigned i = 0; i < 3; i++) {
+        expected[i] = random_uint32();
+    }
+
+    random_init(42);
+    random_bytes(buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, expected, sizeof(buf)));
+}
+
+static void test_random_init_by_array(void)
+{
+    uint32_t key_a[] = { 1, 2, 3, 4 };
+    uint32_t key_b[] = { 1, 2, 3, 5 };
+    uint32_t a, b;
+
+    random_init_by_array(key_a, 4);
+    a = random_uint32();
+    random_init_by_array(key_b, 4);
+    b = random_uint32();
+    TEST_ASSERT(a != b);
+
+    random_init_by_array(key_a, 4);
+    TEST_ASSERT_EQUAL_INT(a, random_uint32());
+}
+
+Test *tests_random_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_random_state_sequence),
+        new_TestFixture(test_random_state_independent),
+        new_TestFixture(test_random_bytes),
+        new_TestFixture(test_random_init_by_array),
+    };
+
+    EMB_UNIT_TESTCALLER(random_tests, NULL, NULL, fixtures);
+
+    return (Test *)&random_tests;
+}
+
+void tests_random(void)
+{
+    TESTS_RUN(tests_random_tests());
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+#include "embUnit.h"
+
+#include "net/gnrc/rpl.h"
+#include "net/netstats/neighbor.h"
+
+#include "unittests-constants.h"
+#include "tests-rpl_mrhof.h"
+
+#define ETX(x)              ((x) * NETSTATS_NB_ETX_DIVISOR)
+#define MIN_HOP             (GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE)
+#define PARENT_RANK         (GNRC_RPL_ROOT_RANK)
+
+static const uint8_t _l2addr1[] = { 0x00, 0x01 };
+static const uint8_t _l2addr2[] = { 0x00, 0x02 };
+
+static netstats_nb_table_t _nb;
+static gnrc_rpl_instance_t _inst;
+static gnrc_rpl_parent_t _p1, _p2;
+static gnrc_rpl_of_t *_of;
+
+static void set_up(void)
+{
+    memset(&_nb, 0, sizeof(_nb));
+    memset(&_inst, 0, sizeof(_inst));
+    memset(&_p1, 0, sizeof(_p1));
+    memset(&_p2, 0, sizeof(_p2));
+    _inst.min_hop_rank_inc = MIN_HOP;
+    _inst.dodag.instance = &_inst;
+    _p1.dodag = &_inst.dodag;
+    _p1.rank = PARENT_RANK;
+    _p2.dodag = &_inst.dodag;
+    _p2.rank = PARENT_RANK;
+    gnrc_rpl_of_manager_init();
+    _of = gnrc_rpl_get_of_for_ocp(GNRC_RPL_MRHOF_OCP);
+}
+
+static void test_netstats_nb_etx(void)
+{
+    const netstats_nb_t *nb;
+    uint16_t etx;
+
+    netstats_nb_record(&_nb, _l2addr1, sizeof(_l2addr1));
+    TEST_ASSERT_NOT_NULL((nb = netstats_nb_get(&_nb, _l2addr1, sizeof(_l2addr1))));
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_ETX_INIT, nb->etx);
+    netstats_nb_update_tx(&_nb, true);
+    TEST_ASSERT_EQUAL_INT(1, nb->tx_success);
+    TEST_ASSERT(nb->etx < NETSTATS_NB_ETX_INIT);
+    /* the outcome is only counted once */
+    netstats_nb_update_tx(&_nb, true);
+    TEST_ASSERT_EQUAL_INT(1, nb->tx_success);
+    for (unsigned i = 0; i < 64; i++) {
+        netstats_nb_record(&_nb, _l2addr1, sizeof(_l2addr1));
+        netstats_nb_update_tx(&_nb, true);
+    }
+    TEST_ASSERT_EQUAL_INT(ETX(1), nb->etx);
+    etx = nb->etx;
+    netstats_nb_record(&_nb, _l2addr1, sizeof(_l2addr1));
+    netstats_nb_update_tx(&_nb, false);
+    TEST_ASSERT_EQUAL_INT(1, nb->tx_failed);
+    TEST_ASSERT(nb->etx > etx);
+    /* busy medium does not count */
+    etx = nb->etx;
+    netstats_nb_record(&_nb, _l2addr1, sizeof(_l2addr1));
+    netstats_nb_drop_tx(&_nb);
+    netstats_nb_update_tx(&_nb, false);
+    TEST_ASSERT_EQUAL_INT(etx, nb->etx);
+}
+
+static void test_netstats_nb_broadcast(void)
+{
+    netstats_nb_record(&_nb, _l2addr1, sizeof(_l2addr1));
+    netstats_nb_record(&_nb, NULL, 0);
+    TEST_ASSERT_NULL(_nb.pending);
+    netstats_nb_update_tx(&_nb, false);
+    TEST_ASSERT_EQUAL_INT(0,
+                          netstats_nb_get(&_nb, _l2addr1, sizeof(_l2addr1))->tx_failed);
+}
+
+static void test_netstats_nb_replace(void)
+{
+    uint8_t l2addr[2] = { 0x00, 0x00 };
+
+    netstats_nb_record(&_nb, _l2addr1, sizeof(_l2addr1));
+    netstats_nb_update_tx(&_nb, true);
+    netstats_nb_record(&_nb, _l2addr2, sizeof(_l2addr2));
+    /* fill the table with others, replacing the oldest entry */
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE - 1; i++) {
+        l2addr[0] = 0x10 + i;
+        netstats_nb_record(&_nb, l2addr, sizeof(l2addr));
+    }
+    TEST_ASSERT_NULL(netstats_nb_get(&_nb, _l2addr1, sizeof(_l2addr1)));
+    TEST_ASSERT_NOT_NULL(netstats_nb_get(&_nb, _l2addr2, sizeof(_l2addr2)));
+}
+
+static void test_rpl_mrhof_registered(void)
+{
+    TEST_ASSERT_NOT_NULL(_of);
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_MRHOF_OCP, _of->ocp);
+}
+
+static void test_rpl_mrhof_calc_rank(void)
+{
+    /* unknown links count with the initial ETX */
+    TEST_ASSERT_EQUAL_INT(PARENT_RANK + (NETSTATS_NB_ETX_INIT * MIN_HOP) / ETX(1),
+                          _of->calc_rank(&_p1, 0));
+    _p1.link_metric = ETX(3);
+    TEST_ASSERT_EQUAL_INT(PARENT_RANK + 3 * MIN_HOP, _of->calc_rank(&_p1, 0));
+    /* the rank increases by at least MinHopRankIncrease */
+    _p1.link_metric = ETX(1) / 2;
+    TEST_ASSERT_EQUAL_INT(PARENT_RANK + MIN_HOP, _of->calc_rank(&_p1, 0));
+    _p1.link_metric = GNRC_RPL_MRHOF_MAX_LINK_METRIC + 1;
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_INFINITE_RANK, _of->calc_rank(&_p1, 0));
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_INFINITE_RANK, _of->calc_rank(NULL, 0));
+}
+
+static void test_rpl_mrhof_which_parent(void)
+{
+    _p1.link_metric = ETX(1);
+    _p2.link_metric = ETX(3);
+    TEST_ASSERT(_of->which_parent(&_p1, &_p2) == &_p1);
+    TEST_ASSERT(_of->which_parent(&_p2, &_p1) == &_p1);
+    /* a parent over a lossy link loses against one with a higher rank */
+    _p1.rank = PARENT_RANK + MIN_HOP;
+    TEST_ASSERT(_of->which_parent(&_p1, &_p2) == &_p1);
+}
+
+static void test_rpl_mrhof_hysteresis(void)
+{
+    _inst.dodag.parents = &_p2;
+    _p1.link_metric = ETX(1);
+    _p2.link_metric = ETX(2);
+    /* better, but not by the switch threshold */
+    TEST_ASSERT(_of->which_parent(&_p2, &_p1) == &_p2);
+    TEST_ASSERT(_of->which_parent(&_p1, &_p2) == &_p2);
+    _p2.link_metric = ETX(3);
+    TEST_ASSERT(_of->which_parent(&_p2, &_p1) == &_p1);
+    TEST_ASSERT(_of->which_parent(&_p1, &_p2) == &_p1);
+}
+
+Test *tests_rpl_mrhof_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_netstats_nb_etx),
+        new_TestFixture(test_netstats_nb_broadcast),
+        new_TestFixture(test_netstats_nb_replace),
+        new_TestFixture(test_rpl_mrhof_registered),
+        new_TestFixture(test_rpl_mrhof_calc_rank),
+        new_TestFixture(test_rpl_mrhof_which_parent),
+        new_TestFixture(test_rpl_mrhof_hysteresis),
+    };
+
+    EMB_UNIT_TESTCALLER(rpl_mrhof_tests, set_up, NULL, fixtures);
+
+    return (Test *)&rpl_mrhof_tests;
+}
+
+void tests_rpl_mrhof(void)
+{
+    TESTS_RUN(tests_rpl_mrhof_tests());
+}
+/** @} */
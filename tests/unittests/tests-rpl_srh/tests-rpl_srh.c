@@ -11,6 +11,7 @@
  *
  * @file
  */
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
 #include "embUnit.h"
@@ -36,12 +37,39 @@
                                0x00, 0x00, 0x00, 0x00, \
                                0x00, 0x00, 0x00, 0x03 }}
 
+#define IPV6_ADDR3          {{ 0x20, 0x01, 0xab, 0xce, \
+                               0x00, 0x00, 0x00, 0x00, \
+                               0x00, 0x00, 0x00, 0x00, \
+                               0x00, 0x00, 0x00, 0x04 }}
+
 #define IPV6_ADDR1_ELIDED   { 0x00, 0x00, 0x02 }
 #define IPV6_ADDR2_ELIDED   { 0x00, 0x00, 0x03 }
 #define IPV6_ELIDED_PREFIX  (13)
 
 #define SRH_SEG_LEFT        (2)
 
+#define TEST_FIB_SR_NUMOF   (2)
+
+static fib_sr_t _sr_headers[TEST_FIB_SR_NUMOF];
+static fib_sr_entry_t _sr_pool[TEST_FIB_SR_NUMOF * 3];
+static fib_sr_meta_t _sr_meta = { .headers = _sr_headers,
+                                  .entry_pool = _sr_pool,
+                                  .entry_pool_size = TEST_FIB_SR_NUMOF * 3 };
+static fib_table_t _sr_table = { .data.source_routes = &_sr_meta,
+                                 .table_type = FIB_TABLE_TYPE_SR,
+                                 .size = TEST_FIB_SR_NUMOF,
+                                 .mtx_access = MUTEX_INIT };
+
+static void set_up(void)
+{
+    fib_init(&_sr_table);
+}
+
+static void tear_down(void)
+{
+    fib_deinit(&_sr_table);
+}
+
 static void test_rpl_srh_nexthop_no_prefix_elided(void)
 {
     ipv6_hdr_t hdr;
@@ -105,14 +133,92 @@ static void test_rpl_srh_nexthop_prefix_elided(void)
     TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &expected2));
 }
 
+static void _add_route(fib_sr_t **sr)
+{
+    ipv6_addr_t a1 = IPV6_ADDR1, a2 = IPV6_ADDR2, dst = IPV6_DST;
+
+    TEST_ASSERT_EQUAL_INT(0, fib_sr_create(&_sr_table, sr, 42, 0, 100000));
+    TEST_ASSERT_EQUAL_INT(0, fib_sr_entry_append(&_sr_table, *sr, a1.u8, sizeof(a1)));
+    TEST_ASSERT_EQUAL_INT(0, fib_sr_entry_append(&_sr_table, *sr, a2.u8, sizeof(a2)));
+    TEST_ASSERT_EQUAL_INT(0, fib_sr_entry_append(&_sr_table, *sr, dst.u8, sizeof(dst)));
+}
+
+static void test_rpl_srh_build__no_route(void)
+{
+    uint8_t buf[GNRC_RPL_SRH_MAX_LEN];
+    ipv6_addr_t dst = IPV6_DST, first_hop;
+    kernel_pid_t iface;
+
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH,
+                          gnrc_rpl_srh_build(&_sr_table, &dst, &iface, &first_hop,
+                                             buf, sizeof(buf)));
+}
+
+static void test_rpl_srh_build__success(void)
+{
+    ipv6_hdr_t hdr;
+    uint8_t buf[GNRC_RPL_SRH_MAX_LEN];
+    gnrc_rpl_srh_t *srh = (gnrc_rpl_srh_t *) buf;
+    ipv6_addr_t dst = IPV6_DST, expected1 = IPV6_ADDR1, expected2 = IPV6_ADDR2;
+    kernel_pid_t iface = KERNEL_PID_UNDEF;
+    fib_sr_t *sr = NULL;
+
+    _add_route(&sr);
+    /* all addresses share 15 octets, 1 inline octet each padded to 8 */
+    TEST_ASSERT_EQUAL_INT(sizeof(gnrc_rpl_srh_t) + 8,
+                          gnrc_rpl_srh_build(&_sr_table, &dst, &iface, &hdr.dst,
+                                             buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(42, iface);
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &expected1));
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_SRH_TYPE, srh->type);
+    TEST_ASSERT_EQUAL_INT(1, srh->len);
+    TEST_ASSERT_EQUAL_INT(2, srh->seg_left);
+    TEST_ASSERT_EQUAL_INT(0xff, srh->compr);
+
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &expected2));
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &dst));
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_OK, gnrc_rpl_srh_process(&hdr, srh));
+}
+
+static void test_rpl_srh_build__route_changed(void)
+{
+    ipv6_hdr_t hdr;
+    uint8_t buf[GNRC_RPL_SRH_MAX_LEN];
+    gnrc_rpl_srh_t *srh = (gnrc_rpl_srh_t *) buf;
+    ipv6_addr_t dst = IPV6_DST, a2 = IPV6_ADDR2, a3 = IPV6_ADDR3;
+    kernel_pid_t iface;
+    fib_sr_t *sr = NULL;
+
+    _add_route(&sr);
+    TEST_ASSERT(gnrc_rpl_srh_build(&_sr_table, &dst, &iface, &hdr.dst, buf,
+                                   sizeof(buf)) > 0);
+    /* the intermediate hop now only shares 3 octets with its neighbors */
+    TEST_ASSERT_EQUAL_INT(0, fib_sr_entry_overwrite(&_sr_table, sr, a2.u8,
+                                                    sizeof(a2), a3.u8,
+                                                    sizeof(a3)));
+    TEST_ASSERT_EQUAL_INT(sizeof(gnrc_rpl_srh_t) + 32,
+                          gnrc_rpl_srh_build(&_sr_table, &dst, &iface, &hdr.dst,
+                                             buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0x33, srh->compr);
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &a3));
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &dst));
+}
+
 Test *tests_rpl_srh_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_rpl_srh_nexthop_no_prefix_elided),
         new_TestFixture(test_rpl_srh_nexthop_prefix_elided),
+        new_TestFixture(test_rpl_srh_build__no_route),
+        new_TestFixture(test_rpl_srh_build__success),
+        new_TestFixture(test_rpl_srh_build__route_changed),
     };
 
-    EMB_UNIT_TESTCALLER(rpl_srh_tests, NULL, NULL, fixtures);
+    EMB_UNIT_TESTCALLER(rpl_srh_tests, set_up, tear_down, fixtures);
 
     return (Test *)&rpl_srh_tests;
 }
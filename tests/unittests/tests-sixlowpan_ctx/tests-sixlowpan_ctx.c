@@ -156,6 +156,69 @@ static void test_sixlowpan_ctx_lookup_addr__other_addr_other_prefix(void)
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
 }
 
+static void _fill_nested(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_PREFIX;
+
+    /* context i gets the (i + 1) * 8 bit prefix of DEFAULT_TEST_PREFIX, added
+     * in an order that is neither ascending nor descending */
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_CTX_SIZE; i++) {
+        uint8_t id = (i * 7) % GNRC_SIXLOWPAN_CTX_SIZE;
+
+        TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(id, &addr, (id + 1) * 8,
+                                                       TEST_UINT16, true));
+    }
+}
+
+static void test_sixlowpan_ctx_lookup_addr__longest_prefix(void)
+{
+    ipv6_addr_t addr1 = DEFAULT_TEST_PREFIX;
+    ipv6_addr_t addr2 = OTHER_TEST_PREFIX;
+    gnrc_sixlowpan_ctx_t *ctx;
+
+    _fill_nested();
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr1)));
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_CTX_SIZE - 1,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    TEST_ASSERT_EQUAL_INT(IPV6_ADDR_BIT_LEN, ctx->prefix_len);
+    /* OTHER_TEST_PREFIX shares the first 63 bits with DEFAULT_TEST_PREFIX */
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr2)));
+    TEST_ASSERT_EQUAL_INT(6, ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    TEST_ASSERT_EQUAL_INT(56, ctx->prefix_len);
+}
+
+static void test_sixlowpan_ctx_lookup_addr__update_prefix_len(void)
+{
+    ipv6_addr_t addr1 = DEFAULT_TEST_PREFIX;
+    ipv6_addr_t addr2 = OTHER_TEST_PREFIX;
+    gnrc_sixlowpan_ctx_t *ctx;
+
+    _fill_nested();
+    /* shorten the longest context below the one matching OTHER_TEST_PREFIX */
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_update(GNRC_SIXLOWPAN_CTX_SIZE - 1,
+                                                   &addr1, 4, TEST_UINT16,
+                                                   true));
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr1)));
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_CTX_SIZE - 2,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr2)));
+    TEST_ASSERT_EQUAL_INT(6, ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+}
+
+static void test_sixlowpan_ctx_lookup_addr__remove_longest(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_PREFIX;
+    gnrc_sixlowpan_ctx_t *ctx;
+
+    _fill_nested();
+    gnrc_sixlowpan_ctx_remove(GNRC_SIXLOWPAN_CTX_SIZE - 1);
+    TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_id(GNRC_SIXLOWPAN_CTX_SIZE - 1));
+    TEST_ASSERT_NOT_NULL((ctx = gnrc_sixlowpan_ctx_lookup_addr(&addr)));
+    TEST_ASSERT_EQUAL_INT(GNRC_SIXLOWPAN_CTX_SIZE - 2,
+                          ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
+    TEST_ASSERT_EQUAL_INT(IPV6_ADDR_BIT_LEN - 8, ctx->prefix_len);
+}
+
 static void test_sixlowpan_ctx_lookup_id__empty(void)
 {
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_id(DEFAULT_TEST_ID));
@@ -207,6 +270,9 @@ Test *tests_sixlowpan_ctx_tests(void)
         new_TestFixture(test_sixlowpan_ctx_lookup_addr__same_addr),
         new_TestFixture(test_sixlowpan_ctx_lookup_addr__other_addr_same_prefix),
         new_TestFixture(test_sixlowpan_ctx_lookup_addr__other_addr_other_prefix),
+        new_TestFixture(test_sixlowpan_ctx_lookup_addr__longest_prefix),
+        new_TestFixture(test_sixlowpan_ctx_lookup_addr__update_prefix_len),
+        new_TestFixture(test_sixlowpan_ctx_lookup_addr__remove_longest),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__empty),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__wrong_id),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__success),
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "spscrb.h"
+
+#define ELEM_NUMOF  (8U)
+
+typedef struct {
+    uint16_t a;
+    uint8_t b;
+} elem_t;
+
+static elem_t _buf[ELEM_NUMOF];
+static spscrb_t _rb;
+
+static void set_up(void)
+{
+    memset(_buf, 0, sizeof(_buf));
+    spscrb_init(&_rb, _buf, ELEM_NUMOF, sizeof(elem_t));
+}
+
+static void test_spscrb_init(void)
+{
+    spscrb_t rb = SPSCRB_INIT(_buf, sizeof(elem_t));
+
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, rb.size);
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, _rb.size);
+    TEST_ASSERT_EQUAL_INT(1, spscrb_empty(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, spscrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, spscrb_avail(&_rb));
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, spscrb_free(&_rb));
+}
+
+static void test_spscrb_put_get(void)
+{
+    elem_t in[ELEM_NUMOF + 2], out[ELEM_NUMOF + 2];
+
+    for (unsigned i = 0; i < ELEM_NUMOF + 2; i++) {
+        in[i].a = 1000 + i;
+        in[i].b = i;
+    }
+
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, spscrb_put(&_rb, in, ELEM_NUMOF + 2));
+    TEST_ASSERT_EQUAL_INT(1, spscrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, spscrb_put(&_rb, in, 1));
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, spscrb_get(&_rb, out, ELEM_NUMOF + 2));
+    TEST_ASSERT_EQUAL_INT(1, spscrb_empty(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(in, out, ELEM_NUMOF * sizeof(elem_t)));
+}
+
+static void test_spscrb_wrap_around(void)
+{
+    elem_t in[ELEM_NUMOF], out[ELEM_NUMOF];
+
+    for (unsigned i = 0; i < ELEM_NUMOF; i++) {
+        in[i].a = i;
+        in[i].b = ~i;
+    }
+
+    /* move read and write position to the middle */
+    TEST_ASSERT_EQUAL_INT(5, spscrb_put(&_rb, in, 5));
+    TEST_ASSERT_EQUAL_INT(5, spscrb_get(&_rb, out, 5));
+
+    /* copying spans the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, spscrb_put(&_rb, in, ELEM_NUMOF));
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, spscrb_get(&_rb, out, ELEM_NUMOF));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(in, out, sizeof(in)));
+}
+
+static void test_spscrb_regions(void)
+{
+    elem_t *region;
+
+    /* whole buffer is one region initially */
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF, spscrb_reserve(&_rb, (void **)&region));
+    TEST_ASSERT(region == &_buf[0]);
+    region[0].a = 42;
+    region[1].a = 43;
+    region[2].a = 44;
+    spscrb_commit(&_rb, 3);
+
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF - 3, spscrb_reserve(&_rb, (void **)&region));
+    TEST_ASSERT(region == &_buf[3]);
+
+    TEST_ASSERT_EQUAL_INT(3, spscrb_peek(&_rb, (void **)&region));
+    TEST_ASSERT(region == &_buf[0]);
+    TEST_ASSERT_EQUAL_INT(42, region[0].a);
+    spscrb_release(&_rb, 2);
+
+    TEST_ASSERT_EQUAL_INT(1, spscrb_peek(&_rb, (void **)&region));
+    TEST_ASSERT_EQUAL_INT(44, region[0].a);
+
+    /* fill up to the end: free region must stop at the end of the buffer */
+    spscrb_commit(&_rb, ELEM_NUMOF - 3);
+    TEST_ASSERT_EQUAL_INT(2, spscrb_reserve(&_rb, (void **)&region));
+    TEST_ASSERT(region == &_buf[0]);
+    spscrb_commit(&_rb, 2);
+    TEST_ASSERT_EQUAL_INT(1, spscrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, spscrb_reserve(&_rb, (void **)&region));
+
+    /* readable region stops at the end of the buffer as well */
+    TEST_ASSERT_EQUAL_INT(ELEM_NUMOF - 2, spscrb_peek(&_rb, (void **)&region));
+    TEST_ASSERT(region == &_buf[2]);
+}
+
+Test *tests_spscrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_spscrb_init),
+        new_TestFixture(test_spscrb_put_get),
+        new_TestFixture(test_spscrb_wrap_around),
+        new_TestFixture(test_spscrb_regions),
+    };
+
+    EMB_UNIT_TESTCALLER(spscrb_tests, set_up, NULL, fixtures);
+
+    return (Test *)&spscrb_tests;
+}
+
+void tests_spscrb(void)
+{
+    TESTS_RUN(tests_spscrb_tests());
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Prints the xtimer parameters measured at boot and the
+ *              precision of xtimer_periodic_wakeup() with them
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "xtimer.h"
+
+#define TEST_PERIOD     (1000U)
+#define TEST_RUNS       (1000U)
+
+int main(void)
+{
+    const xtimer_calibration_t *cal = xtimer_get_calibration();
+    xtimer_ticks32_t last = xtimer_now();
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+
+    puts("xtimer calibration test");
+    printf("backoff:     %4" PRIu32 " ticks (default %u)\n",
+           cal->backoff, (unsigned)XTIMER_BACKOFF);
+    printf("overhead:    %4" PRIu32 " ticks (default %u)\n",
+           cal->overhead, (unsigned)XTIMER_OVERHEAD);
+    printf("isr_backoff: %4" PRIu32 " ticks (default %u)\n",
+           cal->isr_backoff, (unsigned)XTIMER_ISR_BACKOFF);
+
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        xtimer_periodic_wakeup(&last, TEST_PERIOD);
+        uint32_t late = xtimer_diff(xtimer_now(), last).ticks32;
+
+        if (late < min) {
+            min = late;
+        }
+        if (late > max) {
+            max = late;
+        }
+    }
+    printf("periodic wakeup of %u us late by min %" PRIu32 " max %" PRIu32
+           " ticks\n", TEST_PERIOD, min, max);
+    puts("Test done");
+    return 0;
+}
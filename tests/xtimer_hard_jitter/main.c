@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares the jitter of a hard timer to a regular xtimer
+ *              under timer load
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "irq.h"
+#include "xtimer.h"
+
+#define TEST_PERIOD         (1000U)
+#define TEST_REPORTS        (10U)
+#define LOAD_TIMERS         (8U)
+#define LOAD_PERIOD_MASK    (0x3ffU)
+#define LOAD_BUSY_LOOPS     (50U)
+
+typedef struct {
+    xtimer_ticks32_t target;
+    uint32_t min;
+    uint32_t max;
+    uint32_t samples;
+} jitter_t;
+
+static jitter_t _hard_jitter;
+static jitter_t _soft_jitter;
+static xtimer_t _soft;
+static xtimer_t _load[LOAD_TIMERS];
+static uint32_t _period;
+static uint32_t _seed = 1;
+
+static uint32_t _rand(void)
+{
+    /* LCG of Numerical Recipes, good enough to spread the load */
+    _seed = (_seed * 1664525U) + 1013904223U;
+    return _seed >> 8;
+}
+
+static void _reset(jitter_t *jitter)
+{
+    jitter->min = UINT32_MAX;
+    jitter->max = 0;
+    jitter->samples = 0;
+}
+
+/* records how late the timer is and returns the next target */
+static xtimer_ticks32_t _sample(jitter_t *jitter)
+{
+    uint32_t late = xtimer_diff(xtimer_now(), jitter->target).ticks32;
+
+    if (late < jitter->min) {
+        jitter->min = late;
+    }
+    if (late > jitter->max) {
+        jitter->max = late;
+    }
+    jitter->samples++;
+    jitter->target.ticks32 += _period;
+    return jitter->target;
+}
+
+static void _hard_cb(void *arg)
+{
+    (void)arg;
+    xtimer_hard_set_absolute(0, _sample(&_hard_jitter));
+}
+
+static void _soft_cb(void *arg)
+{
+    (void)arg;
+    xtimer_ticks32_t left = xtimer_diff(_sample(&_soft_jitter), xtimer_now());
+
+    if ((int32_t)left.ticks32 < 0) {
+        left.ticks32 = 0;
+    }
+    xtimer_set(&_soft, xtimer_usec_from_ticks(left));
+}
+
+static void _load_cb(void *arg)
+{
+    /* keep the CPU busy in the timer interrupt, like a driver would */
+    for (volatile unsigned i = 0; i < LOAD_BUSY_LOOPS; i++) {}
+    xtimer_set(arg, 10U + (_rand() & LOAD_PERIOD_MASK));
+}
+
+static void _print(const char *name, jitter_t *jitter)
+{
+    printf("%s: %4" PRIu32 " samples, late min %4" PRIu32 " max %4" PRIu32
+           " us\n", name, jitter->samples,
+           xtimer_usec_from_ticks(xtimer_ticks(jitter->min)),
+           xtimer_usec_from_ticks(xtimer_ticks(jitter->max)));
+}
+
+int main(void)
+{
+    puts("xtimer hard timer jitter test");
+    printf("period %u us, %u load timers\n", TEST_PERIOD, LOAD_TIMERS);
+
+    _period = xtimer_ticks_from_usec(TEST_PERIOD).ticks32;
+    if (xtimer_hard_init(0, _hard_cb, NULL) != 0) {
+        puts("error: could not reserve hard timer");
+        return 1;
+    }
+    for (unsigned i = 0; i < LOAD_TIMERS; i++) {
+        _load[i].callback = _load_cb;
+        _load[i].arg = &_load[i];
+        xtimer_set(&_load[i], 10U + (_rand() & LOAD_PERIOD_MASK));
+    }
+    _soft.callback = _soft_cb;
+
+    unsigned state = irq_disable();
+    _reset(&_hard_jitter);
+    _reset(&_soft_jitter);
+    _hard_jitter.target.ticks32 = xtimer_now().ticks32 + _period;
+    _soft_jitter.target = _hard_jitter.target;
+    xtimer_hard_set_absolute(0, _hard_jitter.target);
+    xtimer_set(&_soft, TEST_PERIOD);
+    irq_restore(state);
+
+    for (unsigned i = 0; i < TEST_REPORTS; i++) {
+        xtimer_sleep(1);
+        state = irq_disable();
+        jitter_t hard = _hard_jitter;
+        jitter_t soft = _soft_jitter;
+        _reset(&_hard_jitter);
+        _reset(&_soft_jitter);
+        irq_restore(state);
+        _print("hard", &hard);
+        _print("soft", &soft);
+    }
+
+    xtimer_hard_release(0);
+    xtimer_remove(&_soft);
+    for (unsigned i = 0; i < LOAD_TIMERS; i++) {
+        xtimer_remove(&_load[i]);
+    }
+    puts("Test done");
+    return 0;
+}
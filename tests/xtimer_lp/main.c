@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Idle application with long timers only, to measure the
+ *              energy xtimer_lp saves
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "periph/rtt.h"
+#include "thread.h"
+#include "xtimer.h"
+
+/* roughly the timers of an idle RPL node: DIO interval and NDP reachable
+ * time */
+#define LP_DIO_INTERVAL     (60U * SEC_IN_USEC)
+#define LP_REACHABLE_TIME   (30U * SEC_IN_USEC)
+#define LP_REPORT_INTERVAL  (3600U)     /* in seconds */
+
+#define MSG_DIO             (0x4c01)
+#define MSG_REACHABLE       (0x4c02)
+
+int main(void)
+{
+    xtimer_t dio = { .target = 0, .long_target = 0 };
+    xtimer_t reachable = { .target = 0, .long_target = 0 };
+    msg_t dio_msg = { .type = MSG_DIO };
+    msg_t reachable_msg = { .type = MSG_REACHABLE };
+    uint32_t wakeups = 0, elapsed = 0, start_rtt = rtt_get_counter();
+    uint64_t start = xtimer_now_usec64();
+    unsigned hour = 0;
+
+    puts("xtimer low-power test");
+#ifdef MODULE_XTIMER_LP
+    printf("timers of %" PRIu32 " us and more run on the RTT\n",
+           (uint32_t)XTIMER_LP_THRESHOLD);
+#endif
+
+    xtimer_set_msg(&dio, LP_DIO_INTERVAL, &dio_msg, thread_getpid());
+    xtimer_set_msg(&reachable, LP_REACHABLE_TIME, &reachable_msg,
+                   thread_getpid());
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        wakeups++;
+        if (msg.type == MSG_DIO) {
+            xtimer_set_msg(&dio, LP_DIO_INTERVAL, &dio_msg, thread_getpid());
+            elapsed += LP_DIO_INTERVAL / SEC_IN_USEC;
+        }
+        else {
+            xtimer_set_msg(&reachable, LP_REACHABLE_TIME, &reachable_msg,
+                           thread_getpid());
+        }
+        if (elapsed >= LP_REPORT_INTERVAL) {
+            uint32_t rtt_ticks = (rtt_get_counter() - start_rtt) & RTT_MAX_VALUE;
+
+            /* the RTT counter may wrap within an hour, the xtimer time
+             * shows how long XTIMER_DEV was stopped */
+            printf("hour %u: %" PRIu32 " wake-ups, xtimer %" PRIu32 " s, "
+                   "RTT %" PRIu32 " ticks\n", ++hour, wakeups,
+                   (uint32_t)((xtimer_now_usec64() - start) / SEC_IN_USEC),
+                   rtt_ticks);
+            wakeups = 0;
+            elapsed = 0;
+            start = xtimer_now_usec64();
+            start_rtt = rtt_get_counter();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       test application for xtimer_mbox_get_timeout() and
+ *              mbox_get_many()
+ *
+ *              This test will sequentially start 10 xtimers that put a
+ *              message into a mailbox, alternating with an interval of 99ms
+ *              and 101ms respectively. Everytime a timer was set, it will
+ *              wait for a message for at most 100ms. This should succeed and
+ *              fail in an alternating manner. Afterwards, a number of queued
+ *              messages is retrieved with a single call to mbox_get_many().
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "mbox.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_PERIOD     (100000LU)
+#define QUEUE_SIZE      (8U)
+#define MANY_NUMOF      (5U)
+
+static msg_t queue[QUEUE_SIZE];
+static mbox_t mbox;
+
+static void _put(void *arg)
+{
+    msg_t m = { .type = 44 };
+
+    (void)arg;
+    mbox_try_put(&mbox, &m);
+}
+
+int main(void)
+{
+    msg_t m;
+    msg_t many[QUEUE_SIZE];
+    xtimer_t t = { .callback = _put };
+    int32_t offset = -1000;
+
+    mbox_init(&mbox, queue, QUEUE_SIZE);
+
+    for (int i = 0; i < 10; i++) {
+        xtimer_set(&t, TEST_PERIOD + offset);
+        if (xtimer_mbox_get_timeout(&mbox, &m, TEST_PERIOD) < 0) {
+            puts("Timeout!");
+            /* drain the late message of this round */
+            mbox_get(&mbox, &m);
+        }
+        else {
+            printf("Message received: %" PRIu16 "\n", m.type);
+        }
+        offset = (offset < 0) ? 1000 : -1000;
+        xtimer_remove(&t);
+    }
+
+    for (unsigned i = 0; i < MANY_NUMOF; i++) {
+        m.type = i;
+        mbox_try_put(&mbox, &m);
+    }
+    unsigned n = mbox_get_many(&mbox, many, QUEUE_SIZE);
+    printf("Got %u messages at once\n", n);
+    puts(((n == MANY_NUMOF) && (many[MANY_NUMOF - 1].type == MANY_NUMOF - 1)) ?
+         "[SUCCESS]" : "[FAILED]");
+
+    return 0;
+}
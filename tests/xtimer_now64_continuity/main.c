@@ -25,24 +25,54 @@
 
 #define ITERATIONS (100000LU)
 #define MAXDIFF 1000
+/* interval of the interrupt load, which reads the time as well */
+#define LOAD_INTERVAL (200U)
+
+static xtimer_t _load;
+static uint64_t _load_last;
+static volatile unsigned _load_errors;
+static volatile unsigned _load_count;
+
+static void _load_cb(void *arg)
+{
+    uint64_t now = _xtimer_now64();
+
+    (void)arg;
+    if ((_load_last != 0) && ((now < _load_last) ||
+        ((now - _load_last) > (_xtimer_ticks_from_usec(LOAD_INTERVAL) + MAXDIFF)))) {
+        _load_errors++;
+    }
+    _load_last = now;
+    _load_count++;
+    xtimer_set(&_load, LOAD_INTERVAL);
+}
 
 int main(void)
 {
     uint32_t n = ITERATIONS;
     uint64_t before = _xtimer_now64();
 
+    _load.callback = _load_cb;
+    xtimer_set(&_load, LOAD_INTERVAL);
+
     while(--n) {
         uint64_t now = _xtimer_now64();
-        if ((now-before) > MAXDIFF) {
+        if ((now < before) || ((now-before) > MAXDIFF)) {
             puts("TEST FAILED.");
             break;
         }
         before = now;
     }
+    xtimer_remove(&_load);
 
-    if (!n) {
+    printf("%u reads in interrupts, %u discontinuous\n", _load_count,
+           _load_errors);
+    if (!n && !_load_errors) {
         puts("TEST SUCCESSFUL.");
     }
+    else if (!n) {
+        puts("TEST FAILED.");
+    }
 
     return 0;
 }
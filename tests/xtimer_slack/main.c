@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Shows how xtimer_set_slack() reduces the number of wake-ups
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mutex.h"
+#include "xtimer.h"
+
+#define SLACK_TIMERS        (16U)
+#define SLACK_ROUNDS        (8U)
+#define SLACK_PERIOD        (20U * 1000U)
+#define SLACK_OFFSET_MASK   (0x3fffU)
+#define SLACK_TOLERANCE     (5U * 1000U)
+
+static xtimer_t _timers[SLACK_TIMERS];
+static unsigned _left;
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static uint32_t _seed = 1;
+
+static uint32_t _rand(void)
+{
+    /* LCG of Numerical Recipes, good enough to spread the timers */
+    _seed = (_seed * 1664525U) + 1013904223U;
+    return _seed >> 8;
+}
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    if (--_left == 0) {
+        mutex_unlock(&_done);
+    }
+}
+
+static void _run(uint32_t slack)
+{
+    xtimer_stats_t before = *xtimer_get_stats();
+    const xtimer_stats_t *after = xtimer_get_stats();
+
+    _seed = 1;
+    for (unsigned round = 0; round < SLACK_ROUNDS; round++) {
+        _left = SLACK_TIMERS;
+        for (unsigned i = 0; i < SLACK_TIMERS; i++) {
+            _timers[i].callback = _cb;
+            _timers[i].target = _timers[i].long_target = 0;
+            xtimer_set_slack(&_timers[i],
+                             SLACK_PERIOD + (_rand() & SLACK_OFFSET_MASK), slack);
+        }
+        mutex_lock(&_done);
+    }
+    printf("slack %5" PRIu32 " us: %3" PRIu32 " timers in %3" PRIu32
+           " wake-ups (%" PRIu32 " coalesced)\n", slack,
+           after->fired - before.fired, after->wakeups - before.wakeups,
+           after->coalesced - before.coalesced);
+}
+
+int main(void)
+{
+    puts("xtimer slack test");
+
+    _run(0);
+    _run(SLACK_TOLERANCE);
+
+    puts("done");
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the duration of xtimer_set() and xtimer_remove()
+ *              with many pending timers
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "xtimer.h"
+
+#ifndef TIMINGS_TIMERS_MAX
+#define TIMINGS_TIMERS_MAX  (1000U)
+#endif
+#define TIMINGS_ROUNDS      (1000U)
+/* timers must not expire during the measurement */
+#define TIMINGS_OFFSET_MIN  (60U * SEC_IN_USEC)
+#define TIMINGS_OFFSET_MASK (0x00ffffffU)
+
+static xtimer_t _timers[TIMINGS_TIMERS_MAX];
+static uint32_t _seed = 1;
+
+static uint32_t _rand(void)
+{
+    /* LCG of Numerical Recipes, good enough to spread the targets */
+    _seed = (_seed * 1664525U) + 1013904223U;
+    return _seed;
+}
+
+static void _cb(void *arg)
+{
+    printf("error: timer %p expired\n", arg);
+}
+
+static uint32_t _offset(void)
+{
+    return TIMINGS_OFFSET_MIN + (_rand() & TIMINGS_OFFSET_MASK);
+}
+
+static void _measure(unsigned num)
+{
+    uint32_t set_max = 0, set_sum = 0, remove_max = 0, remove_sum = 0;
+
+    for (unsigned i = 0; i < num; i++) {
+        _timers[i].callback = _cb;
+        _timers[i].arg = &_timers[i];
+        _timers[i].target = _timers[i].long_target = 0;
+        xtimer_set(&_timers[i], _offset());
+    }
+
+    for (unsigned i = 0; i < TIMINGS_ROUNDS; i++) {
+        xtimer_t *timer = &_timers[_rand() % num];
+        uint32_t offset = _offset();
+        uint32_t start, removed, set;
+
+        start = xtimer_now_usec();
+        xtimer_remove(timer);
+        removed = xtimer_now_usec();
+        xtimer_set(timer, offset);
+        set = xtimer_now_usec();
+
+        remove_sum += removed - start;
+        if ((removed - start) > remove_max) {
+            remove_max = removed - start;
+        }
+        set_sum += set - removed;
+        if ((set - removed) > set_max) {
+            set_max = set - removed;
+        }
+    }
+
+    for (unsigned i = 0; i < num; i++) {
+        xtimer_remove(&_timers[i]);
+    }
+
+    printf("%4u timers: set max %5" PRIu32 " us avg %5" PRIu32 " us, "
+           "remove max %5" PRIu32 " us avg %5" PRIu32 " us\n", num,
+           set_max, set_sum / TIMINGS_ROUNDS,
+           remove_max, remove_sum / TIMINGS_ROUNDS);
+}
+
+int main(void)
+{
+    puts("xtimer set and remove timings");
+#ifdef MODULE_XTIMER_HEAP
+    puts("backend: pairing heaps");
+#else
+    puts("backend: sorted lists");
+#endif
+
+    for (unsigned num = 10; num <= TIMINGS_TIMERS_MAX; num *= 10) {
+        _measure(num);
+    }
+
+    puts("done");
+    return 0;
+}